@@ -0,0 +1,38 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include <benchmark/benchmark.h>
+
+#include "column/column_helper.h"
+#include "common/config.h"
+#include "runtime/memory/chunk_allocator.h"
+#include "runtime/vectorized/time_types.h"
+#include "util/cpu_info.h"
+#include "util/logging.h"
+#include "util/mem_info.h"
+
+// The benchmarks do not depend on the services of ExecEnv, so it is not initialized.
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    // Use the default configs unless STARROCKS_HOME is set.
+    std::string conffile;
+    if (getenv("STARROCKS_HOME") != nullptr) {
+        conffile = std::string(getenv("STARROCKS_HOME")) + "/conf/be.conf";
+    }
+    if (!starrocks::config::init(conffile.empty() ? nullptr : conffile.c_str(), false)) {
+        fprintf(stderr, "error read config file. \n");
+        return -1;
+    }
+
+    starrocks::init_glog("be_benchmark", true);
+    starrocks::CpuInfo::init();
+    starrocks::MemInfo::init();
+    starrocks::vectorized::ColumnHelper::init_static_variable();
+    starrocks::vectorized::date::init_date_cache();
+    starrocks::ChunkAllocator::init_instance(starrocks::config::chunk_reserved_bytes_limit);
+
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
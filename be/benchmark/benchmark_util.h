@@ -0,0 +1,79 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "column/binary_column.h"
+#include "column/chunk.h"
+#include "column/fixed_length_column.h"
+
+namespace starrocks::vectorized {
+
+// Generates the data of benchmarks. The data only depends on the seed, so the results of different builds
+// and different runs are comparable.
+class DataGenerator {
+public:
+    explicit DataGenerator(uint32_t seed = 0) : _rng(seed) {}
+
+    // `num_rows` values uniformly distributed in [0, cardinality).
+    template <typename T>
+    std::vector<T> random_values(size_t num_rows, int64_t cardinality) {
+        std::uniform_int_distribution<int64_t> dist(0, std::max<int64_t>(cardinality, 1) - 1);
+        std::vector<T> values(num_rows);
+        for (auto& value : values) {
+            value = static_cast<T>(dist(_rng));
+        }
+        return values;
+    }
+
+    // [0, num_rows) in random order.
+    template <typename T>
+    std::vector<T> shuffled_values(size_t num_rows) {
+        std::vector<T> values(num_rows);
+        for (size_t i = 0; i < num_rows; ++i) {
+            values[i] = static_cast<T>(i);
+        }
+        std::shuffle(values.begin(), values.end(), _rng);
+        return values;
+    }
+
+    // The string of a number, padded to at least `length` bytes, so that equal numbers give equal strings.
+    static std::string to_string(int64_t value, size_t length) {
+        std::string str = std::to_string(value);
+        if (str.size() < length) {
+            str.append(length - str.size(), 'x');
+        }
+        return str;
+    }
+
+    template <typename T>
+    static ColumnPtr to_column(const std::vector<T>& values) {
+        auto column = FixedLengthColumn<T>::create();
+        column->get_data().assign(values.begin(), values.end());
+        return column;
+    }
+
+    static ColumnPtr to_binary_column(const std::vector<int64_t>& values, size_t length) {
+        auto column = BinaryColumn::create();
+        for (int64_t value : values) {
+            column->append_string(to_string(value, length));
+        }
+        return column;
+    }
+
+private:
+    std::mt19937_64 _rng;
+};
+
+// A deep copy of the chunk, for the operators modifying or taking over their input.
+inline ChunkPtr copy_chunk(const Chunk& chunk) {
+    ChunkPtr copy = chunk.clone_empty_with_slot(chunk.num_rows());
+    copy->append(chunk);
+    return copy;
+}
+
+} // namespace starrocks::vectorized
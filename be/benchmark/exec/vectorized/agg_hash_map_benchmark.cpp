@@ -0,0 +1,72 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include <benchmark/benchmark.h>
+
+#include "benchmark_util.h"
+#include "common/config.h"
+#include "exec/vectorized/aggregate/agg_hash_variant.h"
+#include "runtime/mem_pool.h"
+
+namespace starrocks::vectorized {
+
+static constexpr size_t kNumChunks = 64;
+static constexpr size_t kStringKeyLength = 16;
+
+// Feed kNumChunks chunks of keys with the given number of distinct keys into a new hash map variant
+// in every iteration, like the update phase of an aggregate with one group by key.
+static void BM_AggHashMapUpdate(benchmark::State& state, HashMapVariant::Type type) {
+    const size_t chunk_size = config::vector_chunk_size;
+    const int64_t cardinality = state.range(0);
+    const bool is_string = type == HashMapVariant::Type::phase1_string || type == HashMapVariant::Type::phase1_slice;
+
+    DataGenerator generator;
+    std::vector<Columns> key_columns;
+    for (size_t i = 0; i < kNumChunks; ++i) {
+        auto values = generator.random_values<int64_t>(chunk_size, cardinality);
+        if (is_string) {
+            key_columns.emplace_back(Columns{DataGenerator::to_binary_column(values, kStringKeyLength)});
+        } else if (type == HashMapVariant::Type::phase1_int32) {
+            key_columns.emplace_back(
+                    Columns{DataGenerator::to_column(std::vector<int32_t>(values.begin(), values.end()))});
+        } else {
+            key_columns.emplace_back(Columns{DataGenerator::to_column(values)});
+        }
+    }
+
+    // All the keys share one state, only the hash map is measured.
+    int64_t agg_state = 0;
+    auto allocate_func = [&agg_state]() { return reinterpret_cast<AggDataPtr>(&agg_state); };
+    Buffer<AggDataPtr> agg_states(chunk_size);
+    for (auto _ : state) {
+        MemPool mem_pool;
+        HashMapVariant variant;
+        variant.init(type);
+        for (const auto& columns : key_columns) {
+            switch (type) {
+#define M(NAME)                                                                                        \
+    case HashMapVariant::Type::NAME:                                                                   \
+        variant.NAME->compute_agg_states(chunk_size, columns, &mem_pool, allocate_func, &agg_states); \
+        break;
+                M(phase1_int32)
+                M(phase1_int64)
+                M(phase1_string)
+                M(phase1_slice)
+                M(phase1_int32_two_level)
+#undef M
+            default:
+                CHECK(false) << "unsupported hash map type";
+            }
+        }
+        benchmark::DoNotOptimize(variant.size());
+    }
+    state.SetItemsProcessed(state.iterations() * chunk_size * kNumChunks);
+}
+
+BENCHMARK_CAPTURE(BM_AggHashMapUpdate, int32, HashMapVariant::Type::phase1_int32)->Range(16, 1 << 20);
+BENCHMARK_CAPTURE(BM_AggHashMapUpdate, int32_two_level, HashMapVariant::Type::phase1_int32_two_level)
+        ->Range(16, 1 << 20);
+BENCHMARK_CAPTURE(BM_AggHashMapUpdate, int64, HashMapVariant::Type::phase1_int64)->Range(16, 1 << 20);
+BENCHMARK_CAPTURE(BM_AggHashMapUpdate, string, HashMapVariant::Type::phase1_string)->Range(16, 1 << 20);
+BENCHMARK_CAPTURE(BM_AggHashMapUpdate, serialized, HashMapVariant::Type::phase1_slice)->Range(16, 1 << 20);
+
+} // namespace starrocks::vectorized
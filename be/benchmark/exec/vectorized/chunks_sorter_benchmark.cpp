@@ -0,0 +1,125 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include <benchmark/benchmark.h>
+
+#include "benchmark_util.h"
+#include "common/config.h"
+#include "exec/vectorized/chunks_sorter_full_sort.h"
+#include "exec/vectorized/chunks_sorter_topn.h"
+#include "exprs/expr_context.h"
+#include "exprs/slot_ref.h"
+
+namespace starrocks::vectorized {
+
+static constexpr size_t kStringLength = 16;
+
+// Chunks with an int column in slot 0, a bigint column in slot 1 and a varchar column in slot 2,
+// the values are random, and the ints have many duplicates so that the later columns are compared too.
+class ChunksSorterBenchmark {
+public:
+    explicit ChunksSorterBenchmark(size_t num_rows)
+            : _int_ref(TypeDescriptor(TYPE_INT), 0, 0),
+              _bigint_ref(TypeDescriptor(TYPE_BIGINT), 0, 1),
+              _varchar_ref(TypeDescriptor(TYPE_VARCHAR), 0, 2),
+              _int_ctx(&_int_ref),
+              _bigint_ctx(&_bigint_ref),
+              _varchar_ctx(&_varchar_ref) {
+        DataGenerator generator;
+        const size_t chunk_size = config::vector_chunk_size;
+        for (size_t offset = 0; offset < num_rows; offset += chunk_size) {
+            const size_t n = std::min(chunk_size, num_rows - offset);
+            auto chunk = std::make_shared<Chunk>();
+            chunk->append_column(DataGenerator::to_column(generator.random_values<int32_t>(n, 100)), 0);
+            chunk->append_column(DataGenerator::to_column(generator.random_values<int64_t>(n, num_rows)), 1);
+            chunk->append_column(
+                    DataGenerator::to_binary_column(generator.random_values<int64_t>(n, num_rows), kStringLength), 2);
+            _chunks.emplace_back(std::move(chunk));
+        }
+    }
+
+    // Order by the first `num_columns` columns.
+    std::vector<ExprContext*>* sort_exprs(size_t num_columns) {
+        _sort_exprs.assign({&_int_ctx, &_bigint_ctx, &_varchar_ctx});
+        _sort_exprs.resize(num_columns);
+        _is_asc.assign(num_columns, true);
+        _is_null_first.assign(num_columns, true);
+        return &_sort_exprs;
+    }
+
+    template <typename Sorter>
+    size_t sort(Sorter* sorter, benchmark::State& state) {
+        for (const auto& chunk : _chunks) {
+            // The sorter may take over the columns of the input chunk.
+            state.PauseTiming();
+            ChunkPtr copy = copy_chunk(*chunk);
+            state.ResumeTiming();
+            CHECK(sorter->update(nullptr, copy).ok());
+        }
+        CHECK(sorter->done(nullptr).ok());
+        size_t num_rows = 0;
+        bool eos = false;
+        while (!eos) {
+            ChunkPtr output;
+            sorter->get_next(&output, &eos);
+            if (output != nullptr) {
+                num_rows += output->num_rows();
+            }
+        }
+        return num_rows;
+    }
+
+    const std::vector<bool>* is_asc() const { return &_is_asc; }
+    const std::vector<bool>* is_null_first() const { return &_is_null_first; }
+
+private:
+    SlotRef _int_ref;
+    SlotRef _bigint_ref;
+    SlotRef _varchar_ref;
+    ExprContext _int_ctx;
+    ExprContext _bigint_ctx;
+    ExprContext _varchar_ctx;
+    std::vector<ExprContext*> _sort_exprs;
+    std::vector<bool> _is_asc;
+    std::vector<bool> _is_null_first;
+    std::vector<ChunkPtr> _chunks;
+};
+
+static void BM_ChunksSorterFullSort(benchmark::State& state) {
+    const size_t num_rows = state.range(0);
+    const size_t num_columns = state.range(1);
+    ChunksSorterBenchmark bench(num_rows);
+    for (auto _ : state) {
+        ChunksSorterFullSort sorter(bench.sort_exprs(num_columns), bench.is_asc(), bench.is_null_first(), 1024);
+        benchmark::DoNotOptimize(bench.sort(&sorter, state));
+    }
+    state.SetItemsProcessed(state.iterations() * num_rows);
+}
+
+static void BM_ChunksSorterTopn(benchmark::State& state) {
+    const size_t num_rows = state.range(0);
+    const size_t limit = state.range(1);
+    ChunksSorterBenchmark bench(num_rows);
+    for (auto _ : state) {
+        ChunksSorterTopn sorter(bench.sort_exprs(2), bench.is_asc(), bench.is_null_first(), 0, limit);
+        benchmark::DoNotOptimize(bench.sort(&sorter, state));
+    }
+    state.SetItemsProcessed(state.iterations() * num_rows);
+}
+
+// {number of rows, number of sort columns}
+BENCHMARK(BM_ChunksSorterFullSort)
+        ->Args({1 << 16, 1})
+        ->Args({1 << 16, 2})
+        ->Args({1 << 16, 3})
+        ->Args({1 << 20, 1})
+        ->Args({1 << 20, 2})
+        ->Args({1 << 20, 3});
+// {number of rows, limit}
+BENCHMARK(BM_ChunksSorterTopn)
+        ->Args({1 << 16, 10})
+        ->Args({1 << 16, 1000})
+        ->Args({1 << 20, 10})
+        ->Args({1 << 20, 1000})
+        ->Args({1 << 20, 100000});
+
+} // namespace starrocks::vectorized
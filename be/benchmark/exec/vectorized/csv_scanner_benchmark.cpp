@@ -0,0 +1,122 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+#include "benchmark_util.h"
+#include "common/object_pool.h"
+#include "exec/vectorized/csv_scanner.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/descriptors.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::vectorized {
+
+static constexpr size_t kStringLength = 24;
+
+// A local csv file of random rows with an int, a bigint, a double, a varchar and a date column,
+// which is parsed by a new CSVScanner in every iteration.
+class CSVScannerBenchmark {
+public:
+    explicit CSVScannerBenchmark(size_t num_rows)
+            : _path(std::filesystem::temp_directory_path() / "starrocks_csv_scanner_benchmark.csv") {
+        DataGenerator generator;
+        auto ints = generator.random_values<int32_t>(num_rows, 1 << 30);
+        auto bigints = generator.random_values<int64_t>(num_rows, 1L << 60);
+        auto doubles = generator.random_values<int64_t>(num_rows, 1 << 30);
+        auto strings = generator.random_values<int64_t>(num_rows, num_rows);
+        auto days = generator.random_values<int32_t>(num_rows, 28);
+        std::ofstream out(_path);
+        for (size_t i = 0; i < num_rows; ++i) {
+            out << ints[i] << '|' << bigints[i] << '|' << doubles[i] / 1000.0 << '|'
+                << DataGenerator::to_string(strings[i], kStringLength) << '|' << "2021-02-" << (days[i] + 1) << '\n';
+        }
+        CHECK(out.good());
+
+        _types.emplace_back(TYPE_INT);
+        _types.emplace_back(TYPE_BIGINT);
+        _types.emplace_back(TYPE_DOUBLE);
+        _types.emplace_back(TypeDescriptor::create_varchar_type(kStringLength * 2));
+        _types.emplace_back(TYPE_DATE);
+
+        TDescriptorTableBuilder desc_tbl_builder;
+        TTupleDescriptorBuilder tuple_desc_builder;
+        for (auto& type : _types) {
+            TSlotDescriptorBuilder slot_desc_builder;
+            slot_desc_builder.type(type).length(type.len).precision(type.precision).scale(type.scale).nullable(true);
+            tuple_desc_builder.add_slot(slot_desc_builder.build());
+        }
+        tuple_desc_builder.build(&desc_tbl_builder);
+        CHECK(DescriptorTbl::create(&_pool, desc_tbl_builder.desc_tbl(), &_desc_tbl).ok());
+
+        _scan_range.params.row_delimiter = '\n';
+        _scan_range.params.column_separator = '|';
+        _scan_range.params.strict_mode = true;
+        _scan_range.params.dest_tuple_id = 0;
+        _scan_range.params.src_tuple_id = 0;
+        for (int i = 0; i < static_cast<int>(_types.size()); i++) {
+            TExprNode node;
+            node.__set_type(_types[i].to_thrift());
+            node.__set_node_type(TExprNodeType::SLOT_REF);
+            node.__set_is_nullable(true);
+            node.__set_slot_ref(TSlotRef());
+            node.slot_ref.__set_slot_id(i);
+            _scan_range.params.expr_of_dest_slot[i].nodes.emplace_back(node);
+            _scan_range.params.src_slot_ids.emplace_back(i);
+        }
+        TBrokerRangeDesc range;
+        range.__set_path(_path);
+        range.__set_start_offset(0);
+        range.__set_file_type(TFileType::FILE_LOCAL);
+        range.__set_format_type(TFileFormatType::FORMAT_CSV_PLAIN);
+        range.__set_num_of_columns_from_file(_types.size());
+        _scan_range.ranges.emplace_back(range);
+        _scan_range.broker_addresses.emplace_back();
+    }
+
+    ~CSVScannerBenchmark() { std::remove(_path.c_str()); }
+
+    size_t scan() {
+        RuntimeState state(TUniqueId(), TQueryOptions(), TQueryGlobals(), nullptr);
+        state.set_desc_tbl(_desc_tbl);
+        CHECK(state.init_instance_mem_tracker().ok());
+        RuntimeProfile profile("CSVScannerBenchmark");
+        ScannerCounter counter;
+        CSVScanner scanner(&state, &profile, _scan_range, &counter);
+        CHECK(scanner.open().ok());
+        size_t num_rows = 0;
+        while (true) {
+            auto res = scanner.get_next();
+            if (!res.ok()) {
+                CHECK(res.status().is_end_of_file()) << res.status().to_string();
+                break;
+            }
+            num_rows += res.value()->num_rows();
+        }
+        scanner.close();
+        return num_rows;
+    }
+
+private:
+    std::string _path;
+    std::vector<TypeDescriptor> _types;
+    ObjectPool _pool;
+    DescriptorTbl* _desc_tbl = nullptr;
+    TBrokerScanRange _scan_range;
+};
+
+static void BM_CSVScanner(benchmark::State& state) {
+    const size_t num_rows = state.range(0);
+    CSVScannerBenchmark bench(num_rows);
+    for (auto _ : state) {
+        CHECK_EQ(num_rows, bench.scan());
+    }
+    state.SetItemsProcessed(state.iterations() * num_rows);
+}
+
+BENCHMARK(BM_CSVScanner)->Range(1 << 14, 1 << 20);
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,159 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include <benchmark/benchmark.h>
+
+#include "benchmark_util.h"
+#include "common/object_pool.h"
+#include "exec/vectorized/join_hash_map.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/mem_tracker.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::vectorized {
+
+static constexpr size_t kProbeChunkSize = 4096;
+static constexpr size_t kNumProbeChunks = 16;
+static constexpr size_t kStringKeyLength = 16;
+
+// Inner join on one key of the given type, both the probe side and the build side have a key column and
+// an int payload column. The build keys are unique, and a half of the probe rows find their matches.
+class JoinHashTableBenchmark {
+public:
+    JoinHashTableBenchmark(PrimitiveType key_type, size_t num_build_rows)
+            : _key_type(key_type),
+              _runtime_state(TUniqueId(), TQueryOptions(), TQueryGlobals(), nullptr),
+              _profile("JoinHashTableBenchmark") {
+        CHECK(_runtime_state.init_instance_mem_tracker().ok());
+        TDescriptorTableBuilder desc_tbl_builder;
+        add_tuple(&desc_tbl_builder); // probe tuple with slot 0 and 1
+        add_tuple(&desc_tbl_builder); // build tuple with slot 2 and 3
+        DescriptorTbl* desc_tbl = nullptr;
+        CHECK(DescriptorTbl::create(&_pool, desc_tbl_builder.desc_tbl(), &desc_tbl).ok());
+        _row_desc = _pool.add(new RowDescriptor(*desc_tbl, {0, 1}, {false, false}));
+        _probe_row_desc = _pool.add(new RowDescriptor(*desc_tbl, {0}, {false}));
+        _build_row_desc = _pool.add(new RowDescriptor(*desc_tbl, {1}, {false}));
+
+        _param.join_type = TJoinOp::INNER_JOIN;
+        _param.row_desc = _row_desc;
+        _param.probe_row_desc = _probe_row_desc;
+        _param.build_row_desc = _build_row_desc;
+        _param.mem_tracker = &_mem_tracker;
+        _param.join_keys.emplace_back(JoinKeyDesc{key_type, false});
+        _param.search_ht_timer = ADD_TIMER(&_profile, "SearchHashTableTimer");
+        _param.output_build_column_timer = ADD_TIMER(&_profile, "OutputBuildColumnTimer");
+        _param.output_probe_column_timer = ADD_TIMER(&_profile, "OutputProbeColumnTimer");
+        _param.output_tuple_column_timer = ADD_TIMER(&_profile, "OutputTupleColumnTimer");
+
+        DataGenerator generator;
+        _build_chunk = std::make_shared<Chunk>();
+        _build_chunk->append_column(create_key_column(generator.shuffled_values<int64_t>(num_build_rows)), 2);
+        _build_chunk->append_column(DataGenerator::to_column(generator.random_values<int32_t>(num_build_rows, 1000)),
+                                    3);
+        for (size_t i = 0; i < kNumProbeChunks; ++i) {
+            auto chunk = std::make_shared<Chunk>();
+            chunk->append_column(
+                    create_key_column(generator.random_values<int64_t>(kProbeChunkSize, num_build_rows * 2)), 0);
+            chunk->append_column(DataGenerator::to_column(generator.random_values<int32_t>(kProbeChunkSize, 1000)),
+                                 1);
+            _probe_chunks.emplace_back(std::move(chunk));
+        }
+    }
+
+    void build(JoinHashTable* hash_table) {
+        hash_table->create(_param);
+        CHECK(hash_table->append_chunk(&_runtime_state, _build_chunk).ok());
+        hash_table->get_key_columns().emplace_back(hash_table->get_build_chunk()->columns()[0]);
+        CHECK(hash_table->build(&_runtime_state).ok());
+    }
+
+    size_t probe(JoinHashTable* hash_table, benchmark::State& state) {
+        size_t num_output_rows = 0;
+        for (const auto& probe_chunk : _probe_chunks) {
+            // The probe may take over the columns of the probe chunk.
+            state.PauseTiming();
+            ChunkPtr chunk = copy_chunk(*probe_chunk);
+            Columns key_columns{chunk->get_column_by_slot_id(0)};
+            state.ResumeTiming();
+
+            bool has_remain = true;
+            while (has_remain) {
+                ChunkPtr output = std::make_shared<Chunk>();
+                CHECK(hash_table->probe(key_columns, &chunk, &output, &has_remain).ok());
+                num_output_rows += output->num_rows();
+            }
+        }
+        return num_output_rows;
+    }
+
+    size_t num_build_rows() const { return _build_chunk->num_rows(); }
+
+private:
+    void add_tuple(TDescriptorTableBuilder* desc_tbl_builder) const {
+        TSlotDescriptorBuilder key_builder;
+        if (_key_type == TYPE_VARCHAR) {
+            key_builder.string_type(255);
+        } else {
+            key_builder.type(_key_type);
+        }
+        TTupleDescriptorBuilder tuple_builder;
+        tuple_builder.add_slot(key_builder.column_name("k").column_pos(0).nullable(false).build());
+        TSlotDescriptorBuilder value_builder;
+        tuple_builder.add_slot(value_builder.type(TYPE_INT).column_name("v").column_pos(1).nullable(false).build());
+        tuple_builder.build(desc_tbl_builder);
+    }
+
+    ColumnPtr create_key_column(const std::vector<int64_t>& values) const {
+        switch (_key_type) {
+        case TYPE_INT:
+            return DataGenerator::to_column(std::vector<int32_t>(values.begin(), values.end()));
+        case TYPE_BIGINT:
+            return DataGenerator::to_column(values);
+        default:
+            return DataGenerator::to_binary_column(values, kStringKeyLength);
+        }
+    }
+
+    PrimitiveType _key_type;
+    ObjectPool _pool;
+    RuntimeState _runtime_state;
+    RuntimeProfile _profile;
+    MemTracker _mem_tracker;
+    RowDescriptor* _row_desc = nullptr;
+    RowDescriptor* _probe_row_desc = nullptr;
+    RowDescriptor* _build_row_desc = nullptr;
+    HashTableParam _param;
+    ChunkPtr _build_chunk;
+    std::vector<ChunkPtr> _probe_chunks;
+};
+
+static void BM_JoinHashTableBuild(benchmark::State& state, PrimitiveType key_type) {
+    JoinHashTableBenchmark bench(key_type, state.range(0));
+    for (auto _ : state) {
+        JoinHashTable hash_table;
+        bench.build(&hash_table);
+        state.PauseTiming();
+        hash_table.close();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * bench.num_build_rows());
+}
+
+static void BM_JoinHashTableProbe(benchmark::State& state, PrimitiveType key_type) {
+    JoinHashTableBenchmark bench(key_type, state.range(0));
+    JoinHashTable hash_table;
+    bench.build(&hash_table);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(bench.probe(&hash_table, state));
+    }
+    state.SetItemsProcessed(state.iterations() * kProbeChunkSize * kNumProbeChunks);
+    hash_table.close();
+}
+
+BENCHMARK_CAPTURE(BM_JoinHashTableBuild, int32, TYPE_INT)->Range(1 << 12, 1 << 22);
+BENCHMARK_CAPTURE(BM_JoinHashTableBuild, int64, TYPE_BIGINT)->Range(1 << 12, 1 << 22);
+BENCHMARK_CAPTURE(BM_JoinHashTableBuild, varchar, TYPE_VARCHAR)->Range(1 << 12, 1 << 22);
+BENCHMARK_CAPTURE(BM_JoinHashTableProbe, int32, TYPE_INT)->Range(1 << 12, 1 << 22);
+BENCHMARK_CAPTURE(BM_JoinHashTableProbe, int64, TYPE_BIGINT)->Range(1 << 12, 1 << 22);
+BENCHMARK_CAPTURE(BM_JoinHashTableProbe, varchar, TYPE_VARCHAR)->Range(1 << 12, 1 << 22);
+
+} // namespace starrocks::vectorized
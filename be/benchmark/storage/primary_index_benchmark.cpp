@@ -0,0 +1,102 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include <benchmark/benchmark.h>
+
+#include "benchmark_util.h"
+#include "column/schema.h"
+#include "storage/primary_index.h"
+
+namespace starrocks {
+
+using vectorized::DataGenerator;
+
+static constexpr size_t kBatchSize = 4096;
+static constexpr size_t kStringKeyLength = 16;
+
+// The primary keys of a table with one key column of the given type, in batches of kBatchSize keys.
+class PrimaryIndexBenchmark {
+public:
+    explicit PrimaryIndexBenchmark(FieldType key_type) : _key_type(key_type) {
+        auto field = std::make_shared<vectorized::Field>(0, "k", key_type, false);
+        field->set_is_key(true);
+        _schema = std::make_unique<vectorized::Schema>(vectorized::Fields{field});
+    }
+
+    std::unique_ptr<PrimaryIndex> create_index() const { return TEST_create_primary_index(*_schema); }
+
+    // The keys in [0, num_keys) in random order.
+    std::vector<vectorized::ColumnPtr> unique_keys(size_t num_keys) {
+        return to_batches(_generator.shuffled_values<int64_t>(num_keys));
+    }
+
+    // `num_keys` keys randomly chosen from [0, cardinality).
+    std::vector<vectorized::ColumnPtr> random_keys(size_t num_keys, int64_t cardinality) {
+        return to_batches(_generator.random_values<int64_t>(num_keys, cardinality));
+    }
+
+private:
+    std::vector<vectorized::ColumnPtr> to_batches(const std::vector<int64_t>& values) const {
+        std::vector<vectorized::ColumnPtr> batches;
+        for (size_t offset = 0; offset < values.size(); offset += kBatchSize) {
+            std::vector<int64_t> batch(values.begin() + offset,
+                                       values.begin() + std::min(values.size(), offset + kBatchSize));
+            if (_key_type == OLAP_FIELD_TYPE_VARCHAR) {
+                batches.emplace_back(DataGenerator::to_binary_column(batch, kStringKeyLength));
+            } else {
+                batches.emplace_back(DataGenerator::to_column(batch));
+            }
+        }
+        return batches;
+    }
+
+    FieldType _key_type;
+    std::unique_ptr<vectorized::Schema> _schema;
+    DataGenerator _generator;
+};
+
+// Load the keys of a table into a new index, like the first load of the index of a tablet.
+static void BM_PrimaryIndexInsert(benchmark::State& state, FieldType key_type) {
+    const size_t num_keys = state.range(0);
+    PrimaryIndexBenchmark bench(key_type);
+    auto batches = bench.unique_keys(num_keys);
+    for (auto _ : state) {
+        auto index = bench.create_index();
+        for (uint32_t i = 0; i < batches.size(); ++i) {
+            CHECK(index->insert(i, 0, *batches[i]).ok());
+        }
+        state.PauseTiming();
+        index.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * num_keys);
+}
+
+// Upsert random keys of an index with `num_keys` keys, every key upserted already exists.
+static void BM_PrimaryIndexUpsert(benchmark::State& state, FieldType key_type) {
+    const size_t num_keys = state.range(0);
+    PrimaryIndexBenchmark bench(key_type);
+    auto index = bench.create_index();
+    auto batches = bench.unique_keys(num_keys);
+    uint32_t rssid = 0;
+    for (; rssid < batches.size(); ++rssid) {
+        CHECK(index->insert(rssid, 0, *batches[rssid]).ok());
+    }
+    auto updates = bench.random_keys(kBatchSize * 16, num_keys);
+    PrimaryIndex::DeletesMap deletes;
+    for (auto _ : state) {
+        for (const auto& batch : updates) {
+            index->upsert(rssid++, 0, *batch, &deletes);
+        }
+        state.PauseTiming();
+        deletes.clear();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * kBatchSize * updates.size());
+}
+
+BENCHMARK_CAPTURE(BM_PrimaryIndexInsert, bigint, OLAP_FIELD_TYPE_BIGINT)->Range(1 << 16, 1 << 22);
+BENCHMARK_CAPTURE(BM_PrimaryIndexInsert, varchar, OLAP_FIELD_TYPE_VARCHAR)->Range(1 << 16, 1 << 22);
+BENCHMARK_CAPTURE(BM_PrimaryIndexUpsert, bigint, OLAP_FIELD_TYPE_BIGINT)->Range(1 << 16, 1 << 22);
+BENCHMARK_CAPTURE(BM_PrimaryIndexUpsert, varchar, OLAP_FIELD_TYPE_VARCHAR)->Range(1 << 16, 1 << 22);
+
+} // namespace starrocks
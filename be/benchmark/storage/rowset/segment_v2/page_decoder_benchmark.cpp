@@ -0,0 +1,92 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include <benchmark/benchmark.h>
+
+#include "benchmark_util.h"
+#include "column/binary_column.h"
+#include "column/fixed_length_column.h"
+#include "storage/rowset/segment_v2/binary_dict_page.h"
+#include "storage/rowset/segment_v2/binary_plain_page.h"
+#include "storage/rowset/segment_v2/bitshuffle_page.h"
+#include "storage/rowset/segment_v2/options.h"
+#include "storage/types.h"
+
+namespace starrocks::segment_v2 {
+
+using vectorized::DataGenerator;
+
+static constexpr size_t kStringLength = 16;
+
+// Decode a whole bitshuffle page of random numbers into a column.
+template <FieldType Type>
+static void BM_BitshufflePageDecode(benchmark::State& state) {
+    using CppType = typename TypeTraits<Type>::CppType;
+    const size_t num_rows = state.range(0);
+    DataGenerator generator;
+    auto values = generator.random_values<CppType>(num_rows, 1 << 20);
+
+    PageBuilderOptions options;
+    options.data_page_size = num_rows * sizeof(CppType) * 2;
+    BitshufflePageBuilder<Type> builder(options);
+    CHECK_EQ(num_rows, builder.add(reinterpret_cast<const uint8_t*>(values.data()), num_rows));
+    OwnedSlice page = builder.finish()->build();
+
+    auto column = vectorized::FixedLengthColumn<CppType>::create();
+    PageDecoderOptions decoder_options;
+    for (auto _ : state) {
+        BitShufflePageDecoder<Type> decoder(page.slice(), decoder_options);
+        CHECK(decoder.init().ok());
+        column->reset_column();
+        size_t n = num_rows;
+        CHECK(decoder.next_batch(&n, column.get()).ok());
+        benchmark::DoNotOptimize(column->get_data().data());
+    }
+    state.SetItemsProcessed(state.iterations() * num_rows);
+}
+
+// Decode a whole dict page of random strings with the given number of distinct values into a column.
+static void BM_BinaryDictPageDecode(benchmark::State& state) {
+    const size_t num_rows = state.range(0);
+    const int64_t cardinality = state.range(1);
+    DataGenerator generator;
+    std::vector<std::string> strings;
+    strings.reserve(num_rows);
+    for (int64_t value : generator.random_values<int64_t>(num_rows, cardinality)) {
+        strings.emplace_back(DataGenerator::to_string(value, kStringLength));
+    }
+    std::vector<Slice> slices(strings.begin(), strings.end());
+
+    PageBuilderOptions options;
+    options.data_page_size = 4 * 1024 * 1024;
+    options.dict_page_size = 4 * 1024 * 1024;
+    BinaryDictPageBuilder builder(options);
+    CHECK_EQ(num_rows, builder.add(reinterpret_cast<const uint8_t*>(slices.data()), num_rows));
+    OwnedSlice page = builder.finish()->build();
+    OwnedSlice dict_page = builder.get_dictionary_page()->build();
+
+    PageDecoderOptions decoder_options;
+    BinaryPlainPageDecoder<OLAP_FIELD_TYPE_VARCHAR> dict_decoder(dict_page.slice(), decoder_options);
+    CHECK(dict_decoder.init().ok());
+
+    auto column = vectorized::BinaryColumn::create();
+    for (auto _ : state) {
+        BinaryDictPageDecoder<OLAP_FIELD_TYPE_VARCHAR> decoder(page.slice(), decoder_options);
+        decoder.set_dict_decoder(&dict_decoder);
+        CHECK(decoder.init().ok());
+        column->reset_column();
+        size_t n = num_rows;
+        CHECK(decoder.next_batch(&n, column.get()).ok());
+        benchmark::DoNotOptimize(column->get_bytes().data());
+    }
+    state.SetItemsProcessed(state.iterations() * num_rows);
+}
+
+BENCHMARK_TEMPLATE(BM_BitshufflePageDecode, OLAP_FIELD_TYPE_INT)->Range(1 << 10, 1 << 16);
+BENCHMARK_TEMPLATE(BM_BitshufflePageDecode, OLAP_FIELD_TYPE_BIGINT)->Range(1 << 10, 1 << 16);
+// {number of rows, number of distinct values}
+BENCHMARK(BM_BinaryDictPageDecode)
+        ->Args({1 << 16, 16})
+        ->Args({1 << 16, 1024})
+        ->Args({1 << 16, 65536});
+
+} // namespace starrocks::segment_v2
@@ -69,6 +69,15 @@ std::mutex TaskWorkerPool::_s_task_signatures_lock;
 std::map<TTaskType::type, std::set<int64_t>> TaskWorkerPool::_s_task_signatures;
 FrontendServiceClientCache TaskWorkerPool::_master_service_client_cache;
 
+struct TaskWorkerPool::FinishTaskBatch {
+    std::vector<TFinishTaskRequest> requests;
+    bool sent = false;
+};
+
+std::mutex TaskWorkerPool::_s_finish_batch_lock;
+std::condition_variable TaskWorkerPool::_s_finish_batch_cond;
+std::shared_ptr<TaskWorkerPool::FinishTaskBatch> TaskWorkerPool::_s_finish_batch;
+
 TaskWorkerPool::TaskWorkerPool(const TaskWorkerType task_worker_type, ExecEnv* env, const TMasterInfo& master_info,
                                int worker_count)
         : _master_info(master_info),
@@ -233,6 +242,67 @@ void TaskWorkerPool::_spawn_callback_worker_thread(CALLBACK_FUNCTION callback_fu
 }
 
 void TaskWorkerPool::_finish_task(const TFinishTaskRequest& finish_task_request) {
+    const int batch_size = config::agent_task_finish_batch_size;
+    if (batch_size <= 1) {
+        _send_finish_task(finish_task_request);
+        return;
+    }
+
+    std::shared_ptr<FinishTaskBatch> batch;
+    bool leader = false;
+    {
+        std::lock_guard l(_s_finish_batch_lock);
+        if (_s_finish_batch == nullptr) {
+            _s_finish_batch = std::make_shared<FinishTaskBatch>();
+            leader = true;
+        }
+        batch = _s_finish_batch;
+        batch->requests.push_back(finish_task_request);
+        if (batch->requests.size() >= static_cast<size_t>(batch_size)) {
+            _s_finish_batch_cond.notify_all();
+        }
+    }
+    if (leader) {
+        {
+            std::unique_lock l(_s_finish_batch_lock);
+            _s_finish_batch_cond.wait_for(l, std::chrono::milliseconds(config::agent_task_finish_batch_interval_ms),
+                                          [&] { return batch->requests.size() >= static_cast<size_t>(batch_size); });
+            // the tasks finished from now on go to the next batch.
+            _s_finish_batch.reset();
+        }
+        _send_finish_tasks(batch->requests);
+        {
+            std::lock_guard l(_s_finish_batch_lock);
+            batch->sent = true;
+        }
+        _s_finish_batch_cond.notify_all();
+    } else {
+        std::unique_lock l(_s_finish_batch_lock);
+        _s_finish_batch_cond.wait(l, [&] { return batch->sent; });
+    }
+}
+
+void TaskWorkerPool::_send_finish_tasks(const std::vector<TFinishTaskRequest>& finish_task_requests) {
+    if (finish_task_requests.size() == 1) {
+        _send_finish_task(finish_task_requests[0]);
+        return;
+    }
+    TFinishTasksRequest request;
+    request.__set_requests(finish_task_requests);
+    TFinishTasksResult result;
+    StarRocksMetrics::instance()->finish_task_requests_total.increment(1);
+    if (_master_client->finish_tasks(request, &result) == STARROCKS_SUCCESS) {
+        return;
+    }
+    // The FE may not support the batched report, or it failed, report the tasks one by one with retries.
+    StarRocksMetrics::instance()->finish_task_requests_failed.increment(1);
+    LOG(WARNING) << "finish " << finish_task_requests.size() << " tasks in batch failed, finish them one by one";
+    for (const auto& finish_task_request : finish_task_requests) {
+        _send_finish_task(finish_task_request);
+    }
+}
+
+void TaskWorkerPool::_send_finish_task(const TFinishTaskRequest& finish_task_request) {
     // Return result to FE
     TMasterResult result;
     uint32_t try_time = 0;
@@ -830,6 +900,12 @@ void* TaskWorkerPool::_update_tablet_meta_worker_thread_callback(void* arg_this)
     return (void*)nullptr;
 }
 
+// Whether the clones should run one at a time for the io util of the disks, which is refreshed by the daemon.
+static bool is_disk_busy_for_clone() {
+    const int64_t threshold = config::clone_busy_disk_io_util_percent;
+    return threshold > 0 && StarRocksMetrics::instance()->max_disk_io_util_percent.value() >= threshold;
+}
+
 void* TaskWorkerPool::_clone_worker_thread_callback(void* arg_this) {
     TaskWorkerPool* worker_pool_this = (TaskWorkerPool*)arg_this;
 
@@ -842,13 +918,16 @@ void* TaskWorkerPool::_clone_worker_thread_callback(void* arg_this) {
 
         {
             std::unique_lock l(worker_pool_this->_worker_thread_lock);
-            while (worker_pool_this->_tasks.empty()) {
-                worker_pool_this->_worker_thread_condition_variable->wait(l);
+            while (worker_pool_this->_tasks.empty() ||
+                   (worker_pool_this->_num_running_tasks > 0 && is_disk_busy_for_clone())) {
+                // wake up in a while to check whether the disks are still busy.
+                worker_pool_this->_worker_thread_condition_variable->wait_for(l, std::chrono::seconds(1));
             }
 
             agent_task_req = worker_pool_this->_tasks.front();
             clone_req = agent_task_req.clone_req;
             worker_pool_this->_tasks.pop_front();
+            ++worker_pool_this->_num_running_tasks;
         }
 
         StarRocksMetrics::instance()->clone_requests_total.increment(1);
@@ -916,6 +995,12 @@ void* TaskWorkerPool::_clone_worker_thread_callback(void* arg_this) {
             }
         }
 
+        {
+            std::lock_guard l(worker_pool_this->_worker_thread_lock);
+            --worker_pool_this->_num_running_tasks;
+        }
+        worker_pool_this->_worker_thread_condition_variable->notify_one();
+
         task_status.__set_status_code(status_code);
         task_status.__set_error_msgs(error_msgs);
         finish_task_request.__set_task_status(task_status);
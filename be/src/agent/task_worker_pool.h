@@ -89,7 +89,11 @@ private:
     bool _register_task_info(const TTaskType::type task_type, int64_t signature);
     void _remove_task_info(const TTaskType::type task_type, int64_t signature);
     void _spawn_callback_worker_thread(CALLBACK_FUNCTION callback_func);
+    // Report the finished task to FE, in a batch with the tasks of the other pools finished at about the same
+    // time if config::agent_task_finish_batch_size > 1. Returns once the report is sent.
     void _finish_task(const TFinishTaskRequest& finish_task_request);
+    void _send_finish_task(const TFinishTaskRequest& finish_task_request);
+    void _send_finish_tasks(const std::vector<TFinishTaskRequest>& finish_task_requests);
     uint32_t _get_next_task_index(int32_t thread_count, std::deque<TAgentTaskRequest>& tasks, TPriority::type priority);
 
     static void* _create_tablet_worker_thread_callback(void* arg_this);
@@ -132,6 +136,9 @@ private:
     std::condition_variable* _worker_thread_condition_variable;
     std::deque<TAgentTaskRequest> _tasks;
 
+    // the number of the tasks being run, only counted by the clone workers.
+    uint32_t _num_running_tasks = 0;
+
     uint32_t _worker_count = 0;
     TaskWorkerType _task_worker_type;
     CALLBACK_FUNCTION _callback_function;
@@ -142,6 +149,12 @@ private:
     static std::mutex _s_task_signatures_lock;
     static std::map<TTaskType::type, std::set<int64_t>> _s_task_signatures;
 
+    struct FinishTaskBatch;
+    static std::mutex _s_finish_batch_lock;
+    static std::condition_variable _s_finish_batch_cond;
+    // the batch collecting the finish reports, sent by the first task of the batch.
+    static std::shared_ptr<FinishTaskBatch> _s_finish_batch;
+
     TaskWorkerPool(const TaskWorkerPool&) = delete;
     const TaskWorkerPool& operator=(const TaskWorkerPool&) = delete;
 }; // class TaskWorkerPool
@@ -81,6 +81,43 @@ AgentStatus MasterServerClient::finish_task(const TFinishTaskRequest& request, T
     return STARROCKS_SUCCESS;
 }
 
+AgentStatus MasterServerClient::finish_tasks(const TFinishTasksRequest& request, TFinishTasksResult* result) {
+    Status client_status;
+    FrontendServiceConnection client(_client_cache, _master_info.network_address, config::thrift_rpc_timeout_ms,
+                                     &client_status);
+
+    if (!client_status.ok()) {
+        LOG(WARNING) << "Fail to get master client from cache. "
+                     << "host=" << _master_info.network_address.hostname
+                     << ", port=" << _master_info.network_address.port << ", code=" << client_status.code();
+        return STARROCKS_ERROR;
+    }
+
+    try {
+        try {
+            client->finishTasks(*result, request);
+        } catch (TTransportException& e) {
+            LOG(WARNING) << "master client, retry finishTasks: " << e.what();
+            client_status = client.reopen(config::thrift_rpc_timeout_ms);
+            if (!client_status.ok()) {
+                LOG(WARNING) << "Fail to get master client from cache. "
+                             << "host=" << _master_info.network_address.hostname
+                             << ", port=" << _master_info.network_address.port << ", code=" << client_status.code();
+                return STARROCKS_ERROR;
+            }
+            client->finishTasks(*result, request);
+        }
+    } catch (TException& e) {
+        client.reopen(config::thrift_rpc_timeout_ms);
+        LOG(WARNING) << "Fail to finish_tasks. "
+                     << "host=" << _master_info.network_address.hostname
+                     << ", port=" << _master_info.network_address.port << ", error=" << e.what();
+        return STARROCKS_ERROR;
+    }
+
+    return STARROCKS_SUCCESS;
+}
+
 AgentStatus MasterServerClient::report(const TReportRequest& request, TMasterResult* result) {
     Status client_status;
     FrontendServiceConnection client(_client_cache, _master_info.network_address, config::thrift_rpc_timeout_ms,
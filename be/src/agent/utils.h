@@ -45,6 +45,15 @@ public:
     // * result: The result of report task
     virtual AgentStatus finish_task(const TFinishTaskRequest& request, TMasterResult* result);
 
+    // Report several finished tasks to the master server in one rpc
+    //
+    // Input parameters:
+    // * request: The infomation of the finished tasks
+    //
+    // Output parameters:
+    // * result: The results of report tasks, in the order of the requests
+    virtual AgentStatus finish_tasks(const TFinishTasksRequest& request, TFinishTasksResult* result);
+
     // Report tasks/olap tablet/disk state to the master server
     //
     // Input parameters:
@@ -2,6 +2,7 @@
 
 #include "column/chunk.h"
 
+#include "column/column_encoder.h"
 #include "column/column_helper.h"
 #include "column/datum_tuple.h"
 #include "column/fixed_length_column.h"
@@ -151,7 +152,31 @@ void Chunk::serialize(uint8_t* dst) const {
     }
 }
 
-size_t Chunk::serialize_with_meta(starrocks::ChunkPB* chunk) const {
+size_t Chunk::max_encoded_size() const {
+    size_t size = 0;
+    for (const auto& column : _columns) {
+        size += ColumnEncoder::max_encoded_size(*column);
+    }
+    size += sizeof(uint32_t) + sizeof(uint32_t); // version + num rows
+    return size;
+}
+
+size_t Chunk::serialize_encoded(uint8_t* dst) const {
+    uint8_t* begin = dst;
+    uint32_t version = 2;
+    encode_fixed32_le(dst, version);
+    dst += sizeof(uint32_t);
+
+    encode_fixed32_le(dst, num_rows());
+    dst += sizeof(uint32_t);
+
+    for (const auto& column : _columns) {
+        dst = ColumnEncoder::encode(*column, dst);
+    }
+    return dst - begin;
+}
+
+size_t Chunk::serialize_with_meta(starrocks::ChunkPB* chunk, bool encoded) const {
     chunk->clear_slot_id_map();
     chunk->mutable_slot_id_map()->Reserve(static_cast<int>(_slot_id_to_index.size()) * 2);
     for (const auto& kv : _slot_id_to_index) {
@@ -180,6 +205,12 @@ size_t Chunk::serialize_with_meta(starrocks::ChunkPB* chunk) const {
 
     DCHECK_EQ(_columns.size(), _tuple_id_to_index.size() + _slot_id_to_index.size());
 
+    if (encoded) {
+        chunk->mutable_data()->resize(max_encoded_size());
+        size_t size = serialize_encoded((uint8_t*)chunk->mutable_data()->data());
+        chunk->mutable_data()->resize(size);
+        return size;
+    }
     size_t size = serialize_size();
     chunk->mutable_data()->resize(size);
     serialize((uint8_t*)chunk->mutable_data()->data());
@@ -191,8 +222,9 @@ Status Chunk::deserialize(const uint8_t* src, size_t len, const RuntimeChunkMeta
     _tuple_id_to_index = meta.tuple_id_to_index;
     _columns.resize(_slot_id_to_index.size() + _tuple_id_to_index.size());
 
+    const uint8_t* begin = src;
     uint32_t version = decode_fixed32_le(src);
-    DCHECK_EQ(version, 1);
+    DCHECK(version == 1 || version == 2) << version;
     src += sizeof(uint32_t);
 
     size_t rows = decode_fixed32_le(src);
@@ -202,6 +234,21 @@ Status Chunk::deserialize(const uint8_t* src, size_t len, const RuntimeChunkMeta
         _columns[i] = ColumnHelper::create_column(meta.types[i], meta.is_nulls[i], meta.is_consts[i], rows);
     }
 
+    if (version == 2) {
+        for (const auto& column : _columns) {
+            src = ColumnEncoder::decode(src, column.get());
+            if (UNLIKELY(src == nullptr)) {
+                return Status::InternalError("deserialize chunk data failed. corrupted encoded column");
+            }
+        }
+        if (UNLIKELY(src != begin + len)) {
+            return Status::InternalError(
+                    strings::Substitute("deserialize chunk data failed. len: $0, except: $1", len, src - begin));
+        }
+        DCHECK_EQ(rows, num_rows());
+        return Status::OK();
+    }
+
     for (const auto& column : _columns) {
         src = column->deserialize_column(src);
     }
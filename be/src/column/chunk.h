@@ -106,9 +106,10 @@ public:
     // The size for serialize chunk meta and chunk data
     size_t serialize_size() const;
 
-    // Serialize chunk data and meta to ChunkPB
+    // Serialize chunk data and meta to ChunkPB, the chunk data is serialized by serialize_encoded()
+    // if |encoded| is true.
     // The result value is the chunk data serialize size
-    size_t serialize_with_meta(starrocks::ChunkPB* chunk) const;
+    size_t serialize_with_meta(starrocks::ChunkPB* chunk, bool encoded = false) const;
 
     // Only serialize chunk data to dst
     // The serialize format:
@@ -121,7 +122,16 @@ public:
     // Note: You should ensure the dst buffer size is enough
     void serialize(uint8_t* dst) const;
 
-    // Deserialize chunk by |src| (chunk data) and |meta| (chunk meta)
+    // The upper bound of the size of serialize_encoded()
+    size_t max_encoded_size() const;
+
+    // Serialize chunk data to dst with the format of version 2, which is the same as the above one
+    // except that every column is encoded by ColumnEncoder.
+    // The result value is the serialize size
+    // Note: You should ensure the dst buffer size is at least max_encoded_size()
+    size_t serialize_encoded(uint8_t* dst) const;
+
+    // Deserialize chunk by |src| (chunk data of version 1 or 2) and |meta| (chunk meta)
     Status deserialize(const uint8_t* src, size_t len, const RuntimeChunkMeta& meta);
 
     // Create an empty chunk with the same meta and reserve it of size chunk _num_rows
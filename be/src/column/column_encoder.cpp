@@ -0,0 +1,344 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "column/column_encoder.h"
+
+#include <type_traits>
+
+#include "column/binary_column.h"
+#include "column/column_hash.h"
+#include "column/const_column.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "gutil/strings/fastmem.h"
+#include "util/bit_packing.inline.h"
+#include "util/coding.h"
+#include "util/phmap/phmap.h"
+
+namespace starrocks::vectorized {
+
+static constexpr uint8_t PLAIN_ENCODING = 0;
+static constexpr uint8_t FOR_ENCODING = 1;
+static constexpr uint8_t DICT_ENCODING = 2;
+
+// The distinct values of the leading rows are counted to decide whether to try dictionary encoding.
+static constexpr size_t DICT_SAMPLE_ROWS = 1024;
+
+static size_t bit_packed_size(size_t num_values, int bit_width) {
+    return (num_values * bit_width + 7) / 8;
+}
+
+// Pack the lowest |bit_width| bits of |values| in little endian order, as BitPacking::UnpackValues expects.
+// |bit_width| must be at most 32.
+template <typename T>
+static uint8_t* bit_pack(const T* values, size_t num_values, int bit_width, uint8_t* dst) {
+    DCHECK_LE(bit_width, 32);
+    uint64_t buffer = 0;
+    int num_bits = 0;
+    for (size_t i = 0; i < num_values; ++i) {
+        buffer |= static_cast<uint64_t>(values[i]) << num_bits;
+        num_bits += bit_width;
+        while (num_bits >= 8) {
+            *dst++ = static_cast<uint8_t>(buffer);
+            buffer >>= 8;
+            num_bits -= 8;
+        }
+    }
+    if (num_bits > 0) {
+        *dst++ = static_cast<uint8_t>(buffer);
+    }
+    return dst;
+}
+
+// The format of integers:
+//  PLAIN: encoding(1 byte) num_values(4 bytes) values
+//  FOR: encoding(1 byte) num_values(4 bytes) min_value(sizeof(T) bytes) bit_width(1 byte) bit-packed offsets
+template <typename T>
+static size_t max_integers_encoded_size(size_t num_values) {
+    return sizeof(uint8_t) + sizeof(uint32_t) + num_values * sizeof(T);
+}
+
+template <typename T>
+static int integers_bit_width(const T* values, size_t num_values, T* min_value) {
+    using UnsignedT = std::make_unsigned_t<T>;
+    T min = values[0];
+    T max = values[0];
+    for (size_t i = 1; i < num_values; ++i) {
+        min = std::min(min, values[i]);
+        max = std::max(max, values[i]);
+    }
+    *min_value = min;
+    auto range = static_cast<uint64_t>(static_cast<UnsignedT>(static_cast<UnsignedT>(max) - min));
+    return range == 0 ? 0 : 64 - __builtin_clzll(range);
+}
+
+template <typename T>
+static size_t integers_encoded_size(size_t num_values, int bit_width) {
+    if (bit_width > 32) {
+        return max_integers_encoded_size<T>(num_values);
+    }
+    size_t for_size = sizeof(uint8_t) + sizeof(uint32_t) + sizeof(T) + sizeof(uint8_t) +
+                      bit_packed_size(num_values, bit_width);
+    return std::min(for_size, max_integers_encoded_size<T>(num_values));
+}
+
+template <typename T>
+static uint8_t* encode_integers(const T* values, size_t num_values, uint8_t* dst) {
+    using UnsignedT = std::make_unsigned_t<T>;
+    T min_value = 0;
+    int bit_width = num_values > 0 ? integers_bit_width(values, num_values, &min_value) : 0;
+    if (integers_encoded_size<T>(num_values, bit_width) >= max_integers_encoded_size<T>(num_values)) {
+        *dst++ = PLAIN_ENCODING;
+        encode_fixed32_le(dst, num_values);
+        dst += sizeof(uint32_t);
+        strings::memcpy_inlined(dst, values, num_values * sizeof(T));
+        return dst + num_values * sizeof(T);
+    }
+
+    *dst++ = FOR_ENCODING;
+    encode_fixed32_le(dst, num_values);
+    dst += sizeof(uint32_t);
+    memcpy(dst, &min_value, sizeof(T));
+    dst += sizeof(T);
+    *dst++ = static_cast<uint8_t>(bit_width);
+    std::vector<uint32_t> offsets(num_values);
+    for (size_t i = 0; i < num_values; ++i) {
+        offsets[i] = static_cast<UnsignedT>(static_cast<UnsignedT>(values[i]) - min_value);
+    }
+    return bit_pack(offsets.data(), num_values, bit_width, dst);
+}
+
+template <typename T>
+static const uint8_t* decode_integers(const uint8_t* src, Buffer<T>* values) {
+    using UnsignedT = std::make_unsigned_t<T>;
+    uint8_t encoding = *src++;
+    size_t num_values = decode_fixed32_le(src);
+    src += sizeof(uint32_t);
+    values->resize(num_values);
+    if (encoding == PLAIN_ENCODING) {
+        strings::memcpy_inlined(values->data(), src, num_values * sizeof(T));
+        return src + num_values * sizeof(T);
+    }
+    if (UNLIKELY(encoding != FOR_ENCODING)) {
+        return nullptr;
+    }
+
+    T min_value;
+    memcpy(&min_value, src, sizeof(T));
+    src += sizeof(T);
+    int bit_width = *src++;
+    if (UNLIKELY(bit_width > 32)) {
+        return nullptr;
+    }
+    T* data = values->data();
+    if (bit_width == 0) {
+        std::fill(data, data + num_values, min_value);
+        return src;
+    }
+    size_t packed_size = bit_packed_size(num_values, bit_width);
+    std::vector<uint32_t> offsets(num_values);
+    BitPacking::UnpackValues(bit_width, src, packed_size, num_values, offsets.data());
+    for (size_t i = 0; i < num_values; ++i) {
+        data[i] = static_cast<T>(static_cast<UnsignedT>(min_value) + offsets[i]);
+    }
+    return src + packed_size;
+}
+
+using SliceToCode = phmap::flat_hash_map<Slice, uint32_t, SliceHashWithSeed<PhmapSeed1>, SliceEqual>;
+
+// Build the dictionary of |column| to |dict| and the code of every row to |codes|, return false if
+// dictionary encoding is not worth trying.
+static bool build_dict(const BinaryColumn& column, std::vector<Slice>* dict, std::vector<uint32_t>* codes) {
+    size_t num_rows = column.size();
+    size_t num_samples = std::min(num_rows, DICT_SAMPLE_ROWS);
+    size_t max_dict_size = num_rows / 4;
+    if (max_dict_size == 0) {
+        return false;
+    }
+    SliceToCode slice_to_code;
+    codes->resize(num_rows);
+    for (size_t i = 0; i < num_rows; ++i) {
+        Slice value = column.get_slice(i);
+        auto [iter, inserted] = slice_to_code.emplace(value, dict->size());
+        if (inserted) {
+            dict->emplace_back(value);
+            if ((i < num_samples && dict->size() * 4 > num_samples) || dict->size() > max_dict_size) {
+                return false;
+            }
+        }
+        (*codes)[i] = iter->second;
+    }
+    return true;
+}
+
+// The format of strings:
+//  PLAIN: encoding(1 byte) BinaryColumn::serialize_column()
+//  DICT: encoding(1 byte) dict_size(4 bytes) (length(4 bytes) value) * dict_size codes(as integers)
+static uint8_t* encode_binary(const BinaryColumn& column, uint8_t* dst) {
+    std::vector<Slice> dict;
+    std::vector<uint32_t> codes;
+    if (build_dict(column, &dict, &codes)) {
+        size_t dict_size = sizeof(uint8_t) + sizeof(uint32_t);
+        for (const auto& value : dict) {
+            dict_size += sizeof(uint32_t) + value.size;
+        }
+        int bit_width = dict.size() <= 1 ? 0 : 64 - __builtin_clzll(dict.size() - 1);
+        if (dict_size + integers_encoded_size<uint32_t>(codes.size(), bit_width) < column.serialize_size()) {
+            *dst++ = DICT_ENCODING;
+            encode_fixed32_le(dst, dict.size());
+            dst += sizeof(uint32_t);
+            for (const auto& value : dict) {
+                encode_fixed32_le(dst, value.size);
+                dst += sizeof(uint32_t);
+                strings::memcpy_inlined(dst, value.data, value.size);
+                dst += value.size;
+            }
+            return encode_integers(codes.data(), codes.size(), dst);
+        }
+    }
+    *dst++ = PLAIN_ENCODING;
+    return const_cast<BinaryColumn&>(column).serialize_column(dst);
+}
+
+static const uint8_t* decode_binary(const uint8_t* src, BinaryColumn* column) {
+    uint8_t encoding = *src++;
+    if (encoding == PLAIN_ENCODING) {
+        return column->deserialize_column(src);
+    }
+    if (UNLIKELY(encoding != DICT_ENCODING)) {
+        return nullptr;
+    }
+
+    size_t dict_size = decode_fixed32_le(src);
+    src += sizeof(uint32_t);
+    std::vector<Slice> dict(dict_size);
+    for (size_t i = 0; i < dict_size; ++i) {
+        size_t size = decode_fixed32_le(src);
+        src += sizeof(uint32_t);
+        dict[i] = Slice(src, size);
+        src += size;
+    }
+    Buffer<uint32_t> codes;
+    src = decode_integers(src, &codes);
+    if (UNLIKELY(src == nullptr)) {
+        return nullptr;
+    }
+
+    size_t num_rows = codes.size();
+    auto& offsets = column->get_offset();
+    offsets.resize(num_rows + 1);
+    offsets[0] = 0;
+    for (size_t i = 0; i < num_rows; ++i) {
+        if (UNLIKELY(codes[i] >= dict_size)) {
+            return nullptr;
+        }
+        offsets[i + 1] = offsets[i] + dict[codes[i]].size;
+    }
+    auto& bytes = column->get_bytes();
+    bytes.resize(offsets[num_rows]);
+    for (size_t i = 0; i < num_rows; ++i) {
+        const Slice& value = dict[codes[i]];
+        strings::memcpy_inlined(bytes.data() + offsets[i], value.data, value.size);
+    }
+    column->invalidate_slice_cache();
+    return src;
+}
+
+// The format of nullable columns: data column, has_null(1 byte), bit-packed null map if has_null
+static size_t max_nullable_encoded_size(const NullableColumn& column) {
+    return ColumnEncoder::max_encoded_size(*column.data_column()) + sizeof(uint8_t) + bit_packed_size(column.size(), 1);
+}
+
+static uint8_t* encode_nullable(const NullableColumn& column, uint8_t* dst) {
+    dst = ColumnEncoder::encode(*column.data_column(), dst);
+    *dst++ = column.has_null();
+    if (column.has_null()) {
+        dst = bit_pack(column.immutable_null_column_data().data(), column.size(), 1, dst);
+    }
+    return dst;
+}
+
+static const uint8_t* decode_nullable(const uint8_t* src, NullableColumn* column) {
+    src = ColumnEncoder::decode(src, column->mutable_data_column());
+    if (UNLIKELY(src == nullptr)) {
+        return nullptr;
+    }
+    size_t num_rows = column->data_column()->size();
+    auto& null_data = column->null_column_data();
+    null_data.assign(num_rows, 0);
+    bool has_null = *src++;
+    if (has_null) {
+        size_t packed_size = bit_packed_size(num_rows, 1);
+        BitPacking::UnpackValues(1, src, packed_size, num_rows, null_data.data());
+        src += packed_size;
+    }
+    column->update_has_null();
+    return src;
+}
+
+#define APPLY_FOR_INTEGER_TYPES(M) M(uint8_t) M(int8_t) M(int16_t) M(int32_t) M(int64_t)
+
+size_t ColumnEncoder::max_encoded_size(const Column& column) {
+    if (column.is_constant()) {
+        return sizeof(uint64_t) + max_encoded_size(*down_cast<const ConstColumn*>(&column)->data_column());
+    }
+    if (column.is_nullable()) {
+        return max_nullable_encoded_size(*down_cast<const NullableColumn*>(&column));
+    }
+    if (column.is_binary()) {
+        return sizeof(uint8_t) + column.serialize_size();
+    }
+#define M(T)                                                                \
+    if (auto* c = dynamic_cast<const FixedLengthColumnBase<T>*>(&column)) { \
+        return max_integers_encoded_size<T>(c->size());                    \
+    }
+    APPLY_FOR_INTEGER_TYPES(M)
+#undef M
+    return column.serialize_size();
+}
+
+uint8_t* ColumnEncoder::encode(const Column& column, uint8_t* dst) {
+    if (column.is_constant()) {
+        encode_fixed64_le(dst, column.size());
+        dst += sizeof(uint64_t);
+        return encode(*down_cast<const ConstColumn*>(&column)->data_column(), dst);
+    }
+    if (column.is_nullable()) {
+        return encode_nullable(*down_cast<const NullableColumn*>(&column), dst);
+    }
+    if (column.is_binary()) {
+        return encode_binary(*down_cast<const BinaryColumn*>(&column), dst);
+    }
+#define M(T)                                                                \
+    if (auto* c = dynamic_cast<const FixedLengthColumnBase<T>*>(&column)) { \
+        return encode_integers(c->get_data().data(), c->size(), dst);       \
+    }
+    APPLY_FOR_INTEGER_TYPES(M)
+#undef M
+    return const_cast<Column&>(column).serialize_column(dst);
+}
+
+const uint8_t* ColumnEncoder::decode(const uint8_t* src, Column* column) {
+    if (column->is_constant()) {
+        size_t size = decode_fixed64_le(src);
+        src += sizeof(uint64_t);
+        auto* const_column = down_cast<ConstColumn*>(column);
+        src = decode(src, const_column->mutable_data_column()->get());
+        const_column->resize(size);
+        return src;
+    }
+    if (column->is_nullable()) {
+        return decode_nullable(src, down_cast<NullableColumn*>(column));
+    }
+    if (column->is_binary()) {
+        return decode_binary(src, down_cast<BinaryColumn*>(column));
+    }
+#define M(T)                                                          \
+    if (auto* c = dynamic_cast<FixedLengthColumnBase<T>*>(column)) { \
+        return decode_integers(src, &c->get_data());                 \
+    }
+    APPLY_FOR_INTEGER_TYPES(M)
+#undef M
+    return column->deserialize_column(src);
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,32 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "column/column.h"
+
+namespace starrocks::vectorized {
+
+// ColumnEncoder serializes a column with the encodings chosen by its values, it's used by the chunk
+// serialization format of version 2 to reduce the bytes exchanged between backends:
+//  - the null map of a nullable column is omitted if there is no null, otherwise it's bit-packed.
+//  - integers are frame-of-reference encoded, i.e. the offsets to the minimum value are bit-packed, if
+//    it's smaller.
+//  - strings are dictionary encoded if the leading rows have only a few distinct values and the encoded
+//    data is smaller, the codes are encoded as integers.
+//  - const columns keep one value, the other columns are serialized by Column::serialize_column().
+// The encoding is chosen by the column classes and values, so the column used to decode must be created by
+// the same type and nullability as the encoded one.
+class ColumnEncoder {
+public:
+    // The upper bound of the encoded size of |column|.
+    static size_t max_encoded_size(const Column& column);
+
+    // Encode |column| to |dst|, return dst + encoded size.
+    static uint8_t* encode(const Column& column, uint8_t* dst);
+
+    // Replace the content of |column| by the one decoded from |src|, return src + encoded size,
+    // or nullptr if |src| is corrupted.
+    static const uint8_t* decode(const uint8_t* src, Column* column);
+};
+
+} // namespace starrocks::vectorized
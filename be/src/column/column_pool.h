@@ -256,6 +256,34 @@ public:
         }
     }
 
+    // Reduce memory usage on behalf of the columns in the *central* free list if their memory
+    // usage is greater than or equal to |limit|.
+    // Returns the number of bytes freed to tcmalloc.
+    inline size_t release_large_free_columns(size_t limit) {
+        std::vector<DynamicFreeBlock*> blocks;
+        {
+            std::lock_guard<std::mutex> l(_free_blocks_lock);
+            blocks.swap(_free_blocks);
+        }
+        size_t freed_bytes = 0;
+        for (DynamicFreeBlock* blk : blocks) {
+            size_t blk_freed_bytes = 0;
+            for (size_t i = 0; i < blk->nfree; i++) {
+                ASAN_UNPOISON_MEMORY_REGION(blk->ptrs[i], sizeof(T));
+                blk_freed_bytes += release_column_if_large(blk->ptrs[i], limit);
+                ASAN_POISON_MEMORY_REGION(blk->ptrs[i], sizeof(T));
+            }
+            blk->bytes -= blk_freed_bytes;
+            freed_bytes += blk_freed_bytes;
+        }
+        {
+            std::lock_guard<std::mutex> l(_free_blocks_lock);
+            _free_blocks.insert(_free_blocks.end(), blocks.begin(), blocks.end());
+        }
+        UPDATE_BVAR(g_column_pool_total_central_bytes, -freed_bytes);
+        return freed_bytes;
+    }
+
     inline void clear_columns() {
         LocalPool* lp = _local_pool;
         if (lp) {
@@ -410,6 +438,12 @@ inline void release_large_columns(size_t limit) {
     ColumnPool<T>::singleton()->release_large_columns(limit);
 }
 
+template <typename T>
+inline size_t release_large_free_columns(size_t limit) {
+    static_assert(InList<ColumnPool<T>, ColumnPoolList>::value, "Cannot use column pool");
+    return ColumnPool<T>::singleton()->release_large_free_columns(limit);
+}
+
 template <typename T>
 inline size_t release_free_columns(float ratio) {
     static_assert(InList<ColumnPool<T>, ColumnPoolList>::value, "Cannot use column pool");
@@ -86,6 +86,11 @@ CONF_Int32(push_worker_count_normal_priority, "3");
 CONF_Int32(push_worker_count_high_priority, "3");
 // the count of thread to publish version
 CONF_Int32(publish_version_worker_count, "8");
+// the max number of threads of a publish version task to publish the tablets of a partition
+CONF_mInt32(publish_version_tablet_parallelism, "4");
+// the number of threads shared by the storage tasks which run their work in parallel, besides the thread
+// running each task.
+CONF_Int32(storage_parallel_task_threads, "16");
 // the count of thread to clear transaction task
 CONF_Int32(clear_transaction_task_worker_count, "1");
 // the count of thread to delete
@@ -94,14 +99,43 @@ CONF_Int32(delete_worker_count, "3");
 CONF_Int32(alter_tablet_worker_count, "3");
 // the count of thread to clone
 CONF_Int32(clone_worker_count, "3");
+// Run a single clone task at a time while the max io util of the disks reaches this percent, so that the clones
+// don't saturate the disks serving the loads and the queries. 0 means no limit.
+CONF_mInt32(clone_busy_disk_io_util_percent, "0");
 // the count of thread to clone
 CONF_Int32(storage_medium_migrate_count, "1");
+// The max number of finish reports of the agent tasks sent to the FE in one rpc. The reports of the tasks done
+// within agent_task_finish_batch_interval_ms are batched. 0 or 1 sends a report per task.
+CONF_mInt32(agent_task_finish_batch_size, "1");
+CONF_mInt32(agent_task_finish_batch_interval_ms, "100");
+
+// Whether to migrate the cold tablets from the SSD data dirs to the HDD data dirs in background.
+// A tablet is cold if it has not been queried during the last check interval and has not been
+// loaded for tiered_storage_cold_tablet_age_seconds. Note that FE may move a tablet migrated in
+// this way back if the storage medium of its partition is SSD.
+CONF_mBool(enable_tiered_storage_migration, "false");
+CONF_mInt32(tiered_storage_migration_check_interval_seconds, "3600");
+CONF_mInt64(tiered_storage_cold_tablet_age_seconds, "604800");
+// The max number of tablets migrated in one check.
+CONF_mInt32(tiered_storage_migration_max_tablets_per_round, "10");
+// The cold tablets are only migrated in the hours [start_hour, end_hour) of the local time,
+// the window wraps around midnight if start_hour is greater than end_hour.
+CONF_mInt32(tiered_storage_migration_start_hour, "0");
+CONF_mInt32(tiered_storage_migration_end_hour, "6");
 // the count of thread to check consistency
 CONF_Int32(check_consistency_worker_count, "1");
 // the count of thread to upload
 CONF_Int32(upload_worker_count, "1");
 // the count of thread to download
 CONF_Int32(download_worker_count, "1");
+// the number of files uploaded in parallel by an upload task, or of a tablet downloaded in parallel by a
+// download task.
+CONF_mInt32(snapshot_loader_file_parallelism, "4");
+// the max bytes per second uploaded and downloaded by all the upload and download tasks, 0 means no limit.
+CONF_mInt64(snapshot_loader_max_mbytes_per_sec, "0");
+// reuse the segment files uploaded by a previous backup with the same name and size without checksumming
+// the local files again. off by default, as a remote file is then trusted by its name and size only.
+CONF_mBool(snapshot_upload_trust_remote_segments, "false");
 // the count of thread to make snapshot
 CONF_Int32(make_snapshot_worker_count, "5");
 // the count of thread to release snapshot
@@ -126,6 +160,12 @@ CONF_mInt32(max_download_speed_kbps, "50000");
 CONF_mInt32(download_low_speed_limit_kbps, "50");
 // download low speed time(seconds)
 CONF_mInt32(download_low_speed_time, "300");
+// the number of files of a tablet downloaded in parallel by clone or copied in parallel by storage
+// migration. max_download_speed_kbps limits each download, and the files written take the tokens of
+// background_io_mbytes_per_sec_per_disk of the destination disk.
+CONF_mInt32(tablet_file_copy_parallelism, "4");
+// verify the crc32c of the files downloaded by clone or copied by storage migration.
+CONF_mBool(tablet_file_copy_verify_checksum, "true");
 // curl verbose mode
 // CONF_Int64(curl_verbose_mode, "1");
 // seconds to sleep for each time check table status
@@ -173,6 +213,13 @@ CONF_Bool(compress_rowbatches, "true");
 // compress ratio when shuffle row_batches in network, not in storage engine.
 // If ratio is less than this value, use uncompressed data instead
 CONF_mDouble(rpc_compress_ratio_threshold, "1.1");
+// the serialized runtime filters not smaller than this are compressed by LZ4 before sent to the merge nodes
+// and the probe nodes, 0 means never compressed.
+CONF_mInt64(runtime_filter_compress_min_bytes, "65536");
+// If true, the chunks exchanged between backends are serialized with the column-aware encodings, i.e.
+// bit-packed null maps, frame-of-reference encoded integers and dictionary encoded strings.
+// Enable it only after all the backends are upgraded to support the format.
+CONF_mBool(exchange_encode_chunk, "false");
 // serialize and deserialize each returned row batch
 CONF_Bool(serialize_batch, "false");
 // interval between profile reports; in seconds
@@ -183,6 +230,9 @@ CONF_String(local_library_dir, "${UDF_RUNTIME_DIR}");
 CONF_mInt32(doris_scanner_thread_pool_thread_num, "48");
 // number of olap scanner thread pool size
 CONF_Int32(doris_scanner_thread_pool_queue_size, "102400");
+// number of the queues the tasks of the olap scanner thread pool are spread over, and stolen from by the idle
+// threads, to reduce the contention on a single queue of many threads.
+CONF_Int32(doris_scanner_thread_pool_num_lanes, "1");
 // number of etl thread pool size
 CONF_Int32(etl_thread_pool_size, "8");
 // number of etl thread pool size
@@ -193,6 +243,15 @@ CONF_Int32(port, "20001");
 CONF_Int32(thrift_connect_timeout_seconds, "3");
 // broker write timeout in seconds
 CONF_Int32(broker_write_timeout_seconds, "30");
+// The number of blocks of 'broker_read_ahead_block_bytes' read from the broker in parallel ahead of a sequential
+// reader of a broker file, e.g. the file of a broker load. 0 reads the file one request at a time.
+CONF_mInt32(broker_read_ahead_blocks, "0");
+CONF_mInt64(broker_read_ahead_block_bytes, "8388608");
+// The plain CSV files of a broker load larger than 'broker_load_split_range_bytes' are split into ranges of that
+// size, which are scanned by up to 'broker_load_scanner_threads' scanners of the scan node in parallel. The records
+// of a file are loaded out of order then. 0 scans every file as a whole.
+CONF_mInt64(broker_load_split_range_bytes, "0");
+CONF_mInt32(broker_load_scanner_threads, "4");
 // default thrift client retry interval (in milliseconds)
 CONF_mInt64(thrift_client_retry_interval_ms, "100");
 // max row count number for single scan range
@@ -203,6 +262,29 @@ CONF_mInt32(doris_scanner_queue_size, "1024");
 CONF_mInt32(doris_scanner_row_num, "16384");
 // number of max scan keys
 CONF_mInt32(doris_max_scan_key_num, "1024");
+// prune the pages of parquet files by the min/max values in the page index, and skip reading them.
+CONF_mBool(parquet_page_index_enable, "true");
+// read the parquet columns with conjuncts first, and decode the other columns only for the rows selected
+// by the conjuncts.
+CONF_mBool(parquet_late_materialization_enable, "true");
+// the capacity of the cache of the parsed parquet and orc footers shared by the hdfs scanners, in bytes of the
+// serialized footers. 0 disables the cache.
+CONF_Int64(hdfs_file_meta_cache_capacity, "134217728");
+// merge the reads of the parquet column chunks and the orc stripes of the hdfs files into a few large reads.
+CONF_mBool(hdfs_io_coalesce_enable, "true");
+// the max gap between two ranges merged into one read, the bytes of the gap are read and dropped.
+CONF_mInt64(hdfs_io_coalesce_max_gap, "1048576");
+// the max size of a merged read, a range larger than it is read on its own.
+CONF_mInt64(hdfs_io_coalesce_max_buffer_size, "8388608");
+// the local dirs caching the blocks of the remote hdfs and object storage files, separated by ';'.
+// empty disables the cache. the files in the dirs are removed on start.
+CONF_String(hdfs_block_cache_paths, "");
+// the capacity of the block cache of all the dirs, in bytes.
+CONF_Int64(hdfs_block_cache_capacity, "107374182400");
+// the size of the blocks of the remote files cached, in bytes.
+CONF_Int64(hdfs_block_cache_block_size, "1048576");
+// the number of the threads writing the blocks into the cache.
+CONF_Int32(hdfs_block_cache_populate_threads, "2");
 // the max number of push down values of a single column.
 // if exceed, no conditions will be pushed down for that column.
 CONF_mInt32(max_pushdown_conditions_per_column, "1024");
@@ -210,6 +292,9 @@ CONF_mInt32(max_pushdown_conditions_per_column, "1024");
 CONF_mInt32(doris_max_pushdown_conjuncts_return_rate, "90");
 // (Advanced) Maximum size of per-query receive-side buffer
 CONF_mInt32(exchg_node_buffer_size_bytes, "10485760");
+// the data stream senders hand the chunks to the receivers in the same backend directly,
+// instead of serializing them and sending them by brpc.
+CONF_mBool(enable_exchange_pass_through, "false");
 // insert sort threadhold for sorter
 // CONF_Int32(insertion_threadhold, "16");
 // the block_size every block allocate for sorter
@@ -225,14 +310,39 @@ CONF_mInt64(column_dictionary_key_size_threshold, "0");
 //CONF_String(module_output, "");
 // memory_limitation_per_thread_for_schema_change unit GB
 CONF_mInt32(memory_limitation_per_thread_for_schema_change, "2");
+// the number of workers converting the historical rowsets of a tablet in parallel in the schema
+// change rewriting data, the workers share memory_limitation_per_thread_for_schema_change.
+// the linked schema change only links files and is not parallelized.
+CONF_mInt32(schema_change_max_parallel_rowsets, "4");
 
 // CONF_Int64(max_unpacked_row_block_size, "104857600");
 
 CONF_mInt32(update_cache_expire_sec, "360");
+// the max bytes of the delete vectors of the primary key tablets cached in memory, the least recently
+// used ones are evicted and reloaded from the meta when they are read again.
+CONF_mInt64(update_del_vector_cache_capacity, "1073741824"); // 1GB
+// save a snapshot of the primary index of a primary key tablet every this many applied versions,
+// so reloading the index after it's expired or the BE restarts doesn't scan all the segments.
+// 0 means disabled.
+CONF_mInt32(primary_index_snapshot_interval_versions, "50");
+// the max number of threads to read the segments and build the primary index of a large tablet.
+// 1 means the index is always built by the thread loading it.
+CONF_mInt32(primary_index_load_threads, "4");
+// the primary index of a tablet with fewer rows than this is always built by the thread loading it.
+CONF_mInt64(primary_index_parallel_load_min_rows, "1000000");
 CONF_mInt32(file_descriptor_cache_clean_interval, "3600");
 CONF_mInt32(disk_stat_monitor_interval, "5");
 CONF_mInt32(unused_rowset_monitor_interval, "30");
 CONF_String(storage_root_path, "${STARROCKS_HOME}/storage");
+// the directory of the cold column files, usually a mount of the cheaper remote storage such as an S3-compatible
+// object storage. The cold columns are kept in the local segment files if it's empty. Each BE must have a directory
+// of its own, because the files not referred by the rowsets of the BE are removed after trash_file_expire_time_sec.
+// The cold files of the snapshots are copied into the snapshots, so that the clones and the backups carry them.
+// Clearing it leaves the existing cold files there until it's set again, and the segments reading them fail to open.
+CONF_String(cold_column_storage_path, "");
+// the wide value columns of the rowsets compacted from the rowsets created this many seconds ago are moved to
+// cold_column_storage_path. 0 to disable.
+CONF_mInt64(cold_column_ttl_sec, "0");
 // BE process will exit if the percentage of error disk reach this value.
 CONF_mInt32(max_percentage_of_error_disk, "0");
 // CONF_Int32(default_num_rows_per_data_block, "1024");
@@ -263,6 +373,50 @@ CONF_Int64(index_stream_cache_capacity, "10737418240");
 CONF_String(storage_page_cache_limit, "0");
 // whether to disable page cache feature in storage
 CONF_Bool(disable_storage_page_cache, "true");
+// the IN predicates with more values than this are not tested against the bloom filter indexes, most
+// pages would match them while the cost grows with the values.
+CONF_mInt32(bloom_filter_max_in_list_size, "1024");
+// the CHAR/VARCHAR bloom filter columns also get an n-gram bloom filter index of the substrings of this many
+// bytes, to skip the pages by LIKE '%abc%', instr() and locate(). 0 disables the n-gram bloom filter index.
+CONF_mInt32(ngram_bloom_filter_gram_size, "0");
+// the memory of the cache of the parsed segment footers, reused when the segments are opened again.
+// 0 disables the cache.
+CONF_Int64(segment_footer_cache_capacity, "268435456");
+// the memory of the cache of the rows of the segments selected by the pushed down predicates, so the same
+// filters on the same segments skip decoding and evaluating the predicate columns. 0 disables the cache, and
+// the capacity is fixed once it's enabled.
+CONF_mInt64(segment_predicate_cache_capacity, "0");
+// the memory of the cache of the rows of the segments deleted by the DELETE conditions, so the scans remove them
+// by a bitmap instead of evaluating every delete condition on every chunk. 0 disables the cache, and the capacity
+// is fixed once it's enabled.
+CONF_mInt64(segment_delete_bitmap_cache_capacity, "0");
+// whether the storage page cache and the file descriptor cache evict by CLOCK instead of LRU, whose lookups
+// don't serialize on the lock of the shard.
+CONF_Bool(enable_clock_cache, "false");
+// the percentage of storage_page_cache_limit reserved for the index pages, which are cached apart from the
+// data pages so that the large scans can't evict them. 0 means all the pages share one cache.
+CONF_Int32(storage_page_cache_index_percent, "10");
+// whether the scans without any pushed down predicate or key range insert the data pages they read into the
+// page cache. they read every page once, and would only evict the pages of the other queries.
+CONF_mBool(storage_page_cache_fill_by_full_scan, "false");
+// whether the segment iterators of queries read the data pages of their row ranges ahead in large
+// coalesced reads on the pipeline io thread pool.
+CONF_mBool(enable_segment_prefetch, "false");
+// the data pages of a column are coalesced into one read if the gap between them is not larger than this size.
+CONF_mInt64(segment_prefetch_max_gap_bytes, "65536");
+// the max size of a coalesced read of segment prefetch, the data pages are buffered by 2 reads per column.
+CONF_mInt64(segment_prefetch_max_io_bytes, "1048576");
+// whether the batched reads of the local files are submitted by io_uring, falls back to pread
+// if io_uring is not supported by the kernel.
+CONF_mBool(enable_io_uring, "false");
+// the number of entries of the io_uring of every io thread, i.e. the max reads in flight of a batch.
+CONF_Int32(io_uring_queue_depth, "64");
+// the number of rows of every sub-page zone map written with the page zone maps, for pruning the rows
+// inside a data page. 0 to disable the sub-page zone maps.
+CONF_mInt32(sub_page_zone_map_rows, "1024");
+// whether to keep the sums of the numeric columns in the zone maps, for answering sum and count of the
+// duplicate key tables and of the SUM columns of the aggregate key tables from the segment meta.
+CONF_mBool(enable_zone_map_sum, "false");
 // whether to disable column pool
 CONF_Bool(disable_column_pool, "false");
 
@@ -272,6 +426,16 @@ CONF_Int32(base_compaction_num_threads_per_disk, "1");
 CONF_mDouble(base_cumulative_delta_ratio, "0.3");
 CONF_mInt64(base_compaction_interval_seconds_since_last_operation, "86400");
 CONF_mInt32(base_compaction_write_mbytes_per_sec, "5");
+// the max disk I/O speed of the background tasks on a data dir, i.e. the reads and writes of base,
+// cumulative and update compaction and the writes of schema change, in MB per second.
+// <= 0 means no limit.
+CONF_mInt64(background_io_mbytes_per_sec_per_disk, "0");
+// whether the segments of the loads and the compactions are written by the background threads, so that
+// the encoding of the pages overlaps with the disk writes.
+CONF_mBool(enable_async_segment_write, "false");
+CONF_Int32(async_segment_write_threads, "4");
+// the segment data are written in this many bytes at a time, two buffers of which are held by every segment.
+CONF_mInt64(async_segment_write_buffer_size, "4194304");
 
 // cumulative compaction policy: max delta file's size unit:B
 CONF_mInt32(cumulative_compaction_check_interval_seconds, "1");
@@ -288,6 +452,24 @@ CONF_mInt32(cumulative_compaction_skip_window_seconds, "30");
 CONF_mInt32(update_compaction_check_interval_seconds, "60");
 CONF_Int32(update_compaction_num_threads_per_disk, "1");
 CONF_Int32(update_compaction_per_tablet_min_interval_seconds, "120"); // 2min
+// the rowsets of a primary key tablet not worth compacting for their deletes are grouped into size tiers,
+// every tier is update_compaction_size_tier_ratio times larger than the previous one. the rowsets of the
+// smallest tier with at least update_compaction_size_tier_min_rowsets rowsets are compacted together, so
+// the number of rowsets is bounded by the number of tiers times update_compaction_size_tier_min_rowsets.
+CONF_mInt32(update_compaction_size_tier_min_rowsets, "4");
+CONF_mInt32(update_compaction_size_tier_ratio, "4");
+
+// the base and cumulative compaction of the tablets having more value columns than
+// vertical_compaction_max_columns_per_group merge the key columns first, and then the value columns
+// group by group, so that only the key columns and a group of value columns are read at the same time.
+CONF_mBool(enable_vertical_compaction, "true");
+CONF_mInt32(vertical_compaction_max_columns_per_group, "5");
+// the base and cumulative compaction of the tablets whose input rowsets are larger than
+// compaction_key_range_split_min_bytes split the key space into at most compaction_max_key_ranges
+// ranges and merge them in parallel, each range is written into its own segments of the output rowset.
+// the tablets compacted vertically are not split. compaction_max_key_ranges <= 1 disables the split.
+CONF_mInt64(compaction_key_range_split_min_bytes, "10737418240");
+CONF_mInt32(compaction_max_key_ranges, "4");
 
 // if compaction of a tablet failed, this tablet should not be chosen to
 // compaction until this interval passes.
@@ -299,6 +481,12 @@ CONF_mInt64(min_compaction_failure_interval_sec, "120"); // 2 min
 // set it to larger than C will be set to equal to C.
 // This config can be set to 0, which means to forbid any compaction, for some special cases.
 CONF_Int32(max_compaction_concurrency, "-1");
+// the base and cumulative compaction tasks of all the data dirs are picked from a single queue
+// ordered by priority, but at most compaction_max_tasks_per_disk of them run on one data dir at
+// the same time, so that the compactions of a busy disk do not take all the slots. <= 0 means no limit.
+CONF_mInt32(compaction_max_tasks_per_disk, "2");
+// the max number of tasks kept in the queue of the compaction scheduler.
+CONF_mInt32(compaction_scheduler_max_queue_size, "256");
 
 // Threshold to logging compaction trace, in seconds.
 CONF_mInt32(base_compaction_trace_threshold, "120");
@@ -309,6 +497,14 @@ CONF_mInt32(update_compaction_trace_threshold, "20");
 CONF_Int32(webserver_port, "8040");
 // Number of webserver workers
 CONF_Int32(webserver_num_workers, "48");
+// Whether every webserver worker accepts on a listening socket of its own with SO_REUSEPORT, so the kernel
+// balances the connections among the workers.
+CONF_Bool(webserver_reuse_port, "false");
+// Port to serve the monitoring endpoints on, e.g. /metrics and /api/health, so they are not stalled by the stream
+// loads occupying the workers of webserver_port. 0 means serving them on webserver_port only.
+CONF_Int32(webserver_admin_port, "0");
+// Number of workers of webserver_admin_port.
+CONF_Int32(webserver_admin_num_workers, "2");
 // Period to update rate counters and sampling counters in ms.
 CONF_mInt32(periodic_counter_update_period_ms, "500");
 
@@ -332,6 +528,28 @@ CONF_mInt64(streaming_load_max_mb, "10240");
 // Therefore, it is necessary to limit the maximum number of
 // such data when using stream load to prevent excessive memory consumption.
 CONF_mInt64(streaming_load_max_batch_size_mb, "100");
+// The number of threads parsing the body of a single CSV stream load or routine load task in parallel, which is
+// split into blocks of about 'streaming_load_parse_block_bytes' at the record boundaries. 1 parses the body in one
+// scanner thread.
+CONF_mInt32(streaming_load_parse_threads, "1");
+CONF_mInt64(streaming_load_parse_block_bytes, "4194304");
+// The number of threads decompressing a compressed load file ahead of its scanner, every thread a run of the frames
+// of about 'load_decompress_task_bytes', if the frames of the file are decompressed independently, e.g. the frames
+// of a zstd or lz4 file or the blocks of a BGZF file. 1 decompresses the file in the scanner thread.
+CONF_mInt32(load_decompress_threads, "1");
+CONF_mInt64(load_decompress_task_bytes, "4194304");
+// Whether the small CSV stream loads with the header "group_commit: true" are loaded in the transaction of a group
+// of the loads of the same table and load properties, which is committed every 'group_commit_interval_ms' or once
+// 'group_commit_max_bytes' have been loaded. The larger loads are loaded in their own transactions. The loads with
+// the header "label" are rejected, because they would not be deduplicated by their labels.
+CONF_mBool(enable_group_commit, "false");
+CONF_mInt32(group_commit_interval_ms, "1000");
+CONF_mInt64(group_commit_max_bytes, "67108864");
+// keep the profile of every stream load and routine load task, i.e. the time of its phases and the profile of
+// its plan fragment, which can be retrieved by label from /api/load_profile.
+CONF_mBool(enable_load_profile, "false");
+// the number of the latest loads whose profiles are kept.
+CONF_mInt32(load_profile_max_num, "64");
 // the alive time of a TabletsChannel.
 // If the channel does not receive any data till this time,
 // the channel will be removed.
@@ -383,6 +601,10 @@ CONF_Bool(disable_mem_pools, "false");
 // NOTE: When this is set to true, you must set chunk_reserved_bytes_limit
 // to a relative large number or the performace is very very bad.
 CONF_Bool(use_mmap_allocate_chunk, "false");
+// Whether to back the chunks mmap-ed by use_mmap_allocate_chunk with explicit huge pages
+// (MAP_HUGETLB) when their size is a multiple of 2MB. The huge pages must be reserved via
+// "sysctl -w vm.nr_hugepages=N", otherwise normal pages are used.
+CONF_Bool(mmap_huge_tlb_chunk, "false");
 
 // Chunk Allocator's reserved bytes limit,
 // Default value is 2GB, increase this variable can improve performance, but will
@@ -395,6 +617,13 @@ CONF_Bool(enable_quadratic_probing, "false");
 
 // for pprof
 CONF_String(pprof_profile_dir, "${STARROCKS_HOME}/log");
+// continuously sample the CPU of the process at a low frequency and attribute the samples to the queries,
+// which can be dumped by /api/query_cpu_profile.
+CONF_Bool(enable_query_cpu_profiler, "false");
+// the number of samples per second of CPU time of the process.
+CONF_Int32(query_cpu_profiler_frequency, "99");
+// the number of the latest sampled queries whose stacks are kept.
+CONF_mInt32(query_cpu_profiler_max_queries, "256");
 
 // for partition
 // CONF_Bool(enable_partitioned_hash_join, "false")
@@ -429,7 +658,7 @@ CONF_String(scratch_dirs, "/tmp");
 // then only the first writable directory is used
 // CONF_Bool(allow_multiple_scratch_dirs_per_device, "false");
 
-// linux transparent huge page
+// linux transparent huge page, used for the chunks of at least 2MB of the chunk allocator
 CONF_Bool(madvise_huge_pages, "false");
 
 // whether use mmap to allocate memory
@@ -443,6 +672,9 @@ CONF_Int32(memory_max_alignment, "16");
 
 // write buffer size before flush
 CONF_mInt64(write_buffer_size, "104857600");
+// when the total load memory exceeds limit, the memtables smaller than this are flushed only if
+// flushing the larger ones of all the loads is not enough, to avoid flushing tiny segments.
+CONF_mInt64(load_min_flush_memtable_size, "16777216");
 
 // following 2 configs limit the memory consumption of load process on a Backend.
 // eg: memory limit to 80% of mem limit config but up to 100GB(default)
@@ -480,6 +712,9 @@ CONF_mInt32(max_consumer_num_per_group, "3");
 // the size of thread pool for routine load task.
 // this should be larger than FE config 'max_concurrent_task_num_per_be' (default 5)
 CONF_Int32(routine_load_thread_pool_size, "10");
+// The max number of kafka messages a routine load consumer hands over to its task at a time, the messages
+// available without waiting are batched.
+CONF_mInt32(routine_load_kafka_consume_batch_size, "1");
 
 // Is set to true, index loading failure will not causing BE exit,
 // and the tablet will be marked as bad, so that FE will try to repair it.
@@ -488,6 +723,9 @@ CONF_Int32(routine_load_thread_pool_size, "10");
 // max external scan cache batch count, means cache max_memory_cache_batch_count * batch_size row
 // default is 20, batch_size's defualt value is 1024 means 20 * 1024 rows will be cached
 CONF_mInt32(max_memory_sink_batch_count, "20");
+// whether the external scan, e.g. of the spark connector, runs in pipeline engine, where the chunks are
+// converted to arrow batches by all the drivers in parallel.
+CONF_mBool(enable_pipeline_external_scan, "false");
 
 // This configuration is used for the context gc thread schedule period
 // note: unit is minute, default is 5min
@@ -499,6 +737,13 @@ CONF_String(es_scroll_keepalive, "5m");
 // HTTP connection timeout for es
 CONF_Int32(es_http_timeout_ms, "5000");
 
+// The number of the sliced scrolls scanning an es shard concurrently, 1 to scan a shard by a single scroll.
+CONF_Int32(es_scroll_slices_per_shard, "1");
+
+// The number of the connections scanning a mysql external table concurrently, each querying a range of the
+// integer primary key of the table. 1 to scan a table by a single query.
+CONF_Int32(mysql_scan_parallelism, "1");
+
 // the max client cache number per each host
 // There are variety of client cache in BE, but currently we use the
 // same cache size configuration.
@@ -522,6 +767,13 @@ CONF_mInt32(storage_flood_stage_usage_percent, "95"); // 95%
 CONF_mInt64(storage_flood_stage_left_capacity_bytes, "1073741824"); // 1GB
 // number of thread for flushing memtable per store
 CONF_Int32(flush_thread_num_per_store, "2");
+// a large memtable is flushed into up to this many segments written in parallel by the flush threads, every
+// one of which has at least memtable_flush_min_rows_per_segment rows. 1 disables the parallel flush.
+CONF_mInt32(memtable_flush_max_parallel_segments, "1");
+CONF_mInt64(memtable_flush_min_rows_per_segment, "1000000");
+// the memtables smaller than this many bytes are flushed into the segment pack file of the rowset instead of
+// segment files of their own, to save the files of the frequent small loads. 0 to disable.
+CONF_mInt64(segment_pack_max_bytes, "0");
 
 // config for tablet meta checkpoint
 CONF_mInt32(tablet_meta_checkpoint_min_new_rowsets_num, "10");
@@ -531,6 +783,9 @@ CONF_mInt32(tablet_meta_checkpoint_min_interval_secs, "600");
 CONF_Int64(brpc_max_body_size, "2147483648");
 // Max unwritten bytes in each socket, if the limit is reached, Socket.Write fails with EOVERCROWDED
 CONF_Int64(brpc_socket_max_unwritten_bytes, "1073741824");
+// the number of connections to each brpc endpoint, among which the rpcs, e.g. of the shuffle, are balanced in
+// round robin. 1 means all the rpcs to an endpoint share a single connection.
+CONF_Int32(brpc_connections_per_endpoint, "1");
 
 // max number of txns for every txn_partition_map in txn manager
 // this is a self protection to avoid too many txns saving in manager
@@ -552,12 +807,19 @@ CONF_Int32(txn_shard_size, "1024");
 
 // Whether to continue to start be when load tablet from header failed.
 CONF_Bool(ignore_load_tablet_failure, "false");
+// Number of threads per data dir to parse the tablet and rowset metas and create the tablets when be starts.
+CONF_Int32(tablet_meta_load_threads_per_data_dir, "8");
 
 // Whether to continue to start be when load tablet from header failed.
 CONF_Bool(ignore_rowset_stale_unconsistent_delete, "false");
 
 // The chunk size for vector query engine
 CONF_Int32(vector_chunk_size, "4096");
+// The target memory footprint of a chunk read by the olap scan. Scans of wide rows use smaller chunks
+// (never less than `vector_chunk_min_size` rows) so that a chunk stays in the CPU cache. 0 to always use
+// `vector_chunk_size`.
+CONF_mInt64(vector_chunk_target_bytes, "1048576");
+CONF_mInt32(vector_chunk_min_size, "512");
 
 // valid range: [0-1000].
 // `0` will disable late materialization.
@@ -569,6 +831,14 @@ CONF_Int32(late_materialization_ratio, "10");
 // `1000` will enable late materialization always select metric type.
 CONF_Int32(metric_late_materialization_ratio, "1000");
 
+// whether the predicate columns other than the first one and the dict-coded ones are also late materialized,
+// i.e. read by rowid for the rows selected by the other predicates, and filtered before reading the rest columns.
+CONF_mBool(enable_lazy_predicate_columns, "true");
+
+// whether the segment iterator evaluates the first predicate while reading its column, on the RLE and
+// frame-of-reference encoded pages without decoding every value.
+CONF_mBool(enable_encoded_predicate_evaluation, "true");
+
 // Max batched bytes for each transmit request
 CONF_Int64(max_transmit_batched_bytes, "65536");
 
@@ -593,6 +863,13 @@ CONF_mInt16(storage_format_version, "2");
 // 1 for LZ4_NULL
 CONF_mInt16(null_encoding, "0");
 
+// Choose the encoding of every data page of the numeric columns among the available encodings by the
+// encoded size and the decode cost, instead of using the default encoding of the type for all pages.
+// Segments written with it on can't be read by the BEs of the old versions.
+CONF_mBool(enable_adaptive_page_encoding, "false");
+// Try all the candidate encodings on one of every this many data pages.
+CONF_mInt32(adaptive_page_encoding_sample_interval, "16");
+
 // do pre-aggregate if effect great than the factor, factor range:[1-100].
 CONF_Int16(pre_aggregate_factor, "80");
 
@@ -631,8 +908,141 @@ CONF_Int64(pipeline_yield_max_time_spent, "100000000");
 CONF_Int64(pipeline_io_thread_pool_thread_num, "3");
 // queue size of io thread pool for pipeline engine.
 CONF_Int64(pipeline_io_thread_pool_queue_size, "102400");
+// number of the queues of io thread pool for pipeline engine, see doris_scanner_thread_pool_num_lanes.
+CONF_Int32(pipeline_io_thread_pool_num_lanes, "1");
 // the number of execution threads for pipeline engine.
 CONF_Int64(pipeline_exec_thread_pool_thread_num, "3");
+// use per-thread local driver queues with work stealing instead of one queue shared by
+// all the execution threads of pipeline engine.
+CONF_Bool(pipeline_enable_work_stealing_driver_queue, "false");
+// pin each execution thread of pipeline engine to one core, and steal the drivers of the threads on the
+// same NUMA node first, only used with the work stealing driver queue.
+CONF_Bool(pipeline_exec_thread_pin_cores, "false");
+// schedule the drivers of pipeline engine by resource groups, the execution threads are shared among
+// the groups in proportion to their cpu weights, and each query is assigned to the group named by
+// the session variable pipeline_resource_group, or to the default group.
+CONF_Bool(pipeline_enable_resource_group, "false");
+// the resource groups in format "name:cpu_weight[:max_concurrency];...", e.g. "interactive:8;etl:2:4".
+// max_concurrency limits the number of running queries of the group in one BE, 0 means unlimited.
+// the group named "default" overrides the default group, whose cpu_weight is 1 and is unlimited.
+CONF_String(pipeline_resource_groups, "");
+// split the morsels of DUP_KEYS and PRIMARY_KEYS tablets at segment boundaries on demand,
+// so that the scan of a large tablet can be shared by multiple ScanOperators.
+CONF_mBool(pipeline_enable_splittable_morsel, "false");
+// the minimum number of segments of a split morsel.
+CONF_mInt64(pipeline_morsel_min_split_segments, "1");
+// when the session doesn't specify pipeline_dop, choose the dop of each fragment instance from the number of
+// morsels it scans and the number of drivers running in the execution threads, instead of a half of the cores.
+CONF_mBool(pipeline_enable_adaptive_dop, "false");
+// whether the probe side of hash join runs with multiple drivers, which probe the same hash table
+// built once, only for the join types whose probe never writes to the hash table, e.g. inner join.
+CONF_mBool(pipeline_enable_parallel_hash_join_probe, "false");
+// shuffle the input rows of the first phase of aggregate in pipeline engine by the group by keys,
+// so that every driver aggregates a disjoint set of keys unless the keys are skewed.
+CONF_mBool(pipeline_enable_streaming_agg_local_shuffle, "false");
+// shuffle the input rows of the blocking aggregate with group by in pipeline engine by the group by keys,
+// so that the final merge of aggregate states is parallelized across drivers, each of which owns a
+// partition of the keys and outputs it independently.
+CONF_mBool(pipeline_enable_parallel_blocking_agg, "false");
+// shuffle the input rows of the sort below an analytic node in pipeline engine by the PARTITION BY keys,
+// so that every driver sorts and analyzes its own window partitions without merging the sorted runs.
+CONF_mBool(pipeline_enable_parallel_analytic, "false");
+// a partition of the local shuffle is hot when its queued rows exceed this ratio of the average,
+// the rows of hot partitions are rebalanced to the other partitions if the successor operator permits.
+CONF_mDouble(pipeline_local_shuffle_skew_ratio, "2");
+// the maximum bytes of the chunks queued and in flight in the sink buffer of one fragment instance,
+// the exchange sink operators of pipeline engine stop accepting input once it is exceeded.
+CONF_mInt64(pipeline_sink_buffer_max_bytes, "16777216");
+// the small requests queued in the sink buffer for the same destination are coalesced into one rpc
+// up to this size.
+CONF_mInt64(pipeline_sink_max_coalesced_bytes, "1048576");
+// the exchange sink operators of pipeline engine only send chunks to a receiver when it has granted them
+// credit, i.e. free buffer, instead of the receiver holding the responses of the rpcs once its buffer is full.
+CONF_mBool(pipeline_enable_exchange_credit_flow_control, "false");
+// the number of descriptor tables cached for the fragments of the queries with the same shape in pipeline engine,
+// 0 means disabled.
+CONF_mInt64(pipeline_desc_tbl_cache_capacity, "0");
+// the bytes of the scan results of whole tablets cached for the repeated scans in pipeline engine,
+// so that they only read the tablets changed since, 0 means disabled.
+CONF_mInt64(pipeline_scan_result_cache_capacity, "0");
+// the concurrent full scans of the same tablet at the same version with the same columns in pipeline engine read
+// one shared stream of chunks, each evaluating its own predicates, instead of reading the tablet each.
+CONF_mBool(pipeline_enable_shared_scan, "false");
+// the bytes of the chunks of a shared scan kept for its slower readers, beyond which the faster readers wait a
+// while for them to catch up before reading ahead.
+CONF_mInt64(pipeline_shared_scan_max_buffer_bytes, "268435456");
+// trace the scheduling of the drivers of one in every this many queries of pipeline engine, i.e. when they
+// are ready, running and blocked, which can be dumped by /api/pipeline/driver_trace, 0 means disabled.
+CONF_mInt64(pipeline_driver_trace_sample_rate, "0");
+// the number of scheduling events kept for each traced query, the oldest ones are overwritten.
+CONF_mInt64(pipeline_driver_trace_buffer_size, "65536");
+// the number of the latest traced queries whose traces are kept.
+CONF_mInt64(pipeline_driver_trace_max_queries, "16");
+// the interval of sampling the memory of the operators of a query of pipeline engine into the memory timeline
+// in its profile, the interval is doubled every time the timeline reaches 1024 samples, 0 means disabled.
+CONF_mInt64(pipeline_query_mem_timeline_interval_ms, "0");
+// report the actual rows of every plan node of a fragment instance of pipeline engine, with the selectivity of the
+// predicates and runtime filters of the scans, in the final exec status report to FE as cardinality feedback.
+CONF_mBool(pipeline_report_plan_node_runtime_stats, "false");
+// when spilling is enabled for the query, the blocking aggregate of pipeline engine spills
+// its hash table to the spill path of data dirs once the hash table exceeds this size.
+CONF_mInt64(agg_spill_mem_limit_bytes, "1073741824");
+// the number of partitions the spilled aggregate states are split into by the hash of group by keys.
+CONF_Int32(agg_spill_partition_num, "16");
+// the bytes of the memory pool of the aggregate states kept for reuse after the hash table is
+// spilled, so that restoring the next partition doesn't allocate them again.
+CONF_mInt64(agg_mem_pool_retained_bytes, "67108864");
+// the streaming pre-aggregation in auto mode estimates the distinct group by keys of every this many input rows,
+// and decides whether to aggregate or pass through the following rows by the reduction of the window.
+// 0 disables the sampling.
+CONF_mInt64(streaming_agg_sample_window_rows, "262144");
+// the streaming pre-aggregation switches to pass through when the sampled reduction (rows / distinct keys)
+// is lower than this value.
+CONF_mDouble(streaming_agg_pass_through_reduction, "1.2");
+// the streaming pre-aggregation switches back to aggregate when the sampled reduction reaches this value.
+CONF_mDouble(streaming_agg_preagg_reduction, "2");
+// the exact count(distinct) and sum(distinct) of the integer columns move the distinct keys of a group from
+// the hash set to a roaring bitmap once the hash set holds more than this many keys.
+CONF_mInt64(distinct_agg_bitmap_threshold, "65536");
+// when spilling is enabled for the query, the hash join of pipeline engine turns into grace hash join
+// once the build rows exceed this size.
+CONF_mInt64(join_spill_mem_limit_bytes, "1073741824");
+// the number of partitions the build and probe rows of grace hash join are split into.
+CONF_Int32(join_spill_partition_num, "16");
+// when spilling is enabled for the query, the full sort writes its buffered rows to disk as a
+// sorted run once they exceed this size, and merges all the runs at the end.
+CONF_mInt64(sort_spill_mem_limit_bytes, "1073741824");
+// sort the rows of the full sort by multiple order-by columns by their normalized keys, i.e. memcomparable
+// encodings of all the order-by values of a row, if all the order-by columns are of fixed-size types.
+CONF_mBool(enable_sort_normalized_keys, "true");
+// push the boundary of the first order-by column of a TopN down to the olap scan right below it,
+// to skip the segments and pages which can't make it into the top N by their zone maps.
+CONF_mBool(enable_topn_runtime_filter, "true");
+// keep the top rows of a TopN in a bounded heap, and filter the incoming rows by the last one kept,
+// if its offset + limit is not greater than this value.
+CONF_mInt64(topn_heap_sort_max_rows, "1024");
+// build the hash table of hash join by direct mapping, i.e. use the key as the bucket index, if the only
+// join key is an integer whose build values are in a small range.
+CONF_mBool(enable_join_direct_mapping, "true");
+// the maximum range of the build values of direct mapping hash table, i.e. the number of buckets.
+CONF_mInt64(join_direct_mapping_max_range, "4194304");
+// prefetch the bucket heads and the build rows when probing the hash table of hash join whose size is
+// larger than join_probe_prefetch_min_table_bytes, which is much larger than the cache.
+CONF_mBool(enable_join_probe_prefetch, "true");
+CONF_mInt64(join_probe_prefetch_min_table_bytes, "33554432");
+// the number of probe rows to prefetch the bucket heads ahead.
+CONF_mInt32(join_probe_prefetch_distance, "16");
+// cluster the rows of the hash table of hash join into partitions of join_radix_partition_bytes by the high
+// bits of their buckets if there are at least join_radix_partition_min_build_rows build rows, and probe the
+// rows of each probe chunk partition by partition, so that the partition being probed stays in cache.
+// 0 to disable.
+CONF_mInt64(join_radix_partition_min_build_rows, "50000000");
+CONF_mInt64(join_radix_partition_bytes, "2097152");
+// sort the build rows of cross join by the build column of a conjunct like `probe_col < build_col`, and join
+// each probe row only with the build rows in the range found by binary search.
+CONF_mBool(enable_cross_join_range_predicate, "true");
+// evaluate the sub expressions shared by the output expressions of a project node only once per chunk.
+CONF_mBool(enable_project_common_sub_expr_elimination, "true");
 // bitmap serialize version
 CONF_Int16(bitmap_serialize_version, "1");
 // schema change vectorized
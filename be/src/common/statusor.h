@@ -703,3 +703,17 @@ void StatusOr<T>::IgnoreError() const {
 }
 
 } // namespace starrocks
+
+#define STATUSOR_CONCAT_IMPL(x, y) x##y
+#define STATUSOR_CONCAT(x, y) STATUSOR_CONCAT_IMPL(x, y)
+
+#define ASSIGN_OR_RETURN_IMPL(statusor, lhs, rexpr) \
+    auto&& statusor = (rexpr);                      \
+    if (UNLIKELY(!statusor.ok())) {                 \
+        return statusor.status();                   \
+    }                                               \
+    lhs = std::move(statusor).value();
+
+// Evaluate `rexpr` which returns a StatusOr, return its status if it's not ok, otherwise assign
+// its value to `lhs`, e.g. ASSIGN_OR_RETURN(auto file, SpillFile::create(name));
+#define ASSIGN_OR_RETURN(lhs, rexpr) ASSIGN_OR_RETURN_IMPL(STATUSOR_CONCAT(_status_or_value, __COUNTER__), lhs, rexpr)
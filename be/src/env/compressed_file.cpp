@@ -2,6 +2,9 @@
 
 #include "env/compressed_file.h"
 
+#include <algorithm>
+#include <future>
+
 #include "exec/decompressor.h"
 
 namespace starrocks {
@@ -58,4 +61,220 @@ Status CompressedSequentialFile::skip(uint64_t n) {
     return Status::OK();
 }
 
+namespace {
+
+// The bytes of |prefix| followed by the bytes of |file|.
+class PrefixedSequentialFile final : public SequentialFile {
+public:
+    PrefixedSequentialFile(std::string prefix, std::shared_ptr<SequentialFile> file)
+            : _prefix(std::move(prefix)), _file(std::move(file)) {}
+
+    Status read(Slice* result) override {
+        if (_pos < _prefix.size()) {
+            result->size = std::min(result->size, _prefix.size() - _pos);
+            memcpy(result->data, _prefix.data() + _pos, result->size);
+            _pos += result->size;
+            return Status::OK();
+        }
+        return _file->read(result);
+    }
+
+    Status skip(uint64_t n) override {
+        const size_t prefix_skipped = std::min<uint64_t>(n, _prefix.size() - _pos);
+        _pos += prefix_skipped;
+        return n > prefix_skipped ? _file->skip(n - prefix_skipped) : Status::OK();
+    }
+
+    const std::string& filename() const override { return _file->filename(); }
+
+private:
+    const std::string _prefix;
+    size_t _pos = 0;
+    std::shared_ptr<SequentialFile> _file;
+};
+
+} // namespace
+
+struct ParallelCompressedSequentialFile::Task {
+    raw::RawVector<uint8_t> input;
+    raw::RawVector<uint8_t> output;
+    // the number of the bytes of |output| returned.
+    size_t pos = 0;
+    bool ready = false;
+    // destroyed first, which waits for the task to finish.
+    std::future<Status> status;
+};
+
+ParallelCompressedSequentialFile::ParallelCompressedSequentialFile(std::shared_ptr<SequentialFile> input_file,
+                                                                   CompressionTypePB compression, int parallelism,
+                                                                   size_t task_bytes)
+        : _filename("compressed-" + input_file->filename()),
+          _input_file(std::move(input_file)),
+          _compression(compression),
+          _parallelism(std::max(parallelism, 1)),
+          _task_bytes(std::max<size_t>(task_bytes, 64 * 1024)) {}
+
+ParallelCompressedSequentialFile::~ParallelCompressedSequentialFile() = default;
+
+Status ParallelCompressedSequentialFile::read(Slice* result) {
+    while (true) {
+        RETURN_IF_ERROR(_submit_tasks());
+        if (_tasks.empty()) {
+            if (!_frames_unknown) {
+                // end of file.
+                result->size = 0;
+                return Status::OK();
+            }
+            if (_sequential == nullptr) {
+                RETURN_IF_ERROR(_start_sequential());
+            }
+            return _sequential->read(result);
+        }
+        Task* task = _tasks.front().get();
+        if (!task->ready) {
+            Status st = task->status.get();
+            if (!st.ok()) {
+                _tasks.clear();
+                return st;
+            }
+            task->ready = true;
+        }
+        const size_t n = std::min(result->size, task->output.size() - task->pos);
+        memcpy(result->data, task->output.data() + task->pos, n);
+        task->pos += n;
+        if (task->pos == task->output.size()) {
+            _tasks.pop_front();
+        }
+        // skip the tasks of no output, e.g. skippable frames.
+        if (n > 0 || result->size == 0) {
+            result->size = n;
+            return Status::OK();
+        }
+    }
+}
+
+Status ParallelCompressedSequentialFile::skip(uint64_t n) {
+    raw::RawVector<uint8_t> buff;
+    buff.resize(n);
+    while (n > 0) {
+        Slice s(buff.data(), n);
+        RETURN_IF_ERROR(read(&s));
+        if (s.size == 0) {
+            break;
+        }
+        n -= s.size;
+    }
+    return Status::OK();
+}
+
+Status ParallelCompressedSequentialFile::_submit_tasks() {
+    if (_splitter == nullptr) {
+        Decompressor* dec = nullptr;
+        RETURN_IF_ERROR(Decompressor::create_decompressor(_compression, &dec));
+        _splitter.reset(dec);
+    }
+    while (!_frames_unknown && _tasks.size() < static_cast<size_t>(_parallelism)) {
+        // the size of the whole frames from |_input_offset|.
+        size_t frames_bytes = 0;
+        while (frames_bytes < _task_bytes) {
+            const size_t available = _input.size() - _input_offset - frames_bytes;
+            auto res = _splitter->frame_size(_input.data() + _input_offset + frames_bytes, available);
+            if (res.status().is_not_supported()) {
+                _frames_unknown = true;
+                break;
+            }
+            RETURN_IF_ERROR(res.status());
+            if (res.value() > 0) {
+                frames_bytes += res.value();
+            } else if (_input_eof) {
+                if (available > 0) {
+                    return Status::InternalError("Failed to decompress " + _filename + ": truncated frame");
+                }
+                break;
+            } else if (frames_bytes > 0) {
+                // submit the whole frames before reading more input.
+                break;
+            } else if (available >= 4 * _task_bytes) {
+                // a frame too large to be buffered.
+                _frames_unknown = true;
+                break;
+            } else {
+                RETURN_IF_ERROR(_read_input());
+            }
+        }
+        if (frames_bytes == 0) {
+            break;
+        }
+        auto task = std::make_unique<Task>();
+        task->input.assign(_input.begin() + _input_offset, _input.begin() + _input_offset + frames_bytes);
+        _input_offset += frames_bytes;
+        Task* t = task.get();
+        task->status = std::async(std::launch::async, &ParallelCompressedSequentialFile::_decompress, _compression, t);
+        _tasks.emplace_back(std::move(task));
+    }
+    return Status::OK();
+}
+
+Status ParallelCompressedSequentialFile::_read_input() {
+    if (_input_offset > 0) {
+        _input.erase(_input.begin(), _input.begin() + _input_offset);
+        _input_offset = 0;
+    }
+    const size_t size = _input.size();
+    _input.resize(size + _task_bytes);
+    Slice buff(_input.data() + size, _task_bytes);
+    Status st = _input_file->read(&buff);
+    if (st.is_end_of_file()) {
+        buff.size = 0;
+    } else if (!st.ok()) {
+        _input.resize(size);
+        return st;
+    }
+    _input.resize(size + buff.size);
+    _input_eof = buff.size == 0;
+    return Status::OK();
+}
+
+Status ParallelCompressedSequentialFile::_start_sequential() {
+    std::string prefix(reinterpret_cast<const char*>(_input.data()) + _input_offset, _input.size() - _input_offset);
+    _input.clear();
+    _input_offset = 0;
+    auto file = std::make_shared<PrefixedSequentialFile>(std::move(prefix), _input_file);
+    Decompressor* dec = nullptr;
+    RETURN_IF_ERROR(Decompressor::create_decompressor(_compression, &dec));
+    _sequential = std::make_unique<CompressedSequentialFile>(std::move(file), std::shared_ptr<Decompressor>(dec));
+    return Status::OK();
+}
+
+Status ParallelCompressedSequentialFile::_decompress(CompressionTypePB compression, Task* task) {
+    Decompressor* dec = nullptr;
+    RETURN_IF_ERROR(Decompressor::create_decompressor(compression, &dec));
+    std::unique_ptr<Decompressor> decompressor(dec);
+
+    auto& input = task->input;
+    auto& output = task->output;
+    output.resize(std::max<size_t>(input.size() * 4, 64 * 1024));
+    size_t input_pos = 0;
+    size_t output_pos = 0;
+    bool stream_end = false;
+    while (input_pos < input.size() || !stream_end) {
+        if (output_pos == output.size()) {
+            output.resize(output.size() * 2);
+        }
+        size_t input_bytes_read = 0;
+        size_t output_bytes_written = 0;
+        RETURN_IF_ERROR(decompressor->decompress(input.data() + input_pos, input.size() - input_pos,
+                                                 &input_bytes_read, output.data() + output_pos,
+                                                 output.size() - output_pos, &output_bytes_written, &stream_end));
+        input_pos += input_bytes_read;
+        output_pos += output_bytes_written;
+        if (input_bytes_read == 0 && output_bytes_written == 0 && output_pos < output.size()) {
+            return Status::InternalError(
+                    strings::Substitute("Failed to decompress. input_len:$0, output_len:$1", input.size(), output_pos));
+        }
+    }
+    output.resize(output_pos);
+    return Status::OK();
+}
+
 } // namespace starrocks
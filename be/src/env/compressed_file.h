@@ -2,7 +2,10 @@
 
 #pragma once
 
+#include <deque>
+
 #include "env/env.h"
+#include "gen_cpp/types.pb.h"
 #include "util/bit_util.h"
 #include "util/raw_container.h"
 
@@ -76,4 +79,54 @@ private:
     bool _stream_end = false;
 };
 
+// Decompresses the frames of the input that are decompressed independently of each other, e.g. the frames of a zstd
+// or lz4 file or the blocks of a BGZF file, by up to |parallelism| threads ahead of the reader, every thread a run
+// of the frames of about |task_bytes|. The rest of the input is decompressed sequentially once its frames can't be
+// told apart, e.g. a plain gzip file, or a frame is larger than 4 * |task_bytes|.
+class ParallelCompressedSequentialFile final : public SequentialFile {
+public:
+    ParallelCompressedSequentialFile(std::shared_ptr<SequentialFile> input_file, CompressionTypePB compression,
+                                     int parallelism, size_t task_bytes);
+
+    ~ParallelCompressedSequentialFile() override;
+
+    Status read(Slice* result) override;
+
+    Status skip(uint64_t n) override;
+
+    const std::string& filename() const override { return _filename; }
+
+private:
+    struct Task;
+
+    // Submit the frames of the input to the tasks, until |_parallelism| tasks are running.
+    Status _submit_tasks();
+
+    // Append the next bytes of |_input_file| to |_input|.
+    Status _read_input();
+
+    Status _start_sequential();
+
+    static Status _decompress(CompressionTypePB compression, Task* task);
+
+    std::string _filename;
+    std::shared_ptr<SequentialFile> _input_file;
+    const CompressionTypePB _compression;
+    const int _parallelism;
+    const size_t _task_bytes;
+    // used to find the frames of the input.
+    std::unique_ptr<Decompressor> _splitter;
+
+    // the input read but not submitted yet, from |_input_offset|.
+    raw::RawVector<uint8_t> _input;
+    size_t _input_offset = 0;
+    bool _input_eof = false;
+
+    std::deque<std::unique_ptr<Task>> _tasks;
+
+    // whether the rest of the input is decompressed by |_sequential|.
+    bool _frames_unknown = false;
+    std::unique_ptr<SequentialFile> _sequential;
+};
+
 } // namespace starrocks
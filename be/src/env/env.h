@@ -248,6 +248,19 @@ public:
     // Safe for concurrent use by multiple threads.
     virtual Status readv_at(uint64_t offset, const Slice* res, size_t res_cnt) const = 0;
 
+    // Reads "res[i].size" bytes from the file starting at "offsets[i]" for every i in [0, n),
+    // the same as calling `read_at` for every range, but the implementation may submit them in a batch.
+    //
+    // If an error was encountered, returns a non-OK status.
+    //
+    // Safe for concurrent use by multiple threads.
+    virtual Status read_at_batch(const uint64_t* offsets, const Slice* res, size_t n) const {
+        for (size_t i = 0; i < n; i++) {
+            RETURN_IF_ERROR(read_at(offsets[i], res[i]));
+        }
+        return Status::OK();
+    }
+
     // Return the size of this file
     virtual Status size(uint64_t* size) const = 0;
 
@@ -4,11 +4,16 @@
 
 #include <brpc/uri.h>
 
+#include <algorithm>
 #include <chrono>
+#include <cstring>
+#include <deque>
+#include <future>
 #include <memory>
 #include <string>
 #include <thread>
 
+#include "common/config.h"
 #include "env/env.h"
 #include "gen_cpp/FileBrokerService_types.h"
 #include "gen_cpp/TFileBrokerService.h"
@@ -220,17 +225,25 @@ private:
 
 class BrokerSequentialFile : public SequentialFile {
 public:
-    explicit BrokerSequentialFile(std::unique_ptr<RandomAccessFile> random_file) : _file(std::move(random_file)) {}
+    explicit BrokerSequentialFile(std::unique_ptr<RandomAccessFile> random_file)
+            : _file(std::move(random_file)),
+              _read_ahead_blocks(config::broker_read_ahead_blocks),
+              _read_ahead_block_bytes(config::broker_read_ahead_block_bytes) {}
 
+    // Waits for the blocks being read ahead, before closing the file.
     ~BrokerSequentialFile() override = default;
 
     Status read(Slice* result) override {
+        if (_read_ahead_blocks > 0 && _read_ahead_block_bytes > 0) {
+            return _read_ahead(result);
+        }
         Status st = _file->read(_offset, result);
         _offset += st.ok() ? result->size : 0;
         return st;
     }
 
     Status skip(uint64_t n) override {
+        _blocks.clear();
         _offset += n;
         return Status::OK();
     }
@@ -238,8 +251,64 @@ public:
     const std::string& filename() const override { return _file->file_name(); }
 
 private:
+    struct Block {
+        uint64_t offset;
+        std::string data;
+        // the number of the bytes returned.
+        size_t pos = 0;
+        bool ready = false;
+        std::future<Status> status;
+    };
+
+    // Returns the bytes of the first block, while the next blocks up to |_read_ahead_blocks| are being read from
+    // the broker, which reads the file at the bandwidth of many broker requests instead of a single one.
+    Status _read_ahead(Slice* result) {
+        uint64_t file_size = 0;
+        RETURN_IF_ERROR(_file->size(&file_size));
+        uint64_t next = _blocks.empty() ? _offset : _blocks.back()->offset + _blocks.back()->data.size();
+        while (_blocks.size() < static_cast<size_t>(_read_ahead_blocks) && next < file_size) {
+            auto block = std::make_unique<Block>();
+            block->offset = next;
+            block->data.resize(std::min<uint64_t>(_read_ahead_block_bytes, file_size - next));
+            next += block->data.size();
+            Block* b = block.get();
+            RandomAccessFile* file = _file.get();
+            block->status = std::async(std::launch::async, [file, b]() { return file->read_at(b->offset, b->data); });
+            _blocks.emplace_back(std::move(block));
+        }
+        if (_blocks.empty()) {
+            // end of file.
+            result->size = 0;
+            return Status::OK();
+        }
+        Block* b = _blocks.front().get();
+        if (!b->ready) {
+            Status st = b->status.get();
+            if (!st.ok()) {
+                LOG(WARNING) << "Fail to read " << _file->file_name() << ": " << st.message();
+                _blocks.clear();
+                return st;
+            }
+            b->ready = true;
+        }
+        const size_t n = std::min(result->size, b->data.size() - b->pos);
+        memcpy(result->data, b->data.data() + b->pos, n);
+        b->pos += n;
+        result->size = n;
+        _offset += n;
+        if (b->pos == b->data.size()) {
+            _blocks.pop_front();
+        }
+        return Status::OK();
+    }
+
     std::unique_ptr<RandomAccessFile> _file;
     size_t _offset = 0;
+
+    const int32_t _read_ahead_blocks;
+    const int64_t _read_ahead_block_bytes;
+    // the blocks being read ahead from |_offset|, destroyed before |_file|.
+    std::deque<std::unique_ptr<Block>> _blocks;
 };
 
 class BrokerWritableFile : public WritableFile {
@@ -17,8 +17,10 @@
 #include <cstdio>
 #include <memory>
 
+#include "common/config.h"
 #include "common/logging.h"
 #include "env/env.h"
+#include "env/io_uring.h"
 #include "gutil/gscoped_ptr.h"
 #include "gutil/macros.h"
 #include "gutil/port.h"
@@ -276,6 +278,20 @@ public:
     Status readv_at(uint64_t offset, const Slice* res, size_t res_cnt) const override {
         return do_readv_at(_fd, _filename, offset, res, res_cnt, nullptr);
     }
+
+    Status read_at_batch(const uint64_t* offsets, const Slice* res, size_t n) const override {
+        if (n > 1 && config::enable_io_uring) {
+            IoUring* ring = IoUring::local(config::io_uring_queue_depth);
+            if (ring != nullptr) {
+                return ring->pread_batch(_fd, _filename, offsets, res, n);
+            }
+        }
+        for (size_t i = 0; i < n; i++) {
+            RETURN_IF_ERROR(do_readv_at(_fd, _filename, offsets[i], &res[i], 1, nullptr));
+        }
+        return Status::OK();
+    }
+
     Status size(uint64_t* size) const override {
         struct stat st;
         auto res = fstat(_fd, &st);
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "env/env.h"
+#include "util/byte_buffer.h"
 
 namespace starrocks {
 class StreamLoadPipe;
@@ -18,6 +19,9 @@ public:
     Status read(Slice* result) override;
     Status read_one_message(std::unique_ptr<uint8_t[]>* buf, size_t* length);
 
+    // See StreamLoadPipe::read_buffer().
+    Status read_buffer(ByteBufferPtr* buf);
+
     Status skip(uint64_t n) override;
     const std::string& filename() const override { return _filename; }
 
@@ -0,0 +1,271 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "env/io_uring.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#define STARROCKS_HAVE_IO_URING 1
+#endif
+
+#include "common/logging.h"
+#include "gutil/strings/substitute.h"
+#include "util/slice.h"
+
+namespace starrocks {
+
+static Status io_error(const std::string& context, int err_number) {
+    return Status::IOError(context, static_cast<int16_t>(err_number), std::strerror(err_number));
+}
+
+// read |res| at |offset| by pread, retrying on EINTR and short reads.
+static Status pread_fully(int fd, const std::string& filename, uint64_t offset, const Slice& res) {
+    size_t done = 0;
+    while (done < res.size) {
+        ssize_t r = ::pread(fd, res.data + done, res.size - done, offset + done);
+        if (r < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return io_error(filename, errno);
+        }
+        if (r == 0) {
+            return Status::EndOfFile(
+                    strings::Substitute("EOF trying to read $0 bytes at offset $1", res.size, offset));
+        }
+        done += r;
+    }
+    return Status::OK();
+}
+
+#ifdef STARROCKS_HAVE_IO_URING
+
+// set once io_uring_setup failed for the kernel or the seccomp policy, so the other threads don't retry.
+static std::atomic<bool> s_io_uring_unsupported{false};
+
+IoUring::~IoUring() {
+    if (_sqes != nullptr) {
+        munmap(_sqes, _sqes_size);
+    }
+    if (_cq_ptr != nullptr && _cq_ptr != _sq_ptr) {
+        munmap(_cq_ptr, _cq_ring_size);
+    }
+    if (_sq_ptr != nullptr) {
+        munmap(_sq_ptr, _sq_ring_size);
+    }
+    if (_ring_fd >= 0) {
+        ::close(_ring_fd);
+    }
+}
+
+IoUring* IoUring::local(uint32_t queue_depth) {
+    thread_local std::unique_ptr<IoUring> tls_ring;
+    thread_local bool tls_init_failed = false;
+    if (tls_ring != nullptr) {
+        return tls_ring->_broken ? nullptr : tls_ring.get();
+    }
+    if (tls_init_failed || s_io_uring_unsupported.load(std::memory_order_relaxed)) {
+        return nullptr;
+    }
+    std::unique_ptr<IoUring> ring(new IoUring());
+    int err = ring->init(queue_depth);
+    if (err != 0) {
+        tls_init_failed = true;
+        if (err == ENOSYS || err == EPERM || err == EINVAL) {
+            if (!s_io_uring_unsupported.exchange(true)) {
+                LOG(WARNING) << "io_uring is not available, fall back to pread: " << std::strerror(err);
+            }
+        }
+        return nullptr;
+    }
+    tls_ring = std::move(ring);
+    return tls_ring.get();
+}
+
+int IoUring::init(uint32_t queue_depth) {
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    int fd = static_cast<int>(syscall(__NR_io_uring_setup, std::max<uint32_t>(queue_depth, 1), &params));
+    if (fd < 0) {
+        return errno;
+    }
+    _ring_fd = fd;
+    _sq_entries = params.sq_entries;
+
+    _sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    _cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool single_mmap = false;
+#ifdef IORING_FEAT_SINGLE_MMAP
+    single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+#endif
+    if (single_mmap) {
+        _sq_ring_size = _cq_ring_size = std::max(_sq_ring_size, _cq_ring_size);
+    }
+    void* sq_ptr = mmap(nullptr, _sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+                        IORING_OFF_SQ_RING);
+    if (sq_ptr == MAP_FAILED) {
+        return errno;
+    }
+    _sq_ptr = sq_ptr;
+    if (single_mmap) {
+        _cq_ptr = _sq_ptr;
+    } else {
+        void* cq_ptr = mmap(nullptr, _cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+                            IORING_OFF_CQ_RING);
+        if (cq_ptr == MAP_FAILED) {
+            return errno;
+        }
+        _cq_ptr = cq_ptr;
+    }
+    _sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+    void* sqes = mmap(nullptr, _sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+        return errno;
+    }
+    _sqes = sqes;
+
+    auto* sq = static_cast<char*>(_sq_ptr);
+    _sq_head = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+    _sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    _sq_mask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    _sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+    auto* cq = static_cast<char*>(_cq_ptr);
+    _cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    _cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    _cq_mask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    _cqes = cq + params.cq_off.cqes;
+    return 0;
+}
+
+Status IoUring::submit_and_wait(int fd, const std::string& filename, const uint64_t* offsets, const Slice* res,
+                                size_t begin, size_t end) {
+    const size_t num_reads = end - begin;
+    DCHECK_LE(num_reads, _sq_entries);
+    // referenced by the kernel until the completions are reaped.
+    std::vector<iovec> iovs(num_reads);
+    unsigned tail = *_sq_tail;
+    for (size_t i = 0; i < num_reads; i++) {
+        const Slice& slice = res[begin + i];
+        iovs[i] = {slice.data, slice.size};
+        unsigned idx = tail & *_sq_mask;
+        auto* sqe = static_cast<io_uring_sqe*>(_sqes) + idx;
+        memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = IORING_OP_READV;
+        sqe->fd = fd;
+        sqe->addr = reinterpret_cast<uint64_t>(&iovs[i]);
+        sqe->len = 1;
+        sqe->off = offsets[begin + i];
+        sqe->user_data = i;
+        _sq_array[idx] = idx;
+        tail++;
+    }
+    __atomic_store_n(_sq_tail, tail, __ATOMIC_RELEASE);
+
+    size_t num_submitted = 0;
+    while (num_submitted < num_reads) {
+        int r = static_cast<int>(
+                syscall(__NR_io_uring_enter, _ring_fd, num_reads - num_submitted, 0, 0, nullptr, 0));
+        if (r > 0) {
+            num_submitted += r;
+        } else if (r < 0 && errno == EINTR) {
+            continue;
+        } else {
+            // the rest are left in the submission queue, never submit them again.
+            PLOG(WARNING) << "io_uring_enter failed, fall back to pread";
+            _broken = true;
+            break;
+        }
+    }
+
+    // the result of every read, or INT32_MIN if not submitted.
+    std::vector<int32_t> results(num_reads, INT32_MIN);
+    size_t num_completed = 0;
+    unsigned head = *_cq_head;
+    while (num_completed < num_submitted) {
+        if (head == __atomic_load_n(_cq_tail, __ATOMIC_ACQUIRE)) {
+            int r = static_cast<int>(
+                    syscall(__NR_io_uring_enter, _ring_fd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0));
+            // the buffers are still being read by the kernel, can't return without the completions.
+            PLOG_IF(FATAL, r < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY)
+                    << "io_uring_enter failed to wait for the completions";
+            continue;
+        }
+        const auto* cqe = static_cast<const io_uring_cqe*>(_cqes) + (head & *_cq_mask);
+        results[cqe->user_data] = cqe->res;
+        __atomic_store_n(_cq_head, ++head, __ATOMIC_RELEASE);
+        num_completed++;
+    }
+
+    Status st;
+    for (size_t i = 0; i < num_reads; i++) {
+        const uint64_t offset = offsets[begin + i];
+        const Slice& slice = res[begin + i];
+        int32_t r = results[i];
+        Status s;
+        if (r == INT32_MIN || r == -EINTR || r == -EAGAIN) {
+            s = pread_fully(fd, filename, offset, slice);
+        } else if (r < 0) {
+            s = io_error(filename, -r);
+        } else if (static_cast<size_t>(r) < slice.size) {
+            // short read, read the rest by pread, which returns EndOfFile if it's the end of the file.
+            s = pread_fully(fd, filename, offset + r, Slice(slice.data + r, slice.size - r));
+        }
+        if (st.ok() && !s.ok()) {
+            st = s;
+        }
+    }
+    return st;
+}
+
+Status IoUring::pread_batch(int fd, const std::string& filename, const uint64_t* offsets, const Slice* res,
+                            size_t n) {
+    size_t i = 0;
+    while (i < n && !_broken) {
+        const size_t end = std::min<size_t>(n, i + _sq_entries);
+        RETURN_IF_ERROR(submit_and_wait(fd, filename, offsets, res, i, end));
+        i = end;
+    }
+    for (; i < n; i++) {
+        RETURN_IF_ERROR(pread_fully(fd, filename, offsets[i], res[i]));
+    }
+    return Status::OK();
+}
+
+#else
+
+IoUring::~IoUring() = default;
+
+IoUring* IoUring::local(uint32_t queue_depth) {
+    return nullptr;
+}
+
+int IoUring::init(uint32_t queue_depth) {
+    return ENOSYS;
+}
+
+Status IoUring::submit_and_wait(int fd, const std::string& filename, const uint64_t* offsets, const Slice* res,
+                                size_t begin, size_t end) {
+    return Status::NotSupported("io_uring is not supported");
+}
+
+Status IoUring::pread_batch(int fd, const std::string& filename, const uint64_t* offsets, const Slice* res,
+                            size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        RETURN_IF_ERROR(pread_fully(fd, filename, offsets[i], res[i]));
+    }
+    return Status::OK();
+}
+
+#endif
+
+} // namespace starrocks
@@ -0,0 +1,66 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "common/status.h"
+
+namespace starrocks {
+
+class Slice;
+
+// A minimal io_uring of one thread, for submitting a batch of reads in one system call and waiting for all of
+// them. It's driven by the raw system calls, liburing is not a dependency.
+//
+// Not thread-safe, use `IoUring::local()` to get the ring of the calling thread.
+class IoUring {
+public:
+    ~IoUring();
+
+    // Returns the ring of the calling thread, created on the first call with |queue_depth| entries.
+    // Returns nullptr if io_uring is not supported by the kernel or not permitted, the caller should fall back
+    // to the synchronous reads.
+    static IoUring* local(uint32_t queue_depth);
+
+    // Reads |res[i].size| bytes at |offsets[i]| of |fd| into |res[i]| for every i in [0, n), at most
+    // `queue_depth` reads are in flight. The short reads are completed by pread.
+    // Returns the first error, or EndOfFile if any range is beyond the end of the file.
+    Status pread_batch(int fd, const std::string& filename, const uint64_t* offsets, const Slice* res, size_t n);
+
+private:
+    IoUring() = default;
+
+    // returns 0 on success, or the errno of io_uring_setup.
+    int init(uint32_t queue_depth);
+
+    // submit and wait for the reads [begin, end) of the batch, |end - begin| is not larger than |_sq_entries|.
+    Status submit_and_wait(int fd, const std::string& filename, const uint64_t* offsets, const Slice* res,
+                           size_t begin, size_t end);
+
+    int _ring_fd = -1;
+    // broken after an unexpected error of io_uring_enter, all the following reads fall back to pread.
+    bool _broken = false;
+
+    void* _sq_ptr = nullptr;
+    size_t _sq_ring_size = 0;
+    void* _cq_ptr = nullptr;
+    size_t _cq_ring_size = 0;
+    void* _sqes = nullptr;
+    size_t _sqes_size = 0;
+
+    uint32_t _sq_entries = 0;
+    unsigned* _sq_head = nullptr;
+    unsigned* _sq_tail = nullptr;
+    unsigned* _sq_mask = nullptr;
+    unsigned* _sq_array = nullptr;
+    unsigned* _cq_head = nullptr;
+    unsigned* _cq_tail = nullptr;
+    unsigned* _cq_mask = nullptr;
+    void* _cqes = nullptr;
+};
+
+} // namespace starrocks
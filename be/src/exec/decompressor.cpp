@@ -21,6 +21,8 @@
 
 #include "exec/decompressor.h"
 
+#include "util/coding.h"
+
 namespace starrocks {
 
 Status Decompressor::create_decompressor(CompressionTypePB type, Decompressor** decompressor) {
@@ -142,6 +144,33 @@ Status GzipDecompressor::decompress(uint8_t* input, size_t input_len, size_t* in
     return Status::OK();
 }
 
+// BGZF, e.g. written by bgzip, is a series of gzip members with the size of the member in the extra subfield "BC".
+StatusOr<size_t> GzipDecompressor::frame_size(const uint8_t* input, size_t input_len) {
+    if (_is_deflate) {
+        return Status::NotSupported("frame_size of deflate");
+    }
+    if (input_len < 12) {
+        return 0;
+    }
+    // ID1, ID2, CM = deflate, FLG.FEXTRA
+    if (input[0] != 0x1f || input[1] != 0x8b || input[2] != 8 || (input[3] & 0x04) == 0) {
+        return Status::NotSupported("not a BGZF block");
+    }
+    const size_t extra_end = 12 + decode_fixed16_le(input + 10);
+    if (input_len < extra_end) {
+        return 0;
+    }
+    for (size_t pos = 12; pos + 4 <= extra_end;) {
+        const size_t subfield_len = decode_fixed16_le(input + pos + 2);
+        if (input[pos] == 'B' && input[pos + 1] == 'C' && subfield_len == 2 && pos + 6 <= extra_end) {
+            const size_t size = decode_fixed16_le(input + pos + 4) + 1;
+            return input_len >= size ? size : 0;
+        }
+        pos += 4 + subfield_len;
+    }
+    return Status::NotSupported("not a BGZF block");
+}
+
 std::string GzipDecompressor::debug_info() {
     std::stringstream ss;
     ss << "GzipDecompressor."
@@ -307,6 +336,42 @@ Status Lz4FrameDecompressor::decompress(uint8_t* input, size_t input_len, size_t
     return Status::OK();
 }
 
+static const uint32_t k_lz4f_magic_number = 0x184D2204U;
+static const uint32_t k_lz4f_magic_skippable_start = 0x184D2A50U;
+
+StatusOr<size_t> Lz4FrameDecompressor::frame_size(const uint8_t* input, size_t input_len) {
+    if (input_len < 8) {
+        return 0;
+    }
+    const uint32_t magic = decode_fixed32_le(input);
+    if ((magic & 0xFFFFFFF0U) == k_lz4f_magic_skippable_start) {
+        const size_t size = 8 + decode_fixed32_le(input + 4);
+        return input_len >= size ? size : 0;
+    }
+    if (magic != k_lz4f_magic_number) {
+        return Status::InternalError(strings::Substitute("Bad lz4 frame magic number $0", magic));
+    }
+    // Magic, FLG, BD, [content size], [dictionary id], HC
+    const uint8_t flg = input[4];
+    size_t pos = 4 + 2 + ((flg & 0x08) ? 8 : 0) + ((flg & 0x01) ? 4 : 0) + 1;
+    const size_t block_checksum_size = (flg & 0x10) ? 4 : 0;
+    while (true) {
+        if (pos + 4 > input_len) {
+            return 0;
+        }
+        const uint32_t block_size = decode_fixed32_le(input + pos);
+        pos += 4;
+        if (block_size == 0) {
+            // EndMark
+            break;
+        }
+        // the highest bit tells whether the block is uncompressed.
+        pos += (block_size & 0x7FFFFFFFU) + block_checksum_size;
+    }
+    pos += (flg & 0x04) ? 4 : 0;
+    return input_len >= pos ? pos : 0;
+}
+
 std::string Lz4FrameDecompressor::debug_info() {
     std::stringstream ss;
     ss << "Lz4FrameDecompressor."
@@ -365,6 +430,18 @@ Status ZstandardDecompressor::decompress(uint8_t* input, size_t input_len, size_
     return Status::OK();
 }
 
+StatusOr<size_t> ZstandardDecompressor::frame_size(const uint8_t* input, size_t input_len) {
+    size_t ret = ZSTD_findFrameCompressedSize(input, input_len);
+    if (ZSTD_isError(ret)) {
+        if (ZSTD_getErrorCode(ret) == ZSTD_error_srcSize_wrong) {
+            return 0;
+        }
+        return Status::InternalError(
+                strings::Substitute("ZSTD find frame failed. error: $0", ZSTD_getErrorString(ZSTD_getErrorCode(ret))));
+    }
+    return ret;
+}
+
 std::string ZstandardDecompressor::debug_info() {
     return "ZstandardDecompressor";
 }
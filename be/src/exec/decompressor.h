@@ -28,6 +28,7 @@
 #include <zstd/zstd_errors.h>
 
 #include "common/status.h"
+#include "common/statusor.h"
 #include "gen_cpp/types.pb.h"
 #include "gutil/strings/substitute.h"
 
@@ -51,6 +52,13 @@ public:
     virtual Status decompress(uint8_t* input, size_t input_len, size_t* input_bytes_read, uint8_t* output,
                               size_t output_len, size_t* output_bytes_written, bool* stream_end) = 0;
 
+    // Returns the size of the frame at the head of |input|, which is decompressed independently of the other
+    // frames, or 0 if |input| doesn't hold the whole frame. Returns NotSupported if the frames of the input can't
+    // be told apart without decompressing them.
+    virtual StatusOr<size_t> frame_size(const uint8_t* input, size_t input_len) {
+        return Status::NotSupported("frame_size");
+    }
+
 public:
     static Status create_decompressor(CompressionTypePB type, Decompressor** decompressor);
 
@@ -73,6 +81,8 @@ public:
     Status decompress(uint8_t* input, size_t input_len, size_t* input_bytes_read, uint8_t* output, size_t output_len,
                       size_t* output_bytes_written, bool* stream_end) override;
 
+    StatusOr<size_t> frame_size(const uint8_t* input, size_t input_len) override;
+
     std::string debug_info() override;
 
 private:
@@ -115,6 +125,8 @@ public:
     Status decompress(uint8_t* input, size_t input_len, size_t* input_bytes_read, uint8_t* output, size_t output_len,
                       size_t* output_bytes_written, bool* stream_end) override;
 
+    StatusOr<size_t> frame_size(const uint8_t* input, size_t input_len) override;
+
     std::string debug_info() override;
 
 private:
@@ -139,6 +151,8 @@ public:
     Status decompress(uint8_t* input, size_t input_len, size_t* input_bytes_read, uint8_t* output, size_t output_len,
                       size_t* output_bytes_write, bool* stream_end) override;
 
+    StatusOr<size_t> frame_size(const uint8_t* input, size_t input_len) override;
+
     std::string debug_info() override;
 
 private:
@@ -128,6 +128,13 @@ std::string ESScrollQueryBuilder::build(const std::map<std::string, std::string>
     rapidjson::Value field("_doc", allocator);
     sort_node.PushBack(field, allocator);
     es_query_dsl.AddMember("sort", sort_node, allocator);
+    // split the scroll of the shard into the slices scanned concurrently.
+    if (properties.find(ESScanReader::KEY_SLICE_MAX) != properties.end()) {
+        rapidjson::Value slice_node(rapidjson::kObjectType);
+        slice_node.AddMember("id", atoi(properties.at(ESScanReader::KEY_SLICE_ID).c_str()), allocator);
+        slice_node.AddMember("max", atoi(properties.at(ESScanReader::KEY_SLICE_MAX).c_str()), allocator);
+        es_query_dsl.AddMember("slice", slice_node, allocator);
+    }
     // number of docuements returned
     es_query_dsl.AddMember("size", size, allocator);
     rapidjson::StringBuffer buffer;
@@ -47,6 +47,7 @@
 #include "exec/vectorized/hash_join_node.h"
 #include "exec/vectorized/hdfs_scan_node.h"
 #include "exec/vectorized/intersect_node.h"
+#include "exec/vectorized/merge_join_node.h"
 #include "exec/vectorized/mysql_scan_node.h"
 #include "exec/vectorized/olap_meta_scan_node.h"
 #include "exec/vectorized/olap_scan_node.h"
@@ -469,6 +470,9 @@ Status ExecNode::create_vectorized_node(starrocks::RuntimeState* state, starrock
     case TPlanNodeType::CROSS_JOIN_NODE:
         *node = pool->add(new vectorized::CrossJoinNode(pool, tnode, descs));
         return Status::OK();
+    case TPlanNodeType::MERGE_JOIN_NODE:
+        *node = pool->add(new vectorized::MergeJoinNode(pool, tnode, descs));
+        return Status::OK();
     case TPlanNodeType::UNION_NODE:
         *node = pool->add(new vectorized::UnionNode(pool, tnode, descs));
         return Status::OK();
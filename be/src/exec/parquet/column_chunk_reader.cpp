@@ -89,6 +89,7 @@ Status ColumnChunkReader::init() {
     }
 
     _page_reader = std::make_unique<PageReader>(_file.get(), start_offset, metadata().total_compressed_size);
+    _end_offset = start_offset + metadata().total_compressed_size;
 
     // seek to the first page
     _page_reader->seek_to_offset(start_offset);
@@ -98,12 +99,41 @@ Status ColumnChunkReader::init() {
 
     RETURN_IF_ERROR(_try_load_dictionary());
     RETURN_IF_ERROR(_parse_page_data());
+    _page_index = 0;
     return Status::OK();
 }
 
 Status ColumnChunkReader::next_page() {
     RETURN_IF_ERROR(_parse_page_header());
     RETURN_IF_ERROR(_parse_page_data());
+    _page_index++;
+    return Status::OK();
+}
+
+int64_t ColumnChunkReader::next_page_num_rows() const {
+    if (_opts.offset_index == nullptr) {
+        return -1;
+    }
+    const auto& locations = _opts.offset_index->page_locations;
+    size_t next = _page_index + 1;
+    if (next >= locations.size()) {
+        return -1;
+    }
+    int64_t end_row = next + 1 < locations.size() ? locations[next + 1].first_row_index : _opts.num_rows;
+    return end_row - locations[next].first_row_index;
+}
+
+Status ColumnChunkReader::skip_next_page() {
+    DCHECK(_page_parse_state == PAGE_DATA_PARSED);
+    DCHECK(_opts.offset_index != nullptr);
+    const auto& locations = _opts.offset_index->page_locations;
+    _page_index++;
+    if (_page_index + 1 < locations.size()) {
+        _page_reader->seek_to_offset(locations[_page_index + 1].offset);
+    } else {
+        // the skipped page is the last one
+        _page_reader->seek_to_offset(_end_offset);
+    }
     return Status::OK();
 }
 
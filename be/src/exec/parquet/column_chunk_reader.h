@@ -25,6 +25,10 @@ namespace starrocks::parquet {
 
 struct ColumnChunkReaderOptions {
     vectorized::HdfsScanStats* stats = nullptr;
+    // page locations of the column chunk, used to skip pages without reading them
+    const tparquet::OffsetIndex* offset_index = nullptr;
+    // number of rows of the row group
+    int64_t num_rows = 0;
 };
 
 class PageReader;
@@ -42,6 +46,14 @@ public:
 
     uint32_t num_values() const { return _num_values; }
 
+    // Return the number of rows of the page following the current one according to the offset
+    // index, or -1 if the offset index is not given or the current page is the last one.
+    int64_t next_page_num_rows() const;
+
+    // Skip the page following the current one without reading it. The current page must have
+    // been consumed and next_page_num_rows() must not be -1.
+    Status skip_next_page();
+
     // Try to decode n definition levels into 'levels'
     // return number of decoded levels.
     // If the returned value is less than input n, this means current page don't have
@@ -82,6 +94,9 @@ public:
         return _cur_decoder->next_batch(n, content_type, dst);
     }
 
+    // Skip n non-null values of current page without decoding them into column.
+    Status skip_values(size_t n) { return _cur_decoder->skip(n); }
+
     const tparquet::ColumnMetaData& metadata() const { return _chunk_metadata->meta_data; }
 
     Status get_dict_values(vectorized::Column* column) { return _cur_decoder->get_dict_values(column); }
@@ -129,6 +144,9 @@ private:
     LevelDecoder _rep_level_decoder;
 
     size_t _num_values = 0;
+    // index of the current data page in the offset index
+    size_t _page_index = 0;
+    uint64_t _end_offset = 0;
 
     std::unique_ptr<uint8_t[]> _uncompressed_buf;
     size_t _uncompressed_buf_capacity = 0;
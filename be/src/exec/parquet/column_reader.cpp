@@ -5,6 +5,7 @@
 #include <memory>
 #include <utility>
 
+#include "column/array_column.h"
 #include "column/binary_column.h"
 #include "column/column_helper.h"
 #include "column/fixed_length_column.h"
@@ -16,6 +17,7 @@
 #include "gutil/strings/substitute.h"
 #include "runtime/decimalv2_value.h"
 #include "runtime/primitive_type.h"
+#include "simd/simd.h"
 #include "storage/types.h"
 #include "util/bit_util.h"
 #include "util/debug_util.h"
@@ -323,9 +325,11 @@ public:
     ~ScalarColumnReader() override = default;
 
     Status init(RandomAccessFile* file, const ParquetField* field, const tparquet::ColumnChunk* chunk_metadata,
-                const TypeDescriptor& col_type) {
+                int64_t num_rows, const TypeDescriptor& col_type) {
         StoredColumnReaderOptions opts;
         opts.stats = _opts.stats;
+        opts.offset_index = _opts.offset_index;
+        opts.num_rows = num_rows;
         _field = field;
         _col_type = col_type;
 
@@ -356,6 +360,8 @@ public:
 
     Status finish_batch() override { return Status::OK(); }
 
+    Status skip_rows(size_t num_rows) override { return _reader->skip_rows(num_rows); }
+
     void get_levels(level_t** def_levels, level_t** rep_levels, size_t* num_levels) override {
         _reader->get_levels(def_levels, rep_levels, num_levels);
     }
@@ -565,7 +571,7 @@ vectorized::ColumnPtr ScalarColumnReader::_create_column(tparquet::Type::type ty
 }
 
 static void def_rep_to_offset(const LevelInfo& level_info, const level_t* def_levels, const level_t* rep_levels,
-                              size_t num_levels, int32_t* offsets, int8_t* is_nulls, size_t* num_offsets) {
+                              size_t num_levels, uint32_t* offsets, uint8_t* is_nulls, size_t* num_offsets) {
     size_t offset_pos = 0;
     for (int i = 0; i < num_levels; ++i) {
         // when dev_level is less than immediate_repeated_ancestor_def_level, it means that level
@@ -600,6 +606,10 @@ static void def_rep_to_offset(const LevelInfo& level_info, const level_t* def_le
     *num_offsets = offset_pos;
 }
 
+// ListColumnReader assembles the arrays of a batch from the def and rep levels of its leaf column.
+// The elements are read by the element reader into the elements column of the ArrayColumn, then
+// the offsets and null flags of the arrays are appended by the levels, so that nested arrays are
+// assembled level by level without converting the values row by row.
 class ListColumnReader : public ColumnReader {
 public:
     ListColumnReader(ColumnReaderOptions opts) : _opts(std::move(opts)) {}
@@ -612,25 +622,46 @@ public:
     }
 
     Status prepare_batch(size_t* num_records, ColumnContentType content_type, vectorized::Column* dst) override {
-        return _element_reader->prepare_batch(num_records, content_type, dst);
-    }
+        vectorized::NullableColumn* nullable_column = nullptr;
+        vectorized::ArrayColumn* array_column = nullptr;
+        if (dst->is_nullable()) {
+            nullable_column = down_cast<vectorized::NullableColumn*>(dst);
+            array_column = down_cast<vectorized::ArrayColumn*>(nullable_column->data_column().get());
+        } else {
+            array_column = down_cast<vectorized::ArrayColumn*>(dst);
+        }
+
+        // the element reader returns end of file only if no rows are read
+        vectorized::Column* elements = array_column->elements_column().get();
+        RETURN_IF_ERROR(_element_reader->prepare_batch(num_records, content_type, elements));
 
-    Status finish_batch() override {
         level_t* def_levels = nullptr;
         level_t* rep_levels = nullptr;
         size_t num_levels = 0;
-
         _element_reader->get_levels(&def_levels, &rep_levels, &num_levels);
-        std::vector<int32_t> offsets(num_levels + 1);
-        std::vector<int8_t> is_nulls(num_levels);
-        size_t num_offsets = 0;
 
-        offsets[0] = 0;
-        def_rep_to_offset(_field->level_info, def_levels, rep_levels, num_levels, &offsets[0], &is_nulls[0],
-                          &num_offsets);
+        // every array has at least one level, so the number of levels is an upper bound of the
+        // number of arrays. The last offset of the column is the start of the first array.
+        auto& offsets = array_column->offsets_column()->get_data();
+        size_t num_offsets_before = offsets.size();
+        offsets.resize(num_offsets_before + num_levels);
+        _is_nulls.resize(num_levels);
+        size_t num_offsets = 0;
+        def_rep_to_offset(_field->level_info, def_levels, rep_levels, num_levels, &offsets[num_offsets_before - 1],
+                          _is_nulls.data(), &num_offsets);
+        offsets.resize(num_offsets_before + num_offsets);
+        DCHECK_EQ(offsets.back(), elements->size());
+
+        if (nullable_column != nullptr) {
+            auto& null_data = nullable_column->null_column()->get_data();
+            null_data.insert(null_data.end(), _is_nulls.begin(), _is_nulls.begin() + num_offsets);
+            nullable_column->set_has_null(SIMD::count_nonzero(_is_nulls.data(), num_offsets) > 0);
+        }
         return Status::OK();
     }
 
+    Status finish_batch() override { return _element_reader->finish_batch(); }
+
     void get_levels(level_t** def_levels, level_t** rep_levels, size_t* num_levels) override {
         _element_reader->get_levels(def_levels, rep_levels, num_levels);
     }
@@ -640,23 +671,35 @@ private:
 
     const ParquetField* _field = nullptr;
     std::unique_ptr<ColumnReader> _element_reader;
+
+    std::vector<uint8_t> _is_nulls;
 };
 
 Status ColumnReader::create(RandomAccessFile* file, const ParquetField* field, const tparquet::RowGroup& row_group,
                             const TypeDescriptor& col_type, const ColumnReaderOptions& opts,
                             std::unique_ptr<ColumnReader>* output) {
+    // struct and map columns are not supported by the execution engine yet, they are parsed in
+    // the schema so that the columns after them are resolved correctly.
     if (field->type.type == TYPE_MAP || field->type.type == TYPE_STRUCT) {
-        return Status::InternalError("not supported type");
+        return Status::NotSupported(
+                strings::Substitute("parquet column reader: not supported nested type of column $0", field->name));
     }
     if (field->type.type == TYPE_ARRAY) {
+        if (col_type.type != TYPE_ARRAY) {
+            return Status::NotSupported(
+                    strings::Substitute("parquet column reader: not supported convert from parquet `ARRAY` to `$0`",
+                                        type_to_string(col_type.type)));
+        }
         std::unique_ptr<ColumnReader> child_reader;
-        RETURN_IF_ERROR(ColumnReader::create(file, &field->children[0], row_group, col_type, opts, &child_reader));
+        RETURN_IF_ERROR(ColumnReader::create(file, &field->children[0], row_group, col_type.children[0], opts,
+                                             &child_reader));
         std::unique_ptr<ListColumnReader> reader(new ListColumnReader(opts));
         RETURN_IF_ERROR(reader->init(field, std::move(child_reader)));
         *output = std::move(reader);
     } else {
         std::unique_ptr<ScalarColumnReader> reader(new ScalarColumnReader(opts));
-        RETURN_IF_ERROR(reader->init(file, field, &row_group.columns[field->physical_column_index], col_type));
+        RETURN_IF_ERROR(reader->init(file, field, &row_group.columns[field->physical_column_index], row_group.num_rows,
+                                     col_type));
         *output = std::move(reader);
     }
     return Status::OK();
@@ -25,6 +25,8 @@ class ParquetField;
 struct ColumnReaderOptions {
     vectorized::HdfsScanStats* stats = nullptr;
     std::string timezone;
+    // page locations of the column chunk, set when the reader is asked to skip rows
+    const tparquet::OffsetIndex* offset_index = nullptr;
 };
 
 class ColumnReader {
@@ -45,6 +47,10 @@ public:
         return finish_batch();
     }
 
+    // Skip the next num_rows rows without decoding their values, the pages of the skipped rows
+    // are not read when possible.
+    virtual Status skip_rows(size_t num_rows) { return Status::NotSupported("skip_rows is not supported"); }
+
     virtual void get_levels(level_t** def_levels, level_t** rep_levels, size_t* num_levels) = 0;
 
     virtual Status get_dict_values(vectorized::Column* column) {
@@ -67,6 +67,9 @@ public:
     // It will return ERROR if caller wants to read out-of-bound data.
     virtual Status next_batch(size_t count, ColumnContentType content_type, vectorized::Column* dst) = 0;
 
+    // Skip the next count values without materializing them.
+    virtual Status skip(size_t count) { return Status::NotSupported("skip is not supported"); }
+
     // Currently, this function is only used to read dictionary values.
     virtual Status next_batch(size_t count, uint8_t* dst) {
         return Status::NotSupported("next_batch is not supportted");
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <map>
 
 #include "column/column.h"
@@ -97,31 +98,37 @@ public:
     }
 
     Status next_batch(size_t count, ColumnContentType content_type, vectorized::Column* dst) override {
-        _index_batch_decoder.GetBatch(&_indexes[0], count);
-
+        vectorized::FixedLengthColumn<T>* data_column = nullptr;
         if (dst->is_nullable()) {
             auto* nullable_column = reinterpret_cast<vectorized::NullableColumn*>(dst);
-            auto* data_column =
-                    reinterpret_cast<vectorized::FixedLengthColumn<T>*>(nullable_column->data_column().get());
-            size_t cur_size = data_column->size();
-            data_column->resize_uninitialized(cur_size + count);
-
-            for (int i = 0; i < count; i++) {
-                data_column->get_data()[cur_size + i] = _dict[_indexes[i]];
-            }
-
+            data_column = reinterpret_cast<vectorized::FixedLengthColumn<T>*>(nullable_column->data_column().get());
             nullable_column->null_column()->append_default(count);
         } else {
             // current can't reach here
-            auto* data_column = reinterpret_cast<vectorized::FixedLengthColumn<T>*>(dst);
-            size_t cur_size = data_column->size();
-            data_column->resize_uninitialized(cur_size + count);
+            data_column = reinterpret_cast<vectorized::FixedLengthColumn<T>*>(dst);
+        }
+        size_t cur_size = data_column->size();
+        data_column->resize_uninitialized(cur_size + count);
+
+        // the values are looked up while the indexes are decoded, so that the indexes of the
+        // repeated runs are never materialized
+        auto n = _index_batch_decoder.GetBatchWithDict(_dict.data(), static_cast<int32_t>(_dict.size()),
+                                                       &data_column->get_data()[cur_size], count);
+        if (n != static_cast<int32_t>(count)) {
+            return Status::Corruption("invalid dict index or truncated dict encoded data");
+        }
+        return Status::OK();
+    }
 
-            for (int i = 0; i < count; i++) {
-                data_column->get_data()[cur_size + i] = _dict[_indexes[i]];
+    Status skip(size_t count) override {
+        // only the indexes are decoded, the values are not looked up
+        while (count > 0) {
+            auto n = static_cast<int32_t>(std::min(count, _indexes.size()));
+            if (_index_batch_decoder.GetBatch(&_indexes[0], n) != n) {
+                return Status::InternalError("going to skip out-of-bounds data");
             }
+            count -= n;
         }
-
         return Status::OK();
     }
 
@@ -206,17 +213,19 @@ public:
     }
 
     Status next_batch(size_t count, ColumnContentType content_type, vectorized::Column* dst) override {
-        _index_batch_decoder.GetBatch(&_indexes[0], count);
-
         switch (content_type) {
         case DICT_CODE: {
+            if (_index_batch_decoder.GetBatch(&_indexes[0], count) != static_cast<int32_t>(count)) {
+                return Status::Corruption("truncated dict encoded data");
+            }
             dst->append_numbers(&_indexes[0], count * SIZE_OF_DICT_CODE_TYPE);
             break;
         }
         case VALUE: {
             raw::stl_vector_resize_uninitialized(&_slices, count);
-            for (int i = 0; i < count; ++i) {
-                _slices[i] = _dict[_indexes[i]];
+            if (_index_batch_decoder.GetBatchWithDict(_dict.data(), static_cast<int32_t>(_dict.size()), &_slices[0],
+                                                      count) != static_cast<int32_t>(count)) {
+                return Status::Corruption("invalid dict index or truncated dict encoded data");
             }
             dst->append_strings_overflow(_slices, _max_value_length);
             break;
@@ -228,6 +237,18 @@ public:
         return Status::OK();
     }
 
+    Status skip(size_t count) override {
+        // only the indexes are decoded, the values are not looked up
+        while (count > 0) {
+            auto n = static_cast<int32_t>(std::min(count, _indexes.size()));
+            if (_index_batch_decoder.GetBatch(&_indexes[0], n) != n) {
+                return Status::InternalError("going to skip out-of-bounds data");
+            }
+            count -= n;
+        }
+        return Status::OK();
+    }
+
 private:
     enum { SIZE_OF_DICT_CODE_TYPE = sizeof(int32_t) };
     std::unordered_map<Slice, int32_t, SliceHasher> _dict_code_by_value;
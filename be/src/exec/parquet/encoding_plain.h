@@ -94,6 +94,16 @@ public:
         return Status::OK();
     }
 
+    Status skip(size_t count) override {
+        size_t max_fetch = count * SIZE_OF_TYPE;
+        if (max_fetch + _offset > _data.size) {
+            return Status::InternalError(strings::Substitute(
+                    "going to skip out-of-bounds data, offset=$0,count=$1,size=$2", _offset, count, _data.size));
+        }
+        _offset += max_fetch;
+        return Status::OK();
+    }
+
 private:
     enum { SIZE_OF_TYPE = sizeof(T) };
 
@@ -159,6 +169,20 @@ public:
         return Status::OK();
     }
 
+    Status skip(size_t count) override {
+        size_t num_skipped = 0;
+        while (num_skipped < count && _offset < _data.size) {
+            uint32_t length = decode_fixed32_le(reinterpret_cast<const uint8_t*>(_data.data) + _offset);
+            _offset += sizeof(int32_t) + length;
+            num_skipped++;
+        }
+        if (num_skipped < count || _offset > _data.size) {
+            return Status::InternalError(strings::Substitute(
+                    "going to skip out-of-bounds data, offset=$0,count=$1,size=$2", _offset, count, _data.size));
+        }
+        return Status::OK();
+    }
+
 private:
     Slice _data;
     size_t _offset = 0;
@@ -238,6 +262,15 @@ public:
         return Status::OK();
     }
 
+    Status skip(size_t count) override {
+        if (_offset + _type_length * count > _data.size) {
+            return Status::InternalError(strings::Substitute(
+                    "going to skip out-of-bounds data, offset=$0,count=$1,size=$2", _offset, count, _data.size));
+        }
+        _offset += _type_length * count;
+        return Status::OK();
+    }
+
 private:
     Slice _data;
     size_t _type_length;
@@ -9,6 +9,8 @@
 #include "exec/exec_node.h"
 #include "exec/parquet/encoding_plain.h"
 #include "exec/parquet/metadata.h"
+#include "exec/parquet/page_index_reader.h"
+#include "exec/vectorized/hdfs_file_meta_cache.h"
 #include "exprs/expr.h"
 #include "exprs/expr_context.h"
 #include "gen_cpp/parquet_types.h"
@@ -60,6 +62,21 @@ Status FileReader::get_next(vectorized::ChunkPtr* chunk) {
 }
 
 Status FileReader::_parse_footer() {
+    auto* meta_cache = vectorized::HdfsFileMetaCache::instance();
+    std::string cache_key;
+    if (meta_cache != nullptr) {
+        int64_t mtime = -1;
+        if (!_param.scan_ranges.empty() && _param.scan_ranges[0]->__isset.modification_time) {
+            mtime = _param.scan_ranges[0]->modification_time;
+        }
+        cache_key = vectorized::HdfsFileMetaCache::make_key("parquet", _file->file_name(), _file_size, mtime);
+        _file_metadata = meta_cache->lookup<FileMetaData>(cache_key);
+        if (_file_metadata != nullptr) {
+            _param.stats->footer_cache_hit += 1;
+            return Status::OK();
+        }
+    }
+
     // try with buffer on stack
     constexpr uint64_t footer_buf_size = 16 * 1024;
     uint8_t local_buf[footer_buf_size];
@@ -104,8 +121,12 @@ Status FileReader::_parse_footer() {
     // deserialize footer
     RETURN_IF_ERROR(deserialize_thrift_msg(footer_buf + to_read - 8 - footer_size, &footer_size, TProtocolType::COMPACT,
                                            &t_metadata));
-    _file_metadata.reset(new FileMetaData());
-    RETURN_IF_ERROR(_file_metadata->init(t_metadata));
+    auto file_metadata = std::make_shared<FileMetaData>();
+    RETURN_IF_ERROR(file_metadata->init(t_metadata));
+    _file_metadata = std::move(file_metadata);
+    if (meta_cache != nullptr) {
+        meta_cache->insert(cache_key, _file_metadata, footer_size);
+    }
 
     return Status::OK();
 }
@@ -135,10 +156,11 @@ void FileReader::_pre_process_schema() {
     for (auto& materialized_column : _param.materialized_columns) {
         int field_index = _file_metadata->schema().get_column_index(materialized_column.col_name);
         if (field_index >= 0) {
-            auto parquet_type = _file_metadata->schema().get_stored_column_by_idx(field_index)->physical_type;
+            const ParquetField* field = _file_metadata->schema().get_field_by_idx(field_index);
             GroupReaderParam::Column column{};
             column.col_idx_in_parquet = field_index;
-            column.col_type_in_parquet = parquet_type;
+            // the physical type is only meaningful for the primitive columns
+            column.col_type_in_parquet = field->physical_type;
             column.col_idx_in_chunk = materialized_column.col_idx;
             column.col_type_in_chunk = materialized_column.col_type;
             column.slot_id = materialized_column.slot_id;
@@ -222,6 +244,122 @@ Status FileReader::_filter_group(const tparquet::RowGroup& row_group, bool* is_f
     return Status::OK();
 }
 
+Status FileReader::_filter_pages(const tparquet::RowGroup& row_group, vectorized::SparseRange* row_ranges) {
+    *row_ranges = vectorized::SparseRange(0, row_group.num_rows);
+    if (!config::parquet_page_index_enable || _param.min_max_conjunct_ctxs.empty()) {
+        return Status::OK();
+    }
+    // rows can only be skipped in the columns without repetition
+    for (const auto& column : _read_cols) {
+        if (column.col_type_in_chunk.type == TYPE_ARRAY) {
+            return Status::OK();
+        }
+    }
+
+    std::unordered_map<SlotId, const SlotDescriptor*> slot_by_id;
+    for (const SlotDescriptor* slot : _param.min_max_tuple_desc->slots()) {
+        slot_by_id[slot->id()] = slot;
+    }
+
+    for (ExprContext* ctx : _param.min_max_conjunct_ctxs) {
+        // the pages of different columns are not aligned, so only the conjuncts of a single column are used.
+        std::vector<SlotId> slot_ids;
+        ctx->root()->get_slot_ids(&slot_ids);
+        if (slot_ids.size() != 1 || slot_by_id.find(slot_ids[0]) == slot_by_id.end()) {
+            continue;
+        }
+        const SlotDescriptor* slot = slot_by_id[slot_ids[0]];
+        const ParquetField* field = _file_metadata->schema().resolve_by_name(slot->col_name());
+        if (field == nullptr || field->type.type == TYPE_ARRAY) {
+            continue;
+        }
+        const tparquet::ColumnChunk& column_chunk = row_group.columns[field->physical_column_index];
+        if (!has_column_index(column_chunk) || !has_offset_index(column_chunk)) {
+            continue;
+        }
+        const tparquet::ColumnOrder* column_order = nullptr;
+        if (_file_metadata->t_metadata().__isset.column_orders) {
+            const auto& column_orders = _file_metadata->t_metadata().column_orders;
+            int column_idx = field->physical_column_index;
+            column_order = column_idx < column_orders.size() ? &column_orders[column_idx] : nullptr;
+        }
+        if (!_can_use_stats(column_chunk.meta_data.type, column_order)) {
+            continue;
+        }
+
+        tparquet::ColumnIndex column_index;
+        tparquet::OffsetIndex offset_index;
+        {
+            SCOPED_RAW_TIMER(&_param.stats->page_index_read_ns);
+            RETURN_IF_ERROR(read_column_index(_file, column_chunk, &column_index));
+            RETURN_IF_ERROR(read_offset_index(_file, column_chunk, &offset_index));
+        }
+
+        vectorized::SparseRange selected;
+        RETURN_IF_ERROR(_select_pages(ctx, slot, column_chunk.meta_data.type, column_index, offset_index,
+                                      row_group.num_rows, &selected));
+        *row_ranges = row_ranges->intersection(selected);
+        if (row_ranges->empty()) {
+            break;
+        }
+    }
+    return Status::OK();
+}
+
+// a page is selected unless the conjunct is false on both its min and max values
+static bool is_page_selected(const vectorized::ColumnPtr& min_column, const vectorized::ColumnPtr& max_column,
+                             size_t idx) {
+    if (min_column->is_null(idx) || max_column->is_null(idx)) {
+        return true;
+    }
+    return min_column->get(idx).get_int8() != 0 || max_column->get(idx).get_int8() != 0;
+}
+
+Status FileReader::_select_pages(ExprContext* ctx, const SlotDescriptor* slot, const tparquet::Type::type& type,
+                                 const tparquet::ColumnIndex& column_index, const tparquet::OffsetIndex& offset_index,
+                                 int64_t num_rows, vectorized::SparseRange* row_ranges) const {
+    const auto& locations = offset_index.page_locations;
+    size_t num_pages = locations.size();
+    if (column_index.null_pages.size() != num_pages) {
+        *row_ranges = vectorized::SparseRange(0, num_rows);
+        return Status::OK();
+    }
+
+    std::vector<SlotDescriptor*> slots{const_cast<SlotDescriptor*>(slot)};
+    auto min_chunk = vectorized::ChunkHelper::new_chunk(slots, num_pages);
+    auto max_chunk = vectorized::ChunkHelper::new_chunk(slots, num_pages);
+    for (size_t i = 0; i < num_pages; i++) {
+        // the min/max values of the pages containing only nulls are not valid, keep these pages
+        if (column_index.null_pages[i]) {
+            min_chunk->get_column_by_index(0)->append_default();
+            max_chunk->get_column_by_index(0)->append_default();
+            continue;
+        }
+        Status status = _decode_min_max_value(type, column_index.min_values[i], column_index.max_values[i],
+                                              &min_chunk->get_column_by_index(0), &max_chunk->get_column_by_index(0));
+        if (!status.ok()) {
+            *row_ranges = vectorized::SparseRange(0, num_rows);
+            return Status::OK();
+        }
+    }
+
+    vectorized::ColumnPtr min_column;
+    vectorized::ColumnPtr max_column;
+    {
+        SCOPED_RAW_TIMER(&_param.stats->expr_filter_ns);
+        min_column = ctx->evaluate(min_chunk.get());
+        max_column = ctx->evaluate(max_chunk.get());
+    }
+
+    for (size_t i = 0; i < num_pages; i++) {
+        if (column_index.null_pages[i] || is_page_selected(min_column, max_column, i)) {
+            int64_t end_row = i + 1 < num_pages ? locations[i + 1].first_row_index : num_rows;
+            row_ranges->add(vectorized::Range(locations[i].first_row_index, end_row));
+        }
+    }
+    return Status::OK();
+}
+
 Status FileReader::_read_min_max_chunk(const tparquet::RowGroup& row_group, vectorized::ChunkPtr* min_chunk,
                                        vectorized::ChunkPtr* max_chunk, bool* exist) const {
     for (size_t i = 0; i < _param.min_max_tuple_desc->slots().size(); i++) {
@@ -283,17 +421,23 @@ Status FileReader::_decode_min_max_column(const tparquet::ColumnMetaData& column
         return Status::NotSupported("min max statistics not supported");
     }
 
-    switch (column_meta.type) {
+    if (column_meta.statistics.__isset.min_value) {
+        return _decode_min_max_value(column_meta.type, column_meta.statistics.min_value,
+                                     column_meta.statistics.max_value, min_column, max_column);
+    }
+    return _decode_min_max_value(column_meta.type, column_meta.statistics.min, column_meta.statistics.max, min_column,
+                                 max_column);
+}
+
+Status FileReader::_decode_min_max_value(const tparquet::Type::type& type, const std::string& min,
+                                         const std::string& max, vectorized::ColumnPtr* min_column,
+                                         vectorized::ColumnPtr* max_column) {
+    switch (type) {
     case tparquet::Type::type::INT32: {
         int32_t min_value = 0;
         int32_t max_value = 0;
-        if (column_meta.statistics.__isset.min_value) {
-            RETURN_IF_ERROR(PlainDecoder<int32_t>::decode(column_meta.statistics.min_value, &min_value));
-            RETURN_IF_ERROR(PlainDecoder<int32_t>::decode(column_meta.statistics.max_value, &max_value));
-        } else {
-            RETURN_IF_ERROR(PlainDecoder<int32_t>::decode(column_meta.statistics.min, &min_value));
-            RETURN_IF_ERROR(PlainDecoder<int32_t>::decode(column_meta.statistics.max, &max_value));
-        }
+        RETURN_IF_ERROR(PlainDecoder<int32_t>::decode(min, &min_value));
+        RETURN_IF_ERROR(PlainDecoder<int32_t>::decode(max, &max_value));
         (*min_column)->append_numbers(&min_value, sizeof(int32_t));
         (*max_column)->append_numbers(&max_value, sizeof(int32_t));
         return Status::OK();
@@ -301,13 +445,8 @@ Status FileReader::_decode_min_max_column(const tparquet::ColumnMetaData& column
     case tparquet::Type::type::INT64: {
         int64_t min_value = 0;
         int64_t max_value = 0;
-        if (column_meta.statistics.__isset.min_value) {
-            RETURN_IF_ERROR(PlainDecoder<int64_t>::decode(column_meta.statistics.min_value, &min_value));
-            RETURN_IF_ERROR(PlainDecoder<int64_t>::decode(column_meta.statistics.max_value, &max_value));
-        } else {
-            RETURN_IF_ERROR(PlainDecoder<int64_t>::decode(column_meta.statistics.max, &max_value));
-            RETURN_IF_ERROR(PlainDecoder<int64_t>::decode(column_meta.statistics.min, &min_value));
-        }
+        RETURN_IF_ERROR(PlainDecoder<int64_t>::decode(min, &min_value));
+        RETURN_IF_ERROR(PlainDecoder<int64_t>::decode(max, &max_value));
         (*min_column)->append_numbers(&min_value, sizeof(int64_t));
         (*max_column)->append_numbers(&max_value, sizeof(int64_t));
         return Status::OK();
@@ -315,13 +454,8 @@ Status FileReader::_decode_min_max_column(const tparquet::ColumnMetaData& column
     case tparquet::Type::type::BYTE_ARRAY: {
         Slice min_slice;
         Slice max_slice;
-        if (column_meta.statistics.__isset.min_value) {
-            RETURN_IF_ERROR(PlainDecoder<Slice>::decode(column_meta.statistics.min_value, &min_slice));
-            RETURN_IF_ERROR(PlainDecoder<Slice>::decode(column_meta.statistics.max_value, &max_slice));
-        } else {
-            RETURN_IF_ERROR(PlainDecoder<Slice>::decode(column_meta.statistics.min, &min_slice));
-            RETURN_IF_ERROR(PlainDecoder<Slice>::decode(column_meta.statistics.max, &max_slice));
-        }
+        RETURN_IF_ERROR(PlainDecoder<Slice>::decode(min, &min_slice));
+        RETURN_IF_ERROR(PlainDecoder<Slice>::decode(max, &max_slice));
         (*min_column)->append_strings(std::vector<Slice>{min_slice});
         (*max_column)->append_strings(std::vector<Slice>{max_slice});
         return Status::OK();
@@ -367,7 +501,8 @@ bool FileReader::_is_integer_type(const tparquet::Type::type& type) {
            type == tparquet::Type::type::INT96;
 }
 
-Status FileReader::_create_and_init_group_reader(int row_group_number) {
+Status FileReader::_create_and_init_group_reader(int row_group_number,
+                                                 const vectorized::SparseRange& row_ranges) {
     auto row_group_reader = _row_group(row_group_number);
 
     GroupReaderParam param;
@@ -375,6 +510,7 @@ Status FileReader::_create_and_init_group_reader(int row_group_number) {
     param.conjunct_ctxs_by_slot = _param.conjunct_ctxs_by_slot;
     param.read_cols = _read_cols;
     param.timezone = _param.timezone;
+    param.row_ranges = row_ranges;
     param.stats = _param.stats;
 
     RETURN_IF_ERROR(row_group_reader->init(param));
@@ -409,9 +545,21 @@ Status FileReader::_init_group_reader() {
                 continue;
             }
 
-            RETURN_IF_ERROR(_create_and_init_group_reader(i));
+            const tparquet::RowGroup& row_group = _file_metadata->t_metadata().row_groups[i];
+            vectorized::SparseRange row_ranges;
+            RETURN_IF_ERROR(_filter_pages(row_group, &row_ranges));
+            if (row_ranges.empty()) {
+                LOG(INFO) << "row group " << i << " of file has been filtered by page index";
+                continue;
+            }
+            if (row_ranges.span_size() == row_group.num_rows) {
+                // all of the rows are selected
+                row_ranges.clear();
+            }
+
+            RETURN_IF_ERROR(_create_and_init_group_reader(i, row_ranges));
 
-            _total_row_count += _file_metadata->t_metadata().row_groups[i].num_rows;
+            _total_row_count += row_group.num_rows;
         } else {
             continue;
         }
@@ -438,6 +586,8 @@ Status FileReader::_get_next_internal(vectorized::ChunkPtr* chunk) {
                 _scan_row_count += (*chunk)->num_rows();
             }
             if (status.is_end_of_file()) {
+                // release the column readers and the buffers of the row group
+                _row_group_readers[_cur_row_group_idx].reset();
                 _cur_row_group_idx++;
                 return Status::OK();
             }
@@ -51,7 +51,7 @@ private:
     void _filter_file();
 
     // create and inti group reader
-    Status _create_and_init_group_reader(int row_group_number);
+    Status _create_and_init_group_reader(int row_group_number, const vectorized::SparseRange& row_ranges);
 
     // create row group reader
     std::shared_ptr<GroupReader> _row_group(int i);
@@ -62,6 +62,15 @@ private:
     // filter row group by min/max conjuncts
     Status _filter_group(const tparquet::RowGroup& group, bool* is_filter);
 
+    // select the rows of row group by the min/max conjuncts and the page index,
+    // the row ranges are empty if no page of the row group is selected
+    Status _filter_pages(const tparquet::RowGroup& row_group, vectorized::SparseRange* row_ranges);
+
+    // rows of the pages whose min/max values may satisfy the conjunct
+    Status _select_pages(ExprContext* ctx, const SlotDescriptor* slot, const tparquet::Type::type& type,
+                         const tparquet::ColumnIndex& column_index, const tparquet::OffsetIndex& offset_index,
+                         int64_t num_rows, vectorized::SparseRange* row_ranges) const;
+
     // get row group to read
     // if scan range conatain the first byte in the row group, will be read
     // TODO: later modify the larger block should be read
@@ -94,6 +103,9 @@ private:
     static Status _decode_min_max_column(const tparquet::ColumnMetaData& column_meta,
                                          const tparquet::ColumnOrder* column_order, vectorized::ColumnPtr* min_column,
                                          vectorized::ColumnPtr* max_column);
+    static Status _decode_min_max_value(const tparquet::Type::type& type, const std::string& min,
+                                        const std::string& max, vectorized::ColumnPtr* min_column,
+                                        vectorized::ColumnPtr* max_column);
     static bool _can_use_min_max_stats(const tparquet::ColumnMetaData& column_meta,
                                        const tparquet::ColumnOrder* column_order);
     // statistics.min_value max_value
@@ -113,6 +125,7 @@ private:
     uint64_t _file_size;
 
     starrocks::vectorized::HdfsFileReaderParam _param;
+    // shared with the other readers of the file by the meta cache, must not be changed after parsed.
     std::shared_ptr<FileMetaData> _file_metadata;
     vector<std::shared_ptr<GroupReader>> _row_group_readers;
     size_t _cur_row_group_idx = 0;
@@ -0,0 +1,562 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/parquet/file_writer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+#include "column/binary_column.h"
+#include "column/column_helper.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "exec/file_writer.h"
+#include "exec/parquet/utils.h"
+#include "gutil/endian.h"
+#include "gutil/strings/substitute.h"
+#include "runtime/date_value.h"
+#include "runtime/decimalv2_value.h"
+#include "runtime/timestamp_value.h"
+#include "runtime/vectorized/time_types.h"
+#include "simd/simd.h"
+#include "util/block_compression.h"
+#include "util/coding.h"
+#include "util/countdown_latch.h"
+#include "util/faststring.h"
+#include "util/priority_thread_pool.hpp"
+#include "util/rle_encoding.h"
+#include "util/thrift_util.h"
+
+namespace starrocks::parquet {
+
+static constexpr char kMagic[] = "PAR1";
+static constexpr size_t kMagicSize = 4;
+// the min and max values longer than this are not kept in the statistics.
+static constexpr size_t kMaxStatisticsValueSize = 64;
+
+namespace {
+
+// The plain encoded values of the rows of a column chunk, appended page by page.
+class ValueEncoder {
+public:
+    virtual ~ValueEncoder() = default;
+    // the end of the page starting from the row |begin|, whose values take about |page_max_bytes|.
+    virtual size_t page_end(size_t begin, size_t num_rows, size_t page_max_bytes) const = 0;
+    // append the values of the non-null rows in [begin, end).
+    virtual void append(const uint8_t* nulls, size_t begin, size_t end, faststring* out) = 0;
+    // set the min and max values of the rows appended, if they are kept.
+    virtual void set_min_max(tparquet::Statistics* statistics) const {}
+};
+
+// |convert| converts a value of the column into its physical value, e.g. a date into the days since the epoch.
+template <typename CppType, typename PhysicalType, bool WithMinMax, typename Convert>
+class FixedValueEncoder final : public ValueEncoder {
+public:
+    FixedValueEncoder(const CppType* values, Convert convert) : _values(values), _convert(convert) {}
+
+    size_t page_end(size_t begin, size_t num_rows, size_t page_max_bytes) const override {
+        return std::min(num_rows, begin + std::max<size_t>(1, page_max_bytes / sizeof(PhysicalType)));
+    }
+
+    void append(const uint8_t* nulls, size_t begin, size_t end, faststring* out) override {
+        for (size_t i = begin; i < end; ++i) {
+            if (nulls[i]) {
+                continue;
+            }
+            PhysicalType value = _convert(_values[i]);
+            out->append(&value, sizeof(value));
+            if constexpr (WithMinMax) {
+                _update_min_max(value);
+            }
+        }
+    }
+
+    void set_min_max(tparquet::Statistics* statistics) const override {
+        if constexpr (WithMinMax) {
+            if (_has_min_max && !_has_nan) {
+                statistics->__set_min_value(std::string(reinterpret_cast<const char*>(&_min), sizeof(_min)));
+                statistics->__set_max_value(std::string(reinterpret_cast<const char*>(&_max), sizeof(_max)));
+            }
+        }
+    }
+
+private:
+    void _update_min_max(PhysicalType value) {
+        if constexpr (std::is_floating_point_v<PhysicalType>) {
+            if (std::isnan(value)) {
+                _has_nan = true;
+                return;
+            }
+        }
+        if (!_has_min_max) {
+            _min = value;
+            _max = value;
+            _has_min_max = true;
+        } else {
+            _min = std::min(_min, value);
+            _max = std::max(_max, value);
+        }
+    }
+
+    const CppType* _values;
+    Convert _convert;
+    PhysicalType _min{};
+    PhysicalType _max{};
+    bool _has_min_max = false;
+    bool _has_nan = false;
+};
+
+template <typename PhysicalType, bool WithMinMax, typename CppType, typename Convert>
+std::unique_ptr<ValueEncoder> new_fixed_encoder(const vectorized::Column& column, Convert convert) {
+    const auto& data = down_cast<const vectorized::FixedLengthColumnBase<CppType>&>(column).get_data();
+    return std::make_unique<FixedValueEncoder<CppType, PhysicalType, WithMinMax, Convert>>(data.data(), convert);
+}
+
+class BinaryValueEncoder final : public ValueEncoder {
+public:
+    explicit BinaryValueEncoder(const vectorized::BinaryColumn& column) : _column(column) {}
+
+    size_t page_end(size_t begin, size_t num_rows, size_t page_max_bytes) const override {
+        const auto& offsets = _column.get_offset();
+        // the rows [begin, end) whose bytes fit in the page, but at least one row.
+        const uint64_t limit = static_cast<uint64_t>(offsets[begin]) + page_max_bytes;
+        auto iter = std::upper_bound(offsets.begin() + begin + 1, offsets.begin() + num_rows + 1, limit);
+        return std::max<size_t>(iter - offsets.begin() - 1, begin + 1);
+    }
+
+    void append(const uint8_t* nulls, size_t begin, size_t end, faststring* out) override {
+        for (size_t i = begin; i < end; ++i) {
+            if (nulls[i]) {
+                continue;
+            }
+            Slice value = _column.get_slice(i);
+            put_fixed32_le(out, value.size);
+            out->append(value.data, value.size);
+            if (!_has_min_max) {
+                _min = value;
+                _max = value;
+                _has_min_max = true;
+            } else if (value.compare(_min) < 0) {
+                _min = value;
+            } else if (value.compare(_max) > 0) {
+                _max = value;
+            }
+        }
+    }
+
+    void set_min_max(tparquet::Statistics* statistics) const override {
+        if (_has_min_max && _min.size <= kMaxStatisticsValueSize && _max.size <= kMaxStatisticsValueSize) {
+            statistics->__set_min_value(_min.to_string());
+            statistics->__set_max_value(_max.to_string());
+        }
+    }
+
+private:
+    const vectorized::BinaryColumn& _column;
+    Slice _min;
+    Slice _max;
+    bool _has_min_max = false;
+};
+
+// The plain encoded booleans are bit packed, the first value in the least significant bit.
+class BooleanValueEncoder final : public ValueEncoder {
+public:
+    explicit BooleanValueEncoder(const uint8_t* values) : _values(values) {}
+
+    size_t page_end(size_t begin, size_t num_rows, size_t page_max_bytes) const override {
+        return std::min(num_rows, begin + std::max<size_t>(1, page_max_bytes * 8));
+    }
+
+    void append(const uint8_t* nulls, size_t begin, size_t end, faststring* out) override {
+        uint8_t byte = 0;
+        int num_bits = 0;
+        for (size_t i = begin; i < end; ++i) {
+            if (nulls[i]) {
+                continue;
+            }
+            byte |= (_values[i] != 0) << num_bits;
+            if (++num_bits == 8) {
+                out->push_back(byte);
+                byte = 0;
+                num_bits = 0;
+            }
+        }
+        if (num_bits > 0) {
+            out->push_back(byte);
+        }
+    }
+
+private:
+    const uint8_t* _values;
+};
+
+Status new_value_encoder(const TypeDescriptor& type, const vectorized::Column& column,
+                         std::unique_ptr<ValueEncoder>* encoder) {
+    using vectorized::DateValue;
+    using vectorized::TimestampValue;
+    auto identity = [](auto value) { return value; };
+    // the 16 bytes decimals are big-endian two's complement.
+    auto big_endian = [](int128_t value) { return BigEndian::FromHost128(static_cast<unsigned __int128>(value)); };
+    switch (type.type) {
+    case TYPE_BOOLEAN:
+        *encoder = std::make_unique<BooleanValueEncoder>(
+                down_cast<const vectorized::FixedLengthColumnBase<uint8_t>&>(column).get_data().data());
+        break;
+    case TYPE_TINYINT:
+        *encoder = new_fixed_encoder<int32_t, true, int8_t>(column, identity);
+        break;
+    case TYPE_SMALLINT:
+        *encoder = new_fixed_encoder<int32_t, true, int16_t>(column, identity);
+        break;
+    case TYPE_INT:
+    case TYPE_DECIMAL32:
+        *encoder = new_fixed_encoder<int32_t, true, int32_t>(column, identity);
+        break;
+    case TYPE_BIGINT:
+    case TYPE_DECIMAL64:
+        *encoder = new_fixed_encoder<int64_t, true, int64_t>(column, identity);
+        break;
+    case TYPE_LARGEINT:
+    case TYPE_DECIMAL128:
+        *encoder = new_fixed_encoder<unsigned __int128, false, int128_t>(column, big_endian);
+        break;
+    case TYPE_FLOAT:
+        *encoder = new_fixed_encoder<float, true, float>(column, identity);
+        break;
+    case TYPE_DOUBLE:
+        *encoder = new_fixed_encoder<double, true, double>(column, identity);
+        break;
+    case TYPE_DATE:
+        *encoder = new_fixed_encoder<int32_t, true, DateValue>(column, [](const DateValue& value) {
+            return static_cast<int32_t>(value.julian() - vectorized::date::UNIX_EPOCH_JULIAN);
+        });
+        break;
+    case TYPE_DATETIME:
+        *encoder = new_fixed_encoder<int64_t, true, TimestampValue>(column, [](const TimestampValue& value) {
+            vectorized::Timestamp timestamp = value.timestamp();
+            int64_t days = vectorized::timestamp::to_julian(timestamp) - vectorized::date::UNIX_EPOCH_JULIAN;
+            return days * vectorized::USECS_PER_DAY + vectorized::timestamp::to_time(timestamp);
+        });
+        break;
+    case TYPE_DECIMALV2:
+        *encoder = new_fixed_encoder<unsigned __int128, false, DecimalV2Value>(
+                column, [big_endian](const DecimalV2Value& value) { return big_endian(value.value()); });
+        break;
+    case TYPE_CHAR:
+    case TYPE_VARCHAR:
+        *encoder = std::make_unique<BinaryValueEncoder>(down_cast<const vectorized::BinaryColumn&>(column));
+        break;
+    default:
+        return Status::NotSupported(strings::Substitute("unsupported type in parquet file: $0", type.debug_string()));
+    }
+    return Status::OK();
+}
+
+Status to_schema_element(const std::string& name, const TypeDescriptor& type, tparquet::SchemaElement* element) {
+    element->__set_name(name);
+    element->__set_repetition_type(tparquet::FieldRepetitionType::OPTIONAL);
+    auto set_decimal = [element](tparquet::Type::type physical_type, int precision, int scale) {
+        element->__set_type(physical_type);
+        if (physical_type == tparquet::Type::FIXED_LEN_BYTE_ARRAY) {
+            element->__set_type_length(16);
+        }
+        element->__set_converted_type(tparquet::ConvertedType::DECIMAL);
+        element->__set_precision(precision);
+        element->__set_scale(scale);
+    };
+    switch (type.type) {
+    case TYPE_BOOLEAN:
+        element->__set_type(tparquet::Type::BOOLEAN);
+        break;
+    case TYPE_TINYINT:
+        element->__set_type(tparquet::Type::INT32);
+        element->__set_converted_type(tparquet::ConvertedType::INT_8);
+        break;
+    case TYPE_SMALLINT:
+        element->__set_type(tparquet::Type::INT32);
+        element->__set_converted_type(tparquet::ConvertedType::INT_16);
+        break;
+    case TYPE_INT:
+        element->__set_type(tparquet::Type::INT32);
+        break;
+    case TYPE_BIGINT:
+        element->__set_type(tparquet::Type::INT64);
+        break;
+    case TYPE_LARGEINT:
+        // there is no 128 bits integer in parquet.
+        set_decimal(tparquet::Type::FIXED_LEN_BYTE_ARRAY, 38, 0);
+        break;
+    case TYPE_FLOAT:
+        element->__set_type(tparquet::Type::FLOAT);
+        break;
+    case TYPE_DOUBLE:
+        element->__set_type(tparquet::Type::DOUBLE);
+        break;
+    case TYPE_DATE:
+        element->__set_type(tparquet::Type::INT32);
+        element->__set_converted_type(tparquet::ConvertedType::DATE);
+        break;
+    case TYPE_DATETIME:
+        element->__set_type(tparquet::Type::INT64);
+        element->__set_converted_type(tparquet::ConvertedType::TIMESTAMP_MICROS);
+        break;
+    case TYPE_CHAR:
+    case TYPE_VARCHAR:
+        element->__set_type(tparquet::Type::BYTE_ARRAY);
+        element->__set_converted_type(tparquet::ConvertedType::UTF8);
+        break;
+    case TYPE_DECIMALV2:
+        set_decimal(tparquet::Type::FIXED_LEN_BYTE_ARRAY, 27, 9);
+        break;
+    case TYPE_DECIMAL32:
+        set_decimal(tparquet::Type::INT32, type.precision, type.scale);
+        break;
+    case TYPE_DECIMAL64:
+        set_decimal(tparquet::Type::INT64, type.precision, type.scale);
+        break;
+    case TYPE_DECIMAL128:
+        set_decimal(tparquet::Type::FIXED_LEN_BYTE_ARRAY, type.precision, type.scale);
+        break;
+    default:
+        return Status::NotSupported(strings::Substitute("unsupported type in parquet file: $0", type.debug_string()));
+    }
+    return Status::OK();
+}
+
+// The definition levels of the rows [begin, end) of a data page, RLE encoded with the length ahead.
+void encode_definition_levels(const uint8_t* nulls, size_t begin, size_t end, faststring* out) {
+    faststring levels;
+    RleEncoder<uint16_t> encoder(&levels, 1);
+    for (size_t i = begin; i < end;) {
+        size_t run_end = i + 1;
+        while (run_end < end && nulls[run_end] == nulls[i]) {
+            ++run_end;
+        }
+        encoder.Put(nulls[i] ? 0 : 1, run_end - i);
+        i = run_end;
+    }
+    encoder.Flush();
+    put_fixed32_le(out, levels.size());
+    out->append(levels.data(), levels.size());
+}
+
+} // namespace
+
+struct FileWriter::EncodedColumnChunk {
+    Status status;
+    // the pages with their headers.
+    faststring data;
+    tparquet::ColumnMetaData metadata;
+};
+
+struct FileWriter::RowGroup {
+    vectorized::Columns columns;
+    size_t num_rows = 0;
+    std::vector<EncodedColumnChunk> chunks;
+    std::unique_ptr<CountDownLatch> latch;
+};
+
+FileWriter::FileWriter(starrocks::FileWriter* file, std::vector<std::string> column_names,
+                       std::vector<TypeDescriptor> types, FileWriterOptions options)
+        : _file(file), _column_names(std::move(column_names)), _types(std::move(types)), _options(options) {}
+
+FileWriter::~FileWriter() {
+    // the encoding tasks refer to the row group.
+    if (_pending != nullptr) {
+        _pending->latch->wait();
+    }
+}
+
+Status FileWriter::init() {
+    DCHECK_EQ(_column_names.size(), _types.size());
+    std::vector<tparquet::SchemaElement> schema(_types.size() + 1);
+    schema[0].__set_name("schema");
+    schema[0].__set_num_children(_types.size());
+    for (size_t i = 0; i < _types.size(); ++i) {
+        RETURN_IF_ERROR(to_schema_element(_column_names[i], _types[i], &schema[i + 1]));
+    }
+    _metadata.__set_version(1);
+    _metadata.__set_schema(std::move(schema));
+    _metadata.__set_num_rows(0);
+    _metadata.__set_created_by("StarRocks");
+    return _write(reinterpret_cast<const uint8_t*>(kMagic), kMagicSize);
+}
+
+Status FileWriter::write(const vectorized::Columns& columns, size_t num_rows) {
+    DCHECK_EQ(columns.size(), _types.size());
+    if (num_rows == 0) {
+        return Status::OK();
+    }
+    if (_buffer.empty()) {
+        for (const auto& type : _types) {
+            _buffer.emplace_back(vectorized::ColumnHelper::create_column(type, true));
+        }
+    }
+    size_t buffered_bytes = 0;
+    for (size_t i = 0; i < columns.size(); ++i) {
+        if (columns[i]->is_constant()) {
+            auto column = vectorized::ColumnHelper::unpack_and_duplicate_const_column(num_rows, columns[i]);
+            _buffer[i]->append(*column, 0, num_rows);
+        } else {
+            _buffer[i]->append(*columns[i], 0, num_rows);
+        }
+        buffered_bytes += _buffer[i]->byte_size();
+    }
+    _num_buffered_rows += num_rows;
+    if (buffered_bytes >= _options.row_group_max_bytes) {
+        RETURN_IF_ERROR(_start_row_group());
+    }
+    return Status::OK();
+}
+
+Status FileWriter::close() {
+    if (_closed) {
+        return Status::OK();
+    }
+    _closed = true;
+    if (_num_buffered_rows > 0) {
+        RETURN_IF_ERROR(_start_row_group());
+    }
+    RETURN_IF_ERROR(_flush_pending_row_group());
+
+    uint32_t footer_size = 0;
+    uint8_t* footer = nullptr;
+    ThriftSerializer serializer(true, 1024);
+    RETURN_IF_ERROR(serializer.serialize(&_metadata, &footer_size, &footer));
+    RETURN_IF_ERROR(_write(footer, footer_size));
+    uint8_t footer_size_bytes[4];
+    encode_fixed32_le(footer_size_bytes, footer_size);
+    RETURN_IF_ERROR(_write(footer_size_bytes, sizeof(footer_size_bytes)));
+    return _write(reinterpret_cast<const uint8_t*>(kMagic), kMagicSize);
+}
+
+Status FileWriter::_start_row_group() {
+    // at most one row group is encoded in the background.
+    RETURN_IF_ERROR(_flush_pending_row_group());
+
+    _pending = std::make_unique<RowGroup>();
+    RowGroup* row_group = _pending.get();
+    row_group->columns = std::move(_buffer);
+    row_group->num_rows = _num_buffered_rows;
+    row_group->chunks.resize(_types.size());
+    row_group->latch = std::make_unique<CountDownLatch>(_types.size());
+    _buffer.clear();
+    _num_buffered_rows = 0;
+
+    for (size_t i = 0; i < _types.size(); ++i) {
+        auto encode = [this, row_group, i]() {
+            const auto& column = down_cast<const vectorized::NullableColumn&>(*row_group->columns[i]);
+            row_group->chunks[i].status = _encode_column_chunk(i, column, &row_group->chunks[i]);
+            row_group->latch->count_down();
+        };
+        if (_options.pool == nullptr || !_options.pool->offer(encode)) {
+            encode();
+        }
+    }
+    return Status::OK();
+}
+
+Status FileWriter::_flush_pending_row_group() {
+    if (_pending == nullptr) {
+        return Status::OK();
+    }
+    std::unique_ptr<RowGroup> row_group = std::move(_pending);
+    row_group->latch->wait();
+
+    tparquet::RowGroup metadata;
+    int64_t total_byte_size = 0;
+    for (auto& chunk : row_group->chunks) {
+        RETURN_IF_ERROR(chunk.status);
+        chunk.metadata.__set_data_page_offset(_written_bytes);
+        tparquet::ColumnChunk column_chunk;
+        column_chunk.__set_file_offset(_written_bytes);
+        column_chunk.__set_meta_data(chunk.metadata);
+        metadata.columns.emplace_back(std::move(column_chunk));
+        total_byte_size += chunk.metadata.total_uncompressed_size;
+        RETURN_IF_ERROR(_write(chunk.data.data(), chunk.data.size()));
+    }
+    metadata.__set_total_byte_size(total_byte_size);
+    metadata.__set_num_rows(row_group->num_rows);
+    _metadata.row_groups.emplace_back(std::move(metadata));
+    _metadata.__set_num_rows(_metadata.num_rows + row_group->num_rows);
+    return Status::OK();
+}
+
+Status FileWriter::_encode_column_chunk(size_t index, const vectorized::NullableColumn& column,
+                                        EncodedColumnChunk* chunk) const {
+    std::unique_ptr<ValueEncoder> encoder;
+    RETURN_IF_ERROR(new_value_encoder(_types[index], *column.data_column(), &encoder));
+    const BlockCompressionCodec* codec = nullptr;
+    RETURN_IF_ERROR(get_block_compression_codec(convert_compression_codec(_options.compression), &codec));
+
+    const size_t num_rows = column.size();
+    const uint8_t* nulls = column.immutable_null_column_data().data();
+    ThriftSerializer serializer(true, 256);
+    faststring page;
+    faststring compressed;
+    std::vector<uint8_t> header_bytes;
+    int64_t uncompressed_size = 0;
+    int64_t compressed_size = 0;
+    for (size_t begin = 0; begin < num_rows;) {
+        size_t end = encoder->page_end(begin, num_rows, _options.page_max_bytes);
+        page.clear();
+        encode_definition_levels(nulls, begin, end, &page);
+        encoder->append(nulls, begin, end, &page);
+        Slice page_data(page.data(), page.size());
+        if (codec != nullptr) {
+            compressed.resize(codec->max_compressed_len(page.size()));
+            Slice output(compressed.data(), compressed.size());
+            RETURN_IF_ERROR(codec->compress(page_data, &output));
+            page_data = output;
+        }
+
+        tparquet::DataPageHeader data_page_header;
+        data_page_header.__set_num_values(end - begin);
+        data_page_header.__set_encoding(tparquet::Encoding::PLAIN);
+        data_page_header.__set_definition_level_encoding(tparquet::Encoding::RLE);
+        data_page_header.__set_repetition_level_encoding(tparquet::Encoding::RLE);
+        tparquet::PageHeader header;
+        header.__set_type(tparquet::PageType::DATA_PAGE);
+        header.__set_uncompressed_page_size(page.size());
+        header.__set_compressed_page_size(page_data.size);
+        header.__set_data_page_header(data_page_header);
+        RETURN_IF_ERROR(serializer.serialize(&header, &header_bytes));
+
+        chunk->data.append(header_bytes.data(), header_bytes.size());
+        chunk->data.append(page_data.data, page_data.size);
+        uncompressed_size += header_bytes.size() + page.size();
+        compressed_size += header_bytes.size() + page_data.size;
+        begin = end;
+    }
+
+    tparquet::Statistics statistics;
+    statistics.__set_null_count(SIMD::count_nonzero(column.immutable_null_column_data()));
+    encoder->set_min_max(&statistics);
+
+    tparquet::ColumnMetaData& metadata = chunk->metadata;
+    metadata.__set_type(_metadata.schema[index + 1].type);
+    metadata.__set_encodings({tparquet::Encoding::PLAIN, tparquet::Encoding::RLE});
+    metadata.__set_path_in_schema({_column_names[index]});
+    metadata.__set_codec(_options.compression);
+    metadata.__set_num_values(num_rows);
+    metadata.__set_total_uncompressed_size(uncompressed_size);
+    metadata.__set_total_compressed_size(compressed_size);
+    metadata.__set_statistics(statistics);
+    return Status::OK();
+}
+
+Status FileWriter::_write(const uint8_t* data, size_t size) {
+    while (size > 0) {
+        size_t written = 0;
+        RETURN_IF_ERROR(_file->write(data, size, &written));
+        if (written == 0) {
+            return Status::IOError("fail to write parquet file");
+        }
+        data += written;
+        size -= written;
+        _written_bytes += written;
+    }
+    return Status::OK();
+}
+
+} // namespace starrocks::parquet
@@ -0,0 +1,87 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "column/vectorized_fwd.h"
+#include "common/status.h"
+#include "gen_cpp/parquet_types.h"
+#include "runtime/types.h"
+
+namespace starrocks {
+class FileWriter;
+class PriorityThreadPool;
+
+namespace vectorized {
+class NullableColumn;
+} // namespace vectorized
+
+} // namespace starrocks
+
+namespace starrocks::parquet {
+
+struct FileWriterOptions {
+    // a row group is encoded once the rows buffered take more memory than this.
+    int64_t row_group_max_bytes = 128 * 1024 * 1024;
+    // the values of a data page before compression.
+    int64_t page_max_bytes = 1024 * 1024;
+    tparquet::CompressionCodec::type compression = tparquet::CompressionCodec::SNAPPY;
+    // the pool to encode the column chunks of a row group in parallel, or they are encoded by the caller.
+    PriorityThreadPool* pool = nullptr;
+};
+
+// Write the chunks into a parquet file, whose columns are all OPTIONAL and PLAIN encoded.
+//
+// The rows are buffered into a row group. Once it's full, its column chunks are encoded in parallel on the pool
+// while the rows of the next row group are buffered, and the encoded row groups are written out in order by the
+// caller, so that the file is written sequentially.
+class FileWriter {
+public:
+    // |file| is not owned, and is not closed by this writer.
+    FileWriter(starrocks::FileWriter* file, std::vector<std::string> column_names, std::vector<TypeDescriptor> types,
+               FileWriterOptions options = FileWriterOptions());
+    ~FileWriter();
+
+    // Check the types of the columns and write the header of the file.
+    Status init();
+
+    // Append |num_rows| rows, the columns are in the order of the types and may be const.
+    Status write(const vectorized::Columns& columns, size_t num_rows);
+
+    // Write the rows buffered and the footer of the file.
+    Status close();
+
+    // the bytes written into the file so far.
+    int64_t written_bytes() const { return _written_bytes; }
+
+private:
+    struct EncodedColumnChunk;
+    struct RowGroup;
+
+    // Write out the row group being encoded, and start encoding the rows buffered.
+    Status _start_row_group();
+    Status _flush_pending_row_group();
+    Status _encode_column_chunk(size_t index, const vectorized::NullableColumn& column,
+                                EncodedColumnChunk* chunk) const;
+    Status _write(const uint8_t* data, size_t size);
+
+    starrocks::FileWriter* _file;
+    const std::vector<std::string> _column_names;
+    const std::vector<TypeDescriptor> _types;
+    const FileWriterOptions _options;
+
+    vectorized::Columns _buffer;
+    size_t _num_buffered_rows = 0;
+    // the row group being encoded.
+    std::unique_ptr<RowGroup> _pending;
+
+    tparquet::FileMetaData _metadata;
+    int64_t _written_bytes = 0;
+    bool _closed = false;
+};
+
+} // namespace starrocks::parquet
@@ -4,8 +4,11 @@
 #include "exec/parquet/group_reader.h"
 
 #include "column/column_helper.h"
+#include "common/config.h"
 #include "exec/exec_node.h"
+#include "exec/parquet/page_index_reader.h"
 #include "exprs/expr.h"
+#include "exprs/expr_context.h"
 #include "runtime/types.h"
 #include "simd/simd.h"
 #include "storage/vectorized/chunk_helper.h"
@@ -23,7 +26,11 @@ GroupReader::GroupReader(RandomAccessFile* file, FileMetaData* file_metadata, in
 
 Status GroupReader::init(const GroupReaderParam& param) {
     _param = param;
+    if (!_param.row_ranges.empty()) {
+        _row_range_iter = _param.row_ranges.new_iterator();
+    }
     // the calling order matters, do not change unless you know why.
+    _init_coalesced_file();
     RETURN_IF_ERROR(_init_column_readers());
     _pre_process_columns_and_conjunct_ctxs();
     RETURN_IF_ERROR(_rewrite_dict_column_predicates());
@@ -41,31 +48,47 @@ Status GroupReader::get_next(vectorized::ChunkPtr* chunk, size_t* row_count) {
     size_t count = *row_count;
     bool has_dict_filter = !_dict_filter_preds.empty();
     bool has_more_filter = !_left_conjunct_ctxs.empty();
+    bool has_row_ranges = !_param.row_ranges.empty();
     Status status;
 
     {
         SCOPED_RAW_TIMER(&_param.stats->group_chunk_read_ns);
+        if (has_row_ranges) {
+            if (!_row_range_iter.has_more()) {
+                *row_count = 0;
+                return Status::EndOfFile("");
+            }
+            RETURN_IF_ERROR(_next_row_range(&count));
+        }
         // read data into _read_chunk
-        status = _read(&count);
+        status = _read(_lazy_read_columns.empty() ? _direct_read_columns : _active_read_columns, &count);
         _param.stats->raw_rows_read += count;
         if (!status.ok() && !status.is_end_of_file()) {
             return status;
         }
+        if (status.ok() && has_row_ranges && !_row_range_iter.has_more()) {
+            status = Status::EndOfFile("");
+        }
     }
 
-    // dict filter
-    if (has_dict_filter) {
-        SCOPED_RAW_TIMER(&_param.stats->expr_filter_ns);
-        SCOPED_RAW_TIMER(&_param.stats->group_dict_filter_ns);
-        _dict_filter();
+    if (!_lazy_read_columns.empty()) {
+        RETURN_IF_ERROR(_late_materialize(count));
         _read_chunk->check_or_die();
-    }
+    } else {
+        // dict filter
+        if (has_dict_filter) {
+            SCOPED_RAW_TIMER(&_param.stats->expr_filter_ns);
+            SCOPED_RAW_TIMER(&_param.stats->group_dict_filter_ns);
+            _dict_filter();
+            _read_chunk->check_or_die();
+        }
 
-    // other filter that not dict
-    if (has_more_filter) {
-        SCOPED_RAW_TIMER(&_param.stats->expr_filter_ns);
-        ExecNode::eval_conjuncts(_left_conjunct_ctxs, _read_chunk.get());
-        _read_chunk->check_or_die();
+        // other filter that not dict
+        if (has_more_filter) {
+            SCOPED_RAW_TIMER(&_param.stats->expr_filter_ns);
+            ExecNode::eval_conjuncts(_left_conjunct_ctxs, _read_chunk.get());
+            _read_chunk->check_or_die();
+        }
     }
 
     *row_count = _read_chunk->num_rows();
@@ -77,6 +100,38 @@ Status GroupReader::get_next(vectorized::ChunkPtr* chunk, size_t* row_count) {
     return status;
 }
 
+static void append_column_chunk_ranges(const ParquetField* field, const tparquet::RowGroup& row_group,
+                                       int64_t max_buffer_size,
+                                       std::vector<vectorized::CoalescedRandomAccessFile::IORange>* ranges) {
+    if (!field->children.empty()) {
+        for (const auto& child : field->children) {
+            append_column_chunk_ranges(&child, row_group, max_buffer_size, ranges);
+        }
+        return;
+    }
+    const tparquet::ColumnMetaData& metadata = row_group.columns[field->physical_column_index].meta_data;
+    int64_t start_offset = metadata.__isset.dictionary_page_offset ? metadata.dictionary_page_offset
+                                                                   : metadata.data_page_offset;
+    // a large column chunk is left to be read by its own buffer
+    if (metadata.total_compressed_size <= max_buffer_size) {
+        ranges->emplace_back(start_offset, metadata.total_compressed_size);
+    }
+}
+
+void GroupReader::_init_coalesced_file() {
+    if (!config::hdfs_io_coalesce_enable) {
+        return;
+    }
+    int64_t max_buffer_size = config::hdfs_io_coalesce_max_buffer_size;
+    std::vector<vectorized::CoalescedRandomAccessFile::IORange> ranges;
+    for (const auto& column : _param.read_cols) {
+        const auto* field = _file_metadata->schema().get_field_by_idx(column.col_idx_in_parquet);
+        append_column_chunk_ranges(field, *_row_group_metadata, max_buffer_size, &ranges);
+    }
+    _coalesced_file = std::make_unique<vectorized::CoalescedRandomAccessFile>(_file, _param.stats);
+    _coalesced_file->set_io_ranges(std::move(ranges), config::hdfs_io_coalesce_max_gap, max_buffer_size);
+}
+
 Status GroupReader::_init_column_readers() {
     for (const auto& column : _param.read_cols) {
         RETURN_IF_ERROR(_create_column_reader(column));
@@ -86,14 +141,24 @@ Status GroupReader::_init_column_readers() {
 
 Status GroupReader::_create_column_reader(const GroupReaderParam::Column& column) {
     std::unique_ptr<ColumnReader> column_reader = nullptr;
-    const auto* schema_node = _file_metadata->schema().get_stored_column_by_idx(column.col_idx_in_parquet);
+    const auto* schema_node = _file_metadata->schema().get_field_by_idx(column.col_idx_in_parquet);
 
     ColumnReaderOptions opts;
     opts.stats = _param.stats;
     opts.timezone = _param.timezone;
+    // the rows of the nested columns can not be skipped, so their pages are never filtered
+    if (!_param.row_ranges.empty() && schema_node->is_leaf() &&
+        has_offset_index(_row_group_metadata->columns[schema_node->physical_column_index])) {
+        const tparquet::ColumnChunk& column_chunk = _row_group_metadata->columns[schema_node->physical_column_index];
+        SCOPED_RAW_TIMER(&_param.stats->page_index_read_ns);
+        tparquet::OffsetIndex& offset_index = _offset_indexes[column.slot_id];
+        RETURN_IF_ERROR(read_offset_index(_file, column_chunk, &offset_index));
+        opts.offset_index = &offset_index;
+    }
     {
         SCOPED_RAW_TIMER(&_param.stats->column_reader_init_ns);
-        RETURN_IF_ERROR(ColumnReader::create(_file, schema_node, *_row_group_metadata, column.col_type_in_chunk, opts,
+        RandomAccessFile* file = _coalesced_file != nullptr ? _coalesced_file.get() : _file;
+        RETURN_IF_ERROR(ColumnReader::create(file, schema_node, *_row_group_metadata, column.col_type_in_chunk, opts,
                                              &column_reader));
     }
     _column_readers[column.slot_id] = std::move(column_reader);
@@ -106,13 +171,21 @@ void GroupReader::_pre_process_columns_and_conjunct_ctxs() {
     for (const auto& column : _param.read_cols) {
         int chunk_index = column.col_idx_in_chunk;
         SlotId slot_id = column.slot_id;
-        const tparquet::ColumnMetaData& column_metadata =
-                _row_group_metadata->columns[column.col_idx_in_parquet].meta_data;
-        if (_can_using_dict_filter(slots[chunk_index], conjunct_ctxs_by_slot, column_metadata)) {
+        const auto* field = _file_metadata->schema().get_field_by_idx(column.col_idx_in_parquet);
+        if (field->is_leaf() &&
+            _can_using_dict_filter(slots[chunk_index], conjunct_ctxs_by_slot,
+                                   _row_group_metadata->columns[field->physical_column_index].meta_data)) {
             _dict_filter_columns.emplace_back(column);
             _dict_filter_conjunct_ctxs[slot_id] = conjunct_ctxs_by_slot.at(slot_id);
         } else {
             _direct_read_columns.emplace_back(column);
+            // array columns can not skip rows, so they are always read before the conjuncts are evaluated
+            if (conjunct_ctxs_by_slot.find(slot_id) != conjunct_ctxs_by_slot.end() ||
+                column.col_type_in_chunk.type == TYPE_ARRAY) {
+                _active_read_columns.emplace_back(column);
+            } else {
+                _lazy_read_columns.emplace_back(column);
+            }
             if (conjunct_ctxs_by_slot.find(slot_id) != conjunct_ctxs_by_slot.end()) {
                 for (ExprContext* ctx : conjunct_ctxs_by_slot.at(slot_id)) {
                     _left_conjunct_ctxs.emplace_back(ctx);
@@ -120,6 +193,13 @@ void GroupReader::_pre_process_columns_and_conjunct_ctxs() {
             }
         }
     }
+
+    // late materialization is useless if there are no conjuncts or all the columns have conjuncts
+    bool has_conjuncts = !_dict_filter_columns.empty() || !_left_conjunct_ctxs.empty();
+    if (!config::parquet_late_materialization_enable || !has_conjuncts) {
+        _active_read_columns.clear();
+        _lazy_read_columns.clear();
+    }
 }
 
 bool GroupReader::_can_using_dict_filter(const SlotDescriptor* slot, const SlotIdExprContextsMap& conjunct_ctxs_by_slot,
@@ -276,7 +356,21 @@ void GroupReader::_init_read_chunk() {
     }
 }
 
-Status GroupReader::_read(size_t* row_count) {
+Status GroupReader::_next_row_range(size_t* row_count) {
+    vectorized::Range range = _row_range_iter.next(*row_count);
+    if (range.begin() > _next_row) {
+        size_t num_rows = range.begin() - _next_row;
+        for (auto& [slot_id, column_reader] : _column_readers) {
+            RETURN_IF_ERROR(column_reader->skip_rows(num_rows));
+        }
+        _param.stats->page_skip_rows += num_rows;
+    }
+    _next_row = range.end();
+    *row_count = range.span_size();
+    return Status::OK();
+}
+
+Status GroupReader::_read(const std::vector<GroupReaderParam::Column>& direct_read_columns, size_t* row_count) {
     size_t count = *row_count;
 
     for (const auto& column : _dict_filter_columns) {
@@ -289,7 +383,7 @@ Status GroupReader::_read(size_t* row_count) {
         }
     }
 
-    for (const auto& column : _direct_read_columns) {
+    for (const auto& column : direct_read_columns) {
         SlotId slot_id = column.slot_id;
         count = *row_count;
         Status status = _column_readers[slot_id]->next_batch(&count, ColumnContentType::VALUE,
@@ -308,19 +402,116 @@ Status GroupReader::_read(size_t* row_count) {
     return Status::OK();
 }
 
-void GroupReader::_dict_filter() {
-    DCHECK(!_dict_filter_preds.empty());
+// If the selected rows are in too many ranges, the lazy columns are read for all the rows and then
+// filtered, because the overhead of reading and skipping each range exceeds the decoding saved.
+static constexpr size_t kLazyReadMinRowsPerRange = 16;
 
-    size_t count = _read_chunk->num_rows();
+Status GroupReader::_late_materialize(size_t row_count) {
+    vectorized::Column::Filter filter(row_count, 1);
+    if (row_count > 0) {
+        SCOPED_RAW_TIMER(&_param.stats->expr_filter_ns);
+        if (!_dict_filter_preds.empty()) {
+            SCOPED_RAW_TIMER(&_param.stats->group_dict_filter_ns);
+            _eval_dict_filter_preds(filter.data());
+        }
+        if (!_left_conjunct_ctxs.empty()) {
+            vectorized::Chunk active_chunk;
+            for (const auto& column : _active_read_columns) {
+                active_chunk.append_column(_read_chunk->get_column_by_slot_id(column.slot_id), column.slot_id);
+            }
+            for (ExprContext* ctx : _left_conjunct_ctxs) {
+                vectorized::ColumnPtr result = ctx->evaluate(&active_chunk);
+                vectorized::ColumnHelper::merge_two_filters(result, &filter);
+            }
+        }
+    }
+
+    size_t hit_count = SIMD::count_nonzero(filter.data(), row_count);
+    RETURN_IF_ERROR(_read_lazy_columns(filter, row_count, hit_count));
+    if (hit_count == 0) {
+        _read_chunk->set_num_rows(0);
+    } else if (hit_count != row_count) {
+        for (const auto& column : _dict_filter_columns) {
+            _read_chunk->get_column_by_slot_id(column.slot_id)->filter(filter);
+        }
+        for (const auto& column : _active_read_columns) {
+            _read_chunk->get_column_by_slot_id(column.slot_id)->filter(filter);
+        }
+    }
+    return Status::OK();
+}
+
+Status GroupReader::_read_lazy_columns(const vectorized::Column::Filter& filter, size_t row_count,
+                                       size_t hit_count) {
+    // ranges of the rows with the same selection
+    std::vector<std::pair<bool, size_t>> ranges;
+    size_t num_selected_ranges = 0;
+    if (hit_count > 0 && hit_count < row_count) {
+        size_t i = 0;
+        while (i < row_count) {
+            size_t j = i + 1;
+            while (j < row_count && filter[j] == filter[i]) {
+                j++;
+            }
+            ranges.emplace_back(filter[i] != 0, j - i);
+            num_selected_ranges += filter[i] != 0;
+            i = j;
+        }
+    }
+    bool read_selected_only = num_selected_ranges * kLazyReadMinRowsPerRange <= row_count;
+
+    for (const auto& column : _lazy_read_columns) {
+        ColumnReader* column_reader = _column_readers[column.slot_id].get();
+        vectorized::Column* dst = _read_chunk->get_column_by_slot_id(column.slot_id).get();
+        if (hit_count == 0) {
+            RETURN_IF_ERROR(column_reader->skip_rows(row_count));
+            _param.stats->lazy_skip_rows += row_count;
+            continue;
+        }
+        if (ranges.empty() || !read_selected_only) {
+            size_t count = row_count;
+            Status status = column_reader->next_batch(&count, ColumnContentType::VALUE, dst);
+            if (!status.ok() && !status.is_end_of_file()) {
+                return status;
+            }
+            if (!ranges.empty()) {
+                dst->filter(filter);
+            }
+            continue;
+        }
+        for (const auto& [selected, num_rows] : ranges) {
+            if (selected) {
+                size_t count = num_rows;
+                Status status = column_reader->next_batch(&count, ColumnContentType::VALUE, dst);
+                if (!status.ok() && !status.is_end_of_file()) {
+                    return status;
+                }
+            } else {
+                RETURN_IF_ERROR(column_reader->skip_rows(num_rows));
+                _param.stats->lazy_skip_rows += num_rows;
+            }
+        }
+    }
+    return Status::OK();
+}
+
+void GroupReader::_eval_dict_filter_preds(uint8_t* selection) {
     auto iter = _dict_filter_preds.begin();
     SlotId slot_id = iter->first;
     auto pred = iter->second;
-    pred->evaluate(_read_chunk->get_column_by_slot_id(slot_id).get(), _selection.data());
+    pred->evaluate(_read_chunk->get_column_by_slot_id(slot_id).get(), selection);
     while (++iter != _dict_filter_preds.end()) {
         slot_id = iter->first;
         pred = iter->second;
-        pred->evaluate_and(_read_chunk->get_column_by_slot_id(slot_id).get(), _selection.data());
+        pred->evaluate_and(_read_chunk->get_column_by_slot_id(slot_id).get(), selection);
     }
+}
+
+void GroupReader::_dict_filter() {
+    DCHECK(!_dict_filter_preds.empty());
+
+    size_t count = _read_chunk->num_rows();
+    _eval_dict_filter_preds(_selection.data());
 
     auto hit_count = SIMD::count_nonzero(_selection.data(), count);
     if (hit_count == 0) {
@@ -6,10 +6,12 @@
 #include "column/vectorized_fwd.h"
 #include "exec/parquet/column_reader.h"
 #include "exec/parquet/metadata.h"
+#include "exec/vectorized/coalesced_random_access_file.h"
 #include "exec/vectorized/hdfs_scanner.h"
 #include "gen_cpp/parquet_types.h"
 #include "runtime/descriptors.h"
 #include "storage/vectorized/column_predicate.h"
+#include "storage/vectorized/range.h"
 #include "util/runtime_profile.h"
 
 namespace starrocks {
@@ -48,6 +50,9 @@ struct GroupReaderParam {
 
     std::string timezone;
 
+    // rows of the row group to read, selected by the page index. empty means all of the rows.
+    vectorized::SparseRange row_ranges;
+
     vectorized::HdfsScanStats* stats = nullptr;
 };
 
@@ -62,6 +67,8 @@ public:
 private:
     using SlotIdExprContextsMap = std::unordered_map<int, std::vector<ExprContext*>>;
 
+    // merge the reads of the column chunks to read
+    void _init_coalesced_file();
     Status _init_column_readers();
     Status _create_column_reader(const GroupReaderParam::Column& column);
     // Extract dict filter columns and conjuncts
@@ -73,11 +80,20 @@ private:
     Status _rewrite_dict_column_predicates();
     void _init_read_chunk();
 
-    Status _read(size_t* row_count);
+    // skip the column readers to the next row range, and limit row_count to the rows of the range
+    Status _next_row_range(size_t* row_count);
+    // read the dict filter columns and direct_read_columns
+    Status _read(const std::vector<GroupReaderParam::Column>& direct_read_columns, size_t* row_count);
+    // evaluate the conjuncts on the columns read, then read the lazy columns only for the selected rows
+    Status _late_materialize(size_t row_count);
+    Status _read_lazy_columns(const vectorized::Column::Filter& filter, size_t row_count, size_t hit_count);
+    void _eval_dict_filter_preds(uint8_t* selection);
     void _dict_filter();
     Status _dict_decode(vectorized::ChunkPtr* chunk);
 
     RandomAccessFile* _file;
+    // reads the column chunks with a few large reads, null if the io coalescing is disabled
+    std::unique_ptr<vectorized::CoalescedRandomAccessFile> _coalesced_file;
 
     // parquet file meta
     FileMetaData* _file_metadata;
@@ -90,6 +106,11 @@ private:
 
     // column readers for column chunk in row group
     std::unordered_map<SlotId, std::unique_ptr<ColumnReader>> _column_readers;
+    // offset indexes of the column chunks, used to skip the pages out of row ranges
+    std::unordered_map<SlotId, tparquet::OffsetIndex> _offset_indexes;
+    vectorized::SparseRangeIterator _row_range_iter;
+    // the next row to read in row group
+    size_t _next_row = 0;
     // conjunct ctxs for each dict filter column
     std::unordered_map<SlotId, std::vector<ExprContext*>> _dict_filter_conjunct_ctxs;
     // preds transformed from conjunct ctxs for each dict filter column
@@ -101,6 +122,10 @@ private:
     std::vector<GroupReaderParam::Column> _dict_filter_columns;
     // direct read conlumns
     std::vector<GroupReaderParam::Column> _direct_read_columns;
+    // direct read columns with conjuncts, read before the lazy columns
+    std::vector<GroupReaderParam::Column> _active_read_columns;
+    // direct read columns without conjuncts, only read for the rows selected by the conjuncts
+    std::vector<GroupReaderParam::Column> _lazy_read_columns;
 
     // dict value is empty after conjunct eval, file group can be skipped
     bool _is_group_filtered = false;
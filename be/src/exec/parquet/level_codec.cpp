@@ -2,6 +2,9 @@
 
 #include "exec/parquet/level_codec.h"
 
+#include <algorithm>
+#include <cstring>
+
 #include "util/bit_util.h"
 #include "util/coding.h"
 
@@ -22,7 +25,7 @@ Status LevelDecoder::parse(tparquet::Encoding::type encoding, level_t max_level,
         if (num_bytes > slice->size - 4) {
             return Status::InternalError("");
         }
-        _rle_decoder = RleDecoder<level_t>(data + 4, num_bytes, _bit_width);
+        _rle_decoder = RleBatchDecoder<uint16_t>(data + 4, num_bytes, _bit_width);
 
         slice->data += 4 + num_bytes;
         slice->size -= 4 + num_bytes;
@@ -46,4 +49,42 @@ Status LevelDecoder::parse(tparquet::Encoding::type encoding, level_t max_level,
     return Status::OK();
 }
 
+size_t LevelDecoder::decode_null_map(size_t n, level_t max_level, uint8_t* is_nulls) {
+    if (_encoding != tparquet::Encoding::RLE) {
+        return 0;
+    }
+    // a multiple of 32, so that the literals are unpacked directly into the buffer
+    constexpr size_t kLevelBatchSize = 256;
+    uint16_t levels[kLevelBatchSize];
+
+    n = std::min((size_t)_num_levels, n);
+    size_t num_decoded = 0;
+    while (num_decoded < n) {
+        size_t num_repeats = _rle_decoder.NextNumRepeats();
+        if (num_repeats > 0) {
+            size_t num_to_set = std::min(num_repeats, n - num_decoded);
+            level_t level = _rle_decoder.GetRepeatedValue(num_to_set);
+            memset(is_nulls + num_decoded, level < max_level, num_to_set);
+            num_decoded += num_to_set;
+            continue;
+        }
+
+        size_t num_literals = _rle_decoder.NextNumLiterals();
+        if (num_literals == 0) {
+            break;
+        }
+        size_t num_to_set = std::min({num_literals, n - num_decoded, kLevelBatchSize});
+        if (!_rle_decoder.GetLiteralValues(num_to_set, levels)) {
+            break;
+        }
+        uint8_t* dst = is_nulls + num_decoded;
+        for (size_t i = 0; i < num_to_set; ++i) {
+            dst[i] = static_cast<level_t>(levels[i]) < max_level;
+        }
+        num_decoded += num_to_set;
+    }
+    _num_levels -= num_decoded;
+    return num_decoded;
+}
+
 } // namespace starrocks::parquet
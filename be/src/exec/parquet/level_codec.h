@@ -34,7 +34,8 @@ public:
             // NOTE(zc): Because RLE can only record elements that are multiples of 8,
             // it must be ensured that the incoming parameters cannot exceed the boundary.
             n = std::min((size_t)_num_levels, n);
-            auto num_decoded = _rle_decoder.GetBatch(levels, n);
+            // levels are never negative, so they are unpacked as unsigned integers in batches.
+            auto num_decoded = _rle_decoder.GetBatch(reinterpret_cast<uint16_t*>(levels), n);
             _num_levels -= num_decoded;
             return num_decoded;
         } else if (_encoding == tparquet::Encoding::BIT_PACKED) {
@@ -42,19 +43,27 @@ public:
         return 0;
     }
 
+    // Try to decode n levels and set is_nulls[i] to whether the i-th level is less than max_level,
+    // without materializing the levels. The repeated runs are filled with memset and the literal
+    // runs are unpacked in batches. Return the number of decoded levels.
+    size_t decode_null_map(size_t n, level_t max_level, uint8_t* is_nulls);
+
     size_t next_repeated_count() {
         DCHECK_EQ(_encoding, tparquet::Encoding::RLE);
-        return _rle_decoder.repeated_count();
+        return _rle_decoder.NextNumRepeats();
     }
 
-    level_t get_repeated_value(size_t count) { return _rle_decoder.get_repeated_value(count); }
+    level_t get_repeated_value(size_t count) {
+        _num_levels -= count;
+        return _rle_decoder.GetRepeatedValue(count);
+    }
 
 private:
     tparquet::Encoding::type _encoding;
     level_t _bit_width = 0;
     level_t _max_level = 0;
     uint32_t _num_levels = 0;
-    RleDecoder<level_t> _rle_decoder;
+    RleBatchDecoder<uint16_t> _rle_decoder;
     BitReader _bit_packed_decoder;
 };
 
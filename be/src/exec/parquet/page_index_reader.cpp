@@ -0,0 +1,51 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/parquet/page_index_reader.h"
+
+#include <memory>
+
+#include "env/env.h"
+#include "gutil/strings/substitute.h"
+#include "util/thrift_util.h"
+
+namespace starrocks::parquet {
+
+bool has_column_index(const tparquet::ColumnChunk& column_chunk) {
+    return column_chunk.__isset.column_index_offset && column_chunk.__isset.column_index_length &&
+           column_chunk.column_index_length > 0;
+}
+
+bool has_offset_index(const tparquet::ColumnChunk& column_chunk) {
+    return column_chunk.__isset.offset_index_offset && column_chunk.__isset.offset_index_length &&
+           column_chunk.offset_index_length > 0;
+}
+
+template <typename T>
+static Status read_thrift_struct(RandomAccessFile* file, int64_t offset, int32_t length, T* msg) {
+    if (offset < 0 || length <= 0) {
+        return Status::Corruption(strings::Substitute("Invalid parquet page index: name=$0, offset=$1, length=$2",
+                                                      file->file_name(), offset, length));
+    }
+    std::unique_ptr<uint8_t[]> buf(new uint8_t[length]);
+    RETURN_IF_ERROR(file->read_at(offset, Slice(buf.get(), length)));
+    uint32_t len = length;
+    return deserialize_thrift_msg(buf.get(), &len, TProtocolType::COMPACT, msg);
+}
+
+Status read_column_index(RandomAccessFile* file, const tparquet::ColumnChunk& column_chunk,
+                         tparquet::ColumnIndex* column_index) {
+    RETURN_IF_ERROR(read_thrift_struct(file, column_chunk.column_index_offset, column_chunk.column_index_length,
+                                       column_index));
+    if (column_index->min_values.size() != column_index->null_pages.size() ||
+        column_index->max_values.size() != column_index->null_pages.size()) {
+        return Status::Corruption(strings::Substitute("Invalid parquet column index: name=$0", file->file_name()));
+    }
+    return Status::OK();
+}
+
+Status read_offset_index(RandomAccessFile* file, const tparquet::ColumnChunk& column_chunk,
+                         tparquet::OffsetIndex* offset_index) {
+    return read_thrift_struct(file, column_chunk.offset_index_offset, column_chunk.offset_index_length, offset_index);
+}
+
+} // namespace starrocks::parquet
@@ -0,0 +1,26 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "common/status.h"
+#include "gen_cpp/parquet_types.h"
+
+namespace starrocks {
+class RandomAccessFile;
+} // namespace starrocks
+
+namespace starrocks::parquet {
+
+// The page index of a column chunk is written after all the row groups, and consists of a column
+// index holding the min/max values of each data page and an offset index holding the location
+// and the first row of each data page.
+// refer: https://github.com/apache/parquet-format/blob/master/PageIndex.md
+bool has_column_index(const tparquet::ColumnChunk& column_chunk);
+bool has_offset_index(const tparquet::ColumnChunk& column_chunk);
+
+Status read_column_index(RandomAccessFile* file, const tparquet::ColumnChunk& column_chunk,
+                         tparquet::ColumnIndex* column_index);
+Status read_offset_index(RandomAccessFile* file, const tparquet::ColumnChunk& column_chunk,
+                         tparquet::OffsetIndex* offset_index);
+
+} // namespace starrocks::parquet
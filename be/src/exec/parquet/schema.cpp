@@ -354,7 +354,7 @@ std::string SchemaDescriptor::debug_string() const {
 
 int SchemaDescriptor::get_column_index(const std::string& column) const {
     for (size_t i = 0; i < _fields.size(); i++) {
-        if (_physical_fields[i]->name == column) {
+        if (_fields[i].name == column) {
             return i;
         }
     }
@@ -55,6 +55,8 @@ struct ParquetField {
 
     int16_t max_def_level() const { return level_info.max_def_level; }
     int16_t max_rep_level() const { return level_info.max_rep_level; }
+    // Only the leaf nodes are stored as column chunks, the others are nested types.
+    bool is_leaf() const { return children.empty(); }
     std::string debug_string() const;
 };
 
@@ -67,7 +69,9 @@ public:
 
     std::string debug_string() const;
 
+    // Return the index of the top level field named column, or -1 if there is no such field.
     int get_column_index(const std::string& column) const;
+    const ParquetField* get_field_by_idx(int idx) const { return &_fields[idx]; }
     const ParquetField* get_stored_column_by_idx(int idx) const { return _physical_fields[idx]; }
 
     const ParquetField* resolve_by_name(const std::string& name) const {
@@ -2,10 +2,12 @@
 
 #include "exec/parquet/stored_column_reader.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "column/column.h"
 #include "exec/parquet/types.h"
+#include "simd/simd.h"
 #include "util/runtime_profile.h"
 
 namespace starrocks::parquet {
@@ -20,6 +22,8 @@ public:
 
         ColumnChunkReaderOptions opts;
         opts.stats = _opts.stats;
+        opts.offset_index = _opts.offset_index;
+        opts.num_rows = _opts.num_rows;
         _reader = std::make_unique<ColumnChunkReader>(_field->max_def_level(), _field->max_rep_level(),
                                                       _field->type_length, chunk_metadata, file, opts);
         RETURN_IF_ERROR(_reader->init());
@@ -31,29 +35,24 @@ public:
 
     Status read_records(size_t* num_rows, ColumnContentType content_type, vectorized::Column* dst) override;
 
+    // The levels of the rows returned by the last read_records.
     void get_levels(level_t** def_levels, level_t** rep_levels, size_t* num_levels) override {
-        *def_levels = &_def_levels[0];
-        *rep_levels = &_rep_levels[0];
+        *def_levels = _def_levels.data();
+        *rep_levels = _rep_levels.data();
         *num_levels = _levels_parsed;
     }
 
 private:
-    Status _next_page();
-
-    // Try to deocde enough levels in levels buffer, except there is no enough levels in current
+    // Decode at least num_levels levels into the levels buffer, unless there are not enough
+    // levels left in the current page.
     void _decode_levels(size_t num_levels);
 
-    void _delimit_rows(size_t* num_rows, size_t* num_levels_parsed);
-
 private:
     StoredColumnReaderOptions _opts;
 
     const ParquetField* _field = nullptr;
 
     bool _eof = false;
-    bool _meet_first_record = false;
-    size_t _num_values_left_in_cur_page = 0;
-
     size_t _levels_parsed = 0;
     size_t _levels_decoded = 0;
     size_t _levels_capacity = 0;
@@ -75,6 +74,8 @@ public:
 
         ColumnChunkReaderOptions opts;
         opts.stats = _opts.stats;
+        opts.offset_index = _opts.offset_index;
+        opts.num_rows = _opts.num_rows;
         _reader = std::make_unique<ColumnChunkReader>(_field->max_def_level(), _field->max_rep_level(),
                                                       _field->type_length, chunk_metadata, file, opts);
         RETURN_IF_ERROR(_reader->init());
@@ -85,6 +86,8 @@ public:
     // Reset internal state and ready for next read_values
     void reset() override;
 
+    Status skip_rows(size_t num_rows) override { return _skip_rows(num_rows); }
+
     Status read_records(size_t* num_records, ColumnContentType content_type, vectorized::Column* dst) override {
         if (_needs_levels) {
             return _read_records_and_levels(num_records, content_type, dst);
@@ -105,7 +108,7 @@ public:
     }
 
 private:
-    Status _next_page();
+    Status _skip_values(size_t num_values) override;
 
     void _decode_levels(size_t num_levels);
     Status _read_records_only(size_t* num_records, ColumnContentType content_type, vectorized::Column* dst);
@@ -120,7 +123,6 @@ private:
     bool _needs_levels = false;
 
     bool _eof = false;
-    size_t _num_values_left_in_cur_page = 0;
 
     size_t _levels_parsed = 0;
     size_t _levels_decoded = 0;
@@ -140,9 +142,12 @@ public:
 
         ColumnChunkReaderOptions opts;
         opts.stats = _opts.stats;
+        opts.offset_index = _opts.offset_index;
+        opts.num_rows = _opts.num_rows;
         _reader = std::make_unique<ColumnChunkReader>(_field->max_def_level(), _field->max_rep_level(),
                                                       _field->type_length, chunk_metadata, file, opts);
         RETURN_IF_ERROR(_reader->init());
+        _num_values_left_in_cur_page = _reader->num_values();
         return Status::OK();
     }
 
@@ -150,6 +155,8 @@ public:
 
     Status read_records(size_t* num_rows, ColumnContentType content_type, vectorized::Column* dst) override;
 
+    Status skip_rows(size_t num_rows) override { return _skip_rows(num_rows); }
+
     void get_levels(level_t** def_levels, level_t** rep_levels, size_t* num_levels) override {
         *def_levels = nullptr;
         *rep_levels = nullptr;
@@ -157,16 +164,49 @@ public:
     }
 
 private:
-    Status _next_page();
+    Status _skip_values(size_t num_values) override { return _reader->skip_values(num_values); }
 
     RandomAccessFile* _file = nullptr;
     // TODO(zc): No need copy
     const tparquet::ColumnChunk _chunk_metadata;
     const ParquetField* _field = nullptr;
     StoredColumnReaderOptions _opts;
-    size_t _num_values_left_in_cur_page = 0;
 };
 
+Status StoredColumnReader::_next_page() {
+    do {
+        RETURN_IF_ERROR(_reader->next_page());
+        _num_values_left_in_cur_page = _reader->num_values();
+    } while (_num_values_left_in_cur_page == 0);
+    return Status::OK();
+}
+
+Status StoredColumnReader::_skip_rows(size_t num_rows) {
+    while (num_rows > 0) {
+        // skip the following pages without reading them once the current one is consumed
+        while (_num_values_left_in_cur_page == 0) {
+            int64_t page_rows = _reader->next_page_num_rows();
+            if (page_rows < 0 || static_cast<size_t>(page_rows) > num_rows) {
+                break;
+            }
+            RETURN_IF_ERROR(_reader->skip_next_page());
+            num_rows -= page_rows;
+        }
+        if (num_rows == 0) {
+            break;
+        }
+
+        if (_num_values_left_in_cur_page == 0) {
+            RETURN_IF_ERROR(_next_page());
+        }
+        size_t rows_to_skip = std::min(num_rows, _num_values_left_in_cur_page);
+        RETURN_IF_ERROR(_skip_values(rows_to_skip));
+        _num_values_left_in_cur_page -= rows_to_skip;
+        num_rows -= rows_to_skip;
+    }
+    return Status::OK();
+}
+
 void RepeatedStoredColumnReader::reset() {
     size_t num_levels = _levels_decoded - _levels_parsed;
     if (_levels_parsed == 0 || num_levels == 0) {
@@ -180,107 +220,73 @@ void RepeatedStoredColumnReader::reset() {
     _levels_parsed = 0;
 }
 
-Status RepeatedStoredColumnReader::read_records(size_t* num_records, ColumnContentType content_type,
+Status RepeatedStoredColumnReader::read_records(size_t* num_rows, ColumnContentType content_type,
                                                 vectorized::Column* dst) {
+    SCOPED_RAW_TIMER(&_opts.stats->column_read_ns);
     if (_eof) {
         return Status::EndOfFile("");
     }
+    // drop the levels returned by the last call, the levels of this call are kept for get_levels
+    reset();
 
-    size_t records_read = 0;
-    do {
-        if (_num_values_left_in_cur_page == 0) {
-            auto st = _next_page();
-            if (!st.ok()) {
-                if (st.is_end_of_file()) {
-                    if (_meet_first_record) {
-                        records_read++;
+    size_t rows_read = 0;
+    while (true) {
+        if (_levels_parsed == _levels_decoded) {
+            if (_num_values_left_in_cur_page == 0) {
+                SCOPED_RAW_TIMER(&_opts.stats->page_read_ns);
+                auto st = _next_page();
+                if (!st.ok()) {
+                    if (st.is_end_of_file()) {
+                        _eof = true;
+                        break;
+                    } else {
+                        return st;
                     }
-                    _eof = true;
-                    break;
-                } else {
-                    return st;
                 }
             }
+            SCOPED_RAW_TIMER(&_opts.stats->level_decode_ns);
+            _decode_levels(*num_rows - rows_read);
         }
-        // NOTE: must have values in current page.
-        DCHECK_GT(_num_values_left_in_cur_page, 0);
 
-        size_t records_to_read = *num_records - records_read;
-        _decode_levels(records_to_read);
-
-        size_t num_parsed_levels = 0;
-        _delimit_rows(&records_to_read, &num_parsed_levels);
+        // A level whose rep level is 0 starts a new row. The levels of a row may span pages, so
+        // the last row is complete only when the first level of the next row is met.
+        size_t levels_pos = _levels_parsed;
+        for (; levels_pos < _levels_decoded; ++levels_pos) {
+            if (_rep_levels[levels_pos] == 0) {
+                if (rows_read == *num_rows) {
+                    break;
+                }
+                rows_read++;
+            }
+        }
 
-        // decode value read from reader
-        // TODO(zc): optimized here
         {
-            // ensure enough capacity
-            _is_nulls.resize(num_parsed_levels);
-            int null_pos = 0;
-            for (int i = 0; i < num_parsed_levels; ++i) {
-                _is_nulls[null_pos] = _def_levels[i] < _field->max_def_level();
-                null_pos += _def_levels[i] >= _field->level_info.immediate_repeated_ancestor_def_level;
+            SCOPED_RAW_TIMER(&_opts.stats->value_decode_ns);
+            // only the levels not less than immediate_repeated_ancestor_def_level have values, the
+            // others stand for the empty or null ancestors.
+            _is_nulls.resize(levels_pos - _levels_parsed);
+            size_t num_values = 0;
+            for (size_t i = _levels_parsed; i < levels_pos; ++i) {
+                _is_nulls[num_values] = _def_levels[i] < _field->max_def_level();
+                num_values += _def_levels[i] >= _field->level_info.immediate_repeated_ancestor_def_level;
+            }
+            if (num_values > 0) {
+                RETURN_IF_ERROR(_reader->decode_values(num_values, &_is_nulls[0], content_type, dst));
             }
-            RETURN_IF_ERROR(_reader->decode_values(null_pos, &_is_nulls[0], content_type, dst));
         }
-
-        records_read += num_parsed_levels;
-        _levels_parsed += num_parsed_levels;
-        _num_values_left_in_cur_page -= num_parsed_levels;
-    } while (records_read < *num_records);
-
-    *num_records = records_read;
-    return Status::OK();
-}
-
-Status RepeatedStoredColumnReader::_next_page() {
-    do {
-        RETURN_IF_ERROR(_reader->next_page());
-        _num_values_left_in_cur_page = _reader->num_values();
-    } while (_num_values_left_in_cur_page == 0);
-    return Status::OK();
-}
-
-void RepeatedStoredColumnReader::_delimit_rows(size_t* num_rows, size_t* num_levels_parsed) {
-    DCHECK_GT(_levels_decoded - _levels_parsed, 0);
-    size_t levels_pos = _levels_parsed;
-
-    std::stringstream ss;
-    ss << "rep=[";
-    for (int i = levels_pos; i < _levels_decoded; ++i) {
-        ss << ", " << _rep_levels[i];
-    }
-    ss << "], def=[";
-    for (int i = levels_pos; i < _levels_decoded; ++i) {
-        ss << ", " << _def_levels[i];
-    }
-    ss << "]";
-    LOG(INFO) << ss.str();
-
-    if (!_meet_first_record) {
-        _meet_first_record = true;
-        DCHECK_EQ(_rep_levels[levels_pos], 0);
-        levels_pos++;
-    }
-
-    size_t rows_read = 0;
-    for (; levels_pos < _levels_decoded && rows_read < *num_rows; ++levels_pos) {
-        rows_read += _rep_levels[levels_pos] == 0;
+        _levels_parsed = levels_pos;
+        if (levels_pos < _levels_decoded) {
+            break;
+        }
     }
 
-    LOG(INFO) << "rows_reader=" << rows_read << ", level_parsed=" << levels_pos - _levels_parsed;
     *num_rows = rows_read;
-    *num_levels_parsed = levels_pos - _levels_parsed;
+    return Status::OK();
 }
 
 void RepeatedStoredColumnReader::_decode_levels(size_t num_levels) {
     constexpr size_t min_level_batch_size = 4096;
-    size_t levels_remaining = _levels_decoded - _levels_parsed;
-    if (num_levels <= levels_remaining) {
-        return;
-    }
-    size_t levels_to_decode = std::max(min_level_batch_size, num_levels - levels_remaining);
-    levels_to_decode = std::min(levels_to_decode, _num_values_left_in_cur_page - levels_remaining);
+    size_t levels_to_decode = std::min(std::max(min_level_batch_size, num_levels), _num_values_left_in_cur_page);
 
     size_t new_capacity = _levels_decoded + levels_to_decode;
     if (new_capacity > _levels_capacity) {
@@ -295,6 +301,7 @@ void RepeatedStoredColumnReader::_decode_levels(size_t num_levels) {
     _reader->decode_rep_levels(levels_to_decode, &_rep_levels[_levels_decoded]);
 
     _levels_decoded += levels_to_decode;
+    _num_values_left_in_cur_page -= levels_to_decode;
 }
 
 void OptionalStoredColumnReader::reset() {
@@ -395,32 +402,12 @@ Status OptionalStoredColumnReader::_read_records_only(size_t* num_records, Colum
             {
                 SCOPED_RAW_TIMER(&_opts.stats->level_decode_ns);
 
-                size_t new_capacity = records_to_read;
-                if (new_capacity > _levels_capacity) {
-                    new_capacity = BitUtil::next_power_of_two(new_capacity);
-                    _def_levels.resize(new_capacity);
-
-                    _levels_capacity = new_capacity;
-                }
-                _reader->decode_def_levels(records_to_read, &_def_levels[0]);
+                _is_nulls.resize(records_to_read);
+                _reader->def_level_decoder().decode_null_map(records_to_read, _field->max_def_level(), &_is_nulls[0]);
             }
 
             SCOPED_RAW_TIMER(&_opts.stats->value_decode_ns);
-            size_t i = 0;
-            while (i < records_to_read) {
-                size_t j = i;
-                bool is_null = _def_levels[j] < _field->max_def_level();
-                j++;
-                while (j < records_to_read && is_null == (_def_levels[j] < _field->max_def_level())) {
-                    j++;
-                }
-                if (is_null) {
-                    dst->append_nulls(j - i);
-                } else {
-                    RETURN_IF_ERROR(_reader->decode_values(j - i, content_type, dst));
-                }
-                i = j;
-            }
+            RETURN_IF_ERROR(_reader->decode_values(records_to_read, &_is_nulls[0], content_type, dst));
         }
 
         _num_values_left_in_cur_page -= records_to_read;
@@ -430,12 +417,21 @@ Status OptionalStoredColumnReader::_read_records_only(size_t* num_records, Colum
     return Status::OK();
 }
 
-Status OptionalStoredColumnReader::_next_page() {
-    do {
-        RETURN_IF_ERROR(_reader->next_page());
-        _num_values_left_in_cur_page = _reader->num_values();
-    } while (_num_values_left_in_cur_page == 0);
-    return Status::OK();
+Status OptionalStoredColumnReader::_skip_values(size_t num_values) {
+    // the def levels are decoded to know how many values are not null
+    size_t num_not_nulls = 0;
+    if (_needs_levels) {
+        _decode_levels(num_values);
+        for (size_t i = 0; i < num_values; ++i) {
+            num_not_nulls += _def_levels[_levels_parsed + i] >= _field->max_def_level();
+        }
+        _levels_parsed += num_values;
+    } else {
+        _is_nulls.resize(num_values);
+        _reader->def_level_decoder().decode_null_map(num_values, _field->max_def_level(), &_is_nulls[0]);
+        num_not_nulls = SIMD::count_zero(_is_nulls, num_values);
+    }
+    return _reader->skip_values(num_not_nulls);
 }
 
 void OptionalStoredColumnReader::_decode_levels(size_t num_levels) {
@@ -483,14 +479,6 @@ Status RequiredStoredColumnReader::read_records(size_t* num_records, ColumnConte
     return Status::OK();
 }
 
-Status RequiredStoredColumnReader::_next_page() {
-    do {
-        RETURN_IF_ERROR(_reader->next_page());
-        _num_values_left_in_cur_page = _reader->num_values();
-    } while (_num_values_left_in_cur_page == 0);
-    return Status::OK();
-}
-
 Status StoredColumnReader::create(RandomAccessFile* file, const ParquetField* field,
                                   const tparquet::ColumnChunk* chunk_metadata, const StoredColumnReaderOptions& opts,
                                   std::unique_ptr<StoredColumnReader>* out) {
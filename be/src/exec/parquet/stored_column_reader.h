@@ -26,6 +26,10 @@ class ColumnChunkReader;
 
 struct StoredColumnReaderOptions {
     vectorized::HdfsScanStats* stats = nullptr;
+    // page locations of the column chunk, nullptr if the pages can not be skipped
+    const tparquet::OffsetIndex* offset_index = nullptr;
+    // number of rows of the row group
+    int64_t num_rows = 0;
 };
 
 class StoredColumnReader {
@@ -50,6 +54,10 @@ public:
     // this function will fill (1, 2, 3, 4, 5, 6) into 'dst'.
     virtual Status read_records(size_t* num_rows, ColumnContentType content_type, vectorized::Column* dst) = 0;
 
+    // Skip the next num_rows rows without decoding their values. The pages entirely covered by
+    // the skipped rows are not read if the offset index is given.
+    virtual Status skip_rows(size_t num_rows) { return Status::NotSupported("skip_rows is not supported"); }
+
     // This function can only be called after calling read_values. This function returns the
     // levels for last read_values.
     virtual void get_levels(level_t** def_levels, level_t** rep_levels, size_t* num_levels) = 0;
@@ -65,7 +73,15 @@ public:
     }
 
 protected:
+    Status _next_page();
+
+    // skip rows of the non-repeated column, whose number of values equals to the number of rows.
+    Status _skip_rows(size_t num_rows);
+    // skip rows in current page
+    virtual Status _skip_values(size_t num_values) { return Status::NotSupported("skip_values is not supported"); }
+
     std::unique_ptr<ColumnChunkReader> _reader;
+    size_t _num_values_left_in_cur_page = 0;
 };
 
 } // namespace starrocks::parquet
@@ -78,6 +78,10 @@ Status AggregateBlockingSinkOperator::push_chunk(RuntimeState* state, const vect
     }
     _aggregator->update_num_input_rows(chunk->num_rows());
 
+    if (_aggregator->should_spill()) {
+        RETURN_IF_ERROR(_aggregator->spill_hash_map(state));
+    }
+
     return Status::OK();
 }
 } // namespace starrocks::pipeline
\ No newline at end of file
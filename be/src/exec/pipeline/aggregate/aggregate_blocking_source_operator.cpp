@@ -5,11 +5,13 @@
 namespace starrocks::pipeline {
 
 bool AggregateBlockingSourceOperator::has_output() const {
-    return _aggregator->is_sink_complete() && !_aggregator->is_ht_eos();
+    return _aggregator->is_sink_complete() &&
+           (!_aggregator->is_ht_eos() || _aggregator->has_pending_spill_partitions());
 }
 
 bool AggregateBlockingSourceOperator::is_finished() const {
-    return _aggregator->is_sink_complete() && _aggregator->is_ht_eos();
+    return _aggregator->is_sink_complete() && _aggregator->is_ht_eos() &&
+           !_aggregator->has_pending_spill_partitions();
 }
 
 void AggregateBlockingSourceOperator::finish(RuntimeState* state) {
@@ -34,6 +36,8 @@ StatusOr<vectorized::ChunkPtr> AggregateBlockingSourceOperator::pull_chunk(Runti
         SCOPED_TIMER(_aggregator->get_results_timer());
         _aggregator->convert_to_chunk_no_groupby(&chunk);
     } else {
+        // Load the next spilled partition into hash map once the current one is consumed
+        RETURN_IF_ERROR(_aggregator->restore_spill_partition_if_needed(state));
         if (false) {
         }
 #define HASH_MAP_METHOD(NAME)                                                                                     \
@@ -32,17 +32,19 @@ private:
 
 class AggregateBlockingSourceOperatorFactory final : public SourceOperatorFactory {
 public:
-    AggregateBlockingSourceOperatorFactory(int32_t id, int32_t plan_node_id, AggregatorPtr aggregator)
+    AggregateBlockingSourceOperatorFactory(int32_t id, int32_t plan_node_id, AggregatorFactoryPtr aggregator_factory)
             : SourceOperatorFactory(id, "aggregate_blocking_source", plan_node_id),
-              _aggregator(std::move(aggregator)) {}
+              _aggregator_factory(std::move(aggregator_factory)) {}
 
     ~AggregateBlockingSourceOperatorFactory() override = default;
 
     OperatorPtr create(int32_t degree_of_parallelism, int32_t driver_sequence) override {
-        return std::make_shared<AggregateBlockingSourceOperator>(_id, _plan_node_id, _aggregator);
+        return std::make_shared<AggregateBlockingSourceOperator>(_id, _plan_node_id,
+                                                                 _aggregator_factory->get_or_create(_aggregator_idx++));
     }
 
 private:
-    AggregatorPtr _aggregator = nullptr;
+    AggregatorFactoryPtr _aggregator_factory = nullptr;
+    size_t _aggregator_idx = 0;
 };
 } // namespace starrocks::pipeline
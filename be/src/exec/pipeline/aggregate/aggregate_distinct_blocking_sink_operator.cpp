@@ -72,6 +72,7 @@ Status AggregateDistinctBlockingSinkOperator::push_chunk(RuntimeState* state, co
         }
 
         RETURN_IF_ERROR(_aggregator->check_hash_set_memory_usage(state));
+        _aggregator->try_convert_to_two_level_set();
     }
 
     return Status::OK();
@@ -32,10 +32,13 @@ Status AggregateDistinctStreamingSinkOperator::push_chunk(RuntimeState* state, c
     _aggregator->update_num_input_rows(chunk_size);
     COUNTER_SET(_aggregator->input_row_count(), _aggregator->num_input_rows());
     RETURN_IF_ERROR(_aggregator->check_hash_set_memory_usage(state));
+    _aggregator->try_convert_to_two_level_set();
 
     _aggregator->evaluate_exprs(chunk.get());
+    _aggregator->sample_streaming_reduction(chunk_size);
 
-    if (_aggregator->streaming_preaggregation_mode() == TStreamingPreaggregationMode::FORCE_STREAMING) {
+    if (_aggregator->streaming_preaggregation_mode() == TStreamingPreaggregationMode::FORCE_STREAMING ||
+        _aggregator->is_streaming_pass_through()) {
         return _push_chunk_by_force_streaming();
     } else if (_aggregator->streaming_preaggregation_mode() == TStreamingPreaggregationMode::FORCE_PREAGGREGATION) {
         return _push_chunk_by_force_preaggregation(chunk->num_rows());
@@ -82,8 +85,8 @@ Status AggregateDistinctStreamingSinkOperator::_push_chunk_by_auto(const size_t
     size_t remain_size = real_capacity - _aggregator->hash_set_variant().size();
     bool ht_needs_expansion = remain_size < chunk_size;
     if (!ht_needs_expansion ||
-        // TODO(hcf) first param
-        _aggregator->should_expand_preagg_hash_tables(0, chunk_size, _aggregator->mem_pool()->total_allocated_bytes(),
+        _aggregator->should_expand_preagg_hash_tables(_aggregator->num_input_rows(), chunk_size,
+                                                      _aggregator->mem_pool()->total_allocated_bytes(),
                                                       _aggregator->hash_set_variant().size())) {
         // hash table is not full or allow expand the hash table according reduction rate
         SCOPED_TIMER(_aggregator->agg_compute_timer());
@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <utility>
+
 #include "exec/pipeline/operator.h"
 #include "exec/vectorized/analytor.h"
 
@@ -40,17 +42,21 @@ private:
 
 class AnalyticSinkOperatorFactory final : public OperatorFactory {
 public:
-    AnalyticSinkOperatorFactory(int32_t id, int32_t plan_node_id, const TPlanNode& tnode, AnalytorPtr analytor)
-            : OperatorFactory(id, "analytic_sink", plan_node_id), _tnode(tnode), _analytor(analytor) {}
+    AnalyticSinkOperatorFactory(int32_t id, int32_t plan_node_id, const TPlanNode& tnode,
+                                AnalytorFactoryPtr analytor_factory)
+            : OperatorFactory(id, "analytic_sink", plan_node_id),
+              _tnode(tnode),
+              _analytor_factory(std::move(analytor_factory)) {}
 
     ~AnalyticSinkOperatorFactory() override = default;
 
     OperatorPtr create(int32_t degree_of_parallelism, int32_t driver_sequence) override {
-        return std::make_shared<AnalyticSinkOperator>(_id, _plan_node_id, _tnode, _analytor);
+        return std::make_shared<AnalyticSinkOperator>(_id, _plan_node_id, _tnode,
+                                                      _analytor_factory->get_or_create(driver_sequence));
     }
 
 private:
     TPlanNode _tnode;
-    AnalytorPtr _analytor = nullptr;
+    AnalytorFactoryPtr _analytor_factory = nullptr;
 };
 } // namespace starrocks::pipeline
@@ -32,16 +32,18 @@ private:
 
 class AnalyticSourceOperatorFactory final : public SourceOperatorFactory {
 public:
-    AnalyticSourceOperatorFactory(int32_t id, int32_t plan_node_id, AnalytorPtr analytor)
-            : SourceOperatorFactory(id, "analytic_source", plan_node_id), _analytor(std::move(analytor)) {}
+    AnalyticSourceOperatorFactory(int32_t id, int32_t plan_node_id, AnalytorFactoryPtr analytor_factory)
+            : SourceOperatorFactory(id, "analytic_source", plan_node_id),
+              _analytor_factory(std::move(analytor_factory)) {}
 
     ~AnalyticSourceOperatorFactory() override = default;
 
     OperatorPtr create(int32_t degree_of_parallelism, int32_t driver_sequence) override {
-        return std::make_shared<AnalyticSourceOperator>(_id, _plan_node_id, _analytor);
+        return std::make_shared<AnalyticSourceOperator>(_id, _plan_node_id,
+                                                        _analytor_factory->get_or_create(driver_sequence));
     }
 
 private:
-    AnalytorPtr _analytor = nullptr;
+    AnalytorFactoryPtr _analytor_factory = nullptr;
 };
 } // namespace starrocks::pipeline
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "column/vectorized_fwd.h"
+#include "exec/vectorized/range_join_predicate.h"
 
 namespace starrocks {
 namespace pipeline {
@@ -18,11 +19,19 @@ public:
 
     void set_right_complete() { _right_table_complete.store(true, std::memory_order_release); }
 
+    // If set, the build chunk is sorted by the right sink before completing the right table.
+    const vectorized::RangeJoinPredicate* range_predicate() const { return _range_predicate.get(); }
+
+    void set_range_predicate(std::unique_ptr<vectorized::RangeJoinPredicate> range_predicate) {
+        _range_predicate = std::move(range_predicate);
+    }
+
 private:
     // Used in operators to reference right table's datas.
     vectorized::ChunkPtr _build_chunk;
     // used in operators to mark that the right table has been constructed.
     std::atomic<bool> _right_table_complete;
+    std::unique_ptr<vectorized::RangeJoinPredicate> _range_predicate;
 };
 
 } // namespace pipeline
@@ -241,7 +241,39 @@ void CrossJoinLeftOperator::_copy_build_rows_with_index_base_build(vectorized::C
  * This algorithm is the same as that CrossJoinNode, 
  * and pull_chunk, need_input, push_chunk is splited from CrossJoinNode's get_next.
  */
+vectorized::ChunkPtr CrossJoinLeftOperator::_pull_range_joined_chunk() {
+    if (_probe_chunk->num_rows() == 0) {
+        _probe_chunk = nullptr;
+        return std::make_shared<vectorized::Chunk>();
+    }
+
+    vectorized::ChunkPtr chunk = nullptr;
+    _init_chunk(&chunk);
+    while (chunk->num_rows() < config::vector_chunk_size) {
+        size_t row_count = std::min<size_t>(config::vector_chunk_size - chunk->num_rows(),
+                                            _range_ends[_probe_chunk_index] - _range_build_rows_index);
+        if (row_count > 0) {
+            _copy_joined_rows_with_index_base_probe(chunk, row_count, _probe_chunk_index, _range_build_rows_index);
+            _range_build_rows_index += row_count;
+        }
+        if (_range_build_rows_index >= _range_ends[_probe_chunk_index]) {
+            if (++_probe_chunk_index == _probe_chunk->num_rows()) {
+                _probe_chunk = nullptr;
+                break;
+            }
+            _range_build_rows_index = _range_starts[_probe_chunk_index];
+        }
+    }
+
+    ExecNode::eval_conjuncts(_conjunct_ctxs, chunk.get());
+    return chunk;
+}
+
 StatusOr<vectorized::ChunkPtr> CrossJoinLeftOperator::pull_chunk(RuntimeState* state) {
+    if (_total_build_rows > 0 && _cross_join_context->range_predicate() != nullptr) {
+        return _pull_range_joined_chunk();
+    }
+
     vectorized::ChunkPtr chunk = nullptr;
     // If right table is empty, so we just return empty chunk.
     if (_total_build_rows > 0) {
@@ -391,6 +423,13 @@ Status CrossJoinLeftOperator::push_chunk(RuntimeState* state, const vectorized::
     _probe_chunk = chunk;
     _within_threshold_build_rows_index = 0;
     _probe_chunk_index = 0;
+
+    const vectorized::RangeJoinPredicate* range_predicate = _cross_join_context->range_predicate();
+    if (range_predicate != nullptr && _probe_chunk != nullptr && _probe_chunk->num_rows() > 0) {
+        range_predicate->compute_ranges(*_probe_chunk, *_cross_join_context->get_build_chunk(), &_range_starts,
+                                        &_range_ends);
+        _range_build_rows_index = _range_starts[0];
+    }
     return Status::OK();
 }
 
@@ -69,6 +69,9 @@ public:
     Status push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) override;
 
 private:
+    // Join each probe row only with its range of the build rows sorted by the range predicate.
+    vectorized::ChunkPtr _pull_range_joined_chunk();
+
     // previsou saved chunk.
     vectorized::ChunkPtr _pre_output_chunk = nullptr;
 
@@ -110,6 +113,12 @@ private:
 
     std::vector<uint32_t> _buf_selective;
 
+    // Used when the cross join context has a range predicate, the i-th row of _probe_chunk
+    // is only joined with the build rows in [_range_starts[i], _range_ends[i]).
+    std::vector<uint32_t> _range_starts;
+    std::vector<uint32_t> _range_ends;
+    size_t _range_build_rows_index = 0;
+
     const std::shared_ptr<CrossJoinContext>& _cross_join_context;
 };
 
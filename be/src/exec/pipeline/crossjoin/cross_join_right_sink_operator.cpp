@@ -48,6 +48,11 @@ Status CrossJoinRightSinkOperator::push_chunk(RuntimeState* state, const vectori
 
 void CrossJoinRightSinkOperator::finish(RuntimeState* state) {
     if (!_is_finished) {
+        const RangeJoinPredicate* range_predicate = _cross_join_context->range_predicate();
+        if (range_predicate != nullptr && _cross_join_context->get_build_chunk()->num_rows() > 0) {
+            _cross_join_context->set_build_chunk(
+                    range_predicate->sort_build_chunk(_cross_join_context->get_build_chunk()));
+        }
         // Used to notify cross_join_left_operator.
         _cross_join_context->set_right_complete();
         _is_finished = true;
@@ -0,0 +1,60 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/descriptor_tbl_cache.h"
+
+#include "common/config.h"
+#include "runtime/descriptors.h"
+#include "util/thrift_util.h"
+
+namespace starrocks::pipeline {
+
+DescriptorTblCache::DescriptorTblCache() = default;
+DescriptorTblCache::~DescriptorTblCache() = default;
+
+static bool is_cacheable(const TDescriptorTable& t_desc_tbl) {
+    for (const auto& t_table_desc : t_desc_tbl.tableDescriptors) {
+        if (t_table_desc.tableType == TTableType::HDFS_TABLE) {
+            return false;
+        }
+    }
+    return true;
+}
+
+StatusOr<CachedDescriptorTblPtr> DescriptorTblCache::get_or_create(const TDescriptorTable& t_desc_tbl) {
+    const auto capacity = static_cast<size_t>(std::max<int64_t>(config::pipeline_desc_tbl_cache_capacity, 0));
+    if (capacity == 0 || !is_cacheable(t_desc_tbl)) {
+        return CachedDescriptorTblPtr();
+    }
+
+    std::string key;
+    ThriftSerializer serializer(false, 4096);
+    RETURN_IF_ERROR(serializer.serialize(&t_desc_tbl, &key));
+    {
+        std::lock_guard lock(_lock);
+        auto iter = _entries.find(key);
+        if (iter != _entries.end()) {
+            _lru.splice(_lru.begin(), _lru, iter->second);
+            return iter->second->second;
+        }
+    }
+
+    // Build it without holding the lock, the one built by a concurrent fragment may be dropped.
+    auto cached = std::make_shared<CachedDescriptorTbl>();
+    RETURN_IF_ERROR(DescriptorTbl::create(&cached->pool, t_desc_tbl, &cached->desc_tbl));
+
+    std::lock_guard lock(_lock);
+    auto iter = _entries.find(key);
+    if (iter != _entries.end()) {
+        _lru.splice(_lru.begin(), _lru, iter->second);
+        return iter->second->second;
+    }
+    _lru.emplace_front(key, cached);
+    _entries.emplace(std::move(key), _lru.begin());
+    while (_lru.size() > capacity) {
+        _entries.erase(_lru.back().first);
+        _lru.pop_back();
+    }
+    return cached;
+}
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,53 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "common/object_pool.h"
+#include "common/statusor.h"
+#include "gen_cpp/Descriptors_types.h"
+#include "storage/olap_define.h"
+
+namespace starrocks {
+class DescriptorTbl;
+
+namespace pipeline {
+
+// A DescriptorTbl built once and shared by the fragments whose descriptor tables are equal.
+struct CachedDescriptorTbl {
+    ObjectPool pool;
+    DescriptorTbl* desc_tbl = nullptr;
+};
+using CachedDescriptorTblPtr = std::shared_ptr<CachedDescriptorTbl>;
+
+// The queries of the same shape, e.g. sent by dashboards repeatedly, carry the same descriptor table,
+// so their fragments share the DescriptorTbl cached here instead of rebuilding it from thrift.
+// The entries are keyed by the serialized thrift descriptor table and evicted in LRU order, an evicted
+// entry lives on until the fragments using it are released.
+//
+// The descriptors are immutable once built, except the hdfs table descriptors whose partition key exprs
+// are prepared by each fragment, so the descriptor tables containing hdfs tables are never cached.
+class DescriptorTblCache {
+    DECLARE_SINGLETON(DescriptorTblCache);
+
+public:
+    // Return the cached DescriptorTbl equal to t_desc_tbl, build and cache it if absent.
+    // Return nullptr if the cache is disabled by config::pipeline_desc_tbl_cache_capacity,
+    // or t_desc_tbl is not cacheable.
+    StatusOr<CachedDescriptorTblPtr> get_or_create(const TDescriptorTable& t_desc_tbl);
+
+private:
+    using LruList = std::list<std::pair<std::string, CachedDescriptorTblPtr>>;
+
+    std::mutex _lock;
+    LruList _lru;
+    std::unordered_map<std::string, LruList::iterator> _entries;
+};
+
+} // namespace pipeline
+} // namespace starrocks
@@ -79,7 +79,7 @@ Status DictDecodeOperatorFactory::prepare(RuntimeState* state) {
 
         vectorized::DefaultDecoderPtr decoder = std::make_unique<vectorized::DefaultDecoder>();
         // TODO : avoid copy dict
-        decoder->dict = dict_iter->second.second;
+        decoder->set_dict(dict_iter->second.second);
         _decoders.emplace_back(std::move(decoder));
     }
 
@@ -0,0 +1,174 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/driver_tracer.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <sstream>
+
+#include "common/config.h"
+#include "exec/pipeline/pipeline_driver.h"
+#include "util/bit_util.h"
+#include "util/uid_util.h"
+
+namespace starrocks::pipeline {
+
+DriverTraceBuffer::DriverTraceBuffer(const TUniqueId& query_id, size_t capacity)
+        : _query_id(query_id),
+          _mask(BitUtil::next_power_of_two(std::max<size_t>(capacity, 1)) - 1),
+          _slots(new Slot[_mask + 1]) {}
+
+void DriverTraceBuffer::add(const DriverTraceEvent& event) {
+    const uint64_t pos = _next.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = _slots[pos & _mask];
+    slot.seq.store(pos * 2 + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.event = event;
+    slot.seq.store(pos * 2 + 2, std::memory_order_release);
+}
+
+std::vector<DriverTraceEvent> DriverTraceBuffer::events() const {
+    const uint64_t end = _next.load(std::memory_order_acquire);
+    const uint64_t begin = end > _mask + 1 ? end - _mask - 1 : 0;
+    std::vector<DriverTraceEvent> events;
+    events.reserve(end - begin);
+    for (uint64_t pos = begin; pos < end; ++pos) {
+        const Slot& slot = _slots[pos & _mask];
+        if (slot.seq.load(std::memory_order_acquire) != pos * 2 + 2) {
+            continue;
+        }
+        DriverTraceEvent event = slot.event;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) != pos * 2 + 2) {
+            continue;
+        }
+        events.push_back(event);
+    }
+    return events;
+}
+
+static const char* event_name(const DriverTraceEvent& event) {
+    switch (event.type) {
+    case DriverTraceEventType::READY:
+        return "Ready";
+    case DriverTraceEventType::RUNNING:
+        return "Running";
+    case DriverTraceEventType::BLOCKED:
+        return "Blocked";
+    case DriverTraceEventType::FINISHED:
+        return "Finished";
+    }
+    return "Unknown";
+}
+
+std::string DriverTraceBuffer::to_chrome_trace() const {
+    auto all_events = events();
+    std::stable_sort(all_events.begin(), all_events.end(),
+                     [](const DriverTraceEvent& lhs, const DriverTraceEvent& rhs) {
+                         return lhs.timestamp_ns < rhs.timestamp_ns;
+                     });
+    // Chrome trace wants small integers as pid and tid.
+    std::map<int64_t, int> pids;
+    std::map<uint64_t, int> tids;
+    // The last event of every driver, which lasts until the next event of the driver.
+    std::map<uint64_t, DriverTraceEvent> last_events;
+
+    std::stringstream ss;
+    // The timestamps are in microseconds.
+    ss << std::fixed << std::setprecision(3);
+    bool first = true;
+    auto append_separator = [&ss, &first]() {
+        if (!first) {
+            ss << ",\n";
+        }
+        first = false;
+    };
+    auto append_interval = [&](const DriverTraceEvent& event, int64_t end_ns) {
+        append_separator();
+        ss << R"({"name":")" << event_name(event) << R"(","ph":"X","ts":)" << event.timestamp_ns / 1000.0
+           << R"(,"dur":)" << (end_ns - event.timestamp_ns) / 1000.0 << R"(,"pid":)"
+           << pids[event.fragment_instance_lo] << R"(,"tid":)" << tids[event.driver] << R"(,"args":{"state":")"
+           << ds_to_string(static_cast<DriverState>(event.state)) << R"("}})";
+    };
+
+    ss << R"({"displayTimeUnit":"ms","traceEvents":[)" << '\n';
+    for (const auto& event : all_events) {
+        if (pids.emplace(event.fragment_instance_lo, pids.size() + 1).second) {
+            append_separator();
+            TUniqueId instance_id;
+            instance_id.__set_hi(_query_id.hi);
+            instance_id.__set_lo(event.fragment_instance_lo);
+            ss << R"({"name":"process_name","ph":"M","pid":)" << pids[event.fragment_instance_lo]
+               << R"(,"args":{"name":"fragment instance )" << print_id(instance_id) << R"("}})";
+        }
+        if (tids.emplace(event.driver, tids.size() + 1).second) {
+            append_separator();
+            ss << R"({"name":"thread_name","ph":"M","pid":)" << pids[event.fragment_instance_lo] << R"(,"tid":)"
+               << tids[event.driver] << R"(,"args":{"name":"driver )" << event.driver_id << " (source node "
+               << event.source_node_id << ")\"}}";
+        }
+        auto it = last_events.find(event.driver);
+        if (it != last_events.end()) {
+            append_interval(it->second, event.timestamp_ns);
+        }
+        if (event.type == DriverTraceEventType::FINISHED) {
+            append_separator();
+            ss << R"({"name":"Finished","ph":"i","s":"t","ts":)" << event.timestamp_ns / 1000.0 << R"(,"pid":)"
+               << pids[event.fragment_instance_lo] << R"(,"tid":)" << tids[event.driver] << "}";
+            if (it != last_events.end()) {
+                last_events.erase(it);
+            }
+        } else {
+            last_events[event.driver] = event;
+        }
+    }
+    // The drivers still running last until the latest event.
+    if (!all_events.empty()) {
+        for (const auto& [driver, event] : last_events) {
+            append_interval(event, all_events.back().timestamp_ns);
+        }
+    }
+    ss << "\n]}";
+    return ss.str();
+}
+
+DriverTracer* DriverTracer::instance() {
+    static DriverTracer tracer;
+    return &tracer;
+}
+
+DriverTraceBufferPtr DriverTracer::start_query(const TUniqueId& query_id) {
+    const int64_t sample_rate = config::pipeline_driver_trace_sample_rate;
+    if (sample_rate <= 0 || _num_queries.fetch_add(1, std::memory_order_relaxed) % sample_rate != 0) {
+        return nullptr;
+    }
+    auto buffer = std::make_shared<DriverTraceBuffer>(query_id, config::pipeline_driver_trace_buffer_size);
+    std::lock_guard<std::mutex> l(_lock);
+    _buffers.push_front(buffer);
+    while (_buffers.size() > static_cast<size_t>(std::max<int64_t>(config::pipeline_driver_trace_max_queries, 1))) {
+        _buffers.pop_back();
+    }
+    return buffer;
+}
+
+DriverTraceBufferPtr DriverTracer::get(const std::string& query_id) {
+    std::lock_guard<std::mutex> l(_lock);
+    for (const auto& buffer : _buffers) {
+        if (print_id(buffer->query_id()) == query_id) {
+            return buffer;
+        }
+    }
+    return nullptr;
+}
+
+std::vector<std::string> DriverTracer::query_ids() {
+    std::lock_guard<std::mutex> l(_lock);
+    std::vector<std::string> ids;
+    for (const auto& buffer : _buffers) {
+        ids.emplace_back(print_id(buffer->query_id()));
+    }
+    return ids;
+}
+
+} // namespace starrocks::pipeline
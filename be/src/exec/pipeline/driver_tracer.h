@@ -0,0 +1,94 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "gen_cpp/Types_types.h"
+
+namespace starrocks::pipeline {
+
+enum class DriverTraceEventType : uint8_t {
+    // Put into the driver queue, waiting for a worker thread.
+    READY = 0,
+    // Taken by a worker thread to process.
+    RUNNING = 1,
+    // Handed over to PipelineDriverPoller, the cause is the state of the driver.
+    BLOCKED = 2,
+    FINISHED = 3,
+};
+
+struct DriverTraceEvent {
+    int64_t timestamp_ns;
+    // Identify the driver, as the drivers of different fragment instances may have the same driver id.
+    uint64_t driver;
+    int64_t fragment_instance_lo;
+    int32_t driver_id;
+    int32_t source_node_id;
+    DriverTraceEventType type;
+    // The DriverState of the driver when the event is recorded.
+    uint32_t state;
+};
+
+// The scheduling events of the drivers of one query in a fixed size ring buffer, the oldest events are
+// overwritten once it's full. Adding events is lock-free, so the worker threads and the poller never
+// block on each other.
+class DriverTraceBuffer {
+public:
+    DriverTraceBuffer(const TUniqueId& query_id, size_t capacity);
+
+    const TUniqueId& query_id() const { return _query_id; }
+
+    void add(const DriverTraceEvent& event);
+
+    // The events in the buffer in the order they were added, the events being overwritten are skipped.
+    std::vector<DriverTraceEvent> events() const;
+
+    // The events in Chrome trace event format, which can be loaded by chrome://tracing or Perfetto.
+    // Every fragment instance is shown as a process, and every driver as a thread with the intervals
+    // it's ready, running and blocked.
+    std::string to_chrome_trace() const;
+
+private:
+    // A seqlock per slot: `seq` is odd while the event is being written.
+    struct Slot {
+        std::atomic<uint64_t> seq{0};
+        DriverTraceEvent event;
+    };
+
+    const TUniqueId _query_id;
+    const size_t _mask;
+    std::unique_ptr<Slot[]> _slots;
+    std::atomic<uint64_t> _next{0};
+};
+
+using DriverTraceBufferPtr = std::shared_ptr<DriverTraceBuffer>;
+
+// Samples the queries whose drivers are traced by config::pipeline_driver_trace_sample_rate and keeps
+// the traces of the last config::pipeline_driver_trace_max_queries ones, so they can still be dumped
+// after the queries finish.
+class DriverTracer {
+public:
+    static DriverTracer* instance();
+
+    // Return a new trace buffer of the query if it's sampled, otherwise nullptr.
+    DriverTraceBufferPtr start_query(const TUniqueId& query_id);
+
+    // Return nullptr if the query isn't traced or its trace has been evicted, `query_id` is as print_id.
+    DriverTraceBufferPtr get(const std::string& query_id);
+
+    // The ids of the queries whose traces are kept, the latest first.
+    std::vector<std::string> query_ids();
+
+private:
+    std::atomic<uint64_t> _num_queries{0};
+    std::mutex _lock;
+    std::list<DriverTraceBufferPtr> _buffers;
+};
+
+} // namespace starrocks::pipeline
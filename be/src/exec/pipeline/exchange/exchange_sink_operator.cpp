@@ -420,9 +420,17 @@ Status ExchangeSinkOperator::serialize_chunk(const vectorized::Chunk* src, Chunk
         SCOPED_TIMER(_serialize_batch_timer);
         dst->set_compress_type(CompressionTypePB::NO_COMPRESSION);
         // We only serialize chunk meta for first chunk
+        bool encoded = config::exchange_encode_chunk;
         if (*is_first_chunk) {
-            uncompressed_size = src->serialize_with_meta(dst);
+            uncompressed_size = src->serialize_with_meta(dst, encoded);
             *is_first_chunk = false;
+        } else if (encoded) {
+            dst->clear_is_nulls();
+            dst->clear_is_consts();
+            dst->clear_slot_id_map();
+            dst->mutable_data()->resize(src->max_encoded_size());
+            uncompressed_size = src->serialize_encoded((uint8_t*)dst->mutable_data()->data());
+            dst->mutable_data()->resize(uncompressed_size);
         } else {
             dst->clear_is_nulls();
             dst->clear_is_consts();
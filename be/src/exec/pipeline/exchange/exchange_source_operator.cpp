@@ -18,6 +18,7 @@ Status ExchangeSourceOperator::prepare(RuntimeState* state) {
 }
 
 Status ExchangeSourceOperator::close(RuntimeState* state) {
+    _remove_observer();
     Operator::close(state);
     return Status::OK();
 }
@@ -35,9 +36,24 @@ void ExchangeSourceOperator::finish(RuntimeState* state) {
         return;
     }
     _is_finishing = true;
+    _remove_observer();
     return _stream_recvr->close();
 }
 
+bool ExchangeSourceOperator::add_observer(PipelineObserver* observer) {
+    _observer = observer;
+    _stream_recvr->add_observer(observer);
+    return true;
+}
+
+// the driver owning the observer may be destructed while brpc threads still reference the receiver.
+void ExchangeSourceOperator::_remove_observer() {
+    if (_observer != nullptr && _stream_recvr != nullptr) {
+        _stream_recvr->remove_observer(_observer);
+        _observer = nullptr;
+    }
+}
+
 StatusOr<vectorized::ChunkPtr> ExchangeSourceOperator::pull_chunk(RuntimeState* state) {
     std::unique_ptr<vectorized::Chunk> chunk = std::make_unique<vectorized::Chunk>();
     RETURN_IF_ERROR(_stream_recvr->get_chunk(&chunk));
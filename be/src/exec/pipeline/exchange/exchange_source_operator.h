@@ -29,11 +29,16 @@ public:
 
     StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
 
+    bool add_observer(PipelineObserver* observer) override;
+
 private:
+    void _remove_observer();
+
     int32_t _num_sender;
     const RowDescriptor& _row_desc;
     std::shared_ptr<DataStreamRecvr> _stream_recvr;
     std::atomic<bool> _is_finishing{false};
+    PipelineObserver* _observer = nullptr;
 };
 
 class ExchangeSourceOperatorFactory final : public SourceOperatorFactory {
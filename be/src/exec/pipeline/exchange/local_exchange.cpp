@@ -3,21 +3,63 @@
 #include "exec/pipeline/exchange/local_exchange.h"
 
 #include "column/chunk.h"
+#include "exprs/expr.h"
 #include "exprs/expr_context.h"
+#include "runtime/descriptors.h"
 
 namespace starrocks::pipeline {
 
 PartitionExchanger::PartitionExchanger(const std::shared_ptr<LocalExchangeMemoryManager>& memory_manager,
                                        LocalExchangeSourceOperatorFactory* source, bool is_shuffle,
-                                       const std::vector<ExprContext*>& partition_expr_ctxs)
+                                       const std::vector<ExprContext*>& partition_expr_ctxs, bool rebalance_skew)
         : LocalExchanger(memory_manager),
           _source(source),
           _is_shuffle(is_shuffle),
-          _partition_expr_ctxs(partition_expr_ctxs) {
+          _partition_expr_ctxs(partition_expr_ctxs),
+          _rebalance_skew(rebalance_skew) {
     _partitions_columns.resize(partition_expr_ctxs.size());
     _row_indexes.resize(config::vector_chunk_size);
 }
 
+Status PartitionExchanger::prepare(RuntimeState* state) {
+    // The partition exprs may be shared with the successor operators, preparing and opening the exprs is idempotent.
+    RowDescriptor row_desc;
+    RETURN_IF_ERROR(Expr::prepare(_partition_expr_ctxs, state, row_desc));
+    return Expr::open(_partition_expr_ctxs, state);
+}
+
+void PartitionExchanger::close(RuntimeState* state) {
+    Expr::close(_partition_expr_ctxs, state);
+}
+
+void PartitionExchanger::_mark_hot_channels(int num_channels) {
+    _hot_channels.assign(num_channels, 0);
+    _cold_channels.clear();
+
+    int64_t total_rows = 0;
+    for (int i = 0; i < num_channels; ++i) {
+        total_rows += _memory_manager->partition_row_count(i);
+    }
+    if (total_rows <= 0) {
+        return;
+    }
+
+    const double hot_threshold = total_rows * config::pipeline_local_shuffle_skew_ratio;
+    bool has_hot_channel = false;
+    for (int i = 0; i < num_channels; ++i) {
+        int64_t num_rows = static_cast<int64_t>(_memory_manager->partition_row_count(i)) * num_channels;
+        if (num_rows > hot_threshold) {
+            _hot_channels[i] = 1;
+            has_hot_channel = true;
+        } else if (num_rows < total_rows) {
+            _cold_channels.emplace_back(i);
+        }
+    }
+    if (has_hot_channel && _cold_channels.empty()) {
+        _hot_channels.assign(num_channels, 0);
+    }
+}
+
 Status PartitionExchanger::accept(const vectorized::ChunkPtr& chunk) {
     uint16_t num_rows = chunk->num_rows();
     if (num_rows == 0) {
@@ -51,10 +93,24 @@ Status PartitionExchanger::accept(const vectorized::ChunkPtr& chunk) {
 
         // compute row indexes for each channel
         _channel_row_idx_start_points.assign(num_channels + 1, 0);
-        for (uint16_t i = 0; i < num_rows; ++i) {
-            uint16_t channel_index = _hash_values[i] % num_channels;
-            _channel_row_idx_start_points[channel_index]++;
-            _hash_values[i] = channel_index;
+        if (_rebalance_skew) {
+            _mark_hot_channels(num_channels);
+        }
+        if (!_cold_channels.empty()) {
+            for (uint16_t i = 0; i < num_rows; ++i) {
+                uint16_t channel_index = _hash_values[i] % num_channels;
+                if (_hot_channels[channel_index]) {
+                    channel_index = _cold_channels[_next_cold_channel++ % _cold_channels.size()];
+                }
+                _channel_row_idx_start_points[channel_index]++;
+                _hash_values[i] = channel_index;
+            }
+        } else {
+            for (uint16_t i = 0; i < num_rows; ++i) {
+                uint16_t channel_index = _hash_values[i] % num_channels;
+                _channel_row_idx_start_points[channel_index]++;
+                _hash_values[i] = channel_index;
+            }
         }
         // NOTE:
         // we make the last item equal with number of rows of this chunk
@@ -80,6 +136,7 @@ Status PartitionExchanger::accept(const vectorized::ChunkPtr& chunk) {
         //     // dest bucket is no used, continue
         //     continue;
         // }
+        _memory_manager->update_partition_row_count(i, size);
         RETURN_IF_ERROR(_source->get_sources()[i]->add_chunk(chunk.get(), _row_indexes.data(), from, size));
     }
     return Status::OK();
@@ -19,6 +19,10 @@ public:
     LocalExchanger(std::shared_ptr<LocalExchangeMemoryManager> memory_manager)
             : _memory_manager(std::move(memory_manager)) {}
 
+    virtual Status prepare(RuntimeState* state) { return Status::OK(); }
+
+    virtual void close(RuntimeState* state) {}
+
     virtual Status accept(const vectorized::ChunkPtr& chunk) = 0;
 
     virtual void finish(RuntimeState* state) = 0;
@@ -35,11 +39,20 @@ protected:
 };
 
 // Exchange the local data for shuffle
+// If |rebalance_skew| is true, the rows of the hot partitions, whose queued rows are much more than the
+// average, are sent to the partitions with less queued rows than the average in round-robin manner.
+// It is only used when the rows with the same partition key are NOT required to be processed by the
+// same driver, e.g. the first phase of aggregate, whose output rows are merged by the second phase.
+// The queued rows of each partition are tracked by LocalExchangeMemoryManager.
 class PartitionExchanger final : public LocalExchanger {
 public:
     PartitionExchanger(const std::shared_ptr<LocalExchangeMemoryManager>& memory_manager,
                        LocalExchangeSourceOperatorFactory* source, bool is_shuffle,
-                       const std::vector<ExprContext*>& _partition_expr_ctxs);
+                       const std::vector<ExprContext*>& _partition_expr_ctxs, bool rebalance_skew = false);
+
+    Status prepare(RuntimeState* state) override;
+
+    void close(RuntimeState* state) override;
 
     Status accept(const vectorized::ChunkPtr& chunk) override;
 
@@ -52,9 +65,17 @@ public:
     }
 
 private:
+    // mark the partitions whose queued rows exceed config::pipeline_local_shuffle_skew_ratio of the average.
+    void _mark_hot_channels(int num_channels);
+
     LocalExchangeSourceOperatorFactory* _source;
     bool _is_shuffle = true;
     std::vector<ExprContext*> _partition_expr_ctxs; // compute per-row partition values
+    const bool _rebalance_skew;
+    // only used when _rebalance_skew is true, recomputed for each input chunk.
+    std::vector<uint8_t> _hot_channels;
+    std::vector<uint16_t> _cold_channels;
+    size_t _next_cold_channel = 0;
 
     vectorized::Columns _partitions_columns;
     std::vector<uint32_t> _hash_values;
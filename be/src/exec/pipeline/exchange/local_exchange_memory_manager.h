@@ -3,6 +3,7 @@
 #pragma once
 
 #include <atomic>
+#include <memory>
 
 namespace starrocks::pipeline {
 // Manage the memory usage for local exchange
@@ -10,12 +11,35 @@ namespace starrocks::pipeline {
 // Use row number because it's hard to control very big bitmap column memory usage
 class LocalExchangeMemoryManager {
 public:
-    LocalExchangeMemoryManager(int32_t max_row_count) : _max_row_count(max_row_count) {}
+    // |num_partitions| is the number of partitions whose queued rows are tracked separately,
+    // it is only used by the local shuffle which rebalances the hot partitions.
+    LocalExchangeMemoryManager(int32_t max_row_count, size_t num_partitions = 0)
+            : _max_row_count(max_row_count),
+              _num_partitions(num_partitions),
+              _partition_row_counts(new std::atomic<int32_t>[num_partitions]) {
+        for (size_t i = 0; i < num_partitions; i++) {
+            _partition_row_counts[i] = 0;
+        }
+    }
     void update_row_count(int32_t row_count) { _row_count += row_count; }
     bool is_full() const { return _row_count >= _max_row_count; }
 
+    // the partitions beyond num_partitions are not tracked.
+    void update_partition_row_count(size_t partition, int32_t row_count) {
+        if (partition < _num_partitions) {
+            _partition_row_counts[partition] += row_count;
+        }
+    }
+    int32_t partition_row_count(size_t partition) const {
+        return partition < _num_partitions ? _partition_row_counts[partition].load() : 0;
+    }
+    size_t num_partitions() const { return _num_partitions; }
+
 private:
     int32_t _max_row_count;
     std::atomic<int32_t> _row_count{0};
+    const size_t _num_partitions;
+    // the number of rows queued in the local exchange source operator of each partition.
+    std::unique_ptr<std::atomic<int32_t>[]> _partition_row_counts;
 };
 } // namespace starrocks::pipeline
\ No newline at end of file
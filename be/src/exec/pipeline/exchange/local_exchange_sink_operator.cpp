@@ -32,4 +32,14 @@ Status LocalExchangeSinkOperator::push_chunk(RuntimeState* state, const vectoriz
     return Status::OK();
 }
 
+Status LocalExchangeSinkOperatorFactory::prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(OperatorFactory::prepare(state));
+    return _exchanger->prepare(state);
+}
+
+void LocalExchangeSinkOperatorFactory::close(RuntimeState* state) {
+    _exchanger->close(state);
+    OperatorFactory::close(state);
+}
+
 } // namespace starrocks::pipeline
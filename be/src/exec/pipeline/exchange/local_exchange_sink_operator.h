@@ -45,6 +45,10 @@ public:
         return std::make_shared<LocalExchangeSinkOperator>(_id, _exchanger);
     }
 
+    Status prepare(RuntimeState* state) override;
+
+    void close(RuntimeState* state) override;
+
 private:
     std::shared_ptr<LocalExchanger> _exchanger;
 };
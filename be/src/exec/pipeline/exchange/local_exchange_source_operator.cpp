@@ -8,34 +8,44 @@
 namespace starrocks::pipeline {
 
 Status LocalExchangeSourceOperator::add_chunk(vectorized::ChunkPtr chunk) {
-    std::lock_guard<std::mutex> l(_chunk_lock);
-    if (_full_chunk == nullptr) {
-        _full_chunk = std::move(chunk);
-    } else {
-        vectorized::Columns& dest_columns = _full_chunk->columns();
-        vectorized::Columns& src_columns = chunk->columns();
-        size_t num_rows = chunk->num_rows();
-        for (size_t i = 0; i < dest_columns.size(); i++) {
-            dest_columns[i]->append(*src_columns[i], 0, num_rows);
+    {
+        std::lock_guard<std::mutex> l(_chunk_lock);
+        if (_full_chunk == nullptr) {
+            _full_chunk = std::move(chunk);
+        } else {
+            vectorized::Columns& dest_columns = _full_chunk->columns();
+            vectorized::Columns& src_columns = chunk->columns();
+            size_t num_rows = chunk->num_rows();
+            for (size_t i = 0; i < dest_columns.size(); i++) {
+                dest_columns[i]->append(*src_columns[i], 0, num_rows);
+            }
         }
     }
+    _observable.notify_observers();
     return Status::OK();
 }
 
 Status LocalExchangeSourceOperator::add_chunk(vectorized::Chunk* chunk, const uint32_t* indexes, uint32_t from,
                                               uint32_t size) {
-    std::lock_guard<std::mutex> l(_chunk_lock);
+    std::unique_lock<std::mutex> l(_chunk_lock);
 
     if (_partial_chunk == nullptr) {
         _partial_chunk = chunk->clone_empty_with_slot();
     }
 
+    bool has_full_chunk = false;
     if (_partial_chunk->num_rows() + size > config::vector_chunk_size) {
         _full_chunk = std::move(_partial_chunk);
         _partial_chunk = chunk->clone_empty_with_slot();
+        has_full_chunk = true;
     }
 
     _partial_chunk->append_selective(*chunk, indexes, from, size);
+    if (has_full_chunk) {
+        // notify observers without holding _chunk_lock.
+        l.unlock();
+        _observable.notify_observers();
+    }
     return Status::OK();
 }
 
@@ -52,6 +62,7 @@ bool LocalExchangeSourceOperator::has_output() const {
 StatusOr<vectorized::ChunkPtr> LocalExchangeSourceOperator::pull_chunk(RuntimeState* state) {
     std::lock_guard<std::mutex> l(_chunk_lock);
     _memory_manager->update_row_count(-_full_chunk->num_rows());
+    _memory_manager->update_partition_row_count(_partition, -_full_chunk->num_rows());
     return std::move(_full_chunk);
 }
 
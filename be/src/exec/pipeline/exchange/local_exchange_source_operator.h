@@ -6,13 +6,15 @@
 #include <utility>
 
 #include "exec/pipeline/exchange/local_exchange_memory_manager.h"
+#include "exec/pipeline/pipeline_observer.h"
 #include "exec/pipeline/source_operator.h"
 
 namespace starrocks::pipeline {
 class LocalExchangeSourceOperator final : public SourceOperator {
 public:
-    LocalExchangeSourceOperator(int32_t id, const std::shared_ptr<LocalExchangeMemoryManager>& memory_manager)
-            : SourceOperator(id, "local_exchange_source", -1), _memory_manager(memory_manager) {}
+    LocalExchangeSourceOperator(int32_t id, const std::shared_ptr<LocalExchangeMemoryManager>& memory_manager,
+                                size_t partition = 0)
+            : SourceOperator(id, "local_exchange_source", -1), _memory_manager(memory_manager), _partition(partition) {}
 
     Status add_chunk(vectorized::ChunkPtr chunk);
 
@@ -23,16 +25,24 @@ public:
     bool is_finished() const override;
 
     void finish(RuntimeState* state) override {
-        std::lock_guard<std::mutex> l(_chunk_lock);
+        {
+            std::lock_guard<std::mutex> l(_chunk_lock);
 
-        if (_partial_chunk != nullptr) {
-            _full_chunk = std::move(_partial_chunk);
+            if (_partial_chunk != nullptr) {
+                _full_chunk = std::move(_partial_chunk);
+            }
+            _is_finished = true;
         }
-        _is_finished = true;
+        _observable.notify_observers();
     }
 
     StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
 
+    bool add_observer(PipelineObserver* observer) override {
+        _observable.add_observer(observer);
+        return true;
+    }
+
 private:
     std::atomic<bool> _is_finished{false};
     vectorized::ChunkPtr _full_chunk = nullptr;
@@ -40,6 +50,9 @@ private:
     // TODO(KKS): make it lock free
     mutable std::mutex _chunk_lock;
     const std::shared_ptr<LocalExchangeMemoryManager>& _memory_manager;
+    // the index of this source in LocalExchangeSourceOperatorFactory::get_sources().
+    const size_t _partition;
+    PipelineObservable _observable;
 };
 
 class LocalExchangeSourceOperatorFactory final : public SourceOperatorFactory {
@@ -51,7 +64,7 @@ public:
 
     OperatorPtr create(int32_t degree_of_parallelism, int32_t driver_sequence) override {
         std::shared_ptr<LocalExchangeSourceOperator> source =
-                std::make_shared<LocalExchangeSourceOperator>(_id, _memory_manager);
+                std::make_shared<LocalExchangeSourceOperator>(_id, _memory_manager, _sources.size());
         _sources.emplace_back(source.get());
         return source;
     }
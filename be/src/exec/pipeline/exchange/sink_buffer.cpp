@@ -0,0 +1,179 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/exchange/sink_buffer.h"
+
+#include <limits>
+
+#include "common/config.h"
+
+namespace starrocks::pipeline {
+
+SinkBuffer::SinkBuffer(size_t channel_number, size_t num_sinkers)
+        : _destinations(channel_number), _num_sinkers_per_channel(channel_number, num_sinkers) {}
+
+void SinkBuffer::add_request(const TransmitChunkInfo& request) {
+    bool should_send = false;
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        if (_is_cancelled) {
+            return;
+        }
+
+        TransmitChunkInfo info = request;
+        if (info.params.eos()) {
+            // Only the last eos is sent to ExchangeSourceOperator. it must be guaranteed that
+            // eos is the last packet to send to finish the input stream of the corresponding of
+            // ExchangeSourceOperator and eos is sent exactly-once.
+            if (--_num_sinkers_per_channel[info.channel_id] > 0) {
+                if (info.params.chunks_size() == 0) {
+                    return;
+                }
+                info.params.set_eos(false);
+            }
+        }
+
+        _num_buffered_bytes += _request_bytes(info.params);
+        _num_unfinished_requests++;
+        _destinations[info.channel_id].pending_requests.emplace_back(std::move(info));
+        should_send = _pick_rpc(request.channel_id);
+    }
+    if (should_send) {
+        _send_rpc(request.channel_id);
+    }
+}
+
+bool SinkBuffer::is_full() const {
+    return _num_buffered_bytes >= config::pipeline_sink_buffer_max_bytes;
+}
+
+size_t SinkBuffer::_request_bytes(const PTransmitChunkParams& params) {
+    size_t bytes = 0;
+    for (const auto& chunk : params.chunks()) {
+        bytes += chunk.data().size();
+    }
+    return bytes;
+}
+
+bool SinkBuffer::_pick_rpc(size_t channel_id) {
+    auto& dest = _destinations[channel_id];
+    if (dest.has_in_flight_rpc || dest.pending_requests.empty()) {
+        return false;
+    }
+    const bool use_credit = config::pipeline_enable_exchange_credit_flow_control;
+    const auto& front = dest.pending_requests.front();
+    const int64_t front_bytes = _request_bytes(front.params);
+    if (use_credit && front_bytes > dest.credit && !front.params.eos()) {
+        dest.in_flight_request.channel_id = front.channel_id;
+        dest.in_flight_request.brpc_stub = front.brpc_stub;
+        auto& params = dest.in_flight_request.params;
+        params.Clear();
+        *params.mutable_finst_id() = front.params.finst_id();
+        params.set_node_id(front.params.node_id());
+        params.set_sender_id(front.params.sender_id());
+        params.set_be_number(front.params.be_number());
+        params.set_eos(false);
+        params.set_use_credit(true);
+        params.set_min_credit_bytes(front_bytes);
+        dest.in_flight_bytes = 0;
+        dest.is_credit_request = true;
+        dest.has_in_flight_rpc = true;
+        _num_unfinished_requests++;
+        return true;
+    }
+
+    dest.in_flight_request = std::move(dest.pending_requests.front());
+    dest.pending_requests.pop_front();
+    auto& params = dest.in_flight_request.params;
+    dest.in_flight_bytes = _request_bytes(params);
+
+    // Coalesce the following small requests, the chunks are kept in the order of requests.
+    while (!dest.pending_requests.empty() && !params.eos()) {
+        auto& next = dest.pending_requests.front().params;
+        size_t next_bytes = _request_bytes(next);
+        if (dest.in_flight_bytes + next_bytes > config::pipeline_sink_max_coalesced_bytes) {
+            break;
+        }
+        if (use_credit && static_cast<int64_t>(dest.in_flight_bytes + next_bytes) > dest.credit) {
+            break;
+        }
+        for (int i = 0; i < next.chunks_size(); ++i) {
+            params.add_chunks()->Swap(next.mutable_chunks(i));
+        }
+        params.set_eos(next.eos());
+        dest.in_flight_bytes += next_bytes;
+        dest.pending_requests.pop_front();
+        _num_unfinished_requests--;
+    }
+
+    if (use_credit) {
+        // The eos request is sent even without credit, it's the last request of the destination.
+        dest.credit -= static_cast<int64_t>(dest.in_flight_bytes);
+    }
+    params.set_sequence(_request_seq++);
+    params.set_use_credit(use_credit);
+    dest.has_in_flight_rpc = true;
+    return true;
+}
+
+void SinkBuffer::_send_rpc(size_t channel_id) {
+    auto& request = _destinations[channel_id].in_flight_request;
+    const bool is_credit_request = _destinations[channel_id].is_credit_request;
+    auto* closure = new CallBackClosure<PTransmitChunkResult>();
+    closure->ref();
+    // The callback holds the buffer, which may be released by the fragment before the rpc is done.
+    auto self = shared_from_this();
+    closure->addFailedHandler([self, channel_id, closure, is_credit_request]() noexcept {
+        if (is_credit_request && closure->cntl.ErrorCode() == brpc::ERPCTIMEDOUT) {
+            // The receiver has no free buffer yet, ask again.
+            self->_on_rpc_done(channel_id, Status::OK(), 0);
+            return;
+        }
+        self->_on_rpc_done(channel_id, Status::InternalError("transmit chunk rpc failed"), -1);
+    });
+    closure->addSuccessHandler([self, channel_id](const PTransmitChunkResult& result) noexcept {
+        self->_on_rpc_done(channel_id, Status(result.status()), result.has_credit_bytes() ? result.credit_bytes() : -1);
+    });
+    closure->cntl.set_timeout_ms(is_credit_request ? kCreditRequestTimeoutMs : 500);
+    request.brpc_stub->transmit_chunk(&closure->cntl, &request.params, &closure->result, closure);
+}
+
+void SinkBuffer::_on_rpc_done(size_t channel_id, const Status& status, int64_t credit) {
+    bool should_send = false;
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        auto& dest = _destinations[channel_id];
+        dest.has_in_flight_rpc = false;
+        dest.is_credit_request = false;
+        // The grant isn't an increment, since there is at most one rpc in flight per destination.
+        dest.credit = credit < 0 ? std::numeric_limits<int64_t>::max() : credit;
+        _num_buffered_bytes -= dest.in_flight_bytes;
+        dest.in_flight_bytes = 0;
+        dest.in_flight_request.params.Clear();
+        _num_unfinished_requests--;
+
+        if (!status.ok()) {
+            LOG(WARNING) << "transmit chunk rpc failed: " << status.to_string();
+            _is_cancelled = true;
+        }
+        if (_is_cancelled) {
+            _clear_pending_requests();
+        } else {
+            should_send = _pick_rpc(channel_id);
+        }
+    }
+    if (should_send) {
+        _send_rpc(channel_id);
+    }
+}
+
+void SinkBuffer::_clear_pending_requests() {
+    for (auto& dest : _destinations) {
+        for (const auto& request : dest.pending_requests) {
+            _num_buffered_bytes -= _request_bytes(request.params);
+            _num_unfinished_requests--;
+        }
+        dest.pending_requests.clear();
+    }
+}
+
+} // namespace starrocks::pipeline
@@ -2,9 +2,14 @@
 
 #pragma once
 
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 #include "column/chunk.h"
 #include "gen_cpp/BackendService.h"
-#include "util/blocking_queue.hpp"
 #include "util/brpc_stub_cache.h"
 #include "util/callback_closure.h"
 
@@ -16,121 +21,74 @@ struct TransmitChunkInfo {
     doris::PBackendService_Stub* brpc_stub;
 };
 
-class SinkBuffer {
+// SinkBuffer sends the requests of all the ExchangeSinkOperators of one fragment instance without any
+// dedicated thread. Every destination has at most one rpc in flight, so the requests of one destination
+// arrive in order and the eos request is always the last one. The next rpc of a destination is issued by
+// the callback of the previous one, and the requests queued meanwhile are coalesced into one rpc up to
+// config::pipeline_sink_max_coalesced_bytes. The bytes queued and in flight are capped by
+// config::pipeline_sink_buffer_max_bytes, the sink operators stop accepting input once it is full.
+//
+// With config::pipeline_enable_exchange_credit_flow_control, the chunks are only sent to a destination
+// within its credit, which is granted by the response of every rpc. The bytes sent are charged against the
+// credit and an rpc never coalesces more than the credit. If the next request doesn't fit into the credit,
+// a request without chunks asks the destination for a credit covering it instead, which is answered as soon
+// as the receiver has enough free buffer, or with no credit after kCreditRequestTimeoutMs and then asked
+// again. The first rpc of a destination asks for credit too.
+//
+// The callbacks of the rpcs hold a reference of the buffer, so the buffer must be created by make_shared.
+class SinkBuffer : public std::enable_shared_from_this<SinkBuffer> {
 public:
-    SinkBuffer(size_t channel_number, size_t num_sinkers)
-            : _closure_size(channel_number), _num_sinkers_per_channel(channel_number, num_sinkers) {
-        for (size_t i = 0; i < channel_number; ++i) {
-            auto _chunk_closure = new CallBackClosure<PTransmitChunkResult>();
-            _chunk_closure->ref();
-            _chunk_closure->addFailedHandler([this]() noexcept {
-                _in_flight_rpc_num--;
-                _is_cancelled = true;
-                LOG(WARNING) << " transmit chunk rpc failed, ";
-            });
-
-            _chunk_closure->addSuccessHandler([this](const PTransmitChunkResult& result) noexcept {
-                _in_flight_rpc_num--;
-                Status status(result.status());
-                if (!status.ok()) {
-                    _is_cancelled = true;
-                    LOG(WARNING) << " transmit chunk rpc failed, ";
-                }
-            });
-            _closures.push_back(_chunk_closure);
-        }
-        try {
-            _thread = std::thread{&SinkBuffer::process, this};
-        } catch (const std::exception& exp) {
-            LOG(FATAL) << "[ExchangeSinkOperator] create thread: " << exp.what();
-        } catch (...) {
-            LOG(FATAL) << "[ExchangeSinkOperator] create thread: unknown";
-        }
-    }
-
-    ~SinkBuffer() {
-        _pending_chunks.shutdown();
-        _thread.join();
-        for (auto* closure : _closures) {
-            if (closure->unref()) {
-                delete closure;
-            }
-        }
-    }
-
-    void add_request(const TransmitChunkInfo& request) {
-        _in_flight_rpc_num++;
-        _pending_chunks.put(request);
-    }
-
-    void process() {
-        try {
-            while (true) {
-                // If the head closure has flight rpc, means all closures are busy
-                if (_closures.front()->has_in_flight_rpc()) {
-                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
-                    continue;
-                }
-
-                TransmitChunkInfo info;
-                if (!_pending_chunks.blocking_get(&info)) {
-                    break;
-                }
-                _send_rpc(info);
-
-                // The original design is bad, we must release_finst_id here!
-                info.params.release_finst_id();
-            }
-        } catch (const std::exception& exp) {
-            LOG(FATAL) << "[ExchangeSinkOperator] sink_buffer::process: " << exp.what();
-        } catch (...) {
-            LOG(FATAL) << "[ExchangeSinkOperator] sink_buffer::process: UNKNOWN";
-        }
-    }
-
-    bool is_full() const { return _in_flight_rpc_num >= _closure_size; }
-
-    bool is_finished() const { return _in_flight_rpc_num == 0 || _is_cancelled; }
+    SinkBuffer(size_t channel_number, size_t num_sinkers);
+
+    ~SinkBuffer() = default;
+
+    void add_request(const TransmitChunkInfo& request);
+
+    bool is_full() const;
+
+    bool is_finished() const { return _num_unfinished_requests == 0 || _is_cancelled; }
 
     bool is_cancelled() const { return _is_cancelled; }
 
 private:
-    void _send_rpc(TransmitChunkInfo& request) {
-        if (request.params.eos()) {
-            // Only the last eos is sent to ExchangeSourceOperator. it must be guaranteed that
-            // eos is the last packet to send to finish the input stream of the corresponding of
-            // ExchangeSourceOperator and eos is sent exactly-once.
-            if (--_num_sinkers_per_channel[request.channel_id] > 0) {
-                if (request.params.chunks_size() == 0) {
-                    _in_flight_rpc_num--;
-                    return;
-                } else {
-                    request.params.set_eos(false);
-                }
-            }
-        }
-        request.params.set_sequence(_request_seq);
-        auto* closure = _closures.front();
-        DCHECK(!closure->has_in_flight_rpc());
-        // Move the closure has flight rpc to tail
-        _closures.pop_front();
-        _closures.push_back(closure);
-        closure->ref();
-        closure->cntl.Reset();
-        closure->cntl.set_timeout_ms(500);
-        request.brpc_stub->transmit_chunk(&closure->cntl, &request.params, &closure->result, closure);
-        _request_seq++;
-    }
-
-    // To avoid lock
-    const int32_t _closure_size;
-    vector<size_t> _num_sinkers_per_channel;
+    struct Destination {
+        std::deque<TransmitChunkInfo> pending_requests;
+        // the request of the rpc in flight, kept alive until the rpc is done.
+        TransmitChunkInfo in_flight_request;
+        size_t in_flight_bytes = 0;
+        bool has_in_flight_rpc = false;
+        bool is_credit_request = false;
+        // the bytes which may be sent until the next response.
+        int64_t credit = 0;
+    };
+
+    static constexpr int kCreditRequestTimeoutMs = 1000;
+
+    static size_t _request_bytes(const PTransmitChunkParams& params);
+
+    // Coalesce the pending requests of |channel_id| into the in flight request, must be called with _mutex held.
+    // Return false if there is nothing to send or an rpc of the destination is already in flight.
+    bool _pick_rpc(size_t channel_id);
+
+    // Send the in flight request of |channel_id| without holding _mutex.
+    void _send_rpc(size_t channel_id);
+
+    // |credit| is negative if the destination doesn't grant credit.
+    void _on_rpc_done(size_t channel_id, const Status& status, int64_t credit);
+
+    // drop all the pending requests after the buffer is cancelled, must be called with _mutex held.
+    void _clear_pending_requests();
+
+    mutable std::mutex _mutex;
+    std::vector<Destination> _destinations;
+    std::vector<size_t> _num_sinkers_per_channel;
     int64_t _request_seq = 0;
-    std::atomic<int32_t> _in_flight_rpc_num = 0;
+
+    // the requests queued and the rpcs in flight.
+    std::atomic<int32_t> _num_unfinished_requests = 0;
+    // the bytes of the chunks queued and in flight.
+    std::atomic<int64_t> _num_buffered_bytes = 0;
     std::atomic<bool> _is_cancelled{false};
-    std::deque<CallBackClosure<PTransmitChunkResult>*> _closures;
-    std::thread _thread;
-    UnboundedBlockingQueue<TransmitChunkInfo> _pending_chunks;
 };
 
 } // namespace starrocks::pipeline
@@ -93,6 +93,10 @@ TReportExecStatusParams ExecStateReporter::create_report_exec_status_params(Frag
         // Send new errors to coordinator
         runtime_state->get_unreported_errors(&(params.error_log));
         params.__isset.error_log = (params.error_log.size() > 0);
+
+        if (done && config::pipeline_report_plan_node_runtime_stats) {
+            params.__set_plan_node_runtime_stats(fragment_ctx->plan_node_runtime_stats());
+        }
     }
 
     if (exec_env->master_info()->__isset.backend_id) {
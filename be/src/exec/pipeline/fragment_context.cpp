@@ -3,6 +3,59 @@
 #include "exec/pipeline/fragment_context.h"
 namespace starrocks::pipeline {
 
+static int64_t sum_counters(RuntimeProfile* profile, const std::string& name) {
+    std::vector<RuntimeProfile::Counter*> counters;
+    profile->get_counters(name, &counters);
+    int64_t sum = 0;
+    for (auto* counter : counters) {
+        sum += counter->value();
+    }
+    return sum;
+}
+
+std::vector<TPlanNodeRuntimeStats> FragmentContext::plan_node_runtime_stats() {
+    std::map<int32_t, TPlanNodeRuntimeStats> stats;
+    {
+        std::lock_guard<std::mutex> l(_node_output_rows_lock);
+        for (const auto& [plan_node_id, rows] : _node_output_rows) {
+            stats[plan_node_id].__set_output_rows(rows);
+        }
+    }
+    for (const auto& driver : _drivers) {
+        for (const auto& op : driver->operators()) {
+            if (op->get_plan_node_id() < 0) {
+                continue;
+            }
+            auto* profile = op->get_runtime_profile();
+            auto& node_stats = stats[op->get_plan_node_id()];
+            int64_t raw_rows_read = sum_counters(profile, "RawRowsRead");
+            if (raw_rows_read > 0) {
+                node_stats.__set_raw_rows_read(node_stats.raw_rows_read + raw_rows_read);
+                node_stats.__set_rows_read(node_stats.rows_read + sum_counters(profile, "RowsRead"));
+                int64_t index_filtered_rows = 0;
+                for (const auto& name : {"ShortKeyFilterRows", "ZoneMapIndexFilterRows", "BloomFilterFilterRows",
+                                         "BitmapIndexFilterRows"}) {
+                    index_filtered_rows += sum_counters(profile, name);
+                }
+                node_stats.__set_index_filtered_rows(node_stats.index_filtered_rows + index_filtered_rows);
+            }
+            int64_t rf_input_rows = sum_counters(profile, "JoinRuntimeFilterInputRows");
+            if (rf_input_rows > 0) {
+                node_stats.__set_runtime_filter_input_rows(node_stats.runtime_filter_input_rows + rf_input_rows);
+                node_stats.__set_runtime_filter_output_rows(node_stats.runtime_filter_output_rows +
+                                                            sum_counters(profile, "JoinRuntimeFilterOutputRows"));
+            }
+        }
+    }
+    std::vector<TPlanNodeRuntimeStats> result;
+    result.reserve(stats.size());
+    for (auto& [plan_node_id, node_stats] : stats) {
+        node_stats.__set_plan_node_id(plan_node_id);
+        result.emplace_back(std::move(node_stats));
+    }
+    return result;
+}
+
 FragmentContext* FragmentContextManager::get_or_register(const TUniqueId& fragment_id) {
     std::lock_guard<std::mutex> lock(_lock);
     auto it = _fragment_contexts.find(fragment_id);
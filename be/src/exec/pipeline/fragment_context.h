@@ -2,9 +2,12 @@
 
 #pragma once
 
+#include <map>
+#include <mutex>
 #include <unordered_map>
 
 #include "exec/exec_node.h"
+#include "exec/pipeline/descriptor_tbl_cache.h"
 #include "exec/pipeline/morsel.h"
 #include "exec/pipeline/pipeline.h"
 #include "exec/pipeline/pipeline_driver.h"
@@ -45,6 +48,7 @@ public:
     void set_runtime_state(std::shared_ptr<RuntimeState>&& runtime_state) { _runtime_state = std::move(runtime_state); }
     ExecNode* plan() const { return _plan; }
     void set_plan(ExecNode* plan) { _plan = plan; }
+    void set_cached_desc_tbl(CachedDescriptorTblPtr cached_desc_tbl) { _cached_desc_tbl = std::move(cached_desc_tbl); }
     Pipelines& pipelines() { return _pipelines; }
     void set_pipelines(Pipelines&& pipelines) { _pipelines = std::move(pipelines); }
     Drivers& drivers() { return _drivers; }
@@ -99,6 +103,15 @@ public:
         }
     }
 
+    void update_node_output_rows(int32_t plan_node_id, int64_t rows) {
+        std::lock_guard<std::mutex> l(_node_output_rows_lock);
+        _node_output_rows[plan_node_id] += rows;
+    }
+
+    // The actual rows of the plan nodes of this fragment instance, collected from the rows output by the drivers
+    // and the counters in the profiles of the operators.
+    std::vector<TPlanNodeRuntimeStats> plan_node_runtime_stats();
+
 private:
     // Id of this query
     TUniqueId _query_id;
@@ -109,6 +122,8 @@ private:
     // promise used to determine whether fragment finished its execution
     FragmentPromise _finish_promise;
 
+    // the cached descriptor table used by _plan if any, it must be released after _runtime_state.
+    CachedDescriptorTblPtr _cached_desc_tbl;
     // never adjust the order of _runtime_state, _plan, _pipelines and _drivers, since
     // _plan depends on _runtime_state and _drivers depends on _runtime_state.
     std::shared_ptr<RuntimeState> _runtime_state = nullptr;
@@ -130,6 +145,9 @@ private:
     std::atomic<Status*> _final_status;
     std::atomic<bool> _cancel_flag;
     Status _s_status;
+
+    std::mutex _node_output_rows_lock;
+    std::map<int32_t, int64_t> _node_output_rows;
 };
 
 class FragmentContextManager {
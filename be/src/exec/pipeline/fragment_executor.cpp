@@ -5,10 +5,12 @@
 #include <unordered_map>
 
 #include "exec/exchange_node.h"
+#include "exec/pipeline/descriptor_tbl_cache.h"
 #include "exec/pipeline/exchange/exchange_sink_operator.h"
 #include "exec/pipeline/exchange/local_exchange_source_operator.h"
 #include "exec/pipeline/exchange/sink_buffer.h"
 #include "exec/pipeline/fragment_context.h"
+#include "exec/pipeline/memory_scratch_sink_operator.h"
 #include "exec/pipeline/morsel.h"
 #include "exec/pipeline/pipeline_builder.h"
 #include "exec/pipeline/result_sink_operator.h"
@@ -20,12 +22,30 @@
 #include "runtime/data_stream_sender.h"
 #include "runtime/descriptors.h"
 #include "runtime/exec_env.h"
+#include "runtime/file_result_writer.h"
+#include "runtime/memory_scratch_sink.h"
 #include "runtime/result_sink.h"
 #include "util/pretty_printer.h"
 #include "util/uid_util.h"
 
 namespace starrocks::pipeline {
 
+int32_t FragmentExecutor::compute_adaptive_dop(size_t max_dop, size_t max_num_morsels, bool capped_by_morsels,
+                                               size_t num_threads, size_t num_drivers) {
+    size_t dop = std::max<size_t>(1, max_dop);
+    // When the execution threads are shared by more drivers than threads, each one only gets a share of them,
+    // so the dop shrinks as the drivers increase, e.g. a half of max_dop when there are twice as many drivers.
+    if (num_threads > 0 && num_drivers > num_threads) {
+        dop = dop * num_threads / num_drivers;
+    }
+    // A fragment instance only reading from scan nodes has no more data than its morsels, and the drivers
+    // beyond the number of morsels, including the ones after a local shuffle, would mostly be idle.
+    if (capped_by_morsels) {
+        dop = std::min(dop, max_num_morsels);
+    }
+    return static_cast<int32_t>(std::max<size_t>(1, dop));
+}
+
 static void setup_profile_hierarchy(RuntimeState* runtime_state, const Operators& operators) {
     for (int32_t j = operators.size() - 1; j >= 0; --j) {
         auto& curr_op = operators[j];
@@ -47,15 +67,21 @@ Morsels convert_scan_range_to_morsel(const std::vector<TScanRangeParams>& scan_r
 }
 
 Status FragmentExecutor::prepare(ExecEnv* exec_env, const TExecPlanFragmentParams& request) {
+    return prepare(exec_env, request, request);
+}
+
+Status FragmentExecutor::prepare(ExecEnv* exec_env, const TExecPlanFragmentParams& common_request,
+                                 const TExecPlanFragmentParams& unique_request) {
+    const auto& request = common_request;
     DCHECK(request.__isset.desc_tbl);
     DCHECK(request.__isset.fragment);
-    const auto& params = request.params;
+    const auto& params = unique_request.params;
     const auto& query_id = params.query_id;
     const auto& fragment_instance_id = params.fragment_instance_id;
     const auto& coord = request.coord;
     const auto& query_options = request.query_options;
     const auto& query_globals = request.query_globals;
-    const auto& backend_num = request.backend_num;
+    const auto& backend_num = unique_request.backend_num;
     const auto& t_desc_tbl = request.desc_tbl;
     const auto& fragment = request.fragment;
 
@@ -70,6 +96,17 @@ Status FragmentExecutor::prepare(ExecEnv* exec_env, const TExecPlanFragmentParam
     }
 
     _query_ctx = QueryContextManager::instance()->get_or_register(query_id);
+    if (config::pipeline_enable_resource_group) {
+        const std::string& group_name =
+                query_options.__isset.pipeline_resource_group ? query_options.pipeline_resource_group : "";
+        Status st = _query_ctx->set_resource_group(ResourceGroupManager::instance()->get(group_name));
+        if (!st.ok()) {
+            if (_query_ctx->count_down_fragments()) {
+                QueryContextManager::instance()->remove(query_id);
+            }
+            return st;
+        }
+    }
     if (params.__isset.instances_number) {
         _query_ctx->set_total_fragments(params.instances_number);
     }
@@ -100,7 +137,15 @@ Status FragmentExecutor::prepare(ExecEnv* exec_env, const TExecPlanFragmentParam
     // Set up desc tbl
     auto* obj_pool = runtime_state->obj_pool();
     DescriptorTbl* desc_tbl = nullptr;
-    RETURN_IF_ERROR(DescriptorTbl::create(obj_pool, t_desc_tbl, &desc_tbl));
+    auto maybe_cached_desc_tbl = DescriptorTblCache::instance()->get_or_create(t_desc_tbl);
+    RETURN_IF_ERROR(maybe_cached_desc_tbl.status());
+    CachedDescriptorTblPtr cached_desc_tbl = std::move(maybe_cached_desc_tbl.value());
+    if (cached_desc_tbl != nullptr) {
+        desc_tbl = cached_desc_tbl->desc_tbl;
+        _fragment_ctx->set_cached_desc_tbl(std::move(cached_desc_tbl));
+    } else {
+        RETURN_IF_ERROR(DescriptorTbl::create(obj_pool, t_desc_tbl, &desc_tbl));
+    }
     runtime_state->set_desc_tbl(desc_tbl);
     // Set up plan
     ExecNode* plan = nullptr;
@@ -121,9 +166,33 @@ Status FragmentExecutor::prepare(ExecEnv* exec_env, const TExecPlanFragmentParam
         static_cast<ExchangeNode*>(exch_node)->set_num_senders(num_senders);
     }
 
+    // set scan ranges
+    std::vector<ExecNode*> scan_nodes;
+    std::vector<TScanRangeParams> no_scan_ranges;
+    plan->collect_scan_nodes(&scan_nodes);
+
+    std::vector<Morsels> scan_node_morsels;
+    scan_node_morsels.reserve(scan_nodes.size());
+    size_t max_num_morsels = 0;
+    for (auto& i : scan_nodes) {
+        ScanNode* scan_node = down_cast<ScanNode*>(i);
+        const std::vector<TScanRangeParams>& scan_ranges =
+                FindWithDefault(params.per_node_scan_ranges, scan_node->id(), no_scan_ranges);
+        scan_node_morsels.emplace_back(convert_scan_range_to_morsel(scan_ranges, scan_node->id()));
+        max_num_morsels = std::max(max_num_morsels, scan_node_morsels.back().size());
+    }
+
     int32_t degree_of_parallelism = 1;
     if (query_options.__isset.pipeline_dop && query_options.pipeline_dop > 0) {
         degree_of_parallelism = query_options.pipeline_dop;
+    } else if (config::pipeline_enable_adaptive_dop) {
+        // The morsels are split on demand by the splittable morsel queue, so their number isn't a bound.
+        bool capped_by_morsels = exch_nodes.empty() && !config::pipeline_enable_splittable_morsel;
+        auto* dispatcher = exec_env->driver_dispatcher();
+        degree_of_parallelism = compute_adaptive_dop(std::thread::hardware_concurrency(), max_num_morsels,
+                                                     capped_by_morsels, dispatcher->num_threads(),
+                                                     dispatcher->num_drivers());
+        runtime_state->runtime_profile()->add_info_string("AdaptiveDop", std::to_string(degree_of_parallelism));
     } else {
         // default dop is a half of the number of hardware threads.
         degree_of_parallelism = std::max<int32_t>(1, std::thread::hardware_concurrency() / 2);
@@ -137,18 +206,17 @@ Status FragmentExecutor::prepare(ExecEnv* exec_env, const TExecPlanFragmentParam
         pipeline_scan_mode = query_options.pipeline_scan_mode;
     }
 
-    // set scan ranges
-    std::vector<ExecNode*> scan_nodes;
-    std::vector<TScanRangeParams> no_scan_ranges;
-    plan->collect_scan_nodes(&scan_nodes);
-
     MorselQueueMap& morsel_queues = _fragment_ctx->morsel_queues();
-    for (auto& i : scan_nodes) {
-        ScanNode* scan_node = down_cast<ScanNode*>(i);
-        const std::vector<TScanRangeParams>& scan_ranges =
-                FindWithDefault(params.per_node_scan_ranges, scan_node->id(), no_scan_ranges);
-        Morsels morsels = convert_scan_range_to_morsel(scan_ranges, scan_node->id());
-        morsel_queues.emplace(scan_node->id(), std::make_unique<MorselQueue>(std::move(morsels)));
+    for (size_t i = 0; i < scan_nodes.size(); ++i) {
+        ScanNode* scan_node = down_cast<ScanNode*>(scan_nodes[i]);
+        Morsels& morsels = scan_node_morsels[i];
+        if (config::pipeline_enable_splittable_morsel && scan_node->type() == TPlanNodeType::OLAP_SCAN_NODE) {
+            auto morsel_queue = std::make_unique<SplittableMorselQueue>(std::move(morsels), degree_of_parallelism);
+            RETURN_IF_ERROR(morsel_queue->init());
+            morsel_queues.emplace(scan_node->id(), std::move(morsel_queue));
+        } else {
+            morsel_queues.emplace(scan_node->id(), std::make_unique<MorselQueue>(std::move(morsels)));
+        }
     }
 
     PipelineBuilderContext context(_fragment_ctx, degree_of_parallelism);
@@ -157,9 +225,8 @@ Status FragmentExecutor::prepare(ExecEnv* exec_env, const TExecPlanFragmentParam
     // Set up sink, if required
     std::unique_ptr<DataSink> sink;
     if (fragment.__isset.output_sink) {
-        RowDescriptor row_desc;
         RETURN_IF_ERROR(DataSink::create_data_sink(obj_pool, fragment.output_sink, fragment.output_exprs, params,
-                                                   row_desc, &sink));
+                                                   plan->row_desc(), &sink));
         RuntimeProfile* sink_profile = sink->profile();
         if (sink_profile != nullptr) {
             runtime_state->runtime_profile()->add_child(sink_profile, true, nullptr);
@@ -237,8 +304,13 @@ void FragmentExecutor::_convert_data_sink_to_operator(const TPlanFragmentExecPar
     if (typeid(*datasink) == typeid(starrocks::ResultSink)) {
         starrocks::ResultSink* result_sink = down_cast<starrocks::ResultSink*>(datasink);
         // Result sink doesn't have plan node id;
-        OpFactoryPtr op = std::make_shared<ResultSinkOperatorFactory>(
-                context->next_operator_id(), -1, result_sink->get_sink_type(), result_sink->get_output_exprs());
+        std::shared_ptr<ResultFileOptions> file_opts;
+        if (result_sink->get_file_options() != nullptr) {
+            file_opts = std::make_shared<ResultFileOptions>(*result_sink->get_file_options());
+        }
+        OpFactoryPtr op = std::make_shared<ResultSinkOperatorFactory>(context->next_operator_id(), -1,
+                                                                      result_sink->get_sink_type(),
+                                                                      result_sink->get_output_exprs(), file_opts);
         // Add result sink operator to last pipeline
         _fragment_ctx->pipelines().back()->add_op_factory(op);
     } else if (typeid(*datasink) == typeid(starrocks::DataStreamSender)) {
@@ -250,6 +322,11 @@ void FragmentExecutor::_convert_data_sink_to_operator(const TPlanFragmentExecPar
                 context->next_operator_id(), -1, sink_buffer, sender->get_partition_type(), params.destinations,
                 params.sender_id, sender->get_dest_node_id(), sender->get_partition_exprs());
         _fragment_ctx->pipelines().back()->add_op_factory(exchange_sink);
+    } else if (typeid(*datasink) == typeid(starrocks::MemoryScratchSink)) {
+        starrocks::MemoryScratchSink* memory_scratch_sink = down_cast<starrocks::MemoryScratchSink*>(datasink);
+        OpFactoryPtr op = std::make_shared<MemoryScratchSinkOperatorFactory>(context->next_operator_id(), -1,
+                                                                             memory_scratch_sink->get_row_desc());
+        _fragment_ctx->pipelines().back()->add_op_factory(op);
     }
 }
 
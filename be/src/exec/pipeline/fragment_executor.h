@@ -18,8 +18,17 @@ class QueryContext;
 class FragmentExecutor {
 public:
     Status prepare(ExecEnv* exec_env, const TExecPlanFragmentParams& request);
+    // Prepare one instance deployed by exec_batch_plan_fragments, the params and backend_num are taken from
+    // unique_request, and all the other parts are taken from common_request shared by the instances.
+    Status prepare(ExecEnv* exec_env, const TExecPlanFragmentParams& common_request,
+                   const TExecPlanFragmentParams& unique_request);
     Status execute(ExecEnv* exec_env);
 
+    // Choose the dop of a fragment instance not specified by the session, max_dop is scaled down by the load of
+    // the execution threads, and capped by the number of morsels of the scan nodes if capped_by_morsels.
+    static int32_t compute_adaptive_dop(size_t max_dop, size_t max_num_morsels, bool capped_by_morsels,
+                                        size_t num_threads, size_t num_drivers);
+
 private:
     void _convert_data_sink_to_operator(const TPlanFragmentExecParams& params, PipelineBuilderContext* context,
                                         DataSink* datasink);
@@ -22,6 +22,7 @@ void HashJoinBuildOperator::finish(RuntimeState* state) {
     if (!_is_finished) {
         _hash_joiner->build_ht(state);
         _is_finished = true;
+        _hash_joiner->notify_observers();
     }
 }
 
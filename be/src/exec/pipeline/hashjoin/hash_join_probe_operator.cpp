@@ -21,8 +21,7 @@ bool HashJoinProbeOperator::is_finished() const {
 }
 
 Status HashJoinProbeOperator::push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) {
-    _hash_joiner->push_chunk(state, std::move(const_cast<vectorized::ChunkPtr&>(chunk)));
-    return Status::OK();
+    return _hash_joiner->push_chunk(state, std::move(const_cast<vectorized::ChunkPtr&>(chunk)));
 }
 
 StatusOr<vectorized::ChunkPtr> HashJoinProbeOperator::pull_chunk(RuntimeState* state) {
@@ -41,18 +40,30 @@ bool HashJoinProbeOperator::is_ready() const {
 }
 
 HashJoinProbeOperatorFactory::HashJoinProbeOperatorFactory(int32_t id, int32_t plan_node_id,
-                                                           std::unique_ptr<HashJoiner>&& hash_joiner)
-        : OperatorFactory(id, "hash_join_probe", plan_node_id), _hash_joiner(std::move(hash_joiner)) {}
+                                                           std::unique_ptr<HashJoiner>&& hash_joiner,
+                                                           std::vector<std::unique_ptr<HashJoiner>>&& readers)
+        : OperatorFactory(id, "hash_join_probe", plan_node_id),
+          _hash_joiner(std::move(hash_joiner)),
+          _readers(std::move(readers)) {}
 
 Status HashJoinProbeOperatorFactory::prepare(RuntimeState* state) {
-    return OperatorFactory::prepare(state);
+    RETURN_IF_ERROR(OperatorFactory::prepare(state));
+    for (auto& reader : _readers) {
+        RETURN_IF_ERROR(reader->prepare(state));
+    }
+    return Status::OK();
 }
 void HashJoinProbeOperatorFactory::close(RuntimeState* state) {
+    for (auto& reader : _readers) {
+        reader->close(state);
+    }
     OperatorFactory::close(state);
 }
 
 OperatorPtr HashJoinProbeOperatorFactory::create(int32_t degree_of_parallelism, int32_t driver_sequence) {
-    return std::make_shared<HashJoinProbeOperator>(_id, _name, _plan_node_id, _hash_joiner.get());
+    DCHECK(_readers.empty() || _readers.size() + 1 == degree_of_parallelism);
+    HashJoiner* hash_joiner = driver_sequence == 0 ? _hash_joiner.get() : _readers[driver_sequence - 1].get();
+    return std::make_shared<HashJoinProbeOperator>(_id, _name, _plan_node_id, hash_joiner);
 }
 
 } // namespace pipeline
@@ -25,6 +25,10 @@ public:
     StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state);
     void finish(RuntimeState* state) override;
     bool is_ready() const override;
+    bool add_observer(PipelineObserver* observer) override {
+        _hash_joiner->add_observer(observer);
+        return true;
+    }
 
 private:
     HashJoiner* _hash_joiner;
@@ -33,7 +37,9 @@ private:
 
 class HashJoinProbeOperatorFactory final : public OperatorFactory {
 public:
-    HashJoinProbeOperatorFactory(int32_t id, int32_t plan_node_id, std::unique_ptr<HashJoiner>&& hash_joiner);
+    // |readers| probe the hash table built by |hash_joiner| in the drivers from the second one, see HashJoiner.
+    HashJoinProbeOperatorFactory(int32_t id, int32_t plan_node_id, std::unique_ptr<HashJoiner>&& hash_joiner,
+                                 std::vector<std::unique_ptr<HashJoiner>>&& readers = {});
 
     ~HashJoinProbeOperatorFactory() = default;
 
@@ -44,6 +50,7 @@ public:
 
 private:
     std::unique_ptr<HashJoiner> _hash_joiner;
+    std::vector<std::unique_ptr<HashJoiner>> _readers;
 };
 } // namespace pipeline
 } // namespace starrocks
\ No newline at end of file
@@ -0,0 +1,83 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/memory_scratch_sink_operator.h"
+
+#include <arrow/memory_pool.h>
+#include <arrow/record_batch.h>
+
+#include "column/chunk.h"
+#include "runtime/exec_env.h"
+#include "runtime/record_batch_queue.h"
+#include "runtime/runtime_state.h"
+#include "util/arrow/row_batch.h"
+#include "util/arrow/starrocks_column_to_arrow.h"
+
+namespace starrocks::pipeline {
+
+Status MemoryScratchSinkOperator::close(RuntimeState* state) {
+    if (!_last_error.ok()) {
+        _queue->update_status(_last_error);
+    }
+    // Put sentinel by the last closed operator, after all the batches have been put.
+    if (--_num_sinks == 0) {
+        _queue->blocking_put(nullptr);
+    }
+    return Operator::close(state);
+}
+
+StatusOr<vectorized::ChunkPtr> MemoryScratchSinkOperator::pull_chunk(RuntimeState* state) {
+    CHECK(false) << "Shouldn't pull chunk from memory scratch sink operator";
+}
+
+bool MemoryScratchSinkOperator::need_input() const {
+    if (is_finished()) {
+        return false;
+    }
+    if (_pending_batch == nullptr) {
+        return true;
+    }
+    _last_error = _try_put_pending_batch();
+    return _pending_batch == nullptr || !_last_error.ok();
+}
+
+Status MemoryScratchSinkOperator::push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) {
+    if (!_last_error.ok()) {
+        return _last_error;
+    }
+    DCHECK(_pending_batch == nullptr);
+    if (chunk->num_rows() == 0) {
+        return Status::OK();
+    }
+    RETURN_IF_ERROR(vectorized::convert_chunk_to_arrow_batch(chunk.get(), _slot_types, _slot_ids, _arrow_schema,
+                                                             arrow::default_memory_pool(), &_pending_batch));
+    return _try_put_pending_batch();
+}
+
+Status MemoryScratchSinkOperator::_try_put_pending_batch() const {
+    int ret = _queue->try_put(_pending_batch);
+    if (ret < 0) {
+        // The queue is shutdown once the client closes the scan context.
+        _pending_batch = nullptr;
+        return Status::Cancelled("memory scratch sink queue has been shutdown");
+    }
+    if (ret > 0) {
+        _pending_batch = nullptr;
+    }
+    return Status::OK();
+}
+
+Status MemoryScratchSinkOperatorFactory::prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(OperatorFactory::prepare(state));
+    RETURN_IF_ERROR(convert_to_arrow_schema(_row_desc, &_arrow_schema));
+    for (auto* tuple_desc : _row_desc.tuple_descriptors()) {
+        for (auto* slot : tuple_desc->slots()) {
+            _slot_types.push_back(&slot->type());
+            _slot_ids.push_back(slot->id());
+        }
+    }
+    // The queue is shared by all the operators
+    state->exec_env()->result_queue_mgr()->create_queue(state->fragment_instance_id(), &_queue);
+    return Status::OK();
+}
+
+} // namespace starrocks::pipeline
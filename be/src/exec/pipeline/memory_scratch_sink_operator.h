@@ -0,0 +1,92 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <atomic>
+#include <utility>
+
+#include "exec/pipeline/operator.h"
+#include "runtime/descriptors.h"
+#include "runtime/result_queue_mgr.h"
+
+namespace arrow {
+class RecordBatch;
+class Schema;
+} // namespace arrow
+
+namespace starrocks::pipeline {
+
+// Converts the chunks to arrow RecordBatches and puts them to the RecordBatchQueue of the fragment instance,
+// from which the external clients, e.g. the spark connector, fetch the columnar results directly from each BE.
+// The operators of all the drivers convert their chunks in parallel, and the last closed operator puts the
+// sentinel to the queue after all the batches have been put.
+class MemoryScratchSinkOperator final : public Operator {
+public:
+    MemoryScratchSinkOperator(int32_t id, int32_t plan_node_id, std::shared_ptr<arrow::Schema> arrow_schema,
+                              const std::vector<const TypeDescriptor*>& slot_types,
+                              const std::vector<SlotId>& slot_ids, BlockQueueSharedPtr queue,
+                              std::atomic<int32_t>& num_sinks)
+            : Operator(id, "memory_scratch_sink", plan_node_id),
+              _arrow_schema(std::move(arrow_schema)),
+              _slot_types(slot_types),
+              _slot_ids(slot_ids),
+              _queue(std::move(queue)),
+              _num_sinks(num_sinks) {}
+
+    ~MemoryScratchSinkOperator() override = default;
+
+    Status close(RuntimeState* state) override;
+
+    bool has_output() const override { return false; }
+
+    bool need_input() const override;
+
+    bool is_finished() const override { return _is_finished && _pending_batch == nullptr; }
+
+    void finish(RuntimeState* state) override { _is_finished = true; }
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+
+    Status push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) override;
+
+private:
+    // Try to put the pending batch to the queue without blocking, the batch is kept if the queue is full.
+    Status _try_put_pending_batch() const;
+
+    std::shared_ptr<arrow::Schema> _arrow_schema;
+    const std::vector<const TypeDescriptor*>& _slot_types;
+    const std::vector<SlotId>& _slot_ids;
+    BlockQueueSharedPtr _queue;
+    // The number of the operators not closed yet, shared by all the operators created by the same factory.
+    std::atomic<int32_t>& _num_sinks;
+
+    mutable std::shared_ptr<arrow::RecordBatch> _pending_batch;
+    mutable Status _last_error;
+    bool _is_finished = false;
+};
+
+class MemoryScratchSinkOperatorFactory final : public OperatorFactory {
+public:
+    MemoryScratchSinkOperatorFactory(int32_t id, int32_t plan_node_id, const RowDescriptor& row_desc)
+            : OperatorFactory(id, "memory_scratch_sink", plan_node_id), _row_desc(row_desc) {}
+
+    ~MemoryScratchSinkOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t degree_of_parallelism, int32_t driver_sequence) override {
+        _num_sinks = degree_of_parallelism;
+        return std::make_shared<MemoryScratchSinkOperator>(_id, _plan_node_id, _arrow_schema, _slot_types, _slot_ids,
+                                                           _queue, _num_sinks);
+    }
+
+    Status prepare(RuntimeState* state) override;
+
+private:
+    const RowDescriptor _row_desc;
+    std::shared_ptr<arrow::Schema> _arrow_schema;
+    std::vector<const TypeDescriptor*> _slot_types;
+    std::vector<SlotId> _slot_ids;
+    BlockQueueSharedPtr _queue;
+    std::atomic<int32_t> _num_sinks = 0;
+};
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,35 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/mergejoin/merge_join_left_operator.h"
+
+#include "column/chunk.h"
+
+namespace starrocks::pipeline {
+
+bool MergeJoinLeftOperator::has_output() const {
+    return is_ready() && !_merge_joiner->is_finished() && !_merge_joiner->need_left();
+}
+
+bool MergeJoinLeftOperator::need_input() const {
+    return is_ready() && !_is_left_finished && !_merge_joiner->is_finished() && _merge_joiner->need_left();
+}
+
+bool MergeJoinLeftOperator::is_finished() const {
+    if (!is_ready()) {
+        return false;
+    }
+    // No more rows can be joined once all the left rows pushed have been consumed.
+    return _merge_joiner->is_finished() || (_is_left_finished && _merge_joiner->need_left());
+}
+
+StatusOr<vectorized::ChunkPtr> MergeJoinLeftOperator::pull_chunk(RuntimeState* state) {
+    vectorized::ChunkPtr chunk;
+    RETURN_IF_ERROR(_merge_joiner->pull_chunk(&chunk));
+    return std::move(chunk);
+}
+
+Status MergeJoinLeftOperator::push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) {
+    return _merge_joiner->push_left(chunk);
+}
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,60 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <utility>
+
+#include "column/vectorized_fwd.h"
+#include "exec/pipeline/operator_with_dependency.h"
+#include "exec/vectorized/merge_joiner.h"
+
+namespace starrocks {
+namespace pipeline {
+using MergeJoiner = starrocks::vectorized::MergeJoiner;
+using MergeJoinerPtr = starrocks::vectorized::MergeJoinerPtr;
+
+// Merges the sorted left input with the right rows buffered by MergeJoinRightSinkOperator.
+// The right chunks are released as soon as the left keys have passed them.
+class MergeJoinLeftOperator final : public OperatorWithDependency {
+public:
+    MergeJoinLeftOperator(int32_t id, int32_t plan_node_id, MergeJoinerPtr merge_joiner)
+            : OperatorWithDependency(id, "merge_join_left", plan_node_id), _merge_joiner(std::move(merge_joiner)) {}
+
+    ~MergeJoinLeftOperator() override = default;
+
+    bool has_output() const override;
+    bool need_input() const override;
+    bool is_finished() const override;
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+    Status push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) override;
+
+    // The left input may finish before the right one, so MergeJoiner is not touched here.
+    void finish(RuntimeState* state) override { _is_left_finished = true; }
+
+    bool is_ready() const override { return _merge_joiner->is_right_complete(); }
+
+private:
+    MergeJoinerPtr _merge_joiner;
+    bool _is_left_finished = false;
+};
+
+class MergeJoinLeftOperatorFactory final : public OperatorWithDependencyFactory {
+public:
+    MergeJoinLeftOperatorFactory(int32_t id, int32_t plan_node_id, MergeJoinerPtr merge_joiner)
+            : OperatorWithDependencyFactory(id, "merge_join_left", plan_node_id),
+              _merge_joiner(std::move(merge_joiner)) {}
+
+    ~MergeJoinLeftOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t degree_of_parallelism, int32_t driver_sequence) override {
+        DCHECK_EQ(degree_of_parallelism, 1);
+        return std::make_shared<MergeJoinLeftOperator>(_id, _plan_node_id, _merge_joiner);
+    }
+
+private:
+    MergeJoinerPtr _merge_joiner;
+};
+
+} // namespace pipeline
+} // namespace starrocks
@@ -0,0 +1,34 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/mergejoin/merge_join_right_sink_operator.h"
+
+#include "column/chunk.h"
+
+namespace starrocks::pipeline {
+
+StatusOr<vectorized::ChunkPtr> MergeJoinRightSinkOperator::pull_chunk(RuntimeState* state) {
+    return Status::InternalError("Shouldn't pull chunk from merge join right sink operator");
+}
+
+Status MergeJoinRightSinkOperator::push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) {
+    return _merge_joiner->push_right(chunk);
+}
+
+void MergeJoinRightSinkOperator::finish(RuntimeState* state) {
+    if (!_is_finished) {
+        _merge_joiner->set_right_eos();
+        _is_finished = true;
+    }
+}
+
+Status MergeJoinRightSinkOperatorFactory::prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(OperatorFactory::prepare(state));
+    return _merge_joiner->prepare(state);
+}
+
+void MergeJoinRightSinkOperatorFactory::close(RuntimeState* state) {
+    _merge_joiner->close(state);
+    OperatorFactory::close(state);
+}
+
+} // namespace starrocks::pipeline
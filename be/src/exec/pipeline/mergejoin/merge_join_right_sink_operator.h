@@ -0,0 +1,63 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <utility>
+
+#include "column/vectorized_fwd.h"
+#include "exec/pipeline/operator.h"
+#include "exec/vectorized/merge_joiner.h"
+
+namespace starrocks {
+namespace pipeline {
+using MergeJoiner = starrocks::vectorized::MergeJoiner;
+using MergeJoinerPtr = starrocks::vectorized::MergeJoinerPtr;
+
+// Feeds the sorted right input into MergeJoiner. MergeJoiner is not thread-safe, so the right rows
+// are all buffered before MergeJoinLeftOperator starts merging, see MergeJoinLeftOperator::is_ready().
+class MergeJoinRightSinkOperator final : public Operator {
+public:
+    MergeJoinRightSinkOperator(int32_t id, int32_t plan_node_id, MergeJoinerPtr merge_joiner)
+            : Operator(id, "merge_join_right_sink", plan_node_id), _merge_joiner(std::move(merge_joiner)) {}
+
+    ~MergeJoinRightSinkOperator() override = default;
+
+    bool has_output() const override { return false; }
+
+    bool need_input() const override { return !is_finished(); }
+
+    bool is_finished() const override { return _is_finished; }
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+
+    Status push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) override;
+
+    void finish(RuntimeState* state) override;
+
+private:
+    bool _is_finished = false;
+
+    MergeJoinerPtr _merge_joiner;
+};
+
+class MergeJoinRightSinkOperatorFactory final : public OperatorFactory {
+public:
+    MergeJoinRightSinkOperatorFactory(int32_t id, int32_t plan_node_id, MergeJoinerPtr merge_joiner)
+            : OperatorFactory(id, "merge_join_right_sink", plan_node_id), _merge_joiner(std::move(merge_joiner)) {}
+
+    ~MergeJoinRightSinkOperatorFactory() override = default;
+
+    OperatorPtr create(int32_t degree_of_parallelism, int32_t driver_sequence) override {
+        DCHECK_EQ(degree_of_parallelism, 1);
+        return std::make_shared<MergeJoinRightSinkOperator>(_id, _plan_node_id, _merge_joiner);
+    }
+
+    Status prepare(RuntimeState* state) override;
+    void close(RuntimeState* state) override;
+
+private:
+    MergeJoinerPtr _merge_joiner;
+};
+
+} // namespace pipeline
+} // namespace starrocks
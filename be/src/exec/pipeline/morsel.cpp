@@ -0,0 +1,102 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/morsel.h"
+
+#include "common/config.h"
+#include "common/logging.h"
+#include "gutil/casts.h"
+#include "gutil/strings/substitute.h"
+#include "storage/storage_engine.h"
+#include "storage/tablet_manager.h"
+#include "storage/tablet_updates.h"
+
+namespace starrocks::pipeline {
+
+SplittableMorselQueue::SplittableMorselQueue(Morsels&& morsels, int64_t degree_of_parallelism)
+        : MorselQueue(std::move(morsels)), _degree_of_parallelism(std::max<int64_t>(1, degree_of_parallelism)) {}
+
+Status SplittableMorselQueue::init() {
+    _tablet_splits.resize(_morsels.size());
+    for (size_t i = 0; i < _morsels.size(); ++i) {
+        auto* morsel = down_cast<OlapMorsel*>(_morsels[i].get());
+        RETURN_IF_ERROR(_init_tablet_splits(morsel, &_tablet_splits[i]));
+        _max_num_splits += _tablet_splits[i].rowsets.empty() ? 1 : _tablet_splits[i].num_segments;
+    }
+    return Status::OK();
+}
+
+Status SplittableMorselQueue::_init_tablet_splits(OlapMorsel* morsel, TabletSplits* splits) {
+    const TInternalScanRange* scan_range = morsel->get_scan_range();
+    TTabletId tablet_id = scan_range->tablet_id;
+    SchemaHash schema_hash = strtoul(scan_range->schema_hash.c_str(), nullptr, 10);
+    int64_t version = strtoul(scan_range->version.c_str(), nullptr, 10);
+
+    std::string err;
+    auto tablet = StorageEngine::instance()->tablet_manager()->get_tablet(tablet_id, schema_hash, true, &err);
+    if (tablet == nullptr) {
+        std::string msg = strings::Substitute("failed to get tablet. tablet_id=$0, with schema_hash=$1, reason=$2",
+                                              tablet_id, schema_hash, err);
+        LOG(WARNING) << msg;
+        return Status::InternalError(msg);
+    }
+    if (tablet->keys_type() != DUP_KEYS && tablet->keys_type() != PRIMARY_KEYS) {
+        return Status::OK();
+    }
+    // the rowsets of a primary key tablet are captured after the version is applied, don't wait for a version
+    // which is not even committed.
+    if (tablet->updates() != nullptr && tablet->updates()->max_version() < version) {
+        return Status::NotFound(strings::Substitute("version $0 of tablet $1 not found, max version is $2", version,
+                                                    tablet_id, tablet->updates()->max_version()));
+    }
+
+    std::vector<RowsetSharedPtr> rowsets;
+    tablet->obtain_header_rdlock();
+    auto st = tablet->capture_consistent_rowsets(Version(0, version), &rowsets);
+    tablet->release_header_lock();
+    if (!st.ok()) {
+        LOG(WARNING) << "failed to capture rowsets of tablet " << tablet_id << " at version " << version << ": "
+                     << st.to_string();
+        return st;
+    }
+
+    int64_t num_segments = 0;
+    for (auto& rowset : rowsets) {
+        num_segments += rowset->num_segments();
+    }
+    if (num_segments <= 1) {
+        return Status::OK();
+    }
+    splits->rowsets = std::move(rowsets);
+    splits->num_segments = num_segments;
+    return Status::OK();
+}
+
+std::optional<MorselPtr> SplittableMorselQueue::try_get() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    while (_tablet_idx < _morsels.size()) {
+        auto& splits = _tablet_splits[_tablet_idx];
+        if (splits.rowsets.empty()) {
+            return std::move(_morsels[_tablet_idx++]);
+        }
+
+        int64_t remaining = splits.num_segments - splits.next_segment;
+        if (remaining <= 0) {
+            splits.rowsets.clear();
+            _morsels[_tablet_idx++].reset();
+            continue;
+        }
+
+        int64_t num_segments = (remaining + _degree_of_parallelism - 1) / _degree_of_parallelism;
+        num_segments = std::max<int64_t>(num_segments, config::pipeline_morsel_min_split_segments);
+        num_segments = std::min(num_segments, remaining);
+
+        auto* morsel = down_cast<OlapMorsel*>(_morsels[_tablet_idx].get());
+        auto split = std::make_unique<OlapMorsel>(morsel->get_plan_node_id(), *morsel->get_scan_range());
+        split->set_segment_range(splits.rowsets, splits.next_segment, splits.next_segment + num_segments);
+        splits.next_segment += num_segments;
+        return MorselPtr(std::move(split));
+    }
+    return {};
+}
+
+} // namespace starrocks::pipeline
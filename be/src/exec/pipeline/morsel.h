@@ -2,10 +2,12 @@
 
 #pragma once
 
+#include <mutex>
 #include <optional>
 
 #include "gen_cpp/InternalService_types.h"
 #include "storage/olap_common.h"
+#include "storage/rowset/rowset.h"
 
 namespace starrocks {
 namespace pipeline {
@@ -32,18 +34,40 @@ public:
         _scan_range = std::make_unique<TInternalScanRange>(scan_range.scan_range.internal_scan_range);
     }
 
+    OlapMorsel(int32_t plan_node_id, const TInternalScanRange& scan_range) : Morsel(plan_node_id) {
+        _scan_range = std::make_unique<TInternalScanRange>(scan_range);
+    }
+
     TInternalScanRange* get_scan_range() { return _scan_range.get(); }
 
+    // A split morsel only reads the segments whose ordinals are in [segment_begin, segment_end) of
+    // the captured rowsets, the ordinals are counted over the segments of all the rowsets in order.
+    void set_segment_range(std::vector<RowsetSharedPtr> rowsets, int64_t segment_begin, int64_t segment_end) {
+        _rowsets = std::move(rowsets);
+        _segment_begin = segment_begin;
+        _segment_end = segment_end;
+    }
+    bool has_segment_range() const { return _segment_end >= 0; }
+    const std::vector<RowsetSharedPtr>& rowsets() const { return _rowsets; }
+    int64_t segment_begin() const { return _segment_begin; }
+    int64_t segment_end() const { return _segment_end; }
+
 private:
     std::unique_ptr<TInternalScanRange> _scan_range;
+    // rowsets captured when the morsel is split, the other splits of the same tablet
+    // must read the same rowsets, otherwise the segment ordinals are meaningless.
+    std::vector<RowsetSharedPtr> _rowsets;
+    int64_t _segment_begin = 0;
+    int64_t _segment_end = -1;
 };
 
 class MorselQueue {
 public:
     MorselQueue(Morsels&& morsels) : _morsels(std::move(morsels)), _num_morsels(_morsels.size()), _pop_index(0) {}
+    virtual ~MorselQueue() = default;
 
-    size_t num_morsels() const { return _num_morsels; }
-    std::optional<MorselPtr> try_get() {
+    virtual size_t num_morsels() const { return _num_morsels; }
+    virtual std::optional<MorselPtr> try_get() {
         auto idx = _pop_index.load();
         // prevent _num_morsels from superfluous addition
         if (idx >= _num_morsels) {
@@ -57,11 +81,47 @@ public:
         }
     }
 
-private:
+protected:
     Morsels _morsels;
     const size_t _num_morsels;
     std::atomic<size_t> _pop_index;
 };
 
+// SplittableMorselQueue splits the morsel of a tablet at segment boundaries on demand, so the
+// ScanOperators becoming idle early can take the remaining segments of a large tablet instead of
+// waiting for the only ScanOperator reading it. Each try_get takes 1/degree_of_parallelism of the
+// remaining segments of the current tablet(guided self-scheduling), so the splits handed out at
+// the beginning are large and the splits handed out at the tail are small.
+// Only the tablets whose rows needn't be merged across segments(DUP_KEYS and PRIMARY_KEYS) are split.
+class SplittableMorselQueue final : public MorselQueue {
+public:
+    SplittableMorselQueue(Morsels&& morsels, int64_t degree_of_parallelism);
+    ~SplittableMorselQueue() override = default;
+
+    // Capture the rowsets of the tablets to split, must be called before try_get. Return an error if a tablet
+    // or its version to read does not exist, which the scan of the tablet would fail with anyway.
+    Status init();
+
+    // the maximum number of morsels could be handed out, used to decide the degree of parallelism.
+    size_t num_morsels() const override { return _max_num_splits; }
+    std::optional<MorselPtr> try_get() override;
+
+private:
+    struct TabletSplits {
+        // empty if the tablet is not splittable.
+        std::vector<RowsetSharedPtr> rowsets;
+        int64_t num_segments = 0;
+        int64_t next_segment = 0;
+    };
+    Status _init_tablet_splits(OlapMorsel* morsel, TabletSplits* splits);
+
+    const int64_t _degree_of_parallelism;
+    std::vector<TabletSplits> _tablet_splits;
+    size_t _max_num_splits = 0;
+
+    std::mutex _mutex;
+    size_t _tablet_idx = 0;
+};
+
 } // namespace pipeline
 } // namespace starrocks
\ No newline at end of file
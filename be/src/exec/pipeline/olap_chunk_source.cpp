@@ -3,14 +3,17 @@
 #include "exec/pipeline/olap_chunk_source.h"
 
 #include "column/column_helper.h"
+#include "column/column_pool.h"
 #include "exec/vectorized/olap_scan_prepare.h"
 #include "exprs/vectorized/in_const_predicate.hpp"
 #include "exprs/vectorized/runtime_filter.h"
+#include "gutil/casts.h"
 #include "gutil/map_util.h"
 #include "runtime/current_mem_tracker.h"
 #include "runtime/current_thread.h"
 #include "runtime/descriptors.h"
 #include "runtime/exec_env.h"
+#include "runtime/global_dicts.h"
 #include "storage/storage_engine.h"
 #include "storage/vectorized/chunk_helper.h"
 #include "storage/vectorized/predicate_parser.h"
@@ -43,6 +46,10 @@ Status OlapChunkSource::prepare(RuntimeState* state) {
     }
     cm.parse_conjuncts(true, max_scan_key_num);
 
+    if (_lookup_scan_result_cache()) {
+        return Status::OK();
+    }
+
     // 4. Build olap scanner range
     RETURN_IF_ERROR(_build_scan_range(_runtime_state));
 
@@ -55,6 +62,8 @@ void OlapChunkSource::_init_counter(RuntimeState* state) {
     _scan_timer = ADD_TIMER(_runtime_profile, "ScanTime");
     _bytes_read_counter = ADD_COUNTER(_runtime_profile, "BytesRead", TUnit::BYTES);
     _rows_read_counter = ADD_COUNTER(_runtime_profile, "RowsRead", TUnit::UNIT);
+    _scan_result_cache_hit_counter = ADD_COUNTER(_runtime_profile, "ScanResultCacheHitTablets", TUnit::UNIT);
+    _shared_scan_counter = ADD_COUNTER(_runtime_profile, "SharedScanTablets", TUnit::UNIT);
 
     _scan_profile = _runtime_profile->create_child("SCAN", true, false);
 
@@ -73,6 +82,8 @@ void OlapChunkSource::_init_counter(RuntimeState* state) {
     _bi_filter_timer = ADD_CHILD_TIMER(_scan_profile, "BitmapIndexFilter", "SegmentInit");
     _bi_filtered_counter = ADD_CHILD_COUNTER(_scan_profile, "BitmapIndexFilterRows", TUnit::UNIT, "SegmentInit");
     _bf_filtered_counter = ADD_CHILD_COUNTER(_scan_profile, "BloomFilterFilterRows", TUnit::UNIT, "SegmentInit");
+    _pred_cache_filtered_counter =
+            ADD_CHILD_COUNTER(_scan_profile, "PredicateCacheFilterRows", TUnit::UNIT, "SegmentInit");
     _zm_filtered_counter = ADD_CHILD_COUNTER(_scan_profile, "ZoneMapIndexFilterRows", TUnit::UNIT, "SegmentInit");
     _sk_filtered_counter = ADD_CHILD_COUNTER(_scan_profile, "ShortKeyFilterRows", TUnit::UNIT, "SegmentInit");
 
@@ -143,6 +154,11 @@ Status OlapChunkSource::_init_reader_params(const std::vector<OlapScanRange*>& k
     PredicateParser parser(_tablet->tablet_schema());
     std::vector<vectorized::ColumnPredicate*> preds;
     _conjuncts_manager.get_column_predicates(&parser, &preds);
+    _params.runtime_filter_preds_builder = [this](ObjectPool* pool,
+                                                  std::vector<const vectorized::ColumnPredicate*>* preds) {
+        PredicateParser parser(_tablet->tablet_schema());
+        _conjuncts_manager.get_runtime_filter_predicates(&parser, pool, preds);
+    };
     for (auto* p : preds) {
         _predicate_free_pool.emplace_back(p);
         if (parser.can_pushdown(p)) {
@@ -164,6 +180,17 @@ Status OlapChunkSource::_init_reader_params(const std::vector<OlapScanRange*>& k
         _params.start_key.push_back(key_range->begin_scan_range);
         _params.end_key.push_back(key_range->end_scan_range);
     }
+    if (_can_share_scan()) {
+        // The shared stream reads the whole tablet, and the predicates are evaluated on its chunks.
+        for (const auto* p : _params.predicates) {
+            _not_push_down_predicates.add(p);
+        }
+        _params.predicates.clear();
+        _share_scan = true;
+    }
+    // a full scan reads every data page once, and would evict the pages of the other queries.
+    _params.fill_page_cache = config::storage_page_cache_fill_by_full_scan || !_params.predicates.empty() ||
+                              !_params.start_key.empty();
 
     // Return columns
     if (_skip_aggregation) {
@@ -218,7 +245,24 @@ Status OlapChunkSource::_init_olap_reader(RuntimeState* runtime_state) {
     const TabletSchema& tablet_schema = _tablet->tablet_schema();
     starrocks::vectorized::Schema child_schema =
             ChunkHelper::convert_schema_to_format_v2(tablet_schema, reader_columns);
-    _reader = std::make_shared<TabletReader>(_tablet, Version(0, _version), std::move(child_schema));
+    _params.chunk_size = ChunkHelper::adaptive_chunk_size(child_schema);
+    if (!_not_push_down_conjuncts.empty() || !_not_push_down_predicates.empty()) {
+        _expr_filter_timer = ADD_TIMER(_scan_profile, "ExprFilterTime");
+    }
+    if (_share_scan) {
+        return _init_shared_scan(std::move(child_schema), scanner_columns, reader_columns);
+    }
+    auto* olap_morsel = down_cast<OlapMorsel*>(_morsel.get());
+    if (olap_morsel->has_segment_range()) {
+        // the morsel is split from a tablet, so read the rowsets captured when it's split.
+        _params.segment_begin = olap_morsel->segment_begin();
+        _params.segment_end = olap_morsel->segment_end();
+        _reader = std::make_shared<TabletReader>(_tablet, Version(0, _version), std::move(child_schema),
+                                                 olap_morsel->rowsets());
+    } else {
+        _reader = std::make_shared<TabletReader>(_tablet, Version(0, _version), std::move(child_schema));
+    }
+    _reader->mutable_stats()->collect_column_stats = _runtime_state->query_options().enable_scan_column_io_stats;
     if (reader_columns.size() == scanner_columns.size()) {
         _prj_iter = _reader;
     } else {
@@ -227,10 +271,6 @@ Status OlapChunkSource::_init_olap_reader(RuntimeState* runtime_state) {
         _prj_iter = new_projection_iterator(output_schema, _reader);
     }
 
-    if (!_not_push_down_conjuncts.empty() || !_not_push_down_predicates.empty()) {
-        _expr_filter_timer = ADD_TIMER(_scan_profile, "ExprFilterTime");
-    }
-
     DCHECK(_params.global_dictmaps != nullptr);
     RETURN_IF_ERROR(_prj_iter->init_encoded_schema(*_params.global_dictmaps));
 
@@ -239,6 +279,45 @@ Status OlapChunkSource::_init_olap_reader(RuntimeState* runtime_state) {
     return Status::OK();
 }
 
+bool OlapChunkSource::_can_share_scan() const {
+    auto* olap_morsel = down_cast<OlapMorsel*>(_morsel.get());
+    // The chunks of the stream are not encoded by the global dicts of a query.
+    return config::pipeline_enable_shared_scan && !olap_morsel->has_segment_range() && _params.start_key.empty() &&
+           _params.global_dictmaps->empty();
+}
+
+Status OlapChunkSource::_init_shared_scan(vectorized::Schema child_schema, const std::vector<uint32_t>& scanner_columns,
+                                          const std::vector<uint32_t>& reader_columns) {
+    const TabletSchema& tablet_schema = _tablet->tablet_schema();
+    Schema output_schema = ChunkHelper::convert_schema_to_format_v2(tablet_schema, scanner_columns);
+    // The stream may outlive this scan, so it's opened with the parameters not referring to this scan.
+    TabletReaderParams params;
+    params.reader_type = READER_QUERY;
+    params.skip_aggregation = _params.skip_aggregation;
+    params.use_page_cache = _params.use_page_cache;
+    params.fill_page_cache = _params.fill_page_cache;
+    params.chunk_size = _params.chunk_size;
+    const bool project = reader_columns.size() != scanner_columns.size();
+    auto open = [tablet = _tablet, version = _version, child_schema, output_schema, params,
+                 project]() -> StatusOr<ChunkIteratorPtr> {
+        auto reader = std::make_shared<TabletReader>(tablet, Version(0, version), child_schema);
+        ChunkIteratorPtr iter = reader;
+        if (project) {
+            iter = new_projection_iterator(output_schema, reader);
+        }
+        RETURN_IF_ERROR(iter->init_encoded_schema(EMPTY_GLOBAL_DICTMAPS));
+        RETURN_IF_ERROR(reader->prepare());
+        RETURN_IF_ERROR(reader->open(params));
+        return iter;
+    };
+
+    const std::string key = SharedScanMgr::make_key(_tablet->tablet_id(), _version, scanner_columns, _skip_aggregation);
+    _shared_scan = SharedScanMgr::instance()->get_or_create(key, output_schema, _params.chunk_size, open);
+    _shared_scan_reader_id = _shared_scan->attach();
+    COUNTER_UPDATE(_shared_scan_counter, 1);
+    return Status::OK();
+}
+
 bool OlapChunkSource::has_next_chunk() const {
     // If we need and could get next chunk from storage engine,
     // the _status must be ok.
@@ -249,15 +328,75 @@ StatusOr<vectorized::ChunkUniquePtr> OlapChunkSource::get_next_chunk() {
     if (!_status.ok()) {
         return _status;
     }
+    if (_cached_chunks != nullptr) {
+        return _get_next_cached_chunk();
+    }
     using namespace vectorized;
-    ChunkUniquePtr chunk(ChunkHelper::new_chunk_pooled(_prj_iter->encoded_schema(), config::vector_chunk_size, true));
+    const Schema& schema = _shared_scan != nullptr ? _shared_scan->schema() : _prj_iter->encoded_schema();
+    ChunkUniquePtr chunk(ChunkHelper::new_chunk_pooled(schema, _params.chunk_size, true));
     _status = _read_chunk_from_storage(_runtime_state, chunk.get());
     if (!_status.ok()) {
+        if (_status.is_end_of_file() && _populate_scan_result_cache) {
+            ScanResultCache::instance()->insert(_scan_result_cache_key, std::move(_chunks_to_cache));
+            _populate_scan_result_cache = false;
+        }
         return _status;
     }
+    if (_populate_scan_result_cache) {
+        _record_chunk_to_cache(*chunk);
+    }
     return std::move(chunk);
 }
 
+static vectorized::ChunkUniquePtr copy_chunk(const vectorized::Chunk& chunk) {
+    auto copy = chunk.clone_empty_with_slot(chunk.num_rows());
+    copy->append(chunk);
+    return copy;
+}
+
+bool OlapChunkSource::_lookup_scan_result_cache() {
+    auto* olap_morsel = down_cast<OlapMorsel*>(_morsel.get());
+    // A split morsel only reads a part of the tablet.
+    if (_scan_result_cache_digest.empty() || olap_morsel->has_segment_range() || !_status.ok()) {
+        return false;
+    }
+    auto* cache = ScanResultCache::instance();
+    cache->set_capacity(std::max<int64_t>(config::pipeline_scan_result_cache_capacity, 0));
+    if (cache->capacity() == 0) {
+        return false;
+    }
+    _scan_result_cache_key = ScanResultCache::make_key(_scan_result_cache_digest, _scan_range->tablet_id,
+                                                       strtoul(_scan_range->version.c_str(), nullptr, 10));
+    _cached_chunks = cache->lookup(_scan_result_cache_key);
+    if (_cached_chunks != nullptr) {
+        COUNTER_UPDATE(_scan_result_cache_hit_counter, 1);
+        return true;
+    }
+    _populate_scan_result_cache = true;
+    return false;
+}
+
+StatusOr<vectorized::ChunkUniquePtr> OlapChunkSource::_get_next_cached_chunk() {
+    if (_cached_chunk_index >= _cached_chunks->size()) {
+        _status = Status::EndOfFile("no more cached chunks");
+        return _status;
+    }
+    // The downstream operators may modify the chunk in place.
+    const auto& chunk = (*_cached_chunks)[_cached_chunk_index++];
+    _num_rows_read += chunk->num_rows();
+    return copy_chunk(*chunk);
+}
+
+void OlapChunkSource::_record_chunk_to_cache(const vectorized::Chunk& chunk) {
+    _bytes_to_cache += chunk.memory_usage();
+    if (_bytes_to_cache > ScanResultCache::instance()->capacity()) {
+        _populate_scan_result_cache = false;
+        _chunks_to_cache.clear();
+        return;
+    }
+    _chunks_to_cache.emplace_back(copy_chunk(chunk));
+}
+
 void OlapChunkSource::cache_next_chunk_blocking() {
     _chunk = get_next_chunk();
 }
@@ -295,7 +434,13 @@ Status OlapChunkSource::_read_chunk_from_storage(RuntimeState* state, vectorized
     }
     SCOPED_TIMER(_scan_timer);
     do {
-        if (Status status = _prj_iter->get_next(chunk); !status.ok()) {
+        if (_shared_scan != nullptr) {
+            ChunkPtr shared_chunk;
+            RETURN_IF_ERROR(_shared_scan->get_next(_shared_scan_reader_id, &shared_chunk));
+            // the predicates filter the chunk in place.
+            chunk->append(*shared_chunk);
+            _num_rows_read += chunk->num_rows();
+        } else if (Status status = _prj_iter->get_next(chunk); !status.ok()) {
             return status;
         }
 
@@ -326,10 +471,24 @@ Status OlapChunkSource::_read_chunk_from_storage(RuntimeState* state, vectorized
 }
 
 Status OlapChunkSource::close(RuntimeState* state) {
+    if (_cached_chunks != nullptr) {
+        COUNTER_UPDATE(_rows_read_counter, _num_rows_read);
+        _cached_chunks.reset();
+        return Status::OK();
+    }
+    if (_shared_scan != nullptr) {
+        COUNTER_UPDATE(_rows_read_counter, _num_rows_read);
+        _shared_scan->detach(_shared_scan_reader_id);
+        _shared_scan.reset();
+        _predicate_free_pool.clear();
+        return Status::OK();
+    }
     _update_counter();
     _prj_iter->close();
     _reader.reset();
     _predicate_free_pool.clear();
+    // Reduce the memory usage if the the average string size is greater than 512.
+    release_large_columns<BinaryColumn>(config::vector_chunk_size * 512);
     return Status::OK();
 }
 
@@ -361,6 +520,7 @@ void OlapChunkSource::_update_counter() {
 
     COUNTER_UPDATE(_zm_filtered_counter, _reader->stats().rows_stats_filtered);
     COUNTER_UPDATE(_bf_filtered_counter, _reader->stats().rows_bf_filtered);
+    COUNTER_UPDATE(_pred_cache_filtered_counter, _reader->stats().rows_pred_cache_filtered);
     COUNTER_UPDATE(_sk_filtered_counter, _reader->stats().rows_key_range_filtered);
     COUNTER_UPDATE(_index_load_timer, _reader->stats().index_load_ns);
 
@@ -375,6 +535,22 @@ void OlapChunkSource::_update_counter() {
 
     StarRocksMetrics::instance()->query_scan_bytes.increment(_compressed_bytes_read);
     StarRocksMetrics::instance()->query_scan_rows.increment(_raw_rows_read);
+    StarRocksMetrics::instance()->query_scan_pages.increment(_reader->stats().total_pages_num);
+    StarRocksMetrics::instance()->query_scan_cached_pages.increment(_reader->stats().cached_pages_num);
+    StarRocksMetrics::instance()->query_scan_io_time_us.increment(_reader->stats().io_ns / 1000);
+    StarRocksMetrics::instance()->query_scan_decompress_time_us.increment(_reader->stats().decompress_ns / 1000);
+
+    for (const auto& [name, column_stats] : _reader->stats().column_stats) {
+        RuntimeProfile* p = _scan_profile->create_child("Column " + name);
+        COUNTER_UPDATE(ADD_COUNTER(p, "PagesRead", TUnit::UNIT), column_stats.pages_read);
+        COUNTER_UPDATE(ADD_COUNTER(p, "CachedPagesRead", TUnit::UNIT), column_stats.cached_pages);
+        COUNTER_UPDATE(ADD_TIMER(p, "IOTime"), column_stats.io_ns);
+        COUNTER_UPDATE(ADD_COUNTER(p, "CompressedBytesRead", TUnit::BYTES), column_stats.compressed_bytes_read);
+        COUNTER_UPDATE(ADD_TIMER(p, "DecompressTime"), column_stats.decompress_ns);
+        COUNTER_UPDATE(ADD_COUNTER(p, "UncompressedBytesRead", TUnit::BYTES), column_stats.uncompressed_bytes_read);
+        COUNTER_UPDATE(ADD_TIMER(p, "DecodeTime"), column_stats.decode_ns);
+        COUNTER_UPDATE(ADD_COUNTER(p, "BytesRead", TUnit::BYTES), column_stats.bytes_read);
+    }
 
     if (_reader->stats().decode_dict_ns > 0) {
         RuntimeProfile::Counter* c = ADD_TIMER(_scan_profile, "DictDecode");
@@ -7,6 +7,8 @@
 #include "exec/olap_common.h"
 #include "exec/olap_utils.h"
 #include "exec/pipeline/chunk_source.h"
+#include "exec/pipeline/scan_result_cache.h"
+#include "exec/pipeline/shared_scan.h"
 #include "exec/vectorized/olap_scan_prepare.h"
 #include "exprs/expr.h"
 #include "exprs/expr_context.h"
@@ -27,14 +29,16 @@ class OlapChunkSource final : public ChunkSource {
 public:
     OlapChunkSource(MorselPtr&& morsel, int32_t tuple_id, std::vector<ExprContext*> conjunct_ctxs,
                     RuntimeProfile* runtime_profile, const vectorized::RuntimeFilterProbeCollector& runtime_filters,
-                    std::vector<std::string> key_column_names, bool skip_aggregation)
+                    std::vector<std::string> key_column_names, bool skip_aggregation,
+                    const std::string& scan_result_cache_digest)
             : ChunkSource(std::move(morsel)),
               _tuple_id(tuple_id),
               _conjunct_ctxs(std::move(conjunct_ctxs)),
               _runtime_profile(runtime_profile),
               _runtime_filters(runtime_filters),
               _key_column_names(std::move(key_column_names)),
-              _skip_aggregation(skip_aggregation) {
+              _skip_aggregation(skip_aggregation),
+              _scan_result_cache_digest(scan_result_cache_digest) {
         OlapMorsel* olap_morsel = (OlapMorsel*)_morsel.get();
         _scan_range = olap_morsel->get_scan_range();
     }
@@ -62,6 +66,14 @@ private:
     Status _build_scan_range(RuntimeState* state);
     Status _read_chunk_from_storage([[maybe_unused]] RuntimeState* state, vectorized::Chunk* chunk);
     void _update_counter();
+    // Look up the chunks of the whole tablet in ScanResultCache, return true on hit.
+    bool _lookup_scan_result_cache();
+    StatusOr<vectorized::ChunkUniquePtr> _get_next_cached_chunk();
+    void _record_chunk_to_cache(const vectorized::Chunk& chunk);
+    // Whether the scan reads the whole tablet, which can share a stream of chunks with the concurrent scans.
+    bool _can_share_scan() const;
+    Status _init_shared_scan(vectorized::Schema child_schema, const std::vector<uint32_t>& scanner_columns,
+                             const std::vector<uint32_t>& reader_columns);
 
     vectorized::TabletReaderParams _params = {};
 
@@ -73,6 +85,23 @@ private:
     bool _skip_aggregation;
     TInternalScanRange* _scan_range;
 
+    // Empty if the output of the scan is not cacheable.
+    const std::string& _scan_result_cache_digest;
+    std::string _scan_result_cache_key;
+    // The cached chunks of the tablet on hit, which are output in order.
+    ScanResultCache::ChunksPtr _cached_chunks;
+    size_t _cached_chunk_index = 0;
+    // The chunks read from storage to populate the cache on miss, discarded once they cannot fit in the cache.
+    bool _populate_scan_result_cache = false;
+    ScanResultCache::Chunks _chunks_to_cache;
+    size_t _bytes_to_cache = 0;
+
+    // The shared stream read instead of |_reader| if config::pipeline_enable_shared_scan, with all the predicates
+    // evaluated on its chunks.
+    bool _share_scan = false;
+    std::shared_ptr<SharedScan> _shared_scan;
+    int64_t _shared_scan_reader_id = -1;
+
     Status _status = Status::OK();
     StatusOr<vectorized::ChunkUniquePtr> _chunk;
     // The conjuncts couldn't push down to storage engine
@@ -106,6 +135,8 @@ private:
     RuntimeProfile* _runtime_profile = nullptr;
     RuntimeProfile::Counter* _bytes_read_counter = nullptr;
     RuntimeProfile::Counter* _rows_read_counter = nullptr;
+    RuntimeProfile::Counter* _scan_result_cache_hit_counter = nullptr;
+    RuntimeProfile::Counter* _shared_scan_counter = nullptr;
 
     RuntimeProfile* _scan_profile = nullptr;
     RuntimeProfile::Counter* _expr_filter_timer = nullptr;
@@ -125,6 +156,7 @@ private:
     RuntimeProfile::Counter* _seg_init_timer = nullptr;
     RuntimeProfile::Counter* _zm_filtered_counter = nullptr;
     RuntimeProfile::Counter* _bf_filtered_counter = nullptr;
+    RuntimeProfile::Counter* _pred_cache_filtered_counter = nullptr;
     RuntimeProfile::Counter* _sk_filtered_counter = nullptr;
     RuntimeProfile::Counter* _block_seek_timer = nullptr;
     RuntimeProfile::Counter* _block_seek_counter = nullptr;
@@ -13,6 +13,7 @@ class MemTracker;
 class RuntimeProfile;
 class RuntimeState;
 namespace pipeline {
+class PipelineObserver;
 class Operator;
 using OperatorPtr = std::shared_ptr<Operator>;
 using Operators = std::vector<OperatorPtr>;
@@ -50,6 +51,11 @@ public:
     // Push chunk to this operator
     virtual Status push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) = 0;
 
+    // Register the observer of the driver, return true if the operator notifies the observer whenever
+    // has_output(), is_finished() or is_ready() may change, then the driver blocked on this operator
+    // is only re-evaluated by PipelineDriverPoller after notified. return false by default.
+    virtual bool add_observer(PipelineObserver* observer) { return false; }
+
     int32_t get_id() const { return _id; }
 
     int32_t get_plan_node_id() const { return _plan_node_id; }
@@ -35,7 +35,7 @@ OpFactories PipelineBuilderContext::maybe_interpolate_local_passthrough_exchange
 }
 
 OpFactories PipelineBuilderContext::maybe_interpolate_local_shuffle_exchange(
-        OpFactories& pred_operators, const std::vector<ExprContext*>& partition_expr_ctxs) {
+        OpFactories& pred_operators, const std::vector<ExprContext*>& partition_expr_ctxs, bool rebalance_skew) {
     DCHECK(!pred_operators.empty() && pred_operators[0]->is_source());
 
     // If DOP is one, we needn't partition input chunks.
@@ -45,10 +45,11 @@ OpFactories PipelineBuilderContext::maybe_interpolate_local_shuffle_exchange(
     }
 
     // TODO: make max_row_count as config::vector_chunk_size * shuffle_partitions_num when the local shuffle is lock free.
-    auto mem_mgr = std::make_shared<LocalExchangeMemoryManager>(config::vector_chunk_size);
+    auto mem_mgr = std::make_shared<LocalExchangeMemoryManager>(config::vector_chunk_size,
+                                                                rebalance_skew ? shuffle_partitions_num : 0);
     auto local_shuffle_source = std::make_shared<LocalExchangeSourceOperatorFactory>(next_operator_id(), mem_mgr);
-    auto local_shuffle =
-            std::make_shared<PartitionExchanger>(mem_mgr, local_shuffle_source.get(), true, partition_expr_ctxs);
+    auto local_shuffle = std::make_shared<PartitionExchanger>(mem_mgr, local_shuffle_source.get(), true,
+                                                              partition_expr_ctxs, rebalance_skew);
 
     // Append local shuffle sink to the tail of the current pipeline, which comes to end.
     auto local_shuffle_sink = std::make_shared<LocalExchangeSinkOperatorFactory>(next_operator_id(), local_shuffle);
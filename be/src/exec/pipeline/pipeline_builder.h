@@ -31,8 +31,11 @@ public:
     // It is used to parallelize complex operators. For example, the build Hash Table (HT) operator can partition
     // the input chunks to build multiple partition HTs, and the probe HT operator can also partition the input chunks
     // and probe on multiple partition HTs in parallel.
+    // If |rebalance_skew| is true, the rows of the hot partitions are rebalanced to the other partitions,
+    // see PartitionExchanger.
     OpFactories maybe_interpolate_local_shuffle_exchange(OpFactories& pred_operators,
-                                                         const std::vector<ExprContext*>& partition_expr_ctxs);
+                                                         const std::vector<ExprContext*>& partition_expr_ctxs,
+                                                         bool rebalance_skew = false);
 
     // Uses local exchange to gather the output chunks of multiple predecessor pipelines
     // into a new pipeline, which the successor operator belongs to.
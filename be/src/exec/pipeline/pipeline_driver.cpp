@@ -8,9 +8,40 @@
 #include "column/chunk.h"
 #include "exec/pipeline/source_operator.h"
 #include "runtime/exec_env.h"
+#include "runtime/mem_tracker.h"
 #include "runtime/runtime_state.h"
+#include "util/defer_op.h"
+#include "util/time.h"
 
 namespace starrocks::pipeline {
+
+// Adds the hardware events of the driver thread during the lifetime to the counters of an operator.
+class ScopedHardwareCounters {
+public:
+    explicit ScopedHardwareCounters(const PipelineDriver::HardwareCounters* counters) : _counters(counters) {
+        if (_counters != nullptr) {
+            _thread_counters = ThreadHardwareCounters::current();
+            if (_thread_counters == nullptr || !_thread_counters->read(&_begin)) {
+                _counters = nullptr;
+            }
+        }
+    }
+
+    ~ScopedHardwareCounters() {
+        ThreadHardwareCounters::Values end;
+        if (_counters != nullptr && _thread_counters->read(&end)) {
+            for (int i = 0; i < ThreadHardwareCounters::NUM_EVENTS; ++i) {
+                COUNTER_UPDATE((*_counters)[i], end[i] - _begin[i]);
+            }
+        }
+    }
+
+private:
+    const PipelineDriver::HardwareCounters* _counters;
+    ThreadHardwareCounters* _thread_counters = nullptr;
+    ThreadHardwareCounters::Values _begin;
+};
+
 Status PipelineDriver::prepare(RuntimeState* runtime_state) {
     DCHECK(_state == DriverState::NOT_READY);
     // fill OperatorWithDependency instances into _dependencies from _operators.
@@ -25,14 +56,87 @@ Status PipelineDriver::prepare(RuntimeState* runtime_state) {
     for (auto& op : _operators) {
         RETURN_IF_ERROR(op->prepare(runtime_state));
     }
+    if (runtime_state->query_options().enable_pipeline_hardware_counters) {
+        _prepare_hardware_counters();
+    }
+    _peak_mem_usage_counter =
+            source_operator()->get_runtime_profile()->AddHighWaterMarkCounter("DriverPeakMemoryUsage", TUnit::BYTES);
+    if (config::pipeline_report_plan_node_runtime_stats) {
+        _output_rows.assign(_operators.size(), 0);
+    }
     // Driver has no dependencies always sets _all_dependencies_ready to true;
     _all_dependencies_ready = _dependencies.empty();
+    _is_source_observable = source_operator()->add_observer(&_observer);
+    _is_dependencies_observable = !_dependencies.empty();
+    for (auto* dep : _dependencies) {
+        _is_dependencies_observable &= dep->add_observer(&_observer);
+    }
     _state = DriverState::READY;
     return Status::OK();
 }
 
+void PipelineDriver::_prepare_hardware_counters() {
+    _hw_counters.reserve(_operators.size());
+    for (auto& op : _operators) {
+        auto* profile = op->get_runtime_profile();
+        HardwareCounters counters;
+        counters[ThreadHardwareCounters::CPU_CYCLES] = ADD_COUNTER(profile, "HwCpuCycles", TUnit::UNIT);
+        counters[ThreadHardwareCounters::INSTRUCTIONS] = ADD_COUNTER(profile, "HwInstructions", TUnit::UNIT);
+        counters[ThreadHardwareCounters::LLC_MISSES] = ADD_COUNTER(profile, "HwLLCMisses", TUnit::UNIT);
+        counters[ThreadHardwareCounters::BRANCH_MISSES] = ADD_COUNTER(profile, "HwBranchMisses", TUnit::UNIT);
+        _hw_counters.push_back(counters);
+    }
+}
+
+void PipelineDriver::_add_trace_event(DriverTraceEventType type) {
+    DriverTraceEvent event;
+    event.timestamp_ns = MonotonicNanos();
+    event.driver = reinterpret_cast<uint64_t>(this);
+    event.fragment_instance_lo = _fragment_ctx->fragment_instance_id().lo;
+    event.driver_id = _driver_id;
+    event.source_node_id = _source_node_id;
+    event.type = type;
+    event.state = _state;
+    _query_ctx->driver_trace()->add(event);
+}
+
+void PipelineDriver::_update_mem_usage() {
+    int64_t mem_usage = 0;
+    for (auto& op : _operators) {
+        if (op->get_memtracker() != nullptr) {
+            mem_usage += op->get_memtracker()->consumption();
+        }
+    }
+    if (_peak_mem_usage_counter != nullptr) {
+        COUNTER_SET(_peak_mem_usage_counter, mem_usage);
+    }
+    if (mem_usage != _mem_usage) {
+        _query_ctx->update_mem_usage(mem_usage - _mem_usage);
+        _mem_usage = mem_usage;
+    }
+}
+
+void PipelineDriver::_update_output_rows() {
+    for (size_t i = 0; i < _output_rows.size(); ++i) {
+        if (_output_rows[i] == 0) {
+            continue;
+        }
+        // A plan node may be decomposed into consecutive operators, its output is pulled from the last one.
+        const int32_t plan_node_id = _operators[i]->get_plan_node_id();
+        const bool is_last = i + 1 == _operators.size() || _operators[i + 1]->get_plan_node_id() != plan_node_id;
+        if (plan_node_id >= 0 && is_last) {
+            _fragment_ctx->update_node_output_rows(plan_node_id, _output_rows[i]);
+        }
+        _output_rows[i] = 0;
+    }
+}
+
 StatusOr<DriverState> PipelineDriver::process(RuntimeState* runtime_state) {
     _state = DriverState::RUNNING;
+    DeferOp update_mem_usage([this]() {
+        _update_mem_usage();
+        _update_output_rows();
+    });
     size_t total_chunks_moved = 0;
     int64_t time_spent = 0;
     while (true) {
@@ -71,7 +175,11 @@ StatusOr<DriverState> PipelineDriver::process(RuntimeState* runtime_state) {
 
                 // pull chunk from current operator and push the chunk onto next
                 // operator
-                auto maybe_chunk = curr_op->pull_chunk(runtime_state);
+                StatusOr<vectorized::ChunkPtr> maybe_chunk;
+                {
+                    ScopedHardwareCounters scoped_counters(_hardware_counters(i));
+                    maybe_chunk = curr_op->pull_chunk(runtime_state);
+                }
                 auto status = maybe_chunk.status();
                 if (!status.ok() && !status.is_end_of_file()) {
                     LOG(WARNING) << " status " << status.to_string();
@@ -86,6 +194,10 @@ StatusOr<DriverState> PipelineDriver::process(RuntimeState* runtime_state) {
                     if (maybe_chunk.value() && maybe_chunk.value()->num_rows() > 0) {
                         VLOG_ROW << "[Driver] transfer chunk(" << maybe_chunk.value()->num_rows() << ") from "
                                  << curr_op->get_name() << " to " << next_op->get_name() << ", driver=" << this;
+                        if (!_output_rows.empty()) {
+                            _output_rows[i] += maybe_chunk.value()->num_rows();
+                        }
+                        ScopedHardwareCounters scoped_counters(_hardware_counters(i + 1));
                         next_op->push_chunk(runtime_state, maybe_chunk.value());
                     }
                     num_chunk_moved += 1;
@@ -169,6 +281,7 @@ void PipelineDriver::finalize(RuntimeState* runtime_state, DriverState state) {
         DCHECK(false);
     }
     _state = state;
+    _update_mem_usage();
 
     // last root driver cancel the all drivers' execution and notify FE the
     // fragment's completion but do not unregister the FragmentContext because
@@ -177,6 +290,11 @@ void PipelineDriver::finalize(RuntimeState* runtime_state, DriverState state) {
     if (is_root()) {
         if (_fragment_ctx->count_down_root_drivers()) {
             _fragment_ctx->finish();
+            auto* profile = _fragment_ctx->runtime_state()->runtime_profile();
+            COUNTER_SET(ADD_COUNTER(profile, "QueryPeakMemoryUsage", TUnit::BYTES), _query_ctx->peak_mem_usage());
+            if (config::pipeline_query_mem_timeline_interval_ms > 0) {
+                profile->add_info_string("QueryMemoryTimeline", _query_ctx->mem_usage_timeline_string());
+            }
             auto status = _fragment_ctx->final_status();
             _fragment_ctx->runtime_state()->exec_env()->driver_dispatcher()->report_exec_state(_fragment_ctx, status,
                                                                                                true);
@@ -12,9 +12,12 @@
 #include "exec/pipeline/operator.h"
 #include "exec/pipeline/operator_with_dependency.h"
 #include "exec/pipeline/pipeline_fwd.h"
+#include "exec/pipeline/pipeline_observer.h"
 #include "exec/pipeline/query_context.h"
 #include "exec/pipeline/source_operator.h"
 #include "runtime/mem_tracker.h"
+#include "util/perf_counters.h"
+#include "util/runtime_profile.h"
 
 namespace starrocks {
 class MemTracker;
@@ -93,8 +96,14 @@ public:
     }
     void increment_schedule_times() { this->schedule_times += 1; }
 
+    // the local queue of the execution thread that ran the driver last, -1 if it's never run. It's a hint
+    // used by WorkStealingDriverQueue to put the driver back to that thread, whose caches still hold its state.
+    int64_t get_last_local_queue() const { return last_local_queue; }
+    void set_last_local_queue(int64_t index) { this->last_local_queue = index; }
+
 private:
     int64_t schedule_times{0};
+    int64_t last_local_queue{-1};
     int64_t last_time_spent{0};
     int64_t last_chunks_moved{0};
     int64_t accumulated_time_spent{0};
@@ -103,6 +112,9 @@ private:
 
 class PipelineDriver {
 public:
+    // The counters of the hardware events of an operator, indexed by ThreadHardwareCounters::Event.
+    using HardwareCounters = std::array<RuntimeProfile::Counter*, ThreadHardwareCounters::NUM_EVENTS>;
+
     PipelineDriver(const Operators& operators, QueryContext* query_ctx, FragmentContext* fragment_ctx,
                    int32_t driver_id, bool is_root)
             : _operators(operators),
@@ -124,12 +136,20 @@ public:
     FragmentContext* fragment_ctx() { return _fragment_ctx; }
     int32_t source_node_id() { return _source_node_id; }
     int32_t driver_id() const { return _driver_id; }
+    const Operators& operators() const { return _operators; }
     DriverPtr clone() { return std::make_shared<PipelineDriver>(*this); }
     void set_morsel_queue(MorselQueue* morsel_queue) { _morsel_queue = morsel_queue; }
     Status prepare(RuntimeState* runtime_state);
     StatusOr<DriverState> process(RuntimeState* runtime_state);
     void finalize(RuntimeState* runtime_state, DriverState state);
     DriverAcct& driver_acct() { return _driver_acct; }
+    // Record the scheduling event into the driver trace of the query if it's traced, must be called
+    // before the driver is handed over to the others.
+    void trace(DriverTraceEventType type) {
+        if (_query_ctx->driver_trace() != nullptr) {
+            _add_trace_event(type);
+        }
+    }
     DriverState driver_state() { return _state; }
     void set_driver_state(DriverState state) { _state = state; }
     SourceOperator* source_operator() { return down_cast<SourceOperator*>(_operators.front().get()); }
@@ -167,11 +187,29 @@ public:
 
     bool is_root() const { return _is_root; }
 
+    PipelineObserver* observer() { return &_observer; }
+    // return true if the driver is blocked on operators that notify it when they become ready,
+    // so PipelineDriverPoller needn't re-evaluate it until its observer is notified.
+    bool is_blocked_on_observables() const {
+        return (_state == DriverState::INPUT_EMPTY && _is_source_observable) ||
+               (_state == DriverState::DEPENDENCIES_BLOCK && _is_dependencies_observable);
+    }
+
     std::string to_debug_string() const;
 
 private:
     // check whether fragment is cancelled. It is used before pull_chunk and push_chunk.
     bool _check_fragment_is_canceled(RuntimeState* runtime_state);
+    // Add the counters of the hardware events into the profiles of the operators.
+    void _prepare_hardware_counters();
+    void _add_trace_event(DriverTraceEventType type);
+    // Sum up the memory of the operators into the peak of the driver, and report the change to the query.
+    void _update_mem_usage();
+    // Add the rows output by the operators since last time into the stats of their plan nodes.
+    void _update_output_rows();
+    const HardwareCounters* _hardware_counters(size_t op_index) const {
+        return _hw_counters.empty() ? nullptr : &_hw_counters[op_index];
+    }
 
     Operators _operators;
     DriverDependencies _dependencies;
@@ -184,6 +222,9 @@ private:
     int32_t _driver_id;
     const bool _is_root;
     DriverAcct _driver_acct;
+    PipelineObserver _observer;
+    bool _is_source_observable = false;
+    bool _is_dependencies_observable = false;
     // The first one is source operator
     MorselQueue* _morsel_queue = nullptr;
     DriverState _state;
@@ -191,6 +232,14 @@ private:
     std::shared_ptr<MemTracker> _mem_tracker = nullptr;
     const size_t _yield_max_chunks_moved;
     const int64_t _yield_max_time_spent;
+    // Empty unless the query option enable_pipeline_hardware_counters is set.
+    std::vector<HardwareCounters> _hw_counters;
+    // The memory of the operators last reported to the query.
+    int64_t _mem_usage = 0;
+    RuntimeProfile::HighWaterMarkCounter* _peak_mem_usage_counter = nullptr;
+    // The rows pulled from every operator not reported to the fragment yet,
+    // empty unless config::pipeline_report_plan_node_runtime_stats is set.
+    std::vector<int64_t> _output_rows;
 };
 
 } // namespace pipeline
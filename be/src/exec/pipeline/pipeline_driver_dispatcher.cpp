@@ -2,21 +2,33 @@
 
 #include "exec/pipeline/pipeline_driver_dispatcher.h"
 
+#include "common/config.h"
 #include "gutil/strings/substitute.h"
+#include "runtime/current_thread.h"
+
 namespace starrocks::pipeline {
 GlobalDriverDispatcher::GlobalDriverDispatcher(std::unique_ptr<ThreadPool> thread_pool)
-        : _driver_queue(new QuerySharedDriverQueue()),
-          _thread_pool(std::move(thread_pool)),
-          _blocked_driver_poller(new PipelineDriverPoller(_driver_queue.get())),
-          _exec_state_reporter(new ExecStateReporter()) {}
+        : _thread_pool(std::move(thread_pool)), _exec_state_reporter(new ExecStateReporter()) {}
 
 GlobalDriverDispatcher::~GlobalDriverDispatcher() {
-    _driver_queue->close();
+    if (_driver_queue != nullptr) {
+        _driver_queue->close();
+    }
 }
 
 void GlobalDriverDispatcher::initialize(int num_threads) {
+    if (config::pipeline_enable_resource_group) {
+        _driver_queue = std::make_unique<ResourceGroupDriverQueue>(ResourceGroupManager::instance()->groups());
+    } else if (config::pipeline_enable_work_stealing_driver_queue) {
+        _driver_queue =
+                std::make_unique<WorkStealingDriverQueue>(num_threads, config::pipeline_exec_thread_pin_cores);
+    } else {
+        _driver_queue = std::make_unique<QuerySharedDriverQueue>();
+    }
+    _blocked_driver_poller = std::make_unique<PipelineDriverPoller>(_driver_queue.get());
     _blocked_driver_poller->start();
     _num_threads_setter.set_actual_num(num_threads);
+    _num_threads = num_threads;
     for (auto i = 0; i < num_threads; ++i) {
         _thread_pool->submit_func([this]() { this->run(); });
     }
@@ -27,6 +39,7 @@ void GlobalDriverDispatcher::change_num_threads(int32_t num_threads) {
     if (!_num_threads_setter.adjust_expect_num(num_threads, &old_num_threads)) {
         return;
     }
+    _num_threads = num_threads;
     for (int i = old_num_threads; i < num_threads; ++i) {
         _thread_pool->submit_func([this]() { this->run(); });
     }
@@ -34,7 +47,9 @@ void GlobalDriverDispatcher::change_num_threads(int32_t num_threads) {
 
 void GlobalDriverDispatcher::finalize_driver(DriverRawPtr driver, RuntimeState* runtime_state, DriverState state) {
     DCHECK(driver);
+    driver->trace(DriverTraceEventType::FINISHED);
     driver->finalize(runtime_state, state);
+    _num_drivers.fetch_sub(1, std::memory_order_relaxed);
     if (driver->query_ctx()->is_finished()) {
         auto query_id = driver->query_ctx()->query_id();
         DCHECK(!driver->source_operator()->pending_finish());
@@ -55,10 +70,12 @@ void GlobalDriverDispatcher::run() {
         }
         auto driver = maybe_driver.value();
         DCHECK(driver != nullptr);
+        driver->trace(DriverTraceEventType::RUNNING);
 
         auto* query_ctx = driver->query_ctx();
         auto* fragment_ctx = driver->fragment_ctx();
         auto* runtime_state = fragment_ctx->runtime_state();
+        CurrentThread::set_query_id(query_ctx->query_id());
 
         if (fragment_ctx->is_canceled()) {
             VLOG_ROW << "[Driver] Canceled: driver=" << driver
@@ -66,6 +83,7 @@ void GlobalDriverDispatcher::run() {
             driver->finish_operators(runtime_state);
             if (driver->source_operator()->pending_finish()) {
                 driver->set_driver_state(DriverState::PENDING_FINISH);
+                driver->trace(DriverTraceEventType::BLOCKED);
                 _blocked_driver_poller->add_blocked_driver(driver);
             } else {
                 finalize_driver(driver, runtime_state, DriverState::CANCELED);
@@ -89,6 +107,7 @@ void GlobalDriverDispatcher::run() {
             driver->finish_operators(runtime_state);
             if (driver->source_operator()->pending_finish()) {
                 driver->set_driver_state(DriverState::PENDING_FINISH);
+                driver->trace(DriverTraceEventType::BLOCKED);
                 _blocked_driver_poller->add_blocked_driver(driver);
             } else {
                 finalize_driver(driver, runtime_state, DriverState::INTERNAL_ERROR);
@@ -101,6 +120,7 @@ void GlobalDriverDispatcher::run() {
         case RUNNING: {
             VLOG_ROW << strings::Substitute("[Driver] Push back again, source=$0, state=$1",
                                             driver->source_operator()->get_name(), ds_to_string(driver_state));
+            driver->trace(DriverTraceEventType::READY);
             this->_driver_queue->put_back(driver);
             break;
         }
@@ -119,6 +139,7 @@ void GlobalDriverDispatcher::run() {
         case DEPENDENCIES_BLOCK: {
             VLOG_ROW << strings::Substitute("[Driver] Blocked, source=$0, state=$1",
                                             driver->source_operator()->get_name(), ds_to_string(driver_state));
+            driver->trace(DriverTraceEventType::BLOCKED);
             _blocked_driver_poller->add_blocked_driver(driver);
             break;
         }
@@ -129,10 +150,13 @@ void GlobalDriverDispatcher::run() {
 }
 
 void GlobalDriverDispatcher::dispatch(DriverRawPtr driver) {
+    _num_drivers.fetch_add(1, std::memory_order_relaxed);
     if (driver->dependencies_block()) {
         driver->set_driver_state(DriverState::DEPENDENCIES_BLOCK);
+        driver->trace(DriverTraceEventType::BLOCKED);
         this->_blocked_driver_poller->add_blocked_driver(driver);
     } else {
+        driver->trace(DriverTraceEventType::READY);
         this->_driver_queue->put_back(driver);
     }
 }
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <unordered_map>
 
@@ -28,6 +29,9 @@ public:
     virtual void initialize(int32_t num_threads) {}
     virtual void change_num_threads(int32_t num_threads) {}
     virtual void dispatch(DriverRawPtr driver){};
+    // The number of the drivers dispatched and not finalized yet.
+    virtual size_t num_drivers() const { return 0; }
+    virtual size_t num_threads() const { return 0; }
 
     // When all the root drivers (the drivers have no successors in the same fragment) have finished,
     // just notify FE timely the completeness of fragment via invocation of report_exec_state, but
@@ -44,6 +48,8 @@ public:
     void initialize(int32_t num_threads) override;
     void change_num_threads(int32_t num_threads) override;
     void dispatch(DriverRawPtr driver) override;
+    size_t num_drivers() const override { return _num_drivers.load(std::memory_order_relaxed); }
+    size_t num_threads() const override { return _num_threads.load(std::memory_order_relaxed); }
     void report_exec_state(FragmentContext* fragment_ctx, const Status& status, bool done) override;
 
 private:
@@ -56,6 +62,8 @@ private:
     std::unique_ptr<ThreadPool> _thread_pool;
     PipelineDriverPollerPtr _blocked_driver_poller;
     std::unique_ptr<ExecStateReporter> _exec_state_reporter;
+    std::atomic<size_t> _num_drivers = 0;
+    std::atomic<size_t> _num_threads = 0;
 };
 
 } // namespace pipeline
@@ -26,6 +26,10 @@ void PipelineDriverPoller::run_internal() {
     this->_is_polling_thread_initialized.store(true, std::memory_order_release);
     typeof(this->_blocked_drivers) local_blocked_drivers;
     int spin_count = 0;
+    // the number of drivers that are blocked on operators not notifying their readiness in last round.
+    size_t num_unobservable_drivers = 0;
+    auto last_full_check_time = std::chrono::steady_clock::now();
+    const auto full_check_interval = std::chrono::milliseconds(FULL_CHECK_INTERVAL_MS);
     while (!_is_shutdown.load(std::memory_order_acquire)) {
         {
             std::unique_lock<std::mutex> lock(this->_mutex);
@@ -38,8 +42,23 @@ void PipelineDriverPoller::run_internal() {
                     break;
                 }
                 local_blocked_drivers.splice(local_blocked_drivers.end(), _blocked_drivers);
+            } else if (spin_count > 0 && num_unobservable_drivers == 0) {
+                // all the blocked drivers are waiting for notifications, so sleep until any of them is
+                // notified or new blocked drivers arrive, instead of spinning on the blocked drivers.
+                _cond.wait_for(lock, full_check_interval, [this]() {
+                    return this->_has_notification || !this->_blocked_drivers.empty() ||
+                           this->_is_shutdown.load(std::memory_order_acquire);
+                });
+                local_blocked_drivers.splice(local_blocked_drivers.end(), _blocked_drivers);
             }
+            _has_notification = false;
+        }
+        auto now = std::chrono::steady_clock::now();
+        const bool full_check = now - last_full_check_time >= full_check_interval;
+        if (full_check) {
+            last_full_check_time = now;
         }
+        num_unobservable_drivers = 0;
         size_t previous_num_blocked_drivers = local_blocked_drivers.size();
         auto driver_it = local_blocked_drivers.begin();
         while (driver_it != local_blocked_drivers.end()) {
@@ -54,6 +73,7 @@ void PipelineDriverPoller::run_internal() {
                 // FragmentContext is unregistered prematurely.
                 driver->set_driver_state(driver->fragment_ctx()->is_canceled() ? DriverState::CANCELED
                                                                                : DriverState::FINISH);
+                driver->trace(DriverTraceEventType::READY);
                 _dispatch_queue->put_back(*driver_it);
                 local_blocked_drivers.erase(driver_it++);
             } else if (driver->is_finished()) {
@@ -71,6 +91,7 @@ void PipelineDriverPoller::run_internal() {
                     ++driver_it;
                 } else {
                     driver->set_driver_state(DriverState::FINISH);
+                    driver->trace(DriverTraceEventType::READY);
                     _dispatch_queue->put_back(*driver_it);
                     local_blocked_drivers.erase(driver_it++);
                 }
@@ -83,14 +104,22 @@ void PipelineDriverPoller::run_internal() {
                     ++driver_it;
                 } else {
                     driver->set_driver_state(DriverState::CANCELED);
+                    driver->trace(DriverTraceEventType::READY);
                     _dispatch_queue->put_back(*driver_it);
                     local_blocked_drivers.erase(driver_it++);
                 }
+            } else if (!full_check && driver->is_blocked_on_observables() && !driver->observer()->check_and_reset()) {
+                // nothing observed by the driver has changed since last evaluation.
+                ++driver_it;
             } else if (driver->is_not_blocked()) {
                 driver->set_driver_state(DriverState::READY);
+                driver->trace(DriverTraceEventType::READY);
                 _dispatch_queue->put_back(*driver_it);
                 local_blocked_drivers.erase(driver_it++);
             } else {
+                if (!driver->is_blocked_on_observables()) {
+                    ++num_unobservable_drivers;
+                }
                 ++driver_it;
             }
         }
@@ -116,9 +145,23 @@ void PipelineDriverPoller::run_internal() {
 }
 
 void PipelineDriverPoller::add_blocked_driver(const DriverRawPtr driver) {
+    driver->observer()->set_poller(this);
     std::unique_lock<std::mutex> lock(this->_mutex);
     this->_blocked_drivers.push_back(driver);
     this->_cond.notify_one();
 }
 
+void PipelineDriverPoller::notify() {
+    std::unique_lock<std::mutex> lock(this->_mutex);
+    this->_has_notification = true;
+    this->_cond.notify_one();
+}
+
+void PipelineObserver::notify() {
+    _is_notified.store(true, std::memory_order_release);
+    if (auto* poller = _poller.load(std::memory_order_acquire); poller != nullptr) {
+        poller->notify();
+    }
+}
+
 } // namespace starrocks::pipeline
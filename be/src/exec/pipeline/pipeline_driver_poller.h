@@ -31,6 +31,12 @@ public:
     void shutdown();
     // add blocked driver to poller
     void add_blocked_driver(const DriverRawPtr driver);
+    // wake up the poller thread, invoked when an observable object of blocked drivers changes.
+    void notify();
+
+    // The interval to re-evaluate all the blocked drivers even if they are not notified,
+    // so the cancellation and expiration of fragments are detected timely.
+    static constexpr int64_t FULL_CHECK_INTERVAL_MS = 10;
 
 private:
     void run_internal();
@@ -41,6 +47,7 @@ private:
     std::mutex _mutex;
     std::condition_variable _cond;
     DriverList _blocked_drivers;
+    bool _has_notification = false;
     DriverQueue* _dispatch_queue;
     Thread* _polling_thread;
     std::atomic<bool> _is_polling_thread_initialized;
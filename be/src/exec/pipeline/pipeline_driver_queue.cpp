@@ -2,7 +2,15 @@
 
 #include "exec/pipeline/pipeline_driver_queue.h"
 
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+
+#include "common/logging.h"
 #include "gutil/strings/substitute.h"
+#include "util/cpu_info.h"
+
 namespace starrocks::pipeline {
 void QuerySharedDriverQueue::close() {
     std::unique_lock<std::mutex> lock(_global_mutex);
@@ -69,4 +77,270 @@ SubQuerySharedDriverQueue* QuerySharedDriverQueue::get_sub_queue(size_t index) {
     return _queues + index;
 }
 
+namespace {
+// the local queue owned by the current executor thread.
+thread_local const WorkStealingDriverQueue* tls_owner_queue = nullptr;
+thread_local size_t tls_local_queue_index = 0;
+} // namespace
+
+WorkStealingDriverQueue::WorkStealingDriverQueue(size_t num_local_queues, bool pin_cores) {
+    num_local_queues = std::max<size_t>(1, num_local_queues);
+    _local_queues.reserve(num_local_queues);
+    const int num_cores = pin_cores ? CpuInfo::num_cores() : 0;
+    for (size_t i = 0; i < num_local_queues; ++i) {
+        auto local_queue = std::make_unique<LocalQueue>();
+        if (num_cores > 0) {
+            local_queue->core = static_cast<int>(i % num_cores);
+        }
+        _local_queues.emplace_back(std::move(local_queue));
+    }
+    auto numa_node = [this](size_t index) {
+        int core = _local_queues[index]->core;
+        return core < 0 ? 0 : CpuInfo::get_numa_node_of_core(core);
+    };
+    // steal from the neighbours, and from the ones on the same NUMA node first.
+    for (size_t i = 0; i < num_local_queues; ++i) {
+        auto& steal_order = _local_queues[i]->steal_order;
+        for (size_t j = 1; j < num_local_queues; ++j) {
+            steal_order.push_back((i + j) % num_local_queues);
+        }
+        const int node = numa_node(i);
+        std::stable_partition(steal_order.begin(), steal_order.end(),
+                              [&numa_node, node](size_t j) { return numa_node(j) == node; });
+    }
+    double factor = 1;
+    for (int i = QUEUE_SIZE - 1; i >= 0; --i) {
+        _levels[i].factor_for_normal = factor;
+        factor *= RATIO_OF_ADJACENT_QUEUE;
+    }
+}
+
+void WorkStealingDriverQueue::close() {
+    std::unique_lock<std::mutex> lock(_idle_mutex);
+    _is_closed = true;
+    _cv.notify_all();
+}
+
+size_t WorkStealingDriverQueue::_local_queue_index() {
+    if (tls_owner_queue != this) {
+        tls_owner_queue = this;
+        tls_local_queue_index = _next_worker_index.fetch_add(1) % _local_queues.size();
+        int core = _local_queues[tls_local_queue_index]->core;
+        if (core >= 0) {
+            cpu_set_t cpu_set;
+            CPU_ZERO(&cpu_set);
+            CPU_SET(core, &cpu_set);
+            int ret = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+            LOG_IF(WARNING, ret != 0) << "fail to pin pipeline execution thread to core " << core << ", error=" << ret;
+        }
+    }
+    return tls_local_queue_index;
+}
+
+void WorkStealingDriverQueue::put_back(const DriverRawPtr driver) {
+    size_t index;
+    if (tls_owner_queue == this) {
+        index = tls_local_queue_index;
+    } else if (int64_t last = driver->driver_acct().get_last_local_queue(); last >= 0) {
+        index = last % _local_queues.size();
+    } else {
+        index = _next_put_back_index.fetch_add(1) % _local_queues.size();
+    }
+
+    int level = driver->driver_acct().get_level();
+    auto* local_queue = _local_queues[index].get();
+    {
+        std::lock_guard<std::mutex> lock(local_queue->mutex);
+        local_queue->levels[level % QUEUE_SIZE].emplace_back(driver);
+        local_queue->num_drivers.fetch_add(1);
+    }
+    _num_pending_drivers.fetch_add(1);
+
+    // idle workers increase _num_idle_workers before checking _num_pending_drivers under _idle_mutex,
+    // so either the idle worker observes the new driver, or the driver producer observes the idle worker.
+    if (_num_idle_workers.load() > 0) {
+        std::lock_guard<std::mutex> lock(_idle_mutex);
+        _cv.notify_one();
+    }
+}
+
+bool WorkStealingDriverQueue::_try_take_from(LocalQueue* local_queue, DriverRawPtr* driver, size_t* queue_index) {
+    if (local_queue->num_drivers.load() == 0) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(local_queue->mutex);
+    int queue_idx = -1;
+    double target_accu_time = 0;
+    for (int i = 0; i < QUEUE_SIZE; ++i) {
+        if (!local_queue->levels[i].empty()) {
+            double local_target_time = _levels[i].accu_time_after_divisor();
+            if (queue_idx < 0 || local_target_time < target_accu_time) {
+                target_accu_time = local_target_time;
+                queue_idx = i;
+            }
+        }
+    }
+    if (queue_idx < 0) {
+        return false;
+    }
+
+    *queue_index = queue_idx;
+    *driver = local_queue->levels[queue_idx].front();
+    local_queue->levels[queue_idx].pop_front();
+    local_queue->num_drivers.fetch_sub(1);
+    _num_pending_drivers.fetch_sub(1);
+    return true;
+}
+
+StatusOr<DriverRawPtr> WorkStealingDriverQueue::take(size_t* queue_index) {
+    const size_t local_index = _local_queue_index();
+    DriverRawPtr driver_ptr = nullptr;
+
+    while (true) {
+        if (_is_closed) {
+            return Status::Cancelled("Shutdown");
+        }
+
+        // local queue first, then steal from the other local queues.
+        auto* own_queue = _local_queues[local_index].get();
+        bool taken = _try_take_from(own_queue, &driver_ptr, queue_index);
+        for (size_t i = 0; !taken && i < own_queue->steal_order.size(); ++i) {
+            taken = _try_take_from(_local_queues[own_queue->steal_order[i]].get(), &driver_ptr, queue_index);
+        }
+        if (taken) {
+            driver_ptr->driver_acct().set_last_local_queue(local_index);
+            return driver_ptr;
+        }
+
+        std::unique_lock<std::mutex> lock(_idle_mutex);
+        _num_idle_workers.fetch_add(1);
+        if (!_is_closed && _num_pending_drivers.load() == 0) {
+            _cv.wait(lock);
+        }
+        _num_idle_workers.fetch_sub(1);
+    }
+}
+
+SubQuerySharedDriverQueue* WorkStealingDriverQueue::get_sub_queue(size_t index) {
+    return _levels + index;
+}
+
+ResourceGroupDriverQueue::ResourceGroupDriverQueue(const std::vector<ResourceGroupPtr>& groups) {
+    _groups.reserve(std::max<size_t>(1, groups.size()));
+    for (const auto& group : groups) {
+        auto group_queue = std::make_unique<GroupQueue>();
+        group_queue->cpu_weight = std::max(1, group->cpu_weight());
+        _groups.emplace_back(std::move(group_queue));
+    }
+    if (_groups.empty()) {
+        _groups.emplace_back(std::make_unique<GroupQueue>());
+    }
+    for (auto& group_queue : _groups) {
+        double factor = 1;
+        for (int i = QUEUE_SIZE - 1; i >= 0; --i) {
+            group_queue->levels[i].factor_for_normal = factor;
+            factor *= RATIO_OF_ADJACENT_QUEUE;
+        }
+    }
+}
+
+double ResourceGroupDriverQueue::GroupQueue::vruntime() const {
+    int64_t accu_time = 0;
+    for (const auto& level : levels) {
+        accu_time += level.accu_time();
+    }
+    return static_cast<double>(accu_time) / cpu_weight + vruntime_offset;
+}
+
+void ResourceGroupDriverQueue::close() {
+    std::unique_lock<std::mutex> lock(_global_mutex);
+    _is_closed = true;
+    _cv.notify_all();
+}
+
+size_t ResourceGroupDriverQueue::_group_index(const DriverRawPtr driver) const {
+    const auto* group = driver->query_ctx()->resource_group();
+    if (group == nullptr || group->index() >= _groups.size()) {
+        return 0;
+    }
+    return group->index();
+}
+
+void ResourceGroupDriverQueue::put_back(const DriverRawPtr driver) {
+    const size_t group_index = _group_index(driver);
+    const int level = driver->driver_acct().get_level();
+    std::unique_lock<std::mutex> lock(_global_mutex);
+    auto* group_queue = _groups[group_index].get();
+    if (group_queue->num_drivers == 0) {
+        // the group becomes active, lift its virtual runtime to the least one of the active groups.
+        double min_vruntime = -1;
+        for (const auto& other : _groups) {
+            if (other->num_drivers > 0) {
+                double vruntime = other->vruntime();
+                if (min_vruntime < 0 || vruntime < min_vruntime) {
+                    min_vruntime = vruntime;
+                }
+            }
+        }
+        double vruntime = group_queue->vruntime();
+        if (min_vruntime > vruntime) {
+            group_queue->vruntime_offset += min_vruntime - vruntime;
+        }
+    }
+    group_queue->levels[level % QUEUE_SIZE].queue.emplace(driver);
+    group_queue->num_drivers++;
+    _cv.notify_one();
+}
+
+StatusOr<DriverRawPtr> ResourceGroupDriverQueue::take(size_t* queue_index) {
+    std::unique_lock<std::mutex> lock(_global_mutex);
+    int group_idx = -1;
+    while (true) {
+        if (_is_closed) {
+            return Status::Cancelled("Shutdown");
+        }
+
+        double target_vruntime = 0;
+        for (int i = 0; i < _groups.size(); ++i) {
+            if (_groups[i]->num_drivers > 0) {
+                double vruntime = _groups[i]->vruntime();
+                if (group_idx < 0 || vruntime < target_vruntime) {
+                    target_vruntime = vruntime;
+                    group_idx = i;
+                }
+            }
+        }
+
+        if (group_idx >= 0) {
+            break;
+        }
+        _cv.wait(lock);
+    }
+
+    auto* group_queue = _groups[group_idx].get();
+    int queue_idx = -1;
+    double target_accu_time = 0;
+    for (int i = 0; i < QUEUE_SIZE; ++i) {
+        if (!group_queue->levels[i].queue.empty()) {
+            double local_target_time = group_queue->levels[i].accu_time_after_divisor();
+            if (queue_idx < 0 || local_target_time < target_accu_time) {
+                target_accu_time = local_target_time;
+                queue_idx = i;
+            }
+        }
+    }
+    DCHECK_GE(queue_idx, 0);
+
+    *queue_index = group_idx * QUEUE_SIZE + queue_idx;
+    DriverRawPtr driver_ptr = group_queue->levels[queue_idx].queue.front();
+    group_queue->levels[queue_idx].queue.pop();
+    group_queue->num_drivers--;
+    return driver_ptr;
+}
+
+SubQuerySharedDriverQueue* ResourceGroupDriverQueue::get_sub_queue(size_t index) {
+    return _groups[index / QUEUE_SIZE]->levels + index % QUEUE_SIZE;
+}
+
 } // namespace starrocks::pipeline
@@ -2,9 +2,12 @@
 
 #pragma once
 
+#include <deque>
 #include <queue>
+#include <vector>
 
 #include "exec/pipeline/pipeline_driver.h"
+#include "exec/pipeline/resource_group.h"
 #include "util/factory_method.h"
 namespace starrocks {
 namespace pipeline {
@@ -19,6 +22,8 @@ public:
 
     double accu_time_after_divisor() { return _accu_consume_time.load() / factor_for_normal; }
 
+    int64_t accu_time() const { return _accu_consume_time.load(); }
+
     std::queue<DriverRawPtr> queue;
     // factor for normalization
     double factor_for_normal = 0;
@@ -69,5 +74,115 @@ private:
     std::atomic<bool> _is_empty;
 };
 
+// WorkStealingDriverQueue keeps one local queue per executor thread, so that the drivers put back by an
+// executor thread are taken again by the same thread without touching any shared lock. An executor thread
+// whose local queue is empty steals drivers from the other local queues. Every local queue is split into
+// QUEUE_SIZE levels just like QuerySharedDriverQueue, and the accumulated time of each level is shared by
+// all the local queues, so the priority among levels is the same as the one of QuerySharedDriverQueue.
+//
+// A driver put back by a thread other than the executor threads, e.g. the poller, goes back to the local queue
+// of the thread that ran it last, whose caches are likely still warm with its hash tables and chunks. If
+// |pin_cores| is set, the thread of every local queue is pinned to one core, and the idle threads steal from
+// the local queues on the same NUMA node first.
+class WorkStealingDriverQueue : public FactoryMethod<DriverQueue, WorkStealingDriverQueue> {
+    friend class FactoryMethod<DriverQueue, WorkStealingDriverQueue>;
+
+public:
+    explicit WorkStealingDriverQueue(size_t num_local_queues, bool pin_cores = false);
+    ~WorkStealingDriverQueue() override = default;
+    void close() override;
+
+    static const size_t QUEUE_SIZE = QuerySharedDriverQueue::QUEUE_SIZE;
+    static constexpr double RATIO_OF_ADJACENT_QUEUE = QuerySharedDriverQueue::RATIO_OF_ADJACENT_QUEUE;
+    // put the driver into the local queue of the current executor thread, or into the local queue that
+    // ran it last when the caller is not an executor thread(e.g. poller), or round-robin if it's never run.
+    void put_back(const DriverRawPtr driver) override;
+    // take a driver from the local queue of the current executor thread first, steal from the
+    // other local queues if it is empty, and block if all the local queues are empty.
+    // return Status::Cancelled if queue is closed;
+    StatusOr<DriverRawPtr> take(size_t* queue_index) override;
+    // the returned sub queue is only used to accumulate the execution time of each level.
+    SubQuerySharedDriverQueue* get_sub_queue(size_t) override;
+
+    size_t num_local_queues() const { return _local_queues.size(); }
+
+private:
+    struct LocalQueue {
+        std::mutex mutex;
+        std::deque<DriverRawPtr> levels[QUEUE_SIZE];
+        // the number of drivers in this local queue, read without holding mutex.
+        std::atomic<size_t> num_drivers = 0;
+        // the core the threads of this local queue are pinned to, -1 if not pinned.
+        int core = -1;
+        // the other local queues to steal from in order, the ones on the same NUMA node first.
+        std::vector<size_t> steal_order;
+    };
+
+    // the index of local queue owned by the current thread, assigned at the first time when take is invoked,
+    // when the thread is pinned to the core of the local queue if any.
+    size_t _local_queue_index();
+    // take a driver from the level of the local queue with the least normalized accumulated time.
+    bool _try_take_from(LocalQueue* local_queue, DriverRawPtr* driver, size_t* queue_index);
+
+    std::vector<std::unique_ptr<LocalQueue>> _local_queues;
+    // only accu time of these sub queues is used, drivers are kept in local queues.
+    SubQuerySharedDriverQueue _levels[QUEUE_SIZE];
+
+    std::atomic<size_t> _next_worker_index = 0;
+    std::atomic<size_t> _next_put_back_index = 0;
+
+    // idle executor threads sleep on _cv when there is no driver in any local queue.
+    std::mutex _idle_mutex;
+    std::condition_variable _cv;
+    std::atomic<size_t> _num_pending_drivers = 0;
+    std::atomic<size_t> _num_idle_workers = 0;
+    std::atomic<bool> _is_closed = false;
+};
+
+// ResourceGroupDriverQueue shares the execution threads among the resource groups in proportion to their
+// cpu weights. Every group is split into QUEUE_SIZE levels just like QuerySharedDriverQueue. take() chooses
+// the group with the least virtual runtime, i.e. the accumulated execution time of the group divided by its
+// cpu weight, and then chooses the level of the group in the same way as QuerySharedDriverQueue.
+// The virtual runtime of a group that becomes active again is lifted to the least one of the active groups,
+// otherwise a group idle for a long time would monopolize the execution threads until it catches up.
+class ResourceGroupDriverQueue : public FactoryMethod<DriverQueue, ResourceGroupDriverQueue> {
+    friend class FactoryMethod<DriverQueue, ResourceGroupDriverQueue>;
+
+public:
+    explicit ResourceGroupDriverQueue(const std::vector<ResourceGroupPtr>& groups);
+    ~ResourceGroupDriverQueue() override = default;
+    void close() override;
+
+    static const size_t QUEUE_SIZE = QuerySharedDriverQueue::QUEUE_SIZE;
+    static constexpr double RATIO_OF_ADJACENT_QUEUE = QuerySharedDriverQueue::RATIO_OF_ADJACENT_QUEUE;
+    void put_back(const DriverRawPtr driver) override;
+    // *queue_index is set to group_index * QUEUE_SIZE + level.
+    // return Status::Cancelled if queue is closed;
+    StatusOr<DriverRawPtr> take(size_t* queue_index) override;
+    SubQuerySharedDriverQueue* get_sub_queue(size_t) override;
+
+    size_t num_groups() const { return _groups.size(); }
+
+private:
+    struct GroupQueue {
+        double vruntime() const;
+
+        int cpu_weight = 1;
+        SubQuerySharedDriverQueue levels[QUEUE_SIZE];
+        // the number of drivers in all the levels of this group.
+        size_t num_drivers = 0;
+        // added to the virtual runtime, only increased when the group becomes active.
+        double vruntime_offset = 0;
+    };
+
+    // the drivers of queries without resource group belong to the default group.
+    size_t _group_index(const DriverRawPtr driver) const;
+
+    std::vector<std::unique_ptr<GroupQueue>> _groups;
+    std::mutex _global_mutex;
+    std::condition_variable _cv;
+    bool _is_closed = false;
+};
+
 } // namespace pipeline
 } // namespace starrocks
@@ -0,0 +1,65 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace starrocks::pipeline {
+class PipelineDriverPoller;
+
+// PipelineObserver is owned by a PipelineDriver and registered into the PipelineObservable objects that
+// determine whether the driver is blocked, e.g. the receiver of ExchangeSourceOperator. When the state of
+// an observable object changes, the observer is marked as notified and PipelineDriverPoller is woken up,
+// so the poller only re-evaluates the blocked drivers whose observed objects have changed.
+class PipelineObserver {
+public:
+    PipelineObserver() = default;
+
+    void set_poller(PipelineDriverPoller* poller) { _poller.store(poller, std::memory_order_release); }
+
+    // Defined in pipeline_driver_poller.cpp.
+    void notify();
+
+    // return true if the observer has been notified since last invocation.
+    bool check_and_reset() { return _is_notified.exchange(false, std::memory_order_acq_rel); }
+
+private:
+    std::atomic<bool> _is_notified{true};
+    std::atomic<PipelineDriverPoller*> _poller{nullptr};
+};
+
+class PipelineObservable {
+public:
+    void add_observer(PipelineObserver* observer) {
+        std::lock_guard<std::mutex> l(_mutex);
+        _observers.push_back(observer);
+    }
+
+    // Observers must be removed before they are destructed when the observable object
+    // outlives the drivers, e.g. DataStreamRecvr referenced by brpc threads.
+    void remove_observer(PipelineObserver* observer) {
+        std::lock_guard<std::mutex> l(_mutex);
+        _observers.erase(std::remove(_observers.begin(), _observers.end(), observer), _observers.end());
+    }
+
+    void clear_observers() {
+        std::lock_guard<std::mutex> l(_mutex);
+        _observers.clear();
+    }
+
+    void notify_observers() {
+        std::lock_guard<std::mutex> l(_mutex);
+        for (auto* observer : _observers) {
+            observer->notify();
+        }
+    }
+
+private:
+    std::mutex _mutex;
+    std::vector<PipelineObserver*> _observers;
+};
+
+} // namespace starrocks::pipeline
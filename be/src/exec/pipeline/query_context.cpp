@@ -1,11 +1,31 @@
 // This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
 #include "exec/pipeline/query_context.h"
 
+#include <sstream>
+
+#include "column/column_pool.h"
 #include "exec/pipeline/fragment_context.h"
+#include "gutil/strings/substitute.h"
+#include "util/pretty_printer.h"
+#include "util/time.h"
 
 namespace starrocks::pipeline {
 QueryContext::QueryContext()
-        : _fragment_mgr(new FragmentContextManager()), _num_fragments(0), _num_active_fragments(0) {}
+        : _fragment_mgr(new FragmentContextManager()),
+          _num_fragments(0),
+          _num_active_fragments(0),
+          _start_ms(MonotonicMillis()),
+          _last_mem_sample_ms(_start_ms),
+          _mem_sample_interval_ms(config::pipeline_query_mem_timeline_interval_ms) {}
+
+QueryContext::~QueryContext() {
+    if (_resource_group != nullptr) {
+        _resource_group->release_query();
+    }
+    // The columns this query returned to the central column pool keep the capacity of its largest
+    // strings, shrink them so that they are not cached beyond the lifetime of the query.
+    vectorized::release_large_free_columns<vectorized::BinaryColumn>(config::vector_chunk_size * 512);
+}
 
 FragmentContextManager* QueryContext::fragment_mgr() {
     return _fragment_mgr.get();
@@ -15,6 +35,63 @@ void QueryContext::cancel(const Status& status) {
     _fragment_mgr->cancel(status);
 }
 
+Status QueryContext::set_resource_group(ResourceGroup* group) {
+    std::lock_guard lock(_resource_group_lock);
+    if (_resource_group != nullptr) {
+        return Status::OK();
+    }
+    if (!group->try_acquire_query()) {
+        return Status::TooManyTasks(strings::Substitute("resource group $0 has already run $1 queries", group->name(),
+                                                        group->max_concurrency()));
+    }
+    _resource_group = group;
+    return Status::OK();
+}
+
+void QueryContext::update_mem_usage(int64_t delta) {
+    const int64_t usage = _mem_usage.fetch_add(delta, std::memory_order_relaxed) + delta;
+    int64_t peak = _peak_mem_usage.load(std::memory_order_relaxed);
+    while (usage > peak && !_peak_mem_usage.compare_exchange_weak(peak, usage, std::memory_order_relaxed)) {
+    }
+
+    const int64_t interval = _mem_sample_interval_ms.load(std::memory_order_relaxed);
+    if (interval <= 0) {
+        return;
+    }
+    const int64_t now = MonotonicMillis();
+    int64_t last = _last_mem_sample_ms.load(std::memory_order_relaxed);
+    if (now - last < interval || !_last_mem_sample_ms.compare_exchange_strong(last, now)) {
+        return;
+    }
+    std::lock_guard l(_mem_timeline_lock);
+    if (_mem_timeline.size() >= kMaxMemTimelineSize) {
+        // Keep every other sample and sample at half the rate from now on.
+        size_t j = 0;
+        for (size_t i = 0; i < _mem_timeline.size(); i += 2) {
+            _mem_timeline[j++] = _mem_timeline[i];
+        }
+        _mem_timeline.resize(j);
+        _mem_sample_interval_ms.store(interval * 2, std::memory_order_relaxed);
+    }
+    _mem_timeline.emplace_back(now - _start_ms, usage);
+}
+
+std::vector<std::pair<int64_t, int64_t>> QueryContext::mem_usage_timeline() {
+    std::lock_guard l(_mem_timeline_lock);
+    return _mem_timeline;
+}
+
+std::string QueryContext::mem_usage_timeline_string() {
+    std::stringstream ss;
+    for (const auto& [ms, bytes] : mem_usage_timeline()) {
+        if (ss.tellp() > 0) {
+            ss << ", ";
+        }
+        ss << ms << "ms:" << PrettyPrinter::print(bytes, TUnit::BYTES);
+    }
+    return ss.str();
+}
+
 QueryContextManager::QueryContextManager() = default;
 QueryContextManager::~QueryContextManager() = default;
 QueryContext* QueryContextManager::get_or_register(const TUniqueId& query_id) {
@@ -28,6 +105,7 @@ QueryContext* QueryContextManager::get_or_register(const TUniqueId& query_id) {
     auto&& ctx = std::make_shared<QueryContext>();
     auto* ctx_raw_ptr = ctx.get();
     ctx_raw_ptr->set_query_id(query_id);
+    ctx_raw_ptr->set_driver_trace(DriverTracer::instance()->start_query(query_id));
     ctx_raw_ptr->increment_num_fragments();
     _contexts.emplace(query_id, std::move(ctx));
     return ctx_raw_ptr;
@@ -6,9 +6,13 @@
 #include <chrono>
 #include <mutex>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
+#include "exec/pipeline/driver_tracer.h"
 #include "exec/pipeline/fragment_context.h"
 #include "exec/pipeline/pipeline_fwd.h"
+#include "exec/pipeline/resource_group.h"
 #include "gen_cpp/InternalService_types.h" // for TQueryOptions
 #include "gen_cpp/Types_types.h"           // for TUniqueId
 #include "runtime/mem_tracker.h"
@@ -27,6 +31,7 @@ using std::chrono::duration_cast;
 class QueryContext {
 public:
     QueryContext();
+    ~QueryContext();
     void set_query_id(const TUniqueId& query_id) { _query_id = query_id; }
     TUniqueId query_id() { return _query_id; }
     RuntimeState* runtime_state() { return _runtime_state.get(); }
@@ -58,6 +63,28 @@ public:
 
     void cancel(const Status& status);
 
+    // Assign the query to |group|, only the first fragment of the query takes effect.
+    // Return Status::TooManyTasks if the group has already run max_concurrency queries.
+    Status set_resource_group(ResourceGroup* group);
+    // nullptr if resource group is disabled.
+    ResourceGroup* resource_group() const { return _resource_group; }
+
+    // nullptr unless the scheduling of the drivers of this query is traced.
+    DriverTraceBuffer* driver_trace() const { return _driver_trace.get(); }
+    void set_driver_trace(DriverTraceBufferPtr driver_trace) { _driver_trace = std::move(driver_trace); }
+
+    // The memory of the operators of all the drivers of the query in this BE, which is reported by the drivers
+    // after every time slice. It's sampled into a timeline every config::pipeline_query_mem_timeline_interval_ms.
+    void update_mem_usage(int64_t delta);
+    int64_t mem_usage() const { return _mem_usage.load(std::memory_order_relaxed); }
+    int64_t peak_mem_usage() const { return _peak_mem_usage.load(std::memory_order_relaxed); }
+    // The samples of the timeline as (milliseconds since the query started, bytes).
+    std::vector<std::pair<int64_t, int64_t>> mem_usage_timeline();
+    // e.g. "0ms:1.00 MB, 100ms:12.50 MB".
+    std::string mem_usage_timeline_string();
+
+    static constexpr size_t kMaxMemTimelineSize = 1024;
+
 private:
     std::unique_ptr<RuntimeState> _runtime_state;
     std::shared_ptr<RuntimeProfile> _runtime_profile;
@@ -70,6 +97,18 @@ private:
     std::atomic<size_t> _num_active_fragments;
     int64_t _deadline;
     seconds _expire_seconds;
+    std::mutex _resource_group_lock;
+    ResourceGroup* _resource_group = nullptr;
+    DriverTraceBufferPtr _driver_trace;
+
+    const int64_t _start_ms;
+    std::atomic<int64_t> _mem_usage{0};
+    std::atomic<int64_t> _peak_mem_usage{0};
+    // The time of the last sample, only the thread advancing it takes the sample.
+    std::atomic<int64_t> _last_mem_sample_ms{0};
+    std::atomic<int64_t> _mem_sample_interval_ms{0};
+    std::mutex _mem_timeline_lock;
+    std::vector<std::pair<int64_t, int64_t>> _mem_timeline;
 };
 
 class QueryContextManager {
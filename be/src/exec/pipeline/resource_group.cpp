@@ -0,0 +1,72 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/resource_group.h"
+
+#include "common/config.h"
+#include "common/logging.h"
+#include "gutil/strings/numbers.h"
+#include "gutil/strings/split.h"
+#include "gutil/strings/substitute.h"
+
+namespace starrocks::pipeline {
+
+bool ResourceGroup::try_acquire_query() {
+    int num_queries = _num_running_queries.fetch_add(1) + 1;
+    if (_max_concurrency > 0 && num_queries > _max_concurrency) {
+        _num_running_queries.fetch_sub(1);
+        return false;
+    }
+    return true;
+}
+
+ResourceGroupManager::ResourceGroupManager() {
+    Status st = parse_groups(config::pipeline_resource_groups, &_groups);
+    if (!st.ok()) {
+        LOG(WARNING) << "invalid pipeline_resource_groups, only the default group is used: " << st.to_string();
+        _groups.clear();
+        _groups.emplace_back(std::make_unique<ResourceGroup>(DEFAULT_GROUP_NAME, 0, 1, 0));
+    }
+}
+
+ResourceGroupManager::~ResourceGroupManager() = default;
+
+Status ResourceGroupManager::parse_groups(const std::string& conf, std::vector<ResourceGroupPtr>* groups) {
+    groups->clear();
+    groups->emplace_back(std::make_unique<ResourceGroup>(DEFAULT_GROUP_NAME, 0, 1, 0));
+    for (const std::string& group_conf : strings::Split(conf, ";", strings::SkipWhitespace())) {
+        std::vector<std::string> fields = strings::Split(group_conf, ":");
+        int32_t cpu_weight = 0;
+        int32_t max_concurrency = 0;
+        bool valid = fields.size() >= 2 && fields.size() <= 3 && !fields[0].empty() &&
+                     safe_strto32(fields[1], &cpu_weight) && cpu_weight > 0;
+        if (valid && fields.size() == 3) {
+            valid = safe_strto32(fields[2], &max_concurrency) && max_concurrency >= 0;
+        }
+        if (!valid) {
+            return Status::InvalidArgument(strings::Substitute("invalid resource group: $0", group_conf));
+        }
+
+        if (fields[0] == DEFAULT_GROUP_NAME) {
+            (*groups)[0] = std::make_unique<ResourceGroup>(DEFAULT_GROUP_NAME, 0, cpu_weight, max_concurrency);
+            continue;
+        }
+        for (const auto& group : *groups) {
+            if (group->name() == fields[0]) {
+                return Status::InvalidArgument(strings::Substitute("duplicate resource group: $0", fields[0]));
+            }
+        }
+        groups->emplace_back(std::make_unique<ResourceGroup>(fields[0], groups->size(), cpu_weight, max_concurrency));
+    }
+    return Status::OK();
+}
+
+ResourceGroup* ResourceGroupManager::get(const std::string& name) const {
+    for (const auto& group : _groups) {
+        if (group->name() == name) {
+            return group.get();
+        }
+    }
+    return _groups[0].get();
+}
+
+} // namespace starrocks::pipeline
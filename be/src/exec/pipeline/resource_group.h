@@ -0,0 +1,67 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/status.h"
+#include "storage/olap_define.h"
+
+namespace starrocks {
+namespace pipeline {
+
+// A resource group isolates the queries of one workload from the others in pipeline engine.
+// The drivers of the queries in one group are scheduled by ResourceGroupDriverQueue, which shares
+// the execution threads among the groups in proportion to cpu_weight.
+// max_concurrency limits the number of queries running in the group on this BE, 0 means unlimited.
+class ResourceGroup {
+public:
+    ResourceGroup(std::string name, size_t index, int cpu_weight, int max_concurrency)
+            : _name(std::move(name)), _index(index), _cpu_weight(cpu_weight), _max_concurrency(max_concurrency) {}
+
+    const std::string& name() const { return _name; }
+    // the index of group in ResourceGroupManager::groups().
+    size_t index() const { return _index; }
+    int cpu_weight() const { return _cpu_weight; }
+    int max_concurrency() const { return _max_concurrency; }
+
+    // return false if there are already max_concurrency queries in the group.
+    bool try_acquire_query();
+    void release_query() { _num_running_queries.fetch_sub(1); }
+    int num_running_queries() const { return _num_running_queries.load(); }
+
+private:
+    const std::string _name;
+    const size_t _index;
+    const int _cpu_weight;
+    const int _max_concurrency;
+    std::atomic<int> _num_running_queries = 0;
+};
+
+using ResourceGroupPtr = std::unique_ptr<ResourceGroup>;
+
+class ResourceGroupManager {
+    DECLARE_SINGLETON(ResourceGroupManager);
+
+public:
+    static constexpr const char* DEFAULT_GROUP_NAME = "default";
+
+    // Parse the groups defined by |conf| in format "name:cpu_weight[:max_concurrency];...",
+    // e.g. "interactive:8;etl:2:4". The first group is always the default group, whose
+    // cpu_weight is 1 and max_concurrency is 0 unless it is defined in |conf| explicitly.
+    static Status parse_groups(const std::string& conf, std::vector<ResourceGroupPtr>* groups);
+
+    // return the default group if there is no group named |name|.
+    ResourceGroup* get(const std::string& name) const;
+    const std::vector<ResourceGroupPtr>& groups() const { return _groups; }
+
+private:
+    // the groups are defined by config::pipeline_resource_groups, and never changed.
+    std::vector<ResourceGroupPtr> _groups;
+};
+
+} // namespace pipeline
+} // namespace starrocks
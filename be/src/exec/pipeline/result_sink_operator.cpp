@@ -6,6 +6,7 @@
 #include "exprs/expr.h"
 #include "runtime/buffer_control_block.h"
 #include "runtime/exec_env.h"
+#include "runtime/file_result_writer.h"
 #include "runtime/mysql_result_writer.h"
 #include "runtime/result_buffer_mgr.h"
 #include "runtime/runtime_state.h"
@@ -17,14 +18,19 @@ Status ResultSinkOperator::prepare(RuntimeState* state) {
     // Create profile
     _profile = std::make_unique<RuntimeProfile>("result sink");
 
-    // Create sender
-    RETURN_IF_ERROR(state->exec_env()->result_mgr()->create_sender(state->fragment_instance_id(), 1024, &_sender));
-
     // Create writer based on sink type
     switch (_sink_type) {
     case TResultSinkType::MYSQL_PROTOCAL:
         _writer = std::make_shared<MysqlResultWriter>(_sender.get(), _output_expr_ctxs, _profile.get());
         break;
+    case TResultSinkType::FILE:
+        DCHECK(_file_opts != nullptr);
+        if (_file_opts->file_format != TFileFormatType::FORMAT_PARQUET) {
+            return Status::NotSupported("only parquet files are written by pipeline engine");
+        }
+        _writer = std::make_shared<FileResultWriter>(_file_opts.get(), _output_expr_ctxs, _profile.get(),
+                                                     _driver_sequence);
+        break;
     default:
         return Status::InternalError("Unknown result sink type");
     }
@@ -38,18 +44,17 @@ Status ResultSinkOperator::close(RuntimeState* state) {
     // Close the writer
     if (_writer != nullptr) {
         st = _writer->close();
+        _num_written_rows += _writer->get_written_rows();
     }
 
-    // Close sender
-    if (_sender != nullptr) {
-        if (_writer != nullptr) {
-            _sender->update_num_written_rows(_writer->get_written_rows());
-        }
+    // Close sender by the last closed operator, after all the rows have been added.
+    if (--_num_result_sinks == 0) {
+        _sender->update_num_written_rows(_num_written_rows);
         _sender->close(st);
-    }
 
-    state->exec_env()->result_mgr()->cancel_at_time(time(nullptr) + config::result_buffer_cancelled_interval_time,
-                                                    state->fragment_instance_id());
+        state->exec_env()->result_mgr()->cancel_at_time(
+                time(nullptr) + config::result_buffer_cancelled_interval_time, state->fragment_instance_id());
+    }
 
     Operator::close(state);
     return Status::OK();
@@ -80,6 +85,9 @@ Status ResultSinkOperator::push_chunk(RuntimeState* state, const vectorized::Chu
     if (!_last_error.ok()) {
         return _last_error;
     }
+    if (_sink_type == TResultSinkType::FILE) {
+        return _writer->append_chunk(chunk.get());
+    }
     DCHECK(!_fetch_data_result);
     auto* mysql_writer = down_cast<MysqlResultWriter*>(_writer.get());
     auto status = mysql_writer->process_chunk(chunk.get());
@@ -91,6 +99,9 @@ Status ResultSinkOperator::push_chunk(RuntimeState* state, const vectorized::Chu
     }
 }
 Status ResultSinkOperatorFactory::prepare(RuntimeState* state) {
+    // Create sender shared by all the operators
+    RETURN_IF_ERROR(state->exec_env()->result_mgr()->create_sender(state->fragment_instance_id(), 1024, &_sender));
+
     RETURN_IF_ERROR(Expr::create_expr_trees(state->obj_pool(), _t_output_expr, &_output_expr_ctxs));
     RowDescriptor row_desc;
     RETURN_IF_ERROR(Expr::prepare(_output_expr_ctxs, state, row_desc));
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <utility>
 
 #include "exec/pipeline/operator.h"
@@ -11,13 +12,26 @@ namespace starrocks {
 class BufferControlBlock;
 class ExprContext;
 class ResultWriter;
+struct ResultFileOptions;
 
 namespace pipeline {
+// The result sink operators of all the drivers serialize their chunks into mysql rows in parallel,
+// and add the rows to the same BufferControlBlock, which is closed by the last closed operator.
+// For the FILE sink, every driver writes its own parquet files, named by its driver sequence.
 class ResultSinkOperator final : public Operator {
 public:
     ResultSinkOperator(int32_t id, int32_t plan_node_id, TResultSinkType::type sink_type,
-                       const std::vector<ExprContext*>& output_expr_ctxs)
-            : Operator(id, "result_sink", plan_node_id), _sink_type(sink_type), _output_expr_ctxs(output_expr_ctxs) {}
+                       const std::vector<ExprContext*>& output_expr_ctxs, std::shared_ptr<BufferControlBlock> sender,
+                       std::atomic<int32_t>& num_result_sinks, std::atomic<int64_t>& num_written_rows,
+                       std::shared_ptr<ResultFileOptions> file_opts, int32_t driver_sequence)
+            : Operator(id, "result_sink", plan_node_id),
+              _sink_type(sink_type),
+              _file_opts(std::move(file_opts)),
+              _driver_sequence(driver_sequence),
+              _output_expr_ctxs(output_expr_ctxs),
+              _sender(std::move(sender)),
+              _num_result_sinks(num_result_sinks),
+              _num_written_rows(num_written_rows) {}
 
     ~ResultSinkOperator() override = default;
 
@@ -41,8 +55,14 @@ public:
 
 private:
     TResultSinkType::type _sink_type;
+    std::shared_ptr<ResultFileOptions> _file_opts;
+    const int32_t _driver_sequence;
     std::vector<ExprContext*> _output_expr_ctxs;
     std::shared_ptr<BufferControlBlock> _sender;
+    // The number of the operators not closed yet, and the rows written by all the operators,
+    // both are shared by all the operators created by the same factory.
+    std::atomic<int32_t>& _num_result_sinks;
+    std::atomic<int64_t>& _num_written_rows;
     std::shared_ptr<ResultWriter> _writer;
     std::unique_ptr<RuntimeProfile> _profile = nullptr;
     mutable TFetchDataResultPtr _fetch_data_result;
@@ -53,15 +73,20 @@ private:
 class ResultSinkOperatorFactory final : public OperatorFactory {
 public:
     ResultSinkOperatorFactory(int32_t id, int32_t plan_node_id, TResultSinkType::type sink_type,
-                              std::vector<TExpr> t_output_expr)
+                              std::vector<TExpr> t_output_expr, std::shared_ptr<ResultFileOptions> file_opts = nullptr)
             : OperatorFactory(id, "result_sink", plan_node_id),
               _sink_type(sink_type),
-              _t_output_expr(std::move(t_output_expr)) {}
+              _t_output_expr(std::move(t_output_expr)),
+              _file_opts(std::move(file_opts)) {}
 
     ~ResultSinkOperatorFactory() override = default;
 
     OperatorPtr create(int32_t degree_of_parallelism, int32_t driver_sequence) override {
-        return std::make_shared<ResultSinkOperator>(_id, _plan_node_id, _sink_type, _output_expr_ctxs);
+        // Each driver has its own result sink operator, all of them must be closed before closing the sender.
+        _num_result_sinks = degree_of_parallelism;
+        return std::make_shared<ResultSinkOperator>(_id, _plan_node_id, _sink_type, _output_expr_ctxs, _sender,
+                                                    _num_result_sinks, _num_written_rows, _file_opts,
+                                                    driver_sequence);
     }
 
     Status prepare(RuntimeState* state) override;
@@ -71,7 +96,12 @@ public:
 private:
     TResultSinkType::type _sink_type;
     std::vector<TExpr> _t_output_expr;
+    // set when the sink type is FILE.
+    std::shared_ptr<ResultFileOptions> _file_opts;
     std::vector<ExprContext*> _output_expr_ctxs;
+    std::shared_ptr<BufferControlBlock> _sender;
+    std::atomic<int32_t> _num_result_sinks = 0;
+    std::atomic<int64_t> _num_written_rows = 0;
 };
 
 } // namespace pipeline
@@ -4,6 +4,7 @@
 
 #include "column/chunk.h"
 #include "exec/pipeline/olap_chunk_source.h"
+#include "runtime/current_thread.h"
 #include "runtime/exec_env.h"
 #include "runtime/runtime_state.h"
 
@@ -23,12 +24,12 @@ void ScanOperator::_pickup_morsel(RuntimeState* state) {
         DCHECK(morsel);
         _chunk_source = starrocks::make_exclusive<OlapChunkSource>(
                 std::move(morsel), _olap_scan_node.tuple_id, _conjunct_ctxs, _runtime_profile.get(), _runtime_filters,
-                _olap_scan_node.key_column_name, _olap_scan_node.is_preaggregation);
+                _olap_scan_node.key_column_name, _olap_scan_node.is_preaggregation, _scan_result_cache_digest);
         _chunk_source->prepare(state);
-        _trigger_read_chunk();
+        _trigger_read_chunk(state);
     }
 }
-void ScanOperator::_trigger_read_chunk() {
+void ScanOperator::_trigger_read_chunk(RuntimeState* state) {
     if (_io_threads == nullptr) {
         return;
     }
@@ -40,8 +41,10 @@ void ScanOperator::_trigger_read_chunk() {
     _pending_chunk_source_future = chunk_source_promise->get_future();
     PriorityThreadPool::Task task;
 
-    task.work_function = [chunk_source, chunk_source_promise]() {
+    task.work_function = [chunk_source, chunk_source_promise, query_id = state->query_id()]() {
+        CurrentThread::set_query_id(query_id);
         chunk_source->cache_next_chunk_blocking();
+        CurrentThread::set_query_id(TUniqueId());
         chunk_source_promise->set_value(chunk_source);
     };
     // TODO(by satanson): set a proper priority
@@ -160,7 +163,7 @@ StatusOr<vectorized::ChunkPtr> ScanOperator::_pull_chunk_nonblocking(RuntimeStat
     _pending_chunk_source_future = {};
     auto chunk = _chunk_source->get_next_chunk_nonblocking();
     if (chunk.ok()) {
-        _trigger_read_chunk();
+        _trigger_read_chunk(state);
         return chunk;
     }
     if (!chunk.status().is_end_of_file()) {
@@ -17,11 +17,13 @@ class ScanOperator final : public SourceOperator {
 public:
     ScanOperator(int32_t id, int32_t plan_node_id, const TOlapScanNode& olap_scan_node,
                  const std::vector<ExprContext*>& conjunct_ctxs,
-                 const vectorized::RuntimeFilterProbeCollector& runtime_filters)
+                 const vectorized::RuntimeFilterProbeCollector& runtime_filters,
+                 const std::string& scan_result_cache_digest)
             : SourceOperator(id, "olap_scan", plan_node_id),
               _olap_scan_node(olap_scan_node),
               _conjunct_ctxs(conjunct_ctxs),
-              _runtime_filters(runtime_filters) {}
+              _runtime_filters(runtime_filters),
+              _scan_result_cache_digest(scan_result_cache_digest) {}
 
     ~ScanOperator() override = default;
 
@@ -42,7 +44,7 @@ public:
 
 private:
     void _pickup_morsel(RuntimeState* state);
-    void _trigger_read_chunk();
+    void _trigger_read_chunk(RuntimeState* state);
     bool _has_output_blocking() const;
     bool _has_output_nonblocking() const;
     StatusOr<vectorized::ChunkPtr> _pull_chunk_blocking(RuntimeState* state);
@@ -53,6 +55,7 @@ private:
     const TOlapScanNode& _olap_scan_node;
     const std::vector<ExprContext*>& _conjunct_ctxs;
     const vectorized::RuntimeFilterProbeCollector& _runtime_filters;
+    const std::string& _scan_result_cache_digest;
     PriorityThreadPool* _io_threads = nullptr;
     OptionalChunkSourceFuture _pending_chunk_source_future;
 };
@@ -61,16 +64,19 @@ class ScanOperatorFactory final : public SourceOperatorFactory {
 public:
     ScanOperatorFactory(int32_t id, int32_t plan_node_id, const TOlapScanNode& olap_scan_node,
                         std::vector<ExprContext*>&& conjunct_ctxs,
-                        vectorized::RuntimeFilterProbeCollector&& runtime_filters)
+                        vectorized::RuntimeFilterProbeCollector&& runtime_filters,
+                        std::string scan_result_cache_digest)
             : SourceOperatorFactory(id, "olap_scan", plan_node_id),
               _olap_scan_node(olap_scan_node),
               _conjunct_ctxs(std::move(conjunct_ctxs)),
-              _runtime_filters(std::move(runtime_filters)) {}
+              _runtime_filters(std::move(runtime_filters)),
+              _scan_result_cache_digest(std::move(scan_result_cache_digest)) {}
 
     ~ScanOperatorFactory() override = default;
 
     OperatorPtr create(int32_t degree_of_parallelism, int32_t driver_sequence) override {
-        return std::make_shared<ScanOperator>(_id, _plan_node_id, _olap_scan_node, _conjunct_ctxs, _runtime_filters);
+        return std::make_shared<ScanOperator>(_id, _plan_node_id, _olap_scan_node, _conjunct_ctxs, _runtime_filters,
+                                              _scan_result_cache_digest);
     }
 
     // ScanOperator needs to attach MorselQueue.
@@ -83,6 +89,8 @@ private:
     const TOlapScanNode& _olap_scan_node;
     std::vector<ExprContext*> _conjunct_ctxs;
     vectorized::RuntimeFilterProbeCollector _runtime_filters;
+    // The digest identifying the output of the scan for ScanResultCache, empty if not cacheable.
+    std::string _scan_result_cache_digest;
 };
 
 } // namespace pipeline
@@ -0,0 +1,87 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/scan_result_cache.h"
+
+#include "column/chunk.h"
+#include "common/config.h"
+#include "runtime/exec_env.h"
+#include "runtime/mem_tracker.h"
+
+namespace starrocks::pipeline {
+
+ScanResultCache* ScanResultCache::instance() {
+    static ScanResultCache s_instance(std::max<int64_t>(config::pipeline_scan_result_cache_capacity, 0),
+                                      ExecEnv::GetInstance()->scan_result_cache_mem_tracker());
+    return &s_instance;
+}
+
+std::string ScanResultCache::make_key(const std::string& digest, int64_t tablet_id, int64_t version) {
+    std::string key;
+    key.reserve(digest.size() + 2 * sizeof(int64_t));
+    key.append(digest);
+    key.append(reinterpret_cast<const char*>(&tablet_id), sizeof(tablet_id));
+    key.append(reinterpret_cast<const char*>(&version), sizeof(version));
+    return key;
+}
+
+ScanResultCache::ChunksPtr ScanResultCache::lookup(const std::string& key) {
+    std::lock_guard lock(_lock);
+    auto iter = _entries.find(key);
+    if (iter == _entries.end()) {
+        return nullptr;
+    }
+    _lru.splice(_lru.begin(), _lru, iter->second);
+    return iter->second->chunks;
+}
+
+void ScanResultCache::insert(const std::string& key, Chunks chunks) {
+    size_t bytes = key.size();
+    for (const auto& chunk : chunks) {
+        bytes += chunk->memory_usage();
+    }
+
+    std::lock_guard lock(_lock);
+    if (bytes > _capacity) {
+        return;
+    }
+    auto iter = _entries.find(key);
+    if (iter != _entries.end()) {
+        _release(iter->second->bytes);
+        _lru.erase(iter->second);
+        _entries.erase(iter);
+    }
+    if (_mem_tracker != nullptr && _mem_tracker->any_limit_exceeded()) {
+        return;
+    }
+    _lru.push_front(Entry{key, std::make_shared<const Chunks>(std::move(chunks)), bytes});
+    _entries.emplace(key, _lru.begin());
+    _memory_usage += bytes;
+    if (_mem_tracker != nullptr) {
+        _mem_tracker->consume(bytes);
+    }
+    _evict();
+}
+
+void ScanResultCache::set_capacity(size_t capacity) {
+    std::lock_guard lock(_lock);
+    _capacity = capacity;
+    _evict();
+}
+
+void ScanResultCache::_evict() {
+    while (_memory_usage > _capacity) {
+        const Entry& entry = _lru.back();
+        _release(entry.bytes);
+        _entries.erase(entry.key);
+        _lru.pop_back();
+    }
+}
+
+void ScanResultCache::_release(size_t bytes) {
+    _memory_usage -= bytes;
+    if (_mem_tracker != nullptr) {
+        _mem_tracker->release(bytes);
+    }
+}
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,75 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "column/vectorized_fwd.h"
+
+namespace starrocks {
+class MemTracker;
+}
+
+namespace starrocks::pipeline {
+
+// Caches the output chunks of scanning a whole tablet at a version, keyed by the digest of the scan,
+// the tablet id and the version. The repeated queries of the same scan, e.g. the aggregations over
+// historical partitions sent by dashboards, reuse the chunks of the unchanged tablets, and only read
+// the tablets whose versions have changed since, i.e. loaded new rowsets.
+//
+// The cached chunks are immutable, the readers must copy them before modifying. The entries are evicted
+// in LRU order once their total memory exceeds the capacity. The memory of the entries is charged to
+// |mem_tracker| if any, and no entry is inserted while any of its limits is exceeded.
+class ScanResultCache {
+public:
+    using Chunks = std::vector<vectorized::ChunkPtr>;
+    using ChunksPtr = std::shared_ptr<const Chunks>;
+
+    explicit ScanResultCache(size_t capacity, MemTracker* mem_tracker = nullptr)
+            : _capacity(capacity), _mem_tracker(mem_tracker) {}
+
+    // The cache shared by all the queries, whose capacity is config::pipeline_scan_result_cache_capacity
+    // and whose memory is charged to ExecEnv::scan_result_cache_mem_tracker().
+    static ScanResultCache* instance();
+
+    static std::string make_key(const std::string& digest, int64_t tablet_id, int64_t version);
+
+    // Return nullptr if absent.
+    ChunksPtr lookup(const std::string& key);
+
+    // Replace the existing entry of key if any, the chunks larger than the capacity are not cached.
+    // Nothing is cached while the memory limit of the tracker is exceeded.
+    void insert(const std::string& key, Chunks chunks);
+
+    // Shrink the cache immediately if the capacity is lowered.
+    void set_capacity(size_t capacity);
+
+    size_t capacity() const { return _capacity; }
+    size_t memory_usage() const { return _memory_usage; }
+    size_t num_entries() const { return _entries.size(); }
+
+private:
+    struct Entry {
+        std::string key;
+        ChunksPtr chunks;
+        size_t bytes;
+    };
+    using LruList = std::list<Entry>;
+
+    void _evict();
+    void _release(size_t bytes);
+
+    std::mutex _lock;
+    size_t _capacity;
+    MemTracker* _mem_tracker;
+    size_t _memory_usage = 0;
+    LruList _lru;
+    std::unordered_map<std::string, LruList::iterator> _entries;
+};
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,131 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+#pragma once
+
+#include "column/chunk.h"
+#include "column/column_hash.h"
+#include "column/column_helper.h"
+#include "column/type_traits.h"
+#include "common/statusor.h"
+#include "exec/olap_common.h"
+#include "exec/vectorized/intersect_hash_set.h"
+#include "exprs/expr_context.h"
+#include "gutil/casts.h"
+#include "runtime/mem_pool.h"
+#include "util/hash_util.hpp"
+#include "util/phmap/phmap.h"
+#include "util/slice.h"
+
+namespace starrocks::pipeline {
+
+class IntersectContext;
+using IntersectContextPtr = std::shared_ptr<IntersectContext>;
+
+class IntersectPartitionContextFactory;
+using IntersectPartitionContextFactoryPtr = std::shared_ptr<IntersectPartitionContextFactory>;
+
+// Used as the shared context for IntersectBuildSinkOperator, IntersectProbeSinkOperator,
+// and IntersectOutputSourceOperator.
+class IntersectContext {
+public:
+    IntersectContext(const int dst_tuple_id, const size_t intersect_times)
+            : _dst_tuple_id(dst_tuple_id),
+              _intersect_times(intersect_times),
+              _finished_dependencies(new std::atomic<bool>[intersect_times + 1]) {
+        for (size_t i = 0; i <= intersect_times; ++i) {
+            _finished_dependencies[i] = false;
+        }
+    }
+
+    /// The following methods are for Build phase.
+    Status prepare(RuntimeState* state, const std::vector<ExprContext*>& build_exprs);
+
+    void finish_build_ht() {
+        _next_processed_iter = _hash_set->begin();
+        _finished_dependencies[0].store(true, std::memory_order_release);
+    }
+
+    bool is_ht_empty() const { return _hash_set->empty(); }
+
+    Status append_chunk_to_ht(RuntimeState* state, const ChunkPtr& chunk, const std::vector<ExprContext*>& dst_exprs);
+
+    /// The following methods are for Probe phase.
+    // The i-th child (1-based) refines the keys hit by all the previous children, so it probes the hash set
+    // after BUILD and the PROBEs of the previous children have finished.
+    bool is_dependency_finished(size_t child_idx) const {
+        for (size_t i = 0; i < child_idx; ++i) {
+            if (!_finished_dependencies[i].load(std::memory_order_acquire)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void finish_probe_ht(size_t child_idx) { _finished_dependencies[child_idx].store(true, std::memory_order_release); }
+
+    Status refine_chunk_from_ht(RuntimeState* state, const ChunkPtr& chunk,
+                                const std::vector<ExprContext*>& child_exprs, size_t child_idx);
+
+    /// The following methods are for Output phase.
+    bool is_probe_finished() const { return is_dependency_finished(_intersect_times + 1); }
+
+    bool is_output_finished() const { return _next_processed_iter == _hash_set->end(); }
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state);
+
+    Status close(RuntimeState* state);
+
+private:
+    std::unique_ptr<vectorized::IntersectHashSerializeSet> _hash_set =
+            std::make_unique<vectorized::IntersectHashSerializeSet>();
+
+    const int _dst_tuple_id;
+    // The number of children except the first one.
+    const size_t _intersect_times;
+    // Cache the dest tuple descriptor in the preparation phase of IntersectBuildSinkOperator.
+    TupleDescriptor* _dst_tuple_desc = nullptr;
+    // Indicate whether each dest column is nullable.
+    std::vector<bool> _dst_nullables;
+
+    // Used to allocate keys in the hash set.
+    // It is used to allocate keys in IntersectBuildSinkOperator, and release all allocated keys
+    // when IntersectOutputSourceOperator is finished by calling close().
+    std::unique_ptr<MemPool> _build_pool = nullptr;
+
+    vectorized::IntersectHashSerializeSet::KeyVector _remained_keys;
+    // Used for traversal on the hash set to get the keys hit by all the children to dest chunk.
+    // Init when the hash set is finished building in finish_build_ht().
+    vectorized::IntersectHashSerializeSet::Iterator _next_processed_iter;
+
+    // _finished_dependencies[0] is set by BUILD, and _finished_dependencies[i] is set by the PROBE of the i-th child.
+    // The PROBE of the i-th child and OUTPUT see all the operations on the hash set by the previous ones
+    // by acquiring the flags.
+    std::unique_ptr<std::atomic<bool>[]> _finished_dependencies;
+};
+
+// The input chunks of BUILD and PROBE are shuffled by the local shuffle operator.
+// The number of shuffled partitions is the degree of parallelism (DOP), which means
+// the number of partition hash sets and the number of BUILD drivers, PROBE drivers of one child, OUTPUT drivers
+// are both DOP. And each pair of BUILD/PROBE/OUTPUT drivers shares a same intersect partition context.
+class IntersectPartitionContextFactory {
+public:
+    IntersectPartitionContextFactory(const size_t dst_tuple_id, const size_t intersect_times)
+            : _dst_tuple_id(dst_tuple_id), _intersect_times(intersect_times) {}
+
+    IntersectContextPtr get_or_create(const int partition_id) {
+        auto it = _partition_id2ctx.find(partition_id);
+        if (it != _partition_id2ctx.end()) {
+            return it->second;
+        }
+
+        auto ctx = std::make_shared<IntersectContext>(_dst_tuple_id, _intersect_times);
+        _partition_id2ctx[partition_id] = ctx;
+        return ctx;
+    }
+
+private:
+    const size_t _dst_tuple_id;
+    const size_t _intersect_times;
+    std::unordered_map<size_t, IntersectContextPtr> _partition_id2ctx;
+};
+
+} // namespace starrocks::pipeline
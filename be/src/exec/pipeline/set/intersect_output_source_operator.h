@@ -0,0 +1,67 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "exec/pipeline/operator.h"
+#include "exec/pipeline/set/intersect_context.h"
+#include "exec/pipeline/source_operator.h"
+
+namespace starrocks::pipeline {
+
+// IntersectNode is decomposed to IntersectBuildSinkOperator, IntersectProbeSinkOperator,
+// and IntersectOutputSourceOperator.
+// - IntersectBuildSinkOperator (BUILD) builds the hash set from the output rows of IntersectNode's first child.
+// - IntersectProbeSinkOperator (PROBE) of the i-th child labels the keys hit by the output rows of the child
+//   and all the previous children in the hash set.
+//   PROBE of the i-th child depends on BUILD and PROBEs of the previous children, since it only refines the keys
+//   labeled by them.
+// - IntersectOutputSourceOperator (OUTPUT) traverses the hash set and outputs the keys hit by all the children.
+//   OUTPUT depends on all the PROBEs.
+//
+// The input chunks of BUILD and PROBE are shuffled by the local shuffle operator.
+// The number of shuffled partitions is the degree of parallelism (DOP), which means
+// the number of partition hash sets and the number of BUILD drivers, PROBE drivers of one child, OUTPUT drivers
+// are both DOP. And each pair of BUILD/PROBE/OUTPUT drivers shares a same intersect partition context.
+class IntersectOutputSourceOperator final : public SourceOperator {
+public:
+    IntersectOutputSourceOperator(int32_t id, int32_t plan_node_id, std::shared_ptr<IntersectContext> intersect_ctx)
+            : SourceOperator(id, "intersect_output_source", plan_node_id), _intersect_ctx(std::move(intersect_ctx)) {}
+
+    bool has_output() const override {
+        return _intersect_ctx->is_probe_finished() && !_intersect_ctx->is_output_finished();
+    }
+
+    bool is_finished() const override {
+        return _intersect_ctx->is_probe_finished() && _intersect_ctx->is_output_finished();
+    }
+
+    // Finish is noop.
+    void finish(RuntimeState* state) override {}
+
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override;
+
+    Status close(RuntimeState* state) override;
+
+private:
+    std::shared_ptr<IntersectContext> _intersect_ctx;
+};
+
+class IntersectOutputSourceOperatorFactory final : public SourceOperatorFactory {
+public:
+    IntersectOutputSourceOperatorFactory(int32_t id, int32_t plan_node_id,
+                                         IntersectPartitionContextFactoryPtr intersect_partition_ctx_factory)
+            : SourceOperatorFactory(id, "intersect_output_source", plan_node_id),
+              _intersect_partition_ctx_factory(std::move(intersect_partition_ctx_factory)) {}
+
+    OperatorPtr create(int32_t degree_of_parallelism, int32_t driver_sequence) override {
+        return std::make_shared<IntersectOutputSourceOperator>(
+                _id, _plan_node_id, _intersect_partition_ctx_factory->get_or_create(driver_sequence));
+    }
+
+    void close(RuntimeState* state) override;
+
+private:
+    IntersectPartitionContextFactoryPtr _intersect_partition_ctx_factory;
+};
+
+} // namespace starrocks::pipeline
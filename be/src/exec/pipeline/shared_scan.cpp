@@ -0,0 +1,188 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/shared_scan.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "column/chunk.h"
+#include "common/config.h"
+#include "storage/vectorized/chunk_helper.h"
+
+namespace starrocks::pipeline {
+
+SharedScan::SharedScan(vectorized::Schema schema, int chunk_size, OpenFunc open)
+        : _schema(std::move(schema)), _chunk_size(chunk_size), _open(std::move(open)) {}
+
+SharedScan::~SharedScan() {
+    if (_iter != nullptr) {
+        _iter->close();
+    }
+}
+
+int64_t SharedScan::attach() {
+    std::lock_guard l(_lock);
+    Reader reader;
+    reader.next_seq = _next_seq;
+    if (_in_pass) {
+        reader.pass = _num_passes;
+        reader.start_index = _next_seq - _pass_start_seq;
+    } else {
+        // starts from the beginning of the next pass.
+        reader.pass = _num_passes + 1;
+        reader.start_index = 0;
+    }
+    int64_t reader_id = _next_reader_id++;
+    _readers.emplace(reader_id, reader);
+    return reader_id;
+}
+
+void SharedScan::detach(int64_t reader_id) {
+    std::lock_guard l(_lock);
+    _readers.erase(reader_id);
+    _trim();
+}
+
+Status SharedScan::get_next(int64_t reader_id, vectorized::ChunkPtr* chunk) {
+    std::unique_lock l(_lock);
+    bool waited = false;
+    while (true) {
+        RETURN_IF_ERROR(_status);
+        Reader& reader = _readers.at(reader_id);
+        if (reader.end_seq >= 0 && reader.next_seq >= reader.end_seq) {
+            return Status::EndOfFile("no more shared chunks");
+        }
+        if (reader.next_seq < _next_seq) {
+            *chunk = _chunks[reader.next_seq - _base_seq];
+            ++reader.next_seq;
+            _trim();
+            return Status::OK();
+        }
+        if (_reading) {
+            _cond.wait(l);
+            continue;
+        }
+        const auto max_bytes = static_cast<size_t>(config::pipeline_shared_scan_max_buffer_bytes);
+        if (_bytes > max_bytes && !waited) {
+            // give the slower readers a chance to catch up, but never wait for them forever, as they may be
+            // waiting for this reader in the same fragment.
+            waited = true;
+            _cond.wait_for(l, std::chrono::milliseconds(100), [this, max_bytes] { return _bytes <= max_bytes; });
+            continue;
+        }
+        RETURN_IF_ERROR(_read_next(l));
+    }
+}
+
+Status SharedScan::_read_next(std::unique_lock<std::mutex>& l) {
+    _reading = true;
+    const bool open = _iter == nullptr;
+    if (open) {
+        _in_pass = true;
+        ++_num_passes;
+        _pass_start_seq = _next_seq;
+    }
+    vectorized::ChunkIteratorPtr iter = _iter;
+    l.unlock();
+
+    Status st;
+    vectorized::ChunkPtr chunk;
+    if (open) {
+        auto res = _open();
+        st = res.status();
+        if (st.ok()) {
+            iter = std::move(res).value();
+        }
+    }
+    if (st.ok()) {
+        chunk = vectorized::ChunkHelper::new_chunk(iter->encoded_schema(), _chunk_size);
+        st = iter->get_next(chunk.get());
+    }
+
+    l.lock();
+    _reading = false;
+    _cond.notify_all();
+    if (open) {
+        _iter = iter;
+    }
+    if (st.is_end_of_file()) {
+        // The readers attached in this pass read the next pass up to where they were attached.
+        for (auto& [id, reader] : _readers) {
+            if (reader.end_seq < 0 && reader.pass == _num_passes) {
+                reader.end_seq = _next_seq + reader.start_index;
+            } else if (reader.end_seq > _next_seq) {
+                reader.end_seq = _next_seq;
+            }
+        }
+        _in_pass = false;
+        if (_iter != nullptr) {
+            _iter->close();
+            _iter.reset();
+        }
+        return Status::OK();
+    }
+    if (!st.ok()) {
+        _status = st;
+        return st;
+    }
+    _bytes += chunk->memory_usage();
+    _chunks.emplace_back(std::move(chunk));
+    ++_next_seq;
+    return Status::OK();
+}
+
+void SharedScan::_trim() {
+    int64_t min_seq = _next_seq;
+    for (const auto& [id, reader] : _readers) {
+        // the readers done don't hold the chunks.
+        if (reader.end_seq < 0 || reader.next_seq < reader.end_seq) {
+            min_seq = std::min(min_seq, reader.next_seq);
+        }
+    }
+    if (_base_seq >= min_seq) {
+        return;
+    }
+    while (_base_seq < min_seq) {
+        _bytes -= _chunks.front()->memory_usage();
+        _chunks.pop_front();
+        ++_base_seq;
+    }
+    _cond.notify_all();
+}
+
+SharedScanMgr* SharedScanMgr::instance() {
+    static SharedScanMgr s_instance;
+    return &s_instance;
+}
+
+std::string SharedScanMgr::make_key(int64_t tablet_id, int64_t version, const std::vector<uint32_t>& columns,
+                                    bool skip_aggregation) {
+    std::string key;
+    key.reserve(2 * sizeof(int64_t) + 1 + columns.size() * sizeof(uint32_t));
+    key.append(reinterpret_cast<const char*>(&tablet_id), sizeof(tablet_id));
+    key.append(reinterpret_cast<const char*>(&version), sizeof(version));
+    key.push_back(skip_aggregation ? 1 : 0);
+    key.append(reinterpret_cast<const char*>(columns.data()), columns.size() * sizeof(uint32_t));
+    return key;
+}
+
+std::shared_ptr<SharedScan> SharedScanMgr::get_or_create(const std::string& key, const vectorized::Schema& schema,
+                                                         int chunk_size, const SharedScan::OpenFunc& open) {
+    std::lock_guard l(_lock);
+    for (auto iter = _scans.begin(); iter != _scans.end();) {
+        if (iter->second.expired()) {
+            iter = _scans.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+    auto& entry = _scans[key];
+    std::shared_ptr<SharedScan> scan = entry.lock();
+    if (scan == nullptr) {
+        scan = std::make_shared<SharedScan>(schema, chunk_size, open);
+        entry = scan;
+    }
+    return scan;
+}
+
+} // namespace starrocks::pipeline
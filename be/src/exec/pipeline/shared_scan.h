@@ -0,0 +1,114 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "column/vectorized_fwd.h"
+#include "common/statusor.h"
+#include "storage/vectorized/chunk_iterator.h"
+
+namespace starrocks::pipeline {
+
+// One stream of the chunks of a tablet shared by the concurrent scans of the same tablet at the same version with
+// the same columns, e.g. the queries of a dashboard refreshed at once, so that the tablet is read and decoded once
+// instead of once per scan.
+//
+// The stream reads the whole tablet without predicates, and every reader evaluates its own predicates on a copy of
+// the chunks. A reader attached in the middle of the stream reads the chunks from there to the end, and then the
+// chunks from the start up to where it was attached, which the stream reads by opening the tablet again, i.e. a
+// circular scan. The chunks are kept until all the readers have read them. The chunks are read by the readers
+// themselves: the reader that needs a chunk not read yet reads it for all.
+class SharedScan {
+public:
+    // Open the iterator of the whole tablet, which is opened again for every pass of the stream.
+    using OpenFunc = std::function<StatusOr<vectorized::ChunkIteratorPtr>()>;
+
+    SharedScan(vectorized::Schema schema, int chunk_size, OpenFunc open);
+
+    ~SharedScan();
+
+    const vectorized::Schema& schema() const { return _schema; }
+
+    // Attach a reader, which reads every chunk of the tablet once from the current position of the stream.
+    int64_t attach();
+
+    void detach(int64_t reader_id);
+
+    // The next chunk of the reader, which must not be modified, or EndOfFile once it has read all the chunks.
+    Status get_next(int64_t reader_id, vectorized::ChunkPtr* chunk);
+
+    // The number of times the tablet has been read, for tests.
+    int64_t num_passes() const { return _num_passes; }
+
+private:
+    struct Reader {
+        // the sequence number of the next chunk to read.
+        int64_t next_seq = 0;
+        // the pass the reader is attached in, and the index of the chunk in the pass it starts at.
+        int64_t pass = 0;
+        int64_t start_index = 0;
+        // the sequence number after the last chunk to read, -1 until the pass it's attached in ends.
+        int64_t end_seq = -1;
+    };
+
+    // Read the next chunk of the stream for all the readers, with |l| unlocked while reading.
+    Status _read_next(std::unique_lock<std::mutex>& l);
+
+    // Drop the chunks read by all the readers.
+    void _trim();
+
+    const vectorized::Schema _schema;
+    const int _chunk_size;
+    const OpenFunc _open;
+
+    std::mutex _lock;
+    std::condition_variable _cond;
+    Status _status;
+    std::unordered_map<int64_t, Reader> _readers;
+    int64_t _next_reader_id = 0;
+
+    // the iterator of the current pass, nullptr between the passes.
+    vectorized::ChunkIteratorPtr _iter;
+    // whether a reader is reading the next chunk.
+    bool _reading = false;
+    // whether a pass is in progress, and the number of the passes started.
+    bool _in_pass = false;
+    int64_t _num_passes = 0;
+    // the sequence number of the first chunk of the current pass, or of the next pass between the passes.
+    int64_t _pass_start_seq = 0;
+
+    // the chunks kept, from the sequence number |_base_seq| to |_next_seq| exclusively.
+    std::deque<vectorized::ChunkPtr> _chunks;
+    int64_t _base_seq = 0;
+    int64_t _next_seq = 0;
+    size_t _bytes = 0;
+};
+
+// The shared scans in progress, keyed by the tablet, the version and the columns.
+class SharedScanMgr {
+public:
+    static SharedScanMgr* instance();
+
+    static std::string make_key(int64_t tablet_id, int64_t version, const std::vector<uint32_t>& columns,
+                                bool skip_aggregation);
+
+    // Return the shared scan of |key| in progress, or a new one opened by |open|.
+    std::shared_ptr<SharedScan> get_or_create(const std::string& key, const vectorized::Schema& schema,
+                                              int chunk_size, const SharedScan::OpenFunc& open);
+
+private:
+    std::mutex _lock;
+    // the scans are owned by their readers, and are released once all of them are done.
+    std::unordered_map<std::string, std::weak_ptr<SharedScan>> _scans;
+};
+
+} // namespace starrocks::pipeline
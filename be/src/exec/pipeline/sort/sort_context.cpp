@@ -0,0 +1,91 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/sort/sort_context.h"
+
+#include "column/chunk.h"
+#include "exec/vectorized/chunks_sorter.h"
+#include "runtime/vectorized/sorted_chunks_merger.h"
+
+namespace starrocks::pipeline {
+
+SortContext::SortContext(std::vector<std::shared_ptr<vectorized::ChunksSorter>>&& chunks_sorters,
+                         const std::vector<ExprContext*>* sort_exprs, const std::vector<bool>* is_asc,
+                         const std::vector<bool>* is_null_first, bool is_partitioned)
+        : _chunks_sorters(std::move(chunks_sorters)),
+          _sort_exprs(sort_exprs),
+          _is_asc(is_asc),
+          _is_null_first(is_null_first),
+          _is_partitioned(is_partitioned),
+          _finished_sinks(std::make_unique<std::atomic<bool>[]>(_chunks_sorters.size())) {
+    DCHECK(!_chunks_sorters.empty());
+}
+
+SortContext::~SortContext() = default;
+
+Status SortContext::_init_merger() {
+    vectorized::ChunkSuppliers chunk_suppliers;
+    vectorized::ChunkProbeSuppliers chunk_probe_suppliers;
+    vectorized::ChunkHasSuppliers chunk_has_suppliers;
+    for (auto& chunks_sorter : _chunks_sorters) {
+        // ChunksSorter::pull_chunk may return the last chunk together with eos.
+        auto eos = std::make_shared<bool>(false);
+        vectorized::ChunksSorter* sorter = chunks_sorter.get();
+        chunk_suppliers.emplace_back([sorter, eos](vectorized::Chunk** chunk) -> Status {
+            *chunk = nullptr;
+            vectorized::ChunkPtr sorted_chunk;
+            while (!*eos && (sorted_chunk == nullptr || sorted_chunk->num_rows() == 0)) {
+                *eos = sorter->pull_chunk(&sorted_chunk);
+            }
+            RETURN_IF_ERROR(sorter->status());
+            if (sorted_chunk != nullptr && sorted_chunk->num_rows() > 0) {
+                // The merger takes the ownership of the chunk, move the columns out of the shared one.
+                *chunk = new vectorized::Chunk();
+                (*chunk)->swap_chunk(*sorted_chunk);
+            }
+            return Status::OK();
+        });
+        // The sorted runs are all in memory, so they are always ready.
+        chunk_probe_suppliers.emplace_back([](vectorized::Chunk**) -> bool { return false; });
+        chunk_has_suppliers.emplace_back([]() -> bool { return true; });
+    }
+
+    _merger = std::make_unique<vectorized::SortedChunksMerger>(false);
+    return _merger->init(chunk_suppliers, chunk_probe_suppliers, chunk_has_suppliers, _sort_exprs, _is_asc,
+                         _is_null_first);
+}
+
+bool SortContext::pull_chunk(int32_t driver_sequence, vectorized::ChunkPtr* chunk) {
+    DCHECK(is_sink_complete(driver_sequence));
+    *chunk = nullptr;
+    if (_is_partitioned) {
+        return _chunks_sorters[driver_sequence]->pull_chunk(chunk);
+    }
+    if (_chunks_sorters.size() == 1) {
+        return _chunks_sorters[0]->pull_chunk(chunk);
+    }
+
+    if (_merger == nullptr) {
+        _merge_status = _init_merger();
+        if (!_merge_status.ok()) {
+            return true;
+        }
+    }
+    bool eos = false;
+    _merge_status = _merger->get_next(chunk, &eos);
+    if (!_merge_status.ok() || eos) {
+        // Release the sorted runs as soon as they have been merged.
+        _merger.reset();
+        return true;
+    }
+    return false;
+}
+
+Status SortContext::status() const {
+    RETURN_IF_ERROR(_merge_status);
+    for (const auto& chunks_sorter : _chunks_sorters) {
+        RETURN_IF_ERROR(chunks_sorter->status());
+    }
+    return Status::OK();
+}
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,81 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "column/vectorized_fwd.h"
+#include "common/status.h"
+
+namespace starrocks {
+class ExprContext;
+
+namespace vectorized {
+class ChunksSorter;
+class SortedChunksMerger;
+} // namespace vectorized
+
+namespace pipeline {
+
+class SortContext;
+using SortContextPtr = std::shared_ptr<SortContext>;
+
+// Used as the shared context for SortSinkOperator and SortSourceOperator.
+// Every SortSinkOperator sorts its own input by the ChunksSorter of its driver, and SortSourceOperator
+// merges the sorted runs of all the drivers in order once all of them have finished.
+// If the input has been shuffled by some partition keys, e.g. the PARTITION BY keys of the window above,
+// the rows are only ordered within a partition, so every SortSourceOperator outputs the sorted run
+// of its own driver as soon as the SortSinkOperator of the same driver has finished.
+class SortContext {
+public:
+    SortContext(std::vector<std::shared_ptr<vectorized::ChunksSorter>>&& chunks_sorters,
+                const std::vector<ExprContext*>* sort_exprs, const std::vector<bool>* is_asc,
+                const std::vector<bool>* is_null_first, bool is_partitioned = false);
+    ~SortContext();
+
+    size_t num_chunks_sorters() const { return _chunks_sorters.size(); }
+    const std::shared_ptr<vectorized::ChunksSorter>& chunks_sorter(int32_t driver_sequence) const {
+        return _chunks_sorters[driver_sequence];
+    }
+
+    bool is_partitioned() const { return _is_partitioned; }
+
+    void finish_one_sink(int32_t driver_sequence) {
+        _finished_sinks[driver_sequence].store(true, std::memory_order_release);
+        _num_finished_sinks.fetch_add(1, std::memory_order_release);
+    }
+    // Whether the rows to be output by the SortSourceOperator of |driver_sequence| have all been sorted.
+    bool is_sink_complete(int32_t driver_sequence) const {
+        if (_is_partitioned) {
+            return _finished_sinks[driver_sequence].load(std::memory_order_acquire);
+        }
+        return _num_finished_sinks.load(std::memory_order_acquire) == _chunks_sorters.size();
+    }
+
+    // Return true if all the sorted rows of the SortSourceOperator of |driver_sequence| have been pulled.
+    // Must be called after is_sink_complete() returns true.
+    bool pull_chunk(int32_t driver_sequence, vectorized::ChunkPtr* chunk);
+
+    // The first error of the ChunksSorters or of merging their sorted runs.
+    Status status() const;
+
+private:
+    Status _init_merger();
+
+    std::vector<std::shared_ptr<vectorized::ChunksSorter>> _chunks_sorters;
+    const std::vector<ExprContext*>* _sort_exprs;
+    const std::vector<bool>* _is_asc;
+    const std::vector<bool>* _is_null_first;
+    const bool _is_partitioned;
+
+    std::unique_ptr<std::atomic<bool>[]> _finished_sinks;
+    std::atomic<size_t> _num_finished_sinks = 0;
+
+    std::unique_ptr<vectorized::SortedChunksMerger> _merger;
+    Status _merge_status;
+};
+
+} // namespace pipeline
+} // namespace starrocks
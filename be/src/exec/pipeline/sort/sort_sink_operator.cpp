@@ -37,7 +37,7 @@ bool SortSinkOperator::need_input() const {
 Status SortSinkOperator::push_chunk(RuntimeState* state, const vectorized::ChunkPtr& chunk) {
     if (chunk && chunk->num_rows() > 0) {
         vectorized::ChunkPtr materialize_chunk = _materialize_chunk_before_sort(chunk.get());
-        _chunks_sorter->update(state, materialize_chunk);
+        RETURN_IF_ERROR(_chunks_sorter->update(state, materialize_chunk));
     }
 
     return Status::OK();
@@ -96,7 +96,9 @@ vectorized::ChunkPtr SortSinkOperator::_materialize_chunk_before_sort(vectorized
 }
 
 void SortSinkOperator::finish(RuntimeState* state) {
-    _chunks_sorter->finish(state);
+    // The error is surfaced by SortSourceOperator through SortContext::status().
+    (void)_chunks_sorter->finish(state);
+    _sort_context->finish_one_sink(_driver_sequence);
     _is_finished = true;
 }
 
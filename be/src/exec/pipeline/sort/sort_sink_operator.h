@@ -6,6 +6,7 @@
 
 #include "column/vectorized_fwd.h"
 #include "exec/pipeline/operator.h"
+#include "exec/pipeline/sort/sort_context.h"
 #include "exec/sort_exec_exprs.h"
 #include "gen_cpp/InternalService_types.h"
 #include "runtime/mysql_result_writer.h"
@@ -24,11 +25,13 @@ class ChunksSorter;
 namespace pipeline {
 class SortSinkOperator final : public Operator {
 public:
-    SortSinkOperator(int32_t id, int32_t plan_node_id, std::shared_ptr<vectorized::ChunksSorter> chunks_sorter,
-                     SortExecExprs sort_exec_exprs, const std::vector<OrderByType>& order_by_types,
-                     TupleDescriptor* materialized_tuple_desc, const RowDescriptor& parent_node_row_desc,
-                     const RowDescriptor& parent_node_child_row_desc)
+    SortSinkOperator(int32_t id, int32_t plan_node_id, int32_t driver_sequence, SortContextPtr sort_context,
+                     std::shared_ptr<vectorized::ChunksSorter> chunks_sorter, SortExecExprs sort_exec_exprs,
+                     const std::vector<OrderByType>& order_by_types, TupleDescriptor* materialized_tuple_desc,
+                     const RowDescriptor& parent_node_row_desc, const RowDescriptor& parent_node_child_row_desc)
             : Operator(id, "sort_sink", plan_node_id),
+              _driver_sequence(driver_sequence),
+              _sort_context(std::move(sort_context)),
               _chunks_sorter(std::move(chunks_sorter)),
               _sort_exec_exprs(std::move(sort_exec_exprs)),
               _order_by_types(order_by_types),
@@ -59,6 +62,9 @@ private:
     vectorized::ChunkPtr _materialize_chunk_before_sort(vectorized::Chunk* chunk);
     bool _is_finished = false;
 
+    const int32_t _driver_sequence;
+    SortContextPtr _sort_context;
+    // The sorter of this driver, owned by _sort_context.
     std::shared_ptr<vectorized::ChunksSorter> _chunks_sorter;
 
     // from topn
@@ -76,13 +82,12 @@ private:
 
 class SortSinkOperatorFactory final : public OperatorFactory {
 public:
-    SortSinkOperatorFactory(int32_t id, int32_t plan_node_id,
-                            const std::shared_ptr<vectorized::ChunksSorter>& chunks_sorter,
+    SortSinkOperatorFactory(int32_t id, int32_t plan_node_id, SortContextPtr sort_context,
                             SortExecExprs& sort_exec_exprs, const std::vector<OrderByType>& order_by_types,
                             TupleDescriptor* materialized_tuple_desc, const RowDescriptor& parent_node_row_desc,
                             const RowDescriptor& parent_node_child_row_desc)
             : OperatorFactory(id, "sort_sink", plan_node_id),
-              _chunks_sorter(std::move(chunks_sorter)),
+              _sort_context(std::move(sort_context)),
               _sort_exec_exprs(sort_exec_exprs),
               _order_by_types(order_by_types),
               _materialized_tuple_desc(materialized_tuple_desc),
@@ -92,9 +97,11 @@ public:
     ~SortSinkOperatorFactory() override = default;
 
     OperatorPtr create(int32_t degree_of_parallelism, int32_t driver_sequence) override {
-        auto ope = std::make_shared<SortSinkOperator>(_id, _plan_node_id, _chunks_sorter, _sort_exec_exprs,
-                                                      _order_by_types, _materialized_tuple_desc, _parent_node_row_desc,
-                                                      _parent_node_child_row_desc);
+        DCHECK_EQ(degree_of_parallelism, _sort_context->num_chunks_sorters());
+        auto ope = std::make_shared<SortSinkOperator>(
+                _id, _plan_node_id, driver_sequence, _sort_context, _sort_context->chunks_sorter(driver_sequence),
+                _sort_exec_exprs, _order_by_types, _materialized_tuple_desc, _parent_node_row_desc,
+                _parent_node_child_row_desc);
         return ope;
     }
 
@@ -102,7 +109,7 @@ public:
     void close(RuntimeState* state) override;
 
 private:
-    std::shared_ptr<vectorized::ChunksSorter> _chunks_sorter;
+    SortContextPtr _sort_context;
 
     // _sort_exec_exprs contains the ordering expressions
     SortExecExprs& _sort_exec_exprs;
@@ -17,10 +17,12 @@
 
 namespace starrocks::pipeline {
 StatusOr<vectorized::ChunkPtr> SortSourceOperator::pull_chunk(RuntimeState* state) {
+    RETURN_IF_ERROR(_sort_context->status());
     ChunkPtr chunk;
-    if (_chunks_sorter->pull_chunk(&chunk)) {
+    if (_sort_context->pull_chunk(_driver_sequence, &chunk)) {
         _is_source_complete = true;
     }
+    RETURN_IF_ERROR(_sort_context->status());
 
     if (!chunk) {
         return std::make_shared<vectorized::Chunk>();
@@ -34,7 +36,7 @@ void SortSourceOperator::finish(RuntimeState* state) {
 }
 
 bool SortSourceOperator::has_output() const {
-    return _chunks_sorter->sink_complete();
+    return _sort_context->is_sink_complete(_driver_sequence);
 }
 
 bool SortSourceOperator::is_finished() const {
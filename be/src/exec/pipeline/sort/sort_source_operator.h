@@ -3,6 +3,7 @@
 #pragma once
 
 #include "column/vectorized_fwd.h"
+#include "exec/pipeline/sort/sort_context.h"
 #include "exec/pipeline/source_operator.h"
 #include "exec/sort_exec_exprs.h"
 #include "gen_cpp/InternalService_types.h"
@@ -14,15 +15,13 @@ class BufferControlBlock;
 class ExprContext;
 class ResultWriter;
 
-namespace vectorized {
-class ChunksSorter;
-}
-
 namespace pipeline {
 class SortSourceOperator final : public SourceOperator {
 public:
-    SortSourceOperator(int32_t id, int32_t plan_node_id, std::shared_ptr<vectorized::ChunksSorter>&& chunks_sorter)
-            : SourceOperator(id, "sort_source", plan_node_id), _chunks_sorter(chunks_sorter) {}
+    SortSourceOperator(int32_t id, int32_t plan_node_id, int32_t driver_sequence, SortContextPtr sort_context)
+            : SourceOperator(id, "sort_source", plan_node_id),
+              _driver_sequence(driver_sequence),
+              _sort_context(std::move(sort_context)) {}
 
     ~SortSourceOperator() override = default;
 
@@ -37,7 +36,8 @@ public:
     void finish(RuntimeState* state) override;
 
 private:
-    std::shared_ptr<vectorized::ChunksSorter> _chunks_sorter;
+    const int32_t _driver_sequence;
+    SortContextPtr _sort_context;
 
     bool _is_finished = false;
     vectorized::ChunkPtr _full_chunk = nullptr;
@@ -47,19 +47,18 @@ private:
 
 class SortSourceOperatorFactory final : public SourceOperatorFactory {
 public:
-    SortSourceOperatorFactory(int32_t id, int32_t plan_node_id,
-                              std::shared_ptr<vectorized::ChunksSorter>&& chunks_sorter)
-            : SourceOperatorFactory(id, "sort_source", plan_node_id), _chunks_sorter(chunks_sorter) {}
+    SortSourceOperatorFactory(int32_t id, int32_t plan_node_id, SortContextPtr sort_context)
+            : SourceOperatorFactory(id, "sort_source", plan_node_id), _sort_context(std::move(sort_context)) {}
 
     ~SortSourceOperatorFactory() override = default;
 
     OperatorPtr create(int32_t degree_of_parallelism, int32_t driver_sequence) override {
-        auto ope = std::make_shared<SortSourceOperator>(_id, _plan_node_id, std::move(_chunks_sorter));
+        auto ope = std::make_shared<SortSourceOperator>(_id, _plan_node_id, driver_sequence, _sort_context);
         return ope;
     }
 
 private:
-    std::shared_ptr<vectorized::ChunksSorter> _chunks_sorter;
+    SortContextPtr _sort_context;
 };
 
 } // namespace pipeline
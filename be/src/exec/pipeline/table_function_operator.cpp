@@ -81,62 +81,50 @@ StatusOr<vectorized::ChunkPtr> TableFunctionOperator::pull_chunk(RuntimeState* s
     std::vector<vectorized::ColumnPtr> output_columns;
 
     _process_table_function();
+    const auto& offsets = vectorized::ColumnHelper::as_raw_column<vectorized::UInt32Column>(
+                                  _table_function_result.second)
+                                  ->get_data();
 
-    output_columns.reserve(_outer_slots.size());
-    for (int _outer_slot : _outer_slots) {
-        output_columns.emplace_back(_input_chunk->get_column_by_slot_id(_outer_slot)->clone_empty());
-    }
-    for (size_t i = 0; i < _fn_result_slots.size(); ++i) {
-        output_columns.emplace_back(_table_function_result.first[i]->clone_empty());
-    }
-
+    // The results of the consecutive input rows are consecutive in the result columns, so the output rows are
+    // [start_offset, start_offset + _repeat_indexes.size()) of the result columns,
+    // and _repeat_indexes[i] is the input row of the i-th output row.
     //If _remain_repeat_times > 0, first use the remaining data of the previous chunk to construct this data
-    while (_remain_repeat_times > 0 || _input_chunk_index < _input_chunk->num_rows()) {
-        bool has_remain_repeat_times = _remain_repeat_times > 0;
-
-        if (!has_remain_repeat_times) {
-            _remain_repeat_times = _table_function_result.second->get(_input_chunk_index + 1).get_int32() -
-                                   _table_function_result.second->get(_input_chunk_index).get_int32();
+    uint32_t start_offset = _remain_repeat_times > 0 ? offsets[_input_chunk_index + 1] - _remain_repeat_times
+                                                     : offsets[_input_chunk_index];
+    _repeat_indexes.clear();
+    while (remain_chunk_size > 0 && (_remain_repeat_times > 0 || _input_chunk_index < _input_chunk->num_rows())) {
+        if (_remain_repeat_times == 0) {
+            _remain_repeat_times = offsets[_input_chunk_index + 1] - offsets[_input_chunk_index];
         }
         size_t repeat_times = std::min(_remain_repeat_times, remain_chunk_size);
-        if (repeat_times == 0) {
-            ++_input_chunk_index;
-            continue;
-        }
-
-        //Build outer data, repeat multiple times
-        for (size_t i = 0; i < _outer_slots.size(); ++i) {
-            vectorized::ColumnPtr& input_column_ptr = _input_chunk->get_column_by_slot_id(_outer_slots[i]);
-            vectorized::Datum value = input_column_ptr->get(_input_chunk_index);
-            if (value.is_null()) {
-                DCHECK(output_columns[i]->is_nullable());
-                down_cast<vectorized::NullableColumn*>(output_columns[i].get())->append_nulls(repeat_times);
-            } else {
-                output_columns[i]->append_value_multiple_times(&value, repeat_times);
-            }
-        }
-        //Build table function result
-        for (size_t i = 0; i < _fn_result_slots.size(); ++i) {
-            uint32_t start_offset;
-            if (has_remain_repeat_times) {
-                start_offset =
-                        _table_function_result.second->get(_input_chunk_index + 1).get_int32() - _remain_repeat_times;
-            } else {
-                start_offset = _table_function_result.second->get(_input_chunk_index).get_int32();
-            }
-            output_columns[_outer_slots.size() + i]->append(*(_table_function_result.first[i]), start_offset,
-                                                            repeat_times);
-        }
+        _repeat_indexes.insert(_repeat_indexes.end(), repeat_times, _input_chunk_index);
 
         remain_chunk_size -= repeat_times;
         _remain_repeat_times -= repeat_times;
         if (_remain_repeat_times == 0) {
             ++_input_chunk_index;
         }
+    }
+    const size_t num_rows = _repeat_indexes.size();
 
-        if (remain_chunk_size == 0) {
-            // Chunk is full
-            break;
+    //Build outer data by gathering the input row of each output row
+    output_columns.reserve(_outer_slots.size() + _fn_result_slots.size());
+    for (int _outer_slot : _outer_slots) {
+        const vectorized::ColumnPtr& input_column = _input_chunk->get_column_by_slot_id(_outer_slot);
+        vectorized::ColumnPtr output_column = input_column->clone_empty();
+        output_column->append_selective(*input_column, _repeat_indexes.data(), 0, num_rows);
+        output_columns.emplace_back(std::move(output_column));
+    }
+    //Build table function result
+    for (size_t i = 0; i < _fn_result_slots.size(); ++i) {
+        const vectorized::ColumnPtr& result_column = _table_function_result.first[i];
+        if (start_offset == 0 && num_rows == result_column->size()) {
+            // All the results are in this chunk, e.g. the elements column of the unnested array, use it without copy.
+            output_columns.emplace_back(result_column);
+        } else {
+            vectorized::ColumnPtr output_column = result_column->clone_empty();
+            output_column->append(*result_column, start_offset, num_rows);
+            output_columns.emplace_back(std::move(output_column));
         }
     }
 
@@ -55,6 +55,8 @@ private:
     size_t _input_chunk_index;
     //The current outer line needs to be repeated several times
     size_t _remain_repeat_times;
+    //The input row of each output row of the current output chunk
+    vectorized::Buffer<uint32_t> _repeat_indexes;
     //table function result
     std::pair<vectorized::Columns, vectorized::ColumnPtr> _table_function_result;
     //table function return result end ?
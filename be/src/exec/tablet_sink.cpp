@@ -38,7 +38,9 @@
 #include "service/brpc.h"
 #include "simd/simd.h"
 #include "storage/hll.h"
+#include "util/block_compression.h"
 #include "util/brpc_stub_cache.h"
+#include "util/compression_utils.h"
 #include "util/monotime.h"
 #include "util/uid_util.h"
 
@@ -109,6 +111,14 @@ Status NodeChannel::init(RuntimeState* state) {
 
     _rpc_timeout_ms = state->query_options().query_timeout * 1000;
 
+    // Set compression type according to query options, same as DataStreamSender
+    if (state->query_options().__isset.transmission_compression_type) {
+        _compress_type = CompressionUtils::to_compression_pb(state->query_options().transmission_compression_type);
+    } else if (config::compress_rowbatches) {
+        _compress_type = CompressionTypePB::LZ4;
+    }
+    RETURN_IF_ERROR(get_block_compression_codec(_compress_type, &_compress_codec));
+
     // for get global_dict
     _runtime_state = state;
 
@@ -136,6 +146,7 @@ void NodeChannel::open() {
     }
     request.set_load_channel_timeout_s(_parent->_load_channel_timeout_s);
     request.set_is_vectorized(_parent->_is_vectorized);
+    request.set_input_sorted(_parent->_input_sorted);
 
     // set global dict
     const auto& global_dict = _runtime_state->get_global_dict_map();
@@ -223,6 +234,12 @@ Status NodeChannel::open_wait() {
             _add_batch_counter.add_batch_execution_time_us += result.execution_time_us();
             _add_batch_counter.add_batch_wait_lock_time_us += result.wait_lock_time_us();
             _add_batch_counter.add_batch_num++;
+            _add_batch_counter.deserialize_time_us += result.deserialize_time_us();
+            _add_batch_counter.write_memtable_time_us += result.write_memtable_time_us();
+            _add_batch_counter.reduce_mem_time_us += result.reduce_mem_time_us();
+            _add_batch_counter.close_wait_time_us += result.close_wait_time_us();
+            _add_batch_counter.flush_time_us += result.flush_time_us();
+            _add_batch_counter.flush_count += result.flush_count();
         }
     });
 
@@ -368,7 +385,13 @@ int NodeChannel::try_send_chunk_and_fetch_status() {
         request.set_packet_seq(_next_packet_seq);
         if (chunk->num_rows() > 0) {
             SCOPED_RAW_TIMER(&_serialize_batch_ns);
-            chunk->serialize_with_meta(request.mutable_chunk());
+            auto st = _serialize_chunk(chunk.get(), request.mutable_chunk());
+            if (!st.ok()) {
+                LOG(WARNING) << name() << " serialize chunk failed, " << print_load_info() << ", err=" << st;
+                _cancelled = true;
+                _mem_tracker->release(chunk->memory_usage());
+                return 0;
+            }
         }
 
         _add_batch_closure->reset();
@@ -395,6 +418,37 @@ int NodeChannel::try_send_chunk_and_fetch_status() {
     return _send_finished ? 0 : 1;
 }
 
+Status NodeChannel::_serialize_chunk(const vectorized::Chunk* src, ChunkPB* dst) {
+    dst->set_compress_type(CompressionTypePB::NO_COMPRESSION);
+    // the tablets channel builds its chunk meta from the first chunk it receives,
+    // so the meta is always serialized.
+    size_t uncompressed_size = src->serialize_with_meta(dst);
+    if (_compress_codec == nullptr || uncompressed_size == 0) {
+        return Status::OK();
+    }
+    if (_compress_codec->exceed_max_input_size(uncompressed_size)) {
+        return Status::InternalError(strings::Substitute("The input size for compression should be less than $0",
+                                                          _compress_codec->max_input_size()));
+    }
+    dst->set_uncompressed_size(uncompressed_size);
+
+    // Try compressing data to _compression_scratch, swap if compressed data is smaller
+    size_t max_compressed_size = _compress_codec->max_compressed_len(uncompressed_size);
+    if (_compression_scratch.size() < max_compressed_size) {
+        _compression_scratch.resize(max_compressed_size);
+    }
+    Slice compressed_slice{_compression_scratch.data(), _compression_scratch.size()};
+    RETURN_IF_ERROR(_compress_codec->compress(dst->data(), &compressed_slice));
+    double compress_ratio = (static_cast<double>(uncompressed_size)) / compressed_slice.size;
+    if (LIKELY(compress_ratio > config::rpc_compress_ratio_threshold)) {
+        _compression_scratch.resize(compressed_slice.size);
+        dst->mutable_data()->swap(reinterpret_cast<std::string&>(_compression_scratch));
+        dst->set_compress_type(_compress_type);
+    }
+    VLOG_ROW << "uncompressed size: " << uncompressed_size << ", compressed size: " << compressed_slice.size;
+    return Status::OK();
+}
+
 Status NodeChannel::none_of(std::initializer_list<bool> vars) {
     bool none = std::none_of(vars.begin(), vars.end(), [](bool var) { return var; });
     Status st = Status::OK();
@@ -504,6 +558,7 @@ Status OlapTableSink::init(const TDataSink& t_sink) {
     } else {
         _load_channel_timeout_s = config::streaming_load_rpc_max_alive_time_sec;
     }
+    _input_sorted = table_sink.__isset.input_sorted && table_sink.input_sorted;
 
     return Status::OK();
 }
@@ -600,6 +655,14 @@ Status OlapTableSink::prepare(RuntimeState* state) {
     _close_timer = ADD_TIMER(_profile, "CloseWaitTime");
     _non_blocking_send_timer = ADD_TIMER(_profile, "NonBlockingSendTime");
     _serialize_batch_timer = ADD_TIMER(_profile, "SerializeBatchTime");
+    _rpc_execution_timer = ADD_TIMER(_profile, "RpcExecutionTime");
+    _rpc_wait_lock_timer = ADD_TIMER(_profile, "RpcWaitLockTime");
+    _rpc_deserialize_timer = ADD_TIMER(_profile, "RpcDeserializeTime");
+    _rpc_write_memtable_timer = ADD_TIMER(_profile, "RpcWriteMemtableTime");
+    _rpc_reduce_mem_timer = ADD_TIMER(_profile, "RpcReduceMemTime");
+    _rpc_close_wait_timer = ADD_TIMER(_profile, "RpcCloseWaitTime");
+    _memtable_flush_timer = ADD_TIMER(_profile, "MemtableFlushTime");
+    _memtable_flush_counter = ADD_COUNTER(_profile, "MemtableFlushCount", TUnit::UNIT);
     _load_mem_limit = state->get_load_mem_limit();
 
     // open all channels
@@ -864,6 +927,19 @@ Status OlapTableSink::close(RuntimeState* state, Status close_status) {
         state->set_num_rows_load_total(num_rows_load_total);
         state->update_num_rows_load_filtered(_number_filtered_rows);
 
+        AddBatchCounter total_add_batch_counter;
+        for (auto const& pair : node_add_batch_counter_map) {
+            total_add_batch_counter += pair.second;
+        }
+        COUNTER_SET(_rpc_execution_timer, total_add_batch_counter.add_batch_execution_time_us * 1000);
+        COUNTER_SET(_rpc_wait_lock_timer, total_add_batch_counter.add_batch_wait_lock_time_us * 1000);
+        COUNTER_SET(_rpc_deserialize_timer, total_add_batch_counter.deserialize_time_us * 1000);
+        COUNTER_SET(_rpc_write_memtable_timer, total_add_batch_counter.write_memtable_time_us * 1000);
+        COUNTER_SET(_rpc_reduce_mem_timer, total_add_batch_counter.reduce_mem_time_us * 1000);
+        COUNTER_SET(_rpc_close_wait_timer, total_add_batch_counter.close_wait_time_us * 1000);
+        COUNTER_SET(_memtable_flush_timer, total_add_batch_counter.flush_time_us * 1000);
+        COUNTER_SET(_memtable_flush_counter, total_add_batch_counter.flush_count);
+
         // print log of add batch time of all node, for tracing load performance easily
         std::stringstream ss;
         ss << "Closed olap table sink load_id=" << print_id(_load_id) << " txn_id=" << _txn_id
@@ -39,12 +39,14 @@
 #include "gen_cpp/internal_service.pb.h"
 #include "runtime/global_dicts.h"
 #include "util/bitmap.h"
+#include "util/raw_container.h"
 #include "util/ref_count_closure.h"
 #include "util/thrift_util.h"
 
 namespace starrocks {
 
 class Bitmap;
+class BlockCompressionCodec;
 class MemTracker;
 class RuntimeProfile;
 class RowDescriptor;
@@ -69,10 +71,24 @@ struct AddBatchCounter {
     int64_t add_batch_wait_lock_time_us = 0;
     // number of add_batch call
     int64_t add_batch_num = 0;
+    // time of the phases of add_chunk rpcs on the receiver
+    int64_t deserialize_time_us = 0;
+    int64_t write_memtable_time_us = 0;
+    int64_t reduce_mem_time_us = 0;
+    int64_t close_wait_time_us = 0;
+    // memtables flushed by the receiver
+    int64_t flush_time_us = 0;
+    int64_t flush_count = 0;
     AddBatchCounter& operator+=(const AddBatchCounter& rhs) {
         add_batch_execution_time_us += rhs.add_batch_execution_time_us;
         add_batch_wait_lock_time_us += rhs.add_batch_wait_lock_time_us;
         add_batch_num += rhs.add_batch_num;
+        deserialize_time_us += rhs.deserialize_time_us;
+        write_memtable_time_us += rhs.write_memtable_time_us;
+        reduce_mem_time_us += rhs.reduce_mem_time_us;
+        close_wait_time_us += rhs.close_wait_time_us;
+        flush_time_us += rhs.flush_time_us;
+        flush_count += rhs.flush_count;
         return *this;
     }
     friend AddBatchCounter operator+(const AddBatchCounter& lhs, const AddBatchCounter& rhs) {
@@ -194,6 +210,9 @@ public:
     void clear_all_batches();
 
 private:
+    // serialize |src| to |dst|, and compress the data if it is smaller enough after compression.
+    Status _serialize_chunk(const vectorized::Chunk* src, ChunkPB* dst);
+
     std::unique_ptr<MemTracker> _mem_tracker = nullptr;
 
     OlapTableSink* _parent = nullptr;
@@ -237,6 +256,10 @@ private:
     AddBatchCounter _add_batch_counter;
     int64_t _serialize_batch_ns = 0;
 
+    CompressionTypePB _compress_type = CompressionTypePB::NO_COMPRESSION;
+    const BlockCompressionCodec* _compress_codec = nullptr;
+    raw::RawString _compression_scratch;
+
     // vectorized
     bool _is_vectorized = true;
     std::unique_ptr<vectorized::Chunk> _cur_chunk;
@@ -416,12 +439,24 @@ private:
     RuntimeProfile::Counter* _close_timer = nullptr;
     RuntimeProfile::Counter* _non_blocking_send_timer = nullptr;
     RuntimeProfile::Counter* _serialize_batch_timer = nullptr;
+    // the sum of the counters reported by the receivers
+    RuntimeProfile::Counter* _rpc_execution_timer = nullptr;
+    RuntimeProfile::Counter* _rpc_wait_lock_timer = nullptr;
+    RuntimeProfile::Counter* _rpc_deserialize_timer = nullptr;
+    RuntimeProfile::Counter* _rpc_write_memtable_timer = nullptr;
+    RuntimeProfile::Counter* _rpc_reduce_mem_timer = nullptr;
+    RuntimeProfile::Counter* _rpc_close_wait_timer = nullptr;
+    RuntimeProfile::Counter* _memtable_flush_timer = nullptr;
+    RuntimeProfile::Counter* _memtable_flush_counter = nullptr;
 
     // load mem limit is for remote load channel
     int64_t _load_mem_limit = 0;
 
     // the timeout of load channels opened by this tablet sink. in second
     int64_t _load_channel_timeout_s = 0;
+
+    // whether the rows of every tablet are sent in the order of the keys.
+    bool _input_sorted = false;
 };
 
 } // namespace stream_load
@@ -51,6 +51,16 @@ using FixedSize16SliceAggHashMap =
 // two level agg hash map
 template <PhmapSeed seed>
 using Int32AggTwoLevelHashMap = phmap::parallel_flat_hash_map<int32_t, AggDataPtr, StdHashWithSeed<int32_t, seed>>;
+template <PhmapSeed seed>
+using Int64AggTwoLevelHashMap = phmap::parallel_flat_hash_map<int64_t, AggDataPtr, StdHashWithSeed<int64_t, seed>>;
+template <PhmapSeed seed>
+using Int128AggTwoLevelHashMap = phmap::parallel_flat_hash_map<int128_t, AggDataPtr, StdHashWithSeed<int128_t, seed>>;
+template <PhmapSeed seed>
+using FixedSize8SliceAggTwoLevelHashMap =
+        phmap::parallel_flat_hash_map<SliceKey8, AggDataPtr, FixedSizeSliceKeyHash<SliceKey8, seed>>;
+template <PhmapSeed seed>
+using FixedSize16SliceAggTwoLevelHashMap =
+        phmap::parallel_flat_hash_map<SliceKey16, AggDataPtr, FixedSizeSliceKeyHash<SliceKey16, seed>>;
 
 // The SliceAggTwoLevelHashMap will have 2 ^ 4 = 16 sub map,
 // The 16 is same as PartitionedAggregationNode::PARTITION_FANOUT
@@ -81,6 +91,25 @@ static_assert(sizeof(AggDataPtr) == sizeof(size_t));
         hash_map.prefetch_hash(hash_values[__prefetch_index++]); \
     }
 
+template <typename HashMap>
+struct IsTwoLevelAggHashMap : std::false_type {};
+template <class K, class V, class Hash, class Eq, class Alloc, size_t N, class Mutex, bool balance>
+struct IsTwoLevelAggHashMap<phmap::parallel_flat_hash_map<K, V, Hash, Eq, Alloc, N, Mutex, balance>>
+        : std::true_type {};
+
+// phmap::parallel_flat_hash_map::lazy_emplace_with_hash takes the hash value before the key, while
+// phmap::flat_hash_map::lazy_emplace_with_hash takes it after the key. The integer keys are implicitly
+// converted to the hash value and vice versa, so always call it through this function.
+template <typename HashMap, typename Key, typename Func>
+typename HashMap::iterator agg_hash_map_lazy_emplace_with_hash(HashMap& hash_map, const Key& key, size_t hashval,
+                                                               Func&& func) {
+    if constexpr (IsTwoLevelAggHashMap<HashMap>::value) {
+        return hash_map.lazy_emplace_with_hash(hashval, key, std::forward<Func>(func));
+    } else {
+        return hash_map.lazy_emplace_with_hash(key, hashval, std::forward<Func>(func));
+    }
+}
+
 // ==============================================================
 // TODO(kks): Remove redundant code for compute_agg_states method
 // handle one number hash key
@@ -106,8 +135,8 @@ struct AggHashMapWithOneNumberKey {
             AGG_HASH_MAP_PREFETCH_HASH_VALUE();
 
             FieldType key = column->get_data()[i];
-            auto iter = hash_map.lazy_emplace_with_hash(key, hash_values[i],
-                                                        [&](const auto& ctor) { ctor(key, allocate_func()); });
+            auto iter = agg_hash_map_lazy_emplace_with_hash(hash_map, key, hash_values[i],
+                                                            [&](const auto& ctor) { ctor(key, allocate_func()); });
             (*agg_states)[i] = iter->second;
         }
     }
@@ -173,8 +202,8 @@ struct AggHashMapWithOneNullableNumberKey {
                     AGG_HASH_MAP_PREFETCH_HASH_VALUE();
 
                     auto key = data_column->get_data()[i];
-                    auto iter = hash_map.lazy_emplace_with_hash(key, hash_values[i],
-                                                                [&](const auto& ctor) { ctor(key, allocate_func()); });
+                    auto iter = agg_hash_map_lazy_emplace_with_hash(
+                            hash_map, key, hash_values[i], [&](const auto& ctor) { ctor(key, allocate_func()); });
                     (*agg_states)[i] = iter->second;
                 }
                 return;
@@ -284,7 +313,7 @@ struct AggHashMapWithOneStringKey {
             AGG_HASH_MAP_PREFETCH_HASH_VALUE();
 
             auto key = column->get_slice(i);
-            auto iter = hash_map.lazy_emplace_with_hash(key, hash_values[i], [&](const auto& ctor) {
+            auto iter = agg_hash_map_lazy_emplace_with_hash(hash_map, key, hash_values[i], [&](const auto& ctor) {
                 // we must persist the slice before insert
                 uint8_t* pos = pool->allocate(key.size);
                 strings::memcpy_inlined(pos, key.data, key.size);
@@ -353,13 +382,14 @@ struct AggHashMapWithOneNullableStringKey {
                 for (size_t i = 0; i < column_size; i++) {
                     AGG_HASH_MAP_PREFETCH_HASH_VALUE();
                     auto key = data_column->get_slice(i);
-                    auto iter = hash_map.lazy_emplace_with_hash(key, hash_values[i], [&](const auto& ctor) {
-                        uint8_t* pos = pool->allocate(key.size);
-                        strings::memcpy_inlined(pos, key.data, key.size);
-                        Slice pk{pos, key.size};
-                        AggDataPtr pv = allocate_func();
-                        ctor(pk, pv);
-                    });
+                    auto iter =
+                            agg_hash_map_lazy_emplace_with_hash(hash_map, key, hash_values[i], [&](const auto& ctor) {
+                                uint8_t* pos = pool->allocate(key.size);
+                                strings::memcpy_inlined(pos, key.data, key.size);
+                                Slice pk{pos, key.size};
+                                AggDataPtr pv = allocate_func();
+                                ctor(pk, pv);
+                            });
                     (*agg_states)[i] = iter->second;
                 }
                 return;
@@ -622,7 +652,7 @@ struct AggHashMapWithSerializedKeyFixedSize {
                 hash_map.prefetch_hash(caches[__prefetch_index++].hashval);
             }
             FixedSizeSliceKey& key = caches[i].key;
-            auto iter = hash_map.lazy_emplace_with_hash(key, caches[i].hashval, [&](const auto& ctor) {
+            auto iter = agg_hash_map_lazy_emplace_with_hash(hash_map, key, caches[i].hashval, [&](const auto& ctor) {
                 AggDataPtr pv = allocate_func();
                 ctor(key, pv);
             });
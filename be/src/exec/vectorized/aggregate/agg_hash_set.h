@@ -45,6 +45,16 @@ using FixedSize16SliceAggHashSet = phmap::flat_hash_set<SliceKey16, FixedSizeSli
 // two level agg hash set
 template <PhmapSeed seed>
 using Int32AggTwoLevelHashSet = phmap::parallel_flat_hash_set<int32_t, StdHashWithSeed<int32_t, seed>>;
+template <PhmapSeed seed>
+using Int64AggTwoLevelHashSet = phmap::parallel_flat_hash_set<int64_t, StdHashWithSeed<int64_t, seed>>;
+template <PhmapSeed seed>
+using Int128AggTwoLevelHashSet = phmap::parallel_flat_hash_set<int128_t, StdHashWithSeed<int128_t, seed>>;
+template <PhmapSeed seed>
+using FixedSize8SliceAggTwoLevelHashSet =
+        phmap::parallel_flat_hash_set<SliceKey8, FixedSizeSliceKeyHash<SliceKey8, seed>>;
+template <PhmapSeed seed>
+using FixedSize16SliceAggTwoLevelHashSet =
+        phmap::parallel_flat_hash_set<SliceKey16, FixedSizeSliceKeyHash<SliceKey16, seed>>;
 
 template <PhmapSeed seed>
 using SliceAggTwoLevelHashSet =
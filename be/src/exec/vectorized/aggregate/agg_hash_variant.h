@@ -45,93 +45,125 @@ namespace starrocks::vectorized {
     M(phase1_slice_fx8)               \
     M(phase1_slice_fx16)              \
     M(phase2_slice_fx8)               \
-    M(phase2_slice_fx16)
-
-#define APPLY_FOR_VARIANT_NULL(M) \
-    M(phase1_null_uint8)          \
-    M(phase1_null_int8)           \
-    M(phase1_null_int16)          \
-    M(phase1_null_int32)          \
-    M(phase1_null_int64)          \
-    M(phase1_null_int128)         \
-    M(phase1_null_decimal32)      \
-    M(phase1_null_decimal64)      \
-    M(phase1_null_decimal128)     \
-    M(phase1_null_date)           \
-    M(phase1_null_timestamp)      \
-    M(phase1_null_string)         \
-    M(phase2_null_uint8)          \
-    M(phase2_null_int8)           \
-    M(phase2_null_int16)          \
-    M(phase2_null_int32)          \
-    M(phase2_null_int64)          \
-    M(phase2_null_int128)         \
-    M(phase2_null_decimal32)      \
-    M(phase2_null_decimal64)      \
-    M(phase2_null_decimal128)     \
-    M(phase2_null_date)           \
-    M(phase2_null_timestamp)      \
-    M(phase2_null_string)
-
-#define APPLY_FOR_VARIANT_ALL(M) \
-    M(phase1_uint8)              \
-    M(phase1_int8)               \
-    M(phase1_int16)              \
-    M(phase1_int32)              \
-    M(phase1_int64)              \
-    M(phase1_int128)             \
-    M(phase1_decimal32)          \
-    M(phase1_decimal64)          \
-    M(phase1_decimal128)         \
-    M(phase1_date)               \
-    M(phase1_timestamp)          \
-    M(phase1_string)             \
-    M(phase1_slice)              \
-    M(phase1_null_uint8)         \
-    M(phase1_null_int8)          \
-    M(phase1_null_int16)         \
-    M(phase1_null_int32)         \
-    M(phase1_null_int64)         \
-    M(phase1_null_int128)        \
-    M(phase1_null_decimal32)     \
-    M(phase1_null_decimal64)     \
-    M(phase1_null_decimal128)    \
-    M(phase1_null_date)          \
-    M(phase1_null_timestamp)     \
-    M(phase1_null_string)        \
-    M(phase1_slice_two_level)    \
-    M(phase1_int32_two_level)    \
-    M(phase2_uint8)              \
-    M(phase2_int8)               \
-    M(phase2_int16)              \
-    M(phase2_int32)              \
-    M(phase2_int64)              \
-    M(phase2_int128)             \
-    M(phase2_decimal32)          \
-    M(phase2_decimal64)          \
-    M(phase2_decimal128)         \
-    M(phase2_date)               \
-    M(phase2_timestamp)          \
-    M(phase2_string)             \
-    M(phase2_slice)              \
-    M(phase2_null_uint8)         \
-    M(phase2_null_int8)          \
-    M(phase2_null_int16)         \
-    M(phase2_null_int32)         \
-    M(phase2_null_int64)         \
-    M(phase2_null_int128)        \
-    M(phase2_null_decimal32)     \
-    M(phase2_null_decimal64)     \
-    M(phase2_null_decimal128)    \
-    M(phase2_null_date)          \
-    M(phase2_null_timestamp)     \
-    M(phase2_null_string)        \
-    M(phase2_slice_two_level)    \
-    M(phase2_int32_two_level)    \
-    M(phase1_slice_fx8)          \
-    M(phase1_slice_fx16)         \
-    M(phase2_slice_fx8)          \
-    M(phase2_slice_fx16)
+    M(phase2_slice_fx16)              \
+    M(phase1_int64_two_level)         \
+    M(phase1_int128_two_level)        \
+    M(phase1_string_two_level)        \
+    M(phase1_slice_fx8_two_level)     \
+    M(phase1_slice_fx16_two_level)    \
+    M(phase2_int64_two_level)         \
+    M(phase2_int128_two_level)        \
+    M(phase2_string_two_level)        \
+    M(phase2_slice_fx8_two_level)     \
+    M(phase2_slice_fx16_two_level)
+
+#define APPLY_FOR_VARIANT_NULL(M)   \
+    M(phase1_null_uint8)            \
+    M(phase1_null_int8)             \
+    M(phase1_null_int16)            \
+    M(phase1_null_int32)            \
+    M(phase1_null_int64)            \
+    M(phase1_null_int128)           \
+    M(phase1_null_decimal32)        \
+    M(phase1_null_decimal64)        \
+    M(phase1_null_decimal128)       \
+    M(phase1_null_date)             \
+    M(phase1_null_timestamp)        \
+    M(phase1_null_string)           \
+    M(phase2_null_uint8)            \
+    M(phase2_null_int8)             \
+    M(phase2_null_int16)            \
+    M(phase2_null_int32)            \
+    M(phase2_null_int64)            \
+    M(phase2_null_int128)           \
+    M(phase2_null_decimal32)        \
+    M(phase2_null_decimal64)        \
+    M(phase2_null_decimal128)       \
+    M(phase2_null_date)             \
+    M(phase2_null_timestamp)        \
+    M(phase2_null_string)           \
+    M(phase1_null_int64_two_level)  \
+    M(phase1_null_int128_two_level) \
+    M(phase1_null_string_two_level) \
+    M(phase2_null_int64_two_level)  \
+    M(phase2_null_int128_two_level) \
+    M(phase2_null_string_two_level)
+
+#define APPLY_FOR_VARIANT_ALL(M)    \
+    M(phase1_uint8)                 \
+    M(phase1_int8)                  \
+    M(phase1_int16)                 \
+    M(phase1_int32)                 \
+    M(phase1_int64)                 \
+    M(phase1_int128)                \
+    M(phase1_decimal32)             \
+    M(phase1_decimal64)             \
+    M(phase1_decimal128)            \
+    M(phase1_date)                  \
+    M(phase1_timestamp)             \
+    M(phase1_string)                \
+    M(phase1_slice)                 \
+    M(phase1_null_uint8)            \
+    M(phase1_null_int8)             \
+    M(phase1_null_int16)            \
+    M(phase1_null_int32)            \
+    M(phase1_null_int64)            \
+    M(phase1_null_int128)           \
+    M(phase1_null_decimal32)        \
+    M(phase1_null_decimal64)        \
+    M(phase1_null_decimal128)       \
+    M(phase1_null_date)             \
+    M(phase1_null_timestamp)        \
+    M(phase1_null_string)           \
+    M(phase1_slice_two_level)       \
+    M(phase1_int32_two_level)       \
+    M(phase2_uint8)                 \
+    M(phase2_int8)                  \
+    M(phase2_int16)                 \
+    M(phase2_int32)                 \
+    M(phase2_int64)                 \
+    M(phase2_int128)                \
+    M(phase2_decimal32)             \
+    M(phase2_decimal64)             \
+    M(phase2_decimal128)            \
+    M(phase2_date)                  \
+    M(phase2_timestamp)             \
+    M(phase2_string)                \
+    M(phase2_slice)                 \
+    M(phase2_null_uint8)            \
+    M(phase2_null_int8)             \
+    M(phase2_null_int16)            \
+    M(phase2_null_int32)            \
+    M(phase2_null_int64)            \
+    M(phase2_null_int128)           \
+    M(phase2_null_decimal32)        \
+    M(phase2_null_decimal64)        \
+    M(phase2_null_decimal128)       \
+    M(phase2_null_date)             \
+    M(phase2_null_timestamp)        \
+    M(phase2_null_string)           \
+    M(phase2_slice_two_level)       \
+    M(phase2_int32_two_level)       \
+    M(phase1_slice_fx8)             \
+    M(phase1_slice_fx16)            \
+    M(phase2_slice_fx8)             \
+    M(phase2_slice_fx16)            \
+    M(phase1_int64_two_level)       \
+    M(phase1_int128_two_level)      \
+    M(phase1_string_two_level)      \
+    M(phase1_slice_fx8_two_level)   \
+    M(phase1_slice_fx16_two_level)  \
+    M(phase1_null_int64_two_level)  \
+    M(phase1_null_int128_two_level) \
+    M(phase1_null_string_two_level) \
+    M(phase2_int64_two_level)       \
+    M(phase2_int128_two_level)      \
+    M(phase2_string_two_level)      \
+    M(phase2_slice_fx8_two_level)   \
+    M(phase2_slice_fx16_two_level)  \
+    M(phase2_null_int64_two_level)  \
+    M(phase2_null_int128_two_level) \
+    M(phase2_null_string_two_level)
 
 // Hash maps for phase1
 template <PhmapSeed seed>
@@ -197,12 +229,33 @@ template <PhmapSeed seed>
 using SerializedKeyTwoLevelAggHashMap = AggHashMapWithSerializedKey<SliceAggTwoLevelHashMap<seed>>;
 template <PhmapSeed seed>
 using Int32TwoLevelAggHashMapWithOneNumberKey = AggHashMapWithOneNumberKey<TYPE_INT, Int32AggTwoLevelHashMap<seed>>;
+template <PhmapSeed seed>
+using Int64TwoLevelAggHashMapWithOneNumberKey = AggHashMapWithOneNumberKey<TYPE_BIGINT, Int64AggTwoLevelHashMap<seed>>;
+template <PhmapSeed seed>
+using Int128TwoLevelAggHashMapWithOneNumberKey =
+        AggHashMapWithOneNumberKey<TYPE_LARGEINT, Int128AggTwoLevelHashMap<seed>>;
+template <PhmapSeed seed>
+using NullInt64TwoLevelAggHashMapWithOneNumberKey =
+        AggHashMapWithOneNullableNumberKey<TYPE_BIGINT, Int64AggTwoLevelHashMap<seed>>;
+template <PhmapSeed seed>
+using NullInt128TwoLevelAggHashMapWithOneNumberKey =
+        AggHashMapWithOneNullableNumberKey<TYPE_LARGEINT, Int128AggTwoLevelHashMap<seed>>;
+template <PhmapSeed seed>
+using OneStringTwoLevelAggHashMap = AggHashMapWithOneStringKey<SliceAggTwoLevelHashMap<seed>>;
+template <PhmapSeed seed>
+using NullOneStringTwoLevelAggHashMap = AggHashMapWithOneNullableStringKey<SliceAggTwoLevelHashMap<seed>>;
 
 // fixed slice key type.
 template <PhmapSeed seed>
 using SerializedKeyFixedSize8AggHashMap = AggHashMapWithSerializedKeyFixedSize<FixedSize8SliceAggHashMap<seed>>;
 template <PhmapSeed seed>
 using SerializedKeyFixedSize16AggHashMap = AggHashMapWithSerializedKeyFixedSize<FixedSize16SliceAggHashMap<seed>>;
+template <PhmapSeed seed>
+using SerializedKeyFixedSize8TwoLevelAggHashMap =
+        AggHashMapWithSerializedKeyFixedSize<FixedSize8SliceAggTwoLevelHashMap<seed>>;
+template <PhmapSeed seed>
+using SerializedKeyFixedSize16TwoLevelAggHashMap =
+        AggHashMapWithSerializedKeyFixedSize<FixedSize16SliceAggTwoLevelHashMap<seed>>;
 
 // 1) For different group by columns type, size, cardinality, volume, we should choose different
 // hash functions and different hashmaps.
@@ -279,6 +332,23 @@ struct HashMapVariant {
 
         phase2_slice_fx8,
         phase2_slice_fx16,
+
+        phase1_int64_two_level,
+        phase1_int128_two_level,
+        phase1_string_two_level,
+        phase1_slice_fx8_two_level,
+        phase1_slice_fx16_two_level,
+        phase1_null_int64_two_level,
+        phase1_null_int128_two_level,
+        phase1_null_string_two_level,
+        phase2_int64_two_level,
+        phase2_int128_two_level,
+        phase2_string_two_level,
+        phase2_slice_fx8_two_level,
+        phase2_slice_fx16_two_level,
+        phase2_null_int64_two_level,
+        phase2_null_int128_two_level,
+        phase2_null_string_two_level,
     };
     Type type = Type::phase1_slice;
 
@@ -352,6 +422,24 @@ struct HashMapVariant {
     std::unique_ptr<SerializedKeyFixedSize8AggHashMap<PhmapSeed2>> phase2_slice_fx8;
     std::unique_ptr<SerializedKeyFixedSize16AggHashMap<PhmapSeed2>> phase2_slice_fx16;
 
+    std::unique_ptr<Int64TwoLevelAggHashMapWithOneNumberKey<PhmapSeed1>> phase1_int64_two_level;
+    std::unique_ptr<Int128TwoLevelAggHashMapWithOneNumberKey<PhmapSeed1>> phase1_int128_two_level;
+    std::unique_ptr<OneStringTwoLevelAggHashMap<PhmapSeed1>> phase1_string_two_level;
+    std::unique_ptr<SerializedKeyFixedSize8TwoLevelAggHashMap<PhmapSeed1>> phase1_slice_fx8_two_level;
+    std::unique_ptr<SerializedKeyFixedSize16TwoLevelAggHashMap<PhmapSeed1>> phase1_slice_fx16_two_level;
+    std::unique_ptr<NullInt64TwoLevelAggHashMapWithOneNumberKey<PhmapSeed1>> phase1_null_int64_two_level;
+    std::unique_ptr<NullInt128TwoLevelAggHashMapWithOneNumberKey<PhmapSeed1>> phase1_null_int128_two_level;
+    std::unique_ptr<NullOneStringTwoLevelAggHashMap<PhmapSeed1>> phase1_null_string_two_level;
+
+    std::unique_ptr<Int64TwoLevelAggHashMapWithOneNumberKey<PhmapSeed2>> phase2_int64_two_level;
+    std::unique_ptr<Int128TwoLevelAggHashMapWithOneNumberKey<PhmapSeed2>> phase2_int128_two_level;
+    std::unique_ptr<OneStringTwoLevelAggHashMap<PhmapSeed2>> phase2_string_two_level;
+    std::unique_ptr<SerializedKeyFixedSize8TwoLevelAggHashMap<PhmapSeed2>> phase2_slice_fx8_two_level;
+    std::unique_ptr<SerializedKeyFixedSize16TwoLevelAggHashMap<PhmapSeed2>> phase2_slice_fx16_two_level;
+    std::unique_ptr<NullInt64TwoLevelAggHashMapWithOneNumberKey<PhmapSeed2>> phase2_null_int64_two_level;
+    std::unique_ptr<NullInt128TwoLevelAggHashMapWithOneNumberKey<PhmapSeed2>> phase2_null_int128_two_level;
+    std::unique_ptr<NullOneStringTwoLevelAggHashMap<PhmapSeed2>> phase2_null_string_two_level;
+
     void init(Type type_) {
         type = type_;
         switch (type_) {
@@ -466,6 +554,21 @@ template <PhmapSeed seed>
 using SerializedTwoLevelKeyAggHashSet = AggHashSetOfSerializedKey<SliceAggTwoLevelHashSet<seed>>;
 template <PhmapSeed seed>
 using Int32TwoLevelAggHashSetOfOneNumberKey = AggHashSetOfOneNumberKey<TYPE_INT, Int32AggTwoLevelHashSet<seed>>;
+template <PhmapSeed seed>
+using Int64TwoLevelAggHashSetOfOneNumberKey = AggHashSetOfOneNumberKey<TYPE_BIGINT, Int64AggTwoLevelHashSet<seed>>;
+template <PhmapSeed seed>
+using Int128TwoLevelAggHashSetOfOneNumberKey =
+        AggHashSetOfOneNumberKey<TYPE_LARGEINT, Int128AggTwoLevelHashSet<seed>>;
+template <PhmapSeed seed>
+using NullInt64TwoLevelAggHashSetOfOneNumberKey =
+        AggHashSetOfOneNullableNumberKey<TYPE_BIGINT, Int64AggTwoLevelHashSet<seed>>;
+template <PhmapSeed seed>
+using NullInt128TwoLevelAggHashSetOfOneNumberKey =
+        AggHashSetOfOneNullableNumberKey<TYPE_LARGEINT, Int128AggTwoLevelHashSet<seed>>;
+template <PhmapSeed seed>
+using OneStringTwoLevelAggHashSet = AggHashSetOfOneStringKey<SliceAggTwoLevelHashSet<seed>>;
+template <PhmapSeed seed>
+using NullOneStringTwoLevelAggHashSet = AggHashSetOfOneNullableStringKey<SliceAggTwoLevelHashSet<seed>>;
 
 // For fixed slice type.
 template <PhmapSeed seed>
@@ -474,6 +577,14 @@ using SerializedKeyAggHashSetFixedSize8 = AggHashSetOfSerializedKeyFixedSize<Fix
 template <PhmapSeed seed>
 using SerializedKeyAggHashSetFixedSize16 = AggHashSetOfSerializedKeyFixedSize<FixedSize16SliceAggHashSet<seed>>;
 
+template <PhmapSeed seed>
+using SerializedKeyTwoLevelAggHashSetFixedSize8 =
+        AggHashSetOfSerializedKeyFixedSize<FixedSize8SliceAggTwoLevelHashSet<seed>>;
+
+template <PhmapSeed seed>
+using SerializedKeyTwoLevelAggHashSetFixedSize16 =
+        AggHashSetOfSerializedKeyFixedSize<FixedSize16SliceAggTwoLevelHashSet<seed>>;
+
 // 1) HashSetVariant is alike HashMapVariant, while a set only holds keys, no associated value.
 //
 // 2) Distributed aggregation is divided into two stages.
@@ -543,6 +654,23 @@ struct HashSetVariant {
         phase1_slice_fx16,
         phase2_slice_fx8,
         phase2_slice_fx16,
+
+        phase1_int64_two_level,
+        phase1_int128_two_level,
+        phase1_string_two_level,
+        phase1_slice_fx8_two_level,
+        phase1_slice_fx16_two_level,
+        phase1_null_int64_two_level,
+        phase1_null_int128_two_level,
+        phase1_null_string_two_level,
+        phase2_int64_two_level,
+        phase2_int128_two_level,
+        phase2_string_two_level,
+        phase2_slice_fx8_two_level,
+        phase2_slice_fx16_two_level,
+        phase2_null_int64_two_level,
+        phase2_null_int128_two_level,
+        phase2_null_string_two_level,
     };
     Type type = Type::phase1_slice;
 
@@ -619,6 +747,24 @@ struct HashSetVariant {
     std::unique_ptr<SerializedKeyAggHashSetFixedSize8<PhmapSeed2>> phase2_slice_fx8;
     std::unique_ptr<SerializedKeyAggHashSetFixedSize16<PhmapSeed2>> phase2_slice_fx16;
 
+    std::unique_ptr<Int64TwoLevelAggHashSetOfOneNumberKey<PhmapSeed1>> phase1_int64_two_level;
+    std::unique_ptr<Int128TwoLevelAggHashSetOfOneNumberKey<PhmapSeed1>> phase1_int128_two_level;
+    std::unique_ptr<OneStringTwoLevelAggHashSet<PhmapSeed1>> phase1_string_two_level;
+    std::unique_ptr<SerializedKeyTwoLevelAggHashSetFixedSize8<PhmapSeed1>> phase1_slice_fx8_two_level;
+    std::unique_ptr<SerializedKeyTwoLevelAggHashSetFixedSize16<PhmapSeed1>> phase1_slice_fx16_two_level;
+    std::unique_ptr<NullInt64TwoLevelAggHashSetOfOneNumberKey<PhmapSeed1>> phase1_null_int64_two_level;
+    std::unique_ptr<NullInt128TwoLevelAggHashSetOfOneNumberKey<PhmapSeed1>> phase1_null_int128_two_level;
+    std::unique_ptr<NullOneStringTwoLevelAggHashSet<PhmapSeed1>> phase1_null_string_two_level;
+
+    std::unique_ptr<Int64TwoLevelAggHashSetOfOneNumberKey<PhmapSeed2>> phase2_int64_two_level;
+    std::unique_ptr<Int128TwoLevelAggHashSetOfOneNumberKey<PhmapSeed2>> phase2_int128_two_level;
+    std::unique_ptr<OneStringTwoLevelAggHashSet<PhmapSeed2>> phase2_string_two_level;
+    std::unique_ptr<SerializedKeyTwoLevelAggHashSetFixedSize8<PhmapSeed2>> phase2_slice_fx8_two_level;
+    std::unique_ptr<SerializedKeyTwoLevelAggHashSetFixedSize16<PhmapSeed2>> phase2_slice_fx16_two_level;
+    std::unique_ptr<NullInt64TwoLevelAggHashSetOfOneNumberKey<PhmapSeed2>> phase2_null_int64_two_level;
+    std::unique_ptr<NullInt128TwoLevelAggHashSetOfOneNumberKey<PhmapSeed2>> phase2_null_int128_two_level;
+    std::unique_ptr<NullOneStringTwoLevelAggHashSet<PhmapSeed2>> phase2_null_string_two_level;
+
     void init(Type type_) {
         type = type_;
         switch (type_) {
@@ -7,10 +7,16 @@
 #include "exec/pipeline/operator.h"
 #include "exec/pipeline/pipeline_builder.h"
 #include "exec/vectorized/aggregator.h"
+#include "exprs/expr.h"
 #include "simd/simd.h"
 
 namespace starrocks::vectorized {
 
+Status AggregateBlockingNode::init(const TPlanNode& tnode, RuntimeState* state) {
+    RETURN_IF_ERROR(AggregateBaseNode::init(tnode, state));
+    return Expr::create_expr_trees(_pool, tnode.agg_node.grouping_exprs, &_local_shuffle_expr_ctxs);
+}
+
 Status AggregateBlockingNode::prepare(RuntimeState* state) {
     RETURN_IF_ERROR(AggregateBaseNode::prepare(state));
     _aggregator->set_aggr_phase(AggrPhase2);
@@ -157,22 +163,38 @@ std::vector<std::shared_ptr<pipeline::OperatorFactory> > AggregateBlockingNode::
         pipeline::PipelineBuilderContext* context) {
     using namespace pipeline;
     OpFactories operators_with_sink = _children[0]->decompose_to_pipeline(context);
-    operators_with_sink = context->maybe_interpolate_local_passthrough_exchange(operators_with_sink);
+    size_t degree_of_parallelism =
+            down_cast<SourceOperatorFactory*>(operators_with_sink[0].get())->degree_of_parallelism();
+    // Shuffle the input rows by the group by keys, so that each driver owns a disjoint set of keys, merges
+    // the partial states of its keys into its own hash map and outputs them independently.
+    // The rows of the same key must be aggregated by the same driver, so the hot partitions are not rebalanced.
+    // The limit is applied by each aggregator, hence the local shuffle is not used with limit.
+    bool parallel_agg = config::pipeline_enable_parallel_blocking_agg && !_local_shuffle_expr_ctxs.empty() &&
+                        limit() == -1 && degree_of_parallelism > 1;
+    if (parallel_agg) {
+        operators_with_sink =
+                context->maybe_interpolate_local_shuffle_exchange(operators_with_sink, _local_shuffle_expr_ctxs);
+        degree_of_parallelism =
+                down_cast<SourceOperatorFactory*>(operators_with_sink[0].get())->degree_of_parallelism();
+    } else {
+        operators_with_sink = context->maybe_interpolate_local_passthrough_exchange(operators_with_sink);
+        degree_of_parallelism = 1;
+    }
 
-    // shared by sink operator and source operator
-    AggregatorPtr aggregator = std::make_shared<Aggregator>(_tnode);
+    // shared by sink operator factory and source operator factory
+    AggregatorFactoryPtr aggregator_factory = std::make_shared<AggregatorFactory>(_tnode);
 
-    operators_with_sink.emplace_back(
-            std::make_shared<AggregateBlockingSinkOperatorFactory>(context->next_operator_id(), id(), aggregator));
+    operators_with_sink.emplace_back(std::make_shared<AggregateBlockingSinkOperatorFactory>(
+            context->next_operator_id(), id(), aggregator_factory));
     context->add_pipeline(operators_with_sink);
 
     OpFactories operators_with_source;
-    auto source_operator =
-            std::make_shared<AggregateBlockingSourceOperatorFactory>(context->next_operator_id(), id(), aggregator);
+    auto source_operator = std::make_shared<AggregateBlockingSourceOperatorFactory>(context->next_operator_id(), id(),
+                                                                                    aggregator_factory);
 
-    // TODO(hcf) Currently, the shared data structure aggregator does not support concurrency.
-    // So the degree of parallism must set to 1, we'll fix it later
-    source_operator->set_degree_of_parallelism(1);
+    // Aggregator must be used by a pair of sink and source operators,
+    // so operators_with_source's degree of parallelism must be equal with operators_with_sink's
+    source_operator->set_degree_of_parallelism(degree_of_parallelism);
     operators_with_source.push_back(std::move(source_operator));
     return operators_with_source;
 }
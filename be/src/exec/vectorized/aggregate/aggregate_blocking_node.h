@@ -14,11 +14,16 @@ public:
     AggregateBlockingNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs)
             : AggregateBaseNode(pool, tnode, descs) {}
 
+    Status init(const TPlanNode& tnode, RuntimeState* state) override;
     Status prepare(RuntimeState* state) override;
     Status open(RuntimeState* state) override;
     Status get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) override;
 
     std::vector<std::shared_ptr<pipeline::OperatorFactory>> decompose_to_pipeline(
             pipeline::PipelineBuilderContext* context) override;
+
+private:
+    // only used to shuffle the input rows in pipeline engine, see decompose_to_pipeline.
+    std::vector<ExprContext*> _local_shuffle_expr_ctxs;
 };
 } // namespace starrocks::vectorized
@@ -6,10 +6,16 @@
 #include "exec/pipeline/aggregate/aggregate_streaming_source_operator.h"
 #include "exec/pipeline/operator.h"
 #include "exec/pipeline/pipeline_builder.h"
+#include "exprs/expr.h"
 #include "simd/simd.h"
 
 namespace starrocks::vectorized {
 
+Status AggregateStreamingNode::init(const TPlanNode& tnode, RuntimeState* state) {
+    RETURN_IF_ERROR(AggregateBaseNode::init(tnode, state));
+    return Expr::create_expr_trees(_pool, tnode.agg_node.grouping_exprs, &_local_shuffle_expr_ctxs);
+}
+
 Status AggregateStreamingNode::prepare(RuntimeState* state) {
     RETURN_IF_ERROR(AggregateBaseNode::prepare(state));
     _aggregator->set_aggr_phase(AggrPhase1);
@@ -50,8 +56,10 @@ Status AggregateStreamingNode::get_next(RuntimeState* state, ChunkPtr* chunk, bo
             COUNTER_SET(_aggregator->input_row_count(), _aggregator->num_input_rows());
             RETURN_IF_ERROR(_aggregator->check_hash_map_memory_usage(state));
             _aggregator->evaluate_exprs(input_chunk.get());
+            _aggregator->sample_streaming_reduction(input_chunk_size);
 
-            if (_aggregator->streaming_preaggregation_mode() == TStreamingPreaggregationMode::FORCE_STREAMING) {
+            if (_aggregator->streaming_preaggregation_mode() == TStreamingPreaggregationMode::FORCE_STREAMING ||
+                _aggregator->is_streaming_pass_through()) {
                 // force execute streaming
                 SCOPED_TIMER(_aggregator->streaming_timer());
                 _aggregator->output_chunk_by_streaming(chunk);
@@ -222,6 +230,12 @@ std::vector<std::shared_ptr<pipeline::OperatorFactory> > AggregateStreamingNode:
         pipeline::PipelineBuilderContext* context) {
     using namespace pipeline;
     OpFactories operators_with_sink = _children[0]->decompose_to_pipeline(context);
+    // Shuffle the input rows by the group by keys, so that each driver aggregates the rows of less distinct keys.
+    // The rows of hot keys can be rebalanced to other drivers, since the output rows are merged by the second phase.
+    if (config::pipeline_enable_streaming_agg_local_shuffle && !_local_shuffle_expr_ctxs.empty()) {
+        operators_with_sink =
+                context->maybe_interpolate_local_shuffle_exchange(operators_with_sink, _local_shuffle_expr_ctxs, true);
+    }
     // We cannot get degree of parallelism from PipelineBuilderContext, of which is only a suggest value
     // and we may set other parallelism for source operator in many special cases
     size_t degree_of_parallelism =
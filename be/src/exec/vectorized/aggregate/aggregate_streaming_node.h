@@ -13,6 +13,7 @@ public:
     AggregateStreamingNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs)
             : AggregateBaseNode(pool, tnode, descs) {}
 
+    Status init(const TPlanNode& tnode, RuntimeState* state) override;
     Status prepare(RuntimeState* state) override;
     Status open(RuntimeState* state) override;
     Status get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) override;
@@ -22,5 +23,8 @@ public:
 
 private:
     void _output_chunk_from_hash_map(ChunkPtr* chunk);
+
+    // only used to shuffle the input rows in pipeline engine, see decompose_to_pipeline.
+    std::vector<ExprContext*> _local_shuffle_expr_ctxs;
 };
 } // namespace starrocks::vectorized
\ No newline at end of file
@@ -63,6 +63,7 @@ Status DistinctBlockingNode::open(RuntimeState* state) {
             }
 
             RETURN_IF_ERROR(_aggregator->check_hash_set_memory_usage(state));
+            _aggregator->try_convert_to_two_level_set();
         }
     }
 
@@ -52,9 +52,12 @@ Status DistinctStreamingNode::get_next(RuntimeState* state, ChunkPtr* chunk, boo
             _aggregator->update_num_input_rows(input_chunk_size);
             COUNTER_SET(_aggregator->input_row_count(), _aggregator->num_input_rows());
             RETURN_IF_ERROR(_aggregator->check_hash_set_memory_usage(state));
+            _aggregator->try_convert_to_two_level_set();
             _aggregator->evaluate_exprs(input_chunk.get());
+            _aggregator->sample_streaming_reduction(input_chunk_size);
 
-            if (_aggregator->streaming_preaggregation_mode() == TStreamingPreaggregationMode::FORCE_STREAMING) {
+            if (_aggregator->streaming_preaggregation_mode() == TStreamingPreaggregationMode::FORCE_STREAMING ||
+                _aggregator->is_streaming_pass_through()) {
                 // force execute streaming
                 SCOPED_TIMER(_aggregator->streaming_timer());
                 _aggregator->output_chunk_by_streaming(chunk);
@@ -2,7 +2,11 @@
 
 #include "aggregator.h"
 
+#include <numeric>
+
 #include "exprs/anyval_util.h"
+#include "util/hash_util.hpp"
+#include "util/uid_util.h"
 
 namespace starrocks {
 
@@ -136,20 +140,26 @@ Status Aggregator::prepare(RuntimeState* state, ObjectPool* pool, MemTracker* me
     }
 
     // compute agg state total size and offsets
-    for (int i = 0; i < _agg_fn_ctxs.size(); ++i) {
+    // The states of one group are allocated together, place them in the descending order of alignment so that
+    // no padding is needed between them, e.g. the states of max(tinyint), count(*), min(tinyint), count(*) take
+    // 24 bytes rather than 32.
+    std::vector<size_t> state_order(_agg_fn_ctxs.size());
+    std::iota(state_order.begin(), state_order.end(), 0);
+    std::stable_sort(state_order.begin(), state_order.end(), [this](size_t lhs, size_t rhs) {
+        return _agg_functions[lhs]->alignof_size() > _agg_functions[rhs]->alignof_size();
+    });
+    for (size_t i : state_order) {
+        size_t align_size = _agg_functions[i]->alignof_size();
+        // Add padding by rounding up '_agg_states_total_size' to be a multiplier of align_size.
+        _agg_states_total_size = (_agg_states_total_size + align_size - 1) / align_size * align_size;
         _agg_states_offsets[i] = _agg_states_total_size;
         _agg_states_total_size += _agg_functions[i]->size();
-        _max_agg_state_align_size = std::max(_max_agg_state_align_size, _agg_functions[i]->alignof_size());
-
-        // If not the last aggregate_state, we need pad it so that next aggregate_state will be aligned.
-        if (i + 1 < _agg_fn_ctxs.size()) {
-            size_t next_state_align_size = _agg_functions[i + 1]->alignof_size();
-            // Extend total_size to next alignment requirement
-            // Add padding by rounding up '_agg_states_total_size' to be a multiplier of next_state_align_size.
-            _agg_states_total_size = (_agg_states_total_size + next_state_align_size - 1) / next_state_align_size *
-                                     next_state_align_size;
-        }
+        _max_agg_state_align_size = std::max(_max_agg_state_align_size, align_size);
     }
+    // Round up the total size, so that the states of the consecutive groups are packed in _mem_pool
+    // without the padding of allocate_aligned.
+    _agg_states_total_size = (_agg_states_total_size + _max_agg_state_align_size - 1) / _max_agg_state_align_size *
+                             _max_agg_state_align_size;
 
     _is_only_group_by_columns = _agg_expr_ctxs.empty() && !_group_by_expr_ctxs.empty();
 
@@ -166,6 +176,20 @@ Status Aggregator::prepare(RuntimeState* state, ObjectPool* pool, MemTracker* me
     _input_row_count = ADD_COUNTER(_runtime_profile, "InputRowCount", TUnit::UNIT);
     _hash_table_size = ADD_COUNTER(_runtime_profile, "HashTableSize", TUnit::UNIT);
     _pass_through_row_count = ADD_COUNTER(_runtime_profile, "PassThroughRowCount", TUnit::UNIT);
+    _hash_table_memory_usage = _runtime_profile->AddHighWaterMarkCounter("HashTableMemoryUsage", TUnit::BYTES);
+    _key_memory_usage = _runtime_profile->AddHighWaterMarkCounter("KeyMemoryUsage", TUnit::BYTES);
+    _agg_state_memory_usage = _runtime_profile->AddHighWaterMarkCounter("AggStateMemoryUsage", TUnit::BYTES);
+    _agg_func_memory_usage = _runtime_profile->AddHighWaterMarkCounter("AggFuncMemoryUsage", TUnit::BYTES);
+    _mem_pool_memory_usage = _runtime_profile->AddHighWaterMarkCounter("MemPoolMemoryUsage", TUnit::BYTES);
+
+    _enable_spill = state->enable_spill() && !_group_by_expr_ctxs.empty() && !_is_only_group_by_columns;
+    if (_enable_spill) {
+        _spill_timer = ADD_TIMER(_runtime_profile, "SpillTime");
+        _restore_timer = ADD_TIMER(_runtime_profile, "SpillRestoreTime");
+        _spill_count = ADD_COUNTER(_runtime_profile, "SpillCount", TUnit::UNIT);
+        _spill_rows = ADD_COUNTER(_runtime_profile, "SpillRows", TUnit::UNIT);
+        _spill_bytes = ADD_COUNTER(_runtime_profile, "SpillBytes", TUnit::BYTES);
+    }
 
     SCOPED_TIMER(_runtime_profile->total_time_counter());
 
@@ -241,6 +265,7 @@ Status Aggregator::close(RuntimeState* state) {
 
     _mem_tracker->release(_last_agg_func_memory_usage);
     _mem_tracker->release(_last_ht_memory_usage);
+    _spill_files.clear();
 
     Expr::close(_group_by_expr_ctxs, state);
     for (const auto& i : _agg_expr_ctxs) {
@@ -304,6 +329,47 @@ bool Aggregator::should_expand_preagg_hash_tables(size_t prev_row_returned, size
     return current_reduction > min_reduction;
 }
 
+void Aggregator::sample_streaming_reduction(size_t chunk_size) {
+    if (_streaming_preaggregation_mode != TStreamingPreaggregationMode::AUTO || _group_by_columns.empty() ||
+        config::streaming_agg_sample_window_rows <= 0 || chunk_size == 0) {
+        return;
+    }
+    if (_sample_window_count == nullptr) {
+        _sampled_reduction = ADD_COUNTER(_runtime_profile, "StreamingSampledReduction", TUnit::DOUBLE_VALUE);
+        _sample_window_count = ADD_COUNTER(_runtime_profile, "StreamingSampleWindowCount", TUnit::UNIT);
+        _switch_to_pass_through_count = ADD_COUNTER(_runtime_profile, "StreamingSwitchToPassThroughCount", TUnit::UNIT);
+        _switch_to_preagg_count = ADD_COUNTER(_runtime_profile, "StreamingSwitchToPreaggCount", TUnit::UNIT);
+    }
+
+    _sampled_hashes.assign(chunk_size, HashUtil::FNV_SEED);
+    for (const auto& column : _group_by_columns) {
+        column->fnv_hash(_sampled_hashes.data(), 0, chunk_size);
+    }
+    // HyperLogLog takes the leading bits as the register index, so spread the 32 bits hash to 64 bits.
+    for (uint32_t hash : _sampled_hashes) {
+        _sampled_keys.update(HashUtil::murmur_hash64A(&hash, sizeof(hash), HashUtil::MURMUR_SEED));
+    }
+    _sampled_rows += chunk_size;
+    if (_sampled_rows < config::streaming_agg_sample_window_rows) {
+        return;
+    }
+
+    double reduction = static_cast<double>(_sampled_rows) / std::max<int64_t>(_sampled_keys.estimate_cardinality(), 1);
+    COUNTER_SET(_sampled_reduction, reduction);
+    COUNTER_UPDATE(_sample_window_count, 1);
+    // Use different thresholds to switch the two modes, to avoid switching back and forth on every window.
+    if (!_is_streaming_pass_through && reduction < config::streaming_agg_pass_through_reduction) {
+        _is_streaming_pass_through = true;
+        COUNTER_UPDATE(_switch_to_pass_through_count, 1);
+    } else if (_is_streaming_pass_through && reduction >= config::streaming_agg_preagg_reduction) {
+        _is_streaming_pass_through = false;
+        COUNTER_UPDATE(_switch_to_preagg_count, 1);
+    }
+    _sampled_rows = 0;
+    // HyperLogLog::clear() keeps the registers, which are expected to be released before reuse.
+    _sampled_keys = HyperLogLog();
+}
+
 void Aggregator::compute_single_agg_state(size_t chunk_size) {
     for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
         if (!_is_merge_funcs[i]) {
@@ -472,6 +538,7 @@ Status Aggregator::check_hash_map_memory_usage(RuntimeState* state) {
         }
         _mem_tracker->consume(agg_func_memory_usage - _last_agg_func_memory_usage);
         _last_agg_func_memory_usage = agg_func_memory_usage;
+        _update_memory_usage_counters(_hash_map_variant.size(), _agg_states_total_size);
 
         RETURN_IF_ERROR(state->check_query_state("Aggregation Node"));
     }
@@ -483,32 +550,282 @@ Status Aggregator::check_hash_set_memory_usage(RuntimeState* state) {
         int64_t delta_memory_usage = static_cast<int64_t>(_hash_set_variant.memory_usage()) - _last_ht_memory_usage;
         _mem_tracker->consume(delta_memory_usage);
         _last_ht_memory_usage = _hash_set_variant.memory_usage();
+        _update_memory_usage_counters(_hash_set_variant.size(), 0);
 
         RETURN_IF_ERROR(state->check_query_state("Aggregation Node"));
     }
     return Status::OK();
 }
 
-#define CONVERT_TO_TWO_LEVEL(DST, SRC)                                                             \
-    if (_hash_map_variant.type == vectorized::HashMapVariant::Type::SRC) {                         \
-        _hash_map_variant.DST = std::make_unique<decltype(_hash_map_variant.DST)::element_type>(); \
-        _hash_map_variant.DST->hash_map.reserve(_hash_map_variant.SRC->hash_map.capacity());       \
-        _hash_map_variant.DST->hash_map.insert(_hash_map_variant.SRC->hash_map.begin(),            \
-                                               _hash_map_variant.SRC->hash_map.end());             \
-        _hash_map_variant.type = vectorized::HashMapVariant::Type::DST;                            \
-        _hash_map_variant.SRC.reset();                                                             \
-        return;                                                                                    \
+// The two level hash table has the same key and value types as its single level counterpart, so the
+void Aggregator::_update_memory_usage_counters(size_t num_groups, size_t state_size) {
+    // The keys of variable length and the states of the groups are both allocated from _mem_pool,
+    // the rest of the pool besides the states is attributed to the keys.
+    const int64_t mem_pool_usage = _mem_pool->total_allocated_bytes();
+    const int64_t agg_state_usage = std::min<int64_t>(num_groups * state_size, mem_pool_usage);
+    COUNTER_SET(_hash_table_memory_usage, _last_ht_memory_usage);
+    COUNTER_SET(_key_memory_usage, mem_pool_usage - agg_state_usage);
+    COUNTER_SET(_agg_state_memory_usage, agg_state_usage);
+    COUNTER_SET(_agg_func_memory_usage, _last_agg_func_memory_usage);
+    COUNTER_SET(_mem_pool_memory_usage, static_cast<int64_t>(_mem_pool->total_reserved_bytes()));
+}
+
+// converting just moves the entries, the states and the serialized keys are still kept in _mem_pool.
+#define CONVERT_TO_TWO_LEVEL(VARIANT, TABLE, DST, SRC, COPY_FIELDS)                      \
+    if (VARIANT.type == std::remove_reference_t<decltype(VARIANT)>::Type::SRC) {         \
+        VARIANT.DST = std::make_unique<decltype(VARIANT.DST)::element_type>();           \
+        VARIANT.DST->TABLE.reserve(VARIANT.SRC->TABLE.capacity());                       \
+        VARIANT.DST->TABLE.insert(VARIANT.SRC->TABLE.begin(), VARIANT.SRC->TABLE.end()); \
+        COPY_FIELDS(VARIANT.DST, VARIANT.SRC);                                           \
+        VARIANT.type = std::remove_reference_t<decltype(VARIANT)>::Type::DST;            \
+        VARIANT.SRC.reset();                                                             \
+        return;                                                                          \
     }
 
+#define COPY_NO_FIELDS(DST, SRC)
+#define COPY_NULL_KEY_DATA(DST, SRC) DST->null_key_data = SRC->null_key_data
+#define COPY_HAS_NULL_KEY(DST, SRC) DST->has_null_key = SRC->has_null_key
+#define COPY_FIXED_SIZE_FIELDS(DST, SRC)         \
+    DST->has_null_column = SRC->has_null_column; \
+    DST->fixed_byte_size = SRC->fixed_byte_size
+
+#define CONVERT_MAP(NAME, COPY_FIELDS)                                                          \
+    CONVERT_TO_TWO_LEVEL(_hash_map_variant, hash_map, phase1_##NAME##_two_level, phase1_##NAME, \
+                         COPY_FIELDS);                                                          \
+    CONVERT_TO_TWO_LEVEL(_hash_map_variant, hash_map, phase2_##NAME##_two_level, phase2_##NAME, \
+                         COPY_FIELDS);
+
+#define CONVERT_SET(NAME, COPY_FIELDS)                                                          \
+    CONVERT_TO_TWO_LEVEL(_hash_set_variant, hash_set, phase1_##NAME##_two_level, phase1_##NAME, \
+                         COPY_FIELDS);                                                          \
+    CONVERT_TO_TWO_LEVEL(_hash_set_variant, hash_set, phase2_##NAME##_two_level, phase2_##NAME, \
+                         COPY_FIELDS);
+
 void Aggregator::try_convert_to_two_level_map() {
     if (_last_ht_memory_usage > two_level_memory_threshold) {
-        CONVERT_TO_TWO_LEVEL(phase1_slice_two_level, phase1_slice);
-        CONVERT_TO_TWO_LEVEL(phase2_slice_two_level, phase2_slice);
+        CONVERT_MAP(slice, COPY_NO_FIELDS);
+        CONVERT_MAP(int32, COPY_NO_FIELDS);
+        CONVERT_MAP(int64, COPY_NO_FIELDS);
+        CONVERT_MAP(int128, COPY_NO_FIELDS);
+        CONVERT_MAP(string, COPY_NO_FIELDS);
+        CONVERT_MAP(null_int64, COPY_NULL_KEY_DATA);
+        CONVERT_MAP(null_int128, COPY_NULL_KEY_DATA);
+        CONVERT_MAP(null_string, COPY_NULL_KEY_DATA);
+        CONVERT_MAP(slice_fx8, COPY_FIXED_SIZE_FIELDS);
+        CONVERT_MAP(slice_fx16, COPY_FIXED_SIZE_FIELDS);
     }
 }
 
+void Aggregator::try_convert_to_two_level_set() {
+    if (_last_ht_memory_usage > two_level_memory_threshold) {
+        CONVERT_SET(int32, COPY_NO_FIELDS);
+        CONVERT_SET(int64, COPY_NO_FIELDS);
+        CONVERT_SET(int128, COPY_NO_FIELDS);
+        CONVERT_SET(string, COPY_NO_FIELDS);
+        CONVERT_SET(null_int64, COPY_HAS_NULL_KEY);
+        CONVERT_SET(null_int128, COPY_HAS_NULL_KEY);
+        CONVERT_SET(null_string, COPY_HAS_NULL_KEY);
+        CONVERT_SET(slice_fx8, COPY_FIXED_SIZE_FIELDS);
+        CONVERT_SET(slice_fx16, COPY_FIXED_SIZE_FIELDS);
+    }
+}
+
+#undef CONVERT_SET
+#undef CONVERT_MAP
+#undef COPY_FIXED_SIZE_FIELDS
+#undef COPY_HAS_NULL_KEY
+#undef COPY_NULL_KEY_DATA
+#undef COPY_NO_FIELDS
 #undef CONVERT_TO_TWO_LEVEL
 
+bool Aggregator::should_spill() const {
+    if (!_enable_spill) {
+        return false;
+    }
+    return _last_ht_memory_usage + _mem_pool->total_allocated_bytes() > config::agg_spill_mem_limit_bytes;
+}
+
+Status Aggregator::spill_hash_map(RuntimeState* state) {
+    SCOPED_TIMER(_spill_timer);
+    if (_spill_files.empty()) {
+        size_t num_partitions = std::max(config::agg_spill_partition_num, 1);
+        std::string name = "agg_" + print_id(state->fragment_instance_id());
+        for (size_t i = 0; i < num_partitions; i++) {
+            ASSIGN_OR_RETURN(auto file, vectorized::SpillFile::create(name));
+            _spill_files.emplace_back(std::move(file));
+        }
+        _spill_partition_rows.resize(num_partitions);
+    }
+    if (_hash_map_variant.size() == 0) {
+        return Status::OK();
+    }
+    COUNTER_UPDATE(_spill_count, 1);
+
+    // Reuse the output path to serialize the agg states, the counters of output
+    // are restored after the hash map has been spilled.
+    bool needs_finalize = _needs_finalize;
+    int64_t num_rows_returned = _num_rows_returned;
+    _needs_finalize = false;
+    _is_ht_eos = false;
+    _reset_hash_map_iterator();
+
+    Status st;
+    while (!_is_ht_eos && st.ok()) {
+        vectorized::ChunkPtr chunk;
+        if (false) {
+        }
+#define HASH_MAP_METHOD(NAME)                                                          \
+    else if (_hash_map_variant.type == vectorized::HashMapVariant::Type::NAME)         \
+            convert_hash_map_to_chunk<decltype(_hash_map_variant.NAME)::element_type>( \
+                    *_hash_map_variant.NAME, config::vector_chunk_size, &chunk);
+        APPLY_FOR_VARIANT_ALL(HASH_MAP_METHOD)
+#undef HASH_MAP_METHOD
+        st = _spill_chunk(*chunk);
+    }
+
+    _needs_finalize = needs_finalize;
+    _num_rows_returned = num_rows_returned;
+    _is_ht_eos = false;
+    RETURN_IF_ERROR(st);
+
+    _reset_hash_map();
+    return Status::OK();
+}
+
+Status Aggregator::restore_spill_partition_if_needed(RuntimeState* state) {
+    if (_spill_files.empty()) {
+        return Status::OK();
+    }
+    if (!_is_spill_flushed) {
+        RETURN_IF_ERROR(spill_hash_map(state));
+        for (auto& file : _spill_files) {
+            RETURN_IF_ERROR(file->flip_to_read());
+        }
+        _is_spill_flushed = true;
+        _is_ht_eos = true;
+    }
+
+    while (_is_ht_eos && _next_spill_partition < _spill_files.size()) {
+        _reset_hash_map();
+        RETURN_IF_ERROR(_restore_spill_partition(state, _spill_files[_next_spill_partition].get()));
+        // The partition has been loaded into hash map, delete the file as soon as possible
+        _spill_files[_next_spill_partition].reset();
+        _next_spill_partition++;
+
+        _reset_hash_map_iterator();
+        _is_ht_eos = _hash_map_variant.size() == 0;
+    }
+    return Status::OK();
+}
+
+void Aggregator::_reset_hash_map_iterator() {
+    if (false) {
+    }
+#define HASH_MAP_METHOD(NAME)                                                  \
+    else if (_hash_map_variant.type == vectorized::HashMapVariant::Type::NAME) \
+            _it_hash = _hash_map_variant.NAME->hash_map.begin();
+    APPLY_FOR_VARIANT_ALL(HASH_MAP_METHOD)
+#undef HASH_MAP_METHOD
+}
+
+void Aggregator::_reset_hash_map() {
+    // Note: the keys and agg states are allocated from _mem_pool,
+    // the hash map must be destroyed before _mem_pool is cleared.
+    if (false) {
+    }
+#define HASH_MAP_METHOD(NAME)                                                                         \
+    else if (_hash_map_variant.type == vectorized::HashMapVariant::Type::NAME) {                      \
+        _release_agg_memory<decltype(_hash_map_variant.NAME)::element_type>(*_hash_map_variant.NAME); \
+        _hash_map_variant.NAME.reset();                                                               \
+    }
+    APPLY_FOR_VARIANT_ALL(HASH_MAP_METHOD)
+#undef HASH_MAP_METHOD
+    // The hash map is refilled right after it's reset, keep some chunks for the new states.
+    _mem_pool->clear_and_retain(config::agg_mem_pool_retained_bytes);
+
+    _mem_tracker->release(_last_ht_memory_usage);
+    _last_ht_memory_usage = 0;
+    _init_agg_hash_variant(_hash_map_variant);
+}
+
+Status Aggregator::_spill_chunk(const vectorized::Chunk& chunk) {
+    size_t num_rows = chunk.num_rows();
+    if (num_rows == 0) {
+        return Status::OK();
+    }
+    if (_spill_chunk_template == nullptr) {
+        _spill_chunk_template = chunk.clone_empty(0);
+    }
+
+    // Partition the rows by hash of group by columns, the hash function must differ from the one
+    // of hash map, otherwise the rows of one partition are clustered in the hash map when restoring.
+    _spill_hashes.assign(num_rows, HashUtil::FNV_SEED);
+    for (size_t i = 0; i < _group_by_types.size(); i++) {
+        chunk.get_column_by_index(i)->fnv_hash(_spill_hashes.data(), 0, num_rows);
+    }
+    size_t num_partitions = _spill_files.size();
+    for (auto& rows : _spill_partition_rows) {
+        rows.clear();
+    }
+    for (uint32_t row = 0; row < num_rows; row++) {
+        _spill_partition_rows[_spill_hashes[row] % num_partitions].push_back(row);
+    }
+
+    for (size_t i = 0; i < num_partitions; i++) {
+        const auto& rows = _spill_partition_rows[i];
+        if (rows.empty()) {
+            continue;
+        }
+        vectorized::ChunkUniquePtr partition_chunk = chunk.clone_empty(rows.size());
+        partition_chunk->append_selective(chunk, rows.data(), 0, rows.size());
+        size_t num_bytes = _spill_files[i]->num_bytes();
+        RETURN_IF_ERROR(_spill_files[i]->append(*partition_chunk));
+        COUNTER_UPDATE(_spill_bytes, _spill_files[i]->num_bytes() - num_bytes);
+    }
+    COUNTER_UPDATE(_spill_rows, num_rows);
+    return Status::OK();
+}
+
+Status Aggregator::_restore_spill_partition(RuntimeState* state, vectorized::SpillFile* file) {
+    SCOPED_TIMER(_restore_timer);
+    size_t num_group_by_columns = _group_by_columns.size();
+    while (true) {
+        ASSIGN_OR_RETURN(auto chunk, file->read(*_spill_chunk_template));
+        if (chunk == nullptr) {
+            break;
+        }
+        size_t num_rows = chunk->num_rows();
+        for (size_t i = 0; i < num_group_by_columns; i++) {
+            _group_by_columns[i] = chunk->get_column_by_index(i);
+        }
+
+        if (false) {
+        }
+#define HASH_MAP_METHOD(NAME)                                                  \
+    else if (_hash_map_variant.type == vectorized::HashMapVariant::Type::NAME) \
+            build_hash_map<decltype(_hash_map_variant.NAME)::element_type>(*_hash_map_variant.NAME, num_rows);
+        APPLY_FOR_VARIANT_ALL(HASH_MAP_METHOD)
+#undef HASH_MAP_METHOD
+
+        // The spilled columns are always intermediate agg states
+        for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
+            _agg_functions[i]->merge_batch(_agg_fn_ctxs[i], num_rows, _agg_states_offsets[i],
+                                           chunk->get_column_by_index(num_group_by_columns + i).get(),
+                                           _tmp_agg_states.data());
+        }
+
+        int64_t ht_memory_usage = _hash_map_variant.memory_usage();
+        _mem_tracker->consume(ht_memory_usage - _last_ht_memory_usage);
+        _last_ht_memory_usage = ht_memory_usage;
+        RETURN_IF_ERROR(state->check_query_state("Aggregation Node"));
+        try_convert_to_two_level_map();
+    }
+    for (size_t i = 0; i < num_group_by_columns; i++) {
+        _group_by_columns[i] = nullptr;
+    }
+    return Status::OK();
+}
+
 // When need finalize, create column by result type
 // otherwise, create column by serde type
 vectorized::Columns Aggregator::_create_agg_result_columns() {
@@ -11,12 +11,14 @@
 #include "column/type_traits.h"
 #include "column/vectorized_fwd.h"
 #include "exec/vectorized/aggregate/agg_hash_variant.h"
+#include "exec/vectorized/spill_file.h"
 #include "exprs/agg/aggregate_factory.h"
 #include "exprs/expr.h"
 #include "gutil/strings/substitute.h"
 #include "runtime/descriptors.h"
 #include "runtime/runtime_state.h"
 #include "runtime/types.h"
+#include "storage/hll.h"
 
 namespace starrocks {
 
@@ -107,6 +109,14 @@ public:
     bool should_expand_preagg_hash_tables(size_t prev_row_returned, size_t input_chunk_size, int64_t ht_mem,
                                           int64_t ht_rows) const;
 
+    // Adaptive streaming pre-aggregation, only used in TStreamingPreaggregationMode::AUTO.
+    // The distinct group by keys of every config::streaming_agg_sample_window_rows input rows are estimated by
+    // HyperLogLog, if the reduction (rows / distinct keys) of the window is too low, the following chunks are
+    // passed through without touching the hash table, and aggregated again once the reduction of a later window
+    // becomes high enough. Must be called after evaluate_exprs.
+    void sample_streaming_reduction(size_t chunk_size);
+    bool is_streaming_pass_through() const { return _is_streaming_pass_through; }
+
     // For aggregate without group by
     void compute_single_agg_state(size_t chunk_size);
     // For aggregate with group by
@@ -136,6 +146,22 @@ public:
     // we convert the single hash map to two level hash map.
     // two level hash map is better in large data set.
     void try_convert_to_two_level_map();
+    void try_convert_to_two_level_set();
+
+    // Partitioned spill of the hash map, only used by the blocking aggregate of pipeline engine.
+    // When the hash map exceeds config::agg_spill_mem_limit_bytes, the intermediate agg states are
+    // serialized and written to config::agg_spill_partition_num spill files by the hash of group by
+    // keys, then the hash map is cleared. Once the sink is completed, the partitions are merged back
+    // into the hash map one by one, so that only one partition is in memory at a time.
+    bool should_spill() const;
+    Status spill_hash_map(RuntimeState* state);
+    bool has_spilled() const { return !_spill_files.empty(); }
+    bool has_pending_spill_partitions() const {
+        return !_spill_files.empty() && (!_is_spill_flushed || _next_spill_partition < _spill_files.size());
+    }
+    // Flush the rest of hash map to the spill files at first call, and if the current hash map
+    // has been consumed, load the next non-empty partition into hash map.
+    Status restore_spill_partition_if_needed(RuntimeState* state);
 
 #ifdef NDEBUG
     static constexpr size_t two_level_memory_threshold = 33554432; // 32M, L3 Cache
@@ -230,6 +256,22 @@ private:
 
     std::vector<uint8_t> _streaming_selection;
 
+    // used for adaptive streaming pre-aggregation
+    bool _is_streaming_pass_through = false;
+    size_t _sampled_rows = 0;
+    HyperLogLog _sampled_keys;
+    std::vector<uint32_t> _sampled_hashes;
+
+    // used for spill
+    bool _enable_spill = false;
+    bool _is_spill_flushed = false;
+    size_t _next_spill_partition = 0;
+    std::vector<vectorized::SpillFilePtr> _spill_files;
+    // The layout of spilled chunk: group by columns + intermediate agg columns
+    vectorized::ChunkUniquePtr _spill_chunk_template;
+    std::vector<uint32_t> _spill_hashes;
+    std::vector<std::vector<uint32_t>> _spill_partition_rows;
+
     RuntimeProfile::Counter* _get_results_timer{};
     RuntimeProfile::Counter* _agg_compute_timer{};
     RuntimeProfile::Counter* _streaming_timer{};
@@ -242,6 +284,21 @@ private:
     RuntimeProfile::Counter* _pass_through_row_count{};
     RuntimeProfile::Counter* _expr_compute_timer{};
     RuntimeProfile::Counter* _expr_release_timer{};
+    RuntimeProfile::Counter* _spill_timer{};
+    RuntimeProfile::Counter* _restore_timer{};
+    RuntimeProfile::Counter* _spill_count{};
+    RuntimeProfile::Counter* _spill_rows{};
+    RuntimeProfile::Counter* _spill_bytes{};
+    RuntimeProfile::Counter* _sampled_reduction{};
+    RuntimeProfile::Counter* _sample_window_count{};
+    RuntimeProfile::Counter* _switch_to_pass_through_count{};
+    RuntimeProfile::Counter* _switch_to_preagg_count{};
+    // The peak memory of the hash table and the parts of _mem_pool, updated along with the mem tracker.
+    RuntimeProfile::HighWaterMarkCounter* _hash_table_memory_usage{};
+    RuntimeProfile::HighWaterMarkCounter* _key_memory_usage{};
+    RuntimeProfile::HighWaterMarkCounter* _agg_state_memory_usage{};
+    RuntimeProfile::HighWaterMarkCounter* _agg_func_memory_usage{};
+    RuntimeProfile::HighWaterMarkCounter* _mem_pool_memory_usage{};
 
 public:
     template <typename HashMapWithKey>
@@ -467,6 +524,15 @@ private:
     template <typename HashVariantType>
     void _init_agg_hash_variant(HashVariantType& hash_variant);
 
+    void _reset_hash_map_iterator();
+    // Destroy all the agg states and replace the hash map with an empty one
+    void _reset_hash_map();
+    Status _spill_chunk(const vectorized::Chunk& chunk);
+    Status _restore_spill_partition(RuntimeState* state, vectorized::SpillFile* file);
+    // Break the memory of the hash table and _mem_pool down into the profile, `state_size` is
+    // the size of the agg states of every group, 0 for the hash set.
+    void _update_memory_usage_counters(size_t num_groups, size_t state_size);
+
     template <typename HashMapWithKey>
     void _release_agg_memory(HashMapWithKey& hash_map_with_key) {
         auto it = hash_map_with_key.hash_map.begin();
@@ -477,6 +543,13 @@ private:
             }
             ++it;
         }
+        if constexpr (HashMapWithKey::has_single_null_key) {
+            if (hash_map_with_key.null_key_data != nullptr) {
+                for (int i = 0; i < _agg_functions.size(); i++) {
+                    _agg_functions[i]->destroy(hash_map_with_key.null_key_data + _agg_states_offsets[i]);
+                }
+            }
+        }
     }
 };
 
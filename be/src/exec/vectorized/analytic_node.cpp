@@ -8,14 +8,18 @@
 
 #include "column/chunk.h"
 #include "column/column_helper.h"
+#include "common/config.h"
 #include "exec/pipeline/analysis/analytic_sink_operator.h"
 #include "exec/pipeline/analysis/analytic_source_operator.h"
 #include "exec/pipeline/operator.h"
 #include "exec/pipeline/pipeline_builder.h"
+#include "exec/pipeline/source_operator.h"
+#include "exec/vectorized/topn_node.h"
 #include "exprs/agg/count.h"
 #include "exprs/anyval_util.h"
 #include "exprs/expr.h"
 #include "exprs/expr_context.h"
+#include "gutil/casts.h"
 #include "gutil/strings/substitute.h"
 #include "runtime/mem_tracker.h"
 #include "runtime/runtime_state.h"
@@ -55,6 +59,10 @@ Status AnalyticNode::init(const TPlanNode& tnode, RuntimeState* state) {
     RETURN_IF_ERROR(ExecNode::init(tnode, state));
     DCHECK(_conjunct_ctxs.empty());
 
+    if (config::pipeline_enable_parallel_analytic && child(0)->type() == TPlanNodeType::SORT_NODE) {
+        RETURN_IF_ERROR(down_cast<TopNNode*>(child(0))->init_local_partition_exprs(tnode.analytic_node.partition_exprs,
+                                                                                   &_is_input_partitioned));
+    }
     return Status::OK();
 }
 
@@ -240,10 +248,7 @@ Status AnalyticNode::_get_next_for_sliding_frame(RuntimeState* state, ChunkPtr*
 
         while (_analytor->current_row_position() < _analytor->partition_end() &&
                _analytor->window_result_position() < chunk_size) {
-            _analytor->reset_window_state();
-            FrameRange range = _analytor->get_sliding_frame_range();
-            _analytor->update_window_batch(_analytor->partition_start(), _analytor->partition_end(), range.start,
-                                           range.end);
+            _analytor->update_window_batch_for_sliding_frame();
             _analytor->update_window_result_position(1);
             int64_t result_start = _analytor->get_total_position(_analytor->current_row_position()) -
                                    _analytor->input_chunk_first_row_positions()[_analytor->output_chunk_index()];
@@ -359,21 +364,32 @@ std::vector<std::shared_ptr<pipeline::OperatorFactory> > AnalyticNode::decompose
         pipeline::PipelineBuilderContext* context) {
     using namespace pipeline;
     OpFactories operators_with_sink = _children[0]->decompose_to_pipeline(context);
-    context->maybe_interpolate_local_passthrough_exchange(operators_with_sink);
+    // If the sort below has shuffled its input by the PARTITION BY keys, every driver gets whole window
+    // partitions in order, and analyzes them by its own Analytor.
+    // Otherwise, an Analytor must see all the rows, so the input is gathered to one driver.
+    size_t degree_of_parallelism = 1;
+    if (_is_input_partitioned) {
+        degree_of_parallelism =
+                down_cast<SourceOperatorFactory*>(operators_with_sink[0].get())->degree_of_parallelism();
+    } else {
+        operators_with_sink = context->maybe_interpolate_local_passthrough_exchange(operators_with_sink);
+    }
 
-    // shared by sink operator and source operator
-    AnalytorPtr analytor = std::make_shared<Analytor>(_tnode, child(0)->row_desc(), _result_tuple_desc);
+    // shared by sink operator factory and source operator factory
+    AnalytorFactoryPtr analytor_factory =
+            std::make_shared<AnalytorFactory>(_tnode, child(0)->row_desc(), _result_tuple_desc);
 
     operators_with_sink.emplace_back(
-            std::make_shared<AnalyticSinkOperatorFactory>(context->next_operator_id(), id(), _tnode, analytor));
+            std::make_shared<AnalyticSinkOperatorFactory>(context->next_operator_id(), id(), _tnode, analytor_factory));
     context->add_pipeline(operators_with_sink);
 
     OpFactories operators_with_source;
-    auto source_operator = std::make_shared<AnalyticSourceOperatorFactory>(context->next_operator_id(), id(), analytor);
+    auto source_operator =
+            std::make_shared<AnalyticSourceOperatorFactory>(context->next_operator_id(), id(), analytor_factory);
 
-    // TODO(hcf) Currently, the shared data structure analytor does not support concurrency.
-    // So the degree of parallism must set to 1, we'll fix it laterr
-    source_operator->set_degree_of_parallelism(1);
+    // Analytor must be used by a pair of sink and source operators,
+    // so operators_with_source's degree of parallelism must be equal with operators_with_sink's
+    source_operator->set_degree_of_parallelism(degree_of_parallelism);
     operators_with_source.push_back(std::move(source_operator));
     return operators_with_source;
 }
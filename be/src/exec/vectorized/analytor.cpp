@@ -8,11 +8,13 @@
 
 #include "column/chunk.h"
 #include "column/column_helper.h"
+#include "column/nullable_column.h"
 #include "common/status.h"
 #include "exprs/agg/count.h"
 #include "exprs/anyval_util.h"
 #include "exprs/expr.h"
 #include "exprs/expr_context.h"
+#include "gutil/casts.h"
 #include "gutil/strings/substitute.h"
 #include "runtime/mem_tracker.h"
 #include "runtime/runtime_state.h"
@@ -97,6 +99,9 @@ Status Analytor::prepare(RuntimeState* state, ObjectPool* pool, MemTracker* mem_
     _agg_intput_columns.resize(agg_size);
     _agg_fn_types.resize(agg_size);
     _agg_states_offsets.resize(agg_size);
+    _sliding_modes.resize(agg_size, SlidingMode::Recompute);
+    _sliding_non_null_rows.resize(agg_size, 0);
+    _sliding_candidates.resize(agg_size);
 
     bool has_outer_join_child = analytic_node.__isset.has_outer_join_child && analytic_node.has_outer_join_child;
 
@@ -180,6 +185,13 @@ Status Analytor::prepare(RuntimeState* state, ObjectPool* pool, MemTracker* mem_
         if (_agg_functions[i]->get_name() == "lead-lag") {
             _has_lead_lag_function = true;
         }
+        if (_agg_functions[i]->is_removable()) {
+            _sliding_modes[i] = SlidingMode::Removable;
+        } else if (fn.name.function_name == "max") {
+            _sliding_modes[i] = SlidingMode::Max;
+        } else if (fn.name.function_name == "min") {
+            _sliding_modes[i] = SlidingMode::Min;
+        }
     }
 
     // compute agg state total size and offsets
@@ -320,10 +332,50 @@ void Analytor::update_window_batch(int64_t peer_group_start, int64_t peer_group_
     }
 }
 
+void Analytor::update_window_batch_for_sliding_frame() {
+    FrameRange range = get_sliding_frame_range();
+    if (_has_lead_lag_function) {
+        reset_window_state();
+        update_window_batch(_partition_start, _partition_end, range.start, range.end);
+        return;
+    }
+
+    // Both ends of the frame only move forward within a partition.
+    int64_t frame_start = std::clamp<int64_t>(range.start, _partition_start, _partition_end);
+    int64_t frame_end = std::clamp<int64_t>(range.end, frame_start, _partition_end);
+    if (frame_start >= _sliding_frame_end) {
+        // no row is shared with the previous frame, e.g. the first row of a partition.
+        for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
+            _reset_window_state(i);
+            _sliding_non_null_rows[i] = 0;
+            _sliding_candidates[i].clear();
+        }
+        _sliding_frame_start = frame_start;
+        _sliding_frame_end = frame_start;
+    }
+
+    for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
+        switch (_sliding_modes[i]) {
+        case SlidingMode::Removable:
+            _slide_removable_window_state(i, frame_start, frame_end);
+            break;
+        case SlidingMode::Max:
+        case SlidingMode::Min:
+            _slide_max_min_window_state(i, frame_start, frame_end);
+            break;
+        default:
+            _reset_window_state(i);
+            _update_window_state(i, frame_start, frame_end);
+            break;
+        }
+    }
+    _sliding_frame_start = frame_start;
+    _sliding_frame_end = frame_end;
+}
+
 void Analytor::reset_window_state() {
     for (size_t i = 0; i < _agg_fn_ctxs.size(); i++) {
-        _agg_functions[i]->reset(_agg_fn_ctxs[i], _agg_intput_columns[i],
-                                 _managed_fn_states[0]->mutable_data() + _agg_states_offsets[i]);
+        _reset_window_state(i);
     }
 }
 
@@ -510,6 +562,13 @@ void Analytor::remove_unused_buffer_values() {
     _current_row_position -= remove_count;
     _peer_group_start -= remove_count;
     _peer_group_end -= remove_count;
+    _sliding_frame_start -= remove_count;
+    _sliding_frame_end -= remove_count;
+    for (auto& candidates : _sliding_candidates) {
+        for (int64_t& row : candidates) {
+            row -= remove_count;
+        }
+    }
 
     _removed_chunk_index += BUFFER_CHUNK_NUMBER;
 
@@ -538,6 +597,75 @@ void Analytor::_update_window_batch_normal(int64_t peer_group_start, int64_t pee
     }
 }
 
+void Analytor::_reset_window_state(size_t index) {
+    _agg_functions[index]->reset(_agg_fn_ctxs[index], _agg_intput_columns[index],
+                                 _managed_fn_states[0]->mutable_data() + _agg_states_offsets[index]);
+}
+
+void Analytor::_update_window_state(size_t index, int64_t frame_start, int64_t frame_end) {
+    const vectorized::Column* agg_column = _agg_intput_columns[index][0].get();
+    _agg_functions[index]->update_batch_single_state(
+            _agg_fn_ctxs[index], _managed_fn_states[0]->mutable_data() + _agg_states_offsets[index], &agg_column,
+            _partition_start, _partition_end, frame_start, frame_end);
+}
+
+static int64_t count_non_null_rows(const vectorized::Column* column, int64_t start, int64_t end) {
+    // count(*) has no input column.
+    if (column == nullptr || !column->is_nullable() || !column->has_null()) {
+        return end - start;
+    }
+    const uint8_t* null_data = down_cast<const vectorized::NullableColumn*>(column)->null_column()->raw_data();
+    int64_t count = 0;
+    for (int64_t i = start; i < end; ++i) {
+        count += !null_data[i];
+    }
+    return count;
+}
+
+void Analytor::_slide_removable_window_state(size_t index, int64_t frame_start, int64_t frame_end) {
+    const vectorized::Column* agg_column = _agg_intput_columns[index][0].get();
+    // add the rows entering the frame.
+    if (frame_end > _sliding_frame_end) {
+        _update_window_state(index, _sliding_frame_end, frame_end);
+        _sliding_non_null_rows[index] += count_non_null_rows(agg_column, _sliding_frame_end, frame_end);
+    }
+    // remove the rows leaving the frame.
+    if (frame_start > _sliding_frame_start) {
+        _agg_functions[index]->remove_batch_single_state(
+                _agg_fn_ctxs[index], _managed_fn_states[0]->mutable_data() + _agg_states_offsets[index], &agg_column,
+                _sliding_frame_start, frame_start);
+        _sliding_non_null_rows[index] -= count_non_null_rows(agg_column, _sliding_frame_start, frame_start);
+        // the result of a frame without NOT NULL rows is NULL, or 0 for count.
+        if (_sliding_non_null_rows[index] == 0) {
+            _reset_window_state(index);
+        }
+    }
+}
+
+void Analytor::_slide_max_min_window_state(size_t index, int64_t frame_start, int64_t frame_end) {
+    const vectorized::Column* agg_column = _agg_intput_columns[index][0].get();
+    auto& candidates = _sliding_candidates[index];
+    const int order = _sliding_modes[index] == SlidingMode::Max ? 1 : -1;
+    // a row entering the frame outlives the earlier rows, so they are no longer candidates if not better.
+    for (int64_t row = _sliding_frame_end; row < frame_end; ++row) {
+        if (agg_column->is_null(row)) {
+            continue;
+        }
+        while (!candidates.empty() && agg_column->compare_at(candidates.back(), row, *agg_column, 1) * order <= 0) {
+            candidates.pop_back();
+        }
+        candidates.push_back(row);
+    }
+    while (!candidates.empty() && candidates.front() < frame_start) {
+        candidates.pop_front();
+    }
+
+    _reset_window_state(index);
+    if (!candidates.empty()) {
+        _update_window_state(index, candidates.front(), candidates.front() + 1);
+    }
+}
+
 int64_t Analytor::_find_first_not_equal(vectorized::Column* column, int64_t start, int64_t end) {
     int64_t target = start;
     while (start + 1 < end) {
@@ -2,6 +2,9 @@
 
 #pragma once
 
+#include <deque>
+#include <unordered_map>
+
 #include "exprs/agg/aggregate_factory.h"
 #include "exprs/expr.h"
 #include "runtime/descriptors.h"
@@ -94,6 +97,9 @@ public:
     FrameRange get_sliding_frame_range();
 
     void update_window_batch(int64_t peer_group_start, int64_t peer_group_end, int64_t frame_start, int64_t frame_end);
+    // Update the window states for the sliding frame of the current row, the states of removable
+    // aggregate functions and max/min follow the frame incrementally instead of being recomputed.
+    void update_window_batch_for_sliding_frame();
     void reset_window_state();
     void get_window_function_result(int32_t start, int32_t end);
 
@@ -185,6 +191,18 @@ private:
     std::vector<std::vector<vectorized::ColumnPtr>> _agg_intput_columns;
     std::vector<FunctionTypes> _agg_fn_types;
 
+    // How the state of a window function follows a sliding frame.
+    enum class SlidingMode { Recompute, Removable, Max, Min };
+    std::vector<SlidingMode> _sliding_modes;
+    // The frame which the states are updated with, i.e. the frame of the previous row.
+    int64_t _sliding_frame_start = 0;
+    int64_t _sliding_frame_end = 0;
+    // The number of NOT NULL rows in the frame, for Removable.
+    std::vector<int64_t> _sliding_non_null_rows;
+    // The rows which may be max/min of the frame now or later, with the values in descending (Max)
+    // or ascending (Min) order, so the front is the result, i.e. a monotonic queue.
+    std::vector<std::deque<int64_t>> _sliding_candidates;
+
     std::vector<ExprContext*> _partition_ctxs;
     vectorized::Columns _partition_columns;
 
@@ -203,6 +221,11 @@ private:
     void _update_window_batch_lead_lag(int64_t peer_group_start, int64_t peer_group_end, int64_t frame_start,
                                        int64_t frame_end);
 
+    void _reset_window_state(size_t index);
+    void _update_window_state(size_t index, int64_t frame_start, int64_t frame_end);
+    void _slide_removable_window_state(size_t index, int64_t frame_start, int64_t frame_end);
+    void _slide_max_min_window_state(size_t index, int64_t frame_start, int64_t frame_end);
+
     int64_t _find_first_not_equal(vectorized::Column* column, int64_t start, int64_t end);
 };
 
@@ -230,4 +253,33 @@ private:
     Analytor* _agg_node;
 };
 
+class AnalytorFactory;
+using AnalytorFactoryPtr = std::shared_ptr<AnalytorFactory>;
+
+// Creates an Analytor for each pair of AnalyticSinkOperator and AnalyticSourceOperator of the same driver,
+// the input of which has been shuffled by the PARTITION BY keys, so that the drivers never share a window partition.
+class AnalytorFactory {
+public:
+    AnalytorFactory(const TPlanNode& tnode, const RowDescriptor& child_row_desc,
+                    const TupleDescriptor* result_tuple_desc)
+            : _tnode(tnode), _child_row_desc(child_row_desc), _result_tuple_desc(result_tuple_desc) {}
+
+    AnalytorPtr get_or_create(size_t driver_sequence) {
+        auto it = _analytors.find(driver_sequence);
+        if (it != _analytors.end()) {
+            return it->second;
+        }
+        auto analytor = std::make_shared<Analytor>(_tnode, _child_row_desc, _result_tuple_desc);
+        _analytors[driver_sequence] = analytor;
+        return analytor;
+    }
+
+private:
+    const TPlanNode& _tnode;
+    const RowDescriptor& _child_row_desc;
+    const TupleDescriptor* _result_tuple_desc;
+
+    std::unordered_map<size_t, AnalytorPtr> _analytors;
+};
+
 } // namespace starrocks
@@ -48,6 +48,7 @@ ChunksSorter::~ChunksSorter() {
 
 void ChunksSorter::setup_runtime(MemTracker* mem_tracker, RuntimeProfile* profile, const std::string& parent_timer) {
     _mem_tracker = mem_tracker;
+    _runtime_profile = profile;
     _build_timer = ADD_CHILD_TIMER(profile, "1-BuildingTime", parent_timer);
     _sort_timer = ADD_CHILD_TIMER(profile, "2-SortingTime", parent_timer);
     _merge_timer = ADD_CHILD_TIMER(profile, "3-MergingTime", parent_timer);
@@ -64,9 +65,10 @@ Status ChunksSorter::_consume_and_check_memory_limit(RuntimeState* state, int64_
 }
 
 Status ChunksSorter::finish(RuntimeState* state) {
-    RETURN_IF_ERROR(done(state));
+    // Mark the sink complete even on failure, so that the source could observe the error.
+    _status = done(state);
     _is_sink_complete = true;
-    return Status::OK();
+    return _status;
 }
 
 bool ChunksSorter::sink_complete() {
@@ -3,7 +3,9 @@
 #pragma once
 
 #include "column/vectorized_fwd.h"
+#include "common/status.h"
 #include "exprs/expr_context.h"
+#include "exprs/vectorized/topn_runtime_filter.h"
 #include "util/runtime_profile.h"
 
 namespace starrocks::vectorized {
@@ -289,6 +291,13 @@ public:
     // pull_chunk for pipeline.
     virtual bool pull_chunk(ChunkPtr* chunk) = 0;
 
+    // The error which could not be returned by finish, get_next or pull_chunk,
+    // e.g. failed to read back the spilled rows.
+    const Status& status() const { return _status; }
+
+    // Publish the boundary of the first order-by column to |filter|, only done by the TopN sorters.
+    void set_runtime_filter(TopNRuntimeFilter* filter) { _runtime_filter = filter; }
+
 protected:
     inline size_t _get_number_of_order_by_columns() const { return _sort_exprs->size(); }
 
@@ -305,12 +314,16 @@ protected:
     MemTracker* _mem_tracker;
     int64_t _last_memory_usage;
 
+    RuntimeProfile* _runtime_profile = nullptr;
     RuntimeProfile::Counter* _build_timer = nullptr;
     RuntimeProfile::Counter* _sort_timer = nullptr;
     RuntimeProfile::Counter* _merge_timer = nullptr;
     RuntimeProfile::Counter* _output_timer = nullptr;
 
     std::atomic<bool> _is_sink_complete = false;
+    Status _status;
+
+    TopNRuntimeFilter* _runtime_filter = nullptr;
 };
 
 } // namespace starrocks::vectorized
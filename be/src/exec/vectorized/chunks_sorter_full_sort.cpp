@@ -7,8 +7,12 @@
 #include "gutil/casts.h"
 #include "runtime/mem_tracker.h"
 #include "runtime/runtime_state.h"
+#include "runtime/vectorized/sorted_chunks_merger.h"
+#include "util/bit_util.h"
 #include "util/orlp/pdqsort.h"
+#include "util/radix_sort.h"
 #include "util/stopwatch.hpp"
+#include "util/uid_util.h"
 
 namespace starrocks::vectorized {
 
@@ -71,6 +75,79 @@ public:
         pdqsort(perm.begin(), perm.end(), cmp_fn);
     }
 
+    // The number of bytes of the normalized key of a value of the type, or 0 if its values could not be
+    // normalized. A normalized key is a byte string whose memcmp order is the sort order of the values.
+    static size_t normalized_key_size(PrimitiveType type) {
+        switch (type) {
+        case TYPE_BOOLEAN:
+        case TYPE_TINYINT:
+            return 1;
+        case TYPE_SMALLINT:
+            return 2;
+        case TYPE_INT:
+        case TYPE_DECIMAL32:
+        case TYPE_DATE:
+            return 4;
+        case TYPE_BIGINT:
+        case TYPE_DECIMAL64:
+        case TYPE_DATETIME:
+            return 8;
+        case TYPE_LARGEINT:
+        case TYPE_DECIMAL128:
+        case TYPE_DECIMALV2:
+            return 16;
+        default:
+            return 0;
+        }
+    }
+
+    // Write the normalized keys of the column at |offset| of the key of every row, whose size is |key_size|.
+    // The keys of a nullable column begin with a byte which puts the NULLs before or after all the values.
+    template <PrimitiveType PT>
+    static void encode_normalized_keys(const Column* column, bool is_asc_order, bool is_null_first, uint8_t* keys,
+                                       size_t key_size, size_t offset) {
+        using CppTypeName = typename RunTimeTypeTraits<PT>::CppType;
+        // All the supported types are stored as signed integers of the same size, e.g. the julian of DATE.
+        using SignedType = std::conditional_t<
+                sizeof(CppTypeName) == 1, int8_t,
+                std::conditional_t<sizeof(CppTypeName) == 2, int16_t,
+                                   std::conditional_t<sizeof(CppTypeName) == 4, int32_t,
+                                                      std::conditional_t<sizeof(CppTypeName) == 8, int64_t, int128_t>>>>;
+        using UnsignedType = std::make_unsigned_t<SignedType>;
+        static_assert(sizeof(CppTypeName) == sizeof(SignedType));
+        constexpr UnsignedType sign_bit = UnsignedType(1) << (sizeof(UnsignedType) * 8 - 1);
+
+        const uint8_t* nulls = nullptr;
+        if (column->is_nullable()) {
+            const auto* nullable_column = down_cast<const NullableColumn*>(column);
+            nulls = nullable_column->null_column()->raw_data();
+            column = nullable_column->data_column().get();
+        }
+        const auto* data = reinterpret_cast<const CppTypeName*>(column->raw_data());
+        const size_t num_rows = column->size();
+        for (size_t i = 0; i < num_rows; ++i) {
+            uint8_t* key = keys + i * key_size + offset;
+            if (nulls != nullptr) {
+                bool is_null = nulls[i] != 0;
+                *key++ = (is_null == is_null_first) ? 0 : 1;
+                if (is_null) {
+                    memset(key, 0, sizeof(UnsignedType));
+                    continue;
+                }
+            }
+            UnsignedType value;
+            memcpy(&value, &data[i], sizeof(value));
+            value ^= sign_bit;
+            if (!is_asc_order) {
+                value = ~value;
+            }
+            // big endian, so that the most significant byte is compared first.
+            for (size_t byte = 0; byte < sizeof(value); ++byte) {
+                key[byte] = static_cast<uint8_t>(value >> ((sizeof(value) - 1 - byte) * 8));
+            }
+        }
+    }
+
 private:
     // Sort on type-known column, and the column has no NULL value in sorting range.
     template <PrimitiveType PT, bool stable>
@@ -133,6 +210,29 @@ private:
         uint32_t permutation_index; // sequence index for keeping sort stable.
     };
 
+    // The first bytes of a string are kept inline in the sort item as a big-endian integer, padded with
+    // zeros, so that most comparisons don't have to dereference the string data. Two strings whose
+    // prefixes differ compare the same as their prefixes, otherwise the whole strings are compared.
+    struct StringSortItem {
+        uint64_t prefix;
+        Slice value;
+        uint32_t index_in_chunk;
+        uint32_t permutation_index; // sequence index for keeping sort stable.
+    };
+
+    static inline uint64_t string_prefix(const Slice& value) {
+        uint64_t prefix = 0;
+        memcpy(&prefix, value.data, std::min(value.size, sizeof(prefix)));
+        return BitUtil::big_endian(prefix);
+    }
+
+    static inline int compare_string_sort_item(const StringSortItem& l, const StringSortItem& r) {
+        if (l.prefix != r.prefix) {
+            return l.prefix < r.prefix ? -1 : 1;
+        }
+        return l.value.compare(r.value);
+    }
+
     // Sort string
     template <bool stable>
     static void sort_on_not_null_binary_column(Column* column, bool is_asc_order, Permutation& perm, size_t offset,
@@ -140,33 +240,34 @@ private:
         const size_t row_num = (count == 0 || offset + count > perm.size()) ? (perm.size() - offset) : count;
         auto* binary_column = reinterpret_cast<BinaryColumn*>(column);
         auto& data = binary_column->get_data();
-        std::vector<SortItem<Slice>> sort_items(row_num);
+        std::vector<StringSortItem> sort_items(row_num);
         for (uint32_t i = 0; i < row_num; ++i) {
-            sort_items[i] = {data[perm[i + offset].index_in_chunk], perm[i + offset].index_in_chunk, i};
+            const Slice& value = data[perm[i + offset].index_in_chunk];
+            sort_items[i] = {string_prefix(value), value, perm[i + offset].index_in_chunk, i};
         }
-        auto less_fn = [](const SortItem<Slice>& l, const SortItem<Slice>& r) -> bool {
+        auto less_fn = [](const StringSortItem& l, const StringSortItem& r) -> bool {
             if constexpr (stable) {
-                int res = l.value.compare(r.value);
+                int res = compare_string_sort_item(l, r);
                 if (res == 0) {
                     return l.permutation_index < r.permutation_index;
                 } else {
                     return res < 0;
                 }
             } else {
-                int res = l.value.compare(r.value);
+                int res = compare_string_sort_item(l, r);
                 return res < 0;
             }
         };
-        auto greater_fn = [](const SortItem<Slice>& l, const SortItem<Slice>& r) -> bool {
+        auto greater_fn = [](const StringSortItem& l, const StringSortItem& r) -> bool {
             if constexpr (stable) {
-                int res = l.value.compare(r.value);
+                int res = compare_string_sort_item(l, r);
                 if (res == 0) {
                     return l.permutation_index < r.permutation_index;
                 } else {
                     return res > 0;
                 }
             } else {
-                int res = l.value.compare(r.value);
+                int res = compare_string_sort_item(l, r);
                 return res > 0;
             }
         };
@@ -228,25 +329,53 @@ private:
     }
 };
 
+// The normalized key of a row which fits in a word, sorted by radix sort.
+struct NormalizedKeyItem {
+    uint64_t key;
+    uint32_t index_in_chunk;
+};
+
+struct NormalizedKeyRadixSortTraits {
+    using Element = NormalizedKeyItem;
+    using Key = uint64_t;
+    using CountType = uint32_t;
+    using KeyBits = uint64_t;
+
+    static constexpr size_t PART_SIZE_BITS = 8;
+
+    using Transform = RadixSortIdentityTransform<KeyBits>;
+    using Allocator = RadixSortMallocAllocator;
+
+    static Key& extractKey(Element& elem) { return elem.key; }
+};
+
 ChunksSorterFullSort::ChunksSorterFullSort(const std::vector<ExprContext*>* sort_exprs, const std::vector<bool>* is_asc,
                                            const std::vector<bool>* is_null_first, size_t size_of_chunk_batch)
-        : ChunksSorter(sort_exprs, is_asc, is_null_first, size_of_chunk_batch) {
+        : ChunksSorter(sort_exprs, is_asc, is_null_first, size_of_chunk_batch),
+          _is_asc(is_asc),
+          _is_null_first(is_null_first) {
     _selective_values.resize(config::vector_chunk_size);
 }
 
 ChunksSorterFullSort::~ChunksSorterFullSort() = default;
 
 Status ChunksSorterFullSort::update(RuntimeState* state, const ChunkPtr& chunk) {
+    if (UNLIKELY(_big_chunk == nullptr)) {
+        _big_chunk = chunk->clone_empty();
+        _enable_spill = state != nullptr && state->enable_spill();
+    }
+
     // Calculate the memory of BigChunk, but every time the mem_usage() of BigChunk is called,
     // the performance may be poor for the Object type.
     // So accumulate the memory of each small Chunk to estimate the total memory.
     // But in some scenarios, Chunk will reserve 4096 rows, but only used 1.
     // So use the shrink_memory_usage() to estimate memory usage
-    RETURN_IF_ERROR(_consume_and_check_memory_limit(state, chunk->shrink_memory_usage()));
-
-    if (UNLIKELY(_big_chunk == nullptr)) {
-        _big_chunk = chunk->clone_empty();
+    int64_t chunk_mem_usage = chunk->shrink_memory_usage();
+    if (_enable_spill && _big_chunk->num_rows() > 0 &&
+        _last_memory_usage + chunk_mem_usage > config::sort_spill_mem_limit_bytes) {
+        RETURN_IF_ERROR(_spill_sorted_run(state));
     }
+    RETURN_IF_ERROR(_consume_and_check_memory_limit(state, chunk_mem_usage));
 
     if (_big_chunk->num_rows() + chunk->num_rows() > std::numeric_limits<uint32_t>::max()) {
         LOG(WARNING) << "full sort row is " << _big_chunk->num_rows() + chunk->num_rows();
@@ -260,6 +389,14 @@ Status ChunksSorterFullSort::update(RuntimeState* state, const ChunkPtr& chunk)
 }
 
 Status ChunksSorterFullSort::done(RuntimeState* state) {
+    if (!_spill_files.empty()) {
+        // The rows left in memory make the last run, so that all the rows are merged in one way.
+        if (_big_chunk != nullptr && _big_chunk->num_rows() > 0) {
+            RETURN_IF_ERROR(_spill_sorted_run(state));
+        }
+        return _init_spill_merger();
+    }
+
     if (_big_chunk != nullptr && _big_chunk->num_rows() > 0) {
         RETURN_IF_ERROR(_sort_chunks(state));
     }
@@ -270,6 +407,10 @@ Status ChunksSorterFullSort::done(RuntimeState* state) {
 
 void ChunksSorterFullSort::get_next(ChunkPtr* chunk, bool* eos) {
     SCOPED_TIMER(_output_timer);
+    if (_spill_merger != nullptr) {
+        _get_next_from_spill_merger(chunk, eos);
+        return;
+    }
     if (_next_output_row >= _sorted_permutation.size()) {
         *chunk = nullptr;
         *eos = true;
@@ -291,6 +432,11 @@ void ChunksSorterFullSort::get_next(ChunkPtr* chunk, bool* eos) {
  * and copy it in chunk as output.
  */
 bool ChunksSorterFullSort::pull_chunk(ChunkPtr* chunk) {
+    if (_spill_merger != nullptr) {
+        bool eos = false;
+        _get_next_from_spill_merger(chunk, &eos);
+        return eos;
+    }
     // _next_output_row used to record next row to get,
     // This condition is used to determine whether all data has been retrieved.
     if (_next_output_row >= _sorted_permutation.size()) {
@@ -312,9 +458,12 @@ Status ChunksSorterFullSort::_sort_chunks(RuntimeState* state) {
     // Step1: construct permutation
     RETURN_IF_ERROR(_build_sorting_data(state));
 
-    // Step2: sort by columns or row
+    // Step2: sort by normalized keys, columns or row
     // For no more than three order-by columns, sorting by columns can benefit from reducing
     // the cost of calling virtual functions of Column::compare_at.
+    if (_get_number_of_order_by_columns() > 1 && config::enable_sort_normalized_keys && _sort_by_normalized_keys()) {
+        return Status::OK();
+    }
     if (_get_number_of_order_by_columns() <= 3) {
         _sort_by_columns();
     } else {
@@ -379,6 +528,108 @@ void ChunksSorterFullSort::_sort_by_row_cmp() {
     }
 }
 
+#define CASE_FOR_NORMALIZED_KEY_ENCODE(PrimitiveTypeName)                                                \
+    case PrimitiveTypeName: {                                                                            \
+        SortHelper::encode_normalized_keys<PrimitiveTypeName>(column, is_asc_order, is_null_first, keys, \
+                                                              key_stride, offset);                       \
+        break;                                                                                           \
+    }
+
+// Encode the order-by columns of every row into a normalized key, and sort the keys as unsigned integers,
+// which saves comparing the rows column by column through the virtual Column::compare_at.
+// Return false if some order-by column could not be normalized.
+bool ChunksSorterFullSort::_sort_by_normalized_keys() {
+    const size_t num_columns = _get_number_of_order_by_columns();
+    const Columns& order_by_columns = _sorted_segment->order_by_columns;
+    size_t key_size = 0;
+    for (size_t col_index = 0; col_index < num_columns; ++col_index) {
+        const Column* column = order_by_columns[col_index].get();
+        if (column->is_constant()) {
+            continue;
+        }
+        size_t value_size = SortHelper::normalized_key_size((*_sort_exprs)[col_index]->root()->type().type);
+        if (value_size == 0) {
+            return false;
+        }
+        key_size += value_size + column->is_nullable();
+    }
+
+    SCOPED_TIMER(_sort_timer);
+    // The keys are padded with zeros to words, and compared word by word.
+    const size_t num_words = (key_size + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+    const size_t num_rows = _sorted_permutation.size();
+    if (num_words == 0 || num_rows <= 1) {
+        return true;
+    }
+    std::vector<uint64_t> words(num_rows * num_words, 0);
+    auto* keys = reinterpret_cast<uint8_t*>(words.data());
+    const size_t key_stride = num_words * sizeof(uint64_t);
+    size_t offset = 0;
+    for (size_t col_index = 0; col_index < num_columns; ++col_index) {
+        const Column* column = order_by_columns[col_index].get();
+        if (column->is_constant()) {
+            continue;
+        }
+        bool is_asc_order = (_sort_order_flag[col_index] == 1);
+        bool is_null_first = (_sort_order_flag[col_index] * _null_first_flag[col_index] == -1);
+        PrimitiveType type = (*_sort_exprs)[col_index]->root()->type().type;
+        switch (type) {
+            CASE_FOR_NORMALIZED_KEY_ENCODE(TYPE_BOOLEAN)
+            CASE_FOR_NORMALIZED_KEY_ENCODE(TYPE_TINYINT)
+            CASE_FOR_NORMALIZED_KEY_ENCODE(TYPE_SMALLINT)
+            CASE_FOR_NORMALIZED_KEY_ENCODE(TYPE_INT)
+            CASE_FOR_NORMALIZED_KEY_ENCODE(TYPE_BIGINT)
+            CASE_FOR_NORMALIZED_KEY_ENCODE(TYPE_LARGEINT)
+            CASE_FOR_NORMALIZED_KEY_ENCODE(TYPE_DECIMALV2)
+            CASE_FOR_NORMALIZED_KEY_ENCODE(TYPE_DECIMAL32)
+            CASE_FOR_NORMALIZED_KEY_ENCODE(TYPE_DECIMAL64)
+            CASE_FOR_NORMALIZED_KEY_ENCODE(TYPE_DECIMAL128)
+            CASE_FOR_NORMALIZED_KEY_ENCODE(TYPE_DATE)
+            CASE_FOR_NORMALIZED_KEY_ENCODE(TYPE_DATETIME)
+        default:
+            DCHECK(false) << "unsupported type of normalized key: " << type;
+        }
+        offset += SortHelper::normalized_key_size(type) + column->is_nullable();
+    }
+    for (uint64_t& word : words) {
+        word = BitUtil::big_endian_to_host(word);
+    }
+
+    // Ties are broken by the row index as _sort_by_row_cmp does.
+    if (num_words == 1) {
+        std::vector<NormalizedKeyItem> items(num_rows);
+        for (uint32_t i = 0; i < num_rows; ++i) {
+            items[i] = {words[i], i};
+        }
+        // LSD radix sort is stable.
+        RadixSort<NormalizedKeyRadixSortTraits>::executeLSD(items.data(), num_rows);
+        for (size_t i = 0; i < num_rows; ++i) {
+            _sorted_permutation[i].index_in_chunk = _sorted_permutation[i].permutation_index = items[i].index_in_chunk;
+        }
+    } else {
+        std::vector<uint32_t> indices(num_rows);
+        for (uint32_t i = 0; i < num_rows; ++i) {
+            indices[i] = i;
+        }
+        const uint64_t* data = words.data();
+        auto less_fn = [data, num_words](uint32_t l, uint32_t r) {
+            const uint64_t* l_key = data + l * num_words;
+            const uint64_t* r_key = data + r * num_words;
+            for (size_t i = 0; i < num_words; ++i) {
+                if (l_key[i] != r_key[i]) {
+                    return l_key[i] < r_key[i];
+                }
+            }
+            return l < r;
+        };
+        pdqsort(indices.begin(), indices.end(), less_fn);
+        for (size_t i = 0; i < num_rows; ++i) {
+            _sorted_permutation[i].index_in_chunk = _sorted_permutation[i].permutation_index = indices[i];
+        }
+    }
+    return true;
+}
+
 #define CASE_FOR_NULLABLE_COLUMN_SORT(PrimitiveTypeName)                                                       \
     case PrimitiveTypeName: {                                                                                  \
         if (stable) {                                                                                          \
@@ -493,4 +744,88 @@ void ChunksSorterFullSort::_append_rows_to_chunk(Chunk* dest, Chunk* src, const
     DCHECK(!dest->has_const_column());
 }
 
+Status ChunksSorterFullSort::_spill_sorted_run(RuntimeState* state) {
+    if (_spill_chunk_template == nullptr) {
+        _spill_chunk_template = _big_chunk->clone_empty();
+        _spill_name = "sort_" + print_id(state->fragment_instance_id());
+        if (_runtime_profile != nullptr) {
+            _spill_timer = ADD_TIMER(_runtime_profile, "SpillTime");
+            _spill_runs = ADD_COUNTER(_runtime_profile, "SpillRuns", TUnit::UNIT);
+            _spill_rows = ADD_COUNTER(_runtime_profile, "SpillRows", TUnit::UNIT);
+            _spill_bytes = ADD_COUNTER(_runtime_profile, "SpillBytes", TUnit::BYTES);
+        }
+    }
+
+    RETURN_IF_ERROR(_sort_chunks(state));
+
+    SCOPED_TIMER(_spill_timer);
+    ASSIGN_OR_RETURN(auto file, SpillFile::create(_spill_name));
+    const size_t total_rows = _sorted_permutation.size();
+    for (size_t offset = 0; offset < total_rows; offset += config::vector_chunk_size) {
+        size_t count = std::min(size_t(config::vector_chunk_size), total_rows - offset);
+        ChunkUniquePtr run_chunk = _sorted_segment->chunk->clone_empty(count);
+        _append_rows_to_chunk(run_chunk.get(), _sorted_segment->chunk.get(), _sorted_permutation, offset, count);
+        RETURN_IF_ERROR(file->append(*run_chunk));
+    }
+    COUNTER_UPDATE(_spill_runs, 1);
+    COUNTER_UPDATE(_spill_rows, file->num_rows());
+    COUNTER_UPDATE(_spill_bytes, file->num_bytes());
+    _spill_files.emplace_back(std::move(file));
+
+    // Release the sorted rows, the next run starts from an empty chunk.
+    _sorted_segment.reset();
+    Permutation().swap(_sorted_permutation);
+    _big_chunk = _spill_chunk_template->clone_empty();
+    if (_mem_tracker != nullptr) {
+        _mem_tracker->release(_last_memory_usage);
+    }
+    _last_memory_usage = 0;
+    return Status::OK();
+}
+
+Status ChunksSorterFullSort::_init_spill_merger() {
+    ChunkSuppliers chunk_suppliers;
+    ChunkProbeSuppliers chunk_probe_suppliers;
+    ChunkHasSuppliers chunk_has_suppliers;
+    for (auto& file : _spill_files) {
+        RETURN_IF_ERROR(file->flip_to_read());
+        SpillFile* spill_file = file.get();
+        chunk_suppliers.emplace_back([this, spill_file](Chunk** chunk) -> Status {
+            *chunk = nullptr;
+            auto chunk_or = spill_file->read(*_spill_chunk_template);
+            if (!chunk_or.ok()) {
+                // ChunkCursor takes a failed supplier as the end of its run, keep the error for the caller.
+                _status = chunk_or.status();
+                return _status;
+            }
+            *chunk = chunk_or.value().release();
+            return Status::OK();
+        });
+        // Only used by the pipeline mode of SortedChunksMerger.
+        chunk_probe_suppliers.emplace_back([](Chunk**) -> bool { return false; });
+        chunk_has_suppliers.emplace_back([]() -> bool { return true; });
+    }
+
+    _spill_merger = std::make_unique<SortedChunksMerger>(false);
+    return _spill_merger->init(chunk_suppliers, chunk_probe_suppliers, chunk_has_suppliers, _sort_exprs, _is_asc,
+                               _is_null_first);
+}
+
+void ChunksSorterFullSort::_get_next_from_spill_merger(ChunkPtr* chunk, bool* eos) {
+    SCOPED_TIMER(_merge_timer);
+    Status st = _spill_merger->get_next(chunk, eos);
+    if (!st.ok() || !_status.ok()) {
+        if (_status.ok()) {
+            _status = st;
+        }
+        *chunk = nullptr;
+        *eos = true;
+    }
+    if (*eos) {
+        // Delete the runs as soon as they have been merged.
+        _spill_merger.reset();
+        _spill_files.clear();
+    }
+}
+
 } // namespace starrocks::vectorized
@@ -4,10 +4,16 @@
 
 #include "column/vectorized_fwd.h"
 #include "exec/vectorized/chunks_sorter.h"
+#include "exec/vectorized/spill_file.h"
 #include "exprs/expr_context.h"
 #include "util/runtime_profile.h"
 
 namespace starrocks::vectorized {
+class SortedChunksMerger;
+
+// When spilling is enabled for the query, the buffered rows are sorted and written to a
+// SpillFile as a sorted run once they exceed config::sort_spill_mem_limit_bytes, and all
+// the runs are merged by SortedChunksMerger in done(), i.e. an external merge sort.
 class ChunksSorterFullSort : public ChunksSorter {
 public:
     /**
@@ -33,15 +39,35 @@ private:
     Status _sort_chunks(RuntimeState* state);
     Status _build_sorting_data(RuntimeState* state);
 
+    bool _sort_by_normalized_keys();
     void _sort_by_row_cmp();
     void _sort_by_columns();
 
     void _append_rows_to_chunk(Chunk* dest, Chunk* src, const Permutation& permutation, size_t offset, size_t count);
 
+    // Sort the buffered rows and write them to a new spill file.
+    Status _spill_sorted_run(RuntimeState* state);
+    Status _init_spill_merger();
+    void _get_next_from_spill_merger(ChunkPtr* chunk, bool* eos);
+
+    const std::vector<bool>* _is_asc;
+    const std::vector<bool>* _is_null_first;
+
     ChunkUniquePtr _big_chunk;
     std::unique_ptr<DataSegment> _sorted_segment;
     Permutation _sorted_permutation;
     std::vector<uint32_t> _selective_values; // for appending selective values to sorted rows
+
+    bool _enable_spill = false;
+    std::string _spill_name;
+    ChunkUniquePtr _spill_chunk_template;
+    std::vector<SpillFilePtr> _spill_files;
+    std::unique_ptr<SortedChunksMerger> _spill_merger;
+
+    RuntimeProfile::Counter* _spill_timer = nullptr;
+    RuntimeProfile::Counter* _spill_runs = nullptr;
+    RuntimeProfile::Counter* _spill_rows = nullptr;
+    RuntimeProfile::Counter* _spill_bytes = nullptr;
 };
 
 } // namespace starrocks::vectorized
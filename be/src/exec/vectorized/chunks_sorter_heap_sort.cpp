@@ -0,0 +1,224 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/chunks_sorter_heap_sort.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "column/column_helper.h"
+#include "column/nullable_column.h"
+#include "column/type_traits.h"
+#include "common/config.h"
+#include "exprs/expr.h"
+#include "gutil/casts.h"
+#include "runtime/runtime_state.h"
+#include "util/stopwatch.hpp"
+
+namespace starrocks::vectorized {
+
+// Compare the non-null values of |column| with the boundary in a branchless loop, which is
+// vectorized by the compiler. Return false if it's not applicable to the columns.
+template <PrimitiveType PT>
+static bool compare_with_boundary(const Column& column, const Column& boundary_column, size_t boundary_row,
+                                  int sort_order_flag, std::vector<int8_t>* compare_results) {
+    using ColumnType = RunTimeColumnType<PT>;
+    if (column.is_nullable() || column.is_constant() || boundary_column.is_constant()) {
+        return false;
+    }
+    if (boundary_column.is_nullable() && boundary_column.is_null(boundary_row)) {
+        return false;
+    }
+    const auto* boundary_data = down_cast<const ColumnType*>(ColumnHelper::get_data_column(&boundary_column));
+    const auto boundary = boundary_data->get_data()[boundary_row];
+    const auto* data = down_cast<const ColumnType*>(&column)->get_data().data();
+    int8_t* results = compare_results->data();
+    const size_t num_rows = column.size();
+    for (size_t i = 0; i < num_rows; ++i) {
+        results[i] = static_cast<int8_t>(sort_order_flag * ((data[i] > boundary) - (data[i] < boundary)));
+    }
+    return true;
+}
+
+ChunksSorterHeapSort::ChunksSorterHeapSort(const std::vector<ExprContext*>* sort_exprs,
+                                           const std::vector<bool>* is_asc, const std::vector<bool>* is_null_first,
+                                           size_t offset, size_t limit)
+        : ChunksSorter(sort_exprs, is_asc, is_null_first),
+          _offset(offset),
+          _limit(limit),
+          _sorted_chunk(std::make_shared<Chunk>()) {
+    DCHECK_GT(_limit, 0);
+    _heap.reserve(_get_number_of_rows_to_sort());
+}
+
+ChunksSorterHeapSort::~ChunksSorterHeapSort() = default;
+
+Status ChunksSorterHeapSort::update(RuntimeState* state, const ChunkPtr& chunk) {
+    const size_t rows_to_sort = _get_number_of_rows_to_sort();
+    const size_t num_rows = chunk->num_rows();
+    std::vector<uint32_t> candidates;
+    {
+        ScopedTimer<MonotonicStopWatch> timer(_build_timer);
+        DataSegment segment(_sort_exprs, chunk);
+        if (_heap.size() < rows_to_sort) {
+            candidates.resize(num_rows);
+            std::iota(candidates.begin(), candidates.end(), 0);
+        } else {
+            _filter_by_boundary(segment, &candidates);
+        }
+        // none of the rows can make it into the top N.
+        if (candidates.empty()) {
+            return Status::OK();
+        }
+        _segments.emplace_back(std::move(segment));
+    }
+
+    ScopedTimer<MonotonicStopWatch> timer(_sort_timer);
+    const auto segment_index = static_cast<uint32_t>(_segments.size() - 1);
+    auto less = [this](const HeapEntry& lhs, const HeapEntry& rhs) { return _compare_entries(lhs, rhs) < 0; };
+    for (uint32_t row : candidates) {
+        HeapEntry entry{segment_index, row};
+        if (_heap.size() < rows_to_sort) {
+            _heap.push_back(entry);
+            std::push_heap(_heap.begin(), _heap.end(), less);
+        } else if (less(entry, _heap.front())) {
+            std::pop_heap(_heap.begin(), _heap.end(), less);
+            _heap.back() = entry;
+            std::push_heap(_heap.begin(), _heap.end(), less);
+        }
+    }
+    _num_segment_rows += num_rows;
+
+    // most of the buffered rows are not in the heap any more.
+    if (_segments.size() > 1 && _num_segment_rows > 4 * std::max<size_t>(rows_to_sort, config::vector_chunk_size)) {
+        _compact_segments();
+    }
+
+    if (_runtime_filter != nullptr && _heap.size() >= rows_to_sort) {
+        const HeapEntry& top = _heap.front();
+        _runtime_filter->update(*_segments[top.segment_index].order_by_columns[0], top.index_in_segment);
+    }
+
+    int64_t memory_in_use = 0;
+    for (const DataSegment& segment : _segments) {
+        memory_in_use += segment.chunk->memory_usage();
+    }
+    return _consume_and_check_memory_limit(state, memory_in_use - _last_memory_usage);
+}
+
+Status ChunksSorterHeapSort::done(RuntimeState* state) {
+    ScopedTimer<MonotonicStopWatch> timer(_merge_timer);
+    auto less = [this](const HeapEntry& lhs, const HeapEntry& rhs) { return _compare_entries(lhs, rhs) < 0; };
+    // sort_heap leaves the rows in ascending order, i.e. the first row is the top one.
+    std::sort_heap(_heap.begin(), _heap.end(), less);
+
+    // skip top OFFSET rows
+    if (_heap.size() > _offset) {
+        const size_t num_rows = _heap.size() - _offset;
+        _sorted_chunk.reset(_segments[_heap[_offset].segment_index].chunk->clone_empty(num_rows).release());
+        for (size_t i = _offset; i < _heap.size(); ++i) {
+            const HeapEntry& entry = _heap[i];
+            _sorted_chunk->append_safe(*_segments[entry.segment_index].chunk, entry.index_in_segment, 1);
+        }
+    }
+    _heap.clear();
+    _segments.clear();
+    _next_output_row = 0;
+    return Status::OK();
+}
+
+void ChunksSorterHeapSort::get_next(ChunkPtr* chunk, bool* eos) {
+    pull_chunk(chunk);
+    *eos = *chunk == nullptr;
+}
+
+bool ChunksSorterHeapSort::pull_chunk(ChunkPtr* chunk) {
+    ScopedTimer<MonotonicStopWatch> timer(_output_timer);
+    if (_next_output_row >= _sorted_chunk->num_rows()) {
+        *chunk = nullptr;
+        return true;
+    }
+    size_t count = std::min(size_t(config::vector_chunk_size), _sorted_chunk->num_rows() - _next_output_row);
+    chunk->reset(_sorted_chunk->clone_empty(count).release());
+    (*chunk)->append_safe(*_sorted_chunk, _next_output_row, count);
+    _next_output_row += count;
+    return _next_output_row >= _sorted_chunk->num_rows();
+}
+
+void ChunksSorterHeapSort::_filter_by_boundary(DataSegment& segment, std::vector<uint32_t>* candidates) {
+    const HeapEntry& top = _heap.front();
+    DataSegment& boundary = _segments[top.segment_index];
+    const size_t num_rows = segment.chunk->num_rows();
+    std::vector<int8_t> compare_results(num_rows, 0);
+    std::vector<uint64_t> rows_to_compare;
+
+    // the first order-by column decides the most rows, compare it in the fast path if possible.
+    size_t first_column = 0;
+    const Column& column = *segment.order_by_columns[0];
+    const Column& boundary_column = *boundary.order_by_columns[0];
+    bool compared = false;
+    switch ((*_sort_exprs)[0]->root()->type().type) {
+    case TYPE_TINYINT:
+        compared = compare_with_boundary<TYPE_TINYINT>(column, boundary_column, top.index_in_segment,
+                                                       _sort_order_flag[0], &compare_results);
+        break;
+    case TYPE_SMALLINT:
+        compared = compare_with_boundary<TYPE_SMALLINT>(column, boundary_column, top.index_in_segment,
+                                                        _sort_order_flag[0], &compare_results);
+        break;
+    case TYPE_INT:
+        compared = compare_with_boundary<TYPE_INT>(column, boundary_column, top.index_in_segment,
+                                                   _sort_order_flag[0], &compare_results);
+        break;
+    case TYPE_BIGINT:
+        compared = compare_with_boundary<TYPE_BIGINT>(column, boundary_column, top.index_in_segment,
+                                                      _sort_order_flag[0], &compare_results);
+        break;
+    default:
+        break;
+    }
+    if (compared) {
+        first_column = 1;
+        for (size_t i = 0; i < num_rows; ++i) {
+            if (compare_results[i] == 0) {
+                rows_to_compare.push_back(i);
+            }
+        }
+    } else {
+        rows_to_compare.resize(num_rows);
+        std::iota(rows_to_compare.begin(), rows_to_compare.end(), 0);
+    }
+
+    // the ties on the previous columns are decided by the next ones.
+    for (size_t i = first_column; i < segment.order_by_columns.size() && !rows_to_compare.empty(); ++i) {
+        DataSegment::compare_column_with_one_row(*segment.order_by_columns[i], *boundary.order_by_columns[i],
+                                                 top.index_in_segment, &rows_to_compare, &compare_results,
+                                                 _sort_order_flag[i], _null_first_flag[i]);
+    }
+
+    // the rows equal to the boundary can't replace it.
+    for (size_t i = 0; i < num_rows; ++i) {
+        if (compare_results[i] < 0) {
+            candidates->push_back(i);
+        }
+    }
+}
+
+void ChunksSorterHeapSort::_compact_segments() {
+    ChunkPtr chunk(_segments[_heap.front().segment_index].chunk->clone_empty(_heap.size()).release());
+    uint32_t index = 0;
+    // the heap order is kept, since the relative order of the rows is not changed.
+    for (HeapEntry& entry : _heap) {
+        chunk->append_safe(*_segments[entry.segment_index].chunk, entry.index_in_segment, 1);
+        entry = HeapEntry{0, index++};
+    }
+    _segments.clear();
+    _segments.emplace_back(_sort_exprs, chunk);
+    _num_segment_rows = chunk->num_rows();
+}
+
+int ChunksSorterHeapSort::_compare_entries(const HeapEntry& lhs, const HeapEntry& rhs) const {
+    return _segments[lhs.segment_index].compare_at(lhs.index_in_segment, _segments[rhs.segment_index],
+                                                   rhs.index_in_segment, _sort_order_flag, _null_first_flag);
+}
+
+} // namespace starrocks::vectorized
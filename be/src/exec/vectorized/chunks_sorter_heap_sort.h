@@ -0,0 +1,71 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "column/vectorized_fwd.h"
+#include "exec/vectorized/chunks_sorter.h"
+#include "exprs/expr_context.h"
+#include "util/runtime_profile.h"
+
+namespace starrocks::vectorized {
+
+// Sort Chunks in a streaming way for a small OFFSET + LIMIT.
+//
+// The top rows seen so far are kept as references in a bounded max-heap, whose top is the
+// boundary that an incoming row has to beat. Every incoming chunk is first filtered against
+// the boundary column by column, so only the candidate rows are compared with the heap,
+// and the chunk is released at once if none of its rows is a candidate.
+class ChunksSorterHeapSort : public ChunksSorter {
+public:
+    /**
+     * Constructor.
+     * @param sort_exprs     The order-by columns or columns with expresion. This sorter will use but not own the object.
+     * @param is_asc         Orders on each column.
+     * @param is_null_first  NULL values should at the head or tail.
+     * @param offset         Number of top rows to skip.
+     * @param limit          Number of top rows after those skipped to extract, must be positive.
+     */
+    ChunksSorterHeapSort(const std::vector<ExprContext*>* sort_exprs, const std::vector<bool>* is_asc,
+                         const std::vector<bool>* is_null_first, size_t offset, size_t limit);
+    ~ChunksSorterHeapSort() override;
+
+    // Append a Chunk for sort.
+    Status update(RuntimeState* state, const ChunkPtr& chunk) override;
+    // Finish seeding Chunk, and get sorted data with top OFFSET rows have been skipped.
+    Status done(RuntimeState* state) override;
+    // get_next only works after done().
+    void get_next(ChunkPtr* chunk, bool* eos) override;
+    // pull_chunk for pipeline.
+    bool pull_chunk(ChunkPtr* chunk) override;
+
+private:
+    // A reference to a row kept in the heap.
+    struct HeapEntry {
+        uint32_t segment_index;
+        uint32_t index_in_segment;
+    };
+
+    inline size_t _get_number_of_rows_to_sort() const { return _offset + _limit; }
+
+    // Collect the rows of |segment| which precede the boundary, i.e. the top of the heap.
+    void _filter_by_boundary(DataSegment& segment, std::vector<uint32_t>* candidates);
+
+    // Copy the rows in the heap to a single segment, to release the chunks referred by few rows.
+    void _compact_segments();
+
+    int _compare_entries(const HeapEntry& lhs, const HeapEntry& rhs) const;
+
+    const size_t _offset;
+    const size_t _limit;
+
+    // the chunks referred by the heap, with their order-by columns.
+    DataSegments _segments;
+    size_t _num_segment_rows = 0;
+    // max-heap by the sort order, so the top is the last row to keep.
+    std::vector<HeapEntry> _heap;
+
+    // the sorted rows for output.
+    ChunkPtr _sorted_chunk;
+};
+
+} // namespace starrocks::vectorized
@@ -147,6 +147,12 @@ Status ChunksSorterTopn::_sort_chunks(RuntimeState* state) {
     // the result is _merged_segment as [BEFORE, IN].
     RETURN_IF_ERROR(_merge_sort_data_as_merged_segment(state, permutations, segments));
 
+    // the last row to keep is the boundary that any later row has to beat.
+    const size_t rows_to_keep = _get_number_of_rows_to_sort();
+    if (_runtime_filter != nullptr && _merged_segment.chunk->num_rows() >= rows_to_keep) {
+        _runtime_filter->update(*_merged_segment.order_by_columns[0], rows_to_keep - 1);
+    }
+
     // This is memory_usage at end of this batch chunks,
     // Just update to It prepared for next batch chunks.
     size_t memory_in_use = sizeof(DataSegment) + _merged_segment.chunk->memory_usage();
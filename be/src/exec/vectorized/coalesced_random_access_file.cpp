@@ -0,0 +1,94 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/coalesced_random_access_file.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "exec/vectorized/hdfs_scanner.h"
+
+namespace starrocks::vectorized {
+
+void CoalescedRandomAccessFile::set_io_ranges(std::vector<IORange> ranges, int64_t max_gap,
+                                              int64_t max_buffer_size) {
+    _buffers.clear();
+    std::sort(ranges.begin(), ranges.end(),
+              [](const IORange& lhs, const IORange& rhs) { return lhs.offset < rhs.offset; });
+
+    size_t i = 0;
+    while (i < ranges.size()) {
+        int64_t start = ranges[i].offset;
+        int64_t end = start + ranges[i].size;
+        int64_t bytes = ranges[i].size;
+        size_t j = i + 1;
+        while (j < ranges.size() && ranges[j].offset <= end + max_gap &&
+               std::max(end, ranges[j].offset + ranges[j].size) - start <= max_buffer_size) {
+            end = std::max(end, ranges[j].offset + ranges[j].size);
+            bytes += ranges[j].size;
+            j++;
+        }
+        // a single range is read as well without the buffer
+        if (j - i > 1) {
+            SharedBuffer& buffer = _buffers[end];
+            buffer.offset = start;
+            buffer.size = end - start;
+            buffer.remaining = bytes;
+        }
+        i = j;
+    }
+}
+
+Status CoalescedRandomAccessFile::_read_from_buffer(uint64_t offset, const Slice& res, bool* hit) const {
+    *hit = false;
+    // the first range whose end > offset
+    auto it = _buffers.upper_bound(offset);
+    if (it == _buffers.end() || static_cast<int64_t>(offset) < it->second.offset ||
+        static_cast<int64_t>(offset + res.size) > it->first) {
+        return Status::OK();
+    }
+
+    SharedBuffer& buffer = it->second;
+    if (buffer.data == nullptr) {
+        std::unique_ptr<uint8_t[]> data(new uint8_t[buffer.size]);
+        RETURN_IF_ERROR(_file->read_at(buffer.offset, Slice(data.get(), buffer.size)));
+        buffer.data = std::move(data);
+        _stats->coalesced_io_count += 1;
+        _stats->coalesced_io_bytes += buffer.size;
+    }
+    memcpy(res.data, buffer.data.get() + (offset - buffer.offset), res.size);
+    *hit = true;
+
+    buffer.remaining -= res.size;
+    if (buffer.remaining <= 0) {
+        _buffers.erase(it);
+    }
+    return Status::OK();
+}
+
+Status CoalescedRandomAccessFile::read(uint64_t offset, Slice* res) const {
+    bool hit = false;
+    RETURN_IF_ERROR(_read_from_buffer(offset, *res, &hit));
+    if (hit) {
+        return Status::OK();
+    }
+    return _file->read(offset, res);
+}
+
+Status CoalescedRandomAccessFile::read_at(uint64_t offset, const Slice& res) const {
+    bool hit = false;
+    RETURN_IF_ERROR(_read_from_buffer(offset, res, &hit));
+    if (hit) {
+        return Status::OK();
+    }
+    return _file->read_at(offset, res);
+}
+
+Status CoalescedRandomAccessFile::readv_at(uint64_t offset, const Slice* res, size_t res_cnt) const {
+    for (size_t i = 0; i < res_cnt; i++) {
+        RETURN_IF_ERROR(read_at(offset, res[i]));
+        offset += res[i].size;
+    }
+    return Status::OK();
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,68 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "env/env.h"
+
+namespace starrocks::vectorized {
+
+struct HdfsScanStats;
+
+// A RandomAccessFile reading the ranges going to be read from the underlying file with a few large reads,
+// because the small reads of the remote files are dominated by the latency.
+// The ranges whose gap is not larger than |max_gap| are merged as long as the merged one is not larger
+// than |max_buffer_size|, and a merged range is read into a buffer by the first read falling into it. A read
+// not contained by any merged range goes to the underlying file. A buffer is freed once as many bytes as its
+// ranges have been read from it, or when the ranges are replaced.
+// Not thread safe, it's used by the readers of one scanner.
+class CoalescedRandomAccessFile final : public RandomAccessFile {
+public:
+    struct IORange {
+        IORange(int64_t offset_, int64_t size_) : offset(offset_), size(size_) {}
+        int64_t offset;
+        int64_t size;
+    };
+
+    CoalescedRandomAccessFile(RandomAccessFile* file, HdfsScanStats* stats) : _file(file), _stats(stats) {}
+    ~CoalescedRandomAccessFile() override = default;
+
+    // Replace the ranges going to be read, the ranges not merged with any other are left to the underlying
+    // file.
+    void set_io_ranges(std::vector<IORange> ranges, int64_t max_gap, int64_t max_buffer_size);
+
+    Status read(uint64_t offset, Slice* res) const override;
+
+    Status read_at(uint64_t offset, const Slice& res) const override;
+
+    Status readv_at(uint64_t offset, const Slice* res, size_t res_cnt) const override;
+
+    Status size(uint64_t* size) const override { return _file->size(size); }
+
+    const std::string& file_name() const override { return _file->file_name(); }
+
+    size_t num_buffers() const { return _buffers.size(); }
+
+private:
+    struct SharedBuffer {
+        int64_t offset = 0;
+        int64_t size = 0;
+        // bytes of the ranges not read yet
+        int64_t remaining = 0;
+        std::unique_ptr<uint8_t[]> data;
+    };
+
+    // Copy [offset, offset + res.size) from the buffer containing it, |*hit| is false if there is none.
+    Status _read_from_buffer(uint64_t offset, const Slice& res, bool* hit) const;
+
+    RandomAccessFile* _file;
+    HdfsScanStats* _stats;
+    // key: end of the merged range.
+    // the merged ranges are not overlapped.
+    mutable std::map<int64_t, SharedBuffer> _buffers;
+};
+
+} // namespace starrocks::vectorized
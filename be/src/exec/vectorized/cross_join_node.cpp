@@ -30,6 +30,9 @@ Status CrossJoinNode::prepare(RuntimeState* state) {
     _probe_rows_counter = ADD_COUNTER(runtime_profile(), "ProbeRows", TUnit::UNIT);
 
     _init_row_desc();
+    if (config::enable_cross_join_range_predicate) {
+        _range_predicate = RangeJoinPredicate::create(_conjunct_ctxs, child(0)->row_desc(), child(1)->row_desc());
+    }
     return Status::OK();
 }
 
@@ -262,22 +265,8 @@ Step 2: For probe_chunk and small_chunk, use every row in smaller chunk to itera
 
 So far, probe_chunk is done, we will process next chunk.
 */
-Status CrossJoinNode::get_next_internal(RuntimeState* state, ChunkPtr* chunk, bool* eos,
-                                        ScopedTimer<MonotonicStopWatch>& probe_timer) {
-    RETURN_IF_CANCELLED(state);
-
-    *chunk = nullptr;
-    if (_eos) {
-        *eos = true;
-        return Status::OK();
-    }
-
-    if (_build_chunk == nullptr || _build_chunk->num_rows() == 0) {
-        _eos = true;
-        *eos = true;
-        return Status::OK();
-    }
-
+Status CrossJoinNode::_get_next_cross_joined_chunk(RuntimeState* state, ChunkPtr* chunk,
+                                                   ScopedTimer<MonotonicStopWatch>& probe_timer) {
     for (;;) {
         // need to get probe_chunk
         if (_probe_chunk == nullptr || _probe_chunk->num_rows() == 0) {
@@ -287,7 +276,6 @@ Status CrossJoinNode::get_next_internal(RuntimeState* state, ChunkPtr* chunk, bo
             if (_eos) {
                 if (*chunk == nullptr || (*chunk)->num_rows() < 1) {
                     *chunk = nullptr;
-                    *eos = true;
                     return Status::OK();
                 } else {
                     // should output (*chunk) first before EOS
@@ -395,6 +383,78 @@ Status CrossJoinNode::get_next_internal(RuntimeState* state, ChunkPtr* chunk, bo
         // we get result chunk.
         break;
     }
+    return Status::OK();
+}
+
+Status CrossJoinNode::_get_next_range_joined_chunk(RuntimeState* state, ChunkPtr* chunk,
+                                                   ScopedTimer<MonotonicStopWatch>& probe_timer) {
+    for (;;) {
+        if (_probe_chunk == nullptr || _probe_chunk_index == _probe_chunk->num_rows()) {
+            probe_timer.stop();
+            RETURN_IF_ERROR(_get_next_probe_chunk(state));
+            probe_timer.start();
+            if (_eos) {
+                break;
+            }
+            _range_predicate->compute_ranges(*_probe_chunk, *_build_chunk, &_range_starts, &_range_ends);
+            _build_rows_index = _range_starts[0];
+            continue;
+        }
+
+        if ((*chunk) == nullptr) {
+            _init_chunk(chunk);
+        }
+
+        // join the current probe row with the rest of its range of build rows.
+        size_t row_count = std::min<size_t>(config::vector_chunk_size - (*chunk)->num_rows(),
+                                            _range_ends[_probe_chunk_index] - _build_rows_index);
+        if (row_count > 0) {
+            _copy_joined_rows_with_index_base_probe(*chunk, row_count, _probe_chunk_index, _build_rows_index);
+            _build_rows_index += row_count;
+        }
+        if (_build_rows_index >= _range_ends[_probe_chunk_index] &&
+            ++_probe_chunk_index < _probe_chunk->num_rows()) {
+            _build_rows_index = _range_starts[_probe_chunk_index];
+        }
+
+        if ((*chunk)->num_rows() >= config::vector_chunk_size) {
+            break;
+        }
+    }
+
+    if (*chunk == nullptr || (*chunk)->num_rows() < 1) {
+        *chunk = nullptr;
+    } else {
+        ExecNode::eval_conjuncts(_conjunct_ctxs, (*chunk).get());
+    }
+    return Status::OK();
+}
+
+Status CrossJoinNode::get_next_internal(RuntimeState* state, ChunkPtr* chunk, bool* eos,
+                                        ScopedTimer<MonotonicStopWatch>& probe_timer) {
+    RETURN_IF_CANCELLED(state);
+
+    *chunk = nullptr;
+    if (_eos) {
+        *eos = true;
+        return Status::OK();
+    }
+
+    if (_build_chunk == nullptr || _build_chunk->num_rows() == 0) {
+        _eos = true;
+        *eos = true;
+        return Status::OK();
+    }
+
+    if (_range_predicate != nullptr) {
+        RETURN_IF_ERROR(_get_next_range_joined_chunk(state, chunk, probe_timer));
+    } else {
+        RETURN_IF_ERROR(_get_next_cross_joined_chunk(state, chunk, probe_timer));
+    }
+    if (*chunk == nullptr) {
+        *eos = true;
+        return Status::OK();
+    }
 
     _num_rows_returned += (*chunk)->num_rows();
     if (reached_limit()) {
@@ -487,6 +547,9 @@ Status CrossJoinNode::_build(RuntimeState* state) {
 
     // Should not call num_rows on nullptr.
     if (_build_chunk != nullptr) {
+        if (_range_predicate != nullptr) {
+            _build_chunk = _range_predicate->sort_build_chunk(_build_chunk);
+        }
         _number_of_build_rows = _build_chunk->num_rows();
         _build_chunks_size = (_number_of_build_rows / config::vector_chunk_size) * config::vector_chunk_size;
     }
@@ -533,6 +596,10 @@ pipeline::OpFactories CrossJoinNode::decompose_to_pipeline(pipeline::PipelineBui
     using namespace pipeline;
 
     std::shared_ptr<pipeline::CrossJoinContext> cross_join_context = std::make_shared<pipeline::CrossJoinContext>();
+    if (config::enable_cross_join_range_predicate) {
+        cross_join_context->set_range_predicate(
+                RangeJoinPredicate::create(_conjunct_ctxs, child(0)->row_desc(), child(1)->row_desc()));
+    }
 
     // step 0: construct pipeline end with cross join right operator.
     OpFactories operator_before_cross_join_right = _children[1]->decompose_to_pipeline(context);
@@ -4,6 +4,7 @@
 
 #include "column/chunk.h"
 #include "exec/exec_node.h"
+#include "exec/vectorized/range_join_predicate.h"
 
 namespace starrocks {
 namespace vectorized {
@@ -28,6 +29,11 @@ public:
 private:
     Status _build(RuntimeState* state);
     Status _get_next_probe_chunk(RuntimeState* state);
+    // Fill |chunk| with the joined rows, leave it nullptr if all the rows have been joined.
+    Status _get_next_cross_joined_chunk(RuntimeState* state, ChunkPtr* chunk,
+                                        ScopedTimer<MonotonicStopWatch>& probe_timer);
+    Status _get_next_range_joined_chunk(RuntimeState* state, ChunkPtr* chunk,
+                                        ScopedTimer<MonotonicStopWatch>& probe_timer);
 
     // append cross-joined rows into chunk
 
@@ -88,6 +94,12 @@ private:
     RuntimeProfile::Counter* _probe_rows_counter = nullptr;
 
     std::vector<uint32_t> _buf_selective;
+
+    // Set if a conjunct can be used as RangeJoinPredicate, then _build_chunk is sorted by its build column,
+    // and the i-th row of _probe_chunk is only joined with the build rows in [_range_starts[i], _range_ends[i]).
+    std::unique_ptr<RangeJoinPredicate> _range_predicate;
+    std::vector<uint32_t> _range_starts;
+    std::vector<uint32_t> _range_ends;
 };
 } // namespace vectorized
 } // namespace starrocks
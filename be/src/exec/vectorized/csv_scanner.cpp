@@ -2,9 +2,14 @@
 
 #include "exec/vectorized/csv_scanner.h"
 
+#ifdef __x86_64__
+#include <immintrin.h>
+#endif
+
 #include "column/column_helper.h"
 #include "column/hash_set.h"
 #include "env/env.h"
+#include "env/env_stream_pipe.h"
 #include "gutil/strings/substitute.h"
 #include "runtime/runtime_state.h"
 #include "util/utf8_check.h"
@@ -12,10 +17,21 @@
 namespace starrocks::vectorized {
 
 /// CSVScanner::CSVReader
+CSVScanner::CSVReader::CSVReader(std::shared_ptr<SequentialFile> file, char record_delimiter, string field_delimiter)
+        : _file(std::move(file)),
+          _stream_file(dynamic_cast<StreamPipeSequentialFile*>(_file.get())),
+          _record_delimiter(record_delimiter),
+          _field_delimiter(std::move(field_delimiter)),
+          _storage(kMinBufferSize),
+          _buff(_storage.data(), _storage.size()) {}
+
 Status CSVScanner::CSVReader::next_record(Record* record) {
     if (_limit > 0 && _parsed_bytes > _limit) {
         return Status::EndOfFile("Reached limit");
     }
+    if (_stream_file != nullptr) {
+        return _next_stream_record(record);
+    }
     char* d;
     size_t pos = 0;
     while ((d = _buff.find(_record_delimiter, pos)) == nullptr) {
@@ -34,6 +50,57 @@ Status CSVScanner::CSVReader::next_record(Record* record) {
     return Status::OK();
 }
 
+Status CSVScanner::CSVReader::_next_stream_record(Record* record) {
+    while (true) {
+        if (_stream_buff != nullptr && _stream_buff->has_remaining()) {
+            char* data = _stream_buff->ptr + _stream_buff->pos;
+            const size_t n = _stream_buff->remaining();
+            const char* d = static_cast<const char*>(memchr(data, _record_delimiter, n));
+            if (d != nullptr && _buff.available() == 0) {
+                size_t l = d - data;
+                *record = Record(data, l);
+                _stream_buff->pos += l + 1;
+                _parsed_bytes += l + 1;
+                return Status::OK();
+            }
+            // the head of a record across the buffers, or its tail ended by the record delimiter.
+            size_t l = d != nullptr ? d - data + 1 : n;
+            RETURN_IF_ERROR(_append_to_buffer(data, l));
+            _stream_buff->pos += l;
+            if (d != nullptr) {
+                break;
+            }
+        } else if (!_stream_eof) {
+            SCOPED_RAW_TIMER(&_counter->file_read_ns);
+            RETURN_IF_ERROR(_stream_file->read_buffer(&_stream_buff));
+            _stream_eof = _stream_buff == nullptr;
+        } else if (_buff.available() > 0) {
+            // Has reached the end of the stream but still no record delimiter found, which is valid,
+            // according the RFC, add the record delimiter ourself.
+            RETURN_IF_ERROR(_append_to_buffer(&_record_delimiter, 1));
+            break;
+        } else {
+            return Status::EndOfFile(_file->filename());
+        }
+    }
+    // the record in _buff ended by the record delimiter.
+    size_t l = _buff.available() - 1;
+    *record = Record(_buff.position(), l);
+    _buff.skip(l + 1);
+    _parsed_bytes += l + 1;
+    return Status::OK();
+}
+
+Status CSVScanner::CSVReader::_append_to_buffer(const char* data, size_t size) {
+    _buff.compact();
+    while (_buff.free_space() < size) {
+        RETURN_IF_ERROR(_expand_buffer());
+    }
+    memcpy(_buff.limit(), data, size);
+    _buff.add_limit(size);
+    return Status::OK();
+}
+
 Status CSVScanner::CSVReader::_fill_buffer() {
     SCOPED_RAW_TIMER(&_counter->file_read_ns);
 
@@ -82,8 +149,37 @@ void CSVScanner::CSVReader::split_record(const Record& record, Fields* fields) c
     const size_t size = record.size;
 
     if (_field_delimiter.size() == 1) {
-        for (size_t i = 0; i < size; ++i, ++ptr) {
-            if (*ptr == _field_delimiter[0]) {
+        // Locate the delimiters of a whole block at a time: compare the block with the delimiter,
+        // and walk the set bits of the move mask, each of which ends a field.
+        const char delimiter = _field_delimiter[0];
+        const char* const end = record.data + size;
+#if defined(__AVX2__)
+        const __m256i pattern = _mm256_set1_epi8(delimiter);
+        for (; ptr + 32 <= end; ptr += 32) {
+            auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+                    _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr)), pattern)));
+            while (mask != 0) {
+                const char* d = ptr + __builtin_ctz(mask);
+                fields->emplace_back(value, d - value);
+                value = d + 1;
+                mask &= mask - 1;
+            }
+        }
+#elif defined(__SSE2__)
+        const __m128i pattern = _mm_set1_epi8(delimiter);
+        for (; ptr + 16 <= end; ptr += 16) {
+            auto mask = static_cast<uint32_t>(_mm_movemask_epi8(
+                    _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr)), pattern)));
+            while (mask != 0) {
+                const char* d = ptr + __builtin_ctz(mask);
+                fields->emplace_back(value, d - value);
+                value = d + 1;
+                mask &= mask - 1;
+            }
+        }
+#endif
+        for (; ptr < end; ++ptr) {
+            if (*ptr == delimiter) {
                 fields->emplace_back(value, ptr - value);
                 value = ptr + 1;
             }
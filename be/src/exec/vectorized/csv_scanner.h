@@ -8,11 +8,13 @@
 
 #include "exec/vectorized/file_scanner.h"
 #include "formats/csv/converter.h"
+#include "util/byte_buffer.h"
 #include "util/logging.h"
 #include "util/raw_container.h"
 
 namespace starrocks {
 class SequentialFile;
+class StreamPipeSequentialFile;
 }
 
 namespace starrocks::vectorized {
@@ -91,13 +93,9 @@ private:
         using Field = Slice;
         using Fields = std::vector<Field>;
 
-        CSVReader(std::shared_ptr<SequentialFile> file, char record_delimiter, string field_delimiter)
-                : _file(std::move(file)),
-                  _record_delimiter(record_delimiter),
-                  _field_delimiter(std::move(field_delimiter)),
-                  _storage(kMinBufferSize),
-                  _buff(_storage.data(), _storage.size()) {}
+        CSVReader(std::shared_ptr<SequentialFile> file, char record_delimiter, string field_delimiter);
 
+        // The record is valid until the next call.
         Status next_record(Record* record);
 
         void set_limit(size_t limit) { _limit = limit; }
@@ -110,7 +108,18 @@ private:
         Status _expand_buffer();
         Status _fill_buffer();
 
+        // The records of a stream load are parsed in the buffers of the pipe, only the records across the buffers
+        // are copied to _buff.
+        Status _next_stream_record(Record* record);
+        // Append |data| to _buff, which is expanded if needed.
+        Status _append_to_buffer(const char* data, size_t size);
+
         std::shared_ptr<SequentialFile> _file;
+        // not null if _file is the pipe of a stream load.
+        StreamPipeSequentialFile* _stream_file = nullptr;
+        // the buffer of the pipe parsed in place.
+        ByteBufferPtr _stream_buff;
+        bool _stream_eof = false;
         char _record_delimiter;
         string _field_delimiter;
         raw::RawVector<char> _storage;
@@ -78,7 +78,7 @@ Status DictDecodeNode::prepare(RuntimeState* state) {
 
         DefaultDecoderPtr decoder = std::make_unique<DefaultDecoder>();
         // TODO : avoid copy dict
-        decoder->dict = dict_iter->second.second;
+        decoder->set_dict(dict_iter->second.second);
         _decoders.emplace_back(std::move(decoder));
     }
     if (VLOG_ROW_IS_ON) {
@@ -17,6 +17,7 @@ static const char* FIELD_HITS = "hits";
 static const char* FIELD_INNER_HITS = "hits";
 static const char* FIELD_SOURCE = "_source";
 static const char* FIELD_ID = "_id";
+static const char* FIELD_FIELDS = "fields";
 
 const char* json_type_to_raw_str(rapidjson::Type type) {
     switch (type) {
@@ -108,6 +109,7 @@ ScrollParser::ScrollParser(bool doc_value_mode)
           _docvalue_context(nullptr),
           _size(0),
           _cur_line(0),
+          _inner_hits_node(nullptr),
           _doc_value_mode(doc_value_mode),
           _temp_writer(_scratch_buffer) {}
 
@@ -140,9 +142,9 @@ Status ScrollParser::parse(const std::string& scroll_result, bool exactly_once)
     if (!inner_hits_node.IsArray()) {
         return Status::OK();
     }
-    _inner_hits_node.CopyFrom(inner_hits_node, _document_node.GetAllocator());
+    _inner_hits_node = &inner_hits_node;
     // how many documents contains in this batch
-    _size = _inner_hits_node.Size();
+    _size = _inner_hits_node->Size();
 
     return Status::OK();
 }
@@ -165,11 +167,17 @@ Status ScrollParser::fill_chunk(ChunkPtr* chunk, bool* line_eos) {
     size_t left_sz = _size - _cur_line;
     size_t fill_sz = std::min(left_sz, (size_t)config::vector_chunk_size);
 
+    if (_doc_value_mode) {
+        RETURN_IF_ERROR(_fill_chunk_by_column(chunk->get(), fill_sz));
+        _cur_line += fill_sz;
+        return Status::OK();
+    }
+
     auto slots = _tuple_desc->slots();
 
     // TODO: we could fill chunk by column rather than row
     for (size_t i = 0; i < fill_sz; ++i) {
-        const rapidjson::Value& obj = _inner_hits_node[_cur_line + i];
+        const rapidjson::Value& obj = (*_inner_hits_node)[_cur_line + i];
         bool pure_doc_value = _pure_doc_value(obj);
         const rapidjson::Value& line = obj.HasMember(FIELD_SOURCE) ? obj[FIELD_SOURCE] : obj["fields"];
 
@@ -244,6 +252,56 @@ Status ScrollParser::fill_chunk(ChunkPtr* chunk, bool* line_eos) {
     return Status::OK();
 }
 
+Status ScrollParser::_fill_chunk_by_column(Chunk* chunk, size_t fill_sz) {
+    // the docvalue fields of the hits, nullptr for a hit without any of the fields.
+    std::vector<const rapidjson::Value*> hit_fields(fill_sz, nullptr);
+    for (size_t i = 0; i < fill_sz; ++i) {
+        const rapidjson::Value& obj = (*_inner_hits_node)[_cur_line + i];
+        auto iter = obj.FindMember(FIELD_FIELDS);
+        if (iter != obj.MemberEnd()) {
+            hit_fields[i] = &iter->value;
+        }
+    }
+
+    for (auto* slot_desc : _tuple_desc->slots()) {
+        if (!slot_desc->is_materialized()) {
+            continue;
+        }
+        if (slot_desc->col_name() == FIELD_ID) {
+            return Status::RuntimeError("obtain `_id` is not supported in doc_values mode");
+        }
+        Column* column = chunk->get_column_by_slot_id(slot_desc->id()).get();
+        const PrimitiveType type = slot_desc->type().type;
+        const std::string& field_name = _docvalue_context->at(slot_desc->col_name());
+        const rapidjson::Value field_key(rapidjson::StringRef(field_name.data(), field_name.size()));
+        column->reserve(fill_sz);
+        for (size_t i = 0; i < fill_sz; ++i) {
+            const rapidjson::Value* col = nullptr;
+            if (hit_fields[i] != nullptr) {
+                auto iter = hit_fields[i]->FindMember(field_key);
+                if (iter != hit_fields[i]->MemberEnd()) {
+                    col = &iter->value;
+                }
+            }
+            // a field not in the hit is null as well.
+            if (col == nullptr) {
+                _append_null(column);
+                continue;
+            }
+            if (col->IsNull() || (col->IsArray() && (col->Empty() || (*col)[0].IsNull()))) {
+                if (!slot_desc->is_nullable()) {
+                    return Status::DataQualityError(
+                            fmt::format("col `{}` is not null, but value from ES is null", slot_desc->col_name()));
+                }
+                _append_null(column);
+                continue;
+            }
+            RETURN_IF_ERROR(_append_value_from_json_val(column, type, *col, true));
+        }
+    }
+    return Status::OK();
+}
+
 void ScrollParser::set_params(const TupleDescriptor* descs,
                               const std::map<std::string, std::string>* docvalue_context) {
     _tuple_desc = descs;
@@ -35,6 +35,9 @@ public:
 private:
     static bool _pure_doc_value(const rapidjson::Value& obj);
 
+    // Fill |fill_sz| rows of the docvalue fields into |chunk| column by column.
+    Status _fill_chunk_by_column(Chunk* chunk, size_t fill_sz);
+
     template <PrimitiveType type, class CppType = RunTimeCppType<type>>
     static void _append_data(Column* column, CppType& value);
 
@@ -64,7 +67,8 @@ private:
     size_t _size;
     rapidjson::SizeType _cur_line;
     rapidjson::Document _document_node;
-    rapidjson::Value _inner_hits_node;
+    // the hits in _document_node.
+    const rapidjson::Value* _inner_hits_node;
     bool _doc_value_mode;
 
     rapidjson::StringBuffer _scratch_buffer;
@@ -217,18 +217,26 @@ Status EsHttpScanNode::_normalize_conjuncts() {
 }
 
 Status EsHttpScanNode::_start_scan_thread(RuntimeState* state) {
-    _num_running_scanners = _scan_ranges.size();
-    _scanners_status.resize(_scan_ranges.size());
+    // a shard is scanned by the sliced scrolls of its own scanners, but a search with limit is not sliced.
+    int num_slices = std::max(1, config::es_scroll_slices_per_shard);
+    if (limit() != -1 && limit() <= _runtime_state->batch_size()) {
+        num_slices = 1;
+    }
+    const size_t num_scanners = _scan_ranges.size() * num_slices;
+    _num_running_scanners = num_scanners;
+    _scanners_status.resize(num_scanners);
 
     // create scanner
-    std::vector<std::unique_ptr<EsHttpScanner>> scanners(_scan_ranges.size());
+    std::vector<std::unique_ptr<EsHttpScanner>> scanners(num_scanners);
     for (int i = 0; i < _scan_ranges.size(); i++) {
-        RETURN_IF_ERROR(_create_scanner(i, &scanners[i]));
+        for (int slice = 0; slice < num_slices; slice++) {
+            RETURN_IF_ERROR(_create_scanner(i, slice, num_slices, &scanners[i * num_slices + slice]));
+        }
     }
 
     // start scan
     // TODO: use thread pool instead of new thread
-    for (int i = 0; i < _scan_ranges.size(); i++) {
+    for (int i = 0; i < num_scanners; i++) {
         _scanner_threads.emplace_back(&EsHttpScanNode::_scanner_scan, this, std::move(scanners[i]),
                                       std::ref(_scanners_status[i]));
     }
@@ -250,7 +258,8 @@ static std::string get_host_port(const std::vector<TNetworkAddress>& es_hosts) {
     return fmt::format("{}:{}", host.hostname, host.port);
 }
 
-Status EsHttpScanNode::_create_scanner(int scanner_idx, std::unique_ptr<EsHttpScanner>* res) {
+Status EsHttpScanNode::_create_scanner(int scanner_idx, int slice_id, int num_slices,
+                                       std::unique_ptr<EsHttpScanner>* res) {
     std::vector<ExprContext*> scanner_expr_ctxs;
     auto status = Expr::clone_if_not_exists(_conjunct_ctxs, _runtime_state, &scanner_expr_ctxs);
     RETURN_IF_ERROR(status);
@@ -269,6 +278,10 @@ Status EsHttpScanNode::_create_scanner(int scanner_idx, std::unique_ptr<EsHttpSc
     if (limit() != -1 && limit() <= _runtime_state->batch_size()) {
         properties[ESScanReader::KEY_TERMINATE_AFTER] = std::to_string(limit());
     }
+    if (num_slices > 1) {
+        properties[ESScanReader::KEY_SLICE_ID] = std::to_string(slice_id);
+        properties[ESScanReader::KEY_SLICE_MAX] = std::to_string(num_slices);
+    }
 
     bool doc_value_mode = false;
     properties[ESScanReader::KEY_QUERY] =
@@ -44,7 +44,8 @@ private:
     Status _normalize_conjuncts();
 
     Status _start_scan_thread(RuntimeState* state);
-    Status _create_scanner(int scanner_idx, std::unique_ptr<EsHttpScanner>* res);
+    // create the scanner of the slice |slice_id| of |num_slices| of the scan range |scanner_idx|.
+    Status _create_scanner(int scanner_idx, int slice_id, int num_slices, std::unique_ptr<EsHttpScanner>* res);
     void _scanner_scan(std::unique_ptr<EsHttpScanner> scanner, std::promise<Status>& p_status);
     Status _acquire_chunks(EsHttpScanner* scanner);
 
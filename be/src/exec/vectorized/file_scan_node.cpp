@@ -2,10 +2,14 @@
 
 #include "exec/vectorized/file_scan_node.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cstring>
+#include <limits>
 #include <sstream>
 
 #include "column/chunk.h"
+#include "common/config.h"
 #include "common/object_pool.h"
 #include "env/compressed_file.h"
 #include "env/env.h"
@@ -20,6 +24,8 @@
 #include "runtime/exec_env.h"
 #include "runtime/row_batch.h"
 #include "runtime/runtime_state.h"
+#include "runtime/stream_load/load_stream_mgr.h"
+#include "runtime/stream_load/stream_load_pipe.h"
 #include "util/runtime_profile.h"
 
 namespace starrocks::vectorized {
@@ -81,15 +87,67 @@ Status FileScanNode::open(RuntimeState* state) {
 }
 
 Status FileScanNode::start_scanners() {
+    if (parse_stream_in_parallel()) {
+        return start_stream_parsers();
+    }
+    int num_scanners = 1;
+    if (split_scan_ranges()) {
+        num_scanners = std::max(1, std::min<int>(config::broker_load_scanner_threads, _scan_ranges.size()));
+    }
     {
         std::unique_lock<std::mutex> l(_chunk_queue_lock);
 
-        _num_running_scanners = 1;
-        _scanner_threads.emplace_back(&FileScanNode::scanner_worker, this, 0, _scan_ranges.size());
+        _num_running_scanners = num_scanners;
+        const int num_ranges = _scan_ranges.size();
+        for (int i = 0; i < num_scanners; ++i) {
+            const int start_idx = num_ranges * i / num_scanners;
+            const int end_idx = num_ranges * (i + 1) / num_scanners;
+            _scanner_threads.emplace_back(&FileScanNode::scanner_worker, this, start_idx, end_idx - start_idx);
+        }
     }
     return Status::OK();
 }
 
+bool FileScanNode::split_scan_ranges() {
+    const int64_t split_bytes = config::broker_load_split_range_bytes;
+    if (split_bytes <= 0) {
+        return false;
+    }
+    bool split = false;
+    std::vector<TScanRangeParams> scan_ranges;
+    for (const TScanRangeParams& scan_range_params : _scan_ranges) {
+        const TBrokerScanRange& scan_range = scan_range_params.scan_range.broker_scan_range;
+        TScanRangeParams rest(scan_range_params);
+        auto& rest_ranges = rest.scan_range.broker_scan_range.ranges;
+        rest_ranges.clear();
+        for (const TBrokerRangeDesc& range_desc : scan_range.ranges) {
+            // CSVScanner reads the records started in the range [start_offset, start_offset + size] of a plain
+            // CSV file, except the first one if start_offset isn't 0.
+            if (range_desc.file_type == TFileType::FILE_STREAM || !range_desc.splittable ||
+                range_desc.format_type != TFileFormatType::FORMAT_CSV_PLAIN || range_desc.size <= split_bytes) {
+                rest_ranges.emplace_back(range_desc);
+                continue;
+            }
+            for (int64_t offset = 0; offset < range_desc.size; offset += split_bytes) {
+                TScanRangeParams piece(scan_range_params);
+                TBrokerRangeDesc piece_desc(range_desc);
+                piece_desc.start_offset = range_desc.start_offset + offset;
+                piece_desc.size = std::min(split_bytes, range_desc.size - offset);
+                piece.scan_range.broker_scan_range.ranges = {piece_desc};
+                scan_ranges.emplace_back(std::move(piece));
+            }
+            split = true;
+        }
+        if (!rest_ranges.empty()) {
+            scan_ranges.emplace_back(std::move(rest));
+        }
+    }
+    if (split) {
+        _scan_ranges = std::move(scan_ranges);
+    }
+    return split;
+}
+
 Status FileScanNode::get_next(RuntimeState* state, RowBatch* row_batch, bool* eos) {
     return Status::InternalError("Not support");
 }
@@ -143,8 +201,8 @@ Status FileScanNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
         return Status::OK();
     }
 
-    // notify one scanner
-    _queue_writer_cond.notify_one();
+    // notify the scanners, the parsers of a stream load wait for their turn to hand over the chunks.
+    _queue_writer_cond.notify_all();
 
     *chunk = temp_chunk;
     _num_rows_returned += temp_chunk->num_rows();
@@ -176,6 +234,9 @@ Status FileScanNode::close(RuntimeState* state) {
     _scan_finished.store(true);
     _queue_writer_cond.notify_all();
     _queue_reader_cond.notify_all();
+    if (_stream_blocks != nullptr) {
+        _stream_blocks->shutdown();
+    }
     for (auto& _scanner_thread : _scanner_threads) {
         _scanner_thread.join();
     }
@@ -307,20 +368,28 @@ void FileScanNode::scanner_worker(int start_idx, int length) {
             }
         }
 
-        // Update stats
-        _runtime_state->update_num_rows_load_filtered(counter.num_rows_filtered);
-        _runtime_state->update_num_rows_load_unselected(counter.num_rows_unselected);
+        update_counters(counter);
+    }
+
+    finish_scanner(status);
+    Expr::close(scanner_expr_ctxs, _runtime_state);
+}
 
-        COUNTER_UPDATE(_scanner_total_timer, counter.total_ns);
-        COUNTER_UPDATE(_scanner_fill_timer, counter.fill_ns);
-        COUNTER_UPDATE(_scanner_read_timer, counter.read_batch_ns);
-        COUNTER_UPDATE(_scanner_cast_chunk_timer, counter.cast_chunk_ns);
-        COUNTER_UPDATE(_scanner_materialize_timer, counter.materialize_ns);
-        COUNTER_UPDATE(_scanner_init_chunk_timer, counter.init_chunk_ns);
+void FileScanNode::update_counters(const ScannerCounter& counter) {
+    _runtime_state->update_num_rows_load_filtered(counter.num_rows_filtered);
+    _runtime_state->update_num_rows_load_unselected(counter.num_rows_unselected);
 
-        COUNTER_UPDATE(_scanner_file_reader_timer, counter.file_read_ns);
-    }
+    COUNTER_UPDATE(_scanner_total_timer, counter.total_ns);
+    COUNTER_UPDATE(_scanner_fill_timer, counter.fill_ns);
+    COUNTER_UPDATE(_scanner_read_timer, counter.read_batch_ns);
+    COUNTER_UPDATE(_scanner_cast_chunk_timer, counter.cast_chunk_ns);
+    COUNTER_UPDATE(_scanner_materialize_timer, counter.materialize_ns);
+    COUNTER_UPDATE(_scanner_init_chunk_timer, counter.init_chunk_ns);
 
+    COUNTER_UPDATE(_scanner_file_reader_timer, counter.file_read_ns);
+}
+
+void FileScanNode::finish_scanner(const Status& status) {
     // scanner is going to finish
     {
         std::lock_guard<std::mutex> l(_chunk_queue_lock);
@@ -335,7 +404,200 @@ void FileScanNode::scanner_worker(int start_idx, int length) {
     if (!status.ok() && !status.is_end_of_file()) {
         _queue_writer_cond.notify_all();
     }
+}
+
+bool FileScanNode::parse_stream_in_parallel() const {
+    if (config::streaming_load_parse_threads <= 1 || _scan_ranges.size() != 1) {
+        return false;
+    }
+    const auto& ranges = _scan_ranges[0].scan_range.broker_scan_range.ranges;
+    // The compressed and the JSON bodies can't be split at the record boundaries without parsing them.
+    return ranges.size() == 1 && ranges[0].file_type == TFileType::FILE_STREAM &&
+           ranges[0].format_type == TFileFormatType::FORMAT_CSV_PLAIN;
+}
+
+Status FileScanNode::start_stream_parsers() {
+    const TBrokerRangeDesc& range_desc = _scan_ranges[0].scan_range.broker_scan_range.ranges[0];
+    auto pipe = _runtime_state->exec_env()->load_stream_mgr()->get(range_desc.load_id);
+    if (pipe == nullptr) {
+        std::stringstream ss("Invalid or outdated load id ");
+        range_desc.load_id.printTo(ss);
+        return Status::InternalError(ss.str());
+    }
+    const int num_parsers = config::streaming_load_parse_threads;
+    _stream_blocks = std::make_unique<BlockingQueue<StreamBlock>>(num_parsers);
+    {
+        std::unique_lock<std::mutex> l(_chunk_queue_lock);
+
+        _num_running_scanners = num_parsers + 1;
+        _scanner_threads.emplace_back(&FileScanNode::stream_splitter_worker, this, std::move(pipe));
+        for (int i = 0; i < num_parsers; ++i) {
+            _scanner_threads.emplace_back(&FileScanNode::stream_parser_worker, this);
+        }
+    }
+    return Status::OK();
+}
+
+void FileScanNode::stream_splitter_worker(std::shared_ptr<StreamLoadPipe> pipe) {
+    auto status = split_stream(pipe.get());
+    if (!status.ok()) {
+        LOG(WARNING) << "Fail to split the stream load body. status=" << status.get_error_msg();
+    }
+    // the parsers exit once they have parsed the blocks in the queue.
+    _stream_blocks->shutdown();
+    finish_scanner(status);
+}
+
+Status FileScanNode::split_stream(StreamLoadPipe* pipe) {
+    const size_t block_bytes = config::streaming_load_parse_block_bytes;
+    const char record_delimiter = _scan_ranges[0].scan_range.broker_scan_range.params.row_delimiter;
+    int64_t seq = 0;
+    auto new_block = [] { return std::make_shared<StreamLoadPipe>(std::numeric_limits<size_t>::max()); };
+    auto block = new_block();
+    size_t bytes = 0;
+    while (true) {
+        ByteBufferPtr buf;
+        RETURN_IF_ERROR(pipe->read_buffer(&buf));
+        if (buf == nullptr) {
+            break;
+        }
+        if (bytes + buf->remaining() < block_bytes) {
+            bytes += buf->remaining();
+            RETURN_IF_ERROR(block->append(buf));
+            continue;
+        }
+        // End the block at the last record delimiter of the buffer, the rest of the buffer, i.e. the head of a
+        // record, is copied to the next block.
+        const char* data = buf->ptr + buf->pos;
+        const auto* d = static_cast<const char*>(memrchr(data, record_delimiter, buf->remaining()));
+        if (d == nullptr) {
+            bytes += buf->remaining();
+            RETURN_IF_ERROR(block->append(buf));
+            continue;
+        }
+        ByteBufferPtr tail;
+        const size_t head_size = d + 1 - data;
+        if (head_size < buf->remaining()) {
+            tail = ByteBuffer::allocate(buf->remaining() - head_size);
+            tail->put_bytes(data + head_size, buf->remaining() - head_size);
+            tail->flip();
+            buf->limit = buf->pos + head_size;
+        }
+        RETURN_IF_ERROR(block->append(buf));
+        RETURN_IF_ERROR(block->finish());
+        if (!_stream_blocks->blocking_put(StreamBlock{seq++, std::move(block)})) {
+            // the scan node is closed or a parser failed.
+            return Status::OK();
+        }
+        block = new_block();
+        bytes = 0;
+        if (tail != nullptr) {
+            bytes = tail->remaining();
+            RETURN_IF_ERROR(block->append(tail));
+        }
+    }
+    if (bytes > 0) {
+        RETURN_IF_ERROR(block->finish());
+        _stream_blocks->blocking_put(StreamBlock{seq, std::move(block)});
+    }
+    return Status::OK();
+}
+
+void FileScanNode::stream_parser_worker() {
+    std::vector<ExprContext*> scanner_expr_ctxs;
+    auto status = Expr::clone_if_not_exists(_conjunct_ctxs, _runtime_state, &scanner_expr_ctxs);
+    if (!status.ok()) {
+        LOG(WARNING) << "Clone conjuncts failed.";
+    } else {
+        ScannerCounter counter;
+        StreamBlock block;
+        while (!_scan_finished.load() && _stream_blocks->blocking_get(&block)) {
+            status = parse_stream_block(block, scanner_expr_ctxs, &counter);
+            if (!status.ok() && !status.is_end_of_file()) {
+                LOG(WARNING) << "FileScanner of stream block " << block.seq
+                             << " process failed. status=" << status.get_error_msg();
+                // stop the splitter.
+                _stream_blocks->shutdown();
+                break;
+            }
+        }
+        update_counters(counter);
+    }
+
+    finish_scanner(status);
     Expr::close(scanner_expr_ctxs, _runtime_state);
 }
 
+Status FileScanNode::parse_stream_block(const StreamBlock& block, const std::vector<ExprContext*>& conjunct_ctxs,
+                                        ScannerCounter* counter) {
+    const TBrokerScanRange& scan_range = _scan_ranges[0].scan_range.broker_scan_range;
+    std::unique_ptr<FileScanner> scanner = create_scanner(scan_range, counter);
+    if (scanner == nullptr) {
+        return Status::InternalError("Failed to create scanner");
+    }
+    scanner->set_stream_pipe(block.pipe);
+    RETURN_IF_ERROR(scanner->open());
+
+    std::vector<ChunkPtr> chunks;
+    while (true) {
+        RETURN_IF_CANCELLED(_runtime_state);
+        if (_scan_finished.load()) {
+            return Status::OK();
+        }
+
+        auto res = scanner->get_next();
+        if (res.status().is_end_of_file()) {
+            break;
+        }
+        if (!res.ok()) {
+            return res.status();
+        }
+        ChunkPtr temp_chunk = std::move(res.value());
+
+        size_t before = temp_chunk->num_rows();
+        eval_conjuncts(conjunct_ctxs, temp_chunk.get());
+        counter->num_rows_unselected += (before - temp_chunk->num_rows());
+        if (temp_chunk->num_rows() > 0) {
+            chunks.emplace_back(std::move(temp_chunk));
+        }
+    }
+
+    // Hand over the chunks after those of the previous blocks, which keeps the order of the rows of the load.
+    {
+        std::unique_lock<std::mutex> l(_chunk_queue_lock);
+        for (auto& chunk : chunks) {
+            while (_process_status.ok() && !_scan_finished.load() && !_runtime_state->is_cancelled() &&
+                   (_next_stream_block != block.seq || _chunk_queue.size() >= _max_queue_size ||
+                    (mem_tracker()->any_limit_exceeded() && !_chunk_queue.empty()))) {
+                _queue_writer_cond.wait_for(l, std::chrono::seconds(1));
+            }
+            // Process already set failed, so we just return OK
+            if (!_process_status.ok()) {
+                return Status::OK();
+            }
+            // Scan already finished, just return
+            if (_scan_finished.load()) {
+                return Status::OK();
+            }
+            // Runtime state is canceled, just return cancel
+            if (_runtime_state->is_cancelled()) {
+                return Status::Cancelled("Cancelled FileScanNode::parse_stream_block");
+            }
+            _chunk_queue.push_back(std::move(chunk));
+            mem_tracker()->consume(_chunk_queue.back()->memory_usage());
+
+            _queue_reader_cond.notify_one();
+        }
+        // A block without any chunk waits for its turn as well.
+        while (_process_status.ok() && !_scan_finished.load() && !_runtime_state->is_cancelled() &&
+               _next_stream_block != block.seq) {
+            _queue_writer_cond.wait_for(l, std::chrono::seconds(1));
+        }
+        _next_stream_block = block.seq + 1;
+    }
+    // the parser of the next block.
+    _queue_writer_cond.notify_all();
+    return Status::OK();
+}
+
 } // namespace starrocks::vectorized
@@ -16,6 +16,7 @@
 #include "exec/scan_node.h"
 #include "exec/vectorized/file_scanner.h"
 #include "gen_cpp/InternalService_types.h"
+#include "util/blocking_queue.hpp"
 
 namespace starrocks {
 
@@ -26,6 +27,7 @@ class RandomAccessFile;
 struct ScannerCounter;
 class SequentialFile;
 class RandomAccessFile;
+class StreamLoadPipe;
 
 namespace vectorized {
 
@@ -72,6 +74,10 @@ private:
     // Create scanners to do scan job
     Status start_scanners();
 
+    // Split the large splittable plain CSV files into ranges of config::broker_load_split_range_bytes, every range
+    // in a scan range of its own. Returns whether any file is split.
+    bool split_scan_ranges();
+
     // One scanner worker, This scanner will handle 'length' ranges start from start_idx
     void scanner_worker(int start_idx, int length);
 
@@ -81,6 +87,32 @@ private:
 
     std::unique_ptr<FileScanner> create_scanner(const TBrokerScanRange& scan_range, ScannerCounter* counter);
 
+    void update_counters(const ScannerCounter& counter);
+
+    // Called by a scanner thread when it's going to finish with |status|.
+    void finish_scanner(const Status& status);
+
+    // The body of a CSV stream load is split at the record boundaries into blocks by a splitter thread, which are
+    // parsed by config::streaming_load_parse_threads scanner threads in parallel, and handed over to the chunk
+    // queue in the order of the blocks.
+    struct StreamBlock {
+        int64_t seq = 0;
+        std::shared_ptr<StreamLoadPipe> pipe;
+    };
+
+    bool parse_stream_in_parallel() const;
+
+    Status start_stream_parsers();
+
+    void stream_splitter_worker(std::shared_ptr<StreamLoadPipe> pipe);
+
+    Status split_stream(StreamLoadPipe* pipe);
+
+    void stream_parser_worker();
+
+    Status parse_stream_block(const StreamBlock& block, const std::vector<ExprContext*>& conjunct_ctxs,
+                              ScannerCounter* counter);
+
 private:
     TupleId _tuple_id;
     RuntimeState* _runtime_state;
@@ -103,6 +135,11 @@ private:
 
     std::vector<std::thread> _scanner_threads;
 
+    // The blocks of the stream load body to parse.
+    std::unique_ptr<BlockingQueue<StreamBlock>> _stream_blocks;
+    // The sequence number of the block whose chunks are handed over next, protected by _chunk_queue_lock.
+    int64_t _next_stream_block = 0;
+
     // Profile information
     RuntimeProfile::Counter* _wait_scanner_timer = nullptr;
     RuntimeProfile::Counter* _scanner_total_timer = nullptr;
@@ -4,6 +4,7 @@
 
 #include "column/column_helper.h"
 #include "column/hash_set.h"
+#include "common/config.h"
 #include "env/compressed_file.h"
 #include "env/env.h"
 #include "env/env_broker.h"
@@ -247,7 +248,10 @@ Status FileScanner::create_sequential_file(const TBrokerRangeDesc& range_desc, c
         break;
     }
     case TFileType::FILE_STREAM: {
-        auto pipe = _state->exec_env()->load_stream_mgr()->get(range_desc.load_id);
+        auto pipe = _stream_pipe;
+        if (pipe == nullptr) {
+            pipe = _state->exec_env()->load_stream_mgr()->get(range_desc.load_id);
+        }
         if (pipe == nullptr) {
             std::stringstream ss("Invalid or outdated load id ");
             range_desc.load_id.printTo(ss);
@@ -269,6 +273,14 @@ Status FileScanner::create_sequential_file(const TBrokerRangeDesc& range_desc, c
         return Status::OK();
     }
 
+    if (config::load_decompress_threads > 1 &&
+        (compression == CompressionTypePB::GZIP || compression == CompressionTypePB::LZ4_FRAME ||
+         compression == CompressionTypePB::ZSTD)) {
+        *file = std::make_shared<ParallelCompressedSequentialFile>(
+                std::move(src_file), compression, config::load_decompress_threads, config::load_decompress_task_bytes);
+        return Status::OK();
+    }
+
     using DecompressorPtr = std::shared_ptr<Decompressor>;
     Decompressor* dec = nullptr;
     RETURN_IF_ERROR(Decompressor::create_decompressor(compression, &dec));
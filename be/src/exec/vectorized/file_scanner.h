@@ -9,6 +9,7 @@
 namespace starrocks {
 class SequentialFile;
 class RandomAccessFile;
+class StreamLoadPipe;
 } // namespace starrocks
 
 namespace starrocks::vectorized {
@@ -49,6 +50,9 @@ public:
     Status create_sequential_file(const TBrokerRangeDesc& range_desc, const TNetworkAddress& address,
                                   const TBrokerScanRangeParams& params, std::shared_ptr<SequentialFile>* file);
 
+    // The FILE_STREAM ranges read |pipe| instead of the pipe registered by their load id.
+    void set_stream_pipe(std::shared_ptr<StreamLoadPipe> pipe) { _stream_pipe = std::move(pipe); }
+
 protected:
     void fill_columns_from_path(ChunkPtr& chunk, int slot_start, const std::vector<std::string>& columns_from_path,
                                 int size);
@@ -78,5 +82,7 @@ protected:
     // index: destination slot id
     // value: source slot desc
     std::vector<SlotDescriptor*> _dest_slot_desc_mappings;
+
+    std::shared_ptr<StreamLoadPipe> _stream_pipe;
 };
 } // namespace starrocks::vectorized
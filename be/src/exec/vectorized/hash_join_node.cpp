@@ -87,6 +87,10 @@ Status HashJoinNode::prepare(RuntimeState* state) {
     _probe_timer = ADD_TIMER(_runtime_profile, "ProbeTime");
     _merge_input_chunk_timer = ADD_CHILD_TIMER(_runtime_profile, "1-MergeInputChunkTimer", "ProbeTime");
     _search_ht_timer = ADD_CHILD_TIMER(_runtime_profile, "2-SearchHashTableTimer", "ProbeTime");
+    _search_ht_hash_timer = ADD_CHILD_TIMER(_runtime_profile, "2-1-HashProbeKeysTimer", "2-SearchHashTableTimer");
+    _search_ht_prefetch_timer =
+            ADD_CHILD_TIMER(_runtime_profile, "2-2-PrefetchBuildRowsTimer", "2-SearchHashTableTimer");
+    _search_ht_match_timer = ADD_CHILD_TIMER(_runtime_profile, "2-3-MatchProbeRowsTimer", "2-SearchHashTableTimer");
     _output_build_column_timer = ADD_CHILD_TIMER(_runtime_profile, "3-OutputBuildColumnTimer", "ProbeTime");
     _output_probe_column_timer = ADD_CHILD_TIMER(_runtime_profile, "4-OutputProbeColumnTimer", "ProbeTime");
     _output_tuple_column_timer = ADD_CHILD_TIMER(_runtime_profile, "5-OutputTupleColumnTimer", "ProbeTime");
@@ -125,6 +129,9 @@ void HashJoinNode::_init_hash_table_param(HashTableParam* param) {
     param->build_row_desc = &child(1)->row_desc();
     param->probe_row_desc = &child(0)->row_desc();
     param->search_ht_timer = _search_ht_timer;
+    param->search_ht_hash_timer = _search_ht_hash_timer;
+    param->search_ht_prefetch_timer = _search_ht_prefetch_timer;
+    param->search_ht_match_timer = _search_ht_match_timer;
     param->output_build_column_timer = _output_build_column_timer;
     param->output_probe_column_timer = _output_probe_column_timer;
     param->output_tuple_column_timer = _output_tuple_column_timer;
@@ -344,21 +351,45 @@ Status HashJoinNode::close(RuntimeState* state) {
 }
 
 pipeline::OpFactories HashJoinNode::decompose_to_pipeline(pipeline::PipelineBuilderContext* context) {
-    auto hash_joiner = std::make_unique<HashJoiner>(_hash_join_node, _id, _type, limit(), std::move(_is_null_safes),
-                                                    std::move(_build_expr_ctxs), std::move(_probe_expr_ctxs),
-                                                    std::move(_other_join_conjunct_ctxs), std::move(_conjunct_ctxs),
-                                                    child(1)->row_desc(), child(0)->row_desc(), _row_descriptor);
-    auto build_op = std::make_shared<pipeline::HashJoinBuildOperatorFactory>(context->next_operator_id(), id(),
-                                                                             hash_joiner.get());
-    // HashJoinProbeOperatorFactory holds the ownership of HashJoiner object.
-    auto probe_op = std::make_shared<pipeline::HashJoinProbeOperatorFactory>(context->next_operator_id(), id(),
-                                                                             std::move(hash_joiner));
+    auto build_op_id = context->next_operator_id();
+    auto probe_op_id = context->next_operator_id();
     auto rhs_operators = child(1)->decompose_to_pipeline(context);
     auto lhs_operators = child(0)->decompose_to_pipeline(context);
-    // Up to now, both HashJoin{Build, Probe}Operator is not parallelized, so add LocalExchangeOperator
+
+    // The probe side keeps the parallelism of the left child when the drivers can share one hash table,
+    // otherwise both HashJoin{Build, Probe}Operator are not parallelized, so add LocalExchangeOperator
     // to merge multi-stream into one stream then pipe into HashJoin{Build, Probe}Operator.
+    size_t num_probe_drivers = 1;
+    RuntimeState* state = context->fragment_context()->runtime_state();
+    if (config::pipeline_enable_parallel_hash_join_probe && JoinHashTable::can_share_build(_join_type) &&
+        limit() == -1 && !state->enable_spill()) {
+        auto* source_operator = down_cast<pipeline::SourceOperatorFactory*>(lhs_operators[0].get());
+        num_probe_drivers = source_operator->degree_of_parallelism();
+    }
     auto operators_with_build_op = context->maybe_interpolate_local_passthrough_exchange(rhs_operators);
-    auto operators_with_probe_op = context->maybe_interpolate_local_passthrough_exchange(lhs_operators);
+    auto operators_with_probe_op = num_probe_drivers > 1
+                                           ? lhs_operators
+                                           : context->maybe_interpolate_local_passthrough_exchange(lhs_operators);
+
+    std::vector<std::unique_ptr<HashJoiner>> readers;
+    for (size_t i = 1; i < num_probe_drivers; i++) {
+        readers.emplace_back(std::make_unique<HashJoiner>(
+                _hash_join_node, _id, _type, limit(), std::vector<bool>(_is_null_safes),
+                std::vector<ExprContext*>(_build_expr_ctxs), std::vector<ExprContext*>(_probe_expr_ctxs),
+                std::vector<ExprContext*>(_other_join_conjunct_ctxs), std::vector<ExprContext*>(_conjunct_ctxs),
+                child(1)->row_desc(), child(0)->row_desc(), _row_descriptor));
+    }
+    auto hash_joiner = std::make_unique<HashJoiner>(_hash_join_node, _id, _type, limit(), std::move(_is_null_safes),
+                                                    std::move(_build_expr_ctxs), std::move(_probe_expr_ctxs),
+                                                    std::move(_other_join_conjunct_ctxs), std::move(_conjunct_ctxs),
+                                                    child(1)->row_desc(), child(0)->row_desc(), _row_descriptor);
+    for (auto& reader : readers) {
+        hash_joiner->add_reader(reader.get());
+    }
+    auto build_op = std::make_shared<pipeline::HashJoinBuildOperatorFactory>(build_op_id, id(), hash_joiner.get());
+    // HashJoinProbeOperatorFactory holds the ownership of HashJoiner objects.
+    auto probe_op = std::make_shared<pipeline::HashJoinProbeOperatorFactory>(probe_op_id, id(), std::move(hash_joiner),
+                                                                             std::move(readers));
     // add build-side pipeline to context and return probe-side pipeline.
     operators_with_build_op.emplace_back(std::move(build_op));
     context->add_pipeline(operators_with_build_op);
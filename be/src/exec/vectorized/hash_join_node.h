@@ -113,6 +113,9 @@ private:
     RuntimeProfile::Counter* _merge_input_chunk_timer = nullptr;
     RuntimeProfile::Counter* _probe_timer = nullptr;
     RuntimeProfile::Counter* _search_ht_timer = nullptr;
+    RuntimeProfile::Counter* _search_ht_hash_timer = nullptr;
+    RuntimeProfile::Counter* _search_ht_prefetch_timer = nullptr;
+    RuntimeProfile::Counter* _search_ht_match_timer = nullptr;
     RuntimeProfile::Counter* _output_build_column_timer = nullptr;
     RuntimeProfile::Counter* _output_probe_column_timer = nullptr;
     RuntimeProfile::Counter* _output_tuple_column_timer = nullptr;
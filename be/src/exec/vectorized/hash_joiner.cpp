@@ -16,7 +16,9 @@
 #include "gutil/strings/substitute.h"
 #include "runtime/runtime_filter_worker.h"
 #include "simd/simd.h"
+#include "util/hash_util.hpp"
 #include "util/runtime_profile.h"
+#include "util/uid_util.h"
 namespace starrocks::vectorized {
 
 HashJoiner::HashJoiner(const THashJoinNode& hash_join_node, TPlanNodeId node_id, TPlanNodeType::type node_type,
@@ -71,6 +73,10 @@ Status HashJoiner::prepare(RuntimeState* state) {
     _probe_timer = ADD_TIMER(_runtime_profile, "ProbeTime");
     _merge_input_chunk_timer = ADD_CHILD_TIMER(_runtime_profile, "1-MergeInputChunkTimer", "ProbeTime");
     _search_ht_timer = ADD_CHILD_TIMER(_runtime_profile, "2-SearchHashTableTimer", "ProbeTime");
+    _search_ht_hash_timer = ADD_CHILD_TIMER(_runtime_profile, "2-1-HashProbeKeysTimer", "2-SearchHashTableTimer");
+    _search_ht_prefetch_timer =
+            ADD_CHILD_TIMER(_runtime_profile, "2-2-PrefetchBuildRowsTimer", "2-SearchHashTableTimer");
+    _search_ht_match_timer = ADD_CHILD_TIMER(_runtime_profile, "2-3-MatchProbeRowsTimer", "2-SearchHashTableTimer");
     _output_build_column_timer = ADD_CHILD_TIMER(_runtime_profile, "3-OutputBuildColumnTimer", "ProbeTime");
     _output_probe_column_timer = ADD_CHILD_TIMER(_runtime_profile, "4-OutputProbeColumnTimer", "ProbeTime");
     _output_tuple_column_timer = ADD_CHILD_TIMER(_runtime_profile, "5-OutputTupleColumnTimer", "ProbeTime");
@@ -82,19 +88,24 @@ Status HashJoiner::prepare(RuntimeState* state) {
     _probe_rows_counter = ADD_COUNTER(_runtime_profile, "ProbeRows", TUnit::UNIT);
     _build_rows_counter = ADD_COUNTER(_runtime_profile, "BuildRows", TUnit::UNIT);
     _build_buckets_counter = ADD_COUNTER(_runtime_profile, "BuildBuckets", TUnit::UNIT);
+    _bucket_memory_usage = _runtime_profile->AddHighWaterMarkCounter("BucketMemoryUsage", TUnit::BYTES);
+    _key_memory_usage = _runtime_profile->AddHighWaterMarkCounter("KeyMemoryUsage", TUnit::BYTES);
+    _build_chunk_memory_usage = _runtime_profile->AddHighWaterMarkCounter("BuildChunkMemoryUsage", TUnit::BYTES);
     _push_down_expr_num = ADD_COUNTER(_runtime_profile, "PushDownExprNum", TUnit::UNIT);
     _avg_input_probe_chunk_size = ADD_COUNTER(_runtime_profile, "AvgInputProbeChunkSize", TUnit::UNIT);
     _avg_output_chunk_size = ADD_COUNTER(_runtime_profile, "AvgOutputChunkSize", TUnit::UNIT);
     _runtime_profile->add_info_string("JoinType", _get_join_type_str(_join_type));
 
-    RETURN_IF_ERROR(Expr::prepare(_build_expr_ctxs, state, _build_row_descriptor));
-    RETURN_IF_ERROR(Expr::prepare(_probe_expr_ctxs, state, _probe_row_descriptor));
-    RETURN_IF_ERROR(Expr::prepare(_other_join_conjunct_ctxs, state, _row_descriptor));
-    RETURN_IF_ERROR(Expr::prepare(_conjunct_ctxs, state, _row_descriptor));
-    RETURN_IF_ERROR(Expr::open(_build_expr_ctxs, state));
-    RETURN_IF_ERROR(Expr::open(_probe_expr_ctxs, state));
-    RETURN_IF_ERROR(Expr::open(_other_join_conjunct_ctxs, state));
-    RETURN_IF_ERROR(Expr::open(_conjunct_ctxs, state));
+    if (_builder == nullptr) {
+        RETURN_IF_ERROR(Expr::prepare(_build_expr_ctxs, state, _build_row_descriptor));
+        RETURN_IF_ERROR(Expr::prepare(_probe_expr_ctxs, state, _probe_row_descriptor));
+        RETURN_IF_ERROR(Expr::prepare(_other_join_conjunct_ctxs, state, _row_descriptor));
+        RETURN_IF_ERROR(Expr::prepare(_conjunct_ctxs, state, _row_descriptor));
+        RETURN_IF_ERROR(Expr::open(_build_expr_ctxs, state));
+        RETURN_IF_ERROR(Expr::open(_probe_expr_ctxs, state));
+        RETURN_IF_ERROR(Expr::open(_other_join_conjunct_ctxs, state));
+        RETURN_IF_ERROR(Expr::open(_conjunct_ctxs, state));
+    }
 
     HashTableParam param;
     _init_hash_table_param(&param);
@@ -103,6 +114,14 @@ Status HashJoiner::prepare(RuntimeState* state) {
     _probe_column_count = _ht.get_probe_column_count();
     _build_column_count = _ht.get_build_column_count();
 
+    _enable_spill = state->enable_spill() && _can_spill() && _builder == nullptr && _readers.empty();
+    if (_enable_spill) {
+        _spill_timer = ADD_TIMER(_runtime_profile, "SpillTime");
+        _spill_build_rows_counter = ADD_COUNTER(_runtime_profile, "SpillBuildRows", TUnit::UNIT);
+        _spill_probe_rows_counter = ADD_COUNTER(_runtime_profile, "SpillProbeRows", TUnit::UNIT);
+        _spill_bytes_counter = ADD_COUNTER(_runtime_profile, "SpillBytes", TUnit::BYTES);
+    }
+
     return Status::OK();
 }
 
@@ -114,6 +133,9 @@ void HashJoiner::_init_hash_table_param(HashTableParam* param) {
     param->build_row_desc = &_build_row_descriptor;
     param->probe_row_desc = &_probe_row_descriptor;
     param->search_ht_timer = _search_ht_timer;
+    param->search_ht_hash_timer = _search_ht_hash_timer;
+    param->search_ht_prefetch_timer = _search_ht_prefetch_timer;
+    param->search_ht_match_timer = _search_ht_match_timer;
     param->output_build_column_timer = _output_build_column_timer;
     param->output_probe_column_timer = _output_probe_column_timer;
     param->output_tuple_column_timer = _output_tuple_column_timer;
@@ -129,6 +151,10 @@ Status HashJoiner::append_chunk_to_ht(RuntimeState* state, const ChunkPtr& chunk
     if (!chunk || chunk->is_empty()) {
         return Status::OK();
     }
+    if (_is_spilled) {
+        SCOPED_TIMER(_spill_timer);
+        return _spill_chunk(chunk, true, nullptr);
+    }
     if (UNLIKELY(_ht.get_row_count() + chunk->num_rows() >= UINT32_MAX)) {
         return Status::NotSupported(strings::Substitute("row count of right table in hash join > $0", UINT32_MAX));
     }
@@ -137,22 +163,53 @@ Status HashJoiner::append_chunk_to_ht(RuntimeState* state, const ChunkPtr& chunk
         SCOPED_TIMER(_copy_right_table_chunk_timer);
         RETURN_IF_ERROR(_ht.append_chunk(state, chunk));
     }
+    if (_enable_spill &&
+        static_cast<int64_t>(_ht.get_build_chunk()->memory_usage()) > config::join_spill_mem_limit_bytes) {
+        return _spill_build_rows(state);
+    }
     return Status::OK();
 }
 
 Status HashJoiner::build_ht(RuntimeState* state) {
     if (_phase == HashJoinPhase::BUILD) {
-        RETURN_IF_ERROR(_build(state));
+        if (_is_spilled) {
+            _build_status = _load_spill_partition(state, 0);
+        } else {
+            RETURN_IF_ERROR(_build(state));
+        }
         COUNTER_SET(_build_rows_counter, static_cast<int64_t>(_ht.get_row_count()));
         COUNTER_SET(_build_buckets_counter, static_cast<int64_t>(_ht.get_bucket_size()));
-        _short_circuit_break();
+        _update_memory_usage_counters();
+        // The short-circuit depends on the whole build rows
+        if (!_is_spilled) {
+            _short_circuit_break();
+        }
         auto old_phase = HashJoinPhase::BUILD;
         // _phase may be set to HashJoinPhase::EOS because HashJoinProbeOperator finishes prematurely.
         _phase.compare_exchange_strong(old_phase, HashJoinPhase::PROBE);
+        for (HashJoiner* reader : _readers) {
+            reader->_share_build(*this);
+        }
     }
     return Status::OK();
 }
 
+void HashJoiner::_update_memory_usage_counters() {
+    COUNTER_SET(_bucket_memory_usage, static_cast<int64_t>(_ht.get_bucket_memory_usage()));
+    COUNTER_SET(_key_memory_usage, static_cast<int64_t>(_ht.get_key_memory_usage()));
+    COUNTER_SET(_build_chunk_memory_usage, static_cast<int64_t>(_ht.get_build_chunk_memory_usage()));
+}
+
+void HashJoiner::_share_build(const HashJoiner& builder) {
+    _ht.share_build(builder._ht);
+    COUNTER_SET(_build_rows_counter, static_cast<int64_t>(_ht.get_row_count()));
+    COUNTER_SET(_build_buckets_counter, static_cast<int64_t>(_ht.get_bucket_size()));
+    _short_circuit_break();
+    auto old_phase = HashJoinPhase::BUILD;
+    _phase.compare_exchange_strong(old_phase, HashJoinPhase::PROBE);
+    notify_observers();
+}
+
 bool HashJoiner::need_input() const {
     // when _buffered_chunk accumulates several chunks to form into a large enough chunk, it is moved into
     // _probe_chunk for probe operations.
@@ -173,18 +230,30 @@ bool HashJoiner::has_output() const {
     }
 }
 
-void HashJoiner::push_chunk(RuntimeState* state, ChunkPtr&& chunk) {
+Status HashJoiner::push_chunk(RuntimeState* state, ChunkPtr&& chunk) {
     DCHECK(chunk && !chunk->is_empty());
     DCHECK(!_probe_input_chunk);
+    RETURN_IF_ERROR(_build_status);
+    if (_is_spilled) {
+        SCOPED_TIMER(_spill_timer);
+        ChunkPtr first_partition_chunk;
+        RETURN_IF_ERROR(_spill_chunk(chunk, false, &first_partition_chunk));
+        if (first_partition_chunk == nullptr) {
+            return Status::OK();
+        }
+        chunk = std::move(first_partition_chunk);
+    }
     _merge_probe_input_chunk(state, std::move(chunk));
     if (_probe_input_chunk) {
         _ht_has_remain = true;
         _prepare_probe_key_columns();
     }
+    return Status::OK();
 }
 
 StatusOr<ChunkPtr> HashJoiner::pull_chunk(RuntimeState* state) {
     DCHECK(_phase != HashJoinPhase::BUILD);
+    RETURN_IF_ERROR(_build_status);
     auto&& maybe_chunk = _pull_probe_output_chunk(state);
     if (UNLIKELY(!maybe_chunk.ok())) {
         return std::move(maybe_chunk);
@@ -232,6 +301,23 @@ StatusOr<ChunkPtr> HashJoiner::_pull_probe_output_chunk(RuntimeState* state) {
             _ht_has_remain = true;
             _prepare_probe_key_columns();
         }
+        // read the spilled probe rows of current partition.
+        SpillFile* probe_spill_file = _is_spilled ? _probe_spill_files[_spill_partition].get() : nullptr;
+        if (probe_spill_file != nullptr && !_probe_input_chunk) {
+            SCOPED_TIMER(_spill_timer);
+            ChunkUniquePtr spilled_chunk;
+            if (_probe_spill_template != nullptr) {
+                ASSIGN_OR_RETURN(spilled_chunk, probe_spill_file->read(*_probe_spill_template));
+            }
+            if (spilled_chunk != nullptr) {
+                _probe_input_chunk = std::move(spilled_chunk);
+                _ht_has_remain = true;
+                _prepare_probe_key_columns();
+            } else {
+                _probe_spill_files[_spill_partition].reset();
+                probe_spill_file = nullptr;
+            }
+        }
         // _probe_chunk has remain rows to be processed, so go on probing ht.
         if (_probe_input_chunk) {
             RETURN_IF_ERROR(_ht.probe(_key_columns, &_probe_input_chunk, &chunk, &_ht_has_remain));
@@ -245,7 +331,7 @@ StatusOr<ChunkPtr> HashJoiner::_pull_probe_output_chunk(RuntimeState* state) {
         }
         // cached _buffered_probe_chunk and _probe_chunk have been exhausted, so now entries of ht should be processed
         // for RIGHT ANTI-JOIN, RIGHT SEMI-JOIN, FULL OUTER-JOIN.
-        if (!_buffered_probe_input_chunk && !_probe_input_chunk) {
+        if (!_buffered_probe_input_chunk && !_probe_input_chunk && probe_spill_file == nullptr) {
             RETURN_IF_ERROR(_post_probe(state));
             if (_probe_output_chunk) {
                 return std::move(_probe_output_chunk);
@@ -264,10 +350,14 @@ StatusOr<ChunkPtr> HashJoiner::_pull_probe_output_chunk(RuntimeState* state) {
 void HashJoiner::close(RuntimeState* state) {
     if (!_is_closed) {
         _ht.close();
-        Expr::close(_conjunct_ctxs, state);
-        Expr::close(_other_join_conjunct_ctxs, state);
-        Expr::close(_probe_expr_ctxs, state);
-        Expr::close(_build_expr_ctxs, state);
+        _build_spill_files.clear();
+        _probe_spill_files.clear();
+        if (_builder == nullptr) {
+            Expr::close(_conjunct_ctxs, state);
+            Expr::close(_other_join_conjunct_ctxs, state);
+            Expr::close(_probe_expr_ctxs, state);
+            Expr::close(_build_expr_ctxs, state);
+        }
         _is_closed = true;
     }
 }
@@ -299,6 +389,9 @@ Status HashJoiner::_build(RuntimeState* state) {
 
     {
         SCOPED_TIMER(_build_ht_timer);
+        // the hash table of a large build is much larger than the cache, partition it to probe.
+        _ht.set_radix_partition(config::join_radix_partition_min_build_rows > 0 &&
+                                _ht.get_row_count() >= config::join_radix_partition_min_build_rows);
         RETURN_IF_ERROR(_ht.build(state));
     }
 
@@ -420,6 +513,162 @@ void HashJoiner::_process_other_conjunct(ChunkPtr* chunk) {
     }
 }
 
+bool HashJoiner::_can_spill() const {
+    // NULL_AWARE_LEFT_ANTI_JOIN depends on whether there is null in all the build rows.
+    if (_join_type == TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN || _probe_expr_ctxs.empty()) {
+        return false;
+    }
+    // The tuple columns of nullable tuples are not spilled.
+    return !_build_row_descriptor.is_any_tuple_nullable() && !_probe_row_descriptor.is_any_tuple_nullable();
+}
+
+ChunkPtr HashJoiner::_normalize_spill_chunk(const ChunkPtr& chunk, const RowDescriptor& row_desc) {
+    auto result = std::make_shared<Chunk>();
+    size_t num_rows = chunk->num_rows();
+    for (const auto& tuple_desc : row_desc.tuple_descriptors()) {
+        for (const auto& slot : tuple_desc->slots()) {
+            ColumnPtr column = ColumnHelper::unfold_const_column(slot->type(), num_rows,
+                                                                 chunk->get_column_by_slot_id(slot->id()));
+            if (slot->is_nullable() && !column->is_nullable()) {
+                column = NullableColumn::create(column, NullColumn::create(num_rows, 0));
+            }
+            result->append_column(std::move(column), slot->id());
+        }
+    }
+    return result;
+}
+
+void HashJoiner::_partition_chunk(const ChunkPtr& chunk, const std::vector<ExprContext*>& expr_ctxs) {
+    size_t num_rows = chunk->num_rows();
+    Columns key_columns;
+    _prepare_key_columns(key_columns, chunk, expr_ctxs);
+    // The equal keys of build and probe side must be in the same partition, and the hash differs
+    // from the one of JoinHashMap, otherwise the rows of a partition are clustered in hash table.
+    _spill_hashes.assign(num_rows, HashUtil::FNV_SEED);
+    for (const auto& column : key_columns) {
+        column->fnv_hash(_spill_hashes.data(), 0, num_rows);
+    }
+    size_t num_partitions = _spill_partition_rows.size();
+    for (auto& rows : _spill_partition_rows) {
+        rows.clear();
+    }
+    for (uint32_t row = 0; row < num_rows; row++) {
+        _spill_partition_rows[_spill_hashes[row] % num_partitions].push_back(row);
+    }
+}
+
+Status HashJoiner::_spill_build_rows(RuntimeState* state) {
+    SCOPED_TIMER(_spill_timer);
+    size_t num_partitions = std::max(config::join_spill_partition_num, 1);
+    std::string name = "join_" + print_id(state->fragment_instance_id());
+    _probe_spill_files.emplace_back(nullptr);
+    for (size_t i = 0; i < num_partitions; i++) {
+        ASSIGN_OR_RETURN(auto build_file, SpillFile::create(name));
+        _build_spill_files.emplace_back(std::move(build_file));
+        if (i > 0) {
+            ASSIGN_OR_RETURN(auto probe_file, SpillFile::create(name));
+            _probe_spill_files.emplace_back(std::move(probe_file));
+        }
+    }
+    _spill_partition_rows.resize(num_partitions);
+
+    // The first row of build chunk is reserved by hash table.
+    const ChunkPtr& build_chunk = _ht.get_build_chunk();
+    size_t num_rows = _ht.get_row_count();
+    for (size_t offset = 1; offset <= num_rows; offset += config::vector_chunk_size) {
+        size_t count = std::min<size_t>(config::vector_chunk_size, num_rows + 1 - offset);
+        ChunkPtr chunk = build_chunk->clone_empty_with_slot(count);
+        chunk->append(*build_chunk, offset, count);
+        RETURN_IF_ERROR(_spill_chunk(chunk, true, nullptr));
+    }
+    _ht.reset_build();
+    _is_spilled = true;
+    return Status::OK();
+}
+
+Status HashJoiner::_spill_chunk(const ChunkPtr& chunk, bool is_build, ChunkPtr* first_partition_chunk) {
+    if (chunk->is_empty()) {
+        return Status::OK();
+    }
+    ChunkPtr normalized = _normalize_spill_chunk(chunk, is_build ? _build_row_descriptor : _probe_row_descriptor);
+    _partition_chunk(normalized, is_build ? _build_expr_ctxs : _probe_expr_ctxs);
+
+    auto& files = is_build ? _build_spill_files : _probe_spill_files;
+    auto& spill_template = is_build ? _build_spill_template : _probe_spill_template;
+    if (spill_template == nullptr) {
+        spill_template = normalized->clone_empty_with_slot(0);
+    }
+    size_t num_spilled_rows = 0;
+    for (size_t i = 0; i < files.size(); i++) {
+        const auto& rows = _spill_partition_rows[i];
+        if (rows.empty()) {
+            continue;
+        }
+        ChunkPtr partition_chunk = normalized->clone_empty_with_slot(rows.size());
+        partition_chunk->append_selective(*normalized, rows.data(), 0, rows.size());
+        if (files[i] == nullptr) {
+            DCHECK(first_partition_chunk != nullptr);
+            *first_partition_chunk = std::move(partition_chunk);
+            continue;
+        }
+        size_t num_bytes = files[i]->num_bytes();
+        RETURN_IF_ERROR(files[i]->append(*partition_chunk));
+        COUNTER_UPDATE(_spill_bytes_counter, files[i]->num_bytes() - num_bytes);
+        num_spilled_rows += rows.size();
+    }
+    COUNTER_UPDATE(is_build ? _spill_build_rows_counter : _spill_probe_rows_counter, num_spilled_rows);
+    return Status::OK();
+}
+
+Status HashJoiner::_load_spill_partition(RuntimeState* state, size_t partition) {
+    {
+        SCOPED_TIMER(_spill_timer);
+        if (partition == 0) {
+            for (auto& file : _build_spill_files) {
+                RETURN_IF_ERROR(file->flip_to_read());
+            }
+        }
+        _spill_partition = partition;
+        _ht.reset_build();
+        SpillFile* file = _build_spill_files[partition].get();
+        while (_build_spill_template != nullptr) {
+            ASSIGN_OR_RETURN(ChunkUniquePtr chunk, file->read(*_build_spill_template));
+            if (chunk == nullptr) {
+                break;
+            }
+            if (UNLIKELY(_ht.get_row_count() + chunk->num_rows() >= UINT32_MAX)) {
+                return Status::NotSupported(strings::Substitute(
+                        "row count of right table in partition $0 of spilled hash join > $1", partition, UINT32_MAX));
+            }
+            RETURN_IF_ERROR(_ht.append_chunk(state, std::move(chunk)));
+        }
+        _build_spill_files[partition].reset();
+    }
+    RETURN_IF_ERROR(_build(state));
+    // The partitions are built one by one, the counters keep the peak of them.
+    _update_memory_usage_counters();
+    return Status::OK();
+}
+
+Status HashJoiner::_finish_probe_partition(RuntimeState* state) {
+    if (!_is_spilled || _spill_partition + 1 >= _build_spill_files.size()) {
+        _phase = HashJoinPhase::EOS;
+        // The readers may be still probing the hash table.
+        if (_readers.empty()) {
+            _ht.close();
+        }
+        return Status::OK();
+    }
+    if (_spill_partition == 0) {
+        // All the probe rows have been spilled
+        for (size_t i = 1; i < _probe_spill_files.size(); i++) {
+            RETURN_IF_ERROR(_probe_spill_files[i]->flip_to_read());
+        }
+    }
+    _probe_spill_files[_spill_partition].reset();
+    return _load_spill_partition(state, _spill_partition + 1);
+}
+
 std::string HashJoiner::_get_join_type_str(TJoinOp::type join_type) {
     switch (join_type) {
     case TJoinOp::INNER_JOIN:
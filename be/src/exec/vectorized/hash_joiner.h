@@ -6,8 +6,10 @@
 #include "column/fixed_length_column.h"
 #include "common/statusor.h"
 #include "exec/exec_node.h"
+#include "exec/pipeline/pipeline_observer.h"
 #include "exec/vectorized/hash_join_node.h"
 #include "exec/vectorized/join_hash_map.h"
+#include "exec/vectorized/spill_file.h"
 #include "util/phmap/phmap.h"
 
 namespace starrocks {
@@ -31,6 +33,19 @@ class RuntimeFilterBuildDescriptor;
 //   processed.
 // 4.DONE: all input streams have been processed.
 //
+// When spilling is enabled for the query and the build rows exceed config::join_spill_mem_limit_bytes,
+// HashJoiner turns into grace hash join: build and probe rows are partitioned by the hash of join keys
+// into config::join_spill_partition_num partitions. The first partition is joined in PROBE and
+// POST_PROBE phases as usual, while the rest partitions are spilled to disk, and joined one by one
+// in POST_PROBE phase, each of them rebuilds the hash table from its spilled build rows before the
+// spilled probe rows are read back.
+//
+// For the join types whose probe never writes to the hash table, see JoinHashTable::can_share_build,
+// the probe side can run with multiple drivers sharing one hash table: the HashJoiner used by
+// HashJoinBuildOperator builds the hash table, and the readers added by add_reader, one for each of
+// the other probe drivers, probe the same hash table once the building is done. A reader shares the
+// expression contexts with its builder, which prepares and closes them.
+//
 enum HashJoinPhase {
     BUILD = 0,
     PROBE = 1,
@@ -52,6 +67,9 @@ public:
     bool has_output() const;
     bool is_build_done() const { return _phase != HashJoinPhase::BUILD; }
     bool is_done() const { return _phase == HashJoinPhase::EOS; }
+    // the observers of probe drivers are notified when the building of ht is done.
+    void add_observer(pipeline::PipelineObserver* observer) { _observable.add_observer(observer); }
+    void notify_observers() { _observable.notify_observers(); }
     void enter_post_probe_phase() {
         HashJoinPhase old_phase = HashJoinPhase::PROBE;
         if (!_phase.compare_exchange_strong(old_phase, HashJoinPhase::POST_PROBE)) {
@@ -60,11 +78,16 @@ public:
             _phase.compare_exchange_strong(old_phase, HashJoinPhase::EOS);
         }
     }
+    // must be called before prepare.
+    void add_reader(HashJoiner* reader) {
+        reader->_builder = this;
+        _readers.emplace_back(reader);
+    }
     // build phase
     Status append_chunk_to_ht(RuntimeState* state, const ChunkPtr& chunk);
     Status build_ht(RuntimeState* state);
     // probe phase
-    void push_chunk(RuntimeState* state, ChunkPtr&& chunk);
+    Status push_chunk(RuntimeState* state, ChunkPtr&& chunk);
     StatusOr<ChunkPtr> pull_chunk(RuntimeState* state);
 
 private:
@@ -151,9 +174,7 @@ private:
     Status _post_probe(RuntimeState* state) {
         DCHECK(_phase == HashJoinPhase::POST_PROBE);
         if (!_need_post_probe()) {
-            _phase = HashJoinPhase::EOS;
-            _ht.close();
-            return Status::OK();
+            return _finish_probe_partition(state);
         }
         DCHECK(!_probe_output_chunk);
         while (true) {
@@ -162,9 +183,7 @@ private:
             RETURN_IF_ERROR(_ht.probe_remain(&chunk, &has_remain));
             _merge_probe_output_chunk(state, std::move(chunk));
             if (!has_remain) {
-                _phase = HashJoinPhase::EOS;
-                _ht.close();
-                return Status::OK();
+                return _finish_probe_partition(state);
             }
             if (_probe_output_chunk) {
                 return Status::OK();
@@ -206,10 +225,28 @@ private:
 
     static std::string _get_join_type_str(TJoinOp::type join_type);
 
+    // grace hash join
+    bool _can_spill() const;
+    // Convert the columns to the layout of |row_desc|, the layout of spilled chunks must be the same
+    static ChunkPtr _normalize_spill_chunk(const ChunkPtr& chunk, const RowDescriptor& row_desc);
+    void _partition_chunk(const ChunkPtr& chunk, const std::vector<ExprContext*>& expr_ctxs);
+    // Spill the rows appended to _ht, and append the later build chunks to spill files directly.
+    Status _spill_build_rows(RuntimeState* state);
+    // For probe chunk, the rows of the first partition are not spilled but returned by |first_partition_chunk|.
+    Status _spill_chunk(const ChunkPtr& chunk, bool is_build, ChunkPtr* first_partition_chunk);
+    Status _load_spill_partition(RuntimeState* state, size_t partition);
+    // Called when the probe of current partition is done, enter into next spilled partition or EOS.
+    Status _finish_probe_partition(RuntimeState* state);
+
+    // Called by the builder when the hash table is built, the reader enters into PROBE phase.
+    void _share_build(const HashJoiner& builder);
+    void _update_memory_usage_counters();
+
     TJoinOp::type _join_type = TJoinOp::INNER_JOIN;
     const int64_t _limit; // -1: no limit
     int64_t _num_rows_returned;
     std::atomic<HashJoinPhase> _phase = HashJoinPhase::BUILD;
+    pipeline::PipelineObservable _observable;
     std::shared_ptr<RuntimeProfile> _runtime_profile;
     bool _is_closed = false;
 
@@ -236,6 +273,22 @@ private:
     bool _is_push_down = false;
 
     JoinHashTable _ht;
+    // _builder is set for the readers, and _readers is set for the builder.
+    HashJoiner* _builder = nullptr;
+    std::vector<HashJoiner*> _readers;
+
+    bool _enable_spill = false;
+    bool _is_spilled = false;
+    // The build_ht may fail because of spilling, the error is returned by probe
+    Status _build_status;
+    size_t _spill_partition = 0;
+    std::vector<SpillFilePtr> _build_spill_files;
+    // _probe_spill_files[0] is always nullptr, the probe rows of the first partition are never spilled.
+    std::vector<SpillFilePtr> _probe_spill_files;
+    ChunkUniquePtr _build_spill_template;
+    ChunkUniquePtr _probe_spill_template;
+    std::vector<uint32_t> _spill_hashes;
+    std::vector<std::vector<uint32_t>> _spill_partition_rows;
 
     Columns _key_columns;
     size_t _probe_column_count = 0;
@@ -255,12 +308,19 @@ private:
     RuntimeProfile::Counter* _merge_input_chunk_timer = nullptr;
     RuntimeProfile::Counter* _probe_timer = nullptr;
     RuntimeProfile::Counter* _search_ht_timer = nullptr;
+    RuntimeProfile::Counter* _search_ht_hash_timer = nullptr;
+    RuntimeProfile::Counter* _search_ht_prefetch_timer = nullptr;
+    RuntimeProfile::Counter* _search_ht_match_timer = nullptr;
     RuntimeProfile::Counter* _output_build_column_timer = nullptr;
     RuntimeProfile::Counter* _output_probe_column_timer = nullptr;
     RuntimeProfile::Counter* _output_tuple_column_timer = nullptr;
     RuntimeProfile::Counter* _build_rows_counter = nullptr;
     RuntimeProfile::Counter* _probe_rows_counter = nullptr;
     RuntimeProfile::Counter* _build_buckets_counter = nullptr;
+    // The memory of the hash table built, the readers sharing the hash table don't report it.
+    RuntimeProfile::HighWaterMarkCounter* _bucket_memory_usage = nullptr;
+    RuntimeProfile::HighWaterMarkCounter* _key_memory_usage = nullptr;
+    RuntimeProfile::HighWaterMarkCounter* _build_chunk_memory_usage = nullptr;
     RuntimeProfile::Counter* _push_down_expr_num = nullptr;
     RuntimeProfile::Counter* _avg_input_probe_chunk_size = nullptr;
     RuntimeProfile::Counter* _avg_output_chunk_size = nullptr;
@@ -268,6 +328,10 @@ private:
     RuntimeProfile::Counter* _probe_conjunct_evaluate_timer = nullptr;
     RuntimeProfile::Counter* _other_join_conjunct_evaluate_timer = nullptr;
     RuntimeProfile::Counter* _where_conjunct_evaluate_timer = nullptr;
+    RuntimeProfile::Counter* _spill_timer = nullptr;
+    RuntimeProfile::Counter* _spill_build_rows_counter = nullptr;
+    RuntimeProfile::Counter* _spill_probe_rows_counter = nullptr;
+    RuntimeProfile::Counter* _spill_bytes_counter = nullptr;
 };
 
 } // namespace vectorized
@@ -0,0 +1,317 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/hdfs_block_cache.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/config.h"
+#include "common/logging.h"
+#include "gutil/strings/split.h"
+#include "gutil/strings/substitute.h"
+#include "util/crc32c.h"
+#include "util/hash_util.hpp"
+#include "util/starrocks_metrics.h"
+#include "util/threadpool.h"
+
+namespace starrocks::vectorized {
+
+HdfsBlockCache::HdfsBlockCache(std::vector<std::string> paths, size_t capacity, size_t block_size)
+        : _paths(std::move(paths)), _capacity(capacity), _block_size(block_size) {
+    _doorkeeper_size = std::max<size_t>(1024, capacity / block_size);
+    _doorkeeper.reset(new std::atomic<uint64_t>[_doorkeeper_size]);
+    for (size_t i = 0; i < _doorkeeper_size; i++) {
+        _doorkeeper[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+HdfsBlockCache::~HdfsBlockCache() {
+    if (_populate_pool != nullptr) {
+        _populate_pool->shutdown();
+    }
+}
+
+Status HdfsBlockCache::init() {
+    Env* env = Env::Default();
+    for (const auto& path : _paths) {
+        RETURN_IF_ERROR(env->create_dir_if_missing(path));
+        std::vector<std::string> children;
+        RETURN_IF_ERROR(env->get_children(path, &children));
+        for (const auto& child : children) {
+            if (child == "." || child == "..") {
+                continue;
+            }
+            RETURN_IF_ERROR(env->delete_file(path + "/" + child));
+        }
+    }
+    // the blocks waiting to be written are held in memory, so the queue is bounded.
+    return ThreadPoolBuilder("hdfs_block_cache_populate")
+            .set_min_threads(1)
+            .set_max_threads(std::max(1, config::hdfs_block_cache_populate_threads))
+            .set_max_queue_size(64)
+            .build(&_populate_pool);
+}
+
+HdfsBlockCache* HdfsBlockCache::instance() {
+    static HdfsBlockCache* s_instance = []() -> HdfsBlockCache* {
+        std::vector<std::string> paths =
+                strings::Split(config::hdfs_block_cache_paths, ";", strings::SkipWhitespace());
+        if (paths.empty() || config::hdfs_block_cache_capacity <= 0 || config::hdfs_block_cache_block_size <= 0) {
+            return nullptr;
+        }
+        auto* cache = new HdfsBlockCache(std::move(paths), config::hdfs_block_cache_capacity,
+                                         config::hdfs_block_cache_block_size);
+        Status st = cache->init();
+        if (!st.ok()) {
+            LOG(WARNING) << "Fail to init hdfs block cache, the cache is disabled: " << st.to_string();
+            delete cache;
+            return nullptr;
+        }
+        return cache;
+    }();
+    return s_instance;
+}
+
+std::string HdfsBlockCache::make_file_key(const std::string& path, int64_t file_size, int64_t mtime) {
+    std::string key(path);
+    // the path may be a prefix of another one
+    key.push_back('\0');
+    key.append((const char*)&file_size, sizeof(file_size));
+    key.append((const char*)&mtime, sizeof(mtime));
+    return key;
+}
+
+std::string HdfsBlockCache::_block_key(const std::string& file_key, int64_t block_index) {
+    std::string key(file_key);
+    key.append((const char*)&block_index, sizeof(block_index));
+    return key;
+}
+
+Status HdfsBlockCache::read(const std::string& file_key, int64_t block_index, size_t offset, const Slice& res) {
+    std::string key = _block_key(file_key, block_index);
+    std::string path;
+    size_t size = 0;
+    std::vector<uint32_t> checksums;
+    {
+        std::lock_guard<std::mutex> lg(_lock);
+        auto it = _blocks.find(key);
+        if (it == _blocks.end()) {
+            return Status::NotFound("");
+        }
+        _lru.splice(_lru.begin(), _lru, it->second.lru_pos);
+        path = it->second.path;
+        size = it->second.size;
+        checksums = it->second.checksums;
+    }
+    if (offset + res.size > size) {
+        return Status::InternalError(strings::Substitute("read out of the cached block, offset=$0, size=$1, block=$2",
+                                                         offset, res.size, size));
+    }
+
+    // read the checksum units covering the range
+    size_t first_unit = offset / kChecksumUnitSize;
+    size_t last_unit = (offset + res.size - 1) / kChecksumUnitSize;
+    size_t start = first_unit * kChecksumUnitSize;
+    size_t end = std::min(size, (last_unit + 1) * kChecksumUnitSize);
+    std::unique_ptr<RandomAccessFile> file;
+    Status st = Env::Default()->new_random_access_file(path, &file);
+    std::string buf(end - start, '\0');
+    if (st.ok()) {
+        st = file->read_at(start, Slice(buf.data(), buf.size()));
+    }
+    for (size_t unit = first_unit; st.ok() && unit <= last_unit; unit++) {
+        size_t unit_start = unit * kChecksumUnitSize - start;
+        size_t unit_size = std::min(kChecksumUnitSize, buf.size() - unit_start);
+        if (crc32c::Value(buf.data() + unit_start, unit_size) != checksums[unit]) {
+            StarRocksMetrics::instance()->hdfs_block_cache_checksum_failed_total.increment(1);
+            st = Status::Corruption(strings::Substitute("checksum mismatch of the cached block $0", path));
+        }
+    }
+    if (!st.ok()) {
+        LOG(WARNING) << "Fail to read the cached block, remove it: " << st.to_string();
+        _erase(key);
+        return st;
+    }
+    memcpy(res.data, buf.data() + (offset - start), res.size);
+    return Status::OK();
+}
+
+bool HdfsBlockCache::admit(const std::string& file_key, int64_t block_index) {
+    std::string key = _block_key(file_key, block_index);
+    // 0 marks the empty slot.
+    uint64_t hash = HashUtil::hash64(key.data(), key.size(), 0) | 1;
+    std::atomic<uint64_t>& slot = _doorkeeper[hash % _doorkeeper_size];
+    if (slot.load(std::memory_order_relaxed) == hash) {
+        slot.store(0, std::memory_order_relaxed);
+        return true;
+    }
+    slot.store(hash, std::memory_order_relaxed);
+    return false;
+}
+
+void HdfsBlockCache::populate(const std::string& file_key, int64_t block_index, std::string data) {
+    std::string key = _block_key(file_key, block_index);
+    {
+        std::lock_guard<std::mutex> lg(_lock);
+        if (_blocks.count(key) > 0 || !_populating.insert(key).second) {
+            return;
+        }
+    }
+    auto task = [this, key, data = std::move(data)]() { _write_block(key, data); };
+    Status st = _populate_pool->submit_func(std::move(task));
+    if (!st.ok()) {
+        // the queue is full, drop the block
+        std::lock_guard<std::mutex> lg(_lock);
+        _populating.erase(key);
+    }
+}
+
+void HdfsBlockCache::_write_block(const std::string& key, const std::string& data) {
+    uint64_t hash = HashUtil::hash64(key.data(), key.size(), 0);
+    std::string path = strings::Substitute("$0/$1", _paths[hash % _paths.size()],
+                                           _next_block_id.fetch_add(1, std::memory_order_relaxed));
+    Block block;
+    block.path = path;
+    block.size = data.size();
+    for (size_t offset = 0; offset < data.size(); offset += kChecksumUnitSize) {
+        block.checksums.push_back(
+                crc32c::Value(data.data() + offset, std::min(kChecksumUnitSize, data.size() - offset)));
+    }
+
+    std::unique_ptr<WritableFile> file;
+    Status st = Env::Default()->new_writable_file(path, &file);
+    if (st.ok()) {
+        st = file->append(Slice(data));
+    }
+    if (st.ok()) {
+        st = file->close();
+    }
+
+    std::vector<std::string> evicted;
+    {
+        std::lock_guard<std::mutex> lg(_lock);
+        _populating.erase(key);
+        if (st.ok()) {
+            _lru.push_front(key);
+            block.lru_pos = _lru.begin();
+            _usage += block.size;
+            _blocks.emplace(key, std::move(block));
+            _evict(&evicted);
+        }
+    }
+    if (!st.ok()) {
+        LOG(WARNING) << "Fail to write the cached block " << path << ": " << st.to_string();
+        evicted.push_back(path);
+    } else {
+        StarRocksMetrics::instance()->hdfs_block_cache_write_total.increment(1);
+    }
+    for (const auto& p : evicted) {
+        (void)Env::Default()->delete_file(p);
+    }
+}
+
+void HdfsBlockCache::_erase(const std::string& key) {
+    std::string path;
+    {
+        std::lock_guard<std::mutex> lg(_lock);
+        auto it = _blocks.find(key);
+        if (it == _blocks.end()) {
+            return;
+        }
+        path = std::move(it->second.path);
+        _usage -= it->second.size;
+        _lru.erase(it->second.lru_pos);
+        _blocks.erase(it);
+        StarRocksMetrics::instance()->hdfs_block_cache_usage_bytes.set_value(_usage);
+    }
+    (void)Env::Default()->delete_file(path);
+}
+
+void HdfsBlockCache::_evict(std::vector<std::string>* paths) {
+    while (_usage > _capacity && !_lru.empty()) {
+        auto it = _blocks.find(_lru.back());
+        _usage -= it->second.size;
+        paths->push_back(std::move(it->second.path));
+        _blocks.erase(it);
+        _lru.pop_back();
+    }
+    StarRocksMetrics::instance()->hdfs_block_cache_usage_bytes.set_value(_usage);
+}
+
+void HdfsBlockCache::wait() {
+    _populate_pool->wait();
+}
+
+size_t HdfsBlockCache::usage() const {
+    std::lock_guard<std::mutex> lg(_lock);
+    return _usage;
+}
+
+Status CachedRandomAccessFile::read(uint64_t offset, Slice* res) const {
+    if (offset >= _file_size) {
+        res->size = 0;
+        return Status::OK();
+    }
+    res->size = std::min<uint64_t>(res->size, _file_size - offset);
+    return read_at(offset, *res);
+}
+
+Status CachedRandomAccessFile::read_at(uint64_t offset, const Slice& res) const {
+    if (offset + res.size > _file_size) {
+        return Status::InternalError(strings::Substitute("read out of file, file=$0, offset=$1, size=$2, file_size=$3",
+                                                         file_name(), offset, res.size, _file_size));
+    }
+    const uint64_t block_size = _cache->block_size();
+    const uint64_t end = offset + res.size;
+    // the range missed and not admitted, read from the remote file by one read
+    uint64_t pending_start = offset;
+    uint64_t pending_end = offset;
+    auto flush_pending = [&]() -> Status {
+        if (pending_end > pending_start) {
+            RETURN_IF_ERROR(_file->read_at(pending_start,
+                                           Slice(res.data + (pending_start - offset), pending_end - pending_start)));
+        }
+        return Status::OK();
+    };
+
+    uint64_t pos = offset;
+    while (pos < end) {
+        int64_t block_index = pos / block_size;
+        uint64_t block_start = block_index * block_size;
+        uint64_t block_end = std::min<uint64_t>(block_start + block_size, _file_size);
+        uint64_t read_end = std::min(end, block_end);
+        Slice dst(res.data + (pos - offset), read_end - pos);
+
+        Status st = _cache->read(_file_key, block_index, pos - block_start, dst);
+        if (st.ok()) {
+            StarRocksMetrics::instance()->hdfs_block_cache_hit_total.increment(1);
+            StarRocksMetrics::instance()->hdfs_block_cache_hit_bytes.increment(dst.size);
+            RETURN_IF_ERROR(flush_pending());
+            pending_start = pending_end = read_end;
+        } else {
+            StarRocksMetrics::instance()->hdfs_block_cache_miss_total.increment(1);
+            if (_cache->admit(_file_key, block_index)) {
+                RETURN_IF_ERROR(flush_pending());
+                pending_start = pending_end = read_end;
+                std::string block(block_end - block_start, '\0');
+                RETURN_IF_ERROR(_file->read_at(block_start, Slice(block.data(), block.size())));
+                memcpy(dst.data, block.data() + (pos - block_start), dst.size);
+                _cache->populate(_file_key, block_index, std::move(block));
+            } else {
+                pending_end = read_end;
+            }
+        }
+        pos = read_end;
+    }
+    return flush_pending();
+}
+
+Status CachedRandomAccessFile::readv_at(uint64_t offset, const Slice* res, size_t res_cnt) const {
+    for (size_t i = 0; i < res_cnt; i++) {
+        RETURN_IF_ERROR(read_at(offset, res[i]));
+        offset += res[i].size;
+    }
+    return Status::OK();
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,125 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "env/env.h"
+
+namespace starrocks {
+class ThreadPool;
+}
+
+namespace starrocks::vectorized {
+
+// A cache of the blocks of the remote hdfs and object storage files on the local disks, so that the
+// repeated scans of the same files don't pay the network cost again.
+// The files are split into the blocks of |block_size|, and every cached block is a file under one of
+// the |paths|, checksummed by every kChecksumUnitSize bytes. A block missed is only admitted on its
+// second miss within a short history, and is written by the background threads, the least recently
+// used blocks are removed once the cached blocks use more than |capacity| bytes.
+// The index of the blocks is kept in memory, the cached blocks are removed on start.
+class HdfsBlockCache {
+public:
+    static constexpr size_t kChecksumUnitSize = 64 * 1024;
+
+    HdfsBlockCache(std::vector<std::string> paths, size_t capacity, size_t block_size);
+    ~HdfsBlockCache();
+
+    // Create the cache dirs and remove the blocks cached by the previous run.
+    Status init();
+
+    // Return the global instance, or null if hdfs_block_cache_paths is empty or the cache fails to init.
+    static HdfsBlockCache* instance();
+
+    // |mtime| is -1 if the modification time of the file is unknown.
+    static std::string make_file_key(const std::string& path, int64_t file_size, int64_t mtime);
+
+    size_t block_size() const { return _block_size; }
+
+    // Copy |res.size| bytes at |offset| of the block from the cache.
+    // Return NotFound if the block is not cached, or Corruption if the checksum mismatches.
+    Status read(const std::string& file_key, int64_t block_index, size_t offset, const Slice& res);
+
+    // Whether the block missed should be written into the cache.
+    bool admit(const std::string& file_key, int64_t block_index);
+
+    // Write the block into the cache in the background.
+    void populate(const std::string& file_key, int64_t block_index, std::string data);
+
+    // Wait for the blocks being written.
+    void wait();
+
+    size_t usage() const;
+
+private:
+    struct Block {
+        std::string path;
+        size_t size = 0;
+        std::vector<uint32_t> checksums;
+        std::list<std::string>::iterator lru_pos;
+    };
+
+    static std::string _block_key(const std::string& file_key, int64_t block_index);
+
+    void _write_block(const std::string& key, const std::string& data);
+    void _erase(const std::string& key);
+    // requires |_lock|, the paths of the blocks removed are appended to |paths|.
+    void _evict(std::vector<std::string>* paths);
+
+    const std::vector<std::string> _paths;
+    const size_t _capacity;
+    const size_t _block_size;
+
+    std::unique_ptr<ThreadPool> _populate_pool;
+    std::atomic<uint64_t> _next_block_id{0};
+
+    mutable std::mutex _lock;
+    std::unordered_map<std::string, Block> _blocks;
+    // the most recently used at the front.
+    std::list<std::string> _lru;
+    size_t _usage = 0;
+    // the blocks being written.
+    std::unordered_set<std::string> _populating;
+
+    // the hashes of the blocks missed recently, a slot is overwritten by the later miss mapped to it.
+    std::unique_ptr<std::atomic<uint64_t>[]> _doorkeeper;
+    size_t _doorkeeper_size = 0;
+};
+
+// A RandomAccessFile reading the remote file through the HdfsBlockCache.
+class CachedRandomAccessFile final : public RandomAccessFile {
+public:
+    CachedRandomAccessFile(std::shared_ptr<RandomAccessFile> file, HdfsBlockCache* cache, std::string file_key,
+                           int64_t file_size)
+            : _file(std::move(file)), _cache(cache), _file_key(std::move(file_key)), _file_size(file_size) {}
+    ~CachedRandomAccessFile() override = default;
+
+    Status read(uint64_t offset, Slice* res) const override;
+
+    Status read_at(uint64_t offset, const Slice& res) const override;
+
+    Status readv_at(uint64_t offset, const Slice* res, size_t res_cnt) const override;
+
+    Status size(uint64_t* size) const override {
+        *size = _file_size;
+        return Status::OK();
+    }
+
+    const std::string& file_name() const override { return _file->file_name(); }
+
+private:
+    std::shared_ptr<RandomAccessFile> _file;
+    HdfsBlockCache* _cache;
+    std::string _file_key;
+    int64_t _file_size;
+};
+
+} // namespace starrocks::vectorized
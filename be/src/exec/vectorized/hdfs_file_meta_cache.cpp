@@ -0,0 +1,51 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/hdfs_file_meta_cache.h"
+
+#include "common/config.h"
+#include "storage/lru_cache.h"
+
+namespace starrocks::vectorized {
+
+HdfsFileMetaCache::HdfsFileMetaCache(size_t capacity) : _cache(new_lru_cache(capacity)) {}
+
+HdfsFileMetaCache::~HdfsFileMetaCache() = default;
+
+HdfsFileMetaCache* HdfsFileMetaCache::instance() {
+    static HdfsFileMetaCache* s_instance = config::hdfs_file_meta_cache_capacity > 0
+                                                   ? new HdfsFileMetaCache(config::hdfs_file_meta_cache_capacity)
+                                                   : nullptr;
+    return s_instance;
+}
+
+std::string HdfsFileMetaCache::make_key(const std::string& format, const std::string& path, int64_t file_size,
+                                        int64_t mtime) {
+    std::string key;
+    key.reserve(format.size() + path.size() + 1 + sizeof(file_size) + sizeof(mtime));
+    key.append(format);
+    key.append(path);
+    // the path may be a prefix of another one
+    key.push_back('\0');
+    key.append((const char*)&file_size, sizeof(file_size));
+    key.append((const char*)&mtime, sizeof(mtime));
+    return key;
+}
+
+std::shared_ptr<void> HdfsFileMetaCache::_lookup(const std::string& key) {
+    Cache::Handle* handle = _cache->lookup(CacheKey(key));
+    if (handle == nullptr) {
+        return nullptr;
+    }
+    std::shared_ptr<void> value = *reinterpret_cast<std::shared_ptr<void>*>(_cache->value(handle));
+    _cache->release(handle);
+    return value;
+}
+
+void HdfsFileMetaCache::insert(const std::string& key, std::shared_ptr<void> value, size_t charge) {
+    auto deleter = [](const CacheKey& key, void* value) { delete reinterpret_cast<std::shared_ptr<void>*>(value); };
+    auto* holder = new std::shared_ptr<void>(std::move(value));
+    Cache::Handle* handle = _cache->insert(CacheKey(key), holder, charge, deleter);
+    _cache->release(handle);
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,44 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+namespace starrocks {
+class Cache;
+}
+
+namespace starrocks::vectorized {
+
+// A per-BE LRU cache of the parsed footers of the parquet and orc files, shared by all of the hdfs scanners,
+// so that the scan ranges of a file don't read and parse the same footer again. Besides the path, the key
+// contains the size and the modification time of the file, a rewritten file is looked up by a new key.
+class HdfsFileMetaCache {
+public:
+    explicit HdfsFileMetaCache(size_t capacity);
+    ~HdfsFileMetaCache();
+
+    // Return the global instance, or null if hdfs_file_meta_cache_capacity is 0.
+    static HdfsFileMetaCache* instance();
+
+    // |mtime| is -1 if the modification time of the file is unknown.
+    static std::string make_key(const std::string& format, const std::string& path, int64_t file_size,
+                                int64_t mtime);
+
+    // Return the value cached by |key|, or null.
+    template <typename T>
+    std::shared_ptr<T> lookup(const std::string& key) {
+        return std::static_pointer_cast<T>(_lookup(key));
+    }
+
+    // |charge| is usually the size of the serialized footer.
+    void insert(const std::string& key, std::shared_ptr<void> value, size_t charge);
+
+private:
+    std::shared_ptr<void> _lookup(const std::string& key);
+
+    std::unique_ptr<Cache> _cache;
+};
+
+} // namespace starrocks::vectorized
@@ -5,6 +5,7 @@
 #include <memory>
 
 #include "env/env_hdfs.h"
+#include "exec/vectorized/hdfs_block_cache.h"
 #include "exprs/expr.h"
 #include "exprs/expr_context.h"
 #include "exprs/vectorized/runtime_filter.h"
@@ -174,6 +175,7 @@ Status HdfsScanNode::_create_and_init_scanner(RuntimeState* state, const HdfsFil
     scanner_params.runtime_filter_collector = &_runtime_filter_collector;
     scanner_params.scan_ranges = hdfs_file_desc.splits;
     scanner_params.fs = hdfs_file_desc.fs;
+    scanner_params.hdfs_file = hdfs_file_desc.hdfs_file;
     scanner_params.tuple_desc = _tuple_desc;
     scanner_params.materialize_slots = _materialize_slots;
     scanner_params.materialize_index_in_chunk = _materialize_index_in_chunk;
@@ -558,6 +560,14 @@ Status HdfsScanNode::_find_and_insert_hdfs_file(const THdfsScanRange& scan_range
         hdfs_file_desc->hdfs_fs = hdfs;
         hdfs_file_desc->hdfs_file = file;
         hdfs_file_desc->fs = std::make_shared<HdfsRandomAccessFile>(hdfs, file, native_file_path);
+        HdfsBlockCache* block_cache = HdfsBlockCache::instance();
+        if (block_cache != nullptr) {
+            int64_t mtime = scan_range.__isset.modification_time ? scan_range.modification_time : -1;
+            hdfs_file_desc->fs = std::make_shared<CachedRandomAccessFile>(
+                    hdfs_file_desc->fs, block_cache,
+                    HdfsBlockCache::make_file_key(native_file_path, scan_range.file_length, mtime),
+                    scan_range.file_length);
+        }
         hdfs_file_desc->partition_id = scan_range.partition_id;
         hdfs_file_desc->path = scan_range.relative_path;
         hdfs_file_desc->file_length = scan_range.file_length;
@@ -632,6 +642,18 @@ void HdfsScanNode::_init_counter(RuntimeState* state) {
     // reader init
     _footer_read_timer = ADD_TIMER(_runtime_profile, "ReaderInitFooterRead");
     _column_reader_init_timer = ADD_TIMER(_runtime_profile, "ReaderInitColumnReaderInit");
+    _page_index_read_timer = ADD_TIMER(_runtime_profile, "ReaderInitPageIndexRead");
+    _footer_cache_hit_counter = ADD_COUNTER(_runtime_profile, "ReaderInitFooterCacheHit", TUnit::UNIT);
+
+    // io coalescing
+    _coalesced_io_counter = ADD_COUNTER(_runtime_profile, "CoalescedIoCounter", TUnit::UNIT);
+    _coalesced_io_bytes_counter = ADD_COUNTER(_runtime_profile, "CoalescedIoBytes", TUnit::BYTES);
+
+    // page index
+    _page_skip_counter = ADD_COUNTER(_runtime_profile, "PageIndexSkipRows", TUnit::UNIT);
+
+    // late materialization
+    _lazy_skip_counter = ADD_COUNTER(_runtime_profile, "LateMaterializeSkipRows", TUnit::UNIT);
 
     // dict filter
     _group_chunk_read_timer = ADD_TIMER(_runtime_profile, "GroupChunkRead");
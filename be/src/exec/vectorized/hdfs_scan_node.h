@@ -176,6 +176,18 @@ private:
     // reader init
     RuntimeProfile::Counter* _footer_read_timer = nullptr;
     RuntimeProfile::Counter* _column_reader_init_timer = nullptr;
+    RuntimeProfile::Counter* _page_index_read_timer = nullptr;
+    RuntimeProfile::Counter* _footer_cache_hit_counter = nullptr;
+
+    // io coalescing
+    RuntimeProfile::Counter* _coalesced_io_counter = nullptr;
+    RuntimeProfile::Counter* _coalesced_io_bytes_counter = nullptr;
+
+    // page index
+    RuntimeProfile::Counter* _page_skip_counter = nullptr;
+
+    // late materialization
+    RuntimeProfile::Counter* _lazy_skip_counter = nullptr;
 
     // dict filter
     RuntimeProfile::Counter* _group_chunk_read_timer = nullptr;
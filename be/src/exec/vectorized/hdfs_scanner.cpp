@@ -169,11 +169,10 @@ static void get_hdfs_statistics(hdfsFile file, HdfsReadStats* stats) {
 void HdfsScanner::update_counter() {
 #ifndef BE_TEST
     HdfsReadStats hdfs_stats;
-    auto hdfs_file = down_cast<HdfsRandomAccessFile*>(_scanner_params.fs.get())->hdfs_file();
     // Hdfslib only supports obtaining statistics of hdfs file system.
     // For other systems such as s3, calling this function will cause be crash.
-    if (_scanner_params.parent->_is_hdfs_fs) {
-        get_hdfs_statistics(hdfs_file, &hdfs_stats);
+    if (_scanner_params.parent->_is_hdfs_fs && _scanner_params.hdfs_file != nullptr) {
+        get_hdfs_statistics(_scanner_params.hdfs_file, &hdfs_stats);
     }
 
     COUNTER_UPDATE(_scanner_params.parent->_bytes_total_read, hdfs_stats.bytes_total_read);
@@ -223,6 +222,12 @@ void HdfsParquetScanner::update_counter() {
     COUNTER_UPDATE(_scanner_params.parent->_page_read_timer, _stats.page_read_ns);
     COUNTER_UPDATE(_scanner_params.parent->_footer_read_timer, _stats.footer_read_ns);
     COUNTER_UPDATE(_scanner_params.parent->_column_reader_init_timer, _stats.column_reader_init_ns);
+    COUNTER_UPDATE(_scanner_params.parent->_page_index_read_timer, _stats.page_index_read_ns);
+    COUNTER_UPDATE(_scanner_params.parent->_footer_cache_hit_counter, _stats.footer_cache_hit);
+    COUNTER_UPDATE(_scanner_params.parent->_coalesced_io_counter, _stats.coalesced_io_count);
+    COUNTER_UPDATE(_scanner_params.parent->_coalesced_io_bytes_counter, _stats.coalesced_io_bytes);
+    COUNTER_UPDATE(_scanner_params.parent->_page_skip_counter, _stats.page_skip_rows);
+    COUNTER_UPDATE(_scanner_params.parent->_lazy_skip_counter, _stats.lazy_skip_rows);
     COUNTER_UPDATE(_scanner_params.parent->_group_chunk_read_timer, _stats.group_chunk_read_ns);
     COUNTER_UPDATE(_scanner_params.parent->_group_dict_filter_timer, _stats.group_dict_filter_ns);
     COUNTER_UPDATE(_scanner_params.parent->_group_dict_decode_timer, _stats.group_dict_decode_ns);
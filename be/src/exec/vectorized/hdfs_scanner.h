@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <hdfs/hdfs.h>
+
 #include <utility>
 
 #include "column/chunk.h"
@@ -31,6 +33,15 @@ struct HdfsScanStats {
     // reader init
     int64_t footer_read_ns = 0;
     int64_t column_reader_init_ns = 0;
+    int64_t page_index_read_ns = 0;
+    int64_t footer_cache_hit = 0;
+    // io coalescing
+    int64_t coalesced_io_count = 0;
+    int64_t coalesced_io_bytes = 0;
+    // page index
+    int64_t page_skip_rows = 0;
+    // late materialization
+    int64_t lazy_skip_rows = 0;
     // dict filter
     int64_t group_chunk_read_ns = 0;
     int64_t group_dict_filter_ns = 0;
@@ -52,6 +63,8 @@ struct HdfsScannerParams {
 
     // file fd (local file or hdfs file)
     std::shared_ptr<RandomAccessFile> fs = nullptr;
+    // the hdfs file read by fs, null for the local file
+    hdfsFile hdfs_file = nullptr;
 
     const TupleDescriptor* tuple_desc;
 
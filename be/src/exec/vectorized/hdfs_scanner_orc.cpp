@@ -4,7 +4,10 @@
 
 #include <utility>
 
+#include "common/config.h"
 #include "env/env.h"
+#include "exec/vectorized/coalesced_random_access_file.h"
+#include "exec/vectorized/hdfs_file_meta_cache.h"
 #include "exec/vectorized/hdfs_scan_node.h"
 #include "gen_cpp/orc_proto.pb.h"
 #include "storage/vectorized/chunk_helper.h"
@@ -14,7 +17,7 @@ namespace starrocks::vectorized {
 class ORCHdfsFileStream : public orc::InputStream {
 public:
     ORCHdfsFileStream(std::shared_ptr<RandomAccessFile> file, uint64_t length, HdfsScanStats* stats)
-            : _file(std::move(file)), _length(length), _stats(stats) {}
+            : _file(std::move(file)), _coalesced_file(_file.get(), stats), _length(length), _stats(stats) {}
 
     ~ORCHdfsFileStream() override = default;
 
@@ -29,7 +32,8 @@ public:
             throw orc::ParseError("Buffer is null");
         }
 
-        Status status = _file->read_at(offset, Slice((char*)buf, length));
+        _enter_stripe(offset);
+        Status status = _coalesced_file.read_at(offset, Slice((char*)buf, length));
         if (!status.ok()) {
             auto msg = strings::Substitute("Failed to read $0: $1", _file->file_name(), status.to_string());
             throw orc::ParseError(msg);
@@ -39,10 +43,51 @@ public:
 
     const std::string& getName() const override { return _file->file_name(); }
 
+    // The streams of the stripe being read are merged into a few large reads, set before reading the stripes.
+    void set_stripes(const orc::Reader& reader) {
+        for (uint64_t i = 0; i < reader.getNumberOfStripes(); i++) {
+            auto stripe = reader.getStripe(i);
+            StripeRange range;
+            range.offset = stripe->getOffset();
+            range.index_length = stripe->getIndexLength();
+            range.data_length = stripe->getDataLength();
+            range.footer_length = stripe->getFooterLength();
+            _stripes.emplace(range.offset + range.index_length + range.data_length + range.footer_length, range);
+        }
+    }
+
 private:
+    struct StripeRange {
+        uint64_t offset = 0;
+        uint64_t index_length = 0;
+        uint64_t data_length = 0;
+        uint64_t footer_length = 0;
+    };
+
+    // the stripes are read one by one, the buffers of the previous stripe are released by the next one.
+    void _enter_stripe(uint64_t offset) {
+        // the first stripe whose end > offset
+        auto it = _stripes.upper_bound(offset);
+        if (it == _stripes.end() || offset < it->second.offset || it->first == _cur_stripe_end) {
+            return;
+        }
+        _cur_stripe_end = it->first;
+        const StripeRange& stripe = it->second;
+        std::vector<CoalescedRandomAccessFile::IORange> ranges;
+        ranges.emplace_back(stripe.offset, stripe.index_length);
+        ranges.emplace_back(stripe.offset + stripe.index_length, stripe.data_length);
+        ranges.emplace_back(stripe.offset + stripe.index_length + stripe.data_length, stripe.footer_length);
+        _coalesced_file.set_io_ranges(std::move(ranges), config::hdfs_io_coalesce_max_gap,
+                                      config::hdfs_io_coalesce_max_buffer_size);
+    }
+
     std::shared_ptr<RandomAccessFile> _file;
+    CoalescedRandomAccessFile _coalesced_file;
     uint64_t _length;
     HdfsScanStats* _stats;
+    // key: end of stripe.
+    std::map<uint64_t, StripeRange> _stripes;
+    uint64_t _cur_stripe_end = 0;
 };
 
 class OrcRowReaderFilter : public orc::RowReaderFilter {
@@ -298,6 +343,9 @@ void HdfsOrcScanner::update_counter() {
     COUNTER_UPDATE(_scanner_params.parent->_column_convert_timer, _stats.column_convert_ns);
     COUNTER_UPDATE(_scanner_params.parent->_value_decode_timer, _stats.value_decode_ns);
     COUNTER_UPDATE(_scanner_params.parent->_level_decode_timer, _stats.level_decode_ns);
+    COUNTER_UPDATE(_scanner_params.parent->_footer_cache_hit_counter, _stats.footer_cache_hit);
+    COUNTER_UPDATE(_scanner_params.parent->_coalesced_io_counter, _stats.coalesced_io_count);
+    COUNTER_UPDATE(_scanner_params.parent->_coalesced_io_bytes_counter, _stats.coalesced_io_bytes);
 #endif
 }
 
@@ -307,17 +355,42 @@ Status HdfsParquetScanner::do_close(RuntimeState* runtime_state) {
 }
 
 Status HdfsOrcScanner::do_open(RuntimeState* runtime_state) {
-    auto input_stream = std::make_unique<ORCHdfsFileStream>(_scanner_params.fs,
-                                                            _scanner_params.scan_ranges[0]->file_length, &_stats);
+    const THdfsScanRange* scan_range = _scanner_params.scan_ranges[0];
+    auto input_stream = std::make_unique<ORCHdfsFileStream>(_scanner_params.fs, scan_range->file_length, &_stats);
+    ORCHdfsFileStream* orc_hdfs_file_stream = input_stream.get();
+
+    HdfsFileMetaCache* meta_cache = HdfsFileMetaCache::instance();
+    std::string cache_key;
+    std::shared_ptr<std::string> file_tail;
+    if (meta_cache != nullptr) {
+        cache_key = HdfsFileMetaCache::make_key(
+                "orc", _scanner_params.fs->file_name(), scan_range->file_length,
+                scan_range->__isset.modification_time ? scan_range->modification_time : -1);
+        file_tail = meta_cache->lookup<std::string>(cache_key);
+        if (file_tail != nullptr) {
+            _stats.footer_cache_hit += 1;
+        }
+    }
+
     std::unique_ptr<orc::Reader> reader;
     try {
         orc::ReaderOptions options;
+        if (file_tail != nullptr) {
+            options.setSerializedFileTail(*file_tail);
+        }
         reader = orc::createReader(std::move(input_stream), options);
+        if (meta_cache != nullptr && file_tail == nullptr) {
+            file_tail = std::make_shared<std::string>(reader->getSerializedFileTail());
+            meta_cache->insert(cache_key, file_tail, file_tail->size());
+        }
     } catch (std::exception& e) {
         auto s = strings::Substitute("HdfsOrcScanner::do_open failed. reason = $0", e.what());
         LOG(WARNING) << s;
         return Status::InternalError(s);
     }
+    if (config::hdfs_io_coalesce_enable) {
+        orc_hdfs_file_stream->set_stripes(*reader);
+    }
 
     std::unordered_set<std::string> known_column_names;
     OrcScannerAdapter::build_column_name_set(&known_column_names, _scanner_params.hive_column_names, reader->getType());
@@ -9,6 +9,8 @@
 #include "column/column_helper.h"
 #include "column/type_traits.h"
 #include "exec/olap_common.h"
+#include "exec/pipeline/operator.h"
+#include "exec/vectorized/intersect_hash_set.h"
 #include "exprs/expr_context.h"
 #include "runtime/mem_pool.h"
 #include "runtime/mem_tracker.h"
@@ -24,161 +26,6 @@ class TupleDescriptor;
 
 namespace starrocks::vectorized {
 class IntersectNode : public ExecNode {
-    class SliceFlag {
-    public:
-        SliceFlag(const uint8_t* d, size_t n) : slice(d, n), hit_times(0) {}
-
-        Slice slice;
-        mutable uint16_t hit_times;
-    };
-
-    struct SliceFlagEqual {
-        bool operator()(const SliceFlag& x, const SliceFlag& y) const {
-            return memequal(x.slice.data, x.slice.size, y.slice.data, y.slice.size);
-        }
-    };
-
-    struct SliceFlagHash {
-        static const uint32_t CRC_SEED = 0x811C9DC5;
-        std::size_t operator()(const SliceFlag& sliceMayUnneed) const {
-            const Slice& slice = sliceMayUnneed.slice;
-            return crc_hash_64(slice.data, slice.size, CRC_SEED);
-        }
-    };
-
-    template <typename HashSet>
-    struct HashSetFromExprs {
-        using Iterator = typename HashSet::iterator;
-        using ResultVector = typename std::vector<Slice>;
-        std::unique_ptr<HashSet> hash_set;
-
-        HashSetFromExprs()
-                : hash_set(std::make_unique<HashSet>()),
-                  _mem_pool(std::make_unique<MemPool>()),
-                  _buffer(_mem_pool->allocate(_max_one_row_size * config::vector_chunk_size)) {}
-
-        Iterator begin() { return hash_set->begin(); }
-
-        Iterator end() { return hash_set->end(); }
-
-        void serialize_columns(const ChunkPtr& chunkPtr, const std::vector<ExprContext*>& exprs, size_t chunk_size,
-                               const std::function<void(const ColumnPtr&, int)>& get_type) {
-            const bool null = false;
-            for (size_t i = 0; i < exprs.size(); i++) {
-                ColumnPtr key_column = exprs[i]->evaluate(chunkPtr.get());
-                get_type(key_column, i);
-                if (key_column->is_nullable()) {
-                    key_column->serialize_batch(_buffer, _slice_sizes, chunk_size, _max_one_row_size);
-                } else {
-                    if (!key_column->is_constant()) {
-                        for (size_t j = 0; j < chunk_size; ++j) {
-                            memcpy(_buffer + j * _max_one_row_size + _slice_sizes[j], &null, sizeof(bool));
-                            _slice_sizes[j] += sizeof(bool);
-                            _slice_sizes[j] +=
-                                    key_column->serialize(j, _buffer + j * _max_one_row_size + _slice_sizes[j]);
-                        }
-                    } else {
-                        for (size_t j = 0; j < chunk_size; ++j) {
-                            memcpy(_buffer + j * _max_one_row_size + _slice_sizes[j], &null, sizeof(bool));
-                            _slice_sizes[j] += sizeof(bool);
-                            _slice_sizes[j] +=
-                                    key_column->serialize(0, _buffer + j * _max_one_row_size + _slice_sizes[j]);
-                        }
-                    }
-                }
-            }
-        }
-
-        Status build_set(RuntimeState* state, const ChunkPtr& chunkPtr, const std::vector<ExprContext*>& exprs,
-                         MemPool* pool, const std::function<void(const ColumnPtr&, int)>& get_type) {
-            size_t chunk_size = chunkPtr->num_rows();
-
-            _slice_sizes.assign(config::vector_chunk_size, 0);
-            size_t cur_max_one_row_size = get_max_serialize_size(chunkPtr, exprs);
-            if (UNLIKELY(cur_max_one_row_size > _max_one_row_size)) {
-                _max_one_row_size = cur_max_one_row_size;
-                _mem_pool->clear();
-                _buffer = _mem_pool->allocate(_max_one_row_size * config::vector_chunk_size);
-                if (UNLIKELY(_buffer == nullptr)) {
-                    return Status::InternalError("Mem usage has exceed the limit of BE");
-                }
-            }
-
-            serialize_columns(chunkPtr, exprs, chunk_size, get_type);
-
-            for (size_t i = 0; i < chunk_size; ++i) {
-                SliceFlag key(_buffer + i * _max_one_row_size, _slice_sizes[i]);
-                hash_set->lazy_emplace(key, [&](const auto& ctor) {
-                    // we must persist the slice before insert
-                    uint8_t* pos = pool->allocate(key.slice.size);
-                    memcpy(pos, key.slice.data, key.slice.size);
-                    ctor(pos, key.slice.size);
-                });
-            }
-            RETURN_IF_LIMIT_EXCEEDED(state, "Intersect, while build hash table.");
-            return Status::OK();
-        }
-
-        Status refine_intersect_row(RuntimeState* state, const ChunkPtr& chunkPtr,
-                                    const std::vector<ExprContext*>& exprs, int hit_times) {
-            size_t chunk_size = chunkPtr->num_rows();
-            _slice_sizes.assign(config::vector_chunk_size, 0);
-            size_t cur_max_one_row_size = get_max_serialize_size(chunkPtr, exprs);
-            if (UNLIKELY(cur_max_one_row_size > _max_one_row_size)) {
-                _max_one_row_size = cur_max_one_row_size;
-                _mem_pool->clear();
-                _buffer = _mem_pool->allocate(_max_one_row_size * config::vector_chunk_size);
-                if (UNLIKELY(_buffer == nullptr)) {
-                    return Status::InternalError("Mem usage has exceed the limit of BE");
-                }
-                RETURN_IF_LIMIT_EXCEEDED(state, "Intersect, while probe hash table.");
-            }
-
-            serialize_columns(chunkPtr, exprs, chunk_size, [](const ColumnPtr& column, int i) -> void {});
-
-            for (size_t i = 0; i < chunk_size; ++i) {
-                SliceFlag key(_buffer + i * _max_one_row_size, _slice_sizes[i]);
-                auto iter = hash_set->find(key);
-                if (iter != hash_set->end() && iter->hit_times == hit_times - 1) {
-                    iter->hit_times = hit_times;
-                }
-            }
-            return Status::OK();
-        }
-
-        size_t get_max_serialize_size(const ChunkPtr& chunkPtr, const std::vector<ExprContext*>& exprs) {
-            size_t max_size = 0;
-            for (auto* expr : exprs) {
-                ColumnPtr key_column = expr->evaluate(chunkPtr.get());
-                max_size += key_column->max_one_element_serialize_size();
-                if (!key_column->is_nullable()) {
-                    max_size += sizeof(bool);
-                }
-            }
-            return max_size;
-        }
-
-        void insert_keys_to_columns(ResultVector& keys, const Columns& key_columns, int32_t batch_size) {
-            for (const auto& key_column : key_columns) {
-                if (!key_column->is_nullable()) {
-                    for (auto& key : keys) {
-                        key.data += sizeof(bool);
-                    }
-                } else if (key_column->is_constant()) {
-                    continue;
-                }
-
-                key_column->deserialize_and_append_batch(keys, batch_size);
-            }
-        }
-
-        Buffer<uint32_t> _slice_sizes;
-        size_t _max_one_row_size = 8;
-        std::unique_ptr<MemPool> _mem_pool;
-        uint8_t* _buffer;
-        ResultVector _results;
-    };
-
 public:
     IntersectNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs);
 
@@ -189,6 +36,8 @@ public:
     Status get_next(RuntimeState* state, ChunkPtr* row_batch, bool* eos) override;
     Status close(RuntimeState* state) override;
 
+    pipeline::OpFactories decompose_to_pipeline(pipeline::PipelineBuilderContext* context) override;
+
 private:
     /// Tuple id resolved in Prepare() to set tuple_desc_;
     const int _tuple_id;
@@ -205,9 +54,9 @@ private:
     std::vector<IntersectColumnTypes> _types;
     size_t _intersect_times = 0;
 
-    using HashSerializeSet = HashSetFromExprs<phmap::flat_hash_set<SliceFlag, SliceFlagHash, SliceFlagEqual>>;
-    std::unique_ptr<HashSerializeSet> _hash_set;
-    HashSerializeSet::Iterator _hash_set_iterator;
+    std::unique_ptr<IntersectHashSerializeSet> _hash_set;
+    IntersectHashSerializeSet::Iterator _hash_set_iterator;
+    IntersectHashSerializeSet::KeyVector _remained_keys;
 
     // pool for allocate key.
     std::unique_ptr<MemPool> _build_pool;
@@ -149,7 +149,7 @@ Status SerializedJoinProbeFunc::lookup_init(const JoinHashTableItems& table_item
     for (const auto& data_column : data_columns) {
         serialize_size += data_column->serialize_size();
     }
-    uint8_t* ptr = table_items.probe_pool->allocate(serialize_size);
+    uint8_t* ptr = probe_state->probe_pool->allocate(serialize_size);
     if (UNLIKELY(ptr == nullptr)) {
         return Status::InternalError("Mem usage has exceed the limit of BE");
     }
@@ -174,9 +174,7 @@ void SerializedJoinProbeFunc::_probe_column(const JoinHashTableItems& table_item
         ptr += probe_state->probe_slice[i].size;
     }
 
-    for (uint32_t i = 0; i < row_count; i++) {
-        probe_state->next[i] = table_items.first[probe_state->buckets[i]];
-    }
+    JoinHashMapHelper::lookup_bucket_heads(table_items, probe_state, nullptr);
 }
 
 void SerializedJoinProbeFunc::_probe_nullable_column(const JoinHashTableItems& table_items,
@@ -204,88 +202,163 @@ void SerializedJoinProbeFunc::_probe_nullable_column(const JoinHashTableItems& t
         if (probe_state->is_nulls[i] == 0) {
             probe_state->buckets[i] =
                     JoinHashMapHelper::calc_bucket_num<Slice>(probe_state->probe_slice[i], table_items.bucket_size);
-            probe_state->next[i] = table_items.first[probe_state->buckets[i]];
-        } else {
-            probe_state->next[i] = 0;
         }
     }
+    JoinHashMapHelper::lookup_bucket_heads(table_items, probe_state, probe_state->is_nulls.data());
 }
 
 JoinHashTable::~JoinHashTable() {
-    _table_items.mem_tracker->release(_table_items.last_memory_usage);
+    if (_owns_table_items) {
+        _table_items->mem_tracker->release(_table_items->last_memory_usage);
+    }
 }
 
 void JoinHashTable::close() {
-    _table_items.build_pool.reset();
-    _table_items.probe_pool.reset();
+    if (_owns_table_items) {
+        _table_items->build_pool.reset();
+    }
+    _probe_state.probe_pool.reset();
 }
 
 void JoinHashTable::create(const HashTableParam& param) {
-    _table_items.row_count = 0;
-    _table_items.bucket_size = 0;
-    _table_items.build_chunk = std::make_shared<Chunk>();
-    _table_items.mem_tracker = param.mem_tracker;
-    _table_items.build_pool = std::make_unique<MemPool>();
-    _table_items.probe_pool = std::make_unique<MemPool>();
-    _table_items.with_other_conjunct = param.with_other_conjunct;
-    _table_items.join_type = param.join_type;
-    _table_items.row_desc = param.row_desc;
-    if (_table_items.join_type == TJoinOp::RIGHT_SEMI_JOIN || _table_items.join_type == TJoinOp::RIGHT_ANTI_JOIN ||
-        _table_items.join_type == TJoinOp::RIGHT_OUTER_JOIN) {
-        _table_items.left_to_nullable = true;
-    } else if (_table_items.join_type == TJoinOp::LEFT_SEMI_JOIN || _table_items.join_type == TJoinOp::LEFT_ANTI_JOIN ||
-               _table_items.join_type == TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN ||
-               _table_items.join_type == TJoinOp::LEFT_OUTER_JOIN) {
-        _table_items.right_to_nullable = true;
-    } else if (_table_items.join_type == TJoinOp::FULL_OUTER_JOIN) {
-        _table_items.left_to_nullable = true;
-        _table_items.right_to_nullable = true;
-    }
-    _table_items.search_ht_timer = param.search_ht_timer;
-    _table_items.output_build_column_timer = param.output_build_column_timer;
-    _table_items.output_probe_column_timer = param.output_probe_column_timer;
-    _table_items.output_tuple_column_timer = param.output_tuple_column_timer;
-    _table_items.join_keys = param.join_keys;
+    _table_items->row_count = 0;
+    _table_items->bucket_size = 0;
+    _table_items->build_chunk = std::make_shared<Chunk>();
+    _table_items->mem_tracker = param.mem_tracker;
+    _table_items->build_pool = std::make_unique<MemPool>();
+    _table_items->with_other_conjunct = param.with_other_conjunct;
+    _table_items->join_type = param.join_type;
+    _table_items->row_desc = param.row_desc;
+    if (_table_items->join_type == TJoinOp::RIGHT_SEMI_JOIN || _table_items->join_type == TJoinOp::RIGHT_ANTI_JOIN ||
+        _table_items->join_type == TJoinOp::RIGHT_OUTER_JOIN) {
+        _table_items->left_to_nullable = true;
+    } else if (_table_items->join_type == TJoinOp::LEFT_SEMI_JOIN ||
+               _table_items->join_type == TJoinOp::LEFT_ANTI_JOIN ||
+               _table_items->join_type == TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN ||
+               _table_items->join_type == TJoinOp::LEFT_OUTER_JOIN) {
+        _table_items->right_to_nullable = true;
+    } else if (_table_items->join_type == TJoinOp::FULL_OUTER_JOIN) {
+        _table_items->left_to_nullable = true;
+        _table_items->right_to_nullable = true;
+    }
+    _table_items->search_ht_timer = param.search_ht_timer;
+    _table_items->search_ht_hash_timer = param.search_ht_hash_timer;
+    _table_items->search_ht_prefetch_timer = param.search_ht_prefetch_timer;
+    _table_items->search_ht_match_timer = param.search_ht_match_timer;
+    _table_items->output_build_column_timer = param.output_build_column_timer;
+    _table_items->output_probe_column_timer = param.output_probe_column_timer;
+    _table_items->output_tuple_column_timer = param.output_tuple_column_timer;
+    _table_items->join_keys = param.join_keys;
+    _param_join_keys = param.join_keys;
 
     const auto& probe_desc = *param.probe_row_desc;
     for (const auto& tuple_desc : probe_desc.tuple_descriptors()) {
         for (const auto& slot : tuple_desc->slots()) {
-            _table_items.probe_slots.emplace_back(slot);
-            _table_items.probe_column_count++;
+            _table_items->probe_slots.emplace_back(slot);
+            _table_items->probe_column_count++;
         }
-        if (_table_items.row_desc->get_tuple_idx(tuple_desc->id()) != RowDescriptor::INVALID_IDX) {
-            _table_items.output_probe_tuple_ids.emplace_back(tuple_desc->id());
+        if (_table_items->row_desc->get_tuple_idx(tuple_desc->id()) != RowDescriptor::INVALID_IDX) {
+            _table_items->output_probe_tuple_ids.emplace_back(tuple_desc->id());
         }
     }
 
     const auto& build_desc = *param.build_row_desc;
     for (const auto& tuple_desc : build_desc.tuple_descriptors()) {
         for (const auto& slot : tuple_desc->slots()) {
-            _table_items.build_slots.emplace_back(slot);
-            ColumnPtr column = ColumnHelper::create_column(slot->type(), slot->is_nullable());
-            if (slot->is_nullable()) {
-                auto* nullable_column = ColumnHelper::as_raw_column<NullableColumn>(column);
-                nullable_column->append_default_not_null_value();
-            } else {
-                column->append_default();
-            }
-            _table_items.build_chunk->append_column(std::move(column), slot->id());
-            _table_items.build_column_count++;
+            _table_items->build_slots.emplace_back(slot);
+            _table_items->build_column_count++;
+        }
+        if (_table_items->row_desc->get_tuple_idx(tuple_desc->id()) != RowDescriptor::INVALID_IDX) {
+            _table_items->output_build_tuple_ids.emplace_back(tuple_desc->id());
         }
-        if (_table_items.row_desc->get_tuple_idx(tuple_desc->id()) != RowDescriptor::INVALID_IDX) {
-            _table_items.output_build_tuple_ids.emplace_back(tuple_desc->id());
+    }
+    _init_build_chunk();
+}
+
+void JoinHashTable::_init_build_chunk() {
+    // The first row is reserved to mark the end of the bucket lists, see JoinHashTableItems.next
+    _table_items->build_chunk = std::make_shared<Chunk>();
+    for (const auto& slot : _table_items->build_slots) {
+        ColumnPtr column = ColumnHelper::create_column(slot->type(), slot->is_nullable());
+        if (slot->is_nullable()) {
+            auto* nullable_column = ColumnHelper::as_raw_column<NullableColumn>(column);
+            nullable_column->append_default_not_null_value();
+        } else {
+            column->append_default();
         }
+        _table_items->build_chunk->append_column(std::move(column), slot->id());
+    }
+}
+
+void JoinHashTable::reset_build() {
+    _table_items->mem_tracker->release(_table_items->last_memory_usage);
+    _table_items->last_memory_usage = 0;
+    _table_items->row_count = 0;
+    _table_items->bucket_size = 0;
+    _table_items->key_columns.clear();
+    _table_items->first.clear();
+    _table_items->next.clear();
+    _table_items->build_slice.clear();
+    _table_items->build_key_column = nullptr;
+    _table_items->join_keys = _param_join_keys;
+    _table_items->build_pool = std::make_unique<MemPool>();
+    _init_build_chunk();
+
+#define M(NAME) _##NAME.reset();
+    APPLY_FOR_JOIN_VARIANTS(M)
+#undef M
+    _hash_map_type = JoinHashMapType::empty;
+    _probe_state = HashTableProbeState();
+}
+
+bool JoinHashTable::can_share_build(TJoinOp::type join_type) {
+    return join_type == TJoinOp::INNER_JOIN || join_type == TJoinOp::LEFT_OUTER_JOIN ||
+           join_type == TJoinOp::LEFT_SEMI_JOIN || join_type == TJoinOp::LEFT_ANTI_JOIN ||
+           join_type == TJoinOp::NULL_AWARE_LEFT_ANTI_JOIN;
+}
+
+void JoinHashTable::share_build(const JoinHashTable& built) {
+    DCHECK(can_share_build(built._table_items->join_type));
+    if (_owns_table_items) {
+        _table_items->mem_tracker->release(_table_items->last_memory_usage);
+    }
+    _table_items = built._table_items;
+    _owns_table_items = false;
+    _param_join_keys = built._param_join_keys;
+
+#define M(NAME) _##NAME.reset();
+    APPLY_FOR_JOIN_VARIANTS(M)
+#undef M
+    _probe_state = HashTableProbeState();
+    JoinHashMapHelper::prepare_map_index(&_probe_state);
+    _probe_state.is_nulls.resize(config::vector_chunk_size);
+
+    _hash_map_type = built._hash_map_type;
+    switch (_hash_map_type) {
+    case JoinHashMapType::empty:
+        break;
+#define M(NAME)                                                                                                  \
+    case JoinHashMapType::NAME:                                                                                  \
+        _##NAME = std::make_unique<typename decltype(_##NAME)::element_type>(_table_items.get(), &_probe_state); \
+        break;
+        APPLY_FOR_JOIN_VARIANTS(M)
+#undef M
+    default:
+        break;
     }
 }
 
 Status JoinHashTable::build(RuntimeState* state) {
     _hash_map_type = _choose_join_hash_map();
-    _table_items.bucket_size = JoinHashMapHelper::calc_bucket_size(_table_items.row_count + 1);
-    _table_items.first.resize(_table_items.bucket_size, 0);
-    _table_items.next.resize(_table_items.row_count + 1, 0);
-    if (_table_items.join_type == TJoinOp::RIGHT_OUTER_JOIN || _table_items.join_type == TJoinOp::FULL_OUTER_JOIN ||
-        _table_items.join_type == TJoinOp::RIGHT_SEMI_JOIN || _table_items.join_type == TJoinOp::RIGHT_ANTI_JOIN) {
-        _probe_state.build_match_index.resize(_table_items.row_count + 1, 0);
+    // the bucket size of direct mapping is decided by the range of keys.
+    if (!_is_direct_mapping(_hash_map_type)) {
+        _table_items->bucket_size = JoinHashMapHelper::calc_bucket_size(_table_items->row_count + 1);
+    }
+    _table_items->first.resize(_table_items->bucket_size, 0);
+    _table_items->next.resize(_table_items->row_count + 1, 0);
+    if (_table_items->join_type == TJoinOp::RIGHT_OUTER_JOIN || _table_items->join_type == TJoinOp::FULL_OUTER_JOIN ||
+        _table_items->join_type == TJoinOp::RIGHT_SEMI_JOIN || _table_items->join_type == TJoinOp::RIGHT_ANTI_JOIN) {
+        _probe_state.build_match_index.resize(_table_items->row_count + 1, 0);
         _probe_state.build_match_index[0] = 1;
     }
 
@@ -293,15 +366,15 @@ Status JoinHashTable::build(RuntimeState* state) {
 
     // size of hashtable index
     RETURN_IF_ERROR(JoinHashMapHelper::check_and_add_memory_usage(
-            state, &_table_items, (_table_items.first.size() + _table_items.row_count + 1) * sizeof(uint32_t)));
+            state, _table_items.get(), (_table_items->first.size() + _table_items->row_count + 1) * sizeof(uint32_t)));
 
     switch (_hash_map_type) {
     case JoinHashMapType::empty:
         break;
-#define M(NAME)                                                                                             \
-    case JoinHashMapType::NAME:                                                                             \
-        _##NAME = std::make_unique<typename decltype(_##NAME)::element_type>(&_table_items, &_probe_state); \
-        RETURN_IF_ERROR(_##NAME->build(state));                                                             \
+#define M(NAME)                                                                                                  \
+    case JoinHashMapType::NAME:                                                                                  \
+        _##NAME = std::make_unique<typename decltype(_##NAME)::element_type>(_table_items.get(), &_probe_state); \
+        RETURN_IF_ERROR(_##NAME->build(state));                                                                  \
         break;
         APPLY_FOR_JOIN_VARIANTS(M)
 #undef M
@@ -309,6 +382,103 @@ Status JoinHashTable::build(RuntimeState* state) {
         return Status::InternalError("not supported");
     }
 
+    // the buckets of direct mapping are already in the order of keys.
+    if (_enable_radix_partition && !_is_direct_mapping(_hash_map_type)) {
+        RETURN_IF_ERROR(_radix_cluster_build_rows(state));
+    }
+
+    return Status::OK();
+}
+
+Status JoinHashTable::_radix_cluster_build_rows(RuntimeState* state) {
+    // at most as many partitions as the rows of a probe chunk
+    static constexpr uint32_t MAX_RADIX_PARTITION_BITS = 12;
+
+    const uint32_t row_count = _table_items->row_count;
+    const uint32_t bucket_size = _table_items->bucket_size;
+    DCHECK_EQ(bucket_size & (bucket_size - 1), 0);
+
+    // the partitions are sized by the bucket heads, the bucket chains and the build keys.
+    size_t table_bytes = (_table_items->first.size() + _table_items->next.size()) * sizeof(uint32_t);
+    for (const auto& key_column : _table_items->key_columns) {
+        table_bytes += key_column->byte_size();
+    }
+    uint32_t bucket_bits = __builtin_ctz(bucket_size);
+    uint32_t bits = 0;
+    while (bits < std::min(bucket_bits, MAX_RADIX_PARTITION_BITS) &&
+           (table_bytes >> bits) > static_cast<size_t>(config::join_radix_partition_bytes)) {
+        bits++;
+    }
+    _table_items->radix_partition_bits = bits;
+    _table_items->radix_partition_shift = bucket_bits - bits;
+    if (bits == 0) {
+        return Status::OK();
+    }
+
+    // The build chunk is copied in the new order, the copy is accounted before it's made, and the original
+    // one is released afterwards.
+    Columns original_build_columns = _table_items->build_chunk->columns();
+    size_t build_chunk_bytes = 0;
+    for (const auto& column : original_build_columns) {
+        build_chunk_bytes += column->memory_usage();
+    }
+    RETURN_IF_ERROR(JoinHashMapHelper::check_and_add_memory_usage(state, _table_items.get(), build_chunk_bytes));
+
+    // The rows without bucket, e.g. of null keys, are put into an extra partition at the end, and the
+    // dummy row 0 stays at the beginning since the sort is stable.
+    Buffer<uint32_t> row_buckets(row_count + 1, bucket_size);
+    row_buckets[0] = 0;
+    for (uint32_t bucket = 0; bucket < bucket_size; bucket++) {
+        for (uint32_t row = _table_items->first[bucket]; row != 0; row = _table_items->next[row]) {
+            row_buckets[row] = bucket;
+        }
+    }
+    Buffer<uint32_t> rows;
+    JoinHashMapHelper::radix_cluster_rows(row_buckets.data(), row_count + 1, _table_items->radix_partition_shift,
+                                          (1u << bits) + 1, &rows);
+    DCHECK_EQ(rows[0], 0);
+
+    // renumber the bucket chains
+    Buffer<uint32_t> new_rows(row_count + 1);
+    for (uint32_t i = 0; i <= row_count; i++) {
+        new_rows[rows[i]] = i;
+    }
+    for (auto& head : _table_items->first) {
+        head = new_rows[head];
+    }
+    Buffer<uint32_t> next(row_count + 1);
+    for (uint32_t i = 0; i <= row_count; i++) {
+        next[i] = new_rows[_table_items->next[rows[i]]];
+    }
+    _table_items->next.swap(next);
+
+    // reorder the build rows, the key columns may be the columns of build chunk.
+    std::unordered_map<const Column*, ColumnPtr> permuted;
+    JoinHashMapHelper::permute_columns(&_table_items->build_chunk->columns(), rows, &permuted);
+    JoinHashMapHelper::permute_columns(&_table_items->key_columns, rows, &permuted);
+    if (_table_items->build_key_column != nullptr) {
+        Columns build_key_columns{_table_items->build_key_column};
+        JoinHashMapHelper::permute_columns(&build_key_columns, rows, &permuted);
+        _table_items->build_key_column = build_key_columns[0];
+    }
+    if (!_table_items->build_slice.empty()) {
+        Buffer<Slice> build_slice(row_count + 1);
+        for (uint32_t i = 0; i <= row_count; i++) {
+            build_slice[i] = _table_items->build_slice[rows[i]];
+        }
+        _table_items->build_slice.swap(build_slice);
+    }
+
+    // the original columns are only freed if nothing else refers to them.
+    size_t freed_bytes = 0;
+    for (const auto& column : original_build_columns) {
+        if (column.use_count() == 1) {
+            freed_bytes += column->memory_usage();
+        }
+    }
+    original_build_columns.clear();
+    _table_items->mem_tracker->release(freed_bytes);
+    _table_items->last_memory_usage -= freed_bytes;
     return Status::OK();
 }
 
@@ -345,11 +515,11 @@ Status JoinHashTable::probe_remain(ChunkPtr* chunk, bool* eos) {
 }
 
 Status JoinHashTable::append_chunk(RuntimeState* state, const ChunkPtr& chunk) {
-    Columns& columns = _table_items.build_chunk->columns();
+    Columns& columns = _table_items->build_chunk->columns();
     size_t chunk_memory_size = 0;
 
-    for (size_t i = 0; i < _table_items.build_column_count; i++) {
-        SlotDescriptor* slot = _table_items.build_slots[i];
+    for (size_t i = 0; i < _table_items->build_column_count; i++) {
+        SlotDescriptor* slot = _table_items->build_slots[i];
         ColumnPtr& column = chunk->get_column_by_slot_id(slot->id());
         chunk_memory_size += column->memory_usage();
 
@@ -366,30 +536,30 @@ Status JoinHashTable::append_chunk(RuntimeState* state, const ChunkPtr& chunk) {
 
     const auto& tuple_id_map = chunk->get_tuple_id_to_index_map();
     for (auto iter = tuple_id_map.begin(); iter != tuple_id_map.end(); iter++) {
-        if (_table_items.row_desc->get_tuple_idx(iter->first) != RowDescriptor::INVALID_IDX) {
-            if (_table_items.build_chunk->is_tuple_exist(iter->first)) {
+        if (_table_items->row_desc->get_tuple_idx(iter->first) != RowDescriptor::INVALID_IDX) {
+            if (_table_items->build_chunk->is_tuple_exist(iter->first)) {
                 ColumnPtr& src_column = chunk->get_tuple_column_by_id(iter->first);
-                ColumnPtr& dest_column = _table_items.build_chunk->get_tuple_column_by_id(iter->first);
+                ColumnPtr& dest_column = _table_items->build_chunk->get_tuple_column_by_id(iter->first);
                 dest_column->append(*src_column, 0, src_column->size());
                 chunk_memory_size += src_column->memory_usage();
             } else {
                 ColumnPtr& src_column = chunk->get_tuple_column_by_id(iter->first);
-                ColumnPtr dest_column = BooleanColumn::create(_table_items.row_count + 1, 1);
+                ColumnPtr dest_column = BooleanColumn::create(_table_items->row_count + 1, 1);
                 dest_column->append(*src_column, 0, src_column->size());
-                _table_items.build_chunk->append_tuple_column(dest_column, iter->first);
+                _table_items->build_chunk->append_tuple_column(dest_column, iter->first);
                 chunk_memory_size += src_column->memory_usage();
             }
         }
     }
 
-    RETURN_IF_ERROR(JoinHashMapHelper::check_and_add_memory_usage(state, &_table_items, chunk_memory_size));
+    RETURN_IF_ERROR(JoinHashMapHelper::check_and_add_memory_usage(state, _table_items.get(), chunk_memory_size));
 
-    _table_items.row_count += chunk->num_rows();
+    _table_items->row_count += chunk->num_rows();
     return Status::OK();
 }
 
 void JoinHashTable::remove_duplicate_index(Column::Filter* filter) {
-    switch (_table_items.join_type) {
+    switch (_table_items->join_type) {
     case TJoinOp::LEFT_OUTER_JOIN:
         _remove_duplicate_index_for_left_outer_join(filter);
         break;
@@ -417,28 +587,85 @@ void JoinHashTable::remove_duplicate_index(Column::Filter* filter) {
     }
 }
 
+template <PrimitiveType PT>
+bool JoinHashTable::_can_use_direct_mapping() {
+    using CppType = typename RunTimeTypeTraits<PT>::CppType;
+    // The bucket-chained hash table has 1.14x~2.28x buckets of the build rows, the direct mapping one
+    // is only chosen if it doesn't have much more buckets.
+    static constexpr uint64_t MAX_BUCKETS_PER_ROW = 4;
+
+    const uint32_t row_count = _table_items->row_count;
+    if (!config::enable_join_direct_mapping || row_count == 0) {
+        return false;
+    }
+
+    const auto& data = JoinBuildFunc<PT>::get_key_data(*_table_items);
+    const NullColumn::Container* null_array = nullptr;
+    if (_table_items->key_columns[0]->is_nullable()) {
+        auto* nullable_column = ColumnHelper::as_raw_column<NullableColumn>(_table_items->key_columns[0]);
+        null_array = &nullable_column->null_column()->get_data();
+    }
+
+    bool has_value = false;
+    CppType min_value = 0;
+    CppType max_value = 0;
+    for (size_t i = 1; i < row_count + 1; i++) {
+        if (null_array != nullptr && (*null_array)[i] != 0) {
+            continue;
+        }
+        if (!has_value) {
+            min_value = max_value = data[i];
+            has_value = true;
+        } else {
+            min_value = std::min(min_value, data[i]);
+            max_value = std::max(max_value, data[i]);
+        }
+    }
+    if (!has_value) {
+        return false;
+    }
+
+    // max - min in unsigned never overflows, and the range is max - min + 1.
+    uint64_t max_offset = static_cast<uint64_t>(static_cast<int64_t>(max_value)) -
+                          static_cast<uint64_t>(static_cast<int64_t>(min_value));
+    if (max_offset >= static_cast<uint64_t>(config::join_direct_mapping_max_range) ||
+        max_offset >= MAX_BUCKETS_PER_ROW * row_count) {
+        return false;
+    }
+
+    _table_items->direct_mapping_min_key = static_cast<int64_t>(min_value);
+    // bucket 0 is reserved for the probe values out of range.
+    _table_items->bucket_size = max_offset + 2;
+    return true;
+}
+
+bool JoinHashTable::_is_direct_mapping(JoinHashMapType type) {
+    return type == JoinHashMapType::direct8 || type == JoinHashMapType::direct16 ||
+           type == JoinHashMapType::direct32 || type == JoinHashMapType::direct64;
+}
+
 JoinHashMapType JoinHashTable::_choose_join_hash_map() {
-    size_t size = _table_items.join_keys.size();
+    size_t size = _table_items->join_keys.size();
     DCHECK_GT(size, 0);
 
-    for (size_t i = 0; i < _table_items.join_keys.size(); i++) {
-        if (!_table_items.key_columns[i]->has_null()) {
-            _table_items.join_keys[i].is_null_safe_equal = false;
+    for (size_t i = 0; i < _table_items->join_keys.size(); i++) {
+        if (!_table_items->key_columns[i]->has_null()) {
+            _table_items->join_keys[i].is_null_safe_equal = false;
         }
     }
 
-    if (size == 1 && !_table_items.join_keys[0].is_null_safe_equal) {
-        switch (_table_items.join_keys[0].type) {
+    if (size == 1 && !_table_items->join_keys[0].is_null_safe_equal) {
+        switch (_table_items->join_keys[0].type) {
         case PrimitiveType::TYPE_BOOLEAN:
             return JoinHashMapType::keyboolean;
         case PrimitiveType::TYPE_TINYINT:
-            return JoinHashMapType::key8;
+            return _can_use_direct_mapping<TYPE_TINYINT>() ? JoinHashMapType::direct8 : JoinHashMapType::key8;
         case PrimitiveType::TYPE_SMALLINT:
-            return JoinHashMapType::key16;
+            return _can_use_direct_mapping<TYPE_SMALLINT>() ? JoinHashMapType::direct16 : JoinHashMapType::key16;
         case PrimitiveType::TYPE_INT:
-            return JoinHashMapType::key32;
+            return _can_use_direct_mapping<TYPE_INT>() ? JoinHashMapType::direct32 : JoinHashMapType::key32;
         case PrimitiveType::TYPE_BIGINT:
-            return JoinHashMapType::key64;
+            return _can_use_direct_mapping<TYPE_BIGINT>() ? JoinHashMapType::direct64 : JoinHashMapType::key64;
         case PrimitiveType::TYPE_LARGEINT:
             return JoinHashMapType::key128;
         case PrimitiveType::TYPE_FLOAT:
@@ -469,7 +696,7 @@ JoinHashMapType JoinHashTable::_choose_join_hash_map() {
 
     size_t total_size_in_byte = 0;
 
-    for (auto& join_key : _table_items.join_keys) {
+    for (auto& join_key : _table_items->join_keys) {
         if (join_key.is_null_safe_equal) {
             total_size_in_byte += 1;
         }
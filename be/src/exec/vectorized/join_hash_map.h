@@ -6,10 +6,13 @@
 #include <runtime/descriptors.h>
 #include <runtime/runtime_state.h>
 
+#include <unordered_map>
+
 #include "column/chunk.h"
 #include "column/column_hash.h"
 #include "column/column_helper.h"
 #include "runtime/mem_tracker.h"
+#include "runtime/mem_pool.h"
 #include "util/phmap/phmap.h"
 
 #if defined(__aarch64__)
@@ -36,7 +39,11 @@ namespace starrocks::vectorized {
     M(slice)                       \
     M(fixed32)                     \
     M(fixed64)                     \
-    M(fixed128)
+    M(fixed128)                    \
+    M(direct8)                     \
+    M(direct16)                    \
+    M(direct32)                    \
+    M(direct64)
 
 enum class JoinHashMapType {
     empty,
@@ -58,7 +65,12 @@ enum class JoinHashMapType {
     slice,
     fixed32, // 4 bytes
     fixed64, // 8 bytes
-    fixed128 // 16 bytes
+    fixed128, // 16 bytes
+    // one integer key whose build values are in a small range, see DirectMappingJoinBuildFunc
+    direct8,
+    direct16,
+    direct32,
+    direct64
 };
 
 enum class JoinMatchFlag { NORMAL, ALL_NOT_MATCH, ALL_MATCH_ONE, MOST_MATCH_ONE };
@@ -89,6 +101,15 @@ struct JoinHashTableItems {
     Buffer<Slice> build_slice;
     ColumnPtr build_key_column;
     uint32_t bucket_size = 0;
+    // the minimum build key of the direct mapping hash map, see DirectMappingJoinBuildFunc.
+    int64_t direct_mapping_min_key = 0;
+    // prefetch the bucket heads and build rows when probing, set for the hash table larger than
+    // config::join_probe_prefetch_min_table_bytes.
+    bool enable_probe_prefetch = false;
+    // the build rows are clustered into 2^radix_partition_bits partitions by the high bits of their buckets,
+    // i.e. bucket >> radix_partition_shift, see JoinHashTable::_radix_cluster_build_rows.
+    uint32_t radix_partition_bits = 0;
+    uint32_t radix_partition_shift = 0;
     uint32_t row_count = 0; // real row count
     size_t build_column_count = 0;
     size_t probe_column_count = 0;
@@ -100,7 +121,6 @@ struct JoinHashTableItems {
 
     MemTracker* mem_tracker = nullptr;
     std::unique_ptr<MemPool> build_pool = nullptr;
-    std::unique_ptr<MemPool> probe_pool = nullptr;
     uint64_t last_memory_usage = 0;
     std::vector<JoinKeyDesc> join_keys;
 
@@ -108,6 +128,9 @@ struct JoinHashTableItems {
     RuntimeProfile::Counter* output_build_column_timer = nullptr;
     RuntimeProfile::Counter* output_probe_column_timer = nullptr;
     RuntimeProfile::Counter* output_tuple_column_timer = nullptr;
+    RuntimeProfile::Counter* search_ht_hash_timer = nullptr;
+    RuntimeProfile::Counter* search_ht_prefetch_timer = nullptr;
+    RuntimeProfile::Counter* search_ht_match_timer = nullptr;
 };
 
 struct HashTableProbeState {
@@ -146,6 +169,15 @@ struct HashTableProbeState {
     // cur_probe_index records the position of the last probe
     uint32_t cur_probe_index = 0;
     uint32_t cur_row_match_count = 0;
+
+    // for serializing the probe keys, allocated on the first probe.
+    std::unique_ptr<MemPool> probe_pool = nullptr;
+
+    // true if the rows of current probe chunk are reordered by the radix partitions of the hash table,
+    // key_columns points to clustered_key_columns then.
+    bool probe_rows_clustered = false;
+    Columns clustered_key_columns;
+    Buffer<uint32_t> clustered_rows;
 };
 
 struct HashTableParam {
@@ -161,6 +193,9 @@ struct HashTableParam {
     RuntimeProfile::Counter* output_build_column_timer = nullptr;
     RuntimeProfile::Counter* output_probe_column_timer = nullptr;
     RuntimeProfile::Counter* output_tuple_column_timer = nullptr;
+    RuntimeProfile::Counter* search_ht_hash_timer = nullptr;
+    RuntimeProfile::Counter* search_ht_prefetch_timer = nullptr;
+    RuntimeProfile::Counter* search_ht_match_timer = nullptr;
 };
 
 template <class T>
@@ -229,6 +264,96 @@ public:
         }
     }
 
+    // The bucket of a direct mapping hash map is (value - min_key + 1), bucket 0 is for the values out of range.
+    // The subtraction is done in unsigned, so the values less than min_key are wrapped to be out of range.
+    template <typename CppType>
+    static uint32_t calc_direct_mapping_bucket_num(const CppType& value, int64_t min_key, uint32_t bucket_size) {
+        uint64_t offset = static_cast<uint64_t>(static_cast<int64_t>(value)) - static_cast<uint64_t>(min_key);
+        return offset < bucket_size - 1 ? offset + 1 : 0;
+    }
+
+    template <typename CppType>
+    static void calc_direct_mapping_bucket_nums(const Buffer<CppType>& data, int64_t min_key, uint32_t bucket_size,
+                                                Buffer<uint32_t>* buckets, uint32_t start, uint32_t count) {
+        for (size_t i = 0; i < count; i++) {
+            (*buckets)[i] = calc_direct_mapping_bucket_num<CppType>(data[start + i], min_key, bucket_size);
+        }
+    }
+
+    // Fetch the head of the bucket chain of every probe row into probe_state->next, the rows whose
+    // is_nulls[i] is not 0 get 0. When the hash table is much larger than the cache, the bucket heads
+    // are prefetched config::join_probe_prefetch_distance rows ahead, so the cache misses of
+    // first[] overlap with each other instead of stalling the loop one by one.
+    static void lookup_bucket_heads(const JoinHashTableItems& table_items, HashTableProbeState* probe_state,
+                                    const uint8_t* is_nulls) {
+        const uint32_t row_count = probe_state->probe_row_count;
+        const uint32_t* buckets = probe_state->buckets.data();
+        const uint32_t* first = table_items.first.data();
+        uint32_t* next = probe_state->next.data();
+
+        if (table_items.enable_probe_prefetch) {
+            const uint32_t distance = config::join_probe_prefetch_distance;
+            for (uint32_t i = 0; i < row_count; i++) {
+                if (i + distance < row_count) {
+                    __builtin_prefetch(first + buckets[i + distance]);
+                }
+                next[i] = (is_nulls == nullptr || is_nulls[i] == 0) ? first[buckets[i]] : 0;
+            }
+            return;
+        }
+
+        if (is_nulls == nullptr) {
+            for (uint32_t i = 0; i < row_count; i++) {
+                next[i] = first[buckets[i]];
+            }
+        } else {
+            for (uint32_t i = 0; i < row_count; i++) {
+                next[i] = is_nulls[i] == 0 ? first[buckets[i]] : 0;
+            }
+        }
+    }
+
+    // Order the rows by the partitions of their buckets, i.e. bucket >> shift, which must be less than
+    // num_partitions. It's a stable counting sort, rows[i] is the original index of the i-th row.
+    static void radix_cluster_rows(const uint32_t* buckets, uint32_t row_count, uint32_t shift,
+                                   uint32_t num_partitions, Buffer<uint32_t>* rows) {
+        std::vector<uint32_t> offsets(num_partitions + 1, 0);
+        for (uint32_t i = 0; i < row_count; i++) {
+            offsets[(buckets[i] >> shift) + 1]++;
+        }
+        for (uint32_t i = 1; i <= num_partitions; i++) {
+            offsets[i] += offsets[i - 1];
+        }
+        rows->resize(row_count);
+        for (uint32_t i = 0; i < row_count; i++) {
+            (*rows)[offsets[buckets[i] >> shift]++] = i;
+        }
+    }
+
+    // Reorder the rows of |columns| by |rows|. A column referenced by multiple entries, e.g. the key column
+    // of a slot ref, is reordered only once and the reordered one is recorded in |permuted|.
+    static void permute_columns(Columns* columns, const Buffer<uint32_t>& rows,
+                                std::unordered_map<const Column*, ColumnPtr>* permuted) {
+        for (auto& column : *columns) {
+            auto& dest = (*permuted)[column.get()];
+            if (dest == nullptr) {
+                dest = column->clone_empty();
+                dest->append_selective(*column, rows.data(), 0, rows.size());
+            }
+            column = dest;
+        }
+    }
+
+    // Reorder the first rows.size() values by |rows|, the values beyond them are kept.
+    template <typename T>
+    static void permute_values(Buffer<T>* values, const Buffer<uint32_t>& rows) {
+        Buffer<T> permuted(rows.size());
+        for (size_t i = 0; i < rows.size(); i++) {
+            permuted[i] = (*values)[rows[i]];
+        }
+        std::copy(permuted.begin(), permuted.end(), values->begin());
+    }
+
     static void prepare_map_index(HashTableProbeState* probe_state) {
         probe_state->build_index.resize(config::vector_chunk_size + 8);
         probe_state->probe_index.resize(config::vector_chunk_size + 8);
@@ -287,6 +412,18 @@ public:
     static Status construct_hash_table(JoinHashTableItems* table_items, HashTableProbeState* probe_state);
 };
 
+// For one integer key whose build values are in a small range [min, max], the key itself is the bucket
+// index after subtracting min, so the probe is a bounds check plus an array lookup without hashing.
+// The bucket array has (max - min + 2) buckets, and bucket 0 is always empty for the values out of range.
+// The rows with the same key are still chained by JoinHashTableItems.next.
+template <PrimitiveType PT>
+class DirectMappingJoinBuildFunc : public JoinBuildFunc<PT> {
+public:
+    using CppType = typename RunTimeTypeTraits<PT>::CppType;
+
+    static Status construct_hash_table(JoinHashTableItems* table_items, HashTableProbeState* probe_state);
+};
+
 template <PrimitiveType PT>
 class FixedSizeJoinBuildFunc {
 public:
@@ -334,9 +471,20 @@ public:
 
     static Status lookup_init(const JoinHashTableItems& table_items, HashTableProbeState* probe_state);
 
+    // reorder the per-row states computed by lookup_init, after the key columns are reordered by |rows|.
+    static void permute(HashTableProbeState* probe_state, const Buffer<uint32_t>& rows);
+
     static const Buffer<CppType>& get_key_data(const HashTableProbeState& probe_state);
 };
 
+template <PrimitiveType PT>
+class DirectMappingJoinProbeFunc : public JoinProbeFunc<PT> {
+public:
+    using CppType = typename RunTimeTypeTraits<PT>::CppType;
+
+    static Status lookup_init(const JoinHashTableItems& table_items, HashTableProbeState* probe_state);
+};
+
 template <PrimitiveType PT>
 class FixedSizeJoinProbeFunc {
 public:
@@ -352,6 +500,12 @@ public:
     // serialize and calculate hash values for probe keys.
     static Status lookup_init(const JoinHashTableItems& table_items, HashTableProbeState* probe_state);
 
+    static void permute(HashTableProbeState* probe_state, const Buffer<uint32_t>& rows) {
+        auto* probe_key_column = ColumnHelper::as_raw_column<ColumnType>(probe_state->probe_key_column);
+        JoinHashMapHelper::permute_values(&probe_key_column->get_data(), rows);
+        JoinHashMapHelper::permute_values(&probe_state->is_nulls, rows);
+    }
+
     static const Buffer<CppType>& get_key_data(const HashTableProbeState& probe_state) {
         return ColumnHelper::as_raw_column<ColumnType>(probe_state.probe_key_column)->get_data();
     }
@@ -368,13 +522,23 @@ public:
     static const Buffer<Slice>& get_key_data(const HashTableProbeState& probe_state) { return probe_state.probe_slice; }
 
     static void prepare(JoinHashTableItems* table_items, HashTableProbeState* probe_state) {
-        table_items->probe_pool->clear();
+        // The pool belongs to the probe state, so that the probers of a shared hash table do not race.
+        if (probe_state->probe_pool == nullptr) {
+            probe_state->probe_pool = std::make_unique<MemPool>();
+        } else {
+            probe_state->probe_pool->clear();
+        }
         probe_state->probe_slice.resize(probe_state->probe_row_count);
         probe_state->is_nulls.resize(config::vector_chunk_size);
     }
 
     static Status lookup_init(const JoinHashTableItems& table_items, HashTableProbeState* probe_state);
 
+    static void permute(HashTableProbeState* probe_state, const Buffer<uint32_t>& rows) {
+        JoinHashMapHelper::permute_values(&probe_state->probe_slice, rows);
+        JoinHashMapHelper::permute_values(&probe_state->is_nulls, rows);
+    }
+
 private:
     static void _probe_column(const JoinHashTableItems& table_items, HashTableProbeState* probe_state,
                               const Columns& data_columns, uint8_t* ptr);
@@ -414,6 +578,12 @@ private:
     Status _search_ht(ChunkPtr* probe_chunk);
     void _search_ht_remain();
 
+    // prefetch the first build row of the bucket chain of every probe row, see lookup_bucket_heads.
+    void _prefetch_build_rows(const Buffer<CppType>& build_data);
+    // reorder the rows of the probe chunk and its key columns by the radix partitions of their buckets,
+    // so that the probe accesses one cache-sized partition of the hash table after another.
+    void _cluster_probe_rows(ChunkPtr* probe_chunk);
+
     template <bool first_probe>
     void _search_ht_impl(const Buffer<CppType>& build_data, const Buffer<CppType>& data);
 
@@ -491,6 +661,7 @@ private:
 #define JoinHashMapForOneKey(PT) JoinHashMap<PT, JoinBuildFunc<PT>, JoinProbeFunc<PT>>
 #define JoinHashMapForFixedSizeKey(PT) JoinHashMap<PT, FixedSizeJoinBuildFunc<PT>, FixedSizeJoinProbeFunc<PT>>
 #define JoinHashMapForSerializedKey(PT) JoinHashMap<PT, SerializedJoinBuildFunc, SerializedJoinProbeFunc>
+#define JoinHashMapForDirectMapping(PT) JoinHashMap<PT, DirectMappingJoinBuildFunc<PT>, DirectMappingJoinProbeFunc<PT>>
 
 class JoinHashTable {
 public:
@@ -498,6 +669,15 @@ public:
 
     void create(const HashTableParam& param);
     void close();
+    // Drop all the appended build rows and the hash map built on them, so that the
+    // table can be appended and built again, e.g. for the next partition of spilled join.
+    void reset_build();
+    // Probe the hash table built by |built| instead of building one, the build rows and the hash map are
+    // shared while the probe state is owned by this table, so that multiple HashJoiners can probe the
+    // same hash table concurrently. Only the join types which never touch the build match index in probe
+    // are allowed, see can_share_build().
+    void share_build(const JoinHashTable& built);
+    static bool can_share_build(TJoinOp::type join_type);
 
     Status build(RuntimeState* state);
     Status probe(const Columns& key_columns, ChunkPtr* probe_chunk, ChunkPtr* chunk, bool* eos);
@@ -505,17 +685,48 @@ public:
 
     Status append_chunk(RuntimeState* state, const ChunkPtr& chunk);
 
-    const ChunkPtr& get_build_chunk() const { return _table_items.build_chunk; }
-    Columns& get_key_columns() { return _table_items.key_columns; }
-    uint32_t get_row_count() const { return _table_items.row_count; }
-    size_t get_probe_column_count() const { return _table_items.probe_column_count; }
-    size_t get_build_column_count() const { return _table_items.build_column_count; }
-    size_t get_bucket_size() const { return _table_items.bucket_size; }
+    const ChunkPtr& get_build_chunk() const { return _table_items->build_chunk; }
+    Columns& get_key_columns() { return _table_items->key_columns; }
+    uint32_t get_row_count() const { return _table_items->row_count; }
+    size_t get_probe_column_count() const { return _table_items->probe_column_count; }
+    size_t get_build_column_count() const { return _table_items->build_column_count; }
+    size_t get_bucket_size() const { return _table_items->bucket_size; }
+    // The memory of the bucket heads and the chains of the build rows.
+    size_t get_bucket_memory_usage() const {
+        return (_table_items->first.capacity() + _table_items->next.capacity()) * sizeof(uint32_t);
+    }
+    // The memory of the build keys, either the key column or the serialized keys in build_pool.
+    size_t get_key_memory_usage() const {
+        size_t usage = _table_items->build_slice.capacity() * sizeof(Slice);
+        if (_table_items->build_key_column != nullptr) {
+            usage += _table_items->build_key_column->memory_usage();
+        }
+        if (_table_items->build_pool != nullptr) {
+            usage += _table_items->build_pool->total_reserved_bytes();
+        }
+        return usage;
+    }
+    size_t get_build_chunk_memory_usage() const {
+        return _table_items->build_chunk != nullptr ? _table_items->build_chunk->memory_usage() : 0;
+    }
 
     void remove_duplicate_index(Column::Filter* filter);
 
+    // Cluster the build rows by the high bits of their buckets on build, so that the hash table is accessed
+    // partition by partition of config::join_radix_partition_bytes, which stay in cache, when probing.
+    void set_radix_partition(bool enable) { _enable_radix_partition = enable; }
+
 private:
     JoinHashMapType _choose_join_hash_map();
+    // Renumber the build rows in the order of their radix partitions, the first/next arrays, the build chunk
+    // and the build keys are all reordered. The copy of the build chunk is accounted to the mem tracker.
+    Status _radix_cluster_build_rows(RuntimeState* state);
+    // Return true if the build values of the only key are in a range small enough to be direct mapped,
+    // the minimum value and the bucket size are recorded in JoinHashTableItems.
+    template <PrimitiveType PT>
+    bool _can_use_direct_mapping();
+    static bool _is_direct_mapping(JoinHashMapType type);
+    void _init_build_chunk();
     static size_t _get_size_of_fixed_and_contiguous_type(PrimitiveType data_type);
 
     void _remove_duplicate_index_for_left_outer_join(Column::Filter* filter);
@@ -545,10 +756,19 @@ private:
     std::unique_ptr<JoinHashMapForFixedSizeKey(TYPE_INT)> _fixed32 = nullptr;
     std::unique_ptr<JoinHashMapForFixedSizeKey(TYPE_BIGINT)> _fixed64 = nullptr;
     std::unique_ptr<JoinHashMapForFixedSizeKey(TYPE_LARGEINT)> _fixed128 = nullptr;
+    std::unique_ptr<JoinHashMapForDirectMapping(TYPE_TINYINT)> _direct8 = nullptr;
+    std::unique_ptr<JoinHashMapForDirectMapping(TYPE_SMALLINT)> _direct16 = nullptr;
+    std::unique_ptr<JoinHashMapForDirectMapping(TYPE_INT)> _direct32 = nullptr;
+    std::unique_ptr<JoinHashMapForDirectMapping(TYPE_BIGINT)> _direct64 = nullptr;
 
     JoinHashMapType _hash_map_type = JoinHashMapType::empty;
+    // JoinHashTableItems.join_keys may be modified by building, keep the original ones for reset_build
+    std::vector<JoinKeyDesc> _param_join_keys;
 
-    JoinHashTableItems _table_items;
+    std::shared_ptr<JoinHashTableItems> _table_items = std::make_shared<JoinHashTableItems>();
+    // false if _table_items is shared from another table, whose owner accounts for the memory.
+    bool _owns_table_items = true;
+    bool _enable_radix_partition = false;
     HashTableProbeState _probe_state;
 };
 } // namespace starrocks::vectorized
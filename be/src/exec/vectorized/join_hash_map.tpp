@@ -41,6 +41,35 @@ Status JoinBuildFunc<PT>::construct_hash_table(JoinHashTableItems* table_items,
     return Status::OK();
 }
 
+template <PrimitiveType PT>
+Status DirectMappingJoinBuildFunc<PT>::construct_hash_table(JoinHashTableItems* table_items,
+                                                            HashTableProbeState* probe_state) {
+    auto& data = JoinBuildFunc<PT>::get_key_data(*table_items);
+    const int64_t min_key = table_items->direct_mapping_min_key;
+    const uint32_t bucket_size = table_items->bucket_size;
+    if (table_items->key_columns[0]->is_nullable()) {
+        auto* nullable_column =
+                ColumnHelper::as_raw_column<NullableColumn>(table_items->key_columns[0]);
+        auto& null_array = nullable_column->null_column()->get_data();
+        for (size_t i = 1; i < table_items->row_count + 1; i++) {
+            if (null_array[i] == 0) {
+                uint32_t bucket_num = JoinHashMapHelper::calc_direct_mapping_bucket_num<CppType>(
+                        data[i], min_key, bucket_size);
+                table_items->next[i] = table_items->first[bucket_num];
+                table_items->first[bucket_num] = i;
+            }
+        }
+    } else {
+        for (size_t i = 1; i < table_items->row_count + 1; i++) {
+            uint32_t bucket_num = JoinHashMapHelper::calc_direct_mapping_bucket_num<CppType>(
+                    data[i], min_key, bucket_size);
+            table_items->next[i] = table_items->first[bucket_num];
+            table_items->first[bucket_num] = i;
+        }
+    }
+    return Status::OK();
+}
+
 template <PrimitiveType PT>
 Status FixedSizeJoinBuildFunc<PT>::prepare(RuntimeState* state, JoinHashTableItems* table_items,
                                            HashTableProbeState* probe_state) {
@@ -153,7 +182,6 @@ void FixedSizeJoinBuildFunc<PT>::_build_nullable_columns(JoinHashTableItems* tab
 template <PrimitiveType PT>
 Status JoinProbeFunc<PT>::lookup_init(const JoinHashTableItems& table_items,
                                       HashTableProbeState* probe_state) {
-    size_t probe_row_count = probe_state->probe_row_count;
     auto& data = get_key_data(*probe_state);
     JoinHashMapHelper::calc_bucket_nums<CppType>(data, table_items.bucket_size,
                                                  &probe_state->buckets, 0, data.size());
@@ -164,26 +192,16 @@ Status JoinProbeFunc<PT>::lookup_init(const JoinHashTableItems& table_items,
 
         if (nullable_column->has_null()) {
             auto& null_array = nullable_column->null_column()->get_data();
-            for (size_t i = 0; i < probe_row_count; i++) {
-                if (null_array[i] == 0) {
-                    probe_state->next[i] = table_items.first[probe_state->buckets[i]];
-                } else {
-                    probe_state->next[i] = 0;
-                }
-            }
+            JoinHashMapHelper::lookup_bucket_heads(table_items, probe_state, null_array.data());
             probe_state->null_array = &nullable_column->null_column()->get_data();
         } else {
-            for (size_t i = 0; i < probe_row_count; i++) {
-                probe_state->next[i] = table_items.first[probe_state->buckets[i]];
-            }
+            JoinHashMapHelper::lookup_bucket_heads(table_items, probe_state, nullptr);
             probe_state->null_array = nullptr;
         }
         return Status::OK();
     }
 
-    for (size_t i = 0; i < probe_row_count; i++) {
-        probe_state->next[i] = table_items.first[probe_state->buckets[i]];
-    }
+    JoinHashMapHelper::lookup_bucket_heads(table_items, probe_state, nullptr);
     probe_state->null_array = nullptr;
     return Status::OK();
 }
@@ -200,6 +218,41 @@ const Buffer<typename JoinProbeFunc<PT>::CppType>& JoinProbeFunc<PT>::get_key_da
     return ColumnHelper::as_raw_column<ColumnType>((*probe_state.key_columns)[0])->get_data();
 }
 
+template <PrimitiveType PT>
+void JoinProbeFunc<PT>::permute(HashTableProbeState* probe_state, const Buffer<uint32_t>& rows) {
+    // the keys are read from the key columns, which are reordered already, only the null array refers to them.
+    if (probe_state->null_array != nullptr) {
+        auto* nullable_column =
+                ColumnHelper::as_raw_column<NullableColumn>((*probe_state->key_columns)[0]);
+        probe_state->null_array = &nullable_column->null_column()->get_data();
+    }
+}
+
+template <PrimitiveType PT>
+Status DirectMappingJoinProbeFunc<PT>::lookup_init(const JoinHashTableItems& table_items,
+                                                   HashTableProbeState* probe_state) {
+    size_t probe_row_count = probe_state->probe_row_count;
+    auto& data = JoinProbeFunc<PT>::get_key_data(*probe_state);
+    JoinHashMapHelper::calc_direct_mapping_bucket_nums<CppType>(
+            data, table_items.direct_mapping_min_key, table_items.bucket_size,
+            &probe_state->buckets, 0, probe_row_count);
+
+    probe_state->null_array = nullptr;
+    if ((*probe_state->key_columns)[0]->is_nullable()) {
+        auto* nullable_column =
+                ColumnHelper::as_raw_column<NullableColumn>((*probe_state->key_columns)[0]);
+        if (nullable_column->has_null()) {
+            auto& null_array = nullable_column->null_column()->get_data();
+            JoinHashMapHelper::lookup_bucket_heads(table_items, probe_state, null_array.data());
+            probe_state->null_array = &nullable_column->null_column()->get_data();
+            return Status::OK();
+        }
+    }
+
+    JoinHashMapHelper::lookup_bucket_heads(table_items, probe_state, nullptr);
+    return Status::OK();
+}
+
 template <PrimitiveType PT>
 Status FixedSizeJoinProbeFunc<PT>::lookup_init(const JoinHashTableItems& table_items,
                                                HashTableProbeState* probe_state) {
@@ -250,9 +303,7 @@ void FixedSizeJoinProbeFunc<PT>::_probe_column(const JoinHashTableItems& table_i
     JoinHashMapHelper::calc_bucket_nums<CppType>(data, table_items.bucket_size,
                                                  &probe_state->buckets, 0, row_count);
 
-    for (uint32_t i = 0; i < row_count; i++) {
-        probe_state->next[i] = table_items.first[probe_state->buckets[i]];
-    }
+    JoinHashMapHelper::lookup_bucket_heads(table_items, probe_state, nullptr);
 }
 
 template <PrimitiveType PT>
@@ -277,13 +328,7 @@ void FixedSizeJoinProbeFunc<PT>::_probe_nullable_column(const JoinHashTableItems
     JoinHashMapHelper::calc_bucket_nums<CppType>(data, table_items.bucket_size,
                                                  &probe_state->buckets, 0, row_count);
 
-    for (uint32_t i = 0; i < row_count; i++) {
-        if (probe_state->is_nulls[i] == 0) {
-            probe_state->next[i] = table_items.first[probe_state->buckets[i]];
-        } else {
-            probe_state->next[i] = 0;
-        }
-    }
+    JoinHashMapHelper::lookup_bucket_heads(table_items, probe_state, probe_state->is_nulls.data());
 }
 
 template <PrimitiveType PT, class BuildFunc, class ProbeFunc>
@@ -294,6 +339,12 @@ Status JoinHashMap<PT, BuildFunc, ProbeFunc>::build(RuntimeState* state) {
     // construct hash table
     RETURN_IF_ERROR(BuildFunc().construct_hash_table(_table_items, _probe_state));
 
+    // bucket heads, bucket chains and build keys, the probe mostly misses the cache when they are much larger.
+    size_t table_bytes = (_table_items->bucket_size + _table_items->row_count + 1) * sizeof(uint32_t) +
+                         (_table_items->row_count + 1) * sizeof(CppType);
+    _table_items->enable_probe_prefetch =
+            config::enable_join_probe_prefetch && table_bytes >= config::join_probe_prefetch_min_table_bytes;
+
     return Status::OK();
 }
 
@@ -301,7 +352,11 @@ template <PrimitiveType PT, class BuildFunc, class ProbeFunc>
 Status JoinHashMap<PT, BuildFunc, ProbeFunc>::probe(const Columns& key_columns,
                                                     ChunkPtr* probe_chunk, ChunkPtr* chunk,
                                                     bool* has_remain) {
-    _probe_state->key_columns = &key_columns;
+    // the probe of a clustered chunk goes on with the reordered key columns,
+    // see _cluster_probe_rows.
+    if (!_probe_state->has_remain || !_probe_state->probe_rows_clustered) {
+        _probe_state->key_columns = &key_columns;
+    }
     {
         SCOPED_TIMER(_table_items->search_ht_timer);
         RETURN_IF_ERROR(_search_ht(probe_chunk));
@@ -655,20 +710,68 @@ template <PrimitiveType PT, class BuildFunc, class ProbeFunc>
 Status JoinHashMap<PT, BuildFunc, ProbeFunc>::_search_ht(ChunkPtr* probe_chunk) {
     if (!_probe_state->has_remain) {
         _probe_state->probe_row_count = (*probe_chunk)->num_rows();
-        ProbeFunc().prepare(_table_items, _probe_state);
-        RETURN_IF_ERROR(ProbeFunc().lookup_init(*_table_items, _probe_state));
+        _probe_state->probe_rows_clustered = false;
+        {
+            SCOPED_TIMER(_table_items->search_ht_hash_timer);
+            ProbeFunc().prepare(_table_items, _probe_state);
+            RETURN_IF_ERROR(ProbeFunc().lookup_init(*_table_items, _probe_state));
+            if (_table_items->radix_partition_bits > 0) {
+                _cluster_probe_rows(probe_chunk);
+            }
+        }
 
         auto& build_data = BuildFunc().get_key_data(*_table_items);
         auto& probe_data = ProbeFunc().get_key_data(*_probe_state);
+        if (_table_items->enable_probe_prefetch) {
+            SCOPED_TIMER(_table_items->search_ht_prefetch_timer);
+            _prefetch_build_rows(build_data);
+        }
+        SCOPED_TIMER(_table_items->search_ht_match_timer);
         _search_ht_impl<true>(build_data, probe_data);
     } else {
         auto& build_data = BuildFunc().get_key_data(*_table_items);
         auto& probe_data = ProbeFunc().get_key_data(*_probe_state);
+        SCOPED_TIMER(_table_items->search_ht_match_timer);
         _search_ht_impl<false>(build_data, probe_data);
     }
     return Status::OK();
 }
 
+template <PrimitiveType PT, class BuildFunc, class ProbeFunc>
+void JoinHashMap<PT, BuildFunc, ProbeFunc>::_cluster_probe_rows(ChunkPtr* probe_chunk) {
+    auto& rows = _probe_state->clustered_rows;
+    JoinHashMapHelper::radix_cluster_rows(
+            _probe_state->buckets.data(), _probe_state->probe_row_count,
+            _table_items->radix_partition_shift, 1u << _table_items->radix_partition_bits, &rows);
+
+    std::unordered_map<const Column*, ColumnPtr> permuted;
+    _probe_state->clustered_key_columns = *_probe_state->key_columns;
+    JoinHashMapHelper::permute_columns(&_probe_state->clustered_key_columns, rows, &permuted);
+    JoinHashMapHelper::permute_columns(&(*probe_chunk)->columns(), rows, &permuted);
+    _probe_state->key_columns = &_probe_state->clustered_key_columns;
+    _probe_state->probe_rows_clustered = true;
+
+    // the buckets and the keys computed by lookup_init are reordered rather than computed again.
+    JoinHashMapHelper::permute_values(&_probe_state->buckets, rows);
+    JoinHashMapHelper::permute_values(&_probe_state->next, rows);
+    ProbeFunc().permute(_probe_state, rows);
+}
+
+template <PrimitiveType PT, class BuildFunc, class ProbeFunc>
+void JoinHashMap<PT, BuildFunc, ProbeFunc>::_prefetch_build_rows(const Buffer<CppType>& build_data) {
+    // The bucket heads of the whole chunk are known after lookup_init, prefetch the build key and the
+    // chain link of every head, so that the matching loops below find the first row of each chain in cache.
+    const uint32_t* heads = _probe_state->next.data();
+    const uint32_t* next = _table_items->next.data();
+    const CppType* keys = build_data.data();
+    for (size_t i = 0; i < _probe_state->probe_row_count; i++) {
+        if (heads[i] != 0) {
+            __builtin_prefetch(keys + heads[i]);
+            __builtin_prefetch(next + heads[i]);
+        }
+    }
+}
+
 template <PrimitiveType PT, class BuildFunc, class ProbeFunc>
 void JoinHashMap<PT, BuildFunc, ProbeFunc>::_search_ht_remain() {
     if (!_probe_state->has_remain) {
@@ -9,6 +9,7 @@
 #include <algorithm>
 
 #include "column/array_column.h"
+#include "column/binary_column.h"
 #include "column/chunk.h"
 #include "column/column_helper.h"
 #include "column/nullable_column.h"
@@ -279,6 +280,7 @@ Status JsonReader::read_chunk(Chunk* chunk, int32_t rows_to_read, const std::vec
             _next_line = 0;
         }
         _total_lines = (_json_doc->IsArray()) ? _json_doc->Size() : 1;
+        SCOPED_RAW_TIMER(&_counter->fill_ns);
         while (_next_line < _total_lines && rows_to_read > 0) {
             rapidjson::Value* objectValue = _json_doc;
             if (_json_doc->IsArray()) {
@@ -290,11 +292,18 @@ Status JsonReader::read_chunk(Chunk* chunk, int32_t rows_to_read, const std::vec
                         continue;
                     }
                     ColumnPtr& column = chunk->get_column_by_slot_id(slot_desc->id());
-                    const char* column_name = slot_desc->col_name().c_str();
-                    if (!objectValue->IsObject() || !objectValue->HasMember(column_name)) {
+                    if (!objectValue->IsObject()) {
+                        column->append_nulls(1);
+                        continue;
+                    }
+                    // look up the member only once, and without strlen of the column name.
+                    const std::string& column_name = slot_desc->col_name();
+                    auto member = objectValue->FindMember(
+                            rapidjson::StringRef(column_name.data(), column_name.size()));
+                    if (member == objectValue->MemberEnd()) {
                         column->append_nulls(1);
                     } else {
-                        _construct_column((*objectValue)[column_name], column.get(), slot_desc->type());
+                        _construct_column(member->value, column.get(), slot_desc->type());
                     }
                 }
             } else {
@@ -327,6 +336,11 @@ Status JsonReader::read_chunk(Chunk* chunk, int32_t rows_to_read, const std::vec
 
 // read one json string from file read and parse it to json doc.
 Status JsonReader::_read_and_parse_json() {
+    SCOPED_RAW_TIMER(&_counter->read_batch_ns);
+    // Parse never releases the memory of the previous document, which lives in the allocator of
+    // the document, reuse it for the next message instead of growing for every message of the pipe.
+    _origin_json_doc.SetNull();
+    _origin_json_doc.GetAllocator().Clear();
 #ifdef BE_TEST
     [[maybe_unused]] size_t message_size = 0;
     Slice result(_buf.data(), _buf_size);
@@ -384,6 +398,18 @@ Status JsonReader::_read_and_parse_json() {
     return Status::OK();
 }
 
+// The columns of json are all nullable varchar, or nullable array of them, append the value straight
+// to the binary column instead of building a temporary vector for append_strings.
+static inline void _append_string(Column* column, const Slice& value) {
+    if (column->is_nullable()) {
+        auto* nullable_column = down_cast<NullableColumn*>(column);
+        down_cast<BinaryColumn*>(nullable_column->mutable_data_column())->append(value);
+        nullable_column->null_column_data().emplace_back(0);
+    } else {
+        down_cast<BinaryColumn*>(column)->append(value);
+    }
+}
+
 void JsonReader::_construct_column(const rapidjson::Value& objectValue, Column* column,
                                    const TypeDescriptor& type_desc) {
     if (objectValue.GetType() != rapidjson::kArrayType && type_desc.type == TYPE_ARRAY) {
@@ -398,35 +424,35 @@ void JsonReader::_construct_column(const rapidjson::Value& objectValue, Column*
         break;
     }
     case rapidjson::Type::kFalseType: {
-        column->append_strings(std::vector<Slice>{Slice("0")});
+        _append_string(column, Slice("0"));
         break;
     }
     case rapidjson::Type::kTrueType: {
-        column->append_strings(std::vector<Slice>{Slice("1")});
+        _append_string(column, Slice("1"));
         break;
     }
     case rapidjson::Type::kNumberType: {
         if (objectValue.IsUint()) {
             auto f = fmt::format_int(objectValue.GetUint());
-            column->append_strings(std::vector<Slice>{Slice(f.data(), f.size())});
+            _append_string(column, Slice(f.data(), f.size()));
         } else if (objectValue.IsInt()) {
             auto f = fmt::format_int(objectValue.GetInt());
-            column->append_strings(std::vector<Slice>{Slice(f.data(), f.size())});
+            _append_string(column, Slice(f.data(), f.size()));
         } else if (objectValue.IsUint64()) {
             auto f = fmt::format_int(objectValue.GetUint64());
-            column->append_strings(std::vector<Slice>{Slice(f.data(), f.size())});
+            _append_string(column, Slice(f.data(), f.size()));
         } else if (objectValue.IsInt64()) {
             auto f = fmt::format_int(objectValue.GetInt64());
-            column->append_strings(std::vector<Slice>{Slice(f.data(), f.size())});
+            _append_string(column, Slice(f.data(), f.size()));
         } else {
             int len = d2s_buffered_n(objectValue.GetDouble(), buf);
-            column->append_strings(std::vector<Slice>{Slice(buf, len)});
+            _append_string(column, Slice(buf, len));
         }
         break;
     }
     case rapidjson::Type::kStringType: {
         const char* str_value = objectValue.GetString();
-        column->append_strings(std::vector<Slice>{Slice(str_value, objectValue.GetStringLength())});
+        _append_string(column, Slice(str_value, objectValue.GetStringLength()));
         break;
     }
     case rapidjson::Type::kArrayType: {
@@ -445,13 +471,13 @@ void JsonReader::_construct_column(const rapidjson::Value& objectValue, Column*
             offsets->append_numbers(&size, 4);
         } else {
             std::string json_str = JsonFunctions::get_raw_json_string(objectValue);
-            column->append_strings(std::vector<Slice>{Slice(json_str.c_str(), json_str.length())});
+            _append_string(column, Slice(json_str.c_str(), json_str.length()));
         }
         break;
     }
     case rapidjson::Type::kObjectType: {
         std::string json_str = JsonFunctions::get_raw_json_string(objectValue);
-        column->append_strings(std::vector<Slice>{Slice(json_str.c_str(), json_str.length())});
+        _append_string(column, Slice(json_str.c_str(), json_str.length()));
         break;
     }
     }
@@ -0,0 +1,138 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/merge_join_node.h"
+
+#include "column/chunk.h"
+#include "exec/pipeline/mergejoin/merge_join_left_operator.h"
+#include "exec/pipeline/mergejoin/merge_join_right_sink_operator.h"
+#include "exec/pipeline/operator.h"
+#include "exec/pipeline/pipeline_builder.h"
+#include "exprs/expr.h"
+#include "runtime/runtime_state.h"
+
+namespace starrocks::vectorized {
+
+MergeJoinNode::MergeJoinNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs)
+        : ExecNode(pool, tnode, descs) {}
+
+Status MergeJoinNode::init(const TPlanNode& tnode, RuntimeState* state) {
+    RETURN_IF_ERROR(ExecNode::init(tnode, state));
+
+    for (const auto& cmp_conjunct : tnode.merge_join_node.cmp_conjuncts) {
+        if (cmp_conjunct.__isset.opcode && cmp_conjunct.opcode == TExprOpcode::EQ_FOR_NULL) {
+            return Status::NotSupported("merge join does not support null-safe equal");
+        }
+        ExprContext* ctx = nullptr;
+        RETURN_IF_ERROR(Expr::create_expr_tree(_pool, cmp_conjunct.left, &ctx));
+        _left_key_ctxs.push_back(ctx);
+        RETURN_IF_ERROR(Expr::create_expr_tree(_pool, cmp_conjunct.right, &ctx));
+        _right_key_ctxs.push_back(ctx);
+    }
+    if (_left_key_ctxs.empty()) {
+        return Status::InternalError("merge join requires equal join conditions");
+    }
+    return Expr::create_expr_trees(_pool, tnode.merge_join_node.other_join_conjuncts, &_other_join_conjunct_ctxs);
+}
+
+Status MergeJoinNode::prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(ExecNode::prepare(state));
+
+    _left_rows_counter = ADD_COUNTER(runtime_profile(), "LeftRows", TUnit::UNIT);
+    _right_rows_counter = ADD_COUNTER(runtime_profile(), "RightRows", TUnit::UNIT);
+
+    std::vector<ExprContext*> conjunct_ctxs(_other_join_conjunct_ctxs);
+    conjunct_ctxs.insert(conjunct_ctxs.end(), _conjunct_ctxs.begin(), _conjunct_ctxs.end());
+    _merge_joiner = std::make_shared<MergeJoiner>(std::vector<ExprContext*>(_left_key_ctxs),
+                                                  std::vector<ExprContext*>(_right_key_ctxs), std::move(conjunct_ctxs),
+                                                  child(0)->row_desc(), child(1)->row_desc(), _row_descriptor);
+    return _merge_joiner->prepare(state);
+}
+
+Status MergeJoinNode::open(RuntimeState* state) {
+    SCOPED_TIMER(_runtime_profile->total_time_counter());
+    RETURN_IF_ERROR(ExecNode::open(state));
+    RETURN_IF_ERROR(child(0)->open(state));
+    return child(1)->open(state);
+}
+
+Status MergeJoinNode::get_next(RuntimeState* state, RowBatch* row_batch, bool* eos) {
+    return Status::NotSupported("get_next for row_batch is not supported");
+}
+
+Status MergeJoinNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
+    SCOPED_TIMER(_runtime_profile->total_time_counter());
+    RETURN_IF_CANCELLED(state);
+
+    while (true) {
+        if (_merge_joiner->is_finished() || reached_limit()) {
+            *eos = true;
+            return Status::OK();
+        }
+        // Pull the child which the joiner is waiting for.
+        if (_merge_joiner->need_left() || _merge_joiner->need_right()) {
+            bool is_left = _merge_joiner->need_left();
+            ChunkPtr input;
+            bool input_eos = false;
+            RETURN_IF_ERROR(child(is_left ? 0 : 1)->get_next(state, &input, &input_eos));
+            if (input_eos) {
+                is_left ? _merge_joiner->set_left_eos() : _merge_joiner->set_right_eos();
+            } else if (is_left) {
+                COUNTER_UPDATE(_left_rows_counter, input->num_rows());
+                RETURN_IF_ERROR(_merge_joiner->push_left(input));
+            } else {
+                COUNTER_UPDATE(_right_rows_counter, input->num_rows());
+                RETURN_IF_ERROR(_merge_joiner->push_right(input));
+            }
+            continue;
+        }
+        RETURN_IF_ERROR(_merge_joiner->pull_chunk(chunk));
+        if ((*chunk)->num_rows() > 0) {
+            break;
+        }
+    }
+
+    _num_rows_returned += (*chunk)->num_rows();
+    if (reached_limit()) {
+        (*chunk)->set_num_rows((*chunk)->num_rows() - (_num_rows_returned - _limit));
+        _num_rows_returned = _limit;
+    }
+    COUNTER_SET(_rows_returned_counter, _num_rows_returned);
+    *eos = false;
+    DCHECK_CHUNK(*chunk);
+    return Status::OK();
+}
+
+Status MergeJoinNode::close(RuntimeState* state) {
+    if (is_closed()) {
+        return Status::OK();
+    }
+    if (_merge_joiner != nullptr) {
+        _merge_joiner->close(state);
+    }
+    return ExecNode::close(state);
+}
+
+pipeline::OpFactories MergeJoinNode::decompose_to_pipeline(pipeline::PipelineBuilderContext* context) {
+    using namespace pipeline;
+
+    std::vector<ExprContext*> conjunct_ctxs(std::move(_other_join_conjunct_ctxs));
+    conjunct_ctxs.insert(conjunct_ctxs.end(), _conjunct_ctxs.begin(), _conjunct_ctxs.end());
+    auto merge_joiner = std::make_shared<MergeJoiner>(std::move(_left_key_ctxs), std::move(_right_key_ctxs),
+                                                      std::move(conjunct_ctxs), child(0)->row_desc(),
+                                                      child(1)->row_desc(), _row_descriptor);
+
+    // Both children must output their rows in order by a single driver, e.g. a sort or a merging exchange.
+    OpFactories right_operators = _children[1]->decompose_to_pipeline(context);
+    right_operators = context->maybe_interpolate_local_passthrough_exchange(right_operators);
+    right_operators.emplace_back(
+            std::make_shared<MergeJoinRightSinkOperatorFactory>(context->next_operator_id(), id(), merge_joiner));
+    context->add_pipeline(right_operators);
+
+    OpFactories left_operators = _children[0]->decompose_to_pipeline(context);
+    left_operators = context->maybe_interpolate_local_passthrough_exchange(left_operators);
+    left_operators.emplace_back(
+            std::make_shared<MergeJoinLeftOperatorFactory>(context->next_operator_id(), id(), std::move(merge_joiner)));
+    return left_operators;
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,42 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "exec/exec_node.h"
+#include "exec/vectorized/merge_joiner.h"
+
+namespace starrocks::vectorized {
+
+// Node for the inner equi-join of two children both sorted by the join keys in ascending order,
+// which merges the rows of the two children by MergeJoiner without building a hash table.
+//
+// Both children are pulled in a streaming way, so only the current left chunk and the group of
+// right rows with the current keys are held. In pipeline engine, the right rows are buffered
+// before merging, like the other joins, and released as soon as the left keys have passed them.
+class MergeJoinNode final : public ExecNode {
+public:
+    MergeJoinNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs);
+    ~MergeJoinNode() override = default;
+
+    Status init(const TPlanNode& tnode, RuntimeState* state) override;
+    Status prepare(RuntimeState* state) override;
+    Status open(RuntimeState* state) override;
+    Status get_next(RuntimeState* state, RowBatch* row_batch, bool* eos) override;
+    Status get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) override;
+    Status close(RuntimeState* state) override;
+
+    std::vector<std::shared_ptr<pipeline::OperatorFactory>> decompose_to_pipeline(
+            pipeline::PipelineBuilderContext* context) override;
+
+private:
+    std::vector<ExprContext*> _left_key_ctxs;
+    std::vector<ExprContext*> _right_key_ctxs;
+    std::vector<ExprContext*> _other_join_conjunct_ctxs;
+
+    MergeJoinerPtr _merge_joiner;
+
+    RuntimeProfile::Counter* _left_rows_counter = nullptr;
+    RuntimeProfile::Counter* _right_rows_counter = nullptr;
+};
+
+} // namespace starrocks::vectorized
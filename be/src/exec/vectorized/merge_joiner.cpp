@@ -0,0 +1,292 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/merge_joiner.h"
+
+#include <algorithm>
+
+#include "column/column_helper.h"
+#include "column/nullable_column.h"
+#include "common/config.h"
+#include "exec/exec_node.h"
+#include "exprs/expr.h"
+#include "gutil/casts.h"
+
+namespace starrocks::vectorized {
+
+MergeJoiner::MergeJoiner(std::vector<ExprContext*>&& left_key_ctxs, std::vector<ExprContext*>&& right_key_ctxs,
+                         std::vector<ExprContext*>&& conjunct_ctxs, const RowDescriptor& left_row_desc,
+                         const RowDescriptor& right_row_desc, const RowDescriptor& row_desc)
+        : _left_key_ctxs(std::move(left_key_ctxs)),
+          _right_key_ctxs(std::move(right_key_ctxs)),
+          _conjunct_ctxs(std::move(conjunct_ctxs)),
+          _left_row_desc(left_row_desc),
+          _right_row_desc(right_row_desc),
+          _row_desc(row_desc) {
+    DCHECK_EQ(_left_key_ctxs.size(), _right_key_ctxs.size());
+}
+
+Status MergeJoiner::prepare(RuntimeState* state) {
+    RETURN_IF_ERROR(Expr::prepare(_left_key_ctxs, state, _left_row_desc));
+    RETURN_IF_ERROR(Expr::prepare(_right_key_ctxs, state, _right_row_desc));
+    RETURN_IF_ERROR(Expr::prepare(_conjunct_ctxs, state, _row_desc));
+    RETURN_IF_ERROR(Expr::open(_left_key_ctxs, state));
+    RETURN_IF_ERROR(Expr::open(_right_key_ctxs, state));
+    return Expr::open(_conjunct_ctxs, state);
+}
+
+void MergeJoiner::close(RuntimeState* state) {
+    Expr::close(_left_key_ctxs, state);
+    Expr::close(_right_key_ctxs, state);
+    Expr::close(_conjunct_ctxs, state);
+}
+
+Status MergeJoiner::_evaluate_keys(const std::vector<ExprContext*>& key_ctxs, const ChunkPtr& chunk,
+                                   KeyedChunk* keyed) {
+    size_t num_rows = chunk->num_rows();
+    keyed->chunk = chunk;
+    keyed->null_keys.assign(num_rows, 0);
+    for (ExprContext* key_ctx : key_ctxs) {
+        ColumnPtr key = ColumnHelper::unpack_and_duplicate_const_column(num_rows, key_ctx->evaluate(chunk.get()));
+        if (key->is_nullable()) {
+            const auto& nulls = down_cast<NullableColumn*>(key.get())->immutable_null_column_data();
+            for (size_t i = 0; i < num_rows; ++i) {
+                keyed->null_keys[i] |= nulls[i];
+            }
+        }
+        keyed->data_keys.emplace_back(ColumnHelper::get_data_column(key.get()));
+        keyed->keys.emplace_back(std::move(key));
+    }
+    return Status::OK();
+}
+
+int MergeJoiner::_compare(const KeyedChunk& lhs, size_t lhs_row, const KeyedChunk& rhs, size_t rhs_row) {
+    for (size_t i = 0; i < lhs.data_keys.size(); ++i) {
+        int cmp = lhs.data_keys[i]->compare_at(lhs_row, rhs_row, *rhs.data_keys[i], 1);
+        if (cmp != 0) {
+            return cmp;
+        }
+    }
+    return 0;
+}
+
+Status MergeJoiner::push_left(const ChunkPtr& chunk) {
+    DCHECK(need_left());
+    if (chunk == nullptr || chunk->num_rows() == 0) {
+        return Status::OK();
+    }
+    _left = KeyedChunk();
+    RETURN_IF_ERROR(_evaluate_keys(_left_key_ctxs, chunk, &_left));
+    _left_pos = 0;
+    return Status::OK();
+}
+
+Status MergeJoiner::push_right(const ChunkPtr& chunk) {
+    if (chunk == nullptr || chunk->num_rows() == 0) {
+        return Status::OK();
+    }
+    KeyedChunk right;
+    RETURN_IF_ERROR(_evaluate_keys(_right_key_ctxs, chunk, &right));
+    _rights.emplace_back(std::move(right));
+    _is_right_starving = false;
+    return Status::OK();
+}
+
+void MergeJoiner::set_left_eos() {
+    _left_eos = true;
+    _update_finished();
+}
+
+void MergeJoiner::set_right_eos() {
+    _right_eos = true;
+    _is_right_starving = false;
+    _update_finished();
+    _is_right_complete.store(true, std::memory_order_release);
+}
+
+void MergeJoiner::_update_finished() {
+    _is_finished = (_left_eos && _left_pos >= _left_rows()) || (_right_eos && _rights.empty());
+}
+
+bool MergeJoiner::_seek_right() {
+    while (true) {
+        if (_rights.empty()) {
+            _is_right_starving = true;
+            return false;
+        }
+        const KeyedChunk& first = _rights.front();
+        if (_right_pos >= first.chunk->num_rows()) {
+            // the pending rows may refer to the first right chunk.
+            _flush_joined_rows();
+            _rights.pop_front();
+            _right_pos = 0;
+            _reset_right_group();
+            continue;
+        }
+        if (first.null_keys[_right_pos] || _compare(_left, _left_pos, first, _right_pos) > 0) {
+            ++_right_pos;
+            _reset_right_group();
+            continue;
+        }
+        return true;
+    }
+}
+
+bool MergeJoiner::_seek_right_group_end() {
+    if (_group_end_found) {
+        return true;
+    }
+    if (!_is_seeking_group_end) {
+        _is_seeking_group_end = true;
+        _group_end_index = 0;
+        _group_end_pos = _right_pos + 1;
+    }
+    const KeyedChunk& first = _rights.front();
+    while (true) {
+        if (_group_end_index >= _rights.size()) {
+            if (_right_eos) {
+                _group_end_found = true;
+                return true;
+            }
+            _is_right_starving = true;
+            return false;
+        }
+        const KeyedChunk& right = _rights[_group_end_index];
+        if (_group_end_pos >= right.chunk->num_rows()) {
+            ++_group_end_index;
+            _group_end_pos = 0;
+            continue;
+        }
+        if (right.null_keys[_group_end_pos] || _compare(first, _right_pos, right, _group_end_pos) != 0) {
+            _group_end_found = true;
+            return true;
+        }
+        ++_group_end_pos;
+    }
+}
+
+Status MergeJoiner::pull_chunk(ChunkPtr* chunk) {
+    const size_t chunk_size = config::vector_chunk_size;
+    auto num_joined_rows = [this]() {
+        return (_output == nullptr ? 0 : _output->num_rows()) + _left_selection.size();
+    };
+    while (!_is_finished && num_joined_rows() < chunk_size) {
+        if (_left_pos >= _left_rows()) {
+            break;
+        }
+        if (_left.null_keys[_left_pos]) {
+            ++_left_pos;
+            continue;
+        }
+        if (!_seek_right()) {
+            break;
+        }
+        if (_compare(_left, _left_pos, _rights.front(), _right_pos) < 0) {
+            ++_left_pos;
+            continue;
+        }
+        if (!_seek_right_group_end()) {
+            break;
+        }
+        // join the current left row with the group of right rows with the same keys,
+        // go on with the rest of the group in the next output chunk if this one is full.
+        if (!_is_joining_group) {
+            _is_joining_group = true;
+            _join_index = 0;
+            _join_pos = _right_pos;
+        }
+        while (_join_index <= _group_end_index && _join_index < _rights.size()) {
+            size_t capacity = chunk_size - num_joined_rows();
+            if (capacity == 0) {
+                break;
+            }
+            size_t end = _join_index == _group_end_index ? _group_end_pos : _rights[_join_index].chunk->num_rows();
+            size_t stop = std::min(end, _join_pos + capacity);
+            if (_join_pos < stop) {
+                _append_joined_rows(_join_index, _join_pos, stop);
+                _join_pos = stop;
+            }
+            if (_join_pos >= end) {
+                ++_join_index;
+                _join_pos = 0;
+            }
+        }
+        if (_join_index <= _group_end_index && _join_index < _rights.size()) {
+            break;
+        }
+        _is_joining_group = false;
+        ++_left_pos;
+    }
+    _flush_joined_rows();
+    _update_finished();
+
+    if (_output == nullptr) {
+        *chunk = std::make_shared<Chunk>();
+        return Status::OK();
+    }
+    *chunk = std::move(_output);
+    _output = nullptr;
+    if (!_conjunct_ctxs.empty()) {
+        ExecNode::eval_conjuncts(_conjunct_ctxs, chunk->get());
+    }
+    return Status::OK();
+}
+
+void MergeJoiner::_init_output_columns(const RowDescriptor& row_desc, const Chunk& src) {
+    for (TupleDescriptor* tuple_desc : row_desc.tuple_descriptors()) {
+        for (SlotDescriptor* slot : tuple_desc->slots()) {
+            if (src.is_slot_exist(slot->id())) {
+                _output->append_column(src.get_column_by_slot_id(slot->id())->clone_empty(), slot->id());
+            }
+        }
+        if (_row_desc.get_tuple_idx(tuple_desc->id()) != RowDescriptor::INVALID_IDX &&
+            src.is_tuple_exist(tuple_desc->id())) {
+            _output->append_tuple_column(src.get_tuple_column_by_id(tuple_desc->id())->clone_empty(),
+                                         tuple_desc->id());
+        }
+    }
+}
+
+void MergeJoiner::_append_joined_rows(size_t right_index, size_t begin, size_t end) {
+    if (right_index != _pending_right_index) {
+        _flush_joined_rows();
+        _pending_right_index = right_index;
+    }
+    for (size_t i = begin; i < end; ++i) {
+        _left_selection.emplace_back(_left_pos);
+        _right_selection.emplace_back(i);
+    }
+}
+
+void MergeJoiner::_flush_joined_rows() {
+    if (_left_selection.empty()) {
+        return;
+    }
+    if (_output == nullptr) {
+        _output = std::make_shared<Chunk>();
+        _init_output_columns(_left_row_desc, *_left.chunk);
+        _init_output_columns(_right_row_desc, *_rights[_pending_right_index].chunk);
+    }
+    _append_output_columns(_left_row_desc, *_left.chunk, _left_selection);
+    _append_output_columns(_right_row_desc, *_rights[_pending_right_index].chunk, _right_selection);
+    _left_selection.clear();
+    _right_selection.clear();
+}
+
+void MergeJoiner::_append_output_columns(const RowDescriptor& row_desc, const Chunk& src,
+                                         const std::vector<uint32_t>& selection) {
+    auto num_rows = static_cast<uint32_t>(selection.size());
+    for (TupleDescriptor* tuple_desc : row_desc.tuple_descriptors()) {
+        for (SlotDescriptor* slot : tuple_desc->slots()) {
+            if (src.is_slot_exist(slot->id())) {
+                _output->get_column_by_slot_id(slot->id())
+                        ->append_selective(*src.get_column_by_slot_id(slot->id()), selection.data(), 0, num_rows);
+            }
+        }
+        if (_output->is_tuple_exist(tuple_desc->id())) {
+            _output->get_tuple_column_by_id(tuple_desc->id())
+                    ->append_selective(*src.get_tuple_column_by_id(tuple_desc->id()), selection.data(), 0, num_rows);
+        }
+    }
+}
+
+} // namespace starrocks::vectorized
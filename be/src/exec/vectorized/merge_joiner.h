@@ -0,0 +1,134 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "column/chunk.h"
+#include "column/vectorized_fwd.h"
+#include "common/status.h"
+#include "exprs/expr_context.h"
+#include "runtime/descriptors.h"
+
+namespace starrocks {
+
+class RuntimeState;
+
+namespace vectorized {
+
+class MergeJoiner;
+using MergeJoinerPtr = std::shared_ptr<MergeJoiner>;
+
+// Inner join of two inputs which are both sorted by the join keys in ascending order,
+// e.g. read from the colocated duplicate key tablets in the order of their sort keys.
+//
+// The left and right rows are merged by comparing the join keys column by column, the same way
+// as SortedChunksMerger compares the rows of the sorted runs, so no hash table is built.
+// Only the current left chunk and the right chunks from the first row not less than the current
+// left keys are kept, hence the memory is bounded by the largest group of right rows with equal keys.
+// The rows with a NULL key never match.
+//
+// It is driven by the caller: feed the chunk of the side that need_left() or need_right() asks for,
+// and pull the joined rows until is_finished().
+class MergeJoiner {
+public:
+    MergeJoiner(std::vector<ExprContext*>&& left_key_ctxs, std::vector<ExprContext*>&& right_key_ctxs,
+                std::vector<ExprContext*>&& conjunct_ctxs, const RowDescriptor& left_row_desc,
+                const RowDescriptor& right_row_desc, const RowDescriptor& row_desc);
+
+    Status prepare(RuntimeState* state);
+    void close(RuntimeState* state);
+
+    // Whether the next chunk of the left or the right input is needed to go on joining.
+    bool need_left() const { return !_left_eos && _left_pos >= _left_rows(); }
+    bool need_right() const { return !_right_eos && _is_right_starving; }
+    // Whether no more rows can be joined.
+    bool is_finished() const { return _is_finished; }
+
+    Status push_left(const ChunkPtr& chunk);
+    Status push_right(const ChunkPtr& chunk);
+    void set_left_eos();
+    void set_right_eos();
+    // Whether set_right_eos() has been called, it can be called by another thread than the one feeding the rows.
+    bool is_right_complete() const { return _is_right_complete.load(std::memory_order_acquire); }
+
+    // Join the rows until the output has config::vector_chunk_size rows or some input is needed,
+    // the output may be empty.
+    Status pull_chunk(ChunkPtr* chunk);
+
+private:
+    struct KeyedChunk {
+        ChunkPtr chunk;
+        Columns keys;
+        // the data columns of the join keys, to be compared.
+        std::vector<const Column*> data_keys;
+        // whether any of the join keys is NULL.
+        Buffer<uint8_t> null_keys;
+    };
+
+    Status _evaluate_keys(const std::vector<ExprContext*>& key_ctxs, const ChunkPtr& chunk, KeyedChunk* keyed);
+    size_t _left_rows() const { return _left.chunk == nullptr ? 0 : _left.chunk->num_rows(); }
+
+    static int _compare(const KeyedChunk& lhs, size_t lhs_row, const KeyedChunk& rhs, size_t rhs_row);
+
+    // Skip the right rows less than the current left row.
+    // Return false if more right rows are needed to know.
+    bool _seek_right();
+    // Find the end of the group of right rows equal to the first right row.
+    // Return false if more right rows are needed to know.
+    bool _seek_right_group_end();
+    void _reset_right_group() {
+        _is_seeking_group_end = false;
+        _group_end_found = false;
+    }
+    void _update_finished();
+
+    void _append_joined_rows(size_t right_index, size_t begin, size_t end);
+    void _flush_joined_rows();
+    void _init_output_columns(const RowDescriptor& row_desc, const Chunk& src);
+    void _append_output_columns(const RowDescriptor& row_desc, const Chunk& src,
+                                const std::vector<uint32_t>& selection);
+
+    std::vector<ExprContext*> _left_key_ctxs;
+    std::vector<ExprContext*> _right_key_ctxs;
+    std::vector<ExprContext*> _conjunct_ctxs;
+    const RowDescriptor& _left_row_desc;
+    const RowDescriptor& _right_row_desc;
+    const RowDescriptor& _row_desc;
+
+    KeyedChunk _left;
+    size_t _left_pos = 0;
+    bool _left_eos = false;
+
+    // the right chunks from the one of the first right row _right_pos.
+    std::deque<KeyedChunk> _rights;
+    size_t _right_pos = 0;
+    bool _right_eos = false;
+    std::atomic<bool> _is_right_complete = false;
+    // the end of the group of right rows equal to the first right row, if _group_end_found,
+    // otherwise where to go on seeking the end if _is_seeking_group_end.
+    bool _is_seeking_group_end = false;
+    bool _group_end_found = false;
+    size_t _group_end_index = 0;
+    size_t _group_end_pos = 0;
+    // the next right row of the group to join with the current left row, if _is_joining_group.
+    bool _is_joining_group = false;
+    size_t _join_index = 0;
+    size_t _join_pos = 0;
+    // Whether more right rows are needed before the join can go on.
+    bool _is_right_starving = true;
+
+    bool _is_finished = false;
+
+    ChunkPtr _output;
+    // the pending joined rows of the current left chunk and the right chunk _pending_right_index.
+    std::vector<uint32_t> _left_selection;
+    std::vector<uint32_t> _right_selection;
+    size_t _pending_right_index = 0;
+};
+
+} // namespace vectorized
+} // namespace starrocks
@@ -2,6 +2,7 @@
 
 #include "mysql_scan_node.h"
 
+#include <algorithm>
 #include <sstream>
 
 #include "column/binary_column.h"
@@ -12,6 +13,7 @@
 #include "exec/text_converter.hpp"
 #include "exprs/slot_ref.h"
 #include "gen_cpp/PlanNodes_types.h"
+#include "gutil/strings/substitute.h"
 #include "runtime/date_value.hpp"
 #include "runtime/decimalv2_value.h"
 #include "runtime/decimalv3.h"
@@ -80,7 +82,16 @@ Status MysqlScanNode::open(RuntimeState* state) {
     RETURN_IF_CANCELLED(state);
     SCOPED_TIMER(_runtime_profile->total_time_counter());
     RETURN_IF_ERROR(_mysql_scanner->open());
-    RETURN_IF_ERROR(_mysql_scanner->query(_table_name, _columns, _filters));
+    // Scan the ranges of the key by the connections of their own instead if the table can be split.
+    std::vector<std::string> range_filters;
+    if (config::mysql_scan_parallelism > 1) {
+        ASSIGN_OR_RETURN(range_filters, split_key_ranges(config::mysql_scan_parallelism));
+    }
+    if (range_filters.size() > 1) {
+        RETURN_IF_ERROR(open_split_scanners(range_filters));
+    } else {
+        RETURN_IF_ERROR(_mysql_scanner->query(_table_name, _columns, _filters));
+    }
     // check materialize slot num
     int materialize_num = 0;
 
@@ -90,10 +101,16 @@ Status MysqlScanNode::open(RuntimeState* state) {
         }
     }
 
-    if (_mysql_scanner->field_num() != materialize_num) {
+    MysqlScanner* scanner = _split_scanners.empty() ? _mysql_scanner.get() : _split_scanners[0].get();
+    if (scanner->field_num() != materialize_num) {
         return Status::InternalError("input and output not equal.");
     }
 
+    _num_running_scanners = _split_scanners.size();
+    for (auto& split_scanner : _split_scanners) {
+        _scanner_threads.emplace_back(&MysqlScanNode::split_scanner_scan, this, state, split_scanner.get());
+    }
+
     return Status::OK();
 }
 
@@ -300,6 +317,36 @@ Status MysqlScanNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos)
         return Status::OK();
     }
 
+    if (!_scanner_threads.empty()) {
+        if (!_result_chunks.blocking_get(chunk)) {
+            // all the scanners have finished.
+            _is_finished = true;
+            std::lock_guard<SpinLock> l(_status_mutex);
+            RETURN_IF_ERROR(_process_status);
+        }
+    } else {
+        bool mysql_eos = false;
+        RETURN_IF_ERROR(fill_chunk(state, _mysql_scanner.get(), chunk, &mysql_eos));
+        // if the chunk has rows, eos will be set to true in the next call.
+        _is_finished = mysql_eos;
+    }
+    if (*chunk == nullptr || (*chunk)->num_rows() == 0) {
+        *eos = true;
+        return Status::OK();
+    }
+
+    _num_rows_returned += (*chunk)->num_rows();
+    if (reached_limit()) {
+        (*chunk)->set_num_rows((*chunk)->num_rows() - (_num_rows_returned - _limit));
+        _num_rows_returned = _limit;
+        _is_finished = true;
+    }
+    COUNTER_SET(_rows_returned_counter, _num_rows_returned);
+    *eos = false;
+    return Status::OK();
+}
+
+Status MysqlScanNode::fill_chunk(RuntimeState* state, MysqlScanner* scanner, ChunkPtr* chunk, bool* eos) {
     *chunk = std::make_shared<Chunk>();
     std::vector<SlotDescriptor*> slot_descs = _tuple_desc->slots();
     // init column information
@@ -308,43 +355,18 @@ Status MysqlScanNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos)
         (*chunk)->append_column(std::move(column), slot_desc->id());
     }
 
-    // indicates whether there are more rows to process. Set in _hbase_scanner.next().
-    bool mysql_eos = false;
-    int row_num = 0;
-
-    while (true) {
+    *eos = false;
+    for (int row_num = 0; row_num < config::vector_chunk_size; ++row_num) {
         RETURN_IF_CANCELLED(state);
 
-        if (reached_limit()) {
-            _is_finished = true;
-            // if row_num is greater than 0, in this call, eos = false, and eos will be set to true
-            // in the next call
-            if (row_num == 0) {
-                *eos = true;
-            }
-            return Status::OK();
-        }
-
-        if (row_num >= config::vector_chunk_size) {
-            return Status::OK();
-        }
-
         // read mysql
         char** data = nullptr;
         size_t* length = nullptr;
-        RETURN_IF_ERROR(_mysql_scanner->get_next_row(&data, &length, &mysql_eos));
-        if (mysql_eos) {
-            _is_finished = true;
-            // if row_num is greater than 0, in this call, eos = false, and eos will be set to true
-            // in the next call
-            if (row_num == 0) {
-                *eos = true;
-            }
+        RETURN_IF_ERROR(scanner->get_next_row(&data, &length, eos));
+        if (*eos) {
             return Status::OK();
         }
 
-        ++row_num;
-
         int materialized_col_idx = -1;
         for (size_t col_idx = 0; col_idx < _slot_num; ++col_idx) {
             SlotDescriptor* slot_desc = slot_descs[col_idx];
@@ -370,9 +392,124 @@ Status MysqlScanNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos)
                                                       slot_desc, column.get()));
             }
         }
+    }
+    return Status::OK();
+}
 
-        ++_num_rows_returned;
-        COUNTER_SET(_rows_returned_counter, _num_rows_returned);
+// Read all the rows of the last query of |scanner|, the first column of the first row into |value| if any.
+static Status read_first_value(MysqlScanner* scanner, std::string* value, bool* found) {
+    *found = false;
+    bool eos = false;
+    while (true) {
+        char** data = nullptr;
+        size_t* length = nullptr;
+        RETURN_IF_ERROR(scanner->get_next_row(&data, &length, &eos));
+        if (eos) {
+            return Status::OK();
+        }
+        if (!*found && data[0] != nullptr) {
+            value->assign(data[0], length[0]);
+            *found = true;
+        }
+    }
+}
+
+StatusOr<std::vector<std::string>> MysqlScanNode::split_key_ranges(int num_ranges) {
+    std::string table = _table_name;
+    table.erase(std::remove(table.begin(), table.end(), '`'), table.end());
+    std::string key;
+    bool found = false;
+    RETURN_IF_ERROR(_mysql_scanner->query(strings::Substitute(
+            "SELECT COLUMN_NAME FROM information_schema.KEY_COLUMN_USAGE WHERE TABLE_SCHEMA = '$0' AND "
+            "TABLE_NAME = '$1' AND CONSTRAINT_NAME = 'PRIMARY' ORDER BY ORDINAL_POSITION",
+            _my_param.db, table)));
+    RETURN_IF_ERROR(read_first_value(_mysql_scanner.get(), &key, &found));
+    if (!found) {
+        return std::vector<std::string>();
+    }
+    key = "`" + key + "`";
+
+    std::string min_str;
+    std::string max_str;
+    RETURN_IF_ERROR(_mysql_scanner->query(_table_name, {"MIN(" + key + ")"}, _filters));
+    RETURN_IF_ERROR(read_first_value(_mysql_scanner.get(), &min_str, &found));
+    // the MIN of an empty table is NULL.
+    if (!found) {
+        return std::vector<std::string>();
+    }
+    RETURN_IF_ERROR(_mysql_scanner->query(_table_name, {"MAX(" + key + ")"}, _filters));
+    RETURN_IF_ERROR(read_first_value(_mysql_scanner.get(), &max_str, &found));
+    return split_int_key_range(key, min_str, max_str, num_ranges);
+}
+
+std::vector<std::string> MysqlScanNode::split_int_key_range(const std::string& key, const std::string& min_str,
+                                                            const std::string& max_str, int num_ranges) {
+    StringParser::ParseResult min_result;
+    StringParser::ParseResult max_result;
+    auto min = StringParser::string_to_int<int64_t>(min_str.data(), min_str.size(), &min_result);
+    auto max = StringParser::string_to_int<int64_t>(max_str.data(), max_str.size(), &max_result);
+    // only an integer key is split.
+    if (num_ranges <= 1 || min_result != StringParser::PARSE_SUCCESS || max_result != StringParser::PARSE_SUCCESS ||
+        min > max) {
+        return std::vector<std::string>();
+    }
+
+    const __int128 step = (static_cast<__int128>(max) - min) / num_ranges + 1;
+    std::vector<std::string> range_filters;
+    for (int i = 0; i < num_ranges; ++i) {
+        const __int128 lower = min + step * i;
+        if (lower > max) {
+            break;
+        }
+        // the first and the last ranges are unbounded, for the rows written after the min and max are queried.
+        std::string filter;
+        if (i > 0) {
+            filter = strings::Substitute("$0 >= $1", key, static_cast<int64_t>(lower));
+        }
+        if (i + 1 < num_ranges && lower + step <= max) {
+            filter += strings::Substitute("$0$1 < $2", filter.empty() ? "" : " AND ", key,
+                                          static_cast<int64_t>(lower + step));
+        }
+        range_filters.push_back(filter.empty() ? "1 = 1" : filter);
+    }
+    return range_filters;
+}
+
+Status MysqlScanNode::open_split_scanners(const std::vector<std::string>& range_filters) {
+    for (const auto& range_filter : range_filters) {
+        auto scanner = std::make_unique<MysqlScanner>(_my_param);
+        RETURN_IF_ERROR(scanner->open());
+        std::vector<std::string> filters(_filters);
+        filters.push_back(range_filter);
+        RETURN_IF_ERROR(scanner->query(_table_name, _columns, filters));
+        _split_scanners.push_back(std::move(scanner));
+    }
+    return Status::OK();
+}
+
+void MysqlScanNode::split_scanner_scan(RuntimeState* state, MysqlScanner* scanner) {
+    bool eos = false;
+    while (!eos) {
+        ChunkPtr chunk;
+        Status st = fill_chunk(state, scanner, &chunk, &eos);
+        if (!st.ok()) {
+            update_status(st);
+            _result_chunks.shutdown();
+            break;
+        }
+        if (chunk->num_rows() > 0 && !_result_chunks.blocking_put(std::move(chunk))) {
+            break;
+        }
+    }
+    if (--_num_running_scanners == 0) {
+        _result_chunks.shutdown();
+    }
+}
+
+void MysqlScanNode::update_status(const Status& status) {
+    std::lock_guard<SpinLock> l(_status_mutex);
+    if (_process_status.ok()) {
+        _process_status = status;
     }
 }
 
@@ -387,6 +524,11 @@ Status MysqlScanNode::close(RuntimeState* state) {
     RETURN_IF_ERROR(exec_debug_action(TExecNodePhase::CLOSE));
     SCOPED_TIMER(_runtime_profile->total_time_counter());
 
+    _result_chunks.shutdown();
+    for (auto& thread : _scanner_threads) {
+        thread.join();
+    }
+    _split_scanners.clear();
     _tuple_pool.reset();
 
     return ScanNode::close(state);
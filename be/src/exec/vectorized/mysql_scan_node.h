@@ -2,13 +2,19 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
+#include <thread>
+#include <vector>
 
 #include "column/chunk.h"
 #include "column/vectorized_fwd.h"
+#include "common/statusor.h"
 #include "exec/mysql_scanner.h"
 #include "exec/scan_node.h"
 #include "runtime/descriptors.h"
+#include "util/blocking_queue.hpp"
+#include "util/spinlock.h"
 
 namespace starrocks {
 
@@ -57,6 +63,26 @@ private:
     template <PrimitiveType PT, typename CppType = RunTimeCppType<PT>>
     void append_value_to_column(Column* column, CppType& value);
 
+    // Fill a chunk of at most config::vector_chunk_size rows read by |scanner|.
+    Status fill_chunk(RuntimeState* state, MysqlScanner* scanner, ChunkPtr* chunk, bool* eos);
+
+    // Returns the filters splitting the table by the ranges of its integer primary key, or an empty vector if
+    // the table can't be split.
+    StatusOr<std::vector<std::string>> split_key_ranges(int num_ranges);
+
+    // Returns the filters splitting the integer |key| between |min_str| and |max_str| into at most |num_ranges|
+    // ranges, or an empty vector if they are not integers.
+    static std::vector<std::string> split_int_key_range(const std::string& key, const std::string& min_str,
+                                                        const std::string& max_str, int num_ranges);
+
+    // Open the scanners querying the ranges of the key.
+    Status open_split_scanners(const std::vector<std::string>& range_filters);
+
+    // Put the chunks read by |scanner| of a range of the key into _result_chunks.
+    void split_scanner_scan(RuntimeState* state, MysqlScanner* scanner);
+
+    void update_status(const Status& status);
+
     bool _is_init;
     bool _is_finished = false;
 
@@ -82,6 +108,14 @@ private:
     std::unique_ptr<MysqlScanner> _mysql_scanner;
     // Current tuple.
     Tuple* _tuple = nullptr;
+
+    // The scanners of the ranges of the key scanned concurrently.
+    std::vector<std::unique_ptr<MysqlScanner>> _split_scanners;
+    std::vector<std::thread> _scanner_threads;
+    std::atomic<int> _num_running_scanners{0};
+    BlockingQueue<ChunkPtr> _result_chunks{4};
+    SpinLock _status_mutex;
+    Status _process_status;
 };
 } // namespace vectorized
 } // namespace starrocks
@@ -5,9 +5,11 @@
 #include <chrono>
 #include <limits>
 #include <thread>
+#include <unordered_set>
 
 #include "column/column_pool.h"
 #include "column/type_traits.h"
+#include "common/config.h"
 #include "common/global_types.h"
 #include "common/status.h"
 #include "exec/pipeline/limit_operator.h"
@@ -27,15 +29,54 @@
 #include "runtime/primitive_type.h"
 #include "storage/vectorized/chunk_helper.h"
 #include "util/priority_thread_pool.hpp"
+#include "util/thrift_util.h"
 
 namespace starrocks::vectorized {
 
+// Whether any of the exprs calls a function whose result differs from query to query, e.g. rand() or now(),
+// unless the FE has folded it to a constant.
+static bool has_non_deterministic_fn(const std::vector<TExpr>& exprs) {
+    static const std::unordered_set<std::string> fn_names{"rand", "random", "sleep", "last_query_id", "now",
+                                                          "current_timestamp", "localtime", "localtimestamp",
+                                                          "curtime", "current_time", "curdate", "current_date",
+                                                          "utc_timestamp"};
+    for (const auto& expr : exprs) {
+        for (const auto& node : expr.nodes) {
+            if (!node.__isset.fn) {
+                continue;
+            }
+            const std::string& name = node.fn.name.function_name;
+            // unix_timestamp() without arguments is the current time.
+            if (fn_names.count(name) > 0 || (name == "unix_timestamp" && node.num_children == 0)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
 OlapScanNode::OlapScanNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs)
         : ScanNode(pool, tnode, descs), _olap_scan_node(tnode.olap_scan_node), _status(Status::OK()) {}
 
 Status OlapScanNode::init(const TPlanNode& tnode, RuntimeState* state) {
     RETURN_IF_ERROR(ExecNode::init(tnode, state));
     DCHECK(!tnode.olap_scan_node.__isset.sort_column) << "sorted result not supported any more";
+
+    // The scan is identified by its whole plan node, the scan ranges are excluded since the cache is per tablet.
+    // The scans with runtime filters or non-deterministic functions are not cached, since their results differ
+    // from query to query.
+    if (config::pipeline_scan_result_cache_capacity > 0 && tnode.probe_runtime_filters.empty() &&
+        !has_non_deterministic_fn(tnode.conjuncts)) {
+        TPlanNode digest_node = tnode;
+        // The id varies with the shape of the rest of the plan, and doesn't affect the scanned rows.
+        digest_node.node_id = 0;
+        uint32_t len = 0;
+        uint8_t* buff = nullptr;
+        ThriftSerializer serializer(false, 4096);
+        if (serializer.serialize(&digest_node, &len, &buff).ok()) {
+            _scan_result_cache_digest.assign(reinterpret_cast<const char*>(buff), len);
+        }
+    }
     return Status::OK();
 }
 
@@ -65,11 +106,14 @@ Status OlapScanNode::open(RuntimeState* state) {
     SCOPED_TIMER(_runtime_profile->total_time_counter());
     RETURN_IF_CANCELLED(state);
     RETURN_IF_ERROR(ExecNode::open(state));
-    CurrentThread::set_mem_tracker(mem_tracker());
+    // Restore the tracker before return, the memory cached in this thread for the tracker of this node
+    // must be flushed before the node is destructed.
+    MemTracker* prev_tracker = CurrentThread::set_mem_tracker(mem_tracker());
 
     Status status;
     OlapScanConjunctsManager::eval_const_conjuncts(_conjunct_ctxs, &status);
     _update_status(status);
+    CurrentThread::set_mem_tracker(prev_tracker);
     return Status::OK();
 }
 
@@ -123,6 +167,7 @@ Status OlapScanNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
     }
 
     Chunk* ptr = nullptr;
+    const bool starved = _result_chunks.empty();
     if (_result_chunks.blocking_get(&ptr)) {
         // If the second argument of `_fill_chunk_pool` is false *AND* the column pool is empty,
         // the column object in the chunk will be destroyed and its memory will be deallocated
@@ -135,7 +180,9 @@ Status OlapScanNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
         // is the first time of calling `get_next`, pass the second argument of `_fill_chunk_pool` as
         // true to ensure that the newly allocated column objects will be returned back into the column
         // pool.
-        _fill_chunk_pool(1, first_call);
+        int refill = _num_chunks_to_refill(starved, _result_chunks.get_size(), _min_chunks, _max_chunks, &_num_chunks);
+        COUNTER_SET(_peak_chunks_counter, static_cast<int64_t>(_num_chunks));
+        _fill_chunk_pool(refill, first_call);
         mem_tracker()->release(ptr->memory_usage());
         *chunk = std::shared_ptr<Chunk>(ptr);
         eval_join_runtime_filters(chunk);
@@ -201,7 +248,7 @@ OlapScanNode::~OlapScanNode() {
 }
 
 void OlapScanNode::_fill_chunk_pool(int count, bool force_column_pool) {
-    const size_t capacity = config::vector_chunk_size;
+    const size_t capacity = ChunkHelper::adaptive_chunk_size(*_chunk_schema);
     for (int i = 0; i < count; i++) {
         Chunk* chk = ChunkHelper::new_chunk_pooled(*_chunk_schema, capacity, force_column_pool);
         mem_tracker()->consume(chk->memory_usage());
@@ -211,6 +258,22 @@ void OlapScanNode::_fill_chunk_pool(int count, bool force_column_pool) {
     }
 }
 
+// The chunks owned by the node follow the rate of the consumer: a consumer waiting for the scanners gets one more
+// chunk, so that one more scanner can run once the pool holds enough chunks, and a consumer falling behind the
+// scanners returns no chunk, so that the scanners park themselves instead of piling chunks up in _result_chunks.
+int OlapScanNode::_num_chunks_to_refill(bool starved, size_t num_result_chunks, int32_t min_chunks,
+                                        int32_t max_chunks, int32_t* num_chunks) {
+    if (starved && *num_chunks < max_chunks) {
+        ++*num_chunks;
+        return 2;
+    }
+    if (!starved && *num_chunks > min_chunks && num_result_chunks * 2 >= static_cast<size_t>(*num_chunks)) {
+        --*num_chunks;
+        return 0;
+    }
+    return 1;
+}
+
 // For global dictionary optimized columns,
 // the type at the execution level is INT but at the storage level is TYPE_STRING/TYPE_CHAR,
 // so we need to pass the real type to the Table Scanner.
@@ -332,9 +395,10 @@ void OlapScanNode::_scanner_thread(TabletScanner* scanner) {
     if (_closed_scanners.load(std::memory_order_acquire) == _num_scanners) {
         _result_chunks.shutdown();
     }
+    // Flush the memory cached in this thread to the tracker while the node is still alive.
+    CurrentThread::set_mem_tracker(nullptr);
     _running_threads.fetch_sub(1, std::memory_order_release);
     CurrentThread::set_query_id(TUniqueId());
-    CurrentThread::set_mem_tracker(nullptr);
     // DO NOT touch any shared variables since here, as they may have been destructed.
 }
 
@@ -390,6 +454,8 @@ Status OlapScanNode::_start_scan(RuntimeState* state) {
 void OlapScanNode::_init_counter(RuntimeState* state) {
     _scan_timer = ADD_TIMER(_runtime_profile, "ScanTime");
 
+    _peak_chunks_counter = _runtime_profile->AddHighWaterMarkCounter("PeakChunks", TUnit::UNIT);
+
     _scan_profile = _runtime_profile->create_child("SCAN", true, false);
 
     _create_seg_iter_timer = ADD_TIMER(_scan_profile, "CreateSegmentIter");
@@ -407,6 +473,8 @@ void OlapScanNode::_init_counter(RuntimeState* state) {
     _bi_filter_timer = ADD_CHILD_TIMER(_scan_profile, "BitmapIndexFilter", "SegmentInit");
     _bi_filtered_counter = ADD_CHILD_COUNTER(_scan_profile, "BitmapIndexFilterRows", TUnit::UNIT, "SegmentInit");
     _bf_filtered_counter = ADD_CHILD_COUNTER(_scan_profile, "BloomFilterFilterRows", TUnit::UNIT, "SegmentInit");
+    _pred_cache_filtered_counter =
+            ADD_CHILD_COUNTER(_scan_profile, "PredicateCacheFilterRows", TUnit::UNIT, "SegmentInit");
     _seg_zm_filtered_counter = ADD_CHILD_COUNTER(_scan_profile, "SegmentZoneMapFilterRows", TUnit::UNIT, "SegmentInit");
     _zm_filtered_counter = ADD_CHILD_COUNTER(_scan_profile, "ZoneMapIndexFilterRows", TUnit::UNIT, "SegmentInit");
     _sk_filtered_counter = ADD_CHILD_COUNTER(_scan_profile, "ShortKeyFilterRows", TUnit::UNIT, "SegmentInit");
@@ -525,7 +593,17 @@ Status OlapScanNode::_start_scan_thread(RuntimeState* state) {
     _chunks_per_scanner = config::doris_scanner_row_num / config::vector_chunk_size;
     _chunks_per_scanner += (config::doris_scanner_row_num % config::vector_chunk_size != 0);
     int concurrency = std::min<int>(kMaxConcurrency, _num_scanners);
+    if (_limit != -1) {
+        // a scanner reads doris_scanner_row_num rows before yielding, start with the scanners enough for the
+        // limit, and more are started if the consumer still waits for them.
+        int64_t scanners_for_limit = (_limit + config::doris_scanner_row_num - 1) / config::doris_scanner_row_num;
+        concurrency = std::min<int64_t>(concurrency, std::max<int64_t>(1, scanners_for_limit));
+    }
     int chunks = _chunks_per_scanner * concurrency;
+    _num_chunks = chunks;
+    _min_chunks = _chunks_per_scanner;
+    _max_chunks = _chunks_per_scanner * std::min<int>(kMaxConcurrency, _num_scanners);
+    COUNTER_SET(_peak_chunks_counter, static_cast<int64_t>(_num_chunks));
     _chunk_pool.reserve(chunks);
     _fill_chunk_pool(chunks, true);
     std::lock_guard<std::mutex> l(_mtx);
@@ -570,9 +648,32 @@ void OlapScanNode::_close_pending_scanners() {
 pipeline::OpFactories OlapScanNode::decompose_to_pipeline(pipeline::PipelineBuilderContext* context) {
     using namespace pipeline;
     OpFactories operators;
-    auto scan_operator =
-            std::make_shared<ScanOperatorFactory>(context->next_operator_id(), id(), _olap_scan_node,
-                                                  std::move(_conjunct_ctxs), std::move(_runtime_filter_collector));
+    RuntimeState* state = context->fragment_context()->runtime_state();
+    if (!_scan_result_cache_digest.empty()) {
+        // The slot ids in the plan node refer to the descriptor table, so the output slots are part of the scan.
+        // The chunks of the scans using global dicts hold dict codes, which are not comparable across queries.
+        if (!state->get_global_dict_map().empty()) {
+            _scan_result_cache_digest.clear();
+        } else if (const auto* tuple_desc = state->desc_tbl().get_tuple_descriptor(_olap_scan_node.tuple_id)) {
+            for (const auto* slot : tuple_desc->slots()) {
+                _scan_result_cache_digest.append(std::to_string(slot->id()));
+                _scan_result_cache_digest.append(slot->col_name());
+                _scan_result_cache_digest.append(slot->type().debug_string());
+                _scan_result_cache_digest.push_back(slot->is_materialized() ? '1' : '0');
+            }
+            // The query options the scanned rows depend on: the time zone of the time functions in the
+            // conjuncts, and the batch size which bounds the number of rows of the cached chunks.
+            // The sql_mode is not sent to BE, it only affects the plan, which is part of the digest already.
+            _scan_result_cache_digest.append(state->timezone());
+            _scan_result_cache_digest.push_back('\0');
+            _scan_result_cache_digest.append(std::to_string(state->batch_size()));
+        } else {
+            _scan_result_cache_digest.clear();
+        }
+    }
+    auto scan_operator = std::make_shared<ScanOperatorFactory>(
+            context->next_operator_id(), id(), _olap_scan_node, std::move(_conjunct_ctxs),
+            std::move(_runtime_filter_collector), std::move(_scan_result_cache_digest));
     auto& morsel_queues = context->fragment_context()->morsel_queues();
     auto source_id = scan_operator->plan_node_id();
     DCHECK(morsel_queues.count(source_id));
@@ -35,6 +35,9 @@ namespace starrocks::vectorized {
 // If _chunk_pool is empty, OlapScanners will quit the thread pool and put themself to the
 // _pending_scanners. After enough chunks has been placed into _chunk_pool, OlapScanNode will
 // resubmit OlapScanners to the thread pool.
+//
+// The number of chunks, and hence the number of running scanners, grows while the consumer waits
+// for the scanners and shrinks while the chunks pile up in _result_chunks.
 class OlapScanNode final : public starrocks::ScanNode {
 public:
     OlapScanNode(ObjectPool* pool, const TPlanNode& tnode, const DescriptorTbl& descs);
@@ -102,12 +105,18 @@ private:
     Status _get_status();
 
     void _fill_chunk_pool(int count, bool force_column_pool);
+    // The number of chunks to put into _chunk_pool for a chunk taken from _result_chunks, when |num_result_chunks|
+    // chunks are left in it, and |*num_chunks| is adjusted in [min_chunks, max_chunks] accordingly.
+    static int _num_chunks_to_refill(bool starved, size_t num_result_chunks, int32_t min_chunks, int32_t max_chunks,
+                                     int32_t* num_chunks);
     Status _rewrite_descriptor();
     bool _submit_scanner(TabletScanner* scanner, bool blockable);
     void _close_pending_scanners();
     int _compute_priority(int32_t num_submitted_tasks);
 
     TOlapScanNode _olap_scan_node;
+    // Identifies the scan in ScanResultCache, empty if the results of the scan are not cached.
+    std::string _scan_result_cache_digest;
     std::vector<std::unique_ptr<TInternalScanRange>> _scan_ranges;
     RuntimeState* _runtime_state = nullptr;
     TupleDescriptor* _tuple_desc = nullptr;
@@ -118,6 +127,11 @@ private:
 
     int32_t _num_scanners = 0;
     int32_t _chunks_per_scanner = 10;
+    // the chunks in _chunk_pool, in _result_chunks and being filled by the scanners, adjusted by get_next
+    // in [_min_chunks, _max_chunks].
+    int32_t _num_chunks = 0;
+    int32_t _min_chunks = 0;
+    int32_t _max_chunks = 0;
     bool _start = false;
 
     mutable SpinLock _status_mutex;
@@ -139,6 +153,8 @@ private:
     RuntimeProfile* _scan_profile = nullptr;
 
     RuntimeProfile::Counter* _scan_timer = nullptr;
+    // the current and the peak number of the chunks owned by the node.
+    RuntimeProfile::HighWaterMarkCounter* _peak_chunks_counter = nullptr;
     RuntimeProfile::Counter* _create_seg_iter_timer = nullptr;
     RuntimeProfile::Counter* _tablet_counter = nullptr;
     RuntimeProfile::Counter* _io_timer = nullptr;
@@ -154,6 +170,7 @@ private:
     RuntimeProfile::Counter* _seg_zm_filtered_counter = nullptr;
     RuntimeProfile::Counter* _zm_filtered_counter = nullptr;
     RuntimeProfile::Counter* _bf_filtered_counter = nullptr;
+    RuntimeProfile::Counter* _pred_cache_filtered_counter = nullptr;
     RuntimeProfile::Counter* _sk_filtered_counter = nullptr;
     RuntimeProfile::Counter* _block_seek_timer = nullptr;
     RuntimeProfile::Counter* _block_seek_counter = nullptr;
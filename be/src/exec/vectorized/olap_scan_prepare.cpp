@@ -4,6 +4,7 @@
 #include "exec/vectorized/olap_scan_prepare.h"
 
 #include "exprs/vectorized/in_const_predicate.hpp"
+#include "exprs/vectorized/runtime_filter_bank.h"
 #include "gutil/map_util.h"
 #include "runtime/date_value.hpp"
 #include "storage/vectorized/column_predicate.h"
@@ -739,6 +740,79 @@ void OlapScanConjunctsManager::get_column_predicates(PredicateParser* parser, st
     }
 }
 
+size_t OlapScanConjunctsManager::count_arrived_runtime_filters() const {
+    if (runtime_filters == nullptr) {
+        return 0;
+    }
+    size_t num = 0;
+    for (const auto& it : runtime_filters->descriptors()) {
+        num += (it.second->runtime_filter() != nullptr);
+    }
+    return num;
+}
+
+void OlapScanConjunctsManager::get_runtime_filter_predicates(PredicateParser* parser, ObjectPool* pool,
+                                                             std::vector<const ColumnPredicate*>* preds) const {
+    get_topn_runtime_filter_predicates(parser, pool, preds);
+    if (count_arrived_runtime_filters() == num_arrived_runtime_filters) {
+        return;
+    }
+    // normalize the join runtime filters only, by a manager without conjuncts.
+    std::vector<ExprContext*> no_conjuncts;
+    OlapScanConjunctsManager cm;
+    cm.conjunct_ctxs_ptr = &no_conjuncts;
+    cm.tuple_desc = tuple_desc;
+    cm.obj_pool = obj_pool;
+    cm.key_column_names = key_column_names;
+    cm.runtime_filters = runtime_filters;
+    cm.runtime_state = runtime_state;
+    cm.normalize_conjuncts();
+    if (!cm.build_olap_filters().ok()) {
+        return;
+    }
+    for (const auto& f : cm.olap_filters) {
+        ColumnPredicate* p = parser->parse_thrift_cond(f);
+        if (p == nullptr) {
+            continue;
+        }
+        pool->add(p);
+        if (!parser->can_pushdown(p)) {
+            continue;
+        }
+        // the rows are still filtered by the runtime filters after read.
+        p->set_index_filter_only(true);
+        preds->push_back(p);
+    }
+}
+
+void OlapScanConjunctsManager::get_topn_runtime_filter_predicates(PredicateParser* parser, ObjectPool* pool,
+                                                                  std::vector<const ColumnPredicate*>* preds) const {
+    const TopNRuntimeFilter* filter = runtime_filters != nullptr ? runtime_filters->topn_runtime_filter() : nullptr;
+    if (filter == nullptr) {
+        return;
+    }
+    for (const SlotDescriptor* slot : tuple_desc->slots()) {
+        if (slot->id() != filter->slot_id()) {
+            continue;
+        }
+        TCondition cond;
+        if (!filter->get_condition(slot->col_name(), &cond)) {
+            return;
+        }
+        ColumnPredicate* p = parser->parse_thrift_cond(cond);
+        if (p == nullptr) {
+            return;
+        }
+        pool->add(p);
+        if (parser->can_pushdown(p)) {
+            // the rows beyond the boundary are dropped by the TopN itself.
+            p->set_index_filter_only(true);
+            preds->push_back(p);
+        }
+        return;
+    }
+}
+
 void OlapScanConjunctsManager::eval_const_conjuncts(const std::vector<ExprContext*>& conjunct_ctxs, Status* status) {
     *status = Status::OK();
     for (const auto& ctx_iter : conjunct_ctxs) {
@@ -816,6 +890,8 @@ void OlapScanConjunctsManager::build_column_expr_predicates() {
 
 Status OlapScanConjunctsManager::parse_conjuncts(bool scan_keys_unlimited, int32_t max_scan_key_num,
                                                  bool enable_column_expr_predicate) {
+    // count before normalizing, the runtime filters arriving in between are taken as late ones.
+    num_arrived_runtime_filters = count_arrived_runtime_filters();
     normalize_conjuncts();
     RETURN_IF_ERROR(build_olap_filters());
     build_scan_keys(scan_keys_unlimited, max_scan_key_num);
@@ -34,12 +34,23 @@ private:
     std::vector<TCondition> olap_filters;                             // from _column_value_ranges
     std::vector<TCondition> is_null_vector;                           // from conjunct_ctxs
     std::map<int, std::vector<ExprContext*>> slot_index_to_expr_ctxs; // from conjunct_ctxs
+    size_t num_arrived_runtime_filters = 0;                           // when parsing conjunct ctxs
 
 public:
     static void eval_const_conjuncts(const std::vector<ExprContext*>& conjunct_ctxs, Status* status);
 
     void get_column_predicates(PredicateParser* parser, std::vector<ColumnPredicate*>* preds);
 
+    // Build the index only predicates of the join runtime filters, if any of them arrived after the conjunct
+    // ctxs were parsed. The predicates are added to |pool|. It's thread safe and called by the storage readers
+    // when they start to read a segment, to prune the segments and pages by the runtime filters arrived late.
+    void get_runtime_filter_predicates(PredicateParser* parser, ObjectPool* pool,
+                                       std::vector<const ColumnPredicate*>* preds) const;
+
+    // Build the index only predicate of the TopN runtime filter, if the TopN above has published its boundary.
+    void get_topn_runtime_filter_predicates(PredicateParser* parser, ObjectPool* pool,
+                                            std::vector<const ColumnPredicate*>* preds) const;
+
     Status get_key_ranges(std::vector<std::unique_ptr<OlapScanRange>>* key_ranges);
 
     void get_not_push_down_conjuncts(std::vector<ExprContext*>* predicates);
@@ -48,6 +59,8 @@ public:
                            bool enable_column_expr_predicate = false);
 
 private:
+    size_t count_arrived_runtime_filters() const;
+
     Status normalize_conjuncts();
     Status build_olap_filters();
     Status build_scan_keys(bool unlimited, int32_t max_scan_key_num);
@@ -4,9 +4,11 @@
 
 #include <glog/logging.h>
 
+#include <cstring>
 #include <exception>
 #include <limits>
 #include <set>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
 
@@ -52,6 +54,27 @@ const static std::set<PrimitiveType> g_starrocks_decimal_type = {TYPE_DECIMAL32,
 const static cctz::time_point<cctz::sys_seconds> CCTZ_UNIX_EPOCH =
         std::chrono::time_point_cast<cctz::sys_seconds>(std::chrono::system_clock::from_time_t(0));
 
+// orc not null flags are 0/1 bytes, the null map is their negation.
+// keep the loop free of branches so that it can be vectorized.
+static inline void fill_null_map(const char* not_null, int from, int size, uint8_t* nulls) {
+    const auto* cvbn = reinterpret_cast<const uint8_t*>(not_null) + from;
+    for (int i = 0; i < size; ++i) {
+        nulls[i] = (cvbn[i] == 0);
+    }
+}
+
+// copy values of orc vector batch to column, it's a memcpy if both sides have the same type.
+template <typename DstType, typename SrcType>
+static inline void copy_values(const SrcType* src, int size, DstType* dst) {
+    if constexpr (std::is_same_v<DstType, SrcType>) {
+        memcpy(dst, src, size * sizeof(SrcType));
+    } else {
+        for (int i = 0; i < size; ++i) {
+            dst[i] = src[i];
+        }
+    }
+}
+
 static void fill_boolean_column(orc::ColumnVectorBatch* cvb, ColumnPtr& col, int from, int size,
                                 const TypeDescriptor& type_desc, void* ctx) {
     auto* data = down_cast<orc::LongVectorBatch*>(cvb);
@@ -78,14 +101,10 @@ static void fill_boolean_column_with_null(orc::ColumnVectorBatch* cvb, ColumnPtr
     auto* values = ColumnHelper::cast_to_raw<TYPE_BOOLEAN>(c->data_column())->get_data().data();
 
     auto* cvbd = data->data.data();
-    auto pos = from;
     if (cvb->hasNulls) {
-        auto* cvbn = reinterpret_cast<uint8_t*>(cvb->notNull.data());
-        for (int i = col_start; i < col_start + size; ++i, ++pos) {
-            nulls[i] = !cvbn[pos];
-        }
+        fill_null_map(cvb->notNull.data(), from, size, nulls + col_start);
     }
-    pos = from;
+    auto pos = from;
     for (int i = col_start; i < col_start + size; ++i, ++pos) {
         values[i] = (cvbd[pos] != 0);
     }
@@ -104,10 +123,7 @@ static void fill_int_column_from_cvb(OrcColumnVectorBatch* data, ColumnPtr& col,
 
     auto* cvbd = data->data.data();
 
-    auto pos = from;
-    for (int i = col_start; i < col_start + size; ++i, ++pos) {
-        values[i] = cvbd[pos];
-    }
+    copy_values(cvbd + from, size, values + col_start);
 
     // col_start == 0 and from == 0 means it's at top level of fill chunk, not in the middle of array
     // otherwise `broker_load_filter` does not work.
@@ -147,17 +163,10 @@ static void fill_int_column_with_null_from_cvb(OrcColumnVectorBatch* data, Colum
     auto* values = ColumnHelper::cast_to_raw<Type>(c->data_column())->get_data().data();
 
     auto* cvbd = data->data.data();
-    auto pos = from;
     if (data->hasNulls) {
-        auto* cvbn = reinterpret_cast<uint8_t*>(data->notNull.data());
-        for (int i = col_start; i < col_start + size; ++i, ++pos) {
-            nulls[i] = !cvbn[pos];
-        }
-    }
-    pos = from;
-    for (int i = col_start; i < col_start + size; ++i, ++pos) {
-        values[i] = cvbd[pos];
+        fill_null_map(data->notNull.data(), from, size, nulls + col_start);
     }
+    copy_values(cvbd + from, size, values + col_start);
 
     // col_start == 0 and from == 0 means it's at top level of fill chunk, not in the middle of array
     // otherwise `broker_load_filter` does not work.
@@ -250,9 +259,7 @@ static void fill_float_column(orc::ColumnVectorBatch* cvb, ColumnPtr& col, int f
     auto* values = ColumnHelper::cast_to_raw<Type>(col)->get_data().data();
 
     auto* cvbd = data->data.data();
-    for (int i = col_start; i < col_start + size; ++i, ++from) {
-        values[i] = cvbd[from];
-    }
+    copy_values(cvbd + from, size, values + col_start);
 }
 
 template <PrimitiveType Type>
@@ -267,17 +274,10 @@ static void fill_float_column_with_null(orc::ColumnVectorBatch* cvb, ColumnPtr&
     auto* values = ColumnHelper::cast_to_raw<Type>(c->data_column())->get_data().data();
 
     auto* cvbd = data->data.data();
-    auto pos = from;
     if (cvb->hasNulls) {
-        auto* cvbn = reinterpret_cast<uint8_t*>(cvb->notNull.data());
-        for (int i = col_start; i < col_start + size; ++i, ++pos) {
-            nulls[i] = !cvbn[pos];
-        }
-    }
-    pos = from;
-    for (int i = col_start; i < col_start + size; ++i, ++pos) {
-        values[i] = cvbd[pos];
+        fill_null_map(cvb->notNull.data(), from, size, nulls + col_start);
     }
+    copy_values(cvbd + from, size, values + col_start);
     c->update_has_null();
 }
 
@@ -322,12 +322,8 @@ static void fill_decimal_column_with_null_from_orc_decimal64(orc::ColumnVectorBa
     null_column->resize(data_column->size());
     auto* nulls = null_column->get_data().data();
 
-    auto pos = from;
     if (cvb->hasNulls) {
-        auto* cvbn = reinterpret_cast<uint8_t*>(cvb->notNull.data());
-        for (int i = col_start; i < col_start + size; ++i, ++pos) {
-            nulls[i] = !cvbn[pos];
-        }
+        fill_null_map(cvb->notNull.data(), from, size, nulls + col_start);
         c->update_has_null();
     }
 }
@@ -371,12 +367,8 @@ static void fill_decimal_column_with_null_from_orc_decimal128(orc::ColumnVectorB
     null_column->resize(data_column->size());
     auto* nulls = null_column->get_data().data();
 
-    auto pos = from;
     if (cvb->hasNulls) {
-        auto* cvbn = reinterpret_cast<uint8_t*>(cvb->notNull.data());
-        for (int i = col_start; i < col_start + size; ++i, ++pos) {
-            nulls[i] = !cvbn[pos];
-        }
+        fill_null_map(cvb->notNull.data(), from, size, nulls + col_start);
         c->update_has_null();
     }
 }
@@ -424,13 +416,8 @@ static inline void fill_decimal_column_generic(orc::ColumnVectorBatch* cvb, Colu
         auto nullable_column = ColumnHelper::as_raw_column<NullableColumn>(col);
         if (cvb->hasNulls) {
             auto nulls = nullable_column->null_column()->get_data().data();
-            auto cvbn = reinterpret_cast<uint8_t*>(cvb->notNull.data());
-            bool has_null = col->has_null();
-            auto src_idx = from;
-            for (auto dst_idx = col_start; dst_idx < col_start + size; ++dst_idx, ++src_idx) {
-                has_null |= cvbn[src_idx] == 0;
-                nulls[dst_idx] = !cvbn[src_idx];
-            }
+            fill_null_map(cvb->notNull.data(), from, size, nulls + col_start);
+            bool has_null = col->has_null() || SIMD::count_nonzero(nulls + col_start, size) > 0;
             nullable_column->set_has_null(has_null);
         }
         decimal_column = ColumnHelper::cast_to_raw<DecimalType>(nullable_column->data_column());
@@ -521,6 +508,47 @@ static void fill_decimal128_column_with_null(orc::ColumnVectorBatch* cvb, Column
     fill_decimal_column_from_orc_decimal64_or_decimal128<TYPE_DECIMAL128, true>(cvb, col, from, size, type_desc, ctx);
 }
 
+// Append |size| strings starting at |from| of |data|, whose total length is |len|, to |values|.
+// Strings of the direct encoding are stored back to back in the blob of the vector batch,
+// so they are copied with one memcpy and the offsets are just the prefix sum of the lengths.
+// Only the dictionary encoded or filtered batches fall back to copy the strings one by one.
+static void copy_string_values(orc::StringVectorBatch* data, int from, int size, size_t len, BinaryColumn* values) {
+    if (size == 0) {
+        return;
+    }
+    auto& vb = values->get_bytes();
+    auto& vo = values->get_offset();
+    const int64_t* lengths = data->length.data() + from;
+    char* const* starts = data->data.data() + from;
+
+    size_t bytes_start = vb.size();
+    size_t offsets_start = vo.size();
+    vo.resize(offsets_start + size);
+    vb.resize(bytes_start + len);
+
+    uint32_t* offsets = vo.data() + offsets_start;
+    uint32_t offset = bytes_start;
+    for (int i = 0; i < size; ++i) {
+        offset += lengths[i];
+        offsets[i] = offset;
+    }
+
+    const char* first = starts[0];
+    const char* last = starts[size - 1] + lengths[size - 1];
+    if (!data->use_codes && first <= last && static_cast<size_t>(last - first) == len) {
+        memcpy(vb.data() + bytes_start, first, len);
+    } else {
+        uint8_t* dst = vb.data() + bytes_start;
+        for (int i = 0; i < size; ++i) {
+            // the start of null values of dictionary encoding is nullptr.
+            if (lengths[i] > 0) {
+                memcpy(dst, starts[i], lengths[i]);
+                dst += lengths[i];
+            }
+        }
+    }
+}
+
 static void fill_string_column(orc::ColumnVectorBatch* cvb, ColumnPtr& col, int from, int size,
                                const TypeDescriptor& type_desc, void* ctx) {
     OrcScannerAdapter* adapter = static_cast<OrcScannerAdapter*>(ctx);
@@ -534,17 +562,7 @@ static void fill_string_column(orc::ColumnVectorBatch* cvb, ColumnPtr& col, int
 
     int col_start = col->size();
     auto* values = ColumnHelper::cast_to_raw<TYPE_VARCHAR>(col);
-
-    values->get_offset().reserve(col_start + size);
-    values->get_bytes().reserve(len);
-
-    auto& vb = values->get_bytes();
-    auto& vo = values->get_offset();
-    int pos = from;
-    for (int i = col_start; i < col_start + size; ++i, ++pos) {
-        vb.insert(vb.end(), data->data[pos], data->data[pos] + data->length[pos]);
-        vo.emplace_back(vb.size());
-    }
+    copy_string_values(data, from, size, len, values);
 
     // col_start == 0 and from == 0 means it's at top level of fill chunk, not in the middle of array
     // otherwise `broker_load_filter` does not work.
@@ -588,31 +606,14 @@ static void fill_string_column_with_null(orc::ColumnVectorBatch* cvb, ColumnPtr&
     auto* nulls = c->null_column()->get_data().data();
     auto* values = ColumnHelper::cast_to_raw<TYPE_VARCHAR>(c->data_column());
 
-    values->get_offset().reserve(values->get_offset().size() + size);
-    values->get_bytes().reserve(values->get_bytes().size() + len);
-
-    auto& vb = values->get_bytes();
-    auto& vo = values->get_offset();
+    // the length of null values is 0 in orc.
     if (cvb->hasNulls) {
-        for (int i = col_start; i < col_start + size; ++i, ++from) {
-            nulls[i] = !cvb->notNull[from];
-            if (cvb->notNull[from]) {
-                vb.insert(vb.end(), data->data[from], data->data[from] + data->length[from]);
-                vo.emplace_back(vb.size());
-            } else {
-                vo.emplace_back(vb.size());
-            }
-        }
-    } else {
-        for (int i = col_start; i < col_start + size; ++i, ++from) {
-            vb.insert(vb.end(), data->data[from], data->data[from] + data->length[from]);
-            vo.emplace_back(vb.size());
-        }
+        fill_null_map(cvb->notNull.data(), from, size, nulls + col_start);
     }
+    copy_string_values(data, from, size, len, values);
 
     // col_start == 0 and from == 0 means it's at top level of fill chunk, not in the middle of array
     // otherwise `broker_load_filter` does not work.
-    from -= size; // move back
     if (adapter->get_broker_load_mode() && from == 0 && col_start == 0) {
         auto* filter = adapter->get_broker_load_fiter()->data();
         auto strict_mode = adapter->get_strict_mode();
@@ -1404,6 +1405,22 @@ static std::unordered_map<PrimitiveType, orc::PredicateDataType> _supported_prim
 bool OrcScannerAdapter::_ok_to_add_conjunct(const Expr* conjunct) {
     TExprNodeType::type node_type = conjunct->node_type();
     TExprOpcode::type op_type = conjunct->op();
+
+    // is null and is not null are function calls in the vectorized engine.
+    std::string is_null_str;
+    if (node_type == TExprNodeType::FUNCTION_CALL && conjunct->is_null_scalar_function(is_null_str)) {
+        if (conjunct->get_num_children() != 1) {
+            return false;
+        }
+        Expr* c = conjunct->get_child(0);
+        if (c->node_type() != TExprNodeType::type::SLOT_REF) {
+            return false;
+        }
+        SlotId slot_id = down_cast<ColumnRef*>(c)->slot_id();
+        return _slot_id_to_desc.find(slot_id) != _slot_id_to_desc.end() &&
+               _supported_primitive_types.find(c->type().type) != _supported_primitive_types.end();
+    }
+
     if (_supported_expr_node_types.find(node_type) == _supported_expr_node_types.end()) {
         return false;
     }
@@ -1553,6 +1570,19 @@ void OrcScannerAdapter::_add_conjunct(const Expr* conjunct, std::unique_ptr<orc:
     std::string name = _slot_id_to_desc[slot_id]->col_name();
     orc::PredicateDataType pred_type = _supported_primitive_types[slot->type().type];
 
+    std::string is_null_str;
+    if (node_type == TExprNodeType::FUNCTION_CALL && conjunct->is_null_scalar_function(is_null_str)) {
+        bool neg = (is_null_str == "not null");
+        if (neg) {
+            builder->startNot();
+        }
+        builder->isNull(name, pred_type);
+        if (neg) {
+            builder->end();
+        }
+        return;
+    }
+
     if (node_type == TExprNodeType::type::BINARY_PRED) {
         Expr* lit = conjunct->get_child(1);
         orc::Literal literal = translate_to_orc_literal(lit, pred_type);
@@ -1605,7 +1635,7 @@ void OrcScannerAdapter::_add_conjunct(const Expr* conjunct, std::unique_ptr<orc:
         }
         std::vector<orc::Literal> literals;
         for (int i = 1; i < conjunct->get_num_children(); i++) {
-            Expr* lit = conjunct->get_child(1);
+            Expr* lit = conjunct->get_child(i);
             orc::Literal literal = translate_to_orc_literal(lit, pred_type);
             literals.emplace_back(literal);
         }
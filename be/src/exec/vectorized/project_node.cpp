@@ -14,6 +14,7 @@
 #include "column/column_viewer.h"
 #include "column/nullable_column.h"
 #include "column/vectorized_fwd.h"
+#include "common/config.h"
 #include "common/global_types.h"
 #include "exec/pipeline/limit_operator.h"
 #include "exec/pipeline/pipeline_builder.h"
@@ -21,6 +22,7 @@
 #include "exprs/expr.h"
 #include "exprs/expr_context.h"
 #include "exprs/vectorized/column_ref.h"
+#include "exprs/vectorized/common_sub_expr.h"
 #include "exprs/vectorized/runtime_filter.h"
 #include "fmt/compile.h"
 #include "glog/logging.h"
@@ -67,6 +69,40 @@ Status ProjectNode::init(const TPlanNode& tnode, RuntimeState* state) {
         _common_sub_expr_ctxs.emplace_back(context);
     }
 
+    // Find the common sub expressions the planner leaves in the output expressions. They are only
+    // applied in prepare(), when it's known whether the global dicts rewrite the expressions.
+    if (config::enable_project_common_sub_expr_elimination) {
+        for (auto const& [key, val] : tnode.project_node.slot_map) {
+            _extracted_exprs.emplace_back(val);
+        }
+        // the planner never assigns negative slot ids, and -1 means an invalid slot.
+        SlotId next_slot_id = -2;
+        if (extract_common_sub_exprs(&_extracted_exprs, _tuple_ids[0], &next_slot_id,
+                                     &_extracted_common_slot_ids, &_extracted_common_exprs) == 0) {
+            _extracted_exprs.clear();
+        }
+    }
+
+    return Status::OK();
+}
+
+Status ProjectNode::_apply_extracted_common_sub_exprs(RuntimeState* state) {
+    // The low cardinality optimization rewrites the expressions on the dict encoded slots as a whole,
+    // which doesn't expect the slots of the extracted sub expressions.
+    if (_extracted_exprs.empty() || !state->get_global_dict_map().empty()) {
+        return Status::OK();
+    }
+    DCHECK_EQ(_extracted_exprs.size(), _expr_ctxs.size());
+    std::vector<ExprContext*> expr_ctxs;
+    std::vector<ExprContext*> common_expr_ctxs;
+    RETURN_IF_ERROR(Expr::create_expr_trees(_pool, _extracted_exprs, &expr_ctxs));
+    RETURN_IF_ERROR(Expr::create_expr_trees(_pool, _extracted_common_exprs, &common_expr_ctxs));
+
+    _expr_ctxs = std::move(expr_ctxs);
+    _common_sub_slot_ids.insert(_common_sub_slot_ids.end(), _extracted_common_slot_ids.begin(),
+                                _extracted_common_slot_ids.end());
+    _common_sub_expr_ctxs.insert(_common_sub_expr_ctxs.end(), common_expr_ctxs.begin(), common_expr_ctxs.end());
+    _extracted_exprs.clear();
     return Status::OK();
 }
 
@@ -74,6 +110,7 @@ Status ProjectNode::prepare(RuntimeState* state) {
     SCOPED_TIMER(_runtime_profile->total_time_counter());
     RETURN_IF_ERROR(ExecNode::prepare(state));
 
+    RETURN_IF_ERROR(_apply_extracted_common_sub_exprs(state));
     RETURN_IF_ERROR(Expr::prepare(_expr_ctxs, state, row_desc()));
     RETURN_IF_ERROR(Expr::prepare(_common_sub_expr_ctxs, state, row_desc()));
 
@@ -228,6 +265,18 @@ void ProjectNode::push_down_predicate(RuntimeState* state, std::list<ExprContext
     ExecNode::push_down_predicate(state, expr_ctxs, is_vectorized);
 }
 
+bool ProjectNode::_references_common_sub_slots(Expr* expr) const {
+    std::vector<SlotId> slot_ids;
+    expr->get_slot_ids(&slot_ids);
+    for (SlotId slot_id : slot_ids) {
+        if (std::find(_common_sub_slot_ids.begin(), _common_sub_slot_ids.end(), slot_id) !=
+            _common_sub_slot_ids.end()) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void ProjectNode::push_down_join_runtime_filter(RuntimeState* state,
                                                 vectorized::RuntimeFilterProbeCollector* collector) {
     // accept runtime filters from parent if possible.
@@ -248,7 +297,8 @@ void ProjectNode::push_down_join_runtime_filter(RuntimeState* state,
         }
         bool match = false;
         for (int i = 0; i < _slot_ids.size(); i++) {
-            if (_slot_ids[i] == slot_id) {
+            // the slots of common sub expressions are evaluated by this node, not by the children.
+            if (_slot_ids[i] == slot_id && !_references_common_sub_slots(_expr_ctxs[i]->root())) {
                 // replace with new probe expr
                 ExprContext* new_probe_expr_ctx = _expr_ctxs[i];
                 rf_desc->replace_probe_expr_ctx(state, row_desc(), new_probe_expr_ctx);
@@ -274,6 +324,9 @@ void ProjectNode::push_down_join_runtime_filter(RuntimeState* state,
 pipeline::OpFactories ProjectNode::decompose_to_pipeline(pipeline::PipelineBuilderContext* context) {
     using namespace pipeline;
     OpFactories operators = _children[0]->decompose_to_pipeline(context);
+    // prepare() is not called in pipeline engine, the operators prepare the expressions themselves.
+    Status st = _apply_extracted_common_sub_exprs(context->fragment_context()->runtime_state());
+    LOG_IF(WARNING, !st.ok()) << "Failed to extract the common sub expressions: " << st.to_string();
     operators.emplace_back(std::make_shared<ProjectOperatorFactory>(
             context->next_operator_id(), id(), std::move(_slot_ids), std::move(_expr_ctxs),
             std::move(_type_is_nullable), std::move(_common_sub_slot_ids), std::move(_common_sub_expr_ctxs)));
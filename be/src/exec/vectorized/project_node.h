@@ -32,6 +32,9 @@ public:
             pipeline::PipelineBuilderContext* context) override;
 
 private:
+    Status _apply_extracted_common_sub_exprs(RuntimeState* state);
+    bool _references_common_sub_slots(Expr* expr) const;
+
     std::vector<SlotId> _slot_ids;
     std::vector<ExprContext*> _expr_ctxs;
     std::vector<bool> _type_is_nullable;
@@ -39,6 +42,11 @@ private:
     std::vector<SlotId> _common_sub_slot_ids;
     std::vector<ExprContext*> _common_sub_expr_ctxs;
 
+    // output expressions with the common sub expressions extracted, empty if there is no common one.
+    std::vector<TExpr> _extracted_exprs;
+    std::vector<SlotId> _extracted_common_slot_ids;
+    std::vector<TExpr> _extracted_common_exprs;
+
     RuntimeProfile::Counter* _expr_compute_timer = nullptr;
     RuntimeProfile::Counter* _common_sub_expr_compute_timer = nullptr;
 
@@ -0,0 +1,143 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/range_join_predicate.h"
+
+#include <algorithm>
+
+#include "column/chunk.h"
+#include "column/column_helper.h"
+#include "exprs/expr.h"
+#include "exprs/expr_context.h"
+#include "exprs/vectorized/column_ref.h"
+
+namespace starrocks::vectorized {
+
+static bool is_range_opcode(TExprOpcode::type op) {
+    return op == TExprOpcode::LT || op == TExprOpcode::LE || op == TExprOpcode::GT || op == TExprOpcode::GE;
+}
+
+// `a op b` is the same as `b reverse(op) a`.
+static TExprOpcode::type reverse_opcode(TExprOpcode::type op) {
+    switch (op) {
+    case TExprOpcode::LT:
+        return TExprOpcode::GT;
+    case TExprOpcode::LE:
+        return TExprOpcode::GE;
+    case TExprOpcode::GT:
+        return TExprOpcode::LT;
+    default:
+        DCHECK_EQ(op, TExprOpcode::GE);
+        return TExprOpcode::LE;
+    }
+}
+
+static bool is_bound_to(const ColumnRef* ref, const RowDescriptor& row_desc) {
+    return row_desc.get_tuple_idx(ref->tuple_id()) != RowDescriptor::INVALID_IDX;
+}
+
+std::unique_ptr<RangeJoinPredicate> RangeJoinPredicate::create(const std::vector<ExprContext*>& conjunct_ctxs,
+                                                               const RowDescriptor& probe_row_desc,
+                                                               const RowDescriptor& build_row_desc) {
+    for (ExprContext* ctx : conjunct_ctxs) {
+        Expr* root = ctx->root();
+        if (root->node_type() != TExprNodeType::BINARY_PRED || !is_range_opcode(root->op())) {
+            continue;
+        }
+        Expr* left = root->get_child(0);
+        Expr* right = root->get_child(1);
+        // The binary search compares the two columns directly, so they must have the same type.
+        if (!left->is_slotref() || !right->is_slotref() || left->type() != right->type()) {
+            continue;
+        }
+        auto* left_ref = down_cast<ColumnRef*>(left);
+        auto* right_ref = down_cast<ColumnRef*>(right);
+        if (is_bound_to(left_ref, probe_row_desc) && is_bound_to(right_ref, build_row_desc)) {
+            return std::make_unique<RangeJoinPredicate>(left_ref->slot_id(), right_ref->slot_id(), root->op());
+        }
+        if (is_bound_to(left_ref, build_row_desc) && is_bound_to(right_ref, probe_row_desc)) {
+            return std::make_unique<RangeJoinPredicate>(right_ref->slot_id(), left_ref->slot_id(),
+                                                        reverse_opcode(root->op()));
+        }
+    }
+    return nullptr;
+}
+
+ChunkPtr RangeJoinPredicate::sort_build_chunk(const ChunkPtr& build_chunk) const {
+    const size_t num_rows = build_chunk->num_rows();
+    const ColumnPtr& build_column = build_chunk->get_column_by_slot_id(_build_slot_id);
+    ColumnPtr key_column = ColumnHelper::unpack_and_duplicate_const_column(num_rows, build_column);
+
+    std::vector<uint32_t> indexes;
+    indexes.reserve(num_rows);
+    for (uint32_t i = 0; i < num_rows; ++i) {
+        if (!key_column->is_null(i)) {
+            indexes.emplace_back(i);
+        }
+    }
+    const Column* data_column = ColumnHelper::get_data_column(key_column.get());
+    std::sort(indexes.begin(), indexes.end(), [data_column](uint32_t lhs, uint32_t rhs) {
+        return data_column->compare_at(lhs, rhs, *data_column, 1) < 0;
+    });
+
+    ChunkPtr sorted_chunk = build_chunk->clone_empty_with_tuple(indexes.size());
+    sorted_chunk->append_selective(*build_chunk, indexes.data(), 0, indexes.size());
+    return sorted_chunk;
+}
+
+void RangeJoinPredicate::compute_ranges(const Chunk& probe_chunk, const Chunk& sorted_build_chunk,
+                                        std::vector<uint32_t>* starts, std::vector<uint32_t>* ends) const {
+    const size_t num_probe_rows = probe_chunk.num_rows();
+    const auto num_build_rows = static_cast<uint32_t>(sorted_build_chunk.num_rows());
+    ColumnPtr probe_column = ColumnHelper::unpack_and_duplicate_const_column(
+            num_probe_rows, probe_chunk.get_column_by_slot_id(_probe_slot_id));
+    const Column* probe_data = ColumnHelper::get_data_column(probe_column.get());
+    const ColumnPtr& build_column = sorted_build_chunk.get_column_by_slot_id(_build_slot_id);
+    const Column* build_data = ColumnHelper::get_data_column(build_column.get());
+    const bool is_build_const = build_column->is_constant();
+
+    starts->resize(num_probe_rows);
+    ends->resize(num_probe_rows);
+    for (size_t i = 0; i < num_probe_rows; ++i) {
+        // A null probe value matches no build row.
+        if (probe_column->is_null(i)) {
+            (*starts)[i] = (*ends)[i] = 0;
+            continue;
+        }
+        // The first build row not less than the probe value, and the first one greater than it.
+        auto bound = [&](bool upper) {
+            uint32_t low = 0;
+            uint32_t high = num_build_rows;
+            while (low < high) {
+                uint32_t mid = low + (high - low) / 2;
+                int cmp = build_data->compare_at(is_build_const ? 0 : mid, i, *probe_data, 1);
+                if (cmp < 0 || (upper && cmp == 0)) {
+                    low = mid + 1;
+                } else {
+                    high = mid;
+                }
+            }
+            return low;
+        };
+        switch (_op) {
+        case TExprOpcode::GE:
+            (*starts)[i] = 0;
+            (*ends)[i] = bound(true);
+            break;
+        case TExprOpcode::GT:
+            (*starts)[i] = 0;
+            (*ends)[i] = bound(false);
+            break;
+        case TExprOpcode::LE:
+            (*starts)[i] = bound(false);
+            (*ends)[i] = num_build_rows;
+            break;
+        default:
+            DCHECK_EQ(_op, TExprOpcode::LT);
+            (*starts)[i] = bound(true);
+            (*ends)[i] = num_build_rows;
+            break;
+        }
+    }
+}
+
+} // namespace starrocks::vectorized
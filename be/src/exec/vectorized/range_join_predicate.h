@@ -0,0 +1,50 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "column/vectorized_fwd.h"
+#include "gen_cpp/Opcodes_types.h"
+#include "runtime/descriptors.h"
+
+namespace starrocks {
+class ExprContext;
+
+namespace vectorized {
+
+// A join conjunct of the form `probe_slot op build_slot`, where op is one of <, <=, > and >=.
+// Once the build rows are sorted by build_slot, the build rows which may satisfy it for a probe row
+// are a contiguous range found by binary search, so the cross join only needs to join each probe row
+// with that range instead of all the build rows, e.g. for `a.ts BETWEEN b.start AND b.end`.
+//
+// The range is a superset of the matched rows, all the conjuncts are still evaluated on the joined rows.
+class RangeJoinPredicate {
+public:
+    RangeJoinPredicate(SlotId probe_slot_id, SlotId build_slot_id, TExprOpcode::type op)
+            : _probe_slot_id(probe_slot_id), _build_slot_id(build_slot_id), _op(op) {}
+
+    // Find the first conjunct usable as the range predicate, return nullptr if there is none.
+    // Only the expr trees are inspected, so the conjuncts need not be prepared.
+    static std::unique_ptr<RangeJoinPredicate> create(const std::vector<ExprContext*>& conjunct_ctxs,
+                                                      const RowDescriptor& probe_row_desc,
+                                                      const RowDescriptor& build_row_desc);
+
+    // Return the build rows sorted by build_slot in ascending order.
+    // The rows with null build_slot are removed, since they never satisfy the predicate.
+    ChunkPtr sort_build_chunk(const ChunkPtr& build_chunk) const;
+
+    // For the i-th probe row, [(*starts)[i], (*ends)[i]) is the range of the sorted build rows to join with.
+    void compute_ranges(const Chunk& probe_chunk, const Chunk& sorted_build_chunk, std::vector<uint32_t>* starts,
+                        std::vector<uint32_t>* ends) const;
+
+private:
+    SlotId _probe_slot_id;
+    SlotId _build_slot_id;
+    // Normalized to `probe_slot op build_slot`.
+    TExprOpcode::type _op;
+};
+
+} // namespace vectorized
+} // namespace starrocks
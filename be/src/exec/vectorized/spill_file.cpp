@@ -0,0 +1,113 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/spill_file.h"
+
+#include <atomic>
+
+#include "column/chunk.h"
+#include "env/env.h"
+#include "gutil/strings/substitute.h"
+#include "storage/data_dir.h"
+#include "storage/storage_engine.h"
+#include "util/coding.h"
+#include "util/raw_container.h"
+
+namespace starrocks::vectorized {
+
+static std::atomic<uint64_t> s_spill_file_seq{0};
+
+StatusOr<SpillFilePtr> SpillFile::create(const std::string& name) {
+    StorageEngine* engine = StorageEngine::instance();
+    if (engine == nullptr) {
+        return Status::InternalError("storage engine is not initialized, could not spill");
+    }
+    std::vector<DataDir*> stores = engine->get_stores();
+    if (stores.empty()) {
+        return Status::InternalError("no available data dir to spill");
+    }
+    uint64_t seq = s_spill_file_seq.fetch_add(1, std::memory_order_relaxed);
+    DataDir* store = stores[seq % stores.size()];
+    return create_at(strings::Substitute("$0/$1_$2", store->spill_path(), name, seq));
+}
+
+StatusOr<SpillFilePtr> SpillFile::create_at(const std::string& path) {
+    SpillFilePtr file(new SpillFile(path));
+    RETURN_IF_ERROR(Env::Default()->new_writable_file(path, &file->_writer));
+    return std::move(file);
+}
+
+SpillFile::~SpillFile() {
+    _writer.reset();
+    _reader.reset();
+    Status st = Env::Default()->delete_file(_path);
+    if (!st.ok() && !st.is_not_found()) {
+        LOG(WARNING) << "failed to delete spill file " << _path << ": " << st.to_string();
+    }
+}
+
+Status SpillFile::append(const Chunk& chunk) {
+    if (_writer == nullptr) {
+        return Status::InternalError(strings::Substitute("spill file $0 is not writable", _path));
+    }
+    size_t size = chunk.serialize_size();
+    raw::stl_string_resize_uninitialized(&_buffer, sizeof(uint32_t) + size);
+    auto* dst = reinterpret_cast<uint8_t*>(_buffer.data());
+    encode_fixed32_le(dst, static_cast<uint32_t>(size));
+    chunk.serialize(dst + sizeof(uint32_t));
+    RETURN_IF_ERROR(_writer->append(Slice(_buffer)));
+
+    _num_chunks++;
+    _num_rows += chunk.num_rows();
+    _num_bytes += _buffer.size();
+    return Status::OK();
+}
+
+Status SpillFile::flip_to_read() {
+    if (_writer != nullptr) {
+        RETURN_IF_ERROR(_writer->close());
+        _writer.reset();
+    }
+    _num_read_chunks = 0;
+    return Env::Default()->new_sequential_file(_path, &_reader);
+}
+
+StatusOr<ChunkUniquePtr> SpillFile::read(const Chunk& template_chunk) {
+    if (_reader == nullptr) {
+        return Status::InternalError(strings::Substitute("spill file $0 is not readable", _path));
+    }
+    if (_num_read_chunks >= _num_chunks) {
+        return nullptr;
+    }
+
+    uint8_t header[sizeof(uint32_t)];
+    Slice header_slice(header, sizeof(header));
+    RETURN_IF_ERROR(_reader->read(&header_slice));
+    if (header_slice.size != sizeof(header)) {
+        return Status::Corruption(strings::Substitute("spill file $0 is truncated", _path));
+    }
+    uint32_t size = decode_fixed32_le(header);
+
+    raw::stl_string_resize_uninitialized(&_buffer, size);
+    Slice data(_buffer.data(), size);
+    RETURN_IF_ERROR(_reader->read(&data));
+    if (data.size != size) {
+        return Status::Corruption(strings::Substitute("spill file $0 is truncated", _path));
+    }
+
+    // Skip version and number of rows, see Chunk::serialize
+    const auto* src = reinterpret_cast<const uint8_t*>(_buffer.data()) + sizeof(uint32_t);
+    size_t num_rows = decode_fixed32_le(src);
+    src += sizeof(uint32_t);
+
+    ChunkUniquePtr chunk = template_chunk.clone_empty(num_rows);
+    for (const auto& column : chunk->columns()) {
+        src = column->deserialize_column(src);
+    }
+    if (UNLIKELY(chunk->num_rows() != num_rows || src != reinterpret_cast<const uint8_t*>(_buffer.data()) + size)) {
+        return Status::Corruption(strings::Substitute("failed to deserialize chunk from spill file $0", _path));
+    }
+    _num_read_chunks++;
+    return std::move(chunk);
+}
+
+} // namespace starrocks::vectorized
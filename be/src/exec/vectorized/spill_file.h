@@ -0,0 +1,76 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "column/vectorized_fwd.h"
+#include "common/status.h"
+#include "common/statusor.h"
+
+namespace starrocks {
+class WritableFile;
+class SequentialFile;
+} // namespace starrocks
+
+namespace starrocks::vectorized {
+
+class SpillFile;
+using SpillFilePtr = std::unique_ptr<SpillFile>;
+
+// A local temporary file holding chunks spilled by memory intensive operators
+// (aggregate, join, sort). Chunks are appended once and then read back sequentially
+// in the order they were written, the file is deleted when the object is destroyed.
+//
+// File format:
+// | uint32 chunk size | chunk serialized by Chunk::serialize | ... |
+//
+// Only the column data is persisted, the reader provides a template chunk with the
+// layout (column types, nullability, slot ids) of the written chunks.
+class SpillFile {
+public:
+    // Create a spill file under the spill path of one of the storage data dirs,
+    // the data dirs are used in round robin to spread the IO.
+    // |name| is only used to make the file name readable, e.g. the fragment instance id.
+    static StatusOr<SpillFilePtr> create(const std::string& name);
+
+    // Create a spill file at the exact |path|, the parent directory must exist.
+    static StatusOr<SpillFilePtr> create_at(const std::string& path);
+
+    ~SpillFile();
+
+    SpillFile(const SpillFile&) = delete;
+    SpillFile& operator=(const SpillFile&) = delete;
+
+    // Return error if the file has been switched to read.
+    Status append(const Chunk& chunk);
+
+    // Finish writing and prepare to read from the beginning.
+    Status flip_to_read();
+
+    // Read next chunk, return nullptr when all the chunks have been read.
+    // The returned chunk has the same layout with |template_chunk|.
+    StatusOr<ChunkUniquePtr> read(const Chunk& template_chunk);
+
+    const std::string& path() const { return _path; }
+    size_t num_chunks() const { return _num_chunks; }
+    size_t num_rows() const { return _num_rows; }
+    size_t num_bytes() const { return _num_bytes; }
+
+private:
+    explicit SpillFile(std::string path) : _path(std::move(path)) {}
+
+    std::string _path;
+    std::unique_ptr<WritableFile> _writer;
+    std::unique_ptr<SequentialFile> _reader;
+    // Reused buffer for serialization and deserialization
+    std::string _buffer;
+
+    size_t _num_chunks = 0;
+    size_t _num_rows = 0;
+    size_t _num_bytes = 0;
+    size_t _num_read_chunks = 0;
+};
+
+} // namespace starrocks::vectorized
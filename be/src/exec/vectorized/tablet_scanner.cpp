@@ -35,7 +35,9 @@ Status TabletScanner::init(RuntimeState* runtime_state, const TabletScannerParam
     RETURN_IF_ERROR(_init_reader_params(params.key_ranges));
     const TabletSchema& tablet_schema = _tablet->tablet_schema();
     Schema child_schema = ChunkHelper::convert_schema_to_format_v2(tablet_schema, _reader_columns);
+    _params.chunk_size = ChunkHelper::adaptive_chunk_size(child_schema);
     _reader = std::make_shared<TabletReader>(_tablet, Version(0, _version), std::move(child_schema));
+    _reader->mutable_stats()->collect_column_stats = _runtime_state->query_options().enable_scan_column_io_stats;
     if (_reader_columns.size() == _scanner_columns.size()) {
         _prj_iter = _reader;
     } else {
@@ -106,6 +108,7 @@ Status TabletScanner::_get_tablet(const TInternalScanRange* scan_range) {
         LOG(WARNING) << ss.str();
         return Status::InternalError(ss.str());
     }
+    _tablet->increase_query_count();
     return Status::OK();
 }
 
@@ -124,6 +127,11 @@ Status TabletScanner::_init_reader_params(const std::vector<OlapScanRange*>* key
     PredicateParser parser(_tablet->tablet_schema());
     std::vector<vectorized::ColumnPredicate*> preds;
     _parent->_conjuncts_manager.get_column_predicates(&parser, &preds);
+    _params.runtime_filter_preds_builder = [this](ObjectPool* pool,
+                                                  std::vector<const vectorized::ColumnPredicate*>* preds) {
+        PredicateParser parser(_tablet->tablet_schema());
+        _parent->_conjuncts_manager.get_runtime_filter_predicates(&parser, pool, preds);
+    };
     for (auto* p : preds) {
         _predicate_free_pool.emplace_back(p);
         if (parser.can_pushdown(p)) {
@@ -145,6 +153,9 @@ Status TabletScanner::_init_reader_params(const std::vector<OlapScanRange*>* key
         _params.start_key.push_back(key_range->begin_scan_range);
         _params.end_key.push_back(key_range->end_scan_range);
     }
+    // a full scan reads every data page once, and would evict the pages of the other queries.
+    _params.fill_page_cache = config::storage_page_cache_fill_by_full_scan || !_params.predicates.empty() ||
+                              !_params.start_key.empty();
 
     // Return columns
     if (_skip_aggregation) {
@@ -289,6 +300,7 @@ void TabletScanner::update_counter() {
     COUNTER_UPDATE(_parent->_seg_zm_filtered_counter, _reader->stats().segment_stats_filtered);
     COUNTER_UPDATE(_parent->_zm_filtered_counter, _reader->stats().rows_stats_filtered);
     COUNTER_UPDATE(_parent->_bf_filtered_counter, _reader->stats().rows_bf_filtered);
+    COUNTER_UPDATE(_parent->_pred_cache_filtered_counter, _reader->stats().rows_pred_cache_filtered);
     COUNTER_UPDATE(_parent->_sk_filtered_counter, _reader->stats().rows_key_range_filtered);
     COUNTER_UPDATE(_parent->_index_load_timer, _reader->stats().index_load_ns);
 
@@ -303,6 +315,22 @@ void TabletScanner::update_counter() {
 
     StarRocksMetrics::instance()->query_scan_bytes.increment(_compressed_bytes_read);
     StarRocksMetrics::instance()->query_scan_rows.increment(_raw_rows_read);
+    StarRocksMetrics::instance()->query_scan_pages.increment(_reader->stats().total_pages_num);
+    StarRocksMetrics::instance()->query_scan_cached_pages.increment(_reader->stats().cached_pages_num);
+    StarRocksMetrics::instance()->query_scan_io_time_us.increment(_reader->stats().io_ns / 1000);
+    StarRocksMetrics::instance()->query_scan_decompress_time_us.increment(_reader->stats().decompress_ns / 1000);
+
+    for (const auto& [name, column_stats] : _reader->stats().column_stats) {
+        RuntimeProfile* p = _parent->_scan_profile->create_child("Column " + name);
+        COUNTER_UPDATE(ADD_COUNTER(p, "PagesRead", TUnit::UNIT), column_stats.pages_read);
+        COUNTER_UPDATE(ADD_COUNTER(p, "CachedPagesRead", TUnit::UNIT), column_stats.cached_pages);
+        COUNTER_UPDATE(ADD_TIMER(p, "IOTime"), column_stats.io_ns);
+        COUNTER_UPDATE(ADD_COUNTER(p, "CompressedBytesRead", TUnit::BYTES), column_stats.compressed_bytes_read);
+        COUNTER_UPDATE(ADD_TIMER(p, "DecompressTime"), column_stats.decompress_ns);
+        COUNTER_UPDATE(ADD_COUNTER(p, "UncompressedBytesRead", TUnit::BYTES), column_stats.uncompressed_bytes_read);
+        COUNTER_UPDATE(ADD_TIMER(p, "DecodeTime"), column_stats.decode_ns);
+        COUNTER_UPDATE(ADD_COUNTER(p, "BytesRead", TUnit::BYTES), column_stats.bytes_read);
+    }
 
     if (_reader->stats().decode_dict_ns > 0) {
         RuntimeProfile::Counter* c = ADD_TIMER(_parent->_scan_profile, "DictDecode");
@@ -2,18 +2,25 @@
 
 #include "exec/vectorized/topn_node.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "column/column_helper.h"
+#include "common/config.h"
 #include "exec/pipeline/exchange/local_exchange.h"
 #include "exec/pipeline/exchange/local_exchange_sink_operator.h"
 #include "exec/pipeline/exchange/local_exchange_source_operator.h"
 #include "exec/pipeline/pipeline_builder.h"
+#include "exec/pipeline/sort/sort_context.h"
 #include "exec/pipeline/sort/sort_sink_operator.h"
 #include "exec/pipeline/sort/sort_source_operator.h"
 #include "exec/vectorized/chunks_sorter.h"
 #include "exec/vectorized/chunks_sorter_full_sort.h"
+#include "exec/vectorized/chunks_sorter_heap_sort.h"
 #include "exec/vectorized/chunks_sorter_topn.h"
+#include "exprs/expr.h"
+#include "exprs/vectorized/column_ref.h"
+#include "exprs/vectorized/topn_runtime_filter.h"
 #include "gutil/casts.h"
 #include "runtime/mem_tracker.h"
 
@@ -35,6 +42,7 @@ Status TopNNode::init(const TPlanNode& tnode, RuntimeState* state) {
     _is_asc_order = tnode.sort_node.sort_info.is_asc_order;
     _is_null_first = tnode.sort_node.sort_info.nulls_first;
     bool has_outer_join_child = tnode.sort_node.__isset.has_outer_join_child && tnode.sort_node.has_outer_join_child;
+    _sort_tuple_slot_exprs = tnode.sort_node.sort_info.sort_tuple_slot_exprs;
     if (!_sort_exec_exprs.sort_tuple_slot_expr_ctxs().empty()) {
         size_t size = _sort_exec_exprs.sort_tuple_slot_expr_ctxs().size();
         _order_by_types.resize(size);
@@ -54,6 +62,77 @@ Status TopNNode::init(const TPlanNode& tnode, RuntimeState* state) {
         _runtime_profile->add_info_string("SortKeys", tnode.sort_node.sql_sort_keys);
     }
     _runtime_profile->add_info_string("SortType", tnode.sort_node.use_top_n ? "TopN" : "All");
+    _init_topn_runtime_filter();
+    return Status::OK();
+}
+
+void TopNNode::_init_topn_runtime_filter() {
+    // Only an olap scan right below the TopN, whose output values are not changed by
+    // any projection or outer join, can skip data by the first order-by column.
+    if (!config::enable_topn_runtime_filter || _limit <= 0 || child(0)->type() != TPlanNodeType::OLAP_SCAN_NODE) {
+        return;
+    }
+    Expr* order_by_expr = _sort_exec_exprs.lhs_ordering_expr_ctxs()[0]->root();
+    if (!order_by_expr->is_slotref()) {
+        return;
+    }
+    SlotId slot_id = down_cast<ColumnRef*>(order_by_expr)->slot_id();
+    const auto& sort_tuple_slot_exprs = _sort_exec_exprs.sort_tuple_slot_expr_ctxs();
+    if (!sort_tuple_slot_exprs.empty()) {
+        // map the slot of the materialized tuple to the slot of the child.
+        const auto& slots = _materialized_tuple_desc->slots();
+        auto iter = std::find_if(slots.begin(), slots.end(),
+                                 [slot_id](const SlotDescriptor* slot) { return slot->id() == slot_id; });
+        if (iter == slots.end() || !sort_tuple_slot_exprs[iter - slots.begin()]->root()->is_slotref()) {
+            return;
+        }
+        slot_id = down_cast<ColumnRef*>(sort_tuple_slot_exprs[iter - slots.begin()]->root())->slot_id();
+    }
+    const SlotDescriptor* scan_slot = nullptr;
+    for (TupleDescriptor* tuple_desc : child(0)->row_desc().tuple_descriptors()) {
+        for (SlotDescriptor* slot : tuple_desc->slots()) {
+            if (slot->id() == slot_id) {
+                scan_slot = slot;
+            }
+        }
+    }
+    if (scan_slot == nullptr || !TopNRuntimeFilter::is_supported(scan_slot->type().type)) {
+        return;
+    }
+    // the pages pruned by the boundary may contain NULLs, which must sort after the boundary.
+    if (_is_null_first[0] && scan_slot->is_nullable()) {
+        return;
+    }
+    _topn_runtime_filter = _pool->add(new TopNRuntimeFilter(slot_id, scan_slot->type().type, _is_asc_order[0]));
+    child(0)->runtime_filter_collector().set_topn_runtime_filter(_topn_runtime_filter);
+}
+
+Status TopNNode::init_local_partition_exprs(const std::vector<TExpr>& partition_exprs, bool* partitioned) {
+    *partitioned = false;
+    if (_limit > 0 || partition_exprs.empty()) {
+        return Status::OK();
+    }
+    std::vector<TExpr> input_partition_exprs;
+    if (_sort_tuple_slot_exprs.empty()) {
+        input_partition_exprs = partition_exprs;
+    } else {
+        // map the slot of the materialized tuple to the expr on the child.
+        const auto& slots = _materialized_tuple_desc->slots();
+        for (const TExpr& partition_expr : partition_exprs) {
+            if (partition_expr.nodes.size() != 1 || partition_expr.nodes[0].node_type != TExprNodeType::SLOT_REF) {
+                return Status::OK();
+            }
+            SlotId slot_id = partition_expr.nodes[0].slot_ref.slot_id;
+            auto iter = std::find_if(slots.begin(), slots.end(),
+                                     [slot_id](const SlotDescriptor* slot) { return slot->id() == slot_id; });
+            if (iter == slots.end()) {
+                return Status::OK();
+            }
+            input_partition_exprs.emplace_back(_sort_tuple_slot_exprs[iter - slots.begin()]);
+        }
+    }
+    RETURN_IF_ERROR(Expr::create_expr_trees(_pool, input_partition_exprs, &_local_partition_expr_ctxs));
+    *partitioned = true;
     return Status::OK();
 }
 
@@ -106,6 +185,7 @@ Status TopNNode::get_next(RuntimeState* state, ChunkPtr* chunk, bool* eos) {
         SCOPED_TIMER(_sort_timer);
         _chunks_sorter->get_next(chunk, eos);
     }
+    RETURN_IF_ERROR(_chunks_sorter->status());
     if (*eos) {
         _chunks_sorter = nullptr;
     } else {
@@ -130,15 +210,29 @@ Status TopNNode::close(RuntimeState* state) {
     return ExecNode::close(state);
 }
 
-Status TopNNode::_consume_chunks(RuntimeState* state, ExecNode* child) {
+std::unique_ptr<ChunksSorter> TopNNode::_create_topn_sorter() {
     static const uint SIZE_OF_CHUNK_FOR_TOPN = 3000;
+
+    std::unique_ptr<ChunksSorter> chunks_sorter;
+    // a small N is kept in a heap, without buffering and re-sorting the input chunks.
+    if (_offset + _limit <= config::topn_heap_sort_max_rows) {
+        chunks_sorter = std::make_unique<ChunksSorterHeapSort>(&(_sort_exec_exprs.lhs_ordering_expr_ctxs()),
+                                                               &_is_asc_order, &_is_null_first, _offset, _limit);
+    } else {
+        chunks_sorter =
+                std::make_unique<ChunksSorterTopn>(&(_sort_exec_exprs.lhs_ordering_expr_ctxs()), &_is_asc_order,
+                                                   &_is_null_first, _offset, _limit, SIZE_OF_CHUNK_FOR_TOPN);
+    }
+    chunks_sorter->set_runtime_filter(_topn_runtime_filter);
+    return chunks_sorter;
+}
+
+Status TopNNode::_consume_chunks(RuntimeState* state, ExecNode* child) {
     static const uint SIZE_OF_CHUNK_FOR_FULL_SORT = 5000;
 
     ScopedTimer<MonotonicStopWatch> timer(_sort_timer);
     if (_limit > 0) {
-        _chunks_sorter =
-                std::make_unique<ChunksSorterTopn>(&(_sort_exec_exprs.lhs_ordering_expr_ctxs()), &_is_asc_order,
-                                                   &_is_null_first, _offset, _limit, SIZE_OF_CHUNK_FOR_TOPN);
+        _chunks_sorter = _create_topn_sorter();
     } else {
         _chunks_sorter =
                 std::make_unique<ChunksSorterFullSort>(&(_sort_exec_exprs.lhs_ordering_expr_ctxs()), &_is_asc_order,
@@ -223,33 +317,46 @@ pipeline::OpFactories TopNNode::decompose_to_pipeline(pipeline::PipelineBuilderC
     // step 0: construct pipeline end with sort operator.
     // get operators before sort operator
     OpFactories operators_sink_with_sort = _children[0]->decompose_to_pipeline(context);
-    operators_sink_with_sort = context->maybe_interpolate_local_passthrough_exchange(operators_sink_with_sort);
 
-    static const uint SIZE_OF_CHUNK_FOR_TOPN = 3000;
     static const uint SIZE_OF_CHUNK_FOR_FULL_SORT = 5000;
-    std::shared_ptr<ChunksSorter> chunks_sorter;
+    std::vector<std::shared_ptr<ChunksSorter>> chunks_sorters;
+    // The rows of a partition are all sorted by the same driver, so no driver has to merge the sorted runs.
+    // The keys are not rebalanced, because the rows of the same key must go to the same driver.
+    bool is_partitioned = !_local_partition_expr_ctxs.empty() && context->degree_of_parallelism() > 1;
     if (_limit > 0) {
-        chunks_sorter = std::make_unique<vectorized::ChunksSorterTopn>(&(_sort_exec_exprs.lhs_ordering_expr_ctxs()),
-                                                                       &_is_asc_order, &_is_null_first, _offset, _limit,
-                                                                       SIZE_OF_CHUNK_FOR_TOPN);
+        operators_sink_with_sort = context->maybe_interpolate_local_passthrough_exchange(operators_sink_with_sort);
+        chunks_sorters.emplace_back(_create_topn_sorter());
     } else {
-        chunks_sorter = std::make_unique<vectorized::ChunksSorterFullSort>(&(_sort_exec_exprs.lhs_ordering_expr_ctxs()),
-                                                                           &_is_asc_order, &_is_null_first,
-                                                                           SIZE_OF_CHUNK_FOR_FULL_SORT);
+        if (is_partitioned) {
+            operators_sink_with_sort = context->maybe_interpolate_local_shuffle_exchange(operators_sink_with_sort,
+                                                                                         _local_partition_expr_ctxs);
+        }
+        // Every driver of the predecessor pipeline sorts its own input, and SortSourceOperator
+        // merges the sorted runs of all the drivers unless the input is partitioned.
+        auto* source_operator = down_cast<SourceOperatorFactory*>(operators_sink_with_sort[0].get());
+        for (size_t i = 0; i < source_operator->degree_of_parallelism(); ++i) {
+            chunks_sorters.emplace_back(std::make_shared<vectorized::ChunksSorterFullSort>(
+                    &(_sort_exec_exprs.lhs_ordering_expr_ctxs()), &_is_asc_order, &_is_null_first,
+                    SIZE_OF_CHUNK_FOR_FULL_SORT));
+        }
     }
+    size_t degree_of_parallelism = is_partitioned ? chunks_sorters.size() : 1;
+    auto sort_context =
+            std::make_shared<SortContext>(std::move(chunks_sorters), &(_sort_exec_exprs.lhs_ordering_expr_ctxs()),
+                                          &_is_asc_order, &_is_null_first, is_partitioned);
 
     // add SortSinkOperator to this pipeline
     auto sort_sink_operator = std::make_shared<SortSinkOperatorFactory>(
-            context->next_operator_id(), id(), chunks_sorter, _sort_exec_exprs, _order_by_types,
+            context->next_operator_id(), id(), sort_context, _sort_exec_exprs, _order_by_types,
             _materialized_tuple_desc, child(0)->row_desc(), _row_descriptor);
     operators_sink_with_sort.emplace_back(std::move(sort_sink_operator));
     context->add_pipeline(operators_sink_with_sort);
 
     OpFactories operators_source_with_sort;
     auto sort_source_operator =
-            std::make_shared<SortSourceOperatorFactory>(context->next_operator_id(), id(), std::move(chunks_sorter));
-    // SourceSourceOperator's instance count must be 1
-    sort_source_operator->set_degree_of_parallelism(1);
+            std::make_shared<SortSourceOperatorFactory>(context->next_operator_id(), id(), std::move(sort_context));
+    // SortSourceOperator's instance count must be 1 unless every driver outputs its own partitions.
+    sort_source_operator->set_degree_of_parallelism(degree_of_parallelism);
     operators_source_with_sort.emplace_back(std::move(sort_source_operator));
 
     // return to the following pipeline
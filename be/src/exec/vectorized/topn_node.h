@@ -8,6 +8,7 @@
 namespace starrocks::vectorized {
 
 class ChunksSorter;
+class TopNRuntimeFilter;
 
 // Node for in-memory TopN (ORDER BY ... LIMIT).
 //
@@ -30,7 +31,15 @@ public:
     std::vector<std::shared_ptr<pipeline::OperatorFactory>> decompose_to_pipeline(
             pipeline::PipelineBuilderContext* context) override;
 
+    // Shuffle the input rows locally by |partition_exprs| on the output rows in the pipeline engine,
+    // so that every driver sorts and outputs the rows of its own partitions without a final merge,
+    // e.g. for the PARTITION BY keys of a window. |*partitioned| is false if some of the exprs can not
+    // be mapped to the input rows, then the sorted runs of all the drivers are merged as usual.
+    Status init_local_partition_exprs(const std::vector<TExpr>& partition_exprs, bool* partitioned);
+
 private:
+    void _init_topn_runtime_filter();
+    std::unique_ptr<ChunksSorter> _create_topn_sorter();
     Status _consume_chunks(RuntimeState* state, ExecNode* child);
     ChunkPtr _materialize_chunk_before_sort(Chunk* chunk);
 
@@ -41,6 +50,10 @@ private:
     std::vector<bool> _is_asc_order;
     std::vector<bool> _is_null_first;
     std::vector<OrderByType> _order_by_types;
+    std::vector<TExpr> _sort_tuple_slot_exprs;
+
+    // The partition exprs on the input rows of the local shuffle for a full sort, if any.
+    std::vector<ExprContext*> _local_partition_expr_ctxs;
 
     // Cached descriptor for the materialized tuple. Assigned in Prepare().
     TupleDescriptor* _materialized_tuple_desc;
@@ -51,6 +64,9 @@ private:
 
     std::unique_ptr<ChunksSorter> _chunks_sorter;
 
+    // Published by the sorter and pushed down to the olap scan child, if any.
+    TopNRuntimeFilter* _topn_runtime_filter = nullptr;
+
     RuntimeProfile::Counter* _sort_timer;
 };
 
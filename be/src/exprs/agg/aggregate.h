@@ -100,6 +100,15 @@ public:
                                            int64_t peer_group_start, int64_t peer_group_end, int64_t frame_start,
                                            int64_t frame_end) const {}
 
+    // Whether the rows could be removed from the state by remove_batch_single_state, so the state
+    // of a sliding window frame is updated incrementally instead of being recomputed for every row.
+    virtual bool is_removable() const { return false; }
+
+    // For window functions
+    // Remove the rows [frame_start, frame_end), which were updated into the state before.
+    virtual void remove_batch_single_state(FunctionContext* ctx, AggDataPtr __restrict state, const Column** columns,
+                                           int64_t frame_start, int64_t frame_end) const {}
+
     // Contains a loop with calls to "merge" function.
     // You can collect arguments into array "states"
     // and do a single call to "merge_batch" for devirtualization and inlining.
@@ -141,6 +141,20 @@ public:
         this->data(state).count += frame_end - frame_start;
     }
 
+    // Only the exact decimal sums are removable, the others are accumulated in double.
+    bool is_removable() const override { return pt_is_decimal_of_any_version<PT>; }
+
+    void remove_batch_single_state(FunctionContext* ctx, AggDataPtr __restrict state, const Column** columns,
+                                   int64_t frame_start, int64_t frame_end) const override {
+        if constexpr (pt_is_decimal_of_any_version<PT>) {
+            const auto* data = down_cast<const InputColumnType*>(columns[0])->get_data().data();
+            for (size_t i = frame_start; i < frame_end; ++i) {
+                this->data(state).sum -= data[i];
+            }
+            this->data(state).count -= frame_end - frame_start;
+        }
+    }
+
     void merge(FunctionContext* ctx, const Column* column, AggDataPtr __restrict state, size_t row_num) const override {
         DCHECK(column->is_binary());
         Slice slice = column->get(row_num).get_slice();
@@ -24,6 +24,22 @@ public:
         this->data(state) |= *(col->get_object(row_num));
     }
 
+    // union the bitmaps of the batch at once.
+    void update_batch_single_state(FunctionContext* ctx, size_t batch_size, const Column** columns,
+                                   AggDataPtr __restrict state) const override {
+        merge_batch_single_state(ctx, batch_size, columns[0], state);
+    }
+
+    void merge_batch_single_state(FunctionContext* ctx, size_t batch_size, const Column* column,
+                                  AggDataPtr __restrict state) const override {
+        const BitmapColumn* col = down_cast<const BitmapColumn*>(column);
+        std::vector<const BitmapValue*> values(batch_size);
+        for (size_t i = 0; i < batch_size; ++i) {
+            values[i] = col->get_object(i);
+        }
+        this->data(state).fastunion(values);
+    }
+
     void serialize_to_column(FunctionContext* ctx, ConstAggDataPtr __restrict state, Column* to) const override {
         BitmapColumn* col = down_cast<BitmapColumn*>(to);
         BitmapValue& bitmap = const_cast<BitmapValue&>(this->data(state));
@@ -12,6 +12,7 @@
 #include "column/hash_set.h"
 #include "column/type_traits.h"
 #include "column/vectorized_fwd.h"
+#include "common/config.h"
 #include "exprs/agg/aggregate.h"
 #include "exprs/agg/sum.h"
 #include "gen_cpp/Data_types.h"
@@ -20,6 +21,7 @@
 #include "runtime/mem_pool.h"
 #include "thrift/protocol/TJSONProtocol.h"
 #include "udf/udf_internal.h"
+#include "util/bitmap_value.h"
 #include "util/phmap/phmap_dump.h"
 #include "util/slice.h"
 
@@ -179,28 +181,49 @@ struct DistinctAggregateStateV2<PT, FixedLengthPTGuard<PT>> {
     using SumType = RunTimeCppType<SumResultPT<PT>>;
     using MyHashSet = HashSet<T>;
     static constexpr size_t item_size = phmap::item_serialize_size<MyHashSet>::value;
+    // The integer keys are moved from the hash set to a roaring bitmap once the hash set exceeds
+    // config::distinct_agg_bitmap_threshold keys, which takes much less memory for a large number of keys.
+    static constexpr bool support_bitmap = std::is_integral_v<T> && sizeof(T) <= sizeof(uint64_t);
+    // Written in place of the number of keys of the serialized hash set, the serialized bitmap follows it.
+    static constexpr size_t BITMAP_SERIALIZED_MARKER = std::numeric_limits<size_t>::max();
 
     size_t update(T key) {
+        if (bitmap != nullptr) {
+            bitmap->add(to_bitmap_value(key));
+            return 0;
+        }
         auto pair = set.insert(key);
+        maybe_convert_to_bitmap();
         return pair.second * item_size;
     }
 
     size_t update_with_hash([[maybe_unused]] MemPool* mempool, T key, size_t hash) {
+        if (bitmap != nullptr) {
+            bitmap->add(to_bitmap_value(key));
+            return 0;
+        }
         auto pair = set.emplace_with_hash(hash, key);
+        maybe_convert_to_bitmap();
         return pair.second * item_size;
     }
 
     void prefetch(T key) { set.prefetch(key); }
 
-    int64_t disctint_count() const { return set.size(); }
+    int64_t disctint_count() const { return bitmap != nullptr ? bitmap->cardinality() : set.size(); }
 
     size_t serialize_size() const {
-        size_t size = set.size() * sizeof(T) + sizeof(size_t);
+        size_t size = bitmap != nullptr ? sizeof(size_t) + bitmap->getSizeInBytes()
+                                        : set.size() * sizeof(T) + sizeof(size_t);
         size = std::max(size, MIN_SIZE_OF_HASH_SET_SERIALIZED_DATA);
         return size;
     }
 
     void serialize(uint8_t* dst) const {
+        if (bitmap != nullptr) {
+            memcpy(dst, &BITMAP_SERIALIZED_MARKER, sizeof(size_t));
+            bitmap->write(reinterpret_cast<char*>(dst + sizeof(size_t)));
+            return;
+        }
         size_t size = set.size();
         memcpy(dst, &size, sizeof(size));
         dst += sizeof(size);
@@ -213,10 +236,27 @@ struct DistinctAggregateStateV2<PT, FixedLengthPTGuard<PT>> {
     size_t deserialize_and_merge(const uint8_t* src, size_t len) {
         size_t size = 0;
         memcpy(&size, src, sizeof(size));
+        src += sizeof(size);
+        if constexpr (support_bitmap) {
+            if (size == BITMAP_SERIALIZED_MARKER) {
+                BitmapValue src_bitmap(reinterpret_cast<const char*>(src));
+                convert_to_bitmap();
+                *bitmap |= src_bitmap;
+                return 0;
+            }
+            if (bitmap != nullptr) {
+                for (size_t i = 0; i < size; i++) {
+                    T key;
+                    memcpy(&key, src, sizeof(T));
+                    bitmap->add(to_bitmap_value(key));
+                    src += sizeof(T);
+                }
+                return 0;
+            }
+        }
         set.rehash(set.size() + size);
 
         size_t old_size = set.size();
-        src += sizeof(size);
         for (size_t i = 0; i < size; i++) {
             T key;
             memcpy(&key, src, sizeof(T));
@@ -224,6 +264,7 @@ struct DistinctAggregateStateV2<PT, FixedLengthPTGuard<PT>> {
             src += sizeof(T);
         }
         size_t new_size = set.size();
+        maybe_convert_to_bitmap();
         return (new_size - old_size) * item_size;
     }
 
@@ -234,6 +275,14 @@ struct DistinctAggregateStateV2<PT, FixedLengthPTGuard<PT>> {
             return sum;
         }
 
+        if (bitmap != nullptr) {
+            std::vector<int64_t> keys;
+            bitmap->to_array(&keys);
+            for (int64_t key : keys) {
+                sum += from_bitmap_value(key);
+            }
+            return sum;
+        }
         for (auto& key : set) {
             sum += key;
         }
@@ -248,7 +297,46 @@ struct DistinctAggregateStateV2<PT, FixedLengthPTGuard<PT>> {
 #endif
     }
 
+    // The negative keys are mapped to the upper half of the range of the unsigned type of the same width,
+    // so that the small keys of any sign are kept in the same 32 bits container of the roaring bitmap.
+    static uint64_t to_bitmap_value(T key) {
+        if constexpr (support_bitmap) {
+            return static_cast<uint64_t>(static_cast<std::make_unsigned_t<T>>(key));
+        } else {
+            return 0;
+        }
+    }
+
+    static T from_bitmap_value(uint64_t value) {
+        if constexpr (support_bitmap) {
+            return static_cast<T>(static_cast<std::make_unsigned_t<T>>(value));
+        } else {
+            return T{};
+        }
+    }
+
+    void maybe_convert_to_bitmap() {
+        if constexpr (support_bitmap) {
+            if (UNLIKELY(set.size() > config::distinct_agg_bitmap_threshold)) {
+                convert_to_bitmap();
+            }
+        }
+    }
+
+    void convert_to_bitmap() {
+        if (bitmap != nullptr) {
+            return;
+        }
+        bitmap = std::make_unique<BitmapValue>();
+        for (auto& key : set) {
+            bitmap->add(to_bitmap_value(key));
+        }
+        MyHashSet().swap(set);
+    }
+
     MyHashSet set;
+    // Not null once the keys are moved to the bitmap, only for the integer keys.
+    std::unique_ptr<BitmapValue> bitmap;
 };
 
 template <PrimitiveType PT>
@@ -75,8 +75,7 @@ public:
         DCHECK(column->is_binary());
 
         const BinaryColumn* hll_column = down_cast<const BinaryColumn*>(column);
-        HyperLogLog hll(hll_column->get(row_num).get_slice());
-        this->data(state).merge(hll);
+        this->data(state).merge(hll_column->get_slice(row_num));
     }
 
     void get_values(FunctionContext* ctx, ConstAggDataPtr __restrict state, Column* dst, size_t start,
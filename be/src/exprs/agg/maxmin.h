@@ -9,6 +9,7 @@
 #include "column/type_traits.h"
 #include "exprs/agg/aggregate.h"
 #include "gutil/casts.h"
+#include "simd/reduce.h"
 #include "util/raw_container.h"
 
 namespace starrocks::vectorized {
@@ -187,6 +188,30 @@ public:
         OP()(this->data(state), value);
     }
 
+    void update_batch(FunctionContext* ctx, size_t batch_size, size_t state_offset, const Column** columns,
+                      AggDataPtr* states) const override {
+        DCHECK(!columns[0]->is_nullable() && !columns[0]->is_binary());
+        const auto* data = down_cast<const InputColumnType*>(columns[0])->get_data().data();
+        for (size_t i = 0; i < batch_size; ++i) {
+            OP()(this->data(states[i] + state_offset), data[i]);
+        }
+    }
+
+    void update_batch_single_state(FunctionContext* ctx, size_t batch_size, const Column** columns,
+                                   AggDataPtr __restrict state) const override {
+        DCHECK(!columns[0]->is_nullable() && !columns[0]->is_binary());
+        const auto* data = down_cast<const InputColumnType*>(columns[0])->get_data().data();
+        if constexpr (std::is_arithmetic_v<T> && std::is_same_v<OP, MaxElement<PT, State>>) {
+            this->data(state).result = SIMD::max<T>(data, batch_size, this->data(state).result);
+        } else if constexpr (std::is_arithmetic_v<T> && std::is_same_v<OP, MinElement<PT, State>>) {
+            this->data(state).result = SIMD::min<T>(data, batch_size, this->data(state).result);
+        } else {
+            for (size_t i = 0; i < batch_size; ++i) {
+                OP()(this->data(state), data[i]);
+            }
+        }
+    }
+
     void update_batch_single_state(FunctionContext* ctx, AggDataPtr __restrict state, const Column** columns,
                                    int64_t peer_group_start, int64_t peer_group_end, int64_t frame_start,
                                    int64_t frame_end) const override {
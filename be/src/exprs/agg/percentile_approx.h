@@ -2,12 +2,14 @@
 
 #pragma once
 
+#include <strings.h>
+
 #include "column/column_helper.h"
 #include "column/object_column.h"
 #include "column/vectorized_fwd.h"
 #include "exprs/agg/aggregate.h"
 #include "gutil/casts.h"
-#include "util/tdigest.h"
+#include "util/percentile_value.h"
 
 namespace starrocks::vectorized {
 
@@ -24,6 +26,18 @@ public:
 class PercentileApproxAggregateFunction final
         : public AggregateFunctionBatchHelper<PercentileApproxState, PercentileApproxAggregateFunction> {
 public:
+    // percentile_approx(expr, p, accuracy, 'ddsketch') keeps a DDSketch of the relative accuracy, which is smaller
+    // and faster to update and merge than the TDigest of percentile_approx(expr, p [, compression]).
+    static PercentileValue create_percentile(const Column* const* columns, size_t num_args) {
+        if (num_args == 4) {
+            Slice method = columns[3]->get(0).get_slice();
+            if (method.size == 8 && strncasecmp(method.data, "ddsketch", 8) == 0) {
+                return PercentileValue(columns[2]->get(0).get_double());
+            }
+        }
+        return PercentileValue();
+    }
+
     void update(FunctionContext* ctx, const Column** columns, AggDataPtr state, size_t row_num) const override {
         double column_value;
         if (columns[0]->is_nullable()) {
@@ -38,6 +52,9 @@ public:
         DCHECK(!columns[1]->only_null());
         DCHECK(!columns[1]->is_null(0));
 
+        if (data(state).is_null) {
+            data(state).percentile = std::make_unique<PercentileValue>(create_percentile(columns, ctx->get_num_args()));
+        }
         data(state).percentile->add(implicit_cast<float>(column_value));
         data(state).targetQuantile = columns[1]->get(0).get_double();
         data(state).is_null = false;
@@ -78,12 +95,12 @@ public:
             if (data(state).is_null) {
                 column->append_default();
             } else {
-                down_cast<BinaryColumn*>(column->data_column().get())->append(Slice(result, size));
+                down_cast<BinaryColumn*>(column->data_column().get())->append(Slice(result, size + sizeof(double)));
                 column->null_column_data().push_back(0);
             }
         } else {
             BinaryColumn* column = down_cast<BinaryColumn*>(to);
-            column->append(Slice(result, size));
+            column->append(Slice(result, size + sizeof(double)));
         }
     }
 
@@ -114,6 +131,10 @@ public:
         DCHECK(src[1]->is_constant());
         const auto* const_column = down_cast<const ConstColumn*>(src[1].get());
         double quantile = const_column->get(0).get_double();
+        std::vector<const Column*> args(src.size());
+        for (size_t i = 0; i < src.size(); ++i) {
+            args[i] = src[i].get();
+        }
 
         Bytes& bytes = result->get_bytes();
         bytes.reserve(chunk_size * 20);
@@ -127,7 +148,7 @@ public:
                 dst_nullable_column->set_has_null(true);
                 result->get_offset()[i + 1] = old_size;
             } else {
-                PercentileValue percentile;
+                PercentileValue percentile = create_percentile(args.data(), args.size());
                 percentile.add(input->get_data()[i]);
 
                 size_t new_size = old_size + sizeof(double) + percentile.serialize_size();
@@ -6,6 +6,7 @@
 #include "exprs/agg/aggregate.h"
 #include "gutil/casts.h"
 #include "runtime/primitive_type.h"
+#include "simd/reduce.h"
 
 namespace starrocks::vectorized {
 
@@ -50,12 +51,25 @@ public:
         this->data(state).sum += column.get_data()[row_num];
     }
 
+    void update_batch(FunctionContext* ctx, size_t batch_size, size_t state_offset, const Column** columns,
+                      AggDataPtr* states) const override {
+        const auto* data = down_cast<const InputColumnType*>(columns[0])->get_data().data();
+        for (size_t i = 0; i < batch_size; ++i) {
+            this->data(states[i] + state_offset).sum += data[i];
+        }
+    }
+
     void update_batch_single_state(FunctionContext* ctx, size_t batch_size, const Column** columns,
                                    AggDataPtr __restrict state) const override {
         const auto* column = down_cast<const InputColumnType*>(columns[0]);
         const auto* data = column->get_data().data();
-        for (size_t i = 0; i < batch_size; ++i) {
-            this->data(state).sum += data[i];
+        if constexpr (std::is_integral_v<T> && std::is_integral_v<ResultType>) {
+            // The integer summing is associative, so it can be reduced by SIMD.
+            this->data(state).sum += SIMD::sum<ResultType>(data, batch_size);
+        } else {
+            for (size_t i = 0; i < batch_size; ++i) {
+                this->data(state).sum += data[i];
+            }
         }
     }
 
@@ -69,6 +83,17 @@ public:
         }
     }
 
+    // The floating point sum is not removable, since the result would depend on the order of the rows.
+    bool is_removable() const override { return pt_is_integral<PT> || pt_is_decimal_of_any_version<PT>; }
+
+    void remove_batch_single_state(FunctionContext* ctx, AggDataPtr __restrict state, const Column** columns,
+                                   int64_t frame_start, int64_t frame_end) const override {
+        const auto* data = down_cast<const InputColumnType*>(columns[0])->get_data().data();
+        for (size_t i = frame_start; i < frame_end; ++i) {
+            this->data(state).sum -= data[i];
+        }
+    }
+
     void merge(FunctionContext* ctx, const Column* column, AggDataPtr __restrict state, size_t row_num) const override {
         DCHECK(column->is_numeric() || column->is_decimal());
         const auto* input_column = down_cast<const ResultColumnType*>(column);
@@ -20,6 +20,41 @@ namespace starrocks::vectorized {
                                                                                                       \
     virtual bool is_vectorized() const override { return true; };
 
+// the result of a child is an intermediate column if it's referenced by nobody else, e.g. the result of
+// another arithmetic expression, so it can be overwritten by the result of its parent, which saves the
+// allocation and the memory traffic of a new column for every node of a nested arithmetic expression.
+static inline bool is_reusable_result(const ColumnPtr& column) {
+    return column.use_count() == 1 && !column->is_nullable() && !column->is_constant();
+}
+
+template <PrimitiveType Type, typename ArithmeticOp>
+static inline ColumnPtr evaluate_into(const ColumnPtr& l, const ColumnPtr& r, const ColumnPtr& result) {
+    using CppType = RunTimeCppType<Type>;
+    auto* data3 = ColumnHelper::cast_to_raw<Type>(result)->get_data().data();
+    const size_t size = result->size();
+    if (l->is_constant()) {
+        const auto data1 = ColumnHelper::get_const_value<Type>(l);
+        const auto* data2 = ColumnHelper::cast_to_raw<Type>(r)->get_data().data();
+        for (size_t i = 0; i < size; ++i) {
+            data3[i] = ArithmeticOp::template apply<CppType, CppType, CppType>(data1, data2[i]);
+        }
+    } else if (r->is_constant()) {
+        const auto* data1 = ColumnHelper::cast_to_raw<Type>(l)->get_data().data();
+        const auto data2 = ColumnHelper::get_const_value<Type>(r);
+        for (size_t i = 0; i < size; ++i) {
+            data3[i] = ArithmeticOp::template apply<CppType, CppType, CppType>(data1[i], data2);
+        }
+    } else {
+        DCHECK_EQ(l->size(), r->size());
+        const auto* data1 = ColumnHelper::cast_to_raw<Type>(l)->get_data().data();
+        const auto* data2 = ColumnHelper::cast_to_raw<Type>(r)->get_data().data();
+        for (size_t i = 0; i < size; ++i) {
+            data3[i] = ArithmeticOp::template apply<CppType, CppType, CppType>(data1[i], data2[i]);
+        }
+    }
+    return result;
+}
+
 template <PrimitiveType Type, typename OP>
 class VectorizedArithmeticExpr final : public Expr {
 public:
@@ -31,6 +66,13 @@ public:
             return VectorizedStrictDecimalBinaryFunction<OP, false>::template evaluate<Type>(l, r);
         } else {
             using ArithmeticOp = ArithmeticBinaryOperator<OP, Type>;
+            if (!l->is_nullable() && !r->is_nullable()) {
+                if (is_reusable_result(l)) {
+                    return evaluate_into<Type, ArithmeticOp>(l, r, l);
+                } else if (is_reusable_result(r)) {
+                    return evaluate_into<Type, ArithmeticOp>(l, r, r);
+                }
+            }
             return VectorizedStrictBinaryFunction<ArithmeticOp>::template evaluate<Type>(l, r);
         }
     }
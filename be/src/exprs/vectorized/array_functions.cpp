@@ -2,7 +2,11 @@
 
 #include "exprs/vectorized/array_functions.h"
 
+#include <cstring>
+
 #include "column/array_column.h"
+#include "column/hash_set.h"
+#include "simd/simd.h"
 #include "util/raw_container.h"
 
 namespace starrocks::vectorized {
@@ -137,6 +141,28 @@ private:
             return (*null_map)[idx] != 0;
         };
 
+        if constexpr (ConstTarget && !std::is_same_v<ArrayColumn, ElementColumn>) {
+            // Compare the target with all the elements at once, which has no branch and is vectorized for the
+            // fixed-length types, and then look for a match in the range of each array.
+            const size_t begin = offsets_ptr[0];
+            const size_t end = offsets_ptr[num_array];
+            Column::Filter matches;
+            raw::make_room(&matches, end - begin);
+            auto* matches_ptr = matches.data();
+            for (size_t k = begin; k < end; k++) {
+                if constexpr (NullableElement) {
+                    matches_ptr[k - begin] = !is_null(null_map_elements, k) & (elements_ptr[k] == first_target);
+                } else {
+                    matches_ptr[k - begin] = (elements_ptr[k] == first_target);
+                }
+            }
+            for (size_t i = 0; i < num_array; i++) {
+                size_t array_size = offsets_ptr[i + 1] - offsets_ptr[i];
+                result_ptr[i] = memchr(matches_ptr + offsets_ptr[i] - begin, 1, array_size) != nullptr;
+            }
+            return result;
+        }
+
         for (size_t i = 0; i < num_array; i++) {
             size_t offset = offsets_ptr[i];
             size_t array_size = offsets_ptr[i + 1] - offsets_ptr[i];
@@ -284,6 +310,93 @@ private:
         }
     }
 
+    // Probe the elements of the constant array |array_data| of one row with a hash set.
+    template <typename ElementColumn>
+    static ColumnPtr _probe_const_array(const ArrayColumn& array_data, const Column& target) {
+        using ValueType = typename ElementColumn::ValueType;
+        using ElementSet =
+                std::conditional_t<std::is_same_v<BinaryColumn, ElementColumn>, SliceHashSet, HashSet<ValueType>>;
+
+        const Column* elements = &array_data.elements();
+        const NullColumn::Container* null_elements = nullptr;
+        if (elements->is_nullable()) {
+            null_elements = &down_cast<const NullableColumn*>(elements)->null_column()->get_data();
+            elements = down_cast<const NullableColumn*>(elements)->data_column().get();
+        }
+        const auto* elements_ptr = (const ValueType*)(elements->raw_data());
+        const auto* offsets_ptr = array_data.offsets().get_data().data();
+
+        ElementSet set;
+        bool has_null_element = false;
+        for (size_t k = offsets_ptr[0]; k < offsets_ptr[1]; k++) {
+            if (null_elements != nullptr && (*null_elements)[k] != 0) {
+                has_null_element = true;
+            } else {
+                set.emplace(elements_ptr[k]);
+            }
+        }
+
+        const Column* targets = &target;
+        const NullColumn::Container* null_targets = nullptr;
+        if (targets->is_nullable()) {
+            null_targets = &down_cast<const NullableColumn*>(targets)->null_column()->get_data();
+            targets = down_cast<const NullableColumn*>(targets)->data_column().get();
+        }
+        const auto* targets_ptr = (const ValueType*)(targets->raw_data());
+
+        const size_t num_rows = target.size();
+        auto result = UInt8Column::create();
+        result->resize(num_rows);
+        auto* result_ptr = result->get_data().data();
+        for (size_t i = 0; i < num_rows; i++) {
+            if (null_targets != nullptr && (*null_targets)[i] != 0) {
+                result_ptr[i] = has_null_element;
+            } else {
+                result_ptr[i] = set.contains(targets_ptr[i]);
+            }
+        }
+        return result;
+    }
+
+    // array_contains(<constant array>, x), e.g. the arrays of literals, builds a hash set of the elements once
+    // instead of scanning the array again for each row.
+    static ColumnPtr _array_contains_const_array(const ConstColumn& array, const Column& target) {
+        const size_t num_rows = array.size();
+        // the data of a constant array, which is NOT null, is not nullable.
+        const auto& array_data = down_cast<const ArrayColumn&>(*array.data_column());
+        if (target.is_constant()) {
+            const auto& target_data = *down_cast<const ConstColumn&>(target).data_column();
+            auto result = _array_contains_non_nullable(array_data, target_data);
+            return ConstColumn::create(std::move(result), num_rows);
+        }
+
+        const Column* elements = ColumnHelper::get_data_column(&array_data.elements());
+#define HANDLE_HASH_ELEMENT_TYPE(ElementType)                           \
+    do {                                                                \
+        if (typeid(*elements) == typeid(ElementType)) {                 \
+            return _probe_const_array<ElementType>(array_data, target); \
+        }                                                               \
+    } while (0)
+
+        HANDLE_HASH_ELEMENT_TYPE(Int8Column);
+        HANDLE_HASH_ELEMENT_TYPE(Int16Column);
+        HANDLE_HASH_ELEMENT_TYPE(Int32Column);
+        HANDLE_HASH_ELEMENT_TYPE(Int64Column);
+        HANDLE_HASH_ELEMENT_TYPE(Int128Column);
+        HANDLE_HASH_ELEMENT_TYPE(DecimalColumn);
+        HANDLE_HASH_ELEMENT_TYPE(Decimal32Column);
+        HANDLE_HASH_ELEMENT_TYPE(Decimal64Column);
+        HANDLE_HASH_ELEMENT_TYPE(Decimal128Column);
+        HANDLE_HASH_ELEMENT_TYPE(BinaryColumn);
+        HANDLE_HASH_ELEMENT_TYPE(DateColumn);
+        HANDLE_HASH_ELEMENT_TYPE(TimestampColumn);
+
+        // The other types, e.g. the floating points whose -0.0 equals 0.0, are compared by scanning.
+        auto unfolded = array_data.clone_empty();
+        unfolded->append_value_multiple_times(array_data, 0, num_rows);
+        return _array_contains_non_nullable(down_cast<const ArrayColumn&>(*unfolded), target);
+    }
+
     static ColumnPtr _array_contains_generic(const Column& array, const Column& target) {
         // array_contains(NULL, xxx) -> NULL
         if (array.only_null()) {
@@ -291,6 +404,9 @@ private:
             result->append_nulls(array.size());
             return result;
         }
+        if (array.is_constant()) {
+            return _array_contains_const_array(down_cast<const ConstColumn&>(array), target);
+        }
         if (auto nullable = dynamic_cast<const NullableColumn*>(&array); nullable != nullptr) {
             auto array_col = down_cast<const ArrayColumn*>(nullable->data_column().get());
             auto result = _array_contains_non_nullable(*array_col, target);
@@ -343,21 +459,38 @@ public:
             ResultType sum{};
 
             bool has_data = false;
-            for (size_t j = 0; j < array_size; j++) {
+            if constexpr (pt_is_arithmetic<value_type> || pt_is_decimal<value_type>) {
+                // Sum the flat elements without a branch, so that the loop is vectorized.
+                const ValueType* values = elements_ptr + offset;
                 if constexpr (has_null) {
-                    if ((*null_elements)[offset + j] != 0) {
-                        continue;
+                    const uint8_t* nulls = null_elements->data() + offset;
+                    has_data = SIMD::count_nonzero(nulls, array_size) < array_size;
+                    for (size_t j = 0; j < array_size; j++) {
+                        sum += nulls[j] ? ResultType{} : static_cast<ResultType>(values[j]);
+                    }
+                } else {
+                    has_data = array_size > 0;
+                    for (size_t j = 0; j < array_size; j++) {
+                        sum += values[j];
                     }
                 }
+            } else {
+                for (size_t j = 0; j < array_size; j++) {
+                    if constexpr (has_null) {
+                        if ((*null_elements)[offset + j] != 0) {
+                            continue;
+                        }
+                    }
 
-                has_data = true;
-                auto& value = elements_ptr[offset + j];
-                if constexpr (pt_is_datetime<value_type>) {
-                    sum += value.to_unix_second();
-                } else if constexpr (pt_is_date<value_type>) {
-                    sum += value.julian();
-                } else {
-                    sum += value;
+                    has_data = true;
+                    auto& value = elements_ptr[offset + j];
+                    if constexpr (pt_is_datetime<value_type>) {
+                        sum += value.to_unix_second();
+                    } else if constexpr (pt_is_date<value_type>) {
+                        sum += value.julian();
+                    } else {
+                        sum += value;
+                    }
                 }
             }
 
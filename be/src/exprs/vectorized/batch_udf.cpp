@@ -0,0 +1,101 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exprs/vectorized/batch_udf.h"
+
+#include "column/binary_column.h"
+#include "column/column_helper.h"
+#include "column/nullable_column.h"
+#include "gutil/strings/substitute.h"
+#include "simd/simd.h"
+
+namespace starrocks::vectorized {
+
+using starrocks_udf::UdfColumn;
+using starrocks_udf::UdfResultColumn;
+
+Status check_batch_udf_type(const TypeDescriptor& type) {
+    switch (type.type) {
+    case TYPE_BOOLEAN:
+    case TYPE_TINYINT:
+    case TYPE_SMALLINT:
+    case TYPE_INT:
+    case TYPE_BIGINT:
+    case TYPE_LARGEINT:
+    case TYPE_FLOAT:
+    case TYPE_DOUBLE:
+    case TYPE_CHAR:
+    case TYPE_VARCHAR:
+        return Status::OK();
+    default:
+        return Status::NotSupported(strings::Substitute("Batch UDF doesn't support type $0", type.debug_string()));
+    }
+}
+
+static UdfColumn to_udf_column(const ColumnPtr& column, size_t num_rows) {
+    UdfColumn udf_column{static_cast<int64_t>(num_rows), nullptr, nullptr, nullptr};
+    const Column* data_column = column.get();
+    if (column->is_nullable()) {
+        const auto* nullable_column = down_cast<const NullableColumn*>(column.get());
+        if (nullable_column->has_null()) {
+            udf_column.null_data = nullable_column->immutable_null_column_data().data();
+        }
+        data_column = nullable_column->data_column().get();
+    }
+    if (data_column->is_binary()) {
+        const auto* binary_column = down_cast<const BinaryColumn*>(data_column);
+        udf_column.data = binary_column->get_bytes().data();
+        udf_column.offsets = binary_column->get_offset().data();
+    } else {
+        udf_column.data = data_column->raw_data();
+    }
+    return udf_column;
+}
+
+static void append_string(UdfResultColumn* result, const uint8_t* ptr, int64_t len) {
+    auto* binary_column = static_cast<BinaryColumn*>(result->builder);
+    binary_column->append(Slice(ptr, len));
+}
+
+ColumnPtr call_batch_udf(starrocks_udf::UdfBatchEvaluate fn, FunctionContext* context,
+                         const TypeDescriptor& result_type, const std::vector<TypeDescriptor>& arg_types,
+                         const Columns& args, size_t num_rows) {
+    DCHECK_EQ(arg_types.size(), args.size());
+    Columns columns;
+    std::vector<UdfColumn> udf_args;
+    columns.reserve(args.size());
+    udf_args.reserve(args.size());
+    for (size_t i = 0; i < args.size(); ++i) {
+        // keep the unfolded columns alive during the call.
+        columns.emplace_back(ColumnHelper::unfold_const_column(arg_types[i], num_rows, args[i]));
+        udf_args.emplace_back(to_udf_column(columns.back(), num_rows));
+    }
+
+    auto null_column = NullColumn::create(num_rows, 0);
+    ColumnPtr data_column = ColumnHelper::create_column(result_type, false);
+    UdfResultColumn result{static_cast<int64_t>(num_rows), null_column->get_data().data(), nullptr, append_string,
+                           nullptr};
+    if (data_column->is_binary()) {
+        data_column->reserve(num_rows);
+        result.builder = data_column.get();
+    } else {
+        data_column->resize(num_rows);
+        result.data = data_column->mutable_raw_data();
+    }
+
+    fn(context, static_cast<int>(udf_args.size()), udf_args.data(), &result);
+
+    if (UNLIKELY(data_column->size() != num_rows)) {
+        if (!context->has_error()) {
+            context->set_error(strings::Substitute("Batch UDF returns $0 values for $1 rows", data_column->size(),
+                                                   num_rows)
+                                       .c_str());
+        }
+        data_column->resize(num_rows);
+    }
+    if (SIMD::count_nonzero(null_column->get_data()) == 0) {
+        return data_column;
+    }
+    return NullableColumn::create(data_column, null_column);
+}
+
+} // namespace starrocks::vectorized
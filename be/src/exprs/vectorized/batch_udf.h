@@ -0,0 +1,23 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "column/column.h"
+#include "common/status.h"
+#include "runtime/types.h"
+#include "udf/udf.h"
+
+namespace starrocks::vectorized {
+
+// Return OK if the values of |type| can be passed to or returned from a batch UDF,
+// see UdfBatchEvaluate in udf/udf.h.
+Status check_batch_udf_type(const TypeDescriptor& type);
+
+// Evaluate the batch UDF |fn| on |args| of |num_rows| rows, whose types are |arg_types|,
+// and return the result column of |result_type|.
+// The const columns of |args| are expanded in place. The error of |fn| is left in |context|.
+ColumnPtr call_batch_udf(starrocks_udf::UdfBatchEvaluate fn, FunctionContext* context,
+                         const TypeDescriptor& result_type, const std::vector<TypeDescriptor>& arg_types,
+                         const Columns& args, size_t num_rows);
+
+} // namespace starrocks::vectorized
@@ -4,6 +4,8 @@
 
 #include <ryu/ryu.h>
 
+#include <limits>
+
 #include "column/array_column.h"
 #include "column/column_builder.h"
 #include "column/column_viewer.h"
@@ -12,6 +14,7 @@
 #include "exprs/vectorized/column_ref.h"
 #include "exprs/vectorized/decimal_cast_expr.h"
 #include "exprs/vectorized/unary_function.h"
+#include "gutil/strings/fastmem.h"
 #include "gutil/strings/substitute.h"
 #include "runtime/runtime_state.h"
 #include "util/date_func.h"
@@ -761,22 +764,31 @@ struct CastToString {
 // CastToString will copy string when returning value,
 // it will consume 400ms when casting 10^8 rows.
 // It's better to eliminate the CastToString overload.
+// The bytes are resized to the maximum length of the integers once, and every integer is written to its
+// position directly, then the bytes are shrunk to the actual length.
 #define DEFINE_INT_CAST_TO_STRING(FROM_TYPE, TO_TYPE)                                                       \
     template <>                                                                                             \
     template <>                                                                                             \
     inline ColumnPtr StringUnaryFunction<CastToString>::evaluate<FROM_TYPE, TO_TYPE>(const ColumnPtr& v1) { \
+        using CppType = RunTimeCppType<FROM_TYPE>;                                                          \
+        /* the sign and all the digits */                                                                   \
+        constexpr size_t max_len = std::numeric_limits<CppType>::digits10 + 2;                              \
         auto& r1 = ColumnHelper::cast_to_raw<FROM_TYPE>(v1)->get_data();                                    \
         auto result = RunTimeColumnType<TO_TYPE>::create();                                                 \
         auto& offset = result->get_offset();                                                                \
-        offset.resize(v1->size() + 1);                                                                      \
-        auto& bytes = result->get_bytes();                                                                  \
-        bytes.reserve(sizeof(RunTimeColumnType<FROM_TYPE>) * v1->size());                                   \
         int size = v1->size();                                                                              \
+        offset.resize(size + 1);                                                                            \
+        auto& bytes = result->get_bytes();                                                                  \
+        bytes.resize(max_len * size);                                                                       \
+        auto* begin = bytes.data();                                                                         \
+        auto* pos = begin;                                                                                  \
         for (int i = 0; i < size; ++i) {                                                                    \
             auto f = fmt::format_int(r1[i]);                                                                \
-            bytes.insert(bytes.end(), (uint8_t*)f.data(), (uint8_t*)f.data() + f.size());                   \
-            offset[i + 1] = bytes.size();                                                                   \
+            strings::memcpy_inlined(pos, f.data(), f.size());                                               \
+            pos += f.size();                                                                                \
+            offset[i + 1] = pos - begin;                                                                    \
         }                                                                                                   \
+        bytes.resize(pos - begin);                                                                          \
         return result;                                                                                      \
     }
 
@@ -0,0 +1,160 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exprs/vectorized/common_sub_expr.h"
+
+#include <algorithm>
+#include <string>
+
+#include "common/logging.h"
+
+namespace starrocks::vectorized {
+
+using ExprNodes = std::vector<TExprNode>;
+
+// the nodes of an expression are in pre-order, return the end of the sub expression starting at |begin|.
+static size_t sub_expr_end(const ExprNodes& nodes, size_t begin) {
+    size_t end = begin + 1;
+    for (int i = 0; i < nodes[begin].num_children; ++i) {
+        end = sub_expr_end(nodes, end);
+    }
+    return end;
+}
+
+static bool is_non_deterministic(const TExprNode& node) {
+    if (!node.__isset.fn) {
+        return false;
+    }
+    const std::string& name = node.fn.name.function_name;
+    return name == "rand" || name == "random" || name == "sleep";
+}
+
+static bool can_extract(const ExprNodes& nodes, size_t begin, size_t end) {
+    if (nodes[begin].num_children == 0) {
+        return false;
+    }
+    bool has_slot_ref = false;
+    for (size_t i = begin; i < end; ++i) {
+        if (is_non_deterministic(nodes[i])) {
+            return false;
+        }
+        has_slot_ref |= nodes[i].node_type == TExprNodeType::SLOT_REF;
+    }
+    return has_slot_ref;
+}
+
+namespace {
+
+struct SubExpr {
+    ExprNodes nodes;
+    size_t count = 0;
+    // id of the slot the sub expression is extracted to, valid iff extracted is true.
+    SlotId slot_id = 0;
+    bool extracted = false;
+};
+
+class SubExprSet {
+public:
+    SubExpr* find_or_insert(const ExprNodes& nodes, size_t begin, size_t end) {
+        for (auto& sub_expr : _sub_exprs) {
+            if (sub_expr.nodes.size() == end - begin &&
+                std::equal(sub_expr.nodes.begin(), sub_expr.nodes.end(), nodes.begin() + begin)) {
+                return &sub_expr;
+            }
+        }
+        auto& sub_expr = _sub_exprs.emplace_back();
+        sub_expr.nodes.assign(nodes.begin() + begin, nodes.begin() + end);
+        return &sub_expr;
+    }
+
+private:
+    // there are only a few expressions in a projection, a linear search is enough.
+    std::vector<SubExpr> _sub_exprs;
+};
+
+} // namespace
+
+static void count_sub_exprs(const ExprNodes& nodes, SubExprSet* sub_exprs) {
+    // skip the root.
+    for (size_t i = 1; i < nodes.size(); ++i) {
+        size_t end = sub_expr_end(nodes, i);
+        if (can_extract(nodes, i, end)) {
+            sub_exprs->find_or_insert(nodes, i, end)->count++;
+        }
+    }
+}
+
+struct RewriteContext {
+    SubExprSet* sub_exprs;
+    TupleId tuple_id;
+    SlotId* next_slot_id;
+    std::vector<SlotId>* common_slot_ids;
+    std::vector<TExpr>* common_exprs;
+};
+
+// copy the sub expression starting at |begin| to |result|, with its outermost common sub expressions
+// replaced by slot refs, return the end of the sub expression.
+static size_t rewrite_sub_expr(const ExprNodes& nodes, size_t begin, bool is_root, RewriteContext* ctx,
+                               ExprNodes* result) {
+    size_t end = sub_expr_end(nodes, begin);
+    if (!is_root && can_extract(nodes, begin, end)) {
+        SubExpr* sub_expr = ctx->sub_exprs->find_or_insert(nodes, begin, end);
+        if (sub_expr->count > 1) {
+            if (!sub_expr->extracted) {
+                sub_expr->extracted = true;
+                sub_expr->slot_id = (*ctx->next_slot_id)--;
+                ctx->common_slot_ids->emplace_back(sub_expr->slot_id);
+                ctx->common_exprs->emplace_back().__set_nodes(sub_expr->nodes);
+            }
+
+            const TExprNode& node = nodes[begin];
+            TExprNode slot_node;
+            slot_node.__set_node_type(TExprNodeType::SLOT_REF);
+            slot_node.__set_type(node.type);
+            slot_node.__set_num_children(0);
+            slot_node.__set_output_scale(node.output_scale);
+            TSlotRef slot_ref;
+            slot_ref.__set_slot_id(sub_expr->slot_id);
+            slot_ref.__set_tuple_id(ctx->tuple_id);
+            slot_node.__set_slot_ref(slot_ref);
+            if (node.__isset.use_vectorized) {
+                slot_node.__set_use_vectorized(node.use_vectorized);
+            }
+            if (node.__isset.is_nullable) {
+                slot_node.__set_is_nullable(node.is_nullable);
+            }
+            result->emplace_back(std::move(slot_node));
+            return end;
+        }
+    }
+
+    result->emplace_back(nodes[begin]);
+    size_t child = begin + 1;
+    for (int i = 0; i < nodes[begin].num_children; ++i) {
+        child = rewrite_sub_expr(nodes, child, false, ctx, result);
+    }
+    DCHECK_EQ(child, end);
+    return end;
+}
+
+size_t extract_common_sub_exprs(std::vector<TExpr>* exprs, TupleId tuple_id, SlotId* next_slot_id,
+                                std::vector<SlotId>* common_slot_ids, std::vector<TExpr>* common_exprs) {
+    SubExprSet sub_exprs;
+    for (const auto& expr : *exprs) {
+        count_sub_exprs(expr.nodes, &sub_exprs);
+    }
+
+    size_t num_common_exprs = common_exprs->size();
+    RewriteContext ctx{&sub_exprs, tuple_id, next_slot_id, common_slot_ids, common_exprs};
+    for (auto& expr : *exprs) {
+        if (expr.nodes.empty()) {
+            continue;
+        }
+        ExprNodes result;
+        result.reserve(expr.nodes.size());
+        rewrite_sub_expr(expr.nodes, 0, true, &ctx, &result);
+        expr.nodes = std::move(result);
+    }
+    return common_exprs->size() - num_common_exprs;
+}
+
+} // namespace starrocks::vectorized
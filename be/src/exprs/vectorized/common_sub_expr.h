@@ -0,0 +1,26 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <vector>
+
+#include "common/global_types.h"
+#include "gen_cpp/Exprs_types.h"
+
+namespace starrocks::vectorized {
+
+// Extract the sub expressions which appear more than once in |exprs|, e.g. the `get_json_string(payload, '$.a')`
+// referenced by several output slots of a projection, so that each of them is evaluated only once per chunk.
+//
+// Two sub expressions are the same iff their thrift nodes are equal, only the proper sub expressions which
+// reference a slot and call no non-deterministic function are extracted, and the roots of |exprs| are kept.
+// Every extracted sub expression is replaced in |exprs| by the slot ref of a new slot, whose id is taken from
+// |next_slot_id| downwards, and the (slot id, expression) pairs are appended to |common_slot_ids| and
+// |common_exprs|. The extracted expressions only reference the slots |exprs| reference, so they can be evaluated
+// in any order before |exprs|.
+//
+// Return the number of extracted sub expressions.
+size_t extract_common_sub_exprs(std::vector<TExpr>* exprs, TupleId tuple_id, SlotId* next_slot_id,
+                                std::vector<SlotId>* common_slot_ids, std::vector<TExpr>* common_exprs);
+
+} // namespace starrocks::vectorized
@@ -2,6 +2,8 @@
 
 #include "exprs/vectorized/compound_predicate.h"
 
+#include "column/chunk.h"
+#include "column/column_viewer.h"
 #include "common/object_pool.h"
 #include "exprs/predicate.h"
 #include "exprs/vectorized/binary_function.h"
@@ -28,6 +30,79 @@ DEFINE_BINARY_FUNCTION_WITH_IMPL(AndImpl, l_value, r_value) {
     return l_value & r_value;
 }
 
+// The result of AND (OR) is decided by the left child on the rows it's false (true) and not null, where
+// the right child is not cared. If there are only a few undecided rows left, evaluate the right child on
+// the undecided rows only, so that the expensive right children, e.g. regexp and json functions, don't
+// compute the rows filtered out already. The copy of the referenced columns of the undecided rows pays
+// off only if the right child is evaluated on no more than half of the rows.
+static constexpr double kSelectiveEvalMaxUndecidedRatio = 0.5;
+
+// Evaluate |expr| on the rows of |chunk| the left child |l| doesn't decide, and return a column of all
+// the rows with arbitrary values on the decided rows. Return nullptr if it's better to evaluate |expr|
+// on all the rows.
+template <bool is_and>
+static ColumnPtr evaluate_undecided_rows(Expr* expr, ExprContext* context, Chunk* chunk, const ColumnPtr& l,
+                                         size_t num_decided) {
+    size_t num_rows = l->size();
+    size_t num_undecided = num_rows - num_decided;
+    if (chunk == nullptr || chunk->has_tuple_columns() ||
+        num_undecided > num_rows * kSelectiveEvalMaxUndecidedRatio) {
+        return nullptr;
+    }
+
+    std::vector<SlotId> slot_ids;
+    expr->get_slot_ids(&slot_ids);
+    if (slot_ids.empty()) {
+        return nullptr;
+    }
+    for (SlotId slot_id : slot_ids) {
+        if (!chunk->is_slot_exist(slot_id)) {
+            return nullptr;
+        }
+    }
+
+    std::vector<uint32_t> indexes;
+    indexes.reserve(num_undecided);
+    ColumnViewer<TYPE_BOOLEAN> l_viewer(l);
+    for (uint32_t i = 0; i < num_rows; ++i) {
+        // AND is undecided on true or null rows, and OR on false or null rows.
+        if (l_viewer.is_null(i) || (l_viewer.value(i) != 0) == is_and) {
+            indexes.emplace_back(i);
+        }
+    }
+
+    Chunk undecided_chunk;
+    for (SlotId slot_id : slot_ids) {
+        if (undecided_chunk.is_slot_exist(slot_id)) {
+            continue;
+        }
+        const ColumnPtr& src = chunk->get_column_by_slot_id(slot_id);
+        ColumnPtr dst = src->clone_empty();
+        dst->append_selective(*src, indexes.data(), 0, indexes.size());
+        undecided_chunk.append_column(std::move(dst), slot_id);
+    }
+
+    ColumnPtr r = expr->evaluate(context, &undecided_chunk);
+    ColumnViewer<TYPE_BOOLEAN> r_viewer(r);
+    auto data_column = BooleanColumn::create(num_rows, 0);
+    auto& data = data_column->get_data();
+    for (size_t i = 0; i < indexes.size(); ++i) {
+        data[indexes[i]] = r_viewer.value(i);
+    }
+    // keep the nullability of the right child, which the result follows.
+    if (!r->is_nullable() && !r->only_null()) {
+        return data_column;
+    }
+    auto null_column = NullColumn::create(num_rows, 0);
+    auto& nulls = null_column->get_data();
+    for (size_t i = 0; i < indexes.size(); ++i) {
+        nulls[indexes[i]] = r_viewer.is_null(i);
+    }
+    auto result = NullableColumn::create(std::move(data_column), std::move(null_column));
+    result->update_has_null();
+    return result;
+}
+
 class VectorizedAndCompoundPredicate final : public Predicate {
 public:
     DEFINE_COMPOUND_CONSTRUCT(VectorizedAndCompoundPredicate);
@@ -40,7 +115,10 @@ public:
             return l->clone();
         }
 
-        auto r = _children[1]->evaluate(context, ptr);
+        auto r = evaluate_undecided_rows<true>(_children[1], context, ptr, l, l_falses);
+        if (r == nullptr) {
+            r = _children[1]->evaluate(context, ptr);
+        }
 
         return VectorizedLogicPredicateBinaryFunction<AndNullImpl, AndImpl>::template evaluate<TYPE_BOOLEAN>(l, r);
     }
@@ -72,7 +150,10 @@ public:
             return l->clone();
         }
 
-        auto r = _children[1]->evaluate(context, ptr);
+        auto r = evaluate_undecided_rows<false>(_children[1], context, ptr, l, l_trues);
+        if (r == nullptr) {
+            r = _children[1]->evaluate(context, ptr);
+        }
 
         return VectorizedLogicPredicateBinaryFunction<OrNullImpl, OrImpl>::template evaluate<TYPE_BOOLEAN>(l, r);
     }
@@ -102,6 +102,18 @@ struct DecimalBinaryFunction {
         const auto rhs_scale = rhs_column->scale();
         auto [precision, scale, adjust_scale] = compute_decimal_result_type<ResultCppType, Op>(lhs_scale, rhs_scale);
 
+        if constexpr (check_overflow && is_div_op<Op>) {
+            // Division only overflows when the lhs is scaled up, and the values of the lhs are bounded by its
+            // precision, so if the precision of the lhs scaled up is still in the limit of the type, no row can
+            // overflow, and the rows are evaluated by the loop free of the overflow checks. The rows divided by
+            // zero are set to null by the caller.
+            using LhsCppType = RunTimeCppType<LhsType>;
+            if (lhs_column->precision() + adjust_scale <= decimal_precision_limit<LhsCppType>) {
+                return DecimalBinaryFunction<false, Op>::template evaluate<lhs_is_const, rhs_is_const, LhsType,
+                                                                           RhsType, ResultType>(lhs, rhs);
+            }
+        }
+
         auto result_column = ResultColumnType::create(precision, scale, num_rows);
         auto result_data = &ColumnHelper::cast_to_raw<ResultType>(result_column)->get_data().front();
         NullColumnPtr null_column;
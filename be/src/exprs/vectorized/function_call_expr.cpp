@@ -6,6 +6,7 @@
 #include "column/const_column.h"
 #include "column/fixed_length_column.h"
 #include "exprs/anyval_util.h"
+#include "exprs/vectorized/batch_udf.h"
 #include "exprs/vectorized/builtin_functions.h"
 #include "gutil/strings/substitute.h"
 #include "runtime/user_function_cache.h"
@@ -18,17 +19,19 @@ Status VectorizedFunctionCallExpr::prepare(starrocks::RuntimeState* state, const
                                            starrocks::ExprContext* context) {
     RETURN_IF_ERROR(Expr::prepare(state, row_desc, context));
 
-    if (!_fn.__isset.fid) {
+    if (_fn.binary_type == TFunctionBinaryType::NATIVE) {
+        RETURN_IF_ERROR(_prepare_native_udf());
+    } else if (!_fn.__isset.fid) {
         return Status::InternalError("Vectorized engine doesn't implement function " + _fn.name.function_name);
-    }
-
-    _fn_desc = BuiltinFunctions::find_builtin_function(_fn.fid);
+    } else {
+        _fn_desc = BuiltinFunctions::find_builtin_function(_fn.fid);
 
-    if (_fn_desc == nullptr || _fn_desc->scalar_function == nullptr) {
-        return Status::InternalError("Vectorized engine doesn't implement function " + _fn.name.function_name);
+        if (_fn_desc == nullptr || _fn_desc->scalar_function == nullptr) {
+            return Status::InternalError("Vectorized engine doesn't implement function " + _fn.name.function_name);
+        }
     }
 
-    if (_fn_desc->args_nums > _children.size()) {
+    if (_fn_desc != nullptr && _fn_desc->args_nums > _children.size()) {
         return Status::InternalError(strings::Substitute("Vectorized function $0 requires $1 arguments but given $2",
                                                          _fn.name.function_name, _fn_desc->args_nums,
                                                          _children.size()));
@@ -48,6 +51,34 @@ Status VectorizedFunctionCallExpr::prepare(starrocks::RuntimeState* state, const
     return Status::OK();
 }
 
+Status VectorizedFunctionCallExpr::_prepare_native_udf() {
+    if (!_fn.__isset.scalar_fn) {
+        return Status::InternalError("Native UDF " + _fn.name.function_name + " isn't a scalar function");
+    }
+    RETURN_IF_ERROR(check_batch_udf_type(_type));
+    for (Expr* child : _children) {
+        RETURN_IF_ERROR(check_batch_udf_type(child->type()));
+        _udf_arg_types.emplace_back(child->type());
+    }
+
+    auto* cache = UserFunctionCache::instance();
+    void* fn_ptr = nullptr;
+    RETURN_IF_ERROR(cache->get_function_ptr(_fn.id, _fn.scalar_fn.symbol, _fn.hdfs_location, _fn.checksum, &fn_ptr,
+                                            &_cache_entry));
+    _udf_evaluate = reinterpret_cast<starrocks_udf::UdfBatchEvaluate>(fn_ptr);
+    if (_fn.scalar_fn.__isset.prepare_fn_symbol && !_fn.scalar_fn.prepare_fn_symbol.empty()) {
+        RETURN_IF_ERROR(cache->get_function_ptr(_fn.id, _fn.scalar_fn.prepare_fn_symbol, _fn.hdfs_location,
+                                                _fn.checksum, &fn_ptr, &_cache_entry));
+        _udf_prepare = reinterpret_cast<starrocks_udf::UdfPrepare>(fn_ptr);
+    }
+    if (_fn.scalar_fn.__isset.close_fn_symbol && !_fn.scalar_fn.close_fn_symbol.empty()) {
+        RETURN_IF_ERROR(cache->get_function_ptr(_fn.id, _fn.scalar_fn.close_fn_symbol, _fn.hdfs_location,
+                                                _fn.checksum, &fn_ptr, &_cache_entry));
+        _udf_close = reinterpret_cast<starrocks_udf::UdfClose>(fn_ptr);
+    }
+    return Status::OK();
+}
+
 Status VectorizedFunctionCallExpr::open(starrocks::RuntimeState* state, starrocks::ExprContext* context,
                                         FunctionContext::FunctionStateScope scope) {
     RETURN_IF_ERROR(Expr::open(state, context, scope));
@@ -63,7 +94,15 @@ Status VectorizedFunctionCallExpr::open(starrocks::RuntimeState* state, starrock
         fn_ctx->impl()->set_constant_columns(std::move(const_columns));
     }
 
-    if (_fn_desc->prepare_function != nullptr) {
+    if (_udf_prepare != nullptr) {
+        if (scope == FunctionContext::FRAGMENT_LOCAL) {
+            _udf_prepare(fn_ctx, FunctionContext::FRAGMENT_LOCAL);
+        }
+        _udf_prepare(fn_ctx, FunctionContext::THREAD_LOCAL);
+        if (fn_ctx->has_error()) {
+            return Status::InternalError(fn_ctx->error_msg());
+        }
+    } else if (_fn_desc != nullptr && _fn_desc->prepare_function != nullptr) {
         if (scope == FunctionContext::FRAGMENT_LOCAL) {
             RETURN_IF_ERROR(_fn_desc->prepare_function(fn_ctx, FunctionContext::FRAGMENT_LOCAL));
         }
@@ -94,7 +133,14 @@ Status VectorizedFunctionCallExpr::open(starrocks::RuntimeState* state, starrock
 
 void VectorizedFunctionCallExpr::close(starrocks::RuntimeState* state, starrocks::ExprContext* context,
                                        FunctionContext::FunctionStateScope scope) {
-    if (_fn_desc != nullptr && _fn_desc->close_function != nullptr) {
+    if (_udf_close != nullptr) {
+        FunctionContext* fn_ctx = context->fn_context(_fn_context_index);
+        _udf_close(fn_ctx, FunctionContext::THREAD_LOCAL);
+
+        if (scope == FunctionContext::FRAGMENT_LOCAL) {
+            _udf_close(fn_ctx, FunctionContext::FRAGMENT_LOCAL);
+        }
+    } else if (_fn_desc != nullptr && _fn_desc->close_function != nullptr) {
         FunctionContext* fn_ctx = context->fn_context(_fn_context_index);
         _fn_desc->close_function(fn_ctx, FunctionContext::THREAD_LOCAL);
 
@@ -103,6 +149,11 @@ void VectorizedFunctionCallExpr::close(starrocks::RuntimeState* state, starrocks
         }
     }
 
+    if (scope == FunctionContext::FRAGMENT_LOCAL && _cache_entry != nullptr) {
+        UserFunctionCache::instance()->release_entry(_cache_entry);
+        _cache_entry = nullptr;
+    }
+
     Expr::close(state, context, scope);
 }
 
@@ -142,6 +193,11 @@ ColumnPtr VectorizedFunctionCallExpr::evaluate(starrocks::ExprContext* context,
     }
 #endif
 
+    if (_udf_evaluate != nullptr) {
+        size_t num_rows = ptr != nullptr ? ptr->num_rows() : 1;
+        return call_batch_udf(_udf_evaluate, fn_ctx, _type, _udf_arg_types, args, num_rows);
+    }
+
     ColumnPtr result = _fn_desc->scalar_function(fn_ctx, args);
     // For no args function call (pi, e)
     if (result->is_constant() && ptr != nullptr) {
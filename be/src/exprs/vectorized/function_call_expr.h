@@ -29,8 +29,17 @@ protected:
     ColumnPtr evaluate(ExprContext* context, vectorized::Chunk* ptr) override;
 
 private:
+    // Look up the batch UDF and its prepare/close functions from the library of the native UDF.
+    Status _prepare_native_udf();
+
     const FunctionDescriptor* _fn_desc;
 
+    // Set iff this is a native UDF, which is evaluated a chunk per call, see UdfBatchEvaluate in udf/udf.h.
+    starrocks_udf::UdfBatchEvaluate _udf_evaluate = nullptr;
+    starrocks_udf::UdfPrepare _udf_prepare = nullptr;
+    starrocks_udf::UdfClose _udf_close = nullptr;
+    std::vector<TypeDescriptor> _udf_arg_types;
+
     // is rand/random function.
     bool _is_rand_function = false;
 };
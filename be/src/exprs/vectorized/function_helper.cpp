@@ -10,6 +10,28 @@
 
 namespace starrocks::vectorized {
 
+// dst[i] = null1[i] | null2[i], |dst| may be the same as |null1|.
+static void union_null_data(const uint8_t* null1, const uint8_t* null2, uint8_t* dst, size_t size) {
+    const uint8_t* null1_end = null1 + size;
+#if defined(__AVX2__)
+    constexpr auto AVX2_SIZE = sizeof(__m256i);
+    const uint8_t* null1_avx2_end = null1 + (size & ~(AVX2_SIZE - 1));
+    for (; null1 < null1_avx2_end; null1 += AVX2_SIZE, null2 += AVX2_SIZE, dst += AVX2_SIZE) {
+        _mm256_storeu_si256((__m256i*)dst,
+                            _mm256_or_si256(_mm256_loadu_si256((__m256i*)null1), _mm256_loadu_si256((__m256i*)null2)));
+    }
+#elif defined(__SSE2__)
+    constexpr auto SSE2_SIZE = sizeof(__m128i);
+    const uint8_t* null1_sse2_end = null1 + (size & ~(SSE2_SIZE - 1));
+    for (; null1 < null1_sse2_end; null1 += SSE2_SIZE, null2 += SSE2_SIZE, dst += SSE2_SIZE) {
+        _mm_storeu_si128((__m128i*)dst, _mm_or_si128(_mm_loadu_si128((__m128i*)null1), _mm_loadu_si128((__m128i*)null2)));
+    }
+#endif
+    for (; null1 < null1_end; ++null1, ++null2, ++dst) {
+        *dst = *null1 | *null2;
+    }
+}
+
 NullColumnPtr FunctionHelper::union_nullable_column(const ColumnPtr& v1, const ColumnPtr& v2) {
     // union nullable column
     ColumnPtr result;
@@ -17,12 +39,12 @@ NullColumnPtr FunctionHelper::union_nullable_column(const ColumnPtr& v1, const C
         const auto& n1 = ColumnHelper::as_raw_column<NullableColumn>(v1)->null_column();
         const auto& n2 = ColumnHelper::as_raw_column<NullableColumn>(v2)->null_column();
         if (!v1->has_null()) {
-            result = std::move(n2->clone());
+            result = n2->clone();
+        } else if (!v2->has_null()) {
+            result = n1->clone();
+        } else {
+            return union_null_column(n1, n2);
         }
-        if (!v2->has_null()) {
-            result = std::move(n1->clone());
-        }
-        return union_null_column(n1, n2);
     } else if (v1->is_nullable()) {
         result = std::move(ColumnHelper::as_raw_column<NullableColumn>(v1)->null_column()->clone());
     } else if (v2->is_nullable()) {
@@ -41,58 +63,24 @@ void FunctionHelper::union_produce_nullable_column(const ColumnPtr& v1, const Co
 
     if (v1->has_null()) {
         auto* null1 = down_cast<NullableColumn*>(v1.get())->null_column()->get_data().data();
-
-        int size = v1->size();
-        for (int i = 0; i < size; ++i) {
-            result[i] = result[i] | null1[i];
-        }
+        union_null_data(result, null1, result, v1->size());
     }
 
     if (v2->has_null()) {
         auto* null2 = down_cast<NullableColumn*>(v2.get())->null_column()->get_data().data();
-
-        int size = v2->size();
-        for (int i = 0; i < size; ++i) {
-            result[i] = result[i] | null2[i];
-        }
+        union_null_data(result, null2, result, v2->size());
     }
 }
 
 NullColumnPtr FunctionHelper::union_null_column(const NullColumnPtr& v1, const NullColumnPtr& v2) {
     // union null column
-    auto null1_begin = (uint8_t*)v1->get_data().data();
-    auto null2_begin = (uint8_t*)v2->get_data().data();
-
     const size_t row_num = v1->size();
     NullColumnPtr null_result = NullColumn::create();
 
     auto& result_data = null_result->get_data();
     raw::make_room(&result_data, row_num);
-    auto result_begin = (uint8_t*)result_data.data();
-    const size_t bytes_size = sizeof(NullColumn::ValueType) * row_num;
-    const auto null1_end = null1_begin + bytes_size;
-
-    auto null1_curr = null1_begin;
-    auto null2_curr = null2_begin;
-    auto result_curr = result_begin;
-#if defined(__AVX2__)
-    constexpr auto AVX2_SIZE = sizeof(__m256i);
-    const auto null1_avx2_end = null1_begin + (bytes_size & ~(AVX2_SIZE - 1));
-    for (; null1_curr < null1_avx2_end; null1_curr += AVX2_SIZE, null2_curr += AVX2_SIZE, result_curr += AVX2_SIZE) {
-        _mm256_storeu_si256((__m256i*)result_curr, _mm256_or_si256(_mm256_loadu_si256((__m256i*)null1_curr),
-                                                                   _mm256_loadu_si256((__m256i*)null2_curr)));
-    }
-#elif defined(__SSE2__)
-    constexpr auto SSE2_SIZE = sizeof(__m128i);
-    const auto null1_sse2_end = null1_begin + (bytes_size & ~(SSE2_SIZE - 1));
-    for (; null1_curr < null1_sse2_end; null1_curr += SSE2_SIZE, null2_curr += SSE2_SIZE, result_curr += SSE2_SIZE) {
-        _mm_storeu_si128((__m128i*)result_curr,
-                         _mm_or_si128(_mm_loadu_si128((__m128i*)null1_curr), _mm_loadu_si128((__m128i*)null2_curr)));
-    }
-#endif
-    for (; null1_curr < null1_end; ++null1_curr, ++null2_curr, ++result_curr) {
-        *result_curr = *null1_curr | *null2_curr;
-    }
+    union_null_data(v1->get_data().data(), v2->get_data().data(), result_data.data(),
+                    sizeof(NullColumn::ValueType) * row_num);
     return null_result;
 }
 
@@ -108,6 +96,9 @@ ColumnPtr FunctionHelper::merge_column_and_null_column(ColumnPtr&& column, NullC
     } else if (column->is_nullable()) {
         DCHECK_EQ(column->size(), null_column->size());
         auto* nullable_column = down_cast<NullableColumn*>(column.get());
+        if (!nullable_column->has_null()) {
+            return NullableColumn::create(std::move(nullable_column->data_column()), std::move(null_column));
+        }
         auto new_null_column = union_null_column(nullable_column->null_column(), null_column);
         return NullableColumn::create(std::move(nullable_column->data_column()), new_null_column);
     } else {
@@ -7,6 +7,7 @@
 #include "column/column_viewer.h"
 #include "common/logging.h"
 #include "geo/geo_types.h"
+#include "simd/simd.h"
 
 namespace starrocks::vectorized {
 
@@ -232,6 +233,28 @@ ColumnPtr GeoFunctions::st_y(FunctionContext* context, const Columns& columns) {
 }
 
 ColumnPtr GeoFunctions::st_distance_sphere(FunctionContext* context, const Columns& columns) {
+    // The coordinates of the rows without NULL are computed as arrays.
+    bool flat = true;
+    for (const auto& column : columns) {
+        flat &= !column->is_constant() && !column->has_null();
+    }
+    if (flat) {
+        const double* coords[4];
+        for (int i = 0; i < 4; ++i) {
+            const Column* data = ColumnHelper::get_data_column(columns[i].get());
+            coords[i] = down_cast<const DoubleColumn*>(data)->get_data().data();
+        }
+        const size_t size = columns[0]->size();
+        auto result = DoubleColumn::create(size);
+        auto invalid = NullColumn::create(size);
+        GeoPoint::st_distance_sphere(coords[0], coords[1], coords[2], coords[3], size, result->get_data().data(),
+                                     invalid->get_data().data());
+        if (SIMD::count_nonzero(invalid->get_data()) == 0) {
+            return result;
+        }
+        return NullableColumn::create(std::move(result), std::move(invalid));
+    }
+
     ColumnViewer<TYPE_DOUBLE> x_lng(columns[0]);
     ColumnViewer<TYPE_DOUBLE> x_lat(columns[1]);
     ColumnViewer<TYPE_DOUBLE> y_lng(columns[2]);
@@ -326,6 +349,9 @@ Status GeoFunctions::st_contains_prepare(FunctionContext* ctx, FunctionContext::
                 contains_ctx->shapes[i] = GeoShape::from_encoded(str_value.data, str_value.size);
                 if (contains_ctx->shapes[i] == nullptr) {
                     contains_ctx->is_null = true;
+                } else if (i == 0 && contains_ctx->shapes[i]->type() == GEO_SHAPE_POLYGON) {
+                    // the constant polygon is tested against many points.
+                    down_cast<GeoPolygon*>(contains_ctx->shapes[i])->build_covering();
                 }
             }
         }
@@ -346,6 +372,8 @@ ColumnPtr GeoFunctions::st_contains(FunctionContext* context, const Columns& col
         return ColumnHelper::create_const_null_column(columns[0]->size());
     }
 
+    // the points, the common right hand side, are decoded into this one without an allocation per row.
+    GeoPoint point;
     auto size = columns[0]->size();
     for (int row = 0; row < size; ++row) {
         if (lhs_viewer.is_null(row) || rhs_viewer.is_null(row)) {
@@ -363,6 +391,8 @@ ColumnPtr GeoFunctions::st_contains(FunctionContext* context, const Columns& col
         for (i = 0; i < 2; ++i) {
             if (state != nullptr && state->shapes[i] != nullptr) {
                 shapes[i] = state->shapes[i];
+            } else if (i == 1 && point.decode_from(strs[i]->data, strs[i]->size)) {
+                shapes[i] = &point;
             } else {
                 shapes[i] = local_state.shapes[i] = GeoShape::from_encoded(strs[i]->data, strs[i]->size);
                 if (shapes[i] == nullptr) {
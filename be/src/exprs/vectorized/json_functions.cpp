@@ -246,57 +246,30 @@ void JsonFunctions::parse_json_paths(const std::string& path_string, std::vector
     get_parsed_paths(paths, parsed_paths);
 }
 
-rapidjson::Value* JsonFunctions::get_json_object(FunctionContext* context, const std::string& json_string,
-                                                 const std::string& path_string, const JsonFunctionType& fntype,
-                                                 rapidjson::Document* document) {
-    // split path by ".", and escape quota by "\"
-    // eg:
-    //    '$.text#abc.xyz'  ->  [$, text#abc, xyz]
-    //    '$."text.abc".xyz'  ->  [$, text.abc, xyz]
-    //    '$."text.abc"[1].xyz'  ->  [$, text.abc[1], xyz]
-    std::vector<JsonPath>* parsed_paths;
-    std::vector<JsonPath> tmp_parsed_paths;
-#ifndef BE_TEST
-    parsed_paths =
-            reinterpret_cast<std::vector<JsonPath>*>(context->get_function_state(FunctionContext::FRAGMENT_LOCAL));
-    if (parsed_paths == nullptr) {
-        boost::tokenizer<boost::escaped_list_separator<char> > tok(
-                path_string, boost::escaped_list_separator<char>("\\", ".", "\""));
-        std::vector<std::string> paths(tok.begin(), tok.end());
-        get_parsed_paths(paths, &tmp_parsed_paths);
-        parsed_paths = &tmp_parsed_paths;
-    }
-#else
-    boost::tokenizer<boost::escaped_list_separator<char> > tok(path_string,
-                                                               boost::escaped_list_separator<char>("\\", ".", "\""));
-    std::vector<std::string> paths(tok.begin(), tok.end());
-    get_parsed_paths(paths, &tmp_parsed_paths);
-    parsed_paths = &tmp_parsed_paths;
-#endif
-
-    VLOG(10) << "first parsed path: " << (*parsed_paths)[0].debug_string();
+rapidjson::Value* JsonFunctions::get_json_object(const std::vector<JsonPath>& parsed_paths, const Slice& json_string,
+                                                 const JsonFunctionType& fntype, rapidjson::Document* document) {
+    VLOG(10) << "first parsed path: " << parsed_paths[0].debug_string();
 
-    if (!(*parsed_paths)[0].is_valid) {
+    if (!parsed_paths[0].is_valid) {
         return document;
     }
 
-    if (UNLIKELY((*parsed_paths).size() == 1)) {
+    if (UNLIKELY(parsed_paths.size() == 1)) {
         if (fntype == JSON_FUN_STRING) {
-            document->SetString(json_string.c_str(), document->GetAllocator());
+            document->SetString(json_string.data, json_string.size, document->GetAllocator());
         } else {
             return document;
         }
     }
 
-    //rapidjson::Document document;
-    document->Parse(json_string.c_str());
+    document->Parse(json_string.data, json_string.size);
     if (UNLIKELY(document->HasParseError())) {
         VLOG(1) << "Error at offset " << document->GetErrorOffset() << ": "
                 << GetParseError_En(document->GetParseError());
         document->SetNull();
         return document;
     }
-    return match_value(*parsed_paths, document, document->GetAllocator());
+    return match_value(parsed_paths, document, document->GetAllocator());
 }
 
 JsonFunctionType JsonTypeTraits<TYPE_INT>::JsonType = JSON_FUN_INT;
@@ -308,6 +281,17 @@ ColumnPtr JsonFunctions::iterate_rows(FunctionContext* context, const Columns& c
     auto json_viewer = ColumnViewer<TYPE_VARCHAR>(columns[0]);
     auto path_viewer = ColumnViewer<TYPE_VARCHAR>(columns[1]);
 
+    // the constant path is parsed in json_path_prepare.
+    const std::vector<JsonPath>* const_parsed_paths = nullptr;
+#ifndef BE_TEST
+    const_parsed_paths =
+            reinterpret_cast<std::vector<JsonPath>*>(context->get_function_state(FunctionContext::FRAGMENT_LOCAL));
+#endif
+    std::vector<JsonPath> row_parsed_paths;
+    std::string path_string;
+    // the document and the memory of its allocator are reused across rows.
+    rapidjson::Document document;
+
     ColumnBuilder<primitive_type> result;
     auto size = columns[0]->size();
     for (int row = 0; row < size; ++row) {
@@ -321,19 +305,30 @@ ColumnPtr JsonFunctions::iterate_rows(FunctionContext* context, const Columns& c
             result.append_null();
             continue;
         }
-        std::string json_string(json_value.data, json_value.size);
 
-        auto path_value = path_viewer.value(row);
-        std::string path_string(path_value.data, path_value.size);
-        // Must remove or replace the escape sequence.
-        path_string.erase(std::remove(path_string.begin(), path_string.end(), '\\'), path_string.end());
-        if (path_string.empty()) {
-            result.append_null();
-            continue;
+        const std::vector<JsonPath>* parsed_paths = const_parsed_paths;
+        if (parsed_paths == nullptr) {
+            auto path_value = path_viewer.value(row);
+            path_string.assign(path_value.data, path_value.size);
+            // Must remove or replace the escape sequence.
+            path_string.erase(std::remove(path_string.begin(), path_string.end(), '\\'), path_string.end());
+            if (path_string.empty()) {
+                result.append_null();
+                continue;
+            }
+            // split path by ".", and escape quota by "\"
+            // eg:
+            //    '$.text#abc.xyz'  ->  [$, text#abc, xyz]
+            //    '$."text.abc".xyz'  ->  [$, text.abc, xyz]
+            //    '$."text.abc"[1].xyz'  ->  [$, text.abc[1], xyz]
+            row_parsed_paths.clear();
+            parse_json_paths(path_string, &row_parsed_paths);
+            parsed_paths = &row_parsed_paths;
         }
 
-        rapidjson::Document document;
-        rapidjson::Value* root = JsonFunctions::get_json_object(context, json_string, path_string,
+        document.SetNull();
+        document.GetAllocator().Clear();
+        rapidjson::Value* root = JsonFunctions::get_json_object(*parsed_paths, json_value,
                                                                 JsonTypeTraits<primitive_type>::JsonType, &document);
 
         if constexpr (primitive_type == TYPE_INT) {
@@ -125,9 +125,8 @@ private:
     template <PrimitiveType primitive_type>
     static ColumnPtr iterate_rows(FunctionContext* context, const Columns& columns);
 
-    static rapidjson::Value* get_json_object(FunctionContext* context, const std::string& json_string,
-                                             const std::string& path_string, const JsonFunctionType& fntype,
-                                             rapidjson::Document* document);
+    static rapidjson::Value* get_json_object(const std::vector<JsonPath>& parsed_paths, const Slice& json_string,
+                                             const JsonFunctionType& fntype, rapidjson::Document* document);
 
     static rapidjson::Value* match_value(const std::vector<JsonPath>& parsed_paths, rapidjson::Value* document,
                                          rapidjson::Document::AllocatorType& mem_allocator,
@@ -107,6 +107,37 @@ bool SimdBlockFilter::check_equal(const SimdBlockFilter& bf) const {
            memcmp(_directory, bf._directory, alloc_size) == 0;
 }
 
+void JoinRuntimeFilter::compute_shuffle_hashes(const Column* column, int8_t join_mode,
+                                               std::vector<uint32_t>* hashes) {
+    size_t size = column->size();
+    if (join_mode == TRuntimeFilterBuildJoinMode::PARTITIONED) {
+        hashes->assign(size, HashUtil::FNV_SEED);
+        column->fnv_hash(hashes->data(), 0, size);
+    } else {
+        DCHECK_EQ(join_mode, TRuntimeFilterBuildJoinMode::BUCKET_SHUFFLE);
+        hashes->assign(size, 0);
+        column->crc32_hash(hashes->data(), 0, size);
+    }
+}
+
+const std::vector<uint32_t>& JoinRuntimeFilter::ShuffleHashCache::get_or_compute(const Column* column,
+                                                                                 int8_t join_mode) {
+    for (size_t i = 0; i < _num_entries; i++) {
+        if (_entries[i].column == column && _entries[i].join_mode == join_mode) {
+            DCHECK_EQ(column->size(), _entries[i].hashes.size());
+            return _entries[i].hashes;
+        }
+    }
+    if (_num_entries == _entries.size()) {
+        _entries.emplace_back();
+    }
+    Entry& entry = _entries[_num_entries++];
+    entry.column = column;
+    entry.join_mode = join_mode;
+    compute_shuffle_hashes(column, join_mode, &entry.hashes);
+    return entry.hashes;
+}
+
 size_t JoinRuntimeFilter::max_serialized_size() const {
     // todo(yan): noted that it's not serialize compatible with 32-bit and 64-bit.
     size_t size = sizeof(_has_null) + sizeof(_size) + sizeof(_hash_partition_number) + sizeof(_join_mode);
@@ -197,10 +197,36 @@ public:
 
     virtual void init(size_t hash_table_size) = 0;
 
+    // Computes the hash of every row of |column| the same way as the data stream sender of |join_mode|
+    // does, so that a row is tested against the partition of the runtime filter built from its shuffle.
+    static void compute_shuffle_hashes(const Column* column, int8_t join_mode, std::vector<uint32_t>* hashes);
+
+    // The shuffle hashes of the columns of a chunk, shared by the runtime filters probing the same column,
+    // so that the hash of a row is computed once instead of once per runtime filter.
+    // The owner must clear() it whenever the rows of the chunk change, and must only pass columns
+    // which stay alive until then.
+    class ShuffleHashCache {
+    public:
+        const std::vector<uint32_t>& get_or_compute(const Column* column, int8_t join_mode);
+        void clear() { _num_entries = 0; }
+
+    private:
+        struct Entry {
+            const Column* column;
+            int8_t join_mode;
+            std::vector<uint32_t> hashes;
+        };
+        // The entries after _num_entries are kept to reuse their memory.
+        std::vector<Entry> _entries;
+        size_t _num_entries = 0;
+    };
+
     class RunningContext {
     public:
         Column::Filter selection;
         std::vector<uint32_t> hash_values;
+        // Set by the caller if the shuffle hashes of the input column can be shared, see ShuffleHashCache.
+        ShuffleHashCache* shuffle_hash_cache = nullptr;
     };
 
     virtual Column::Filter& evaluate(Column* input_column, RunningContext* ctx) const = 0;
@@ -364,17 +390,16 @@ public:
             if (_join_mode == TRuntimeFilterBuildJoinMode::BORADCAST) {
                 // since there is only one copy and one rf
                 _hash_values.assign(size, 0);
-            } else if (_join_mode == TRuntimeFilterBuildJoinMode::PARTITIONED) {
-                _hash_values.assign(size, HashUtil::FNV_SEED);
-                input_column->fnv_hash(_hash_values.data(), 0, size);
-                for (size_t i = 0; i < size; i++) {
-                    _hash_values[i] %= _hash_partition_number;
+            } else {
+                const std::vector<uint32_t>* shuffle_hashes = &_hash_values;
+                if (ctx->shuffle_hash_cache != nullptr) {
+                    shuffle_hashes = &ctx->shuffle_hash_cache->get_or_compute(input_column, _join_mode);
+                } else {
+                    compute_shuffle_hashes(input_column, _join_mode, &_hash_values);
                 }
-            } else if (_join_mode == TRuntimeFilterBuildJoinMode::BUCKET_SHUFFLE) {
-                _hash_values.assign(size, 0);
-                input_column->crc32_hash(_hash_values.data(), 0, size);
+                _hash_values.resize(size);
                 for (size_t i = 0; i < size; i++) {
-                    _hash_values[i] %= _hash_partition_number;
+                    _hash_values[i] = (*shuffle_hashes)[i] % _hash_partition_number;
                 }
             }
         }
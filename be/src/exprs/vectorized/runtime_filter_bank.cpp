@@ -2,6 +2,7 @@
 
 #include "exprs/vectorized/runtime_filter_bank.h"
 
+#include <algorithm>
 #include <thread>
 
 #include "column/column.h"
@@ -255,6 +256,36 @@ Status RuntimeFilterBuildDescriptor::init(ObjectPool* pool, const TRuntimeFilter
     return Status::OK();
 }
 
+void RuntimeFilterSelectivityWindow::add(size_t input_rows, size_t output_rows, int64_t ns) {
+    _samples[_next] = Sample{input_rows, output_rows, ns};
+    _next = (_next + 1) % k_num_samples;
+    _num_samples = std::min(_num_samples + 1, k_num_samples);
+}
+
+double RuntimeFilterSelectivityWindow::selectivity() const {
+    size_t input_rows = 0;
+    size_t output_rows = 0;
+    for (size_t i = 0; i < _num_samples; i++) {
+        input_rows += _samples[i].input_rows;
+        output_rows += _samples[i].output_rows;
+    }
+    return input_rows == 0 ? 1.0 : output_rows * 1.0 / input_rows;
+}
+
+double RuntimeFilterSelectivityWindow::cost_per_row() const {
+    size_t input_rows = 0;
+    int64_t ns = 0;
+    for (size_t i = 0; i < _num_samples; i++) {
+        input_rows += _samples[i].input_rows;
+        ns += _samples[i].ns;
+    }
+    return input_rows == 0 ? 0.0 : ns * 1.0 / input_rows;
+}
+
+double RuntimeFilterSelectivityWindow::rank() const {
+    return cost_per_row() / std::max(1.0 - selectivity(), 1e-6);
+}
+
 Status RuntimeFilterProbeDescriptor::init(ObjectPool* pool, const TRuntimeFilterDescription& desc,
                                           TPlanNodeId node_id) {
     _filter_id = desc.filter_id;
@@ -283,9 +314,27 @@ Status RuntimeFilterProbeDescriptor::prepare(RuntimeState* state, const RowDescr
     _latency_timer = ADD_COUNTER(p, strings::Substitute("JoinRuntimeFilter/$0/latency", _filter_id), TUnit::TIME_NS);
     // not set yet.
     _latency_timer->set((int64_t)(-1));
+    _input_counter = ADD_COUNTER(p, strings::Substitute("JoinRuntimeFilter/$0/input_rows", _filter_id), TUnit::UNIT);
+    _output_counter =
+            ADD_COUNTER(p, strings::Substitute("JoinRuntimeFilter/$0/output_rows", _filter_id), TUnit::UNIT);
+    _skip_counter =
+            ADD_COUNTER(p, strings::Substitute("JoinRuntimeFilter/$0/skipped_chunks", _filter_id), TUnit::UNIT);
     return Status::OK();
 }
 
+void RuntimeFilterProbeDescriptor::update_filter_counters(size_t input_rows, size_t output_rows) {
+    if (_input_counter != nullptr) {
+        _input_counter->update(input_rows);
+        _output_counter->update(output_rows);
+    }
+}
+
+void RuntimeFilterProbeDescriptor::update_skip_counter() {
+    if (_skip_counter != nullptr) {
+        _skip_counter->update(1);
+    }
+}
+
 Status RuntimeFilterProbeDescriptor::open(RuntimeState* state) {
     if (_probe_expr_ctx != nullptr) {
         RETURN_IF_ERROR(_probe_expr_ctx->open(state));
@@ -329,12 +378,19 @@ std::string RuntimeFilterProbeDescriptor::debug_string() const {
 }
 
 static const int default_runtime_filter_wait_timeout_ms = 1000;
+// every how many chunks the selectivity of the filters is measured again.
+static const size_t runtime_filter_sample_interval = 32;
+// the filters passing more rows than this fraction are skipped until the next sampled chunk.
+static const double runtime_filter_max_selectivity = 0.5;
 
 RuntimeFilterProbeCollector::RuntimeFilterProbeCollector() : _wait_timeout_ms(default_runtime_filter_wait_timeout_ms) {}
 
 RuntimeFilterProbeCollector::RuntimeFilterProbeCollector(RuntimeFilterProbeCollector&& that) noexcept
         : _descriptors(std::move(that._descriptors)),
-          _selectivity(std::move(that._selectivity)),
+          _selected_filters(std::move(that._selected_filters)),
+          _skipped_filters(std::move(that._skipped_filters)),
+          _num_sampled_filters(that._num_sampled_filters),
+          _topn_runtime_filter(that._topn_runtime_filter),
           _input_chunk_nums(that._input_chunk_nums),
           _wait_timeout_ms(that._wait_timeout_ms) {}
 
@@ -361,27 +417,45 @@ void RuntimeFilterProbeCollector::close(RuntimeState* state) {
     }
 }
 
+JoinRuntimeFilter::RunningContext* RuntimeFilterProbeCollector::running_context(RuntimeFilterProbeDescriptor* rf_desc) {
+    JoinRuntimeFilter::RunningContext* ctx = rf_desc->runtime_filter_ctx();
+    // a slot ref returns the column of the chunk itself, which outlives the cached hashes,
+    // and runtime filters probing the same slot share them.
+    SlotId slot_id;
+    ctx->shuffle_hash_cache = rf_desc->is_probe_slot_ref(&slot_id) ? &_shuffle_hash_cache : nullptr;
+    return ctx;
+}
+
 void RuntimeFilterProbeCollector::do_evaluate(vectorized::Chunk* chunk) {
-    if ((_input_chunk_nums++ & 31) == 0) {
+    _shuffle_hash_cache.clear();
+    size_t num_arrived_filters = 0;
+    for (auto& it : _descriptors) {
+        num_arrived_filters += it.second->runtime_filter() != nullptr;
+    }
+    // measure the filters arrived since the last sampled chunk at once instead of waiting for the next one.
+    if ((_input_chunk_nums++ % runtime_filter_sample_interval) == 0 || num_arrived_filters != _num_sampled_filters) {
+        _num_sampled_filters = num_arrived_filters;
         update_selectivity(chunk);
         return;
     }
-    if (!_selectivity.empty()) {
-        for (auto& kv : _selectivity) {
-            RuntimeFilterProbeDescriptor* rf_desc = kv.second;
-            const JoinRuntimeFilter* filter = rf_desc->runtime_filter();
-            if (filter == nullptr) continue;
-            ColumnPtr column = rf_desc->probe_expr_ctx()->evaluate(chunk);
-            vectorized::Column::Filter& selection = filter->evaluate(column.get(), rf_desc->runtime_filter_ctx());
-            _run_filter_nums += 1;
-            size_t true_count = SIMD::count_nonzero(selection);
-
-            if (true_count == 0) {
-                chunk->set_num_rows(0);
-                return;
-            } else {
-                chunk->filter(selection);
-            }
+    for (RuntimeFilterProbeDescriptor* rf_desc : _skipped_filters) {
+        rf_desc->update_skip_counter();
+    }
+    for (RuntimeFilterProbeDescriptor* rf_desc : _selected_filters) {
+        const JoinRuntimeFilter* filter = rf_desc->runtime_filter();
+        size_t input_rows = chunk->num_rows();
+        ColumnPtr column = rf_desc->probe_expr_ctx()->evaluate(chunk);
+        vectorized::Column::Filter& selection = filter->evaluate(column.get(), running_context(rf_desc));
+        _run_filter_nums += 1;
+        size_t true_count = SIMD::count_nonzero(selection);
+        rf_desc->update_filter_counters(input_rows, true_count);
+
+        if (true_count == 0) {
+            chunk->set_num_rows(0);
+            return;
+        } else if (true_count != input_rows) {
+            chunk->filter(selection);
+            _shuffle_hash_cache.clear();
         }
     }
 }
@@ -406,51 +480,45 @@ void RuntimeFilterProbeCollector::evaluate(vectorized::Chunk* chunk) {
 }
 
 void RuntimeFilterProbeCollector::update_selectivity(vectorized::Chunk* chunk) {
-    _selectivity.clear();
+    _selected_filters.clear();
+    _skipped_filters.clear();
     size_t chunk_size = chunk->num_rows();
     vectorized::Column::Filter* selection = nullptr;
     for (auto& it : _descriptors) {
         RuntimeFilterProbeDescriptor* rf_desc = it.second;
         const JoinRuntimeFilter* filter = rf_desc->runtime_filter();
         if (filter == nullptr) continue;
+        int64_t start = MonotonicNanos();
         ColumnPtr column = rf_desc->probe_expr_ctx()->evaluate(chunk);
-        vectorized::Column::Filter& new_selection = filter->evaluate(column.get(), rf_desc->runtime_filter_ctx());
+        vectorized::Column::Filter& new_selection = filter->evaluate(column.get(), running_context(rf_desc));
         _run_filter_nums += 1;
         size_t true_count = SIMD::count_nonzero(new_selection);
-        double selectivity = true_count * 1.0 / chunk_size;
-        if (selectivity <= 0.5) {     // useful filter
-            if (selectivity < 0.05) { // very useful filter, could early return
-                _selectivity.clear();
-                _selectivity.emplace(selectivity, rf_desc);
-                chunk->filter(new_selection);
-                return;
-            }
-
-            // Only choose three most selective runtime filters
-            if (_selectivity.size() < 3) {
-                _selectivity.emplace(selectivity, rf_desc);
-            } else {
-                auto it = _selectivity.end();
-                it--;
-                if (selectivity < it->first) {
-                    _selectivity.erase(it);
-                    _selectivity.emplace(selectivity, rf_desc);
-                }
-            }
+        RuntimeFilterSelectivityWindow* window = rf_desc->selectivity_window();
+        window->add(chunk_size, true_count, MonotonicNanos() - start);
+        rf_desc->update_filter_counters(chunk_size, true_count);
+        if (window->selectivity() <= runtime_filter_max_selectivity) {
+            _selected_filters.push_back(rf_desc);
+        } else {
+            _skipped_filters.push_back(rf_desc);
+        }
 
-            if (selection == nullptr) {
-                selection = &new_selection;
-            } else {
-                // Merge selection
-                uint8_t* dest = selection->data();
-                const uint8_t* src = new_selection.data();
-                for (size_t j = 0; j < chunk_size; ++j) {
-                    dest[j] = src[j] & dest[j];
-                }
+        // the rows of this chunk are filtered by all the filters evaluated anyway.
+        if (selection == nullptr) {
+            selection = &new_selection;
+        } else {
+            // Merge selection
+            uint8_t* dest = selection->data();
+            const uint8_t* src = new_selection.data();
+            for (size_t j = 0; j < chunk_size; ++j) {
+                dest[j] = src[j] & dest[j];
             }
         }
     }
-    if (!_selectivity.empty()) {
+    std::sort(_selected_filters.begin(), _selected_filters.end(),
+              [](RuntimeFilterProbeDescriptor* lhs, RuntimeFilterProbeDescriptor* rhs) {
+                  return lhs->selectivity_window()->rank() < rhs->selectivity_window()->rank();
+              });
+    if (selection != nullptr) {
         chunk->filter(*selection);
     }
 }
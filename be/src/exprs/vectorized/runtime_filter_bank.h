@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <array>
 #include <mutex>
 
 #include "column/column.h"
@@ -11,6 +12,7 @@
 #include "exprs/expr_context.h"
 #include "exprs/vectorized/column_ref.h"
 #include "exprs/vectorized/runtime_filter.h"
+#include "exprs/vectorized/topn_runtime_filter.h"
 #include "gen_cpp/InternalService_types.h"
 #include "gen_cpp/PlanNodes_types.h"
 #include "gen_cpp/Types_types.h"
@@ -81,6 +83,30 @@ private:
     JoinRuntimeFilter* _runtime_filter = nullptr;
 };
 
+// The selectivity and the cost per row of a runtime filter measured on the last sampled chunks.
+class RuntimeFilterSelectivityWindow {
+public:
+    static constexpr size_t k_num_samples = 4;
+
+    void add(size_t input_rows, size_t output_rows, int64_t ns);
+    bool empty() const { return _num_samples == 0; }
+    // the fraction of the rows passing the filter, 1 if nothing is measured yet.
+    double selectivity() const;
+    double cost_per_row() const;
+    // the cost to filter out a row, by which the filters are ordered, the lower the earlier.
+    double rank() const;
+
+private:
+    struct Sample {
+        size_t input_rows = 0;
+        size_t output_rows = 0;
+        int64_t ns = 0;
+    };
+    std::array<Sample, k_num_samples> _samples;
+    size_t _next = 0;
+    size_t _num_samples = 0;
+};
+
 class RuntimeFilterProbeDescriptor {
 public:
     RuntimeFilterProbeDescriptor() = default;
@@ -105,6 +131,9 @@ public:
     void replace_probe_expr_ctx(RuntimeState* state, const RowDescriptor& row_desc, ExprContext* new_probe_expr_ctx);
     std::string debug_string() const;
     JoinRuntimeFilter::RunningContext* runtime_filter_ctx() { return &_runtime_filter_ctx; }
+    RuntimeFilterSelectivityWindow* selectivity_window() { return &_selectivity_window; }
+    void update_filter_counters(size_t input_rows, size_t output_rows);
+    void update_skip_counter();
 
 private:
     friend class HashJoinNode;
@@ -114,6 +143,11 @@ private:
     std::atomic<const JoinRuntimeFilter*> _runtime_filter;
     std::shared_ptr<const JoinRuntimeFilter> _shared_runtime_filter;
     JoinRuntimeFilter::RunningContext _runtime_filter_ctx;
+    RuntimeFilterSelectivityWindow _selectivity_window;
+    // the rows in and out of this filter, and the chunks it's skipped for as it filters too few rows.
+    RuntimeProfile::Counter* _input_counter = nullptr;
+    RuntimeProfile::Counter* _output_counter = nullptr;
+    RuntimeProfile::Counter* _skip_counter = nullptr;
     // we want to measure when this runtime filter is applied since it's opened.
     RuntimeProfile::Counter* _latency_timer = nullptr;
     int64_t _open_timestamp = 0;
@@ -141,14 +175,27 @@ public:
     void wait();
     std::string debug_string() const;
     bool empty() const { return _descriptors.empty(); }
+    // the boundary of the TopN above, pushed down to the storage only.
+    void set_topn_runtime_filter(const TopNRuntimeFilter* filter) { _topn_runtime_filter = filter; }
+    const TopNRuntimeFilter* topn_runtime_filter() const { return _topn_runtime_filter; }
 
 private:
+    // Evaluate all the filters arrived on |chunk| one by one to measure their selectivity, and choose the ones
+    // to evaluate on the following chunks.
     void update_selectivity(vectorized::Chunk* chunk);
     void do_evaluate(vectorized::Chunk* chunk);
+    JoinRuntimeFilter::RunningContext* running_context(RuntimeFilterProbeDescriptor* rf_desc);
     void init_counter();
     // mapping from filter id to runtime filter descriptor.
     std::map<int32_t, RuntimeFilterProbeDescriptor*> _descriptors;
-    std::map<double, RuntimeFilterProbeDescriptor*> _selectivity;
+    // the filters evaluated until the next sampled chunk ordered by their ranks, and the ones skipped.
+    std::vector<RuntimeFilterProbeDescriptor*> _selected_filters;
+    std::vector<RuntimeFilterProbeDescriptor*> _skipped_filters;
+    // the number of the filters arrived when the last chunk is sampled.
+    size_t _num_sampled_filters = 0;
+    // shuffle hashes of the probe columns of the current chunk, valid until its rows change.
+    JoinRuntimeFilter::ShuffleHashCache _shuffle_hash_cache;
+    const TopNRuntimeFilter* _topn_runtime_filter = nullptr;
     size_t _input_chunk_nums = 0;
     int _run_filter_nums = 0;
     int _wait_timeout_ms = 0;
@@ -1536,20 +1536,47 @@ ColumnPtr StringFunctions::append_trailing_char_if_absent(FunctionContext* conte
 }
 
 // length
-DEFINE_UNARY_FN_WITH_IMPL(lengthImpl, str) {
-    return str.size;
+// byte length of every row is the difference of adjacent offsets, no need to visit the bytes.
+static inline void lengths_from_offsets(const Offsets& offsets, Int32Column::Container* lengths) {
+    const size_t num_rows = offsets.size() - 1;
+    lengths->resize(num_rows);
+    auto* dst = lengths->data();
+    const auto* src = offsets.data();
+    for (size_t i = 0; i < num_rows; ++i) {
+        dst[i] = src[i + 1] - src[i];
+    }
 }
 
-ColumnPtr StringFunctions::length(FunctionContext* context, const Columns& columns) {
-    return VectorizedStrictUnaryFunction<lengthImpl>::evaluate<TYPE_VARCHAR, TYPE_INT>(columns[0]);
-}
+template <bool is_utf8>
+struct LengthFunction {
+    template <PrimitiveType Type, PrimitiveType ResultType>
+    static inline ColumnPtr evaluate(const ColumnPtr& column) {
+        auto* src = down_cast<BinaryColumn*>(column.get());
+        auto& src_bytes = src->get_bytes();
+        auto result = Int32Column::create();
+        auto& lengths = result->get_data();
+        // the char length of ascii strings equals to their byte length.
+        if (!is_utf8 || validate_ascii_fast((const char*)src_bytes.data(), src_bytes.size())) {
+            lengths_from_offsets(src->get_offset(), &lengths);
+            return result;
+        }
 
-DEFINE_UNARY_FN_WITH_IMPL(utf8LengthImpl, str) {
-    return utf8_len(str.data, str.data + str.size);
+        const auto num_rows = src->size();
+        lengths.resize(num_rows);
+        for (size_t i = 0; i < num_rows; ++i) {
+            auto s = src->get_slice(i);
+            lengths[i] = utf8_len(s.data, s.data + s.size);
+        }
+        return result;
+    }
+};
+
+ColumnPtr StringFunctions::length(FunctionContext* context, const Columns& columns) {
+    return VectorizedUnaryFunction<LengthFunction<false>>::evaluate<TYPE_VARCHAR, TYPE_INT>(columns[0]);
 }
 
 ColumnPtr StringFunctions::utf8_length(FunctionContext* context, const starrocks::vectorized::Columns& columns) {
-    return VectorizedStrictUnaryFunction<utf8LengthImpl>::evaluate<TYPE_VARCHAR, TYPE_INT>(columns[0]);
+    return VectorizedUnaryFunction<LengthFunction<true>>::evaluate<TYPE_VARCHAR, TYPE_INT>(columns[0]);
 }
 
 template <char CA, char CZ>
@@ -1566,6 +1593,20 @@ static inline void vectorized_toggle_case(const Bytes* src, Bytes* dst) {
     char* begin = (char*)(src->data());
     char* end = (char*)(begin + size);
     char* src_ptr = begin;
+#if defined(__AVX2__)
+    static constexpr int AVX2_BYTES = sizeof(__m256i);
+    const char* avx2_end = begin + (size & ~(AVX2_BYTES - 1));
+    const auto a_minus1_256 = _mm256_set1_epi8(CA - 1);
+    const auto z_plus1_256 = _mm256_set1_epi8(CZ + 1);
+    const auto flips_256 = _mm256_set1_epi8(32);
+
+    for (; src_ptr < avx2_end; src_ptr += AVX2_BYTES, dst_ptr += AVX2_BYTES) {
+        auto bytes = _mm256_loadu_si256((const __m256i*)src_ptr);
+        // non-ascii bytes are negative as signed chars, so they are never in the range and keep verbatim.
+        auto masks = _mm256_and_si256(_mm256_cmpgt_epi8(bytes, a_minus1_256), _mm256_cmpgt_epi8(z_plus1_256, bytes));
+        _mm256_storeu_si256((__m256i*)dst_ptr, _mm256_xor_si256(bytes, _mm256_and_si256(masks, flips_256)));
+    }
+#endif
 #if defined(__SSE2__)
     static constexpr int SSE2_BYTES = sizeof(__m128i);
     const char* sse2_end = begin + (size & ~(SSE2_BYTES - 1));
@@ -1573,7 +1614,7 @@ static inline void vectorized_toggle_case(const Bytes* src, Bytes* dst) {
     const auto z_plus1 = _mm_set1_epi8(CZ + 1);
     const auto flips = _mm_set1_epi8(32);
 
-    for (; src_ptr > sse2_end; src_ptr += SSE2_BYTES, dst_ptr += SSE2_BYTES) {
+    for (; src_ptr < sse2_end; src_ptr += SSE2_BYTES, dst_ptr += SSE2_BYTES) {
         auto bytes = _mm_loadu_si128((const __m128i*)src_ptr);
         // the i-th byte of masks is set to 0xff if the corresponding byte is
         // between a..z when computing upper function (A..Z when computing lower function),
@@ -2504,6 +2545,21 @@ int StringFunctions::index_of(const char* source, int source_count, const char*
 
 Status StringFunctions::regexp_prepare(starrocks_udf::FunctionContext* context,
                                        starrocks_udf::FunctionContext::FunctionStateScope scope) {
+    if (scope == FunctionContext::THREAD_LOCAL) {
+        auto fragment_state =
+                reinterpret_cast<StringFunctionsState*>(context->get_function_state(FunctionContext::FRAGMENT_LOCAL));
+        if (fragment_state == nullptr || fragment_state->database == nullptr) {
+            return Status::OK();
+        }
+        auto* state = new RegexpThreadState();
+        context->set_function_state(scope, state);
+        if (hs_alloc_scratch(fragment_state->database, &state->scratch) != HS_SUCCESS) {
+            // go without the prefilter.
+            state->scratch = nullptr;
+        }
+        return Status::OK();
+    }
+
     if (scope != FunctionContext::FRAGMENT_LOCAL) {
         return Status::OK();
     }
@@ -2538,11 +2594,23 @@ Status StringFunctions::regexp_prepare(starrocks_udf::FunctionContext* context,
         return Status::InvalidArgument(error.str());
     }
 
+    // the pattern is in re2 syntax, which hyperscan mostly shares, leave the database null and fall back to re2
+    // if hyperscan rejects the pattern.
+    hs_compile_error_t* compile_err = nullptr;
+    if (hs_compile(pattern_str.c_str(),
+                   HS_FLAG_PREFILTER | HS_FLAG_ALLOWEMPTY | HS_FLAG_DOTALL | HS_FLAG_UTF8 | HS_FLAG_SINGLEMATCH,
+                   HS_MODE_BLOCK, nullptr, &state->database, &compile_err) != HS_SUCCESS) {
+        hs_free_compile_error(compile_err);
+        state->database = nullptr;
+    }
+
     return Status::OK();
 }
 
 Status StringFunctions::regexp_close(FunctionContext* context, FunctionContext::FunctionStateScope scope) {
-    if (scope == FunctionContext::FRAGMENT_LOCAL) {
+    if (scope == FunctionContext::THREAD_LOCAL) {
+        delete reinterpret_cast<RegexpThreadState*>(context->get_function_state(FunctionContext::THREAD_LOCAL));
+    } else if (scope == FunctionContext::FRAGMENT_LOCAL) {
         StringFunctionsState* state =
                 reinterpret_cast<StringFunctionsState*>(context->get_function_state(FunctionContext::FRAGMENT_LOCAL));
         delete state;
@@ -2600,12 +2668,38 @@ ColumnPtr StringFunctions::regexp_extract_general(FunctionContext* context, re2:
     return result.build(ColumnHelper::is_all_const(columns));
 }
 
-ColumnPtr StringFunctions::regexp_extract_const(re2::RE2* const_re, const Columns& columns) {
+bool StringFunctions::regexp_may_match(FunctionContext* context, StringFunctionsState* state, const Slice& str) {
+    if (state->database == nullptr) {
+        return true;
+    }
+    auto thread_state =
+            reinterpret_cast<RegexpThreadState*>(context->get_function_state(FunctionContext::THREAD_LOCAL));
+    if (thread_state == nullptr || thread_state->scratch == nullptr) {
+        return true;
+    }
+
+    bool matched = false;
+    auto status = hs_scan(
+            state->database, str.data, str.size, 0, thread_state->scratch,
+            [](unsigned int id, unsigned long long from, unsigned long long to, unsigned int flags, void* ctx) -> int {
+                *((bool*)ctx) = true;
+                return 1;
+            },
+            &matched);
+    // let re2 decide if hyperscan fails.
+    return matched || (status != HS_SUCCESS && status != HS_SCAN_TERMINATED);
+}
+
+ColumnPtr StringFunctions::regexp_extract_const(FunctionContext* context, StringFunctionsState* state,
+                                                const Columns& columns) {
+    re2::RE2* const_re = state->regex.get();
     auto content_viewer = ColumnViewer<TYPE_VARCHAR>(columns[0]);
     auto field_viewer = ColumnViewer<TYPE_BIGINT>(columns[2]);
 
     ColumnBuilder<TYPE_VARCHAR> result;
     auto size = columns[0]->size();
+    int max_matches = 1 + const_re->NumberOfCapturingGroups();
+    std::vector<re2::StringPiece> matches(max_matches);
     for (int row = 0; row < size; ++row) {
         if (content_viewer.is_null(row) || field_viewer.is_null(row)) {
             result.append_null();
@@ -2618,15 +2712,17 @@ ColumnPtr StringFunctions::regexp_extract_const(re2::RE2* const_re, const Column
             continue;
         }
 
-        int max_matches = 1 + const_re->NumberOfCapturingGroups();
         if (field_value >= max_matches) {
             result.append(Slice("", 0));
             continue;
         }
 
         auto str_value = content_viewer.value(row);
+        if (!regexp_may_match(context, state, str_value)) {
+            result.append(Slice("", 0));
+            continue;
+        }
         re2::StringPiece str_sp(str_value.get_data(), str_value.get_size());
-        std::vector<re2::StringPiece> matches(max_matches);
         bool success = const_re->Match(str_sp, 0, str_value.get_size(), re2::RE2::UNANCHORED, &matches[0], max_matches);
         if (!success) {
             result.append(Slice("", 0));
@@ -2644,8 +2740,7 @@ ColumnPtr StringFunctions::regexp_extract(FunctionContext* context, const Column
     auto state = reinterpret_cast<StringFunctionsState*>(context->get_function_state(FunctionContext::FRAGMENT_LOCAL));
 
     if (state->const_pattern) {
-        re2::RE2* const_re = state->regex.get();
-        return regexp_extract_const(const_re, columns);
+        return regexp_extract_const(context, state, columns);
     }
 
     re2::RE2::Options* options = state->options.get();
@@ -2685,22 +2780,31 @@ ColumnPtr StringFunctions::regexp_replace_general(FunctionContext* context, re2:
     return result.build(ColumnHelper::is_all_const(columns));
 }
 
-ColumnPtr StringFunctions::regexp_replace_const(re2::RE2* const_re, const Columns& columns) {
+ColumnPtr StringFunctions::regexp_replace_const(FunctionContext* context, StringFunctionsState* state,
+                                                const Columns& columns) {
+    re2::RE2* const_re = state->regex.get();
     auto str_viewer = ColumnViewer<TYPE_VARCHAR>(columns[0]);
     auto rpl_viewer = ColumnViewer<TYPE_VARCHAR>(columns[2]);
 
     ColumnBuilder<TYPE_VARCHAR> result;
     auto size = columns[0]->size();
+    std::string result_str;
     for (int row = 0; row < size; ++row) {
         if (str_viewer.is_null(row) || rpl_viewer.is_null(row)) {
             result.append_null();
             continue;
         }
 
+        auto str_value = str_viewer.value(row);
+        // nothing to replace, keep the string as is.
+        if (!regexp_may_match(context, state, str_value)) {
+            result.append(str_value);
+            continue;
+        }
+
         auto rpl_value = rpl_viewer.value(row);
         re2::StringPiece rpl_str = re2::StringPiece(rpl_value.get_data(), rpl_value.get_size());
-        auto str_value = str_viewer.value(row);
-        std::string result_str(str_value.get_data(), str_value.get_size());
+        result_str.assign(str_value.get_data(), str_value.get_size());
         re2::RE2::GlobalReplace(&result_str, *const_re, rpl_str);
         result.append(Slice(result_str.data(), result_str.size()));
     }
@@ -2712,8 +2816,7 @@ ColumnPtr StringFunctions::regexp_replace(FunctionContext* context, const Column
     auto state = reinterpret_cast<StringFunctionsState*>(context->get_function_state(FunctionContext::FRAGMENT_LOCAL));
 
     if (state->const_pattern) {
-        re2::RE2* const_re = state->regex.get();
-        return regexp_replace_const(const_re, columns);
+        return regexp_replace_const(context, state, columns);
     }
 
     re2::RE2::Options* options = state->options.get();
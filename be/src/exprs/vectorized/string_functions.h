@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <hs/hs.h>
 #include <runtime/decimalv3.h>
 
 #include <iomanip>
@@ -397,15 +398,41 @@ private:
         std::unique_ptr<re2::RE2> regex;
         std::unique_ptr<re2::RE2::Options> options;
         bool const_pattern{false};
+        // hyperscan database compiled from the constant pattern with HS_FLAG_PREFILTER, it matches a superset of
+        // what the pattern matches, so the rows it doesn't match are skipped without running re2.
+        // nullptr if hyperscan doesn't support the pattern.
+        hs_database_t* database = nullptr;
 
         StringFunctionsState() : regex(), options() {}
+
+        ~StringFunctionsState() {
+            if (database != nullptr) {
+                hs_free_database(database);
+            }
+        }
     };
 
-    static ColumnPtr regexp_extract_const(re2::RE2* const_re, const Columns& columns);
+    // one scratch space per thread is required to scan the database of StringFunctionsState.
+    struct RegexpThreadState {
+        hs_scratch_t* scratch = nullptr;
+
+        ~RegexpThreadState() {
+            if (scratch != nullptr) {
+                hs_free_scratch(scratch);
+            }
+        }
+    };
+
+    // return false only if the hyperscan prefilter of |state| proves |str| doesn't match the constant pattern.
+    static bool regexp_may_match(FunctionContext* context, StringFunctionsState* state, const Slice& str);
+
+    static ColumnPtr regexp_extract_const(FunctionContext* context, StringFunctionsState* state,
+                                          const Columns& columns);
     static ColumnPtr regexp_extract_general(FunctionContext* context, re2::RE2::Options* options,
                                             const Columns& columns);
 
-    static ColumnPtr regexp_replace_const(re2::RE2* const_re, const Columns& columns);
+    static ColumnPtr regexp_replace_const(FunctionContext* context, StringFunctionsState* state,
+                                          const Columns& columns);
     static ColumnPtr regexp_replace_general(FunctionContext* context, re2::RE2::Options* options,
                                             const Columns& columns);
 
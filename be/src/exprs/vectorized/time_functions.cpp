@@ -2,10 +2,13 @@
 
 #include "exprs/vectorized/time_functions.h"
 
+#include <optional>
+
 #include "exprs/vectorized/binary_function.h"
 #include "exprs/vectorized/unary_function.h"
 #include "runtime/runtime_state.h"
 #include "udf/udf_internal.h"
+#include "util/timezone_utils.h"
 
 namespace starrocks::vectorized {
 // index as day of week(1: Sunday, 2: Monday....), value as distance of this day and first day(Monday) of this week.
@@ -154,6 +157,24 @@ ColumnPtr TimeFunctions::convert_tz_general(FunctionContext* context, const Colu
     auto from_str = ColumnViewer<TYPE_VARCHAR>(columns[1]);
     auto to_str = ColumnViewer<TYPE_VARCHAR>(columns[2]);
 
+    // the time zones of adjacent rows are usually the same, keep the last ones found.
+    std::string last_from;
+    std::string last_to;
+    std::optional<TimezoneOffsetCache> from_cache;
+    std::optional<TimezoneOffsetCache> to_cache;
+    auto find_time_zone = [](const Slice& name, std::string* last_name, std::optional<TimezoneOffsetCache>* cache) {
+        if (!cache->has_value() || Slice(*last_name) != name) {
+            last_name->assign(name.data, name.size);
+            cctz::time_zone ctz;
+            if (TimezoneUtils::find_cctz_time_zone(*last_name, ctz)) {
+                cache->emplace(ctz);
+            } else {
+                cache->reset();
+            }
+        }
+        return cache->has_value();
+    };
+
     ColumnBuilder<TYPE_DATETIME> result;
     auto size = columns[0]->size();
     for (int row = 0; row < size; ++row) {
@@ -162,30 +183,15 @@ ColumnPtr TimeFunctions::convert_tz_general(FunctionContext* context, const Colu
             continue;
         }
 
-        auto datetime_value = time_viewer.value(row);
-        auto from_format = from_str.value(row);
-        auto to_format = to_str.value(row);
-
-        int year, month, day, hour, minute, second, usec;
-        datetime_value.to_timestamp(&year, &month, &day, &hour, &minute, &second, &usec);
-        DateTimeValue ts_value(TIME_DATETIME, year, month, day, hour, minute, second, usec);
-
-        int64_t timestamp;
-        // TODO find a better approach to replace datetime_value.unix_timestamp
-        if (!ts_value.unix_timestamp(&timestamp, std::string(from_format.data, from_format.size))) {
-            result.append_null();
-            continue;
-        }
-        DateTimeValue ts_value2;
-        // TODO find a better approach to replace datetime_value.from_unixtime
-        if (!ts_value2.from_unixtime(timestamp, std::string(to_format.data, to_format.size))) {
+        if (!find_time_zone(from_str.value(row), &last_from, &from_cache) ||
+            !find_time_zone(to_str.value(row), &last_to, &to_cache)) {
             result.append_null();
             continue;
         }
 
+        int64_t timestamp = from_cache->local_to_utc(time_viewer.value(row).to_unix_second());
         TimestampValue ts;
-        ts.from_timestamp(ts_value2.year(), ts_value2.month(), ts_value2.day(), ts_value2.hour(), ts_value2.minute(),
-                          ts_value2.second(), 0);
+        ts.from_unix_second(to_cache->utc_to_local(timestamp));
         result.append(ts);
     }
 
@@ -195,6 +201,8 @@ ColumnPtr TimeFunctions::convert_tz_general(FunctionContext* context, const Colu
 ColumnPtr TimeFunctions::convert_tz_const(FunctionContext* context, const Columns& columns, const cctz::time_zone& from,
                                           const cctz::time_zone& to) {
     auto time_viewer = ColumnViewer<TYPE_DATETIME>(columns[0]);
+    TimezoneOffsetCache from_cache(from);
+    TimezoneOffsetCache to_cache(to);
 
     ColumnBuilder<TYPE_DATETIME> result;
     auto size = columns[0]->size();
@@ -204,28 +212,10 @@ ColumnPtr TimeFunctions::convert_tz_const(FunctionContext* context, const Column
             continue;
         }
 
-        auto datetime_value = time_viewer.value(row);
-
-        int year, month, day, hour, minute, second, usec;
-        datetime_value.to_timestamp(&year, &month, &day, &hour, &minute, &second, &usec);
-        DateTimeValue ts_value(TIME_DATETIME, year, month, day, hour, minute, second, usec);
-
-        int64_t timestamp;
-        // TODO find a better approach to replace datetime_value.unix_timestamp
-        if (!ts_value.unix_timestamp(&timestamp, from)) {
-            result.append_null();
-            continue;
-        }
-        DateTimeValue ts_value2;
-        // TODO find a better approach to replace datetime_value.from_unixtime
-        if (!ts_value2.from_unixtime(timestamp, to)) {
-            result.append_null();
-            continue;
-        }
-
+        // the microseconds are dropped.
+        int64_t timestamp = from_cache.local_to_utc(time_viewer.value(row).to_unix_second());
         TimestampValue ts;
-        ts.from_timestamp(ts_value2.year(), ts_value2.month(), ts_value2.day(), ts_value2.hour(), ts_value2.minute(),
-                          ts_value2.second(), 0);
+        ts.from_unix_second(to_cache.utc_to_local(timestamp));
         result.append(ts);
     }
 
@@ -763,6 +753,13 @@ Status TimeFunctions::from_unix_prepare(starrocks_udf::FunctionContext* context,
     }
 
     state->format_content = convert_format(format);
+    if (state->format_content == "%Y%m%d") {
+        state->format_type = yyyyMMdd;
+    } else if (state->format_content == "%Y-%m-%d") {
+        state->format_type = yyyy_MM_dd;
+    } else if (state->format_content == "%Y-%m-%d %H:%i:%s") {
+        state->format_type = yyyy_MM_dd_HH_mm_ss;
+    }
     return Status::OK();
 }
 
@@ -861,6 +858,74 @@ ColumnPtr TimeFunctions::from_unix_with_format_const(std::string& format_content
     return result.build(ColumnHelper::is_all_const(columns));
 }
 
+static inline char* write_2_digits(char* to, int v) {
+    to[0] = v / 10 + '0';
+    to[1] = v % 10 + '0';
+    return to + 2;
+}
+
+// the digits of the fixed formats are written to their positions directly, instead of interpreting
+// the format by DateTimeValue::to_format_string for every row.
+template <TimeFunctions::FormatType format_type>
+static ColumnPtr from_unix_with_fixed_format(FunctionContext* context, const Columns& columns) {
+    static_assert(format_type == TimeFunctions::yyyyMMdd || format_type == TimeFunctions::yyyy_MM_dd ||
+                  format_type == TimeFunctions::yyyy_MM_dd_HH_mm_ss);
+    constexpr bool has_sep = format_type != TimeFunctions::yyyyMMdd;
+    constexpr bool has_time = format_type == TimeFunctions::yyyy_MM_dd_HH_mm_ss;
+    constexpr size_t len = has_time ? 19 : (has_sep ? 10 : 8);
+
+    RETURN_IF_COLUMNS_ONLY_NULL(columns);
+
+    ColumnBuilder<TYPE_VARCHAR> result;
+    ColumnViewer<TYPE_INT> data_column(columns[0]);
+    const auto& timezone = context->impl()->state()->timezone_obj();
+
+    auto size = columns[0]->size();
+    result.data_column()->reserve(size, size * len);
+    char buf[len];
+    for (int row = 0; row < size; ++row) {
+        if (data_column.is_null(row)) {
+            result.append_null();
+            continue;
+        }
+
+        auto date = data_column.value(row);
+        if (date < 0 || date > INT_MAX) {
+            result.append_null();
+            continue;
+        }
+
+        DateTimeValue dtv;
+        if (!dtv.from_unixtime(date, timezone)) {
+            result.append_null();
+            continue;
+        }
+
+        char* to = write_2_digits(buf, dtv.year() / 100);
+        to = write_2_digits(to, dtv.year() % 100);
+        if constexpr (has_sep) {
+            *to++ = '-';
+        }
+        to = write_2_digits(to, dtv.month());
+        if constexpr (has_sep) {
+            *to++ = '-';
+        }
+        to = write_2_digits(to, dtv.day());
+        if constexpr (has_time) {
+            *to++ = ' ';
+            to = write_2_digits(to, dtv.hour());
+            *to++ = ':';
+            to = write_2_digits(to, dtv.minute());
+            *to++ = ':';
+            to = write_2_digits(to, dtv.second());
+        }
+        DCHECK_EQ(len, to - buf);
+        result.append(Slice(buf, len));
+    }
+
+    return result.build(ColumnHelper::is_all_const(columns));
+}
+
 ColumnPtr TimeFunctions::from_unix_to_datetime_with_format(FunctionContext* context,
                                                            const starrocks::vectorized::Columns& columns) {
     DCHECK_EQ(columns.size(), 2);
@@ -868,6 +933,16 @@ ColumnPtr TimeFunctions::from_unix_to_datetime_with_format(FunctionContext* cont
             reinterpret_cast<FromUnixState*>(context->get_function_state(FunctionContext::FRAGMENT_LOCAL));
 
     if (state->const_format) {
+        switch (state->format_type) {
+        case yyyyMMdd:
+            return from_unix_with_fixed_format<yyyyMMdd>(context, columns);
+        case yyyy_MM_dd:
+            return from_unix_with_fixed_format<yyyy_MM_dd>(context, columns);
+        case yyyy_MM_dd_HH_mm_ss:
+            return from_unix_with_fixed_format<yyyy_MM_dd_HH_mm_ss>(context, columns);
+        default:
+            break;
+        }
         std::string format_content = state->format_content;
         return from_unix_with_format_const(format_content, context, columns);
     }
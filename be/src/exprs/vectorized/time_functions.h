@@ -494,6 +494,9 @@ private:
     struct FromUnixState {
         bool const_format{false};
         std::string format_content;
+        // yyyyMMdd, yyyy_MM_dd or yyyy_MM_dd_HH_mm_ss if the constant format is one of them, which is formatted
+        // by fixed digit positions, None otherwise.
+        FormatType format_type{None};
         FromUnixState() {}
     };
 
@@ -0,0 +1,75 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exprs/vectorized/topn_runtime_filter.h"
+
+#include "column/datum.h"
+#include "runtime/date_value.hpp"
+#include "runtime/timestamp_value.h"
+
+namespace starrocks::vectorized {
+
+bool TopNRuntimeFilter::is_supported(PrimitiveType type) {
+    switch (type) {
+    case TYPE_TINYINT:
+    case TYPE_SMALLINT:
+    case TYPE_INT:
+    case TYPE_BIGINT:
+    case TYPE_DATE:
+    case TYPE_DATETIME:
+    case TYPE_VARCHAR:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void TopNRuntimeFilter::update(const Column& column, size_t row) {
+    Datum datum = column.get(row);
+    if (datum.is_null()) {
+        return;
+    }
+    std::string value;
+    switch (_type) {
+    case TYPE_TINYINT:
+        value = std::to_string(datum.get_int8());
+        break;
+    case TYPE_SMALLINT:
+        value = std::to_string(datum.get_int16());
+        break;
+    case TYPE_INT:
+        value = std::to_string(datum.get_int32());
+        break;
+    case TYPE_BIGINT:
+        value = std::to_string(datum.get_int64());
+        break;
+    case TYPE_DATE:
+        value = datum.get_date().to_string();
+        break;
+    case TYPE_DATETIME:
+        value = datum.get_timestamp().to_string();
+        break;
+    case TYPE_VARCHAR:
+        value = datum.get_slice().to_string();
+        break;
+    default:
+        return;
+    }
+    std::lock_guard<std::mutex> l(_mutex);
+    _value = std::move(value);
+    _has_value = true;
+}
+
+bool TopNRuntimeFilter::get_condition(const std::string& column_name, TCondition* condition) const {
+    std::lock_guard<std::mutex> l(_mutex);
+    if (!_has_value) {
+        return false;
+    }
+    condition->__set_column_name(column_name);
+    // the rows sorted after the boundary can't be in the result.
+    condition->__set_condition_op(_is_asc ? "<=" : ">=");
+    condition->__set_condition_values({_value});
+    condition->__set_is_index_filter_only(true);
+    return true;
+}
+
+} // namespace starrocks::vectorized
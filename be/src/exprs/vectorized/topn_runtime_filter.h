@@ -0,0 +1,48 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <mutex>
+#include <string>
+
+#include "column/column.h"
+#include "common/global_types.h"
+#include "gen_cpp/InternalService_types.h"
+#include "runtime/primitive_type.h"
+
+namespace starrocks::vectorized {
+
+// The boundary of the first ordering column of a TopN, published by the sorter
+// once it has kept offset + limit rows, and pushed down to the olap scan below
+// the TopN as an index only predicate, so that the segments and pages whose
+// zone maps can't beat the boundary are skipped.
+//
+// The boundary only tightens as the sorter sees more rows, and the condition
+// is non-strict so that the rows equal to it are kept for the ties.
+class TopNRuntimeFilter {
+public:
+    TopNRuntimeFilter(SlotId slot_id, PrimitiveType type, bool is_asc)
+            : _slot_id(slot_id), _type(type), _is_asc(is_asc) {}
+
+    static bool is_supported(PrimitiveType type);
+
+    SlotId slot_id() const { return _slot_id; }
+
+    // Publish the value of |column| at |row| as the new boundary, NULL is ignored.
+    void update(const Column& column, size_t row);
+
+    // Build the condition on |column_name| by the current boundary.
+    // Return false if no boundary has been published yet.
+    bool get_condition(const std::string& column_name, TCondition* condition) const;
+
+private:
+    const SlotId _slot_id;
+    const PrimitiveType _type;
+    const bool _is_asc;
+
+    mutable std::mutex _mutex;
+    bool _has_value = false;
+    std::string _value;
+};
+
+} // namespace starrocks::vectorized
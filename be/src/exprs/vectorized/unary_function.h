@@ -161,6 +161,12 @@ public:
         if (v1->is_nullable()) {
             auto col = ColumnHelper::as_raw_column<NullableColumn>(v1);
 
+            if (!v1->has_null()) {
+                // no null in the input, the null column needs neither to be copied nor merged.
+                return FN::template evaluate<Type, ResultType, Args...>(col->data_column(),
+                                                                         std::forward<Args>(args)...);
+            }
+
             if (v1->size() == ColumnHelper::count_nulls(v1)) {
                 auto data = RunTimeColumnType<ResultType>::create(std::forward<Args>(args)...);
                 data->resize(v1->size());
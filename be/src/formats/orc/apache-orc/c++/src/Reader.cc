@@ -478,7 +478,7 @@ uint64_t ReaderImpl::getNumberOfStripeStatistics() const {
     if (!isMetadataLoaded) {
         readMetadata();
     }
-    return metadata == nullptr ? 0 : static_cast<uint64_t>(metadata->stripestats_size());
+    return contents->metadata == nullptr ? 0 : static_cast<uint64_t>(contents->metadata->stripestats_size());
 }
 
 std::unique_ptr<StripeInformation> ReaderImpl::getStripe(uint64_t stripeIndex) const {
@@ -629,10 +629,11 @@ std::unique_ptr<StripeStatistics> ReaderImpl::getStripeStatistics(uint64_t strip
     if (!isMetadataLoaded) {
         readMetadata();
     }
-    if (metadata == nullptr) {
+    if (contents->metadata == nullptr) {
         throw std::logic_error("No stripe statistics in file");
     }
-    size_t num_cols = static_cast<size_t>(metadata->stripestats(static_cast<int>(stripeIndex)).colstats_size());
+    size_t num_cols =
+            static_cast<size_t>(contents->metadata->stripestats(static_cast<int>(stripeIndex)).colstats_size());
     std::vector<std::vector<proto::ColumnStatistics>> indexStats(num_cols);
 
     proto::StripeInformation currentStripeInfo = footer->stripes(static_cast<int>(stripeIndex));
@@ -645,7 +646,8 @@ std::unique_ptr<StripeStatistics> ReaderImpl::getStripeStatistics(uint64_t strip
                                        : getLocalTimezone();
     StatContext statContext(hasCorrectStatistics(), &writerTZ);
     return std::unique_ptr<StripeStatistics>(
-            new StripeStatisticsImpl(metadata->stripestats(static_cast<int>(stripeIndex)), indexStats, statContext));
+            new StripeStatisticsImpl(contents->metadata->stripestats(static_cast<int>(stripeIndex)), indexStats,
+                                     statContext));
 }
 
 std::unique_ptr<Statistics> ReaderImpl::getStatistics() const {
@@ -679,8 +681,8 @@ void ReaderImpl::readMetadata() const {
                                    std::unique_ptr<SeekableInputStream>(new SeekableFileInputStream(
                                            contents->stream.get(), metadataStart, metadataSize, *contents->pool)),
                                    contents->blockSize, *contents->pool);
-        metadata.reset(new proto::Metadata());
-        if (!metadata->ParseFromZeroCopyStream(pbStream.get())) {
+        contents->metadata.reset(new proto::Metadata());
+        if (!contents->metadata->ParseFromZeroCopyStream(pbStream.get())) {
             throw ParseError("Failed to parse the metadata");
         }
     }
@@ -705,6 +707,10 @@ std::unique_ptr<RowReader> ReaderImpl::createRowReader() const {
 }
 
 std::unique_ptr<RowReader> ReaderImpl::createRowReader(const RowReaderOptions& opts) const {
+    if (opts.getSearchArgument() && footer->rowindexstride() > 0 && !isMetadataLoaded) {
+        // load the stripe statistics to skip the stripes by the search argument
+        readMetadata();
+    }
     return std::unique_ptr<RowReader>(new RowReaderImpl(contents, opts));
 }
 
@@ -899,6 +905,14 @@ void RowReaderImpl::startNextStripe() {
             }
         }
 
+        // skip the stripe by its statistics before reading its footer and row indexes
+        if (sargsApplier && contents->metadata &&
+            static_cast<uint64_t>(contents->metadata->stripestats_size()) > currentStripe &&
+            !sargsApplier->evaluateStripeStatistics(contents->metadata->stripestats(static_cast<int>(currentStripe)))) {
+            skipStripe = true;
+            goto end;
+        }
+
         currentStripeFooter = getStripeFooter(currentStripeInfo, *contents);
         rowsInCurrentStripe = currentStripeInfo.numberofrows();
 
@@ -65,6 +65,8 @@ struct FileContents {
     CompressionKind compression;
     MemoryPool* pool;
     std::ostream* errorStream;
+    // stripe statistics, loaded on demand
+    std::unique_ptr<proto::Metadata> metadata;
 };
 
 proto::StripeFooter getStripeFooter(const proto::StripeInformation& info, const FileContents& contents);
@@ -236,8 +238,7 @@ private:
                                const proto::StripeFooter& currentStripeFooter,
                                std::vector<std::vector<proto::ColumnStatistics> >* indexStats) const;
 
-    // metadata
-    mutable std::unique_ptr<proto::Metadata> metadata;
+    // whether contents->metadata is loaded
     mutable bool isMetadataLoaded;
 
 public:
@@ -22,7 +22,7 @@
 
 #include "SargsApplier.hh"
 
-#include <numeric>
+#include <algorithm>
 
 namespace orc {
 
@@ -67,7 +67,8 @@ bool SargsApplier::pickRowGroups(uint64_t rowsInStripe, const std::unordered_map
                                  const std::map<uint32_t, BloomFilterIndex>& bloomFilters) {
     // init state of each row group
     uint64_t groupsInStripe = (rowsInStripe + mRowIndexStride - 1) / mRowIndexStride;
-    mRowGroups.resize(groupsInStripe, true);
+    // the row groups selected in the last stripe must not be kept
+    mRowGroups.assign(groupsInStripe, true);
     mTotalRowsInStripe = rowsInStripe;
 
     // row indexes do not exist, simply read all rows
@@ -123,11 +124,28 @@ bool SargsApplier::pickRowGroups(uint64_t rowsInStripe, const std::unordered_map
     }
 
     // update stats
-    mStats.first = std::accumulate(mRowGroups.cbegin(), mRowGroups.cend(), mStats.first,
-                                   [](bool rg, uint64_t s) { return rg ? 1 : 0 + s; });
+    mStats.first += static_cast<uint64_t>(std::count(mRowGroups.cbegin(), mRowGroups.cend(), true));
     mStats.second += groupsInStripe;
 
     return mHasSelected;
 }
 
+bool SargsApplier::evaluateStripeStatistics(const proto::StripeStatistics& stripeStats) const {
+    if (stripeStats.colstats_size() == 0) {
+        return true;
+    }
+
+    const auto& leaves = dynamic_cast<const SearchArgumentImpl*>(mSearchArgument)->getLeaves();
+    std::vector<TruthValue> leafValues(leaves.size(), TruthValue::YES_NO_NULL);
+    for (size_t pred = 0; pred != leaves.size(); ++pred) {
+        uint64_t columnIdx = mFilterColumns[pred];
+        if (columnIdx != INVALID_COLUMN_ID && static_cast<uint64_t>(stripeStats.colstats_size()) > columnIdx) {
+            // bloom filters are stored per row group, so only the statistics are used for stripes
+            leafValues[pred] =
+                    leaves[pred].evaluate(mWriterVersion, stripeStats.colstats(static_cast<int>(columnIdx)), nullptr);
+        }
+    }
+    return isNeeded(mSearchArgument->evaluate(leafValues));
+}
+
 } // namespace orc
@@ -48,6 +48,12 @@ public:
     bool pickRowGroups(uint64_t rowsInStripe, const std::unordered_map<uint64_t, proto::RowIndex>& rowIndexes,
                        const std::map<uint32_t, BloomFilterIndex>& bloomFilters);
 
+    /**
+     * Evaluate search argument on the column statistics of a stripe.
+     * @return true if the stripe may have rows matching the search argument
+     */
+    bool evaluateStripeStatistics(const proto::StripeStatistics& stripeStats) const;
+
     /**
      * Return a vector of bool for each row group for their selection
      * in the last evaluation
@@ -29,13 +29,17 @@ DIAGNOSTIC_IGNORE("-Wclass-memaccess")
 #include <s2/s2cell.h>
 DIAGNOSTIC_POP
 
+#include <s2/s2cell_union.h>
 #include <s2/s2earth.h>
 #include <s2/s2latlng.h>
 #include <s2/s2polygon.h>
 #include <s2/s2polyline.h>
+#include <s2/s2region_coverer.h>
 #include <s2/util/coding/coder.h>
 #include <s2/util/units/length-units.h>
 
+#include <algorithm>
+#include <cmath>
 #include <cstdio>
 #include <iomanip>
 #include <memory>
@@ -234,6 +238,26 @@ bool GeoPoint::st_distance_sphere(double x_lng, double x_lat, double y_lng, doub
     return true;
 }
 
+void GeoPoint::st_distance_sphere(const double* x_lng, const double* x_lat, const double* y_lng, const double* y_lat,
+                                  size_t size, double* result, uint8_t* invalid) {
+    // The haversine formula of S2LatLng::GetDistance() without a branch, so that the loop is vectorized as much as
+    // the math functions allow.
+    constexpr double radians_per_degree = M_PI / 180;
+    const double radius = S2Earth::RadiusMeters();
+    for (size_t i = 0; i < size; ++i) {
+        const double lat1 = radians_per_degree * x_lat[i];
+        const double lng1 = radians_per_degree * x_lng[i];
+        const double lat2 = radians_per_degree * y_lat[i];
+        const double lng2 = radians_per_degree * y_lng[i];
+        invalid[i] = !(std::fabs(lat1) <= M_PI_2 && std::fabs(lng1) <= M_PI && std::fabs(lat2) <= M_PI_2 &&
+                       std::fabs(lng2) <= M_PI);
+        const double dlat = std::sin(0.5 * (lat2 - lat1));
+        const double dlng = std::sin(0.5 * (lng2 - lng1));
+        const double h = dlat * dlat + dlng * dlng * std::cos(lat1) * std::cos(lat2);
+        result[i] = 2 * std::asin(std::sqrt(std::min(1.0, h))) * radius;
+    }
+}
+
 GeoParseStatus GeoPoint::from_coord(double x, double y) {
     return to_s2point(x, y, _point.get());
 }
@@ -310,9 +334,22 @@ void GeoPolygon::encode(std::string* buf) {
 bool GeoPolygon::decode(const void* data, size_t size) {
     Decoder decoder(data, size);
     _polygon = std::make_unique<S2Polygon>();
+    _covering.reset();
+    _interior_covering.reset();
     return _polygon->Decode(&decoder);
 }
 
+void GeoPolygon::build_covering() {
+    if (_polygon == nullptr) {
+        return;
+    }
+    S2RegionCoverer::Options options;
+    options.set_max_cells(64);
+    S2RegionCoverer coverer(options);
+    _covering = std::make_unique<S2CellUnion>(coverer.GetCovering(*_polygon));
+    _interior_covering = std::make_unique<S2CellUnion>(coverer.GetInteriorCovering(*_polygon));
+}
+
 std::string GeoLine::as_wkt() const {
     std::stringstream ss;
     ss << "LINESTRING (";
@@ -354,6 +391,15 @@ bool GeoPolygon::contains(const GeoShape* rhs) const {
     switch (rhs->type()) {
     case GEO_SHAPE_POINT: {
         const GeoPoint* point = (const GeoPoint*)rhs;
+        if (_covering != nullptr) {
+            S2CellId cell_id(*point->point());
+            if (!_covering->Contains(cell_id)) {
+                return false;
+            }
+            if (_interior_covering->Contains(cell_id)) {
+                return true;
+            }
+        }
         return _polygon->Contains(*point->point());
 #if 0
         if (_polygon->Contains(point->point())) {
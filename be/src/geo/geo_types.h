@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -31,6 +32,7 @@
 class S2Polyline;
 class S2Polygon;
 class S2Cap;
+class S2CellUnion;
 
 template <typename T>
 class Vector3;
@@ -84,6 +86,9 @@ public:
     double y() const;
 
     static bool st_distance_sphere(double x, double y, double x1, double y1, double* result);
+    // The distances in meters of |size| pairs of points, |invalid| is set to 1 for the pairs of invalid coordinates.
+    static void st_distance_sphere(const double* x, const double* y, const double* x1, const double* y1, size_t size,
+                                   double* result, uint8_t* invalid);
 
 protected:
     void encode(std::string* buf) override;
@@ -126,12 +131,19 @@ public:
     bool contains(const GeoShape* rhs) const override;
     std::string as_wkt() const override;
 
+    // Cover the polygon with S2 cells, so that contains() of most points is answered by looking up the cell of the
+    // point, and only the points near the boundary are tested against the edges. Worth it for a constant polygon.
+    void build_covering();
+
 protected:
     void encode(std::string* buf) override;
     bool decode(const void* data, size_t size) override;
 
 private:
     std::unique_ptr<S2Polygon> _polygon;
+    // the cells covering the polygon, and the cells inside it.
+    std::unique_ptr<S2CellUnion> _covering;
+    std::unique_ptr<S2CellUnion> _interior_covering;
 };
 
 class GeoCircle : public GeoShape {
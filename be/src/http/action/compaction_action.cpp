@@ -31,6 +31,7 @@
 #include "http/http_request.h"
 #include "http/http_response.h"
 #include "http/http_status.h"
+#include "storage/compaction_scheduler.h"
 #include "storage/olap_define.h"
 #include "storage/storage_engine.h"
 #include "storage/tablet.h"
@@ -45,8 +46,13 @@ Status CompactionAction::_handle_show_compaction(HttpRequest* req, std::string*
     const std::string& req_tablet_id = req->param(TABLET_ID_KEY);
     const std::string& req_schema_hash = req->param(TABLET_SCHEMA_HASH_KEY);
     if (req_tablet_id == "" && req_schema_hash == "") {
-        // TODO(cmy): View the overall compaction status
-        return Status::NotSupported("The overall compaction status is not supported yet");
+        // the overall compaction status is the state of the compaction scheduler
+        CompactionScheduler* scheduler = StorageEngine::instance()->compaction_scheduler();
+        if (scheduler == nullptr) {
+            return Status::NotSupported("The compaction scheduler is not started");
+        }
+        scheduler->get_status(json_result);
+        return Status::OK();
     }
 
     uint64_t tablet_id = 0;
@@ -0,0 +1,45 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "http/action/load_profile_action.h"
+
+#include <sstream>
+#include <string>
+
+#include "http/http_channel.h"
+#include "http/http_headers.h"
+#include "http/http_request.h"
+#include "http/http_status.h"
+#include "runtime/stream_load/load_profile_mgr.h"
+
+namespace starrocks {
+
+const static std::string HEADER_JSON = "application/json";
+const static std::string HEADER_TEXT = "text/plain";
+const static std::string LABEL = "label";
+
+void LoadProfileAction::handle(HttpRequest* req) {
+    auto* mgr = LoadProfileMgr::instance();
+    const std::string& label = req->param(LABEL);
+    if (label.empty()) {
+        std::stringstream ss;
+        ss << R"({"labels":[)";
+        bool first = true;
+        for (const auto& l : mgr->labels()) {
+            ss << (first ? "" : ",") << '"' << l << '"';
+            first = false;
+        }
+        ss << "]}";
+        req->add_output_header(HttpHeaders::CONTENT_TYPE, HEADER_JSON.c_str());
+        HttpChannel::send_reply(req, HttpStatus::OK, ss.str());
+        return;
+    }
+    std::string profile;
+    if (!mgr->get(label, &profile)) {
+        HttpChannel::send_reply(req, HttpStatus::NOT_FOUND, "no profile of load " + label);
+        return;
+    }
+    req->add_output_header(HttpHeaders::CONTENT_TYPE, HEADER_TEXT.c_str());
+    HttpChannel::send_reply(req, HttpStatus::OK, profile);
+}
+
+} // namespace starrocks
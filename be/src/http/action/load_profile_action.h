@@ -0,0 +1,20 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "http/http_handler.h"
+
+namespace starrocks {
+
+// Dump the profile of a stream load or routine load task kept by LoadProfileMgr.
+// GET /api/load_profile lists the labels of the loads whose profiles are kept, and
+// GET /api/load_profile?label=<label> returns the profile of the load.
+class LoadProfileAction : public HttpHandler {
+public:
+    LoadProfileAction() = default;
+    ~LoadProfileAction() override = default;
+
+    void handle(HttpRequest* req) override;
+};
+
+} // namespace starrocks
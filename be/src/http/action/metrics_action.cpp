@@ -28,6 +28,7 @@
 
 #include <string>
 
+#include "gutil/casts.h"
 #include "http/http_channel.h"
 #include "http/http_headers.h"
 #include "http/http_request.h"
@@ -45,6 +46,9 @@ public:
 
 private:
     void _visit_simple_metric(const std::string& name, const MetricLabels& labels, Metric* metric);
+    void _visit_histogram_metric(const std::string& name, const MetricLabels& labels, CoreLocalHistogram* metric);
+    // Output the labels with an optional extra one, e.g. {type="a",le="1"}.
+    void _write_labels(const MetricLabels& labels, const std::string& extra_label = "");
 
 private:
     std::stringstream _ss;
@@ -97,27 +101,74 @@ void PrometheusMetricsVisitor::visit(const std::string& prefix, const std::strin
             _visit_simple_metric(metric_name, it.first, (Metric*)it.second);
         }
         break;
+    case MetricType::HISTOGRAM:
+        for (auto& it : collector->metrics()) {
+            _visit_histogram_metric(metric_name, it.first, down_cast<CoreLocalHistogram*>(it.second));
+        }
+        break;
     default:
         break;
     }
 }
 
+void PrometheusMetricsVisitor::_write_labels(const MetricLabels& labels, const std::string& extra_label) {
+    if (labels.empty() && extra_label.empty()) {
+        return;
+    }
+    _ss << "{";
+    int i = 0;
+    for (auto& label : labels.labels) {
+        if (i++ > 0) {
+            _ss << ",";
+        }
+        _ss << label.name << "=\"" << label.value << "\"";
+    }
+    if (!extra_label.empty()) {
+        if (i > 0) {
+            _ss << ",";
+        }
+        _ss << extra_label;
+    }
+    _ss << "}";
+}
+
 void PrometheusMetricsVisitor::_visit_simple_metric(const std::string& name, const MetricLabels& labels,
                                                     Metric* metric) {
     _ss << name;
-    // labels
-    if (!labels.empty()) {
-        _ss << "{";
-        int i = 0;
-        for (auto& label : labels.labels) {
-            if (i++ > 0) {
-                _ss << ",";
-            }
-            _ss << label.name << "=\"" << label.value << "\"";
+    _write_labels(labels);
+    _ss << " " << metric->to_string() << "\n";
+}
+
+// The fine-grained buckets are exported at the powers of two only, to keep the output small.
+// eg:
+// starrocks_be_fragment_request_latency_us_bucket{le="1"} 0
+// ...
+// starrocks_be_fragment_request_latency_us_bucket{le="+Inf"} 12
+// starrocks_be_fragment_request_latency_us_sum 3456
+// starrocks_be_fragment_request_latency_us_count 12
+void PrometheusMetricsVisitor::_visit_histogram_metric(const std::string& name, const MetricLabels& labels,
+                                                       CoreLocalHistogram* metric) {
+    auto counts = metric->bucket_counts();
+    int64_t cumulative_count = 0;
+    for (int i = 0; i < CoreLocalHistogram::kNumBuckets; ++i) {
+        cumulative_count += counts[i];
+        int64_t upper_bound = CoreLocalHistogram::bucket_upper_bound(i);
+        if ((upper_bound & (upper_bound - 1)) != 0) {
+            continue;
         }
-        _ss << "}";
+        _ss << name << "_bucket";
+        _write_labels(labels, "le=\"" + std::to_string(upper_bound) + "\"");
+        _ss << " " << cumulative_count << "\n";
     }
-    _ss << " " << metric->to_string() << "\n";
+    _ss << name << "_bucket";
+    _write_labels(labels, "le=\"+Inf\"");
+    _ss << " " << cumulative_count << "\n";
+    _ss << name << "_sum";
+    _write_labels(labels);
+    _ss << " " << metric->sum() << "\n";
+    _ss << name << "_count";
+    _write_labels(labels);
+    _ss << " " << cumulative_count << "\n";
 }
 
 void SimpleCoreMetricsVisitor::visit(const std::string& prefix, const std::string& name, MetricCollector* collector) {
@@ -168,6 +219,7 @@ void JsonMetricsVisitor::visit(const std::string& prefix, const std::string& nam
     switch (collector->type()) {
     case MetricType::COUNTER:
     case MetricType::GAUGE:
+    case MetricType::HISTOGRAM:
         for (auto& it : collector->metrics()) {
             const MetricLabels& labels = it.first;
             Metric* metric = reinterpret_cast<Metric*>(it.second);
@@ -0,0 +1,45 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "http/action/pipeline_driver_trace_action.h"
+
+#include <sstream>
+#include <string>
+
+#include "exec/pipeline/driver_tracer.h"
+#include "http/http_channel.h"
+#include "http/http_headers.h"
+#include "http/http_request.h"
+#include "http/http_status.h"
+
+namespace starrocks {
+
+const static std::string HEADER_JSON = "application/json";
+const static std::string QUERY_ID = "query_id";
+
+void PipelineDriverTraceAction::handle(HttpRequest* req) {
+    auto* tracer = pipeline::DriverTracer::instance();
+    const std::string& query_id = req->param(QUERY_ID);
+    std::string result;
+    if (query_id.empty()) {
+        std::stringstream ss;
+        ss << R"({"query_ids":[)";
+        bool first = true;
+        for (const auto& id : tracer->query_ids()) {
+            ss << (first ? "" : ",") << '"' << id << '"';
+            first = false;
+        }
+        ss << "]}";
+        result = ss.str();
+    } else {
+        auto trace = tracer->get(query_id);
+        if (trace == nullptr) {
+            HttpChannel::send_reply(req, HttpStatus::NOT_FOUND, "no driver trace of query " + query_id);
+            return;
+        }
+        result = trace->to_chrome_trace();
+    }
+    req->add_output_header(HttpHeaders::CONTENT_TYPE, HEADER_JSON.c_str());
+    HttpChannel::send_reply(req, HttpStatus::OK, result);
+}
+
+} // namespace starrocks
@@ -0,0 +1,20 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "http/http_handler.h"
+
+namespace starrocks {
+
+// Dump the scheduling trace of the pipeline drivers of a query in Chrome trace event format.
+// GET /api/pipeline/driver_trace lists the ids of the traced queries, and
+// GET /api/pipeline/driver_trace?query_id=<id> returns the trace of the query.
+class PipelineDriverTraceAction : public HttpHandler {
+public:
+    PipelineDriverTraceAction() = default;
+    ~PipelineDriverTraceAction() override = default;
+
+    void handle(HttpRequest* req) override;
+};
+
+} // namespace starrocks
@@ -40,6 +40,7 @@
 #include "runtime/exec_env.h"
 #include "util/bfd_parser.h"
 #include "util/file_utils.h"
+#include "util/query_cpu_profiler.h"
 
 namespace starrocks {
 
@@ -136,9 +137,15 @@ void ProfileAction::handle(HttpRequest* req) {
     std::ostringstream tmp_prof_file_name;
     // Build a temporary file name that is hopefully unique.
     tmp_prof_file_name << config::pprof_profile_dir << "/starrocks_profile." << getpid() << "." << rand();
+    // Both use SIGPROF, so the query cpu profiler is paused while gperftools is profiling.
+    bool query_profiler_running = QueryCpuProfiler::instance()->stop();
     ProfilerStart(tmp_prof_file_name.str().c_str());
     sleep(seconds);
     ProfilerStop();
+    if (query_profiler_running) {
+        auto st = QueryCpuProfiler::instance()->start(config::query_cpu_profiler_frequency);
+        LOG_IF(WARNING, !st.ok()) << "Failed to restart query cpu profiler: " << st.to_string();
+    }
     std::ifstream prof_file(tmp_prof_file_name.str().c_str(), std::ios::in);
     std::stringstream ss;
     if (!prof_file.is_open()) {
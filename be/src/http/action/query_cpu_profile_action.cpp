@@ -0,0 +1,80 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "http/action/query_cpu_profile_action.h"
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
+#include "http/http_channel.h"
+#include "http/http_headers.h"
+#include "http/http_request.h"
+#include "http/http_status.h"
+#include "util/query_cpu_profiler.h"
+#include "util/stack_util.h"
+#include "util/uid_util.h"
+
+namespace starrocks {
+
+const static std::string HEADER_JSON = "application/json";
+const static std::string QUERY_ID = "query_id";
+
+void QueryCpuProfileAction::handle(HttpRequest* req) {
+    auto* profiler = QueryCpuProfiler::instance();
+    const std::string& query_id = req->param(QUERY_ID);
+    auto queries = profiler->queries();
+    if (query_id.empty()) {
+        std::stringstream ss;
+        ss << R"({"running":)" << (profiler->is_running() ? "true" : "false") << R"(,"dropped_samples":)"
+           << profiler->num_dropped_samples() << R"(,"queries":[)";
+        bool first = true;
+        for (const auto& [id, num_samples] : queries) {
+            ss << (first ? "" : ",") << R"({"query_id":")" << print_id(id) << R"(","samples":)" << num_samples << "}";
+            first = false;
+        }
+        ss << "]}";
+        req->add_output_header(HttpHeaders::CONTENT_TYPE, HEADER_JSON.c_str());
+        HttpChannel::send_reply(req, HttpStatus::OK, ss.str());
+        return;
+    }
+
+    QueryCpuProfiler::Stacks stacks;
+    bool found = false;
+    for (const auto& [id, num_samples] : queries) {
+        if (print_id(id) == query_id) {
+            found = profiler->get_stacks(id, &stacks);
+            break;
+        }
+    }
+    if (!found) {
+        HttpChannel::send_reply(req, HttpStatus::NOT_FOUND, "no cpu samples of query " + query_id);
+        return;
+    }
+
+    // The same functions are in many stacks, so resolve every address only once.
+    std::unordered_map<void*, std::string> symbols;
+    auto symbolize_once = [&symbols](void* pc) -> const std::string& {
+        auto it = symbols.find(pc);
+        if (it == symbols.end()) {
+            std::string name = symbolize(pc);
+            // ';' separates the frames in the folded format.
+            std::replace(name.begin(), name.end(), ';', ':');
+            it = symbols.emplace(pc, std::move(name)).first;
+        }
+        return it->second;
+    };
+    std::stringstream ss;
+    for (const auto& [stack, num_samples] : stacks) {
+        if (stack.empty()) {
+            continue;
+        }
+        for (auto it = stack.rbegin(); it != stack.rend(); ++it) {
+            ss << (it == stack.rbegin() ? "" : ";") << symbolize_once(*it);
+        }
+        ss << ' ' << num_samples << '\n';
+    }
+    HttpChannel::send_reply(req, HttpStatus::OK, ss.str());
+}
+
+} // namespace starrocks
@@ -0,0 +1,22 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include "http/http_handler.h"
+
+namespace starrocks {
+
+// Dump the CPU samples of the queries collected by QueryCpuProfiler.
+// GET /api/query_cpu_profile lists the sampled queries with their number of samples, the most recently
+// sampled first, and GET /api/query_cpu_profile?query_id=<id> returns the stacks of the query in the
+// folded format of flamegraph.pl, i.e. one line of the frames from the root separated by ';' and the
+// number of samples of every stack.
+class QueryCpuProfileAction : public HttpHandler {
+public:
+    QueryCpuProfileAction() = default;
+    ~QueryCpuProfileAction() override = default;
+
+    void handle(HttpRequest* req) override;
+};
+
+} // namespace starrocks
@@ -21,8 +21,10 @@
 
 #include "http/action/stream_load.h"
 
+#include <algorithm>
 #include <deque>
 #include <future>
+#include <limits>
 #include <sstream>
 
 // use string iequal
@@ -48,6 +50,8 @@
 #include "runtime/fragment_mgr.h"
 #include "runtime/load_path_mgr.h"
 #include "runtime/plan_fragment_executor.h"
+#include "runtime/stream_load/group_commit_mgr.h"
+#include "runtime/stream_load/load_profile_mgr.h"
 #include "runtime/stream_load/load_stream_mgr.h"
 #include "runtime/stream_load/stream_load_context.h"
 #include "runtime/stream_load/stream_load_executor.h"
@@ -66,12 +70,16 @@ namespace starrocks {
 METRIC_DEFINE_INT_COUNTER(streaming_load_requests_total, MetricUnit::REQUESTS);
 METRIC_DEFINE_INT_COUNTER(streaming_load_bytes, MetricUnit::BYTES);
 METRIC_DEFINE_INT_COUNTER(streaming_load_duration_ms, MetricUnit::MILLISECONDS);
+METRIC_DEFINE_INT_HISTOGRAM(streaming_load_latency_ms, MetricUnit::MILLISECONDS);
 METRIC_DEFINE_INT_GAUGE(streaming_load_current_processing, MetricUnit::REQUESTS);
 
 #ifdef BE_TEST
 TStreamLoadPutResult k_stream_load_put_result;
 #endif
 
+// the max size of a buffer the received data is moved into, a few of which fit in the pipe of a stream load.
+static constexpr size_t kMaxChunkBytes = 256 * 1024;
+
 static TFileFormatType::type parse_format(const std::string& format_str) {
     if (boost::iequals(format_str, "csv")) {
         return TFileFormatType::FORMAT_CSV_PLAIN;
@@ -111,6 +119,7 @@ StreamLoadAction::StreamLoadAction(ExecEnv* exec_env) : _exec_env(exec_env) {
                                                              &streaming_load_requests_total);
     StarRocksMetrics::instance()->metrics()->register_metric("streaming_load_bytes", &streaming_load_bytes);
     StarRocksMetrics::instance()->metrics()->register_metric("streaming_load_duration_ms", &streaming_load_duration_ms);
+    StarRocksMetrics::instance()->metrics()->register_metric("streaming_load_latency_ms", &streaming_load_latency_ms);
     StarRocksMetrics::instance()->metrics()->register_metric("streaming_load_current_processing",
                                                              &streaming_load_current_processing);
 }
@@ -125,7 +134,7 @@ void StreamLoadAction::handle(HttpRequest* req) {
 
     // status already set to fail
     if (ctx->status.ok()) {
-        ctx->status = _handle(ctx);
+        ctx->status = _handle(req, ctx);
         if (!ctx->status.ok() && ctx->status.code() != TStatusCode::PUBLISH_TIMEOUT) {
             LOG(WARNING) << "Fail to handle streaming load, id=" << ctx->id
                          << " errmsg=" << ctx->status.get_error_msg();
@@ -145,20 +154,32 @@ void StreamLoadAction::handle(HttpRequest* req) {
 
     auto str = ctx->to_json();
     HttpChannel::send_reply(req, str);
+    LoadProfileMgr::instance()->add(ctx);
 
     // update statstics
     streaming_load_requests_total.increment(1);
     streaming_load_duration_ms.increment(ctx->load_cost_nanos / 1000000);
+    streaming_load_latency_ms.record(ctx->load_cost_nanos / 1000000);
     streaming_load_bytes.increment(ctx->receive_bytes);
     streaming_load_current_processing.increment(-1);
 }
 
-Status StreamLoadAction::_handle(StreamLoadContext* ctx) {
+Status StreamLoadAction::_handle(HttpRequest* http_req, StreamLoadContext* ctx) {
     if (ctx->body_bytes > 0 && ctx->receive_bytes != ctx->body_bytes) {
         LOG(WARNING) << "recevie body don't equal with body bytes, body_bytes=" << ctx->body_bytes
                      << ", receive_bytes=" << ctx->receive_bytes << ", id=" << ctx->id;
         return Status::InternalError("receive body dont't equal with body bytes");
     }
+    if (ctx->group_commit) {
+        RETURN_IF_ERROR(ctx->body_sink->finish());
+        TStreamLoadPutRequest request;
+        RETURN_IF_ERROR(_build_put_request(http_req, ctx, &request));
+        int64_t commit_and_publish_start_time = MonotonicNanos();
+        auto st = _exec_env->group_commit_mgr()->load(ctx, request,
+                                                      static_cast<StreamLoadPipe*>(ctx->body_sink.get()));
+        ctx->commit_and_publish_txn_cost_nanos = MonotonicNanos() - commit_and_publish_start_time;
+        return st;
+    }
     if (!ctx->use_streaming) {
         // if we use non-streaming, we need to close file first,
         // then execute_plan_fragment here
@@ -274,6 +295,23 @@ Status StreamLoadAction::_on_header(HttpRequest* http_req, StreamLoadContext* ct
         ctx->timeout_second = timeout_second;
     }
 
+    if (config::enable_group_commit && boost::iequals(http_req->header(HTTP_GROUP_COMMIT), "true") &&
+        ctx->format == TFileFormatType::FORMAT_CSV_PLAIN && http_req->header(HTTP_ROW_DELIMITER).empty() &&
+        ctx->body_bytes > 0 && ctx->body_bytes <= static_cast<size_t>(config::group_commit_max_bytes)) {
+        // The loads of a group are committed with the label of the group, the label of a load would not be
+        // deduplicated by the FE.
+        if (!http_req->header(HTTP_LABEL_KEY).empty()) {
+            return Status::InvalidArgument("label is not supported by group commit");
+        }
+        // The body is received entirely before it's appended to the pipe of its group as whole records, the
+        // transaction is begun by the group.
+        ctx->group_commit = true;
+        ctx->use_streaming = true;
+        ctx->body_sink = std::make_shared<StreamLoadPipe>(std::numeric_limits<size_t>::max() /* max_buffered_bytes */,
+                                                          64 * 1024 /* min_chunk_size */, ctx->body_bytes);
+        return Status::OK();
+    }
+
     // begin transaction
     int64_t begin_txn_start_time = MonotonicNanos();
     RETURN_IF_ERROR(_exec_env->stream_load_executor()->begin_txn(ctx));
@@ -294,7 +332,9 @@ void StreamLoadAction::on_chunk_data(HttpRequest* req) {
 
     int64_t start_read_data_time = MonotonicNanos();
     while (evbuffer_get_length(evbuf) > 0) {
-        auto bb = ByteBuffer::allocate(4096);
+        // all the data received is moved in one buffer, which is parsed in place by the scanner, instead of
+        // many small buffers each taking a lock of the pipe and a wakeup of the scanner.
+        auto bb = ByteBuffer::allocate(std::min(evbuffer_get_length(evbuf), kMaxChunkBytes));
         auto remove_bytes = evbuffer_remove(evbuf, bb->ptr, bb->capacity);
         bb->pos = remove_bytes;
         bb->flip();
@@ -329,11 +369,8 @@ Status StreamLoadAction::_process_put(HttpRequest* http_req, StreamLoadContext*
 
     // put request
     TStreamLoadPutRequest request;
-    set_request_auth(&request, ctx->auth);
-    request.db = ctx->db;
-    request.tbl = ctx->table;
+    RETURN_IF_ERROR(_build_put_request(http_req, ctx, &request));
     request.txnId = ctx->txn_id;
-    request.formatType = ctx->format;
     request.__set_loadId(ctx->id.to_thrift());
     if (ctx->use_streaming) {
         auto pipe =
@@ -350,48 +387,81 @@ Status StreamLoadAction::_process_put(HttpRequest* http_req, StreamLoadContext*
         request.fileType = TFileType::FILE_LOCAL;
         ctx->body_sink = file_sink;
     }
+    request.__set_thrift_rpc_timeout_ms(config::thrift_rpc_timeout_ms);
+    // plan this load
+    TNetworkAddress master_addr = _exec_env->master_info()->network_address;
+#ifndef BE_TEST
+    int64_t stream_load_put_start_time = MonotonicNanos();
+    RETURN_IF_ERROR(ThriftRpcHelper::rpc<FrontendServiceClient>(
+            master_addr.hostname, master_addr.port,
+            [&request, ctx](FrontendServiceConnection& client) { client->streamLoadPut(ctx->put_result, request); }));
+    ctx->stream_load_put_cost_nanos = MonotonicNanos() - stream_load_put_start_time;
+#else
+    ctx->put_result = k_stream_load_put_result;
+#endif
+    Status plan_status(ctx->put_result.status);
+    if (!plan_status.ok()) {
+        LOG(WARNING) << "plan streaming load failed. errmsg=" << plan_status.get_error_msg() << ctx->brief();
+        return plan_status;
+    }
+    VLOG(3) << "params is " << apache::thrift::ThriftDebugString(ctx->put_result.params);
+    // if we not use streaming, we must download total content before we begin
+    // to process this load
+    if (!ctx->use_streaming) {
+        return Status::OK();
+    }
+
+    return _exec_env->stream_load_executor()->execute_plan_fragment(ctx);
+}
+
+Status StreamLoadAction::_build_put_request(HttpRequest* http_req, StreamLoadContext* ctx,
+                                            TStreamLoadPutRequest* request) {
+    set_request_auth(request, ctx->auth);
+    request->db = ctx->db;
+    request->tbl = ctx->table;
+    request->formatType = ctx->format;
     if (!http_req->header(HTTP_COLUMNS).empty()) {
-        request.__set_columns(http_req->header(HTTP_COLUMNS));
+        request->__set_columns(http_req->header(HTTP_COLUMNS));
     }
     if (!http_req->header(HTTP_WHERE).empty()) {
-        request.__set_where(http_req->header(HTTP_WHERE));
+        request->__set_where(http_req->header(HTTP_WHERE));
     }
     if (!http_req->header(HTTP_COLUMN_SEPARATOR).empty()) {
-        request.__set_columnSeparator(http_req->header(HTTP_COLUMN_SEPARATOR));
+        request->__set_columnSeparator(http_req->header(HTTP_COLUMN_SEPARATOR));
     }
     if (!http_req->header(HTTP_ROW_DELIMITER).empty()) {
-        request.__set_rowDelimiter(http_req->header(HTTP_ROW_DELIMITER));
+        request->__set_rowDelimiter(http_req->header(HTTP_ROW_DELIMITER));
     }
     if (!http_req->header(HTTP_PARTITIONS).empty()) {
-        request.__set_partitions(http_req->header(HTTP_PARTITIONS));
-        request.__set_isTempPartition(false);
+        request->__set_partitions(http_req->header(HTTP_PARTITIONS));
+        request->__set_isTempPartition(false);
         if (!http_req->header(HTTP_TEMP_PARTITIONS).empty()) {
             return Status::InvalidArgument("Can not specify both partitions and temporary partitions");
         }
     }
     if (!http_req->header(HTTP_TEMP_PARTITIONS).empty()) {
-        request.__set_partitions(http_req->header(HTTP_TEMP_PARTITIONS));
-        request.__set_isTempPartition(true);
+        request->__set_partitions(http_req->header(HTTP_TEMP_PARTITIONS));
+        request->__set_isTempPartition(true);
         if (!http_req->header(HTTP_PARTITIONS).empty()) {
             return Status::InvalidArgument("Can not specify both partitions and temporary partitions");
         }
     }
     if (!http_req->header(HTTP_NEGATIVE).empty() && http_req->header(HTTP_NEGATIVE) == "true") {
-        request.__set_negative(true);
+        request->__set_negative(true);
     } else {
-        request.__set_negative(false);
+        request->__set_negative(false);
     }
     if (!http_req->header(HTTP_STRICT_MODE).empty()) {
         if (boost::iequals(http_req->header(HTTP_STRICT_MODE), "false")) {
-            request.__set_strictMode(false);
+            request->__set_strictMode(false);
         } else if (boost::iequals(http_req->header(HTTP_STRICT_MODE), "true")) {
-            request.__set_strictMode(true);
+            request->__set_strictMode(true);
         } else {
             return Status::InvalidArgument("Invalid strict mode format. Must be bool type");
         }
     }
     if (!http_req->header(HTTP_TIMEZONE).empty()) {
-        request.__set_timezone(http_req->header(HTTP_TIMEZONE));
+        request->__set_timezone(http_req->header(HTTP_TIMEZONE));
     }
     if (!http_req->header(HTTP_LOAD_MEM_LIMIT).empty()) {
         try {
@@ -400,58 +470,35 @@ Status StreamLoadAction::_process_put(HttpRequest* http_req, StreamLoadContext*
             if (load_mem_limit < 0) {
                 return Status::InvalidArgument("load_mem_limit must be equal or greater than 0");
             }
-            request.__set_loadMemLimit(load_mem_limit);
+            request->__set_loadMemLimit(load_mem_limit);
         } catch (const std::invalid_argument& e) {
             return Status::InvalidArgument("Invalid load mem limit format");
         }
     }
     if (!http_req->header(HTTP_JSONPATHS).empty()) {
-        request.__set_jsonpaths(http_req->header(HTTP_JSONPATHS));
+        request->__set_jsonpaths(http_req->header(HTTP_JSONPATHS));
     }
     if (!http_req->header(HTTP_JSONROOT).empty()) {
-        request.__set_json_root(http_req->header(HTTP_JSONROOT));
+        request->__set_json_root(http_req->header(HTTP_JSONROOT));
     }
     if (!http_req->header(HTTP_STRIP_OUTER_ARRAY).empty()) {
         if (boost::iequals(http_req->header(HTTP_STRIP_OUTER_ARRAY), "true")) {
-            request.__set_strip_outer_array(true);
+            request->__set_strip_outer_array(true);
         } else {
-            request.__set_strip_outer_array(false);
+            request->__set_strip_outer_array(false);
         }
     } else {
-        request.__set_strip_outer_array(false);
+        request->__set_strip_outer_array(false);
     }
     if (ctx->timeout_second != -1) {
-        request.__set_timeout(ctx->timeout_second);
+        request->__set_timeout(ctx->timeout_second);
     }
-    request.__set_thrift_rpc_timeout_ms(config::thrift_rpc_timeout_ms);
-    // plan this load
-    TNetworkAddress master_addr = _exec_env->master_info()->network_address;
 #ifndef BE_TEST
     if (!http_req->header(HTTP_MAX_FILTER_RATIO).empty()) {
         ctx->max_filter_ratio = strtod(http_req->header(HTTP_MAX_FILTER_RATIO).c_str(), nullptr);
     }
-
-    int64_t stream_load_put_start_time = MonotonicNanos();
-    RETURN_IF_ERROR(ThriftRpcHelper::rpc<FrontendServiceClient>(
-            master_addr.hostname, master_addr.port,
-            [&request, ctx](FrontendServiceConnection& client) { client->streamLoadPut(ctx->put_result, request); }));
-    ctx->stream_load_put_cost_nanos = MonotonicNanos() - stream_load_put_start_time;
-#else
-    ctx->put_result = k_stream_load_put_result;
 #endif
-    Status plan_status(ctx->put_result.status);
-    if (!plan_status.ok()) {
-        LOG(WARNING) << "plan streaming load failed. errmsg=" << plan_status.get_error_msg() << ctx->brief();
-        return plan_status;
-    }
-    VLOG(3) << "params is " << apache::thrift::ThriftDebugString(ctx->put_result.params);
-    // if we not use streaming, we must download total content before we begin
-    // to process this load
-    if (!ctx->use_streaming) {
-        return Status::OK();
-    }
-
-    return _exec_env->stream_load_executor()->execute_plan_fragment(ctx);
+    return Status::OK();
 }
 
 Status StreamLoadAction::_data_saved_path(HttpRequest* req, std::string* file_path) {
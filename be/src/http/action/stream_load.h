@@ -33,6 +33,7 @@ namespace starrocks {
 class ExecEnv;
 class Status;
 class StreamLoadContext;
+class TStreamLoadPutRequest;
 
 class StreamLoadAction : public HttpHandler {
 public:
@@ -50,10 +51,12 @@ public:
 
 private:
     Status _on_header(HttpRequest* http_req, StreamLoadContext* ctx);
-    Status _handle(StreamLoadContext* ctx);
+    Status _handle(HttpRequest* http_req, StreamLoadContext* ctx);
     Status _data_saved_path(HttpRequest* req, std::string* file_path);
     Status _execute_plan_fragment(StreamLoadContext* ctx);
     Status _process_put(HttpRequest* http_req, StreamLoadContext* ctx);
+    // Set the load properties of the put request from the headers.
+    Status _build_put_request(HttpRequest* http_req, StreamLoadContext* ctx, TStreamLoadPutRequest* request);
 
 private:
     ExecEnv* _exec_env;
@@ -38,6 +38,8 @@
 #include "http/http_request.h"
 #include "http/http_response.h"
 #include "http/http_status.h"
+#include "storage/data_dir.h"
+#include "storage/storage_engine.h"
 #include "util/priority_thread_pool.hpp"
 
 namespace starrocks {
@@ -52,6 +54,13 @@ void UpdateConfigAction::handle(HttpRequest* req) {
             LOG(INFO) << "set doris_scanner_thread_pool_thread_num:" << config::doris_scanner_thread_pool_thread_num;
             _exec_env->thread_pool()->set_num_thread(config::doris_scanner_thread_pool_thread_num);
         });
+        _config_callback.emplace("background_io_mbytes_per_sec_per_disk", [&]() {
+            int64_t mbytes_per_sec = config::background_io_mbytes_per_sec_per_disk;
+            LOG(INFO) << "set background_io_mbytes_per_sec_per_disk:" << mbytes_per_sec;
+            for (DataDir* data_dir : StorageEngine::instance()->get_stores()) {
+                data_dir->background_io_limiter()->set_rate(mbytes_per_sec * 1024 * 1024);
+            }
+        });
     });
 
     Status s;
@@ -131,6 +131,9 @@ void mem_tracker_handler(MemTracker* mem_tracker, const WebPageHandler::Argument
         } else if (iter->second == "page_cache") {
             start_mem_tracker = ExecEnv::GetInstance()->page_cache_mem_tracker();
             cur_level = 2;
+        } else if (iter->second == "scan_result_cache") {
+            start_mem_tracker = ExecEnv::GetInstance()->scan_result_cache_mem_tracker();
+            cur_level = 2;
         } else {
             start_mem_tracker = mem_tracker;
             cur_level = 1;
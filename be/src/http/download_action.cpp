@@ -29,6 +29,7 @@
 
 #include "env/env.h"
 #include "http/http_channel.h"
+#include "http/http_common.h"
 #include "http/http_headers.h"
 #include "http/http_request.h"
 #include "http/http_response.h"
@@ -83,6 +84,17 @@ void DownloadAction::handle_normal(HttpRequest* req, const std::string& file_par
     if (FileUtils::is_dir(file_param)) {
         do_dir_response(file_param, req);
     } else {
+        // the checksum is computed only for HEAD requests, so that a download does not read the file twice.
+        if (req->method() == HttpMethod::HEAD && req->param(HTTP_CHECKSUM_KEY) == "crc32c") {
+            uint32_t checksum = 0;
+            status = FileUtils::crc32c(file_param, &checksum);
+            if (!status.ok()) {
+                LOG(WARNING) << "Failed to compute the checksum of " << file_param << ": " << status;
+                HttpChannel::send_error(req, HttpStatus::INTERNAL_SERVER_ERROR);
+                return;
+            }
+            req->add_output_header(HTTP_CRC32C_HEADER.c_str(), std::to_string(checksum).c_str());
+        }
         do_file_response(file_param, req);
     }
 }
@@ -27,11 +27,14 @@
 #include <event2/http.h>
 #include <event2/http_struct.h>
 #include <event2/keyvalq_struct.h>
+#include <sys/socket.h>
 
+#include <cstring>
 #include <memory>
 #include <sstream>
 #include <utility>
 
+#include "common/config.h"
 #include "common/logging.h"
 #include "http/http_channel.h"
 #include "http/http_handler.h"
@@ -109,7 +112,9 @@ Status EvHttpServer::start() {
                 LOG(WARNING) << "Couldn't create an evhttp.";
                 return;
             }
-            auto res = evhttp_accept_socket(http.get(), _server_fd);
+            // every worker accepts on its own socket when the port is reused.
+            const int server_fd = _server_fds.size() == 1 ? _server_fds[0] : _server_fds[i];
+            auto res = evhttp_accept_socket(http.get(), server_fd);
             if (res < 0) {
                 LOG(WARNING) << "evhttp accept socket failed";
                 return;
@@ -127,7 +132,9 @@ Status EvHttpServer::start() {
 }
 
 void EvHttpServer::stop() {
-    close(_server_fd);
+    for (int fd : _server_fds) {
+        close(fd);
+    }
 }
 
 void EvHttpServer::join() {}
@@ -140,30 +147,66 @@ Status EvHttpServer::_bind() {
         ss << "convert address failed, host=" << _host << ", port=" << _port;
         return Status::InternalError(ss.str());
     }
-    // reuse_addr arg is removed in brpc 0.9.7 and use gflag instead.
-    // default reuse_addr is true and reuse_port is false.
-    _server_fd = butil::tcp_listen(point);
-    if (_server_fd < 0) {
+    const int num_sockets = config::webserver_reuse_port ? _num_workers : 1;
+    for (int i = 0; i < num_sockets; ++i) {
+        int fd = -1;
+        RETURN_IF_ERROR(_listen(point, &fd));
+        _server_fds.push_back(fd);
+        if (_port == 0 && i == 0) {
+            struct sockaddr_in addr;
+            socklen_t socklen = sizeof(addr);
+            const int rc = getsockname(fd, (struct sockaddr*)&addr, &socklen);
+            if (rc == 0) {
+                _real_port = ntohs(addr.sin_port);
+                // the other workers listen on the port chosen by the os.
+                point.port = _real_port;
+            }
+        }
+    }
+    return Status::OK();
+}
+
+Status EvHttpServer::_listen(const butil::EndPoint& point, int* fd) {
+    if (config::webserver_reuse_port) {
+        // SO_REUSEPORT lets the kernel balance the new connections among the sockets of the workers, instead of
+        // waking up all the workers accepting on the same socket.
+        *fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (*fd >= 0) {
+            const int on = 1;
+            struct sockaddr_in addr;
+            memset(&addr, 0, sizeof(addr));
+            addr.sin_family = AF_INET;
+            addr.sin_addr = point.ip;
+            addr.sin_port = htons(point.port);
+            if (setsockopt(*fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on)) != 0 ||
+                setsockopt(*fd, SOL_SOCKET, SO_REUSEPORT, &on, sizeof(on)) != 0 ||
+                bind(*fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(*fd, SOMAXCONN) != 0) {
+                const int err = errno;
+                close(*fd);
+                *fd = -1;
+                errno = err;
+            }
+        }
+    } else {
+        // reuse_addr arg is removed in brpc 0.9.7 and use gflag instead.
+        // default reuse_addr is true and reuse_port is false.
+        *fd = butil::tcp_listen(point);
+    }
+    if (*fd < 0) {
         char buf[64];
         std::stringstream ss;
         ss << "tcp listen failed, errno=" << errno << ", errmsg=webserver_port:" << _port << ". "
            << strerror_r(errno, buf, sizeof(buf));
         return Status::InternalError(ss.str());
     }
-    if (_port == 0) {
-        struct sockaddr_in addr;
-        socklen_t socklen = sizeof(addr);
-        const int rc = getsockname(_server_fd, (struct sockaddr*)&addr, &socklen);
-        if (rc == 0) {
-            _real_port = ntohs(addr.sin_port);
-        }
-    }
-    res = butil::make_non_blocking(_server_fd);
+    auto res = butil::make_non_blocking(*fd);
     if (res < 0) {
         char buf[64];
         std::stringstream ss;
         ss << "make socket to non_blocking failed, errno=" << errno
            << ", errmsg=" << strerror_r(errno, buf, sizeof(buf));
+        close(*fd);
+        *fd = -1;
         return Status::InternalError(ss.str());
     }
     return Status::OK();
@@ -29,6 +29,10 @@
 #include "http/http_method.h"
 #include "util/path_trie.hpp"
 
+namespace butil {
+struct EndPoint;
+} // namespace butil
+
 namespace starrocks {
 
 class HttpHandler;
@@ -57,6 +61,7 @@ public:
 
 private:
     Status _bind();
+    Status _listen(const butil::EndPoint& point, int* fd);
     HttpHandler* _find_handler(HttpRequest* req);
 
 private:
@@ -67,7 +72,8 @@ private:
     // used for unittest, set port to 0, os will choose a free port;
     int _real_port;
 
-    int _server_fd = -1;
+    // one listening socket shared by all the workers, or one per worker if config::webserver_reuse_port is set.
+    std::vector<int> _server_fds;
     std::vector<std::thread> _workers;
 
     pthread_rwlock_t _rw_lock;
@@ -21,7 +21,13 @@
 
 #include "http/http_client.h"
 
+#include <strings.h>
+#include <unistd.h>
+
 #include "common/config.h"
+#include "http/http_status.h"
+#include "util/crc32c.h"
+#include "util/token_bucket.h"
 
 namespace starrocks {
 
@@ -99,6 +105,22 @@ Status HttpClient::init(const std::string& url) {
         LOG(WARNING) << "fail to set CURLOPT_WRITEDATA, msg=" << _to_errmsg(code);
         return Status::InternalError("fail to set CURLOPT_WRITEDATA");
     }
+
+    _response_headers.clear();
+    curl_write_callback header_callback = [](char* buffer, size_t size, size_t nmemb, void* param) {
+        HttpClient* client = (HttpClient*)param;
+        return client->on_response_header(buffer, size * nmemb);
+    };
+    code = curl_easy_setopt(_curl, CURLOPT_HEADERFUNCTION, header_callback);
+    if (code != CURLE_OK) {
+        LOG(WARNING) << "fail to set CURLOPT_HEADERFUNCTION, msg=" << _to_errmsg(code);
+        return Status::InternalError("fail to set CURLOPT_HEADERFUNCTION");
+    }
+    code = curl_easy_setopt(_curl, CURLOPT_HEADERDATA, (void*)this);
+    if (code != CURLE_OK) {
+        LOG(WARNING) << "fail to set CURLOPT_HEADERDATA, msg=" << _to_errmsg(code);
+        return Status::InternalError("fail to set CURLOPT_HEADERDATA");
+    }
     // set url
     code = curl_easy_setopt(_curl, CURLOPT_URL, url.c_str());
     if (code != CURLE_OK) {
@@ -144,6 +166,32 @@ size_t HttpClient::on_response_data(const void* data, size_t length) {
     return length;
 }
 
+size_t HttpClient::on_response_header(const char* data, size_t length) {
+    std::string line(data, length);
+    // the status line starts a new response, e.g. after a redirect.
+    if (line.compare(0, 5, "HTTP/") == 0) {
+        _response_headers.clear();
+    }
+    while (!line.empty() && (line.back() == '\r' || line.back() == '\n')) {
+        line.pop_back();
+    }
+    if (!line.empty()) {
+        _response_headers.emplace_back(std::move(line));
+    }
+    return length;
+}
+
+std::string HttpClient::get_response_header(const std::string& name) const {
+    for (auto& line : _response_headers) {
+        if (line.size() > name.size() && line[name.size()] == ':' &&
+            strncasecmp(line.c_str(), name.c_str(), name.size()) == 0) {
+            size_t pos = line.find_first_not_of(' ', name.size() + 1);
+            return pos == std::string::npos ? std::string() : line.substr(pos);
+        }
+    }
+    return std::string();
+}
+
 // Status HttpClient::execute_post_request(const std::string& post_data, const std::function<bool(const void* data, size_t length)>& callback = {}) {
 //     _callback = &callback;
 //     set_post_body(post_data);
@@ -173,8 +221,17 @@ Status HttpClient::execute(const std::function<bool(const void* data, size_t len
 }
 
 Status HttpClient::download(const std::string& local_path) {
+    return download(local_path, 0, nullptr, nullptr);
+}
+
+Status HttpClient::download(const std::string& local_path, int64_t offset, uint32_t* checksum,
+                            TokenBucket* io_limiter) {
     // set method to GET
     set_method(GET);
+    if (offset > 0) {
+        std::string range = std::to_string(offset) + "-";
+        curl_easy_setopt(_curl, CURLOPT_RANGE, range.c_str());
+    }
 
     // TODO(zc) Move this download speed limit outside to limit download speed
     // at system level
@@ -183,19 +240,41 @@ Status HttpClient::download(const std::string& local_path) {
     curl_easy_setopt(_curl, CURLOPT_MAX_RECV_SPEED_LARGE, config::max_download_speed_kbps * 1024);
 
     auto fp_closer = [](FILE* fp) { fclose(fp); };
-    std::unique_ptr<FILE, decltype(fp_closer)> fp(fopen(local_path.c_str(), "w"), fp_closer);
+    std::unique_ptr<FILE, decltype(fp_closer)> fp(fopen(local_path.c_str(), offset > 0 ? "a" : "w"), fp_closer);
     if (fp == nullptr) {
         LOG(WARNING) << "open file failed, file=" << local_path;
         return Status::InternalError("open file failed");
     }
     Status status;
-    auto callback = [&status, &fp, &local_path](const void* data, size_t length) {
+    bool first_data = true;
+    auto callback = [&, this](const void* data, size_t length) {
+        if (first_data) {
+            first_data = false;
+            // the server does not support the range requests and sends the whole file.
+            if (offset > 0 && get_http_status() != HttpStatus::PARTIAL_CONTENT) {
+                LOG(INFO) << "server does not support range requests, download the whole file " << local_path;
+                if (ftruncate(fileno(fp.get()), 0) != 0) {
+                    PLOG(WARNING) << "fail to truncate file, file=" << local_path;
+                    status = Status::InternalError("fail to truncate file when download");
+                    return false;
+                }
+                if (checksum != nullptr) {
+                    *checksum = 0;
+                }
+            }
+        }
         auto res = fwrite(data, length, 1, fp.get());
         if (res != 1) {
             LOG(WARNING) << "fail to write data to file, file=" << local_path << ", error=" << ferror(fp.get());
             status = Status::InternalError("fail to write data when download");
             return false;
         }
+        if (checksum != nullptr) {
+            *checksum = crc32c::Extend(*checksum, static_cast<const char*>(data), length);
+        }
+        if (io_limiter != nullptr) {
+            io_limiter->acquire(length);
+        }
         return true;
     };
     RETURN_IF_ERROR(execute(callback));
@@ -25,6 +25,7 @@
 
 #include <cstdio>
 #include <string>
+#include <vector>
 
 #include "common/status.h"
 #include "http/http_headers.h"
@@ -33,6 +34,8 @@
 #include "http/utils.h"
 namespace starrocks {
 
+class TokenBucket;
+
 // Helper class to access HTTP resource
 class HttpClient {
 public:
@@ -103,6 +106,9 @@ public:
         return code;
     }
 
+    // get the value of the response header |name|, or an empty string if there is no such header.
+    std::string get_response_header(const std::string& name) const;
+
     // execute a head method
     Status head() {
         set_method(HEAD);
@@ -113,6 +119,12 @@ public:
     // a file to local_path
     Status download(const std::string& local_path);
 
+    // download the file to |local_path| from |offset|, the first |offset| bytes of |local_path| are kept if the
+    // server supports the range requests, otherwise the whole file is downloaded again. |checksum|, if not
+    // null, is the crc32c of the bytes kept on input, and the crc32c of the whole file on output. the bytes
+    // written take the tokens of |io_limiter| if it's not null.
+    Status download(const std::string& local_path, int64_t offset, uint32_t* checksum, TokenBucket* io_limiter);
+
     Status execute_post_request(const std::string& payload, std::string* response);
 
     Status execute_delete_request(const std::string& payload, std::string* response);
@@ -125,6 +137,8 @@ public:
 
     size_t on_response_data(const void* data, size_t length);
 
+    size_t on_response_header(const char* data, size_t length);
+
 private:
     const char* _to_errmsg(CURLcode code);
 
@@ -134,6 +148,8 @@ private:
     const HttpCallback* _callback = nullptr;
     char _error_buf[CURL_ERROR_SIZE];
     curl_slist* _header_list = nullptr;
+    // the header lines of the last response
+    std::vector<std::string> _response_headers;
 };
 
 } // namespace starrocks
@@ -44,7 +44,12 @@ static const std::string HTTP_LOAD_MEM_LIMIT = "load_mem_limit";
 static const std::string HTTP_JSONPATHS = "jsonpaths";
 static const std::string HTTP_JSONROOT = "json_root";
 static const std::string HTTP_STRIP_OUTER_ARRAY = "strip_outer_array";
+static const std::string HTTP_GROUP_COMMIT = "group_commit";
 
 static const std::string HTTP_100_CONTINUE = "100-continue";
 
+// a HEAD request of a downloaded file with "checksum=crc32c" gets the crc32c of the file in HTTP_CRC32C_HEADER.
+static const std::string HTTP_CHECKSUM_KEY = "checksum";
+static const std::string HTTP_CRC32C_HEADER = "X-Crc32c";
+
 } // namespace starrocks
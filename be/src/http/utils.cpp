@@ -24,6 +24,8 @@
 #include <fcntl.h>
 #include <sys/stat.h>
 
+#include <cctype>
+
 #include "common/logging.h"
 #include "common/status.h"
 #include "common/utils.h"
@@ -112,6 +114,35 @@ std::string get_content_type(const std::string& file_name) {
     return "";
 }
 
+bool parse_byte_range(const std::string& range_header, int64_t* first, int64_t* last) {
+    static const std::string s_prefix = "bytes=";
+    if (range_header.compare(0, s_prefix.size(), s_prefix) != 0) {
+        return false;
+    }
+    const char* begin = range_header.c_str() + s_prefix.size();
+    const char* end = range_header.c_str() + range_header.size();
+    const char* p = begin;
+    int64_t value = 0;
+    for (; p < end && isdigit(*p); ++p) {
+        value = value * 10 + (*p - '0');
+    }
+    // at most 18 digits so that the value does not overflow.
+    if (p == begin || p - begin > 18 || p == end || *p != '-') {
+        return false;
+    }
+    *first = value;
+    begin = ++p;
+    value = 0;
+    for (; p < end && isdigit(*p); ++p) {
+        value = value * 10 + (*p - '0');
+    }
+    if (p != end || p - begin > 18) {
+        return false;
+    }
+    *last = (p == begin) ? -1 : value;
+    return *last < 0 || *last >= *first;
+}
+
 void do_file_response(const std::string& file_path, HttpRequest* req) {
     if (file_path.find("..") != std::string::npos) {
         LOG(WARNING) << "Not allowed to read relative path: " << file_path;
@@ -138,22 +169,42 @@ void do_file_response(const std::string& file_path, HttpRequest* req) {
     int64_t file_size = st.st_size;
 
     // TODO(lingbin): process "IF_MODIFIED_SINCE" header
-    // TODO(lingbin): process "RANGE" header
+    // only a single range is supported, the whole file is sent for the other forms of ranges.
+    int64_t offset = 0;
+    int64_t length = file_size;
+    HttpStatus status = HttpStatus::OK;
+    int64_t first = 0;
+    int64_t last = 0;
     const std::string& range_header = req->header(HttpHeaders::RANGE);
-    if (!range_header.empty()) {
-        // analyse range header
+    if (!range_header.empty() && parse_byte_range(range_header, &first, &last)) {
+        if (first >= file_size) {
+            close(fd);
+            req->add_output_header(HttpHeaders::CONTENT_RANGE, ("bytes */" + std::to_string(file_size)).c_str());
+            HttpChannel::send_error(req, HttpStatus::REQUESTED_RANGE_NOT_SATISFIED);
+            return;
+        }
+        if (last < 0 || last >= file_size) {
+            last = file_size - 1;
+        }
+        offset = first;
+        length = last - first + 1;
+        status = HttpStatus::PARTIAL_CONTENT;
+        std::string content_range = "bytes " + std::to_string(first) + "-" + std::to_string(last) + "/" +
+                                    std::to_string(file_size);
+        req->add_output_header(HttpHeaders::CONTENT_RANGE, content_range.c_str());
     }
 
     req->add_output_header(HttpHeaders::CONTENT_TYPE, get_content_type(file_path).c_str());
+    req->add_output_header(HttpHeaders::ACCEPT_RANGES, "bytes");
 
     if (req->method() == HttpMethod::HEAD) {
         close(fd);
-        req->add_output_header(HttpHeaders::CONTENT_LENGTH, std::to_string(file_size).c_str());
-        HttpChannel::send_reply(req);
+        req->add_output_header(HttpHeaders::CONTENT_LENGTH, std::to_string(length).c_str());
+        HttpChannel::send_reply(req, status);
         return;
     }
 
-    HttpChannel::send_file(req, fd, 0, file_size);
+    HttpChannel::send_file(req, fd, offset, length, status);
 }
 
 void do_dir_response(const std::string& dir_path, HttpRequest* req) {
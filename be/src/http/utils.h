@@ -39,6 +39,11 @@ bool parse_basic_auth(const HttpRequest& req, std::string* user, std::string* pa
 
 bool parse_basic_auth(const HttpRequest& req, AuthInfo* auth);
 
+// parse the single byte range "bytes=first-[last]" of a Range header, |*last| is -1 if it's absent.
+// return false if |range_header| is not such a range.
+bool parse_byte_range(const std::string& range_header, int64_t* first, int64_t* last);
+
+// send the file, or the byte range of the file requested by the Range header.
 void do_file_response(const std::string& dir_path, HttpRequest* req);
 
 void do_dir_response(const std::string& dir_path, HttpRequest* req);
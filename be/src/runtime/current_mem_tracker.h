@@ -9,18 +9,9 @@
 namespace starrocks {
 class CurrentMemTracker {
 public:
-    inline static void consume(int64_t size) {
-        MemTracker* tracker = CurrentThread::mem_tracker();
-        if (tracker != nullptr && size != 0) {
-            tracker->consume(size);
-        }
-    }
+    // The memory is accounted to the tracker in batches, see CurrentThread::mem_consume().
+    inline static void consume(int64_t size) { CurrentThread::mem_consume(size); }
 
-    inline static void release(int64_t size) {
-        MemTracker* tracker = CurrentThread::mem_tracker();
-        if (tracker != nullptr && size != 0) {
-            tracker->release(size);
-        }
-    }
+    inline static void release(int64_t size) { CurrentThread::mem_consume(-size); }
 };
 } // namespace starrocks
@@ -4,11 +4,12 @@
 
 #include <string>
 
+#include "common/compiler_util.h"
 #include "gen_cpp/Types_types.h"
+#include "runtime/mem_tracker.h"
 #include "util/uid_util.h"
 
 namespace starrocks {
-class MemTracker;
 class TUniqueId;
 } // namespace starrocks
 
@@ -19,22 +20,42 @@ public:
     static void set_query_id(const starrocks::TUniqueId& query_id);
     static const starrocks::TUniqueId& query_id();
     static const std::string& query_id_string();
+    // The same as query_id(), but safe to be called in signal handlers.
+    static void query_id_signal_safe(int64_t* hi, int64_t* lo);
 
-    // Return old memory tracker.
+    // Return old memory tracker, the memory cached in this thread is flushed to the old tracker.
     static starrocks::MemTracker* set_mem_tracker(starrocks::MemTracker* tracker);
     // Return current memory tracker in this thread.
     static starrocks::MemTracker* mem_tracker();
 
+    // Consume |size| bytes of the current memory tracker, negative |size| for release.
+    // The bytes are cached in this thread and flushed to the tracker only when more than MEM_CACHE_BYTES
+    // bytes are cached, so the consumption of the tracker and its ancestors, which are shared by all the
+    // threads of a query, differs from the actual one by at most MEM_CACHE_BYTES per thread.
+    static void mem_consume(int64_t size);
+    // Flush the memory cached in this thread to the current memory tracker.
+    static void mem_tracker_flush();
+
+    static constexpr int64_t MEM_CACHE_BYTES = 1024 * 1024;
+
 private:
     // `__thread` is faster than `thread_local`.
     static inline __thread starrocks::MemTracker* s_tls_mem_tracker{nullptr}; // NOLINT
+    static inline __thread int64_t s_tls_cached_mem{0};                       // NOLINT
     static inline thread_local starrocks::TUniqueId s_tls_query_id{};         // NOLINT
     static inline thread_local std::string s_tls_str_query_id{};              // NOLINT
+    static inline __thread int64_t s_tls_query_id_hi{0};                      // NOLINT
+    static inline __thread int64_t s_tls_query_id_lo{0};                      // NOLINT
 };
 
 inline void CurrentThread::set_query_id(const starrocks::TUniqueId& query_id) {
+    if (s_tls_query_id == query_id && !s_tls_str_query_id.empty()) {
+        return;
+    }
     s_tls_query_id = query_id;
     s_tls_str_query_id = starrocks::print_id(query_id);
+    s_tls_query_id_hi = query_id.hi;
+    s_tls_query_id_lo = query_id.lo;
 }
 
 inline const starrocks::TUniqueId& CurrentThread::query_id() {
@@ -45,7 +66,13 @@ inline const std::string& CurrentThread::query_id_string() {
     return s_tls_str_query_id;
 }
 
+inline void CurrentThread::query_id_signal_safe(int64_t* hi, int64_t* lo) {
+    *hi = s_tls_query_id_hi;
+    *lo = s_tls_query_id_lo;
+}
+
 inline starrocks::MemTracker* CurrentThread::set_mem_tracker(starrocks::MemTracker* tracker) {
+    mem_tracker_flush();
     auto* r = s_tls_mem_tracker;
     s_tls_mem_tracker = tracker;
     return r;
@@ -55,4 +82,21 @@ inline starrocks::MemTracker* CurrentThread::mem_tracker() {
     return s_tls_mem_tracker;
 }
 
+inline void CurrentThread::mem_consume(int64_t size) {
+    if (s_tls_mem_tracker == nullptr) {
+        return;
+    }
+    s_tls_cached_mem += size;
+    if (UNLIKELY(s_tls_cached_mem >= MEM_CACHE_BYTES || s_tls_cached_mem <= -MEM_CACHE_BYTES)) {
+        mem_tracker_flush();
+    }
+}
+
+inline void CurrentThread::mem_tracker_flush() {
+    if (s_tls_mem_tracker != nullptr && s_tls_cached_mem != 0) {
+        s_tls_mem_tracker->consume(s_tls_cached_mem);
+    }
+    s_tls_cached_mem = 0;
+}
+
 } // namespace starrocks
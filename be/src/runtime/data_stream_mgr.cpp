@@ -129,7 +129,8 @@ Status DataStreamMgr::transmit_data(const PTransmitDataParams* request, ::google
     return Status::OK();
 }
 
-Status DataStreamMgr::transmit_chunk(const PTransmitChunkParams& request, ::google::protobuf::Closure** done) {
+Status DataStreamMgr::transmit_chunk(const PTransmitChunkParams& request, PTransmitChunkResult* response,
+                                     ::google::protobuf::Closure** done, butil::IOBuf* attachment) {
     const PUniqueId& finst_id = request.finst_id();
     // TODO(zc): Use PUniqueId directly
     // We can use PUniqueId directly, because old version StarRocks has already use
@@ -157,11 +158,41 @@ Status DataStreamMgr::transmit_chunk(const PTransmitChunkParams& request, ::goog
     }
 
     bool eos = request.eos();
+    // With credit, the response isn't held by the receiver once its buffer is full, the sender stops sending
+    // when it's out of credit instead. A merging receiver must accept the chunks of the sender it's waiting for
+    // even if its buffer is full, so it doesn't grant credit.
+    bool use_credit = request.use_credit() && !recvr->is_merging();
     if (request.chunks_size() > 0) {
-        RETURN_IF_ERROR(recvr->add_chunks(request, eos ? nullptr : done));
+        RETURN_IF_ERROR(recvr->add_chunks(request, (eos || use_credit) ? nullptr : done, attachment));
     }
     if (eos) {
+        if (use_credit) {
+            recvr->revoke_credit(request.be_number());
+        }
         recvr->remove_sender(request.sender_id(), request.be_number());
+    } else if (use_credit) {
+        recvr->grant_credit(request, response, done);
+    }
+    return Status::OK();
+}
+
+Status DataStreamMgr::transmit_local_chunks(const TUniqueId& fragment_instance_id, PlanNodeId node_id, int sender_id,
+                                            int be_number, std::vector<vectorized::ChunkUniquePtr>&& chunks, bool eos,
+                                            const PQueryStatistics* query_statistics,
+                                            ::google::protobuf::Closure** done) {
+    std::shared_ptr<DataStreamRecvr> recvr = find_recvr(fragment_instance_id, node_id);
+    if (recvr == nullptr) {
+        // See transmit_chunk.
+        return Status::OK();
+    }
+    if (query_statistics != nullptr) {
+        recvr->add_sub_plan_statistics(*query_statistics, sender_id);
+    }
+    if (!chunks.empty()) {
+        recvr->add_local_chunks(sender_id, std::move(chunks), eos ? nullptr : done);
+    }
+    if (eos) {
+        recvr->remove_sender(sender_id, be_number);
     }
     return Status::OK();
 }
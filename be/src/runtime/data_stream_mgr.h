@@ -28,6 +28,7 @@
 #include <mutex>
 #include <set>
 
+#include "column/vectorized_fwd.h"
 #include "common/object_pool.h"
 #include "common/status.h"
 #include "gen_cpp/Types_types.h" // for TUniqueId
@@ -43,6 +44,10 @@ class Closure;
 }
 } // namespace google
 
+namespace butil {
+class IOBuf;
+}
+
 namespace starrocks {
 
 class DescriptorTbl;
@@ -86,7 +91,16 @@ public:
 
     Status transmit_data(const PTransmitDataParams* request, ::google::protobuf::Closure** done);
 
-    Status transmit_chunk(const PTransmitChunkParams& request, ::google::protobuf::Closure** done);
+    // The data of the chunks is read from |attachment| if it's not null, see DataStreamRecvr::add_chunks.
+    // The credit of the sender is set in |response| if the request uses credit, see DataStreamRecvr::grant_credit.
+    Status transmit_chunk(const PTransmitChunkParams& request, PTransmitChunkResult* response,
+                          ::google::protobuf::Closure** done, butil::IOBuf* attachment = nullptr);
+
+    // Hand the chunks of a sender in this process to the receiver directly, without serialization and rpc.
+    // Like transmit_chunk, *done is held and set to nullptr if the buffer of the receiver is full.
+    Status transmit_local_chunks(const TUniqueId& fragment_instance_id, PlanNodeId node_id, int sender_id,
+                                 int be_number, std::vector<vectorized::ChunkUniquePtr>&& chunks, bool eos,
+                                 const PQueryStatistics* query_statistics, ::google::protobuf::Closure** done);
     // Closes all receivers registered for fragment_instance_id immediately.
     void cancel(const TUniqueId& fragment_instance_id);
 
@@ -35,6 +35,7 @@
 #include "runtime/data_stream_mgr.h"
 #include "runtime/row_batch.h"
 #include "runtime/vectorized/sorted_chunks_merger.h"
+#include "service/brpc.h"
 #include "util/block_compression.h"
 #include "util/debug_util.h"
 #include "util/faststring.h"
@@ -83,11 +84,16 @@ public:
     // blocks if this will make the stream exceed its buffer limit.
     // If the total size of the chunks in this queue would exceed the allowed buffer size,
     // the queue is considered full and the call blocks until a chunk is dequeued.
-    Status add_chunks(const PTransmitChunkParams& request, ::google::protobuf::Closure** done);
+    Status add_chunks(const PTransmitChunkParams& request, ::google::protobuf::Closure** done,
+                      butil::IOBuf* attachment);
 
     // add_chunks_for_pipeline is almost the same like add_chunks except that it didn't
     // notify compute thread to grab chunks, compute thread is notified by pipeline's dispatch thread.
-    Status add_chunks_for_pipeline(const PTransmitChunkParams& request, ::google::protobuf::Closure** done);
+    Status add_chunks_for_pipeline(const PTransmitChunkParams& request, ::google::protobuf::Closure** done,
+                                   butil::IOBuf* attachment);
+
+    // Adds the chunks of a sender in this process without deserialization.
+    void add_local_chunks(std::vector<ChunkUniquePtr>&& chunks, ::google::protobuf::Closure** done);
 
     // Decrement the number of remaining senders for this queue and signal eos ("new data")
     // if the count drops to 0. The number of senders will be 1 for a merging
@@ -110,11 +116,20 @@ public:
 
 private:
     // _add_chunks_internal is called by add_chunks and add_chunks_for_pipeline
-    Status _add_chunks_internal(const PTransmitChunkParams& request, ::google::protobuf::Closure** done,
-                                const std::function<void()>& cb);
+    Status _add_chunks_internal(const PTransmitChunkParams& request, butil::IOBuf* attachment,
+                                ::google::protobuf::Closure** done, const std::function<void()>& cb);
+
+    typedef std::list<std::pair<int, ChunkUniquePtr>> ChunkQueue;
+
+    // Append |chunks| to _chunk_queue, and hold *done if the buffer of the receiver is full.
+    // Must be called with _lock held.
+    void _enqueue_chunks(ChunkQueue* chunks, size_t total_chunk_bytes, ::google::protobuf::Closure** done);
 
     Status _build_chunk_meta(const ChunkPB& pb_chunk);
-    Status _deserialize_chunk(const ChunkPB& pchunk, vectorized::Chunk* chunk, faststring* uncompressed_buffer);
+    // If |attachment| is not null, the data of |pchunk| is cut from its front, and it's read in place if the
+    // data is in a single block of brpc, otherwise it's gathered into |buffer|.
+    Status _deserialize_chunk(const ChunkPB& pchunk, butil::IOBuf* attachment, vectorized::Chunk* chunk,
+                              faststring* buffer, faststring* uncompressed_buffer);
 
     // Receiver of which this queue is a member.
     DataStreamRecvr* _recvr;
@@ -137,7 +152,6 @@ private:
     typedef list<pair<int, RowBatch*>> RowBatchQueue;
     RowBatchQueue _batch_queue;
 
-    typedef std::list<std::pair<int, ChunkUniquePtr>> ChunkQueue;
     ChunkQueue _chunk_queue;
     vectorized::RuntimeChunkMeta _chunk_meta;
 
@@ -204,6 +218,7 @@ bool DataStreamRecvr::SenderQueue::try_get_chunk(vectorized::Chunk** chunk) {
             closure_pair.first->Run();
             _pending_closures.pop_front();
         }
+        _recvr->_grant_pending_credits();
         return true;
     }
 }
@@ -236,6 +251,7 @@ Status DataStreamRecvr::SenderQueue::get_chunk(vectorized::Chunk** chunk) {
         closure_pair.first->Run();
         _pending_closures.pop_front();
     }
+    _recvr->_grant_pending_credits();
 
     return Status::OK();
 }
@@ -363,6 +379,7 @@ Status DataStreamRecvr::SenderQueue::_build_chunk_meta(const ChunkPB& pb_chunk)
 }
 
 Status DataStreamRecvr::SenderQueue::_add_chunks_internal(const PTransmitChunkParams& request,
+                                                          butil::IOBuf* attachment,
                                                           ::google::protobuf::Closure** done,
                                                           const std::function<void()>& cb) {
     DCHECK(request.chunks_size() > 0);
@@ -408,11 +425,12 @@ Status DataStreamRecvr::SenderQueue::_add_chunks_internal(const PTransmitChunkPa
 
     ChunkQueue chunks;
     size_t total_chunk_bytes = 0;
+    faststring buffer;
     faststring uncompressed_buffer;
     for (auto& pchunk : request.chunks()) {
-        size_t chunk_bytes = pchunk.data().size();
+        size_t chunk_bytes = attachment != nullptr ? pchunk.data_size() : pchunk.data().size();
         ChunkUniquePtr chunk = std::make_unique<vectorized::Chunk>();
-        RETURN_IF_ERROR(_deserialize_chunk(pchunk, chunk.get(), &uncompressed_buffer));
+        RETURN_IF_ERROR(_deserialize_chunk(pchunk, attachment, chunk.get(), &buffer, &uncompressed_buffer));
 
         // TODO(zc): review this chunk_bytes
         chunks.emplace_back(chunk_bytes, std::move(chunk));
@@ -426,38 +444,84 @@ Status DataStreamRecvr::SenderQueue::_add_chunks_internal(const PTransmitChunkPa
         std::unique_lock<std::mutex> l(_lock);
         wait_timer.stop();
 
-        for (auto& pair : chunks) {
-            _chunk_queue.emplace_back(std::move(pair));
-        }
-        // if done is nullptr, this function can't delay this response
-        if (done != nullptr && _recvr->exceeds_limit(total_chunk_bytes)) {
-            MonotonicStopWatch monotonicStopWatch;
-            DCHECK(*done != nullptr);
-            _pending_closures.emplace_back(*done, monotonicStopWatch);
-            *done = nullptr;
-        }
-        _recvr->_num_buffered_bytes += total_chunk_bytes;
+        _enqueue_chunks(&chunks, total_chunk_bytes, done);
     }
     cb();
     return Status::OK();
 }
 
+void DataStreamRecvr::SenderQueue::_enqueue_chunks(ChunkQueue* chunks, size_t total_chunk_bytes,
+                                                   ::google::protobuf::Closure** done) {
+    for (auto& pair : *chunks) {
+        _chunk_queue.emplace_back(std::move(pair));
+    }
+    // if done is nullptr, this function can't delay this response
+    if (done != nullptr && _recvr->exceeds_limit(total_chunk_bytes)) {
+        MonotonicStopWatch monotonicStopWatch;
+        DCHECK(*done != nullptr);
+        _pending_closures.emplace_back(*done, monotonicStopWatch);
+        *done = nullptr;
+    }
+    _recvr->_num_buffered_bytes += total_chunk_bytes;
+}
+
+void DataStreamRecvr::SenderQueue::add_local_chunks(std::vector<ChunkUniquePtr>&& chunks,
+                                                    ::google::protobuf::Closure** done) {
+    ChunkQueue chunk_queue;
+    size_t total_chunk_bytes = 0;
+    for (auto& chunk : chunks) {
+        size_t chunk_bytes = chunk->memory_usage();
+        chunk_queue.emplace_back(chunk_bytes, std::move(chunk));
+        total_chunk_bytes += chunk_bytes;
+    }
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        // See _add_chunks_internal.
+        if (_is_cancelled || _num_remaining_senders <= 0) {
+            return;
+        }
+        _enqueue_chunks(&chunk_queue, total_chunk_bytes, done);
+    }
+    if (!_recvr->_is_pipeline) {
+        _data_arrival_cv.notify_one();
+    }
+}
+
 Status DataStreamRecvr::SenderQueue::add_chunks(const PTransmitChunkParams& request,
-                                                ::google::protobuf::Closure** done) {
+                                                ::google::protobuf::Closure** done, butil::IOBuf* attachment) {
     auto& condition = _data_arrival_cv;
-    return _add_chunks_internal(request, done, [&condition]() -> void { condition.notify_one(); });
+    return _add_chunks_internal(request, attachment, done, [&condition]() -> void { condition.notify_one(); });
 }
 
 Status DataStreamRecvr::SenderQueue::add_chunks_for_pipeline(const PTransmitChunkParams& request,
-                                                             ::google::protobuf::Closure** done) {
-    return _add_chunks_internal(request, done, []() -> void {});
+                                                             ::google::protobuf::Closure** done,
+                                                             butil::IOBuf* attachment) {
+    return _add_chunks_internal(request, attachment, done, []() -> void {});
 }
 
-Status DataStreamRecvr::SenderQueue::_deserialize_chunk(const ChunkPB& pchunk, vectorized::Chunk* chunk,
+Status DataStreamRecvr::SenderQueue::_deserialize_chunk(const ChunkPB& pchunk, butil::IOBuf* attachment,
+                                                        vectorized::Chunk* chunk, faststring* buffer,
                                                         faststring* uncompressed_buffer) {
+    Slice data(pchunk.data());
+    // Hold the blocks cut from attachment until the chunk is deserialized.
+    butil::IOBuf chunk_buf;
+    if (attachment != nullptr) {
+        if (UNLIKELY(attachment->cutn(&chunk_buf, pchunk.data_size()) != pchunk.data_size())) {
+            return Status::InternalError("chunk data is truncated in attachment");
+        }
+        if (chunk_buf.backing_block_num() == 1) {
+            butil::StringPiece block = chunk_buf.backing_block(0);
+            data = Slice(block.data(), block.size());
+        } else {
+            buffer->resize(chunk_buf.size());
+            chunk_buf.copy_to(buffer->data(), buffer->size());
+            data = Slice(buffer->data(), buffer->size());
+        }
+    }
+
     if (pchunk.compress_type() == CompressionTypePB::NO_COMPRESSION) {
         SCOPED_TIMER(_recvr->_deserialize_row_batch_timer);
-        RETURN_IF_ERROR(chunk->deserialize((const uint8_t*)pchunk.data().data(), pchunk.data().size(), _chunk_meta));
+        RETURN_IF_ERROR(chunk->deserialize((const uint8_t*)data.data, data.size, _chunk_meta));
     } else {
         size_t uncompressed_size = 0;
         {
@@ -467,7 +531,7 @@ Status DataStreamRecvr::SenderQueue::_deserialize_chunk(const ChunkPB& pchunk, v
             uncompressed_size = pchunk.uncompressed_size();
             uncompressed_buffer->resize(uncompressed_size);
             Slice output{uncompressed_buffer->data(), uncompressed_size};
-            RETURN_IF_ERROR(codec->decompress(pchunk.data(), &output));
+            RETURN_IF_ERROR(codec->decompress(data, &output));
         }
         {
             SCOPED_TIMER(_recvr->_deserialize_row_batch_timer);
@@ -610,7 +674,8 @@ DataStreamRecvr::DataStreamRecvr(DataStreamMgr* stream_mgr, MemTracker* parent_t
           _num_buffered_bytes(0),
           _profile(std::move(profile)),
           _sub_plan_query_statistics_recvr(std::move(sub_plan_query_statistics_recvr)),
-          _is_pipeline(is_pipeline) {
+          _is_pipeline(is_pipeline),
+          _num_senders(num_senders) {
     (void)parent_tracker;
     // TODO: Now the parent tracker may cause problem when we need spill to disk, so we
     // replace parent_tracker with nullptr, fix future
@@ -664,34 +729,143 @@ void DataStreamRecvr::add_batch(const PRowBatch& batch, int sender_id, int be_nu
     _sender_queues[use_sender_id]->add_batch(batch, be_number, packet_seq, done);
 }
 
-Status DataStreamRecvr::add_chunks(const PTransmitChunkParams& request, ::google::protobuf::Closure** done) {
+Status DataStreamRecvr::add_chunks(const PTransmitChunkParams& request, ::google::protobuf::Closure** done,
+                                   butil::IOBuf* attachment) {
     SCOPED_TIMER(_sender_total_timer);
     COUNTER_UPDATE(_request_received_counter, 1);
     int use_sender_id = _is_merging ? request.sender_id() : 0;
     // Add all batches to the same queue if _is_merging is false.
 
     if (!_is_pipeline) {
-        return _sender_queues[use_sender_id]->add_chunks(request, done);
+        return _sender_queues[use_sender_id]->add_chunks(request, done, attachment);
     } else {
-        return _sender_queues[use_sender_id]->add_chunks_for_pipeline(request, done);
+        auto status = _sender_queues[use_sender_id]->add_chunks_for_pipeline(request, done, attachment);
+        _observable.notify_observers();
+        return status;
+    }
+}
+
+void DataStreamRecvr::add_local_chunks(int sender_id, std::vector<ChunkUniquePtr>&& chunks,
+                                       ::google::protobuf::Closure** done) {
+    SCOPED_TIMER(_sender_total_timer);
+    COUNTER_UPDATE(_request_received_counter, 1);
+    int use_sender_id = _is_merging ? sender_id : 0;
+    _sender_queues[use_sender_id]->add_local_chunks(std::move(chunks), done);
+    if (_is_pipeline) {
+        _observable.notify_observers();
     }
 }
 
 void DataStreamRecvr::remove_sender(int sender_id, int be_number) {
     int use_sender_id = _is_merging ? sender_id : 0;
     _sender_queues[use_sender_id]->decrement_senders(be_number);
+    _observable.notify_observers();
+}
+
+void DataStreamRecvr::grant_credit(const PTransmitChunkParams& request, PTransmitChunkResult* response,
+                                   ::google::protobuf::Closure** done) {
+    std::lock_guard<std::mutex> l(_credit_lock);
+    if (_credit_closed) {
+        // Without credit, the sender sends the rest chunks, which are dropped, instead of asking for credit again.
+        return;
+    }
+    // The chunks of the request are buffered already, and the previous credit of the sender is replaced.
+    _set_credit(request.be_number(), 0);
+    auto iter = _pending_credit_requests.find(request.be_number());
+    if (iter != _pending_credit_requests.end()) {
+        iter->second.response->set_credit_bytes(0);
+        iter->second.done->Run();
+        _pending_credit_requests.erase(iter);
+        _num_pending_credit_requests--;
+    }
+
+    int64_t credit = _available_credit(request.min_credit_bytes());
+    if (credit > 0 || request.chunks_size() > 0) {
+        _set_credit(request.be_number(), credit);
+        response->set_credit_bytes(credit);
+        return;
+    }
+    _pending_credit_requests.emplace(request.be_number(),
+                                     PendingCreditRequest{*done, response, request.min_credit_bytes()});
+    _num_pending_credit_requests++;
+    *done = nullptr;
+}
+
+void DataStreamRecvr::revoke_credit(int be_number) {
+    std::lock_guard<std::mutex> l(_credit_lock);
+    _set_credit(be_number, 0);
+}
+
+void DataStreamRecvr::_grant_pending_credits() {
+    if (_num_pending_credit_requests == 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> l(_credit_lock);
+    for (auto iter = _pending_credit_requests.begin(); iter != _pending_credit_requests.end();) {
+        int64_t credit = _available_credit(iter->second.min_bytes);
+        if (credit == 0) {
+            ++iter;
+            continue;
+        }
+        _set_credit(iter->first, credit);
+        iter->second.response->set_credit_bytes(credit);
+        iter->second.done->Run();
+        iter = _pending_credit_requests.erase(iter);
+        _num_pending_credit_requests--;
+    }
+}
+
+void DataStreamRecvr::_release_pending_credits() {
+    std::lock_guard<std::mutex> l(_credit_lock);
+    _credit_closed = true;
+    for (auto& [be_number, request] : _pending_credit_requests) {
+        request.done->Run();
+    }
+    _pending_credit_requests.clear();
+    _num_pending_credit_requests = 0;
+    _granted_credits.clear();
+    _num_granted_bytes = 0;
+}
+
+int64_t DataStreamRecvr::_available_credit(int64_t min_bytes) const {
+    int64_t free_bytes = _total_buffer_limit - _num_buffered_bytes - _num_granted_bytes;
+    int64_t share = std::max<int64_t>(free_bytes, 0) / std::max(_num_senders, 1);
+    if (share > 0 && share >= min_bytes) {
+        return share;
+    }
+    // The next request of the sender is larger than its share, it's granted once the free buffer covers it.
+    // A request larger than the whole free buffer is granted once nothing is buffered, or it would never be sent.
+    if (min_bytes > 0 && (min_bytes <= free_bytes || _num_buffered_bytes == 0)) {
+        return min_bytes;
+    }
+    return 0;
+}
+
+void DataStreamRecvr::_set_credit(int be_number, int64_t credit) {
+    auto iter = _granted_credits.find(be_number);
+    if (iter != _granted_credits.end()) {
+        _num_granted_bytes -= iter->second;
+        _granted_credits.erase(iter);
+    }
+    if (credit > 0) {
+        _granted_credits.emplace(be_number, credit);
+        _num_granted_bytes += credit;
+    }
 }
 
 void DataStreamRecvr::cancel_stream() {
     for (auto& _sender_queue : _sender_queues) {
         _sender_queue->cancel();
     }
+    _release_pending_credits();
+    _observable.notify_observers();
 }
 
 void DataStreamRecvr::close() {
     for (auto& _sender_queue : _sender_queues) {
         _sender_queue->close();
     }
+    _release_pending_credits();
     // Remove this receiver from the DataStreamMgr that created it.
     // TODO: log error msg
     _mgr->deregister_recvr(fragment_instance_id(), dest_node_id());
@@ -22,9 +22,14 @@
 #ifndef STARROCKS_BE_SRC_RUNTIME_DATA_STREAM_RECVR_H
 #define STARROCKS_BE_SRC_RUNTIME_DATA_STREAM_RECVR_H
 
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
 #include "column/vectorized_fwd.h"
 #include "common/object_pool.h"
 #include "common/status.h"
+#include "exec/pipeline/pipeline_observer.h"
 #include "gen_cpp/Types_types.h" // for TUniqueId
 #include "runtime/descriptors.h"
 #include "runtime/query_statistics.h"
@@ -36,6 +41,10 @@ class Closure;
 }
 } // namespace google
 
+namespace butil {
+class IOBuf;
+}
+
 namespace starrocks {
 
 namespace vectorized {
@@ -48,6 +57,7 @@ class RowBatch;
 class RuntimeProfile;
 class PRowBatch;
 class PTransmitChunkParams;
+class PTransmitChunkResult;
 
 // Single receiver of an m:n data stream.
 // DataStreamRecvr maintains one or more queues of row batches received by a
@@ -99,6 +109,7 @@ public:
     PlanNodeId dest_node_id() const { return _dest_node_id; }
     const RowDescriptor& row_desc() const { return _row_desc; }
     MemTracker* mem_tracker() const { return _mem_tracker.get(); }
+    bool is_merging() const { return _is_merging; }
 
     void add_sub_plan_statistics(const PQueryStatistics& statistics, int sender_id) {
         _sub_plan_query_statistics_recvr->insert(statistics, sender_id);
@@ -110,6 +121,12 @@ public:
 
     bool is_data_ready();
 
+    // the observers are notified when chunks arrive, the senders finish or the stream is cancelled.
+    void add_observer(pipeline::PipelineObserver* observer) { _observable.add_observer(observer); }
+    // the observer of a consumer must be removed before the consumer is destructed, since brpc threads may
+    // still reference this receiver, the observers of the other consumers are kept.
+    void remove_observer(pipeline::PipelineObserver* observer) { _observable.remove_observer(observer); }
+
 private:
     friend class DataStreamMgr;
     class SenderQueue;
@@ -124,12 +141,47 @@ private:
                    ::google::protobuf::Closure** done);
 
     // If receive queue is full, done is enqueue pending, and return with *done is nullptr
-    Status add_chunks(const PTransmitChunkParams& request, ::google::protobuf::Closure** done);
+    // If |attachment| is not null, the data of the chunks is read from it instead of ChunkPB::data,
+    // and it's consumed by the data_size of each chunk.
+    Status add_chunks(const PTransmitChunkParams& request, ::google::protobuf::Closure** done,
+                      butil::IOBuf* attachment = nullptr);
+
+    // Add the chunks of a sender in this process, which are queued as they are.
+    // If receive queue is full, done is enqueue pending, and return with *done is nullptr
+    void add_local_chunks(int sender_id, std::vector<vectorized::ChunkUniquePtr>&& chunks,
+                          ::google::protobuf::Closure** done);
 
     // Indicate that a particular sender is done. Delegated to the appropriate
     // sender queue. Called from DataStreamMgr.
     void remove_sender(int sender_id, int be_number);
 
+    // Set the credit of the sender of |request| in |response|, which is its share of the free buffer. The buffer
+    // is freed as fast as the consumer takes the chunks, so the senders are paced by the consumer.
+    // The credit granted and not used yet is reserved, so the chunks buffered never exceed the limit, unless
+    // a single request is larger than the free buffer while nothing is buffered.
+    // A request without chunks asks for a credit of at least its min_credit_bytes, if there is not enough
+    // free buffer, it's held in *done until the consumer frees some, and its previous held request is
+    // answered with no credit, since the sender has stopped waiting for it.
+    void grant_credit(const PTransmitChunkParams& request, PTransmitChunkResult* response,
+                      ::google::protobuf::Closure** done);
+
+    // Drop the credit of the sender once it has sent its eos.
+    void revoke_credit(int be_number);
+
+    // Answer the held credit requests once there is enough free buffer, called after the consumer takes chunks.
+    void _grant_pending_credits();
+
+    // Answer all the held credit requests without credit, so that the senders stop asking for credit,
+    // called when the stream is cancelled or closed.
+    void _release_pending_credits();
+
+    // The credit which may be granted to a sender needing |min_bytes|, or 0 if there is not enough free buffer,
+    // must be called with _credit_lock held.
+    int64_t _available_credit(int64_t min_bytes) const;
+
+    // Replace the credit of the sender, must be called with _credit_lock held.
+    void _set_credit(int be_number, int64_t credit);
+
     // Empties the sender queues and notifies all waiting consumers of cancellation.
     void cancel_stream();
 
@@ -174,6 +226,9 @@ private:
     // Pool of sender queues.
     ObjectPool _sender_queue_pool;
 
+    // observers of the drivers reading from this receiver, only used by pipeline engine.
+    pipeline::PipelineObservable _observable;
+
     // Runtime profile storing the counters below.
     std::shared_ptr<RuntimeProfile> _profile;
 
@@ -208,6 +263,22 @@ private:
     RuntimeProfile::Counter* _data_arrival_timer;
 
     bool _is_pipeline;
+
+    int _num_senders;
+
+    struct PendingCreditRequest {
+        google::protobuf::Closure* done;
+        PTransmitChunkResult* response;
+        int64_t min_bytes;
+    };
+    std::mutex _credit_lock;
+    // be_number => the held credit request of the sender.
+    std::unordered_map<int, PendingCreditRequest> _pending_credit_requests;
+    // be_number => the credit granted to the sender by the last response, which is reserved in the buffer.
+    std::unordered_map<int, int64_t> _granted_credits;
+    int64_t _num_granted_bytes = 0;
+    std::atomic<int> _num_pending_credit_requests{0};
+    bool _credit_closed = false;
 };
 
 } // end namespace starrocks
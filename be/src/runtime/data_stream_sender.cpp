@@ -26,6 +26,7 @@
 
 #include <algorithm>
 #include <boost/thread/thread.hpp>
+#include <condition_variable>
 #include <functional>
 #include <iostream>
 #include <memory>
@@ -37,6 +38,7 @@
 #include "gen_cpp/BackendService.h"
 #include "gen_cpp/Types_types.h"
 #include "runtime/client_cache.h"
+#include "runtime/data_stream_mgr.h"
 #include "runtime/descriptors.h"
 #include "runtime/dpp_sink_internal.h"
 #include "runtime/exec_env.h"
@@ -45,6 +47,7 @@
 #include "runtime/row_batch.h"
 #include "runtime/runtime_state.h"
 #include "runtime/tuple_row.h"
+#include "service/backend_options.h"
 #include "service/brpc.h"
 #include "util/block_compression.h"
 #include "util/brpc_stub_cache.h"
@@ -57,6 +60,38 @@
 
 namespace starrocks {
 
+// Run by the receiver once it accepts the chunks of a local channel, which is delayed while its buffer is full.
+// It's owned by both the channel and the receiver, so that the channel can give up waiting for it.
+class LocalChunksClosure final : public google::protobuf::Closure {
+public:
+    void Run() override {
+        {
+            std::lock_guard<std::mutex> l(_mutex);
+            _done = true;
+        }
+        _cv.notify_all();
+        unref();
+    }
+
+    // Return false if it's not run within timeout_ms.
+    bool wait(int timeout_ms) {
+        std::unique_lock<std::mutex> l(_mutex);
+        return _cv.wait_for(l, std::chrono::milliseconds(timeout_ms), [this] { return _done; });
+    }
+
+    void unref() {
+        if (_refs.fetch_sub(1) == 1) {
+            delete this;
+        }
+    }
+
+private:
+    std::atomic<int> _refs{2};
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    bool _done = false;
+};
+
 // A channel sends data asynchronously via calls to transmit_data
 // to a single destination ipaddress/node.
 // It has a fixed-capacity buffer and allows the caller either to add rows to
@@ -96,6 +131,10 @@ public:
             delete _chunk_closure;
         }
         _chunk_request.release_finst_id();
+
+        if (_local_closure != nullptr) {
+            _local_closure->unref();
+        }
     }
 
     // Initialize channel.
@@ -136,9 +175,15 @@ public:
 
     TUniqueId get_fragment_instance_id() { return _fragment_instance_id; }
 
+    // Whether the receiver is in this backend, whose chunks are passed through without serialization.
+    bool is_local() const { return _is_local; }
+
 private:
     inline Status _wait_prev_request() {
         SCOPED_TIMER(_parent->_wait_response_timer);
+        if (_is_local) {
+            return _wait_local_request();
+        }
         if (_request_seq == 0) {
             return Status::OK();
         }
@@ -152,6 +197,21 @@ private:
         return {_chunk_closure->result.status()};
     }
 
+    Status _wait_local_request() {
+        if (_local_closure == nullptr) {
+            return Status::OK();
+        }
+        bool done = _local_closure->wait(_brpc_timeout_ms);
+        _local_closure->unref();
+        _local_closure = nullptr;
+        if (!done) {
+            return Status::ThriftRpcError("fail to send chunks to local receiver, timeout");
+        }
+        return Status::OK();
+    }
+
+    Status _send_local_chunks(bool eos);
+
 private:
     Status _send_current_chunk(bool eos);
 
@@ -197,6 +257,12 @@ private:
     bool _is_transfer_chain;
     bool _send_query_statistics_with_every_batch;
     bool _is_inited = false;
+
+    bool _is_local = false;
+    // the chunks of a local channel not passed to the receiver yet.
+    std::vector<vectorized::ChunkUniquePtr> _local_chunks;
+    size_t _local_chunks_bytes = 0;
+    LocalChunksClosure* _local_closure = nullptr;
 };
 
 Status DataStreamSender::Channel::init(RuntimeState* state) {
@@ -233,6 +299,8 @@ Status DataStreamSender::Channel::init(RuntimeState* state) {
         return Status::OK();
     }
     _brpc_stub = state->exec_env()->brpc_stub_cache()->get_stub(_brpc_dest_addr);
+    _is_local = config::enable_exchange_pass_through && _brpc_dest_addr.hostname == BackendOptions::get_localhost() &&
+                _brpc_dest_addr.port == config::brpc_port;
 
     _need_close = true;
     _is_inited = true;
@@ -242,6 +310,20 @@ Status DataStreamSender::Channel::init(RuntimeState* state) {
 Status DataStreamSender::Channel::send_one_chunk(const vectorized::Chunk* chunk, bool eos, bool* is_real_sent) {
     *is_real_sent = false;
 
+    if (_is_local) {
+        if (chunk != nullptr) {
+            auto copy = chunk->clone_empty_with_tuple(chunk->num_rows());
+            copy->append(*chunk);
+            _local_chunks_bytes += copy->memory_usage();
+            _local_chunks.emplace_back(std::move(copy));
+        }
+        if (_local_chunks_bytes > _parent->_request_bytes_threshold || eos) {
+            RETURN_IF_ERROR(_send_local_chunks(eos));
+            *is_real_sent = true;
+        }
+        return Status::OK();
+    }
+
     // If chunk is not null, append it to request
     if (chunk != nullptr) {
         auto pchunk = _chunk_request.add_chunks();
@@ -272,6 +354,28 @@ Status DataStreamSender::Channel::send_one_chunk(const vectorized::Chunk* chunk,
     return Status::OK();
 }
 
+Status DataStreamSender::Channel::_send_local_chunks(bool eos) {
+    RETURN_IF_ERROR(_wait_prev_request());
+    SCOPED_TIMER(_parent->_send_request_timer);
+    PQueryStatistics query_statistics;
+    bool with_statistics = _is_transfer_chain && (_send_query_statistics_with_every_batch || eos);
+    if (with_statistics) {
+        _parent->_query_statistics->to_pb(&query_statistics);
+    }
+    _local_closure = new LocalChunksClosure();
+    google::protobuf::Closure* done = _local_closure;
+    Status status = _parent->_state->exec_env()->stream_mgr()->transmit_local_chunks(
+            _fragment_instance_id, _dest_node_id, _parent->_sender_id, _parent->_be_number, std::move(_local_chunks),
+            eos, with_statistics ? &query_statistics : nullptr, &done);
+    // Not held by the receiver.
+    if (done != nullptr) {
+        done->Run();
+    }
+    _local_chunks.clear();
+    _local_chunks_bytes = 0;
+    return status;
+}
+
 Status DataStreamSender::Channel::send_chunk_request(PTransmitChunkParams* params, const butil::IOBuf& attachment) {
     RETURN_IF_ERROR(_wait_prev_request());
     params->set_allocated_finst_id(&_finst_id);
@@ -319,6 +423,15 @@ Status DataStreamSender::Channel::add_rows_selective(vectorized::Chunk* chunk, c
 }
 
 Status DataStreamSender::Channel::_send_current_chunk(bool eos) {
+    if (_is_local) {
+        // Pass the chunk itself instead of a copy.
+        auto next_chunk = _chunk->clone_empty_with_tuple();
+        _local_chunks_bytes += _chunk->memory_usage();
+        _local_chunks.emplace_back(std::move(_chunk));
+        _chunk = std::move(next_chunk);
+        bool is_real_sent = false;
+        return send_one_chunk(nullptr, eos, &is_real_sent);
+    }
     bool is_real_sent = false;
     RETURN_IF_ERROR(send_one_chunk(_chunk.get(), eos, &is_real_sent));
 
@@ -513,6 +626,7 @@ Status DataStreamSender::prepare(RuntimeState* state) {
             "");
     for (auto& _channel : _channels) {
         RETURN_IF_ERROR(_channel->init(state));
+        _num_local_channels += _channel->is_local();
     }
 
     // set eos for all channels.
@@ -547,18 +661,32 @@ Status DataStreamSender::send_chunk(RuntimeState* state, vectorized::Chunk* chun
     }
     // Unpartition or _channel size
     if (_part_type == TPartitionType::UNPARTITIONED || _channels.size() == 1) {
+        // The local channels take the chunk as it is, the others share one serialized request.
+        if (_num_local_channels > 0) {
+            for (auto channel : _channels) {
+                if (channel->is_local()) {
+                    bool real_sent = false;
+                    RETURN_IF_ERROR(channel->send_one_chunk(chunk, false, &real_sent));
+                }
+            }
+        }
+        if (_num_local_channels == _channels.size()) {
+            return Status::OK();
+        }
         // We use sender request to avoid serialize chunk many times.
         // 1. create a new chunk PB to serialize
         ChunkPB* pchunk = _chunk_request.add_chunks();
         // 2. serialize input chunk to pchunk
-        RETURN_IF_ERROR(serialize_chunk(chunk, pchunk, &_is_first_chunk, _channels.size()));
+        RETURN_IF_ERROR(serialize_chunk(chunk, pchunk, &_is_first_chunk, _channels.size() - _num_local_channels));
         _current_request_bytes += pchunk->data().size();
         // 3. if request bytes exceede the threshold, send current request
         if (_current_request_bytes > _request_bytes_threshold) {
             butil::IOBuf attachment;
             construct_brpc_attachment(&_chunk_request, &attachment);
             for (auto channel : _channels) {
-                RETURN_IF_ERROR(channel->send_chunk_request(&_chunk_request, attachment));
+                if (!channel->is_local()) {
+                    RETURN_IF_ERROR(channel->send_chunk_request(&_chunk_request, attachment));
+                }
             }
             _current_request_bytes = 0;
             _chunk_request.clear_chunks();
@@ -651,7 +779,11 @@ Status DataStreamSender::close(RuntimeState* state, Status exec_status) {
         butil::IOBuf attachment;
         construct_brpc_attachment(&_chunk_request, &attachment);
         for (auto& _channel : _channels) {
-            _channel->send_chunk_request(&_chunk_request, attachment);
+            if (_channel->is_local()) {
+                _channel->close(state);
+            } else {
+                _channel->send_chunk_request(&_chunk_request, attachment);
+            }
         }
     } else {
         for (auto& _channel : _channels) {
@@ -686,9 +818,17 @@ Status DataStreamSender::serialize_chunk(const vectorized::Chunk* src, ChunkPB*
         SCOPED_TIMER(_serialize_batch_timer);
         dst->set_compress_type(CompressionTypePB::NO_COMPRESSION);
         // We only serialize chunk meta for first chunk
+        bool encoded = config::exchange_encode_chunk;
         if (*is_first_chunk) {
-            uncompressed_size = src->serialize_with_meta(dst);
+            uncompressed_size = src->serialize_with_meta(dst, encoded);
             *is_first_chunk = false;
+        } else if (encoded) {
+            dst->clear_is_nulls();
+            dst->clear_is_consts();
+            dst->clear_slot_id_map();
+            dst->mutable_data()->resize(src->max_encoded_size());
+            uncompressed_size = src->serialize_encoded((uint8_t*)dst->mutable_data()->data());
+            dst->mutable_data()->resize(uncompressed_size);
         } else {
             dst->clear_is_nulls();
             dst->clear_is_consts();
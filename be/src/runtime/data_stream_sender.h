@@ -148,6 +148,8 @@ private:
 
     std::vector<Channel*> _channels;
     std::vector<std::shared_ptr<Channel>> _channel_shared_ptrs;
+    // the channels of _channels whose receivers are in this backend, see Channel::is_local.
+    size_t _num_local_channels = 0;
 
     // map from range value to partition_id
     // sorted in ascending orderi by range for binary search
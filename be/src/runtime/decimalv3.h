@@ -68,8 +68,21 @@ public:
 
     // check divide-by-zero before calling div and mod
     static inline bool div_round(Type const& a, Type const& b, Type* c) {
+        Type r;
+#if defined(__x86_64__) && defined(__GNUC__)
+        if constexpr (std::is_same_v<Type, int128_t>) {
+            // one call computes both the quotient and the remainder, with the fast path of 64-bit divisors.
+            uint128_t ur;
+            divmodti3(a, b, *c, ur);
+            r = static_cast<Type>(ur);
+        } else {
+            *c = a / b;
+            r = a % b;
+        }
+#else
         *c = a / b;
-        Type r = a % b;
+        r = a % b;
+#endif
         // case 1: |b| is odd. if [|b|/2] < |r|, then add carry; otherwise add 0.
         // case 2: |b| is even. if [|b|/2] <= |r|, then add carry; otherwise add 0. here
         // [b/2] == r means round half to up.
@@ -44,6 +44,7 @@
 #include "runtime/routine_load/routine_load_task_executor.h"
 #include "runtime/runtime_filter_worker.h"
 #include "runtime/small_file_mgr.h"
+#include "runtime/stream_load/group_commit_mgr.h"
 #include "runtime/stream_load/load_stream_mgr.h"
 #include "runtime/stream_load/stream_load_executor.h"
 #include "runtime/thread_resource_mgr.h"
@@ -89,12 +90,14 @@ Status ExecEnv::_init(const std::vector<StorePath>& store_paths) {
     _broker_client_cache = new BrokerServiceClientCache(config::max_client_cache_size_per_host);
     _thread_mgr = new ThreadResourceMgr();
     _thread_pool = new PriorityThreadPool(config::doris_scanner_thread_pool_thread_num,
-                                          config::doris_scanner_thread_pool_queue_size);
+                                          config::doris_scanner_thread_pool_queue_size,
+                                          config::doris_scanner_thread_pool_num_lanes);
     LOG(INFO) << strings::Substitute("[PIPELINE] IO thread pool: thread_num=$0, queue_size=$1",
                                      config::pipeline_io_thread_pool_thread_num,
                                      config::pipeline_io_thread_pool_queue_size);
     _pipeline_io_thread_pool = new PriorityThreadPool(config::pipeline_io_thread_pool_thread_num,
-                                                      config::pipeline_io_thread_pool_queue_size);
+                                                      config::pipeline_io_thread_pool_queue_size,
+                                                      config::pipeline_io_thread_pool_num_lanes);
     _num_scan_operators = 0;
     _etl_thread_pool = new PriorityThreadPool(config::etl_thread_pool_size, config::etl_thread_pool_queue_size);
     _fragment_mgr = new FragmentMgr(this);
@@ -121,6 +124,7 @@ Status ExecEnv::_init(const std::vector<StorePath>& store_paths) {
     _load_stream_mgr = new LoadStreamMgr();
     _brpc_stub_cache = new BrpcStubCache();
     _stream_load_executor = new StreamLoadExecutor(this);
+    _group_commit_mgr = new GroupCommitMgr(this);
     _routine_load_task_executor = new RoutineLoadTaskExecutor(this);
     _small_file_mgr = new SmallFileMgr(this, config::small_file_dir);
     _plugin_mgr = new PluginMgr();
@@ -184,6 +188,7 @@ Status ExecEnv::init_mem_tracker() {
     _central_column_pool_mem_tracker = new MemTracker(-1, "central_column_pool", _column_pool_mem_tracker);
     _local_column_pool_mem_tracker = new MemTracker(-1, "local_column_pool", _column_pool_mem_tracker);
     _page_cache_mem_tracker = new MemTracker(-1, "page_cache", _mem_tracker);
+    _scan_result_cache_mem_tracker = new MemTracker(-1, "scan_result_cache", _mem_tracker);
     _update_mem_tracker = new MemTracker(bytes_limit * 0.6, "update", _mem_tracker);
 
     return Status::OK();
@@ -232,6 +237,10 @@ void ExecEnv::_destory() {
         delete _routine_load_task_executor;
         _routine_load_task_executor = nullptr;
     }
+    if (_group_commit_mgr) {
+        delete _group_commit_mgr;
+        _group_commit_mgr = nullptr;
+    }
     if (_stream_load_executor) {
         delete _stream_load_executor;
         _stream_load_executor = nullptr;
@@ -296,6 +305,10 @@ void ExecEnv::_destory() {
         delete _update_mem_tracker;
         _update_mem_tracker = nullptr;
     }
+    if (_scan_result_cache_mem_tracker) {
+        delete _scan_result_cache_mem_tracker;
+        _scan_result_cache_mem_tracker = nullptr;
+    }
     if (_page_cache_mem_tracker) {
         delete _page_cache_mem_tracker;
         _page_cache_mem_tracker = nullptr;
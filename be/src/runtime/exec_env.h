@@ -54,6 +54,7 @@ class LoadChannelMgr;
 class ThreadResourceMgr;
 class WebPageHandler;
 class StreamLoadExecutor;
+class GroupCommitMgr;
 class RoutineLoadTaskExecutor;
 class SmallFileMgr;
 class PluginMgr;
@@ -118,6 +119,7 @@ public:
     MemTracker* local_column_pool_mem_tracker() { return _local_column_pool_mem_tracker; }
     MemTracker* central_column_pool_mem_tracker() { return _central_column_pool_mem_tracker; }
     MemTracker* page_cache_mem_tracker() { return _page_cache_mem_tracker; }
+    MemTracker* scan_result_cache_mem_tracker() { return _scan_result_cache_mem_tracker; }
     MemTracker* update_mem_tracker() { return _update_mem_tracker; }
 
     ThreadResourceMgr* thread_mgr() { return _thread_mgr; }
@@ -143,6 +145,7 @@ public:
     void set_storage_engine(StorageEngine* storage_engine);
 
     StreamLoadExecutor* stream_load_executor() { return _stream_load_executor; }
+    GroupCommitMgr* group_commit_mgr() { return _group_commit_mgr; }
     RoutineLoadTaskExecutor* routine_load_task_executor() { return _routine_load_task_executor; }
     HeartbeatFlags* heartbeat_flags() { return _heartbeat_flags; }
 
@@ -198,6 +201,9 @@ private:
     // The memory used for page cache
     MemTracker* _page_cache_mem_tracker = nullptr;
 
+    // The memory used for the scan results cached by pipeline engine
+    MemTracker* _scan_result_cache_mem_tracker = nullptr;
+
     // The memory tracker for update manager
     MemTracker* _update_mem_tracker = nullptr;
 
@@ -220,6 +226,7 @@ private:
     StorageEngine* _storage_engine = nullptr;
 
     StreamLoadExecutor* _stream_load_executor = nullptr;
+    GroupCommitMgr* _group_commit_mgr = nullptr;
     RoutineLoadTaskExecutor* _routine_load_task_executor = nullptr;
     SmallFileMgr* _small_file_mgr = nullptr;
     HeartbeatFlags* _heartbeat_flags = nullptr;
@@ -23,9 +23,12 @@
 
 #include "exec/broker_writer.h"
 #include "exec/local_file_writer.h"
-#include "exec/parquet_writer.h"
+#include "column/chunk.h"
+#include "exec/parquet/file_writer.h"
 #include "exprs/expr.h"
+#include "exprs/expr_context.h"
 #include "gen_cpp/InternalService_types.h"
+#include "runtime/exec_env.h"
 #include "runtime/primitive_type.h"
 #include "runtime/row_batch.h"
 #include "runtime/runtime_state.h"
@@ -39,8 +42,12 @@ namespace starrocks {
 const size_t FileResultWriter::OUTSTREAM_BUFFER_SIZE_BYTES = 1024 * 1024;
 
 FileResultWriter::FileResultWriter(const ResultFileOptions* file_opts,
-                                   const std::vector<ExprContext*>& output_expr_ctxs, RuntimeProfile* parent_profile)
-        : _file_opts(file_opts), _output_expr_ctxs(output_expr_ctxs), _parent_profile(parent_profile) {}
+                                   const std::vector<ExprContext*>& output_expr_ctxs, RuntimeProfile* parent_profile,
+                                   int32_t driver_sequence)
+        : _file_opts(file_opts),
+          _output_expr_ctxs(output_expr_ctxs),
+          _driver_sequence(driver_sequence),
+          _parent_profile(parent_profile) {}
 
 FileResultWriter::~FileResultWriter() {
     _close_file_writer(true);
@@ -78,9 +85,22 @@ Status FileResultWriter::_create_file_writer() {
     case TFileFormatType::FORMAT_CSV_PLAIN:
         // just use file writer is enough
         break;
-    case TFileFormatType::FORMAT_PARQUET:
-        _parquet_writer = new ParquetWriterWrapper(_file_writer, _output_expr_ctxs);
+    case TFileFormatType::FORMAT_PARQUET: {
+        std::vector<std::string> column_names;
+        std::vector<TypeDescriptor> types;
+        for (size_t i = 0; i < _output_expr_ctxs.size(); ++i) {
+            column_names.emplace_back("col" + std::to_string(i));
+            types.emplace_back(_output_expr_ctxs[i]->root()->type());
+        }
+        // the column chunks of a row group are encoded in parallel on the io threads, while the next row group
+        // is buffered.
+        parquet::FileWriterOptions options;
+        options.pool = _state->exec_env()->pipeline_io_thread_pool();
+        _parquet_writer = std::make_unique<parquet::FileWriter>(_file_writer, std::move(column_names),
+                                                                std::move(types), options);
+        RETURN_IF_ERROR(_parquet_writer->init());
         break;
+    }
     default:
         return Status::InternalError(strings::Substitute("unsupport file format: $0", _file_opts->file_format));
     }
@@ -89,10 +109,14 @@ Status FileResultWriter::_create_file_writer() {
     return Status::OK();
 }
 
-// file name format as: my_prefix_0.csv
+// file name format as: my_prefix_0.csv, or my_prefix_<driver sequence>_0.csv
 std::string FileResultWriter::_get_next_file_name() {
     std::stringstream ss;
-    ss << _file_opts->file_path << (_file_idx++) << "." << _file_format_to_name();
+    ss << _file_opts->file_path;
+    if (_driver_sequence >= 0) {
+        ss << _driver_sequence << "_";
+    }
+    ss << (_file_idx++) << "." << _file_format_to_name();
     return ss.str();
 }
 
@@ -114,17 +138,36 @@ Status FileResultWriter::append_row_batch(const RowBatch* batch) {
 
     SCOPED_TIMER(_append_row_batch_timer);
     if (_parquet_writer != nullptr) {
-        RETURN_IF_ERROR(_parquet_writer->write(*batch));
-    } else {
-        RETURN_IF_ERROR(_write_csv_file(*batch));
+        return Status::NotSupported("parquet files are only written by the vectorized engine");
     }
+    RETURN_IF_ERROR(_write_csv_file(*batch));
 
     _written_rows += batch->num_rows();
     return Status::OK();
 }
 
 Status FileResultWriter::append_chunk(vectorized::Chunk* chunk) {
-    return Status::OK();
+    if (_parquet_writer == nullptr || chunk->num_rows() == 0) {
+        return Status::OK();
+    }
+
+    SCOPED_TIMER(_append_row_batch_timer);
+    const size_t num_rows = chunk->num_rows();
+    vectorized::Columns columns;
+    {
+        SCOPED_TIMER(_convert_tuple_timer);
+        for (auto* ctx : _output_expr_ctxs) {
+            columns.emplace_back(ctx->evaluate(chunk));
+        }
+    }
+    {
+        SCOPED_TIMER(_file_write_timer);
+        RETURN_IF_ERROR(_parquet_writer->write(columns, num_rows));
+    }
+    _written_rows += num_rows;
+    COUNTER_UPDATE(_written_data_bytes, _parquet_writer->written_bytes() - _current_written_bytes);
+    _current_written_bytes = _parquet_writer->written_bytes();
+    return _create_new_file_if_exceed_size();
 }
 
 Status FileResultWriter::_write_csv_file(const RowBatch& batch) {
@@ -285,25 +328,36 @@ Status FileResultWriter::_create_new_file_if_exceed_size() {
     // and create new one
     {
         SCOPED_TIMER(_writer_close_timer);
+        RETURN_IF_ERROR(_close_parquet_writer());
         RETURN_IF_ERROR(_close_file_writer(false));
     }
     _current_written_bytes = 0;
     return Status::OK();
 }
 
+Status FileResultWriter::_close_parquet_writer() {
+    if (_parquet_writer == nullptr) {
+        return Status::OK();
+    }
+    RETURN_IF_ERROR(_parquet_writer->close());
+    COUNTER_UPDATE(_written_data_bytes, _parquet_writer->written_bytes() - _current_written_bytes);
+    _current_written_bytes = _parquet_writer->written_bytes();
+    return Status::OK();
+}
+
 Status FileResultWriter::_close_file_writer(bool done) {
+    Status st;
     if (_parquet_writer != nullptr) {
-        _parquet_writer->close();
-        delete _parquet_writer;
-        _parquet_writer = nullptr;
-        if (!done) {
-            //TODO(cmy): implement parquet writer later
-        }
-    } else if (_file_writer != nullptr) {
+        // write the rows buffered and the footer.
+        st = _parquet_writer->close();
+        _parquet_writer.reset();
+    }
+    if (_file_writer != nullptr) {
         _file_writer->close();
         delete _file_writer;
         _file_writer = nullptr;
     }
+    RETURN_IF_ERROR(st);
 
     if (!done) {
         // not finished, create new file writer for next file
@@ -320,6 +374,7 @@ Status FileResultWriter::close() {
     // so does the profile in RuntimeState.
     COUNTER_SET(_written_rows_counter, _written_rows);
     SCOPED_TIMER(_writer_close_timer);
+    RETURN_IF_ERROR(_close_parquet_writer());
     RETURN_IF_ERROR(_close_file_writer(true));
     return Status::OK();
 }
@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include "gen_cpp/DataSinks_types.h"
 #include "runtime/result_writer.h"
 #include "runtime/runtime_state.h"
@@ -29,11 +31,14 @@ namespace starrocks {
 
 class ExprContext;
 class FileWriter;
-class ParquetWriterWrapper;
 class RowBatch;
 class RuntimeProfile;
 class TupleRow;
 
+namespace parquet {
+class FileWriter;
+} // namespace parquet
+
 struct ResultFileOptions {
     bool is_local_file;
     std::string file_path;
@@ -65,8 +70,10 @@ struct ResultFileOptions {
 // write result to file
 class FileResultWriter final : public ResultWriter {
 public:
+    // The files are named by the driver sequence too if it's not negative, when the drivers of a pipeline write
+    // their own files in parallel.
     FileResultWriter(const ResultFileOptions* file_option, const std::vector<ExprContext*>& output_expr_ctxs,
-                     RuntimeProfile* parent_profile);
+                     RuntimeProfile* parent_profile, int32_t driver_sequence = -1);
     ~FileResultWriter() override;
 
     Status init(RuntimeState* state) override;
@@ -87,6 +94,8 @@ private:
     // get next export file name
     std::string _get_next_file_name();
     std::string _file_format_to_name();
+    // write the footer of the parquet file, and update the bytes written.
+    Status _close_parquet_writer();
     // close file writer, and if !done, it will create new writer for next file
     Status _close_file_writer(bool done);
     // create a new file if current file size exceed limit
@@ -96,11 +105,12 @@ private:
     const ResultFileOptions* _file_opts;
     const std::vector<ExprContext*>& _output_expr_ctxs;
 
-    // If the result file format is plain text, like CSV, this _file_writer is owned by this FileResultWriter.
-    // If the result file format is Parquet, this _file_writer is owned by _parquet_writer.
+    const int32_t _driver_sequence;
+
+    // owned by this FileResultWriter.
     FileWriter* _file_writer = nullptr;
-    // parquet file writer
-    ParquetWriterWrapper* _parquet_writer = nullptr;
+    // encodes the chunks into _file_writer if the result file format is Parquet.
+    std::unique_ptr<parquet::FileWriter> _parquet_writer;
     // Used to buffer the export data of plain text
     // TODO(cmy): I simply use a stringstrteam to buffer the data, to avoid calling
     // file writer's write() for every single row.
@@ -30,6 +30,7 @@
 
 #include "common/object_pool.h"
 #include "common/resource_tls.h"
+#include "exec/pipeline/fragment_executor.h"
 #include "gen_cpp/DataSinks_types.h"
 #include "gen_cpp/FrontendService.h"
 #include "gen_cpp/HeartbeatService.h"
@@ -187,6 +188,7 @@ Status FragmentExecState::execute() {
     }
     StarRocksMetrics::instance()->fragment_requests_total.increment(1);
     StarRocksMetrics::instance()->fragment_request_duration_us.increment(duration_ns / 1000);
+    StarRocksMetrics::instance()->fragment_request_latency_us.record(duration_ns / 1000);
     return Status::OK();
 }
 
@@ -641,6 +643,13 @@ Status FragmentMgr::exec_external_plan_fragment(const TScanOpenParams& params, c
     exec_fragment_params.__set_query_options(query_options);
     VLOG_ROW << "external exec_plan_fragment params is "
              << apache::thrift::ThriftDebugString(exec_fragment_params).c_str();
+    if (config::enable_pipeline_external_scan) {
+        exec_fragment_params.__set_is_pipeline(true);
+        exec_fragment_params.params.__set_instances_number(1);
+        auto fragment_executor = std::make_unique<pipeline::FragmentExecutor>();
+        RETURN_IF_ERROR(fragment_executor->prepare(_exec_env, exec_fragment_params));
+        return fragment_executor->execute(_exec_env);
+    }
     return exec_plan_fragment(exec_fragment_params);
 }
 
@@ -98,9 +98,36 @@ struct DictDecoder {
     using ResultColumnType = RunTimeColumnType<result_primitive_type>;
     using ColumnType = RunTimeColumnType<primitive_type>;
     Dict dict;
+
+    // Set the dict and build the dense code -> value table of it if all the codes are in
+    // [0, DICT_DECODE_MAX_SIZE], so that a code is decoded by an array access instead of a hash lookup.
+    void set_dict(const Dict& d) {
+        dict = d;
+        _dense_values.clear();
+        _dense_valid.clear();
+        if constexpr (std::is_integral_v<FieldType> && pt_is_binary<result_primitive_type>) {
+            for (const auto& [key, value] : dict) {
+                if (key < 0 || key > DICT_DECODE_MAX_SIZE) {
+                    return;
+                }
+            }
+            _dense_values.resize(DICT_DECODE_MAX_SIZE + 1);
+            _dense_valid.resize(DICT_DECODE_MAX_SIZE + 1, 0);
+            for (const auto& [key, value] : dict) {
+                _dense_values[key] = value;
+                _dense_valid[key] = 1;
+            }
+        }
+    }
+
     Status decode(vectorized::Column* in, vectorized::Column* out) {
         DCHECK(in != nullptr);
         DCHECK(out != nullptr);
+        if constexpr (std::is_integral_v<FieldType> && pt_is_binary<result_primitive_type>) {
+            if (!_dense_values.empty()) {
+                return _decode_dense(in, out);
+            }
+        }
         if (!in->is_nullable()) {
             auto res_column = down_cast<ResultColumnType*>(out);
             auto column = down_cast<ColumnType*>(in);
@@ -140,6 +167,46 @@ struct DictDecoder {
         }
         return Status::OK();
     }
+
+private:
+    Status _decode_dense(vectorized::Column* in, vectorized::Column* out) {
+        const NullData* nulls = nullptr;
+        ResultColumnType* res_data_column = nullptr;
+        ColumnType* data_column = nullptr;
+        if (in->is_nullable()) {
+            auto column = down_cast<NullableColumn*>(in);
+            auto res_column = down_cast<NullableColumn*>(out);
+            res_column->null_column_data() = column->null_column_data();
+            res_column->update_has_null();
+            nulls = &column->null_column_data();
+            data_column = down_cast<ColumnType*>(column->data_column().get());
+            res_data_column = down_cast<ResultColumnType*>(res_column->data_column().get());
+        } else {
+            data_column = down_cast<ColumnType*>(in);
+            res_data_column = down_cast<ResultColumnType*>(out);
+        }
+
+        const auto& codes = data_column->get_data();
+        size_t size = in->size();
+        // the values of null rows are empty.
+        std::vector<Slice> values(size);
+        for (size_t i = 0; i < size; i++) {
+            if (nulls != nullptr && (*nulls)[i] != 0) {
+                continue;
+            }
+            FieldType key = codes[i];
+            if (UNLIKELY(key < 0 || key > DICT_DECODE_MAX_SIZE || _dense_valid[key] == 0)) {
+                return Status::InternalError(fmt::format("Dict Decode failed, Dict can't take cover all key :{}", key));
+            }
+            values[i] = _dense_values[key];
+        }
+        res_data_column->append_strings(values);
+        return Status::OK();
+    }
+
+    // code -> value, and whether the code is in the dict.
+    std::vector<Slice> _dense_values;
+    std::vector<uint8_t> _dense_valid;
 };
 
 using DefaultDecoder = DictDecoder<TYPE_INT, RGlobalDictMap, TYPE_VARCHAR>;
@@ -24,6 +24,7 @@
 #include "runtime/mem_tracker.h"
 #include "runtime/tablets_channel.h"
 #include "storage/lru_cache.h"
+#include "util/runtime_profile.h"
 
 namespace starrocks {
 
@@ -110,8 +111,7 @@ Status LoadChannel::add_batch(const PTabletWriterAddBatchRequest& request,
     return st;
 }
 
-Status LoadChannel::add_chunk(const PTabletWriterAddChunkRequest& request,
-                              google::protobuf::RepeatedPtrField<PTabletInfo>* tablet_vec) {
+Status LoadChannel::add_chunk(const PTabletWriterAddChunkRequest& request, PTabletWriterAddBatchResult* response) {
     int64_t index_id = request.index_id();
     // 1. get tablets channel
     std::shared_ptr<TabletsChannel> channel;
@@ -131,19 +131,32 @@ Status LoadChannel::add_chunk(const PTabletWriterAddChunkRequest& request,
     }
 
     // 2. check if mem consumption exceed limit
-    _handle_mem_exceed_limit();
+    int64_t reduce_mem_ns = 0;
+    {
+        SCOPED_RAW_TIMER(&reduce_mem_ns);
+        _handle_mem_exceed_limit();
+    }
+    response->set_reduce_mem_time_us(response->reduce_mem_time_us() + reduce_mem_ns / 1000);
 
     // 3. add batch to tablets channel
     if (request.has_chunk()) {
-        RETURN_IF_ERROR(channel->add_chunk(request));
+        RETURN_IF_ERROR(channel->add_chunk(request, response));
     }
 
     // 4. handle eos
     Status st;
     if (request.has_eos() && request.eos()) {
         bool finished = false;
-        RETURN_IF_ERROR(channel->close(request.sender_id(), &finished, request.partition_ids(), tablet_vec));
+        int64_t close_wait_ns = 0;
+        {
+            SCOPED_RAW_TIMER(&close_wait_ns);
+            RETURN_IF_ERROR(channel->close(request.sender_id(), &finished, request.partition_ids(),
+                                           response->mutable_tablet_vec()));
+        }
+        response->set_close_wait_time_us(close_wait_ns / 1000);
         if (finished) {
+            response->set_flush_time_us(channel->flush_stats().flush_time_ns / 1000);
+            response->set_flush_count(channel->flush_stats().flush_count);
             std::lock_guard<std::mutex> l(_lock);
             _tablets_channels.erase(index_id);
             _finished_channel_ids.emplace(index_id);
@@ -195,12 +208,16 @@ void LoadChannel::_handle_mem_exceed_limit() {
               << ", current mem consumption=" << _mem_tracker->consumption() << ", limit=" << _mem_tracker->limit();
 }
 
-void LoadChannel::reduce_mem_usage_async(const std::set<int64_t>& flush_tablet_ids,
-                                         std::shared_ptr<TabletsChannel>* tablets_channel, int64_t* tablet_id,
-                                         int64_t* tablet_mem_consumption) {
-    // lock so that only one thread can check mem limit
+void LoadChannel::get_flush_candidates(std::vector<FlushCandidate>* candidates) {
+    std::vector<MemTableStat> stats;
     std::lock_guard<std::mutex> l(_lock);
-    _reduce_mem_usage_async_internal(flush_tablet_ids, tablets_channel, tablet_id, tablet_mem_consumption);
+    for (auto& it : _tablets_channels) {
+        stats.clear();
+        it.second->get_memtable_stats(&stats);
+        for (const MemTableStat& stat : stats) {
+            candidates->push_back(FlushCandidate{this, it.second, stat});
+        }
+    }
 }
 
 void LoadChannel::_reduce_mem_usage_async_internal(const std::set<int64_t>& flush_tablet_ids,
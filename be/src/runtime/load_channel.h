@@ -25,12 +25,14 @@
 #include <ostream>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "common/status.h"
 #include "gen_cpp/InternalService_types.h"
 #include "gen_cpp/Types_types.h"
 #include "gen_cpp/internal_service.pb.h"
 #include "runtime/mem_tracker.h"
+#include "runtime/tablets_channel.h"
 #include "util/uid_util.h"
 
 namespace starrocks {
@@ -48,6 +50,13 @@ struct FlushTablet {
             : load_channel(load_channel), tablets_channel(tablets_channel), tablet_id(tablet_id) {}
 };
 
+// A memtable collected across all the loads, which may be flushed when the total load memory exceeds limit.
+struct FlushCandidate {
+    LoadChannel* load_channel;
+    std::shared_ptr<TabletsChannel> tablets_channel;
+    MemTableStat stat;
+};
+
 // A LoadChannel manages tablets channels for all indexes
 // corresponding to a certain load job
 class LoadChannel {
@@ -62,8 +71,8 @@ public:
     Status add_batch(const PTabletWriterAddBatchRequest& request,
                      google::protobuf::RepeatedPtrField<PTabletInfo>* tablet_vec);
 
-    Status add_chunk(const PTabletWriterAddChunkRequest& request,
-                     google::protobuf::RepeatedPtrField<PTabletInfo>* tablet_vec);
+    // the tablets closed and the time spent on the phases of the request are set in |response|.
+    Status add_chunk(const PTabletWriterAddChunkRequest& request, PTabletWriterAddBatchResult* response);
 
     // return true if this load channel has been opened and all tablets channels are closed then.
     bool is_finished();
@@ -74,10 +83,8 @@ public:
 
     const UniqueId& load_id() const { return _load_id; }
 
-    // reduce memory with lock, for handle mem exceed limit in load channel mgr.
-    void reduce_mem_usage_async(const std::set<int64_t>& flush_tablet_ids,
-                                std::shared_ptr<TabletsChannel>* tablets_channel, int64_t* tablet_id,
-                                int64_t* tablet_mem_consumption);
+    // appends the memtables of all the tablets channels with lock, for handle mem exceed limit in load channel mgr.
+    void get_flush_candidates(std::vector<FlushCandidate>* candidates);
 
     int64_t mem_consumption() const { return _mem_tracker->consumption(); }
     bool mem_limit_exceeded() const { return _mem_tracker->limit_exceeded(); }
@@ -21,6 +21,7 @@
 
 #include "runtime/load_channel_mgr.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "gutil/strings/substitute.h"
@@ -29,6 +30,7 @@
 #include "runtime/mem_tracker.h"
 #include "service/backend_options.h"
 #include "storage/lru_cache.h"
+#include "util/runtime_profile.h"
 #include "util/starrocks_metrics.h"
 #include "util/stopwatch.hpp"
 
@@ -149,8 +151,7 @@ Status LoadChannelMgr::add_batch(const PTabletWriterAddBatchRequest& request,
     return Status::OK();
 }
 
-Status LoadChannelMgr::add_chunk(const PTabletWriterAddChunkRequest& request,
-                                 google::protobuf::RepeatedPtrField<PTabletInfo>* tablet_vec,
+Status LoadChannelMgr::add_chunk(const PTabletWriterAddChunkRequest& request, PTabletWriterAddBatchResult* response,
                                  int64_t* wait_lock_time_ns) {
     UniqueId load_id(request.id());
     // 1. get load channel
@@ -174,12 +175,17 @@ Status LoadChannelMgr::add_chunk(const PTabletWriterAddChunkRequest& request,
     }
 
     // 2. check if mem consumption exceed limit
-    _handle_mem_exceed_limit(channel);
+    int64_t reduce_mem_ns = 0;
+    {
+        SCOPED_RAW_TIMER(&reduce_mem_ns);
+        _handle_mem_exceed_limit(channel);
+    }
+    response->set_reduce_mem_time_us(reduce_mem_ns / 1000);
 
     // 3. add batch to load channel
     // batch may not exist in request(eg: eos request without batch),
     // this case will be handled in load channel's add batch method.
-    RETURN_IF_ERROR(channel->add_chunk(request, tablet_vec));
+    RETURN_IF_ERROR(channel->add_chunk(request, response));
 
     // 4. handle finish
     if (channel->is_finished()) {
@@ -208,34 +214,33 @@ void LoadChannelMgr::_handle_mem_exceed_limit(const std::shared_ptr<LoadChannel>
 
     // TODO: ancestors exceeded?
     int64_t exceeded_mem = _mem_tracker->consumption() - _mem_tracker->limit();
+    std::vector<FlushCandidate> candidates;
+    for (auto& kv : _load_channels) {
+        kv.second->get_flush_candidates(&candidates);
+    }
+    _rank_flush_candidates(&candidates);
+
+    int64_t num_flushed = 0;
+    auto flush = [&num_flushed](const FlushCandidate& candidate) {
+        RETURN_IF_ERROR(candidate.tablets_channel->flush_memtable_async(candidate.stat.tablet_id));
+        ++num_flushed;
+        return Status::OK();
+    };
     std::vector<FlushTablet> flush_tablets;
-    std::set<int64_t> flush_tablet_ids;
-    int64_t tablet_mem_consumption;
-    do {
-        std::shared_ptr<LoadChannel> load_channel;
-        std::shared_ptr<TabletsChannel> tablets_channel;
-        int64_t tablet_id = -1;
-        if (!_find_candidate_load_channel(data_channel, &load_channel)) {
-            // should not happen, add log to observe
-            LOG(WARNING) << "Fail to find suitable load channel when total load mem limit exceed";
-            break;
-        }
-        DCHECK(load_channel.get() != nullptr);
-
-        // reduce mem usage of the selected load channel
-        load_channel->reduce_mem_usage_async(flush_tablet_ids, &tablets_channel, &tablet_id, &tablet_mem_consumption);
-        if (tablet_id != -1) {
-            flush_tablets.emplace_back(load_channel.get(), tablets_channel.get(), tablet_id);
-            flush_tablet_ids.insert(tablet_id);
-            exceeded_mem -= tablet_mem_consumption;
-            VLOG(3) << "Flush " << *load_channel << ", tablet id=" << tablet_id
-                    << ", mem consumption=" << tablet_mem_consumption;
-        } else {
-            break;
-        }
-    } while (exceeded_mem > 0);
+    for (const FlushCandidate* candidate : _pick_flush_candidates(candidates, exceeded_mem, flush)) {
+        flush_tablets.emplace_back(candidate->load_channel, candidate->tablets_channel.get(),
+                                   candidate->stat.tablet_id);
+        VLOG(3) << "Flush " << *candidate->load_channel << ", tablet id=" << candidate->stat.tablet_id
+                << ", mem consumption=" << candidate->stat.mem_consumption << ", age=" << candidate->stat.age_ms
+                << "ms, flushing=" << candidate->stat.flushing;
+    }
+    if (flush_tablets.empty()) {
+        // should not happen, add log to observe
+        LOG(WARNING) << "Fail to find suitable memtable when total load mem limit exceed";
+        return;
+    }
 
-    // wait flush finish
+    // wait flush finish, |candidates| holds the tablets channels until then.
     for (const FlushTablet& flush_tablet : flush_tablets) {
         Status st = flush_tablet.tablets_channel->wait_mem_usage_reduced(flush_tablet.tablet_id);
         if (!st.ok()) {
@@ -244,45 +249,70 @@ void LoadChannelMgr::_handle_mem_exceed_limit(const std::shared_ptr<LoadChannel>
             LOG(WARNING) << "Fail to wait memory reduced. err=" << st.to_string();
         }
     }
-    LOG(INFO) << "Reduce memory finish. flush tablets num=" << flush_tablet_ids.size()
+    LOG(INFO) << "Reduce memory finish. flush tablets num=" << num_flushed
+              << ", wait tablets num=" << flush_tablets.size() - num_flushed
               << ", current mem consumption=" << _mem_tracker->consumption() << ", limit=" << _mem_tracker->limit();
 }
 
-bool LoadChannelMgr::_find_candidate_load_channel(const std::shared_ptr<LoadChannel>& data_channel,
-                                                  std::shared_ptr<LoadChannel>* candidate_channel) {
-    // 1. select the load channel that consume this batch data if limit exceeded.
-    if (data_channel->mem_limit_exceeded()) {
-        *candidate_channel = data_channel;
-        return true;
-    }
-
-    int64_t max_consume = 0;
-    int64_t max_exceeded_consume = 0;
-    std::shared_ptr<LoadChannel> max_channel;
-    std::shared_ptr<LoadChannel> max_exceeded_channel;
-    for (auto& kv : _load_channels) {
-        if (kv.second->mem_consumption() > max_consume) {
-            max_consume = kv.second->mem_consumption();
-            max_channel = kv.second;
+void LoadChannelMgr::_rank_flush_candidates(std::vector<FlushCandidate>* candidates) {
+    const int64_t min_flush_size = config::load_min_flush_memtable_size;
+    auto tier = [&](const FlushCandidate& c) {
+        if (c.stat.flushing) {
+            return 0;
         }
-
-        if (kv.second->mem_limit_exceeded() && kv.second->mem_consumption() > max_exceeded_consume) {
-            max_exceeded_consume = kv.second->mem_consumption();
-            max_exceeded_channel = kv.second;
+        if (c.stat.mem_consumption < min_flush_size) {
+            return 3;
         }
+        return c.load_channel->mem_limit_exceeded() ? 1 : 2;
+    };
+    // score the large memtables by size weighted by age, so that a memtable not growing for a while
+    // is flushed before a slightly larger one that is still being written, to not stall any single load.
+    auto score = [](const FlushCandidate& c) {
+        return static_cast<double>(c.stat.mem_consumption) * (1.0 + c.stat.age_ms / 60000.0);
+    };
+    std::vector<std::pair<int, double>> keys;
+    keys.reserve(candidates->size());
+    for (const FlushCandidate& c : *candidates) {
+        int t = tier(c);
+        keys.emplace_back(t, t == 1 || t == 2 ? score(c) : static_cast<double>(c.stat.mem_consumption));
     }
-
-    // 2. select the largest limit exceeded load channel.
-    if (max_exceeded_consume > 0) {
-        *candidate_channel = max_exceeded_channel;
-        return true;
+    std::vector<size_t> order(candidates->size());
+    for (size_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        if (keys[a].first != keys[b].first) {
+            return keys[a].first < keys[b].first;
+        }
+        return keys[a].second > keys[b].second;
+    });
+    std::vector<FlushCandidate> ranked;
+    ranked.reserve(candidates->size());
+    for (size_t i : order) {
+        ranked.push_back(std::move((*candidates)[i]));
     }
-    // 3. select the largest consumption load channel.
-    if (max_consume > 0) {
-        *candidate_channel = max_channel;
-        return true;
+    candidates->swap(ranked);
+}
+
+std::vector<const FlushCandidate*> LoadChannelMgr::_pick_flush_candidates(
+        const std::vector<FlushCandidate>& candidates, int64_t exceeded_mem,
+        const std::function<Status(const FlushCandidate&)>& flush) {
+    std::vector<const FlushCandidate*> picked;
+    for (const FlushCandidate& candidate : candidates) {
+        if (exceeded_mem <= 0) {
+            break;
+        }
+        if (!candidate.stat.flushing) {
+            Status st = flush(candidate);
+            if (!st.ok()) {
+                LOG(WARNING) << "Fail to reduce memory async. error=" << st.to_string();
+                continue;
+            }
+        }
+        picked.push_back(&candidate);
+        exceeded_mem -= candidate.stat.mem_consumption;
     }
-    return false;
+    return picked;
 }
 
 Status LoadChannelMgr::cancel(const PTabletWriterCancelRequest& params) {
@@ -22,10 +22,12 @@
 #pragma once
 
 #include <ctime>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <thread>
 #include <unordered_map>
+#include <vector>
 
 #include "common/status.h"
 #include "gen_cpp/InternalService_types.h"
@@ -38,6 +40,7 @@ namespace starrocks {
 
 class Cache;
 class LoadChannel;
+struct FlushCandidate;
 
 // LoadChannelMgr -> LoadChannel -> TabletsChannel -> DeltaWriter
 // All dispatched load data for this backend is routed from this class
@@ -54,23 +57,29 @@ public:
     Status add_batch(const PTabletWriterAddBatchRequest& request,
                      google::protobuf::RepeatedPtrField<PTabletInfo>* tablet_vec, int64_t* wait_lock_time_ns);
 
-    Status add_chunk(const PTabletWriterAddChunkRequest& request,
-                     google::protobuf::RepeatedPtrField<PTabletInfo>* tablet_vec, int64_t* wait_lock_time_ns);
+    Status add_chunk(const PTabletWriterAddChunkRequest& request, PTabletWriterAddBatchResult* response,
+                     int64_t* wait_lock_time_ns);
 
     // cancel all tablet stream for 'load_id' load
     Status cancel(const PTabletWriterCancelRequest& request);
 
 private:
     // check if the total load mem consumption exceeds limit.
-    // If yes, it will pick several load channels to try to reduce memory consumption to limit.
+    // If yes, it will pick the memtables of all the loads to flush to reduce memory consumption to limit.
     void _handle_mem_exceed_limit(const std::shared_ptr<LoadChannel>& data_channel);
 
-    // find a load channel to reduce memory consumption
-    // 1. select the load channel that consume this batch data if limit exceeded.
-    // 2. select the largest limit exceeded load channel.
-    // 3. select the largest consumption load channel.
-    bool _find_candidate_load_channel(const std::shared_ptr<LoadChannel>& data_channel,
-                                      std::shared_ptr<LoadChannel>* candidate_channel);
+    // rank the memtables of all the loads to flush, the earlier the better:
+    // 1. the memtables already in flush queue, waiting for them frees memory without a new segment.
+    // 2. the memtables not smaller than load_min_flush_memtable_size, of the load channels exceeding
+    //    their own limit first, then the larger and older ones.
+    // 3. the smaller memtables, the larger first.
+    static void _rank_flush_candidates(std::vector<FlushCandidate>* candidates);
+
+    // pick the ranked |candidates| in order until they free |exceeded_mem|, the memtables not in flush queue
+    // are submitted by |flush|, and the ones failed to submit are skipped.
+    static std::vector<const FlushCandidate*> _pick_flush_candidates(
+            const std::vector<FlushCandidate>& candidates, int64_t exceeded_mem,
+            const std::function<Status(const FlushCandidate&)>& flush);
 
     Status _start_bg_worker();
 
@@ -63,6 +63,27 @@ void MemPool::clear() {
     DCHECK(check_integrity(false));
 }
 
+void MemPool::clear_and_retain(int64_t max_retained_bytes) {
+    std::sort(chunks_.begin(), chunks_.end(),
+              [](const ChunkInfo& lhs, const ChunkInfo& rhs) { return lhs.chunk.size > rhs.chunk.size; });
+    int64_t retained_bytes = 0;
+    int64_t total_bytes_released = 0;
+    size_t num_retained = 0;
+    for (auto& chunk : chunks_) {
+        if (retained_bytes + static_cast<int64_t>(chunk.chunk.size) <= max_retained_bytes) {
+            retained_bytes += chunk.chunk.size;
+            chunks_[num_retained++] = chunk;
+        } else {
+            total_bytes_released += chunk.chunk.size;
+            ChunkAllocator::instance()->free(chunk.chunk);
+        }
+    }
+    chunks_.resize(num_retained);
+    total_reserved_bytes_ = retained_bytes;
+    StarRocksMetrics::instance()->memory_pool_bytes_total.increment(-total_bytes_released);
+    clear();
+}
+
 void MemPool::free_all() {
     int64_t total_bytes_released = 0;
     for (auto& chunk : chunks_) {
@@ -140,6 +140,11 @@ public:
     /// Makes all allocated chunks available for re-use, but doesn't delete any chunks.
     void clear();
 
+    /// Makes the largest chunks up to 'max_retained_bytes' available for re-use and deletes
+    /// the others. Unlike free_all(), the size of the new chunks keeps growing from where it
+    /// was, so a pool refilled to a similar size doesn't go through the small chunks again.
+    void clear_and_retain(int64_t max_retained_bytes);
+
     /// Deletes all allocated chunks. free_all() or acquire_data() must be called for
     /// each mem pool
     void free_all();
@@ -41,6 +41,7 @@ ChunkAllocator* ChunkAllocator::_s_instance = nullptr;
 
 static IntCounter local_core_alloc_count(MetricUnit::NOUNIT);
 static IntCounter other_core_alloc_count(MetricUnit::NOUNIT);
+static IntCounter remote_numa_node_alloc_count(MetricUnit::NOUNIT);
 static IntCounter system_alloc_count(MetricUnit::NOUNIT);
 static IntCounter system_free_count(MetricUnit::NOUNIT);
 static IntCounter system_alloc_cost_ns(MetricUnit::NANOSECONDS);
@@ -115,6 +116,7 @@ void ChunkAllocator::init_instance(size_t reserve_limit) {
 
     REGISTER_METIRC(local_core_alloc_count);
     REGISTER_METIRC(other_core_alloc_count);
+    REGISTER_METIRC(remote_numa_node_alloc_count);
     REGISTER_METIRC(system_alloc_count);
     REGISTER_METIRC(system_free_count);
     REGISTER_METIRC(system_alloc_cost_ns);
@@ -139,15 +141,20 @@ bool ChunkAllocator::allocate(size_t size, Chunk* chunk) {
         local_core_alloc_count.increment(1);
         return true;
     }
+    const int numa_node = CpuInfo::get_numa_node_of_core(core_id);
     if (_reserved_bytes > size) {
-        // try to allocate from other core's arena
-        ++core_id;
-        for (int i = 1; i < _arenas.size(); ++i, ++core_id) {
-            if (_arenas[core_id % _arenas.size()]->pop_free_chunk(size, &chunk->data)) {
-                _reserved_bytes.fetch_sub(size);
-                other_core_alloc_count.increment(1);
-                // reset chunk's core_id to other
-                chunk->core_id = core_id % _arenas.size();
+        // try to allocate from the arenas of the other cores, the ones in the same numa node first,
+        // because their chunks were placed in the memory local to this core.
+        for (int other_core : CpuInfo::get_cores_of_numa_node(numa_node)) {
+            if (other_core != core_id && _allocate_from_other_core(other_core, size, chunk)) {
+                return true;
+            }
+        }
+        for (int i = 1; i < _arenas.size(); ++i) {
+            int other_core = (core_id + i) % _arenas.size();
+            if (CpuInfo::get_numa_node_of_core(other_core) != numa_node &&
+                _allocate_from_other_core(other_core, size, chunk)) {
+                remote_numa_node_alloc_count.increment(1);
                 return true;
             }
         }
@@ -157,7 +164,7 @@ bool ChunkAllocator::allocate(size_t size, Chunk* chunk) {
     {
         SCOPED_RAW_TIMER(&cost_ns);
         // allocate from system allocator
-        chunk->data = SystemAllocator::allocate(size);
+        chunk->data = SystemAllocator::allocate(size, numa_node);
     }
     system_alloc_count.increment(1);
     system_alloc_cost_ns.increment(cost_ns);
@@ -167,6 +174,17 @@ bool ChunkAllocator::allocate(size_t size, Chunk* chunk) {
     return true;
 }
 
+bool ChunkAllocator::_allocate_from_other_core(int other_core, size_t size, Chunk* chunk) {
+    if (!_arenas[other_core]->pop_free_chunk(size, &chunk->data)) {
+        return false;
+    }
+    _reserved_bytes.fetch_sub(size);
+    other_core_alloc_count.increment(1);
+    // reset chunk's core_id to other
+    chunk->core_id = other_core;
+    return true;
+}
+
 void ChunkAllocator::free(const Chunk& chunk) {
     int64_t old_reserved_bytes = _reserved_bytes;
     int64_t new_reserved_bytes = 0;
@@ -39,7 +39,9 @@ class ChunkArena;
 // ChunkAllocator has one ChunkArena for each CPU core, it will try to allocate
 // memory from current core arena firstly. In this way, there will be no lock contention
 // between concurrently-running threads. If this fails, ChunkAllocator will try to allocate
-// memroy from other core's arena.
+// memroy from the arenas of the other cores in the same NUMA node, and then from the ones
+// of the other NUMA nodes. The chunks allocated from system are placed on the NUMA node of
+// the current core when they are mmap-ed.
 //
 // Memory Reservation
 // ChunkAllocator has a limit about how much free chunk bytes it can reserve, above which
@@ -72,6 +74,8 @@ public:
     void free(const Chunk& chunk);
 
 private:
+    bool _allocate_from_other_core(int other_core, size_t size, Chunk* chunk);
+
     static ChunkAllocator* _s_instance;
 
     size_t _reserve_bytes_limit;
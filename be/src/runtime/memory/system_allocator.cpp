@@ -21,21 +21,25 @@
 
 #include "runtime/memory/system_allocator.h"
 
+#include <linux/mempolicy.h>
 #include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 
 #include <cstdlib>
 #include <cstring>
 
 #include "common/config.h"
 #include "common/logging.h"
+#include "util/cpu_info.h"
 
 namespace starrocks {
 
 #define PAGE_SIZE (4 * 1024) // 4K
 
-uint8_t* SystemAllocator::allocate(size_t length) {
+uint8_t* SystemAllocator::allocate(size_t length, int numa_node) {
     if (config::use_mmap_allocate_chunk) {
-        return allocate_via_mmap(length);
+        return allocate_via_mmap(length, numa_node);
     } else {
         return allocate_via_malloc(length);
     }
@@ -54,22 +58,48 @@ void SystemAllocator::free(uint8_t* ptr, size_t length) {
 
 uint8_t* SystemAllocator::allocate_via_malloc(size_t length) {
     void* ptr = nullptr;
-    // try to use a whole page instead of parts of one page
-    int res = posix_memalign(&ptr, PAGE_SIZE, length);
+    // try to use a whole page instead of parts of one page, and whole huge pages for large chunks
+    bool huge = config::madvise_huge_pages && length >= HUGE_PAGE_SIZE;
+    int res = posix_memalign(&ptr, huge ? HUGE_PAGE_SIZE : PAGE_SIZE, length);
     if (res != 0) {
         PLOG(ERROR) << "fail to allocate mem via posix_memalign, res=" << res;
         return nullptr;
     }
+    if (huge && length % HUGE_PAGE_SIZE == 0) {
+        // The memory doesn't share any huge page with other allocations.
+        madvise(ptr, length, MADV_HUGEPAGE);
+    }
     return (uint8_t*)ptr;
 }
 
-uint8_t* SystemAllocator::allocate_via_mmap(size_t length) {
-    auto ptr = (uint8_t*)mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+uint8_t* SystemAllocator::allocate_via_mmap(size_t length, int numa_node) {
+    void* ptr = MAP_FAILED;
+    if (config::mmap_huge_tlb_chunk && length % HUGE_PAGE_SIZE == 0) {
+        // Fall back to normal pages if there are no free huge pages reserved.
+        ptr = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE | MAP_HUGETLB, -1, 0);
+    }
     if (ptr == MAP_FAILED) {
-        PLOG(ERROR) << "fail to allocate memory via mmap";
-        return nullptr;
+        ptr = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+        if (ptr == MAP_FAILED) {
+            PLOG(ERROR) << "fail to allocate memory via mmap";
+            return nullptr;
+        }
+        if (config::madvise_huge_pages && length >= HUGE_PAGE_SIZE) {
+            madvise(ptr, length, MADV_HUGEPAGE);
+        }
+    }
+    if (numa_node >= 0 && CpuInfo::get_max_num_numa_nodes() > 1) {
+        // No page is touched yet, so all of them follow the policy. It's only a preference, the
+        // kernel still falls back to the other nodes when the node is out of memory.
+        unsigned long nodemask[64 / sizeof(unsigned long)] = {};
+        if (numa_node < (int)(sizeof(nodemask) * 8)) {
+            nodemask[numa_node / (sizeof(unsigned long) * 8)] |= 1UL << (numa_node % (sizeof(unsigned long) * 8));
+            if (syscall(SYS_mbind, ptr, length, MPOL_PREFERRED, nodemask, sizeof(nodemask) * 8, 0) != 0) {
+                PLOG_EVERY_N(WARNING, 1000) << "fail to bind memory to numa node " << numa_node;
+            }
+        }
     }
-    return ptr;
+    return (uint8_t*)ptr;
 }
 
 } // namespace starrocks
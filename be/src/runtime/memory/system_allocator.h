@@ -28,14 +28,22 @@ namespace starrocks {
 
 // Allocate memory from system allocator, this allocator can be configured
 // to allocate memory via mmap or malloc.
+//
+// Allocations of at least HUGE_PAGE_SIZE bytes are backed by transparent huge pages
+// when config::madvise_huge_pages is set, or by explicit huge pages when
+// config::mmap_huge_tlb_chunk is set and they are available.
 class SystemAllocator {
 public:
-    static uint8_t* allocate(size_t length);
+    static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024; // 2M
+
+    // If |numa_node| is not negative, the pages of mmap-ed memory are preferably
+    // placed on that NUMA node.
+    static uint8_t* allocate(size_t length, int numa_node = -1);
 
     static void free(uint8_t* ptr, size_t length);
 
 private:
-    static uint8_t* allocate_via_mmap(size_t length);
+    static uint8_t* allocate_via_mmap(size_t length, int numa_node);
     static uint8_t* allocate_via_malloc(size_t length);
 };
 
@@ -71,6 +71,10 @@ public:
 
     RuntimeProfile* profile() override { return _profile; }
 
+    const RowDescriptor& get_row_desc() const { return _row_desc; }
+
+    const std::vector<TExpr>& get_output_exprs() const { return _t_output_expr; }
+
 private:
     Status prepare_exprs(RuntimeState* state);
     void convert_to_slot_types_and_ids();
@@ -34,6 +34,7 @@
 #include "runtime/tuple_row.h"
 #include "util/date_func.h"
 #include "util/mysql_row_buffer.h"
+#include "util/raw_container.h"
 #include "util/types.h"
 
 namespace starrocks {
@@ -345,18 +346,52 @@ StatusOr<TFetchDataResultPtr> MysqlResultWriter::process_chunk(vectorized::Chunk
         result_columns.emplace_back(std::move(column));
     }
 
-    // Step 2: convert chunk to mysql row format row by row
+    // Step 2: convert chunk to mysql row format column by column.
+    // The cells of one column are encoded into one buffer back to back, so the type dispatch of each column
+    // is done once per chunk instead of once per row, then the cells of each row are concatenated into
+    // the row with one allocation, since the lengths of all the cells are known by then.
     {
-        _row_buffer->reserve(128);
         SCOPED_TIMER(_convert_tuple_timer);
-        for (int i = 0; i < num_rows; ++i) {
-            DCHECK_EQ(0, _row_buffer->length());
-            for (auto& result_column : result_columns) {
-                result_column->put_mysql_row_buffer(_row_buffer, i);
+        std::vector<std::string> column_buffers(num_columns);
+        // cell_offsets[i * (num_rows + 1) + j] is the offset of the j-th cell in the buffer of the i-th column.
+        std::vector<uint32_t> cell_offsets(num_columns * (num_rows + 1));
+        std::vector<size_t> row_lengths(num_rows, 0);
+        for (int i = 0; i < num_columns; ++i) {
+            const ColumnPtr& column = result_columns[i];
+            uint32_t* offsets = cell_offsets.data() + i * (num_rows + 1);
+            _row_buffer->reset();
+            if (column->is_constant()) {
+                // All the rows share the single encoded cell.
+                column->put_mysql_row_buffer(_row_buffer, 0);
+                for (int j = 0; j < num_rows; ++j) {
+                    row_lengths[j] += _row_buffer->length();
+                }
+            } else {
+                offsets[0] = 0;
+                for (int j = 0; j < num_rows; ++j) {
+                    column->put_mysql_row_buffer(_row_buffer, j);
+                    offsets[j + 1] = _row_buffer->length();
+                    row_lengths[j] += offsets[j + 1] - offsets[j];
+                }
+            }
+            _row_buffer->move_content(&column_buffers[i]);
+        }
+
+        for (int j = 0; j < num_rows; ++j) {
+            std::string& row = result_rows[j];
+            raw::stl_string_resize_uninitialized(&row, row_lengths[j]);
+            char* dst = row.data();
+            for (int i = 0; i < num_columns; ++i) {
+                const uint32_t* offsets = cell_offsets.data() + i * (num_rows + 1);
+                if (result_columns[i]->is_constant()) {
+                    memcpy(dst, column_buffers[i].data(), column_buffers[i].size());
+                    dst += column_buffers[i].size();
+                } else {
+                    size_t cell_length = offsets[j + 1] - offsets[j];
+                    memcpy(dst, column_buffers[i].data() + offsets[j], cell_length);
+                    dst += cell_length;
+                }
             }
-            size_t len = _row_buffer->length();
-            _row_buffer->move_content(&result_rows[i]);
-            _row_buffer->reserve(len * 1.1);
         }
     }
     return result;
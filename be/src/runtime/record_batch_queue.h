@@ -53,6 +53,9 @@ public:
 
     bool blocking_put(const std::shared_ptr<arrow::RecordBatch>& val) { return _queue.blocking_put(val); }
 
+    // Return 1 on success, 0 if the queue is full, and -1 if the queue has been shutdown.
+    int try_put(const std::shared_ptr<arrow::RecordBatch>& val) { return _queue.try_put(val); }
+
     // Shut down the queue. Wakes up all threads waiting on blocking_get or blocking_put.
     void shutdown();
 
@@ -64,6 +64,9 @@ public:
 
     const std::vector<TExpr>& get_output_exprs() const { return _t_output_expr; }
 
+    // nullptr unless the sink type is FILE.
+    const ResultFileOptions* get_file_options() const { return _file_opts.get(); }
+
 private:
     Status prepare_exprs(RuntimeState* state);
     TResultSinkType::type _sink_type;
@@ -26,6 +26,7 @@
 #include <string>
 #include <vector>
 
+#include "common/config.h"
 #include "common/status.h"
 #include "gutil/strings/split.h"
 #include "runtime/small_file_mgr.h"
@@ -160,17 +161,19 @@ Status KafkaDataConsumer::assign_topic_partitions(const std::map<int32_t, int64_
     return Status::OK();
 }
 
-Status KafkaDataConsumer::group_consume(TimedBlockingQueue<RdKafka::Message*>* queue, int64_t max_running_time_ms) {
+Status KafkaDataConsumer::group_consume(TimedBlockingQueue<KafkaMessageBatch>* queue, int64_t max_running_time_ms) {
     _last_visit_time = time(nullptr);
     int64_t left_time = max_running_time_ms;
     LOG(INFO) << "start kafka consumer: " << _id << ", grp: " << _grp_id << ", max running time(ms): " << left_time;
 
+    const size_t max_batch_size = std::max<int32_t>(1, config::routine_load_kafka_consume_batch_size);
     int64_t received_rows = 0;
     int64_t put_rows = 0;
     Status st = Status::OK();
     MonotonicStopWatch consumer_watch;
     MonotonicStopWatch watch;
     watch.start();
+    KafkaMessageBatch batch;
     while (true) {
         {
             std::unique_lock<std::mutex> l(_lock);
@@ -184,25 +187,22 @@ Status KafkaDataConsumer::group_consume(TimedBlockingQueue<RdKafka::Message*>* q
         }
 
         bool done = false;
-        // consume 1 message at a time
+        // consume 1 message at a time, waiting for the first message of a batch only
         consumer_watch.start();
-        std::unique_ptr<RdKafka::Message> msg(_k_consumer->consume(1000 /* timeout, ms */));
+        std::unique_ptr<RdKafka::Message> msg(_k_consumer->consume(batch.empty() ? 1000 /* timeout, ms */ : 0));
         consumer_watch.stop();
-        switch (msg->err()) {
+        const RdKafka::ErrorCode err = msg->err();
+        switch (err) {
         case RdKafka::ERR_NO_ERROR:
-            if (!queue->blocking_put(msg.get())) {
-                // queue is shutdown
-                done = true;
-            } else {
-                ++put_rows;
-                msg.release(); // release the ownership, msg will be deleted after being processed
-            }
+            batch.emplace_back(std::move(msg));
             ++received_rows;
             break;
         case RdKafka::ERR__TIMED_OUT:
             // leave the status as OK, because this may happend
             // if there is no data in kafka.
-            LOG(INFO) << "kafka consume timeout: " << _id;
+            if (batch.empty()) {
+                LOG(INFO) << "kafka consume timeout: " << _id;
+            }
             break;
         case RdKafka::ERR_OFFSET_OUT_OF_RANGE: {
             done = true;
@@ -219,12 +219,31 @@ Status KafkaDataConsumer::group_consume(TimedBlockingQueue<RdKafka::Message*>* q
             break;
         }
 
+        // put the batch once it's full or no more message is available.
+        if (!batch.empty() && (batch.size() >= max_batch_size || err != RdKafka::ERR_NO_ERROR)) {
+            const size_t batch_size = batch.size();
+            if (!queue->blocking_put(std::move(batch))) {
+                // queue is shutdown
+                done = true;
+            } else {
+                put_rows += batch_size;
+            }
+            batch = KafkaMessageBatch();
+        }
+
         left_time = max_running_time_ms - watch.elapsed_time() / 1000 / 1000;
         if (done) {
             break;
         }
     }
 
+    if (!batch.empty()) {
+        const size_t batch_size = batch.size();
+        if (queue->blocking_put(std::move(batch))) {
+            put_rows += batch_size;
+        }
+    }
+
     LOG(INFO) << "kafka consume done: " << _id << ", grp: " << _grp_id << ". cancelled: " << _cancelled
               << ", left time(ms): " << left_time << ", total cost(ms): " << watch.elapsed_time() / 1000 / 1000
               << ", consume cost(ms): " << consumer_watch.elapsed_time() / 1000 / 1000
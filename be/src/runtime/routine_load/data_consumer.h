@@ -22,8 +22,10 @@
 #pragma once
 
 #include <ctime>
+#include <memory>
 #include <mutex>
 #include <unordered_map>
+#include <vector>
 
 #include "librdkafka/rdkafkacpp.h"
 #include "runtime/stream_load/stream_load_context.h"
@@ -36,6 +38,9 @@ class KafkaConsumerPipe;
 class Status;
 class StreamLoadPipe;
 
+// The messages a kafka consumer puts to the queue of its group at a time.
+using KafkaMessageBatch = std::vector<std::unique_ptr<RdKafka::Message>>;
+
 class DataConsumer {
 public:
     DataConsumer(StreamLoadContext* ctx)
@@ -136,8 +141,9 @@ public:
     Status assign_topic_partitions(const std::map<int32_t, int64_t>& begin_partition_offset, const std::string& topic,
                                    StreamLoadContext* ctx);
 
-    // start the consumer and put msgs to queue
-    Status group_consume(TimedBlockingQueue<RdKafka::Message*>* queue, int64_t max_running_time_ms);
+    // start the consumer and put msgs to queue, in batches of at most config::routine_load_kafka_consume_batch_size
+    // msgs which are available without waiting.
+    Status group_consume(TimedBlockingQueue<KafkaMessageBatch>* queue, int64_t max_running_time_ms);
 
     // get the partitions ids of the topic
     Status get_partition_meta(std::vector<int32_t>* partition_ids);
@@ -77,12 +77,12 @@ public:
 
 private:
     // start a single consumer
-    void actual_consume(const std::shared_ptr<DataConsumer>& consumer, TimedBlockingQueue<RdKafka::Message*>* queue,
+    void actual_consume(const std::shared_ptr<DataConsumer>& consumer, TimedBlockingQueue<KafkaMessageBatch>* queue,
                         int64_t max_running_time_ms, const ConsumeFinishCallback& cb);
 
 private:
     // blocking queue to receive msgs from all consumers
-    TimedBlockingQueue<RdKafka::Message*> _queue;
+    TimedBlockingQueue<KafkaMessageBatch> _queue;
 };
 
 } // end namespace starrocks
@@ -32,6 +32,7 @@
 #include "runtime/exec_env.h"
 #include "runtime/routine_load/data_consumer_group.h"
 #include "runtime/routine_load/kafka_consumer_pipe.h"
+#include "runtime/stream_load/load_profile_mgr.h"
 #include "runtime/stream_load/stream_load_context.h"
 #include "runtime/stream_load/stream_load_executor.h"
 #include "util/defer_op.h"
@@ -273,6 +274,7 @@ void RoutineLoadTaskExecutor::exec_task(StreamLoadContext* ctx, DataConsumerPool
 
     // commit txn
     HANDLE_ERROR(_exec_env->stream_load_executor()->commit_txn(ctx), "commit failed");
+    LoadProfileMgr::instance()->add(ctx);
 
     // commit kafka offset
     switch (ctx->load_src_type) {
@@ -316,6 +318,7 @@ void RoutineLoadTaskExecutor::exec_task(StreamLoadContext* ctx, DataConsumerPool
 void RoutineLoadTaskExecutor::err_handler(StreamLoadContext* ctx, const Status& st, const std::string& err_msg) {
     LOG(WARNING) << err_msg;
     ctx->status = st;
+    LoadProfileMgr::instance()->add(ctx);
     if (ctx->need_rollback) {
         _exec_env->stream_load_executor()->rollback_txn(ctx);
         ctx->need_rollback = false;
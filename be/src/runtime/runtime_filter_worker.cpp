@@ -10,30 +10,86 @@
 #include "runtime/fragment_mgr.h"
 #include "runtime/runtime_state.h"
 #include "service/backend_options.h"
+#include "util/block_compression.h"
 #include "util/brpc_stub_cache.h"
-#include "util/defer_op.h"
 #include "util/ref_count_closure.h"
 #include "util/time.h"
 
 namespace starrocks {
 
+// Owns the request, so that the sender needn't wait for the rpc to finish before sending the next one.
 class RuntimeFilterRpcClosure final : public RefCountClosure<PTransmitRuntimeFilterResult> {
 public:
-    int64_t seq = 0;
+    PTransmitRuntimeFilterParams request;
 };
 
 static const int default_send_rpc_runtime_filter_timeout_ms = 1000;
 
-static void send_rpc_runtime_filter(doris::PBackendService_Stub* stub, RuntimeFilterRpcClosure* rpc_closure,
-                                    int timeout_ms, const PTransmitRuntimeFilterParams& request) {
-    if (rpc_closure->seq != 0) {
-        brpc::Join(rpc_closure->cntl.call_id());
-    }
+// The rpcs are sent asynchronously without waiting for the previous ones, so that a slow node delays neither
+// the other nodes nor the events of the worker.
+static void send_rpc_runtime_filter(doris::PBackendService_Stub* stub, int timeout_ms,
+                                    const PTransmitRuntimeFilterParams& request) {
+    auto* rpc_closure = new RuntimeFilterRpcClosure();
     rpc_closure->ref();
-    rpc_closure->cntl.Reset();
+    rpc_closure->request = request;
     rpc_closure->cntl.set_timeout_ms(timeout_ms);
-    stub->transmit_runtime_filter(&rpc_closure->cntl, &request, &rpc_closure->result, rpc_closure);
-    rpc_closure->seq++;
+    stub->transmit_runtime_filter(&rpc_closure->cntl, &rpc_closure->request, &rpc_closure->result, rpc_closure);
+}
+
+// Serialize rf into params, and compress it if it's large and compressible enough.
+static void serialize_runtime_filter(const vectorized::JoinRuntimeFilter* rf, PTransmitRuntimeFilterParams* params) {
+    std::string* data = params->mutable_data();
+    size_t max_size = vectorized::RuntimeFilterHelper::max_runtime_filter_serialized_size(rf);
+    data->resize(max_size);
+    size_t actual_size =
+            vectorized::RuntimeFilterHelper::serialize_runtime_filter(rf, reinterpret_cast<uint8_t*>(data->data()));
+    data->resize(actual_size);
+    params->set_compress_type(CompressionTypePB::NO_COMPRESSION);
+    params->set_uncompressed_size(actual_size);
+
+    if (config::runtime_filter_compress_min_bytes <= 0 || actual_size < config::runtime_filter_compress_min_bytes) {
+        return;
+    }
+    const BlockCompressionCodec* codec = nullptr;
+    if (!get_block_compression_codec(CompressionTypePB::LZ4, &codec).ok() ||
+        codec->exceed_max_input_size(actual_size)) {
+        return;
+    }
+    std::string compressed;
+    compressed.resize(codec->max_compressed_len(actual_size));
+    Slice compressed_slice(compressed.data(), compressed.size());
+    if (!codec->compress(Slice(*data), &compressed_slice).ok()) {
+        return;
+    }
+    double compress_ratio = static_cast<double>(actual_size) / compressed_slice.size;
+    if (compress_ratio > config::rpc_compress_ratio_threshold) {
+        compressed.resize(compressed_slice.size);
+        data->swap(compressed);
+        params->set_compress_type(CompressionTypePB::LZ4);
+    }
+}
+
+// Return nullptr if the data is corrupted.
+static vectorized::JoinRuntimeFilter* deserialize_runtime_filter(ObjectPool* pool,
+                                                                 const PTransmitRuntimeFilterParams& params) {
+    const std::string* data = &params.data();
+    std::string uncompressed;
+    if (params.has_compress_type() && params.compress_type() != CompressionTypePB::NO_COMPRESSION) {
+        const BlockCompressionCodec* codec = nullptr;
+        if (!get_block_compression_codec(params.compress_type(), &codec).ok() || codec == nullptr) {
+            return nullptr;
+        }
+        uncompressed.resize(params.uncompressed_size());
+        Slice uncompressed_slice(uncompressed.data(), uncompressed.size());
+        if (!codec->decompress(Slice(*data), &uncompressed_slice).ok()) {
+            return nullptr;
+        }
+        data = &uncompressed;
+    }
+    vectorized::JoinRuntimeFilter* rf = nullptr;
+    vectorized::RuntimeFilterHelper::deserialize_runtime_filter(
+            pool, &rf, reinterpret_cast<const uint8_t*>(data->data()), data->size());
+    return rf;
 }
 
 void RuntimeFilterPort::add_listener(vectorized::RuntimeFilterProbeDescriptor* rf_desc) {
@@ -88,12 +144,7 @@ void RuntimeFilterPort::publish_runtime_filters(std::list<vectorized::RuntimeFil
                   << ", filter_size = " << filter->size() << ", query_id = " << params.query_id()
                   << ", finst_id = " << params.finst_id() << ", be_number = " << params.build_be_number();
 
-        std::string* rf_data = params.mutable_data();
-        size_t max_size = vectorized::RuntimeFilterHelper::max_runtime_filter_serialized_size(filter);
-        rf_data->resize(max_size);
-        size_t actual_size = vectorized::RuntimeFilterHelper::serialize_runtime_filter(
-                filter, reinterpret_cast<uint8_t*>(rf_data->data()));
-        rf_data->resize(actual_size);
+        serialize_runtime_filter(filter, &params);
 
         state->exec_env()->runtime_filter_worker()->send_part_runtime_filter(std::move(params), rf_desc->merge_nodes(),
                                                                              timeout_ms);
@@ -139,8 +190,7 @@ Status RuntimeFilterMerger::init(const TRuntimeFilterParams& params) {
     return Status::OK();
 }
 
-void RuntimeFilterMerger::merge_runtime_filter(PTransmitRuntimeFilterParams& params,
-                                               RuntimeFilterRpcClosure* rpc_closure) {
+void RuntimeFilterMerger::merge_runtime_filter(PTransmitRuntimeFilterParams& params) {
     DCHECK(params.is_partial());
     int32_t filter_id = params.filter_id();
     int32_t be_number = params.build_be_number();
@@ -176,9 +226,7 @@ void RuntimeFilterMerger::merge_runtime_filter(PTransmitRuntimeFilterParams& par
 
     // to merge runtime filters
     ObjectPool* pool = &(status->pool);
-    vectorized::JoinRuntimeFilter* rf = nullptr;
-    vectorized::RuntimeFilterHelper::deserialize_runtime_filter(
-            pool, &rf, reinterpret_cast<const uint8_t*>(params.data().data()), params.data().size());
+    vectorized::JoinRuntimeFilter* rf = deserialize_runtime_filter(pool, params);
     if (rf == nullptr) {
         // something wrong with deserialization.
         return;
@@ -200,10 +248,10 @@ void RuntimeFilterMerger::merge_runtime_filter(PTransmitRuntimeFilterParams& par
 
     // not ready. still have to wait more filters.
     if (status->filters.size() < status->expect_number) return;
-    _send_total_runtime_filter(filter_id, rpc_closure);
+    _send_total_runtime_filter(filter_id);
 }
 
-void RuntimeFilterMerger::_send_total_runtime_filter(int32_t filter_id, RuntimeFilterRpcClosure* rpc_closure) {
+void RuntimeFilterMerger::_send_total_runtime_filter(int32_t filter_id) {
     auto status_it = _statuses.find(filter_id);
     DCHECK(status_it != _statuses.end());
     RuntimeFilterMergerStatus* status = &(status_it->second);
@@ -228,13 +276,7 @@ void RuntimeFilterMerger::_send_total_runtime_filter(int32_t filter_id, RuntimeF
     query_id->set_hi(_query_id.hi);
     query_id->set_lo(_query_id.lo);
 
-    std::string* send_data = request.mutable_data();
-    size_t max_size = vectorized::RuntimeFilterHelper::max_runtime_filter_serialized_size(out);
-    send_data->resize(max_size);
-
-    size_t actual_size = vectorized::RuntimeFilterHelper::serialize_runtime_filter(
-            out, reinterpret_cast<uint8_t*>(send_data->data()));
-    send_data->resize(actual_size);
+    serialize_runtime_filter(out, &request);
     int timeout_ms = default_send_rpc_runtime_filter_timeout_ms;
     if (_query_options.__isset.runtime_filter_send_timeout_ms) {
         timeout_ms = _query_options.runtime_filter_send_timeout_ms;
@@ -323,7 +365,7 @@ void RuntimeFilterMerger::_send_total_runtime_filter(int32_t filter_id, RuntimeF
         }
 
         index += (1 + half);
-        send_rpc_runtime_filter(stub, rpc_closure, timeout_ms, request);
+        send_rpc_runtime_filter(stub, timeout_ms, request);
     }
 
     // we don't need to hold rf any more.
@@ -404,13 +446,9 @@ void RuntimeFilterWorker::receive_runtime_filter(const PTransmitRuntimeFilterPar
     ev.transmit_rf_request = params;
     _queue.put(std::move(ev));
 }
-void RuntimeFilterWorker::_receive_total_runtime_filter(PTransmitRuntimeFilterParams& request,
-                                                        RuntimeFilterRpcClosure* rpc_closure) {
+void RuntimeFilterWorker::_receive_total_runtime_filter(PTransmitRuntimeFilterParams& request) {
     // deserialize once, and all fragment instance shared that runtime filter.
-    vectorized::JoinRuntimeFilter* rf = nullptr;
-    const std::string& data = request.data();
-    vectorized::RuntimeFilterHelper::deserialize_runtime_filter(
-            nullptr, &rf, reinterpret_cast<const uint8_t*>(data.data()), data.size());
+    vectorized::JoinRuntimeFilter* rf = deserialize_runtime_filter(nullptr, request);
     if (rf == nullptr) {
         return;
     }
@@ -454,15 +492,12 @@ void RuntimeFilterWorker::_receive_total_runtime_filter(PTransmitRuntimeFilterPa
         }
 
         index += (1 + half);
-        send_rpc_runtime_filter(stub, rpc_closure, default_send_rpc_runtime_filter_timeout_ms, request);
+        send_rpc_runtime_filter(stub, default_send_rpc_runtime_filter_timeout_ms, request);
     }
 }
 
 void RuntimeFilterWorker::execute() {
     LOG(INFO) << "RuntimeFilterWorker start working.";
-    RuntimeFilterRpcClosure* rpc_closure = new RuntimeFilterRpcClosure();
-    rpc_closure->ref();
-    DeferOp deferop([&] { rpc_closure->Run(); });
 
     for (;;) {
         RuntimeFilterWorkerEvent ev;
@@ -471,7 +506,7 @@ void RuntimeFilterWorker::execute() {
         }
         switch (ev.type) {
         case RECEIVE_TOTAL_RF: {
-            _receive_total_runtime_filter(ev.transmit_rf_request, rpc_closure);
+            _receive_total_runtime_filter(ev.transmit_rf_request);
             break;
         }
 
@@ -506,14 +541,14 @@ void RuntimeFilterWorker::execute() {
                 break;
             }
             RuntimeFilterMerger& merger = it->second;
-            merger.merge_runtime_filter(ev.transmit_rf_request, rpc_closure);
+            merger.merge_runtime_filter(ev.transmit_rf_request);
             break;
         }
 
         case SEND_PART_RF: {
             for (const auto& addr : ev.transmit_addrs) {
                 doris::PBackendService_Stub* stub = _exec_env->brpc_stub_cache()->get_stub(addr);
-                send_rpc_runtime_filter(stub, rpc_closure, ev.transmit_timeout_ms, ev.transmit_rf_request);
+                send_rpc_runtime_filter(stub, ev.transmit_timeout_ms, ev.transmit_rf_request);
             }
             break;
         }
@@ -26,7 +26,6 @@ class RuntimeFilterProbeDescriptor;
 class RuntimeFilterBuildDescriptor;
 } // namespace vectorized
 
-class RuntimeFilterRpcClosure;
 // RuntimeFilterPort is bind to a fragment instance
 // and it's to exchange RF(publish/receive) with outside world.
 class RuntimeFilterPort {
@@ -84,10 +83,10 @@ class RuntimeFilterMerger {
 public:
     RuntimeFilterMerger(ExecEnv* env, const UniqueId& query_id, const TQueryOptions& query_options);
     Status init(const TRuntimeFilterParams& params);
-    void merge_runtime_filter(PTransmitRuntimeFilterParams& params, RuntimeFilterRpcClosure* rpc_closure);
+    void merge_runtime_filter(PTransmitRuntimeFilterParams& params);
 
 private:
-    void _send_total_runtime_filter(int32_t filter_id, RuntimeFilterRpcClosure* rpc_closure);
+    void _send_total_runtime_filter(int32_t filter_id);
     // filter_id -> where this filter should send to
     std::map<int32_t, std::vector<TRuntimeFilterProberParams>> _targets;
     std::map<int32_t, RuntimeFilterMergerStatus> _statuses;
@@ -120,7 +119,7 @@ public:
                                   const std::vector<starrocks::TNetworkAddress>& addrs, int timeout_ms);
 
 private:
-    void _receive_total_runtime_filter(PTransmitRuntimeFilterParams& params, RuntimeFilterRpcClosure* rpc_closure);
+    void _receive_total_runtime_filter(PTransmitRuntimeFilterParams& params);
     UnboundedBlockingQueue<RuntimeFilterWorkerEvent> _queue;
     std::unordered_map<TUniqueId, RuntimeFilterMerger> _mergers;
     ExecEnv* _exec_env;
@@ -301,6 +301,7 @@ void RuntimeState::append_error_msg_to_file(const std::string& line, const std::
     if (_query_options.query_type != TQueryType::LOAD) {
         return;
     }
+    std::lock_guard<std::mutex> l(_error_log_file_lock);
     // If file havn't been opened, open it here
     if (_error_log_file == nullptr) {
         Status status = create_error_log_file();
@@ -359,6 +359,8 @@ private:
 
     std::string _error_log_file_path;
     std::ofstream* _error_log_file = nullptr; // error file path, absolute path
+    // Lock protecting _error_log_file and _error_hub, which are written by the scanners in parallel.
+    std::mutex _error_log_file_lock;
     std::unique_ptr<LoadErrorHub> _error_hub;
     std::vector<TTabletCommitInfo> _tablet_commit_infos;
 
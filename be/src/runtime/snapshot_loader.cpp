@@ -21,9 +21,15 @@
 
 #include "runtime/snapshot_loader.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cctype>
 #include <cstdint>
 #include <filesystem>
+#include <functional>
+#include <mutex>
 
+#include "common/config.h"
 #include "common/logging.h"
 #include "env/env.h"
 #include "env/env_broker.h"
@@ -38,11 +44,21 @@
 #include "storage/storage_engine.h"
 #include "storage/tablet.h"
 #include "util/file_utils.h"
+#include "util/parallel_for.h"
 #include "util/thrift_rpc_helper.h"
+#include "util/token_bucket.h"
 
 namespace starrocks {
 
 #ifdef BE_TEST
+namespace {
+TFileBrokerServiceClient* g_broker_client = nullptr;
+}
+
+void SnapshotLoader::TEST_set_broker_client(TFileBrokerServiceClient* client) {
+    g_broker_client = client;
+}
+
 inline BrokerServiceClientCache* client_cache(ExecEnv* env) {
     static BrokerServiceClientCache s_client_cache;
     return &s_client_cache;
@@ -62,6 +78,74 @@ inline const std::string& client_id(ExecEnv* env, const TNetworkAddress& addr) {
 }
 #endif
 
+// The bytes uploaded and downloaded by all the snapshot loaders of the backend share the limit.
+static TokenBucket* transfer_limiter() {
+    static TokenBucket s_limiter(0);
+    s_limiter.set_rate(config::snapshot_loader_max_mbytes_per_sec * 1024 * 1024);
+    return &s_limiter;
+}
+
+static StatusOr<int64_t> copy_file(SequentialFile* src, WritableFile* dest) {
+    const size_t buff_size = 1024 * 1024;
+    std::unique_ptr<char[]> buf(new char[buff_size]);
+    TokenBucket* limiter = transfer_limiter();
+    int64_t ncopy = 0;
+    while (true) {
+        Slice read_buf(buf.get(), buff_size);
+        RETURN_IF_ERROR(src->read(&read_buf));
+        if (read_buf.size == 0) {
+            break;
+        }
+        limiter->acquire(read_buf.size);
+        ncopy += read_buf.size;
+        RETURN_IF_ERROR(dest->append(read_buf));
+    }
+    return ncopy;
+}
+
+// The files are uploaded and downloaded by the threads shared by the storage tasks, if the storage engine is open.
+static ThreadPool* parallel_task_pool() {
+    StorageEngine* engine = StorageEngine::instance();
+    return engine != nullptr ? engine->parallel_task_pool() : nullptr;
+}
+
+// Call |method| of the broker, the connection is reopened and the call retried once if it's broken.
+template <typename Method, typename Request, typename Response>
+static Status call_broker(ExecEnv* env, const TNetworkAddress& broker_addr, Method method, const Request& request,
+                          Response* response) {
+#ifdef BE_TEST
+    (void)env;
+    (void)broker_addr;
+    try {
+        (g_broker_client->*method)(*response, request);
+    } catch (apache::thrift::TException& e) {
+        return Status::ThriftRpcError(e.what());
+    }
+    return Status::OK();
+#else
+    Status status;
+    BrokerServiceConnection client(client_cache(env), broker_addr, 10000, &status);
+    if (!status.ok()) {
+        std::stringstream ss;
+        ss << "failed to get broker client. "
+           << "broker addr: " << broker_addr << ". msg: " << status.get_error_msg();
+        LOG(WARNING) << ss.str();
+        return Status::InternalError(ss.str());
+    }
+    try {
+        try {
+            (client.get()->*method)(*response, request);
+        } catch (apache::thrift::transport::TTransportException& e) {
+            RETURN_IF_ERROR(client.reopen());
+            (client.get()->*method)(*response, request);
+        }
+    } catch (apache::thrift::TException& e) {
+        return Status::ThriftRpcError(e.what());
+    }
+    return Status::OK();
+#endif
+}
+
 SnapshotLoader::SnapshotLoader(ExecEnv* env, int64_t job_id, int64_t task_id)
         : _env(env), _job_id(job_id), _task_id(task_id) {}
 
@@ -81,110 +165,145 @@ Status SnapshotLoader::upload(const std::map<std::string, std::string>& src_to_d
     // 1. validate local tablet snapshot paths
     RETURN_IF_ERROR(_check_local_snapshot_paths(src_to_dest_path, true));
 
-    // 2. get broker client
-    BrokerServiceConnection client(client_cache(_env), broker_addr, 10000, &status);
-    if (!status.ok()) {
-        std::stringstream ss;
-        ss << "failed to get broker client. "
-           << "broker addr: " << broker_addr << ". msg: " << status.get_error_msg();
-        LOG(WARNING) << ss.str();
-        return Status::InternalError(ss.str());
-    }
-
-    // 3. for each src path, upload it to remote storage
-    // we report to frontend for every 10 files, and we will cancel the job if
-    // the job has already been cancelled in frontend.
-    int report_counter = 0;
-    int total_num = src_to_dest_path.size();
-    int finished_num = 0;
+    // 2. list the existing files of each tablet in local and remote storage
+    struct TabletFiles {
+        int64_t tablet_id = 0;
+        std::string src_path;
+        std::string dest_path;
+        std::map<std::string, FileStat> remote_files;
+        std::vector<std::string> local_files;
+        std::vector<std::string> checksums;
+    };
+    std::vector<TabletFiles> tablets(src_to_dest_path.size());
+    // (tablet, local file) of all the files to upload
+    std::vector<std::pair<size_t, size_t>> files;
+    size_t tablet_idx = 0;
     for (const auto& iter : src_to_dest_path) {
-        const std::string& src_path = iter.first;
-        const std::string& dest_path = iter.second;
+        TabletFiles& tablet = tablets[tablet_idx];
+        tablet.src_path = iter.first;
+        tablet.dest_path = iter.second;
 
-        int64_t tablet_id = 0;
         int32_t schema_hash = 0;
-        RETURN_IF_ERROR(_get_tablet_id_and_schema_hash_from_file_path(src_path, &tablet_id, &schema_hash));
-
-        // 2.1 get existing files from remote path
-        std::map<std::string, FileStat> remote_files;
-        RETURN_IF_ERROR(_get_existing_files_from_remote(client, dest_path, broker_prop, &remote_files));
+        RETURN_IF_ERROR(
+                _get_tablet_id_and_schema_hash_from_file_path(tablet.src_path, &tablet.tablet_id, &schema_hash));
 
-        for (auto& tmp : remote_files) {
+        RETURN_IF_ERROR(
+                _get_existing_files_from_remote(broker_addr, tablet.dest_path, broker_prop, &tablet.remote_files));
+        for (auto& tmp : tablet.remote_files) {
             VLOG(2) << "get remote file: " << tmp.first << ", checksum: " << tmp.second.md5;
         }
 
-        // 2.2 list local files
-        std::vector<std::string> local_files;
-        std::vector<std::string> local_files_with_checksum;
-        RETURN_IF_ERROR(_get_existing_files_from_local(src_path, &local_files));
+        RETURN_IF_ERROR(_get_existing_files_from_local(tablet.src_path, &tablet.local_files));
+        tablet.checksums.resize(tablet.local_files.size());
+        for (size_t i = 0; i < tablet.local_files.size(); ++i) {
+            files.emplace_back(tablet_idx, i);
+        }
+        ++tablet_idx;
+    }
 
-        // 2.3 iterate local files
-        for (auto& local_file : local_files) {
+    // 3. upload the files of all the tablets in parallel.
+    // we report to frontend for every 10 files, and we will cancel the job if
+    // the job has already been cancelled in frontend.
+    std::mutex report_mutex;
+    int report_counter = 0;
+    int total_num = files.size();
+    std::atomic<int> finished_num{0};
+    auto upload_file = [&](size_t i) {
+        {
+            std::lock_guard l(report_mutex);
             RETURN_IF_ERROR(_report_every(10, &report_counter, finished_num, total_num, TTaskType::type::UPLOAD));
+        }
+        TabletFiles& tablet = tablets[files[i].first];
+        RETURN_IF_ERROR(_upload_file(broker_addr, broker_prop, tablet.src_path, tablet.dest_path,
+                                     tablet.local_files[files[i].second], tablet.remote_files,
+                                     &tablet.checksums[files[i].second]));
+        ++finished_num;
+        return Status::OK();
+    };
+    RETURN_IF_ERROR(
+            parallel_for(parallel_task_pool(), files.size(), config::snapshot_loader_file_parallelism, upload_file));
 
-            // calc md5sum of localfile
-            std::string md5sum;
-            status = FileUtils::md5sum(src_path + "/" + local_file, &md5sum);
-            if (!status.ok()) {
-                std::stringstream ss;
-                ss << "failed to get md5sum of file: " << local_file << ": " << status.get_error_msg();
-                LOG(WARNING) << ss.str();
-                return Status::InternalError(ss.str());
-            }
-            VLOG(2) << "get file checksum: " << local_file << ": " << md5sum;
-            local_files_with_checksum.push_back(local_file + "." + md5sum);
+    for (auto& tablet : tablets) {
+        std::vector<std::string> local_files_with_checksum;
+        local_files_with_checksum.reserve(tablet.local_files.size());
+        for (size_t i = 0; i < tablet.local_files.size(); ++i) {
+            local_files_with_checksum.push_back(tablet.local_files[i] + "." + tablet.checksums[i]);
+        }
+        tablet_files->emplace(tablet.tablet_id, std::move(local_files_with_checksum));
+        LOG(INFO) << "finished to write tablet to remote. local path: " << tablet.src_path
+                  << ", remote path: " << tablet.dest_path;
+    }
 
-            // check if this local file need upload
-            bool need_upload = false;
-            auto find = remote_files.find(local_file);
-            if (find != remote_files.end()) {
-                if (md5sum != find->second.md5) {
-                    // remote storage file exist, but with different checksum
-                    LOG(WARNING) << "remote file checksum is invalid. remote: " << find->first << ", local: " << md5sum;
-                    // TODO(cmy): save these files and delete them later
-                    need_upload = true;
-                }
-            } else {
-                need_upload = true;
-            }
+    LOG(INFO) << "finished to upload snapshots. job: " << _job_id << ", task id: " << _task_id;
+    return status;
+}
 
-            if (!need_upload) {
-                VLOG(2) << "file exist in remote path, no need to upload: " << local_file;
-                continue;
-            }
+Status SnapshotLoader::_upload_file(const TNetworkAddress& broker_addr,
+                                    const std::map<std::string, std::string>& broker_prop, const std::string& src_path,
+                                    const std::string& dest_path, const std::string& local_file,
+                                    const std::map<std::string, FileStat>& remote_files, std::string* md5sum) {
+    auto local_file_path = src_path + "/" + local_file;
+    auto find = remote_files.find(local_file);
+    if (find != remote_files.end() && config::snapshot_upload_trust_remote_segments &&
+        _is_rowset_segment_file(local_file)) {
+        // The segment files are named by the rowset ids unique among the backends and never change, so the one
+        // uploaded by a previous backup with the same size is reused without reading the local file.
+        std::error_code ec;
+        uint64_t file_size = std::filesystem::file_size(local_file_path, ec);
+        if (!ec && static_cast<int64_t>(file_size) == find->second.size) {
+            VLOG(2) << "segment file exist in remote path, no need to upload: " << local_file;
+            *md5sum = find->second.md5;
+            return Status::OK();
+        }
+    }
 
-            // upload
-            // open broker writer. file name end with ".part"
-            // it will be renamed to ".md5sum" after upload finished
-            auto full_remote_file = dest_path + "/" + local_file;
-            auto tmp_broker_file_name = full_remote_file + ".part";
-            auto local_file_path = src_path + "/" + local_file;
+    // calc md5sum of localfile
+    Status status = FileUtils::md5sum(local_file_path, md5sum);
+    if (!status.ok()) {
+        std::stringstream ss;
+        ss << "failed to get md5sum of file: " << local_file << ": " << status.get_error_msg();
+        LOG(WARNING) << ss.str();
+        return Status::InternalError(ss.str());
+    }
+    VLOG(2) << "get file checksum: " << local_file << ": " << *md5sum;
 
-            EnvBroker env_broker(broker_addr, broker_prop);
-            std::unique_ptr<WritableFile> broker_file;
-            RETURN_IF_ERROR(env_broker.new_writable_file(tmp_broker_file_name, &broker_file));
+    // check if this local file need upload
+    if (find != remote_files.end()) {
+        if (*md5sum == find->second.md5) {
+            VLOG(2) << "file exist in remote path, no need to upload: " << local_file;
+            return Status::OK();
+        }
+        // remote storage file exist, but with different checksum
+        LOG(WARNING) << "remote file checksum is invalid. remote: " << find->first << ", local: " << *md5sum;
+        // TODO(cmy): save these files and delete them later
+    }
 
-            std::unique_ptr<SequentialFile> input_file;
-            RETURN_IF_ERROR(Env::Default()->new_sequential_file(local_file_path, &input_file));
+    // upload
+    // open broker writer. file name end with ".part"
+    // it will be renamed to ".md5sum" after upload finished
+    auto full_remote_file = dest_path + "/" + local_file;
+    auto tmp_broker_file_name = full_remote_file + ".part";
 
-            auto res = FileUtils::copy(input_file.get(), broker_file.get(), 1024 * 1024);
-            if (!res.ok()) {
-                return res.status();
-            }
-            LOG(INFO) << "finished to write file via broker. file: " << local_file_path << ", length: " << *res;
-            RETURN_IF_ERROR(broker_file->close());
-            // rename file to end with ".md5sum"
-            RETURN_IF_ERROR(_rename_remote_file(client, full_remote_file + ".part", full_remote_file + "." + md5sum,
-                                                broker_prop));
-        } // end for each tablet's local files
-
-        tablet_files->emplace(tablet_id, local_files_with_checksum);
-        finished_num++;
-        LOG(INFO) << "finished to write tablet to remote. local path: " << src_path << ", remote path: " << dest_path;
-    } // end for each tablet path
+    EnvBroker env_broker(broker_addr, broker_prop);
+    // the part file left by a failed upload can't be truncated by the broker.
+    if (env_broker.path_exists(tmp_broker_file_name).ok()) {
+        RETURN_IF_ERROR(env_broker.delete_file(tmp_broker_file_name));
+    }
+    std::unique_ptr<WritableFile> broker_file;
+    RETURN_IF_ERROR(env_broker.new_writable_file(tmp_broker_file_name, &broker_file));
 
-    LOG(INFO) << "finished to upload snapshots. job: " << _job_id << ", task id: " << _task_id;
-    return status;
+    std::unique_ptr<SequentialFile> input_file;
+    RETURN_IF_ERROR(Env::Default()->new_sequential_file(local_file_path, &input_file));
+
+    auto res = copy_file(input_file.get(), broker_file.get());
+    if (!res.ok()) {
+        return res.status();
+    }
+    LOG(INFO) << "finished to write file via broker. file: " << local_file_path << ", length: " << *res;
+    RETURN_IF_ERROR(broker_file->close());
+
+    // rename file to end with ".md5sum"
+    return _rename_remote_file(broker_addr, tmp_broker_file_name, full_remote_file + "." + *md5sum, broker_prop);
 }
 
 /*
@@ -207,19 +326,8 @@ Status SnapshotLoader::download(const std::map<std::string, std::string>& src_to
     // 1. validate local tablet snapshot paths
     RETURN_IF_ERROR(_check_local_snapshot_paths(src_to_dest_path, false));
 
-    // 2. get broker client
-    BrokerServiceConnection client(client_cache(_env), broker_addr, 10000, &status);
-    if (!status.ok()) {
-        std::stringstream ss;
-        ss << "failed to get broker client. "
-           << "broker addr: " << broker_addr << ". msg: " << status.get_error_msg();
-        LOG(WARNING) << ss.str();
-        return Status::InternalError(ss.str());
-    }
-
-    std::vector<TNetworkAddress> broker_addrs;
-    broker_addrs.push_back(broker_addr);
-    // 3. for each src path, download it to local storage
+    // 2. for each src path, download it to local storage
+    std::mutex report_mutex;
     int report_counter = 0;
     int total_num = src_to_dest_path.size();
     int finished_num = 0;
@@ -243,7 +351,7 @@ Status SnapshotLoader::download(const std::map<std::string, std::string>& src_to
 
         // 2. get remote files
         std::map<std::string, FileStat> remote_files;
-        RETURN_IF_ERROR(_get_existing_files_from_remote(client, remote_path, broker_prop, &remote_files));
+        RETURN_IF_ERROR(_get_existing_files_from_remote(broker_addr, remote_path, broker_prop, &remote_files));
         if (remote_files.empty()) {
             std::stringstream ss;
             ss << "get nothing from remote path: " << remote_path;
@@ -260,98 +368,23 @@ Status SnapshotLoader::download(const std::map<std::string, std::string>& src_to
         }
         DataDir* data_dir = tablet->data_dir();
 
-        for (auto& iter : remote_files) {
-            RETURN_IF_ERROR(_report_every(10, &report_counter, finished_num, total_num, TTaskType::type::DOWNLOAD));
-
-            bool need_download = false;
-            const std::string& remote_file = iter.first;
-            const FileStat& file_stat = iter.second;
-            auto find = std::find(local_files.begin(), local_files.end(), remote_file);
-            if (find == local_files.end()) {
-                // remote file does not exist in local, download it
-                need_download = true;
-            } else {
-                if (_end_with(remote_file, ".hdr")) {
-                    // this is a header file, download it.
-                    need_download = true;
-                } else {
-                    // check checksum
-                    std::string local_md5sum;
-                    Status st = FileUtils::md5sum(local_path + "/" + remote_file, &local_md5sum);
-                    if (!st.ok()) {
-                        LOG(WARNING) << "failed to get md5sum of local file: " << remote_file
-                                     << ". msg: " << st.get_error_msg() << ". download it";
-                        need_download = true;
-                    } else {
-                        VLOG(2) << "get local file checksum: " << remote_file << ": " << local_md5sum;
-                        if (file_stat.md5 != local_md5sum) {
-                            // file's checksum does not equal, download it.
-                            need_download = true;
-                        }
-                    }
-                }
-            }
-
-            if (!need_download) {
-                LOG(INFO) << "remote file already exist in local, no need to download."
-                          << ", file: " << remote_file;
-                continue;
-            }
-
-            // begin to download
-            std::string full_remote_file = remote_path + "/" + remote_file + "." + file_stat.md5;
-            std::string local_file_name;
-            // we need to replace the tablet_id in remote file name with local tablet id
-            RETURN_IF_ERROR(_replace_tablet_id(remote_file, local_tablet_id, &local_file_name));
-            std::string full_local_file = local_path + "/" + local_file_name;
-            LOG(INFO) << "begin to download from " << full_remote_file << " to " << full_local_file;
-            size_t file_len = file_stat.size;
-
-            // check disk capacity
-            if (data_dir->reach_capacity_limit(file_len)) {
-                return Status::InternalError("capacity limit reached");
-            }
-
-            EnvBroker env_broker(broker_addr, broker_prop);
-            std::unique_ptr<SequentialFile> broker_file;
-            RETURN_IF_ERROR(env_broker.new_sequential_file(full_remote_file, &broker_file));
-
-            // remove file which will be downloaded now.
-            // this file will be added to local_files if it be downloaded successfully.
-            local_files.erase(find);
-
-            // 3. open local file for write
-            std::unique_ptr<WritableFile> local_file;
-            RETURN_IF_ERROR(Env::Default()->new_writable_file(full_local_file, &local_file));
-
-            auto res = FileUtils::copy(broker_file.get(), local_file.get(), 1024 * 1024);
-            if (!res.ok()) {
-                return res.status();
-            }
-            RETURN_IF_ERROR(local_file->close());
-
-            // 5. check md5 of the downloaded file
-            std::string downloaded_md5sum;
-            status = FileUtils::md5sum(full_local_file, &downloaded_md5sum);
-            if (!status.ok()) {
-                std::stringstream ss;
-                ss << "failed to get md5sum of file: " << full_local_file;
-                LOG(WARNING) << ss.str();
-                return Status::InternalError(ss.str());
-            }
-            VLOG(2) << "get downloaded file checksum: " << full_local_file << ": " << downloaded_md5sum;
-            if (downloaded_md5sum != file_stat.md5) {
-                std::stringstream ss;
-                ss << "invalid md5 of downloaded file: " << full_local_file << ", expected: " << file_stat.md5
-                   << ", get: " << downloaded_md5sum;
-                LOG(WARNING) << ss.str();
-                return Status::InternalError(ss.str());
+        // 3. download the remote files of the tablet in parallel
+        std::vector<const FileStat*> remote_file_stats;
+        remote_file_stats.reserve(remote_files.size());
+        for (const auto& remote_file : remote_files) {
+            remote_file_stats.push_back(&remote_file.second);
+        }
+        auto download_file = [&](size_t i) {
+            {
+                std::lock_guard l(report_mutex);
+                RETURN_IF_ERROR(
+                        _report_every(10, &report_counter, finished_num, total_num, TTaskType::type::DOWNLOAD));
             }
-
-            // local_files always keep the updated local files
-            local_files.push_back(local_file_name);
-            LOG(INFO) << "finished to download file via broker. file: " << full_local_file << ", length: " << file_len;
-        } // end for all remote files
+            return _download_file(broker_addr, broker_prop, remote_path, local_path, local_tablet_id,
+                                  *remote_file_stats[i], local_files, data_dir);
+        };
+        RETURN_IF_ERROR(parallel_for(parallel_task_pool(), remote_file_stats.size(),
+                                     config::snapshot_loader_file_parallelism, download_file));
 
         // finally, delete local files which are not in remote
         for (const auto& local_file : local_files) {
@@ -385,6 +418,95 @@ Status SnapshotLoader::download(const std::map<std::string, std::string>& src_to
     return status;
 }
 
+Status SnapshotLoader::_download_file(const TNetworkAddress& broker_addr,
+                                      const std::map<std::string, std::string>& broker_prop,
+                                      const std::string& remote_path, const std::string& local_path,
+                                      int64_t local_tablet_id, const FileStat& file_stat,
+                                      const std::vector<std::string>& local_files, DataDir* data_dir) {
+    bool need_download = false;
+    const std::string& remote_file = file_stat.name;
+    auto find = std::find(local_files.begin(), local_files.end(), remote_file);
+    if (find == local_files.end()) {
+        // remote file does not exist in local, download it
+        need_download = true;
+    } else {
+        if (_end_with(remote_file, ".hdr")) {
+            // this is a header file, download it.
+            need_download = true;
+        } else {
+            // check checksum
+            std::string local_md5sum;
+            Status st = FileUtils::md5sum(local_path + "/" + remote_file, &local_md5sum);
+            if (!st.ok()) {
+                LOG(WARNING) << "failed to get md5sum of local file: " << remote_file << ". msg: " << st.get_error_msg()
+                             << ". download it";
+                need_download = true;
+            } else {
+                VLOG(2) << "get local file checksum: " << remote_file << ": " << local_md5sum;
+                if (file_stat.md5 != local_md5sum) {
+                    // file's checksum does not equal, download it.
+                    need_download = true;
+                }
+            }
+        }
+    }
+
+    if (!need_download) {
+        LOG(INFO) << "remote file already exist in local, no need to download."
+                  << ", file: " << remote_file;
+        return Status::OK();
+    }
+
+    // begin to download
+    std::string full_remote_file = remote_path + "/" + remote_file + "." + file_stat.md5;
+    std::string local_file_name;
+    // we need to replace the tablet_id in remote file name with local tablet id
+    RETURN_IF_ERROR(_replace_tablet_id(remote_file, local_tablet_id, &local_file_name));
+    std::string full_local_file = local_path + "/" + local_file_name;
+    LOG(INFO) << "begin to download from " << full_remote_file << " to " << full_local_file;
+    size_t file_len = file_stat.size;
+
+    // check disk capacity
+    if (data_dir->reach_capacity_limit(file_len)) {
+        return Status::InternalError("capacity limit reached");
+    }
+
+    EnvBroker env_broker(broker_addr, broker_prop);
+    std::unique_ptr<SequentialFile> broker_file;
+    RETURN_IF_ERROR(env_broker.new_sequential_file(full_remote_file, &broker_file));
+
+    // open local file for write
+    std::unique_ptr<WritableFile> local_file;
+    RETURN_IF_ERROR(Env::Default()->new_writable_file(full_local_file, &local_file));
+
+    auto res = copy_file(broker_file.get(), local_file.get());
+    if (!res.ok()) {
+        return res.status();
+    }
+    RETURN_IF_ERROR(local_file->close());
+
+    // check md5 of the downloaded file
+    std::string downloaded_md5sum;
+    Status status = FileUtils::md5sum(full_local_file, &downloaded_md5sum);
+    if (!status.ok()) {
+        std::stringstream ss;
+        ss << "failed to get md5sum of file: " << full_local_file;
+        LOG(WARNING) << ss.str();
+        return Status::InternalError(ss.str());
+    }
+    VLOG(2) << "get downloaded file checksum: " << full_local_file << ": " << downloaded_md5sum;
+    if (downloaded_md5sum != file_stat.md5) {
+        std::stringstream ss;
+        ss << "invalid md5 of downloaded file: " << full_local_file << ", expected: " << file_stat.md5
+           << ", get: " << downloaded_md5sum;
+        LOG(WARNING) << ss.str();
+        return Status::InternalError(ss.str());
+    }
+
+    LOG(INFO) << "finished to download file via broker. file: " << full_local_file << ", length: " << file_len;
+    return Status::OK();
+}
+
 // move the snapshot files in snapshot_path
 // to tablet_path
 // If overwrite, just replace the tablet_path with snapshot_path,
@@ -507,6 +629,14 @@ Status SnapshotLoader::move(const std::string& snapshot_path, const TabletShared
     return status;
 }
 
+bool SnapshotLoader::_is_rowset_segment_file(const std::string& file_name) {
+    // eg: 0200000000000004f94ff0a2e6b8a9a9e0f8d1b2c3d4e5f6_0.dat
+    // the rowset ids of the old format are not unique among the backends.
+    size_t pos = file_name.find('_');
+    return _end_with(file_name, ".dat") && pos == 48 &&
+           std::all_of(file_name.begin(), file_name.begin() + pos, [](char c) { return std::isxdigit(c); });
+}
+
 bool SnapshotLoader::_end_with(const std::string& str, const std::string& match) {
     if (str.size() >= match.size() && str.compare(str.size() - match.size(), match.size(), match) == 0) {
         return true;
@@ -563,66 +693,64 @@ Status SnapshotLoader::_check_local_snapshot_paths(const std::map<std::string, s
     return Status::OK();
 }
 
-Status SnapshotLoader::_get_existing_files_from_remote(BrokerServiceConnection& client, const std::string& remote_path,
+Status SnapshotLoader::_get_existing_files_from_remote(const TNetworkAddress& broker_addr,
+                                                       const std::string& remote_path,
                                                        const std::map<std::string, std::string>& broker_prop,
                                                        std::map<std::string, FileStat>* files) {
-    try {
-        // get existing files from remote path
-        TBrokerListResponse list_rep;
-        TBrokerListPathRequest list_req;
-        list_req.__set_version(TBrokerVersion::VERSION_ONE);
-        list_req.__set_path(remote_path + "/*");
-        list_req.__set_isRecursive(false);
-        list_req.__set_properties(broker_prop);
-        list_req.__set_fileNameOnly(true); // we only need file name, not abs path
+    // get existing files from remote path
+    TBrokerListResponse list_rep;
+    TBrokerListPathRequest list_req;
+    list_req.__set_version(TBrokerVersion::VERSION_ONE);
+    list_req.__set_path(remote_path + "/*");
+    list_req.__set_isRecursive(false);
+    list_req.__set_properties(broker_prop);
+    list_req.__set_fileNameOnly(true); // we only need file name, not abs path
+
+    Status st = call_broker(_env, broker_addr, &TFileBrokerServiceClient::listPath, list_req, &list_rep);
+    if (!st.ok()) {
+        std::stringstream ss;
+        ss << "failed to list files in remote path: " << remote_path << ", msg: " << st.get_error_msg();
+        LOG(WARNING) << ss.str();
+        return Status::ThriftRpcError(ss.str());
+    }
 
-        try {
-            client->listPath(list_rep, list_req);
-        } catch (apache::thrift::transport::TTransportException& e) {
-            RETURN_IF_ERROR(client.reopen());
-            client->listPath(list_rep, list_req);
-        }
+    if (list_rep.opStatus.statusCode == TBrokerOperationStatusCode::FILE_NOT_FOUND) {
+        LOG(INFO) << "path does not exist: " << remote_path;
+        return Status::OK();
+    } else if (list_rep.opStatus.statusCode != TBrokerOperationStatusCode::OK) {
+        std::stringstream ss;
+        ss << "failed to list files from remote path: " << remote_path << ", msg: " << list_rep.opStatus.message;
+        LOG(WARNING) << ss.str();
+        return Status::InternalError(ss.str());
+    }
+    LOG(INFO) << "finished to list files from remote path. file num: " << list_rep.files.size();
 
-        if (list_rep.opStatus.statusCode == TBrokerOperationStatusCode::FILE_NOT_FOUND) {
-            LOG(INFO) << "path does not exist: " << remote_path;
-            return Status::OK();
-        } else if (list_rep.opStatus.statusCode != TBrokerOperationStatusCode::OK) {
-            std::stringstream ss;
-            ss << "failed to list files from remote path: " << remote_path << ", msg: " << list_rep.opStatus.message;
-            LOG(WARNING) << ss.str();
-            return Status::InternalError(ss.str());
+    // split file name and checksum
+    for (const auto& file : list_rep.files) {
+        if (file.isDir) {
+            // this is not a file
+            continue;
         }
-        LOG(INFO) << "finished to list files from remote path. file num: " << list_rep.files.size();
-
-        // split file name and checksum
-        for (const auto& file : list_rep.files) {
-            if (file.isDir) {
-                // this is not a file
-                continue;
-            }
 
-            const std::string& file_name = file.path;
-            size_t pos = file_name.find_last_of('.');
-            if (pos == std::string::npos || pos == file_name.size() - 1) {
-                // Not found checksum separator, ignore this file
-                continue;
-            }
-
-            FileStat stat = {std::string(file_name, 0, pos), std::string(file_name, pos + 1), file.size};
-            files->emplace(std::string(file_name, 0, pos), stat);
-            VLOG(2) << "split remote file: " << std::string(file_name, 0, pos)
-                    << ", checksum: " << std::string(file_name, pos + 1);
+        const std::string& file_name = file.path;
+        size_t pos = file_name.find_last_of('.');
+        if (pos == std::string::npos || pos == file_name.size() - 1) {
+            // Not found checksum separator, ignore this file
+            continue;
+        }
+        if (_end_with(file_name, ".part")) {
+            // left by a failed upload
+            continue;
         }
 
-        LOG(INFO) << "finished to split files. valid file num: " << files->size();
-
-    } catch (apache::thrift::TException& e) {
-        std::stringstream ss;
-        ss << "failed to list files in remote path: " << remote_path << ", msg: " << e.what();
-        LOG(WARNING) << ss.str();
-        return Status::ThriftRpcError(ss.str());
+        FileStat stat = {std::string(file_name, 0, pos), std::string(file_name, pos + 1), file.size};
+        files->emplace(std::string(file_name, 0, pos), stat);
+        VLOG(2) << "split remote file: " << std::string(file_name, 0, pos)
+                << ", checksum: " << std::string(file_name, pos + 1);
     }
 
+    LOG(INFO) << "finished to split files. valid file num: " << files->size();
+
     return Status::OK();
 }
 
@@ -639,36 +767,29 @@ Status SnapshotLoader::_get_existing_files_from_local(const std::string& local_p
     return Status::OK();
 }
 
-Status SnapshotLoader::_rename_remote_file(BrokerServiceConnection& client, const std::string& orig_name,
+Status SnapshotLoader::_rename_remote_file(const TNetworkAddress& broker_addr, const std::string& orig_name,
                                            const std::string& new_name,
                                            const std::map<std::string, std::string>& broker_prop) {
-    try {
-        TBrokerOperationStatus op_status;
-        TBrokerRenamePathRequest rename_req;
-        rename_req.__set_version(TBrokerVersion::VERSION_ONE);
-        rename_req.__set_srcPath(orig_name);
-        rename_req.__set_destPath(new_name);
-        rename_req.__set_properties(broker_prop);
-
-        try {
-            client->renamePath(op_status, rename_req);
-        } catch (apache::thrift::transport::TTransportException& e) {
-            RETURN_IF_ERROR(client.reopen());
-            client->renamePath(op_status, rename_req);
-        }
-
-        if (op_status.statusCode != TBrokerOperationStatusCode::OK) {
-            std::stringstream ss;
-            ss << "Fail to rename file: " << orig_name << " to: " << new_name << " msg:" << op_status.message;
-            LOG(WARNING) << ss.str();
-            return Status::InternalError(ss.str());
-        }
-    } catch (apache::thrift::TException& e) {
+    TBrokerOperationStatus op_status;
+    TBrokerRenamePathRequest rename_req;
+    rename_req.__set_version(TBrokerVersion::VERSION_ONE);
+    rename_req.__set_srcPath(orig_name);
+    rename_req.__set_destPath(new_name);
+    rename_req.__set_properties(broker_prop);
+
+    Status st = call_broker(_env, broker_addr, &TFileBrokerServiceClient::renamePath, rename_req, &op_status);
+    if (!st.ok()) {
         std::stringstream ss;
-        ss << "Fail to rename file: " << orig_name << " to: " << new_name << " msg:" << e.what();
+        ss << "Fail to rename file: " << orig_name << " to: " << new_name << " msg:" << st.get_error_msg();
         LOG(WARNING) << ss.str();
         return Status::ThriftRpcError(ss.str());
     }
+    if (op_status.statusCode != TBrokerOperationStatusCode::OK) {
+        std::stringstream ss;
+        ss << "Fail to rename file: " << orig_name << " to: " << new_name << " msg:" << op_status.message;
+        LOG(WARNING) << ss.str();
+        return Status::InternalError(ss.str());
+    }
 
     LOG(INFO) << "finished to rename file. orig: " << orig_name << ", new: " << new_name;
 
@@ -697,12 +818,13 @@ Status SnapshotLoader::_replace_tablet_id(const std::string& file_name, int64_t
     // 10007.hdr
     // 10007_2_2_0_0.idx
     // 10007_2_2_0_0.dat
+    // 0200000000000004f94ff0a2e6b8a9a9e0f8d1b2c3d4e5f6_0.cold
     if (_end_with(file_name, ".hdr")) {
         std::stringstream ss;
         ss << tablet_id << ".hdr";
         *new_file_name = ss.str();
         return Status::OK();
-    } else if (_end_with(file_name, ".idx") || _end_with(file_name, ".dat")) {
+    } else if (_end_with(file_name, ".idx") || _end_with(file_name, ".dat") || _end_with(file_name, ".cold")) {
         *new_file_name = file_name;
         return Status::OK();
     } else {
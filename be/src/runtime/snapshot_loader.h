@@ -49,12 +49,17 @@ struct FileStat {
  * Each call of upload() is reponsible for severval tablet snapshots.
  *
  * It will try to get the existing files in remote storage,
- * and only upload the incremental part of files.
+ * and only upload the incremental part of files. With
+ * snapshot_upload_trust_remote_segments, the segment files already
+ * uploaded by a previous backup are reused without being read again,
+ * as they are named by the unique rowset ids.
+ * The files are uploaded by several threads.
  *
  * Download:
  * download() will download the romote tablet snapshot files 
  * to local snapshot dir via broker.
  * It will also only download files which does not exist in local dir.
+ * The files of a tablet are downloaded by several threads.
  *
  * Move:
  * move() is the final step of restore process. it will replace the 
@@ -77,21 +82,37 @@ public:
 
     Status move(const std::string& snapshot_path, const TabletSharedPtr& tablet, bool overwrite);
 
+#ifdef BE_TEST
+    // the client of the listing and renaming rpcs, the files are read and written by EnvBroker.
+    static void TEST_set_broker_client(TFileBrokerServiceClient* client);
+#endif
+
 private:
     Status _get_tablet_id_and_schema_hash_from_file_path(const std::string& src_path, int64_t* tablet_id,
                                                          int32_t* schema_hash);
 
     Status _check_local_snapshot_paths(const std::map<std::string, std::string>& src_to_dest_path, bool check_src);
 
-    Status _get_existing_files_from_remote(BrokerServiceConnection& client, const std::string& remote_path,
+    Status _get_existing_files_from_remote(const TNetworkAddress& broker_addr, const std::string& remote_path,
                                            const std::map<std::string, std::string>& broker_prop,
                                            std::map<std::string, FileStat>* files);
 
     Status _get_existing_files_from_local(const std::string& local_path, std::vector<std::string>* local_files);
 
-    Status _rename_remote_file(BrokerServiceConnection& client, const std::string& orig_name,
+    Status _upload_file(const TNetworkAddress& broker_addr, const std::map<std::string, std::string>& broker_prop,
+                        const std::string& src_path, const std::string& dest_path, const std::string& local_file,
+                        const std::map<std::string, FileStat>& remote_files, std::string* md5sum);
+
+    Status _download_file(const TNetworkAddress& broker_addr, const std::map<std::string, std::string>& broker_prop,
+                          const std::string& remote_path, const std::string& local_path, int64_t local_tablet_id,
+                          const FileStat& file_stat, const std::vector<std::string>& local_files, DataDir* data_dir);
+
+    Status _rename_remote_file(const TNetworkAddress& broker_addr, const std::string& orig_name,
                                const std::string& new_name, const std::map<std::string, std::string>& broker_prop);
 
+    // Whether the file is a segment file of a rowset whose id is unique among the backends.
+    bool _is_rowset_segment_file(const std::string& file_name);
+
     bool _end_with(const std::string& str, const std::string& match);
 
     void _assemble_file_name(const std::string& snapshot_path, const std::string& tablet_path, int64_t tablet_id,
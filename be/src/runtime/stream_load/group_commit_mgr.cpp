@@ -0,0 +1,286 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "runtime/stream_load/group_commit_mgr.h"
+
+#include <thrift/protocol/TDebugProtocol.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <future>
+
+#include "common/config.h"
+#include "common/logging.h"
+#include "gen_cpp/FrontendService.h"
+#include "gen_cpp/FrontendService_types.h"
+#include "runtime/client_cache.h"
+#include "runtime/exec_env.h"
+#include "runtime/stream_load/load_stream_mgr.h"
+#include "runtime/stream_load/stream_load_context.h"
+#include "runtime/stream_load/stream_load_executor.h"
+#include "runtime/stream_load/stream_load_pipe.h"
+#include "util/thrift_rpc_helper.h"
+#include "util/uid_util.h"
+
+namespace starrocks {
+
+#ifdef BE_TEST
+extern TStreamLoadPutResult k_stream_load_put_result;
+#endif
+
+struct GroupCommitMgr::Group {
+    enum State { OPENING, OPEN, CLOSED };
+
+    ~Group() {
+        if (ctx != nullptr && ctx->unref()) {
+            delete ctx;
+        }
+    }
+
+    std::mutex lock;
+    std::condition_variable cond;
+    State state = OPENING;
+    Status open_status;
+    // the load context of the transaction of the group.
+    StreamLoadContext* ctx = nullptr;
+    // the bytes and the number of the loads appended.
+    size_t bytes = 0;
+    int num_loads = 0;
+
+    std::promise<Status> promise;
+    std::shared_future<Status> committed = promise.get_future().share();
+};
+
+// Read the whole body in the finished pipe |body| into |data|.
+static Status read_body(StreamLoadPipe* body, std::string* data) {
+    while (true) {
+        ByteBufferPtr buf;
+        RETURN_IF_ERROR(body->read_buffer(&buf));
+        if (buf == nullptr) {
+            break;
+        }
+        data->append(buf->ptr + buf->pos, buf->remaining());
+    }
+    return Status::OK();
+}
+
+// Append the body |data| to |pipe| as whole records.
+static Status append_body(StreamLoadPipe* pipe, const std::string& data, size_t* bytes) {
+    if (data.empty()) {
+        return Status::OK();
+    }
+    RETURN_IF_ERROR(pipe->append(data.data(), data.size()));
+    *bytes += data.size();
+    // the next body starts with a new record.
+    if (data.back() != '\n') {
+        RETURN_IF_ERROR(pipe->append("\n", 1));
+    }
+    return Status::OK();
+}
+
+// The status of the plan fragment of a load whose filter ratio is exceeded, see StreamLoadExecutor.
+static bool is_too_many_filtered_rows(const Status& st) {
+    return st.code() == TStatusCode::INTERNAL_ERROR && st.get_error_msg() == "too many filtered rows";
+}
+
+Status GroupCommitMgr::load(StreamLoadContext* ctx, const TStreamLoadPutRequest& request, StreamLoadPipe* body) {
+    std::string data;
+    RETURN_IF_ERROR(read_body(body, &data));
+    Status st = _load_in_group(ctx, request, data);
+    if (is_too_many_filtered_rows(st)) {
+        // The filtered rows of a group are not counted per load, so a group fails once any of its rows is
+        // filtered, and every load of it is loaded again in a transaction of its own with its own
+        // max_filter_ratio. Only the malformed loads fail then.
+        LOG(INFO) << "group commit filtered rows, load alone. label=" << ctx->label;
+        st = _load_alone(ctx, request, data);
+    }
+    return st;
+}
+
+Status GroupCommitMgr::_load_in_group(StreamLoadContext* ctx, const TStreamLoadPutRequest& request,
+                                      const std::string& data) {
+    // The loads of a group are executed by the same plan in the transaction begun with the same auth.
+    TStreamLoadPutRequest key_request(request);
+    key_request.__set_loadId(TUniqueId());
+    key_request.txnId = 0;
+    const std::string key = apache::thrift::ThriftDebugString(key_request);
+
+    while (true) {
+        std::shared_ptr<Group> group;
+        bool leader = false;
+        {
+            std::lock_guard<std::mutex> l(_lock);
+            auto& g = _groups[key];
+            if (g == nullptr) {
+                g = std::make_shared<Group>();
+                leader = true;
+            }
+            group = g;
+        }
+        if (leader) {
+            Status st = _open_group(group.get(), ctx, request, 0 /* max_filter_ratio */);
+            if (!st.ok()) {
+                std::lock_guard<std::mutex> l(_lock);
+                _groups.erase(key);
+            }
+            {
+                std::lock_guard<std::mutex> l(group->lock);
+                group->state = st.ok() ? Group::OPEN : Group::CLOSED;
+                group->open_status = st;
+            }
+            group->cond.notify_all();
+        }
+
+        Status st;
+        {
+            std::unique_lock<std::mutex> l(group->lock);
+            group->cond.wait(l, [&group] { return group->state != Group::OPENING; });
+            if (!group->open_status.ok()) {
+                return group->open_status;
+            }
+            if (group->state == Group::CLOSED) {
+                // the group is being committed, load with the next group.
+                continue;
+            }
+            st = append_body(static_cast<StreamLoadPipe*>(group->ctx->body_sink.get()), data, &group->bytes);
+            ++group->num_loads;
+            if (group->bytes >= static_cast<size_t>(config::group_commit_max_bytes)) {
+                group->cond.notify_all();
+            }
+        }
+        // The first load commits the group even if its body failed to be appended, which the other loads wait for.
+        if (leader) {
+            _close_group(key, group.get());
+            _commit_group(group.get());
+        }
+        if (st.ok()) {
+            st = group->committed.get();
+        }
+        ctx->txn_id = group->ctx->txn_id;
+        return st;
+    }
+}
+
+Status GroupCommitMgr::_load_alone(StreamLoadContext* ctx, const TStreamLoadPutRequest& request,
+                                   const std::string& data) {
+    Group group;
+    RETURN_IF_ERROR(_open_group(&group, ctx, request, ctx->max_filter_ratio));
+    group.num_loads = 1;
+    Status st = append_body(static_cast<StreamLoadPipe*>(group.ctx->body_sink.get()), data, &group.bytes);
+    if (!st.ok()) {
+        group.ctx->body_sink->cancel();
+    }
+    Status commit_st = _commit_group(&group);
+    if (st.ok()) {
+        st = commit_st;
+    }
+    const StreamLoadContext* group_ctx = group.ctx;
+    ctx->txn_id = group_ctx->txn_id;
+    ctx->number_total_rows = group_ctx->number_total_rows;
+    ctx->number_loaded_rows = group_ctx->number_loaded_rows;
+    ctx->number_filtered_rows = group_ctx->number_filtered_rows;
+    ctx->number_unselected_rows = group_ctx->number_unselected_rows;
+    ctx->loaded_bytes = group_ctx->loaded_bytes;
+    ctx->error_url = group_ctx->error_url;
+    return st;
+}
+
+Status GroupCommitMgr::_open_group(Group* group, StreamLoadContext* ctx, const TStreamLoadPutRequest& request,
+                                   double max_filter_ratio) {
+    auto* group_ctx = new StreamLoadContext(_exec_env);
+    group_ctx->ref();
+    group->ctx = group_ctx;
+
+    group_ctx->load_type = TLoadType::MANUAL_LOAD;
+    group_ctx->load_src_type = TLoadSourceType::RAW;
+    group_ctx->db = ctx->db;
+    group_ctx->table = ctx->table;
+    group_ctx->label = "group_commit_" + generate_uuid_string();
+    group_ctx->auth = ctx->auth;
+    group_ctx->timeout_second = ctx->timeout_second;
+    group_ctx->max_filter_ratio = max_filter_ratio;
+    group_ctx->format = ctx->format;
+    group_ctx->use_streaming = true;
+    RETURN_IF_ERROR(_exec_env->stream_load_executor()->begin_txn(group_ctx));
+
+    Status st = _execute_group(group_ctx, request);
+    if (!st.ok()) {
+        // no load is appended to the group yet.
+        _exec_env->load_stream_mgr()->remove(group_ctx->id);
+        if (group_ctx->body_sink != nullptr) {
+            group_ctx->body_sink->cancel();
+        }
+        if (group_ctx->need_rollback) {
+            _exec_env->stream_load_executor()->rollback_txn(group_ctx);
+            group_ctx->need_rollback = false;
+        }
+    }
+    return st;
+}
+
+Status GroupCommitMgr::_execute_group(StreamLoadContext* group_ctx, const TStreamLoadPutRequest& request) {
+    auto pipe = std::make_shared<StreamLoadPipe>(1024 * 1024 /* max_buffered_bytes */, 64 * 1024 /* min_chunk_size */);
+    RETURN_IF_ERROR(_exec_env->load_stream_mgr()->put(group_ctx->id, pipe));
+    group_ctx->body_sink = pipe;
+
+    TStreamLoadPutRequest put_request(request);
+    put_request.txnId = group_ctx->txn_id;
+    put_request.__set_loadId(group_ctx->id.to_thrift());
+    put_request.fileType = TFileType::FILE_STREAM;
+#ifndef BE_TEST
+    TNetworkAddress master_addr = _exec_env->master_info()->network_address;
+    RETURN_IF_ERROR(ThriftRpcHelper::rpc<FrontendServiceClient>(
+            master_addr.hostname, master_addr.port, [&put_request, group_ctx](FrontendServiceConnection& client) {
+                client->streamLoadPut(group_ctx->put_result, put_request);
+            }));
+#else
+    group_ctx->put_result = k_stream_load_put_result;
+#endif
+    Status plan_status(group_ctx->put_result.status);
+    if (!plan_status.ok()) {
+        LOG(WARNING) << "plan group commit load failed. errmsg=" << plan_status.get_error_msg()
+                     << group_ctx->brief();
+        return plan_status;
+    }
+    return _exec_env->stream_load_executor()->execute_plan_fragment(group_ctx);
+}
+
+void GroupCommitMgr::_close_group(const std::string& key, Group* group) {
+    {
+        std::unique_lock<std::mutex> l(group->lock);
+        group->cond.wait_for(l, std::chrono::milliseconds(config::group_commit_interval_ms),
+                             [group] { return group->bytes >= static_cast<size_t>(config::group_commit_max_bytes); });
+    }
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        _groups.erase(key);
+    }
+    {
+        // the loads not appended yet go to the next group.
+        std::lock_guard<std::mutex> l(group->lock);
+        group->state = Group::CLOSED;
+    }
+}
+
+Status GroupCommitMgr::_commit_group(Group* group) {
+    StreamLoadContext* ctx = group->ctx;
+    Status st = ctx->body_sink->finish();
+    if (st.ok()) {
+        st = ctx->future.get();
+    }
+    if (st.ok()) {
+        st = _exec_env->stream_load_executor()->commit_txn(ctx);
+    }
+    if (!st.ok() && st.code() != TStatusCode::PUBLISH_TIMEOUT) {
+        ctx->body_sink->cancel();
+        if (ctx->need_rollback) {
+            _exec_env->stream_load_executor()->rollback_txn(ctx);
+            ctx->need_rollback = false;
+        }
+    }
+    LOG(INFO) << "group commit finished. label=" << ctx->label << ", txn_id=" << ctx->txn_id
+              << ", loads=" << group->num_loads << ", bytes=" << group->bytes << ", status=" << st.to_string();
+    group->promise.set_value(st);
+    return st;
+}
+
+} // namespace starrocks
@@ -0,0 +1,72 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "common/status.h"
+
+namespace starrocks {
+
+class ExecEnv;
+class StreamLoadContext;
+class StreamLoadPipe;
+class TStreamLoadPutRequest;
+
+// Loads the small stream loads of the same table and the same load properties in one transaction, instead of a
+// transaction, a rowset per tablet and a publish for each of them.
+//
+// The first load of a group begins the transaction of the group and executes its plan fragment, which reads the
+// pipe of the group. The bodies of the loads are appended to the pipe one after another as soon as they are
+// received, and the first load commits the transaction once config::group_commit_interval_ms has passed or
+// config::group_commit_max_bytes have been appended. Every load of the group replies after the group is
+// committed, so a load is never acknowledged before its data is visible and there is nothing to recover on
+// restart: a load of a failed group fails as a whole, and is retried by its client.
+//
+// The filtered rows are counted for the whole group, so a group fails if any of its rows is filtered, and then
+// each of its loads is loaded again alone with its own max_filter_ratio. The loads of a group share the label of
+// the group, so the loads with labels of their own are rejected by StreamLoadAction.
+class GroupCommitMgr {
+public:
+    explicit GroupCommitMgr(ExecEnv* exec_env) : _exec_env(exec_env) {}
+
+    ~GroupCommitMgr() = default;
+
+    // Load the body of |ctx| in the finished pipe |body| with the group of |request|, and wait for the group to
+    // be committed.
+    Status load(StreamLoadContext* ctx, const TStreamLoadPutRequest& request, StreamLoadPipe* body);
+
+private:
+    struct Group;
+
+    // Load |data| with the group of |request|, and wait for the group to be committed.
+    Status _load_in_group(StreamLoadContext* ctx, const TStreamLoadPutRequest& request, const std::string& data);
+
+    // Load |data| in a transaction of its own with the max_filter_ratio of |ctx|.
+    Status _load_alone(StreamLoadContext* ctx, const TStreamLoadPutRequest& request, const std::string& data);
+
+    // Begin the transaction of |group| and execute its plan fragment with the properties of |request|. The
+    // transaction is rolled back if the plan fragment fails to be executed.
+    Status _open_group(Group* group, StreamLoadContext* ctx, const TStreamLoadPutRequest& request,
+                       double max_filter_ratio);
+
+    // Register the pipe of the transaction of |group_ctx|, plan it and execute its plan fragment.
+    Status _execute_group(StreamLoadContext* group_ctx, const TStreamLoadPutRequest& request);
+
+    // Wait for the group to be full, and then stop appending loads to it.
+    void _close_group(const std::string& key, Group* group);
+
+    // Commit the transaction of the group, or roll it back on failure, and notify the loads of it.
+    Status _commit_group(Group* group);
+
+    ExecEnv* _exec_env;
+
+    std::mutex _lock;
+    // the open groups by their load properties.
+    std::unordered_map<std::string, std::shared_ptr<Group>> _groups;
+};
+
+} // namespace starrocks
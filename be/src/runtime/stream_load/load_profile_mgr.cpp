@@ -0,0 +1,78 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "runtime/stream_load/load_profile_mgr.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "common/config.h"
+#include "runtime/stream_load/stream_load_context.h"
+#include "util/runtime_profile.h"
+
+namespace starrocks {
+
+LoadProfileMgr* LoadProfileMgr::instance() {
+    static LoadProfileMgr mgr;
+    return &mgr;
+}
+
+std::string LoadProfileMgr::to_string(const StreamLoadContext* ctx) {
+    RuntimeProfile profile("Load");
+    profile.add_info_string("Label", ctx->label);
+    profile.add_info_string("TxnId", std::to_string(ctx->txn_id));
+    profile.add_info_string("Status", ctx->status.ok() ? "OK" : ctx->status.get_error_msg());
+    COUNTER_SET(ADD_TIMER(&profile, "BeginTxnTime"), ctx->begin_txn_cost_nanos);
+    COUNTER_SET(ADD_TIMER(&profile, "StreamLoadPutTime"), ctx->stream_load_put_cost_nanos);
+    COUNTER_SET(ADD_TIMER(&profile, "ReadDataTime"), ctx->read_data_cost_nanos);
+    COUNTER_SET(ADD_TIMER(&profile, "WriteDataTime"), ctx->write_data_cost_nanos);
+    COUNTER_SET(ADD_TIMER(&profile, "CommitAndPublishTime"), ctx->commit_and_publish_txn_cost_nanos);
+    COUNTER_SET(ADD_TIMER(&profile, "LoadTime"), ctx->load_cost_nanos);
+    COUNTER_SET(ADD_COUNTER(&profile, "ReceivedBytes", TUnit::BYTES), static_cast<int64_t>(ctx->receive_bytes));
+    COUNTER_SET(ADD_COUNTER(&profile, "LoadedBytes", TUnit::BYTES), ctx->loaded_bytes);
+    COUNTER_SET(ADD_COUNTER(&profile, "TotalRows", TUnit::UNIT), ctx->number_total_rows);
+    COUNTER_SET(ADD_COUNTER(&profile, "LoadedRows", TUnit::UNIT), ctx->number_loaded_rows);
+    COUNTER_SET(ADD_COUNTER(&profile, "FilteredRows", TUnit::UNIT), ctx->number_filtered_rows);
+    COUNTER_SET(ADD_COUNTER(&profile, "UnselectedRows", TUnit::UNIT), ctx->number_unselected_rows);
+
+    std::stringstream ss;
+    profile.pretty_print(&ss);
+    ss << ctx->fragment_profile;
+    return ss.str();
+}
+
+void LoadProfileMgr::add(const StreamLoadContext* ctx) {
+    if (!config::enable_load_profile) {
+        return;
+    }
+    std::string profile = to_string(ctx);
+    std::lock_guard<std::mutex> l(_lock);
+    // The label of a load retried after failing is the same.
+    _profiles.remove_if([ctx](const auto& entry) { return entry.first == ctx->label; });
+    _profiles.emplace_front(ctx->label, std::move(profile));
+    while (_profiles.size() > static_cast<size_t>(std::max(config::load_profile_max_num, 1))) {
+        _profiles.pop_back();
+    }
+}
+
+bool LoadProfileMgr::get(const std::string& label, std::string* profile) {
+    std::lock_guard<std::mutex> l(_lock);
+    for (const auto& [entry_label, entry_profile] : _profiles) {
+        if (entry_label == label) {
+            *profile = entry_profile;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<std::string> LoadProfileMgr::labels() {
+    std::lock_guard<std::mutex> l(_lock);
+    std::vector<std::string> labels;
+    labels.reserve(_profiles.size());
+    for (const auto& entry : _profiles) {
+        labels.emplace_back(entry.first);
+    }
+    return labels;
+}
+
+} // namespace starrocks
@@ -0,0 +1,42 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace starrocks {
+
+class StreamLoadContext;
+
+// Keeps the profiles of the latest config::load_profile_max_num stream loads and routine load tasks, so the
+// time spent on each phase of a slow load can be looked up by its label after it finishes.
+//
+// A profile consists of the phases timed by StreamLoadContext, i.e. beginning the transaction, planning,
+// reading and writing the data and committing, followed by the profile of the plan fragment with the timers
+// of the scanner, OlapTableSink and the add_chunk rpcs reported by the receivers.
+class LoadProfileMgr {
+public:
+    static LoadProfileMgr* instance();
+
+    // Keep the profile of the finished load if config::enable_load_profile.
+    void add(const StreamLoadContext* ctx);
+
+    // Return false if the profile of the label isn't kept.
+    bool get(const std::string& label, std::string* profile);
+
+    // The labels of the loads whose profiles are kept, the latest first.
+    std::vector<std::string> labels();
+
+    static std::string to_string(const StreamLoadContext* ctx);
+
+private:
+    std::mutex _lock;
+    // label -> profile
+    std::list<std::pair<std::string, std::string>> _profiles;
+};
+
+} // namespace starrocks
@@ -155,6 +155,8 @@ public:
     // when use_streaming is true, we use stream_pipe to send source data,
     // otherwise we save source data to file first, then process it.
     bool use_streaming = false;
+    // whether the body is loaded in the transaction of a group of loads, see GroupCommitMgr.
+    bool group_commit = false;
     TFileFormatType::type format = TFileFormatType::FORMAT_CSV_PLAIN;
 
     std::shared_ptr<MessageBodySink> body_sink;
@@ -181,6 +183,8 @@ public:
     int64_t commit_and_publish_txn_cost_nanos = 0;
     int64_t read_data_cost_nanos = 0;
     int64_t write_data_cost_nanos = 0;
+    // the profile of the plan fragment, only set if config::enable_load_profile.
+    std::string fragment_profile;
 
     std::string error_url;
     // if label already be used, set existing job's status here
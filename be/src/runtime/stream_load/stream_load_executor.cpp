@@ -21,6 +21,7 @@
 
 #include "runtime/stream_load/stream_load_executor.h"
 
+#include "common/config.h"
 #include "common/status.h"
 #include "common/utils.h"
 #include "gen_cpp/FrontendService.h"
@@ -101,6 +102,11 @@ Status StreamLoadExecutor::execute_plan_fragment(StreamLoadContext* ctx) {
                     }
                 }
                 ctx->write_data_cost_nanos = MonotonicNanos() - ctx->start_write_data_nanos;
+                if (config::enable_load_profile) {
+                    std::stringstream ss;
+                    executor->profile()->pretty_print(&ss);
+                    ctx->fragment_profile = ss.str();
+                }
                 ctx->promise.set_value(status);
 
                 if (ctx->unref()) {
@@ -30,7 +30,12 @@
 #include "storage/memtable.h"
 #include "storage/vectorized/delta_writer.h"
 #include "storage/vectorized/memtable.h"
+#include "util/block_compression.h"
+#include "util/defer_op.h"
+#include "util/faststring.h"
+#include "util/runtime_profile.h"
 #include "util/starrocks_metrics.h"
+#include "util/stopwatch.hpp"
 
 namespace starrocks {
 
@@ -119,7 +124,7 @@ Status TabletsChannel::add_batch(const PTabletWriterAddBatchRequest& params) {
     return Status::OK();
 }
 
-Status TabletsChannel::add_chunk(const PTabletWriterAddChunkRequest& params) {
+Status TabletsChannel::add_chunk(const PTabletWriterAddChunkRequest& params, PTabletWriterAddBatchResult* response) {
     DCHECK(_is_vectorized == true);
     {
         std::lock_guard<std::mutex> l(_global_lock);
@@ -147,9 +152,29 @@ Status TabletsChannel::add_chunk(const PTabletWriterAddChunkRequest& params) {
         }
     }
 
+    int64_t deserialize_ns = 0;
+    int64_t write_memtable_ns = 0;
+    DeferOp report_time([&]() {
+        response->set_deserialize_time_us(response->deserialize_time_us() + deserialize_ns / 1000);
+        response->set_write_memtable_time_us(response->write_memtable_time_us() + write_memtable_ns / 1000);
+    });
+    MonotonicStopWatch watch;
+    watch.start();
     vectorized::Chunk chunk;
-    RETURN_IF_ERROR(chunk.deserialize((const uint8_t*)pchunk.data().data(), pchunk.data().size(), _chunk_meta));
+    if (pchunk.compress_type() == CompressionTypePB::NO_COMPRESSION) {
+        RETURN_IF_ERROR(chunk.deserialize((const uint8_t*)pchunk.data().data(), pchunk.data().size(), _chunk_meta));
+    } else {
+        const BlockCompressionCodec* codec = nullptr;
+        RETURN_IF_ERROR(get_block_compression_codec(pchunk.compress_type(), &codec));
+        size_t uncompressed_size = pchunk.uncompressed_size();
+        faststring uncompressed_buffer;
+        uncompressed_buffer.resize(uncompressed_size);
+        Slice output{uncompressed_buffer.data(), uncompressed_size};
+        RETURN_IF_ERROR(codec->decompress(pchunk.data(), &output));
+        RETURN_IF_ERROR(chunk.deserialize(uncompressed_buffer.data(), uncompressed_size, _chunk_meta));
+    }
     DCHECK_EQ(params.tablet_ids_size(), chunk.num_rows());
+    deserialize_ns = watch.elapsed_time();
 
     size_t channel_size = _tablet_id_to_sorted_indexes.size();
     std::vector<uint32_t> row_indexes(chunk.num_rows());
@@ -188,6 +213,7 @@ Status TabletsChannel::add_chunk(const PTabletWriterAddChunkRequest& params) {
         }
         {
             std::lock_guard<std::mutex> l(_tablet_locks[tablet_id & k_shard_size]);
+            SCOPED_RAW_TIMER(&write_memtable_ns);
             auto st = it->second->write(&chunk, row_indexes.data(), from, size);
             if (!st.ok()) {
                 return st;
@@ -330,6 +356,9 @@ Status TabletsChannel::close(int sender_id, bool* finished,
             // close may return failed, but no need to handle it here.
             // tablet_vec will only contains success tablet, and then let FE judge it.
             it.second->close_wait(tablet_vec);
+            _flush_stats.flush_time_ns += it.second->flush_stats().flush_time_ns;
+            _flush_stats.flush_count += it.second->flush_stats().flush_count;
+            _flush_stats.flush_size_bytes += it.second->flush_stats().flush_size_bytes;
         }
     }
 
@@ -394,6 +423,58 @@ Status TabletsChannel::reduce_mem_usage_async(const std::set<int64_t>& flush_tab
     return Status::OK();
 }
 
+void TabletsChannel::get_memtable_stats(std::vector<MemTableStat>* stats) {
+    std::vector<std::pair<int64_t, vectorized::DeltaWriter*>> vectorized_writers;
+    {
+        std::lock_guard<std::mutex> l(_global_lock);
+        if (_state == kFinished) {
+            return;
+        }
+        if (!_is_vectorized) {
+            for (auto& it : _tablet_writers) {
+                int64_t consumption = it.second->mem_consumption();
+                if (consumption > 0) {
+                    stats->push_back(MemTableStat{it.first, consumption, 0, false});
+                }
+            }
+            return;
+        }
+        vectorized_writers.assign(_vectorized_tablet_writers.begin(), _vectorized_tablet_writers.end());
+    }
+    for (auto& [tablet_id, writer] : vectorized_writers) {
+        // the memtable is replaced by the writes under the tablet lock.
+        std::lock_guard<std::mutex> l(_tablet_locks[tablet_id & k_shard_size]);
+        int64_t consumption = writer->mem_consumption();
+        int64_t memtable_consumption = writer->memtable_consumption();
+        if (consumption > memtable_consumption) {
+            stats->push_back(MemTableStat{tablet_id, consumption - memtable_consumption, 0, true});
+        } else if (memtable_consumption > 0) {
+            stats->push_back(MemTableStat{tablet_id, memtable_consumption, writer->memtable_age_ms(), false});
+        }
+    }
+}
+
+Status TabletsChannel::flush_memtable_async(int64_t tablet_id) {
+    vectorized::DeltaWriter* vectorized_writer = nullptr;
+    {
+        std::lock_guard<std::mutex> l(_global_lock);
+        if (_state == kFinished) {
+            return _close_status;
+        }
+        if (!_is_vectorized) {
+            auto it = _tablet_writers.find(tablet_id);
+            return it == _tablet_writers.end() ? Status::OK() : it->second->flush_memtable_async();
+        }
+        auto it = _vectorized_tablet_writers.find(tablet_id);
+        if (it == _vectorized_tablet_writers.end()) {
+            return Status::OK();
+        }
+        vectorized_writer = it->second;
+    }
+    std::lock_guard<std::mutex> l(_tablet_locks[tablet_id & k_shard_size]);
+    return vectorized_writer->flush_memtable_async();
+}
+
 Status TabletsChannel::wait_mem_usage_reduced(int64_t tablet_id) {
     vectorized::DeltaWriter* vectorized_writer = nullptr;
     {
@@ -469,6 +550,7 @@ Status TabletsChannel::_open_all_writers(const PTabletWriterOpenRequest& params)
             request.tuple_desc = _tuple_desc;
             request.slots = index_slots;
             request.global_dicts = &_global_dicts;
+            request.input_sorted = params.input_sorted();
 
             vectorized::DeltaWriter* writer = nullptr;
             auto st = vectorized::DeltaWriter::open(&request, _mem_tracker.get(), &writer);
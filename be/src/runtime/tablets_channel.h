@@ -19,6 +19,8 @@
 // specific language governing permissions and limitations
 // under the License.
 
+#pragma once
+
 #include <cstdint>
 #include <unordered_map>
 #include <utility>
@@ -31,6 +33,7 @@
 #include "runtime/descriptors.h"
 #include "runtime/global_dicts.h"
 #include "runtime/mem_tracker.h"
+#include "storage/memtable_flush_executor.h"
 #include "util/bitmap.h"
 #include "util/priority_thread_pool.hpp"
 #include "util/uid_util.h"
@@ -59,6 +62,16 @@ std::ostream& operator<<(std::ostream& os, const TabletsChannelKey& key);
 class DeltaWriter;
 class OlapTableSchemaParam;
 
+// The memtables of a tablet that may be flushed to reduce the memory of the loads.
+struct MemTableStat {
+    int64_t tablet_id = -1;
+    // the memory of the memtable being written, or of the memtables in the flush queue if |flushing|.
+    int64_t mem_consumption = 0;
+    int64_t age_ms = 0;
+    // there are memtables in the flush queue already, a flush is a no-op until they're flushed.
+    bool flushing = false;
+};
+
 // Write channel for a particular (load, index).
 class TabletsChannel {
 public:
@@ -71,8 +84,9 @@ public:
     // no-op when this channel has been closed or cancelled
     Status add_batch(const PTabletWriterAddBatchRequest& batch);
 
-    // no-op when this channel has been closed or cancelled
-    Status add_chunk(const PTabletWriterAddChunkRequest& batch);
+    // no-op when this channel has been closed or cancelled.
+    // The time spent on deserializing and writing memtables is added into |response|.
+    Status add_chunk(const PTabletWriterAddChunkRequest& batch, PTabletWriterAddBatchResult* response);
 
     // Mark sender with 'sender_id' as closed.
     // If all senders are closed, close this channel, set '*finished' to true, update 'tablet_vec'
@@ -93,8 +107,18 @@ public:
     // wait tablet memtables in flush queue to be flushed.
     Status wait_mem_usage_reduced(int64_t tablet_id);
 
+    // appends the memtables of the tablets of this channel, for LoadChannelMgr to choose the
+    // ones to flush across all the loads.
+    void get_memtable_stats(std::vector<MemTableStat>* stats);
+    // submit the memtable of |tablet_id| to flush queue.
+    // no-op when this channel has been closed or cancelled.
+    Status flush_memtable_async(int64_t tablet_id);
+
     int64_t mem_consumption() const { return _mem_tracker->consumption(); }
 
+    // the memtables flushed by the delta writers, available once close() finishes this channel.
+    const FlushStatistic& flush_stats() const { return _flush_stats; }
+
 private:
     // open all writer
     Status _open_all_writers(const PTabletWriterOpenRequest& params);
@@ -146,6 +170,7 @@ private:
     std::unordered_map<int64_t, uint32_t> _tablet_id_to_sorted_indexes;
     // tablet_id -> TabletChannel
     std::unordered_map<int64_t, vectorized::DeltaWriter*> _vectorized_tablet_writers;
+    FlushStatistic _flush_stats;
 
     vectorized::GlobalDictByNameMaps _global_dicts;
     std::unique_ptr<MemPool> _mem_pool;
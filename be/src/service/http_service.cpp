@@ -21,12 +21,16 @@
 
 #include "service/http_service.h"
 
+#include "common/config.h"
 #include "http/action/checksum_action.h"
 #include "http/action/compaction_action.h"
 #include "http/action/health_action.h"
+#include "http/action/load_profile_action.h"
 #include "http/action/meta_action.h"
 #include "http/action/metrics_action.h"
+#include "http/action/pipeline_driver_trace_action.h"
 #include "http/action/pprof_actions.h"
+#include "http/action/query_cpu_profile_action.h"
 #include "http/action/reload_tablet_action.h"
 #include "http/action/restore_tablet_action.h"
 #include "http/action/snapshot_action.h"
@@ -47,7 +51,12 @@ namespace starrocks {
 HttpService::HttpService(ExecEnv* env, int port, int num_threads)
         : _env(env),
           _ev_http_server(new EvHttpServer(port, num_threads)),
-          _web_page_handler(new WebPageHandler(_ev_http_server.get())) {}
+          _web_page_handler(new WebPageHandler(_ev_http_server.get())) {
+    if (config::webserver_admin_port > 0) {
+        _admin_http_server = std::make_unique<EvHttpServer>(config::webserver_admin_port,
+                                                            config::webserver_admin_num_workers);
+    }
+}
 
 HttpService::~HttpService() = default;
 
@@ -78,6 +87,9 @@ Status HttpService::start() {
     // Register BE health action
     HealthAction* health_action = new HealthAction(_env);
     _ev_http_server->register_handler(HttpMethod::GET, "/api/health", health_action);
+    if (_admin_http_server != nullptr) {
+        _admin_http_server->register_handler(HttpMethod::GET, "/api/health", health_action);
+    }
 
     // register pprof actions
     PprofActions::setup(_env, _ev_http_server.get());
@@ -86,6 +98,9 @@ Status HttpService::start() {
     {
         auto action = new MetricsAction(StarRocksMetrics::instance()->metrics());
         _ev_http_server->register_handler(HttpMethod::GET, "/metrics", action);
+        if (_admin_http_server != nullptr) {
+            _admin_http_server->register_handler(HttpMethod::GET, "/metrics", action);
+        }
     }
 
     MetaAction* meta_action = new MetaAction(HEADER);
@@ -117,7 +132,19 @@ Status HttpService::start() {
     UpdateConfigAction* update_config_action = new UpdateConfigAction(_env);
     _ev_http_server->register_handler(HttpMethod::POST, "/api/update_config", update_config_action);
 
+    auto* pipeline_driver_trace_action = new PipelineDriverTraceAction();
+    _ev_http_server->register_handler(HttpMethod::GET, "/api/pipeline/driver_trace", pipeline_driver_trace_action);
+
+    auto* query_cpu_profile_action = new QueryCpuProfileAction();
+    _ev_http_server->register_handler(HttpMethod::GET, "/api/query_cpu_profile", query_cpu_profile_action);
+
+    auto* load_profile_action = new LoadProfileAction();
+    _ev_http_server->register_handler(HttpMethod::GET, "/api/load_profile", load_profile_action);
+
     RETURN_IF_ERROR(_ev_http_server->start());
+    if (_admin_http_server != nullptr) {
+        RETURN_IF_ERROR(_admin_http_server->start());
+    }
     return Status::OK();
 }
 
@@ -43,6 +43,8 @@ private:
     ExecEnv* _env;
 
     std::unique_ptr<EvHttpServer> _ev_http_server;
+    // serves the monitoring endpoints apart from the load traffic, if config::webserver_admin_port is set.
+    std::unique_ptr<EvHttpServer> _admin_http_server;
     std::unique_ptr<WebPageHandler> _web_page_handler;
 };
 
@@ -21,10 +21,14 @@
 
 #include "service/internal_service.h"
 
+#include <algorithm>
+
+#include "column/binary_column.h"
 #include "common/config.h"
 #include "exec/pipeline/fragment_context.h"
 #include "exec/pipeline/fragment_executor.h"
 #include "gen_cpp/BackendService.h"
+#include "gutil/casts.h"
 #include "gutil/strings/substitute.h"
 #include "runtime/buffer_control_block.h"
 #include "runtime/data_stream_mgr.h"
@@ -35,7 +39,14 @@
 #include "runtime/routine_load/routine_load_task_executor.h"
 #include "runtime/runtime_filter_worker.h"
 #include "service/brpc.h"
+#include "storage/storage_engine.h"
+#include "storage/tablet_manager.h"
+#include "storage/tablet_updates.h"
+#include "storage/vectorized/chunk_helper.h"
+#include "util/coding.h"
+#include "util/starrocks_metrics.h"
 #include "util/thrift_util.h"
+#include "util/time.h"
 #include "util/uid_util.h"
 
 namespace starrocks {
@@ -83,23 +94,17 @@ void PInternalServiceImpl<T>::transmit_chunk(google::protobuf::RpcController* cn
                                              google::protobuf::Closure* done) {
     VLOG_ROW << "transmit data: fragment_instance_id=" << print_id(request->finst_id())
              << " node=" << request->node_id();
+    int64_t start_ns = MonotonicNanos();
     // NOTE: we should give a default value to response to avoid concurrent risk
     // If we don't give response here, stream manager will call done->Run before
     // transmit_data(), which will cause a dirty memory access.
     brpc::Controller* cntl = static_cast<brpc::Controller*>(cntl_base);
-    PTransmitChunkParams* req = const_cast<PTransmitChunkParams*>(request);
-    if (cntl->request_attachment().size() > 0) {
-        const butil::IOBuf& io_buf = cntl->request_attachment();
-        size_t offset = 0;
-        for (size_t i = 0; i < req->chunks().size(); ++i) {
-            auto chunk = req->mutable_chunks(i);
-            io_buf.copy_to(chunk->mutable_data(), chunk->data_size(), offset);
-            offset += chunk->data_size();
-        }
-    }
+    // The chunks are deserialized from the blocks of attachment directly, instead of being copied to ChunkPB first.
+    butil::IOBuf* attachment = cntl->request_attachment().size() > 0 ? &cntl->request_attachment() : nullptr;
     Status st;
     st.to_protobuf(response->mutable_status());
-    st = _exec_env->stream_mgr()->transmit_chunk(*request, &done);
+    st = _exec_env->stream_mgr()->transmit_chunk(*request, response, &done, attachment);
+    StarRocksMetrics::instance()->transmit_chunk_latency_us.record((MonotonicNanos() - start_ns) / 1000);
     if (!st.ok()) {
         LOG(WARNING) << "transmit_data failed, message=" << st.get_error_msg()
                      << ", fragment_instance_id=" << print_id(request->finst_id()) << ", node=" << request->node_id();
@@ -153,6 +158,20 @@ void PInternalServiceImpl<T>::exec_plan_fragment(google::protobuf::RpcController
     st.to_protobuf(response->mutable_status());
 }
 
+template <typename T>
+void PInternalServiceImpl<T>::exec_batch_plan_fragments(google::protobuf::RpcController* cntl_base,
+                                                        const PExecBatchPlanFragmentsRequest* request,
+                                                        PExecBatchPlanFragmentsResult* response,
+                                                        google::protobuf::Closure* done) {
+    brpc::ClosureGuard closure_guard(done);
+    brpc::Controller* cntl = static_cast<brpc::Controller*>(cntl_base);
+    auto st = _exec_batch_plan_fragments(cntl);
+    if (!st.ok()) {
+        LOG(WARNING) << "exec batch plan fragments failed, errmsg=" << st.get_error_msg();
+    }
+    st.to_protobuf(response->mutable_status());
+}
+
 template <typename T>
 void PInternalServiceImpl<T>::tablet_writer_add_batch(google::protobuf::RpcController* controller,
                                                       const PTabletWriterAddBatchRequest* request,
@@ -199,8 +218,7 @@ void PInternalServiceImpl<T>::tablet_writer_add_chunk(google::protobuf::RpcContr
         int64_t wait_lock_time_ns = 0;
         {
             SCOPED_RAW_TIMER(&execution_time_ns);
-            auto st = _exec_env->load_channel_mgr()->add_chunk(*request, response->mutable_tablet_vec(),
-                                                               &wait_lock_time_ns);
+            auto st = _exec_env->load_channel_mgr()->add_chunk(*request, response, &wait_lock_time_ns);
             if (!st.ok()) {
                 LOG(WARNING) << "tablet writer add chunk failed, message=" << st.get_error_msg()
                              << ", id=" << print_id(request->id()) << ", index_id=" << request->index_id()
@@ -254,6 +272,42 @@ Status PInternalServiceImpl<T>::_exec_plan_fragment(brpc::Controller* cntl) {
     }
 }
 
+template <typename T>
+Status PInternalServiceImpl<T>::_exec_batch_plan_fragments(brpc::Controller* cntl) {
+    auto ser_request = cntl->request_attachment().to_string();
+    TExecBatchPlanFragmentsParams t_batch_requests;
+    {
+        const uint8_t* buf = (const uint8_t*)ser_request.data();
+        uint32_t len = ser_request.size();
+        RETURN_IF_ERROR(deserialize_thrift_msg(buf, &len, TProtocolType::BINARY, &t_batch_requests));
+    }
+    // The plan fragment and the descriptor table are deserialized only once for all the instances.
+    const auto& common_request = t_batch_requests.common_param;
+    bool is_pipeline = common_request.__isset.is_pipeline && common_request.is_pipeline;
+    LOG(INFO) << "exec batch plan fragments, query_id=" << print_id(common_request.params.query_id)
+              << ", coord=" << common_request.coord
+              << ", num_instances=" << t_batch_requests.unique_param_per_instance.size() << " is_pipeline "
+              << is_pipeline;
+    for (const auto& unique_request : t_batch_requests.unique_param_per_instance) {
+        if (is_pipeline) {
+            auto fragment_executor = std::make_unique<starrocks::pipeline::FragmentExecutor>();
+            auto status = fragment_executor->prepare(_exec_env, common_request, unique_request);
+            if (status.ok()) {
+                RETURN_IF_ERROR(fragment_executor->execute(_exec_env));
+            } else if (!status.is_duplicate_rpc_invocation()) {
+                return status;
+            }
+        } else {
+            // The non-pipeline engine keeps the whole request, so assemble it from the shared parts.
+            TExecPlanFragmentParams t_request = common_request;
+            t_request.__set_params(unique_request.params);
+            t_request.__set_backend_num(unique_request.backend_num);
+            RETURN_IF_ERROR(_exec_env->fragment_mgr()->exec_plan_fragment(t_request));
+        }
+    }
+    return Status::OK();
+}
+
 inline std::string cancel_reason_to_string(::starrocks::PPlanFragmentCancelReason reason) {
     switch (reason) {
     case LIMIT_REACH:
@@ -375,6 +429,129 @@ void PInternalServiceImpl<T>::get_info(google::protobuf::RpcController* controll
     Status::OK().to_protobuf(response->mutable_status());
 }
 
+template <typename T>
+void PInternalServiceImpl<T>::lookup_rows(google::protobuf::RpcController* controller,
+                                          const PLookupRowsRequest* request, PLookupRowsResult* response,
+                                          google::protobuf::Closure* done) {
+    // the lookup may wait for the version to be applied or load the primary index, which would hold the
+    // pthread under bthread, so it's put to a local thread pool as the tablet writer does.
+    bool offered = _tablet_worker_pool.offer([request, response, done, this]() {
+        brpc::ClosureGuard closure_guard(done);
+        auto st = _lookup_rows(*request, response);
+        if (!st.ok()) {
+            LOG(WARNING) << "lookup rows failed, tablet_id=" << request->tablet_id() << ", " << st.to_string();
+        }
+        st.to_protobuf(response->mutable_status());
+    });
+    if (!offered) {
+        brpc::ClosureGuard closure_guard(done);
+        Status::ServiceUnavailable("the tablet worker pool is shut down").to_protobuf(response->mutable_status());
+    }
+}
+
+// Deserialize a key column serialized by Column::serialize_column, the lengths in |data| are checked
+// before they are read, since the bytes come from the rpc.
+static Status deserialize_key_column(const std::string& data, vectorized::Column* column) {
+    const auto* src = reinterpret_cast<const uint8_t*>(data.data());
+    if (data.size() < sizeof(uint32_t)) {
+        return Status::InvalidArgument("truncated key column");
+    }
+    size_t expected_size = sizeof(uint32_t) + decode_fixed32_le(src);
+    if (column->is_binary()) {
+        // the bytes, then the offsets
+        if (data.size() < expected_size + sizeof(uint32_t)) {
+            return Status::InvalidArgument("truncated key column");
+        }
+        size_t offsets_size = decode_fixed32_le(src + expected_size);
+        expected_size += sizeof(uint32_t) + offsets_size;
+        if (offsets_size == 0 || offsets_size % sizeof(vectorized::BinaryColumn::Offset) != 0) {
+            return Status::InvalidArgument("invalid offsets of key column");
+        }
+    } else if (column->is_nullable() || column->is_constant() ||
+               (expected_size - sizeof(uint32_t)) % column->type_size() != 0) {
+        return Status::InvalidArgument("invalid key column");
+    }
+    if (data.size() != expected_size) {
+        return Status::InvalidArgument("invalid size of key column");
+    }
+    column->deserialize_column(src);
+    if (column->is_binary()) {
+        // every offset must be in the bytes, otherwise the values would be read out of bounds.
+        const auto& binary_column = down_cast<const vectorized::BinaryColumn&>(*column);
+        const auto& offsets = binary_column.get_offset();
+        if (offsets[0] != 0 || offsets.back() != binary_column.get_bytes().size() ||
+            !std::is_sorted(offsets.begin(), offsets.end())) {
+            return Status::InvalidArgument("invalid offsets of key column");
+        }
+    }
+    return Status::OK();
+}
+
+template <typename T>
+Status PInternalServiceImpl<T>::_lookup_rows(const PLookupRowsRequest& request, PLookupRowsResult* response) {
+    std::string err;
+    TabletSharedPtr tablet = StorageEngine::instance()->tablet_manager()->get_tablet(
+            request.tablet_id(), request.schema_hash(), false, &err);
+    if (tablet == nullptr) {
+        return Status::NotFound(strings::Substitute("tablet $0 not found: $1", request.tablet_id(), err));
+    }
+    if (tablet->updates() == nullptr) {
+        return Status::NotSupported(strings::Substitute("tablet $0 is not a primary key tablet", request.tablet_id()));
+    }
+    const TabletSchema& tablet_schema = tablet->tablet_schema();
+    if (static_cast<size_t>(request.keys_size()) != tablet_schema.num_key_columns()) {
+        return Status::InvalidArgument(strings::Substitute("expect $0 key columns, got $1",
+                                                           tablet_schema.num_key_columns(), request.keys_size()));
+    }
+    std::vector<ColumnId> cids(tablet_schema.num_columns());
+    for (uint32_t i = 0; i < cids.size(); i++) {
+        cids[i] = i;
+    }
+    auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema, cids);
+    vectorized::Columns key_columns;
+    std::vector<ColumnId> key_cids;
+    for (int i = 0; i < request.keys_size(); i++) {
+        const std::string& data = request.keys(i);
+        auto column = vectorized::ChunkHelper::column_from_field(*schema.field(i));
+        Status st = deserialize_key_column(data, column.get());
+        if (!st.ok()) {
+            return Status::InvalidArgument(strings::Substitute("key column $0: $1", i, st.get_error_msg()));
+        }
+        if (!key_columns.empty() && column->size() != key_columns[0]->size()) {
+            return Status::InvalidArgument("the key columns have different number of rows");
+        }
+        key_columns.emplace_back(std::move(column));
+        key_cids.push_back(i);
+    }
+    auto key_schema = std::make_shared<vectorized::Schema>(
+            vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema, key_cids));
+    vectorized::Chunk keys(std::move(key_columns), key_schema);
+
+    std::vector<uint32_t> column_ids(request.column_ids().begin(), request.column_ids().end());
+    std::vector<std::unique_ptr<vectorized::Column>> columns;
+    for (uint32_t cid : column_ids) {
+        if (cid >= tablet_schema.num_columns()) {
+            return Status::InvalidArgument(strings::Substitute("invalid column id $0", cid));
+        }
+        columns.emplace_back(vectorized::ChunkHelper::column_from_field(*schema.field(cid))->clone_empty());
+    }
+    std::vector<bool> found;
+    int64_t read_version = 0;
+    const int64_t timeout_ms = request.has_timeout_ms() ? request.timeout_ms() : 60000;
+    RETURN_IF_ERROR(tablet->updates()->get_rows_by_keys(keys, request.version(), timeout_ms, column_ids, &found,
+                                                        &columns, &read_version));
+    for (bool f : found) {
+        response->add_found(f);
+    }
+    for (auto& column : columns) {
+        std::string* data = response->add_columns();
+        data->resize(column->serialize_size());
+        column->serialize_column(reinterpret_cast<uint8_t*>(data->data()));
+    }
+    response->set_version(read_version);
+    return Status::OK();
+}
+
 template class PInternalServiceImpl<PInternalService>;
 template class PInternalServiceImpl<doris::PBackendService>;
 
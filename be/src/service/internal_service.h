@@ -54,6 +54,10 @@ public:
     void exec_plan_fragment(google::protobuf::RpcController* controller, const PExecPlanFragmentRequest* request,
                             PExecPlanFragmentResult* result, google::protobuf::Closure* done) override;
 
+    void exec_batch_plan_fragments(google::protobuf::RpcController* controller,
+                                   const PExecBatchPlanFragmentsRequest* request, PExecBatchPlanFragmentsResult* result,
+                                   google::protobuf::Closure* done) override;
+
     void cancel_plan_fragment(google::protobuf::RpcController* controller, const PCancelPlanFragmentRequest* request,
                               PCancelPlanFragmentResult* result, google::protobuf::Closure* done) override;
 
@@ -81,9 +85,16 @@ public:
     void get_info(google::protobuf::RpcController* controller, const PProxyRequest* request, PProxyResult* response,
                   google::protobuf::Closure* done) override;
 
+    void lookup_rows(google::protobuf::RpcController* controller, const PLookupRowsRequest* request,
+                     PLookupRowsResult* response, google::protobuf::Closure* done) override;
+
 private:
     Status _exec_plan_fragment(brpc::Controller* cntl);
 
+    Status _exec_batch_plan_fragments(brpc::Controller* cntl);
+
+    Status _lookup_rows(const PLookupRowsRequest& request, PLookupRowsResult* response);
+
 private:
     ExecEnv* _exec_env;
     PriorityThreadPool _tablet_worker_pool;
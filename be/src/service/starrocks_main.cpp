@@ -53,6 +53,7 @@
 #include "util/file_utils.h"
 #include "util/logging.h"
 #include "util/network_util.h"
+#include "util/query_cpu_profiler.h"
 #include "util/starrocks_metrics.h"
 #include "util/thrift_rpc_helper.h"
 #include "util/thrift_server.h"
@@ -77,11 +78,15 @@ static void thrift_output(const char* x) {
 } // namespace starrocks
 
 extern int meta_tool_main(int argc, char** argv);
+extern int segment_scan_bench_main(int argc, char** argv);
 
 int main(int argc, char** argv) {
     if (argc > 1 && strcmp(argv[1], "meta_tool") == 0) {
         return meta_tool_main(argc - 1, argv + 1);
     }
+    if (argc > 1 && strcmp(argv[1], "segment_scan_bench") == 0) {
+        return segment_scan_bench_main(argc - 1, argv + 1);
+    }
     // check if print version or help
     if (argc > 1) {
         if (strcmp(argv[1], "--version") == 0 || strcmp(argv[1], "-v") == 0) {
@@ -266,12 +271,22 @@ int main(int argc, char** argv) {
         exit(1);
     }
 
+#if !defined(ADDRESS_SANITIZER) && !defined(LEAK_SANITIZER) && !defined(THREAD_SANITIZER)
+    if (starrocks::config::enable_query_cpu_profiler) {
+        status = starrocks::QueryCpuProfiler::instance()->start(starrocks::config::query_cpu_profiler_frequency);
+        if (!status.ok()) {
+            LOG(WARNING) << "Failed to start query cpu profiler: " << status.to_string();
+        }
+    }
+#endif
+
     while (!starrocks::k_starrocks_exit) {
 #if defined(LEAK_SANITIZER)
         __lsan_do_leak_check();
 #endif
         sleep(10);
     }
+    starrocks::QueryCpuProfiler::instance()->stop();
     heartbeat_thrift_server->stop();
     heartbeat_thrift_server->join();
     be_server->stop();
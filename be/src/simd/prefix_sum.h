@@ -0,0 +1,60 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace SIMD {
+
+// Replace every element of |data| with the sum of |init| and all the elements up to and including it.
+// The integer overflow wraps around, which makes it the exact inverse of computing the differences of
+// the adjacent elements in the same type.
+template <typename T>
+inline void prefix_sum(T* data, size_t size, T init) {
+    static_assert(std::is_integral_v<T>, "only integers are supported");
+    using U = std::make_unsigned_t<T>;
+    size_t i = 0;
+#ifdef __AVX2__
+    if constexpr (sizeof(T) == 4) {
+        __m256i carry = _mm256_set1_epi32(static_cast<int32_t>(init));
+        const __m256i last = _mm256_set1_epi32(7);
+        for (; i + 8 <= size; i += 8) {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            // scan the two 128-bit lanes independently, then add the last element of the low lane to the high lane.
+            x = _mm256_add_epi32(x, _mm256_slli_si256(x, 4));
+            x = _mm256_add_epi32(x, _mm256_slli_si256(x, 8));
+            __m256i low = _mm256_shuffle_epi32(x, 0xFF);
+            x = _mm256_add_epi32(x, _mm256_permute2x128_si256(low, low, 0x08));
+            x = _mm256_add_epi32(x, carry);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + i), x);
+            carry = _mm256_permutevar8x32_epi32(x, last);
+        }
+        init = static_cast<T>(_mm256_extract_epi32(carry, 0));
+    } else if constexpr (sizeof(T) == 8) {
+        __m256i carry = _mm256_set1_epi64x(static_cast<int64_t>(init));
+        for (; i + 4 <= size; i += 4) {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            x = _mm256_add_epi64(x, _mm256_slli_si256(x, 8));
+            __m256i low = _mm256_permute4x64_epi64(x, 0x55);
+            x = _mm256_add_epi64(x, _mm256_blend_epi32(_mm256_setzero_si256(), low, 0xF0));
+            x = _mm256_add_epi64(x, carry);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + i), x);
+            carry = _mm256_permute4x64_epi64(x, 0xFF);
+        }
+        init = static_cast<T>(_mm256_extract_epi64(carry, 0));
+    }
+#endif
+    U sum = static_cast<U>(init);
+    for (; i < size; ++i) {
+        sum += static_cast<U>(data[i]);
+        data[i] = static_cast<T>(sum);
+    }
+}
+
+} // namespace SIMD
@@ -0,0 +1,125 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+// Reductions of the numeric arrays, used by the aggregate functions without group by.
+namespace SIMD {
+
+// Sum of |data| in the type of |ResultType|, which may be wider than |T|.
+// The integers are summed by 4 independent accumulators to break the dependency chain. The floating
+// point numbers are always summed in order, to keep the result the same as the row by row summing.
+template <typename ResultType, typename T>
+inline ResultType sum(const T* data, size_t size) {
+    if constexpr (!std::is_integral_v<T> || !std::is_integral_v<ResultType>) {
+        ResultType result{};
+        for (size_t i = 0; i < size; ++i) {
+            result += data[i];
+        }
+        return result;
+    } else {
+        size_t i = 0;
+#ifdef __AVX2__
+        if constexpr (sizeof(ResultType) == 8 && (sizeof(T) == 4 || sizeof(T) == 8)) {
+            __m256i acc0 = _mm256_setzero_si256();
+            __m256i acc1 = _mm256_setzero_si256();
+            if constexpr (sizeof(T) == 4) {
+                // widen 4 int32 to 4 int64 before adding, the same as the scalar summing in int64.
+                for (; i + 8 <= size; i += 8) {
+                    __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+                    __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 4));
+                    if constexpr (std::is_signed_v<T>) {
+                        acc0 = _mm256_add_epi64(acc0, _mm256_cvtepi32_epi64(lo));
+                        acc1 = _mm256_add_epi64(acc1, _mm256_cvtepi32_epi64(hi));
+                    } else {
+                        acc0 = _mm256_add_epi64(acc0, _mm256_cvtepu32_epi64(lo));
+                        acc1 = _mm256_add_epi64(acc1, _mm256_cvtepu32_epi64(hi));
+                    }
+                }
+            } else {
+                for (; i + 8 <= size; i += 8) {
+                    acc0 = _mm256_add_epi64(acc0, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)));
+                    acc1 = _mm256_add_epi64(acc1, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 4)));
+                }
+            }
+            alignas(32) int64_t lanes[4];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), _mm256_add_epi64(acc0, acc1));
+            // The integer overflow wraps around in both paths, so add in unsigned to avoid the undefined behavior.
+            auto result = static_cast<uint64_t>(lanes[0]) + static_cast<uint64_t>(lanes[1]) +
+                          static_cast<uint64_t>(lanes[2]) + static_cast<uint64_t>(lanes[3]);
+            for (; i < size; ++i) {
+                result += static_cast<uint64_t>(static_cast<ResultType>(data[i]));
+            }
+            return static_cast<ResultType>(result);
+        }
+#endif
+        ResultType acc[4]{};
+        for (; i + 4 <= size; i += 4) {
+            acc[0] += data[i];
+            acc[1] += data[i + 1];
+            acc[2] += data[i + 2];
+            acc[3] += data[i + 3];
+        }
+        for (; i < size; ++i) {
+            acc[0] += data[i];
+        }
+        return acc[0] + acc[1] + acc[2] + acc[3];
+    }
+}
+
+// Maximum of |data| and |init|.
+template <typename T>
+inline T max(const T* data, size_t size, T init) {
+    size_t i = 0;
+#ifdef __AVX2__
+    if constexpr (std::is_integral_v<T> && std::is_signed_v<T> && sizeof(T) == 4) {
+        if (size >= 8) {
+            __m256i acc = _mm256_set1_epi32(init);
+            for (; i + 8 <= size; i += 8) {
+                acc = _mm256_max_epi32(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)));
+            }
+            alignas(32) int32_t lanes[8];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+            init = *std::max_element(lanes, lanes + 8);
+        }
+    }
+#endif
+    for (; i < size; ++i) {
+        init = std::max<T>(init, data[i]);
+    }
+    return init;
+}
+
+// Minimum of |data| and |init|.
+template <typename T>
+inline T min(const T* data, size_t size, T init) {
+    size_t i = 0;
+#ifdef __AVX2__
+    if constexpr (std::is_integral_v<T> && std::is_signed_v<T> && sizeof(T) == 4) {
+        if (size >= 8) {
+            __m256i acc = _mm256_set1_epi32(init);
+            for (; i + 8 <= size; i += 8) {
+                acc = _mm256_min_epi32(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)));
+            }
+            alignas(32) int32_t lanes[8];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+            init = *std::min_element(lanes, lanes + 8);
+        }
+    }
+#endif
+    for (; i < size; ++i) {
+        init = std::min<T>(init, data[i]);
+    }
+    return init;
+}
+
+} // namespace SIMD
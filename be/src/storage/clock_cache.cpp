@@ -0,0 +1,313 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/clock_cache.h"
+
+#include <rapidjson/document.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <thread>
+
+#include "common/logging.h"
+
+namespace starrocks {
+
+ClockCacheShard::~ClockCacheShard() {
+    prune();
+}
+
+ClockHandle** ClockCacheShard::_find_pointer(const CacheKey& key, uint32_t hash) {
+    ClockHandle** ptr = &_buckets[hash & (_buckets.size() - 1)];
+    while (*ptr != nullptr && ((*ptr)->hash != hash || key != (*ptr)->key())) {
+        ptr = &(*ptr)->next_hash;
+    }
+    return ptr;
+}
+
+ClockHandle* ClockCacheShard::_table_insert(ClockHandle* h) {
+    ClockHandle** ptr = _find_pointer(h->key(), h->hash);
+    ClockHandle* old = *ptr;
+    h->next_hash = (old == nullptr ? nullptr : old->next_hash);
+    *ptr = h;
+    if (old == nullptr && ++_num_elems > _buckets.size()) {
+        _table_resize();
+    }
+    return old;
+}
+
+ClockHandle* ClockCacheShard::_table_remove(const CacheKey& key, uint32_t hash) {
+    ClockHandle** ptr = _find_pointer(key, hash);
+    ClockHandle* result = *ptr;
+    if (result != nullptr) {
+        *ptr = result->next_hash;
+        --_num_elems;
+    }
+    return result;
+}
+
+void ClockCacheShard::_table_resize() {
+    std::vector<ClockHandle*> new_buckets(_buckets.size() * 2, nullptr);
+    for (ClockHandle* h : _buckets) {
+        while (h != nullptr) {
+            ClockHandle* next = h->next_hash;
+            ClockHandle** ptr = &new_buckets[h->hash & (new_buckets.size() - 1)];
+            h->next_hash = *ptr;
+            *ptr = h;
+            h = next;
+        }
+    }
+    _buckets.swap(new_buckets);
+}
+
+void ClockCacheShard::_ring_insert(ClockHandle* h) {
+    if (_free_slots.empty()) {
+        h->slot = _ring.size();
+        _ring.push_back(h);
+    } else {
+        h->slot = _free_slots.back();
+        _free_slots.pop_back();
+        _ring[h->slot] = h;
+    }
+}
+
+void ClockCacheShard::_ring_remove(ClockHandle* h) {
+    DCHECK_EQ(h, _ring[h->slot]);
+    _ring[h->slot] = nullptr;
+    _free_slots.push_back(h->slot);
+}
+
+void ClockCacheShard::_unref_removed(ClockHandle* h, std::vector<ClockHandle*>* deleted) {
+    h->in_cache = false;
+    if (h->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        _usage.fetch_sub(h->charge, std::memory_order_relaxed);
+        deleted->push_back(h);
+    }
+}
+
+void ClockCacheShard::_evict(size_t charge, std::vector<ClockHandle*>* deleted) {
+    // the normal entries are evicted at first, then the durable ones if it's still not enough.
+    for (bool evict_durable : {false, true}) {
+        // the second round evicts the entries visited in the first round but not since.
+        for (size_t scanned = 0, limit = 2 * _ring.size();
+             _usage.load(std::memory_order_relaxed) + charge > _capacity && scanned < limit; scanned++) {
+            if (_hand >= _ring.size()) {
+                _hand = 0;
+            }
+            ClockHandle* h = _ring[_hand++];
+            if (h == nullptr || h->refs.load(std::memory_order_acquire) != 1) {
+                // an empty slot or in use by the clients.
+                continue;
+            }
+            if (h->priority == CachePriority::DURABLE && !evict_durable) {
+                continue;
+            }
+            if (h->visited.load(std::memory_order_relaxed)) {
+                h->visited.store(false, std::memory_order_relaxed);
+                continue;
+            }
+            _table_remove(h->key(), h->hash);
+            _ring_remove(h);
+            _unref_removed(h, deleted);
+        }
+    }
+}
+
+Cache::Handle* ClockCacheShard::insert(const CacheKey& key, uint32_t hash, void* value, size_t charge,
+                                       void (*deleter)(const CacheKey& key, void* value), CachePriority priority) {
+    void* mem = malloc(sizeof(ClockHandle) - 1 + key.size());
+    auto* e = new (mem) ClockHandle();
+    e->value = value;
+    e->deleter = deleter;
+    e->next_hash = nullptr;
+    e->charge = charge;
+    e->key_length = key.size();
+    // one for the returned handle, one for the cache.
+    e->refs.store(2, std::memory_order_relaxed);
+    // not visited until it's looked up, the entries only inserted are evicted by the first sweep.
+    e->visited.store(false, std::memory_order_relaxed);
+    e->in_cache = true;
+    e->hash = hash;
+    e->priority = priority;
+    memcpy(e->key_data, key.data(), key.size());
+
+    std::vector<ClockHandle*> deleted;
+    {
+        std::unique_lock l(_mutex);
+        // the cache might get larger than its capacity if not enough space was freed.
+        _evict(charge, &deleted);
+        ClockHandle* old = _table_insert(e);
+        _ring_insert(e);
+        _usage.fetch_add(charge, std::memory_order_relaxed);
+        if (old != nullptr) {
+            _ring_remove(old);
+            _unref_removed(old, &deleted);
+        }
+    }
+    for (ClockHandle* h : deleted) {
+        h->free();
+    }
+    return reinterpret_cast<Cache::Handle*>(e);
+}
+
+Cache::Handle* ClockCacheShard::lookup(const CacheKey& key, uint32_t hash) {
+    std::shared_lock l(_mutex);
+    _lookup_count.fetch_add(1, std::memory_order_relaxed);
+    ClockHandle* e = *_find_pointer(key, hash);
+    if (e != nullptr) {
+        // no eviction runs concurrently under the shared lock, the cache still holds its reference.
+        e->refs.fetch_add(1, std::memory_order_relaxed);
+        // avoid writing the cache line shared by the other readers if it's already set.
+        if (!e->visited.load(std::memory_order_relaxed)) {
+            e->visited.store(true, std::memory_order_relaxed);
+        }
+        _hit_count.fetch_add(1, std::memory_order_relaxed);
+    }
+    return reinterpret_cast<Cache::Handle*>(e);
+}
+
+void ClockCacheShard::release(Cache::Handle* handle) {
+    if (handle == nullptr) {
+        return;
+    }
+    auto* e = reinterpret_cast<ClockHandle*>(handle);
+    // the last reference is dropped here only if it's removed from the cache.
+    if (e->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        _usage.fetch_sub(e->charge, std::memory_order_relaxed);
+        e->free();
+    }
+}
+
+void ClockCacheShard::erase(const CacheKey& key, uint32_t hash) {
+    std::vector<ClockHandle*> deleted;
+    {
+        std::unique_lock l(_mutex);
+        ClockHandle* e = _table_remove(key, hash);
+        if (e != nullptr) {
+            _ring_remove(e);
+            _unref_removed(e, &deleted);
+        }
+    }
+    for (ClockHandle* h : deleted) {
+        h->free();
+    }
+}
+
+int ClockCacheShard::prune() {
+    std::vector<ClockHandle*> deleted;
+    {
+        std::unique_lock l(_mutex);
+        for (ClockHandle* h : _ring) {
+            if (h != nullptr && h->refs.load(std::memory_order_acquire) == 1) {
+                _table_remove(h->key(), h->hash);
+                _ring_remove(h);
+                _unref_removed(h, &deleted);
+            }
+        }
+    }
+    for (ClockHandle* h : deleted) {
+        h->free();
+    }
+    return deleted.size();
+}
+
+ShardedClockCache::ShardedClockCache(size_t capacity) {
+    // at least as many shards as the sharded LRU cache, and about two per core to spread the inserts.
+    const size_t num_cores = std::max(1U, std::thread::hardware_concurrency());
+    _shard_bits = kNumShardBits;
+    while (_shard_bits < 8 && (size_t(1) << _shard_bits) < 2 * num_cores) {
+        _shard_bits++;
+    }
+    // the small caches can't be split too much, or an entry may not fit in its shard.
+    while (_shard_bits > 0 && (capacity >> _shard_bits) < 16) {
+        _shard_bits--;
+    }
+    _num_shards = size_t(1) << _shard_bits;
+    _shards.reset(new PaddedShard[_num_shards]);
+    const size_t per_shard = (capacity + (_num_shards - 1)) / _num_shards;
+    for (size_t i = 0; i < _num_shards; i++) {
+        _shards[i].shard.set_capacity(per_shard);
+    }
+}
+
+Cache::Handle* ShardedClockCache::insert(const CacheKey& key, void* value, size_t charge,
+                                         void (*deleter)(const CacheKey& key, void* value), CachePriority priority) {
+    const uint32_t hash = key.hash(key.data(), key.size(), 0);
+    return _shards[_shard(hash)].shard.insert(key, hash, value, charge, deleter, priority);
+}
+
+Cache::Handle* ShardedClockCache::lookup(const CacheKey& key) {
+    const uint32_t hash = key.hash(key.data(), key.size(), 0);
+    return _shards[_shard(hash)].shard.lookup(key, hash);
+}
+
+void ShardedClockCache::release(Handle* handle) {
+    if (handle == nullptr) {
+        return;
+    }
+    auto* h = reinterpret_cast<ClockHandle*>(handle);
+    _shards[_shard(h->hash)].shard.release(handle);
+}
+
+void ShardedClockCache::erase(const CacheKey& key) {
+    const uint32_t hash = key.hash(key.data(), key.size(), 0);
+    _shards[_shard(hash)].shard.erase(key, hash);
+}
+
+void* ShardedClockCache::value(Handle* handle) {
+    return reinterpret_cast<ClockHandle*>(handle)->value;
+}
+
+Slice ShardedClockCache::value_slice(Handle* handle) {
+    auto* h = reinterpret_cast<ClockHandle*>(handle);
+    return Slice((char*)h->value, h->charge);
+}
+
+uint64_t ShardedClockCache::new_id() {
+    return _last_id.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+void ShardedClockCache::prune() {
+    int num_prune = 0;
+    for (size_t i = 0; i < _num_shards; i++) {
+        num_prune += _shards[i].shard.prune();
+    }
+    VLOG(7) << "Successfully prune cache, clean " << num_prune << " entries.";
+}
+
+size_t ShardedClockCache::get_memory_usage() {
+    size_t total_usage = 0;
+    for (size_t i = 0; i < _num_shards; i++) {
+        total_usage += _shards[i].shard.get_usage();
+    }
+    return total_usage;
+}
+
+void ShardedClockCache::get_cache_status(rapidjson::Document* document) {
+    for (size_t i = 0; i < _num_shards; i++) {
+        const ClockCacheShard& shard = _shards[i].shard;
+        size_t capacity = shard.get_capacity();
+        size_t usage = shard.get_usage();
+        rapidjson::Value shard_info(rapidjson::kObjectType);
+        shard_info.AddMember("capacity", static_cast<double>(capacity), document->GetAllocator());
+        shard_info.AddMember("usage", static_cast<double>(usage), document->GetAllocator());
+        float usage_ratio = capacity == 0 ? 0.0f : static_cast<float>(usage) / static_cast<float>(capacity);
+        shard_info.AddMember("usage_ratio", usage_ratio, document->GetAllocator());
+
+        size_t lookup_count = shard.get_lookup_count();
+        size_t hit_count = shard.get_hit_count();
+        shard_info.AddMember("lookup_count", static_cast<double>(lookup_count), document->GetAllocator());
+        shard_info.AddMember("hit_count", static_cast<double>(hit_count), document->GetAllocator());
+        float hit_ratio =
+                lookup_count == 0 ? 0.0f : static_cast<float>(hit_count) / static_cast<float>(lookup_count);
+        shard_info.AddMember("hit_ratio", hit_ratio, document->GetAllocator());
+        document->PushBack(shard_info, document->GetAllocator());
+    }
+}
+
+Cache* new_clock_cache(size_t capacity) {
+    return new ShardedClockCache(capacity);
+}
+
+} // namespace starrocks
@@ -0,0 +1,132 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <vector>
+
+#include "storage/lru_cache.h"
+
+namespace starrocks {
+
+// Returns a cache evicting by CLOCK (second chance) instead of LRU, for the caches looked up by many
+// threads. A lookup only takes the shared lock of its shard and marks the entry visited by an atomic
+// bit, so the lookups never serialize on each other. The inserts and erases take the exclusive lock.
+// The number of shards is scaled with the number of cores.
+extern Cache* new_clock_cache(size_t capacity);
+
+struct ClockHandle {
+    void* value;
+    void (*deleter)(const CacheKey&, void* value);
+    ClockHandle* next_hash;
+    size_t charge;
+    size_t key_length;
+    // one for the cache if it's in the cache, and one for every handle returned to the clients.
+    std::atomic<uint32_t> refs;
+    // set by the lookup, cleared by the clock hand passing by.
+    std::atomic<bool> visited;
+    bool in_cache;
+    uint32_t hash;
+    // the index in the clock ring of the shard if it's in the cache.
+    uint32_t slot;
+    CachePriority priority;
+    char key_data[1]; // Beginning of key
+
+    CacheKey key() const { return CacheKey(key_data, key_length); }
+
+    void free() {
+        (*deleter)(key(), value);
+        this->~ClockHandle();
+        ::free(this);
+    }
+};
+
+class ClockCacheShard {
+public:
+    ClockCacheShard() = default;
+    ~ClockCacheShard();
+
+    void set_capacity(size_t capacity) { _capacity = capacity; }
+
+    Cache::Handle* insert(const CacheKey& key, uint32_t hash, void* value, size_t charge,
+                          void (*deleter)(const CacheKey& key, void* value), CachePriority priority);
+    Cache::Handle* lookup(const CacheKey& key, uint32_t hash);
+    void release(Cache::Handle* handle);
+    void erase(const CacheKey& key, uint32_t hash);
+    int prune();
+
+    uint64_t get_lookup_count() const { return _lookup_count.load(std::memory_order_relaxed); }
+    uint64_t get_hit_count() const { return _hit_count.load(std::memory_order_relaxed); }
+    size_t get_usage() const { return _usage.load(std::memory_order_relaxed); }
+    size_t get_capacity() const { return _capacity; }
+
+private:
+    // the slot of |key| in |_buckets|, or the trailing slot of the bucket if not found.
+    ClockHandle** _find_pointer(const CacheKey& key, uint32_t hash);
+    ClockHandle* _table_insert(ClockHandle* h);
+    ClockHandle* _table_remove(const CacheKey& key, uint32_t hash);
+    void _table_resize();
+
+    void _ring_insert(ClockHandle* h);
+    void _ring_remove(ClockHandle* h);
+
+    // drops the reference of the cache to |h| removed from the cache, appends it to |deleted| if it's the last.
+    void _unref_removed(ClockHandle* h, std::vector<ClockHandle*>* deleted);
+
+    // sweeps the clock hand until |charge| more bytes fit or every entry is visited twice.
+    void _evict(size_t charge, std::vector<ClockHandle*>* deleted);
+
+    size_t _capacity = 0;
+
+    // |_mutex| is shared by the lookups and exclusive for the others, it protects the following
+    // except the atomic fields of the handles.
+    std::shared_mutex _mutex;
+    std::vector<ClockHandle*> _buckets = std::vector<ClockHandle*>(16, nullptr);
+    size_t _num_elems = 0;
+    // the entries in the cache, the empty slots are null and reused by |_free_slots|.
+    std::vector<ClockHandle*> _ring;
+    std::vector<uint32_t> _free_slots;
+    size_t _hand = 0;
+
+    // the charge of the entries not freed yet, updated by the releases without lock.
+    std::atomic<size_t> _usage{0};
+    std::atomic<uint64_t> _lookup_count{0};
+    std::atomic<uint64_t> _hit_count{0};
+};
+
+class ShardedClockCache : public Cache {
+public:
+    explicit ShardedClockCache(size_t capacity);
+    ~ShardedClockCache() override = default;
+    Handle* insert(const CacheKey& key, void* value, size_t charge, void (*deleter)(const CacheKey& key, void* value),
+                   CachePriority priority = CachePriority::NORMAL) override;
+    Handle* lookup(const CacheKey& key) override;
+    void release(Handle* handle) override;
+    void erase(const CacheKey& key) override;
+    void* value(Handle* handle) override;
+    Slice value_slice(Handle* handle) override;
+    uint64_t new_id() override;
+    void prune() override;
+    size_t get_memory_usage() override;
+    void get_cache_status(rapidjson::Document* document) override;
+
+    size_t num_shards() const { return _num_shards; }
+
+private:
+    // pads the shards to their own cache lines.
+    struct alignas(64) PaddedShard {
+        ClockCacheShard shard;
+    };
+
+    uint32_t _shard(uint32_t hash) const { return _shard_bits == 0 ? 0 : hash >> (32 - _shard_bits); }
+
+    int _shard_bits = 0;
+    size_t _num_shards = 0;
+    std::unique_ptr<PaddedShard[]> _shards;
+    std::atomic<uint64_t> _last_id{0};
+};
+
+} // namespace starrocks
@@ -0,0 +1,333 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/compaction_scheduler.h"
+
+#include <rapidjson/document.h>
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/stringbuffer.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include "common/config.h"
+#include "storage/data_dir.h"
+#include "storage/tablet_manager.h"
+#include "storage/vectorized/base_compaction.h"
+#include "storage/vectorized/cumulative_compaction.h"
+#include "util/scoped_cleanup.h"
+#include "util/starrocks_metrics.h"
+#include "util/time.h"
+#include "util/trace.h"
+
+namespace starrocks {
+
+static const char* compaction_type_name(CompactionType type) {
+    return type == BASE_COMPACTION ? "base" : "cumulative";
+}
+
+CompactionScheduler::CompactionScheduler(MemTracker* mem_tracker, TabletManager* tablet_manager)
+        : _mem_tracker(mem_tracker), _tablet_manager(tablet_manager) {}
+
+CompactionScheduler::~CompactionScheduler() {
+    stop();
+}
+
+void CompactionScheduler::start(int32_t num_workers) {
+    _schedule_thread = std::thread([this] { _schedule_thread_callback(); });
+    _worker_threads.reserve(num_workers);
+    for (int32_t i = 0; i < num_workers; ++i) {
+        _worker_threads.emplace_back([this] { _worker_thread_callback(); });
+    }
+    LOG(INFO) << "compaction scheduler started. workers: " << num_workers;
+}
+
+void CompactionScheduler::stop() {
+    {
+        std::lock_guard l(_mutex);
+        if (_stopped) {
+            return;
+        }
+        _stopped = true;
+    }
+    _cv.notify_all();
+    if (_schedule_thread.joinable()) {
+        _schedule_thread.join();
+    }
+    for (auto& thread : _worker_threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    _worker_threads.clear();
+}
+
+double CompactionScheduler::calc_priority(uint32_t score, int64_t version_count, int64_t query_heat) {
+    // a tablet reaching tablet_max_versions rejects the loads, so its priority is doubled at most
+    double max_versions = std::max<int>(1, config::tablet_max_versions);
+    double version_ratio = std::min(1.0, version_count / max_versions);
+    double heat_factor = 1.0 + std::log2(1.0 + std::max<int64_t>(0, query_heat));
+    return score * (1.0 + version_ratio) * heat_factor;
+}
+
+int CompactionScheduler::pick_task(const std::vector<CompactionTask>& queue,
+                                   const std::unordered_map<DataDir*, int32_t>& running_tasks_per_disk,
+                                   int32_t max_tasks_per_disk) {
+    for (int i = 0; i < queue.size(); ++i) {
+        if (max_tasks_per_disk <= 0) {
+            return i;
+        }
+        auto iter = running_tasks_per_disk.find(queue[i].data_dir);
+        if (iter == running_tasks_per_disk.end() || iter->second < max_tasks_per_disk) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void CompactionScheduler::_schedule_thread_callback() {
+    int64_t last_base_check_ms = 0;
+    std::unique_lock l(_mutex);
+    while (!_stopped) {
+        l.unlock();
+        int64_t now_ms = UnixMillis();
+        bool include_base = now_ms - last_base_check_ms >= config::base_compaction_check_interval_seconds * 1000L;
+        if (include_base) {
+            last_base_check_ms = now_ms;
+        }
+        _refresh_queue(include_base);
+        l.lock();
+
+        int32_t interval = config::cumulative_compaction_check_interval_seconds;
+        if (interval <= 0) {
+            LOG(WARNING) << "cumulative compaction check interval config is illegal:" << interval
+                         << "will be forced set to one";
+            interval = 1;
+        }
+        _cv.wait_for(l, std::chrono::seconds(interval), [this] { return _stopped; });
+    }
+}
+
+void CompactionScheduler::_worker_thread_callback() {
+    std::unique_lock l(_mutex);
+    while (!_stopped) {
+        int idx = pick_task(_queue, _running_tasks_per_disk, config::compaction_max_tasks_per_disk);
+        if (idx < 0) {
+            _cv.wait(l);
+            continue;
+        }
+        CompactionTask task = _queue[idx];
+        _queue.erase(_queue.begin() + idx);
+        _running_tasks.push_back(task);
+        _running_tasks_per_disk[task.data_dir]++;
+        l.unlock();
+
+        (void)_do_compaction(task);
+
+        l.lock();
+        for (auto iter = _running_tasks.begin(); iter != _running_tasks.end(); ++iter) {
+            if (iter->tablet == task.tablet && iter->type == task.type) {
+                _running_tasks.erase(iter);
+                break;
+            }
+        }
+        _running_tasks_per_disk[task.data_dir]--;
+        // the finished task may free a slot of the disk other workers are waiting for
+        _cv.notify_all();
+    }
+}
+
+void CompactionScheduler::_refresh_queue(bool include_base) {
+    std::vector<CompactionTask> tasks;
+    _collect_tasks(CUMULATIVE_COMPACTION, &tasks);
+    if (include_base) {
+        _collect_tasks(BASE_COMPACTION, &tasks);
+    }
+
+    {
+        std::lock_guard l(_mutex);
+        if (!include_base) {
+            // keep the base compaction tasks of the previous base check
+            for (auto& task : _queue) {
+                if (task.type == BASE_COMPACTION) {
+                    tasks.push_back(std::move(task));
+                }
+            }
+        }
+        tasks.erase(std::remove_if(tasks.begin(), tasks.end(),
+                                   [this](const CompactionTask& task) {
+                                       return _is_running(task.tablet->tablet_id(), task.type);
+                                   }),
+                    tasks.end());
+        std::stable_sort(tasks.begin(), tasks.end(), [](const CompactionTask& a, const CompactionTask& b) {
+            return a.priority > b.priority;
+        });
+        size_t max_queue_size = std::max(1, config::compaction_scheduler_max_queue_size);
+        if (tasks.size() > max_queue_size) {
+            tasks.resize(max_queue_size);
+        }
+        _queue.swap(tasks);
+    }
+    _cv.notify_all();
+}
+
+void CompactionScheduler::_collect_tasks(CompactionType type, std::vector<CompactionTask>* tasks) {
+    std::vector<std::pair<TabletSharedPtr, uint32_t>> tablets_with_score;
+    _tablet_manager->pick_tablets_to_compaction(type, &tablets_with_score);
+
+    auto& last_query_counts = _last_query_counts[type == BASE_COMPACTION ? 0 : 1];
+    std::unordered_map<int64_t, int64_t> query_counts;
+    uint32_t highest_score = 0;
+    for (auto& [tablet, score] : tablets_with_score) {
+        DataDir* data_dir = tablet->data_dir();
+        if (data_dir->reach_capacity_limit(0)) {
+            continue;
+        }
+        int64_t query_count = tablet->query_count();
+        auto iter = last_query_counts.find(tablet->tablet_id());
+        int64_t query_heat = iter == last_query_counts.end() ? 0 : query_count - iter->second;
+        query_counts[tablet->tablet_id()] = query_count;
+
+        CompactionTask task;
+        task.tablet = tablet;
+        task.data_dir = data_dir;
+        task.type = type;
+        task.score = score;
+        {
+            std::shared_lock rdlock(tablet->get_header_lock());
+            task.version_count = tablet->version_count();
+        }
+        task.query_heat = query_heat;
+        task.priority = calc_priority(score, task.version_count, query_heat);
+        tasks->push_back(std::move(task));
+        highest_score = std::max(highest_score, score);
+    }
+    last_query_counts.swap(query_counts);
+
+    // TODO(lingbin): Remove 'max' from metric name, it would be misunderstood as the
+    // biggest in history(like peak), but it is really just the value at current moment.
+    if (type == BASE_COMPACTION) {
+        StarRocksMetrics::instance()->tablet_base_max_compaction_score.set_value(highest_score);
+    } else {
+        StarRocksMetrics::instance()->tablet_cumulative_max_compaction_score.set_value(highest_score);
+    }
+}
+
+bool CompactionScheduler::_is_running(int64_t tablet_id, CompactionType type) const {
+    for (const auto& task : _running_tasks) {
+        if (task.tablet->tablet_id() == tablet_id && task.type == type) {
+            return true;
+        }
+    }
+    return false;
+}
+
+Status CompactionScheduler::_do_compaction(const CompactionTask& task) {
+    const TabletSharedPtr& tablet = task.tablet;
+    bool is_base = task.type == BASE_COMPACTION;
+    // the task may have waited in the queue for a while
+    if (!tablet->is_used() || !tablet->can_do_compaction() || task.data_dir->reach_capacity_limit(0)) {
+        return Status::NotFound("tablet can not do compaction now");
+    }
+    scoped_refptr<Trace> trace(new Trace);
+    MonotonicStopWatch watch;
+    watch.start();
+    SCOPED_CLEANUP({
+        int32_t threshold =
+                is_base ? config::base_compaction_trace_threshold : config::cumulative_compaction_trace_threshold;
+        if (watch.elapsed_time() / 1e9 > threshold) {
+            LOG(INFO) << "Trace:" << std::endl << trace->DumpToString(Trace::INCLUDE_ALL);
+        }
+    });
+    ADOPT_TRACE(trace.get());
+    TRACE("start to perform $0 compaction of tablet $1, score $2, priority $3", compaction_type_name(task.type),
+          tablet->tablet_id(), task.score, task.priority);
+
+    Status res;
+    if (is_base) {
+        StarRocksMetrics::instance()->base_compaction_request_total.increment(1);
+        vectorized::BaseCompaction base_compaction(_mem_tracker, tablet);
+        res = base_compaction.compact();
+    } else {
+        StarRocksMetrics::instance()->cumulative_compaction_request_total.increment(1);
+        vectorized::CumulativeCompaction cumulative_compaction(_mem_tracker, tablet);
+        res = cumulative_compaction.compact();
+    }
+
+    if (!res.ok()) {
+        if (is_base) {
+            tablet->set_last_base_compaction_failure_time(UnixMillis());
+        } else {
+            tablet->set_last_cumu_compaction_failure_time(UnixMillis());
+        }
+        if (!res.is_not_found()) {
+            if (is_base) {
+                StarRocksMetrics::instance()->base_compaction_request_failed.increment(1);
+            } else {
+                StarRocksMetrics::instance()->cumulative_compaction_request_failed.increment(1);
+            }
+            LOG(WARNING) << "Fail to vectorized " << compaction_type_name(task.type)
+                         << " compact table=" << tablet->full_name() << ", err=" << res.to_string();
+        }
+        return res;
+    }
+
+    if (is_base) {
+        tablet->set_last_base_compaction_failure_time(0);
+    } else {
+        tablet->set_last_cumu_compaction_failure_time(0);
+    }
+    return Status::OK();
+}
+
+void CompactionScheduler::get_status(std::string* json_result) {
+    rapidjson::Document root;
+    root.SetObject();
+    auto& allocator = root.GetAllocator();
+
+    auto task_to_json = [&allocator](const CompactionTask& task) {
+        rapidjson::Value value(rapidjson::kObjectType);
+        value.AddMember("tablet_id", task.tablet->tablet_id(), allocator);
+        value.AddMember("type", rapidjson::StringRef(compaction_type_name(task.type)), allocator);
+        rapidjson::Value path;
+        path.SetString(task.data_dir->path().c_str(), task.data_dir->path().length(), allocator);
+        value.AddMember("data_dir", path, allocator);
+        value.AddMember("score", task.score, allocator);
+        value.AddMember("version_count", task.version_count, allocator);
+        value.AddMember("query_heat", task.query_heat, allocator);
+        value.AddMember("priority", task.priority, allocator);
+        return value;
+    };
+
+    {
+        std::lock_guard l(_mutex);
+        rapidjson::Value running(rapidjson::kArrayType);
+        for (const auto& task : _running_tasks) {
+            running.PushBack(task_to_json(task), allocator);
+        }
+        root.AddMember("running", running, allocator);
+
+        rapidjson::Value queue(rapidjson::kArrayType);
+        for (const auto& task : _queue) {
+            queue.PushBack(task_to_json(task), allocator);
+        }
+        root.AddMember("queue", queue, allocator);
+
+        rapidjson::Value per_disk(rapidjson::kObjectType);
+        for (const auto& [data_dir, num_tasks] : _running_tasks_per_disk) {
+            rapidjson::Value path;
+            path.SetString(data_dir->path().c_str(), data_dir->path().length(), allocator);
+            per_disk.AddMember(path, num_tasks, allocator);
+        }
+        root.AddMember("running tasks per disk", per_disk, allocator);
+    }
+    root.AddMember("max tasks per disk", config::compaction_max_tasks_per_disk, allocator);
+    root.AddMember("workers", static_cast<int64_t>(_worker_threads.size()), allocator);
+
+    rapidjson::StringBuffer strbuf;
+    rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(strbuf);
+    root.Accept(writer);
+    *json_result = std::string(strbuf.GetString());
+}
+
+} // namespace starrocks
@@ -0,0 +1,96 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "common/status.h"
+#include "storage/olap_common.h"
+#include "storage/tablet.h"
+
+namespace starrocks {
+
+class DataDir;
+class MemTracker;
+class TabletManager;
+
+struct CompactionTask {
+    TabletSharedPtr tablet;
+    // the data dir of |tablet|, kept apart so that the queue can be ordered without the tablet
+    DataDir* data_dir = nullptr;
+    CompactionType type = CUMULATIVE_COMPACTION;
+    // base or cumulative compaction score of the tablet
+    uint32_t score = 0;
+    // number of versions a query of the tablet has to merge
+    int64_t version_count = 0;
+    // number of queries on the tablet since the previous scheduling round
+    int64_t query_heat = 0;
+    double priority = 0;
+};
+
+// CompactionScheduler runs the base and cumulative compactions of the tablets on all the data dirs.
+// Instead of every disk's threads compacting their own best tablet, a scheduling thread collects the
+// candidates of all the disks into a single queue ordered by priority, and the worker threads take the
+// task with the highest priority whose data dir runs less than compaction_max_tasks_per_disk tasks.
+// The number of workers bounds the number of compactions running at the same time.
+class CompactionScheduler {
+public:
+    CompactionScheduler(MemTracker* mem_tracker, TabletManager* tablet_manager);
+    ~CompactionScheduler();
+
+    // Start the scheduling thread and |num_workers| worker threads.
+    void start(int32_t num_workers);
+
+    // Wait for the running compactions and stop all the threads.
+    void stop();
+
+    // Dump the running and queued tasks as json, shown by the http compaction action.
+    void get_status(std::string* json_result);
+
+    // The priority grows with the compaction score, and is raised for the tablets whose number of
+    // versions is approaching tablet_max_versions and for the tablets queried frequently, as their
+    // compaction reduces the read amplification the most.
+    static double calc_priority(uint32_t score, int64_t version_count, int64_t query_heat);
+
+    // Return the index of the first task in |queue|, which is ordered by priority, whose data dir runs
+    // less than |max_tasks_per_disk| tasks, or -1 if there is no such task.
+    static int pick_task(const std::vector<CompactionTask>& queue,
+                         const std::unordered_map<DataDir*, int32_t>& running_tasks_per_disk,
+                         int32_t max_tasks_per_disk);
+
+private:
+    void _schedule_thread_callback();
+    void _worker_thread_callback();
+
+    // Rebuild the queue from the tablets need compaction. The base compaction candidates are
+    // only collected every base_compaction_check_interval_seconds.
+    void _refresh_queue(bool include_base);
+    void _collect_tasks(CompactionType type, std::vector<CompactionTask>* tasks);
+
+    bool _is_running(int64_t tablet_id, CompactionType type) const;
+
+    Status _do_compaction(const CompactionTask& task);
+
+    MemTracker* _mem_tracker;
+    TabletManager* _tablet_manager;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _cv;
+    bool _stopped = false;
+
+    std::vector<CompactionTask> _queue;
+    std::vector<CompactionTask> _running_tasks;
+    std::unordered_map<DataDir*, int32_t> _running_tasks_per_disk;
+    // query counts of the tablets seen in the previous round, indexed by compaction type
+    std::unordered_map<int64_t, int64_t> _last_query_counts[2];
+
+    std::thread _schedule_thread;
+    std::vector<std::thread> _worker_threads;
+};
+
+} // namespace starrocks
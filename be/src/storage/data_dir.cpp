@@ -35,7 +35,10 @@
 #include <filesystem>
 #include <fstream>
 #include <set>
+#include <mutex>
 #include <sstream>
+#include <thread>
+#include <tuple>
 #include <utility>
 
 #include "env/env.h"
@@ -50,6 +53,7 @@
 #include "storage/storage_engine.h"
 #include "storage/tablet_meta_manager.h"
 #include "storage/utils.h" // for check_dir_existed
+#include "util/blocking_queue.hpp"
 #include "util/errno.h"
 #include "util/file_utils.h"
 #include "util/monotime.h"
@@ -73,7 +77,8 @@ DataDir::DataDir(std::string path, TStorageMedium::type storage_medium, TabletMa
           _txn_manager(txn_manager),
           _cluster_id(-1),
           _to_be_deleted(false),
-          _current_shard(0) {}
+          _current_shard(0),
+          _background_io_limiter(config::background_io_mbytes_per_sec_per_disk * 1024 * 1024) {}
 
 DataDir::~DataDir() {
     delete _id_generator;
@@ -184,6 +189,17 @@ Status DataDir::_init_data_dir() {
                                   "check_exist failed");
     }
 
+    // Spill files never survive a restart, drop the leftovers of the previous process.
+    std::string spill_path = this->spill_path();
+    if (FileUtils::check_exist(spill_path) && !FileUtils::remove_all(spill_path).ok()) {
+        LOG(WARNING) << "failed to remove spill path " << spill_path;
+    }
+    if (!FileUtils::create_dir(spill_path).ok()) {
+        RETURN_IF_ERROR_WITH_WARN(
+                Status::IOError(strings::Substitute("failed to create spill root path $0", spill_path)),
+                "create spill path failed");
+    }
+
     return Status::OK();
 }
 
@@ -370,6 +386,11 @@ void DataDir::clear_tablets(std::vector<TabletInfo>* tablet_infos) {
     _tablet_set.clear();
 }
 
+void DataDir::get_tablet_infos(std::vector<TabletInfo>* tablet_infos) {
+    std::lock_guard<std::mutex> l(_mutex);
+    tablet_infos->insert(tablet_infos->end(), _tablet_set.begin(), _tablet_set.end());
+}
+
 std::string DataDir::get_absolute_shard_path(int64_t shard_id) {
     return strings::Substitute("$0$1/$2", _path, DATA_PREFIX, shard_id);
 }
@@ -405,23 +426,64 @@ std::string DataDir::get_root_path_from_schema_hash_path_in_trash(const std::str
             .string();
 }
 
+// Traverse the items by |traverse| in the calling thread and consume them by |consume| in
+// |num_threads| threads. The items are passed through a bounded queue to limit the memory used
+// by the items not consumed yet.
+template <typename T, typename Traverse, typename Consume>
+static Status traverse_in_parallel(int32_t num_threads, const Traverse& traverse, const Consume& consume) {
+    if (num_threads <= 1) {
+        return traverse([&consume](T&& item) {
+            consume(item);
+            return true;
+        });
+    }
+    BlockingQueue<T> queue(num_threads * 16);
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+    for (int32_t i = 0; i < num_threads; ++i) {
+        threads.emplace_back([&queue, &consume] {
+            T item;
+            while (queue.blocking_get(&item)) {
+                consume(item);
+            }
+        });
+    }
+    Status st = traverse([&queue](T&& item) { return queue.blocking_put(std::move(item)); });
+    queue.shutdown();
+    for (auto& t : threads) {
+        t.join();
+    }
+    return st;
+}
+
 // TODO(ygl): deal with rowsets and tablets when load failed
 OLAPStatus DataDir::load() {
     LOG(INFO) << "start to load tablets from " << _path;
+    // The metas are read from rocksdb by the calling thread, and parsed and loaded by
+    // tablet_meta_load_threads_per_data_dir threads, as parsing the metas and creating
+    // the tablets take most of the time.
+    const int32_t num_threads = config::tablet_meta_load_threads_per_data_dir;
     // load rowset meta from meta env and create rowset
     // COMMITTED: add to txn manager
     // VISIBLE: add to tablet
     // if one rowset load failed, then the total data dir will not be loaded
     std::vector<RowsetMetaSharedPtr> dir_rowset_metas;
+    std::mutex dir_rowset_metas_lock;
     LOG(INFO) << "begin loading rowset from meta";
-    auto load_rowset_func = [&dir_rowset_metas](const TabletUid& tablet_uid, RowsetId rowset_id,
-                                                const std::string& meta_str) -> bool {
+    using RowsetMetaItem = std::pair<RowsetId, std::string>;
+    auto traverse_rowset_metas = [this](const std::function<bool(RowsetMetaItem&&)>& push) {
+        return RowsetMetaManager::traverse_rowset_metas(
+                _kv_store, [&push](const TabletUid& tablet_uid, RowsetId rowset_id, const std::string& meta_str) {
+                    return push(RowsetMetaItem(rowset_id, meta_str));
+                });
+    };
+    auto load_rowset_func = [&dir_rowset_metas, &dir_rowset_metas_lock](RowsetMetaItem& item) {
         RowsetMetaSharedPtr rowset_meta(new RowsetMeta());
-        bool parsed = rowset_meta->init(meta_str);
+        bool parsed = rowset_meta->init(item.second);
         if (!parsed) {
-            LOG(WARNING) << "parse rowset meta string failed for rowset_id:" << rowset_id;
-            // return false will break meta iterator, return true to skip this error
-            return true;
+            // skip this error
+            LOG(WARNING) << "parse rowset meta string failed for rowset_id:" << item.first;
+            return;
         }
         if (rowset_meta->rowset_type() == ALPHA_ROWSET) {
             LOG(FATAL) << "must change V1 format to V2 format."
@@ -429,10 +491,11 @@ OLAPStatus DataDir::load() {
                        << ", schema_hash: " << rowset_meta->tablet_schema_hash()
                        << ", rowset_id:" << rowset_meta->rowset_id();
         }
+        std::lock_guard l(dir_rowset_metas_lock);
         dir_rowset_metas.push_back(rowset_meta);
-        return true;
     };
-    Status load_rowset_status = RowsetMetaManager::traverse_rowset_metas(_kv_store, load_rowset_func);
+    Status load_rowset_status =
+            traverse_in_parallel<RowsetMetaItem>(num_threads, traverse_rowset_metas, load_rowset_func);
 
     if (!load_rowset_status.ok()) {
         LOG(WARNING) << "errors when load rowset meta from meta env, skip this data dir:" << _path;
@@ -445,10 +508,19 @@ OLAPStatus DataDir::load() {
     LOG(INFO) << "begin loading tablet from meta";
     std::set<int64_t> tablet_ids;
     std::set<int64_t> failed_tablet_ids;
-    auto load_tablet_func = [this, &tablet_ids, &failed_tablet_ids](int64_t tablet_id, int32_t schema_hash,
-                                                                    const std::string& value) -> bool {
+    std::mutex tablet_ids_lock;
+    using TabletMetaItem = std::tuple<int64_t, int32_t, std::string>;
+    auto traverse_tablet_metas = [this](const std::function<bool(TabletMetaItem&&)>& push) {
+        return TabletMetaManager::traverse_headers(
+                _kv_store, [&push](int64_t tablet_id, int32_t schema_hash, const std::string& value) {
+                    return push(TabletMetaItem(tablet_id, schema_hash, value));
+                });
+    };
+    auto load_tablet_func = [this, &tablet_ids, &failed_tablet_ids, &tablet_ids_lock](TabletMetaItem& item) {
+        const auto& [tablet_id, schema_hash, value] = item;
         Status st =
                 _tablet_manager->load_tablet_from_meta(this, tablet_id, schema_hash, value, false, false, false, false);
+        std::lock_guard l(tablet_ids_lock);
         if (!st.ok() && !st.is_not_found()) {
             // load_tablet_from_meta() may return NotFound which means the tablet status is DELETED
             // This may happen when the tablet was just deleted before the BE restarted,
@@ -462,9 +534,9 @@ OLAPStatus DataDir::load() {
         } else {
             tablet_ids.insert(tablet_id);
         }
-        return true;
     };
-    Status load_tablet_status = TabletMetaManager::traverse_headers(_kv_store, load_tablet_func);
+    Status load_tablet_status =
+            traverse_in_parallel<TabletMetaItem>(num_threads, traverse_tablet_metas, load_tablet_func);
     if (failed_tablet_ids.size() != 0) {
         LOG(ERROR) << "load tablets from header failed"
                    << ", loaded tablet: " << tablet_ids.size() << ", error tablet: " << failed_tablet_ids.size()
@@ -487,15 +559,21 @@ OLAPStatus DataDir::load() {
     // 1. add committed rowset to txn map
     // 2. add visible rowset to tablet
     // ignore any errors when load tablet or rowset, because fe will repair them after report
-    for (const auto& rowset_meta : dir_rowset_metas) {
+    // The rowsets are only created here, their segments are loaded when they are read the first time.
+    auto traverse_dir_rowset_metas = [&dir_rowset_metas](const std::function<bool(RowsetMetaSharedPtr&&)>& push) {
+        for (const auto& rowset_meta : dir_rowset_metas) {
+            if (!push(RowsetMetaSharedPtr(rowset_meta))) {
+                break;
+            }
+        }
+        return Status::OK();
+    };
+    auto add_rowset_func = [this](const RowsetMetaSharedPtr& rowset_meta) {
         TabletSharedPtr tablet =
                 _tablet_manager->get_tablet(rowset_meta->tablet_id(), rowset_meta->tablet_schema_hash());
         // tablet maybe dropped, but not drop related rowset meta
         if (tablet == nullptr) {
-            // LOG(WARNING) << "could not find tablet id: " << rowset_meta->tablet_id()
-            //              << ", schema hash: " << rowset_meta->tablet_schema_hash()
-            //              << ", for rowset: " << rowset_meta->rowset_id() << ", skip this rowset";
-            continue;
+            return;
         }
         RowsetSharedPtr rowset;
         OLAPStatus create_status =
@@ -508,7 +586,7 @@ OLAPStatus DataDir::load() {
             LOG(WARNING) << "Fail to create rowset from rowsetmeta,"
                          << " rowset=" << rowset_meta->rowset_id() << " type=" << rowset_meta->rowset_type()
                          << " state=" << rowset_meta->rowset_state();
-            continue;
+            return;
         }
         if (rowset_meta->rowset_state() == RowsetStatePB::COMMITTED &&
             rowset_meta->tablet_uid() == tablet->tablet_uid()) {
@@ -541,7 +619,8 @@ OLAPStatus DataDir::load() {
                          << " schema hash=" << rowset_meta->tablet_schema_hash() << " txn=" << rowset_meta->txn_id()
                          << " current valid tablet uid=" << tablet->tablet_uid();
         }
-    }
+    };
+    (void)traverse_in_parallel<RowsetMetaSharedPtr>(num_threads, traverse_dir_rowset_metas, add_rowset_func);
     return OLAP_SUCCESS;
 }
 
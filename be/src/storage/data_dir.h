@@ -34,6 +34,7 @@
 #include "storage/kv_store.h"
 #include "storage/olap_common.h"
 #include "storage/rowset/rowset_id_generator.h"
+#include "util/token_bucket.h"
 
 namespace starrocks {
 
@@ -54,6 +55,9 @@ public:
     void stop_bg_worker();
 
     const std::string& path() const { return _path; }
+    // Root directory of the temporary files spilled by query operators.
+    // It is emptied every time the data dir is initialized.
+    std::string spill_path() const { return _path + SPILL_PREFIX; }
     int64_t path_hash() const { return _path_hash; }
     bool is_used() const { return _is_used; }
     void set_is_used(bool is_used) { _is_used = is_used; }
@@ -88,6 +92,9 @@ public:
     void deregister_tablet(Tablet* tablet);
     void clear_tablets(std::vector<TabletInfo>* tablet_infos);
 
+    // Append the tablets registered on this data dir to |tablet_infos|.
+    void get_tablet_infos(std::vector<TabletInfo>* tablet_infos);
+
     std::string get_absolute_shard_path(int64_t shard_id);
     std::string get_absolute_tablet_path(int64_t shard_id, int64_t tablet_id, int32_t schema_hash);
 
@@ -116,6 +123,10 @@ public:
 
     Status update_capacity();
 
+    // limits the disk I/O of the background tasks on this data dir, e.g. the reads and writes
+    // of compaction, to background_io_mbytes_per_sec_per_disk
+    TokenBucket* background_io_limiter() { return &_background_io_limiter; }
+
 private:
     std::string _cluster_id_path() const { return _path + CLUSTER_ID_PREFIX; }
     Status _init_cluster_id();
@@ -162,6 +173,8 @@ private:
     std::condition_variable _cv;
     std::set<std::string> _all_check_paths;
     std::set<std::string> _all_tablet_schemahash_paths;
+
+    TokenBucket _background_io_limiter;
 };
 
 } // namespace starrocks
@@ -28,6 +28,7 @@ void DelVector::_add_dels(const std::vector<uint32_t>& dels) {
     } else {
         _roaring->addMany(dels.size(), dels.data());
     }
+    _compact();
     _update_stats();
 }
 
@@ -57,6 +58,7 @@ Status DelVector::load(int64_t version, const char* data, size_t length) {
     _version = version;
     if (length > 0) {
         _roaring = std::make_unique<Roaring>(Roaring::readSafe(data, length));
+        _compact();
     }
     _update_stats();
     return Status::OK();
@@ -86,6 +88,13 @@ string DelVector::to_string() const {
     return strings::Substitute("version:$0 $1", _version, _roaring ? _roaring->toString() : string("null"));
 }
 
+void DelVector::_compact() {
+    // the rows deleted by the upserts and compactions are often consecutive, the run containers encode
+    // them as ranges, which are smaller both in memory and in the saved meta.
+    _roaring->runOptimize();
+    _roaring->shrinkToFit();
+}
+
 void DelVector::_update_stats() {
     // TODO(cbl): optimization
     if (_roaring) {
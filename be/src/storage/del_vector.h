@@ -48,6 +48,9 @@ public:
 private:
     void _add_dels(const std::vector<uint32_t>& dels);
 
+    // converts the containers to run containers where it's smaller, requires |_roaring|.
+    void _compact();
+
     void _update_stats();
 
     bool _loaded = false;
@@ -0,0 +1,150 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/del_vector_cache.h"
+
+#include "gutil/strings/substitute.h"
+#include "runtime/mem_tracker.h"
+#include "storage/del_vector.h"
+
+namespace starrocks {
+
+void DelVectorCache::set_capacity(size_t capacity) {
+    _shard_capacity.store(capacity / kNumShards, std::memory_order_relaxed);
+}
+
+DelVectorPtr DelVectorCache::get(const TabletSegmentId& tsid, int64_t version) {
+    Shard& shard = _shard(tsid);
+    std::lock_guard<std::mutex> lg(shard.lock);
+    auto itr = shard.map.find(tsid);
+    if (itr == shard.map.end() || version < itr->second.delvec->version()) {
+        return nullptr;
+    }
+    shard.lru.splice(shard.lru.begin(), shard.lru, itr->second.lru_pos);
+    return itr->second.delvec;
+}
+
+DelVectorPtr DelVectorCache::get_latest(const TabletSegmentId& tsid) {
+    return get(tsid, INT64_MAX);
+}
+
+Status DelVectorCache::set(const TabletSegmentId& tsid, const DelVectorPtr& delvec) {
+    Shard& shard = _shard(tsid);
+    std::lock_guard<std::mutex> lg(shard.lock);
+    auto itr = shard.map.find(tsid);
+    if (itr == shard.map.end()) {
+        _insert(shard, tsid, delvec);
+    } else if (delvec->version() <= itr->second.delvec->version()) {
+        std::string msg = strings::Substitute("DelVectorCache::set: new version($0) <= old version($1)",
+                                              delvec->version(), itr->second.delvec->version());
+        LOG(ERROR) << msg;
+        return Status::InternalError(msg);
+    } else {
+        _replace(shard, itr->second, delvec);
+    }
+    _evict(shard, tsid);
+    return Status::OK();
+}
+
+DelVectorPtr DelVectorCache::set_if_newer(const TabletSegmentId& tsid, const DelVectorPtr& delvec) {
+    Shard& shard = _shard(tsid);
+    std::lock_guard<std::mutex> lg(shard.lock);
+    auto itr = shard.map.find(tsid);
+    if (itr == shard.map.end()) {
+        _insert(shard, tsid, delvec);
+    } else if (delvec->version() > itr->second.delvec->version()) {
+        _replace(shard, itr->second, delvec);
+    } else {
+        shard.lru.splice(shard.lru.begin(), shard.lru, itr->second.lru_pos);
+        return itr->second.delvec;
+    }
+    _evict(shard, tsid);
+    return delvec;
+}
+
+void DelVectorCache::erase(const std::vector<TabletSegmentId>& tsids) {
+    for (const auto& tsid : tsids) {
+        Shard& shard = _shard(tsid);
+        std::lock_guard<std::mutex> lg(shard.lock);
+        auto itr = shard.map.find(tsid);
+        if (itr != shard.map.end()) {
+            _erase(shard, itr);
+        }
+    }
+}
+
+void DelVectorCache::clear() {
+    for (auto& shard : _shards) {
+        std::lock_guard<std::mutex> lg(shard.lock);
+        if (_mem_tracker != nullptr) {
+            _mem_tracker->release(shard.usage);
+        }
+        shard.map.clear();
+        shard.lru.clear();
+        shard.usage = 0;
+    }
+}
+
+size_t DelVectorCache::size() const {
+    size_t ret = 0;
+    for (const auto& shard : _shards) {
+        std::lock_guard<std::mutex> lg(shard.lock);
+        ret += shard.map.size();
+    }
+    return ret;
+}
+
+size_t DelVectorCache::memory_usage() const {
+    size_t ret = 0;
+    for (const auto& shard : _shards) {
+        std::lock_guard<std::mutex> lg(shard.lock);
+        ret += shard.usage;
+    }
+    return ret;
+}
+
+void DelVectorCache::_insert(Shard& shard, const TabletSegmentId& tsid, const DelVectorPtr& delvec) {
+    shard.lru.push_front(tsid);
+    Entry& entry = shard.map[tsid];
+    entry.delvec = delvec;
+    entry.charge = delvec->memory_usage();
+    entry.lru_pos = shard.lru.begin();
+    shard.usage += entry.charge;
+    if (_mem_tracker != nullptr) {
+        _mem_tracker->consume(entry.charge);
+    }
+}
+
+void DelVectorCache::_replace(Shard& shard, Entry& entry, const DelVectorPtr& delvec) {
+    const size_t charge = delvec->memory_usage();
+    shard.usage = shard.usage - entry.charge + charge;
+    if (_mem_tracker != nullptr) {
+        _mem_tracker->release(entry.charge);
+        _mem_tracker->consume(charge);
+    }
+    entry.delvec = delvec;
+    entry.charge = charge;
+    shard.lru.splice(shard.lru.begin(), shard.lru, entry.lru_pos);
+}
+
+void DelVectorCache::_erase(Shard& shard, std::unordered_map<TabletSegmentId, Entry>::iterator itr) {
+    shard.usage -= itr->second.charge;
+    if (_mem_tracker != nullptr) {
+        _mem_tracker->release(itr->second.charge);
+    }
+    shard.lru.erase(itr->second.lru_pos);
+    shard.map.erase(itr);
+}
+
+void DelVectorCache::_evict(Shard& shard, const TabletSegmentId& keep) {
+    const size_t capacity = _shard_capacity.load(std::memory_order_relaxed);
+    while (shard.usage > capacity && !shard.lru.empty()) {
+        const TabletSegmentId& tsid = shard.lru.back();
+        if (tsid == keep) {
+            // only the entry just set is left.
+            break;
+        }
+        _erase(shard, shard.map.find(tsid));
+    }
+}
+
+} // namespace starrocks
@@ -0,0 +1,87 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <atomic>
+#include <limits>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "common/status.h"
+#include "storage/olap_common.h"
+
+namespace starrocks {
+
+class DelVector;
+using DelVectorPtr = std::shared_ptr<DelVector>;
+class MemTracker;
+
+// The cache of the latest DelVector of the segments of the primary key tablets, shared by the applies
+// and the reads. It's split into shards by the segment, every shard has its own lock and evicts its
+// least recently used entries once the cached DelVectors use more than its part of the capacity.
+// The DelVectors are shared pointers, so an evicted or replaced version stays valid for the readers
+// still holding it, and is only freed after the last of them.
+class DelVectorCache {
+public:
+    static const size_t kNumShards = 16;
+
+    explicit DelVectorCache(MemTracker* mem_tracker) : _mem_tracker(mem_tracker) {}
+    ~DelVectorCache() = default;
+
+    // can be changed at runtime, the shards over the new capacity are shrunk by their next insert.
+    void set_capacity(size_t capacity);
+
+    // returns the cached DelVector of |tsid| if it's valid for |version|, otherwise null.
+    DelVectorPtr get(const TabletSegmentId& tsid, int64_t version);
+
+    // returns the cached DelVector of |tsid| whatever its version, or null.
+    DelVectorPtr get_latest(const TabletSegmentId& tsid);
+
+    // caches |delvec| as the latest version of |tsid|, fails if it's not newer than the cached one.
+    Status set(const TabletSegmentId& tsid, const DelVectorPtr& delvec);
+
+    // caches |delvec| loaded from the meta as the latest version of |tsid|, unless a version not
+    // older than it is cached already, returns the cached one.
+    DelVectorPtr set_if_newer(const TabletSegmentId& tsid, const DelVectorPtr& delvec);
+
+    void erase(const std::vector<TabletSegmentId>& tsids);
+
+    void clear();
+
+    size_t size() const;
+
+    size_t memory_usage() const;
+
+private:
+    struct Entry {
+        DelVectorPtr delvec;
+        size_t charge = 0;
+        std::list<TabletSegmentId>::iterator lru_pos;
+    };
+
+    struct alignas(64) Shard {
+        mutable std::mutex lock;
+        std::unordered_map<TabletSegmentId, Entry> map;
+        // the most recently used at the front.
+        std::list<TabletSegmentId> lru;
+        size_t usage = 0;
+    };
+
+    Shard& _shard(const TabletSegmentId& tsid) { return _shards[std::hash<TabletSegmentId>()(tsid) % kNumShards]; }
+
+    // requires |shard.lock|.
+    void _insert(Shard& shard, const TabletSegmentId& tsid, const DelVectorPtr& delvec);
+    void _replace(Shard& shard, Entry& entry, const DelVectorPtr& delvec);
+    void _erase(Shard& shard, std::unordered_map<TabletSegmentId, Entry>::iterator itr);
+    // evicts the least recently used entries except |keep| until the shard fits its capacity.
+    void _evict(Shard& shard, const TabletSegmentId& keep);
+
+    MemTracker* _mem_tracker = nullptr;
+    std::atomic<size_t> _shard_capacity{std::numeric_limits<size_t>::max()};
+    Shard _shards[kNumShards];
+};
+
+} // namespace starrocks
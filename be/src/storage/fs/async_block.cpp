@@ -0,0 +1,120 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/fs/async_block.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "common/config.h"
+#include "common/logging.h"
+#include "util/threadpool.h"
+
+namespace starrocks::fs {
+
+static ThreadPool* async_write_pool() {
+    static ThreadPool* s_pool = []() -> ThreadPool* {
+        std::unique_ptr<ThreadPool> pool;
+        Status st = ThreadPoolBuilder("async_segment_write")
+                            .set_min_threads(1)
+                            .set_max_threads(std::max(1, config::async_segment_write_threads))
+                            .build(&pool);
+        if (!st.ok()) {
+            LOG(WARNING) << "Fail to create the thread pool of async segment writes: " << st.to_string();
+            return nullptr;
+        }
+        return pool.release();
+    }();
+    return s_pool;
+}
+
+AsyncWritableBlock::AsyncWritableBlock(std::unique_ptr<WritableBlock> block, size_t buffer_size)
+        : _block(std::move(block)), _buffer_size(std::max<size_t>(buffer_size, 4096)) {
+    if (ThreadPool* pool = async_write_pool(); pool != nullptr) {
+        // the buffers of a block are written one by one in order.
+        _token = pool->new_token(ThreadPool::ExecutionMode::SERIAL);
+    }
+    _active.reserve(_buffer_size);
+}
+
+AsyncWritableBlock::~AsyncWritableBlock() {
+    // the background write refers to the buffers.
+    (void)_wait();
+}
+
+Status AsyncWritableBlock::appendv(const Slice* data, size_t data_cnt) {
+    DCHECK(_state == CLEAN || _state == DIRTY) << "Invalid state: " << _state;
+    for (size_t i = 0; i < data_cnt; ++i) {
+        const auto* ptr = reinterpret_cast<const uint8_t*>(data[i].data);
+        size_t remaining = data[i].size;
+        while (remaining > 0) {
+            size_t n = std::min(remaining, _buffer_size - std::min(_buffer_size, _active.size()));
+            _active.append(ptr, n);
+            ptr += n;
+            remaining -= n;
+            if (_active.size() >= _buffer_size) {
+                RETURN_IF_ERROR(_flush_buffer());
+            }
+        }
+        _bytes_appended += data[i].size;
+    }
+    _state = DIRTY;
+    return Status::OK();
+}
+
+Status AsyncWritableBlock::_flush_buffer() {
+    RETURN_IF_ERROR(_wait());
+    if (_active.size() == 0) {
+        return Status::OK();
+    }
+    _active.swap(_flushing);
+    _active.clear();
+    auto write = [this]() { _write_status = _block->append(Slice(_flushing.data(), _flushing.size())); };
+    if (_token == nullptr || !_token->submit_func(write).ok()) {
+        write();
+        return _write_status;
+    }
+    return Status::OK();
+}
+
+Status AsyncWritableBlock::_wait() {
+    if (_token != nullptr) {
+        _token->wait();
+    }
+    return _write_status;
+}
+
+Status AsyncWritableBlock::finalize() {
+    if (_state == FINALIZED) {
+        return Status::OK();
+    }
+    RETURN_IF_ERROR(_flush_buffer());
+    RETURN_IF_ERROR(_wait());
+    RETURN_IF_ERROR(_block->finalize());
+    _state = FINALIZED;
+    return Status::OK();
+}
+
+Status AsyncWritableBlock::close() {
+    if (_state == CLOSED) {
+        return Status::OK();
+    }
+    Status st = _flush_buffer();
+    if (st.ok()) {
+        st = _wait();
+    }
+    if (!st.ok()) {
+        (void)_block->abort();
+        _state = CLOSED;
+        return st;
+    }
+    _state = CLOSED;
+    return _block->close();
+}
+
+Status AsyncWritableBlock::abort() {
+    (void)_wait();
+    _state = CLOSED;
+    return _block->abort();
+}
+
+} // namespace starrocks::fs
@@ -0,0 +1,68 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+
+#include "storage/fs/block_manager.h"
+#include "util/faststring.h"
+#include "util/slice.h"
+
+namespace starrocks {
+class ThreadPoolToken;
+} // namespace starrocks
+
+namespace starrocks::fs {
+
+// A WritableBlock writing the wrapped block in the background threads with two buffers: the appends are
+// copied into the active buffer, which is handed to a background thread once |buffer_size| bytes are
+// buffered, while the other buffer takes the following appends. So the caller, e.g. the segment writer
+// encoding the pages, isn't blocked by the disk unless the previous buffer hasn't been written yet.
+//
+// The errors of the background writes are returned by the following calls.
+class AsyncWritableBlock final : public WritableBlock {
+public:
+    AsyncWritableBlock(std::unique_ptr<WritableBlock> block, size_t buffer_size);
+
+    ~AsyncWritableBlock() override;
+
+    const BlockId& id() const override { return _block->id(); }
+
+    const std::string& path() const override { return _block->path(); }
+
+    Status close() override;
+
+    Status abort() override;
+
+    BlockManager* block_manager() const override { return _block->block_manager(); }
+
+    Status append(const Slice& data) override { return appendv(&data, 1); }
+
+    Status appendv(const Slice* data, size_t data_cnt) override;
+
+    Status finalize() override;
+
+    size_t bytes_appended() const override { return _bytes_appended; }
+
+    State state() const override { return _state; }
+
+private:
+    // Wait for the write in flight, then write the active buffer in the background.
+    Status _flush_buffer();
+
+    // Wait for the write in flight and return its status.
+    Status _wait();
+
+    std::unique_ptr<WritableBlock> _block;
+    const size_t _buffer_size;
+    // null if the background threads are unavailable, then the buffers are written synchronously.
+    std::unique_ptr<ThreadPoolToken> _token;
+    faststring _active;
+    faststring _flushing;
+    // written by the background thread, read after _wait().
+    Status _write_status;
+    size_t _bytes_appended = 0;
+    State _state = CLEAN;
+};
+
+} // namespace starrocks::fs
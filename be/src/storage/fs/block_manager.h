@@ -165,6 +165,16 @@ public:
     // If an error was encountered, returns a non-OK status.
     virtual Status readv(uint64_t offset, const Slice* res, size_t res_cnt) const = 0;
 
+    // Reads exactly 'res[i].size' bytes beginning from 'offsets[i]' in the block for every i in [0, n),
+    // the reads may be submitted in a batch by the underlying file.
+    // If an error was encountered, returns a non-OK status.
+    virtual Status read_batch(const uint64_t* offsets, const Slice* res, size_t n) const {
+        for (size_t i = 0; i < n; i++) {
+            RETURN_IF_ERROR(read(offsets[i], res[i]));
+        }
+        return Status::OK();
+    }
+
     // Returns the memory usage of this object including the object itself.
     // virtual size_t memory_footprint() const = 0;
 };
@@ -270,6 +270,8 @@ public:
 
     Status readv(uint64_t offset, const Slice* results, size_t res_cnt) const override;
 
+    Status read_batch(const uint64_t* offsets, const Slice* res, size_t n) const override;
+
     void handle_error(const Status& s) const;
 
 private:
@@ -358,6 +360,20 @@ Status FileReadableBlock::readv(uint64_t offset, const Slice* results, size_t re
     return Status::OK();
 }
 
+Status FileReadableBlock::read_batch(const uint64_t* offsets, const Slice* res, size_t n) const {
+    DCHECK(!_closed.load());
+
+    RETURN_IF_ERROR(_file->read_at_batch(offsets, res, n));
+
+    if (_block_manager->_metrics) {
+        size_t bytes_read = accumulate(res, res + n, static_cast<size_t>(0),
+                                       [&](size_t sum, const Slice& curr) { return sum + curr.size; });
+        _block_manager->_metrics->total_bytes_read->increment(bytes_read);
+    }
+
+    return Status::OK();
+}
+
 } // namespace internal
 
 ////////////////////////////////////////////////////////////
@@ -0,0 +1,81 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/fs/packed_block_manager.h"
+
+#include "gutil/strings/substitute.h"
+
+namespace starrocks::fs {
+
+namespace {
+
+// The range [offset, offset + size) of the pack file, read as a block of its own path.
+class PackedReadableBlock final : public ReadableBlock {
+public:
+    PackedReadableBlock(BlockManager* block_mgr, std::unique_ptr<ReadableBlock> pack, std::string path,
+                        PackedBlockManager::Range range)
+            : _block_mgr(block_mgr), _pack(std::move(pack)), _path(std::move(path)), _range(range) {}
+
+    ~PackedReadableBlock() override = default;
+
+    const BlockId& id() const override { return _pack->id(); }
+
+    const std::string& path() const override { return _path; }
+
+    Status close() override { return _pack->close(); }
+
+    BlockManager* block_manager() const override { return _block_mgr; }
+
+    Status size(uint64_t* sz) const override {
+        *sz = _range.size;
+        return Status::OK();
+    }
+
+    Status read(uint64_t offset, Slice result) const override { return readv(offset, &result, 1); }
+
+    Status readv(uint64_t offset, const Slice* res, size_t res_cnt) const override {
+        size_t bytes = 0;
+        for (size_t i = 0; i < res_cnt; ++i) {
+            bytes += res[i].size;
+        }
+        RETURN_IF_ERROR(_check_range(offset, bytes));
+        return _pack->readv(_range.offset + offset, res, res_cnt);
+    }
+
+    Status read_batch(const uint64_t* offsets, const Slice* res, size_t n) const override {
+        std::vector<uint64_t> pack_offsets(n);
+        for (size_t i = 0; i < n; ++i) {
+            RETURN_IF_ERROR(_check_range(offsets[i], res[i].size));
+            pack_offsets[i] = _range.offset + offsets[i];
+        }
+        return _pack->read_batch(pack_offsets.data(), res, n);
+    }
+
+private:
+    Status _check_range(uint64_t offset, uint64_t bytes) const {
+        if (offset + bytes > _range.size) {
+            return Status::IOError(strings::Substitute("Fail to read $0 bytes at $1 of $2: block size is $3", bytes,
+                                                       offset, _path, _range.size));
+        }
+        return Status::OK();
+    }
+
+    BlockManager* _block_mgr;
+    std::unique_ptr<ReadableBlock> _pack;
+    const std::string _path;
+    const PackedBlockManager::Range _range;
+};
+
+} // namespace
+
+Status PackedBlockManager::open_block(const std::string& path, std::unique_ptr<ReadableBlock>* block) {
+    auto iter = _ranges.find(path);
+    if (iter == _ranges.end()) {
+        return _block_mgr->open_block(path, block);
+    }
+    std::unique_ptr<ReadableBlock> pack;
+    RETURN_IF_ERROR(_block_mgr->open_block(_pack_path, &pack));
+    *block = std::make_unique<PackedReadableBlock>(this, std::move(pack), path, iter->second);
+    return Status::OK();
+}
+
+} // namespace starrocks::fs
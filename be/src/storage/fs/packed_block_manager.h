@@ -0,0 +1,54 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "storage/fs/block_manager.h"
+
+namespace starrocks::fs {
+
+// A BlockManager opening the blocks packed into a single file by their own paths: the block of a packed path
+// reads the range of the pack file it's packed into, the other paths are opened by the wrapped BlockManager.
+// The pack file is opened by the wrapped BlockManager for every block, which shares the opened file.
+//
+// The blocks are read only.
+class PackedBlockManager final : public BlockManager {
+public:
+    struct Range {
+        uint64_t offset = 0;
+        uint64_t size = 0;
+    };
+
+    PackedBlockManager(BlockManager* block_mgr, std::string pack_path, std::unordered_map<std::string, Range> ranges)
+            : _block_mgr(block_mgr), _pack_path(std::move(pack_path)), _ranges(std::move(ranges)) {}
+
+    ~PackedBlockManager() override = default;
+
+    Status open() override { return Status::OK(); }
+
+    Status create_block(const CreateBlockOptions& opts, std::unique_ptr<WritableBlock>* block) override {
+        return Status::NotSupported("create block in a pack file");
+    }
+
+    Status open_block(const std::string& path, std::unique_ptr<ReadableBlock>* block) override;
+
+    Status get_all_block_ids(std::vector<BlockId>* block_ids) override {
+        return _block_mgr->get_all_block_ids(block_ids);
+    }
+
+    const std::string& pack_path() const { return _pack_path; }
+
+    bool is_packed(const std::string& path) const { return _ranges.count(path) > 0; }
+
+private:
+    BlockManager* _block_mgr;
+    const std::string _pack_path;
+    const std::unordered_map<std::string, Range> _ranges;
+};
+
+} // namespace starrocks::fs
@@ -0,0 +1,58 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+#include <utility>
+
+#include "storage/fs/block_manager.h"
+#include "util/slice.h"
+#include "util/token_bucket.h"
+
+namespace starrocks::fs {
+
+// A WritableBlock taking the tokens of its appends from a TokenBucket before writing them to the
+// wrapped block, used to keep the writes of background tasks, e.g. compaction, below the disk budget.
+class ThrottledWritableBlock final : public WritableBlock {
+public:
+    ThrottledWritableBlock(std::unique_ptr<WritableBlock> block, TokenBucket* limiter)
+            : _block(std::move(block)), _limiter(limiter) {}
+
+    ~ThrottledWritableBlock() override = default;
+
+    const BlockId& id() const override { return _block->id(); }
+
+    const std::string& path() const override { return _block->path(); }
+
+    Status close() override { return _block->close(); }
+
+    Status abort() override { return _block->abort(); }
+
+    BlockManager* block_manager() const override { return _block->block_manager(); }
+
+    Status append(const Slice& data) override {
+        _limiter->acquire(data.size);
+        return _block->append(data);
+    }
+
+    Status appendv(const Slice* data, size_t data_cnt) override {
+        size_t bytes = 0;
+        for (size_t i = 0; i < data_cnt; ++i) {
+            bytes += data[i].size;
+        }
+        _limiter->acquire(bytes);
+        return _block->appendv(data, data_cnt);
+    }
+
+    Status finalize() override { return _block->finalize(); }
+
+    size_t bytes_appended() const override { return _block->bytes_appended(); }
+
+    State state() const override { return _block->state(); }
+
+private:
+    std::unique_ptr<WritableBlock> _block;
+    TokenBucket* _limiter;
+};
+
+} // namespace starrocks::fs
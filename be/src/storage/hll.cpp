@@ -26,6 +26,7 @@
 #endif
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <map>
 
@@ -164,6 +165,63 @@ void HyperLogLog::merge(const HyperLogLog& other) {
     }
 }
 
+void HyperLogLog::_prepare_registers() {
+    switch (_type) {
+    case HLL_DATA_EMPTY:
+        DCHECK_EQ(_registers.data, nullptr);
+        ChunkAllocator::instance()->allocate(HLL_REGISTERS_COUNT, &_registers);
+        DCHECK_NE(_registers.data, nullptr);
+        DCHECK_EQ(_registers.size, HLL_REGISTERS_COUNT);
+        memset(_registers.data, 0, HLL_REGISTERS_COUNT);
+        _type = HLL_DATA_FULL;
+        break;
+    case HLL_DATA_EXPLICIT:
+        _convert_explicit_to_register();
+        _type = HLL_DATA_FULL;
+        break;
+    default:
+        break;
+    }
+}
+
+bool HyperLogLog::merge(const Slice& slice) {
+    if (slice.data == nullptr || slice.size <= 0 || !is_valid(slice)) {
+        return false;
+    }
+    const uint8_t* ptr = (uint8_t*)slice.data;
+    auto type = (HllDataType)*ptr++;
+    switch (type) {
+    case HLL_DATA_EMPTY:
+        break;
+    case HLL_DATA_EXPLICIT: {
+        uint8_t num_explicits = *ptr++;
+        for (int i = 0; i < num_explicits; ++i) {
+            update(decode_fixed64_le(ptr));
+            ptr += 8;
+        }
+        break;
+    }
+    case HLL_DATA_SPARSE: {
+        _prepare_registers();
+        uint32_t num_registers = decode_fixed32_le(ptr);
+        ptr += 4;
+        for (uint32_t i = 0; i < num_registers; ++i) {
+            uint16_t register_idx = decode_fixed16_le(ptr);
+            ptr += 2;
+            _registers.data[register_idx] = std::max(_registers.data[register_idx], *ptr++);
+        }
+        break;
+    }
+    case HLL_DATA_FULL:
+        _prepare_registers();
+        _merge_registers(ptr);
+        break;
+    default:
+        return false;
+    }
+    return true;
+}
+
 size_t HyperLogLog::max_serialized_size() const {
     switch (_type) {
     case HLL_DATA_EMPTY:
@@ -367,11 +425,20 @@ int64_t HyperLogLog::estimate_cardinality() const {
         alpha = 0.7213f / (1 + 1.079f / num_streams);
     }
 
+    // 2^-v of every possible register value, instead of a powf per register.
+    static const auto inverse_powers = [] {
+        std::array<float, 256> powers;
+        for (size_t v = 0; v < powers.size(); ++v) {
+            powers[v] = powf(2.0f, -static_cast<float>(v));
+        }
+        return powers;
+    }();
+
     float harmonic_mean = 0;
     int num_zero_registers = 0;
 
     for (int i = 0; i < HLL_REGISTERS_COUNT; ++i) {
-        harmonic_mean += powf(2.0f, -_registers.data[i]);
+        harmonic_mean += inverse_powers[_registers.data[i]];
 
         if (_registers.data[i] == 0) {
             ++num_zero_registers;
@@ -414,7 +481,7 @@ std::string HyperLogLog::to_string() const {
     }
 }
 
-void HyperLogLog::_merge_registers(uint8_t* other_registers) {
+void HyperLogLog::_merge_registers(const uint8_t* other_registers) {
 #ifdef __AVX2__
     int loop = HLL_REGISTERS_COUNT / 32;
     uint8_t* dst = _registers.data;
@@ -168,6 +168,11 @@ public:
 
     void merge(const HyperLogLog& other);
 
+    // Merge the serialized HLL in |slice| without deserializing it into a HyperLogLog first, which saves
+    // allocating and copying the registers of a full HLL.
+    // Return false if |slice| is not a valid serialized HLL.
+    bool merge(const Slice& slice);
+
     // Return max size of serialized binary
     size_t max_serialized_size() const;
 
@@ -218,8 +223,11 @@ private:
 private:
     void _convert_explicit_to_register();
 
+    // Make this HLL a full one with registers, for merging registers into.
+    void _prepare_registers();
+
     // absorb other registers into this registers
-    void _merge_registers(uint8_t* other_registers);
+    void _merge_registers(const uint8_t* other_registers);
 
     // update one hash value into this registers
     void _update_registers(uint64_t hash_value) {
@@ -166,6 +166,56 @@ Status KVStore::write_batch(rocksdb::WriteBatch* batch) {
     return to_status(s);
 }
 
+std::shared_ptr<QueuedWriteBatch> KVStore::queue_batch(WriteBatch&& batch) {
+    auto queued = std::make_shared<QueuedWriteBatch>();
+    queued->batch = std::move(batch);
+    std::lock_guard l(_queue_lock);
+    _queued_batches.push_back(queued);
+    return queued;
+}
+
+Status KVStore::wait_batch(const std::shared_ptr<QueuedWriteBatch>& queued) {
+    std::unique_lock l(_queue_lock);
+    while (!queued->done) {
+        if (_writing_queued_batches) {
+            _queue_cv.wait(l);
+            continue;
+        }
+        // become the writer of all the batches queued so far, a batch queued after that will be
+        // written by the next writer, after this write finished.
+        _writing_queued_batches = true;
+        std::deque<std::shared_ptr<QueuedWriteBatch>> group;
+        group.swap(_queued_batches);
+        l.unlock();
+
+        Status st;
+        if (group.size() == 1) {
+            st = write_batch(&group.front()->batch);
+        } else {
+            WriteBatch merged;
+            for (auto& b : group) {
+                rocksdb::Status s = merged.Append(&b->batch);
+                if (!s.ok()) {
+                    st = to_status(s);
+                    break;
+                }
+            }
+            if (st.ok()) {
+                st = write_batch(&merged);
+            }
+        }
+
+        l.lock();
+        for (auto& b : group) {
+            b->status = st;
+            b->done = true;
+        }
+        _writing_queued_batches = false;
+        _queue_cv.notify_all();
+    }
+    return queued->status;
+}
+
 Status KVStore::remove(ColumnFamilyIndex column_family_index, const std::string& key) {
     StarRocksMetrics::instance()->meta_write_request_total.increment(1);
     rocksdb::ColumnFamilyHandle* handle = _handles[column_family_index];
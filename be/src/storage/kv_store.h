@@ -24,8 +24,12 @@
 
 #include <rocksdb/write_batch.h>
 
+#include <condition_variable>
+#include <deque>
 #include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <string_view>
 
@@ -42,6 +46,13 @@ namespace starrocks {
 using ColumnFamilyHandle = rocksdb::ColumnFamilyHandle;
 using WriteBatch = rocksdb::WriteBatch;
 
+// A batch queued by `KVStore::queue_batch` to be written with the batches of the other threads.
+struct QueuedWriteBatch {
+    WriteBatch batch;
+    Status status;
+    bool done = false;
+};
+
 class KVStore {
 public:
     explicit KVStore(std::string root_path);
@@ -56,6 +67,16 @@ public:
 
     Status write_batch(WriteBatch* batch);
 
+    // Group commit of the meta writes: queue |batch| to be written together with the batches
+    // queued by the other threads in a single rocksdb write. The batches are applied in the order
+    // they are queued, so that a caller queueing under its own lock keeps the order of its writes
+    // without holding the lock during the write.
+    std::shared_ptr<QueuedWriteBatch> queue_batch(WriteBatch&& batch);
+
+    // Wait until |queued| is written and return the status of the write. The first waiting thread
+    // writes all the batches queued so far, the others wait for it.
+    Status wait_batch(const std::shared_ptr<QueuedWriteBatch>& queued);
+
     Status remove(ColumnFamilyIndex column_family_index, const std::string& key);
 
     Status iterate(ColumnFamilyIndex column_family_index, const std::string& prefix,
@@ -73,6 +94,11 @@ private:
     std::string _root_path;
     rocksdb::DB* _db;
     std::vector<rocksdb::ColumnFamilyHandle*> _handles;
+
+    std::mutex _queue_lock;
+    std::condition_variable _queue_cv;
+    std::deque<std::shared_ptr<QueuedWriteBatch>> _queued_batches;
+    bool _writing_queued_batches = false;
 };
 
 } // namespace starrocks
@@ -134,6 +134,7 @@ OLAPStatus MemTable::flush() {
     }
     StarRocksMetrics::instance()->memtable_flush_total.increment(1);
     StarRocksMetrics::instance()->memtable_flush_duration_us.increment(duration_ns / 1000);
+    StarRocksMetrics::instance()->memtable_flush_latency_us.record(duration_ns / 1000);
     return OLAP_SUCCESS;
 }
 
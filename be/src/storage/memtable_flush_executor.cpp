@@ -86,6 +86,11 @@ void FlushToken::_flush_memtable(std::shared_ptr<MemTable> memtable) {
     _stats.flush_size_bytes += memtable->memory_usage();
 }
 
+Status FlushToken::error() const {
+    std::lock_guard<std::mutex> l(_error_lock);
+    return _error;
+}
+
 void FlushToken::_flush_vectorized_memtable(std::shared_ptr<vectorized::MemTable> memtable) {
     SCOPED_CLEANUP({ memtable.reset(); });
 
@@ -96,6 +101,17 @@ void FlushToken::_flush_vectorized_memtable(std::shared_ptr<vectorized::MemTable
 
     MonotonicStopWatch timer;
     timer.start();
+    // sorted and aggregated by the flush threads instead of the threads writing the memtables.
+    Status st = memtable->finalize();
+    if (!st.ok()) {
+        LOG(WARNING) << "Fail to finalize memtable, tablet_id=" << memtable->tablet_id() << ", " << st.to_string();
+        {
+            std::lock_guard<std::mutex> l(_error_lock);
+            _error = st;
+        }
+        _flush_status.store(OLAP_ERR_WRITER_DATA_WRITE_ERROR);
+        return;
+    }
     _flush_status.store(memtable->flush());
     if (_flush_status.load() != OLAP_SUCCESS) {
         return;
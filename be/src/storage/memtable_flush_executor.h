@@ -23,8 +23,10 @@
 
 #include <atomic>
 #include <memory>
+#include <mutex>
 #include <vector>
 
+#include "common/status.h"
 #include "storage/olap_define.h"
 #include "util/threadpool.h"
 
@@ -75,6 +77,9 @@ public:
     // get flush operations' statistics
     const FlushStatistic& get_stats() const { return _stats; }
 
+    // the error of the first failed vectorized memtable, OK if none failed.
+    Status error() const;
+
 private:
     void _flush_memtable(std::shared_ptr<MemTable> mem_table);
 
@@ -87,6 +92,9 @@ private:
     std::atomic<OLAPStatus> _flush_status;
 
     FlushStatistic _stats;
+
+    mutable std::mutex _error_lock;
+    Status _error;
 };
 
 // MemTableFlushExecutor is responsible for flushing memtables to disk.
@@ -110,6 +118,9 @@ public:
     OLAPStatus create_flush_token(std::unique_ptr<FlushToken>* flush_token,
                                   ThreadPool::ExecutionMode execution_mode = ThreadPool::ExecutionMode::SERIAL);
 
+    // The flush threads also write the segments of a large memtable in parallel.
+    ThreadPool* flush_pool() const { return _flush_pool.get(); }
+
 private:
     std::unique_ptr<ThreadPool> _flush_pool;
 };
@@ -381,6 +381,22 @@ class WrapperField;
 using KeyRange = std::pair<WrapperField*, WrapperField*>;
 
 // ReaderStatistics used to collect statistics when scan data from storage
+// The statistics of reading one column, which are collected only if
+// OlapReaderStatistics::collect_column_stats is set.
+struct ColumnReadStatistics {
+    int64_t pages_read = 0;
+    // the pages hit in page cache.
+    int64_t cached_pages = 0;
+    int64_t io_ns = 0;
+    int64_t compressed_bytes_read = 0;
+    int64_t decompress_ns = 0;
+    int64_t uncompressed_bytes_read = 0;
+    // the time of decoding the pages into columns.
+    int64_t decode_ns = 0;
+    // the bytes of the decoded columns.
+    int64_t bytes_read = 0;
+};
+
 struct OlapReaderStatistics {
     int64_t create_segment_iter_ns = 0;
     int64_t io_ns = 0;
@@ -428,6 +444,13 @@ struct OlapReaderStatistics {
     int64_t bitmap_index_filter_timer = 0;
 
     int64_t rows_del_vec_filtered = 0;
+
+    // the rows filtered by the cached results of the predicates on the segments.
+    int64_t rows_pred_cache_filtered = 0;
+
+    bool collect_column_stats = false;
+    // column name -> the statistics of reading the column.
+    std::map<std::string, ColumnReadStatistics> column_stats;
 };
 
 typedef uint32_t ColumnId;
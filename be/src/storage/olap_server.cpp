@@ -23,14 +23,19 @@
 #include <sys/socket.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <cmath>
 #include <ctime>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "common/status.h"
 #include "storage/olap_common.h"
+#include "storage/compaction_scheduler.h"
 #include "storage/olap_define.h"
 #include "storage/storage_engine.h"
+#include "storage/task/engine_storage_migration_task.h"
 #include "storage/update_manager.h"
 #include "storage/vectorized/compaction.h"
 #include "util/time.h"
@@ -93,27 +98,10 @@ Status StorageEngine::start_bg_threads() {
     }
     vectorized::Compaction::init(max_compaction_concurrency);
 
-    _base_compaction_threads.reserve(base_compaction_num_threads);
-    for (uint32_t i = 0; i < base_compaction_num_threads; ++i) {
-        _base_compaction_threads.emplace_back([this, data_dir_num, data_dirs, i] {
-            _base_compaction_thread_callback(nullptr, data_dirs[i % data_dir_num]);
-        });
-    }
-    for (auto& thread : _base_compaction_threads) {
-        thread.detach();
-    }
-    LOG(INFO) << "base compaction threads started. number: " << base_compaction_num_threads;
-
-    _cumulative_compaction_threads.reserve(cumulative_compaction_num_threads);
-    for (uint32_t i = 0; i < cumulative_compaction_num_threads; ++i) {
-        _cumulative_compaction_threads.emplace_back([this, data_dir_num, data_dirs, i] {
-            _cumulative_compaction_thread_callback(nullptr, data_dirs[i % data_dir_num]);
-        });
-    }
-    for (auto& thread : _cumulative_compaction_threads) {
-        thread.detach();
-    }
-    LOG(INFO) << "cumulative compaction threads started. number: " << cumulative_compaction_num_threads;
+    // the base and cumulative compactions of all the data dirs share the workers of the scheduler
+    _compaction_scheduler =
+            std::make_unique<CompactionScheduler>(_options.compaction_mem_tracker, _tablet_manager.get());
+    _compaction_scheduler->start(max_compaction_concurrency);
 
     int32_t update_compaction_num_threads_per_disk =
             std::max<int32_t>(1, config::update_compaction_num_threads_per_disk);
@@ -159,6 +147,10 @@ Status StorageEngine::start_bg_threads() {
         LOG(INFO) << "path scan/gc threads started. number:" << get_stores().size();
     }
 
+    _tiered_storage_migration_thread = std::thread([this] { _tiered_storage_migration_thread_callback(nullptr); });
+    _tiered_storage_migration_thread.detach();
+    LOG(INFO) << "tiered storage migration thread started";
+
     LOG(INFO) << "all storage engine's backgroud threads are started.";
     return Status::OK();
 }
@@ -181,33 +173,6 @@ void* StorageEngine::_fd_cache_clean_callback(void* arg) {
     return nullptr;
 }
 
-void* StorageEngine::_base_compaction_thread_callback(void* arg, DataDir* data_dir) {
-#ifdef GOOGLE_PROFILER
-    ProfilerRegisterThread();
-#endif
-    //string last_base_compaction_fs;
-    //TTabletId last_base_compaction_tablet_id = -1;
-    Status status = Status::OK();
-    while (!_stop_bg_worker) {
-        // must be here, because this thread is start on start and
-        if (!data_dir->reach_capacity_limit(0)) {
-            status = _perform_base_compaction(data_dir);
-        }
-        if (status.ok()) {
-            continue;
-        }
-
-        int32_t interval = config::base_compaction_check_interval_seconds;
-        if (interval <= 0) {
-            LOG(WARNING) << "base compaction check interval config is illegal: " << interval << ", force set to 1";
-            interval = 1;
-        }
-        SLEEP_IN_BG_WORKER(interval);
-    }
-
-    return nullptr;
-}
-
 void* StorageEngine::_update_compaction_thread_callback(void* arg, DataDir* data_dir) {
 #ifdef GOOGLE_PROFILER
     ProfilerRegisterThread();
@@ -295,34 +260,6 @@ void* StorageEngine::_disk_stat_monitor_thread_callback(void* arg) {
     return nullptr;
 }
 
-void* StorageEngine::_cumulative_compaction_thread_callback(void* arg, DataDir* data_dir) {
-#ifdef GOOGLE_PROFILER
-    ProfilerRegisterThread();
-#endif
-    LOG(INFO) << "try to start cumulative compaction process!";
-
-    Status status = Status::OK();
-    while (!_stop_bg_worker) {
-        // must be here, because this thread is start on start and
-        if (!data_dir->reach_capacity_limit(0)) {
-            status = _perform_cumulative_compaction(data_dir);
-        }
-        if (status.ok()) {
-            continue;
-        }
-
-        int32_t interval = config::cumulative_compaction_check_interval_seconds;
-        if (interval <= 0) {
-            LOG(WARNING) << "cumulative compaction check interval config is illegal:" << interval
-                         << "will be forced set to one";
-            interval = 1;
-        }
-        SLEEP_IN_BG_WORKER(interval);
-    }
-
-    return nullptr;
-}
-
 void* StorageEngine::_update_cache_expire_thread_callback(void* arg) {
 #ifdef GOOGLE_PROFILER
     ProfilerRegisterThread();
@@ -436,4 +373,128 @@ void* StorageEngine::_tablet_checkpoint_callback(void* arg) {
     return nullptr;
 }
 
+void* StorageEngine::_tiered_storage_migration_thread_callback(void* arg) {
+#ifdef GOOGLE_PROFILER
+    ProfilerRegisterThread();
+#endif
+    while (!_stop_bg_worker) {
+        int32_t interval = config::tiered_storage_migration_check_interval_seconds;
+        if (interval <= 0) {
+            LOG(WARNING) << "tiered_storage_migration_check_interval_seconds config is illegal: " << interval
+                         << ", force set to 3600";
+            interval = 3600;
+        }
+        SLEEP_IN_BG_WORKER(interval);
+        if (!config::enable_tiered_storage_migration) {
+            _tiered_storage_query_counts.clear();
+            continue;
+        }
+        time_t now = time(nullptr);
+        struct tm local_tm;
+        localtime_r(&now, &local_tm);
+        _perform_tiered_storage_migration(_in_tiered_storage_migration_window(
+                local_tm.tm_hour, config::tiered_storage_migration_start_hour,
+                config::tiered_storage_migration_end_hour));
+    }
+
+    return nullptr;
+}
+
+bool StorageEngine::_in_tiered_storage_migration_window(int32_t hour, int32_t start_hour, int32_t end_hour) {
+    if (start_hour <= end_hour) {
+        return hour >= start_hour && hour < end_hour;
+    }
+    return hour >= start_hour || hour < end_hour;
+}
+
+void StorageEngine::_collect_cold_tablets(const std::vector<TabletSharedPtr>& tablets, int64_t now,
+                                          std::vector<std::pair<int64_t, TabletSharedPtr>>* cold_tablets) {
+    std::unordered_map<int64_t, int64_t> query_counts;
+    for (const auto& tablet : tablets) {
+        int64_t query_count = tablet->query_count();
+        query_counts[tablet->tablet_id()] = query_count;
+        auto iter = _tiered_storage_query_counts.find(tablet->tablet_id());
+        // the heat of a tablet is unknown until it has been seen for a whole interval
+        if (iter == _tiered_storage_query_counts.end() || query_count != iter->second) {
+            continue;
+        }
+        // the migration task does not support updatable tablets
+        if (tablet->updates() != nullptr || tablet->tablet_state() != TABLET_RUNNING) {
+            continue;
+        }
+        int64_t newest_write_time = 0;
+        {
+            std::shared_lock rdlock(tablet->get_header_lock());
+            const RowsetSharedPtr rowset = tablet->rowset_with_max_version();
+            if (rowset == nullptr) {
+                continue;
+            }
+            newest_write_time = rowset->creation_time();
+        }
+        if (now - newest_write_time >= config::tiered_storage_cold_tablet_age_seconds) {
+            cold_tablets->emplace_back(newest_write_time, tablet);
+        }
+    }
+    _tiered_storage_query_counts.swap(query_counts);
+    // the coldest tablets first
+    std::sort(cold_tablets->begin(), cold_tablets->end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+}
+
+void StorageEngine::_perform_tiered_storage_migration(bool migrate) {
+    if (available_storage_medium_type_count() <= 1) {
+        return;
+    }
+    std::vector<TabletSharedPtr> tablets;
+    for (DataDir* store : get_stores()) {
+        if (store->storage_medium() != TStorageMedium::SSD) {
+            continue;
+        }
+        std::vector<TabletInfo> tablet_infos;
+        store->get_tablet_infos(&tablet_infos);
+        for (const auto& tablet_info : tablet_infos) {
+            TabletSharedPtr tablet =
+                    _tablet_manager->get_tablet(tablet_info.tablet_id, tablet_info.schema_hash, tablet_info.tablet_uid);
+            if (tablet != nullptr) {
+                tablets.emplace_back(std::move(tablet));
+            }
+        }
+    }
+    // pair of the time of the newest data and the tablet
+    std::vector<std::pair<int64_t, TabletSharedPtr>> cold_tablets;
+    _collect_cold_tablets(tablets, UnixSeconds(), &cold_tablets);
+    if (!migrate || cold_tablets.empty()) {
+        return;
+    }
+
+    size_t max_tablets = std::max(0, config::tiered_storage_migration_max_tablets_per_round);
+    if (cold_tablets.size() > max_tablets) {
+        cold_tablets.resize(max_tablets);
+    }
+    size_t num_migrated = 0;
+    for (const auto& [newest_write_time, tablet] : cold_tablets) {
+        if (_stop_bg_worker || !config::enable_tiered_storage_migration) {
+            break;
+        }
+        auto stores = get_stores_for_create_tablet(TStorageMedium::HDD);
+        if (stores.empty()) {
+            LOG(WARNING) << "no hdd data dir for tiered storage migration";
+            break;
+        }
+        EngineStorageMigrationTask task(tablet->tablet_id(), tablet->schema_hash(), stores[0]);
+        OLAPStatus res = execute_task(&task);
+        if (res != OLAP_SUCCESS) {
+            LOG(WARNING) << "fail to migrate cold tablet " << tablet->tablet_id() << " to " << stores[0]->path()
+                         << ", res=" << res;
+            continue;
+        }
+        ++num_migrated;
+        LOG(INFO) << "migrated cold tablet " << tablet->tablet_id() << " to " << stores[0]->path()
+                  << ", newest_write_time=" << newest_write_time;
+    }
+    if (num_migrated > 0) {
+        trigger_report();
+    }
+}
+
 } // namespace starrocks
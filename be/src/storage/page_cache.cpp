@@ -21,8 +21,13 @@
 
 #include "storage/page_cache.h"
 
+#include <algorithm>
+
+#include "common/config.h"
 #include "runtime/exec_env.h"
 #include "runtime/mem_tracker.h"
+#include "storage/clock_cache.h"
+#include "util/hash_util.hpp"
 #include "util/metrics.h"
 #include "util/starrocks_metrics.h"
 
@@ -38,7 +43,11 @@ StoragePageCache* StoragePageCache::_s_instance = nullptr;
 
 void StoragePageCache::create_global_cache(MemTracker* mem_tracker, size_t capacity) {
     if (_s_instance == nullptr) {
-        _s_instance = new StoragePageCache(mem_tracker, capacity);
+        size_t index_capacity = 0;
+        if (config::storage_page_cache_index_percent > 0 && config::storage_page_cache_index_percent < 100) {
+            index_capacity = capacity / 100 * config::storage_page_cache_index_percent;
+        }
+        _s_instance = new StoragePageCache(mem_tracker, capacity, index_capacity);
 #ifndef BE_TEST
         MetricRegistry* reg = StarRocksMetrics::instance()->metrics();
         reg->register_hook("page_cache_size_hook", update_cache_size);
@@ -60,23 +69,60 @@ void StoragePageCache::update_memory_usage_statistics() {
     _mem_tracker->consume(mem_usage - _mem_tracker->consumption());
 }
 
-StoragePageCache::StoragePageCache(MemTracker* mem_tracker, size_t capacity)
-        : _mem_tracker(mem_tracker), _cache(new_lru_cache(capacity)) {}
+static Cache* new_page_cache(size_t capacity) {
+    return config::enable_clock_cache ? new_clock_cache(capacity) : new_lru_cache(capacity);
+}
+
+StoragePageCache::StoragePageCache(MemTracker* mem_tracker, size_t capacity, size_t index_capacity)
+        : _mem_tracker(mem_tracker) {
+    if (index_capacity == 0 || index_capacity >= capacity) {
+        _cache.reset(new_page_cache(capacity));
+        return;
+    }
+    _cache.reset(new_page_cache(capacity - index_capacity));
+    _index_cache.reset(new_page_cache(index_capacity));
+    // remembers about 4x the misses of the data pages the tier holds, assuming 64KB pages.
+    _doorkeeper_size = std::max<size_t>(1024, (capacity - index_capacity) / 16384);
+    _doorkeeper.reset(new std::atomic<uint64_t>[_doorkeeper_size]);
+    for (size_t i = 0; i < _doorkeeper_size; i++) {
+        _doorkeeper[i].store(0, std::memory_order_relaxed);
+    }
+}
 
 StoragePageCache::~StoragePageCache() {
     _mem_tracker->release(_mem_tracker->consumption());
 }
 
-bool StoragePageCache::lookup(const CacheKey& key, PageCacheHandle* handle) {
-    auto* lru_handle = _cache->lookup(key.encode());
+bool StoragePageCache::lookup(const CacheKey& key, PageCacheHandle* handle, bool data_page) {
+    Cache* cache = _cache_of(data_page);
+    auto* lru_handle = cache->lookup(key.encode());
     if (lru_handle == nullptr) {
         return false;
     }
-    *handle = PageCacheHandle(_cache.get(), lru_handle);
+    *handle = PageCacheHandle(cache, lru_handle);
     return true;
 }
 
-void StoragePageCache::insert(const CacheKey& key, const Slice& data, PageCacheHandle* handle, bool in_memory) {
+bool StoragePageCache::_admit(const std::string& key) {
+    // 0 marks the empty slot.
+    uint64_t hash = HashUtil::hash64(key.data(), key.size(), 0) | 1;
+    std::atomic<uint64_t>& slot = _doorkeeper[hash % _doorkeeper_size];
+    if (slot.load(std::memory_order_relaxed) == hash) {
+        slot.store(0, std::memory_order_relaxed);
+        return true;
+    }
+    slot.store(hash, std::memory_order_relaxed);
+    return false;
+}
+
+bool StoragePageCache::insert(const CacheKey& key, const Slice& data, PageCacheHandle* handle, bool in_memory,
+                              bool data_page) {
+    std::string encoded_key = key.encode();
+    // the pages of the in memory tables are always admitted.
+    if (data_page && _doorkeeper != nullptr && !in_memory && !_admit(encoded_key)) {
+        return false;
+    }
+
     auto deleter = [](const starrocks::CacheKey& key, void* value) { delete[](uint8_t*) value; };
 
     CachePriority priority = CachePriority::NORMAL;
@@ -84,8 +130,10 @@ void StoragePageCache::insert(const CacheKey& key, const Slice& data, PageCacheH
         priority = CachePriority::DURABLE;
     }
 
-    auto* lru_handle = _cache->insert(key.encode(), data.data, data.size, deleter, priority);
-    *handle = PageCacheHandle(_cache.get(), lru_handle);
+    Cache* cache = _cache_of(data_page);
+    auto* lru_handle = cache->insert(encoded_key, data.data, data.size, deleter, priority);
+    *handle = PageCacheHandle(cache, lru_handle);
+    return true;
 }
 
 } // namespace starrocks
@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <utility>
@@ -35,6 +36,10 @@ class MemTracker;
 
 // Warpper around Cache, and used for cache page of column datas
 // in Segment.
+// The index pages (short key, ordinal, zone map and the other indexed columns) and the data pages can be
+// kept in two tiers, so that the large scans of the data pages can't evict the small and hot index pages.
+// A data page is only admitted into its tier on the second miss within a short history, the pages read once
+// by a scan pass through without evicting the others.
 // TODO(zc): We should add some metric to see cache hit/miss rate.
 class StoragePageCache {
 public:
@@ -67,7 +72,9 @@ public:
     // Client should call create_global_cache before.
     static StoragePageCache* instance() { return _s_instance; }
 
-    StoragePageCache(MemTracker* mem_tracker, size_t capacity);
+    // |index_capacity| bytes of |capacity| are reserved for the index pages, or 0 if the index pages and the
+    // data pages share one cache without admission.
+    StoragePageCache(MemTracker* mem_tracker, size_t capacity, size_t index_capacity = 0);
 
     void update_memory_usage_statistics();
 
@@ -78,22 +85,38 @@ public:
     // destructs.
     //
     // Return true if entry is found, otherwise return false.
-    bool lookup(const CacheKey& key, PageCacheHandle* handle);
+    bool lookup(const CacheKey& key, PageCacheHandle* handle, bool data_page = false);
 
     // Insert a page with key into this cache.
     // Given hanlde will be set to valid reference.
     // This function is thread-safe, and when two clients insert two same key
     // concurrently, this function can assure that only one page is cached.
     // The in_memory page will have higher priority.
-    void insert(const CacheKey& key, const Slice& data, PageCacheHandle* handle, bool in_memory = false);
+    // Return false if the data page is not admitted, the handle is untouched and the caller still owns |data|.
+    bool insert(const CacheKey& key, const Slice& data, PageCacheHandle* handle, bool in_memory = false,
+                bool data_page = false);
 
-    size_t memory_usage() const { return _cache->get_memory_usage(); }
+    size_t memory_usage() const {
+        return _cache->get_memory_usage() + (_index_cache != nullptr ? _index_cache->get_memory_usage() : 0);
+    }
 
 private:
+    Cache* _cache_of(bool data_page) const {
+        return data_page || _index_cache == nullptr ? _cache.get() : _index_cache.get();
+    }
+
+    // whether the data page of |key| has missed recently, records the miss otherwise.
+    bool _admit(const std::string& key);
+
     static StoragePageCache* _s_instance;
 
     MemTracker* _mem_tracker = nullptr;
+    // the data pages, and the index pages too if |_index_cache| is null.
     std::unique_ptr<Cache> _cache = nullptr;
+    std::unique_ptr<Cache> _index_cache = nullptr;
+    // the hashes of the data pages missed recently, a slot is overwritten by the later miss mapped to it.
+    std::unique_ptr<std::atomic<uint64_t>[]> _doorkeeper;
+    size_t _doorkeeper_size = 0;
 };
 
 // A handle for StoragePageCache entry. This class make it easy to handle
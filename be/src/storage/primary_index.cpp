@@ -2,16 +2,24 @@
 
 #include "storage/primary_index.h"
 
+#include <functional>
 #include <mutex>
+#include <unordered_set>
 
+#include "common/config.h"
+#include "env/env.h"
 #include "storage/primary_key_encoder.h"
 #include "storage/rowset/beta_rowset.h"
 #include "storage/rowset/rowset.h"
 #include "storage/rowset/vectorized/rowset_options.h"
+#include "storage/storage_engine.h"
 #include "storage/tablet.h"
 #include "storage/tablet_updates.h"
 #include "storage/vectorized/chunk_helper.h"
 #include "storage/vectorized/tablet_reader.h"
+#include "util/coding.h"
+#include "util/crc32c.h"
+#include "util/parallel_for.h"
 #include "util/starrocks_metrics.h"
 
 namespace starrocks {
@@ -49,10 +57,27 @@ public:
                              const vector<uint32_t>& src_rssid, vector<uint32_t>* failed) = 0;
     virtual void erase(const vectorized::Column& pks, DeletesMap* deletes) = 0;
 
+    // looks up the positions of |pks|, the keys not found get PrimaryIndex::NOT_FOUND.
+    virtual void get(const vectorized::Column& pks, vector<uint64_t>* rowids) const = 0;
+
+    // same as insert, but can be called by multiple threads concurrently. the keys are grouped by the
+    // sub map they fall into, and every sub map is inserted with its lock in |sub_map_locks| held.
+    virtual Status insert_concurrently(uint32_t rssid, const vector<uint32_t>& rowids, const vectorized::Column& pks,
+                                       std::mutex* sub_map_locks) = 0;
+
     // just an estimate value for now.
     virtual std::size_t memory_usage() const = 0;
 
     virtual std::string memory_info() const = 0;
+
+    using DumpFlusher = std::function<Status(const std::string& block, uint32_t num_entries)>;
+
+    // encodes all the entries into blocks of about |block_size| bytes and passes them to |flush|.
+    // a block can only be loaded by the same implementation.
+    virtual Status dump(size_t block_size, const DumpFlusher& flush) const = 0;
+
+    // inserts the |num_entries| entries of a |block| dumped earlier.
+    virtual Status load_block(const Slice& block, uint32_t num_entries) = 0;
 };
 
 #pragma pack(push)
@@ -89,6 +114,106 @@ public:
 
 const uint32_t PREFETCHN = 8;
 
+// appends the old positions replaced or erased to a DeletesMap. the consecutive old positions are
+// usually of the same segment, so the list of the last segment is kept instead of looking it up again.
+class DeletesCollector {
+public:
+    explicit DeletesCollector(PrimaryIndex::DeletesMap* deletes) : _deletes(deletes) {}
+
+    void add(uint64_t old) {
+        auto rssid = (uint32_t)(old >> 32);
+        if (_last == nullptr || rssid != _last_rssid) {
+            _last = &(*_deletes)[rssid];
+            _last_rssid = rssid;
+        }
+        _last->push_back((uint32_t)(old & 0xffffffff));
+    }
+
+private:
+    PrimaryIndex::DeletesMap* _deletes;
+    uint32_t _last_rssid = 0;
+    vector<uint32_t>* _last = nullptr;
+};
+
+static Status duplicate_key_error(uint32_t rssid, uint32_t rowid, uint64_t old) {
+    std::string msg = strings::Substitute("insert found duplicate key new(rssid=$0 rowid=$1) old(rssid=$2 rowid=$3)",
+                                          rssid, rowid, (uint32_t)(old >> 32), (uint32_t)(old & 0xffffffff));
+    LOG(ERROR) << msg;
+    return Status::InternalError(msg);
+}
+
+// |key_at| returns the i-th key of the batch as the key of |map|.
+template <typename Map, typename KeyAt>
+static Status insert_fixed_size_concurrently(Map* map, uint32_t rssid, const vector<uint32_t>& rowids,
+                                             const KeyAt& key_at, std::mutex* sub_map_locks) {
+    using Key = typename Map::key_type;
+    DCHECK_EQ(phmap_hash_table_shard, map->subcnt());
+    const uint32_t size = rowids.size();
+    std::vector<Key> keys(size);
+    std::vector<size_t> hashes(size);
+    std::vector<uint32_t> sub_maps[phmap_hash_table_shard];
+    for (uint32_t i = 0; i < size; i++) {
+        keys[i] = key_at(i);
+        hashes[i] = map->hash(keys[i]);
+        sub_maps[map->subidx(hashes[i])].push_back(i);
+    }
+    uint64_t base = (((uint64_t)rssid) << 32);
+    for (size_t s = 0; s < phmap_hash_table_shard; s++) {
+        if (sub_maps[s].empty()) {
+            continue;
+        }
+        std::lock_guard<std::mutex> lg(sub_map_locks[s]);
+        for (uint32_t i : sub_maps[s]) {
+            auto p = map->emplace_with_hash(hashes[i], keys[i], RowIdPack4(base + rowids[i]));
+            if (!p.second) {
+                return duplicate_key_error(rssid, rowids[i], p.first->second.value);
+            }
+        }
+    }
+    return Status::OK();
+}
+
+// the entry of a fixed size key is dumped as the raw key followed by the rssid and rowid.
+template <typename Map>
+static Status dump_fixed_size_entries(const Map& map, size_t block_size, const HashIndex::DumpFlusher& flush) {
+    using Key = typename Map::key_type;
+    std::string block;
+    block.reserve(block_size + sizeof(Key) + sizeof(uint64_t));
+    uint32_t num_entries = 0;
+    for (const auto& e : map) {
+        block.append(reinterpret_cast<const char*>(&e.first), sizeof(Key));
+        put_fixed64_le(&block, e.second.value);
+        num_entries++;
+        if (block.size() >= block_size) {
+            RETURN_IF_ERROR(flush(block, num_entries));
+            block.clear();
+            num_entries = 0;
+        }
+    }
+    return num_entries > 0 ? flush(block, num_entries) : Status::OK();
+}
+
+template <typename Map>
+static Status load_fixed_size_entries(Map* map, const Slice& block, uint32_t num_entries) {
+    using Key = typename Map::key_type;
+    constexpr size_t entry_size = sizeof(Key) + sizeof(uint64_t);
+    if (block.size != num_entries * entry_size) {
+        return Status::Corruption(Substitute("primary index snapshot block size $0 != $1*$2", block.size,
+                                             num_entries, entry_size));
+    }
+    map->reserve(map->size() + num_entries);
+    for (uint32_t i = 0; i < num_entries; i++) {
+        const char* p = block.data + i * entry_size;
+        Key key;
+        memcpy(&key, p, sizeof(Key));
+        RowIdPack4 v(decode_fixed64_le(reinterpret_cast<const uint8_t*>(p + sizeof(Key))));
+        if (!map->emplace(key, v).second) {
+            return Status::Corruption("duplicate key in primary index snapshot");
+        }
+    }
+    return Status::OK();
+}
+
 template <typename Key>
 class HashIndexImpl : public HashIndex {
 private:
@@ -152,46 +277,13 @@ public:
     }
 
     void upsert(uint32_t rssid, uint32_t rowid_start, const vectorized::Column& pks, DeletesMap* deletes) override {
-        auto* keys = reinterpret_cast<const Key*>(pks.raw_data());
-        auto size = pks.size();
-        uint64_t base = (((uint64_t)rssid) << 32) + rowid_start;
-        for (uint32_t i = 0; i < size; i++) {
-            uint32_t prefetch_i = i + PREFETCHN;
-            if (LIKELY(prefetch_i < size)) _map.prefetch(keys[prefetch_i]);
-            RowIdPack4 v(base + i);
-            auto p = _map.insert({keys[i], v});
-            if (!p.second) {
-                uint64_t old = p.first->second.value;
-                if ((old >> 32) == rssid) {
-                    LOG(ERROR) << "found duplicate in upsert data rssid:" << rssid << " key=" << keys[i] << " idx=" << i
-                               << " rowid=" << rowid_start + i;
-                }
-                (*deletes)[(uint32_t)(old >> 32)].push_back((uint32_t)(old & 0xffffffff));
-                p.first->second = v;
-            }
-        }
+        _upsert(rssid, pks, [rowid_start](uint32_t i) { return rowid_start + i; }, deletes);
     }
 
     void upsert(uint32_t rssid, const vector<uint32_t>& rowids, const vectorized::Column& pks,
                 DeletesMap* deletes) override {
-        auto* keys = reinterpret_cast<const Key*>(pks.raw_data());
-        auto size = pks.size();
-        uint64_t base = (((uint64_t)rssid) << 32);
-        for (auto i = 0; i < size; i++) {
-            uint32_t prefetch_i = i + PREFETCHN;
-            if (LIKELY(prefetch_i < size)) _map.prefetch(keys[prefetch_i]);
-            RowIdPack4 v(base + rowids[i]);
-            auto p = _map.insert({keys[i], v});
-            if (!p.second) {
-                uint64_t old = p.first->second.value;
-                if ((old >> 32) == rssid) {
-                    LOG(ERROR) << "found duplicate in upsert data rssid:" << rssid << " key=" << keys[i] << " idx=" << i
-                               << " rowid=" << rowids[i];
-                }
-                (*deletes)[(uint32_t)(old >> 32)].push_back((uint32_t)(old & 0xffffffff));
-                p.first->second = v;
-            }
-        }
+        DCHECK(pks.size() == rowids.size());
+        _upsert(rssid, pks, [&rowids](uint32_t i) { return rowids[i]; }, deletes);
     }
 
     void try_replace(uint32_t rssid, uint32_t rowid_start, const vectorized::Column& pks,
@@ -232,16 +324,40 @@ public:
         }
     }
 
+    Status insert_concurrently(uint32_t rssid, const vector<uint32_t>& rowids, const vectorized::Column& pks,
+                               std::mutex* sub_map_locks) override {
+        DCHECK(pks.size() == rowids.size());
+        auto* keys = reinterpret_cast<const Key*>(pks.raw_data());
+        return insert_fixed_size_concurrently(
+                &_map, rssid, rowids, [keys](uint32_t i) { return keys[i]; }, sub_map_locks);
+    }
+
+    void get(const vectorized::Column& pks, vector<uint64_t>* rowids) const override {
+        auto* keys = reinterpret_cast<const Key*>(pks.raw_data());
+        const uint32_t size = pks.size();
+        auto hashes = _compute_hashes(keys, size);
+        rowids->resize(size);
+        for (uint32_t i = 0; i < size; i++) {
+            if (LIKELY(i + PREFETCHN < size)) {
+                _map.prefetch_hash(hashes[i + PREFETCHN]);
+            }
+            auto iter = _map.find(keys[i], hashes[i]);
+            (*rowids)[i] = iter != _map.end() ? iter->second.value : PrimaryIndex::NOT_FOUND;
+        }
+    }
+
     void erase(const vectorized::Column& pks, DeletesMap* deletes) override {
         auto* keys = reinterpret_cast<const Key*>(pks.raw_data());
-        auto size = pks.size();
-        for (auto i = 0; i < size; i++) {
-            uint32_t prefetch_i = i + PREFETCHN;
-            if (LIKELY(prefetch_i < size)) _map.prefetch(keys[prefetch_i]);
-            auto iter = _map.find(keys[i]);
+        const uint32_t size = pks.size();
+        auto hashes = _compute_hashes(keys, size);
+        DeletesCollector collector(deletes);
+        for (uint32_t i = 0; i < size; i++) {
+            if (LIKELY(i + PREFETCHN < size)) {
+                _map.prefetch_hash(hashes[i + PREFETCHN]);
+            }
+            auto iter = _map.find(keys[i], hashes[i]);
             if (iter != _map.end()) {
-                uint64_t old = iter->second.value;
-                (*deletes)[(uint32_t)(old >> 32)].push_back((uint32_t)(old & 0xffffffff));
+                collector.add(iter->second.value);
                 _map.erase(iter);
             }
         }
@@ -259,6 +375,53 @@ public:
         }
         return Substitute("$0M($1/$2 $3)", memory_usage() / (1024 * 1024), size(), capacity(), caps_str);
     }
+
+    Status dump(size_t block_size, const DumpFlusher& flush) const override {
+        return dump_fixed_size_entries(_map, block_size, flush);
+    }
+
+    Status load_block(const Slice& block, uint32_t num_entries) override {
+        return load_fixed_size_entries(&_map, block, num_entries);
+    }
+
+private:
+    // the hashes of a whole batch are computed in a tight loop at first, which the compiler can
+    // vectorize, instead of hashing every key twice to prefetch and to probe it.
+    std::vector<size_t> _compute_hashes(const Key* keys, uint32_t size) const {
+        std::vector<size_t> hashes(size);
+        for (uint32_t i = 0; i < size; i++) {
+            hashes[i] = _map.hash(keys[i]);
+        }
+        return hashes;
+    }
+
+    // |rowid_at| returns the rowid of the i-th key, the slots of the keys PREFETCHN rows ahead are
+    // prefetched while upserting the current one.
+    template <typename RowidAt>
+    void _upsert(uint32_t rssid, const vectorized::Column& pks, const RowidAt& rowid_at, DeletesMap* deletes) {
+        auto* keys = reinterpret_cast<const Key*>(pks.raw_data());
+        const uint32_t size = pks.size();
+        auto hashes = _compute_hashes(keys, size);
+        uint64_t base = (((uint64_t)rssid) << 32);
+        DeletesCollector collector(deletes);
+        for (uint32_t i = 0; i < size; i++) {
+            if (LIKELY(i + PREFETCHN < size)) {
+                _map.prefetch_hash(hashes[i + PREFETCHN]);
+            }
+            const uint32_t rowid = rowid_at(i);
+            RowIdPack4 v(base + rowid);
+            auto p = _map.emplace_with_hash(hashes[i], keys[i], v);
+            if (!p.second) {
+                uint64_t old = p.first->second.value;
+                if ((old >> 32) == rssid) {
+                    LOG(ERROR) << "found duplicate in upsert data rssid:" << rssid << " key=" << keys[i] << " idx=" << i
+                               << " rowid=" << rowid;
+                }
+                collector.add(old);
+                p.first->second = v;
+            }
+        }
+    }
 };
 
 template <size_t S>
@@ -371,6 +534,7 @@ public:
 
     void upsert(uint32_t rssid, uint32_t rowid_start, const vectorized::Column& pks, DeletesMap* deletes) override {
         auto* keys = reinterpret_cast<const Slice*>(pks.raw_data());
+        DeletesCollector collector(deletes);
         uint32_t size = (uint32_t)pks.size();
         uint64_t base = (((uint64_t)rssid) << 32) + rowid_start;
         FixSlice<S> prefetch_keys[PREFETCHN];
@@ -390,7 +554,7 @@ public:
                     LOG(ERROR) << "found duplicate in upsert data rssid:" << rssid << " key=" << keys[i].to_string()
                                << " [" << hexdump(keys[i].data, keys[i].size) << "]";
                 }
-                (*deletes)[(uint32_t)(old >> 32)].push_back((uint32_t)(old & 0xffffffff));
+                collector.add(old);
                 p.first->second = v;
             }
             uint32_t prefetch_i = i + PREFETCHN;
@@ -405,6 +569,7 @@ public:
     void upsert(uint32_t rssid, const vector<uint32_t>& rowids, const vectorized::Column& pks,
                 DeletesMap* deletes) override {
         auto* keys = reinterpret_cast<const Slice*>(pks.raw_data());
+        DeletesCollector collector(deletes);
         uint32_t size = (uint32_t)pks.size();
         uint64_t base = (((uint64_t)rssid) << 32);
         FixSlice<S> prefetch_keys[PREFETCHN];
@@ -424,7 +589,7 @@ public:
                     LOG(ERROR) << "found duplicate in upsert data rssid:" << rssid << " key=" << keys[i].to_string()
                                << " [" << hexdump(keys[i].data, keys[i].size) << "]";
                 }
-                (*deletes)[(uint32_t)(old >> 32)].push_back((uint32_t)(old & 0xffffffff));
+                collector.add(old);
                 p.first->second = v;
             }
             uint32_t prefetch_i = i + PREFETCHN;
@@ -498,8 +663,29 @@ public:
         }
     }
 
+    Status insert_concurrently(uint32_t rssid, const vector<uint32_t>& rowids, const vectorized::Column& pks,
+                               std::mutex* sub_map_locks) override {
+        DCHECK(pks.size() == rowids.size());
+        auto* keys = reinterpret_cast<const Slice*>(pks.raw_data());
+        return insert_fixed_size_concurrently(
+                &_map, rssid, rowids, [keys](uint32_t i) { return FixSlice<S>(keys[i]); }, sub_map_locks);
+    }
+
+    void get(const vectorized::Column& pks, vector<uint64_t>* rowids) const override {
+        auto* keys = reinterpret_cast<const Slice*>(pks.raw_data());
+        const uint32_t size = pks.size();
+        rowids->resize(size);
+        FixSlice<S> key;
+        for (uint32_t i = 0; i < size; i++) {
+            key.assign(keys[i]);
+            auto iter = _map.find(key);
+            (*rowids)[i] = iter != _map.end() ? iter->second.value : PrimaryIndex::NOT_FOUND;
+        }
+    }
+
     void erase(const vectorized::Column& pks, DeletesMap* deletes) override {
         auto* keys = reinterpret_cast<const Slice*>(pks.raw_data());
+        DeletesCollector collector(deletes);
         uint32_t size = pks.size();
         FixSlice<S> prefetch_keys[PREFETCHN];
         size_t prefetch_hashs[PREFETCHN];
@@ -513,7 +699,7 @@ public:
             auto iter = _map.find(prefetch_keys[pslot], prefetch_hashs[pslot]);
             if (iter != _map.end()) {
                 uint64_t old = iter->second.value;
-                (*deletes)[(uint32_t)(old >> 32)].push_back((uint32_t)(old & 0xffffffff));
+                collector.add(old);
                 _map.erase(iter);
             }
             uint32_t prefetch_i = i + PREFETCHN;
@@ -535,6 +721,14 @@ public:
         }
         return Substitute("$0M($1/$2 $3)", memory_usage() / (1024 * 1024), size(), capacity(), caps_str);
     }
+
+    Status dump(size_t block_size, const DumpFlusher& flush) const override {
+        return dump_fixed_size_entries(_map, block_size, flush);
+    }
+
+    Status load_block(const Slice& block, uint32_t num_entries) override {
+        return load_fixed_size_entries(&_map, block, num_entries);
+    }
 };
 
 struct StringHash {
@@ -550,7 +744,8 @@ private:
                                           phmap::NullMutex, false>;
 
     StringMap _map;
-    size_t _total_length = 0;
+    // updated atomically by insert_concurrently
+    std::atomic<size_t> _total_length{0};
 
 public:
     HashIndexImpl() = default;
@@ -619,6 +814,7 @@ public:
 
     void upsert(uint32_t rssid, uint32_t rowid_start, const vectorized::Column& pks, DeletesMap* deletes) override {
         auto* keys = reinterpret_cast<const Slice*>(pks.raw_data());
+        DeletesCollector collector(deletes);
         uint32_t size = pks.size();
         uint64_t base = (((uint64_t)rssid) << 32) + rowid_start;
         for (uint32_t i = 0; i < size; i++) {
@@ -635,7 +831,7 @@ public:
                     LOG(ERROR) << "found duplicate in upsert data rssid:" << rssid << " key=" << keys[i].to_string()
                                << " [" << hexdump(keys[i].data, keys[i].size) << "]";
                 }
-                (*deletes)[(uint32_t)(old >> 32)].push_back((uint32_t)(old & 0xffffffff));
+                collector.add(old);
                 p.first->second = v;
             } else {
                 _total_length += keys[i].size;
@@ -646,6 +842,7 @@ public:
     void upsert(uint32_t rssid, const vector<uint32_t>& rowids, const vectorized::Column& pks,
                 DeletesMap* deletes) override {
         auto* keys = reinterpret_cast<const Slice*>(pks.raw_data());
+        DeletesCollector collector(deletes);
         uint32_t size = pks.size();
         uint64_t base = (((uint64_t)rssid) << 32);
         for (uint32_t i = 0; i < size; i++) {
@@ -662,7 +859,7 @@ public:
                     LOG(ERROR) << "found duplicate in upsert data rssid:" << rssid << " key=" << keys[i].to_string()
                                << " [" << hexdump(keys[i].data, keys[i].size) << "]";
                 }
-                (*deletes)[(uint32_t)(old >> 32)].push_back((uint32_t)(old & 0xffffffff));
+                collector.add(old);
                 p.first->second = v;
             } else {
                 _total_length += keys[i].size;
@@ -714,8 +911,52 @@ public:
         }
     }
 
+    Status insert_concurrently(uint32_t rssid, const vector<uint32_t>& rowids, const vectorized::Column& pks,
+                               std::mutex* sub_map_locks) override {
+        auto* keys = reinterpret_cast<const Slice*>(pks.raw_data());
+        const uint32_t size = pks.size();
+        DCHECK(size == rowids.size());
+        DCHECK_EQ(phmap_hash_table_shard, _map.subcnt());
+        std::vector<string> key_strs(size);
+        std::vector<size_t> hashes(size);
+        std::vector<uint32_t> sub_maps[phmap_hash_table_shard];
+        size_t total_length = 0;
+        for (uint32_t i = 0; i < size; i++) {
+            key_strs[i] = keys[i].to_string();
+            hashes[i] = _map.hash(key_strs[i]);
+            sub_maps[_map.subidx(hashes[i])].push_back(i);
+            total_length += keys[i].size;
+        }
+        uint64_t base = (((uint64_t)rssid) << 32);
+        for (size_t s = 0; s < phmap_hash_table_shard; s++) {
+            if (sub_maps[s].empty()) {
+                continue;
+            }
+            std::lock_guard<std::mutex> lg(sub_map_locks[s]);
+            for (uint32_t i : sub_maps[s]) {
+                auto p = _map.emplace_with_hash(hashes[i], std::move(key_strs[i]), base + rowids[i]);
+                if (!p.second) {
+                    return duplicate_key_error(rssid, rowids[i], p.first->second);
+                }
+            }
+        }
+        _total_length += total_length;
+        return Status::OK();
+    }
+
+    void get(const vectorized::Column& pks, vector<uint64_t>* rowids) const override {
+        auto* keys = reinterpret_cast<const Slice*>(pks.raw_data());
+        const uint32_t size = pks.size();
+        rowids->resize(size);
+        for (uint32_t i = 0; i < size; i++) {
+            auto p = _map.find(keys[i].to_string());
+            (*rowids)[i] = p != _map.end() ? p->second : PrimaryIndex::NOT_FOUND;
+        }
+    }
+
     void erase(const vectorized::Column& pks, DeletesMap* deletes) override {
         auto* keys = reinterpret_cast<const Slice*>(pks.raw_data());
+        DeletesCollector collector(deletes);
         uint32_t size = pks.size();
         for (uint32_t i = 0; i < size; i++) {
             uint32_t prefetch_i = i + PREFETCHN;
@@ -726,7 +967,7 @@ public:
             auto p = _map.find(keys[i].to_string());
             if (p != _map.end()) {
                 uint64_t old = p->second;
-                (*deletes)[(uint32_t)(old >> 32)].push_back((uint32_t)(old & 0xffffffff));
+                collector.add(old);
                 _map.erase(p);
                 _total_length -= keys[i].size;
             }
@@ -753,6 +994,49 @@ public:
         }
         return Substitute("$0M($1/$2 $3)", memory_usage() / (1024 * 1024), size(), capacity(), caps_str);
     }
+
+    // the entry is dumped as the varint length and bytes of the key followed by the rssid and rowid.
+    Status dump(size_t block_size, const DumpFlusher& flush) const override {
+        std::string block;
+        block.reserve(block_size);
+        uint32_t num_entries = 0;
+        for (const auto& e : _map) {
+            put_varint32(&block, e.first.size());
+            block.append(e.first);
+            put_fixed64_le(&block, e.second);
+            num_entries++;
+            if (block.size() >= block_size) {
+                RETURN_IF_ERROR(flush(block, num_entries));
+                block.clear();
+                num_entries = 0;
+            }
+        }
+        return num_entries > 0 ? flush(block, num_entries) : Status::OK();
+    }
+
+    Status load_block(const Slice& block, uint32_t num_entries) override {
+        auto* p = reinterpret_cast<const uint8_t*>(block.data);
+        auto* limit = p + block.size;
+        _map.reserve(_map.size() + num_entries);
+        for (uint32_t i = 0; i < num_entries; i++) {
+            uint32_t key_size = 0;
+            p = decode_varint32_ptr(p, limit, &key_size);
+            if (p == nullptr || static_cast<size_t>(limit - p) < key_size + sizeof(uint64_t)) {
+                return Status::Corruption("truncated primary index snapshot block");
+            }
+            std::string key(reinterpret_cast<const char*>(p), key_size);
+            p += key_size;
+            if (!_map.emplace(std::move(key), decode_fixed64_le(p)).second) {
+                return Status::Corruption("duplicate key in primary index snapshot");
+            }
+            p += sizeof(uint64_t);
+            _total_length += key_size;
+        }
+        if (p != limit) {
+            return Status::Corruption("primary index snapshot block has trailing bytes");
+        }
+        return Status::OK();
+    }
 };
 
 static std::unique_ptr<HashIndex> create_hash_index(FieldType key_type, size_t fix_size) {
@@ -890,13 +1174,118 @@ Status PrimaryIndex::_do_load(Tablet* tablet) {
                   << " #rowset:" << rowsets.size() << " #segment:" << total_segments << " #row:" << total_rows << " -"
                   << total_dels << "=" << total_rows - total_dels << " bytes:" << total_data_size;
     }
+
+    Status st_snapshot = _load_snapshot(tablet, pkey_schema, apply_version, rowsets, total_rows - total_dels);
+    if (st_snapshot.ok()) {
+        _tablet_id = tablet->tablet_id();
+        LOG(INFO) << "load primary index from snapshot finish tablet:" << tablet->tablet_id()
+                  << " version:" << apply_version << " rowsets:" << int_list_to_string(rowset_ids)
+                  << " size:" << size() << " memory:" << memory_usage()
+                  << " duration: " << timer.elapsed_time() / 1000000 << "ms";
+        return Status::OK();
+    }
+    if (!st_snapshot.is_not_found()) {
+        LOG(WARNING) << "load primary index snapshot failed, scan all segments instead. tablet:" << tablet->tablet_id()
+                     << " " << st_snapshot;
+    }
+    // drop the entries loaded from the snapshot
+    _set_schema(pkey_schema);
     if (total_rows > total_dels) {
         _pkey_to_rssid_rowid->reserve(total_rows - total_dels);
     }
+    st = _insert_rowsets(tablet, pkey_schema, apply_version, rowsets, false);
+    if (!st.ok()) {
+        LOG(ERROR) << "load index failed: tablet=" << tablet->tablet_id()
+                   << " rowsets:" << int_list_to_string(rowset_ids) << " reason: " << st.to_string()
+                   << " current_size:" << size() << " updates: " << tablet->updates()->debug_string();
+        return st;
+    }
+    _tablet_id = tablet->tablet_id();
+    if (size() != total_rows - total_dels) {
+        LOG(WARNING) << Substitute("load primary index row count not match tablet:$0 index:$1 != stats:$2", _tablet_id,
+                                   size(), total_rows - total_dels);
+    }
+    LOG(INFO) << "load primary index finish tablet:" << tablet->tablet_id() << " version:" << apply_version
+              << " #rowset:" << rowsets.size() << " #segment:" << total_segments << " data_size:" << total_data_size
+              << " rowsets:" << int_list_to_string(rowset_ids) << " size:" << size() << " capacity:" << capacity()
+              << " memory:" << memory_usage() << " duration: " << timer.elapsed_time() / 1000000 << "ms";
+    return Status::OK();
+}
 
-    OlapReaderStatistics stats;
+Status PrimaryIndex::_insert_rowsets(Tablet* tablet, const vectorized::Schema& pkey_schema, int64_t apply_version,
+                                     const std::vector<RowsetSharedPtr>& rowsets, bool upsert) {
+    KVStore* meta = tablet->data_dir()->get_meta();
+    size_t total_segments = 0;
+    size_t total_rows = 0;
+    for (auto& rowset : rowsets) {
+        total_segments += rowset->num_segments();
+        total_rows += rowset->num_rows();
+    }
+    size_t num_threads = std::min<size_t>(std::max(config::primary_index_load_threads, 1), total_segments);
+    if (upsert || num_threads <= 1 || static_cast<int64_t>(total_rows) < config::primary_index_parallel_load_min_rows) {
+        OlapReaderStatistics stats;
+        for (auto& rowset : rowsets) {
+            RowsetReleaseGuard guard(rowset);
+            auto beta_rowset = down_cast<BetaRowset*>(rowset.get());
+            auto res = beta_rowset->get_segment_iterators2(pkey_schema, meta, apply_version, &stats);
+            if (!res.ok()) {
+                return res.status();
+            }
+            auto& itrs = res.value();
+            // TODO(cbl): auto close iterators on failure
+            CHECK(itrs.size() == rowset->num_segments()) << "itrs.size != num_segments";
+            for (size_t i = 0; i < itrs.size(); i++) {
+                if (itrs[i] == nullptr) {
+                    continue;
+                }
+                uint32_t rssid = rowset->rowset_meta()->get_rowset_seg_id() + i;
+                auto st = _insert_segment(pkey_schema, itrs[i].get(), rssid, upsert, nullptr);
+                if (!st.ok()) {
+                    LOG(ERROR) << "load index failed: rowset:" << rowset->rowset_meta()->get_rowset_seg_id()
+                               << " segment:" << i;
+                    return st;
+                }
+            }
+        }
+        return Status::OK();
+    }
+
+    // the segments are read and inserted by up to |num_threads| workers, every segment is read with its
+    // own statistics. the workers insert into the different sub maps of the index concurrently.
+    std::vector<std::unique_ptr<RowsetReleaseGuard>> guards;
+    std::vector<std::pair<BetaRowset*, uint32_t>> segments;
+    segments.reserve(total_segments);
+    for (auto& rowset : rowsets) {
+        guards.emplace_back(std::make_unique<RowsetReleaseGuard>(rowset));
+        for (uint32_t i = 0; i < rowset->num_segments(); i++) {
+            segments.emplace_back(down_cast<BetaRowset*>(rowset.get()), i);
+        }
+    }
+    std::mutex sub_map_locks[phmap_hash_table_shard];
+    auto load_segment = [&](size_t idx) {
+        auto [rowset, segment_id] = segments[idx];
+        OlapReaderStatistics stats;
+        auto res = rowset->get_segment_iterator2(pkey_schema, segment_id, meta, apply_version, &stats);
+        Status st = res.status();
+        if (st.ok() && res.value() != nullptr) {
+            uint32_t rssid = rowset->rowset_meta()->get_rowset_seg_id() + segment_id;
+            st = _insert_segment(pkey_schema, res.value().get(), rssid, false, sub_map_locks);
+        }
+        if (!st.ok()) {
+            LOG(ERROR) << "load index failed: rowset:" << rowset->rowset_meta()->get_rowset_seg_id()
+                       << " segment:" << segment_id;
+        }
+        return st;
+    };
+    StorageEngine* engine = StorageEngine::instance();
+    return parallel_for(engine != nullptr ? engine->parallel_task_pool() : nullptr, segments.size(), num_threads,
+                        load_segment);
+}
+
+Status PrimaryIndex::_insert_segment(const vectorized::Schema& pkey_schema, vectorized::ChunkIterator* itr,
+                                     uint32_t rssid, bool upsert, std::mutex* sub_map_locks) {
     std::unique_ptr<vectorized::Column> pk_column;
-    if (pk_columns.size() > 1) {
+    if (pkey_schema.num_fields() > 1) {
         if (!PrimaryKeyEncoder::create_column(pkey_schema, &pk_column).ok()) {
             CHECK(false) << "create column for primary key encoder failed";
         }
@@ -906,62 +1295,230 @@ Status PrimaryIndex::_do_load(Tablet* tablet) {
     rowids.reserve(4096);
     auto chunk_shared_ptr = ChunkHelper::new_chunk(pkey_schema, 4096);
     auto chunk = chunk_shared_ptr.get();
-    for (auto& rowset : rowsets) {
-        RowsetReleaseGuard guard(rowset);
-        auto beta_rowset = down_cast<BetaRowset*>(rowset.get());
-        auto res =
-                beta_rowset->get_segment_iterators2(pkey_schema, tablet->data_dir()->get_meta(), apply_version, &stats);
-        if (!res.ok()) {
-            return res.status();
+    DeletesMap deletes;
+    while (true) {
+        chunk->reset();
+        rowids.clear();
+        auto st = itr->get_next(chunk, &rowids);
+        if (st.is_end_of_file()) {
+            break;
+        } else if (!st.ok()) {
+            return st;
         }
-        auto& itrs = res.value();
-        // TODO(cbl): auto close iterators on failure
-        CHECK(itrs.size() == rowset->num_segments()) << "itrs.size != num_segments";
-        for (size_t i = 0; i < itrs.size(); i++) {
-            auto itr = itrs[i].get();
-            if (itr == nullptr) {
-                continue;
-            }
-            while (true) {
-                chunk->reset();
-                rowids.clear();
-                auto st = itr->get_next(chunk, &rowids);
-                if (st.is_end_of_file()) {
-                    break;
-                } else if (!st.ok()) {
-                    return st;
-                } else {
-                    Column* pkc = nullptr;
-                    if (pk_column) {
-                        pk_column->reset_column();
-                        PrimaryKeyEncoder::encode(pkey_schema, *chunk, 0, chunk->num_rows(), pk_column.get());
-                        pkc = pk_column.get();
-                    } else {
-                        pkc = chunk->columns()[0].get();
-                    }
-                    auto st = insert(rowset->rowset_meta()->get_rowset_seg_id() + i, rowids, *pkc);
-                    if (!st.ok()) {
-                        LOG(ERROR) << "load index failed: tablet=" << tablet->tablet_id()
-                                   << " rowsets:" << int_list_to_string(rowset_ids)
-                                   << " rowset:" << rowset->rowset_meta()->get_rowset_seg_id() << " segment:" << i
-                                   << " reason: " << st.to_string() << " current_size:" << size()
-                                   << " updates: " << tablet->updates()->debug_string();
-                        return st;
-                    }
-                }
-            }
-            itr->close();
+        Column* pkc = nullptr;
+        if (pk_column) {
+            pk_column->reset_column();
+            PrimaryKeyEncoder::encode(pkey_schema, *chunk, 0, chunk->num_rows(), pk_column.get());
+            pkc = pk_column.get();
+        } else {
+            pkc = chunk->columns()[0].get();
+        }
+        if (upsert) {
+            // the rows deleted by the later rowsets are skipped by the iterator, the
+            // replaced positions are not needed either.
+            deletes.clear();
+            _pkey_to_rssid_rowid->upsert(rssid, rowids, *pkc, &deletes);
+        } else if (sub_map_locks != nullptr) {
+            RETURN_IF_ERROR(_pkey_to_rssid_rowid->insert_concurrently(rssid, rowids, *pkc, sub_map_locks));
+        } else {
+            RETURN_IF_ERROR(insert(rssid, rowids, *pkc));
         }
     }
-    _tablet_id = tablet->tablet_id();
-    if (size() != total_rows - total_dels) {
-        LOG(WARNING) << Substitute("load primary index row count not match tablet:$0 index:$1 != stats:$2", _tablet_id,
-                                   size(), total_rows - total_dels);
+    itr->close();
+    return Status::OK();
+}
+
+// the file of a snapshot in the tablet directory. the header of the file is
+//   magic, format version, encoded key type, encoded key fixed size : 4 bytes each
+//   apply version : 8 bytes
+//   number of rowsets : 4 bytes, followed by the rowset ids of 4 bytes each
+//   number of entries : 8 bytes
+//   checksum of the header : 4 bytes
+// and the blocks of entries follow, each of them is
+//   number of entries, size in bytes, checksum : 4 bytes each
+//   the entries dumped by the hash index
+// until an empty block without entries.
+static const uint32_t snapshot_magic = 0x58444b50; // "PKDX"
+static const uint32_t snapshot_format_version = 1;
+static const size_t snapshot_fixed_header_size = 4 * 4 + 8 + 4;
+static const size_t snapshot_block_header_size = 4 * 3;
+static const size_t snapshot_block_size = 1024 * 1024;
+
+static std::string snapshot_path(Tablet* tablet) {
+    return Substitute("$0/$1.pkidx", tablet->tablet_path(), tablet->tablet_id());
+}
+
+Status PrimaryIndex::write_snapshot(const std::string& path, int64_t version,
+                                    const std::vector<uint32_t>& rowset_ids) const {
+    DCHECK(_pkey_to_rssid_rowid);
+    std::string header;
+    put_fixed32_le(&header, snapshot_magic);
+    put_fixed32_le(&header, snapshot_format_version);
+    put_fixed32_le(&header, _enc_pk_type);
+    put_fixed32_le(&header, PrimaryKeyEncoder::get_encoded_fixed_size(_pk_schema));
+    put_fixed64_le(&header, version);
+    put_fixed32_le(&header, rowset_ids.size());
+    for (uint32_t id : rowset_ids) {
+        put_fixed32_le(&header, id);
+    }
+    put_fixed64_le(&header, size());
+    put_fixed32_le(&header, crc32c::Value(header.data(), header.size()));
+
+    // written to a temporary file and renamed, so a partially written snapshot is never seen.
+    const std::string tmp_path = path + ".tmp";
+    std::unique_ptr<WritableFile> file;
+    RETURN_IF_ERROR(Env::Default()->new_writable_file(tmp_path, &file));
+    Status st = file->append(header);
+    if (st.ok()) {
+        st = _pkey_to_rssid_rowid->dump(snapshot_block_size, [&](const std::string& block, uint32_t num_entries) {
+            std::string block_header;
+            put_fixed32_le(&block_header, num_entries);
+            put_fixed32_le(&block_header, block.size());
+            put_fixed32_le(&block_header, crc32c::Value(block.data(), block.size()));
+            Slice slices[2] = {block_header, block};
+            return file->appendv(slices, 2);
+        });
+    }
+    if (st.ok()) {
+        std::string end_block(snapshot_block_header_size, '\0');
+        st = file->append(end_block);
+    }
+    if (st.ok()) {
+        st = file->sync();
+    }
+    if (st.ok()) {
+        st = file->close();
+    }
+    if (st.ok()) {
+        st = Env::Default()->rename_file(tmp_path, path);
+    }
+    if (!st.ok()) {
+        file.reset();
+        WARN_IF_ERROR(Env::Default()->delete_file(tmp_path), "failed to delete " + tmp_path);
+    }
+    return st;
+}
+
+Status PrimaryIndex::read_snapshot(const std::string& path, int64_t* version, std::vector<uint32_t>* rowset_ids) {
+    DCHECK(_pkey_to_rssid_rowid && size() == 0);
+    std::unique_ptr<RandomAccessFile> file;
+    RETURN_IF_ERROR(Env::Default()->new_random_access_file(path, &file));
+    uint64_t file_size = 0;
+    RETURN_IF_ERROR(file->size(&file_size));
+    if (file_size < snapshot_fixed_header_size + snapshot_block_header_size) {
+        return Status::Corruption(Substitute("primary index snapshot too small: $0", file_size));
+    }
+    std::string header(snapshot_fixed_header_size, '\0');
+    RETURN_IF_ERROR(file->read_at(0, Slice(header)));
+    auto* p = reinterpret_cast<const uint8_t*>(header.data());
+    if (decode_fixed32_le(p) != snapshot_magic || decode_fixed32_le(p + 4) != snapshot_format_version) {
+        return Status::Corruption("bad primary index snapshot magic or format version");
+    }
+    if (decode_fixed32_le(p + 8) != static_cast<uint32_t>(_enc_pk_type) ||
+        decode_fixed32_le(p + 12) != PrimaryKeyEncoder::get_encoded_fixed_size(_pk_schema)) {
+        return Status::NotFound("primary index snapshot of another key type");
+    }
+    const uint32_t num_rowsets = decode_fixed32_le(p + 24);
+    const size_t header_size = snapshot_fixed_header_size + num_rowsets * 4 + 8 + 4;
+    if (header_size + snapshot_block_header_size > file_size) {
+        return Status::Corruption("truncated primary index snapshot header");
+    }
+    header.resize(header_size);
+    RETURN_IF_ERROR(file->read_at(snapshot_fixed_header_size,
+                                  Slice(header.data() + snapshot_fixed_header_size,
+                                        header_size - snapshot_fixed_header_size)));
+    p = reinterpret_cast<const uint8_t*>(header.data());
+    if (crc32c::Value(header.data(), header_size - 4) != decode_fixed32_le(p + header_size - 4)) {
+        return Status::Corruption("primary index snapshot header checksum mismatch");
+    }
+    *version = static_cast<int64_t>(decode_fixed64_le(p + 16));
+    rowset_ids->resize(num_rowsets);
+    for (uint32_t i = 0; i < num_rowsets; i++) {
+        (*rowset_ids)[i] = decode_fixed32_le(p + snapshot_fixed_header_size + i * 4);
+    }
+    const uint64_t num_entries = decode_fixed64_le(p + header_size - 12);
+
+    uint64_t offset = header_size;
+    std::string block;
+    uint8_t block_header[snapshot_block_header_size];
+    while (true) {
+        if (offset + snapshot_block_header_size > file_size) {
+            return Status::Corruption("truncated primary index snapshot");
+        }
+        RETURN_IF_ERROR(file->read_at(offset, Slice(block_header, snapshot_block_header_size)));
+        offset += snapshot_block_header_size;
+        const uint32_t block_entries = decode_fixed32_le(block_header);
+        const uint32_t block_bytes = decode_fixed32_le(block_header + 4);
+        if (block_entries == 0) {
+            break;
+        }
+        if (offset + block_bytes > file_size) {
+            return Status::Corruption("truncated primary index snapshot block");
+        }
+        block.resize(block_bytes);
+        RETURN_IF_ERROR(file->read_at(offset, Slice(block)));
+        offset += block_bytes;
+        if (crc32c::Value(block.data(), block.size()) != decode_fixed32_le(block_header + 8)) {
+            return Status::Corruption("primary index snapshot block checksum mismatch");
+        }
+        RETURN_IF_ERROR(_pkey_to_rssid_rowid->load_block(Slice(block), block_entries));
+    }
+    if (offset != file_size || size() != num_entries) {
+        return Status::Corruption(Substitute("primary index snapshot size mismatch: entries $0 != $1", size(),
+                                             num_entries));
+    }
+    return Status::OK();
+}
+
+Status PrimaryIndex::save_snapshot(Tablet* tablet) {
+    std::lock_guard<std::mutex> lg(_lock);
+    if (!_loaded || !_status.ok()) {
+        return Status::OK();
+    }
+    MonotonicStopWatch timer;
+    timer.start();
+    int64_t apply_version = 0;
+    std::vector<RowsetSharedPtr> rowsets;
+    std::vector<uint32_t> rowset_ids;
+    RETURN_IF_ERROR(tablet->updates()->_get_apply_version_and_rowsets(&apply_version, &rowsets, &rowset_ids));
+    RETURN_IF_ERROR(write_snapshot(snapshot_path(tablet), apply_version, rowset_ids));
+    LOG(INFO) << "save primary index snapshot tablet:" << tablet->tablet_id() << " version:" << apply_version
+              << " rowsets:" << int_list_to_string(rowset_ids) << " size:" << size()
+              << " duration: " << timer.elapsed_time() / 1000000 << "ms";
+    return Status::OK();
+}
+
+Status PrimaryIndex::_load_snapshot(Tablet* tablet, const vectorized::Schema& pkey_schema, int64_t apply_version,
+                                    const std::vector<RowsetSharedPtr>& rowsets, size_t expected_size) {
+    const std::string path = snapshot_path(tablet);
+    if (!Env::Default()->path_exists(path).ok()) {
+        return Status::NotFound("no primary index snapshot");
+    }
+    int64_t snapshot_version = 0;
+    std::vector<uint32_t> snapshot_rowset_ids;
+    RETURN_IF_ERROR(read_snapshot(path, &snapshot_version, &snapshot_rowset_ids));
+    if (snapshot_version > apply_version) {
+        return Status::InternalError(
+                Substitute("primary index snapshot version $0 > $1", snapshot_version, apply_version));
+    }
+    // the snapshot can be used only if none of its rowsets are compacted since, the keys of the rowsets
+    // applied after the snapshot are upserted.
+    std::unordered_set<uint32_t> snapshot_rowsets(snapshot_rowset_ids.begin(), snapshot_rowset_ids.end());
+    std::vector<RowsetSharedPtr> new_rowsets;
+    for (auto& rowset : rowsets) {
+        if (snapshot_rowsets.erase(rowset->rowset_meta()->get_rowset_seg_id()) == 0) {
+            new_rowsets.push_back(rowset);
+        }
+    }
+    if (!snapshot_rowsets.empty()) {
+        return Status::NotFound("rowsets of the primary index snapshot are compacted");
+    }
+    RETURN_IF_ERROR(_insert_rowsets(tablet, pkey_schema, apply_version, new_rowsets, true));
+    // the keys deleted by the delete operations since the snapshot are still there, it's not usable if so.
+    if (size() != expected_size) {
+        return Status::NotFound(Substitute("primary index snapshot has deleted keys: $0 != $1", size(),
+                                           expected_size));
     }
-    LOG(INFO) << "load primary index finish tablet:" << tablet->tablet_id() << " version:" << apply_version
-              << " #rowset:" << rowsets.size() << " #segment:" << total_segments << " data_size:" << total_data_size
-              << " rowsets:" << int_list_to_string(rowset_ids) << " size:" << size() << " capacity:" << capacity()
-              << " memory:" << memory_usage() << " duration: " << timer.elapsed_time() / 1000000 << "ms";
     return Status::OK();
 }
 
@@ -1003,6 +1560,11 @@ void PrimaryIndex::erase(const Column& key_col, DeletesMap* deletes) {
     _pkey_to_rssid_rowid->erase(key_col, deletes);
 }
 
+void PrimaryIndex::get(const Column& key_col, vector<uint64_t>* rowids) const {
+    DCHECK(_status.ok() && _pkey_to_rssid_rowid);
+    _pkey_to_rssid_rowid->get(key_col, rowids);
+}
+
 std::size_t PrimaryIndex::memory_usage() const {
     return _pkey_to_rssid_rowid ? _pkey_to_rssid_rowid->memory_usage() : 0;
 }
@@ -11,6 +11,8 @@
 
 namespace starrocks {
 
+class Rowset;
+using RowsetSharedPtr = std::shared_ptr<Rowset>;
 class RowsetUpdateState;
 class Tablet;
 class TabletMeta;
@@ -27,6 +29,9 @@ public:
     using tablet_rowid_t = uint64_t;
     using TabletRowidColumn = vectorized::UInt64Column;
 
+    // the position looked up of a key not in the index.
+    static constexpr tablet_rowid_t NOT_FOUND = UINT64_MAX;
+
     PrimaryIndex();
     PrimaryIndex(const vectorized::Schema& pk_schema);
     ~PrimaryIndex();
@@ -42,6 +47,24 @@ public:
     // [thread-safe]
     void unload();
 
+    // Save the loaded index to a snapshot file in the tablet directory, tagged with the latest
+    // apply version and rowsets of |tablet|. A later load starts from the snapshot and only scans
+    // the rowsets applied after it, if none of the rowsets of the snapshot are compacted since.
+    // Must be called by the apply thread between the applies, as the index is not modified then.
+    //
+    // [thread-safe]
+    Status save_snapshot(Tablet* tablet);
+
+    // Write all the entries to the snapshot file |path|, tagged with |version| and |rowset_ids|.
+    //
+    // [not thread-safe]
+    Status write_snapshot(const std::string& path, int64_t version, const std::vector<uint32_t>& rowset_ids) const;
+
+    // Read the entries of the snapshot file |path| into this empty index.
+    //
+    // [not thread-safe]
+    Status read_snapshot(const std::string& path, int64_t* version, std::vector<uint32_t>* rowset_ids);
+
     // insert new primary keys into this index. caller need to make sure key doesn't exists
     // in index
     // [not thread-safe]
@@ -76,6 +99,12 @@ public:
     // [not thread-safe]
     void erase(const vectorized::Column& pks, DeletesMap* deletes);
 
+    // |pks| contains the *encoded* primary keys to look up, the position of every key is
+    // saved to |rowids| as (rssid << 32 | rowid), or NOT_FOUND if it's not in this index.
+    //
+    // [not thread-safe]
+    void get(const vectorized::Column& pks, vector<uint64_t>* rowids) const;
+
     // [not thread-safe]
     std::size_t memory_usage() const;
 
@@ -95,6 +124,20 @@ private:
 
     Status _do_load(Tablet* tablet);
 
+    // load the snapshot of |tablet| and upsert the keys of the |rowsets| applied after it, returns
+    // NotFound if there's no snapshot usable at |apply_version|.
+    Status _load_snapshot(Tablet* tablet, const vectorized::Schema& pkey_schema, int64_t apply_version,
+                          const std::vector<RowsetSharedPtr>& rowsets, size_t expected_size);
+
+    // insert or upsert the primary keys of the rows of |rowsets| not deleted at |apply_version|.
+    Status _insert_rowsets(Tablet* tablet, const vectorized::Schema& pkey_schema, int64_t apply_version,
+                           const std::vector<RowsetSharedPtr>& rowsets, bool upsert);
+
+    // insert or upsert the primary keys read by |itr| of the segment |rssid|, insert concurrently with
+    // the other threads by locking |sub_map_locks| if it's not null.
+    Status _insert_segment(const vectorized::Schema& pkey_schema, vectorized::ChunkIterator* itr, uint32_t rssid,
+                           bool upsert, std::mutex* sub_map_locks);
+
     std::mutex _lock;
     std::atomic<bool> _loaded{false};
     Status _status;
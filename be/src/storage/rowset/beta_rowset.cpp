@@ -24,12 +24,16 @@
 #include <unistd.h> // for link()
 #include <util/file_utils.h>
 
+#include <cerrno>
 #include <cstdio> // for remove()
+#include <filesystem>
 #include <memory>
 #include <set>
 
+#include "common/config.h"
 #include "gutil/strings/substitute.h"
 #include "storage/rowset/beta_rowset_reader.h"
+#include "storage/rowset/segment_v2/segment_pack.h"
 #include "storage/rowset/vectorized/rowset_options.h"
 #include "storage/rowset/vectorized/segment_options.h"
 #include "storage/storage_engine.h"
@@ -61,6 +65,10 @@ std::string BetaRowset::segment_srcrssid_file_path(const std::string& dir, const
     return strings::Substitute("$0/$1_$2.rssid", dir, rowset_id.to_string(), segment_id);
 }
 
+std::string BetaRowset::segment_pack_file_path(const std::string& dir, const RowsetId& rowset_id) {
+    return strings::Substitute("$0/$1_pack.dat", dir, rowset_id.to_string());
+}
+
 BetaRowset::BetaRowset(MemTracker* mem_tracker, const TabletSchema* schema, string rowset_path,
                        RowsetMetaSharedPtr rowset_meta)
         : Rowset(mem_tracker, schema, std::move(rowset_path), std::move(rowset_meta)) {
@@ -77,10 +85,26 @@ Status BetaRowset::do_load() {
     MemTracker* mem_tracker = _mem_tracker.get();
 
     _segments.clear();
+    // the packed segments are opened by the BlockManager of the pack, which opens the other segments by block_mgr.
+    std::shared_ptr<fs::BlockManager> pack_block_mgr;
+    if (_rowset_meta->has_segment_pack()) {
+        std::string pack_path = segment_pack_file_path(_rowset_path, rowset_id());
+        auto res = segment_v2::open_segment_pack(block_mgr, pack_path, [this](uint32_t seg_id) {
+            return segment_file_path(_rowset_path, rowset_id(), seg_id);
+        });
+        if (!res.ok()) {
+            LOG(WARNING) << "Fail to open " << pack_path << ": " << res.status();
+            return res.status();
+        }
+        pack_block_mgr = std::move(res).value();
+    }
     size_t footer_size_hint = 16 * 1024;
     for (int seg_id = 0; seg_id < num_segments(); ++seg_id) {
         std::string seg_path = segment_file_path(_rowset_path, rowset_id(), seg_id);
-        auto res = segment_v2::Segment::open(mem_tracker, block_mgr, seg_path, seg_id, _schema, &footer_size_hint);
+        auto res = pack_block_mgr != nullptr ? segment_v2::Segment::open(mem_tracker, pack_block_mgr, seg_path, seg_id,
+                                                                         _schema, &footer_size_hint)
+                                             : segment_v2::Segment::open(mem_tracker, block_mgr, seg_path, seg_id,
+                                                                         _schema, &footer_size_hint);
         if (!res.ok()) {
             LOG(WARNING) << "Fail to open " << seg_path << ": " << res.status();
             _segments.clear();
@@ -110,6 +134,9 @@ OLAPStatus BetaRowset::remove() {
             << " tablet_id=" << _rowset_meta->tablet_id();
     bool success = true;
     for (int i = 0; i < num_segments(); ++i) {
+        if (_is_packed_segment(i)) {
+            continue;
+        }
         std::string path = segment_file_path(_rowset_path, rowset_id(), i);
         VLOG(1) << "Deleting " << path;
         // TODO(lingbin): use Env API
@@ -118,6 +145,14 @@ OLAPStatus BetaRowset::remove() {
             success = false;
         }
     }
+    if (_rowset_meta->has_segment_pack()) {
+        std::string path = segment_pack_file_path(_rowset_path, rowset_id());
+        VLOG(1) << "Deleting " << path;
+        if (::remove(path.c_str()) != 0) {
+            PLOG(WARNING) << "Fail to delete " << path;
+            success = false;
+        }
+    }
     for (int i = 0; i < num_delete_files(); ++i) {
         std::string del_path = segment_del_file_path(_rowset_path, rowset_id(), i);
         VLOG(1) << "Deleting " << del_path;
@@ -136,6 +171,23 @@ OLAPStatus BetaRowset::remove() {
             }
         }
     }
+    for (int i = 0; i < num_segments(); ++i) {
+        std::string segment_path = segment_file_path(_rowset_path, rowset_id(), i);
+        std::vector<std::string> paths{segment_v2::Segment::local_cold_file_path(segment_path)};
+        // the cold files left by an empty cold_column_storage_path are removed by the orphan cold file sweep.
+        if (!config::cold_column_storage_path.empty()) {
+            paths.emplace_back(segment_v2::Segment::cold_file_path(segment_path));
+        }
+        for (const auto& path : paths) {
+            if (::access(path.c_str(), F_OK) == 0) {
+                VLOG(1) << "Deleting " << path;
+                if (::remove(path.c_str()) != 0) {
+                    PLOG(WARNING) << "Fail to delete " << path;
+                    success = false;
+                }
+            }
+        }
+    }
     if (!success) {
         LOG(WARNING) << "Fail to remove files in rowset id=" << unique_id();
         return OLAP_ERR_ROWSET_DELETE_FILE_FAILED;
@@ -147,18 +199,34 @@ void BetaRowset::do_close() {
     _segments.clear();
 }
 
-Status BetaRowset::link_files_to(const std::string& dir, RowsetId new_rowset_id) {
+Status BetaRowset::link_files_to(const std::string& dir, RowsetId new_rowset_id, int64_t segment_id_offset) {
+    if (_rowset_meta->has_segment_pack()) {
+        // the directory of the pack refers to the segments by their ids in this rowset.
+        if (segment_id_offset != 0) {
+            return Status::NotSupported("Fail to link segment pack with segment id offset");
+        }
+        std::string src_file_path = segment_pack_file_path(_rowset_path, rowset_id());
+        std::string dst_link_path = segment_pack_file_path(dir, new_rowset_id);
+        if (link(src_file_path.c_str(), dst_link_path.c_str()) != 0) {
+            PLOG(WARNING) << "Fail to link " << src_file_path << " to " << dst_link_path;
+            return Status::RuntimeError("Fail to link segment pack file");
+        }
+    }
     for (int i = 0; i < num_segments(); ++i) {
-        std::string dst_link_path = segment_file_path(dir, new_rowset_id, i);
+        if (_is_packed_segment(i)) {
+            continue;
+        }
+        std::string dst_link_path = segment_file_path(dir, new_rowset_id, segment_id_offset + i);
         std::string src_file_path = segment_file_path(_rowset_path, rowset_id(), i);
         if (link(src_file_path.c_str(), dst_link_path.c_str()) != 0) {
             PLOG(WARNING) << "Fail to link " << src_file_path << " to " << dst_link_path;
             return Status::RuntimeError("Fail to link segment data file");
         }
+        RETURN_IF_ERROR(_link_cold_file(src_file_path, dst_link_path));
     }
     for (int i = 0; i < num_delete_files(); ++i) {
         std::string src_file_path = segment_del_file_path(_rowset_path, rowset_id(), i);
-        std::string dst_link_path = segment_del_file_path(dir, new_rowset_id, i);
+        std::string dst_link_path = segment_del_file_path(dir, new_rowset_id, segment_id_offset + i);
         if (link(src_file_path.c_str(), dst_link_path.c_str()) != 0) {
             PLOG(WARNING) << "Fail to link " << src_file_path << " to " << dst_link_path;
             return Status::RuntimeError("Fail to link segment delete file");
@@ -167,18 +235,45 @@ Status BetaRowset::link_files_to(const std::string& dir, RowsetId new_rowset_id)
     return Status::OK();
 }
 
-OLAPStatus BetaRowset::copy_files_to(const std::string& dir) {
+OLAPStatus BetaRowset::copy_files_to(const std::string& dir, TokenBucket* io_limiter) {
+    const bool verify_checksum = config::tablet_file_copy_verify_checksum;
+    if (_rowset_meta->has_segment_pack()) {
+        std::string src_path = segment_pack_file_path(_rowset_path, rowset_id());
+        std::string dst_path = segment_pack_file_path(dir, rowset_id());
+        if (FileUtils::check_exist(dst_path)) {
+            LOG(WARNING) << "Fail to copy file, dest path=" << dst_path << " already exist";
+            return OLAP_ERR_FILE_ALREADY_EXIST;
+        }
+        if (copy_file(src_path, dst_path, io_limiter, verify_checksum) != OLAP_SUCCESS) {
+            LOG(WARNING) << "Fail to copy source " << src_path << " to " << dst_path << ", errno=" << Errno::no();
+            return OLAP_ERR_OS_ERROR;
+        }
+    }
     for (int i = 0; i < num_segments(); ++i) {
+        if (_is_packed_segment(i)) {
+            continue;
+        }
         std::string dst_path = segment_file_path(dir, rowset_id(), i);
         if (FileUtils::check_exist(dst_path)) {
             LOG(WARNING) << "Fail to copy file, dest path=" << dst_path << " already exist";
             return OLAP_ERR_FILE_ALREADY_EXIST;
         }
         std::string src_path = segment_file_path(_rowset_path, rowset_id(), i);
-        if (copy_file(src_path, dst_path) != OLAP_SUCCESS) {
+        if (copy_file(src_path, dst_path, io_limiter, verify_checksum) != OLAP_SUCCESS) {
             LOG(WARNING) << "Fail to copy source " << src_path << " to " << dst_path << ", errno=" << Errno::no();
             return OLAP_ERR_OS_ERROR;
         }
+        // the cold file under cold_column_storage_path is named after the tablet and the rowset, so it's shared by
+        // the copy of the same tablet. Only the one next to the segment file is copied.
+        std::string src_cold_path = segment_v2::Segment::local_cold_file_path(src_path);
+        if (FileUtils::check_exist(src_cold_path)) {
+            std::string dst_cold_path = segment_v2::Segment::local_cold_file_path(dst_path);
+            if (copy_file(src_cold_path, dst_cold_path, io_limiter, verify_checksum) != OLAP_SUCCESS) {
+                LOG(WARNING) << "Fail to copy source " << src_cold_path << " to " << dst_cold_path
+                             << ", errno=" << Errno::no();
+                return OLAP_ERR_OS_ERROR;
+            }
+        }
     }
     for (int i = 0; i < num_delete_files(); ++i) {
         std::string src_path = segment_del_file_path(_rowset_path, rowset_id(), i);
@@ -189,7 +284,7 @@ OLAPStatus BetaRowset::copy_files_to(const std::string& dir) {
                 LOG(WARNING) << "Fail to copy file, dest path=" << dst_path << " already exist";
                 return OLAP_ERR_FILE_ALREADY_EXIST;
             }
-            if (copy_file(src_path, dst_path) != OLAP_SUCCESS) {
+            if (copy_file(src_path, dst_path, io_limiter, verify_checksum) != OLAP_SUCCESS) {
                 LOG(WARNING) << "Fail to copy source " << src_path << " to " << dst_path << ", errno=" << Errno::no();
                 return OLAP_ERR_OS_ERROR;
             }
@@ -198,11 +293,53 @@ OLAPStatus BetaRowset::copy_files_to(const std::string& dir) {
     return OLAP_SUCCESS;
 }
 
+Status BetaRowset::_link_cold_file(const std::string& src_segment_path, const std::string& dst_segment_path) {
+    std::string src_path = segment_v2::Segment::local_cold_file_path(src_segment_path);
+    std::string dst_path = segment_v2::Segment::local_cold_file_path(dst_segment_path);
+    if (::access(src_path.c_str(), F_OK) != 0) {
+        if (config::cold_column_storage_path.empty()) {
+            return Status::OK();
+        }
+        src_path = segment_v2::Segment::cold_file_path(src_segment_path);
+        if (::access(src_path.c_str(), F_OK) != 0) {
+            return Status::OK();
+        }
+        std::string dst_cold_path = segment_v2::Segment::cold_file_path(dst_segment_path);
+        if (dst_cold_path == src_path) {
+            // a snapshot of the same rowset id. The cold file is copied into the snapshot, so that the snapshot can
+            // be cloned or uploaded with it, and removing the snapshot doesn't leave a link behind.
+            if (copy_file(src_path, dst_path) != OLAP_SUCCESS) {
+                LOG(WARNING) << "Fail to copy source " << src_path << " to " << dst_path << ", errno=" << Errno::no();
+                return Status::RuntimeError("Fail to copy segment cold file");
+            }
+            return Status::OK();
+        }
+        RETURN_IF_ERROR(FileUtils::create_dir(std::filesystem::path(dst_cold_path).parent_path().string()));
+        dst_path = std::move(dst_cold_path);
+    }
+    if (link(src_path.c_str(), dst_path.c_str()) != 0) {
+        PLOG(WARNING) << "Fail to link " << src_path << " to " << dst_path;
+        return Status::RuntimeError("Fail to link segment cold file");
+    }
+    return Status::OK();
+}
+
+bool BetaRowset::_is_packed_segment(int segment_id) const {
+    if (!_rowset_meta->has_segment_pack()) {
+        return false;
+    }
+    std::string path = segment_file_path(_rowset_path, rowset_id(), segment_id);
+    return ::access(path.c_str(), F_OK) != 0 && errno == ENOENT;
+}
+
 bool BetaRowset::check_path(const std::string& path) {
     std::set<std::string> valid_paths;
     for (int i = 0; i < num_segments(); ++i) {
         valid_paths.insert(segment_file_path(_rowset_path, rowset_id(), i));
     }
+    if (_rowset_meta->has_segment_pack()) {
+        valid_paths.insert(segment_pack_file_path(_rowset_path, rowset_id()));
+    }
     return valid_paths.find(path) != valid_paths.end();
 }
 
@@ -257,10 +394,12 @@ Status BetaRowset::get_segment_iterators(const vectorized::Schema& schema, const
     seg_options.ranges = options.ranges;
     seg_options.predicates = options.predicates;
     seg_options.use_page_cache = options.use_page_cache;
+    seg_options.fill_page_cache = options.fill_page_cache;
     seg_options.profile = options.profile;
     seg_options.reader_type = options.reader_type;
     seg_options.chunk_size = options.chunk_size;
     seg_options.global_dictmaps = options.global_dictmaps;
+    seg_options.runtime_filter_preds_builder = options.runtime_filter_preds_builder;
     if (options.delete_predicates != nullptr) {
         seg_options.delete_predicates = options.delete_predicates->get_predicates(end_version());
     }
@@ -284,9 +423,12 @@ Status BetaRowset::get_segment_iterators(const vectorized::Schema& schema, const
         }
     }
 
+    int64_t segment_begin = std::max<int64_t>(0, options.segment_begin);
+    int64_t segment_end = options.segment_end < 0 ? num_segments() : std::min(options.segment_end, num_segments());
     std::vector<vectorized::ChunkIteratorPtr> tmp_seg_iters;
     tmp_seg_iters.reserve(num_segments());
-    for (auto& seg_ptr : segments()) {
+    for (int64_t seg_id = segment_begin; seg_id < segment_end; ++seg_id) {
+        auto& seg_ptr = segments()[seg_id];
         if (seg_ptr->num_rows() == 0) {
             continue;
         }
@@ -325,6 +467,23 @@ StatusOr<std::vector<vectorized::ChunkIteratorPtr>> BetaRowset::get_segment_iter
                                                                                        OlapReaderStatistics* stats) {
     RETURN_IF_ERROR(load());
 
+    std::vector<vectorized::ChunkIteratorPtr> seg_iterators(num_segments());
+    for (int64_t i = 0; i < num_segments(); i++) {
+        auto res = get_segment_iterator2(schema, i, meta, version, stats);
+        if (!res.ok()) {
+            return res.status();
+        }
+        seg_iterators[i] = std::move(res).value();
+    }
+    return seg_iterators;
+}
+
+StatusOr<vectorized::ChunkIteratorPtr> BetaRowset::get_segment_iterator2(const vectorized::Schema& schema,
+                                                                         uint32_t segment_id, KVStore* meta,
+                                                                         int64_t version,
+                                                                         OlapReaderStatistics* stats) {
+    RETURN_IF_ERROR(load());
+
     vectorized::SegmentReadOptions seg_options;
     seg_options.block_mgr = fs::fs_util::block_manager();
     seg_options.stats = stats;
@@ -334,24 +493,15 @@ StatusOr<std::vector<vectorized::ChunkIteratorPtr>> BetaRowset::get_segment_iter
     seg_options.version = version;
     seg_options.meta = meta;
 
-    std::vector<vectorized::ChunkIteratorPtr> seg_iterators(num_segments());
-    TabletSegmentId tsid;
-    tsid.tablet_id = rowset_meta()->tablet_id();
-    for (int64_t i = 0; i < num_segments(); i++) {
-        auto& seg_ptr = segments()[i];
-        if (seg_ptr->num_rows() == 0) {
-            continue;
-        }
-        auto res = seg_ptr->new_iterator(schema, seg_options);
-        if (res.status().is_end_of_file()) {
-            continue;
-        }
-        if (!res.ok()) {
-            return res.status();
-        }
-        seg_iterators[i] = std::move(res).value();
+    auto& seg_ptr = segments()[segment_id];
+    if (seg_ptr->num_rows() == 0) {
+        return vectorized::ChunkIteratorPtr();
     }
-    return seg_iterators;
+    auto res = seg_ptr->new_iterator(schema, seg_options);
+    if (res.status().is_end_of_file()) {
+        return vectorized::ChunkIteratorPtr();
+    }
+    return res;
 }
 
 } // namespace starrocks
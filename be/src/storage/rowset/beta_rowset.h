@@ -68,6 +68,12 @@ public:
                                                                                KVStore* meta, int64_t version,
                                                                                OlapReaderStatistics* stats);
 
+    // same as get_segment_iterators2, but only return the iterator of the |segment_id|-th segment,
+    // so the segments can be read by different threads with their own |stats|.
+    StatusOr<vectorized::ChunkIteratorPtr> get_segment_iterator2(const vectorized::Schema& schema, uint32_t segment_id,
+                                                                 KVStore* meta, int64_t version,
+                                                                 OlapReaderStatistics* stats);
+
     static std::string segment_file_path(const std::string& segment_dir, const RowsetId& rowset_id, int segment_id);
 
     static std::string segment_temp_file_path(const std::string& dir, const RowsetId& rowset_id, int segment_id);
@@ -77,14 +83,17 @@ public:
     static std::string segment_srcrssid_file_path(const std::string& segment_dir, const RowsetId& rowset_id,
                                                   int segment_id);
 
+    // The file of the small segments of the rowset packed together, see segment_v2::SegmentPackWriter.
+    static std::string segment_pack_file_path(const std::string& segment_dir, const RowsetId& rowset_id);
+
     OLAPStatus split_range(const RowCursor& start_key, const RowCursor& end_key, uint64_t request_block_row_count,
                            std::vector<OlapTuple>* ranges) override;
 
     OLAPStatus remove() override;
 
-    Status link_files_to(const std::string& dir, RowsetId new_rowset_id) override;
+    Status link_files_to(const std::string& dir, RowsetId new_rowset_id, int64_t segment_id_offset = 0) override;
 
-    OLAPStatus copy_files_to(const std::string& dir) override;
+    OLAPStatus copy_files_to(const std::string& dir, TokenBucket* io_limiter = nullptr) override;
 
     bool check_path(const std::string& path) override;
 
@@ -101,6 +110,15 @@ protected:
 private:
     friend class RowsetFactory;
     friend class BetaRowsetReader;
+
+    // link the cold file of the segment file |src_segment_path| to that of |dst_segment_path| if it exists. A cold file
+    // next to the segment file is linked next to |dst_segment_path|, and one under cold_column_storage_path is linked
+    // there, except that it's copied next to |dst_segment_path| if both have the same name, e.g. for a snapshot.
+    static Status _link_cold_file(const std::string& src_segment_path, const std::string& dst_segment_path);
+
+    // whether the segment |segment_id| is in the segment pack, whose segment file doesn't exist.
+    bool _is_packed_segment(int segment_id) const;
+
     std::vector<segment_v2::SegmentSharedPtr> _segments;
 };
 
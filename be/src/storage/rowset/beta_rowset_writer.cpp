@@ -21,8 +21,13 @@
 
 #include "storage/rowset/beta_rowset_writer.h"
 
+#include <atomic>
+#include <condition_variable>
 #include <ctime>
+#include <filesystem>
+#include <functional>
 #include <memory>
+#include <mutex>
 
 #include "column/chunk.h"
 #include "common/config.h"
@@ -30,12 +35,18 @@
 #include "env/env.h"
 #include "gutil/strings/substitute.h"
 #include "runtime/exec_env.h"
+#include "storage/fs/async_block.h"
 #include "storage/fs/fs_util.h"
+#include "storage/fs/throttled_block.h"
+#include "storage/memtable_flush_executor.h"
 #include "storage/olap_define.h"
 #include "storage/row.h"        // ContiguousRow
 #include "storage/row_cursor.h" // RowCursor
 #include "storage/rowset/beta_rowset.h"
 #include "storage/rowset/rowset_factory.h"
+#include "storage/rowset/segment_v2/column_reader.h"
+#include "storage/rowset/segment_v2/segment.h"
+#include "storage/rowset/segment_v2/segment_pack.h"
 #include "storage/rowset/segment_v2/segment_writer.h"
 #include "storage/rowset/vectorized/segment_options.h"
 #include "storage/storage_engine.h"
@@ -45,6 +56,7 @@
 #include "storage/vectorized/type_utils.h"
 #include "storage/vectorized/union_iterator.h"
 #include "util/defer_op.h"
+#include "util/file_utils.h"
 #include "util/pretty_printer.h"
 
 namespace starrocks {
@@ -67,6 +79,7 @@ BetaRowsetWriter::~BetaRowsetWriter() {
     // TODO(lingbin): Should wrapper exception logic, no need to know file ops directly.
     if (!_already_built) {       // abnormal exit, remove all files generated
         _segment_writer.reset(); // ensure all files are closed
+        _segment_writers.clear();
         if (_context.tablet_schema->keys_type() == KeysType::PRIMARY_KEYS) {
             for (const auto& tmp_segment_file : _tmp_segment_files) {
                 // Even if an error is encountered, these files that have not been cleaned up
@@ -120,6 +133,12 @@ BetaRowsetWriter::~BetaRowsetWriter() {
                 auto st = _context.env->delete_file(path);
                 LOG_IF(WARNING, !st.ok()) << "Fail to delete file=" << path << ", " << st.to_string();
             }
+            if (_segment_pack != nullptr) {
+                auto path = _segment_pack->path();
+                _segment_pack.reset();
+                auto st = _context.env->delete_file(path);
+                LOG_IF(WARNING, !st.ok()) << "Fail to delete file=" << path << ", " << st.to_string();
+            }
         }
     }
 }
@@ -161,6 +180,12 @@ OLAPStatus BetaRowsetWriter::init() {
         _rowset_meta->set_version_hash(_context.version_hash);
     }
     _rowset_meta->set_tablet_uid(_context.tablet_uid);
+    if (_context.partial_update_tablet_schema != nullptr) {
+        auto* txn_meta = _rowset_meta->mutable_txn_meta();
+        for (const auto& column : _context.partial_update_tablet_schema->columns()) {
+            txn_meta->add_partial_update_column_unique_ids(column.unique_id());
+        }
+    }
     return OLAP_SUCCESS;
 }
 
@@ -193,7 +218,7 @@ template OLAPStatus BetaRowsetWriter::_add_row(const ContiguousRow& row);
 
 OLAPStatus BetaRowsetWriter::add_rowset(RowsetSharedPtr rowset) {
     assert(rowset->rowset_meta()->rowset_type() == BETA_ROWSET);
-    if (!rowset->link_files_to(_context.rowset_path_prefix, _context.rowset_id).ok()) {
+    if (!rowset->link_files_to(_context.rowset_path_prefix, _context.rowset_id, _num_segment).ok()) {
         return OLAP_ERR_OTHER_ERROR;
     }
     _num_rows_written += rowset->num_rows();
@@ -205,9 +230,58 @@ OLAPStatus BetaRowsetWriter::add_rowset(RowsetSharedPtr rowset) {
     if (rowset->rowset_meta()->has_delete_predicate()) {
         _rowset_meta->set_delete_predicate(rowset->rowset_meta()->delete_predicate());
     }
+    if (rowset->rowset_meta()->has_segment_pack()) {
+        _rowset_meta->set_has_segment_pack(true);
+    }
     return OLAP_SUCCESS;
 }
 
+Status BetaRowsetWriter::add_segment_file(const std::string& path) {
+    if (_segment_writer != nullptr || _context.write_tmp) {
+        return Status::NotSupported("Fail to add segment file to the rowset writing segments");
+    }
+    auto dst_path = BetaRowset::segment_file_path(_context.rowset_path_prefix, _context.rowset_id, _num_segment);
+    RETURN_IF_ERROR(_context.env->link_file(path, dst_path));
+    bool added = false;
+    DeferOp remove_dst([&] {
+        if (!added) {
+            WARN_IF_ERROR(_context.env->delete_file(dst_path), "Fail to delete " + dst_path);
+        }
+    });
+
+    // Segment::open() verifies the magic number and the checksum of the footer.
+    const auto* schema = _rowset_schema != nullptr ? _rowset_schema.get() : _context.tablet_schema;
+    ASSIGN_OR_RETURN(auto segment, segment_v2::Segment::open(_context.mem_tracker, _context.block_mgr, dst_path,
+                                                             _num_segment, schema));
+    for (size_t i = 0; i < schema->num_columns(); ++i) {
+        const auto& column = schema->column(i);
+        const auto* reader = segment->column(i);
+        if (reader == nullptr) {
+            return Status::Corruption(
+                    strings::Substitute("Bad segment file $0: column $1 is missing", path, column.name()));
+        }
+        // a segment of the tablet format is read by the format adapter as well.
+        const FieldType type = reader->column_type();
+        if (type != column.type() && type != _context.tablet_schema->column(i).type()) {
+            return Status::Corruption(strings::Substitute("Bad segment file $0: column $1 is $2 rather than $3", path,
+                                                          column.name(), field_type_to_string(type),
+                                                          field_type_to_string(column.type())));
+        }
+        if (reader->is_nullable() && !column.is_nullable()) {
+            return Status::Corruption(
+                    strings::Substitute("Bad segment file $0: column $1 is not nullable", path, column.name()));
+        }
+    }
+    uint64_t file_size = 0;
+    RETURN_IF_ERROR(_context.env->get_file_size(dst_path, &file_size));
+
+    added = true;
+    _num_rows_written += segment->num_rows();
+    _total_data_size += file_size;
+    ++_num_segment;
+    return Status::OK();
+}
+
 OLAPStatus BetaRowsetWriter::add_rowset_for_linked_schema_change(RowsetSharedPtr rowset,
                                                                  const SchemaMapping& schema_mapping) {
     // TODO use schema_mapping to transfer zonemap
@@ -241,7 +315,11 @@ Status BetaRowsetWriter::_final_merge() {
     MonotonicStopWatch timer;
     timer.start();
 
-    auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(*_context.tablet_schema);
+    // the segments of a partial update only have the columns loaded.
+    const TabletSchema* segment_schema = _context.partial_update_tablet_schema != nullptr
+                                                 ? _context.partial_update_tablet_schema
+                                                 : _context.tablet_schema;
+    auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(*segment_schema);
 
     std::vector<vectorized::ChunkIteratorPtr> seg_iterators;
     seg_iterators.reserve(_num_segment);
@@ -260,7 +338,7 @@ Status BetaRowsetWriter::_final_merge() {
                 BetaRowset::segment_temp_file_path(_context.rowset_path_prefix, _context.rowset_id, seg_id);
 
         auto segment_ptr = segment_v2::Segment::open(&tracker, fs::fs_util::block_manager(), tmp_segment_file, seg_id,
-                                                     _context.tablet_schema);
+                                                     segment_schema);
         if (!segment_ptr.ok()) {
             LOG(WARNING) << "Fail to open " << tmp_segment_file << ": " << segment_ptr.status();
             return segment_ptr.status();
@@ -327,7 +405,7 @@ Status BetaRowsetWriter::_final_merge() {
         if (st.is_end_of_file()) {
             break;
         } else if (st.ok()) {
-            vectorized::ChunkHelper::padding_char_columns(char_field_indexes, schema, *_context.tablet_schema, chunk);
+            vectorized::ChunkHelper::padding_char_columns(char_field_indexes, schema, *segment_schema, chunk);
             total_rows += chunk->num_rows();
             total_chunk++;
             add_chunk(*chunk);
@@ -369,6 +447,14 @@ RowsetSharedPtr BetaRowsetWriter::build() {
     // When building a rowset, we must ensure that the current _segment_writer has been
     // flushed, that is, the current _segment_wirter is nullptr
     DCHECK(_segment_writer == nullptr) << "segment must be null when build rowset";
+    if (_segment_pack != nullptr) {
+        auto s = _segment_pack->finalize();
+        if (!s.ok()) {
+            LOG(WARNING) << "Fail to finalize segment pack: " << s.to_string();
+            return nullptr;
+        }
+        _rowset_meta->set_has_segment_pack(true);
+    }
     _rowset_meta->set_num_rows(_num_rows_written);
     _rowset_meta->set_total_row_size(_total_row_size);
     _rowset_meta->set_total_disk_size(_total_data_size);
@@ -411,9 +497,42 @@ RowsetSharedPtr BetaRowsetWriter::build() {
     return rowset;
 }
 
-std::unique_ptr<SegmentWriter> BetaRowsetWriter::_create_segment_writer() {
+std::unique_ptr<SegmentWriter> BetaRowsetWriter::_create_segment_writer(bool packed) {
+    std::lock_guard<std::mutex> l(_lock);
+    std::unique_ptr<SegmentWriter> segment_writer = _new_segment_writer(packed);
+    if (segment_writer == nullptr) {
+        return nullptr;
+    }
+    auto s = segment_writer->init(config::push_write_mbytes_per_sec);
+    if (!s.ok()) {
+        LOG(WARNING) << "Fail to init segment writer, " << s.to_string();
+        return nullptr;
+    }
+    ++_num_segment;
+    return segment_writer;
+}
+
+std::unique_ptr<SegmentWriter> BetaRowsetWriter::_create_segment_writer(const std::vector<uint32_t>& column_indexes,
+                                                                        bool is_key) {
     std::lock_guard<std::mutex> l(_lock);
+    std::unique_ptr<SegmentWriter> segment_writer = _new_segment_writer();
+    if (segment_writer == nullptr) {
+        return nullptr;
+    }
+    auto s = segment_writer->init(column_indexes, is_key);
+    if (!s.ok()) {
+        LOG(WARNING) << "Fail to init segment writer, " << s.to_string();
+        return nullptr;
+    }
+    ++_num_segment;
+    return segment_writer;
+}
+
+// lock should be held when calling this method
+std::unique_ptr<SegmentWriter> BetaRowsetWriter::_new_segment_writer(bool packed) {
     std::string path;
+    const std::string final_path =
+            BetaRowset::segment_file_path(_context.rowset_path_prefix, _context.rowset_id, _num_segment);
     if ((_context.tablet_schema->keys_type() == KeysType::PRIMARY_KEYS &&
          _context.segments_overlap != NONOVERLAPPING) ||
         _context.write_tmp) {
@@ -423,35 +542,92 @@ std::unique_ptr<SegmentWriter> BetaRowsetWriter::_create_segment_writer() {
         // for update final merge scenario, we marked segments_overlap to NONOVERLAPPING in
         // function _final_merge, so we create segment data file here, rather than
         // temporary segment files.
-        path = BetaRowset::segment_file_path(_context.rowset_path_prefix, _context.rowset_id, _num_segment);
+        path = final_path;
     }
     std::unique_ptr<fs::WritableBlock> wblock;
-    fs::CreateBlockOptions opts({path});
-    Status st = _context.block_mgr->create_block(opts, &wblock);
-    if (!st.ok()) {
-        LOG(WARNING) << "Fail to create writable block=" << path << ", " << st.to_string();
-        return nullptr;
+    Status st;
+    if (packed) {
+        DCHECK_EQ(path, final_path);
+        if (_segment_pack == nullptr) {
+            std::string pack_path = BetaRowset::segment_pack_file_path(_context.rowset_path_prefix, _context.rowset_id);
+            st = _context.block_mgr->create_block(fs::CreateBlockOptions({pack_path}), &wblock);
+            if (!st.ok()) {
+                LOG(WARNING) << "Fail to create writable block=" << pack_path << ", " << st.to_string();
+                return nullptr;
+            }
+            _segment_pack = std::make_unique<segment_v2::SegmentPackWriter>(std::move(wblock));
+        }
+        wblock = _segment_pack->new_segment_block(path, _num_segment);
+    } else {
+        st = _context.block_mgr->create_block(fs::CreateBlockOptions({path}), &wblock);
+        if (!st.ok()) {
+            LOG(WARNING) << "Fail to create writable block=" << path << ", " << st.to_string();
+            return nullptr;
+        }
     }
 
     DCHECK(wblock != nullptr);
+    if (_context.io_limiter != nullptr) {
+        wblock = std::make_unique<fs::ThrottledWritableBlock>(std::move(wblock), _context.io_limiter);
+    }
+    if (config::enable_async_segment_write) {
+        // wraps the throttled block, so that the background threads wait for the tokens instead.
+        wblock = std::make_unique<fs::AsyncWritableBlock>(std::move(wblock), config::async_segment_write_buffer_size);
+    }
     segment_v2::SegmentWriterOptions writer_options;
     writer_options.storage_format_version = _context.storage_format_version;
     writer_options.mem_tracker = _context.mem_tracker;
     const auto* schema = _rowset_schema != nullptr ? _rowset_schema.get() : _context.tablet_schema;
+    if (_context.partial_update_tablet_schema != nullptr) {
+        schema = _context.partial_update_tablet_schema;
+    }
     writer_options.global_dicts = _context.global_dicts != nullptr ? _context.global_dicts : nullptr;
-    std::unique_ptr<SegmentWriter> segment_writer =
+    auto segment_writer =
             std::make_unique<segment_v2::SegmentWriter>(std::move(wblock), _num_segment, schema, writer_options);
-    // TODO set write_mbytes_per_sec based on writer type (load/base compaction/cumulative compaction)
-    auto s = segment_writer->init(config::push_write_mbytes_per_sec);
-    if (!s.ok()) {
-        LOG(WARNING) << "Fail to init segment writer, " << s.to_string();
-        segment_writer.reset(nullptr);
-        return nullptr;
+    // the cold file is named after the final segment file, so the temporary segment files don't have one.
+    if (_context.write_cold_columns && !config::cold_column_storage_path.empty() && path == final_path) {
+        std::unordered_set<uint32_t> cold_columns = _cold_columns(*schema);
+        if (!cold_columns.empty()) {
+            std::unique_ptr<fs::WritableBlock> cold_wblock;
+            std::string cold_path = segment_v2::Segment::cold_file_path(path);
+            st = FileUtils::create_dir(std::filesystem::path(cold_path).parent_path().string());
+            if (st.ok()) {
+                st = _context.block_mgr->create_block(fs::CreateBlockOptions({cold_path}), &cold_wblock);
+            }
+            if (!st.ok()) {
+                LOG(WARNING) << "Fail to create writable block=" << cold_path << ", " << st.to_string();
+                return nullptr;
+            }
+            segment_writer->set_cold_columns(std::move(cold_wblock), std::move(cold_columns));
+        }
     }
-    ++_num_segment;
     return segment_writer;
 }
 
+// the value columns of the variable length types, which are usually wide and rarely read.
+std::unordered_set<uint32_t> BetaRowsetWriter::_cold_columns(const TabletSchema& schema) const {
+    std::unordered_set<uint32_t> cold_columns;
+    for (uint32_t i = 0; i < schema.num_columns(); i++) {
+        const auto& column = schema.column(i);
+        if (column.is_key()) {
+            continue;
+        }
+        switch (column.type()) {
+        case OLAP_FIELD_TYPE_CHAR:
+        case OLAP_FIELD_TYPE_VARCHAR:
+        case OLAP_FIELD_TYPE_HLL:
+        case OLAP_FIELD_TYPE_OBJECT:
+        case OLAP_FIELD_TYPE_PERCENTILE:
+        case OLAP_FIELD_TYPE_ARRAY:
+            cold_columns.insert(i);
+            break;
+        default:
+            break;
+        }
+    }
+    return cold_columns;
+}
+
 OLAPStatus BetaRowsetWriter::_flush_segment_writer(std::unique_ptr<segment_v2::SegmentWriter>* segment_writer) {
     uint64_t segment_size;
     uint64_t index_size;
@@ -473,15 +649,18 @@ OLAPStatus BetaRowsetWriter::_flush_segment_writer(std::unique_ptr<segment_v2::S
         }
     }
 
-    // check global_dict efficacy
-    const auto& seg_global_dict_columns_valid_info = (*segment_writer)->global_dict_columns_valid_info();
-    for (const auto& it : seg_global_dict_columns_valid_info) {
-        if (it.second == false) {
-            _global_dict_columns_valid_info[it.first] = false;
-        } else {
-            if (const auto& iter = _global_dict_columns_valid_info.find(it.first);
-                iter == _global_dict_columns_valid_info.end()) {
-                _global_dict_columns_valid_info[it.first] = true;
+    // check global_dict efficacy, the segments of a memtable may be flushed in parallel.
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        const auto& seg_global_dict_columns_valid_info = (*segment_writer)->global_dict_columns_valid_info();
+        for (const auto& it : seg_global_dict_columns_valid_info) {
+            if (it.second == false) {
+                _global_dict_columns_valid_info[it.first] = false;
+            } else {
+                if (const auto& iter = _global_dict_columns_valid_info.find(it.first);
+                    iter == _global_dict_columns_valid_info.end()) {
+                    _global_dict_columns_valid_info[it.first] = true;
+                }
             }
         }
     }
@@ -560,9 +739,127 @@ OLAPStatus BetaRowsetWriter::add_chunk_with_rssid(const vectorized::Chunk& chunk
     return OLAP_SUCCESS;
 }
 
+OLAPStatus BetaRowsetWriter::add_columns(const vectorized::Chunk& chunk, const std::vector<uint32_t>& column_indexes,
+                                         bool is_key) {
+    const size_t num_rows = chunk.num_rows();
+    if (num_rows == 0) {
+        return OLAP_SUCCESS;
+    }
+    if (is_key) {
+        // the segments are split by the number of rows only, the key columns are a small part of the size
+        if (_segment_writer == nullptr) {
+            _segment_writer = _create_segment_writer(column_indexes, true);
+        } else if (_segment_writer->num_rows_written() + num_rows >= _context.max_rows_per_segment) {
+            RETURN_NOT_OK(_flush_columns(_segment_writer.get()));
+            _segment_writers.emplace_back(std::move(_segment_writer));
+            _segment_writer = _create_segment_writer(column_indexes, true);
+        }
+        if (_segment_writer == nullptr) {
+            return OLAP_ERR_INIT_FAILED;
+        }
+        auto s = _segment_writer->append_chunk(chunk);
+        if (!s.ok()) {
+            LOG(WARNING) << "Fail to append chunk, " << s.to_string();
+            return OLAP_ERR_WRITER_DATA_WRITE_ERROR;
+        }
+        _num_rows_written += num_rows;
+        _total_row_size += chunk.bytes_usage();
+        return OLAP_SUCCESS;
+    }
+
+    // the value columns follow the segments of the key columns.
+    size_t offset = 0;
+    while (offset < num_rows) {
+        if (_current_writer_index >= _segment_writers.size()) {
+            LOG(WARNING) << "Fail to add columns, more rows than the key columns, rowset_id=" << _context.rowset_id;
+            return OLAP_ERR_WRITER_DATA_WRITE_ERROR;
+        }
+        auto* segment_writer = _segment_writers[_current_writer_index].get();
+        if (!_current_writer_inited) {
+            auto s = segment_writer->init(column_indexes, false);
+            if (!s.ok()) {
+                LOG(WARNING) << "Fail to init segment writer, " << s.to_string();
+                return OLAP_ERR_INIT_FAILED;
+            }
+            _current_writer_inited = true;
+        }
+        size_t rows = std::min<size_t>(segment_writer->num_rows() - segment_writer->num_rows_written(),
+                                       num_rows - offset);
+        Status s;
+        if (rows == num_rows) {
+            s = segment_writer->append_chunk(chunk);
+        } else {
+            auto part = chunk.clone_empty_with_schema(rows);
+            part->append(chunk, offset, rows);
+            s = segment_writer->append_chunk(*part);
+        }
+        if (!s.ok()) {
+            LOG(WARNING) << "Fail to append chunk, " << s.to_string();
+            return OLAP_ERR_WRITER_DATA_WRITE_ERROR;
+        }
+        offset += rows;
+        if (segment_writer->num_rows_written() == segment_writer->num_rows()) {
+            RETURN_NOT_OK(_flush_columns(segment_writer));
+            ++_current_writer_index;
+            _current_writer_inited = false;
+        }
+    }
+    _total_row_size += chunk.bytes_usage();
+    return OLAP_SUCCESS;
+}
+
+OLAPStatus BetaRowsetWriter::flush_columns() {
+    if (_segment_writer != nullptr) {
+        // the key columns
+        RETURN_NOT_OK(_flush_columns(_segment_writer.get()));
+        _segment_writers.emplace_back(std::move(_segment_writer));
+    } else if (_current_writer_index != _segment_writers.size()) {
+        LOG(WARNING) << "Fail to flush columns, less rows than the key columns, rowset_id=" << _context.rowset_id;
+        return OLAP_ERR_WRITER_DATA_WRITE_ERROR;
+    }
+    _current_writer_index = 0;
+    _current_writer_inited = false;
+    return OLAP_SUCCESS;
+}
+
+OLAPStatus BetaRowsetWriter::final_flush() {
+    for (auto& segment_writer : _segment_writers) {
+        uint64_t segment_size = 0;
+        Status s = segment_writer->finalize_footer(&segment_size);
+        if (!s.ok()) {
+            LOG(WARNING) << "Fail to finalize segment footer, " << s.to_string();
+            return OLAP_ERR_WRITER_DATA_WRITE_ERROR;
+        }
+        {
+            std::lock_guard<std::mutex> l(_lock);
+            _total_data_size += segment_size;
+        }
+        segment_writer.reset();
+    }
+    _segment_writers.clear();
+    return OLAP_SUCCESS;
+}
+
+OLAPStatus BetaRowsetWriter::_flush_columns(segment_v2::SegmentWriter* segment_writer) {
+    uint64_t index_size = 0;
+    Status s = segment_writer->finalize_columns(&index_size);
+    if (!s.ok()) {
+        LOG(WARNING) << "Fail to finalize segment columns, " << s.to_string();
+        return OLAP_ERR_WRITER_DATA_WRITE_ERROR;
+    }
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        _total_index_size += index_size;
+    }
+    return OLAP_SUCCESS;
+}
+
 OLAPStatus BetaRowsetWriter::flush_chunk(const vectorized::Chunk& chunk) {
+    if (size_t num_segments = _num_parallel_flush_segments(chunk); num_segments > 1) {
+        return _parallel_flush_chunk(chunk, num_segments);
+    }
     // create segment writer
-    std::unique_ptr<segment_v2::SegmentWriter> segment_writer = _create_segment_writer();
+    std::unique_ptr<segment_v2::SegmentWriter> segment_writer = _create_segment_writer(_can_pack_segment(chunk));
     if (segment_writer == nullptr) {
         return OLAP_ERR_INIT_FAILED;
     }
@@ -584,6 +881,99 @@ OLAPStatus BetaRowsetWriter::flush_chunk(const vectorized::Chunk& chunk) {
     return OLAP_SUCCESS;
 }
 
+// The segments of the primary key tables are read by their file paths by the updates, and the temporary segments
+// and the cold files are renamed or named after the segment files, so none of them is packed. A rowset has only one
+// segment pack, so the segments aren't packed either once a rowset with a pack is linked.
+bool BetaRowsetWriter::_can_pack_segment(const vectorized::Chunk& chunk) const {
+    const int64_t max_bytes = config::segment_pack_max_bytes;
+    if (max_bytes <= 0 || static_cast<int64_t>(chunk.bytes_usage()) >= max_bytes) {
+        return false;
+    }
+    if (_context.tablet_schema->keys_type() == KeysType::PRIMARY_KEYS || _context.write_tmp ||
+        _context.write_cold_columns) {
+        return false;
+    }
+    return _segment_pack != nullptr || !_rowset_meta->has_segment_pack();
+}
+
+size_t BetaRowsetWriter::_num_parallel_flush_segments(const vectorized::Chunk& chunk) const {
+    // the segments of the primary key tables are paired with their delete files by the segment ids.
+    if (_context.tablet_schema->keys_type() == KeysType::PRIMARY_KEYS || _src_rssids != nullptr ||
+        StorageEngine::instance() == nullptr || StorageEngine::instance()->memtable_flush_executor() == nullptr) {
+        return 1;
+    }
+    int64_t min_rows = std::max<int64_t>(config::memtable_flush_min_rows_per_segment, 1);
+    int64_t num_segments = std::min<int64_t>(config::memtable_flush_max_parallel_segments, chunk.num_rows() / min_rows);
+    return std::max<int64_t>(num_segments, 1);
+}
+
+// The memtable is sorted, so its consecutive row ranges are written to the segments of consecutive ids, which
+// keep the order of the keys. The segments are taken one by one by the flush thread and the idle flush threads
+// helping it, every segment by the first thread reaching it, so the flush thread never waits for a queued task.
+OLAPStatus BetaRowsetWriter::_parallel_flush_chunk(const vectorized::Chunk& chunk, size_t num_segments) {
+    std::vector<std::unique_ptr<segment_v2::SegmentWriter>> segment_writers(num_segments);
+    for (auto& segment_writer : segment_writers) {
+        segment_writer = _create_segment_writer();
+        if (segment_writer == nullptr) {
+            return OLAP_ERR_INIT_FAILED;
+        }
+    }
+    const size_t num_rows = chunk.num_rows();
+    const size_t rows_per_segment = (num_rows + num_segments - 1) / num_segments;
+    std::vector<OLAPStatus> results(num_segments, OLAP_SUCCESS);
+    std::function<void(size_t)> flush_segment = [&](size_t i) {
+        size_t from = std::min(num_rows, i * rows_per_segment);
+        size_t count = std::min(rows_per_segment, num_rows - from);
+        auto piece = chunk.clone_empty_with_schema(count);
+        piece->append(chunk, from, count);
+        auto st = segment_writers[i]->append_chunk(*piece);
+        if (!st.ok()) {
+            LOG(WARNING) << "Fail to append chunk, " << st.to_string();
+            results[i] = OLAP_ERR_WRITER_DATA_WRITE_ERROR;
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> l(_lock);
+            _num_rows_written += piece->num_rows();
+            _total_row_size += piece->bytes_usage();
+        }
+        results[i] = _flush_segment_writer(&segment_writers[i]);
+    };
+
+    // shared with the helping tasks, which may start after this flush returns and find nothing to do.
+    struct ParallelFlushState {
+        std::atomic<size_t> next{0};
+        std::mutex mutex;
+        std::condition_variable cv;
+        size_t finished = 0;
+    };
+    auto state = std::make_shared<ParallelFlushState>();
+    auto run = [state, num_segments, flush_segment]() {
+        for (size_t i = state->next++; i < num_segments; i = state->next++) {
+            flush_segment(i);
+            std::lock_guard<std::mutex> l(state->mutex);
+            if (++state->finished == num_segments) {
+                state->cv.notify_all();
+            }
+        }
+    };
+    ThreadPool* pool = StorageEngine::instance()->memtable_flush_executor()->flush_pool();
+    for (size_t i = 1; i < num_segments; i++) {
+        if (!pool->submit_func(run).ok()) {
+            break;
+        }
+    }
+    run();
+    {
+        std::unique_lock<std::mutex> l(state->mutex);
+        state->cv.wait(l, [&] { return state->finished == num_segments; });
+    }
+    for (OLAPStatus st : results) {
+        RETURN_NOT_OK(st);
+    }
+    return OLAP_SUCCESS;
+}
+
 OLAPStatus BetaRowsetWriter::flush_chunk_with_deletes(const vectorized::Chunk& upserts,
                                                       const vectorized::Column& deletes) {
     if (!deletes.empty()) {
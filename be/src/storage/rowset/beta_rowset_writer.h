@@ -23,6 +23,7 @@
 #define STARROCKS_BE_SRC_OLAP_ROWSET_BETA_ROWSET_WRITER_H
 
 #include <mutex>
+#include <unordered_set>
 #include <vector>
 
 #include "storage/rowset/rowset_writer.h"
@@ -34,6 +35,7 @@ class WritableBlock;
 }
 
 namespace segment_v2 {
+class SegmentPackWriter;
 class SegmentWriter;
 } // namespace segment_v2
 
@@ -54,6 +56,13 @@ public:
 
     OLAPStatus add_chunk_with_rssid(const vectorized::Chunk& chunk, const vector<uint32_t>& rssid) override;
 
+    OLAPStatus add_columns(const vectorized::Chunk& chunk, const std::vector<uint32_t>& column_indexes,
+                           bool is_key) override;
+
+    OLAPStatus flush_columns() override;
+
+    OLAPStatus final_flush() override;
+
     OLAPStatus flush_chunk(const vectorized::Chunk& chunk) override;
 
     OLAPStatus flush_chunk_with_deletes(const vectorized::Chunk& upserts, const vectorized::Column& deletes) override;
@@ -61,6 +70,8 @@ public:
     // add rowset by create hard link
     OLAPStatus add_rowset(RowsetSharedPtr rowset) override;
 
+    Status add_segment_file(const std::string& path) override;
+
     OLAPStatus add_rowset_for_linked_schema_change(RowsetSharedPtr rowset,
                                                    const SchemaMapping& schema_mapping) override;
 
@@ -80,9 +91,25 @@ private:
     template <typename RowType>
     OLAPStatus _add_row(const RowType& row);
 
-    std::unique_ptr<segment_v2::SegmentWriter> _create_segment_writer();
+    // the segment is written into the segment pack of the rowset if |packed|.
+    std::unique_ptr<segment_v2::SegmentWriter> _create_segment_writer(bool packed = false);
+    std::unique_ptr<segment_v2::SegmentWriter> _create_segment_writer(const std::vector<uint32_t>& column_indexes,
+                                                                      bool is_key);
+    std::unique_ptr<segment_v2::SegmentWriter> _new_segment_writer(bool packed = false);
+
+    // whether the memtable |chunk| is flushed into the segment pack.
+    bool _can_pack_segment(const vectorized::Chunk& chunk) const;
+
+    // the indexes of the columns of |schema| written to the cold files if write_cold_columns is set.
+    std::unordered_set<uint32_t> _cold_columns(const TabletSchema& schema) const;
+
+    OLAPStatus _flush_columns(segment_v2::SegmentWriter* segment_writer);
 
     OLAPStatus _flush_segment_writer(std::unique_ptr<segment_v2::SegmentWriter>* segment_writer);
+
+    // the number of segments the sorted |chunk| of a memtable is flushed into in parallel.
+    size_t _num_parallel_flush_segments(const vectorized::Chunk& chunk) const;
+    OLAPStatus _parallel_flush_chunk(const vectorized::Chunk& chunk, size_t num_segments);
     Status _flush_src_rssids();
 
     Status _final_merge();
@@ -95,6 +122,11 @@ private:
     vector<bool> _segment_has_deletes;
     vector<std::string> _tmp_segment_files;
     std::unique_ptr<segment_v2::SegmentWriter> _segment_writer;
+    // used for vertical compaction, the segments are kept open until final_flush().
+    std::vector<std::unique_ptr<segment_v2::SegmentWriter>> _segment_writers;
+    // the segment the next value columns are added to, and whether its columns are inited.
+    size_t _current_writer_index = 0;
+    bool _current_writer_inited = false;
     // mutex lock for vectorized add chunk and flush
     std::mutex _lock;
 
@@ -108,6 +140,9 @@ private:
     // used for updatable tablet's compaction
     std::unique_ptr<vector<uint32_t>> _src_rssids;
 
+    // the small segments flushed, created by the first one of them.
+    std::unique_ptr<segment_v2::SegmentPackWriter> _segment_pack;
+
     bool _is_pending = false;
     bool _already_built = false;
 };
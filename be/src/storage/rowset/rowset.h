@@ -44,6 +44,7 @@ using RowsetSharedPtr = std::shared_ptr<Rowset>;
 class RowsetFactory;
 class RowsetReader;
 class TabletSchema;
+class TokenBucket;
 
 namespace vectorized {
 class RowsetReadOptions;
@@ -214,11 +215,13 @@ public:
                 << ", tabletid:" << _rowset_meta->tablet_id();
     }
 
-    // hard link all files in this rowset to `dir` to form a new rowset with id `new_rowset_id`.
-    virtual Status link_files_to(const std::string& dir, RowsetId new_rowset_id) = 0;
+    // hard link all files in this rowset to `dir` to form a new rowset with id `new_rowset_id`,
+    // the segment i of this rowset becomes the segment `segment_id_offset + i` of the new rowset.
+    virtual Status link_files_to(const std::string& dir, RowsetId new_rowset_id, int64_t segment_id_offset = 0) = 0;
 
-    // copy all files to `dir`
-    virtual OLAPStatus copy_files_to(const std::string& dir) = 0;
+    // copy all files to `dir`, the bytes written take the tokens of `io_limiter` if it's not null,
+    // and the copies are verified by checksum if config::tablet_file_copy_verify_checksum is true.
+    virtual OLAPStatus copy_files_to(const std::string& dir, TokenBucket* io_limiter = nullptr) = 0;
 
     // return whether `path` is one of the files in this rowset
     virtual bool check_path(const std::string& path) = 0;
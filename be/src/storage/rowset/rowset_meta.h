@@ -262,6 +262,18 @@ public:
 
     void set_num_delete_files(uint32_t num_delete_files) { _rowset_meta_pb.set_num_delete_files(num_delete_files); }
 
+    bool has_segment_pack() const { return _rowset_meta_pb.has_segment_pack(); }
+
+    void set_has_segment_pack(bool has_segment_pack) { _rowset_meta_pb.set_has_segment_pack(has_segment_pack); }
+
+    bool is_partial_update() const {
+        return _rowset_meta_pb.has_txn_meta() && _rowset_meta_pb.txn_meta().partial_update_column_unique_ids_size() > 0;
+    }
+
+    const RowsetTxnMetaPB& txn_meta() const { return _rowset_meta_pb.txn_meta(); }
+
+    RowsetTxnMetaPB* mutable_txn_meta() { return _rowset_meta_pb.mutable_txn_meta(); }
+
     const RowsetMetaPB& get_meta_pb() const { return _rowset_meta_pb; }
 
 private:
@@ -39,6 +39,11 @@ public:
     static Status save(KVStore* meta, const TabletUid& tablet_uid, const RowsetId& rowset_id,
                        const RowsetMetaPB& rowset_meta_pb);
 
+    // Same as save(), but the write goes through the group commit queue of |meta|, so that
+    // the rowset metas saved by the concurrent publish threads are written in one batch.
+    static Status group_save(KVStore* meta, const TabletUid& tablet_uid, const RowsetId& rowset_id,
+                             const RowsetMetaPB& rowset_meta_pb);
+
     static Status remove(KVStore* meta, const TabletUid& tablet_uid, const RowsetId& rowset_id);
 
     static string get_rowset_meta_key(const TabletUid& tablet_uid, const RowsetId& rowset_id);
@@ -67,6 +67,17 @@ class Column;
 //      // each chunk generates a segment
 //      writer->flush_chunk(chunk);
 //
+//      // 4. add columns group by group, for vertical compaction
+//      // the key columns of all the rows are added first, which decide the segments
+//      writer->add_columns(key_chunk1, key_column_indexes, true);
+//      ...
+//      writer->flush_columns();
+//      writer->add_columns(value_chunk1, value_column_indexes, false);
+//      ...
+//      writer->flush_columns();
+//      ...
+//      writer->final_flush();
+//
 //      // finish
 //      writer->build();
 //
@@ -89,6 +100,19 @@ public:
         return OLAP_ERR_FUNC_NOT_IMPLEMENTED;
     }
 
+    // Used for vertical compaction (BetaRowsetWriter), |chunk| contains the columns of |column_indexes|
+    // in the same order. |is_key| is true iff they are the key columns, which must be added first.
+    virtual OLAPStatus add_columns(const vectorized::Chunk& chunk, const std::vector<uint32_t>& column_indexes,
+                                   bool is_key) {
+        return OLAP_ERR_FUNC_NOT_IMPLEMENTED;
+    }
+
+    // finish the group of columns added by add_columns().
+    virtual OLAPStatus flush_columns() { return OLAP_ERR_FUNC_NOT_IMPLEMENTED; }
+
+    // finish the segments after all the groups of columns are flushed by flush_columns().
+    virtual OLAPStatus final_flush() { return OLAP_ERR_FUNC_NOT_IMPLEMENTED; }
+
     // This routine is free to modify the content of |chunk|.
     virtual OLAPStatus flush_chunk(const vectorized::Chunk& chunk) = 0;
 
@@ -98,6 +122,12 @@ public:
     // Precondition: the input `rowset` should have the same type of the rowset we're building
     virtual OLAPStatus add_rowset(RowsetSharedPtr rowset) = 0;
 
+    // Add the segment file |path| built outside for the tablet schema as the next segment of the rowset, by
+    // linking it into the rowset. The footer and the columns of the segment are verified first.
+    virtual Status add_segment_file(const std::string& path) {
+        return Status::NotSupported("add_segment_file is not supported");
+    }
+
     // Precondition: the input `rowset` should have the same type of the rowset we're building
     virtual OLAPStatus add_rowset_for_linked_schema_change(RowsetSharedPtr rowset,
                                                            const SchemaMapping& schema_mapping) = 0;
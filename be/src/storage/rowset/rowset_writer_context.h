@@ -31,6 +31,7 @@
 namespace starrocks {
 
 class TabletSchema;
+class TokenBucket;
 
 class RowsetWriterContext {
 public:
@@ -53,6 +54,12 @@ public:
     Env* env = Env::Default();
     fs::BlockManager* block_mgr = fs::fs_util::block_manager();
     const TabletSchema* tablet_schema = nullptr;
+    // the columns loaded by a partial update of a primary key tablet, the segments are written
+    // with only these columns if it's not null.
+    const TabletSchema* partial_update_tablet_schema = nullptr;
+    // the writes of the segments take their tokens from |io_limiter| if it's not null,
+    // set by the background tasks like compaction and schema change.
+    TokenBucket* io_limiter = nullptr;
 
     RowsetId rowset_id{};
     int64_t tablet_id = 0;
@@ -66,6 +73,9 @@ public:
     // temporary segment files create or not, set false as default
     // only use for schema change vectorized by now
     bool write_tmp = false;
+    // write the wide value columns to the cold files under config::cold_column_storage_path, set by the
+    // compaction of the rowsets older than config::cold_column_ttl_sec.
+    bool write_cold_columns = false;
 
     RowsetStatePB rowset_state = PREPARED;
     RowsetTypePB rowset_type = BETA_ROWSET;
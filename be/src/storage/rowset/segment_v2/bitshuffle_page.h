@@ -289,7 +289,7 @@ public:
             return Status::InternalError(ss.str());
         }
 
-        RETURN_IF_ERROR(_decode());
+        // decoded on demand, the vectorized reads of the whole page decode it into the column directly.
         _parsed = true;
         return Status::OK();
     }
@@ -313,6 +313,7 @@ public:
             return Status::NotFound("page is empty");
         }
 
+        RETURN_IF_ERROR(_decode());
         size_t left = 0;
         size_t right = _num_elements;
 
@@ -345,6 +346,7 @@ public:
             return Status::OK();
         }
 
+        RETURN_IF_ERROR(_decode());
         size_t max_fetch = std::min(*n, static_cast<size_t>(_num_elements - _cur_index));
         _copy_next_values(max_fetch, dst->data());
         *n = max_fetch;
@@ -367,16 +369,23 @@ private:
     }
 
     Status _decode() {
-        if (_num_elements > 0) {
-            int64_t bytes;
-            _decoded.resize(_num_element_after_padding * _size_of_element);
-            char* in = const_cast<char*>(&_data[BITSHUFFLE_PAGE_HEADER_SIZE]);
-            bytes = bitshuffle::decompress_lz4(in, _decoded.data(), _num_element_after_padding, _size_of_element, 0);
-            if (PREDICT_FALSE(bytes < 0)) {
-                // Ideally, this should not happen.
-                LOG(ERROR) << "bitshuffle decompress failed: " << bitshuffle_error_msg(bytes);
-                return Status::RuntimeError("Unshuffle Process failed");
-            }
+        if (_decoded_ready || _num_elements == 0) {
+            return Status::OK();
+        }
+        _decoded.resize(_num_element_after_padding * _size_of_element);
+        RETURN_IF_ERROR(_decode_to(_decoded.data()));
+        _decoded_ready = true;
+        return Status::OK();
+    }
+
+    // decode all the values of the page into |out|, which has the space of |_num_element_after_padding| values.
+    Status _decode_to(void* out) {
+        char* in = const_cast<char*>(&_data[BITSHUFFLE_PAGE_HEADER_SIZE]);
+        int64_t bytes = bitshuffle::decompress_lz4(in, out, _num_element_after_padding, _size_of_element, 0);
+        if (PREDICT_FALSE(bytes < 0)) {
+            // Ideally, this should not happen.
+            LOG(ERROR) << "bitshuffle decompress failed: " << bitshuffle_error_msg(bytes);
+            return Status::RuntimeError("Unshuffle Process failed");
         }
         return Status::OK();
     }
@@ -394,6 +403,7 @@ private:
 
     int _size_of_element;
     size_t _cur_index;
+    bool _decoded_ready = false;
     faststring _decoded;
 };
 
@@ -405,6 +415,19 @@ inline Status BitShufflePageDecoder<Type>::next_batch(size_t* count, vectorized:
         return Status::OK();
     }
     *count = std::min(*count, static_cast<size_t>(_num_elements - _cur_index));
+    // the null flags of a nullable column must be initialized, so it goes through the decoded buffer.
+    if (!_decoded_ready && _cur_index == 0 && *count == _num_elements && _size_of_element == SIZE_OF_TYPE &&
+        !dst->is_nullable()) {
+        // the whole page is read, decode it into the column directly without the copy of the decoded buffer.
+        const size_t ori_size = dst->size();
+        dst->resize_uninitialized(ori_size + _num_element_after_padding);
+        Status st = _decode_to(dst->mutable_raw_data() + ori_size * SIZE_OF_TYPE);
+        dst->resize_uninitialized(ori_size + _num_elements);
+        RETURN_IF_ERROR(st);
+        _cur_index = _num_elements;
+        return Status::OK();
+    }
+    RETURN_IF_ERROR(_decode());
     int n = dst->append_numbers(&_decoded[_cur_index * SIZE_OF_TYPE], *count * SIZE_OF_TYPE);
     DCHECK_EQ(*count, n);
     _cur_index += *count;
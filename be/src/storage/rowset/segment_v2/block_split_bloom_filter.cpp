@@ -63,4 +63,22 @@ bool BlockSplitBloomFilter::test_hash(uint64_t hash) const {
     return true;
 }
 
+bool BlockSplitBloomFilter::test_any_hash(const uint64_t* hashes, size_t n) const {
+    const uint32_t block_mask = _num_bytes / BYTES_PER_BLOCK - 1;
+    for (size_t i = 0; i < n; i++) {
+        const uint32_t block_index = (uint32_t)(hashes[i] >> 32) & block_mask;
+        const uint32_t key = (uint32_t)hashes[i];
+        const auto* block = (const uint32_t*)(_data + BYTES_PER_BLOCK * block_index);
+        // test the 8 words of the block without branches, so that it's vectorized to 256-bit instructions.
+        uint32_t missed = 0;
+        for (int j = 0; j < BITS_SET_PER_BLOCK; ++j) {
+            missed |= ~block[j] & (0x1U << ((key * SALT[j]) >> 27));
+        }
+        if (missed == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
 } // namespace starrocks::segment_v2
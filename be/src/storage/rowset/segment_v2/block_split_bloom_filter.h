@@ -37,6 +37,8 @@ public:
 
     bool test_hash(uint64_t hash) const override;
 
+    bool test_any_hash(const uint64_t* hashes, size_t n) const override;
+
 private:
     void _set_masks(uint32_t key, uint32_t* masks) const {
         for (int i = 0; i < BITS_SET_PER_BLOCK; ++i) {
@@ -23,6 +23,7 @@
 
 #include <map>
 #include <memory>
+#include <unordered_set>
 #include <utility>
 
 #include "env/env.h"
@@ -85,6 +86,22 @@ inline void update_bf(BloomFilter* bf, const typename CppTypeTraits<type>::CppTy
     }
 }
 
+Status write_bloom_filters(const std::vector<std::unique_ptr<BloomFilter>>& bfs, fs::WritableBlock* wblock,
+                           BloomFilterIndexPB* meta) {
+    TypeInfoPtr bf_typeinfo = get_type_info(OLAP_FIELD_TYPE_VARCHAR);
+    IndexedColumnWriterOptions options;
+    options.write_ordinal_index = true;
+    options.write_value_index = false;
+    options.encoding = PLAIN_ENCODING;
+    IndexedColumnWriter bf_writer(options, bf_typeinfo, wblock);
+    RETURN_IF_ERROR(bf_writer.init());
+    for (auto& bf : bfs) {
+        Slice data(bf->data(), bf->size());
+        bf_writer.add(&data);
+    }
+    return bf_writer.finish(meta->mutable_bloom_filter());
+}
+
 // Builder for bloom filter. In starrocks, bloom filter index is used in
 // high cardinality key columns and none-agg value columns for high selectivity and storage
 // efficiency.
@@ -137,20 +154,7 @@ public:
         meta->set_hash_strategy(_bf_options.strategy);
         meta->set_algorithm(BLOCK_BLOOM_FILTER);
 
-        // write bloom filters
-        TypeInfoPtr bf_typeinfo = get_type_info(OLAP_FIELD_TYPE_VARCHAR);
-        IndexedColumnWriterOptions options;
-        options.write_ordinal_index = true;
-        options.write_value_index = false;
-        options.encoding = PLAIN_ENCODING;
-        IndexedColumnWriter bf_writer(options, bf_typeinfo, wblock);
-        RETURN_IF_ERROR(bf_writer.init());
-        for (auto& bf : _bfs) {
-            Slice data(bf->data(), bf->size());
-            bf_writer.add(&data);
-        }
-        RETURN_IF_ERROR(bf_writer.finish(meta->mutable_bloom_filter()));
-        return Status::OK();
+        return write_bloom_filters(_bfs, wblock, meta);
     }
 
     uint64_t size() override {
@@ -170,6 +174,66 @@ private:
     std::vector<std::unique_ptr<BloomFilter>> _bfs;
 };
 
+// The n-grams are hashed in the same way as BloomFilter::add_bytes(), so that they can be tested by test_bytes().
+class NgramBloomFilterIndexWriter : public BloomFilterIndexWriter {
+public:
+    NgramBloomFilterIndexWriter(const BloomFilterOptions& bf_options, uint32_t gram_size)
+            : _bf_options(bf_options), _gram_size(gram_size) {}
+
+    ~NgramBloomFilterIndexWriter() override = default;
+
+    void add_values(const void* values, size_t count) override {
+        const auto* v = reinterpret_cast<const Slice*>(values);
+        for (size_t i = 0; i < count; ++i, ++v) {
+            for (size_t pos = 0; pos + _gram_size <= v->size; ++pos) {
+                uint64_t hash_code;
+                murmur_hash3_x64_64(v->data + pos, _gram_size, BloomFilter::DEFAULT_SEED, &hash_code);
+                _grams.insert(hash_code);
+            }
+        }
+    }
+
+    void add_nulls(uint32_t count) override { _has_null |= (count > 0); }
+
+    Status flush() override {
+        std::unique_ptr<BloomFilter> bf;
+        RETURN_IF_ERROR(BloomFilter::create(BLOCK_BLOOM_FILTER, &bf));
+        RETURN_IF_ERROR(bf->init(_grams.size(), _bf_options.fpp, _bf_options.strategy));
+        bf->set_has_null(_has_null);
+        for (uint64_t hash_code : _grams) {
+            bf->add_hash(hash_code);
+        }
+        _bf_buffer_size += bf->size();
+        _bfs.push_back(std::move(bf));
+        _grams.clear();
+        _has_null = false;
+        return Status::OK();
+    }
+
+    Status finish(fs::WritableBlock* wblock, ColumnIndexMetaPB* index_meta) override {
+        if (!_grams.empty()) {
+            RETURN_IF_ERROR(flush());
+        }
+        index_meta->set_type(NGRAM_BLOOM_FILTER_INDEX);
+        BloomFilterIndexPB* meta = index_meta->mutable_ngram_bloom_filter_index();
+        meta->set_hash_strategy(_bf_options.strategy);
+        meta->set_algorithm(BLOCK_BLOOM_FILTER);
+        meta->set_gram_size(_gram_size);
+        return write_bloom_filters(_bfs, wblock, meta);
+    }
+
+    uint64_t size() override { return _bf_buffer_size + _grams.size() * sizeof(uint64_t); }
+
+private:
+    BloomFilterOptions _bf_options;
+    const uint32_t _gram_size;
+    bool _has_null = false;
+    uint64_t _bf_buffer_size = 0;
+    // the hashes of the distinct n-grams of the current page
+    std::unordered_set<uint64_t> _grams;
+    std::vector<std::unique_ptr<BloomFilter>> _bfs;
+};
+
 } // namespace
 
 // TODO currently we don't support bloom filter index for tinyint/hll/float/double
@@ -247,4 +311,16 @@ Status BloomFilterIndexWriter::create(const BloomFilterOptions& bf_options, cons
     return Status::OK();
 }
 
+Status BloomFilterIndexWriter::create_ngram(const BloomFilterOptions& bf_options, const TypeInfoPtr& typeinfo,
+                                            uint32_t gram_size, std::unique_ptr<BloomFilterIndexWriter>* res) {
+    if (typeinfo->type() != OLAP_FIELD_TYPE_CHAR && typeinfo->type() != OLAP_FIELD_TYPE_VARCHAR) {
+        return Status::NotSupported("unsupported type for n-gram bloom filter: " + std::to_string(typeinfo->type()));
+    }
+    if (gram_size == 0) {
+        return Status::InvalidArgument("gram size of n-gram bloom filter must be positive");
+    }
+    *res = std::make_unique<NgramBloomFilterIndexWriter>(bf_options, gram_size);
+    return Status::OK();
+}
+
 } // namespace starrocks::segment_v2
@@ -46,6 +46,11 @@ public:
     static Status create(const BloomFilterOptions& bf_options, const TypeInfoPtr& typeinfo,
                          std::unique_ptr<BloomFilterIndexWriter>* res);
 
+    // Create the writer of the n-gram bloom filter index of a CHAR/VARCHAR column, every page of which has a bloom
+    // filter of all the substrings of |gram_size| bytes of its values, to skip the pages by LIKE '%abc%' or instr().
+    static Status create_ngram(const BloomFilterOptions& bf_options, const TypeInfoPtr& typeinfo, uint32_t gram_size,
+                               std::unique_ptr<BloomFilterIndexWriter>* res);
+
     BloomFilterIndexWriter() = default;
     virtual ~BloomFilterIndexWriter() = default;
 
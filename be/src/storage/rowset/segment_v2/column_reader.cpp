@@ -32,6 +32,7 @@
 #include "column/datum.h"
 #include "column/datum_convert.h"
 #include "column/nullable_column.h"
+#include "common/config.h"
 #include "common/logging.h"
 #include "gutil/casts.h"
 #include "storage/column_block.h" // for ColumnBlockView
@@ -48,6 +49,7 @@
 #include "storage/vectorized/column_predicate.h"
 #include "util/block_compression.h"
 #include "util/rle_encoding.h" // for RleDecoder
+#include "util/runtime_profile.h"
 
 namespace starrocks::segment_v2 {
 
@@ -66,7 +68,8 @@ ColumnReader::ColumnReader(const private_type&, MemTracker* mem_tracker, const C
           _zone_map_index(),
           _ordinal_index(),
           _bitmap_index(),
-          _bloom_filter_index() {
+          _bloom_filter_index(),
+          _ngram_bloom_filter_index() {
     _mem_tracker->consume(sizeof(ColumnReader));
 }
 
@@ -82,6 +85,9 @@ ColumnReader::~ColumnReader() {
 
     delete (_flags[kHasBloomFilterIndexMetaPos] ? _bloom_filter_index.meta : nullptr);
     delete (_flags[kHasBloomFilterIndexReaderPos] ? _bloom_filter_index.reader : nullptr);
+
+    delete (_flags[kHasNgramBloomFilterIndexMetaPos] ? _ngram_bloom_filter_index.meta : nullptr);
+    delete (_flags[kHasNgramBloomFilterIndexReaderPos] ? _ngram_bloom_filter_index.reader : nullptr);
 }
 
 Status ColumnReader::_init(ColumnMetaPB* meta) {
@@ -95,7 +101,14 @@ Status ColumnReader::_init(ColumnMetaPB* meta) {
 
     if (is_scalar_field_type(delegate_type(_column_type))) {
         RETURN_IF_ERROR(EncodingInfo::get(delegate_type(_column_type), meta->encoding(), &_encoding_info));
-        RETURN_IF_ERROR(get_block_compression_codec(meta->compression(), &_compress_codec));
+        if (meta->has_compression_dict()) {
+            RETURN_IF_ERROR(create_zstd_dict_codec(meta->compression_dict(), 0, &_dict_compress_codec));
+            _compress_codec = _dict_compress_codec.get();
+            // the dictionary has been digested by the codec.
+            meta->clear_compression_dict();
+        } else {
+            RETURN_IF_ERROR(get_block_compression_codec(meta->compression(), &_compress_codec));
+        }
 
         for (int i = 0; i < meta->indexes_size(); i++) {
             auto* index_meta = meta->mutable_indexes(i);
@@ -117,6 +130,11 @@ Status ColumnReader::_init(ColumnMetaPB* meta) {
                 _bloom_filter_index.meta = index_meta->release_bloom_filter_index();
                 _flags.set(kHasBloomFilterIndexMetaPos, true);
                 break;
+            case NGRAM_BLOOM_FILTER_INDEX:
+                _ngram_bloom_filter_index.meta = index_meta->release_ngram_bloom_filter_index();
+                _ngram_gram_size = _ngram_bloom_filter_index.meta->gram_size();
+                _flags.set(kHasNgramBloomFilterIndexMetaPos, true);
+                break;
             case UNKNOWN_INDEX_TYPE:
                 return Status::Corruption(fmt::format("Bad file {}: unknown index type", _file_name));
             }
@@ -193,9 +211,12 @@ Status ColumnReader::read_page(const ColumnIteratorOptions& iter_opts, const Pag
     opts.page_pointer = pp;
     opts.codec = _compress_codec;
     opts.stats = iter_opts.stats;
+    opts.column_stats = iter_opts.column_stats;
     opts.verify_checksum = _opts.verify_checksum;
     opts.use_page_cache = iter_opts.use_page_cache;
     opts.kept_in_memory = _opts.kept_in_memory;
+    opts.data_page = true;
+    opts.fill_page_cache = iter_opts.fill_page_cache;
 
     return PageIO::read_and_decompress_page(opts, handle, page_body, footer);
 }
@@ -344,12 +365,12 @@ Status ColumnReader::get_row_ranges_by_bloom_filter(CondColumn* cond_column, Row
     return Status::OK();
 }
 
-// prerequisite: at least one predicate in |predicates| support bloom filter.
-Status ColumnReader::bloom_filter(const std::vector<const vectorized::ColumnPredicate*>& predicates,
-                                  vectorized::SparseRange* row_ranges) {
+template <typename Matcher>
+Status ColumnReader::_bloom_filter(BloomFilterIndexReader* reader, const Matcher& matcher,
+                                   vectorized::SparseRange* row_ranges) {
     vectorized::SparseRange bf_row_ranges;
     std::unique_ptr<BloomFilterIndexIterator> bf_iter;
-    RETURN_IF_ERROR(_bloom_filter_index.reader->new_iterator(&bf_iter));
+    RETURN_IF_ERROR(reader->new_iterator(&bf_iter));
     size_t range_size = row_ranges->size();
     // get covered page ids
     std::set<int32_t> page_ids;
@@ -366,17 +387,44 @@ Status ColumnReader::bloom_filter(const std::vector<const vectorized::ColumnPred
     for (const auto& pid : page_ids) {
         std::unique_ptr<BloomFilter> bf;
         RETURN_IF_ERROR(bf_iter->read_bloom_filter(pid, &bf));
-        for (const auto* pred : predicates) {
-            if (pred->support_bloom_filter() && pred->bloom_filter(bf.get())) {
-                bf_row_ranges.add(vectorized::Range(_ordinal_index.reader->get_first_ordinal(pid),
-                                                    _ordinal_index.reader->get_last_ordinal(pid) + 1));
-            }
+        if (matcher(bf.get())) {
+            bf_row_ranges.add(vectorized::Range(_ordinal_index.reader->get_first_ordinal(pid),
+                                                _ordinal_index.reader->get_last_ordinal(pid) + 1));
         }
     }
     *row_ranges = row_ranges->intersection(bf_row_ranges);
     return Status::OK();
 }
 
+// prerequisite: at least one predicate in |predicates| support bloom filter.
+Status ColumnReader::bloom_filter(const std::vector<const vectorized::ColumnPredicate*>& predicates,
+                                  vectorized::SparseRange* row_ranges) {
+    // the predicates are conjunctive, the page is skipped if any of them can't match.
+    auto matcher = [&](const BloomFilter* bf) {
+        for (const auto* pred : predicates) {
+            if (pred->support_bloom_filter() && !pred->bloom_filter(bf)) {
+                return false;
+            }
+        }
+        return true;
+    };
+    return _bloom_filter(_bloom_filter_index.reader, matcher, row_ranges);
+}
+
+// prerequisite: at least one predicate in |predicates| support n-gram bloom filter.
+Status ColumnReader::ngram_bloom_filter(const std::vector<const vectorized::ColumnPredicate*>& predicates,
+                                        vectorized::SparseRange* row_ranges) {
+    auto matcher = [&](const BloomFilter* bf) {
+        for (const auto* pred : predicates) {
+            if (pred->support_ngram_bloom_filter() && !pred->ngram_bloom_filter(bf, _ngram_gram_size)) {
+                return false;
+            }
+        }
+        return true;
+    };
+    return _bloom_filter(_ngram_bloom_filter_index.reader, matcher, row_ranges);
+}
+
 Status ColumnReader::_load_ordinal_index(bool use_page_cache, bool kept_in_memory) {
     Status st;
     if (_flags[kHasOrdinalIndexMetaPos]) {
@@ -434,6 +482,21 @@ Status ColumnReader::_load_bloom_filter_index(bool use_page_cache, bool kept_in_
     return st;
 }
 
+Status ColumnReader::_load_ngram_bloom_filter_index(bool use_page_cache, bool kept_in_memory) {
+    Status st;
+    if (_flags[kHasNgramBloomFilterIndexMetaPos]) {
+        auto* index_meta = _ngram_bloom_filter_index.meta;
+        _ngram_bloom_filter_index.reader = new BloomFilterIndexReader();
+        st = _ngram_bloom_filter_index.reader->load(_opts.block_mgr, _file_name, index_meta, use_page_cache,
+                                                    kept_in_memory);
+        delete index_meta;
+        _flags.set(kHasNgramBloomFilterIndexMetaPos, false);
+        _flags.set(kHasNgramBloomFilterIndexReaderPos, true);
+        _mem_tracker->consume(static_cast<int64_t>(_ngram_bloom_filter_index.reader->mem_usage()));
+    }
+    return st;
+}
+
 Status ColumnReader::seek_to_first(OrdinalPageIndexIterator* iter) {
     *iter = _ordinal_index.reader->begin();
     if (!iter->valid()) {
@@ -456,10 +519,50 @@ Status ColumnReader::zone_map_filter(const std::vector<const vectorized::ColumnP
                                      vectorized::SparseRange* row_ranges) {
     std::vector<uint32_t> page_indexes;
     RETURN_IF_ERROR(_zone_map_filter(predicates, del_predicate, del_partial_filtered_pages, &page_indexes));
+    if (_zone_map_index.reader->sub_page_rows() > 0 && !predicates.empty()) {
+        return _sub_page_zone_map_filter(predicates, page_indexes, row_ranges);
+    }
     RETURN_IF_ERROR(_calculate_row_ranges(page_indexes, row_ranges));
     return Status::OK();
 }
 
+Status ColumnReader::_sub_page_zone_map_filter(const std::vector<const vectorized::ColumnPredicate*>& predicates,
+                                               const std::vector<uint32_t>& pages,
+                                               vectorized::SparseRange* row_ranges) {
+    const std::vector<ZoneMapPB>& zone_maps = _zone_map_index.reader->sub_page_zone_maps();
+    const uint32_t sub_page_rows = _zone_map_index.reader->sub_page_rows();
+    // the index of the first sub-page of the page |page|.
+    size_t sub_page = 0;
+    int32_t page = 0;
+    for (uint32_t i : pages) {
+        for (; page < static_cast<int32_t>(i); page++) {
+            ordinal_t num_rows = _ordinal_index.reader->get_last_ordinal(page) + 1 -
+                                 _ordinal_index.reader->get_first_ordinal(page);
+            sub_page += (num_rows + sub_page_rows - 1) / sub_page_rows;
+        }
+        const ordinal_t first = _ordinal_index.reader->get_first_ordinal(i);
+        const ordinal_t end = _ordinal_index.reader->get_last_ordinal(i) + 1;
+        const size_t num_sub_pages = (end - first + sub_page_rows - 1) / sub_page_rows;
+        if (sub_page + num_sub_pages > zone_maps.size()) {
+            return Status::Corruption(fmt::format("Bad sub-page zone maps of {}, expect at least {}, got {}",
+                                                  _file_name, sub_page + num_sub_pages, zone_maps.size()));
+        }
+        for (size_t k = 0; k < num_sub_pages; k++) {
+            vectorized::ZoneMapDetail detail;
+            _parse_zone_map(zone_maps[sub_page + k], &detail);
+            auto filter = [&](const vectorized::ColumnPredicate* pred) { return pred->zone_map_filter(detail); };
+            if (std::all_of(predicates.begin(), predicates.end(), filter)) {
+                ordinal_t from = first + k * sub_page_rows;
+                ordinal_t to = std::min<ordinal_t>(end, from + sub_page_rows);
+                row_ranges->add({static_cast<rowid_t>(from), static_cast<rowid_t>(to)});
+            }
+        }
+        sub_page += num_sub_pages;
+        page = static_cast<int32_t>(i) + 1;
+    }
+    return Status::OK();
+}
+
 Status ColumnReader::_zone_map_filter(const std::vector<const vectorized::ColumnPredicate*>& predicates,
                                       const vectorized::ColumnPredicate* del_predicate,
                                       std::unordered_set<uint32_t>* del_partial_filtered_pages,
@@ -538,6 +641,7 @@ Status ColumnReader::ensure_index_loaded(ReaderType reader_type) {
             RETURN_IF_ERROR(_load_zone_map_index(use_page_cache, _opts.kept_in_memory));
             RETURN_IF_ERROR(_load_bitmap_index(use_page_cache, _opts.kept_in_memory));
             RETURN_IF_ERROR(_load_bloom_filter_index(use_page_cache, _opts.kept_in_memory));
+            RETURN_IF_ERROR(_load_ngram_bloom_filter_index(use_page_cache, _opts.kept_in_memory));
             return Status::OK();
         });
     }
@@ -710,6 +814,12 @@ FileColumnIterator::~FileColumnIterator() = default;
 
 Status FileColumnIterator::init(const ColumnIteratorOptions& opts) {
     _opts = opts;
+    if (_reader->in_cold_file()) {
+        RETURN_IF_ERROR(_reader->open_block(&_cold_rblock));
+        _opts.rblock = _cold_rblock.get();
+        // the cold file is usually on the remote storage, keep the pages read locally.
+        _opts.use_page_cache = !config::disable_storage_page_cache;
+    }
     RETURN_IF_ERROR(_reader->ensure_index_loaded(_opts.reader_type));
 
     if (_reader->encoding_info()->encoding() != DICT_ENCODING) {
@@ -826,7 +936,7 @@ Status FileColumnIterator::next_batch(size_t* n, ColumnBlockView* dst, bool* has
     *n -= remaining;
     // TODO(hkp): for string type, the bytes_read should be passed to page decoder
     // bytes_read = data size + null bitmap size
-    _opts.stats->bytes_read += static_cast<int64_t>(*n * dst->type_info()->size() + BitmapSize(*n));
+    _update_bytes_read(*n * dst->type_info()->size() + BitmapSize(*n));
     return Status::OK();
 }
 
@@ -846,13 +956,49 @@ Status FileColumnIterator::next_batch(size_t* n, vectorized::Column* dst) {
         contain_deleted_row = contain_deleted_row || _contains_deleted_row(_page->page_index());
         // number of rows to be read from this page
         size_t nread = remaining;
-        RETURN_IF_ERROR(_page->read(dst, &nread));
+        if (_opts.column_stats != nullptr) {
+            SCOPED_RAW_TIMER(&_opts.column_stats->decode_ns);
+            RETURN_IF_ERROR(_page->read(dst, &nread));
+        } else {
+            RETURN_IF_ERROR(_page->read(dst, &nread));
+        }
         _current_ordinal += nread;
         remaining -= nread;
     }
     dst->set_delete_state(contain_deleted_row ? DEL_PARTIAL_SATISFIED : DEL_NOT_SATISFIED);
     *n -= remaining;
-    _opts.stats->bytes_read += static_cast<int64_t>(dst->byte_size() - prev_bytes);
+    _update_bytes_read(dst->byte_size() - prev_bytes);
+    return Status::OK();
+}
+
+Status FileColumnIterator::next_batch_and_evaluate(size_t* n, vectorized::Column* dst,
+                                                   const vectorized::ColumnPredicate* pred, uint8_t* selection) {
+    size_t remaining = *n;
+    size_t prev_bytes = dst->byte_size();
+    bool contain_deleted_row = (dst->delete_state() != DEL_NOT_SATISFIED);
+    while (remaining > 0) {
+        if (_page->remaining() == 0) {
+            bool eos = false;
+            RETURN_IF_ERROR(_load_next_page(&eos));
+            if (eos) {
+                break;
+            }
+        }
+
+        contain_deleted_row = contain_deleted_row || _contains_deleted_row(_page->page_index());
+        size_t nread = remaining;
+        if (_opts.column_stats != nullptr) {
+            SCOPED_RAW_TIMER(&_opts.column_stats->decode_ns);
+            RETURN_IF_ERROR(_page->read_and_evaluate(dst, &nread, pred, selection));
+        } else {
+            RETURN_IF_ERROR(_page->read_and_evaluate(dst, &nread, pred, selection));
+        }
+        _current_ordinal += nread;
+        remaining -= nread;
+    }
+    dst->set_delete_state(contain_deleted_row ? DEL_PARTIAL_SATISFIED : DEL_NOT_SATISFIED);
+    *n -= remaining;
+    _update_bytes_read(dst->byte_size() - prev_bytes);
     return Status::OK();
 }
 
@@ -927,6 +1073,21 @@ Status FileColumnIterator::get_row_ranges_by_zone_map(CondColumn* cond_column, C
     return Status::OK();
 }
 
+Status FileColumnIterator::get_page_pointers(const vectorized::SparseRange& range, std::vector<PagePointer>* pages) {
+    OrdinalPageIndexIterator iter;
+    for (size_t i = 0; i < range.size(); i++) {
+        const vectorized::Range& r = range[i];
+        RETURN_IF_ERROR(_reader->seek_at_or_before(r.begin(), &iter));
+        // adjacent ranges may start in the page where the previous one ends.
+        for (; iter.valid() && iter.first_ordinal() < r.end(); iter.next()) {
+            if (pages->empty() || pages->back() != iter.page()) {
+                pages->push_back(iter.page());
+            }
+        }
+    }
+    return Status::OK();
+}
+
 Status FileColumnIterator::get_row_ranges_by_zone_map(const std::vector<const vectorized::ColumnPredicate*>& predicates,
                                                       const vectorized::ColumnPredicate* del_predicate,
                                                       vectorized::SparseRange* row_ranges) {
@@ -949,13 +1110,18 @@ Status FileColumnIterator::get_row_ranges_by_bloom_filter(CondColumn* cond_colum
 
 Status FileColumnIterator::get_row_ranges_by_bloom_filter(
         const std::vector<const vectorized::ColumnPredicate*>& predicates, vectorized::SparseRange* row_ranges) {
-    RETURN_IF(!_reader->has_bloom_filter_index(), Status::OK());
     bool support = false;
+    bool support_ngram = false;
     for (const auto* pred : predicates) {
         support = support | pred->support_bloom_filter();
+        support_ngram = support_ngram | pred->support_ngram_bloom_filter();
+    }
+    if (support && _reader->has_bloom_filter_index()) {
+        RETURN_IF_ERROR(_reader->bloom_filter(predicates, row_ranges));
+    }
+    if (support_ngram && _reader->has_ngram_bloom_filter_index()) {
+        RETURN_IF_ERROR(_reader->ngram_bloom_filter(predicates, row_ranges));
     }
-    RETURN_IF(!support, Status::OK());
-    RETURN_IF_ERROR(_reader->bloom_filter(predicates, row_ranges));
     return Status::OK();
 }
 
@@ -1022,7 +1188,7 @@ Status FileColumnIterator::_do_next_dict_codes(size_t* n, vectorized::Column* ds
         RETURN_IF_ERROR(_page->read_dict_codes(dst, &nread));
         _current_ordinal += nread;
         remaining -= nread;
-        _opts.stats->bytes_read += static_cast<int64_t>(nread * sizeof(int32_t));
+        _update_bytes_read(nread * sizeof(int32_t));
     }
     dst->set_delete_state(contain_delted_row ? DEL_PARTIAL_SATISFIED : DEL_NOT_SATISFIED);
     *n -= remaining;
@@ -1049,7 +1215,7 @@ Status FileColumnIterator::_do_decode_dict_codes(const int32_t* codes, size_t si
     }
     [[maybe_unused]] bool ok = words->append_strings(slices);
     DCHECK(ok);
-    _opts.stats->bytes_read += static_cast<int64_t>(words->byte_size() + BitmapSize(slices.size()));
+    _update_bytes_read(words->byte_size() + BitmapSize(slices.size()));
     return Status::OK();
 }
 
@@ -1083,7 +1249,7 @@ Status FileColumnIterator::_fetch_by_rowid(const rowid_t* rowids, size_t size, v
         DCHECK_EQ(_current_ordinal, _page->first_ordinal() + _page->offset());
     } while (rowids != end);
     values->set_delete_state(contain_deleted_row ? DEL_PARTIAL_SATISFIED : DEL_NOT_SATISFIED);
-    _opts.stats->bytes_read += static_cast<int64_t>(values->byte_size() - prev_bytes);
+    _update_bytes_read(values->byte_size() - prev_bytes);
     DCHECK_EQ(_current_ordinal, _page->first_ordinal() + _page->offset());
     return Status::OK();
 }
@@ -1221,6 +1387,14 @@ Status DefaultValueColumnIterator::get_row_ranges_by_zone_map(
     return Status::OK();
 }
 
+Status ColumnIterator::next_batch_and_evaluate(size_t* n, vectorized::Column* dst,
+                                               const vectorized::ColumnPredicate* pred, uint8_t* selection) {
+    const size_t from = dst->size();
+    RETURN_IF_ERROR(next_batch(n, dst));
+    pred->evaluate(dst, selection, from, from + *n);
+    return Status::OK();
+}
+
 Status ColumnIterator::decode_dict_codes(const vectorized::Column& codes, vectorized::Column* words) {
     if (codes.is_nullable()) {
         const vectorized::ColumnPtr& data_column = down_cast<const vectorized::NullableColumn&>(codes).data_column();
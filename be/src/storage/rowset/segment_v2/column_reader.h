@@ -86,13 +86,19 @@ struct ColumnReaderOptions {
     bool verify_checksum = true;
     // for in memory olap table, use DURABLE CachePriority in page cache
     bool kept_in_memory = false;
+    // whether the column is in the cold file of the segment, which is read through the page cache.
+    bool in_cold_file = false;
 };
 
 struct ColumnIteratorOptions {
     fs::ReadableBlock* rblock = nullptr;
     // reader statistics
     OlapReaderStatistics* stats = nullptr;
+    // the statistics of this column, null if not collected.
+    ColumnReadStatistics* column_stats = nullptr;
     bool use_page_cache = false;
+    // whether to insert the data pages missed into page cache.
+    bool fill_page_cache = true;
 
     // check whether column pages are all dictionary encoding.
     bool check_dict_encoding = false;
@@ -153,6 +159,9 @@ public:
     bool has_bloom_filter_index() const {
         return _flags[kHasBloomFilterIndexMetaPos] || _flags[kHasBloomFilterIndexReaderPos];
     }
+    bool has_ngram_bloom_filter_index() const {
+        return _flags[kHasNgramBloomFilterIndexMetaPos] || _flags[kHasNgramBloomFilterIndexReaderPos];
+    }
 
     ZoneMapPB* segment_zone_map() const { return _segment_zone_map.get(); }
 
@@ -197,8 +206,19 @@ public:
     Status bloom_filter(const std::vector<const ::starrocks::vectorized::ColumnPredicate*>& p,
                         vectorized::SparseRange* ranges);
 
+    // prerequisite: at least one predicate in |predicates| support n-gram bloom filter.
+    Status ngram_bloom_filter(const std::vector<const ::starrocks::vectorized::ColumnPredicate*>& p,
+                              vectorized::SparseRange* ranges);
+
     uint32_t version() const { return _opts.storage_format_version; }
 
+    bool in_cold_file() const { return _opts.in_cold_file; }
+
+    // open the file of this column, which is the cold file of the segment if in_cold_file().
+    Status open_block(std::unique_ptr<fs::ReadableBlock>* rblock) const {
+        return _opts.block_mgr->open_block(_file_name, rblock);
+    }
+
     // Read and load necessary column indexes into memory if it hasn't been loaded.
     // May be called multiple times, subsequent calls will no op.
     Status ensure_index_loaded(ReaderType reader_type);
@@ -225,6 +245,8 @@ private:
     constexpr static size_t kIsNullablePos = 8;
     constexpr static size_t kHasAllDictEncodedPos = 9;
     constexpr static size_t kAllDictEncodedPos = 10;
+    constexpr static size_t kHasNgramBloomFilterIndexMetaPos = 11;
+    constexpr static size_t kHasNgramBloomFilterIndexReaderPos = 12;
 
     // Disable copy and assignment
     ColumnReader(const ColumnReader&) = delete;
@@ -239,6 +261,11 @@ private:
     Status _load_ordinal_index(bool use_page_cache, bool kept_in_memory);
     Status _load_bitmap_index(bool use_page_cache, bool kept_in_memory);
     Status _load_bloom_filter_index(bool use_page_cache, bool kept_in_memory);
+    Status _load_ngram_bloom_filter_index(bool use_page_cache, bool kept_in_memory);
+
+    // keep the row ranges of the pages whose bloom filters in |reader| satisfy |matcher|.
+    template <typename Matcher>
+    Status _bloom_filter(BloomFilterIndexReader* reader, const Matcher& matcher, vectorized::SparseRange* row_ranges);
 
     static bool _zone_map_match_condition(const ZoneMapPB& zone_map, WrapperField* min_value_container,
                                           WrapperField* max_value_container, CondColumn* cond);
@@ -260,6 +287,10 @@ private:
                             const vectorized::ColumnPredicate* del_predicate,
                             std::unordered_set<uint32_t>* del_partial_filtered_pages, std::vector<uint32_t>* pages);
 
+    // the row ranges of the sub-pages of |pages| which may satisfy |predicates| by the sub-page zone maps.
+    Status _sub_page_zone_map_filter(const std::vector<const vectorized::ColumnPredicate*>& predicates,
+                                     const std::vector<uint32_t>& pages, vectorized::SparseRange* row_ranges);
+
     MemTracker* _mem_tracker = nullptr;
 
     // ColumnReader will be resident in memory. When there are many columns in the table,
@@ -275,11 +306,16 @@ private:
     // initialized in init(), used for create PageDecoder
     const EncodingInfo* _encoding_info = nullptr;
     const BlockCompressionCodec* _compress_codec = nullptr; // initialized in init()
+    // present if the pages are compressed with a ZSTD dictionary.
+    std::unique_ptr<BlockCompressionCodec> _dict_compress_codec;
 
     ColumnIndex<ZoneMapIndexPB, ZoneMapIndexReader> _zone_map_index;
     ColumnIndex<OrdinalIndexPB, OrdinalIndexReader> _ordinal_index;
     ColumnIndex<BitmapIndexPB, BitmapIndexReader> _bitmap_index;
     ColumnIndex<BloomFilterIndexPB, BloomFilterIndexReader> _bloom_filter_index;
+    ColumnIndex<BloomFilterIndexPB, BloomFilterIndexReader> _ngram_bloom_filter_index;
+    // the size of the n-grams in _ngram_bloom_filter_index.
+    uint32_t _ngram_gram_size = 0;
 
     std::unique_ptr<ZoneMapPB> _segment_zone_map;
 
@@ -328,6 +364,14 @@ public:
 
     virtual Status next_batch(size_t* n, vectorized::Column* dst) = 0;
 
+    // Reads the next |*n| rows like `next_batch`, and evaluates |pred| on them into |selection|, which is
+    // indexed by the row of |dst|, i.e. the results of the rows read are in [dst->size(), dst->size() + *n)
+    // of |selection| where the size is the one before the call.
+    // The iterators of the encoded pages may evaluate |pred| on the encoded values, the values of the
+    // unselected rows may be not decoded then.
+    virtual Status next_batch_and_evaluate(size_t* n, vectorized::Column* dst,
+                                           const vectorized::ColumnPredicate* pred, uint8_t* selection);
+
     virtual ordinal_t get_current_ordinal() const = 0;
 
     virtual Status get_row_ranges_by_zone_map(CondColumn* cond_column, CondColumn* delete_condition,
@@ -349,6 +393,12 @@ public:
         return Status::OK();
     }
 
+    // Append the pointers of the data pages holding the rows of |range| to |pages|, in the order of ordinals.
+    // Used to prefetch the pages to be read, leaving |pages| unchanged means nothing to prefetch.
+    virtual Status get_page_pointers(const vectorized::SparseRange& range, std::vector<PagePointer>* pages) {
+        return Status::OK();
+    }
+
     // return true iff all data pages of this column are encoded as dictionary encoding.
     // NOTE: the ColumnIterator must have been initialized with `check_dict_encoding`,
     // otherwise this method will always return false.
@@ -425,6 +475,9 @@ public:
 
     Status next_batch(size_t* n, vectorized::Column* dst) override;
 
+    Status next_batch_and_evaluate(size_t* n, vectorized::Column* dst, const vectorized::ColumnPredicate* pred,
+                                   uint8_t* selection) override;
+
     ordinal_t get_current_ordinal() const override { return _current_ordinal; }
 
     // get row ranges by zone map
@@ -442,6 +495,8 @@ public:
     Status get_row_ranges_by_bloom_filter(const std::vector<const vectorized::ColumnPredicate*>& predicates,
                                           vectorized::SparseRange* range) override;
 
+    Status get_page_pointers(const vectorized::SparseRange& range, std::vector<PagePointer>* pages) override;
+
     bool all_page_dict_encoded() const override { return _all_dict_encoded; }
 
     Status fetch_all_dict_words(std::vector<Slice>* words) const override;
@@ -467,6 +522,13 @@ public:
     int dict_size();
 
 private:
+    void _update_bytes_read(size_t bytes) {
+        _opts.stats->bytes_read += static_cast<int64_t>(bytes);
+        if (_opts.column_stats != nullptr) {
+            _opts.column_stats->bytes_read += static_cast<int64_t>(bytes);
+        }
+    }
+
     static void _seek_to_pos_in_page(ParsedPage* page, ordinal_t offset_in_page);
     Status _load_next_page(bool* eos);
     Status _read_data_page(const OrdinalPageIndexIterator& iter);
@@ -501,6 +563,10 @@ private:
 
     ColumnReader* _reader;
 
+    // the cold file of the segment opened by this iterator if the column is in it, instead of the segment file
+    // in the iterator options.
+    std::unique_ptr<fs::ReadableBlock> _cold_rblock;
+
     // 1. The _page represents current page.
     // 2. We define an operation is one seek and following read,
     //    If new seek is issued, the _page will be reset.
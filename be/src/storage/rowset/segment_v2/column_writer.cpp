@@ -368,10 +368,16 @@ ScalarColumnWriter::~ScalarColumnWriter() {
 }
 
 Status ScalarColumnWriter::init() {
-    RETURN_IF_ERROR(get_block_compression_codec(_opts.meta->compression(), &_compress_codec));
+    RETURN_IF_ERROR(
+            get_block_compression_codec(_opts.meta->compression(), _opts.compression_level, &_compress_codec));
+    _training_compression_dict = _opts.meta->compression() == ZSTD && _opts.compression_dict_size > 0;
 
     if (!_opts.need_speculate_encoding) {
+        bool is_default_encoding = _opts.meta->encoding() == DEFAULT_ENCODING;
         set_encoding(_opts.meta->encoding());
+        if (is_default_encoding && config::enable_adaptive_page_encoding) {
+            RETURN_IF_ERROR(_init_candidate_encodings());
+        }
     }
     // create ordinal builder
     _ordinal_index_builder = std::make_unique<OrdinalIndexWriter>();
@@ -386,7 +392,8 @@ Status ScalarColumnWriter::init() {
     }
     if (_opts.need_zone_map) {
         _has_index_builder = true;
-        _zone_map_index_builder = ZoneMapIndexWriter::create(get_field());
+        _zone_map_index_builder = ZoneMapIndexWriter::create(get_field(), _opts.sub_page_zone_map_rows,
+                                                             _opts.need_zone_map_sum);
     }
     if (_opts.need_bitmap_index) {
         _has_index_builder = true;
@@ -397,6 +404,12 @@ Status ScalarColumnWriter::init() {
         RETURN_IF_ERROR(BloomFilterIndexWriter::create(BloomFilterOptions(), get_field()->type_info(),
                                                        &_bloom_filter_index_builder));
     }
+    if (_opts.ngram_bloom_filter_gram_size > 0) {
+        _has_index_builder = true;
+        RETURN_IF_ERROR(BloomFilterIndexWriter::create_ngram(BloomFilterOptions(), get_field()->type_info(),
+                                                             _opts.ngram_bloom_filter_gram_size,
+                                                             &_ngram_bloom_filter_index_builder));
+    }
     return Status::OK();
 }
 
@@ -420,11 +433,17 @@ uint64_t ScalarColumnWriter::estimate_buffer_size() {
     if (_bloom_filter_index_builder != nullptr) {
         size += _bloom_filter_index_builder->size();
     }
+    if (_ngram_bloom_filter_index_builder != nullptr) {
+        size += _ngram_bloom_filter_index_builder->size();
+    }
     return size;
 }
 
 Status ScalarColumnWriter::finish() {
     RETURN_IF_ERROR(finish_current_page());
+    if (_training_compression_dict) {
+        RETURN_IF_ERROR(_train_compression_dict());
+    }
     _opts.meta->set_num_rows(_next_rowid);
     return Status::OK();
 }
@@ -489,6 +508,26 @@ inline Status ScalarColumnWriter::set_encoding(const EncodingTypePB& encoding) {
     return Status::OK();
 }
 
+Status ScalarColumnWriter::_init_candidate_encodings() {
+    // Only the fixed-size types, whose default encoding is BIT_SHUFFLE, are encoded adaptively.
+    if (_encoding_info == nullptr || _encoding_info->encoding() != BIT_SHUFFLE) {
+        return Status::OK();
+    }
+    PageBuilderOptions opts;
+    opts.data_page_size = _opts.data_page_size;
+    for (EncodingTypePB encoding : {FOR_ENCODING, DELTA_ENCODING, PLAIN_ENCODING}) {
+        const EncodingInfo* encoding_info = nullptr;
+        if (!EncodingInfo::get(get_field()->type_info()->type(), encoding, &encoding_info).ok()) {
+            continue;
+        }
+        PageBuilder* page_builder = nullptr;
+        RETURN_IF_ERROR(encoding_info->create_page_builder(opts, &page_builder));
+        _candidate_encodings.push_back({encoding_info, std::unique_ptr<PageBuilder>(page_builder)});
+    }
+    _sample_page = !_candidate_encodings.empty();
+    return Status::OK();
+}
+
 Status ScalarColumnWriter::write_ordinal_index() {
     return _ordinal_index_builder->finish(_wblock, _opts.meta->add_indexes());
 }
@@ -509,7 +548,47 @@ Status ScalarColumnWriter::write_bitmap_index() {
 
 Status ScalarColumnWriter::write_bloom_filter_index() {
     if (_bloom_filter_index_builder != nullptr) {
-        return _bloom_filter_index_builder->finish(_wblock, _opts.meta->add_indexes());
+        RETURN_IF_ERROR(_bloom_filter_index_builder->finish(_wblock, _opts.meta->add_indexes()));
+    }
+    if (_ngram_bloom_filter_index_builder != nullptr) {
+        RETURN_IF_ERROR(_ngram_bloom_filter_index_builder->finish(_wblock, _opts.meta->add_indexes()));
+    }
+    return Status::OK();
+}
+
+Status ScalarColumnWriter::_train_compression_dict() {
+    _training_compression_dict = false;
+    std::vector<Slice> samples;
+    for (Page* page = _pages.head; page != nullptr; page = page->next) {
+        samples.emplace_back(page->data[0].slice());
+    }
+    std::string dict;
+    Status st = train_zstd_dictionary(samples, _opts.compression_dict_size, &dict);
+    if (st.ok()) {
+        RETURN_IF_ERROR(create_zstd_dict_codec(dict, _opts.compression_level, &_dict_compress_codec));
+        _compress_codec = _dict_compress_codec.get();
+        _opts.meta->set_compression_dict(std::move(dict));
+    } else {
+        // Usually there are too few pages, compress them without a dictionary.
+        VLOG(2) << "Compress column " << _opts.meta->column_id() << " without dictionary: " << st.to_string();
+    }
+
+    for (Page* page = _pages.head; page != nullptr; page = page->next) {
+        std::vector<Slice> body;
+        for (auto& data : page->data) {
+            if (data.slice().size > 0) {
+                body.emplace_back(data.slice());
+            }
+        }
+        faststring compressed_body;
+        RETURN_IF_ERROR(PageIO::compress_page_body(_compress_codec, _opts.compression_min_space_saving, body,
+                                                   &compressed_body));
+        if (compressed_body.size() > 0) {
+            _data_size -= Slice::compute_total_size(body);
+            _data_size += compressed_body.size();
+            page->data.clear();
+            page->data.emplace_back(compressed_body.build());
+        }
     }
     return Status::OK();
 }
@@ -526,6 +605,57 @@ Status ScalarColumnWriter::_write_data_page(Page* page) {
     return Status::OK();
 }
 
+inline size_t ScalarColumnWriter::_add_to_page(const uint8_t* data, size_t count) {
+    size_t num_added = _page_builder->add(data, count);
+    if (_sample_page) {
+        _page_values.append(data, num_added * get_field()->size());
+    }
+    return num_added;
+}
+
+// The relative cost to decode a value, to prefer the encoding cheaper to decode if the encoded sizes are close.
+// BIT_SHUFFLE has to decompress and transpose the whole page, FOR has to unpack the bits of every frame,
+// and DELTA has to sum up the unpacked deltas as well.
+static double decode_cost(EncodingTypePB encoding) {
+    switch (encoding) {
+    case PLAIN_ENCODING:
+        return 1.0;
+    case FOR_ENCODING:
+        return 1.1;
+    case DELTA_ENCODING:
+        return 1.15;
+    default:
+        return 1.2;
+    }
+}
+
+void ScalarColumnWriter::_choose_page_encoding(faststring** encoded_values) {
+    const size_t count = _page_builder->count();
+    double min_cost = (*encoded_values)->size() * decode_cost(_encoding_info->encoding());
+    CandidateEncoding* best = nullptr;
+    faststring* best_values = nullptr;
+    for (auto& candidate : _candidate_encodings) {
+        candidate.page_builder->reset();
+        // Skip the encoding which can't hold all the values of this page.
+        if (candidate.page_builder->add(_page_values.data(), count) < count) {
+            continue;
+        }
+        faststring* values = candidate.page_builder->finish();
+        double cost = values->size() * decode_cost(candidate.encoding_info->encoding());
+        if (cost < min_cost) {
+            min_cost = cost;
+            best = &candidate;
+            best_values = values;
+        }
+    }
+    if (best != nullptr) {
+        // The current page builder becomes a candidate, it's reset before being tried.
+        std::swap(best->page_builder, _page_builder);
+        std::swap(best->encoding_info, _encoding_info);
+        *encoded_values = best_values;
+    }
+}
+
 Status ScalarColumnWriter::finish_current_page() {
     if (_zone_map_index_builder != nullptr) {
         RETURN_IF_ERROR(_zone_map_index_builder->flush());
@@ -535,9 +665,16 @@ Status ScalarColumnWriter::finish_current_page() {
         RETURN_IF_ERROR(_bloom_filter_index_builder->flush());
     }
 
+    if (_ngram_bloom_filter_index_builder != nullptr) {
+        RETURN_IF_ERROR(_ngram_bloom_filter_index_builder->flush());
+    }
+
     // build data page body : encoded values + [nullmap]
     std::vector<Slice> body;
     faststring* encoded_values = _page_builder->finish();
+    if (_sample_page && _page_builder->count() > 0) {
+        _choose_page_encoding(&encoded_values);
+    }
     body.emplace_back(*encoded_values);
 
     OwnedSlice nullmap;
@@ -572,10 +709,13 @@ Status ScalarColumnWriter::finish_current_page() {
         // for page format v2 or above, use the encoding type of config::null_encoding
         data_page_footer->set_null_encoding(_null_map_builder_v2->null_encoding());
     }
-    // trying to compress page body
+    if (!_candidate_encodings.empty()) {
+        data_page_footer->set_encoding(_encoding_info->encoding());
+    }
+    // trying to compress page body, the pages are compressed after the compression dictionary is trained.
     faststring compressed_body;
-    RETURN_IF_ERROR(
-            PageIO::compress_page_body(_compress_codec, _opts.compression_min_space_saving, body, &compressed_body));
+    const BlockCompressionCodec* codec = _training_compression_dict ? nullptr : _compress_codec;
+    RETURN_IF_ERROR(PageIO::compress_page_body(codec, _opts.compression_min_space_saving, body, &compressed_body));
     if (compressed_body.size() == 0) {
         // page body is uncompressed
         page->data.emplace_back(encoded_values->build());
@@ -589,6 +729,13 @@ Status ScalarColumnWriter::finish_current_page() {
     }
 
     _push_back_page(page.release());
+    if (_training_compression_dict) {
+        _compression_dict_samples_size += Slice::compute_total_size(body);
+        // ZSTD suggests the samples to be about 100 times the size of the dictionary.
+        if (_compression_dict_samples_size >= 100 * _opts.compression_dict_size) {
+            RETURN_IF_ERROR(_train_compression_dict());
+        }
+    }
 
     if (is_nullable() && _opts.adaptive_page_format) {
         size_t num_data = (_curr_page_format == 1) ? _page_builder->count() : _null_map_builder_v2->data_count();
@@ -603,6 +750,10 @@ Status ScalarColumnWriter::finish_current_page() {
     }
     _page_builder->reset();
     _first_rowid = _next_rowid;
+    if (!_candidate_encodings.empty()) {
+        _page_values.clear();
+        _sample_page = ++_num_pages % std::max(config::adaptive_page_encoding_sample_interval, 1) == 0;
+    }
 
     return Status::OK();
 }
@@ -636,7 +787,7 @@ Status ScalarColumnWriter::append_array_offsets(const vectorized::Column& column
     while (remaining > 0) {
         bool page_full = false;
         size_t num_written = 0;
-        num_written = _page_builder->add(raw_data, remaining);
+        num_written = _add_to_page(raw_data, remaining);
         page_full = num_written < remaining;
 
         _next_rowid += num_written;
@@ -660,7 +811,7 @@ Status ScalarColumnWriter::append_array_offsets(const uint8_t* data, const uint8
     while (remaining > 0) {
         bool page_full = false;
         size_t num_written = 0;
-        num_written = _page_builder->add(data, remaining);
+        num_written = _add_to_page(data, remaining);
         page_full = num_written < remaining;
         _next_rowid += num_written;
         if (page_full) {
@@ -686,7 +837,7 @@ Status ScalarColumnWriter::append(const uint8_t* data, const uint8_t* null_flags
         bool has_null_in_page = false;
         size_t num_written = 0;
         if (_curr_page_format == 2) {
-            num_written = _page_builder->add(data, remaining);
+            num_written = _add_to_page(data, remaining);
             page_full = num_written < remaining;
             if (_null_map_builder_v2 != nullptr) {
                 _null_map_builder_v2->add_null_flags(null_flags, num_written);
@@ -697,7 +848,7 @@ Status ScalarColumnWriter::append(const uint8_t* data, const uint8_t* null_flags
                 _null_map_builder_v2->set_has_null(has_null_in_page);
             }
         } else if (!has_null) {
-            num_written = _page_builder->add(data, remaining);
+            num_written = _add_to_page(data, remaining);
             page_full = num_written < remaining;
             if (_null_map_builder_v1 != nullptr) {
                 _null_map_builder_v1->add_run(false, num_written);
@@ -709,7 +860,7 @@ Status ScalarColumnWriter::append(const uint8_t* data, const uint8_t* null_flags
                 auto [run, is_null] = pair;
                 size_t num_add = run;
                 if (!is_null) {
-                    num_add = _page_builder->add(ptr, run);
+                    num_add = _add_to_page(ptr, run);
                     _null_map_builder_v1->add_run(false, run);
                 } else {
                     _null_map_builder_v1->add_run(true, run);
@@ -730,10 +881,12 @@ Status ScalarColumnWriter::append(const uint8_t* data, const uint8_t* null_flags
                     INDEX_ADD_NULLS(_zone_map_index_builder, run);
                     INDEX_ADD_NULLS(_bitmap_index_builder, run);
                     INDEX_ADD_NULLS(_bloom_filter_index_builder, run);
+                    INDEX_ADD_NULLS(_ngram_bloom_filter_index_builder, run);
                 } else {
                     INDEX_ADD_VALUES(_zone_map_index_builder, pdata, run);
                     INDEX_ADD_VALUES(_bitmap_index_builder, pdata, run);
                     INDEX_ADD_VALUES(_bloom_filter_index_builder, pdata, run);
+                    INDEX_ADD_VALUES(_ngram_bloom_filter_index_builder, pdata, run);
                 }
                 pdata += get_field()->size() * run;
             }
@@ -741,6 +894,7 @@ Status ScalarColumnWriter::append(const uint8_t* data, const uint8_t* null_flags
             INDEX_ADD_VALUES(_zone_map_index_builder, data, num_written);
             INDEX_ADD_VALUES(_bitmap_index_builder, data, num_written);
             INDEX_ADD_VALUES(_bloom_filter_index_builder, data, num_written);
+            INDEX_ADD_VALUES(_ngram_bloom_filter_index_builder, data, num_written);
         }
 
         _next_rowid += num_written;
@@ -61,9 +61,19 @@ struct ColumnWriterOptions {
     // store compressed page only when space saving is above the threshold.
     // space saving = 1 - compressed_size / uncompressed_size
     double compression_min_space_saving = 0.1;
+    // the level of ZSTD compression, 0 for the default level.
+    int compression_level = 0;
+    // train a ZSTD dictionary of at most this size from the first pages if compression is ZSTD and it's not 0.
+    size_t compression_dict_size = 0;
     bool need_zone_map = false;
+    // write the zone map for every |sub_page_zone_map_rows| rows of the data pages if not 0.
+    uint32_t sub_page_zone_map_rows = 0;
+    // keep the sum of the not-null values in the page and segment zone maps of the numeric columns.
+    bool need_zone_map_sum = false;
     bool need_bitmap_index = false;
     bool need_bloom_filter = false;
+    // write the n-gram bloom filter index of the substrings of this size for CHAR/VARCHAR if not 0.
+    uint32_t ngram_bloom_filter_gram_size = 0;
     bool adaptive_page_format = false;
     // for char/varchar will speculate encoding in append
     // for others will decide encoding in init method
@@ -217,6 +227,19 @@ private:
 
     Status _write_data_page(Page* page);
 
+    // Add the values into the current page, and keep a copy of them if the page is sampled.
+    size_t _add_to_page(const uint8_t* data, size_t count);
+
+    Status _init_candidate_encodings();
+
+    // Train the compression dictionary from the uncompressed pages written so far, and compress them and the
+    // following pages with it.
+    Status _train_compression_dict();
+
+    // Encode the values of the sampled page with all the candidate encodings, and switch to the cheapest one
+    // for this page and the following pages.
+    void _choose_page_encoding(faststring** encoded_values);
+
     ColumnWriterOptions _opts;
     fs::WritableBlock* _wblock;
     uint32_t _curr_page_format;
@@ -229,10 +252,26 @@ private:
     ordinal_t _next_rowid = 0;
 
     const BlockCompressionCodec* _compress_codec = nullptr;
+    // The pages are left uncompressed until the dictionary is trained.
+    bool _training_compression_dict = false;
+    size_t _compression_dict_samples_size = 0;
+    std::unique_ptr<BlockCompressionCodec> _dict_compress_codec;
     const EncodingInfo* _encoding_info = nullptr;
 
     std::unique_ptr<PageBuilder> _page_builder;
 
+    // The encodings other than the current one tried on the sampled pages,
+    // only present if config::enable_adaptive_page_encoding is true.
+    struct CandidateEncoding {
+        const EncodingInfo* encoding_info;
+        std::unique_ptr<PageBuilder> page_builder;
+    };
+    std::vector<CandidateEncoding> _candidate_encodings;
+    bool _sample_page = false;
+    // The values added into the current page if it's sampled.
+    faststring _page_values;
+    uint64_t _num_pages = 0;
+
     // Used when _opts.page_format == 1, using Run-Length encoding to build the null map.
     std::unique_ptr<NullMapRLEBuilder> _null_map_builder_v1;
 
@@ -244,6 +283,7 @@ private:
     std::unique_ptr<ZoneMapIndexWriter> _zone_map_index_builder;
     std::unique_ptr<BitmapIndexWriter> _bitmap_index_builder;
     std::unique_ptr<BloomFilterIndexWriter> _bloom_filter_index_builder;
+    std::unique_ptr<BloomFilterIndexWriter> _ngram_bloom_filter_index_builder;
     // _zone_map_index_builder != NULL || _bitmap_index_builder != NULL || _bloom_filter_index_builder != NULL
     bool _has_index_builder = false;
     int64_t _element_ordinal = 0;
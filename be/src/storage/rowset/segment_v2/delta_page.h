@@ -0,0 +1,258 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "column/column.h"
+#include "gutil/strings/substitute.h"
+#include "simd/prefix_sum.h"
+#include "storage/rowset/segment_v2/options.h"      // for PageBuilderOptions/PageDecoderOptions
+#include "storage/rowset/segment_v2/page_builder.h" // for PageBuilder
+#include "storage/rowset/segment_v2/page_decoder.h" // for PageDecoder
+#include "storage/types.h"
+#include "util/coding.h"
+#include "util/faststring.h"
+#include "util/frame_of_reference_coding.h"
+#include "util/raw_container.h"
+
+namespace starrocks::segment_v2 {
+
+// Delta encoding for the sorted or nearly sorted integers, such as the auto increment ids and the event
+// timestamps. The differences of the adjacent values (order 1), or the differences of the adjacent
+// differences (order 2, for the values increasing in a steady step), are much narrower than the values,
+// and bit packed by ForEncoder. The order with the smaller encoded size is chosen for every page.
+//
+// The encoded data format is as follows:
+//
+//      8 bit Order
+//     32 bit ValuesNum
+//      FirstValue, the first value if ValuesNum > 0
+//      FirstDelta, the difference of the first two values if Order is 2 and ValuesNum > 1
+//      ForEncoder encoded deltas of the remaining values
+//
+// len(FirstValue) and len(FirstDelta) are the size of the type. The differences wrap around on overflow.
+template <FieldType Type>
+class DeltaPageBuilder final : public PageBuilder {
+public:
+    explicit DeltaPageBuilder(const PageBuilderOptions& options)
+            : _max_count(std::max<size_t>(1, options.data_page_size / sizeof(CppType))),
+              _delta_encoder(&_delta_buf),
+              _dod_encoder(&_dod_buf) {}
+
+    ~DeltaPageBuilder() override = default;
+
+    bool is_page_full() override { return _values.size() >= _max_count; }
+
+    size_t add(const uint8_t* vals, size_t count) override {
+        DCHECK(!_finished);
+        count = std::min(count, _max_count - std::min(_max_count, _values.size()));
+        auto new_vals = reinterpret_cast<const CppType*>(vals);
+        _values.insert(_values.end(), new_vals, new_vals + count);
+        return count;
+    }
+
+    faststring* finish() override {
+        DCHECK(!_finished);
+        _finished = true;
+        const size_t n = _values.size();
+        raw::make_room(&_deltas, n);
+        for (size_t i = 1; i < n; i++) {
+            _deltas[i] = subtract(_values[i], _values[i - 1]);
+        }
+        encode(&_delta_encoder, _deltas, 1, n);
+        uint8_t order = 1;
+        if (n > 2) {
+            for (size_t i = n - 1; i > 1; i--) {
+                _deltas[i] = subtract(_deltas[i], _deltas[i - 1]);
+            }
+            encode(&_dod_encoder, _deltas, 2, n);
+            // The first delta is stored in the header instead.
+            if (_dod_buf.size() + sizeof(CppType) < _delta_buf.size()) {
+                order = 2;
+            }
+        }
+
+        _buf.clear();
+        _buf.reserve(kHeaderSize + std::max(_delta_buf.size(), _dod_buf.size()));
+        _buf.push_back(order);
+        put_fixed32_le(&_buf, static_cast<uint32_t>(n));
+        if (n > 0) {
+            _buf.append(&_values[0], sizeof(CppType));
+        }
+        if (order == 2) {
+            CppType first_delta = subtract(_values[1], _values[0]);
+            _buf.append(&first_delta, sizeof(CppType));
+            _buf.append(_dod_buf.data(), _dod_buf.size());
+        } else {
+            _buf.append(_delta_buf.data(), _delta_buf.size());
+        }
+        return &_buf;
+    }
+
+    void reset() override {
+        _values.clear();
+        _finished = false;
+    }
+
+    size_t count() const override { return _values.size(); }
+
+    uint64_t size() const override { return _finished ? _buf.size() : _values.size() * sizeof(CppType); }
+
+    Status get_first_value(void* value) const override {
+        if (_values.empty()) {
+            return Status::NotFound("page is empty");
+        }
+        memcpy(value, &_values.front(), sizeof(CppType));
+        return Status::OK();
+    }
+
+    Status get_last_value(void* value) const override {
+        if (_values.empty()) {
+            return Status::NotFound("page is empty");
+        }
+        memcpy(value, &_values.back(), sizeof(CppType));
+        return Status::OK();
+    }
+
+private:
+    using CppType = typename CppTypeTraits<Type>::CppType;
+    using UnsignedCppType = typename CppTypeTraits<Type>::UnsignedCppType;
+
+    static constexpr size_t kHeaderSize = 1 + 4 + 2 * sizeof(CppType);
+
+    static CppType subtract(CppType lhs, CppType rhs) {
+        return static_cast<CppType>(static_cast<UnsignedCppType>(lhs) - static_cast<UnsignedCppType>(rhs));
+    }
+
+    // Encode values[from, to).
+    static void encode(ForEncoder<CppType>* encoder, const std::vector<CppType>& values, size_t from, size_t to) {
+        encoder->clear();
+        if (from < to) {
+            encoder->put_batch(values.data() + from, to - from);
+        }
+        encoder->flush();
+    }
+
+    const size_t _max_count;
+    bool _finished = false;
+    std::vector<CppType> _values;
+    std::vector<CppType> _deltas;
+    faststring _delta_buf;
+    faststring _dod_buf;
+    ForEncoder<CppType> _delta_encoder;
+    ForEncoder<CppType> _dod_encoder;
+    faststring _buf;
+};
+
+// The whole page is decoded in init(), the deltas are summed up by SIMD::prefix_sum().
+template <FieldType Type>
+class DeltaPageDecoder final : public PageDecoder {
+public:
+    DeltaPageDecoder(Slice data, const PageDecoderOptions& options) : _data(data) {}
+
+    ~DeltaPageDecoder() override = default;
+
+    Status init() override {
+        CHECK(!_parsed);
+        if (_data.size < kHeaderSize) {
+            return Status::Corruption("The delta page is too small");
+        }
+        const auto* ptr = reinterpret_cast<const uint8_t*>(_data.data);
+        const uint8_t order = ptr[0];
+        const size_t n = decode_fixed32_le(ptr + 1);
+        if (order != 1 && order != 2) {
+            return Status::Corruption(strings::Substitute("Unknown delta order $0", order));
+        }
+        const size_t header_size = kHeaderSize + (n > 0 ? sizeof(CppType) : 0) + (order == 2 ? sizeof(CppType) : 0);
+        if (_data.size < header_size) {
+            return Status::Corruption("The delta page is too small");
+        }
+        ptr += kHeaderSize;
+        CppType first_value = 0;
+        CppType first_delta = 0;
+        if (n > 0) {
+            memcpy(&first_value, ptr, sizeof(CppType));
+            ptr += sizeof(CppType);
+        }
+        if (order == 2) {
+            memcpy(&first_delta, ptr, sizeof(CppType));
+            ptr += sizeof(CppType);
+        }
+        const size_t num_encoded = n > order ? n - order : 0;
+        ForDecoder<CppType> decoder(ptr, reinterpret_cast<const uint8_t*>(_data.data) + _data.size - ptr);
+        if (!decoder.init() || decoder.count() != num_encoded) {
+            return Status::Corruption("The delta page metadata maybe broken");
+        }
+
+        raw::make_room(&_values, n);
+        if (num_encoded > 0 && !decoder.get_batch(_values.data() + n - num_encoded, num_encoded)) {
+            return Status::Corruption("The delta page data maybe broken");
+        }
+        if (order == 2 && n > 1) {
+            _values[1] = first_delta;
+            SIMD::prefix_sum(_values.data() + 2, n - 2, first_delta);
+        }
+        if (n > 0) {
+            _values[0] = first_value;
+            SIMD::prefix_sum(_values.data() + 1, n - 1, first_value);
+        }
+        _parsed = true;
+        return Status::OK();
+    }
+
+    Status seek_to_position_in_page(size_t pos) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        DCHECK_LE(pos, _values.size()) << "Tried to seek to " << pos << " which is > number of elements ("
+                                       << _values.size() << ") in the block!";
+        _cur_index = pos;
+        return Status::OK();
+    }
+
+    Status next_batch(size_t* n, ColumnBlockView* dst) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        if (PREDICT_FALSE(*n == 0 || _cur_index >= _values.size())) {
+            *n = 0;
+            return Status::OK();
+        }
+        size_t to_fetch = std::min(*n, _values.size() - _cur_index);
+        memcpy(dst->data(), &_values[_cur_index], to_fetch * sizeof(CppType));
+        _cur_index += to_fetch;
+        *n = to_fetch;
+        return Status::OK();
+    }
+
+    Status next_batch(size_t* n, vectorized::Column* dst) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        if (PREDICT_FALSE(*n == 0 || _cur_index >= _values.size())) {
+            *n = 0;
+            return Status::OK();
+        }
+        size_t to_fetch = std::min(*n, _values.size() - _cur_index);
+        int r = dst->append_numbers(&_values[_cur_index], to_fetch * sizeof(CppType));
+        DCHECK_EQ(to_fetch, r);
+        _cur_index += to_fetch;
+        *n = to_fetch;
+        return Status::OK();
+    }
+
+    size_t count() const override { return _values.size(); }
+
+    size_t current_index() const override { return _cur_index; }
+
+    EncodingTypePB encoding_type() const override { return DELTA_ENCODING; }
+
+private:
+    using CppType = typename CppTypeTraits<Type>::CppType;
+
+    static constexpr size_t kHeaderSize = 1 + 4;
+
+    Slice _data;
+    bool _parsed = false;
+    size_t _cur_index = 0;
+    std::vector<CppType> _values;
+};
+
+} // namespace starrocks::segment_v2
@@ -29,6 +29,7 @@
 #include "storage/rowset/segment_v2/binary_plain_page.h"
 #include "storage/rowset/segment_v2/binary_prefix_page.h"
 #include "storage/rowset/segment_v2/bitshuffle_page.h"
+#include "storage/rowset/segment_v2/delta_page.h"
 #include "storage/rowset/segment_v2/frame_of_reference_page.h"
 #include "storage/rowset/segment_v2/plain_page.h"
 #include "storage/rowset/segment_v2/rle_page.h"
@@ -130,6 +131,20 @@ struct TypeEncodingTraits<type, FOR_ENCODING, CppType,
     }
 };
 
+template <FieldType type, typename CppType>
+struct TypeEncodingTraits<
+        type, DELTA_ENCODING, CppType,
+        typename std::enable_if<std::is_same<CppType, int32_t>::value || std::is_same<CppType, int64_t>::value>::type> {
+    static Status create_page_builder(const PageBuilderOptions& opts, PageBuilder** builder) {
+        *builder = new DeltaPageBuilder<type>(opts);
+        return Status::OK();
+    }
+    static Status create_page_decoder(const Slice& data, const PageDecoderOptions& opts, PageDecoder** decoder) {
+        *decoder = new DeltaPageDecoder<type>(data, opts);
+        return Status::OK();
+    }
+};
+
 template <FieldType type>
 struct TypeEncodingTraits<type, PREFIX_ENCODING, Slice> {
     static Status create_page_builder(const PageBuilderOptions& opts, PageBuilder** builder) {
@@ -205,10 +220,12 @@ EncodingInfoResolver::EncodingInfoResolver() {
     _add_map<OLAP_FIELD_TYPE_INT, BIT_SHUFFLE>();
     _add_map<OLAP_FIELD_TYPE_INT, FOR_ENCODING, true>();
     _add_map<OLAP_FIELD_TYPE_INT, PLAIN_ENCODING>();
+    _add_map<OLAP_FIELD_TYPE_INT, DELTA_ENCODING>();
 
     _add_map<OLAP_FIELD_TYPE_BIGINT, BIT_SHUFFLE>();
     _add_map<OLAP_FIELD_TYPE_BIGINT, FOR_ENCODING, true>();
     _add_map<OLAP_FIELD_TYPE_BIGINT, PLAIN_ENCODING>();
+    _add_map<OLAP_FIELD_TYPE_BIGINT, DELTA_ENCODING>();
 
     _add_map<OLAP_FIELD_TYPE_LARGEINT, BIT_SHUFFLE>();
     _add_map<OLAP_FIELD_TYPE_LARGEINT, PLAIN_ENCODING>();
@@ -244,10 +261,12 @@ EncodingInfoResolver::EncodingInfoResolver() {
     _add_map<OLAP_FIELD_TYPE_DATETIME, BIT_SHUFFLE>();
     _add_map<OLAP_FIELD_TYPE_DATETIME, PLAIN_ENCODING>();
     _add_map<OLAP_FIELD_TYPE_DATETIME, FOR_ENCODING, true>();
+    _add_map<OLAP_FIELD_TYPE_DATETIME, DELTA_ENCODING>();
 
     _add_map<OLAP_FIELD_TYPE_TIMESTAMP, BIT_SHUFFLE>();
     _add_map<OLAP_FIELD_TYPE_TIMESTAMP, PLAIN_ENCODING>();
     _add_map<OLAP_FIELD_TYPE_TIMESTAMP, FOR_ENCODING, true>();
+    _add_map<OLAP_FIELD_TYPE_TIMESTAMP, DELTA_ENCODING>();
 
     _add_map<OLAP_FIELD_TYPE_DECIMAL, BIT_SHUFFLE>();
     _add_map<OLAP_FIELD_TYPE_DECIMAL, PLAIN_ENCODING>();
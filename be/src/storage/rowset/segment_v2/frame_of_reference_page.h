@@ -25,6 +25,7 @@
 #include "storage/rowset/segment_v2/options.h"      // for PageBuilderOptions/PageDecoderOptions
 #include "storage/rowset/segment_v2/page_builder.h" // for PageBuilder
 #include "storage/rowset/segment_v2/page_decoder.h" // for PageDecoder
+#include "storage/vectorized/column_predicate.h"
 #include "util/frame_of_reference_coding.h"
 
 namespace starrocks {
@@ -50,10 +51,19 @@ public:
         if (_count == 0) {
             _first_val = *new_vals;
         }
-        _encoder.put_batch(new_vals, count);
-        _count += count;
-        _last_val = new_vals[count - 1];
-        return count;
+        // Add the values frame by frame to stop once the page is full.
+        size_t num_added = 0;
+        while (num_added < count && !is_page_full()) {
+            size_t n = std::min<size_t>(count - num_added, kFrameSize);
+            _encoder.put_batch(new_vals + num_added, n);
+            num_added += n;
+        }
+        if (num_added == 0) {
+            return 0;
+        }
+        _count += num_added;
+        _last_val = new_vals[num_added - 1];
+        return num_added;
     }
 
     faststring* finish() override {
@@ -91,6 +101,9 @@ public:
 
 private:
     typedef typename TypeTraits<Type>::CppType CppType;
+    // The number of values in a frame of ForEncoder.
+    static constexpr size_t kFrameSize = 128;
+
     PageBuilderOptions _options;
     size_t _count;
     bool _finished;
@@ -198,6 +211,49 @@ public:
         return Status::OK();
     }
 
+    // the frame bounds are compared with the predicates in Datum, so only the integer types whose Datum type
+    // is the same as the storage type are supported.
+    bool support_encoded_evaluation() const override {
+        return Type == OLAP_FIELD_TYPE_TINYINT || Type == OLAP_FIELD_TYPE_SMALLINT || Type == OLAP_FIELD_TYPE_INT ||
+               Type == OLAP_FIELD_TYPE_BIGINT;
+    }
+
+    // skip decoding the frames none of whose values can satisfy |pred| by the frame bounds.
+    Status next_batch_and_evaluate(size_t* n, vectorized::Column* dst, const vectorized::ColumnPredicate* pred,
+                                   uint8_t* selection) override {
+        DCHECK(_parsed) << "Must call init() firstly";
+        DCHECK(support_encoded_evaluation());
+        DCHECK(!dst->is_nullable());
+        if (PREDICT_FALSE(*n == 0 || _cur_index >= _num_elements)) {
+            *n = 0;
+            return Status::OK();
+        }
+        *n = std::min(*n, _num_elements - _cur_index);
+        const size_t from = dst->size();
+        dst->resize(from + *n);
+        auto* values = reinterpret_cast<CppType*>(dst->mutable_raw_data()) + from;
+        size_t pos = 0;
+        while (pos < *n) {
+            size_t len = std::min<size_t>(*n - pos, _decoder.current_frame_remaining());
+            CppType min;
+            CppType max;
+            if (_decoder.current_frame_bounds(&min, &max) &&
+                !pred->zone_map_filter(vectorized::ZoneMapDetail(vectorized::Datum(min), vectorized::Datum(max)))) {
+                // the values are left as zeros, which are filtered out.
+                memset(selection + from + pos, 0, len);
+                bool r = _decoder.skip(static_cast<int32_t>(len));
+                DCHECK(r);
+            } else {
+                bool r = _decoder.get_batch(values + pos, len);
+                DCHECK(r);
+                pred->evaluate(dst, selection, from + pos, from + pos + len);
+            }
+            pos += len;
+        }
+        _cur_index += *n;
+        return Status::OK();
+    }
+
     size_t count() const override { return _num_elements; }
 
     size_t current_index() const override { return _cur_index; }
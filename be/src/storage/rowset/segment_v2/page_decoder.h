@@ -28,7 +28,8 @@
 
 namespace starrocks::vectorized {
 class Column;
-}
+class ColumnPredicate;
+} // namespace starrocks::vectorized
 
 namespace starrocks {
 namespace segment_v2 {
@@ -114,6 +115,20 @@ public:
 
     virtual const PageDecoder* dict_page_decoder() const { return nullptr; }
 
+    // Whether `next_batch_and_evaluate` is supported.
+    virtual bool support_encoded_evaluation() const { return false; }
+
+    // Reads the next |*n| values like `next_batch`, and evaluates |pred| on them into |selection|, which is
+    // indexed by the row of |column|, i.e. the results are in [column->size(), column->size() + *n) of
+    // |selection| where the size is the one before the call.
+    // The predicate is evaluated on the encoded values, e.g. once for a run of the same value, and the values
+    // of the unselected rows may be not decoded, which are arbitrary values in |column|.
+    // |column| must not be nullable.
+    virtual Status next_batch_and_evaluate(size_t* n, vectorized::Column* column,
+                                           const vectorized::ColumnPredicate* pred, uint8_t* selection) {
+        return Status::NotSupported("next_batch_and_evaluate() not supported");
+    }
+
 private:
     PageDecoder(const PageDecoder&) = delete;
     const PageDecoder& operator=(const PageDecoder&) = delete;
@@ -113,14 +113,20 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
                                         PageFooterPB* footer) {
     opts.sanity_check();
     opts.stats->total_pages_num++;
+    if (opts.column_stats != nullptr) {
+        opts.column_stats->pages_read++;
+    }
 
     auto cache = StoragePageCache::instance();
     PageCacheHandle cache_handle;
     StoragePageCache::CacheKey cache_key(opts.rblock->path(), opts.page_pointer.offset);
-    if (opts.use_page_cache && cache->lookup(cache_key, &cache_handle)) {
+    if (opts.use_page_cache && cache->lookup(cache_key, &cache_handle, opts.data_page)) {
         // we find page in cache, use it
         *handle = PageHandle(std::move(cache_handle));
         opts.stats->cached_pages_num++;
+        if (opts.column_stats != nullptr) {
+            opts.column_stats->cached_pages++;
+        }
         // parse body and footer
         Slice page_slice = handle->data();
         uint32_t footer_size = decode_fixed32_le((uint8_t*)page_slice.data + page_slice.size - 4);
@@ -142,10 +148,16 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
     // Allocate APPEND_OVERFLOW_MAX_SIZE more bytes to make append_strings_overflow work
     std::unique_ptr<char[]> page(new char[page_size + vectorized::Column::APPEND_OVERFLOW_MAX_SIZE]);
     Slice page_slice(page.get(), page_size);
+    int64_t io_ns = 0;
     {
-        SCOPED_RAW_TIMER(&opts.stats->io_ns);
+        SCOPED_RAW_TIMER(&io_ns);
         RETURN_IF_ERROR(opts.rblock->read(opts.page_pointer.offset, page_slice));
-        opts.stats->compressed_bytes_read += page_size;
+    }
+    opts.stats->io_ns += io_ns;
+    opts.stats->compressed_bytes_read += page_size;
+    if (opts.column_stats != nullptr) {
+        opts.column_stats->io_ns += io_ns;
+        opts.column_stats->compressed_bytes_read += page_size;
     }
 
     if (opts.verify_checksum) {
@@ -170,7 +182,8 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
         if (opts.codec == nullptr) {
             return Status::Corruption("Bad page: page is compressed but codec is NO_COMPRESSION");
         }
-        SCOPED_RAW_TIMER(&opts.stats->decompress_ns);
+        MonotonicStopWatch watch;
+        watch.start();
         // Allocate APPEND_OVERFLOW_MAX_SIZE more bytes to make append_strings_overflow work
         std::unique_ptr<char[]> decompressed_page(
                 new char[footer->uncompressed_size() + footer_size + 4 + vectorized::Column::APPEND_OVERFLOW_MAX_SIZE]);
@@ -189,15 +202,24 @@ Status PageIO::read_and_decompress_page(const PageReadOptions& opts, PageHandle*
         // free memory of compressed page
         page = std::move(decompressed_page);
         page_slice = Slice(page.get(), footer->uncompressed_size() + footer_size + 4);
+        const int64_t decompress_ns = watch.elapsed_time();
+        opts.stats->decompress_ns += decompress_ns;
         opts.stats->uncompressed_bytes_read += page_slice.size;
+        if (opts.column_stats != nullptr) {
+            opts.column_stats->decompress_ns += decompress_ns;
+            opts.column_stats->uncompressed_bytes_read += page_slice.size;
+        }
     } else {
         opts.stats->uncompressed_bytes_read += body_size;
+        if (opts.column_stats != nullptr) {
+            opts.column_stats->uncompressed_bytes_read += body_size;
+        }
     }
 
     *body = Slice(page_slice.data, page_slice.size - 4 - footer_size);
-    if (opts.use_page_cache) {
+    if (opts.use_page_cache && opts.fill_page_cache &&
+        cache->insert(cache_key, page_slice, &cache_handle, opts.kept_in_memory, opts.data_page)) {
         // insert this page into cache and return the cache handle
-        cache->insert(cache_key, page_slice, &cache_handle, opts.kept_in_memory);
         *handle = PageHandle(std::move(cache_handle));
     } else {
         *handle = PageHandle(page_slice);
@@ -51,6 +51,8 @@ struct PageReadOptions {
     const BlockCompressionCodec* codec = nullptr;
     // used to collect IO metrics
     OlapReaderStatistics* stats = nullptr;
+    // used to collect IO metrics of the column the page belongs to, null if not collected.
+    ColumnReadStatistics* column_stats = nullptr;
     // whether to verify page checksum
     bool verify_checksum = true;
     // whether to use page cache in read path
@@ -58,6 +60,10 @@ struct PageReadOptions {
     // if true, use DURABLE CachePriority in page cache
     // currently used for in memory olap table
     bool kept_in_memory = false;
+    // whether it's a data page or a dict page of a column, which is cached apart from the index pages
+    bool data_page = false;
+    // whether to insert the page into page cache if it's missed, the full scans needn't
+    bool fill_page_cache = true;
 
     void sanity_check() const {
         CHECK_NOTNULL(rblock);
@@ -34,11 +34,29 @@
 #include "storage/rowset/segment_v2/encoding_info.h"
 #include "storage/rowset/segment_v2/options.h"
 #include "storage/rowset/segment_v2/page_handle.h"
+#include "storage/vectorized/column_predicate.h"
 #include "util/block_compression.h"
 #include "util/rle_encoding.h"
 
 namespace starrocks::segment_v2 {
 
+Status ParsedPage::read_and_evaluate(vectorized::Column* column, size_t* count,
+                                     const vectorized::ColumnPredicate* pred, uint8_t* selection) {
+    const size_t from = column->size();
+    if (has_null() || column->is_nullable() || !_data_decoder->support_encoded_evaluation()) {
+        RETURN_IF_ERROR(read(column, count));
+        pred->evaluate(column, selection, from, from + *count);
+        return Status::OK();
+    }
+    DCHECK_EQ(_offset_in_page, _data_decoder->current_index());
+    *count = std::min(*count, remaining());
+    size_t nrows_to_read = *count;
+    RETURN_IF_ERROR(_data_decoder->next_batch_and_evaluate(&nrows_to_read, column, pred, selection));
+    DCHECK_EQ(nrows_to_read, *count);
+    _offset_in_page += nrows_to_read;
+    return Status::OK();
+}
+
 namespace {
 class ByteIterator {
 public:
@@ -184,6 +202,8 @@ public:
         return Status::OK();
     }
 
+    bool has_null() const override { return _has_null; }
+
 private:
     friend Status parse_page_v1(std::unique_ptr<ParsedPage>* result, PageHandle handle, const Slice& body,
                                 const DataPageFooterPB& footer, const EncodingInfo* encoding,
@@ -251,6 +271,8 @@ public:
         return Status::OK();
     }
 
+    bool has_null() const override { return _null_flags.size() > 0; }
+
 private:
     friend Status parse_page_v2(std::unique_ptr<ParsedPage>* result, PageHandle handle, const Slice& body,
                                 const DataPageFooterPB& footer, const EncodingInfo* encoding,
@@ -353,6 +375,10 @@ Status parse_page_v2(std::unique_ptr<ParsedPage>* result, PageHandle handle, con
 Status parse_page(std::unique_ptr<ParsedPage>* result, PageHandle handle, const Slice& body,
                   const DataPageFooterPB& footer, const EncodingInfo* encoding, const PagePointer& page_pointer,
                   uint32_t page_index) {
+    if (footer.has_encoding() && footer.encoding() != encoding->encoding()) {
+        // The encoding of this page is chosen adaptively, see ScalarColumnWriter::_choose_page_encoding().
+        RETURN_IF_ERROR(EncodingInfo::get(encoding->type(), footer.encoding(), &encoding));
+    }
     uint32_t version = footer.has_format_version() ? footer.format_version() : 1;
     if (version == 1) {
         return parse_page_v1(result, std::move(handle), body, footer, encoding, page_pointer, page_index);
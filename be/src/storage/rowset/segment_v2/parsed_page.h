@@ -34,7 +34,8 @@ class Status;
 
 namespace vectorized {
 class Column;
-}
+class ColumnPredicate;
+} // namespace vectorized
 
 namespace segment_v2 {
 
@@ -106,6 +107,15 @@ public:
     // On error, the value of |*count| is undefined.
     virtual Status read_dict_codes(vectorized::Column* column, size_t* count) = 0;
 
+    // Attempts to read up to |*count| records like `read`, and evaluates |pred| on them into |selection|,
+    // which is indexed by the row of |column|. The predicate is evaluated on the encoded values if the page
+    // has no null and the decoder supports it, the values of the unselected records may be not decoded then.
+    Status read_and_evaluate(vectorized::Column* column, size_t* count, const vectorized::ColumnPredicate* pred,
+                             uint8_t* selection);
+
+    // Whether there is any null in the page.
+    virtual bool has_null() const = 0;
+
 protected:
     uint32_t _page_index{0};
     uint64_t _num_rows{0};
@@ -25,6 +25,7 @@
 #include "storage/rowset/segment_v2/options.h"
 #include "storage/rowset/segment_v2/page_builder.h"
 #include "storage/rowset/segment_v2/page_decoder.h"
+#include "storage/vectorized/column_predicate.h"
 #include "util/coding.h"
 #include "util/rle_encoding.h"
 #include "util/slice.h"
@@ -231,6 +232,48 @@ public:
         return Status::OK();
     }
 
+    bool support_encoded_evaluation() const override { return true; }
+
+    Status next_batch_and_evaluate(size_t* n, vectorized::Column* dst, const vectorized::ColumnPredicate* pred,
+                                   uint8_t* selection) override {
+        DCHECK(_parsed);
+        DCHECK(!dst->is_nullable());
+        if (PREDICT_FALSE(_cur_index >= _num_elements)) {
+            *n = 0;
+            return Status::OK();
+        }
+        *n = std::min(*n, static_cast<size_t>(_num_elements - _cur_index));
+        const size_t from = dst->size();
+        dst->resize_uninitialized(from + *n);
+        auto* values = reinterpret_cast<CppType*>(dst->mutable_raw_data()) + from;
+        // the short runs are evaluated together, the rows [pending, pos) are not evaluated yet.
+        size_t pending = 0;
+        size_t pos = 0;
+        while (pos < *n) {
+            CppType value{};
+            size_t run = _rle_decoder.GetNextRun(&value, *n - pos);
+            if (PREDICT_FALSE(run == 0)) {
+                return Status::Corruption("RLE decode failed");
+            }
+            std::fill(values + pos, values + pos + run, value);
+            if (run >= kMinEvaluatedRun) {
+                if (pending < pos) {
+                    pred->evaluate(dst, selection, from + pending, from + pos);
+                }
+                // evaluate the first value of the run only.
+                pred->evaluate(dst, selection, from + pos, from + pos + 1);
+                memset(selection + from + pos + 1, selection[from + pos], run - 1);
+                pending = pos + run;
+            }
+            pos += run;
+        }
+        if (pending < pos) {
+            pred->evaluate(dst, selection, from + pending, from + pos);
+        }
+        _cur_index += *n;
+        return Status::OK();
+    }
+
     size_t count() const override { return _num_elements; }
 
     size_t current_index() const override { return _cur_index; }
@@ -240,6 +283,8 @@ public:
 private:
     typedef typename TypeTraits<Type>::CppType CppType;
     enum { SIZE_OF_TYPE = TypeTraits<Type>::size };
+    // the runs shorter than this are evaluated with the adjacent values in one `evaluate`.
+    static constexpr size_t kMinEvaluatedRun = 16;
 
     Slice _data;
     PageDecoderOptions _options;
@@ -29,12 +29,15 @@
 #include <fmt/core.h>
 #include <google/protobuf/io/zero_copy_stream_impl.h>
 
+#include <filesystem>
 #include <memory>
 
 #include "column/schema.h"
+#include "common/config.h"
 #include "common/logging.h"
 #include "gutil/strings/substitute.h"
 #include "storage/fs/fs_util.h"
+#include "storage/lru_cache.h"
 #include "storage/rowset/segment_v2/column_reader.h"
 #include "storage/rowset/segment_v2/empty_segment_iterator.h"
 #include "storage/rowset/segment_v2/page_io.h"
@@ -47,6 +50,7 @@
 #include "storage/tablet_schema.h"
 #include "storage/vectorized/type_utils.h"
 #include "util/crc32c.h"
+#include "util/file_utils.h"
 #include "util/slice.h"
 
 bvar::Adder<int> g_open_segments;    // NOLINT
@@ -58,11 +62,31 @@ bvar::Window<bvar::Adder<int>> g_open_segments_minute("starrocks", "open_segment
 // NOLINTNEXTLINE
 bvar::Window<bvar::Adder<int>> g_open_segments_io_minute("starrocks", "open_segments_io_minute", &g_open_segments_io,
                                                          60);
+bvar::Adder<int> g_segment_footer_cache_hits; // NOLINT
 
 namespace starrocks::segment_v2 {
 
 using strings::Substitute;
 
+namespace {
+
+struct CachedFooter {
+    uint64_t file_size;
+    uint32_t footer_length;
+    uint32_t checksum;
+    SegmentFooterPB footer;
+};
+
+// The parsed footers of the segments by file name, so reopening a segment, e.g. after its rowset is evicted
+// and loaded again, needn't read and parse the footer again. Returns null if disabled.
+Cache* footer_cache() {
+    static Cache* s_cache =
+            config::segment_footer_cache_capacity > 0 ? new_lru_cache(config::segment_footer_cache_capacity) : nullptr;
+    return s_cache;
+}
+
+} // namespace
+
 StatusOr<std::shared_ptr<Segment>> Segment::open(MemTracker* mem_tracker, fs::BlockManager* blk_mgr,
                                                  const std::string& filename, uint32_t segment_id,
                                                  const TabletSchema* tablet_schema, size_t* footer_length_hint) {
@@ -72,6 +96,15 @@ StatusOr<std::shared_ptr<Segment>> Segment::open(MemTracker* mem_tracker, fs::Bl
     return std::move(segment);
 }
 
+StatusOr<std::shared_ptr<Segment>> Segment::open(MemTracker* mem_tracker, std::shared_ptr<fs::BlockManager> blk_mgr,
+                                                 const std::string& filename, uint32_t segment_id,
+                                                 const TabletSchema* tablet_schema, size_t* footer_length_hint) {
+    ASSIGN_OR_RETURN(auto segment,
+                     open(mem_tracker, blk_mgr.get(), filename, segment_id, tablet_schema, footer_length_hint));
+    segment->_shared_block_mgr = std::move(blk_mgr);
+    return std::move(segment);
+}
+
 Segment::Segment(const private_type&, MemTracker* mem_tracker, fs::BlockManager* blk_mgr, std::string fname,
                  uint32_t segment_id, const TabletSchema* tablet_schema)
         : _mem_tracker(mem_tracker),
@@ -84,6 +117,20 @@ Segment::Segment(const private_type&, MemTracker* mem_tracker, fs::BlockManager*
 
 Segment::~Segment() = default;
 
+std::string Segment::cold_file_path(const std::string& fname) {
+    // the segment file is in the directory <tablet_id>/<schema_hash> of a data dir or a snapshot.
+    std::filesystem::path path(fname);
+    std::filesystem::path schema_hash_dir = path.parent_path();
+    return strings::Substitute("$0/$1/$2/$3.cold", config::cold_column_storage_path,
+                               schema_hash_dir.parent_path().filename().string(), schema_hash_dir.filename().string(),
+                               path.stem().string());
+}
+
+std::string Segment::local_cold_file_path(const std::string& fname) {
+    std::filesystem::path path(fname);
+    return (path.parent_path() / (path.stem().string() + ".cold")).string();
+}
+
 Status Segment::_open(size_t* footer_length_hint) {
     SegmentFooterPB footer;
     RETURN_IF_ERROR(_parse_footer(footer_length_hint, &footer));
@@ -191,6 +238,31 @@ Status Segment::_parse_footer(size_t* footer_length_hint, SegmentFooterPB* foote
         return Status::Corruption(strings::Substitute("Bad segment file $0: file size $1 < 12", _fname, file_size));
     }
 
+    // the cached footer is used only if it's the footer at the tail of the file.
+    Cache* cache = footer_cache();
+    Cache::Handle* handle = cache != nullptr ? cache->lookup(_fname) : nullptr;
+    if (handle != nullptr) {
+        const auto* cached = static_cast<const CachedFooter*>(cache->value(handle));
+        bool hit = false;
+        if (cached->file_size == file_size) {
+            char tail[12];
+            Status st = rblock->read(file_size - 12, Slice(tail, 12));
+            hit = st.ok() && UNALIGNED_LOAD32(tail) == cached->footer_length &&
+                  UNALIGNED_LOAD32(tail + 4) == cached->checksum &&
+                  UNALIGNED_LOAD32(tail + 8) == UNALIGNED_LOAD32(k_segment_magic);
+            if (hit) {
+                footer->CopyFrom(cached->footer);
+            }
+        }
+        cache->release(handle);
+        if (hit) {
+            g_open_segments << 1;
+            g_open_segments_io << 1;
+            g_segment_footer_cache_hits << 1;
+            return Status::OK();
+        }
+    }
+
     size_t hint_size = footer_length_hint ? *footer_length_hint : 4096;
     size_t footer_read_size = std::min<size_t>(hint_size, file_size);
 
@@ -255,6 +327,12 @@ Status Segment::_parse_footer(size_t* footer_length_hint, SegmentFooterPB* foote
                 strings::Substitute("Bad segment file $0: footer checksum not match, actual=$1 vs expect=$2", _fname,
                                     actual_checksum, checksum));
     }
+
+    if (cache != nullptr) {
+        auto* cached = new CachedFooter{file_size, footer_length, checksum, *footer};
+        auto deleter = [](const CacheKey& key, void* value) { delete static_cast<CachedFooter*>(value); };
+        cache->release(cache->insert(_fname, cached, sizeof(CachedFooter) + cached->footer.SpaceUsedLong(), deleter));
+    }
     return Status::OK();
 }
 
@@ -307,7 +385,19 @@ Status Segment::_create_column_readers(SegmentFooterPB* footer) {
         opts.block_mgr = _block_mgr;
         opts.storage_format_version = footer->version();
         opts.kept_in_memory = _tablet_schema->is_in_memory();
-        auto res = ColumnReader::create(_mem_tracker, opts, footer->mutable_columns(iter->second), _fname);
+        opts.in_cold_file = footer->columns(iter->second).in_cold_file();
+        if (opts.in_cold_file && _cold_fname.empty()) {
+            std::string local_cold_fname = local_cold_file_path(_fname);
+            if (FileUtils::check_exist(local_cold_fname)) {
+                _cold_fname = std::move(local_cold_fname);
+            } else if (config::cold_column_storage_path.empty()) {
+                return Status::InternalError(fmt::format("Bad file {}: cold_column_storage_path is not set", _fname));
+            } else {
+                _cold_fname = cold_file_path(_fname);
+            }
+        }
+        const std::string& fname = opts.in_cold_file ? _cold_fname : _fname;
+        auto res = ColumnReader::create(_mem_tracker, opts, footer->mutable_columns(iter->second), fname);
         if (!res.ok()) {
             return res.status();
         }
@@ -82,11 +82,25 @@ public:
                                                    const TabletSchema* tablet_schema,
                                                    size_t* footer_length_hint = nullptr);
 
+    // Open the segment by the BlockManager |blk_mgr| kept alive by the segment, e.g. the one of a segment pack.
+    static StatusOr<std::shared_ptr<Segment>> open(MemTracker* mem_tracker, std::shared_ptr<fs::BlockManager> blk_mgr,
+                                                   const std::string& filename, uint32_t segment_id,
+                                                   const TabletSchema* tablet_schema,
+                                                   size_t* footer_length_hint = nullptr);
+
     Segment(const private_type&, MemTracker* mem_tracker, fs::BlockManager* blk_mgr, std::string fname,
             uint32_t segment_id, const TabletSchema* tablet_schema);
 
     ~Segment();
 
+    // The file of the cold columns of the segment file |fname| under config::cold_column_storage_path, named
+    // <tablet_id>/<schema_hash>/<rowset_id>_<segment_id>.cold after the directory and the name of |fname|.
+    static std::string cold_file_path(const std::string& fname);
+
+    // The cold file kept next to the segment file |fname|, e.g. in a snapshot or a cloned tablet. It's read
+    // instead of the one under config::cold_column_storage_path if it exists.
+    static std::string local_cold_file_path(const std::string& fname);
+
     Status new_iterator(const starrocks::Schema& schema, const StorageReadOptions& read_options,
                         std::unique_ptr<RowwiseIterator>* iter);
 
@@ -131,6 +145,9 @@ public:
 
     const std::string& file_name() const { return _fname; }
 
+    // The BlockManager opening the segment file.
+    fs::BlockManager* block_manager() const { return _block_mgr; }
+
     size_t num_columns() const { return _column_readers.size(); }
 
     const ColumnReader* column(size_t i) const { return _column_readers[i].get(); }
@@ -164,7 +181,11 @@ private:
 
     MemTracker* _mem_tracker = nullptr;
     fs::BlockManager* _block_mgr;
+    // owns _block_mgr if it's opened by a shared BlockManager.
+    std::shared_ptr<fs::BlockManager> _shared_block_mgr;
     std::string _fname;
+    // the file of the columns in cold file, empty if there is none.
+    std::string _cold_fname;
     const TabletSchema* _tablet_schema;
     uint32_t _segment_id = 0;
     uint32_t _num_rows = 0;
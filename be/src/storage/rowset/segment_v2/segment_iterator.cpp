@@ -69,7 +69,7 @@ Status SegmentIterator::init(const StorageReadOptions& opts) {
 Status SegmentIterator::_init() {
     StarRocksMetrics::instance()->segment_read_total.increment(1);
     // get file handle from file descriptor of segment
-    RETURN_IF_ERROR(_opts.block_mgr->open_block(_segment->_fname, &_rblock));
+    RETURN_IF_ERROR(_segment->_block_mgr->open_block(_segment->_fname, &_rblock));
     _row_bitmap.addRange(0, _segment->num_rows());
     RETURN_IF_ERROR(_init_return_column_iterators());
     RETURN_IF_ERROR(_init_bitmap_index_iterators());
@@ -0,0 +1,165 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/rowset/segment_v2/segment_pack.h"
+
+#include <cstring>
+#include <unordered_map>
+#include <utility>
+
+#include "gutil/strings/substitute.h"
+#include "storage/fs/block_manager.h"
+#include "storage/fs/packed_block_manager.h"
+#include "util/coding.h"
+#include "util/crc32c.h"
+#include "util/faststring.h"
+#include "util/raw_container.h"
+
+namespace starrocks::segment_v2 {
+
+static const char* const k_segment_pack_magic = "PACK";
+static const uint32_t k_segment_pack_magic_length = 4;
+
+// Appends a segment to the pack file. The offsets of the segment, e.g. its page pointers, are relative to the
+// start of the segment in the pack.
+class PackedWritableBlock final : public fs::WritableBlock {
+public:
+    PackedWritableBlock(SegmentPackWriter* pack, std::string path, uint32_t segment_id)
+            : _pack(pack),
+              _path(std::move(path)),
+              _segment_id(segment_id),
+              _offset(pack->_wblock->bytes_appended()) {}
+
+    ~PackedWritableBlock() override {
+        if (_state != CLOSED) {
+            WARN_IF_ERROR(abort(), "Fail to abort packed segment " + _path);
+        }
+    }
+
+    const fs::BlockId& id() const override { return _pack->_wblock->id(); }
+
+    const std::string& path() const override { return _path; }
+
+    Status close() override {
+        if (_state == CLOSED) {
+            return Status::OK();
+        }
+        auto* entry = _pack->_footer.add_segments();
+        entry->set_segment_id(_segment_id);
+        entry->set_offset(_offset);
+        entry->set_size(bytes_appended());
+        _pack->_writing = false;
+        _state = CLOSED;
+        return Status::OK();
+    }
+
+    // The bytes written are left in the pack file, but the segment isn't added to the directory.
+    Status abort() override {
+        _pack->_writing = false;
+        _state = CLOSED;
+        return Status::OK();
+    }
+
+    fs::BlockManager* block_manager() const override { return _pack->_wblock->block_manager(); }
+
+    Status append(const Slice& data) override { return appendv(&data, 1); }
+
+    Status appendv(const Slice* data, size_t data_cnt) override {
+        DCHECK(_state == CLEAN || _state == DIRTY);
+        _state = DIRTY;
+        return _pack->_wblock->appendv(data, data_cnt);
+    }
+
+    // The pack file is synced once all the segments are written.
+    Status finalize() override {
+        _state = FINALIZED;
+        return Status::OK();
+    }
+
+    size_t bytes_appended() const override { return _pack->_wblock->bytes_appended() - _offset; }
+
+    State state() const override { return _state; }
+
+private:
+    SegmentPackWriter* _pack;
+    const std::string _path;
+    const uint32_t _segment_id;
+    const uint64_t _offset;
+    State _state = CLEAN;
+};
+
+SegmentPackWriter::SegmentPackWriter(std::unique_ptr<fs::WritableBlock> wblock) : _wblock(std::move(wblock)) {}
+
+SegmentPackWriter::~SegmentPackWriter() = default;
+
+const std::string& SegmentPackWriter::path() const {
+    return _wblock->path();
+}
+
+std::unique_ptr<fs::WritableBlock> SegmentPackWriter::new_segment_block(const std::string& path,
+                                                                        uint32_t segment_id) {
+    DCHECK(!_writing) << "only one segment is written to the pack at a time";
+    _writing = true;
+    return std::make_unique<PackedWritableBlock>(this, path, segment_id);
+}
+
+Status SegmentPackWriter::finalize() {
+    DCHECK(!_writing);
+    std::string footer_buf;
+    if (!_footer.SerializeToString(&footer_buf)) {
+        return Status::InternalError("failed to serialize segment pack footer");
+    }
+    faststring fixed_buf;
+    put_fixed32_le(&fixed_buf, footer_buf.size());
+    put_fixed32_le(&fixed_buf, crc32c::Value(footer_buf.data(), footer_buf.size()));
+    fixed_buf.append(k_segment_pack_magic, k_segment_pack_magic_length);
+
+    Slice slices[2] = {footer_buf, fixed_buf};
+    RETURN_IF_ERROR(_wblock->appendv(slices, 2));
+    RETURN_IF_ERROR(_wblock->finalize());
+    return _wblock->close();
+}
+
+StatusOr<std::shared_ptr<fs::BlockManager>> open_segment_pack(
+        fs::BlockManager* block_mgr, const std::string& path,
+        const std::function<std::string(uint32_t segment_id)>& segment_path) {
+    std::unique_ptr<fs::ReadableBlock> rblock;
+    RETURN_IF_ERROR(block_mgr->open_block(path, &rblock));
+    uint64_t file_size = 0;
+    RETURN_IF_ERROR(rblock->size(&file_size));
+    if (file_size < 12) {
+        return Status::Corruption(strings::Substitute("Bad segment pack $0: file size $1 < 12", path, file_size));
+    }
+    uint8_t fixed_buf[12];
+    RETURN_IF_ERROR(rblock->read(file_size - 12, Slice(fixed_buf, 12)));
+    if (memcmp(fixed_buf + 8, k_segment_pack_magic, k_segment_pack_magic_length) != 0) {
+        return Status::Corruption(strings::Substitute("Bad segment pack $0: magic number not match", path));
+    }
+    const uint32_t footer_length = decode_fixed32_le(fixed_buf);
+    const uint32_t checksum = decode_fixed32_le(fixed_buf + 4);
+    if (file_size < 12 + footer_length) {
+        return Status::Corruption(
+                strings::Substitute("Bad segment pack $0: file size $1 < $2", path, file_size, 12 + footer_length));
+    }
+    std::string footer_buf;
+    raw::stl_string_resize_uninitialized(&footer_buf, footer_length);
+    RETURN_IF_ERROR(rblock->read(file_size - 12 - footer_length, footer_buf));
+    if (crc32c::Value(footer_buf.data(), footer_buf.size()) != checksum) {
+        return Status::Corruption(strings::Substitute("Bad segment pack $0: footer checksum not match", path));
+    }
+    SegmentPackFooterPB footer;
+    if (!footer.ParseFromString(footer_buf)) {
+        return Status::Corruption(strings::Substitute("Bad segment pack $0: failed to parse footer", path));
+    }
+
+    std::unordered_map<std::string, fs::PackedBlockManager::Range> ranges;
+    for (const auto& entry : footer.segments()) {
+        if (entry.offset() + entry.size() > file_size - 12 - footer_length) {
+            return Status::Corruption(
+                    strings::Substitute("Bad segment pack $0: segment $1 out of range", path, entry.segment_id()));
+        }
+        ranges[segment_path(entry.segment_id())] = {entry.offset(), entry.size()};
+    }
+    return std::make_shared<fs::PackedBlockManager>(block_mgr, path, std::move(ranges));
+}
+
+} // namespace starrocks::segment_v2
@@ -0,0 +1,60 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "common/status.h"
+#include "common/statusor.h"
+#include "gen_cpp/segment_v2.pb.h"
+
+namespace starrocks {
+
+namespace fs {
+class BlockManager;
+class WritableBlock;
+} // namespace fs
+
+namespace segment_v2 {
+
+// A segment pack is a file of the small segments of a rowset appended one after another, which saves the files,
+// the opened file descriptors and the footer reads of the many tiny segments created by the frequent small loads.
+// A packed segment is still opened by its own segment file path, see open_segment_pack().
+//
+// SegmentPack := Segment*, SegmentPackFooterPB, FooterPBSize(4), FooterPBChecksum(4), MagicNumber(4)
+class SegmentPackWriter {
+public:
+    explicit SegmentPackWriter(std::unique_ptr<fs::WritableBlock> wblock);
+
+    ~SegmentPackWriter();
+
+    // Returns the block writing the segment |segment_id| of the file |path| at the end of the pack, the segment
+    // is added to the pack once the block is closed. Only one segment is written at a time.
+    std::unique_ptr<fs::WritableBlock> new_segment_block(const std::string& path, uint32_t segment_id);
+
+    // Append the footer and close the pack file.
+    Status finalize();
+
+    const std::string& path() const;
+
+    int num_segments() const { return _footer.segments_size(); }
+
+private:
+    friend class PackedWritableBlock;
+
+    std::unique_ptr<fs::WritableBlock> _wblock;
+    SegmentPackFooterPB _footer;
+    // whether a segment block is open.
+    bool _writing = false;
+};
+
+// Returns the BlockManager opening the segments in the pack file |path| by their segment file paths, named by
+// |segment_path| with the segment id, and the other paths by |block_mgr|.
+StatusOr<std::shared_ptr<fs::BlockManager>> open_segment_pack(
+        fs::BlockManager* block_mgr, const std::string& path,
+        const std::function<std::string(uint32_t segment_id)>& segment_path);
+
+} // namespace segment_v2
+} // namespace starrocks
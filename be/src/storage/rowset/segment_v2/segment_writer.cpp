@@ -21,11 +21,13 @@
 
 #include "storage/rowset/segment_v2/segment_writer.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "column/chunk.h"
 #include "column/datum_tuple.h"
 #include "column/nullable_column.h"
+#include "common/config.h"
 #include "common/logging.h" // LOG
 #include "env/env.h"        // Env
 #include "storage/fs/block_manager.h"
@@ -33,6 +35,7 @@
 #include "storage/row_cursor.h"                      // RowCursor
 #include "storage/rowset/segment_v2/column_writer.h" // ColumnWriter
 #include "storage/rowset/segment_v2/page_io.h"
+#include "storage/rowset/segment_v2/zone_map_index.h"
 #include "storage/schema.h"
 #include "storage/short_key_index.h"
 #include "storage/vectorized/seek_tuple.h"
@@ -69,30 +72,83 @@ void SegmentWriter::_init_column_meta(ColumnMetaPB* meta, uint32_t* column_id, c
     }
 }
 
+void SegmentWriter::set_cold_columns(std::unique_ptr<fs::WritableBlock> cold_block,
+                                     std::unordered_set<uint32_t> cold_columns) {
+    _cold_wblock = std::move(cold_block);
+    _cold_columns = std::move(cold_columns);
+}
+
 Status SegmentWriter::init(uint32_t write_mbytes_per_sec __attribute__((unused))) {
-    uint32_t column_id = 0;
+    std::vector<uint32_t> all_column_indexes;
+    all_column_indexes.reserve(_tablet_schema->num_columns());
+    for (uint32_t i = 0; i < _tablet_schema->num_columns(); ++i) {
+        all_column_indexes.push_back(i);
+    }
+    return init(all_column_indexes, true);
+}
+
+Status SegmentWriter::init(const std::vector<uint32_t>& column_indexes, bool has_key) {
     if (_opts.storage_format_version != 1 && _opts.storage_format_version != 2) {
         auto v = _opts.storage_format_version;
         return Status::InvalidArgument(strings::Substitute("Invalid storage_format_version $0", v));
     }
-    _column_writers.reserve(_tablet_schema->columns().size());
-    for (const auto& column : _tablet_schema->columns()) {
+    // the metas of all the columns are added at the first time, so that they're in the order of schema
+    // however the columns are grouped.
+    if (_footer.columns_size() == 0) {
+        uint32_t column_id = 0;
+        for (const auto& column : _tablet_schema->columns()) {
+            _init_column_meta(_footer.add_columns(), &column_id, column);
+        }
+        for (const auto& [column_index, encoding] : _opts.column_encodings) {
+            if (column_index >= static_cast<uint32_t>(_footer.columns_size())) {
+                return Status::InvalidArgument(strings::Substitute("Invalid column index $0", column_index));
+            }
+            _footer.mutable_columns(column_index)->set_encoding(encoding);
+        }
+        for (const auto& [column_index, compression] : _opts.column_compressions) {
+            if (column_index >= static_cast<uint32_t>(_footer.columns_size())) {
+                return Status::InvalidArgument(strings::Substitute("Invalid column index $0", column_index));
+            }
+            _footer.mutable_columns(column_index)->set_compression(compression.compression);
+        }
+    }
+
+    _column_indexes = column_indexes;
+    _has_key = has_key;
+    _num_rows_written = 0;
+    _column_writers.clear();
+    _column_writers.reserve(column_indexes.size());
+    for (uint32_t column_index : column_indexes) {
+        const auto& column = _tablet_schema->column(column_index);
         ColumnWriterOptions opts;
         opts.page_format = (_opts.storage_format_version == 1) ? 1 : 2;
         opts.adaptive_page_format = (_opts.storage_format_version > 1);
-        opts.meta = _footer.add_columns();
-
-        _init_column_meta(opts.meta, &column_id, column);
+        opts.meta = _footer.mutable_columns(column_index);
+        if (auto iter = _opts.column_compressions.find(column_index); iter != _opts.column_compressions.end()) {
+            opts.compression_level = iter->second.level;
+            opts.compression_dict_size = iter->second.dict_size;
+        }
 
         // now we create zone map for key columns
         // and not support zone map for array type.
         opts.need_zone_map = column.is_key() || (_tablet_schema->keys_type() == KeysType::DUP_KEYS &&
                                                  column.type() != FieldType::OLAP_FIELD_TYPE_CHAR &&
                                                  column.type() != FieldType::OLAP_FIELD_TYPE_VARCHAR);
+        // the sums of the unmerged rows are exact only if the rows are summed up when merged.
+        opts.need_zone_map_sum = config::enable_zone_map_sum && ZoneMapIndexWriter::support_sum(column.type()) &&
+                                 (_tablet_schema->keys_type() == KeysType::DUP_KEYS ||
+                                  (_tablet_schema->keys_type() == KeysType::AGG_KEYS && !column.is_key() &&
+                                   column.aggregation() == OLAP_FIELD_AGGREGATION_SUM));
+        opts.need_zone_map |= opts.need_zone_map_sum;
         if (column.type() == FieldType::OLAP_FIELD_TYPE_ARRAY) {
             opts.need_zone_map = false;
         }
+        opts.sub_page_zone_map_rows = std::max(config::sub_page_zone_map_rows, 0);
         opts.need_bloom_filter = column.is_bf_column();
+        if (opts.need_bloom_filter &&
+            (column.type() == OLAP_FIELD_TYPE_CHAR || column.type() == OLAP_FIELD_TYPE_VARCHAR)) {
+            opts.ngram_bloom_filter_gram_size = std::max(config::ngram_bloom_filter_gram_size, 0);
+        }
         opts.need_bitmap_index = column.has_bitmap_index();
         if (column.type() == FieldType::OLAP_FIELD_TYPE_ARRAY) {
             if (opts.need_bloom_filter) {
@@ -112,12 +168,20 @@ Status SegmentWriter::init(uint32_t write_mbytes_per_sec __attribute__((unused))
             }
         }
 
+        fs::WritableBlock* wblock = _wblock.get();
+        if (_cold_wblock != nullptr && _cold_columns.count(column_index) > 0) {
+            wblock = _cold_wblock.get();
+            opts.meta->set_in_cold_file(true);
+        }
+
         std::unique_ptr<ColumnWriter> writer;
-        RETURN_IF_ERROR(ColumnWriter::create(opts, &column, _wblock.get(), &writer));
+        RETURN_IF_ERROR(ColumnWriter::create(opts, &column, wblock, &writer));
         RETURN_IF_ERROR(writer->init());
         _column_writers.push_back(std::move(writer));
     }
-    _index_builder = std::make_unique<ShortKeyIndexBuilder>(_segment_id, _opts.num_rows_per_block);
+    if (_has_key) {
+        _index_builder = std::make_unique<ShortKeyIndexBuilder>(_segment_id, _opts.num_rows_per_block);
+    }
     return Status::OK();
 }
 
@@ -136,6 +200,7 @@ Status SegmentWriter::append_row(const RowType& row) {
         _mem_tracker->consume(static_cast<int64_t>(estimate_segment_size()) - _mem_tracker->consumption());
     }
     ++_row_count;
+    ++_num_rows_written;
     return Status::OK();
 }
 
@@ -152,11 +217,18 @@ uint64_t SegmentWriter::estimate_segment_size() {
     for (auto& column_writer : _column_writers) {
         size += column_writer->estimate_buffer_size();
     }
-    size += _index_builder->size();
+    if (_index_builder != nullptr) {
+        size += _index_builder->size();
+    }
     return size;
 }
 
 Status SegmentWriter::finalize(uint64_t* segment_file_size, uint64_t* index_size) {
+    RETURN_IF_ERROR(finalize_columns(index_size));
+    return finalize_footer(segment_file_size);
+}
+
+Status SegmentWriter::finalize_columns(uint64_t* index_size) {
     for (auto& column_writer : _column_writers) {
         RETURN_IF_ERROR(column_writer->finish());
     }
@@ -166,8 +238,22 @@ Status SegmentWriter::finalize(uint64_t* segment_file_size, uint64_t* index_size
     RETURN_IF_ERROR(_write_zone_map());
     RETURN_IF_ERROR(_write_bitmap_index());
     RETURN_IF_ERROR(_write_bloom_filter_index());
-    RETURN_IF_ERROR(_write_short_key_index());
+    if (_has_key) {
+        RETURN_IF_ERROR(_write_short_key_index());
+        _index_builder.reset();
+    }
     *index_size = _wblock->bytes_appended() - index_offset;
+    _column_writers.clear();
+    _mem_tracker->release(_mem_tracker->consumption());
+    return Status::OK();
+}
+
+Status SegmentWriter::finalize_footer(uint64_t* segment_file_size) {
+    // the cold file is complete before the footer referring to it.
+    if (_cold_wblock != nullptr) {
+        RETURN_IF_ERROR(_cold_wblock->finalize());
+        RETURN_IF_ERROR(_cold_wblock->close());
+    }
     RETURN_IF_ERROR(_write_footer());
     RETURN_IF_ERROR(_wblock->finalize());
     *segment_file_size = _wblock->bytes_appended();
@@ -180,8 +266,8 @@ Status SegmentWriter::_write_data() {
     for (auto& column_writer : _column_writers) {
         RETURN_IF_ERROR(column_writer->write_data());
         if (column_writer->is_global_dict_valid() == false) {
-            std::string col_name(_tablet_schema->columns()[idx].name().data(),
-                                 _tablet_schema->columns()[idx].name().size());
+            const auto& column = _tablet_schema->column(_column_indexes[idx]);
+            std::string col_name(column.name().data(), column.name().size());
             _global_dict_columns_valid_info[col_name] = false;
         }
         idx++;
@@ -265,16 +351,19 @@ Status SegmentWriter::append_chunk(const vectorized::Chunk& chunk) {
         RETURN_IF_ERROR(_column_writers[i]->append(*col));
     }
 
-    for (size_t i = 0; i < chunk.num_rows(); i++) {
-        // At the begin of one block, so add a short key index entry
-        if ((_row_count % _opts.num_rows_per_block) == 0) {
-            size_t keys = _tablet_schema->num_short_key_columns();
-            vectorized::SeekTuple tuple(*chunk.schema(), chunk.get(i).datums());
-            std::string encoded_key = tuple.short_key_encode(keys, 0);
-            RETURN_IF_ERROR(_index_builder->add_item(encoded_key));
+    if (_has_key) {
+        for (size_t i = 0; i < chunk.num_rows(); i++) {
+            // At the begin of one block, so add a short key index entry
+            if ((_row_count % _opts.num_rows_per_block) == 0) {
+                size_t keys = _tablet_schema->num_short_key_columns();
+                vectorized::SeekTuple tuple(*chunk.schema(), chunk.get(i).datums());
+                std::string encoded_key = tuple.short_key_encode(keys, 0);
+                RETURN_IF_ERROR(_index_builder->add_item(encoded_key));
+            }
+            ++_row_count;
         }
-        ++_row_count;
     }
+    _num_rows_written += chunk.num_rows();
     _mem_tracker->consume(static_cast<int64_t>(estimate_segment_size()) - _mem_tracker->consumption());
     return Status::OK();
 }
@@ -24,6 +24,8 @@
 #include <cstdint>
 #include <memory> // unique_ptr
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "common/status.h" // Status
@@ -55,11 +57,24 @@ class ColumnWriter;
 extern const char* const k_segment_magic;
 extern const uint32_t k_segment_magic_length;
 
+// The compression of a column, e.g. ZSTD level 3 for the cold data and LZ4_FRAME for the hot data.
+struct ColumnCompressionOptions {
+    CompressionTypePB compression = LZ4_FRAME;
+    // the compression level of ZSTD, non-positive for the default level.
+    int level = 0;
+    // the max size of the ZSTD dictionary trained from the first pages of the column, 0 for no dictionary.
+    size_t dict_size = 0;
+};
+
 struct SegmentWriterOptions {
     uint32_t storage_format_version = 1;
     uint32_t num_rows_per_block = 1024;
     MemTracker* mem_tracker = nullptr;
     vectorized::GlobalDictByNameMaps* global_dicts = nullptr;
+    // the encodings of some columns by their indexes in the schema, the other columns use DEFAULT_ENCODING.
+    std::unordered_map<uint32_t, EncodingTypePB> column_encodings;
+    // the compressions of some columns by their indexes in the schema, the other columns use LZ4_FRAME.
+    std::unordered_map<uint32_t, ColumnCompressionOptions> column_compressions;
 };
 
 class SegmentWriter {
@@ -71,19 +86,40 @@ public:
     SegmentWriter(const SegmentWriter&) = delete;
     void operator=(const SegmentWriter&) = delete;
 
+    // Write the data and indexes of |cold_columns| by their indexes in the schema to |cold_block| instead, which is
+    // the cold file of the segment, see Segment::cold_file_path(). Must be called before init().
+    void set_cold_columns(std::unique_ptr<fs::WritableBlock> cold_block, std::unordered_set<uint32_t> cold_columns);
+
     Status init(uint32_t write_mbytes_per_sec);
 
+    // Used by vertical compaction, which writes the columns of a segment group by group:
+    //   init(key_column_indexes, true) -> append_chunk() -> finalize_columns() ->
+    //   init(value_column_indexes, false) -> append_chunk() -> finalize_columns() -> ... -> finalize_footer()
+    // The first group must contain the key columns, which decide the rows of the segment.
+    Status init(const std::vector<uint32_t>& column_indexes, bool has_key);
+
     template <typename RowType>
     Status append_row(const RowType& row);
 
+    // |chunk| contains the columns passed to init(), in the same order.
     Status append_chunk(const vectorized::Chunk& chunk);
 
     uint64_t estimate_segment_size();
 
-    uint32_t num_rows_written() const { return _row_count; }
+    // the number of rows appended to the columns being written.
+    uint32_t num_rows_written() const { return _num_rows_written; }
+
+    // the number of rows of this segment, decided by the key columns.
+    uint32_t num_rows() const { return _row_count; }
 
     Status finalize(uint64_t* segment_file_size, uint64_t* index_size);
 
+    // write the data and indexes of the columns being written, and release their writers.
+    Status finalize_columns(uint64_t* index_size);
+
+    // write the footer after all the columns are finalized.
+    Status finalize_footer(uint64_t* segment_file_size);
+
     uint32_t segment_id() const { return _segment_id; }
 
     const vectorized::DictColumnsValidMap& global_dict_columns_valid_info() { return _global_dict_columns_valid_info; }
@@ -105,11 +141,17 @@ private:
     SegmentWriterOptions _opts;
 
     std::unique_ptr<fs::WritableBlock> _wblock;
+    std::unique_ptr<fs::WritableBlock> _cold_wblock;
+    std::unordered_set<uint32_t> _cold_columns;
 
     SegmentFooterPB _footer;
     std::unique_ptr<ShortKeyIndexBuilder> _index_builder;
     std::vector<std::unique_ptr<ColumnWriter>> _column_writers;
+    // the tablet column index of each one of |_column_writers|.
+    std::vector<uint32_t> _column_indexes;
+    bool _has_key = true;
     uint32_t _row_count = 0;
+    uint32_t _num_rows_written = 0;
 
     vectorized::DictColumnsValidMap _global_dict_columns_valid_info;
 };
@@ -21,6 +21,9 @@
 
 #include "storage/rowset/segment_v2/zone_map_index.h"
 
+#include <cstring>
+#include <type_traits>
+
 #include "runtime/mem_pool.h"
 #include "runtime/mem_tracker.h"
 #include "storage/column_block.h"
@@ -48,25 +51,53 @@ struct ZoneMap {
     bool has_null = false;
     // has_not_null means whether zone has none-null value
     bool has_not_null = false;
+    uint64_t null_count = 0;
+    // sum of the not-null values in the type ZoneMapSum<type>::Type, kept if |sum_size| is not 0.
+    char sum[sizeof(int128_t)] = {};
+    uint8_t sum_size = 0;
 
     void to_proto(ZoneMapPB* dst, Field* field) const {
         dst->set_min(field->to_zone_map_string(min_value));
         dst->set_max(field->to_zone_map_string(max_value));
         dst->set_has_null(has_null);
         dst->set_has_not_null(has_not_null);
+        dst->set_null_count(null_count);
+        if (sum_size > 0) {
+            dst->set_sum(sum, sum_size);
+        }
     }
 };
 
+// The type in which the values of a column are summed up, void if the sum is not supported.
+// The integer sum wraps around on overflow like the sum aggregation of LARGEINT.
+template <FieldType type, typename = void>
+struct ZoneMapSum {
+    using Type = void;
+};
+
+template <FieldType type>
+struct ZoneMapSum<type, std::enable_if_t<type == OLAP_FIELD_TYPE_TINYINT || type == OLAP_FIELD_TYPE_SMALLINT ||
+                                         type == OLAP_FIELD_TYPE_INT || type == OLAP_FIELD_TYPE_BIGINT ||
+                                         type == OLAP_FIELD_TYPE_LARGEINT>> {
+    using Type = int128_t;
+};
+
+template <FieldType type>
+struct ZoneMapSum<type, std::enable_if_t<type == OLAP_FIELD_TYPE_FLOAT || type == OLAP_FIELD_TYPE_DOUBLE>> {
+    using Type = double;
+};
+
 template <FieldType type>
 class ZoneMapIndexWriterImpl final : public ZoneMapIndexWriter {
     using CppType = typename TypeTraits<type>::CppType;
+    using SumType = typename ZoneMapSum<type>::Type;
 
 public:
-    explicit ZoneMapIndexWriterImpl(starrocks::Field* field);
+    ZoneMapIndexWriterImpl(starrocks::Field* field, uint32_t sub_page_rows, bool need_sum);
 
     void add_values(const void* values, size_t count) override;
 
-    void add_nulls(uint32_t count) override { _page_zone_map.has_null |= count > 0; }
+    void add_nulls(uint32_t count) override;
 
     // mark the end of one data page so that we can finalize the corresponding zone map
     Status flush() override;
@@ -82,42 +113,141 @@ private:
         _field->set_to_min(zone_map->max_value);
         zone_map->has_null = false;
         zone_map->has_not_null = false;
+        zone_map->null_count = 0;
+        memset(zone_map->sum, 0, sizeof(zone_map->sum));
     }
 
+    void _update_zone_map(ZoneMap* zone_map, const CppType* values, size_t count);
+
+    void _update_sum(ZoneMap* zone_map, const CppType* values, size_t count);
+
+    // add the sum of |src| to the sum of |dst|.
+    void _merge_sum(ZoneMap* dst, const ZoneMap& src);
+
+    // finalize the zone map of the current sub-page.
+    void _flush_sub_page();
+
     Field* _field;
     // memory will be managed by MemPool
     ZoneMap _page_zone_map;
     ZoneMap _segment_zone_map;
+    // zone map of the rows [k * _sub_page_rows, (k + 1) * _sub_page_rows) of the current page,
+    // disabled if |_sub_page_rows| is 0.
+    ZoneMap _sub_page_zone_map;
+    const uint32_t _sub_page_rows;
+    uint32_t _sub_page_num_rows = 0;
     // TODO(zc): we should replace this memory pool later, we only allocate min/max
     // for field. But MemPool allocate 4KB least, it will a waste for most cases.
     MemPool _pool;
 
     // serialized ZoneMapPB for each data page
     std::vector<std::string> _values;
+    // ZoneMapPB for each sub-page, serialized in `finish`
+    std::vector<ZoneMapPB> _sub_page_zone_maps;
     uint64_t _estimated_size = 0;
 };
 
 template <FieldType type>
-ZoneMapIndexWriterImpl<type>::ZoneMapIndexWriterImpl(Field* field) : _field(field) {
+ZoneMapIndexWriterImpl<type>::ZoneMapIndexWriterImpl(Field* field, uint32_t sub_page_rows, bool need_sum)
+        : _field(field), _sub_page_rows(sub_page_rows) {
     _page_zone_map.min_value = _field->allocate_value(&_pool);
     _page_zone_map.max_value = _field->allocate_value(&_pool);
     _reset_zone_map(&_page_zone_map);
     _segment_zone_map.min_value = _field->allocate_value(&_pool);
     _segment_zone_map.max_value = _field->allocate_value(&_pool);
     _reset_zone_map(&_segment_zone_map);
+    if constexpr (!std::is_void_v<SumType>) {
+        if (need_sum) {
+            _page_zone_map.sum_size = sizeof(SumType);
+            _segment_zone_map.sum_size = sizeof(SumType);
+        }
+    }
+    if (_sub_page_rows > 0) {
+        _sub_page_zone_map.min_value = _field->allocate_value(&_pool);
+        _sub_page_zone_map.max_value = _field->allocate_value(&_pool);
+        _reset_zone_map(&_sub_page_zone_map);
+    }
 }
 
 template <FieldType type>
-void ZoneMapIndexWriterImpl<type>::add_values(const void* values, size_t count) {
+void ZoneMapIndexWriterImpl<type>::_update_zone_map(ZoneMap* zone_map, const CppType* values, size_t count) {
     if (count > 0) {
-        _page_zone_map.has_not_null = true;
-        const CppType* vals = reinterpret_cast<const CppType*>(values);
-        auto [pmin, pmax] = std::minmax_element(vals, vals + count);
-        if (unaligned_load<CppType>(pmin) < unaligned_load<CppType>(_page_zone_map.min_value)) {
-            _field->type_info()->direct_copy(_page_zone_map.min_value, pmin, nullptr);
+        zone_map->has_not_null = true;
+        auto [pmin, pmax] = std::minmax_element(values, values + count);
+        if (unaligned_load<CppType>(pmin) < unaligned_load<CppType>(zone_map->min_value)) {
+            _field->type_info()->direct_copy(zone_map->min_value, pmin, nullptr);
         }
-        if (unaligned_load<CppType>(pmax) > unaligned_load<CppType>(_page_zone_map.max_value)) {
-            _field->type_info()->direct_copy(_page_zone_map.max_value, pmax, nullptr);
+        if (unaligned_load<CppType>(pmax) > unaligned_load<CppType>(zone_map->max_value)) {
+            _field->type_info()->direct_copy(zone_map->max_value, pmax, nullptr);
+        }
+    }
+}
+
+template <FieldType type>
+void ZoneMapIndexWriterImpl<type>::_update_sum(ZoneMap* zone_map, const CppType* values, size_t count) {
+    if constexpr (!std::is_void_v<SumType>) {
+        if (zone_map->sum_size > 0) {
+            auto sum = unaligned_load<SumType>(zone_map->sum);
+            for (size_t i = 0; i < count; i++) {
+                sum += static_cast<SumType>(unaligned_load<CppType>(values + i));
+            }
+            unaligned_store<SumType>(zone_map->sum, sum);
+        }
+    }
+}
+
+template <FieldType type>
+void ZoneMapIndexWriterImpl<type>::_merge_sum(ZoneMap* dst, const ZoneMap& src) {
+    if constexpr (!std::is_void_v<SumType>) {
+        if (dst->sum_size > 0) {
+            unaligned_store<SumType>(dst->sum, unaligned_load<SumType>(dst->sum) + unaligned_load<SumType>(src.sum));
+        }
+    }
+}
+
+template <FieldType type>
+void ZoneMapIndexWriterImpl<type>::_flush_sub_page() {
+    _sub_page_zone_map.to_proto(&_sub_page_zone_maps.emplace_back(), _field);
+    _reset_zone_map(&_sub_page_zone_map);
+    _sub_page_num_rows = 0;
+    _estimated_size += _sub_page_zone_maps.back().ByteSizeLong() + sizeof(uint32_t);
+}
+
+template <FieldType type>
+void ZoneMapIndexWriterImpl<type>::add_values(const void* values, size_t count) {
+    const CppType* vals = reinterpret_cast<const CppType*>(values);
+    _update_zone_map(&_page_zone_map, vals, count);
+    _update_sum(&_page_zone_map, vals, count);
+    if (_sub_page_rows == 0) {
+        return;
+    }
+    while (count > 0) {
+        size_t n = std::min<size_t>(count, _sub_page_rows - _sub_page_num_rows);
+        _update_zone_map(&_sub_page_zone_map, vals, n);
+        _sub_page_num_rows += n;
+        vals += n;
+        count -= n;
+        if (_sub_page_num_rows == _sub_page_rows) {
+            _flush_sub_page();
+        }
+    }
+}
+
+template <FieldType type>
+void ZoneMapIndexWriterImpl<type>::add_nulls(uint32_t count) {
+    _page_zone_map.has_null |= count > 0;
+    _page_zone_map.null_count += count;
+    if (_sub_page_rows == 0) {
+        return;
+    }
+    while (count > 0) {
+        uint32_t n = std::min<uint32_t>(count, _sub_page_rows - _sub_page_num_rows);
+        _sub_page_zone_map.has_null = true;
+        _sub_page_zone_map.null_count += n;
+        _sub_page_num_rows += n;
+        count -= n;
+        if (_sub_page_num_rows == _sub_page_rows) {
+            _flush_sub_page();
         }
     }
 }
@@ -137,6 +267,13 @@ Status ZoneMapIndexWriterImpl<type>::flush() {
     if (_page_zone_map.has_not_null) {
         _segment_zone_map.has_not_null = true;
     }
+    _segment_zone_map.null_count += _page_zone_map.null_count;
+    _merge_sum(&_segment_zone_map, _page_zone_map);
+
+    // the last sub-page of the page may be smaller.
+    if (_sub_page_num_rows > 0) {
+        _flush_sub_page();
+    }
 
     ZoneMapPB zone_map_pb;
     _page_zone_map.to_proto(&zone_map_pb, _field);
@@ -152,46 +289,47 @@ Status ZoneMapIndexWriterImpl<type>::flush() {
     return Status::OK();
 }
 
-std::unique_ptr<ZoneMapIndexWriter> ZoneMapIndexWriter::create(starrocks::Field* field) {
+std::unique_ptr<ZoneMapIndexWriter> ZoneMapIndexWriter::create(starrocks::Field* field, uint32_t sub_page_rows,
+                                                               bool need_sum) {
     switch (field->type()) {
     case OLAP_FIELD_TYPE_BOOL:
-        return std::make_unique<ZoneMapIndexWriterImpl<OLAP_FIELD_TYPE_BOOL>>(field);
+        return std::make_unique<ZoneMapIndexWriterImpl<OLAP_FIELD_TYPE_BOOL>>(field, sub_page_rows, need_sum);
     case OLAP_FIELD_TYPE_TINYINT:
-        return std::make_unique<ZoneMapIndexWriterImpl<OLAP_FIELD_TYPE_TINYINT>>(field);
+        return std::make_unique<ZoneMapIndexWriterImpl<OLAP_FIELD_TYPE_TINYINT>>(field, sub_page_rows, need_sum);
     case OLAP_FIELD_TYPE_SMALLINT:
-        return std::make_unique<ZoneMapIndexWriterImpl<OLAP_FIELD_TYPE_SMALLINT>>(field);
+        return std::make_unique<ZoneMapIndexWriterImpl<OLAP_FIELD_TYPE_SMALLINT>>(field, sub_page_rows, need_sum);
     case OLAP_FIELD_TYPE_INT:
-        return std::make_unique<ZoneMapIndexWriterImpl<OLAP_FIELD_TYPE_INT>>(field);
+        return std::make_unique<ZoneMapIndexWriterImpl<OLAP_FIELD_TYPE_INT>>(field, sub_page_rows, need_sum);
     case OLAP_FIELD_TYPE_BIGINT:
-        return std::make_unique<ZoneMapIndexWriterImpl<OLAP_FIELD_TYPE_BIGINT>>(field);
+        return std::make_unique<ZoneMapIndexWriterImpl<OLAP_FIELD_TYPE_BIGINT>>(field, sub_page_rows, need_sum);
     case OLAP_FIELD_TYPE_LARGEINT:
-        return std::make_unique<ZoneMapIndexWriterImpl<OLAP_FIELD_TYPE_LARGEINT>>(field);
+        return std::make_unique<ZoneMapIndexWriterImpl<OLAP_FIELD_TYPE_LARGEINT>>(field, sub_page_rows, need_sum);
     case OLAP_FIELD_TYPE_FLOAT:
-        return std::make_unique<ZoneMapIndexWriterImpl<OLAP_FIELD_TYPE_FLOAT>>(field);
+        return std::make_unique<ZoneMapIndexWriterImpl<OLAP_FIELD_TYPE_FLOAT>>(field, sub_page_rows, need_sum);
     case OLAP_FIELD_TYPE_DOUBLE:
-        return std::make_unique<ZoneMapIndexWriterImpl<OLAP_FIELD_TYPE_DOUBLE>>(field);
+        return std::make_unique<ZoneMapIndexWriterImpl<OLAP_FIELD_TYPE_DOUBLE>>(field, sub_page_rows, need_sum);
     case OLAP_FIELD_TYPE_DECIMAL:
-        return std::make_unique<ZoneMapIndexWriterImpl<OLAP_FIELD_TYPE_DECIMAL>>(field);
+        return std::make_unique<ZoneMapIndexWriterImpl<OLAP_FIELD_TYPE_DECIMAL>>(field, sub_page_rows, need_sum);
     case OLAP_FIELD_TYPE_DECIMAL_V2:
-        return std::make_unique<ZoneMapIndexWriterImpl<OLAP_FIELD_TYPE_DECIMAL_V2>>(field);
+        return std::make_unique<ZoneMapIndexWriterImpl<OLAP_FIELD_TYPE_DECIMAL_V2>>(field, sub_page_rows, need_sum);
     case OLAP_FIELD_TYPE_DECIMAL32:
-        return std::make_unique<ZoneMapIndexWriterImpl<OLAP_FIELD_TYPE_DECIMAL32>>(field);
+        return std::make_unique<ZoneMapIndexWriterImpl<OLAP_FIELD_TYPE_DECIMAL32>>(field, sub_page_rows, need_sum);
     case OLAP_FIELD_TYPE_DECIMAL64:
-        return std::make_unique<ZoneMapIndexWriterImpl<OLAP_FIELD_TYPE_DECIMAL64>>(field);
+        return std::make_unique<ZoneMapIndexWriterImpl<OLAP_FIELD_TYPE_DECIMAL64>>(field, sub_page_rows, need_sum);
     case OLAP_FIELD_TYPE_DECIMAL128:
-        return std::make_unique<ZoneMapIndexWriterImpl<OLAP_FIELD_TYPE_DECIMAL128>>(field);
+        return std::make_unique<ZoneMapIndexWriterImpl<OLAP_FIELD_TYPE_DECIMAL128>>(field, sub_page_rows, need_sum);
     case OLAP_FIELD_TYPE_CHAR:
-        return std::make_unique<ZoneMapIndexWriterImpl<OLAP_FIELD_TYPE_CHAR>>(field);
+        return std::make_unique<ZoneMapIndexWriterImpl<OLAP_FIELD_TYPE_CHAR>>(field, sub_page_rows, need_sum);
     case OLAP_FIELD_TYPE_DATE:
-        return std::make_unique<ZoneMapIndexWriterImpl<OLAP_FIELD_TYPE_DATE>>(field);
+        return std::make_unique<ZoneMapIndexWriterImpl<OLAP_FIELD_TYPE_DATE>>(field, sub_page_rows, need_sum);
     case OLAP_FIELD_TYPE_DATE_V2:
-        return std::make_unique<ZoneMapIndexWriterImpl<OLAP_FIELD_TYPE_DATE_V2>>(field);
+        return std::make_unique<ZoneMapIndexWriterImpl<OLAP_FIELD_TYPE_DATE_V2>>(field, sub_page_rows, need_sum);
     case OLAP_FIELD_TYPE_DATETIME:
-        return std::make_unique<ZoneMapIndexWriterImpl<OLAP_FIELD_TYPE_DATETIME>>(field);
+        return std::make_unique<ZoneMapIndexWriterImpl<OLAP_FIELD_TYPE_DATETIME>>(field, sub_page_rows, need_sum);
     case OLAP_FIELD_TYPE_TIMESTAMP:
-        return std::make_unique<ZoneMapIndexWriterImpl<OLAP_FIELD_TYPE_TIMESTAMP>>(field);
+        return std::make_unique<ZoneMapIndexWriterImpl<OLAP_FIELD_TYPE_TIMESTAMP>>(field, sub_page_rows, need_sum);
     case OLAP_FIELD_TYPE_VARCHAR:
-        return std::make_unique<ZoneMapIndexWriterImpl<OLAP_FIELD_TYPE_VARCHAR>>(field);
+        return std::make_unique<ZoneMapIndexWriterImpl<OLAP_FIELD_TYPE_VARCHAR>>(field, sub_page_rows, need_sum);
     case OLAP_FIELD_TYPE_STRUCT:
     case OLAP_FIELD_TYPE_ARRAY:
     case OLAP_FIELD_TYPE_MAP:
@@ -211,14 +349,24 @@ std::unique_ptr<ZoneMapIndexWriter> ZoneMapIndexWriter::create(starrocks::Field*
     return nullptr;
 }
 
-template <FieldType type>
-Status ZoneMapIndexWriterImpl<type>::finish(fs::WritableBlock* wblock, ColumnIndexMetaPB* index_meta) {
-    index_meta->set_type(ZONE_MAP_INDEX);
-    ZoneMapIndexPB* meta = index_meta->mutable_zone_map_index();
-    // store segment zone map
-    _segment_zone_map.to_proto(meta->mutable_segment_zone_map(), _field);
+bool ZoneMapIndexWriter::support_sum(FieldType type) {
+    switch (type) {
+    case OLAP_FIELD_TYPE_TINYINT:
+    case OLAP_FIELD_TYPE_SMALLINT:
+    case OLAP_FIELD_TYPE_INT:
+    case OLAP_FIELD_TYPE_BIGINT:
+    case OLAP_FIELD_TYPE_LARGEINT:
+    case OLAP_FIELD_TYPE_FLOAT:
+    case OLAP_FIELD_TYPE_DOUBLE:
+        return true;
+    default:
+        return false;
+    }
+}
 
-    // write out zone map for each data pages
+// write out the serialized zone maps |values| as an IndexedColumn.
+static Status write_zone_maps(fs::WritableBlock* wblock, const std::vector<std::string>& values,
+                              IndexedColumnMetaPB* meta) {
     TypeInfoPtr typeinfo = get_type_info(OLAP_FIELD_TYPE_OBJECT);
     IndexedColumnWriterOptions options;
     options.write_ordinal_index = true;
@@ -229,22 +377,61 @@ Status ZoneMapIndexWriterImpl<type>::finish(fs::WritableBlock* wblock, ColumnInd
     IndexedColumnWriter writer(options, typeinfo, wblock);
     RETURN_IF_ERROR(writer.init());
 
-    for (auto& value : _values) {
+    for (auto& value : values) {
         Slice value_slice(value);
         RETURN_IF_ERROR(writer.add(&value_slice));
     }
-    return writer.finish(meta->mutable_page_zone_maps());
+    return writer.finish(meta);
 }
 
-Status ZoneMapIndexReader::load(fs::BlockManager* block_mgr, const std::string& filename,
-                                const ZoneMapIndexPB* index_meta, bool use_page_cache, bool kept_in_memory) {
-    IndexedColumnReader reader(block_mgr, filename, index_meta->page_zone_maps());
+template <FieldType type>
+Status ZoneMapIndexWriterImpl<type>::finish(fs::WritableBlock* wblock, ColumnIndexMetaPB* index_meta) {
+    index_meta->set_type(ZONE_MAP_INDEX);
+    ZoneMapIndexPB* meta = index_meta->mutable_zone_map_index();
+    // store segment zone map
+    _segment_zone_map.to_proto(meta->mutable_segment_zone_map(), _field);
+
+    // write out zone map for each data pages
+    RETURN_IF_ERROR(write_zone_maps(wblock, _values, meta->mutable_page_zone_maps()));
+    if (_sub_page_rows > 0) {
+        std::vector<std::string> values(_sub_page_zone_maps.size());
+        for (size_t i = 0; i < _sub_page_zone_maps.size(); i++) {
+            if (!_sub_page_zone_maps[i].SerializeToString(&values[i])) {
+                return Status::InternalError("serialize zone map failed");
+            }
+        }
+        meta->set_sub_page_rows(_sub_page_rows);
+        RETURN_IF_ERROR(write_zone_maps(wblock, values, meta->mutable_sub_page_zone_maps()));
+    }
+    return Status::OK();
+}
+
+bool zone_map_int_sum(const ZoneMapPB& zone_map, int128_t* sum) {
+    if (zone_map.sum().size() != sizeof(int128_t)) {
+        return false;
+    }
+    *sum = unaligned_load<int128_t>(zone_map.sum().data());
+    return true;
+}
+
+bool zone_map_double_sum(const ZoneMapPB& zone_map, double* sum) {
+    if (zone_map.sum().size() != sizeof(double)) {
+        return false;
+    }
+    *sum = unaligned_load<double>(zone_map.sum().data());
+    return true;
+}
+
+// read all the zone maps of the IndexedColumn |meta| into |zone_maps|.
+static Status load_zone_maps(fs::BlockManager* block_mgr, const std::string& filename, const IndexedColumnMetaPB& meta,
+                             bool use_page_cache, bool kept_in_memory, std::vector<ZoneMapPB>* zone_maps) {
+    IndexedColumnReader reader(block_mgr, filename, meta);
     RETURN_IF_ERROR(reader.load(use_page_cache, kept_in_memory));
     std::unique_ptr<IndexedColumnIterator> iter;
     RETURN_IF_ERROR(reader.new_iterator(&iter));
 
     MemPool pool;
-    _page_zone_maps.resize(reader.num_values());
+    zone_maps->resize(reader.num_values());
 
     // read and cache all page zone maps
     for (int i = 0; i < reader.num_values(); ++i) {
@@ -260,7 +447,7 @@ Status ZoneMapIndexReader::load(fs::BlockManager* block_mgr, const std::string&
         DCHECK(num_to_read == num_read);
 
         auto* value = reinterpret_cast<Slice*>(cvb->data());
-        if (!_page_zone_maps[i].ParseFromArray(value->data, value->size)) {
+        if (!(*zone_maps)[i].ParseFromArray(value->data, value->size)) {
             return Status::Corruption("Failed to parse zone map");
         }
         pool.clear();
@@ -268,4 +455,16 @@ Status ZoneMapIndexReader::load(fs::BlockManager* block_mgr, const std::string&
     return Status::OK();
 }
 
+Status ZoneMapIndexReader::load(fs::BlockManager* block_mgr, const std::string& filename,
+                                const ZoneMapIndexPB* index_meta, bool use_page_cache, bool kept_in_memory) {
+    RETURN_IF_ERROR(load_zone_maps(block_mgr, filename, index_meta->page_zone_maps(), use_page_cache, kept_in_memory,
+                                   &_page_zone_maps));
+    if (index_meta->sub_page_rows() > 0 && index_meta->has_sub_page_zone_maps()) {
+        RETURN_IF_ERROR(load_zone_maps(block_mgr, filename, index_meta->sub_page_zone_maps(), use_page_cache,
+                                       kept_in_memory, &_sub_page_zone_maps));
+        _sub_page_rows = index_meta->sub_page_rows();
+    }
+    return Status::OK();
+}
+
 } // namespace starrocks::segment_v2
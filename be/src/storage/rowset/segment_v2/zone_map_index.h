@@ -47,9 +47,17 @@ namespace segment_v2 {
 // The IndexedColumn stores serialized ZoneMapPB for each data page.
 // It also create and store the segment-level zone map in the index meta so that
 // reader can prune an entire segment without reading pages.
+// If |sub_page_rows| is not 0, another IndexedColumn stores the zone map for every |sub_page_rows| rows of the
+// data pages, so that the reader can prune the rows inside a page.
+// If |need_sum| is true, the page and segment zone maps of the integer and floating point columns also keep the
+// sum of the not-null values, so that the aggregates can be answered without reading the data pages.
 class ZoneMapIndexWriter {
 public:
-    static std::unique_ptr<ZoneMapIndexWriter> create(starrocks::Field* field);
+    static std::unique_ptr<ZoneMapIndexWriter> create(starrocks::Field* field, uint32_t sub_page_rows = 0,
+                                                      bool need_sum = false);
+
+    // whether the sum of the values of |type| can be kept in the zone maps.
+    static bool support_sum(FieldType type);
 
     virtual ~ZoneMapIndexWriter() = default;
 
@@ -65,6 +73,12 @@ public:
     virtual uint64_t size() const = 0;
 };
 
+// Get the sum of the not-null values of the zone map of an integer column, false if the sum is absent.
+bool zone_map_int_sum(const ZoneMapPB& zone_map, int128_t* sum);
+
+// Get the sum of the not-null values of the zone map of a floating point column, false if the sum is absent.
+bool zone_map_double_sum(const ZoneMapPB& zone_map, double* sum);
+
 class ZoneMapIndexReader {
 public:
     ZoneMapIndexReader() = default;
@@ -77,16 +91,27 @@ public:
 
     int32_t num_pages() const { return _page_zone_maps.size(); }
 
+    // the sub-page zone maps of all the pages in order, every page has ceil(page rows / sub_page_rows()).
+    const std::vector<ZoneMapPB>& sub_page_zone_maps() const { return _sub_page_zone_maps; }
+
+    // 0 if the sub-page zone maps are absent.
+    uint32_t sub_page_rows() const { return _sub_page_rows; }
+
     size_t mem_usage() const {
         size_t size = sizeof(ZoneMapIndexReader);
         for (const auto& zone_map : _page_zone_maps) {
             size += zone_map.SpaceUsedLong();
         }
+        for (const auto& zone_map : _sub_page_zone_maps) {
+            size += zone_map.SpaceUsedLong();
+        }
         return size;
     }
 
 private:
     std::vector<ZoneMapPB> _page_zone_maps;
+    std::vector<ZoneMapPB> _sub_page_zone_maps;
+    uint32_t _sub_page_rows = 0;
 };
 
 } // namespace segment_v2
@@ -0,0 +1,285 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/rowset/vectorized/prefetch_readable_block.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+
+#include "util/priority_thread_pool.hpp"
+#include "util/slice.h"
+
+namespace starrocks::vectorized {
+
+struct PrefetchReadableBlock::Context {
+    enum State { NOT_ISSUED, PENDING, LOADING, READY, FAILED, RELEASED };
+
+    struct IoRange {
+        uint64_t offset = 0;
+        uint64_t size = 0;
+        uint32_t stream = 0;
+        uint32_t seq = 0;
+        State state = NOT_ISSUED;
+        std::unique_ptr<char[]> data;
+    };
+
+    explicit Context(std::unique_ptr<fs::ReadableBlock> b) : block(std::move(b)) {}
+
+    // submit the io range |idx| to the thread pool if it's not issued yet.
+    void issue(const std::shared_ptr<Context>& self, size_t idx);
+
+    // called by the prefetch task.
+    void run(size_t idx);
+
+    // called by the prefetch task, read the io ranges |idxs| still pending in one batch.
+    void run_batch(const std::vector<size_t>& idxs);
+
+    // read the io range |idx| in LOADING state, |l| is locked and unlocked during the read.
+    void load(std::unique_lock<std::mutex>& l, size_t idx);
+
+    // the io range |idx| is hit, release the earlier io ranges of its stream and issue the next one.
+    void advance(const std::shared_ptr<Context>& self, size_t idx);
+
+    std::unique_ptr<fs::ReadableBlock> block;
+    PriorityThreadPool* pool = nullptr;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    // ordered by offset after `start`.
+    std::vector<IoRange> ranges;
+    // the indexes of |ranges| of every stream, in order.
+    std::vector<std::vector<size_t>> streams;
+    // the seq of the latest io range hit of every stream.
+    std::vector<size_t> stream_pos;
+    bool closed = false;
+};
+
+void PrefetchReadableBlock::Context::issue(const std::shared_ptr<Context>& self, size_t idx) {
+    IoRange& r = ranges[idx];
+    if (r.state != NOT_ISSUED) {
+        return;
+    }
+    r.state = PENDING;
+    if (pool != nullptr) {
+        // stays pending and read on demand if the pool is full.
+        pool->try_offer(PriorityThreadPool::Task{0, [ctx = self, idx]() { ctx->run(idx); }});
+    }
+}
+
+void PrefetchReadableBlock::Context::run(size_t idx) {
+    std::unique_lock<std::mutex> l(mutex);
+    if (closed || ranges[idx].state != PENDING) {
+        return;
+    }
+    ranges[idx].state = LOADING;
+    load(l, idx);
+}
+
+void PrefetchReadableBlock::Context::run_batch(const std::vector<size_t>& idxs) {
+    std::unique_lock<std::mutex> l(mutex);
+    if (closed) {
+        return;
+    }
+    std::vector<size_t> loading;
+    std::vector<uint64_t> offsets;
+    for (size_t idx : idxs) {
+        if (ranges[idx].state == PENDING) {
+            ranges[idx].state = LOADING;
+            loading.push_back(idx);
+            offsets.push_back(ranges[idx].offset);
+        }
+    }
+    if (loading.empty()) {
+        return;
+    }
+    std::vector<uint64_t> sizes(loading.size());
+    for (size_t i = 0; i < loading.size(); i++) {
+        sizes[i] = ranges[loading[i]].size;
+    }
+    l.unlock();
+    std::vector<std::unique_ptr<char[]>> data(loading.size());
+    std::vector<Slice> slices;
+    slices.reserve(loading.size());
+    for (size_t i = 0; i < loading.size(); i++) {
+        data[i].reset(new char[sizes[i]]);
+        slices.emplace_back(data[i].get(), sizes[i]);
+    }
+    Status st = block->read_batch(offsets.data(), slices.data(), slices.size());
+    l.lock();
+    for (size_t i = 0; i < loading.size(); i++) {
+        IoRange& r = ranges[loading[i]];
+        if (r.state == LOADING) {
+            if (st.ok()) {
+                r.data = std::move(data[i]);
+                r.state = READY;
+            } else {
+                r.state = FAILED;
+            }
+        }
+    }
+    cv.notify_all();
+}
+
+void PrefetchReadableBlock::Context::load(std::unique_lock<std::mutex>& l, size_t idx) {
+    DCHECK_EQ(LOADING, ranges[idx].state);
+    const uint64_t offset = ranges[idx].offset;
+    const uint64_t size = ranges[idx].size;
+    l.unlock();
+    std::unique_ptr<char[]> data(new char[size]);
+    Status st = block->read(offset, Slice(data.get(), size));
+    l.lock();
+    IoRange& r = ranges[idx];
+    // the io range may be released during the read.
+    if (r.state == LOADING) {
+        if (st.ok()) {
+            r.data = std::move(data);
+            r.state = READY;
+        } else {
+            r.state = FAILED;
+        }
+    }
+    cv.notify_all();
+}
+
+void PrefetchReadableBlock::Context::advance(const std::shared_ptr<Context>& self, size_t idx) {
+    const IoRange& r = ranges[idx];
+    const std::vector<size_t>& stream = streams[r.stream];
+    size_t& pos = stream_pos[r.stream];
+    for (; pos < r.seq; pos++) {
+        IoRange& prev = ranges[stream[pos]];
+        prev.data.reset();
+        prev.state = RELEASED;
+    }
+    if (r.seq + 1 < stream.size()) {
+        issue(self, stream[r.seq + 1]);
+    }
+}
+
+PrefetchReadableBlock::PrefetchReadableBlock(std::unique_ptr<fs::ReadableBlock> block, size_t max_gap,
+                                             size_t max_io_bytes)
+        : _ctx(std::make_shared<Context>(std::move(block))), _max_gap(max_gap), _max_io_bytes(max_io_bytes) {}
+
+PrefetchReadableBlock::~PrefetchReadableBlock() {
+    std::lock_guard<std::mutex> l(_ctx->mutex);
+    _ctx->closed = true;
+}
+
+void PrefetchReadableBlock::add_stream(const std::vector<std::pair<uint64_t, uint64_t>>& ranges) {
+    if (ranges.empty()) {
+        return;
+    }
+    const auto stream = static_cast<uint32_t>(_ctx->streams.size());
+    _ctx->streams.emplace_back();
+    uint32_t seq = 0;
+    Context::IoRange cur;
+    cur.offset = ranges[0].first;
+    cur.size = ranges[0].second;
+    for (size_t i = 1; i < ranges.size(); i++) {
+        const auto& [offset, len] = ranges[i];
+        DCHECK_GE(offset, cur.offset + cur.size);
+        if (offset - (cur.offset + cur.size) <= _max_gap && offset + len - cur.offset <= _max_io_bytes) {
+            cur.size = offset + len - cur.offset;
+            continue;
+        }
+        cur.stream = stream;
+        cur.seq = seq++;
+        _ctx->ranges.emplace_back(std::move(cur));
+        cur = Context::IoRange();
+        cur.offset = offset;
+        cur.size = len;
+    }
+    cur.stream = stream;
+    cur.seq = seq;
+    _ctx->ranges.emplace_back(std::move(cur));
+}
+
+void PrefetchReadableBlock::start(PriorityThreadPool* pool) {
+    auto& ctx = *_ctx;
+    std::lock_guard<std::mutex> l(ctx.mutex);
+    ctx.pool = pool;
+    std::sort(ctx.ranges.begin(), ctx.ranges.end(),
+              [](const Context::IoRange& lhs, const Context::IoRange& rhs) { return lhs.offset < rhs.offset; });
+    for (size_t i = 0; i < ctx.ranges.size(); i++) {
+        const Context::IoRange& r = ctx.ranges[i];
+        auto& stream = ctx.streams[r.stream];
+        if (stream.size() <= r.seq) {
+            stream.resize(r.seq + 1);
+        }
+        stream[r.seq] = i;
+    }
+    ctx.stream_pos.assign(ctx.streams.size(), 0);
+    std::vector<size_t> first_ranges;
+    first_ranges.reserve(ctx.streams.size());
+    for (const auto& stream : ctx.streams) {
+        ctx.ranges[stream[0]].state = Context::PENDING;
+        first_ranges.push_back(stream[0]);
+    }
+    if (pool != nullptr && !first_ranges.empty()) {
+        // the first io ranges of all the streams are read in one batch, which may be submitted by io_uring.
+        pool->try_offer(PriorityThreadPool::Task{
+                0, [ctx = _ctx, idxs = std::move(first_ranges)]() { ctx->run_batch(idxs); }});
+    }
+}
+
+size_t PrefetchReadableBlock::num_io_ranges() const {
+    std::lock_guard<std::mutex> l(_ctx->mutex);
+    return _ctx->ranges.size();
+}
+
+const BlockId& PrefetchReadableBlock::id() const {
+    return _ctx->block->id();
+}
+
+const std::string& PrefetchReadableBlock::path() const {
+    return _ctx->block->path();
+}
+
+Status PrefetchReadableBlock::close() {
+    {
+        std::lock_guard<std::mutex> l(_ctx->mutex);
+        _ctx->closed = true;
+    }
+    return _ctx->block->close();
+}
+
+fs::BlockManager* PrefetchReadableBlock::block_manager() const {
+    return _ctx->block->block_manager();
+}
+
+Status PrefetchReadableBlock::size(uint64_t* sz) const {
+    return _ctx->block->size(sz);
+}
+
+Status PrefetchReadableBlock::read(uint64_t offset, Slice result) const {
+    auto& ctx = *_ctx;
+    std::unique_lock<std::mutex> l(ctx.mutex);
+    auto iter = std::upper_bound(ctx.ranges.begin(), ctx.ranges.end(), offset,
+                                 [](uint64_t off, const Context::IoRange& r) { return off < r.offset; });
+    if (ctx.closed || iter == ctx.ranges.begin() || offset + result.size > (iter - 1)->offset + (iter - 1)->size) {
+        l.unlock();
+        return ctx.block->read(offset, result);
+    }
+    const size_t idx = (iter - 1) - ctx.ranges.begin();
+    ctx.advance(_ctx, idx);
+    Context::IoRange& r = ctx.ranges[idx];
+    if (r.state == Context::NOT_ISSUED || r.state == Context::PENDING) {
+        // read by this thread instead of waiting for the queued task.
+        r.state = Context::LOADING;
+        ctx.load(l, idx);
+    }
+    ctx.cv.wait(l, [&r]() { return r.state != Context::LOADING; });
+    if (r.state == Context::READY) {
+        memcpy(result.data, r.data.get() + (offset - r.offset), result.size);
+        return Status::OK();
+    }
+    // failed to prefetch or read backwards after released, retry with the underlying block.
+    l.unlock();
+    return ctx.block->read(offset, result);
+}
+
+Status PrefetchReadableBlock::readv(uint64_t offset, const Slice* res, size_t res_cnt) const {
+    return _ctx->block->readv(offset, res, res_cnt);
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,66 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "storage/fs/block_manager.h"
+
+namespace starrocks {
+
+class PriorityThreadPool;
+
+namespace vectorized {
+
+// A ReadableBlock reading the planned ranges of the underlying block ahead, in large coalesced reads.
+//
+// The ranges are planned as streams, a stream is the ranges read in order by one reader, e.g. the data pages
+// of a column. The adjacent ranges of a stream are coalesced into one io range if the gap between them is not
+// larger than |max_gap| bytes and the io range is not larger than |max_io_bytes| bytes. Every time a read hits
+// the io range of a stream, the earlier io ranges of the stream are released and the next one is submitted to
+// the thread pool, so at most 2 io ranges of a stream are buffered.
+//
+// A read finding its io range still queued reads the io range by itself, so it never waits for the queued
+// tasks. The reads out of the planned ranges go to the underlying block.
+class PrefetchReadableBlock final : public fs::ReadableBlock {
+public:
+    PrefetchReadableBlock(std::unique_ptr<fs::ReadableBlock> block, size_t max_gap, size_t max_io_bytes);
+
+    ~PrefetchReadableBlock() override;
+
+    // plan the ranges of a stream, |ranges| are the pairs of (offset, size) ordered by offset.
+    // must be called before `start`.
+    void add_stream(const std::vector<std::pair<uint64_t, uint64_t>>& ranges);
+
+    // submit the first io ranges of all the streams to |pool| as one batch read, the io ranges are read on demand
+    // if |pool| is null.
+    void start(PriorityThreadPool* pool);
+
+    size_t num_io_ranges() const;
+
+    const BlockId& id() const override;
+
+    const std::string& path() const override;
+
+    Status close() override;
+
+    fs::BlockManager* block_manager() const override;
+
+    Status size(uint64_t* sz) const override;
+
+    Status read(uint64_t offset, Slice result) const override;
+
+    Status readv(uint64_t offset, const Slice* res, size_t res_cnt) const override;
+
+private:
+    struct Context;
+
+    // shared with the prefetch tasks, which may outlive this block.
+    std::shared_ptr<Context> _ctx;
+    size_t _max_gap;
+    size_t _max_io_bytes;
+};
+
+} // namespace vectorized
+} // namespace starrocks
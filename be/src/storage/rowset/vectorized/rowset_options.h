@@ -9,6 +9,7 @@
 #include "runtime/global_dicts.h"
 #include "storage/fs/fs_util.h"
 #include "storage/olap_common.h"
+#include "storage/vectorized/runtime_filter_predicates.h"
 #include "storage/vectorized/seek_range.h"
 
 namespace starrocks {
@@ -55,8 +56,15 @@ public:
     starrocks::RuntimeState* runtime_state = nullptr;
     starrocks::RuntimeProfile* profile = nullptr;
     bool use_page_cache = false;
+    bool fill_page_cache = true;
 
     ColumnIdToGlobalDictMap* global_dictmaps = &EMPTY_GLOBAL_DICTMAPS;
+
+    RuntimeFilterPredicatesBuilder runtime_filter_preds_builder;
+
+    // only read the segments of the rowset whose ids are in [segment_begin, segment_end), -1 means read all.
+    int64_t segment_begin = 0;
+    int64_t segment_end = -1;
 };
 
 } // namespace starrocks::vectorized
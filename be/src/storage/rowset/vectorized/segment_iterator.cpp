@@ -17,16 +17,20 @@
 #include "gutil/casts.h"
 #include "gutil/stl_util.h"
 #include "runtime/current_mem_tracker.h"
+#include "runtime/exec_env.h"
 #include "simd/simd.h"
 #include "storage/column_predicate.h"
 #include "storage/del_vector.h"
 #include "storage/fs/fs_util.h"
+#include "storage/lru_cache.h"
+#include "storage/page_cache.h"
 #include "storage/row_block2.h"
 #include "storage/rowset/segment_v2/bitmap_index_reader.h"
 #include "storage/rowset/segment_v2/column_reader.h"
 #include "storage/rowset/segment_v2/common.h"
 #include "storage/rowset/segment_v2/row_ranges.h"
 #include "storage/rowset/segment_v2/segment.h"
+#include "storage/rowset/vectorized/prefetch_readable_block.h"
 #include "storage/rowset/vectorized/rowid_column_iterator.h"
 #include "storage/rowset/vectorized/segment_options.h"
 #include "storage/storage_engine.h"
@@ -49,11 +53,92 @@ namespace starrocks::vectorized {
 using segment_v2::BitmapIndexIterator;
 using segment_v2::ColumnIterator;
 using segment_v2::ColumnIteratorOptions;
+using segment_v2::PagePointer;
 using segment_v2::rowid_t;
 using segment_v2::Segment;
 
 constexpr static const FieldType kDictCodeType = OLAP_FIELD_TYPE_INT;
 
+// The rows of the segments selected by the pushed down predicates, keyed by the segment file and the predicates,
+// or null if disabled. The segments are immutable, so the cached rows never change.
+static Cache* predicate_cache() {
+    if (config::segment_predicate_cache_capacity <= 0) {
+        return nullptr;
+    }
+    static Cache* s_cache = new_lru_cache(config::segment_predicate_cache_capacity);
+    return s_cache;
+}
+
+// The rows of the segments deleted by the delete predicates, keyed by the segment file and the delete predicates,
+// or null if disabled.
+static Cache* delete_bitmap_cache() {
+    if (config::segment_delete_bitmap_cache_capacity <= 0) {
+        return nullptr;
+    }
+    static Cache* s_cache = new_lru_cache(config::segment_delete_bitmap_cache_capacity);
+    return s_cache;
+}
+
+// Whether the same debug string of the predicate always selects the same rows.
+static bool is_cacheable_predicate(const ColumnPredicate* pred) {
+    if (pred->is_index_filter_only()) {
+        return false;
+    }
+    switch (pred->type()) {
+    case PredicateType::kEQ:
+    case PredicateType::kNE:
+    case PredicateType::kGT:
+    case PredicateType::kGE:
+    case PredicateType::kLT:
+    case PredicateType::kLE:
+    case PredicateType::kInList:
+    case PredicateType::kNotInList:
+    case PredicateType::kIsNull:
+    case PredicateType::kNotNull:
+        break;
+    default:
+        return false;
+    }
+    // the floating point operands may be rounded in the string.
+    FieldType type = pred->type_info()->type();
+    return type != OLAP_FIELD_TYPE_FLOAT && type != OLAP_FIELD_TYPE_DOUBLE;
+}
+
+// The key of |preds| on the segment |file_name| in the delete bitmap cache, or empty if some predicates can't be
+// cached. The conjunctions and the predicates in them are sorted, so the same delete conditions make the same key.
+static std::string delete_bitmap_cache_key(const std::string& file_name, const DisjunctivePredicates& preds) {
+    std::vector<std::string> conjunctions;
+    for (size_t i = 0; i < preds.size(); i++) {
+        std::set<ColumnId> columns;
+        preds[i].get_column_ids(&columns);
+        std::vector<const ColumnPredicate*> column_preds;
+        for (ColumnId cid : columns) {
+            preds[i].predicates_of_column(cid, &column_preds);
+        }
+        std::vector<std::string> strs;
+        for (const ColumnPredicate* pred : column_preds) {
+            if (!is_cacheable_predicate(pred)) {
+                return "";
+            }
+            strs.emplace_back(std::to_string(static_cast<int>(pred->type())) + ":" + pred->debug_string());
+        }
+        std::sort(strs.begin(), strs.end());
+        std::string conjunction;
+        for (const std::string& str : strs) {
+            conjunction.push_back('&');
+            conjunction.append(str);
+        }
+        conjunctions.emplace_back(std::move(conjunction));
+    }
+    std::sort(conjunctions.begin(), conjunctions.end());
+    std::string key = file_name;
+    for (const std::string& conjunction : conjunctions) {
+        key.push_back('\0');
+        key.append(conjunction);
+    }
+    return key;
+}
+
 // compare |tuple| with the first row of |chunk|.
 // NULL will be treated as a minimal value.
 static int compare(const SeekTuple& tuple, const Chunk& chunk) {
@@ -301,11 +386,17 @@ private:
             return Status::OK();
         }
 
-        Status read_columns(Chunk* chunk, size_t n) {
+        // |selection| receives the results of |_encoded_pred| if it's not null.
+        Status read_columns(Chunk* chunk, size_t n, uint8_t* selection) {
             bool may_has_del_row = chunk->delete_state() != DEL_NOT_SATISFIED;
             for (size_t i = 0; i < _column_iterators.size(); i++) {
                 const ColumnPtr& col = chunk->get_column_by_index(i);
-                RETURN_IF_ERROR(_column_iterators[i]->next_batch(&n, col.get()));
+                if (_encoded_pred != nullptr && i == _encoded_pred_index) {
+                    RETURN_IF_ERROR(_column_iterators[i]->next_batch_and_evaluate(&n, col.get(), _encoded_pred,
+                                                                                 selection));
+                } else {
+                    RETURN_IF_ERROR(_column_iterators[i]->next_batch(&n, col.get()));
+                }
                 may_has_del_row |= (col->delete_state() != DEL_NOT_SATISFIED);
             }
             chunk->set_delete_state(may_has_del_row ? DEL_PARTIAL_SATISFIED : DEL_NOT_SATISFIED);
@@ -337,6 +428,21 @@ private:
         // if true, the last item of |_column_iterators| is a `RowIdColumnIterator` and
         // the last item of |_read_schema| and |_dict_decode_schema| is a row id field.
         bool _late_materialize{false};
+
+        // the predicate evaluated while reading the column |_encoded_pred_index|, on the encoded pages if
+        // supported, instead of evaluated after reading. It's the first one of |_vectorized_preds|.
+        const ColumnPredicate* _encoded_pred{nullptr};
+        size_t _encoded_pred_index{0};
+
+        // the predicates evaluated by `_filter` on the columns of |_read_schema|.
+        std::vector<const ColumnPredicate*> _vectorized_preds;
+        std::vector<const ColumnPredicate*> _branchless_preds;
+
+        // only for late materialization: the indexes in the schema of the predicate columns which are not in
+        // |_read_schema|, in ascending order. They are read by rowid for the rows selected by `_filter`, and
+        // |_lazy_preds| on them are evaluated before reading the other columns.
+        std::vector<size_t> _lazy_fields;
+        std::vector<const ColumnPredicate*> _lazy_preds;
     };
 
     Status _init();
@@ -344,9 +450,27 @@ private:
 
     Status _init_column_iterators(const Schema& schema);
     Status _get_row_ranges_by_keys();
+    // append the predicates of the join runtime filters arrived after the reader was opened.
+    void _init_runtime_filter_predicates();
+
+    // plan the data pages of |_scan_range| to prefetch, every column of schema is a stream.
+    Status _init_prefetch();
+
     Status _get_row_ranges_by_zone_map();
     Status _get_row_ranges_by_bloom_filter();
 
+    // look up the rows selected by the pushed down predicates in the predicate cache, which replace the
+    // predicates if found.
+    void _init_predicate_cache();
+    // start collecting the rows selected by the predicates if they're not cached and can be collected.
+    void _init_predicate_cache_rows();
+    void _insert_predicate_cache();
+
+    // remove the rows deleted by the delete predicates from |_scan_range| by their bitmap in the delete bitmap
+    // cache, evaluating the delete predicates on the whole segment on a miss, and drop the delete predicates.
+    Status _apply_delete_bitmap();
+    Status _evaluate_delete_predicates(Roaring* deleted);
+
     uint32_t segment_id() const { return _segment->id(); }
     uint32_t num_rows() const { return _segment->num_rows(); }
 
@@ -369,7 +493,11 @@ private:
 
     Status _check_low_cardinality_optimization();
 
-    Status _finish_late_materialization(ScanContext* ctx);
+    // |rowid| is filtered with the rows if it's not null.
+    Status _finish_late_materialization(ScanContext* ctx, vector<rowid_t>* rowid);
+
+    // whether the predicate column |_schema.field(i)| is read by rowid in late materialization.
+    bool _is_lazy_predicate_field(size_t i) const;
 
     void _switch_context(ScanContext* to);
 
@@ -399,6 +527,8 @@ private:
 
     // block for file to read
     std::unique_ptr<fs::ReadableBlock> _rblock;
+    // points to |_rblock| if the data pages are prefetched.
+    PrefetchReadableBlock* _prefetch_block = nullptr;
 
     SparseRange _scan_range;
     SparseRangeIterator _range_iter;
@@ -430,6 +560,15 @@ private:
 
     int _late_materialization_ratio = 0;
 
+    // the key of the pushed down predicates in the predicate cache, empty if they're not cached.
+    std::string _predicate_cache_key;
+    // the rows selected by the predicates if found in the predicate cache.
+    std::unique_ptr<SparseRange> _predicate_cache_range;
+    // the rows selected by the predicates so far if they're inserted into the predicate cache after the scan.
+    std::unique_ptr<Roaring> _predicate_cache_rows;
+    // whether the deleted rows are removed from |_scan_range| instead of evaluating the delete predicates.
+    bool _delete_bitmap_applied = false;
+
     bool _inited = false;
     bool _has_bitmap_index = false;
 };
@@ -470,7 +609,16 @@ Status SegmentIterator::_init() {
     CurrentMemTracker::consume(_selected_idx.capacity() * sizeof(_selected_idx[0]));
     StarRocksMetrics::instance()->segment_read_total.increment(1);
     // get file handle from file descriptor of segment
-    RETURN_IF_ERROR(_opts.block_mgr->open_block(_segment->file_name(), &_rblock));
+    RETURN_IF_ERROR(_segment->block_manager()->open_block(_segment->file_name(), &_rblock));
+    if (config::enable_segment_prefetch && _opts.reader_type == READER_QUERY) {
+        auto block = std::make_unique<PrefetchReadableBlock>(std::move(_rblock), config::segment_prefetch_max_gap_bytes,
+                                                             config::segment_prefetch_max_io_bytes);
+        _prefetch_block = block.get();
+        _rblock = std::move(block);
+    }
+
+    _init_predicate_cache();
+    _init_runtime_filter_predicates();
 
     /// the calling order matters, do not change unless you know why.
 
@@ -483,19 +631,221 @@ Status SegmentIterator::_init() {
     // Use indexes and predicates to filter some data page
     RETURN_IF_ERROR(_init_bitmap_index_iterators());
     RETURN_IF_ERROR(_get_row_ranges_by_keys());
+    if (_predicate_cache_range != nullptr) {
+        size_t prev_size = _scan_range.span_size();
+        _scan_range = _scan_range.intersection(*_predicate_cache_range);
+        _opts.stats->rows_pred_cache_filtered += prev_size - _scan_range.span_size();
+    }
+    RETURN_IF_ERROR(_apply_delete_bitmap());
     RETURN_IF_ERROR(_apply_bitmap_index());
     RETURN_IF_ERROR(_get_row_ranges_by_zone_map());
     RETURN_IF_ERROR(_get_row_ranges_by_bloom_filter());
+    RETURN_IF_ERROR(_init_prefetch());
     // rewrite stage
     // Rewriting predicates using segment dictionary codes
     _rewrite_predicates();
     RETURN_IF_ERROR(_init_context());
     _init_column_predicates();
+    _init_predicate_cache_rows();
     _range_iter = _scan_range.new_iterator();
 
     return Status::OK();
 }
 
+void SegmentIterator::_init_predicate_cache() {
+    Cache* cache = predicate_cache();
+    if (cache == nullptr || _opts.predicates.empty() || _opts.reader_type != READER_QUERY) {
+        return;
+    }
+    std::vector<std::string> preds;
+    for (const auto& [cid, list] : _opts.predicates) {
+        // the codes of the global dicts differ between queries.
+        if (_opts.global_dictmaps->count(cid) > 0) {
+            return;
+        }
+        for (const ColumnPredicate* pred : list) {
+            if (!is_cacheable_predicate(pred)) {
+                return;
+            }
+            preds.emplace_back(std::to_string(static_cast<int>(pred->type())) + ":" + pred->debug_string());
+        }
+    }
+    std::sort(preds.begin(), preds.end());
+    _predicate_cache_key = _segment->file_name();
+    for (const std::string& pred : preds) {
+        _predicate_cache_key.push_back('\0');
+        _predicate_cache_key.append(pred);
+    }
+
+    Cache::Handle* handle = cache->lookup(_predicate_cache_key);
+    if (handle == nullptr) {
+        return;
+    }
+    _predicate_cache_range =
+            std::make_unique<SparseRange>(roaring2range(*static_cast<const Roaring*>(cache->value(handle))));
+    cache->release(handle);
+    // the rows are selected by |_predicate_cache_range| instead of the predicates.
+    _opts.predicates.clear();
+    _predicate_columns = 0;
+}
+
+void SegmentIterator::_init_predicate_cache_rows() {
+    if (_predicate_cache_key.empty() || _predicate_cache_range != nullptr) {
+        return;
+    }
+    // the rows can't be collected if some rows are skipped by the key ranges, the delete predicates or the
+    // runtime filters, or nothing is evaluated.
+    if (!_opts.ranges.empty() || !_opts.delete_predicates.empty() || _delete_bitmap_applied) {
+        return;
+    }
+    for (const auto& [cid, list] : _opts.predicates) {
+        for (const ColumnPredicate* pred : list) {
+            if (pred->is_index_filter_only()) {
+                return;
+            }
+        }
+    }
+    if (_vectorized_preds.empty() && _branchless_preds.empty()) {
+        return;
+    }
+    // the lazy predicates are evaluated on the rows left after removing the deleted rows.
+    for (const ScanContext& ctx : _context_list) {
+        if (!ctx._lazy_preds.empty() && _del_vec) {
+            return;
+        }
+    }
+    _predicate_cache_rows = std::make_unique<Roaring>();
+}
+
+Status SegmentIterator::_apply_delete_bitmap() {
+    Cache* cache = delete_bitmap_cache();
+    if (cache == nullptr || _opts.delete_predicates.empty()) {
+        return Status::OK();
+    }
+    const std::string key = delete_bitmap_cache_key(_segment->file_name(), _opts.delete_predicates);
+    if (key.empty()) {
+        return Status::OK();
+    }
+    Cache::Handle* handle = cache->lookup(key);
+    if (handle == nullptr) {
+        // only the scans of the whole segment evaluate the delete predicates on all the rows.
+        if (!_opts.ranges.empty()) {
+            return Status::OK();
+        }
+        auto deleted = std::make_unique<Roaring>();
+        RETURN_IF_ERROR(_evaluate_delete_predicates(deleted.get()));
+        deleted->runOptimize();
+        deleted->shrinkToFit();
+        const size_t charge = key.size() + deleted->getSizeInBytes();
+        auto deleter = [](const CacheKey& key, void* value) { delete static_cast<Roaring*>(value); };
+        handle = cache->insert(key, deleted.release(), charge, deleter);
+    }
+    const auto* deleted = static_cast<const Roaring*>(cache->value(handle));
+    if (!deleted->isEmpty()) {
+        Roaring rows = range2roaring(_scan_range);
+        const uint64_t prev_rows = rows.cardinality();
+        rows -= *deleted;
+        _scan_range = roaring2range(rows);
+        _opts.stats->rows_del_filtered += prev_rows - rows.cardinality();
+    }
+    cache->release(handle);
+    _opts.delete_predicates = DisjunctivePredicates();
+    _delete_bitmap_applied = true;
+    return Status::OK();
+}
+
+Status SegmentIterator::_evaluate_delete_predicates(Roaring* deleted) {
+    SCOPED_RAW_TIMER(&_opts.stats->del_filter_ns);
+    std::set<ColumnId> columns;
+    _opts.delete_predicates.get_column_ids(&columns);
+    Fields fields;
+    for (const FieldPtr& f : _schema.fields()) {
+        if (columns.count(f->id()) > 0) {
+            fields.emplace_back(f);
+        }
+    }
+    DCHECK_EQ(columns.size(), fields.size());
+    Schema schema(fields);
+    ChunkPtr chunk = ChunkHelper::new_chunk(schema, _opts.chunk_size);
+    RETURN_IF_ERROR(_seek_columns(schema, 0));
+    const rowid_t total = num_rows();
+    for (rowid_t start = 0; start < total;) {
+        const auto n = static_cast<uint16_t>(std::min<rowid_t>(_opts.chunk_size, total - start));
+        chunk->reset();
+        RETURN_IF_ERROR(_read_columns(schema, chunk.get(), n));
+        _opts.delete_predicates.evaluate(chunk.get(), _selection.data(), 0, n);
+        for (uint16_t i = 0; i < n; i++) {
+            if (_selection[i]) {
+                deleted->add(start + i);
+            }
+        }
+        start += n;
+    }
+    return Status::OK();
+}
+
+void SegmentIterator::_insert_predicate_cache() {
+    std::unique_ptr<Roaring> rows = std::move(_predicate_cache_rows);
+    Cache* cache = predicate_cache();
+    if (cache == nullptr) {
+        return;
+    }
+    rows->runOptimize();
+    rows->shrinkToFit();
+    const size_t charge = _predicate_cache_key.size() + rows->getSizeInBytes();
+    auto deleter = [](const CacheKey& key, void* value) { delete static_cast<Roaring*>(value); };
+    cache->release(cache->insert(_predicate_cache_key, rows.release(), charge, deleter));
+}
+
+void SegmentIterator::_init_runtime_filter_predicates() {
+    if (!_opts.runtime_filter_preds_builder) {
+        return;
+    }
+    std::vector<const ColumnPredicate*> preds;
+    _opts.runtime_filter_preds_builder(&_obj_pool, &preds);
+    if (preds.empty()) {
+        return;
+    }
+    // the indexes are only read for the columns in schema.
+    std::set<ColumnId> schema_columns;
+    for (const FieldPtr& f : _schema.fields()) {
+        schema_columns.insert(f->id());
+    }
+    for (const ColumnPredicate* pred : preds) {
+        DCHECK(pred->is_index_filter_only());
+        if (schema_columns.count(pred->column_id()) > 0) {
+            _opts.predicates[pred->column_id()].emplace_back(pred);
+        }
+    }
+    _predicate_columns = _opts.predicates.size();
+}
+
+Status SegmentIterator::_init_prefetch() {
+    if (_prefetch_block == nullptr) {
+        return Status::OK();
+    }
+    auto cache = StoragePageCache::instance();
+    std::vector<PagePointer> pages;
+    std::vector<std::pair<uint64_t, uint64_t>> ranges;
+    for (const FieldPtr& f : _schema.fields()) {
+        pages.clear();
+        ranges.clear();
+        RETURN_IF_ERROR(_column_iterators[f->id()]->get_page_pointers(_scan_range, &pages));
+        for (const PagePointer& pp : pages) {
+            // needn't read the cached pages.
+            PageCacheHandle handle;
+            if (_opts.use_page_cache &&
+                cache->lookup(StoragePageCache::CacheKey(_rblock->path(), pp.offset), &handle, true)) {
+                continue;
+            }
+            ranges.emplace_back(pp.offset, pp.size);
+        }
+        _prefetch_block->add_stream(ranges);
+    }
+    _prefetch_block->start(ExecEnv::GetInstance()->pipeline_io_thread_pool());
+    return Status::OK();
+}
+
 Status SegmentIterator::_init_column_iterators(const Schema& schema) {
     DCHECK_EQ(_predicate_columns, _opts.predicates.size());
 
@@ -529,8 +879,12 @@ Status SegmentIterator::_init_column_iterators(const Schema& schema) {
             ColumnIteratorOptions iter_opts;
             iter_opts.stats = _opts.stats;
             iter_opts.use_page_cache = _opts.use_page_cache;
+            iter_opts.fill_page_cache = _opts.fill_page_cache;
             iter_opts.rblock = _rblock.get();
             iter_opts.check_dict_encoding = check_dict_enc;
+            if (_opts.stats->collect_column_stats) {
+                iter_opts.column_stats = &_opts.stats->column_stats[f->name()];
+            }
             RETURN_IF_ERROR(_column_iterators[cid]->init(iter_opts));
 
             // we have a global dict map but column was not encode by dict
@@ -565,6 +919,29 @@ void SegmentIterator::_init_column_predicates() {
     if (_vectorized_preds.empty() && _branchless_preds.empty()) {
         _opts.predicates.clear();
     }
+    for (ScanContext& ctx : _context_list) {
+        auto is_lazy = [&](const ColumnPredicate* pred) {
+            return std::any_of(ctx._lazy_fields.begin(), ctx._lazy_fields.end(),
+                               [&](size_t i) { return _schema.field(i)->id() == pred->column_id(); });
+        };
+        for (const ColumnPredicate* pred : _vectorized_preds) {
+            (is_lazy(pred) ? ctx._lazy_preds : ctx._vectorized_preds).emplace_back(pred);
+        }
+        for (const ColumnPredicate* pred : _branchless_preds) {
+            (is_lazy(pred) ? ctx._lazy_preds : ctx._branchless_preds).emplace_back(pred);
+        }
+        if (!config::enable_encoded_predicate_evaluation || ctx._vectorized_preds.empty()) {
+            continue;
+        }
+        const ColumnPredicate* pred = ctx._vectorized_preds[0];
+        for (size_t i = 0; i < ctx._read_schema.num_fields(); i++) {
+            if (ctx._read_schema.field(i)->id() == pred->column_id()) {
+                ctx._encoded_pred = pred;
+                ctx._encoded_pred_index = i;
+                break;
+            }
+        }
+    }
 }
 
 Status SegmentIterator::_get_row_ranges_by_keys() {
@@ -581,7 +958,7 @@ Status SegmentIterator::_get_row_ranges_by_keys() {
         rowid_t upper_rowid = num_rows();
 
         if (!range.upper().empty()) {
-            _init_column_iterators(range.lower().schema());
+            _init_column_iterators(range.upper().schema());
             RETURN_IF_ERROR(_lookup_ordinal(range.upper(), !range.inclusive_upper(), num_rows(), &upper_rowid));
         }
         if (!range.lower().empty() && upper_rowid > 0) {
@@ -748,7 +1125,7 @@ inline Status SegmentIterator::_read(Chunk* chunk, vector<rowid_t>* rowid, size_
     {
         _opts.stats->blocks_load += 1;
         SCOPED_RAW_TIMER(&_opts.stats->block_fetch_ns);
-        RETURN_IF_ERROR(_context->read_columns(chunk, nread));
+        RETURN_IF_ERROR(_context->read_columns(chunk, nread, _selection.data()));
     }
     _chunk_rowid_start = _cur_rowid;
     if (rowid != nullptr) {
@@ -798,7 +1175,7 @@ Status SegmentIterator::_do_get_next(Chunk* result, vector<rowid_t>* rowid) {
 
     const uint32_t chunk_capacity = _opts.chunk_size;
     const int64_t prev_raw_read = _opts.stats->raw_rows_read;
-    const bool has_predicate = !_opts.predicates.empty();
+    const bool has_predicate = !_context->_vectorized_preds.empty() || !_context->_branchless_preds.empty();
     uint16_t chunk_start = 0;
     bool need_switch_context = false;
 
@@ -837,6 +1214,9 @@ Status SegmentIterator::_do_get_next(Chunk* result, vector<rowid_t>* rowid) {
         // because the chunk is a pointer to _read_chunk instead of _final_chunk.
         curr_mem_usage = _context->memory_usage();
         CurrentMemTracker::consume(curr_mem_usage - old_mem_usage);
+        if (_predicate_cache_rows != nullptr) {
+            _insert_predicate_cache();
+        }
         return Status::EndOfFile("no more data in segment");
     }
 
@@ -848,7 +1228,7 @@ Status SegmentIterator::_do_get_next(Chunk* result, vector<rowid_t>* rowid) {
     if (_context->_late_materialize) {
         chunk = _context->_final_chunk.get();
         SCOPED_RAW_TIMER(&_opts.stats->late_materialize_ns);
-        RETURN_IF_ERROR(_finish_late_materialization(_context));
+        RETURN_IF_ERROR(_finish_late_materialization(_context, rowid));
         if (_context->_next != nullptr && (chunk_start * 1000 > total_read * _late_materialization_ratio)) {
             need_switch_context = true;
         }
@@ -934,29 +1314,35 @@ void SegmentIterator::_switch_context(ScanContext* to) {
 
 uint16_t SegmentIterator::_filter(Chunk* chunk, vector<rowid_t>* rowid, uint16_t from, uint16_t to) {
     // There must be one predicate, either vectorized or branchless.
-    DCHECK(_vectorized_preds.size() + _branchless_preds.size() > 0 || _del_vec);
+    DCHECK(_context->_vectorized_preds.size() + _context->_branchless_preds.size() > 0 || _del_vec);
 
     SCOPED_RAW_TIMER(&_opts.stats->vec_cond_ns);
 
     // first evaluate
-    if (!_vectorized_preds.empty()) {
+    if (!_context->_vectorized_preds.empty()) {
         SCOPED_RAW_TIMER(&_opts.stats->vec_cond_evaluate_ns);
-        const ColumnPredicate* pred = _vectorized_preds[0];
-        Column* c = chunk->get_column_by_id(pred->column_id()).get();
-        pred->evaluate(c, _selection.data(), from, to);
-        for (int i = 1; i < _vectorized_preds.size(); ++i) {
-            pred = _vectorized_preds[i];
+        const ColumnPredicate* pred = _context->_vectorized_preds[0];
+        Column* c = nullptr;
+        if (_context->_encoded_pred != nullptr) {
+            // evaluated while reading the column.
+            DCHECK_EQ(pred, _context->_encoded_pred);
+        } else {
+            c = chunk->get_column_by_id(pred->column_id()).get();
+            pred->evaluate(c, _selection.data(), from, to);
+        }
+        for (int i = 1; i < _context->_vectorized_preds.size(); ++i) {
+            pred = _context->_vectorized_preds[i];
             c = chunk->get_column_by_id(pred->column_id()).get();
             pred->evaluate_and(c, _selection.data(), from, to);
         }
     }
 
     // evaluate brachless
-    if (!_branchless_preds.empty()) {
+    if (!_context->_branchless_preds.empty()) {
         SCOPED_RAW_TIMER(&_opts.stats->vec_cond_evaluate_ns);
 
         uint16_t selected_size = 0;
-        if (!_vectorized_preds.empty()) {
+        if (!_context->_vectorized_preds.empty()) {
             for (uint16_t i = from; i < to; ++i) {
                 _selected_idx[selected_size] = i;
                 selected_size += _selection[i];
@@ -970,8 +1356,8 @@ uint16_t SegmentIterator::_filter(Chunk* chunk, vector<rowid_t>* rowid, uint16_t
             }
         }
 
-        for (size_t i = 0; selected_size > 0 && i < _branchless_preds.size(); ++i) {
-            const ColumnPredicate* pred = _branchless_preds[i];
+        for (size_t i = 0; selected_size > 0 && i < _context->_branchless_preds.size(); ++i) {
+            const ColumnPredicate* pred = _context->_branchless_preds[i];
             ColumnPtr& c = chunk->get_column_by_id(pred->column_id());
             selected_size = pred->evaluate_branchless(c.get(), _selected_idx.data(), selected_size);
         }
@@ -982,9 +1368,18 @@ uint16_t SegmentIterator::_filter(Chunk* chunk, vector<rowid_t>* rowid, uint16_t
         }
     }
 
+    if (_predicate_cache_rows != nullptr && _context->_lazy_preds.empty()) {
+        // the rows selected by the predicates, regardless of the deleted rows of the version read.
+        for (uint16_t i = from; i < to; ++i) {
+            if (_selection[i]) {
+                _predicate_cache_rows->add(_chunk_rowid_start + (i - from));
+            }
+        }
+    }
+
     int64_t del_vec_filtered = 0;
     if (_del_vec) {
-        if (_vectorized_preds.empty() && _branchless_preds.empty()) {
+        if (_context->_vectorized_preds.empty() && _context->_branchless_preds.empty()) {
             // setup selection vector
             memset(_selection.data() + from, 1, to - from);
         }
@@ -1052,6 +1447,10 @@ Status SegmentIterator::_build_context(ScanContext* ctx) {
     for (size_t i = 0; i < early_materialize_fields; i++) {
         const FieldPtr& f = _schema.field(i);
         const ColumnId cid = f->id();
+        if (late_materialization && _is_lazy_predicate_field(i)) {
+            ctx->_lazy_fields.emplace_back(i);
+            continue;
+        }
         bool use_global_dict_code = _can_using_global_dict(f);
         bool use_dict_code = _can_using_dict_code(f);
 
@@ -1103,6 +1502,14 @@ Status SegmentIterator::_build_context(ScanContext* ctx) {
     return Status::OK();
 }
 
+inline bool SegmentIterator::_is_lazy_predicate_field(size_t i) const {
+    DCHECK_LT(i, static_cast<size_t>(_predicate_columns));
+    // the first predicate column is always read by `_filter`, and the dict-coded columns are cheap to read and
+    // evaluated on the codes.
+    const FieldPtr& f = _schema.field(i);
+    return config::enable_lazy_predicate_columns && i > 0 && !_can_using_dict_code(f) && !_can_using_global_dict(f);
+}
+
 Status SegmentIterator::_init_context() {
     DCHECK_EQ(_predicate_columns, _opts.predicates.size());
     _late_materialization_ratio = config::late_materialization_ratio;
@@ -1210,23 +1617,28 @@ Status SegmentIterator::_check_low_cardinality_optimization() {
     return Status::OK();
 }
 
-Status SegmentIterator::_finish_late_materialization(ScanContext* ctx) {
+Status SegmentIterator::_finish_late_materialization(ScanContext* ctx, vector<rowid_t>* rowid) {
     const size_t m = ctx->_read_schema.num_fields();
+    const size_t predicate_count = _predicate_columns;
+    const std::vector<size_t>& lazy_fields = ctx->_lazy_fields;
 
     bool may_has_del_row = ctx->_dict_chunk->delete_state() != DEL_NOT_SATISFIED;
 
     // last column of |_dict_chunk| is a fake column: it's filled by `RowIdColumnIterator`.
     ColumnPtr rowid_column = ctx->_dict_chunk->get_column_by_index(m - 1);
-    const auto* ordinals = down_cast<FixedLengthColumn<rowid_t>*>(rowid_column.get());
+    auto* ordinals = down_cast<FixedLengthColumn<rowid_t>*>(rowid_column.get());
 
-    for (size_t i = 0; i < m - 1; i++) {
-        ctx->_final_chunk->get_column_by_index(i)->swap_column(*ctx->_dict_chunk->get_column_by_index(i));
+    // |_dict_chunk| has the predicate columns except |lazy_fields|.
+    for (size_t i = 0, j = 0, k = 0; i < predicate_count; i++) {
+        if (j < lazy_fields.size() && lazy_fields[j] == i) {
+            j++;
+            continue;
+        }
+        ctx->_final_chunk->get_column_by_index(i)->swap_column(*ctx->_dict_chunk->get_column_by_index(k++));
     }
 
-    const size_t n = _schema.num_fields();
-    for (size_t i = m - 1; i < n; i++) {
-        const FieldPtr& f = _schema.field(i);
-        const ColumnId cid = f->id();
+    auto read_by_rowid = [&](size_t i) {
+        const ColumnId cid = _schema.field(i)->id();
         ColumnPtr& col = ctx->_final_chunk->get_column_by_index(i);
         col->reserve(ordinals->size());
         col->resize(0);
@@ -1234,6 +1646,41 @@ Status SegmentIterator::_finish_late_materialization(ScanContext* ctx) {
         RETURN_IF_ERROR(_column_decoders[cid].decode_values_by_rowid(*ordinals, col.get()));
         DCHECK_EQ(ordinals->size(), col->size());
         may_has_del_row |= (col->delete_state() != DEL_NOT_SATISFIED);
+        return Status::OK();
+    };
+
+    if (!lazy_fields.empty()) {
+        for (size_t i : lazy_fields) {
+            RETURN_IF_ERROR(read_by_rowid(i));
+        }
+        const size_t num_rows = ordinals->size();
+        if (!ctx->_lazy_preds.empty() && num_rows > 0) {
+            memset(_selection.data(), 1, num_rows);
+            for (const ColumnPredicate* pred : ctx->_lazy_preds) {
+                const Column* c = ctx->_final_chunk->get_column_by_id(pred->column_id()).get();
+                pred->evaluate_and(c, _selection.data(), 0, num_rows);
+            }
+            const size_t hit_count = SIMD::count_nonzero(_selection.data(), num_rows);
+            if (hit_count != num_rows) {
+                ordinals->filter_range(_selection, 0, num_rows);
+                for (size_t i = 0; i < predicate_count; i++) {
+                    ctx->_final_chunk->get_column_by_index(i)->filter_range(_selection, 0, num_rows);
+                }
+                if (rowid != nullptr) {
+                    auto size = ColumnHelper::filter_range<uint32_t>(_selection, rowid->data(), 0, num_rows);
+                    rowid->resize(size);
+                }
+                _opts.stats->rows_vec_cond_filtered += num_rows - hit_count;
+            }
+        }
+        if (_predicate_cache_rows != nullptr && !ctx->_lazy_preds.empty()) {
+            _predicate_cache_rows->addMany(ordinals->size(), ordinals->get_data().data());
+        }
+    }
+
+    const size_t n = _schema.num_fields();
+    for (size_t i = predicate_count; i < n; i++) {
+        RETURN_IF_ERROR(read_by_rowid(i));
     }
     ctx->_final_chunk->set_delete_state(may_has_del_row ? DEL_PARTIAL_SATISFIED : DEL_NOT_SATISFIED);
     ctx->_final_chunk->check_or_die();
@@ -1363,6 +1810,7 @@ void SegmentIterator::close() {
     _context_list[0].close();
     _context_list[1].close();
     _obj_pool.clear();
+    _prefetch_block = nullptr;
     _rblock.reset();
     _segment.reset();
 
@@ -29,6 +29,7 @@ Status SegmentReadOptions::convert_to(SegmentReadOptions* dst, const std::vector
 
     dst->stats = stats;
     dst->use_page_cache = use_page_cache;
+    dst->fill_page_cache = fill_page_cache;
     dst->profile = profile;
     dst->global_dictmaps = global_dictmaps;
     return Status::OK();
@@ -61,6 +62,7 @@ std::string SegmentReadOptions::debug_string() const {
     ss << "],delete_predicates={";
     ss << "},tablet_schema={";
     ss << "},use_page_cache=" << use_page_cache;
+    ss << ",fill_page_cache=" << fill_page_cache;
     return ss.str();
 }
 
@@ -9,6 +9,7 @@
 #include "runtime/global_dicts.h"
 #include "storage/fs/fs_util.h"
 #include "storage/vectorized/disjunctive_predicates.h"
+#include "storage/vectorized/runtime_filter_predicates.h"
 #include "storage/vectorized/seek_range.h"
 
 namespace starrocks {
@@ -48,6 +49,8 @@ public:
     RuntimeProfile* profile = nullptr;
 
     bool use_page_cache = false;
+    // whether to insert the data pages missed into page cache.
+    bool fill_page_cache = true;
 
     Status convert_to(SegmentReadOptions* dst, const std::vector<FieldType>& new_types, ObjectPool* obj_pool) const;
 
@@ -58,6 +61,9 @@ public:
     int chunk_size = DEFAULT_CHUNK_SIZE;
 
     const ColumnIdToGlobalDictMap* global_dictmaps = &EMPTY_GLOBAL_DICTMAPS;
+
+    // not copied by `convert_to`, the built predicates are of the types of tablet schema.
+    RuntimeFilterPredicatesBuilder runtime_filter_preds_builder;
 };
 
 } // namespace starrocks::vectorized
@@ -2,10 +2,23 @@
 
 #include "rowset_update_state.h"
 
+#include <algorithm>
+#include <map>
+
+#include "common/config.h"
 #include "storage/primary_key_encoder.h"
 #include "storage/rowset/beta_rowset.h"
 #include "storage/rowset/rowset.h"
+#include "storage/rowset/rowset_factory.h"
+#include "storage/rowset/rowset_writer.h"
+#include "storage/rowset/rowset_writer_context.h"
+#include "storage/rowset/segment_v2/column_reader.h"
 #include "storage/rowset/vectorized/rowset_options.h"
+#include "storage/storage_engine.h"
+#include "storage/tablet.h"
+#include "storage/tablet_updates.h"
+#include "storage/types.h"
+#include "storage/update_manager.h"
 #include "storage/vectorized/chunk_helper.h"
 
 namespace starrocks {
@@ -103,6 +116,148 @@ Status RowsetUpdateState::_do_load(Rowset* rowset) {
     return Status::OK();
 }
 
+Status RowsetUpdateState::_read_segment(Rowset* rowset, uint32_t segment_id,
+                                        const std::vector<uint32_t>& read_column_ids, vectorized::ChunkPtr* chunk) {
+    auto read_schema = ChunkHelper::convert_schema_to_format_v2(rowset->schema(), read_column_ids);
+    *chunk = ChunkHelper::new_chunk(read_schema, 0);
+    OlapReaderStatistics stats;
+    auto res = down_cast<BetaRowset*>(rowset)->get_segment_iterator2(read_schema, segment_id, nullptr, 0, &stats);
+    if (!res.ok()) {
+        return res.status();
+    }
+    auto itr = std::move(res).value();
+    if (itr == nullptr) {
+        return Status::OK();
+    }
+    auto read_chunk = ChunkHelper::new_chunk(read_schema, config::vector_chunk_size);
+    while (true) {
+        read_chunk->reset();
+        auto st = itr->get_next(read_chunk.get());
+        if (st.is_end_of_file()) {
+            break;
+        } else if (!st.ok()) {
+            itr->close();
+            return st;
+        }
+        (*chunk)->append(*read_chunk);
+    }
+    itr->close();
+    return Status::OK();
+}
+
+Status RowsetUpdateState::rewrite_partial_update(Tablet* tablet, Rowset* rowset, const PrimaryIndex& index,
+                                                 RowsetSharedPtr* full_rowset) {
+    const TabletSchema& tablet_schema = tablet->tablet_schema();
+    const auto& loaded_unique_ids = rowset->rowset_meta()->txn_meta().partial_update_column_unique_ids();
+    // the columns loaded and the columns to fill, by their ids in the tablet schema.
+    std::vector<uint32_t> read_column_ids;
+    std::vector<uint32_t> fill_column_ids;
+    for (uint32_t cid = 0; cid < tablet_schema.num_columns(); cid++) {
+        auto unique_id = static_cast<uint32_t>(tablet_schema.column(cid).unique_id());
+        if (std::find(loaded_unique_ids.begin(), loaded_unique_ids.end(), unique_id) != loaded_unique_ids.end()) {
+            read_column_ids.push_back(cid);
+        } else {
+            fill_column_ids.push_back(cid);
+        }
+    }
+    auto full_schema = ChunkHelper::convert_schema_to_format_v2(tablet_schema);
+
+    RowsetWriterContext context(kDataFormatV2, config::storage_format_version);
+    context.mem_tracker = StorageEngine::instance()->update_manager()->mem_tracker();
+    context.rowset_id = StorageEngine::instance()->next_rowset_id();
+    context.tablet_uid = tablet->tablet_uid();
+    context.tablet_id = tablet->tablet_id();
+    context.partition_id = rowset->partition_id();
+    context.tablet_schema_hash = tablet->schema_hash();
+    context.rowset_type = BETA_ROWSET;
+    context.rowset_path_prefix = tablet->tablet_path();
+    context.tablet_schema = &tablet_schema;
+    context.rowset_state = COMMITTED;
+    context.segments_overlap = NONOVERLAPPING;
+    std::unique_ptr<RowsetWriter> writer;
+    RETURN_IF_ERROR(RowsetFactory::create_rowset_writer(context, &writer));
+
+    RowsetReleaseGuard guard(rowset->shared_from_this());
+    for (uint32_t i = 0; i < rowset->num_segments(); i++) {
+        vectorized::ChunkPtr loaded;
+        RETURN_IF_ERROR(_read_segment(rowset, i, read_column_ids, &loaded));
+        const size_t num_rows = loaded->num_rows();
+        if (num_rows != (_upserts[i] != nullptr ? _upserts[i]->size() : 0)) {
+            return Status::InternalError(Substitute("partial update segment and keys mismatch tablet:$0 seg:$1",
+                                                    _tablet_id, i));
+        }
+        // the position of every row in the values of the fill columns, 0 is the default value.
+        std::vector<uint32_t> value_idxes(num_rows, 0);
+        std::map<uint32_t, std::vector<uint32_t>> rowids_by_rssid;
+        std::vector<uint64_t> old_rowids;
+        if (num_rows > 0) {
+            index.get(*_upserts[i], &old_rowids);
+            for (uint64_t v : old_rowids) {
+                if (v != PrimaryIndex::NOT_FOUND) {
+                    rowids_by_rssid[(uint32_t)(v >> 32)].push_back((uint32_t)(v & 0xFFFFFFFF));
+                }
+            }
+        }
+        std::map<uint32_t, uint32_t> rssid_base;
+        uint32_t next_idx = 1;
+        for (auto& [rssid, rowids] : rowids_by_rssid) {
+            std::sort(rowids.begin(), rowids.end());
+            rssid_base[rssid] = next_idx;
+            next_idx += rowids.size();
+        }
+        for (size_t j = 0; j < old_rowids.size(); j++) {
+            uint64_t v = old_rowids[j];
+            if (v != PrimaryIndex::NOT_FOUND) {
+                auto rssid = (uint32_t)(v >> 32);
+                const auto& rowids = rowids_by_rssid[rssid];
+                auto pos = std::lower_bound(rowids.begin(), rowids.end(), (uint32_t)(v & 0xFFFFFFFF)) - rowids.begin();
+                value_idxes[j] = rssid_base[rssid] + pos;
+            }
+        }
+
+        std::vector<std::unique_ptr<vectorized::Column>> values;
+        for (uint32_t cid : fill_column_ids) {
+            const TabletColumn& column = tablet_schema.column(cid);
+            auto value = ChunkHelper::column_from_field(*full_schema.field(cid))->clone_empty();
+            // the default value of the new keys, checked by the load.
+            segment_v2::DefaultValueColumnIterator default_iter(column.has_default_value(), column.default_value(),
+                                                                column.is_nullable(), get_type_info(column),
+                                                                column.length(), 1);
+            segment_v2::ColumnIteratorOptions iter_opts;
+            RETURN_IF_ERROR(default_iter.init(iter_opts));
+            size_t n = 1;
+            RETURN_IF_ERROR(default_iter.next_batch(&n, value.get()));
+            values.emplace_back(std::move(value));
+        }
+        RETURN_IF_ERROR(tablet->updates()->get_column_values(fill_column_ids, rowids_by_rssid, &values));
+
+        auto full_chunk = ChunkHelper::new_chunk(full_schema, num_rows);
+        for (size_t k = 0; k < read_column_ids.size(); k++) {
+            full_chunk->get_column_by_index(read_column_ids[k])->append(*loaded->get_column_by_index(k));
+        }
+        for (size_t k = 0; k < fill_column_ids.size(); k++) {
+            full_chunk->get_column_by_index(fill_column_ids[k])
+                    ->append_selective(*values[k], value_idxes.data(), 0, num_rows);
+        }
+        // the deletes are always in the last segment.
+        OLAPStatus st = OLAP_SUCCESS;
+        if (i + 1 == rowset->num_segments() && !_deletes.empty()) {
+            st = writer->flush_chunk_with_deletes(*full_chunk, *_deletes[0]);
+        } else {
+            st = writer->flush_chunk(*full_chunk);
+        }
+        if (st != OLAP_SUCCESS) {
+            return Status::InternalError(Substitute("rewrite partial update failed tablet:$0 seg:$1 err:$2",
+                                                    _tablet_id, i, st));
+        }
+    }
+    *full_rowset = writer->build();
+    if (*full_rowset == nullptr) {
+        return Status::InternalError(Substitute("rewrite partial update: build rowset failed tablet:$0", _tablet_id));
+    }
+    return Status::OK();
+}
+
 std::string RowsetUpdateState::to_string() const {
     return Substitute("RowsetUpdateState tablet:$0", _tablet_id);
 }
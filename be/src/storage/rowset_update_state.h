@@ -25,6 +25,14 @@ public:
 
     Status load(int64_t tablet_id, Rowset* rowset);
 
+    // Fill the columns not loaded by the partial update |rowset| with the values of the latest rows
+    // of the same keys located by |index|, or the default values for the keys not in |index|, and
+    // write the full rows to |full_rowset|, in the same segments and order of |rowset|. So the
+    // loaded upserts and deletes are still valid for |full_rowset|.
+    // Must be called after |load| by the apply of |rowset|, before |index| is updated by it.
+    Status rewrite_partial_update(Tablet* tablet, Rowset* rowset, const PrimaryIndex& index,
+                                  RowsetSharedPtr* full_rowset);
+
     const std::vector<ColumnUniquePtr>& upserts() const { return _upserts; }
     const std::vector<ColumnUniquePtr>& deletes() const { return _deletes; }
 
@@ -35,6 +43,10 @@ public:
 private:
     Status _do_load(Rowset* rowset);
 
+    // read all the rows of the columns |read_column_ids| of the |segment_id|th segment of |rowset|.
+    Status _read_segment(Rowset* rowset, uint32_t segment_id, const std::vector<uint32_t>& read_column_ids,
+                         vectorized::ChunkPtr* chunk);
+
     std::once_flag _load_once_flag;
     Status _status;
     // one for each segment file
@@ -21,13 +21,16 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <iterator>
 #include <string>
 #include <vector>
 
 #include "common/status.h"
 #include "gen_cpp/segment_v2.pb.h"
+#include "gutil/endian.h"
 #include "util/debug_util.h"
 #include "util/faststring.h"
 #include "util/slice.h"
@@ -256,18 +259,33 @@ public:
     }
 
     int64_t mem_usage() const {
-        return sizeof(ShortKeyIndexDecoder) + sizeof(uint32_t) * _offsets.size() + _key_data.size +
-               _footer.ByteSizeLong() - sizeof(_footer);
+        return sizeof(ShortKeyIndexDecoder) + sizeof(uint32_t) * _offsets.size() + sizeof(uint64_t) * _prefixes.size() +
+               _key_data.size + _footer.ByteSizeLong() - sizeof(_footer);
+    }
+
+    // The first 8 bytes of |key| as a big endian integer, padded with zeros. The order of the prefixes is
+    // consistent with that of the keys, i.e. lhs < rhs implies prefix(lhs) <= prefix(rhs).
+    static uint64_t key_prefix(const Slice& key) {
+        char buf[sizeof(uint64_t)] = {0};
+        memcpy(buf, key.data, std::min(key.size, sizeof(buf)));
+        return BigEndian::Load64(buf);
     }
 
 private:
+    // The seek is narrowed down to the keys of the same prefix by the binary search on the contiguous prefixes
+    // first, which doesn't touch the offsets and the key data, then the keys of the same prefix are compared.
     template <bool lower_bound>
     ShortKeyIndexIterator seek(const Slice& key) const {
+        const uint64_t prefix = key_prefix(key);
+        auto first = std::lower_bound(_prefixes.begin(), _prefixes.end(), prefix);
+        auto last = std::upper_bound(first, _prefixes.end(), prefix);
+        ShortKeyIndexIterator from(this, first - _prefixes.begin());
+        ShortKeyIndexIterator to(this, last - _prefixes.begin());
         auto comparator = [](const Slice& lhs, const Slice& rhs) { return lhs.compare(rhs) < 0; };
         if (lower_bound) {
-            return std::lower_bound(begin(), end(), key, comparator);
+            return std::lower_bound(from, to, key, comparator);
         } else {
-            return std::upper_bound(begin(), end(), key, comparator);
+            return std::upper_bound(from, to, key, comparator);
         }
     }
 
@@ -276,6 +294,8 @@ private:
     // All following fields are only valid after parse has been executed successfully
     segment_v2::ShortKeyFooterPB _footer;
     std::vector<uint32_t> _offsets;
+    // key_prefix() of every key.
+    std::vector<uint64_t> _prefixes;
     Slice _key_data;
 };
 
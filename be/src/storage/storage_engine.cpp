@@ -22,7 +22,9 @@
 #include "storage/storage_engine.h"
 
 #include <rapidjson/document.h>
+#include <sys/stat.h>
 #include <thrift/protocol/TDebugProtocol.h>
+#include <unistd.h>
 
 #include <algorithm>
 #include <boost/algorithm/string.hpp>
@@ -39,7 +41,10 @@
 
 #include "common/status.h"
 #include "env/env.h"
+#include "gutil/strings/numbers.h"
 #include "runtime/exec_env.h"
+#include "storage/clock_cache.h"
+#include "storage/compaction_scheduler.h"
 #include "storage/data_dir.h"
 #include "storage/fs/file_block_manager.h"
 #include "storage/lru_cache.h"
@@ -54,12 +59,11 @@
 #include "storage/tablet_updates.h"
 #include "storage/update_manager.h"
 #include "storage/utils.h"
-#include "storage/vectorized/base_compaction.h"
-#include "storage/vectorized/cumulative_compaction.h"
 #include "util/file_utils.h"
 #include "util/pretty_printer.h"
 #include "util/scoped_cleanup.h"
 #include "util/starrocks_metrics.h"
+#include "util/threadpool.h"
 #include "util/time.h"
 #include "util/trace.h"
 
@@ -157,7 +161,8 @@ Status StorageEngine::_open() {
 
     _index_stream_lru_cache = new_lru_cache(config::index_stream_cache_capacity);
 
-    _file_cache.reset(new_lru_cache(config::file_descriptor_cache_capacity));
+    _file_cache.reset(config::enable_clock_cache ? new_clock_cache(config::file_descriptor_cache_capacity)
+                                                 : new_lru_cache(config::file_descriptor_cache_capacity));
 
     fs::BlockManagerOptions bm_opts;
     bm_opts.read_only = false;
@@ -176,6 +181,12 @@ Status StorageEngine::_open() {
     _memtable_flush_executor = std::make_unique<MemTableFlushExecutor>();
     RETURN_IF_ERROR_WITH_WARN(_memtable_flush_executor->init(dirs), "init memtable_flush_executor failed");
 
+    RETURN_IF_ERROR_WITH_WARN(ThreadPoolBuilder("storage_parallel_task")
+                                      .set_min_threads(0)
+                                      .set_max_threads(std::max(config::storage_parallel_task_threads, 1))
+                                      .build(&_parallel_task_pool),
+                              "init storage parallel task pool failed");
+
     return Status::OK();
 }
 
@@ -453,6 +464,15 @@ bool StorageEngine::_delete_tablets_on_unused_root_path() {
 }
 
 void StorageEngine::_clear() {
+    // the compactions must stop before the data dirs are released
+    if (_compaction_scheduler != nullptr) {
+        _compaction_scheduler->stop();
+    }
+
+    if (_parallel_task_pool != nullptr) {
+        _parallel_task_pool->shutdown();
+    }
+
     SAFE_DELETE(_index_stream_lru_cache);
     _file_cache.reset();
 
@@ -511,77 +531,6 @@ void StorageEngine::_start_clean_fd_cache() {
     VLOG(10) << "Cleaned file descritpor cache";
 }
 
-Status StorageEngine::_perform_cumulative_compaction(DataDir* data_dir) {
-    scoped_refptr<Trace> trace(new Trace);
-    MonotonicStopWatch watch;
-    watch.start();
-    SCOPED_CLEANUP({
-        if (watch.elapsed_time() / 1e9 > config::cumulative_compaction_trace_threshold) {
-            LOG(INFO) << "Trace:" << std::endl << trace->DumpToString(Trace::INCLUDE_ALL);
-        }
-    });
-    ADOPT_TRACE(trace.get());
-    TRACE("start to perform cumulative compaction");
-    TabletSharedPtr best_tablet =
-            _tablet_manager->find_best_tablet_to_compaction(CompactionType::CUMULATIVE_COMPACTION, data_dir);
-    if (best_tablet == nullptr) {
-        return Status::NotFound("there are no suitable tablets");
-    }
-    TRACE("found best tablet $0", best_tablet->get_tablet_info().tablet_id);
-
-    StarRocksMetrics::instance()->cumulative_compaction_request_total.increment(1);
-    vectorized::CumulativeCompaction cumulative_compaction(_options.compaction_mem_tracker, best_tablet);
-
-    Status res = cumulative_compaction.compact();
-    if (!res.ok()) {
-        best_tablet->set_last_cumu_compaction_failure_time(UnixMillis());
-        if (!res.is_not_found()) {
-            StarRocksMetrics::instance()->cumulative_compaction_request_failed.increment(1);
-            LOG(WARNING) << "Fail to vectorized compact table=" << best_tablet->full_name()
-                         << ", err=" << res.to_string();
-        }
-        return res;
-    }
-
-    best_tablet->set_last_cumu_compaction_failure_time(0);
-    return Status::OK();
-}
-
-Status StorageEngine::_perform_base_compaction(DataDir* data_dir) {
-    scoped_refptr<Trace> trace(new Trace);
-    MonotonicStopWatch watch;
-    watch.start();
-    SCOPED_CLEANUP({
-        if (watch.elapsed_time() / 1e9 > config::base_compaction_trace_threshold) {
-            LOG(INFO) << "Trace:" << std::endl << trace->DumpToString(Trace::INCLUDE_ALL);
-        }
-    });
-    ADOPT_TRACE(trace.get());
-    TRACE("start to perform base compaction");
-    TabletSharedPtr best_tablet =
-            _tablet_manager->find_best_tablet_to_compaction(CompactionType::BASE_COMPACTION, data_dir);
-    if (best_tablet == nullptr) {
-        return Status::NotFound("there are no suitable tablets");
-    }
-    TRACE("found best tablet $0", best_tablet->get_tablet_info().tablet_id);
-
-    StarRocksMetrics::instance()->base_compaction_request_total.increment(1);
-    vectorized::BaseCompaction base_compaction(_options.compaction_mem_tracker, best_tablet);
-    Status res = base_compaction.compact();
-    if (!res.ok()) {
-        best_tablet->set_last_base_compaction_failure_time(UnixMillis());
-        if (!res.is_not_found()) {
-            StarRocksMetrics::instance()->base_compaction_request_failed.increment(1);
-            LOG(WARNING) << "failed to init vectorized base compaction. res=" << res.to_string()
-                         << ", table=" << best_tablet->full_name();
-        }
-        return res;
-    }
-
-    best_tablet->set_last_base_compaction_failure_time(0);
-    return Status::OK();
-}
-
 Status StorageEngine::_perform_update_compaction(DataDir* data_dir) {
     scoped_refptr<Trace> trace(new Trace);
     MonotonicStopWatch watch;
@@ -610,6 +559,10 @@ Status StorageEngine::_perform_update_compaction(DataDir* data_dir) {
         res = best_tablet->updates()->compaction(_options.compaction_mem_tracker);
     }
     StarRocksMetrics::instance()->update_compaction_duration_us.increment(duration_ns / 1000);
+    if (res.is_already_exist()) {
+        // picked by another compaction thread of the disk at the same time, try the next tablet.
+        return Status::OK();
+    }
     if (!res.ok()) {
         StarRocksMetrics::instance()->update_compaction_request_failed.increment(1);
         LOG(WARNING) << "failed to perform update compaction. res=" << res.to_string()
@@ -670,9 +623,77 @@ OLAPStatus StorageEngine::_start_trash_sweep(double* usage) {
     // clean unused rowset metas in KVStore
     _clean_unused_rowset_metas();
 
+    _sweep_orphan_cold_files(now, trash_expire);
+
     return res;
 }
 
+// The cold files of the dropped tablets, and the ones left when cold_column_storage_path was cleared before their
+// rowsets were removed, are referred by no rowset. Wait |expire| seconds before removing them, like the trash.
+void StorageEngine::_sweep_orphan_cold_files(time_t now, int32_t expire) {
+    const std::string cold_root = config::cold_column_storage_path;
+    if (cold_root.empty() || !FileUtils::check_exist(cold_root)) {
+        return;
+    }
+    std::set<std::string> tablet_dirs;
+    Status st = FileUtils::list_dirs_files(cold_root, &tablet_dirs, nullptr, Env::Default());
+    if (!st.ok()) {
+        LOG(WARNING) << "Fail to list cold column storage path " << cold_root << ": " << st;
+        return;
+    }
+    for (const auto& tablet_dir : tablet_dirs) {
+        std::string tablet_path = cold_root + "/" + tablet_dir;
+        int64_t tablet_id = 0;
+        std::set<std::string> schema_hash_dirs;
+        bool has_tablet = false;
+        if (!safe_strto64(tablet_dir, &tablet_id) ||
+            !FileUtils::list_dirs_files(tablet_path, &schema_hash_dirs, nullptr, Env::Default()).ok()) {
+            continue;
+        }
+        for (const auto& schema_hash_dir : schema_hash_dirs) {
+            std::string schema_hash_path = tablet_path + "/" + schema_hash_dir;
+            int32_t schema_hash = 0;
+            std::set<std::string> files;
+            if (!safe_strto32(schema_hash_dir, &schema_hash) ||
+                !FileUtils::list_dirs_files(schema_hash_path, nullptr, &files, Env::Default()).ok()) {
+                continue;
+            }
+            // like the path gc, the files of a deleted tablet are kept until the tablet is garbage collected.
+            TabletSharedPtr tablet = _tablet_manager->get_tablet(tablet_id, schema_hash, true);
+            for (const auto& file : files) {
+                // eg: 0200000000000004f94ff0a2e6b8a9a9e0f8d1b2c3d4e5f6_0.cold
+                size_t pos = file.find('_');
+                if (pos == std::string::npos || !boost::algorithm::ends_with(file, ".cold")) {
+                    continue;
+                }
+                std::string path = schema_hash_path + "/" + file;
+                struct stat file_stat;
+                if (::stat(path.c_str(), &file_stat) != 0 || difftime(now, file_stat.st_mtime) < expire) {
+                    continue;
+                }
+                RowsetId rowset_id;
+                rowset_id.init(file.substr(0, pos));
+                if (tablet != nullptr &&
+                    (tablet->check_rowset_id(rowset_id) || check_rowset_id_in_unused_rowsets(rowset_id))) {
+                    continue;
+                }
+                LOG(INFO) << "Removing orphan cold file " << path;
+                st = FileUtils::remove(path);
+                LOG_IF(WARNING, !st.ok()) << "Fail to remove orphan cold file " << path << ": " << st;
+            }
+            if (tablet == nullptr) {
+                // fails if the directory is not empty.
+                ::rmdir(schema_hash_path.c_str());
+            } else {
+                has_tablet = true;
+            }
+        }
+        if (!has_tablet) {
+            ::rmdir(tablet_path.c_str());
+        }
+    }
+}
+
 void StorageEngine::_clean_unused_rowset_metas() {
     std::vector<RowsetMetaSharedPtr> invalid_rowset_metas;
     auto clean_rowset_func = [this, &invalid_rowset_metas](const TabletUid& tablet_uid, RowsetId rowset_id,
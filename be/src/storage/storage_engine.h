@@ -33,6 +33,7 @@
 #include <set>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -58,8 +59,10 @@ namespace starrocks {
 class DataDir;
 class EngineTask;
 class BlockManager;
+class CompactionScheduler;
 class MemTableFlushExecutor;
 class Tablet;
+class ThreadPool;
 class UpdateManager;
 
 // StorageEngine singleton to manage all Table pointers.
@@ -157,6 +160,9 @@ public:
     MemTableFlushExecutor* memtable_flush_executor() { return _memtable_flush_executor.get(); }
     fs::BlockManager* block_manager() { return _block_manager.get(); }
     UpdateManager* update_manager() { return _update_manager.get(); }
+    CompactionScheduler* compaction_scheduler() { return _compaction_scheduler.get(); }
+    // the threads shared by the storage tasks running their work in parallel, see util/parallel_for.h.
+    ThreadPool* parallel_task_pool() { return _parallel_task_pool.get(); }
 
     bool check_rowset_id_in_unused_rowsets(const RowsetId& rowset_id);
 
@@ -194,6 +200,9 @@ private:
 
     void _clean_unused_rowset_metas();
 
+    // remove the files under config::cold_column_storage_path not referred by any rowset for |expire| seconds.
+    void _sweep_orphan_cold_files(time_t now, int32_t expire);
+
     OLAPStatus _do_sweep(const std::string& scan_root, const time_t& local_tm_now, const int32_t expire);
 
     // All these xxx_callback() functions are for Background threads
@@ -203,10 +212,6 @@ private:
     // unused rowset monitor thread
     void* _unused_rowset_monitor_thread_callback(void* arg);
 
-    // base compaction thread process function
-    void* _base_compaction_thread_callback(void* arg, DataDir* data_dir);
-    // cumulative process function
-    void* _cumulative_compaction_thread_callback(void* arg, DataDir* data_dir);
     // update compaction function
     void* _update_compaction_thread_callback(void* arg, DataDir* data_dir);
 
@@ -226,37 +231,24 @@ private:
 
     void* _tablet_checkpoint_callback(void* arg);
 
+    // migrate the cold tablets from the SSD data dirs to the HDD data dirs
+    void* _tiered_storage_migration_thread_callback(void* arg);
+
     void _start_clean_fd_cache();
-    Status _perform_cumulative_compaction(DataDir* data_dir);
-    Status _perform_base_compaction(DataDir* data_dir);
     Status _perform_update_compaction(DataDir* data_dir);
+    // Update the query heat of the tablets on the SSD data dirs, and if |migrate| is true, migrate at most
+    // tiered_storage_migration_max_tablets_per_round cold tablets to the HDD data dirs.
+    void _perform_tiered_storage_migration(bool migrate);
+    // Whether |hour| is in [start_hour, end_hour), which wraps around midnight if start_hour > end_hour.
+    static bool _in_tiered_storage_migration_window(int32_t hour, int32_t start_hour, int32_t end_hour);
+    // Update the query heat of |tablets|, and append the cold ones with the time of their newest data to
+    // |cold_tablets|, the coldest first. A tablet missing from |tablets| loses its heat.
+    void _collect_cold_tablets(const std::vector<TabletSharedPtr>& tablets, int64_t now,
+                               std::vector<std::pair<int64_t, TabletSharedPtr>>* cold_tablets);
     OLAPStatus _start_trash_sweep(double* usage);
     void _start_disk_stat_monitor();
 
 private:
-    struct CompactionCandidate {
-        CompactionCandidate(uint32_t nicumulative_compaction_, int64_t tablet_id_, uint32_t index_)
-                : nice(nicumulative_compaction_), tablet_id(tablet_id_), disk_index(index_) {}
-        uint32_t nice;
-        int64_t tablet_id;
-        uint32_t disk_index = -1;
-    };
-
-    // In descending order
-    struct CompactionCandidateComparator {
-        bool operator()(const CompactionCandidate& a, const CompactionCandidate& b) { return a.nice > b.nice; }
-    };
-
-    struct CompactionDiskStat {
-        CompactionDiskStat(std::string path, uint32_t index, bool used)
-                : storage_path(std::move(path)), disk_index(index), task_running(0), task_remaining(0), is_used(used) {}
-        const std::string storage_path;
-        const uint32_t disk_index;
-        uint32_t task_running;
-        uint32_t task_remaining;
-        bool is_used;
-    };
-
     EngineOptions _options;
     std::mutex _store_lock;
     std::map<std::string, DataDir*> _store_map;
@@ -291,10 +283,8 @@ private:
     std::thread _garbage_sweeper_thread;
     // thread to monitor disk stat
     std::thread _disk_stat_monitor_thread;
-    // threads to run base compaction
-    std::vector<std::thread> _base_compaction_threads;
-    // threads to check cumulative
-    std::vector<std::thread> _cumulative_compaction_threads;
+    // picks and runs the base and cumulative compactions of all the data dirs
+    std::unique_ptr<CompactionScheduler> _compaction_scheduler;
     // threads to run update compaction
     std::vector<std::thread> _update_compaction_threads;
     // threads to clean all file descriptor not actively in use
@@ -304,6 +294,10 @@ private:
     std::vector<std::thread> _path_scan_threads;
     // threads to run tablet checkpoint
     std::vector<std::thread> _tablet_checkpoint_threads;
+    // thread to migrate the cold tablets from SSD to HDD
+    std::thread _tiered_storage_migration_thread;
+    // query counts of the tablets on the SSD data dirs seen in the previous round of tiered storage migration
+    std::unordered_map<int64_t, int64_t> _tiered_storage_query_counts;
 
     // For tablet and disk-stat report
     std::mutex _report_mtx;
@@ -324,6 +318,8 @@ private:
 
     std::unique_ptr<UpdateManager> _update_manager;
 
+    std::unique_ptr<ThreadPool> _parallel_task_pool;
+
     HeartbeatFlags* _heartbeat_flags = nullptr;
 
     StorageEngine(const StorageEngine&) = delete;
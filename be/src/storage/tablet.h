@@ -213,6 +213,11 @@ public:
     int64_t last_base_compaction_success_time() { return _last_base_compaction_success_millis; }
     void set_last_base_compaction_success_time(int64_t millis) { _last_base_compaction_success_millis = millis; }
 
+    // number of queries which have scanned this tablet, used by CompactionScheduler to
+    // prefer compacting the tablets being read
+    int64_t query_count() const { return _query_count; }
+    void increase_query_count() { _query_count.fetch_add(1, std::memory_order_relaxed); }
+
     void delete_all_files();
 
     bool check_rowset_id(const RowsetId& rowset_id);
@@ -319,6 +324,8 @@ private:
     // timestamp of last base compaction success
     std::atomic<int64_t> _last_base_compaction_success_millis{0};
 
+    std::atomic<int64_t> _query_count{0};
+
     std::atomic<int64_t> _cumulative_point{0};
     std::atomic<int32_t> _newly_created_rowset_num{0};
     std::atomic<int64_t> _last_checkpoint_time{0};
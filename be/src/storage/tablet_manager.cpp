@@ -609,12 +609,10 @@ void TabletManager::get_tablet_stat(TTabletStatResult* result) {
     result->__set_tablets_stats(_tablet_stat_cache);
 }
 
-TabletSharedPtr TabletManager::find_best_tablet_to_compaction(CompactionType compaction_type, DataDir* data_dir) {
+void TabletManager::pick_tablets_to_compaction(CompactionType compaction_type,
+                                               std::vector<std::pair<TabletSharedPtr, uint32_t>>* tablets_with_score) {
     int64_t now_ms = UnixMillis();
     const std::string& compaction_type_str = compaction_type == CompactionType::BASE_COMPACTION ? "base" : "cumulative";
-    // only do compaction if compaction #rowset > 1
-    uint32_t highest_score = 1;
-    TabletSharedPtr best_tablet;
     for (const auto& tablets_shard : _tablets_shards) {
         std::shared_lock rlock(*tablets_shard.lock);
         for (const auto& tablet_map : tablets_shard.tablet_map) {
@@ -637,8 +635,7 @@ TabletSharedPtr TabletManager::find_best_tablet_to_compaction(CompactionType com
                     continue;
                 }
 
-                if (tablet_ptr->data_dir()->path_hash() != data_dir->path_hash() || !tablet_ptr->is_used() ||
-                    !tablet_ptr->init_succeeded() || !tablet_ptr->can_do_compaction()) {
+                if (!tablet_ptr->is_used() || !tablet_ptr->init_succeeded() || !tablet_ptr->can_do_compaction()) {
                     continue;
                 }
 
@@ -674,27 +671,13 @@ TabletSharedPtr TabletManager::find_best_tablet_to_compaction(CompactionType com
                         table_score = tablet_ptr->calc_cumulative_compaction_score();
                     }
                 }
-                if (table_score > highest_score) {
-                    highest_score = table_score;
-                    best_tablet = tablet_ptr;
+                // only do compaction if compaction #rowset > 1
+                if (table_score > 1) {
+                    tablets_with_score->emplace_back(tablet_ptr, table_score);
                 }
             }
         }
     }
-
-    if (best_tablet != nullptr) {
-        LOG(INFO) << "Found the best tablet to compact. "
-                  << "compaction_type=" << compaction_type_str << " tablet_id=" << best_tablet->tablet_id()
-                  << " highest_score=" << highest_score;
-        // TODO(lingbin): Remove 'max' from metric name, it would be misunderstood as the
-        // biggest in history(like peak), but it is really just the value at current moment.
-        if (compaction_type == CompactionType::BASE_COMPACTION) {
-            StarRocksMetrics::instance()->tablet_base_max_compaction_score.set_value(highest_score);
-        } else {
-            StarRocksMetrics::instance()->tablet_cumulative_max_compaction_score.set_value(highest_score);
-        }
-    }
-    return best_tablet;
 }
 
 TabletSharedPtr TabletManager::find_best_tablet_to_do_update_compaction(DataDir* data_dir) {
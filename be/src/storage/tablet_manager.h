@@ -66,7 +66,10 @@ public:
 
     Status drop_tablets_on_error_root_path(const std::vector<TabletInfo>& tablet_info_vec);
 
-    TabletSharedPtr find_best_tablet_to_compaction(CompactionType compaction_type, DataDir* data_dir);
+    // Collect the tablets on all the data dirs which can do a compaction of |compaction_type| now,
+    // along with their compaction scores. Used by CompactionScheduler to build its queue.
+    void pick_tablets_to_compaction(CompactionType compaction_type,
+                                    std::vector<std::pair<TabletSharedPtr, uint32_t>>* tablets_with_score);
 
     TabletSharedPtr find_best_tablet_to_do_update_compaction(DataDir* data_dir);
 
@@ -377,20 +377,35 @@ Status TabletMeta::save(const string& file_path, const TabletMetaPB& tablet_meta
 }
 
 Status TabletMeta::save_meta(DataDir* data_dir) {
-    std::unique_lock wrlock(_meta_lock);
-    return _save_meta(data_dir);
+    // The meta is serialized and queued under the lock, so the saves of this tablet are written
+    // in order, but the write itself is done out of the lock and grouped with the saves of the
+    // other tablets on the same data dir.
+    std::shared_ptr<QueuedWriteBatch> queued;
+    {
+        std::unique_lock wrlock(_meta_lock);
+        RETURN_IF_ERROR(_save_meta(data_dir, &queued));
+    }
+    Status st = data_dir->get_meta()->wait_batch(queued);
+    LOG_IF(FATAL, !st.ok()) << "fail to save tablet meta:" << st << ". tablet_id=" << tablet_id()
+                            << ", schema_hash=" << schema_hash();
+    return st;
 }
 
-Status TabletMeta::_save_meta(DataDir* data_dir) {
+Status TabletMeta::_save_meta(DataDir* data_dir, std::shared_ptr<QueuedWriteBatch>* queued) {
     LOG_IF(FATAL, _tablet_uid.hi == 0 && _tablet_uid.lo == 0)
             << "tablet_uid is invalid"
             << " tablet=" << full_name() << " _tablet_uid=" << _tablet_uid.to_string();
     TabletMetaPB tablet_meta_pb;
     to_meta_pb(&tablet_meta_pb);
-    Status st = TabletMetaManager::save(data_dir, tablet_id(), schema_hash(), tablet_meta_pb);
-    LOG_IF(FATAL, !st.ok()) << "fail to save tablet meta:" << st << ". tablet_id=" << tablet_id()
-                            << ", schema_hash=" << schema_hash();
-    return st;
+    WriteBatch batch;
+    Status st = TabletMetaManager::save(data_dir, &batch, tablet_id(), schema_hash(), tablet_meta_pb);
+    if (!st.ok()) {
+        LOG(FATAL) << "fail to save tablet meta:" << st << ". tablet_id=" << tablet_id()
+                   << ", schema_hash=" << schema_hash();
+        return st;
+    }
+    *queued = data_dir->get_meta()->queue_batch(std::move(batch));
+    return Status::OK();
 }
 
 Status TabletMeta::serialize(string* meta_binary) {
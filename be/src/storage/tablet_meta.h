@@ -70,6 +70,7 @@ enum TabletState {
 class RowsetMeta;
 class Rowset;
 class DataDir;
+struct QueuedWriteBatch;
 class TabletMeta;
 using TabletMetaSharedPtr = std::shared_ptr<TabletMeta>;
 class TabletUpdates;
@@ -218,7 +219,8 @@ public:
     }
 
 private:
-    Status _save_meta(DataDir* data_dir);
+    // Serialize the meta and queue it to be written to the meta store of |data_dir|.
+    Status _save_meta(DataDir* data_dir, std::shared_ptr<QueuedWriteBatch>* queued);
 
     static int64_t calc_mem_usage_of_rs_metas(const std::vector<RowsetMetaSharedPtr>& rs_metas) {
         int64_t mem_usage = 0;
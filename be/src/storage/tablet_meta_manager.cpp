@@ -374,6 +374,14 @@ Status TabletMetaManager::save(DataDir* store, TTabletId tablet_id, TSchemaHash
 
 Status TabletMetaManager::save(DataDir* store, TTabletId tablet_id, TSchemaHash schema_hash,
                                const TabletMetaPB& meta_pb) {
+    WriteBatch batch;
+    RETURN_IF_ERROR(save(store, &batch, tablet_id, schema_hash, meta_pb));
+    KVStore* meta = store->get_meta();
+    return meta->wait_batch(meta->queue_batch(std::move(batch)));
+}
+
+Status TabletMetaManager::save(DataDir* store, WriteBatch* batch, TTabletId tablet_id, TSchemaHash schema_hash,
+                               const TabletMetaPB& meta_pb) {
     if (meta_pb.schema().keys_type() != KeysType::PRIMARY_KEYS && meta_pb.has_updates()) {
         return Status::InvalidArgument("non primary key with updates");
     }
@@ -385,9 +393,8 @@ Status TabletMetaManager::save(DataDir* store, TTabletId tablet_id, TSchemaHash
         LOG(FATAL) << "deserialize from previous serialize result failed";
     }
 
-    rocksdb::WriteBatch batch;
     rocksdb::ColumnFamilyHandle* cf = store->get_meta()->handle(META_COLUMN_FAMILY_INDEX);
-    rocksdb::Status st = batch.Put(cf, key, val);
+    rocksdb::Status st = batch->Put(cf, key, val);
     if (!st.ok()) {
         return to_status(st);
     }
@@ -395,12 +402,12 @@ Status TabletMetaManager::save(DataDir* store, TTabletId tablet_id, TSchemaHash
     if (meta_pb.has_updates() && meta_pb.updates().has_next_log_id()) {
         std::string lower = encode_meta_log_key(tablet_id, 0);
         std::string upper = encode_meta_log_key(tablet_id, meta_pb.updates().next_log_id());
-        st = batch.DeleteRange(cf, lower, upper);
+        st = batch->DeleteRange(cf, lower, upper);
         if (!st.ok()) {
             return to_status(st);
         }
     }
-    return store->get_meta()->write_batch(&batch);
+    return Status::OK();
 }
 
 Status TabletMetaManager::remove(DataDir* store, TTabletId tablet_id, TSchemaHash schema_hash) {
@@ -741,7 +748,8 @@ Status TabletMetaManager::rowset_iterate(DataDir* store, TTabletId tablet_id, co
 
 Status TabletMetaManager::apply_rowset_commit(DataDir* store, TTabletId tablet_id, int64_t logid,
                                               const EditVersion& version,
-                                              vector<std::pair<uint32_t, DelVectorPtr>>& delvecs) {
+                                              vector<std::pair<uint32_t, DelVectorPtr>>& delvecs,
+                                              const RowsetMetaPB* rowset) {
     WriteBatch batch;
     auto handle = store->get_meta()->handle(META_COLUMN_FAMILY_INDEX);
     TabletMetaLogPB log;
@@ -769,6 +777,13 @@ Status TabletMetaManager::apply_rowset_commit(DataDir* store, TTabletId tablet_i
             return to_status(st);
         }
     }
+    if (rowset != nullptr) {
+        st = batch.Put(handle, encode_meta_rowset_key(tablet_id, rowset->rowset_seg_id()), rowset->SerializeAsString());
+        if (!st.ok()) {
+            LOG(WARNING) << "rowset_commit failed, rocksdb.batch.put failed";
+            return to_status(st);
+        }
+    }
     return store->get_meta()->write_batch(&batch);
 }
 
@@ -92,6 +92,10 @@ public:
 
     static Status save(DataDir* store, TTabletId tablet_id, TSchemaHash schema_hash, const TabletMetaPB& meta_pb);
 
+    // Add the writes of saving |meta_pb| to |batch| instead of writing them.
+    static Status save(DataDir* store, WriteBatch* batch, TTabletId tablet_id, TSchemaHash schema_hash,
+                       const TabletMetaPB& meta_pb);
+
     static Status remove(DataDir* store, TTabletId tablet_id, TSchemaHash schema_hash);
 
     static Status traverse_headers(KVStore* meta, std::function<bool(long, long, const std::string&)> const& func);
@@ -134,9 +138,11 @@ public:
     // All delete vectors that associated with this rowset will be deleted too.
     static Status rowset_delete(DataDir* store, TTabletId tablet_id, uint32_t rowset_id, uint32_t segments);
 
-    // update meta after state of a rowset commit is applied
+    // update meta after state of a rowset commit is applied, |rowset| replaces the meta of the
+    // rowset applied if it's not null.
     static Status apply_rowset_commit(DataDir* store, TTabletId tablet_id, int64_t logid, const EditVersion& version,
-                                      std::vector<std::pair<uint32_t, DelVectorPtr>>& delvecs);
+                                      std::vector<std::pair<uint32_t, DelVectorPtr>>& delvecs,
+                                      const RowsetMetaPB* rowset = nullptr);
 
     // traverse all the op logs for a tablet
     static Status traverse_meta_logs(DataDir* store, TTabletId tablet_id,
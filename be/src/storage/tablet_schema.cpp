@@ -451,6 +451,18 @@ bool TabletSchema::contains_format_v2_column() const {
     return std::any_of(_cols.begin(), _cols.end(), [](const TabletColumn& col) { return col.is_format_v2_column(); });
 }
 
+std::unique_ptr<TabletSchema> TabletSchema::create_partial(const std::vector<int32_t>& column_indexes) const {
+    TabletSchemaPB schema_pb;
+    to_schema_pb(&schema_pb);
+    // not the schema of the tablet any more.
+    schema_pb.clear_id();
+    schema_pb.clear_column();
+    for (int32_t cid : column_indexes) {
+        column(cid).to_schema_pb(schema_pb.add_column());
+    }
+    return std::make_unique<TabletSchema>(schema_pb);
+}
+
 std::unique_ptr<TabletSchema> TabletSchema::convert_to_format(DataFormatVersion format) const {
     TabletSchemaPB schema_pb;
     to_schema_pb(&schema_pb);
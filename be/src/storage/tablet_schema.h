@@ -249,6 +249,9 @@ public:
 
     std::unique_ptr<TabletSchema> convert_to_format(DataFormatVersion format) const;
 
+    // Returns the schema of only the columns |column_indexes|, in their order.
+    std::unique_ptr<TabletSchema> create_partial(const std::vector<int32_t>& column_indexes) const;
+
     std::string debug_string() const;
 
     int64_t mem_usage() const {
@@ -16,10 +16,13 @@
 #include "runtime/exec_env.h"
 #include "storage/del_vector.h"
 #include "storage/primary_key_encoder.h"
+#include "storage/rowset/beta_rowset.h"
 #include "storage/rowset/rowset_factory.h"
 #include "storage/rowset/rowset_meta_manager.h"
 #include "storage/rowset/rowset_writer.h"
 #include "storage/rowset/rowset_writer_context.h"
+#include "storage/rowset/segment_v2/column_reader.h"
+#include "storage/rowset/segment_v2/segment.h"
 #include "storage/rowset/vectorized/rowset_options.h"
 #include "storage/rowset_update_state.h"
 #include "storage/snapshot_meta.h"
@@ -664,6 +667,11 @@ void TabletUpdates::do_apply() {
         if (_error) {
             break;
         }
+        if (config::primary_index_snapshot_interval_versions > 0 &&
+            ++_applied_since_index_snapshot >= config::primary_index_snapshot_interval_versions) {
+            _save_primary_index_snapshot();
+            _applied_since_index_snapshot = 0;
+        }
     }
     std::lock_guard<std::mutex> lg(_apply_running_lock);
     CHECK(_apply_running) << "illegal state: _apply_running should be true";
@@ -679,6 +687,20 @@ void TabletUpdates::_stop_and_wait_apply_done() {
     }
 }
 
+void TabletUpdates::_save_primary_index_snapshot() {
+    auto manager = StorageEngine::instance()->update_manager();
+    // not worth loading the index only to save it
+    auto index_entry = manager->index_cache().get(_tablet.tablet_id());
+    if (index_entry == nullptr) {
+        return;
+    }
+    auto st = index_entry->value().save_snapshot(&_tablet);
+    if (!st.ok()) {
+        LOG(WARNING) << "save primary index snapshot failed tablet:" << _tablet.tablet_id() << " " << st;
+    }
+    manager->index_cache().release(index_entry);
+}
+
 void TabletUpdates::_apply_rowset_commit(const EditVersionInfo& version_info) {
     // NOTE: after commit, apply must success or fatal crash
     int64_t t_start = MonotonicMillis();
@@ -716,6 +738,21 @@ void TabletUpdates::_apply_rowset_commit(const EditVersionInfo& version_info) {
         _set_error();
         return;
     }
+    // the columns not loaded by a partial update are filled from the latest rows before the index is
+    // updated, the rows are rewritten to a full rowset, which replaces the partial one by this apply.
+    RowsetSharedPtr full_rowset;
+    if (rowset->rowset_meta()->is_partial_update()) {
+        st = state.rewrite_partial_update(&_tablet, rowset.get(), index, &full_rowset);
+        if (!st.ok()) {
+            LOG(ERROR) << "_apply_rowset_commit error: rewrite partial update failed: " << st << " "
+                       << debug_string();
+            manager->update_state_cache().remove(state_entry);
+            manager->index_cache().release(index_entry);
+            _set_error();
+            return;
+        }
+        full_rowset->make_commit(version.major(), rowset_id);
+    }
     int64_t t_load = MonotonicMillis();
 
     // 3. generate delvec
@@ -727,6 +764,7 @@ void TabletUpdates::_apply_rowset_commit(const EditVersionInfo& version_info) {
     size_t old_total_del = 0;
     size_t total_del = 0;
     size_t new_del = 0;
+    std::unique_lock il(_index_lock);
     auto& upserts = state.upserts();
     for (uint32_t i = 0; i < upserts.size(); i++) {
         if (upserts[i] != nullptr) {
@@ -831,12 +869,29 @@ void TabletUpdates::_apply_rowset_commit(const EditVersionInfo& version_info) {
     {
         std::lock_guard wl(_lock);
         // 4. write meta
-        st = TabletMetaManager::apply_rowset_commit(_tablet.data_dir(), tablet_id, _next_log_id, version, new_del_vecs);
+        st = TabletMetaManager::apply_rowset_commit(
+                _tablet.data_dir(), tablet_id, _next_log_id, version, new_del_vecs,
+                full_rowset != nullptr ? &full_rowset->rowset_meta()->get_meta_pb() : nullptr);
         if (!st.ok()) {
             LOG(ERROR) << "_apply_rowset_commit error: write meta failed: " << st << " " << _debug_string(false);
             _set_error();
             return;
         }
+        if (full_rowset != nullptr) {
+            {
+                std::lock_guard<std::mutex> lg(_rowsets_lock);
+                _rowsets[rowset_id] = full_rowset;
+            }
+            {
+                std::lock_guard lg(_rowset_stats_lock);
+                auto iter = _rowset_stats.find(rowset_id);
+                if (iter != _rowset_stats.end()) {
+                    iter->second->byte_size = full_rowset->data_disk_size();
+                }
+            }
+            // only the files are removed, the meta is replaced by the full rowset.
+            StorageEngine::instance()->add_unused_rowset(rowset);
+        }
         // put delvec in cache
         TabletSegmentId tsid;
         tsid.tablet_id = tablet_id;
@@ -849,6 +904,7 @@ void TabletUpdates::_apply_rowset_commit(const EditVersionInfo& version_info) {
         _apply_version_idx++;
         _apply_version_changed.notify_all();
     }
+    il.unlock();
     _update_total_stats(version_info.rowsets);
     int64_t t_write = MonotonicMillis();
 
@@ -863,6 +919,142 @@ void TabletUpdates::_apply_rowset_commit(const EditVersionInfo& version_info) {
     VLOG(1) << "rowset commit apply " << delvec_change_info << " " << _debug_string(true, true);
 }
 
+Status TabletUpdates::get_column_values(const std::vector<uint32_t>& column_ids,
+                                        const std::map<uint32_t, std::vector<uint32_t>>& rowids_by_rssid,
+                                        std::vector<std::unique_ptr<vectorized::Column>>* columns) {
+    DCHECK_EQ(column_ids.size(), columns->size());
+    auto block_manager = fs::fs_util::block_manager();
+    OlapReaderStatistics stats;
+    for (const auto& [rssid, rowids] : rowids_by_rssid) {
+        uint32_t rowset_id = 0;
+        {
+            std::lock_guard lg(_rowset_stats_lock);
+            auto iter = _rowset_stats.upper_bound(rssid);
+            if (iter != _rowset_stats.begin()) {
+                --iter;
+            }
+            if (iter == _rowset_stats.end() || rssid < iter->first ||
+                rssid >= iter->first + iter->second->num_segments) {
+                return Status::InternalError(Substitute("get_column_values: segment not found tablet:$0 rssid:$1",
+                                                        _tablet.tablet_id(), rssid));
+            }
+            rowset_id = iter->first;
+        }
+        auto rowset = _get_rowset(rowset_id);
+        if (rowset == nullptr) {
+            return Status::InternalError(Substitute("get_column_values: rowset not found tablet:$0 rowset:$1",
+                                                    _tablet.tablet_id(), rowset_id));
+        }
+        RETURN_IF_ERROR(rowset->load());
+        RowsetReleaseGuard guard(rowset);
+        const auto& segment = down_cast<BetaRowset*>(rowset.get())->segments()[rssid - rowset_id];
+        std::unique_ptr<fs::ReadableBlock> rblock;
+        RETURN_IF_ERROR(block_manager->open_block(segment->file_name(), &rblock));
+        for (size_t i = 0; i < column_ids.size(); i++) {
+            segment_v2::ColumnIterator* raw_iter = nullptr;
+            RETURN_IF_ERROR(segment->new_column_iterator(column_ids[i], &raw_iter));
+            std::unique_ptr<segment_v2::ColumnIterator> iter(raw_iter);
+            segment_v2::ColumnIteratorOptions iter_opts;
+            iter_opts.stats = &stats;
+            iter_opts.rblock = rblock.get();
+            iter_opts.use_page_cache = !config::disable_storage_page_cache;
+            RETURN_IF_ERROR(iter->init(iter_opts));
+            RETURN_IF_ERROR(iter->fetch_values_by_rowid(rowids.data(), rowids.size(), (*columns)[i].get()));
+        }
+    }
+    return Status::OK();
+}
+
+Status TabletUpdates::get_rows_by_keys(const vectorized::Chunk& keys, int64_t min_version, int64_t timeout_ms,
+                                       const std::vector<uint32_t>& column_ids, std::vector<bool>* found,
+                                       std::vector<std::unique_ptr<vectorized::Column>>* columns,
+                                       int64_t* read_version) {
+    DCHECK_EQ(column_ids.size(), columns->size());
+    const TabletSchema& tablet_schema = _tablet.tablet_schema();
+    std::vector<ColumnId> key_cids(tablet_schema.num_key_columns());
+    for (uint32_t i = 0; i < key_cids.size(); i++) {
+        key_cids[i] = i;
+    }
+    if (keys.num_columns() != key_cids.size()) {
+        return Status::InvalidArgument(Substitute("get_rows_by_keys: expect $0 key columns, got $1", key_cids.size(),
+                                                  keys.num_columns()));
+    }
+    for (uint32_t cid : column_ids) {
+        if (cid >= tablet_schema.num_columns()) {
+            return Status::InvalidArgument(Substitute("get_rows_by_keys: invalid column id $0", cid));
+        }
+    }
+    auto key_schema = ChunkHelper::convert_schema_to_format_v2(tablet_schema, key_cids);
+    std::unique_ptr<vectorized::Column> pks;
+    RETURN_IF_ERROR(PrimaryKeyEncoder::create_column(key_schema, &pks));
+    PrimaryKeyEncoder::encode(key_schema, keys, 0, keys.num_rows(), pks.get());
+
+    if (min_version > 0) {
+        RETURN_IF_ERROR(_wait_for_version(EditVersion(min_version, 0), timeout_ms));
+    }
+    std::shared_lock il(_index_lock);
+    if (_error) {
+        return Status::InternalError(Substitute("get_rows_by_keys: tablet in error state tablet:$0",
+                                                _tablet.tablet_id()));
+    }
+    auto manager = StorageEngine::instance()->update_manager();
+    auto index_entry = manager->index_cache().get_or_create(_tablet.tablet_id());
+    index_entry->update_expire_time(MonotonicMillis() + manager->get_cache_expire_ms());
+    auto& index = index_entry->value();
+    auto st = index.load(&_tablet);
+    manager->index_cache().update_object_size(index_entry, index.memory_usage());
+    if (!st.ok()) {
+        manager->index_cache().remove(index_entry);
+        return st;
+    }
+    std::vector<uint64_t> rowids;
+    index.get(*pks, &rowids);
+    manager->index_cache().release(index_entry);
+    {
+        std::lock_guard rl(_lock);
+        *read_version = _versions[_apply_version_idx]->version.major();
+    }
+
+    std::map<uint32_t, std::vector<uint32_t>> rowids_by_rssid;
+    found->resize(rowids.size());
+    for (size_t i = 0; i < rowids.size(); i++) {
+        (*found)[i] = rowids[i] != PrimaryIndex::NOT_FOUND;
+        if ((*found)[i]) {
+            rowids_by_rssid[(uint32_t)(rowids[i] >> 32)].push_back((uint32_t)(rowids[i] & 0xFFFFFFFF));
+        }
+    }
+    std::map<uint32_t, uint32_t> rssid_base;
+    uint32_t num_values = 0;
+    for (auto& [rssid, segment_rowids] : rowids_by_rssid) {
+        std::sort(segment_rowids.begin(), segment_rowids.end());
+        segment_rowids.erase(std::unique(segment_rowids.begin(), segment_rowids.end()), segment_rowids.end());
+        rssid_base[rssid] = num_values;
+        num_values += segment_rowids.size();
+    }
+    // the values are read in the order of the segments and the rowids, then put in the order of the keys.
+    std::vector<uint32_t> value_idxes;
+    value_idxes.reserve(rowids.size());
+    for (uint64_t v : rowids) {
+        if (v != PrimaryIndex::NOT_FOUND) {
+            auto rssid = (uint32_t)(v >> 32);
+            const auto& segment_rowids = rowids_by_rssid[rssid];
+            auto pos = std::lower_bound(segment_rowids.begin(), segment_rowids.end(), (uint32_t)(v & 0xFFFFFFFF)) -
+                       segment_rowids.begin();
+            value_idxes.push_back(rssid_base[rssid] + pos);
+        }
+    }
+    std::vector<std::unique_ptr<vectorized::Column>> values;
+    values.reserve(column_ids.size());
+    for (const auto& column : *columns) {
+        values.emplace_back(column->clone_empty());
+    }
+    RETURN_IF_ERROR(get_column_values(column_ids, rowids_by_rssid, &values));
+    for (size_t i = 0; i < columns->size(); i++) {
+        (*columns)[i]->append_selective(*values[i], value_idxes.data(), 0, value_idxes.size());
+    }
+    return Status::OK();
+}
+
 RowsetSharedPtr TabletUpdates::_get_rowset(uint32_t rowset_id) {
     std::lock_guard<std::mutex> lg(_rowsets_lock);
     auto itr = _rowsets.find(rowset_id);
@@ -955,6 +1147,7 @@ Status TabletUpdates::_do_compaction(std::unique_ptr<CompactionInfo>* pinfo, Mem
     context.tablet_schema = &(_tablet.tablet_schema());
     context.rowset_state = COMMITTED;
     context.segments_overlap = NONOVERLAPPING;
+    context.io_limiter = _tablet.data_dir()->background_io_limiter();
     std::unique_ptr<RowsetWriter> rowset_writer;
     Status st = RowsetFactory::create_rowset_writer(context, &rowset_writer);
     if (!st.ok()) {
@@ -1114,6 +1307,7 @@ void TabletUpdates::_apply_compaction_commit(const EditVersionInfo& version_info
     size_t total_rows = 0;
     vector<std::pair<uint32_t, DelVectorPtr>> delvecs;
     vector<uint32_t> tmp_deletes;
+    std::unique_lock il(_index_lock);
     for (size_t i = 0; i < _compaction_state->segment_states.size(); i++) {
         auto& sstate = _compaction_state->segment_states[i];
         total_rows += sstate.src_rssids.size();
@@ -1162,6 +1356,7 @@ void TabletUpdates::_apply_compaction_commit(const EditVersionInfo& version_info
         _apply_version_idx++;
         _apply_version_changed.notify_all();
     }
+    il.unlock();
     {
         // Update the stats of affected rowsets.
         std::lock_guard lg(_rowset_stats_lock);
@@ -1334,6 +1529,12 @@ int64_t TabletUpdates::get_compaction_score() {
                 total_score += itr->second->compaction_score;
             }
         }
+        // merging a size tier of n rowsets saves n - 1 seeks.
+        vector<uint32_t> tier_rowsets;
+        _pick_size_tier_rowsets(rowsets, &tier_rowsets);
+        if (!tier_rowsets.empty()) {
+            total_score = std::max(total_score, (int64_t)(tier_rowsets.size() - 1) * _compaction_cost_seek);
+        }
     }
     if (has_error) {
         LOG(WARNING) << "error get_compaction_score: " << debug_string();
@@ -1367,13 +1568,52 @@ static string int_list_to_string(const vector<uint32_t>& l) {
 static const size_t compaction_result_bytes_threashold = 1000000000;
 static const size_t compaction_result_rows_threashold = 10000000;
 
+void TabletUpdates::_pick_size_tier_rowsets(const vector<uint32_t>& rowsets, vector<uint32_t>* picked) {
+    const int64_t ratio = std::max(2, config::update_compaction_size_tier_ratio);
+    const size_t min_rowsets = std::max(2, config::update_compaction_size_tier_min_rowsets);
+    // the tiers are [seek, seek * ratio), [seek * ratio, seek * ratio^2), ... the smaller rowsets are
+    // in the first tier.
+    std::map<int, vector<std::pair<size_t, uint32_t>>> tiers;
+    for (auto rowsetid : rowsets) {
+        auto itr = _rowset_stats.find(rowsetid);
+        if (itr == _rowset_stats.end() || itr->second->compaction_score > 0) {
+            continue;
+        }
+        const size_t bytes = itr->second->byte_size;
+        if (bytes >= compaction_result_bytes_threashold) {
+            // already as large as a compaction result.
+            continue;
+        }
+        int tier = 0;
+        for (int64_t upper = _compaction_cost_seek * ratio; (int64_t)bytes >= upper; upper *= ratio) {
+            tier++;
+        }
+        tiers[tier].emplace_back(bytes, rowsetid);
+    }
+    for (auto& [tier, entries] : tiers) {
+        if (entries.size() < min_rowsets) {
+            continue;
+        }
+        std::sort(entries.begin(), entries.end());
+        size_t total_bytes = 0;
+        for (const auto& [bytes, rowsetid] : entries) {
+            if (picked->size() >= min_rowsets && total_bytes + bytes > compaction_result_bytes_threashold) {
+                break;
+            }
+            picked->push_back(rowsetid);
+            total_bytes += bytes;
+        }
+        return;
+    }
+}
+
 Status TabletUpdates::compaction(MemTracker* mem_tracker) {
     if (_error) {
         return Status::InternalError("tablet updates is in error state, cannot do compaction");
     }
     bool was_runing = false;
     if (!_compaction_running.compare_exchange_strong(was_runing, true)) {
-        return Status::InternalError("illegal state: another compaction is running");
+        return Status::AlreadyExist("another compaction is running");
     }
     std::unique_ptr<CompactionInfo> info = std::make_unique<CompactionInfo>();
     vector<uint32_t> rowsets;
@@ -1390,8 +1630,19 @@ Status TabletUpdates::compaction(MemTracker* mem_tracker) {
     size_t total_bytes_after_compaction = 0;
     int64_t total_score = -_compaction_cost_seek;
     vector<CompactionEntry> candidates;
+    vector<uint32_t> tier_rowsets;
+    size_t tier_rows = 0;
+    size_t tier_dels = 0;
+    size_t tier_bytes = 0;
     {
         std::lock_guard lg(_rowset_stats_lock);
+        _pick_size_tier_rowsets(rowsets, &tier_rowsets);
+        for (auto rowsetid : tier_rowsets) {
+            const auto& stat = *_rowset_stats[rowsetid];
+            tier_rows += stat.num_rows;
+            tier_dels += stat.num_dels;
+            tier_bytes += stat.byte_size;
+        }
         for (auto rowsetid : rowsets) {
             auto itr = _rowset_stats.find(rowsetid);
             if (itr == _rowset_stats.end()) {
@@ -1441,7 +1692,17 @@ Status TabletUpdates::compaction(MemTracker* mem_tracker) {
             break;
         }
     }
-    if (total_valid_rowsets - info->inputs.size() <= 3) {
+    // merge a size tier instead if it saves more, the rowsets picked for deletes are left to the next round.
+    const int64_t tier_score = tier_rowsets.empty() ? 0 : (int64_t)(tier_rowsets.size() - 1) * _compaction_cost_seek;
+    if (tier_score > total_score) {
+        info->inputs = std::move(tier_rowsets);
+        total_score = tier_score;
+        total_rows = tier_rows;
+        total_bytes = tier_bytes;
+        total_rows_after_compaction = tier_rows - tier_dels;
+        total_bytes_after_compaction = tier_rows == 0 ? 0 : tier_bytes * (tier_rows - tier_dels) / tier_rows;
+    }
+    if (info->inputs.size() >= total_valid_rowsets || total_valid_rowsets - info->inputs.size() <= 3) {
         // give 10s time gitter, so same table's compaction don't start at same time
         _last_compaction_time_ms = UnixMillis() + rand() % 10000;
     }
@@ -4,6 +4,7 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <map>
 #include <mutex>
 #include <shared_mutex>
 #include <unordered_map>
@@ -26,7 +27,9 @@ class Tablet;
 class TTabletInfo;
 
 namespace vectorized {
+class Chunk;
 class ChunkIterator;
+class Column;
 class CompactionState;
 class RowsetReadOptions;
 class Schema;
@@ -151,6 +154,22 @@ public:
 
     void to_updates_pb(TabletUpdatesPB* updates_pb) const;
 
+    // Read the values of the columns |column_ids| of the rows |rowids_by_rssid|, the rowids of every
+    // segment are sorted. The values are appended to |columns| in the order of the segments and then
+    // the rowids. Used by the apply of a partial update, when the rows are not being modified.
+    Status get_column_values(const std::vector<uint32_t>& column_ids,
+                             const std::map<uint32_t, std::vector<uint32_t>>& rowids_by_rssid,
+                             std::vector<std::unique_ptr<vectorized::Column>>* columns);
+
+    // Look up the rows of the primary keys |keys|, which has the key columns of the tablet, at the latest
+    // applied version, after waiting until |min_version| is applied. The version read is returned by
+    // |read_version|. |found| is set for every key, the values of the columns |column_ids| of the found rows
+    // are appended to |columns| in the order of the keys. Used by the point lookups, which skip the planning
+    // and the scan of the query.
+    Status get_rows_by_keys(const vectorized::Chunk& keys, int64_t min_version, int64_t timeout_ms,
+                            const std::vector<uint32_t>& column_ids, std::vector<bool>* found,
+                            std::vector<std::unique_ptr<vectorized::Column>>* columns, int64_t* read_version);
+
     // Used for schema change, migrate another tablet's version&rowsets to this tablet
     Status load_from_base_tablet(int64_t version, Tablet* base_tablet);
 
@@ -213,6 +232,8 @@ private:
 
     void _apply_rowset_commit(const EditVersionInfo& version_info);
 
+    void _save_primary_index_snapshot();
+
     void _apply_compaction_commit(const EditVersionInfo& version_info);
 
     RowsetSharedPtr _get_rowset(uint32_t rowset_id);
@@ -239,6 +260,10 @@ private:
 
     void _calc_compaction_score(RowsetStats* stats);
 
+    // pick the rowsets of the smallest size tier with enough rowsets among |rowsets|, skipping the
+    // rowsets worth compacting for their deletes. assuming |_rowset_stats_lock| is already hold.
+    void _pick_size_tier_rowsets(const std::vector<uint32_t>& rowsets, std::vector<uint32_t>* picked);
+
     // This method will acquire |_lock|.
     size_t _get_rowset_num_deletes(uint32_t rowsetid);
 
@@ -278,6 +303,10 @@ private:
     // so after BE restart those "committed" will be lost.
     std::map<int64_t, RowsetSharedPtr> _pending_commits;
 
+    // held shared by the point lookups, and exclusive by the applies from updating the primary index to
+    // applying the version, so the lookups see the index and the rowsets of an applied version.
+    std::shared_mutex _index_lock;
+
     mutable std::mutex _rowsets_lock;
     std::unordered_map<uint32_t, RowsetSharedPtr> _rowsets;
 
@@ -285,6 +314,8 @@ private:
     mutable std::mutex _apply_running_lock;
     // apply process is running currently
     bool _apply_running = false;
+    // the number of versions applied since the last primary index snapshot, only used by the apply thread.
+    int32_t _applied_since_index_snapshot = 0;
 
     // used to stop apply thread when shutting-down this tablet
     std::atomic<bool> _apply_stopped = false;
@@ -21,8 +21,11 @@
 
 #include "storage/task/engine_clone_task.h"
 
+#include <atomic>
 #include <filesystem>
+#include <mutex>
 #include <set>
+#include <thread>
 
 #include "env/env.h"
 #include "gen_cpp/BackendService.h"
@@ -31,6 +34,7 @@
 #include "gutil/strings/stringpiece.h"
 #include "gutil/strings/substitute.h"
 #include "http/http_client.h"
+#include "http/http_common.h"
 #include "runtime/client_cache.h"
 #include "runtime/exec_env.h"
 #include "storage/rowset/rowset.h"
@@ -361,76 +365,142 @@ Status EngineCloneTask::_download_files(DataDir* data_dir, const std::string& re
     // If the header file is not exist, the table could't loaded by olap engine.
     // Avoid of data is not complete, we copy the header file at last.
     // The header file's name is end of .hdr.
-    for (int i = 0; i < file_name_list.size() - 1; ++i) {
+    for (int i = 0; i + 1 < file_name_list.size(); ++i) {
         StringPiece sp(file_name_list[i]);
         if (sp.ends_with(".hdr")) {
             std::swap(file_name_list[i], file_name_list[file_name_list.size() - 1]);
             break;
         }
     }
+    bool has_header_file = !file_name_list.empty() && StringPiece(file_name_list.back()).ends_with(".hdr");
+    size_t num_data_files = has_header_file ? file_name_list.size() - 1 : file_name_list.size();
 
-    // Get copy from remote
-    uint64_t total_file_size = 0;
+    // Get copy from remote, the files except the header file are downloaded in parallel.
+    std::atomic<uint64_t> total_file_size{0};
     MonotonicStopWatch watch;
     watch.start();
-    for (auto& file_name : file_name_list) {
-        auto remote_file_url = remote_url_prefix + file_name;
-
-        // get file length
-        uint64_t file_size = 0;
-        auto get_file_size_cb = [&remote_file_url, &file_size](HttpClient* client) {
-            RETURN_IF_ERROR(client->init(remote_file_url));
-            client->set_timeout_ms(GET_LENGTH_TIMEOUT * 1000);
-            RETURN_IF_ERROR(client->head());
-            file_size = client->get_content_length();
-            return Status::OK();
-        };
-        RETURN_IF_ERROR(HttpClient::execute_with_retry(DOWNLOAD_FILE_MAX_RETRY, 1, get_file_size_cb));
-        // check disk capacity
-        if (data_dir->reach_capacity_limit(file_size)) {
-            return Status::InternalError("Disk reach capacity limit");
+    std::atomic<size_t> next_file{0};
+    std::mutex status_mutex;
+    Status status;
+    auto download_worker = [&]() {
+        for (size_t i = next_file++; i < num_data_files; i = next_file++) {
+            uint64_t file_size = 0;
+            Status st = _download_file(data_dir, remote_url_prefix + file_name_list[i],
+                                       local_path + file_name_list[i], &file_size);
+            if (!st.ok()) {
+                std::lock_guard l(status_mutex);
+                if (status.ok()) {
+                    status = st;
+                }
+                // stop the other workers from taking more files.
+                next_file = num_data_files;
+                break;
+            }
+            total_file_size += file_size;
         }
-
+    };
+    size_t num_threads = std::min<size_t>(std::max(config::tablet_file_copy_parallelism, 1), num_data_files);
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < num_threads; ++i) {
+        threads.emplace_back(download_worker);
+    }
+    download_worker();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    RETURN_IF_ERROR(status);
+    if (has_header_file) {
+        uint64_t file_size = 0;
+        RETURN_IF_ERROR(_download_file(data_dir, remote_url_prefix + file_name_list.back(),
+                                       local_path + file_name_list.back(), &file_size));
         total_file_size += file_size;
-        uint64_t estimate_timeout = file_size / config::download_low_speed_limit_kbps / 1024;
-        if (estimate_timeout < config::download_low_speed_time) {
-            estimate_timeout = config::download_low_speed_time;
-        }
-
-        std::string local_file_path = local_path + file_name;
-
-        LOG(INFO) << "Downloading " << remote_file_url << " to " << local_file_path << ". bytes=" << file_size
-                  << " timeout=" << estimate_timeout;
-
-        auto download_cb = [&remote_file_url, estimate_timeout, &local_file_path, file_size](HttpClient* client) {
-            RETURN_IF_ERROR(client->init(remote_file_url));
-            client->set_timeout_ms(estimate_timeout * 1000);
-            RETURN_IF_ERROR(client->download(local_file_path));
-
-            // Check file length
-            uint64_t local_file_size = std::filesystem::file_size(local_file_path);
-            if (local_file_size != file_size) {
-                LOG(WARNING) << "Fail to download " << remote_file_url << ". file_size=" << local_file_size << "/"
-                             << file_size;
-                return Status::InternalError("mismatched file size");
-            }
-            chmod(local_file_path.c_str(), S_IRUSR | S_IWUSR);
-            return Status::OK();
-        };
-        RETURN_IF_ERROR(HttpClient::execute_with_retry(DOWNLOAD_FILE_MAX_RETRY, 1, download_cb));
     } // Clone files from remote backend
 
     uint64_t total_time_ms = watch.elapsed_time() / 1000 / 1000;
     total_time_ms = total_time_ms > 0 ? total_time_ms : 0;
     double copy_rate = 0.0;
     if (total_time_ms > 0) {
-        copy_rate = total_file_size / ((double)total_time_ms) / 1000;
+        copy_rate = total_file_size.load() / ((double)total_time_ms) / 1000;
     }
-    LOG(INFO) << "Copied tablet " << _signature << ". bytes=" << total_file_size << " cost=" << total_time_ms << " ms"
+    LOG(INFO) << "Copied tablet " << _signature << ". bytes=" << total_file_size.load() << " cost=" << total_time_ms << " ms"
               << " rate=" << copy_rate << " MB/s";
     return Status::OK();
 }
 
+Status EngineCloneTask::_download_file(DataDir* data_dir, const std::string& remote_file_url,
+                                       const std::string& local_file_path, uint64_t* file_size) {
+    // get file length, and the checksum if the source supports it
+    const bool verify_checksum = config::tablet_file_copy_verify_checksum;
+    std::string head_url = remote_file_url;
+    if (verify_checksum) {
+        head_url += "&" + HTTP_CHECKSUM_KEY + "=crc32c";
+    }
+    std::string expected_checksum;
+    auto get_file_size_cb = [&](HttpClient* client) {
+        RETURN_IF_ERROR(client->init(head_url));
+        // the source reads the whole file to compute the checksum.
+        client->set_timeout_ms((verify_checksum ? config::download_low_speed_time : GET_LENGTH_TIMEOUT) * 1000);
+        RETURN_IF_ERROR(client->head());
+        *file_size = client->get_content_length();
+        expected_checksum = client->get_response_header(HTTP_CRC32C_HEADER);
+        return Status::OK();
+    };
+    RETURN_IF_ERROR(HttpClient::execute_with_retry(DOWNLOAD_FILE_MAX_RETRY, 1, get_file_size_cb));
+    // check disk capacity
+    if (data_dir->reach_capacity_limit(*file_size)) {
+        return Status::InternalError("Disk reach capacity limit");
+    }
+
+    uint64_t estimate_timeout = *file_size / config::download_low_speed_limit_kbps / 1024;
+    if (estimate_timeout < config::download_low_speed_time) {
+        estimate_timeout = config::download_low_speed_time;
+    }
+
+    LOG(INFO) << "Downloading " << remote_file_url << " to " << local_file_path << ". bytes=" << *file_size
+              << " timeout=" << estimate_timeout;
+
+    // the bytes written by a failed attempt are kept, the next attempt downloads the rest of the file.
+    int64_t offset = 0;
+    uint32_t checksum = 0;
+    auto download_cb = [&](HttpClient* client) {
+        RETURN_IF_ERROR(client->init(remote_file_url));
+        client->set_timeout_ms(estimate_timeout * 1000);
+        Status st = client->download(local_file_path, offset, &checksum, data_dir->background_io_limiter());
+        std::error_code ec;
+        uint64_t local_file_size = std::filesystem::file_size(local_file_path, ec);
+        if (!st.ok()) {
+            offset = 0;
+            checksum = 0;
+            if (!ec && local_file_size <= *file_size && FileUtils::crc32c(local_file_path, &checksum).ok()) {
+                offset = local_file_size;
+                LOG(INFO) << "Download " << remote_file_url << " will be resumed from " << offset;
+            } else {
+                checksum = 0;
+            }
+            return st;
+        }
+
+        // Check file length
+        if (ec || local_file_size != *file_size) {
+            LOG(WARNING) << "Fail to download " << remote_file_url << ". file_size=" << local_file_size << "/"
+                         << *file_size;
+            offset = 0;
+            checksum = 0;
+            return Status::InternalError("mismatched file size");
+        }
+        if (!expected_checksum.empty() && std::to_string(checksum) != expected_checksum) {
+            LOG(WARNING) << "Fail to download " << remote_file_url << ". checksum=" << checksum << "/"
+                         << expected_checksum;
+            offset = 0;
+            checksum = 0;
+            return Status::Corruption("mismatched file checksum");
+        }
+        chmod(local_file_path.c_str(), S_IRUSR | S_IWUSR);
+        return Status::OK();
+    };
+    return HttpClient::execute_with_retry(DOWNLOAD_FILE_MAX_RETRY, 1, download_cb);
+}
+
 Status EngineCloneTask::_finish_clone(Tablet* tablet, const string& clone_dir, int64_t committed_version,
                                       bool incremental_clone) {
     if (tablet->updates() != nullptr) {
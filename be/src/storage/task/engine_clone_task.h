@@ -61,6 +61,10 @@ private:
     // Download tablet files from
     Status _download_files(DataDir* data_dir, const std::string& remote_url_prefix, const std::string& local_path);
 
+    // Download a file and verify its size and checksum, a failed attempt is resumed by the next one.
+    static Status _download_file(DataDir* data_dir, const std::string& remote_file_url,
+                                 const std::string& local_file_path, uint64_t* file_size);
+
     Status _make_snapshot(const std::string& ip, int port, TTableId tablet_id, TSchemaHash schema_hash, int timeout_s,
                           const std::vector<Version>* missed_versions, std::string* snapshot_path,
                           int32_t* snapshot_version);
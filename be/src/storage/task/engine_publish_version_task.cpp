@@ -21,12 +21,17 @@
 
 #include "storage/task/engine_publish_version_task.h"
 
+#include <algorithm>
 #include <map>
+#include <mutex>
+#include <vector>
 
+#include "common/config.h"
 #include "storage/data_dir.h"
 #include "storage/rowset/rowset_meta_manager.h"
 #include "storage/tablet_manager.h"
 #include "storage/update_manager.h"
+#include "util/parallel_for.h"
 
 namespace starrocks {
 
@@ -59,72 +64,27 @@ OLAPStatus EnginePublishVersionTask::finish() {
         Version version(par_ver_info.version, par_ver_info.version);
         VersionHash version_hash = par_ver_info.version_hash;
 
-        // each tablet
-        for (auto& tablet_rs : tablet_related_rs) {
-            OLAPStatus publish_status = OLAP_SUCCESS;
-            const TabletInfo& tablet_info = tablet_rs.first;
-            const RowsetSharedPtr& rowset = tablet_rs.second;
-            VLOG(1) << "begin to publish version on tablet. "
-                    << "tablet_id=" << tablet_info.tablet_id << ", schema_hash=" << tablet_info.schema_hash
-                    << ", version=" << version.first << ", version_hash=" << version_hash
-                    << ", transaction_id=" << transaction_id;
-            // if rowset is null, it means this be received write task, but failed during write
-            // and receive fe's publish version task
-            // this be must return as an error tablet
-            if (rowset == nullptr) {
-                LOG(WARNING) << "could not find related rowset for tablet " << tablet_info.tablet_id << " txn id "
-                             << transaction_id;
-                _error_tablet_ids->push_back(tablet_info.tablet_id);
-                res = OLAP_ERR_PUSH_ROWSET_NOT_FOUND;
-                continue;
-            }
-            TabletSharedPtr tablet = StorageEngine::instance()->tablet_manager()->get_tablet(
-                    tablet_info.tablet_id, tablet_info.schema_hash, tablet_info.tablet_uid);
-            if (tablet == nullptr) {
-                LOG(WARNING) << "can't get tablet when publish version. tablet_id=" << tablet_info.tablet_id
-                             << " schema_hash=" << tablet_info.schema_hash;
-                _error_tablet_ids->push_back(tablet_info.tablet_id);
-                res = OLAP_ERR_PUSH_TABLE_NOT_EXIST;
-                continue;
-            }
-
-            if (tablet->keys_type() == KeysType::PRIMARY_KEYS) {
-                VLOG(1) << "UpdateManager::on_rowset_published tablet:" << tablet->tablet_id()
-                        << " rowset: " << rowset->rowset_id().to_string() << " version: " << version.second;
-                publish_status = StorageEngine::instance()->txn_manager()->publish_txn2(transaction_id, partition_id,
-                                                                                        tablet, version.second);
+        // The tablets of the partition are published by up to publish_version_tablet_parallelism workers,
+        // the rowset and tablet metas they save at the same time are written to the meta store together.
+        std::vector<std::pair<TabletInfo, RowsetSharedPtr>> tablet_rs_list(tablet_related_rs.begin(),
+                                                                           tablet_related_rs.end());
+        std::mutex mutex;
+        auto publish_tablet = [&](size_t i) {
+            const TabletInfo& tablet_info = tablet_rs_list[i].first;
+            OLAPStatus publish_status =
+                    _publish_tablet(partition_id, tablet_info, tablet_rs_list[i].second, version, version_hash);
+            std::lock_guard l(mutex);
+            if (publish_status == OLAP_SUCCESS || publish_status == OLAP_ERR_PUSH_VERSION_ALREADY_EXIST) {
+                partition_related_tablet_infos.erase(tablet_info);
             } else {
-                publish_status = StorageEngine::instance()->txn_manager()->publish_txn(
-                        partition_id, tablet, transaction_id, version, version_hash);
-            }
-            if (publish_status != OLAP_SUCCESS) {
-                LOG(WARNING) << "failed to publish version. rowset_id=" << rowset->rowset_id()
-                             << ", tablet_id=" << tablet_info.tablet_id << ", txn_id=" << transaction_id;
                 _error_tablet_ids->push_back(tablet_info.tablet_id);
                 res = publish_status;
-                continue;
-            }
-
-            if (tablet->keys_type() != KeysType::PRIMARY_KEYS) {
-                // add visible rowset to tablet
-                auto st = tablet->add_inc_rowset(rowset);
-                publish_status =
-                        st.ok() ? OLAP_SUCCESS
-                                : (st.is_already_exist() ? OLAP_ERR_PUSH_VERSION_ALREADY_EXIST : OLAP_ERR_OTHER_ERROR);
-                if (publish_status != OLAP_SUCCESS && publish_status != OLAP_ERR_PUSH_VERSION_ALREADY_EXIST) {
-                    LOG(WARNING) << "fail to add visible rowset to tablet. rowset_id=" << rowset->rowset_id()
-                                 << ", tablet_id=" << tablet_info.tablet_id << ", txn_id=" << transaction_id
-                                 << ", res=" << publish_status;
-                    _error_tablet_ids->push_back(tablet_info.tablet_id);
-                    res = publish_status;
-                    continue;
-                }
             }
-            partition_related_tablet_infos.erase(tablet_info);
-            VLOG(1) << "publish version successfully on tablet. tablet=" << tablet->full_name()
-                    << ", transaction_id=" << transaction_id << ", version=" << version.first
-                    << ", res=" << publish_status;
-        }
+            // a failed tablet does not stop the others from being published.
+            return Status::OK();
+        };
+        (void)parallel_for(StorageEngine::instance()->parallel_task_pool(), tablet_rs_list.size(),
+                           std::max(config::publish_version_tablet_parallelism, 1), publish_tablet);
 
         // check if the related tablet remained all have the version
         for (auto& tablet_info : partition_related_tablet_infos) {
@@ -154,4 +114,61 @@ OLAPStatus EnginePublishVersionTask::finish() {
     return res;
 }
 
+OLAPStatus EnginePublishVersionTask::_publish_tablet(int64_t partition_id, const TabletInfo& tablet_info,
+                                                     const RowsetSharedPtr& rowset, const Version& version,
+                                                     VersionHash version_hash) {
+    int64_t transaction_id = _publish_version_req.transaction_id;
+    VLOG(1) << "begin to publish version on tablet. "
+            << "tablet_id=" << tablet_info.tablet_id << ", schema_hash=" << tablet_info.schema_hash
+            << ", version=" << version.first << ", version_hash=" << version_hash
+            << ", transaction_id=" << transaction_id;
+    // if rowset is null, it means this be received write task, but failed during write
+    // and receive fe's publish version task
+    // this be must return as an error tablet
+    if (rowset == nullptr) {
+        LOG(WARNING) << "could not find related rowset for tablet " << tablet_info.tablet_id << " txn id "
+                     << transaction_id;
+        return OLAP_ERR_PUSH_ROWSET_NOT_FOUND;
+    }
+    TabletSharedPtr tablet = StorageEngine::instance()->tablet_manager()->get_tablet(
+            tablet_info.tablet_id, tablet_info.schema_hash, tablet_info.tablet_uid);
+    if (tablet == nullptr) {
+        LOG(WARNING) << "can't get tablet when publish version. tablet_id=" << tablet_info.tablet_id
+                     << " schema_hash=" << tablet_info.schema_hash;
+        return OLAP_ERR_PUSH_TABLE_NOT_EXIST;
+    }
+
+    OLAPStatus publish_status = OLAP_SUCCESS;
+    if (tablet->keys_type() == KeysType::PRIMARY_KEYS) {
+        VLOG(1) << "UpdateManager::on_rowset_published tablet:" << tablet->tablet_id()
+                << " rowset: " << rowset->rowset_id().to_string() << " version: " << version.second;
+        publish_status = StorageEngine::instance()->txn_manager()->publish_txn2(transaction_id, partition_id, tablet,
+                                                                                version.second);
+    } else {
+        publish_status = StorageEngine::instance()->txn_manager()->publish_txn(partition_id, tablet, transaction_id,
+                                                                               version, version_hash);
+    }
+    if (publish_status != OLAP_SUCCESS) {
+        LOG(WARNING) << "failed to publish version. rowset_id=" << rowset->rowset_id()
+                     << ", tablet_id=" << tablet_info.tablet_id << ", txn_id=" << transaction_id;
+        return publish_status;
+    }
+
+    if (tablet->keys_type() != KeysType::PRIMARY_KEYS) {
+        // add visible rowset to tablet
+        auto st = tablet->add_inc_rowset(rowset);
+        publish_status = st.ok() ? OLAP_SUCCESS
+                                 : (st.is_already_exist() ? OLAP_ERR_PUSH_VERSION_ALREADY_EXIST : OLAP_ERR_OTHER_ERROR);
+        if (publish_status != OLAP_SUCCESS && publish_status != OLAP_ERR_PUSH_VERSION_ALREADY_EXIST) {
+            LOG(WARNING) << "fail to add visible rowset to tablet. rowset_id=" << rowset->rowset_id()
+                         << ", tablet_id=" << tablet_info.tablet_id << ", txn_id=" << transaction_id
+                         << ", res=" << publish_status;
+            return publish_status;
+        }
+    }
+    VLOG(1) << "publish version successfully on tablet. tablet=" << tablet->full_name()
+            << ", transaction_id=" << transaction_id << ", version=" << version.first << ", res=" << publish_status;
+    return publish_status;
+}
+
 } // namespace starrocks
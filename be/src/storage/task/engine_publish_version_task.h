@@ -23,7 +23,9 @@
 #define STARROCKS_BE_SRC_OLAP_TASK_ENGINE_PUBLISH_VERSION_TASK_H
 
 #include "gen_cpp/AgentService_types.h"
+#include "storage/olap_common.h"
 #include "storage/olap_define.h"
+#include "storage/rowset/rowset.h"
 #include "storage/task/engine_task.h"
 
 namespace starrocks {
@@ -36,6 +38,10 @@ public:
     OLAPStatus finish() override;
 
 private:
+    // Publish |rowset| of the txn on the tablet of |tablet_info|.
+    OLAPStatus _publish_tablet(int64_t partition_id, const TabletInfo& tablet_info, const RowsetSharedPtr& rowset,
+                               const Version& version, VersionHash version_hash);
+
     const TPublishVersionRequest& _publish_version_req;
     vector<TTabletId>* _error_tablet_ids;
 };
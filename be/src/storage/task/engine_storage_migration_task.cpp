@@ -21,9 +21,16 @@
 
 #include "storage/task/engine_storage_migration_task.h"
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#include "common/config.h"
 #include "storage/snapshot_manager.h"
 #include "storage/tablet_meta_manager.h"
 #include "util/defer_op.h"
+#include "util/token_bucket.h"
 
 namespace starrocks {
 
@@ -322,12 +329,36 @@ void EngineStorageMigrationTask::_generate_new_header(DataDir* store, const uint
 OLAPStatus EngineStorageMigrationTask::_copy_index_and_data_files(
         const string& schema_hash_path, const TabletSharedPtr& ref_tablet,
         const std::vector<RowsetSharedPtr>& consistent_rowsets) const {
+    // the rowsets are copied by several threads, throttled by the io limiter of the dest disk
+    // so that the migration does not starve the loads and queries on it.
+    TokenBucket* io_limiter = _dest_store->background_io_limiter();
+    size_t num_threads = std::min<size_t>(std::max(config::tablet_file_copy_parallelism, 1),
+                                          consistent_rowsets.size());
+    std::atomic<size_t> next_rowset{0};
+    std::mutex mutex;
     OLAPStatus status = OLAP_SUCCESS;
-    for (const auto& rs : consistent_rowsets) {
-        status = rs->copy_files_to(schema_hash_path);
-        if (status != OLAP_SUCCESS) {
-            break;
+    auto copy_rowsets = [&]() {
+        size_t i;
+        while ((i = next_rowset.fetch_add(1)) < consistent_rowsets.size()) {
+            OLAPStatus st = consistent_rowsets[i]->copy_files_to(schema_hash_path, io_limiter);
+            if (st != OLAP_SUCCESS) {
+                LOG(WARNING) << "fail to copy rowset " << consistent_rowsets[i]->rowset_id() << " to "
+                             << schema_hash_path << ", res=" << st;
+                std::lock_guard l(mutex);
+                if (status == OLAP_SUCCESS) {
+                    status = st;
+                }
+                next_rowset = consistent_rowsets.size();
+            }
         }
+    };
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < num_threads; ++i) {
+        threads.emplace_back(copy_rowsets);
+    }
+    copy_rowsets();
+    for (auto& t : threads) {
+        t.join();
     }
     return status;
 }
@@ -260,7 +260,7 @@ OLAPStatus TxnManager::publish_txn(KVStore* meta, TPartitionId partition_id, TTr
         // it maybe a fatal error
         rowset_ptr->make_visible(version, version_hash);
         auto& rowset_meta_pb = rowset_ptr->rowset_meta()->get_meta_pb();
-        Status st = RowsetMetaManager::save(meta, tablet_uid, rowset_ptr->rowset_id(), rowset_meta_pb);
+        Status st = RowsetMetaManager::group_save(meta, tablet_uid, rowset_ptr->rowset_id(), rowset_meta_pb);
         if (!st.ok()) {
             LOG(WARNING) << "save committed rowset failed. when publish txn rowset_id:" << rowset_ptr->rowset_id()
                          << ", tablet id: " << tablet_id << ", txn id:" << transaction_id;
@@ -5,6 +5,7 @@
 #include <limits>
 #include <memory>
 
+#include "common/config.h"
 #include "gutil/endian.h"
 #include "storage/del_vector.h"
 #include "storage/kv_store.h"
@@ -25,6 +26,8 @@ UpdateManager::UpdateManager(MemTracker* mem_tracker)
     _update_state_mem_tracker = std::make_unique<MemTracker>(-1, "rowset_update_state", mem_tracker);
     _index_cache_mem_tracker = std::make_unique<MemTracker>(-1, "index_cache", mem_tracker);
     _del_vec_cache_mem_tracker = std::make_unique<MemTracker>(-1, "del_vec_cache", mem_tracker);
+    _del_vec_cache = std::make_unique<DelVectorCache>(_del_vec_cache_mem_tracker.get());
+    _del_vec_cache->set_capacity(config::update_del_vector_cache_capacity);
     _compaction_state_mem_tracker = std::make_unique<MemTracker>(-1, "compaction_state", mem_tracker);
 
     _index_cache.set_mem_tracker(_index_cache_mem_tracker.get());
@@ -33,6 +36,7 @@ UpdateManager::UpdateManager(MemTracker* mem_tracker)
 
 UpdateManager::~UpdateManager() {
     clear_cache();
+    _del_vec_cache.reset();
     if (_compaction_state_mem_tracker) {
         _compaction_state_mem_tracker.reset();
     }
@@ -63,35 +67,17 @@ Status UpdateManager::set_del_vec_in_meta(KVStore* meta, const TabletSegmentId&
 }
 
 Status UpdateManager::get_del_vec(KVStore* meta, const TabletSegmentId& tsid, int64_t version, DelVectorPtr* pdelvec) {
-    {
-        std::lock_guard<std::mutex> lg(_del_vec_cache_lock);
-        auto itr = _del_vec_cache.find(tsid);
-        if (itr != _del_vec_cache.end()) {
-            if (version >= itr->second->version()) {
-                VLOG(3) << strings::Substitute("get_del_vec cached tablet_segment=$0 version=$1 actual_version=$2",
-                                               tsid.to_string(), version, itr->second->version());
-                // cache valid
-                // TODO(cbl): add cache hit stats
-                *pdelvec = itr->second;
-                return Status::OK();
-            }
-        }
+    *pdelvec = _del_vec_cache->get(tsid, version);
+    if (*pdelvec) {
+        VLOG(3) << strings::Substitute("get_del_vec cached tablet_segment=$0 version=$1 actual_version=$2",
+                                       tsid.to_string(), version, (*pdelvec)->version());
+        return Status::OK();
     }
     (*pdelvec).reset(new DelVector());
     int64_t latest_version = 0;
     RETURN_IF_ERROR(get_del_vec_in_meta(meta, tsid, version, pdelvec->get(), &latest_version));
     if ((*pdelvec)->version() == latest_version) {
-        std::lock_guard<std::mutex> lg(_del_vec_cache_lock);
-        auto itr = _del_vec_cache.find(tsid);
-        if (itr == _del_vec_cache.end()) {
-            _del_vec_cache.emplace(tsid, *pdelvec);
-            _del_vec_cache_mem_tracker->consume((*pdelvec)->memory_usage());
-        } else if (latest_version > itr->second->version()) {
-            // should happen rarely
-            _del_vec_cache_mem_tracker->release(itr->second->memory_usage());
-            itr->second = (*pdelvec);
-            _del_vec_cache_mem_tracker->consume(itr->second->memory_usage());
-        }
+        *pdelvec = _del_vec_cache->set_if_newer(tsid, *pdelvec);
     }
     return Status::OK();
 }
@@ -107,38 +93,21 @@ void UpdateManager::clear_cache() {
     }
     StarRocksMetrics::instance()->update_primary_index_num.set_value(0);
     StarRocksMetrics::instance()->update_primary_index_bytes_total.set_value(0);
-    {
-        std::lock_guard<std::mutex> lg(_del_vec_cache_lock);
-        _del_vec_cache.clear();
-        if (_del_vec_cache_mem_tracker) {
-            _del_vec_cache_mem_tracker->release(_del_vec_cache_mem_tracker->consumption());
-        }
-        StarRocksMetrics::instance()->update_del_vector_num.set_value(0);
-        StarRocksMetrics::instance()->update_del_vector_bytes_total.set_value(0);
-    }
+    _del_vec_cache->clear();
+    StarRocksMetrics::instance()->update_del_vector_num.set_value(0);
+    StarRocksMetrics::instance()->update_del_vector_bytes_total.set_value(0);
 }
 
 void UpdateManager::clear_cached_del_vec(const std::vector<TabletSegmentId>& tsids) {
-    std::lock_guard<std::mutex> lg(_del_vec_cache_lock);
-    for (const auto& tsid : tsids) {
-        auto itr = _del_vec_cache.find(tsid);
-        if (itr != _del_vec_cache.end()) {
-            _del_vec_cache_mem_tracker->release(itr->second->memory_usage());
-            _del_vec_cache.erase(itr);
-        }
-    }
+    _del_vec_cache->erase(tsids);
 }
 
 void UpdateManager::expire_cache() {
     StarRocksMetrics::instance()->update_primary_index_num.set_value(_index_cache.object_size());
     StarRocksMetrics::instance()->update_primary_index_bytes_total.set_value(_index_cache.size());
-    {
-        std::lock_guard<std::mutex> lg(_del_vec_cache_lock);
-        StarRocksMetrics::instance()->update_del_vector_num.set_value(_del_vec_cache.size());
-        StarRocksMetrics::instance()->update_del_vector_bytes_total.set_value(std::accumulate(
-                _del_vec_cache.cbegin(), _del_vec_cache.cend(), 0,
-                [](const int& accumulated, const auto& p) { return accumulated + p.second->memory_usage(); }));
-    }
+    _del_vec_cache->set_capacity(config::update_del_vector_cache_capacity);
+    StarRocksMetrics::instance()->update_del_vector_num.set_value(_del_vec_cache->size());
+    StarRocksMetrics::instance()->update_del_vector_bytes_total.set_value(_del_vec_cache->memory_usage());
     if (MonotonicMillis() - _last_clear_expired_cache_millis > _cache_expire_ms) {
         _update_state_cache.clear_expired();
 
@@ -166,43 +135,22 @@ string UpdateManager::memory_stats() {
 }
 
 Status UpdateManager::get_latest_del_vec(KVStore* meta, const TabletSegmentId& tsid, DelVectorPtr* pdelvec) {
-    std::lock_guard<std::mutex> lg(_del_vec_cache_lock);
-    auto itr = _del_vec_cache.find(tsid);
-    if (itr != _del_vec_cache.end()) {
-        *pdelvec = itr->second;
+    *pdelvec = _del_vec_cache->get_latest(tsid);
+    if (*pdelvec) {
         return Status::OK();
-    } else {
-        // TODO(cbl): move get_del_vec_in_meta out of lock
-        (*pdelvec).reset(new DelVector());
-        int64_t latest_version = 0;
-        RETURN_IF_ERROR(get_del_vec_in_meta(meta, tsid, INT64_MAX, pdelvec->get(), &latest_version));
-        _del_vec_cache.emplace(tsid, *pdelvec);
-        _del_vec_cache_mem_tracker->consume((*pdelvec)->memory_usage());
     }
+    // loaded without lock, the version set by a concurrent apply is kept if it's newer.
+    (*pdelvec).reset(new DelVector());
+    int64_t latest_version = 0;
+    RETURN_IF_ERROR(get_del_vec_in_meta(meta, tsid, INT64_MAX, pdelvec->get(), &latest_version));
+    *pdelvec = _del_vec_cache->set_if_newer(tsid, *pdelvec);
     return Status::OK();
 }
 
 Status UpdateManager::set_cached_del_vec(const TabletSegmentId& tsid, const DelVectorPtr& delvec) {
     VLOG(1) << "set_cached_del_vec tablet:" << tsid.tablet_id << " rss:" << tsid.segment_id
             << " version:" << delvec->version() << " #del:" << delvec->cardinality();
-    std::lock_guard<std::mutex> lg(_del_vec_cache_lock);
-    auto itr = _del_vec_cache.find(tsid);
-    if (itr != _del_vec_cache.end()) {
-        if (delvec->version() <= itr->second->version()) {
-            string msg = strings::Substitute("UpdateManager::set_cached_del_vec: new version($0) < old version($1)",
-                                             delvec->version(), itr->second->version());
-            LOG(ERROR) << msg;
-            return Status::InternalError(msg);
-        } else {
-            _del_vec_cache_mem_tracker->release(itr->second->memory_usage());
-            itr->second = delvec;
-            _del_vec_cache_mem_tracker->consume(itr->second->memory_usage());
-        }
-    } else {
-        _del_vec_cache.emplace(tsid, delvec);
-        _del_vec_cache_mem_tracker->consume(delvec->memory_usage());
-    }
-    return Status::OK();
+    return _del_vec_cache->set(tsid, delvec);
 }
 
 Status UpdateManager::on_rowset_finished(Tablet* tablet, Rowset* rowset) {
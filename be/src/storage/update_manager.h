@@ -5,6 +5,7 @@
 #include <string>
 #include <unordered_map>
 
+#include "storage/del_vector_cache.h"
 #include "storage/olap_common.h"
 #include "storage/primary_index.h"
 #include "util/dynamic_cache.h"
@@ -88,9 +89,8 @@ private:
     std::atomic<int64_t> _last_clear_expired_cache_millis{0};
 
     // DelVector related states
-    std::mutex _del_vec_cache_lock;
-    std::unordered_map<TabletSegmentId, DelVectorPtr> _del_vec_cache;
     std::unique_ptr<MemTracker> _del_vec_cache_mem_tracker;
+    std::unique_ptr<DelVectorCache> _del_vec_cache;
 
     std::unique_ptr<ThreadPool> _apply_thread_pool;
 
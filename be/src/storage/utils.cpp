@@ -35,6 +35,7 @@
 #include <cstring>
 #include <ctime>
 #include <filesystem>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -44,9 +45,11 @@
 #include "env/env.h"
 #include "gutil/strings/substitute.h"
 #include "storage/olap_define.h"
+#include "util/crc32c.h"
 #include "util/errno.h"
 #include "util/file_utils.h"
 #include "util/string_parser.hpp"
+#include "util/token_bucket.h"
 
 using std::string;
 using std::set;
@@ -138,9 +141,15 @@ OLAPStatus move_to_trash(const std::filesystem::path& schema_hash_root, const st
 }
 
 OLAPStatus copy_file(const string& src, const string& dest) {
+    return copy_file(src, dest, nullptr, false);
+}
+
+OLAPStatus copy_file(const string& src, const string& dest, TokenBucket* io_limiter, bool verify_checksum) {
     int src_fd = -1;
     int dest_fd = -1;
-    char buf[1024 * 1024];
+    std::unique_ptr<char[]> buf(new char[1024 * 1024]);
+    uint32_t src_checksum = 0;
+    uint32_t dest_checksum = 0;
     OLAPStatus res = OLAP_SUCCESS;
 
     src_fd = ::open(src.c_str(), O_RDONLY);
@@ -158,20 +167,37 @@ OLAPStatus copy_file(const string& src, const string& dest) {
     }
 
     while (true) {
-        ssize_t rd_size = ::read(src_fd, buf, sizeof(buf));
+        ssize_t rd_size = ::read(src_fd, buf.get(), 1024 * 1024);
         if (rd_size < 0) {
             PLOG(WARNING) << "failed to read from " << src;
-            return OLAP_ERR_IO_ERROR;
+            res = OLAP_ERR_IO_ERROR;
+            goto COPY_EXIT;
         } else if (0 == rd_size) {
             break;
         }
 
-        ssize_t wr_size = ::write(dest_fd, buf, rd_size);
+        ssize_t wr_size = ::write(dest_fd, buf.get(), rd_size);
         if (wr_size != rd_size) {
             PLOG(WARNING) << "failed to write to " << dest;
             res = OLAP_ERR_IO_ERROR;
             goto COPY_EXIT;
         }
+        if (verify_checksum) {
+            src_checksum = crc32c::Extend(src_checksum, buf.get(), rd_size);
+        }
+        if (io_limiter != nullptr) {
+            io_limiter->acquire(rd_size);
+        }
+    }
+
+    if (verify_checksum) {
+        if (!FileUtils::crc32c(dest, &dest_checksum).ok()) {
+            LOG(WARNING) << "failed to compute the checksum of " << dest;
+            res = OLAP_ERR_IO_ERROR;
+        } else if (src_checksum != dest_checksum) {
+            LOG(WARNING) << "mismatched checksum of " << dest << ", " << dest_checksum << " vs " << src_checksum;
+            res = OLAP_ERR_CHECKSUM_ERROR;
+        }
     }
 
 COPY_EXIT:
@@ -183,7 +209,9 @@ COPY_EXIT:
         ::close(dest_fd);
     }
 
-    VLOG(3) << "copy file success. [src=" << src << " dest=" << dest << "]";
+    if (res == OLAP_SUCCESS) {
+        VLOG(3) << "copy file success. [src=" << src << " dest=" << dest << "]";
+    }
 
     return res;
 }
@@ -48,6 +48,8 @@
 
 namespace starrocks {
 
+class TokenBucket;
+
 const static int32_t g_power_table[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
 
 class OlapStopWatch {
@@ -78,6 +80,10 @@ OLAPStatus move_to_trash(const std::filesystem::path& schema_hash_root, const st
 
 OLAPStatus copy_file(const std::string& src, const std::string& dest);
 
+// copy |src| to |dest|, the bytes written take the tokens of |io_limiter| if it's not null.
+// if |verify_checksum| is true, |dest| is read back and its crc32c is compared with that of |src|.
+OLAPStatus copy_file(const std::string& src, const std::string& dest, TokenBucket* io_limiter, bool verify_checksum);
+
 OLAPStatus copy_dir(const std::string& src_dir, const std::string& dst_dir);
 
 bool check_datapath_rw(const std::string& path);
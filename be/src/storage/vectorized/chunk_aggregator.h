@@ -40,6 +40,9 @@ public:
 
     size_t merged_rows() const { return _merged_rows; }
 
+    // the number of the rows aggregated so far, including the last one still open.
+    size_t aggregated_rows() const { return _aggregate_chunk == nullptr ? 0 : _aggregate_chunk->num_rows(); }
+
     size_t bytes_usage();
 
     void close();
@@ -263,6 +263,24 @@ size_t ChunkHelper::approximate_sizeof_type(FieldType type) {
     return 4;
 }
 
+size_t ChunkHelper::adaptive_chunk_size(const vectorized::Schema& schema) {
+    const size_t max_size = config::vector_chunk_size;
+    if (config::vector_chunk_target_bytes <= 0) {
+        return max_size;
+    }
+    size_t row_bytes = 0;
+    for (const auto& field : schema.fields()) {
+        row_bytes += approximate_sizeof_type(field->type()->type()) + field->is_nullable();
+    }
+    if (row_bytes * max_size <= config::vector_chunk_target_bytes) {
+        return max_size;
+    }
+    size_t rows = config::vector_chunk_target_bytes / row_bytes;
+    // Round down to a power of two, so that the chunks still divide the default chunk size.
+    size_t size = rows == 0 ? 1 : (size_t{1} << (63 - __builtin_clzll(rows)));
+    return std::clamp<size_t>(size, std::min<size_t>(config::vector_chunk_min_size, max_size), max_size);
+}
+
 std::vector<size_t> ChunkHelper::get_char_field_indexes(const vectorized::Schema& schema) {
     std::vector<size_t> char_field_indexes;
     for (size_t i = 0; i < schema.num_fields(); ++i) {
@@ -291,7 +309,7 @@ void ChunkHelper::padding_char_columns(const std::vector<size_t>& char_column_in
         vectorized::Offsets& new_offset = new_binary->get_offset();
         vectorized::Bytes& new_bytes = new_binary->get_bytes();
 
-        uint32_t len = tschema.column(field_index).length();
+        uint32_t len = tschema.column(schema.field(field_index)->id()).length();
 
         new_offset.resize(num_rows + 1);
         new_bytes.assign(num_rows * len, 0); // padding 0
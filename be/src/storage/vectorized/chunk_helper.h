@@ -71,6 +71,10 @@ public:
     // FieldType data size in memory
     static size_t approximate_sizeof_type(FieldType type);
 
+    // The number of rows of a chunk of |schema| that fits in config::vector_chunk_target_bytes, rounded down
+    // to a power of two and clamped to [config::vector_chunk_min_size, config::vector_chunk_size].
+    static size_t adaptive_chunk_size(const vectorized::Schema& schema);
+
     // Get char column indexes
     static std::vector<size_t> get_char_field_indexes(const vectorized::Schema& schema);
 
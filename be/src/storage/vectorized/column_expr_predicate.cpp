@@ -1,6 +1,8 @@
 
 // This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
 
+#include <strings.h>
+
 #include "column/column_helper.h"
 #include "exprs/expr.h"
 #include "exprs/expr_context.h"
@@ -9,9 +11,91 @@
 #include "runtime/descriptors.h"
 #include "runtime/primitive_type.h"
 #include "runtime/runtime_state.h"
+#include "storage/rowset/segment_v2/bloom_filter.h"
 #include "storage/vectorized/column_predicate.h"
 namespace starrocks::vectorized {
 
+static bool get_const_string(ExprContext* ctx, Expr* expr, std::string* value) {
+    if (expr->node_type() != TExprNodeType::STRING_LITERAL) {
+        return false;
+    }
+    ColumnPtr column = expr->evaluate(ctx, nullptr);
+    if (!column->is_constant() || column->only_null()) {
+        return false;
+    }
+    Slice s = ColumnHelper::get_const_value<TYPE_VARCHAR>(column);
+    value->assign(s.data, s.size);
+    return true;
+}
+
+static bool is_const_zero(ExprContext* ctx, Expr* expr) {
+    if (expr->node_type() != TExprNodeType::INT_LITERAL) {
+        return false;
+    }
+    ColumnPtr column = expr->evaluate(ctx, nullptr);
+    if (!column->is_constant() || column->only_null()) {
+        return false;
+    }
+    switch (expr->type().type) {
+    case TYPE_TINYINT:
+        return ColumnHelper::get_const_value<TYPE_TINYINT>(column) == 0;
+    case TYPE_SMALLINT:
+        return ColumnHelper::get_const_value<TYPE_SMALLINT>(column) == 0;
+    case TYPE_INT:
+        return ColumnHelper::get_const_value<TYPE_INT>(column) == 0;
+    case TYPE_BIGINT:
+        return ColumnHelper::get_const_value<TYPE_BIGINT>(column) == 0;
+    default:
+        return false;
+    }
+}
+
+static bool is_function(Expr* expr, const char* name) {
+    auto type = expr->node_type();
+    return (type == TExprNodeType::FUNCTION_CALL || type == TExprNodeType::COMPUTE_FUNCTION_CALL) &&
+           strcasecmp(expr->fn().name.function_name.c_str(), name) == 0;
+}
+
+// The literal pieces between the wildcards of a LIKE pattern, with the escape character '\\' removed.
+static std::vector<std::string> split_like_pattern(const std::string& pattern) {
+    std::vector<std::string> pieces(1);
+    for (size_t i = 0; i < pattern.size(); i++) {
+        char c = pattern[i];
+        if (c == '\\' && i + 1 < pattern.size()) {
+            pieces.back().push_back(pattern[++i]);
+        } else if (c == '%' || c == '_') {
+            pieces.emplace_back();
+        } else {
+            pieces.back().push_back(c);
+        }
+    }
+    return pieces;
+}
+
+// The substrings contained in all the values satisfying |ctx|, which is one of
+//     col LIKE 'pattern', instr(col, 'str') > 0, locate('str', col) > 0
+static std::vector<std::string> required_substrings(ExprContext* ctx) {
+    Expr* root = ctx->root();
+    std::string value;
+    if (is_function(root, "like") && root->get_num_children() == 2 && root->get_child(0)->is_slotref() &&
+        get_const_string(ctx, root->get_child(1), &value)) {
+        return split_like_pattern(value);
+    }
+    if (root->node_type() == TExprNodeType::BINARY_PRED && root->op() == TExprOpcode::GT &&
+        is_const_zero(ctx, root->get_child(1))) {
+        Expr* fn = root->get_child(0);
+        if (is_function(fn, "instr") && fn->get_num_children() == 2 && fn->get_child(0)->is_slotref() &&
+            get_const_string(ctx, fn->get_child(1), &value)) {
+            return {value};
+        }
+        if (is_function(fn, "locate") && fn->get_num_children() == 2 && fn->get_child(1)->is_slotref() &&
+            get_const_string(ctx, fn->get_child(0), &value)) {
+            return {value};
+        }
+    }
+    return {};
+}
+
 // This class is a bridge to connect ColumnPredicatew which is used in scan/storage layer, and ExprContext which is
 // used in computation layer. By bridging that, we can push more predicates from computation layer onto storage layer,
 // hopefully to scan less data and boost performance.
@@ -38,6 +122,11 @@ public:
             expr_ctx->clone(_state, &ctx);
             _expr_ctxs.emplace_back(ctx);
             _monotonic &= ctx->root()->is_monotonic();
+            // the column is casted to another type if there are more contexts, whose substrings may differ.
+            _substrings.clear();
+            if (_expr_ctxs.size() == 1) {
+                _substrings = required_substrings(ctx);
+            }
         }
     }
 
@@ -141,6 +230,19 @@ public:
     }
 
     bool support_bloom_filter() const override { return false; }
+
+    bool support_ngram_bloom_filter() const override { return !_substrings.empty(); }
+
+    bool ngram_bloom_filter(const segment_v2::BloomFilter* bf, size_t gram_size) const override {
+        for (const auto& str : _substrings) {
+            for (size_t pos = 0; gram_size > 0 && pos + gram_size <= str.size(); pos++) {
+                if (!bf->test_bytes(str.data() + pos, gram_size)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
     PredicateType type() const override { return PredicateType::kExpr; }
     bool can_vectorized() const override { return true; }
 
@@ -183,6 +285,8 @@ private:
     std::vector<ExprContext*> _expr_ctxs;
     const SlotDescriptor* _slot_desc;
     bool _monotonic;
+    // the substrings of the values satisfying the predicate, tested against the n-gram bloom filters.
+    std::vector<std::string> _substrings;
 };
 
 ColumnPredicate* new_column_expr_predicate(const TypeInfoPtr& type, ColumnId column_id, RuntimeState* state,
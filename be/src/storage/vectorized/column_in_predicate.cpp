@@ -1,10 +1,12 @@
 // This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
 
+#include <mutex>
 #include <type_traits>
 
 #include "column/binary_column.h"
 #include "column/column.h"
 #include "column/nullable_column.h"
+#include "common/config.h"
 #include "gutil/casts.h"
 #include "roaring/roaring.hh"
 #include "storage/rowset/segment_v2/bitmap_index_reader.h"
@@ -116,16 +118,22 @@ public:
         return Status::OK();
     }
 
-    bool support_bloom_filter() const override { return true; }
+    bool support_bloom_filter() const override {
+        return _values.size() <= static_cast<size_t>(config::bloom_filter_max_in_list_size);
+    }
 
     bool bloom_filter(const segment_v2::BloomFilter* bf) const override {
         static_assert(field_type != OLAP_FIELD_TYPE_HLL, "TODO");
         static_assert(field_type != OLAP_FIELD_TYPE_OBJECT, "TODO");
         static_assert(field_type != OLAP_FIELD_TYPE_PERCENTILE, "TODO");
-        for (const ValueType& v : _values) {
-            RETURN_IF(bf->test_bytes(reinterpret_cast<const char*>(&v), sizeof(v)), true);
-        }
-        return false;
+        // the values are hashed once for the bloom filters of all the pages, which share one hash strategy.
+        std::call_once(_bf_hashes_once, [&]() {
+            _bf_hashes.reserve(_values.size());
+            for (const ValueType& v : _values) {
+                _bf_hashes.push_back(bf->hash(reinterpret_cast<const char*>(&v), sizeof(v)));
+            }
+        });
+        return bf->test_any_hash(_bf_hashes.data(), _bf_hashes.size());
     }
 
     PredicateType type() const override { return PredicateType::kInList; }
@@ -174,6 +182,8 @@ public:
 
 private:
     ItemSet _values;
+    mutable std::once_flag _bf_hashes_once;
+    mutable std::vector<uint64_t> _bf_hashes;
 };
 
 // Template specialization for binary column
@@ -316,14 +326,18 @@ public:
         return Status::OK();
     }
 
-    bool support_bloom_filter() const override { return true; }
+    bool support_bloom_filter() const override {
+        return _zero_padded_strs.size() <= static_cast<size_t>(config::bloom_filter_max_in_list_size);
+    }
 
     bool bloom_filter(const segment_v2::BloomFilter* bf) const override {
-        for (const auto& str : _zero_padded_strs) {
-            Slice v(str);
-            RETURN_IF(bf->test_bytes(v.data, v.size), true);
-        }
-        return false;
+        std::call_once(_bf_hashes_once, [&]() {
+            _bf_hashes.reserve(_zero_padded_strs.size());
+            for (const auto& str : _zero_padded_strs) {
+                _bf_hashes.push_back(bf->hash(str.data(), str.size()));
+            }
+        });
+        return bf->test_any_hash(_bf_hashes.data(), _bf_hashes.size());
     }
 
     bool can_vectorized() const override { return false; }
@@ -363,6 +377,8 @@ public:
 private:
     std::vector<std::string> _zero_padded_strs;
     ItemHashSet<Slice> _slices;
+    mutable std::once_flag _bf_hashes_once;
+    mutable std::vector<uint64_t> _bf_hashes;
 };
 
 template <template <typename, size_t...> typename Set, size_t... Args>
@@ -109,6 +109,13 @@ public:
     // Return false to filter out a data page.
     virtual bool bloom_filter(const segment_v2::BloomFilter* bf) const { return true; }
 
+    // Whether the predicate searches for some substrings, e.g. LIKE '%abc%', which can be tested against the
+    // n-gram bloom filters.
+    virtual bool support_ngram_bloom_filter() const { return false; }
+
+    // Return false to filter out a data page, |bf| contains the n-grams of |gram_size| bytes of its values.
+    virtual bool ngram_bloom_filter(const segment_v2::BloomFilter* bf, size_t gram_size) const { return true; }
+
     virtual Status seek_bitmap_dictionary(segment_v2::BitmapIndexIterator* iter, SparseRange* range) const {
         return Status::Cancelled("not implemented");
     }
@@ -2,11 +2,20 @@
 
 #include "storage/vectorized/compaction.h"
 
+#include <thread>
 #include <utility>
 
+#include "column/chunk.h"
+#include "column/datum_convert.h"
+#include "gutil/casts.h"
 #include "gutil/strings/substitute.h"
 #include "runtime/current_thread.h"
+#include "storage/data_dir.h"
+#include "storage/fs/fs_util.h"
+#include "storage/rowset/beta_rowset.h"
 #include "storage/rowset/rowset_factory.h"
+#include "storage/rowset/segment_v2/column_reader.h"
+#include "storage/rowset/segment_v2/segment.h"
 #include "storage/vectorized/chunk_helper.h"
 #include "storage/vectorized/tablet_reader.h"
 #include "util/defer_op.h"
@@ -63,6 +72,17 @@ Status Compaction::do_compaction_impl() {
     LOG(INFO) << "start " << compaction_name() << ". tablet=" << _tablet->full_name()
               << ", output version is=" << _output_version.first << "-" << _output_version.second;
 
+    split_column_into_groups();
+    if (!_column_groups.empty()) {
+        LOG(INFO) << compaction_name() << " merges " << _column_groups.size()
+                  << " column groups vertically. tablet=" << _tablet->full_name();
+    } else {
+        split_key_ranges();
+        if (!_key_range_bounds.empty()) {
+            LOG(INFO) << compaction_name() << " merges " << _key_range_bounds.size() + 1
+                      << " key ranges in parallel. tablet=" << _tablet->full_name();
+        }
+    }
     RETURN_IF_ERROR(construct_output_rowset_writer());
     TRACE("prepare finished");
 
@@ -124,6 +144,10 @@ Status Compaction::do_compaction_impl() {
 }
 
 Status Compaction::construct_output_rowset_writer() {
+    return create_rowset_writer(&_output_rs_writer);
+}
+
+Status Compaction::create_rowset_writer(std::unique_ptr<RowsetWriter>* writer) {
     RowsetWriterContext context(kDataFormatV2, config::storage_format_version);
     context.mem_tracker = _mem_tracker.get();
     context.rowset_id = StorageEngine::instance()->next_rowset_id();
@@ -138,7 +162,23 @@ Status Compaction::construct_output_rowset_writer() {
     context.version = _output_version;
     context.version_hash = _output_version_hash;
     context.segments_overlap = NONOVERLAPPING;
-    Status st = RowsetFactory::create_rowset_writer(context, &_output_rs_writer);
+    context.io_limiter = _tablet->data_dir()->background_io_limiter();
+    // the columns outlive their TTL when the newest input rowset does.
+    if (config::cold_column_ttl_sec > 0 && !config::cold_column_storage_path.empty()) {
+        int64_t newest_creation_time = 0;
+        for (const auto& rowset : _input_rowsets) {
+            newest_creation_time = std::max(newest_creation_time, rowset->creation_time());
+        }
+        context.write_cold_columns = newest_creation_time + config::cold_column_ttl_sec < UnixSeconds();
+    }
+    if (!_column_groups.empty()) {
+        // the segments are split by the number of rows in vertical compaction, which is estimated
+        // by the average row size of the input rowsets.
+        int64_t avg_row_size = (_input_rowsets_size + 1) / (_input_row_num + 1);
+        int64_t max_segment_size = OLAP_MAX_COLUMN_SEGMENT_FILE_SIZE * OLAP_COLUMN_FILE_SEGMENT_SIZE_SCALE;
+        context.max_rows_per_segment = std::max<int64_t>(1, max_segment_size / (avg_row_size + 1));
+    }
+    Status st = RowsetFactory::create_rowset_writer(context, writer);
     if (!st.ok()) {
         std::stringstream ss;
         ss << "Fail to create rowset writer. tablet_id=" << context.tablet_id << " err=" << st;
@@ -148,30 +188,210 @@ Status Compaction::construct_output_rowset_writer() {
     return Status::OK();
 }
 
-Status Compaction::merge_rowsets(MemTracker* mem_tracker, Statistics* stats_output) {
-    TRACE_COUNTER_SCOPE_LATENCY_US("merge_rowsets_latency_us");
-    Schema schema = ChunkHelper::convert_schema_to_format_v2(_tablet->tablet_schema());
-    TabletReader reader(_tablet, _output_rs_writer->version(), schema);
-    TabletReaderParams reader_params;
-    reader_params.reader_type = compaction_type();
-    reader_params.profile = _runtime_profile.create_child("merge_rowsets");
-
+// Calculate the chunk size to read the input rowsets within the memory limit,
+// |column_ratio| is the ratio of the columns read at the same time.
+static size_t compaction_chunk_size(MemTracker* mem_tracker, const std::vector<RowsetSharedPtr>& rowsets,
+                                    double column_ratio) {
     int64_t num_rows = 0;
     int64_t total_row_size = 0;
     uint64_t chunk_size = DEFAULT_CHUNK_SIZE;
     if (mem_tracker->limit() > 0) {
-        for (auto& rowset : _input_rowsets) {
+        for (auto& rowset : rowsets) {
             num_rows += rowset->num_rows();
             total_row_size += rowset->total_row_size();
         }
-        int64_t avg_row_size = (total_row_size + 1) / (num_rows + 1);
+        auto avg_row_size = static_cast<int64_t>(column_ratio * (total_row_size + 1) / (num_rows + 1));
         // The result of thie division operation be zero, so added one
-        chunk_size = 1 + mem_tracker->limit() / (_input_rowsets.size() * avg_row_size + 1);
+        chunk_size = 1 + mem_tracker->limit() / (rowsets.size() * avg_row_size + 1);
     }
     if (chunk_size > config::vector_chunk_size) {
         chunk_size = config::vector_chunk_size;
     }
+    return chunk_size;
+}
+
+Status Compaction::merge_rowsets(MemTracker* mem_tracker, Statistics* stats_output) {
+    if (!_column_groups.empty()) {
+        return merge_rowsets_vertically(mem_tracker, stats_output);
+    }
+    if (!_key_range_bounds.empty()) {
+        return merge_rowsets_by_key_ranges(mem_tracker, stats_output);
+    }
+    return merge_rowsets_horizontally(mem_tracker, stats_output);
+}
+
+// Read the short keys of |num_samples| rows evenly spaced in |rowset|, whose rows are sorted, and append
+// them to |samples| in ascending order without duplicates.
+static Status sample_short_keys(const TabletSchema& tablet_schema, const RowsetSharedPtr& rowset, size_t num_samples,
+                                std::vector<OlapTuple>* samples) {
+    RETURN_IF_ERROR(rowset->load());
+    RowsetReleaseGuard guard(rowset);
+    auto& segments = down_cast<BetaRowset*>(rowset.get())->segments();
+    int64_t total_rows = 0;
+    for (auto& segment : segments) {
+        total_rows += segment->num_rows();
+    }
+    if (total_rows == 0) {
+        return Status::OK();
+    }
+
+    const size_t num_keys = tablet_schema.num_short_key_columns();
+    std::vector<Field> fields;
+    Columns columns;
+    for (uint32_t cid = 0; cid < num_keys; ++cid) {
+        fields.emplace_back(ChunkHelper::convert_field_to_format_v2(cid, tablet_schema.column(cid)));
+        auto column = ChunkHelper::column_from_field(fields.back());
+        if (column == nullptr) {
+            return Status::NotSupported("unsupported type of short key column");
+        }
+        columns.emplace_back(std::move(column));
+    }
+
+    OlapReaderStatistics stats;
+    int64_t segment_begin = 0;
+    size_t k = 1;
+    for (auto& segment : segments) {
+        int64_t segment_end = segment_begin + segment->num_rows();
+        std::vector<rowid_t> rowids;
+        for (; k <= num_samples; ++k) {
+            int64_t ordinal = k * total_rows / (num_samples + 1);
+            if (ordinal >= segment_end) {
+                break;
+            }
+            rowids.push_back(static_cast<rowid_t>(ordinal - segment_begin));
+        }
+        segment_begin = segment_end;
+        if (rowids.empty()) {
+            continue;
+        }
+        std::unique_ptr<fs::ReadableBlock> rblock;
+        RETURN_IF_ERROR(segment->block_manager()->open_block(segment->file_name(), &rblock));
+        for (uint32_t cid = 0; cid < num_keys; ++cid) {
+            // the keys of the old storage format have to be converted, they are not sampled.
+            const segment_v2::ColumnReader* column_reader = segment->column(cid);
+            if (column_reader == nullptr || column_reader->column_type() != fields[cid].type()->type()) {
+                return Status::NotSupported("short key column of the old format");
+            }
+            segment_v2::ColumnIterator* raw_iter = nullptr;
+            RETURN_IF_ERROR(segment->new_column_iterator(cid, &raw_iter));
+            std::unique_ptr<segment_v2::ColumnIterator> iter(raw_iter);
+            segment_v2::ColumnIteratorOptions iter_opts;
+            iter_opts.stats = &stats;
+            iter_opts.rblock = rblock.get();
+            RETURN_IF_ERROR(iter->init(iter_opts));
+            RETURN_IF_ERROR(iter->fetch_values_by_rowid(rowids.data(), rowids.size(), columns[cid].get()));
+        }
+    }
+
+    for (size_t r = 0; r < columns[0]->size(); ++r) {
+        if (r > 0) {
+            int cmp = 0;
+            for (size_t cid = 0; cid < num_keys && cmp == 0; ++cid) {
+                cmp = columns[cid]->compare_at(r, r - 1, *columns[cid], -1);
+            }
+            if (cmp < 0) {
+                return Status::InternalError("short keys sampled are not in order");
+            }
+            if (cmp == 0) {
+                continue;
+            }
+        }
+        OlapTuple tuple;
+        for (size_t cid = 0; cid < num_keys; ++cid) {
+            Datum datum = columns[cid]->get(r);
+            if (datum.is_null()) {
+                tuple.add_null();
+            } else {
+                tuple.add_value(datum_to_string(fields[cid].type().get(), datum));
+            }
+        }
+        samples->emplace_back(std::move(tuple));
+    }
+    return Status::OK();
+}
+
+void Compaction::split_key_ranges() {
+    const TabletSchema& tablet_schema = _tablet->tablet_schema();
+    int32_t max_key_ranges = config::compaction_max_key_ranges;
+    if (max_key_ranges <= 1 || _input_rowsets_size < config::compaction_key_range_split_min_bytes ||
+        tablet_schema.keys_type() == KeysType::PRIMARY_KEYS || tablet_schema.num_short_key_columns() == 0) {
+        return;
+    }
+    // the boundaries are sampled from the largest input rowset, which must be sorted. the rows of the
+    // same short key are in the same range, so that the rows of the same key are still merged together.
+    RowsetSharedPtr largest;
+    for (auto& rowset : _input_rowsets) {
+        if (largest == nullptr || rowset->data_disk_size() > largest->data_disk_size()) {
+            largest = rowset;
+        }
+    }
+    if (largest == nullptr || largest->num_rows() == 0 ||
+        (largest->num_segments() > 1 && largest->rowset_meta()->segments_overlap() != NONOVERLAPPING)) {
+        return;
+    }
+    Status st = sample_short_keys(tablet_schema, largest, max_key_ranges - 1, &_key_range_bounds);
+    if (!st.ok()) {
+        LOG(WARNING) << "failed to sample key ranges of rowset " << largest->rowset_id() << ", tablet "
+                     << _tablet->full_name() << ", merge as a whole: " << st;
+        _key_range_bounds.clear();
+    }
+}
+
+void Compaction::split_column_into_groups() {
+    const TabletSchema& tablet_schema = _tablet->tablet_schema();
+    size_t num_key_columns = tablet_schema.num_key_columns();
+    size_t num_columns = tablet_schema.num_columns();
+    size_t max_columns_per_group = std::max(config::vertical_compaction_max_columns_per_group, 0);
+    if (!config::enable_vertical_compaction || max_columns_per_group == 0 ||
+        tablet_schema.keys_type() == KeysType::PRIMARY_KEYS || num_columns - num_key_columns <= max_columns_per_group) {
+        return;
+    }
+    // the key columns are the first columns of the schema.
+    std::vector<uint32_t> key_columns;
+    for (uint32_t cid = 0; cid < num_key_columns; ++cid) {
+        key_columns.push_back(cid);
+    }
+    _column_groups.emplace_back(std::move(key_columns));
+    for (uint32_t cid = num_key_columns; cid < num_columns; ++cid) {
+        if ((cid - num_key_columns) % max_columns_per_group == 0) {
+            _column_groups.emplace_back();
+        }
+        _column_groups.back().push_back(cid);
+    }
+}
+
+Status Compaction::merge_rowsets_horizontally(MemTracker* mem_tracker, Statistics* stats_output) {
+    TRACE_COUNTER_SCOPE_LATENCY_US("merge_rowsets_latency_us");
+    size_t chunk_size = compaction_chunk_size(mem_tracker, _input_rowsets, 1.0);
+    RETURN_IF_ERROR(merge_key_range(mem_tracker, OlapTuple(), OlapTuple(), chunk_size,
+                                    _runtime_profile.create_child("merge_rowsets"), _output_rs_writer.get(),
+                                    stats_output));
+
+    OLAPStatus olap_status = _output_rs_writer->flush();
+    if (olap_status != OLAP_SUCCESS) {
+        LOG(WARNING) << "failed to flush rowset when merging rowsets of tablet " + _tablet->full_name()
+                     << ", err=" << olap_status;
+        return Status::InternalError("failed to flush rowset when merging rowsets of tablet error.");
+    }
+
+    return Status::OK();
+}
+
+Status Compaction::merge_key_range(MemTracker* mem_tracker, const OlapTuple& lower, const OlapTuple& upper,
+                                   size_t chunk_size, RuntimeProfile* profile, RowsetWriter* writer,
+                                   Statistics* stats_output) {
+    Schema schema = ChunkHelper::convert_schema_to_format_v2(_tablet->tablet_schema());
+    TabletReader reader(_tablet, _output_version, schema, _input_rowsets);
+    TabletReaderParams reader_params;
+    reader_params.reader_type = compaction_type();
+    reader_params.profile = profile;
     reader_params.chunk_size = chunk_size;
+    if (lower.size() > 0 || upper.size() > 0) {
+        reader_params.range = "ge";
+        reader_params.end_range = "lt";
+        reader_params.start_key.push_back(lower);
+        reader_params.end_key.push_back(upper);
+    }
     RETURN_IF_ERROR(reader.prepare());
     RETURN_IF_ERROR(reader.open(reader_params));
 
@@ -185,6 +405,7 @@ Status Compaction::merge_rowsets(MemTracker* mem_tracker, Statistics* stats_outp
 
     auto char_field_indexes = ChunkHelper::get_char_field_indexes(schema);
 
+    int64_t bytes_read = 0;
     while (true) {
         chunk->reset();
         Status status = reader.get_next(chunk.get());
@@ -195,10 +416,11 @@ Status Compaction::merge_rowsets(MemTracker* mem_tracker, Statistics* stats_outp
                 return Status::InternalError("reader get_next error.");
             }
         }
+        throttle_read(reader, &bytes_read);
 
         ChunkHelper::padding_char_columns(char_field_indexes, schema, _tablet->tablet_schema(), chunk.get());
 
-        OLAPStatus olap_status = _output_rs_writer->add_chunk(*chunk);
+        OLAPStatus olap_status = writer->add_chunk(*chunk);
         if (olap_status != OLAP_SUCCESS) {
             LOG(WARNING) << "writer add_chunk error, err=" << olap_status;
             return Status::InternalError("writer add_chunk error.");
@@ -211,12 +433,172 @@ Status Compaction::merge_rowsets(MemTracker* mem_tracker, Statistics* stats_outp
         stats_output->merged_rows = reader.merged_rows();
         stats_output->filtered_rows = reader.stats().rows_del_filtered;
     }
+    return Status::OK();
+}
 
-    OLAPStatus olap_status = _output_rs_writer->flush();
+Status Compaction::merge_rowsets_by_key_ranges(MemTracker* mem_tracker, Statistics* stats_output) {
+    TRACE_COUNTER_SCOPE_LATENCY_US("merge_rowsets_latency_us");
+    const size_t num_ranges = _key_range_bounds.size() + 1;
+    // all the ranges are read at the same time, so the chunk size is shrunk as if the rows were
+    // |num_ranges| times larger.
+    size_t chunk_size = compaction_chunk_size(mem_tracker, _input_rowsets, static_cast<double>(num_ranges));
+
+    std::vector<std::unique_ptr<RowsetWriter>> writers(num_ranges);
+    std::vector<RuntimeProfile*> profiles(num_ranges);
+    for (size_t i = 0; i < num_ranges; ++i) {
+        RETURN_IF_ERROR(create_rowset_writer(&writers[i]));
+        profiles[i] = _runtime_profile.create_child(strings::Substitute("merge_rowsets_range_$0", i));
+    }
+
+    const OlapTuple unbounded;
+    std::vector<Statistics> stats(num_ranges);
+    std::vector<Status> results(num_ranges);
+    std::vector<std::thread> threads;
+    threads.reserve(num_ranges);
+    for (size_t i = 0; i < num_ranges; ++i) {
+        const OlapTuple* lower = (i == 0) ? &unbounded : &_key_range_bounds[i - 1];
+        const OlapTuple* upper = (i + 1 == num_ranges) ? &unbounded : &_key_range_bounds[i];
+        threads.emplace_back([&, i, lower, upper] {
+            results[i] = merge_key_range(mem_tracker, *lower, *upper, chunk_size, profiles[i], writers[i].get(),
+                                         &stats[i]);
+            if (results[i].ok() && writers[i]->flush() != OLAP_SUCCESS) {
+                results[i] = Status::InternalError("failed to flush rowset when merging rowsets of tablet error.");
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (size_t i = 0; i < num_ranges; ++i) {
+        if (!results[i].ok()) {
+            LOG(WARNING) << "failed to merge key range " << i << " of tablet " << _tablet->full_name() << ", "
+                         << results[i];
+            return results[i];
+        }
+    }
+
+    // the files of the range rowsets are linked into the output rowset, and removed by gc.
+    std::vector<RowsetSharedPtr> range_rowsets;
+    DeferOp range_rowsets_releaser([&range_rowsets] {
+        for (auto& rowset : range_rowsets) {
+            StorageEngine::instance()->add_unused_rowset(rowset);
+        }
+    });
+    Statistics total;
+    for (size_t i = 0; i < num_ranges; ++i) {
+        RowsetSharedPtr rowset = writers[i]->build();
+        if (rowset == nullptr) {
+            return Status::InternalError("failed to build rowset of key range when merging rowsets.");
+        }
+        range_rowsets.push_back(rowset);
+        OLAPStatus olap_status = _output_rs_writer->add_rowset(rowset);
+        if (olap_status != OLAP_SUCCESS) {
+            LOG(WARNING) << "failed to add rowset of key range " << i << " to the output of tablet "
+                         << _tablet->full_name() << ", err=" << olap_status;
+            return Status::InternalError("failed to add rowset of key range when merging rowsets.");
+        }
+        total.output_rows += stats[i].output_rows;
+        total.merged_rows += stats[i].merged_rows;
+        total.filtered_rows += stats[i].filtered_rows;
+    }
+    if (stats_output != nullptr) {
+        *stats_output = total;
+    }
+    return Status::OK();
+}
+
+Status Compaction::merge_rowsets_vertically(MemTracker* mem_tracker, Statistics* stats_output) {
+    TRACE_COUNTER_SCOPE_LATENCY_US("merge_rowsets_latency_us");
+    const TabletSchema& tablet_schema = _tablet->tablet_schema();
+    const std::vector<uint32_t>& key_columns = _column_groups[0];
+    int64_t output_rows = 0;
+
+    for (size_t i = 0; i < _column_groups.size(); ++i) {
+        const bool is_key = (i == 0);
+        // the key columns are read with every group of value columns, so that the rows are merged in the
+        // same order: MergeIterator orders the rows of equal keys by their iterators.
+        std::vector<ColumnId> read_columns(key_columns.begin(), key_columns.end());
+        if (!is_key) {
+            read_columns.insert(read_columns.end(), _column_groups[i].begin(), _column_groups[i].end());
+        }
+        Schema schema = ChunkHelper::convert_schema_to_format_v2(tablet_schema, read_columns);
+        auto group_schema =
+                std::make_shared<Schema>(ChunkHelper::convert_schema_to_format_v2(tablet_schema, _column_groups[i]));
+
+        TabletReader reader(_tablet, _output_rs_writer->version(), schema, _input_rowsets);
+        TabletReaderParams reader_params;
+        reader_params.reader_type = compaction_type();
+        reader_params.profile = _runtime_profile.create_child(strings::Substitute("merge_rowsets_group_$0", i));
+        double column_ratio = static_cast<double>(read_columns.size()) / tablet_schema.num_columns();
+        reader_params.chunk_size = compaction_chunk_size(mem_tracker, _input_rowsets, column_ratio);
+        RETURN_IF_ERROR(reader.prepare());
+        RETURN_IF_ERROR(reader.open(reader_params));
+
+        auto chunk = ChunkHelper::new_chunk(schema, reader_params.chunk_size);
+
+        auto tracker = std::make_unique<MemTracker>(-1, "merge_rowsets", mem_tracker, true);
+
+        DeferOp memory_tracker_releaser([&tracker] { return tracker->release(tracker->consumption()); });
+
+        auto char_field_indexes = ChunkHelper::get_char_field_indexes(schema);
+
+        int64_t group_rows = 0;
+        int64_t bytes_read = 0;
+        while (true) {
+            chunk->reset();
+            Status status = reader.get_next(chunk.get());
+            if (!status.ok()) {
+                if (status.is_end_of_file()) {
+                    break;
+                } else {
+                    return Status::InternalError("reader get_next error.");
+                }
+            }
+            throttle_read(reader, &bytes_read);
+
+            ChunkHelper::padding_char_columns(char_field_indexes, schema, tablet_schema, chunk.get());
+
+            OLAPStatus olap_status;
+            if (is_key) {
+                olap_status = _output_rs_writer->add_columns(*chunk, _column_groups[i], true);
+            } else {
+                Columns columns(chunk->columns().begin() + key_columns.size(), chunk->columns().end());
+                Chunk group_chunk(std::move(columns), group_schema);
+                olap_status = _output_rs_writer->add_columns(group_chunk, _column_groups[i], false);
+            }
+            if (olap_status != OLAP_SUCCESS) {
+                LOG(WARNING) << "writer add_columns error, err=" << olap_status;
+                return Status::InternalError("writer add_columns error.");
+            }
+            group_rows += chunk->num_rows();
+        }
+
+        if (is_key) {
+            output_rows = group_rows;
+            if (stats_output != nullptr) {
+                stats_output->output_rows = output_rows;
+                stats_output->merged_rows = reader.merged_rows();
+                stats_output->filtered_rows = reader.stats().rows_del_filtered;
+            }
+        } else if (group_rows != output_rows) {
+            LOG(WARNING) << "rows of column group " << i << " is " << group_rows << ", but key columns have "
+                         << output_rows << " rows, tablet=" << _tablet->full_name();
+            return Status::InternalError("column group rows mismatch when merging rowsets vertically.");
+        }
+
+        OLAPStatus olap_status = _output_rs_writer->flush_columns();
+        if (olap_status != OLAP_SUCCESS) {
+            LOG(WARNING) << "failed to flush columns when merging rowsets of tablet " + _tablet->full_name()
+                         << ", err=" << olap_status;
+            return Status::InternalError("failed to flush columns when merging rowsets of tablet error.");
+        }
+    }
+
+    OLAPStatus olap_status = _output_rs_writer->final_flush();
     if (olap_status != OLAP_SUCCESS) {
-        LOG(WARNING) << "failed to flush rowset when merging rowsets of tablet " + _tablet->full_name()
+        LOG(WARNING) << "failed to final flush rowset when merging rowsets of tablet " + _tablet->full_name()
                      << ", err=" << olap_status;
-        return Status::InternalError("failed to flush rowset when merging rowsets of tablet error.");
+        return Status::InternalError("failed to final flush rowset when merging rowsets of tablet error.");
     }
 
     return Status::OK();
@@ -247,6 +629,12 @@ Status Compaction::check_version_continuity(const std::vector<RowsetSharedPtr>&
     return Status::OK();
 }
 
+void Compaction::throttle_read(const TabletReader& reader, int64_t* last_bytes_read) {
+    int64_t bytes_read = reader.stats().compressed_bytes_read;
+    _tablet->data_dir()->background_io_limiter()->acquire(bytes_read - *last_bytes_read);
+    *last_bytes_read = bytes_read;
+}
+
 Status Compaction::check_correctness(const Statistics& stats) {
     // check row number
     if (_input_row_num != _output_rowset->num_rows() + stats.merged_rows + stats.filtered_rows) {
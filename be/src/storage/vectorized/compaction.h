@@ -11,12 +11,14 @@
 #include "storage/storage_engine.h"
 #include "storage/tablet.h"
 #include "storage/tablet_meta.h"
+#include "storage/tuple.h"
 #include "storage/utils.h"
 #include "util/semaphore.hpp"
 
 namespace starrocks::vectorized {
 
 class DataDir;
+class TabletReader;
 
 // This class is a base class for compaction.
 // The entrance of this class is compact()
@@ -57,10 +59,38 @@ protected:
     // return others on error
     Status merge_rowsets(MemTracker* mem_tracker, Statistics* stats_output);
 
+    // merge all the columns at once.
+    Status merge_rowsets_horizontally(MemTracker* mem_tracker, Statistics* stats_output);
+
+    // merge the key columns, and then each group of value columns together with the key columns,
+    // the merge is deterministic so that the rows of every group are in the same order.
+    Status merge_rowsets_vertically(MemTracker* mem_tracker, Statistics* stats_output);
+
+    // merge the key ranges split by |_key_range_bounds| in parallel, every range is merged into a separate
+    // rowset, and the rowsets are added to `_output_rs_writer` in the order of keys.
+    Status merge_rowsets_by_key_ranges(MemTracker* mem_tracker, Statistics* stats_output);
+
+    // merge the rows of all the columns in [lower, upper) into |writer|, an empty bound means unbounded.
+    Status merge_key_range(MemTracker* mem_tracker, const OlapTuple& lower, const OlapTuple& upper,
+                           size_t chunk_size, RuntimeProfile* profile, RowsetWriter* writer, Statistics* stats_output);
+
+    // split the columns into |_column_groups| if the tablet has too many value columns.
+    void split_column_into_groups();
+
+    // split the key space into ranges by |_key_range_bounds| if the input rowsets are large.
+    void split_key_ranges();
+
     void modify_rowsets();
 
     Status construct_output_rowset_writer();
 
+    // create a writer of a rowset with the output version and a new rowset id.
+    Status create_rowset_writer(std::unique_ptr<RowsetWriter>* writer);
+
+    // take the tokens of the bytes |reader| has read since the previous call from the io limiter
+    // of the data dir, so that compaction does not saturate the disk used by queries.
+    void throttle_read(const TabletReader& reader, int64_t* last_bytes_read);
+
     Status check_version_continuity(const std::vector<RowsetSharedPtr>& rowsets);
     Status check_correctness(const Statistics& stats);
 
@@ -75,6 +105,12 @@ protected:
     int64_t _input_rowsets_size;
     int64_t _input_row_num;
 
+    // the key columns and the groups of value columns for vertical compaction, empty for horizontal compaction.
+    std::vector<std::vector<uint32_t>> _column_groups;
+    // the ascending short keys splitting the input rows into key ranges merged in parallel,
+    // empty if the input rowsets are merged as a whole.
+    std::vector<OlapTuple> _key_range_bounds;
+
     RowsetSharedPtr _output_rowset;
     std::unique_ptr<RowsetWriter> _output_rs_writer;
 
@@ -11,6 +11,7 @@
 #include "storage/tablet_updates.h"
 #include "storage/update_manager.h"
 #include "storage/vectorized/memtable.h"
+#include "util/time.h"
 
 namespace starrocks::vectorized {
 
@@ -123,6 +124,8 @@ Status DeltaWriter::init() {
         break;
     }
 
+    RETURN_IF_ERROR(_init_partial_update());
+
     RowsetWriterContext writer_context(kDataFormatV2, config::storage_format_version);
     writer_context.mem_tracker = _mem_tracker.get();
     writer_context.rowset_id = _storage_engine->next_rowset_id();
@@ -133,6 +136,7 @@ Status DeltaWriter::init() {
     writer_context.rowset_type = BETA_ROWSET;
     writer_context.rowset_path_prefix = _tablet->tablet_path();
     writer_context.tablet_schema = &(_tablet->tablet_schema());
+    writer_context.partial_update_tablet_schema = _partial_update_tablet_schema.get();
     writer_context.rowset_state = PREPARED;
     writer_context.txn_id = _req.txn_id;
     writer_context.load_id = _req.load_id;
@@ -146,7 +150,8 @@ Status DeltaWriter::init() {
         return Status::InternalError(ss.str());
     }
 
-    _tablet_schema = &(_tablet->tablet_schema());
+    _tablet_schema = _partial_update_tablet_schema != nullptr ? _partial_update_tablet_schema.get()
+                                                              : &(_tablet->tablet_schema());
     _reset_mem_table();
 
     // create flush handler
@@ -162,6 +167,55 @@ Status DeltaWriter::init() {
     return Status::OK();
 }
 
+Status DeltaWriter::_init_partial_update() {
+    const TabletSchema& tablet_schema = _tablet->tablet_schema();
+    size_t num_load_columns = _req.slots->size();
+    if (num_load_columns > 0 && _req.slots->back()->col_name() == "__op") {
+        num_load_columns--;
+    }
+    if (tablet_schema.keys_type() != KeysType::PRIMARY_KEYS || num_load_columns >= tablet_schema.num_columns()) {
+        return Status::OK();
+    }
+    // the load of a primary key tablet with only some of its columns is a partial update, the
+    // others are filled with the latest rows of the same keys when the rowset is applied.
+    std::vector<int32_t> column_indexes;
+    column_indexes.reserve(num_load_columns);
+    for (size_t i = 0; i < num_load_columns; i++) {
+        const std::string& name = (*_req.slots)[i]->col_name();
+        size_t index = tablet_schema.field_index(name);
+        if (index >= tablet_schema.num_columns()) {
+            return Status::InvalidArgument(Substitute("partial update column $0 not found in tablet:$1", name,
+                                                      _tablet->tablet_id()));
+        }
+        if (!column_indexes.empty() && static_cast<int32_t>(index) <= column_indexes.back()) {
+            return Status::InvalidArgument(Substitute("partial update columns not in order of the schema tablet:$0",
+                                                      _tablet->tablet_id()));
+        }
+        column_indexes.push_back(static_cast<int32_t>(index));
+    }
+    const size_t num_key_columns = tablet_schema.num_key_columns();
+    if (column_indexes.size() <= num_key_columns ||
+        column_indexes[num_key_columns - 1] != static_cast<int32_t>(num_key_columns - 1)) {
+        return Status::InvalidArgument(
+                Substitute("partial update requires all the primary keys and a value column tablet:$0",
+                           _tablet->tablet_id()));
+    }
+    // the columns not loaded of the new keys take the default values.
+    for (size_t cid = 0, k = 0; cid < tablet_schema.num_columns(); cid++) {
+        if (k < column_indexes.size() && column_indexes[k] == static_cast<int32_t>(cid)) {
+            k++;
+            continue;
+        }
+        const TabletColumn& column = tablet_schema.column(cid);
+        if (!column.has_default_value() && !column.is_nullable()) {
+            return Status::InvalidArgument(
+                    Substitute("partial update requires column $0 nullable or with default value", column.name()));
+        }
+    }
+    _partial_update_tablet_schema = tablet_schema.create_partial(column_indexes);
+    return Status::OK();
+}
+
 Status DeltaWriter::write(Chunk* chunk, const uint32_t* indexes, uint32_t from, uint32_t size) {
     if (_is_cancelled) {
         return Status::OK();
@@ -182,7 +236,7 @@ Status DeltaWriter::write(Chunk* chunk, const uint32_t* indexes, uint32_t from,
 }
 
 Status DeltaWriter::_flush_memtable_async() {
-    RETURN_IF_ERROR(_mem_table->finalize());
+    // finalized by the flush thread.
     return _flush_token->submit(_mem_table);
 }
 
@@ -222,6 +276,8 @@ Status DeltaWriter::wait_memtable_flushed() {
 void DeltaWriter::_reset_mem_table() {
     _mem_table = std::make_shared<MemTable>(_tablet->tablet_id(), _tablet_schema, _req.slots, _rowset_writer.get(),
                                             _mem_tracker.get());
+    _mem_table->set_input_sorted(_req.input_sorted);
+    _mem_table_create_ms = MonotonicMillis();
 }
 
 Status DeltaWriter::close() {
@@ -250,7 +306,8 @@ Status DeltaWriter::close_wait(google::protobuf::RepeatedPtrField<PTabletInfo>*
     DCHECK(_mem_table == nullptr) << "Must call close before close_wait";
     // return error if previous flush failed
     if (_flush_token->wait() != OLAPStatus::OLAP_SUCCESS) {
-        return Status::InternalError("Fail to flush memtable");
+        Status st = _flush_token->error();
+        return st.ok() ? Status::InternalError("Fail to flush memtable") : st;
     }
     DCHECK_EQ(_mem_tracker->consumption(), 0);
 
@@ -311,6 +368,18 @@ int64_t DeltaWriter::mem_consumption() const {
     return _mem_tracker->consumption();
 }
 
+int64_t DeltaWriter::memtable_consumption() const {
+    return _mem_table == nullptr ? 0 : _mem_table->memory_usage();
+}
+
+int64_t DeltaWriter::memtable_age_ms() const {
+    return _mem_table == nullptr ? 0 : MonotonicMillis() - _mem_table_create_ms;
+}
+
+const FlushStatistic& DeltaWriter::flush_stats() const {
+    return _flush_token->get_stats();
+}
+
 int64_t DeltaWriter::partition_id() const {
     return _req.partition_id;
 }
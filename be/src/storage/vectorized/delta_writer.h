@@ -10,6 +10,7 @@
 namespace starrocks {
 
 class FlushToken;
+struct FlushStatistic;
 class MemTracker;
 class Schema;
 class StorageEngine;
@@ -33,6 +34,8 @@ struct WriteRequest {
     // slots are in order of tablet's schema
     const std::vector<SlotDescriptor*>* slots;
     vectorized::GlobalDictByNameMaps* global_dicts = nullptr;
+    // whether the rows are written in the order of the keys, whose sort is skipped by the memtables.
+    bool input_sorted = false;
 };
 
 // Writer for a particular (load, index, tablet).
@@ -67,6 +70,16 @@ public:
 
     int64_t mem_consumption() const;
 
+    // the memory of the memtable being written, not including the ones in the flush queue.
+    // called with the same lock as write().
+    int64_t memtable_consumption() const;
+
+    // milliseconds since the memtable being written was created.
+    int64_t memtable_age_ms() const;
+
+    // the time and the number of the memtables flushed, only complete after close_wait().
+    const FlushStatistic& flush_stats() const;
+
 private:
     DeltaWriter(WriteRequest* req, MemTracker* parent, StorageEngine* storage_engine);
 
@@ -77,12 +90,18 @@ private:
 
     void _reset_mem_table();
 
+    // sets |_partial_update_tablet_schema| if the load is a partial update of a primary key tablet.
+    Status _init_partial_update();
+
     bool _is_init = false;
     WriteRequest _req;
     TabletSharedPtr _tablet;
     RowsetSharedPtr _cur_rowset;
+    // the columns loaded by a partial update, used by |_rowset_writer| and |_mem_table|.
+    std::unique_ptr<TabletSchema> _partial_update_tablet_schema;
     std::unique_ptr<RowsetWriter> _rowset_writer;
     std::shared_ptr<MemTable> _mem_table;
+    int64_t _mem_table_create_ms = 0;
     const TabletSchema* _tablet_schema;
     bool _delta_written_success;
 
@@ -3,6 +3,7 @@
 #include "storage/vectorized/memtable.h"
 
 #include <memory>
+#include <queue>
 
 #include "column/type_traits.h"
 #include "common/logging.h"
@@ -89,11 +90,15 @@ bool MemTable::insert(Chunk* chunk, const uint32_t* indexes, uint32_t from, uint
     // The shadow column is not exist in _vectorized_schema
     // So the chunk can only be accessed by the subscript
     // instead of the column name.
+    const size_t old_rows = _chunk->num_rows();
     for (int i = 0; i < _slot_descs->size(); ++i) {
         ColumnPtr& src = chunk->get_column_by_slot_id((*_slot_descs)[i]->id());
         ColumnPtr& dest = _chunk->get_column_by_index(i);
         dest->append_selective(*src, indexes, from, size);
     }
+    if (_input_sorted && size > 0) {
+        _check_input_sorted(old_rows);
+    }
 
     if (chunk->has_rows()) {
         _chunk_memory_usage += chunk->memory_usage() * size / chunk->num_rows();
@@ -138,16 +143,18 @@ Status MemTable::finalize() {
                 _merge();
             }
 
-            if (_merge_count > 1) {
+            // the runs of the sorted input are in order, so are the rows aggregated.
+            if (_merge_count > 1 && !_input_sorted) {
                 _chunk = _aggregator->aggregate_result();
                 _aggregator->aggregate_reset();
 
                 int64_t t1 = MonotonicMicros();
-                _sort(true);
+                _merge_sorted_runs();
                 int64_t t2 = MonotonicMicros();
                 _aggregate(true);
                 int64_t t3 = MonotonicMicros();
-                VLOG(1) << Substitute("memtable final sort:$0 agg:$1 total:$2", t2 - t1, t3 - t2, t3 - t1);
+                VLOG(1) << Substitute("memtable final merge:$0 runs:$1 agg:$2 total:$3", t2 - t1,
+                                      _sorted_run_ends.size(), t3 - t2, t3 - t1);
             } else {
                 // if there is only one data chunk and merge once,
                 // no need to perform an additional merge.
@@ -183,6 +190,7 @@ Status MemTable::finalize() {
     }
 
     StarRocksMetrics::instance()->memtable_flush_duration_us.increment(duration_ns / 1000);
+    StarRocksMetrics::instance()->memtable_flush_latency_us.record(duration_ns / 1000);
     return Status::OK();
 }
 
@@ -202,6 +210,7 @@ OLAPStatus MemTable::flush() {
     }
     StarRocksMetrics::instance()->memtable_flush_total.increment(1);
     StarRocksMetrics::instance()->memtable_flush_duration_us.increment(duration_ns / 1000);
+    StarRocksMetrics::instance()->memtable_flush_latency_us.record(duration_ns / 1000);
     VLOG(1) << "memtable flush: " << duration_ns / 1000 << "us";
     return OLAP_SUCCESS;
 }
@@ -218,6 +227,8 @@ void MemTable::_merge() {
     int64_t t3 = MonotonicMicros();
     VLOG(1) << Substitute("memtable sort:$0 agg:$1 total:$2", t2 - t1, t3 - t2, t3 - t1);
     ++_merge_count;
+    // the first row of the next run is aggregated into the last row of this one if their keys are equal.
+    _sorted_run_ends.push_back(_aggregator->aggregated_rows());
 }
 
 void MemTable::_aggregate(bool is_final) {
@@ -247,7 +258,49 @@ void MemTable::_aggregate(bool is_final) {
     }
 }
 
+void MemTable::_check_input_sorted(size_t from) {
+    const size_t num_key_columns = _tablet_schema->num_key_columns();
+    // compares the row |l| of |lhs| with the row |r| of |_chunk| by their keys.
+    auto compare = [this, num_key_columns](const Chunk& lhs, size_t l, size_t r) {
+        for (size_t i = 0; i < num_key_columns; i++) {
+            int c = lhs.get_column_by_index(i)->compare_at(l, r, *_chunk->get_column_by_index(i), -1);
+            if (c != 0) {
+                return c;
+            }
+        }
+        return 0;
+    };
+    const size_t num_rows = _chunk->num_rows();
+    bool sorted = _last_row == nullptr || compare(*_last_row, 0, from) <= 0;
+    for (size_t i = from + 1; sorted && i < num_rows; i++) {
+        sorted = compare(*_chunk, i - 1, i) <= 0;
+    }
+    if (!sorted) {
+        LOG(INFO) << "The input of tablet " << _tablet_id << " isn't sorted by the keys, sort it in the memtable";
+        _input_sorted = false;
+        _last_row.reset();
+        return;
+    }
+    if (_last_row == nullptr) {
+        _last_row = _chunk->clone_empty_with_schema();
+    }
+    _last_row->reset();
+    _last_row->append(*_chunk, num_rows - 1, 1);
+}
+
 void MemTable::_sort(bool is_final) {
+    if (_input_sorted) {
+        // the rows are in order already, and the equal keys in the order they are loaded, as a stable sort does.
+        _result_chunk = _chunk;
+        if (is_final) {
+            _chunk.reset();
+        } else {
+            _chunk = _chunk->clone_empty_with_schema();
+        }
+        _chunk_memory_usage = 0;
+        _chunk_bytes_usage = 0;
+        return;
+    }
     _permutations.resize(_chunk->num_rows());
     for (uint32_t i = 0; i < _chunk->num_rows(); ++i) {
         _permutations[i] = {i, i};
@@ -268,6 +321,52 @@ void MemTable::_sort(bool is_final) {
     _chunk_bytes_usage = 0;
 }
 
+void MemTable::_merge_sorted_runs() {
+    // the rows aggregated by every merge are sorted with unique keys, merging the runs by a heap takes
+    // O(n log(runs)) instead of sorting all the rows again. The equal keys are taken from the earlier runs
+    // at first, so the later rows replace them in the aggregate as they do after a stable sort.
+    using RunCursor = std::pair<uint32_t, uint32_t>; // (row, run)
+    const size_t num_key_columns = _tablet_schema->num_key_columns();
+    const Chunk* chunk = _chunk.get();
+    auto greater = [chunk, num_key_columns](const RunCursor& l, const RunCursor& r) {
+        for (size_t i = 0; i < num_key_columns; i++) {
+            const auto& col = chunk->get_column_by_index(i);
+            int c = col->compare_at(l.first, r.first, *col, -1);
+            if (c != 0) {
+                return c > 0;
+            }
+        }
+        return l.second > r.second;
+    };
+    std::priority_queue<RunCursor, std::vector<RunCursor>, decltype(greater)> heap(greater);
+    uint32_t run_start = 0;
+    for (uint32_t run = 0; run < _sorted_run_ends.size(); run++) {
+        if (run_start < _sorted_run_ends[run]) {
+            heap.emplace(run_start, run);
+        }
+        run_start = _sorted_run_ends[run];
+    }
+    DCHECK_EQ(run_start, _chunk->num_rows());
+    _permutations.resize(_chunk->num_rows());
+    size_t pos = 0;
+    while (!heap.empty()) {
+        RunCursor cursor = heap.top();
+        heap.pop();
+        _permutations[pos] = {cursor.first, static_cast<uint32_t>(pos)};
+        pos++;
+        if (cursor.first + 1 < _sorted_run_ends[cursor.second]) {
+            heap.emplace(cursor.first + 1, cursor.second);
+        }
+    }
+    DCHECK_EQ(pos, _permutations.size());
+    _result_chunk = _chunk->clone_empty_with_schema();
+    _append_to_sorted_chunk(_chunk.get(), _result_chunk.get());
+    _chunk.reset();
+    _sorted_run_ends.clear();
+    _chunk_memory_usage = 0;
+    _chunk_bytes_usage = 0;
+}
+
 void MemTable::_append_to_sorted_chunk(Chunk* src, Chunk* dest) {
     _selective_values.clear();
     _selective_values.reserve(src->num_rows());
@@ -38,10 +38,19 @@ public:
 
     bool is_full() const;
 
+    // Whether the rows are inserted in the order of the keys, whose sort is skipped then. The order is checked as
+    // the rows are inserted, and the rows are sorted as usual once they are found out of order.
+    void set_input_sorted(bool input_sorted) { _input_sorted = input_sorted; }
+
 private:
+    // clears |_input_sorted| if the rows from |from| of |_chunk| aren't in the order of the keys.
+    void _check_input_sorted(size_t from);
+
     void _merge();
 
     void _sort(bool is_final);
+    // merges the sorted runs of |_chunk| by their keys into |_result_chunk|.
+    void _merge_sorted_runs();
     void _sort_chunk_by_columns();
     void _sort_chunk_by_rows();
     void _append_to_sorted_chunk(Chunk* src, Chunk* dest);
@@ -79,6 +88,12 @@ private:
     std::unique_ptr<ChunkAggregator> _aggregator;
 
     uint64_t _merge_count = 0;
+    // the end of every sorted run of the aggregated rows, one run is added by every merge.
+    std::vector<uint32_t> _sorted_run_ends;
+
+    bool _input_sorted = false;
+    // the keys of the last row inserted, to check the order of the next rows.
+    ChunkPtr _last_row;
 
     bool _has_op_slot = false;
     std::unique_ptr<Column> _deletes;
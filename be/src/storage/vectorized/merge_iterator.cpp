@@ -2,75 +2,116 @@
 
 #include "storage/vectorized/merge_iterator.h"
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
-#include <queue>
 #include <vector>
 
-#include "boost/heap/skew_heap.hpp"
+#include "column/binary_column.h"
 #include "column/chunk.h"
+#include "column/nullable_column.h"
 #include "common/config.h"
 #include "common/status.h"
+#include "gutil/casts.h"
+#include "gutil/endian.h"
 #include "runtime/current_mem_tracker.h"
 #include "storage/iterators.h" // StorageReadOptions
 #include "storage/vectorized/chunk_helper.h"
 
 namespace starrocks::vectorized {
 
-// Compare the row of index |m| in |lhs|, with the row of index |n| in |rhs|.
-inline int compare_chunk(size_t key_columns, const Chunk& lhs, size_t m, const Chunk& rhs, size_t n) {
-    for (size_t i = 0; i < key_columns; i++) {
-        const ColumnPtr& lc = lhs.get_column_by_index(i);
-        const ColumnPtr& rc = rhs.get_column_by_index(i);
-        if (int r = lc->compare_at(m, n, *rc, -1); r != 0) {
-            return r;
-        }
+// The normalized prefix of the first key column, an unsigned integer ordered the same as the values.
+enum class KeyPrefix {
+    kNone,
+    kInt8,
+    kInt16,
+    kInt32,
+    kInt64,
+    kBool,
+    kBinary,
+};
+
+static KeyPrefix key_prefix_of(FieldType type) {
+    switch (type) {
+    case OLAP_FIELD_TYPE_TINYINT:
+        return KeyPrefix::kInt8;
+    case OLAP_FIELD_TYPE_SMALLINT:
+        return KeyPrefix::kInt16;
+    case OLAP_FIELD_TYPE_INT:
+    case OLAP_FIELD_TYPE_DATE_V2:
+    case OLAP_FIELD_TYPE_DECIMAL32:
+        return KeyPrefix::kInt32;
+    case OLAP_FIELD_TYPE_BIGINT:
+    case OLAP_FIELD_TYPE_TIMESTAMP:
+    case OLAP_FIELD_TYPE_DECIMAL64:
+        return KeyPrefix::kInt64;
+    case OLAP_FIELD_TYPE_BOOL:
+        return KeyPrefix::kBool;
+    case OLAP_FIELD_TYPE_CHAR:
+    case OLAP_FIELD_TYPE_VARCHAR:
+        return KeyPrefix::kBinary;
+    default:
+        return KeyPrefix::kNone;
     }
-    return 0;
 }
 
-// Compare two chunks by the one specific row of each other.
-class ComparableChunk {
-public:
-    explicit ComparableChunk(Chunk* chunk, size_t order, size_t key_columns)
-            : _chunk(chunk), _order(order), _key_columns(key_columns) {}
-
-    bool operator>(const ComparableChunk& rhs) const {
-        DCHECK_EQ(_key_columns, rhs._key_columns);
-        int r = compare_chunk(_key_columns, *_chunk, _compared_row, *rhs._chunk, rhs._compared_row);
-        return (r > 0) | ((r == 0) & (_order > rhs._order));
+static size_t key_prefix_type_size(KeyPrefix prefix) {
+    switch (prefix) {
+    case KeyPrefix::kInt8:
+    case KeyPrefix::kBool:
+        return 1;
+    case KeyPrefix::kInt16:
+        return 2;
+    case KeyPrefix::kInt32:
+        return 4;
+    case KeyPrefix::kInt64:
+        return 8;
+    default:
+        return 0;
     }
+}
 
-    // return true iff all rows in |this| chunk are less than those in |rhs|, i.e, if
-    // last row in |this| chunk is less than the first row in |rhs|.
-    // assume both |this| and |rhs| are not empty.
-    bool less_than_all(const ComparableChunk& rhs) {
-        size_t last_row = _chunk->num_rows() - 1;
-        int r = compare_chunk(_key_columns, *_chunk, last_row, *rhs._chunk, rhs._compared_row);
-        return (r < 0) | ((r == 0) & (_order < rhs._order));
+// The integers in the order of the values, and the booleans stored as 0 or 1.
+template <typename T>
+static void signed_prefixes(const Column& column, std::vector<uint64_t>* prefixes) {
+    const auto* data = reinterpret_cast<const T*>(column.raw_data());
+    const size_t n = column.size();
+    prefixes->resize(n);
+    for (size_t i = 0; i < n; i++) {
+        (*prefixes)[i] = static_cast<uint64_t>(static_cast<int64_t>(data[i])) ^ (1ULL << 63);
     }
+}
 
-    size_t compared_row() const { return _compared_row; }
-
-    void advance(size_t row) { _compared_row += row; }
-
-    size_t remaining_rows() const { return _chunk->num_rows() - _compared_row; }
-
-private:
-    friend class HeapMergeIterator;
-
-    Chunk* _chunk;
-    // used to determinate the order of two rows when their key columns are all equals.
-    uint16_t _order;
-    uint16_t _key_columns;
-    uint16_t _compared_row = 0;
-};
+// The first 8 bytes of the strings in big-endian, padded with zeros.
+static void binary_prefixes(const BinaryColumn& column, std::vector<uint64_t>* prefixes) {
+    const size_t n = column.size();
+    prefixes->resize(n);
+    for (size_t i = 0; i < n; i++) {
+        Slice s = column.get_slice(i);
+        uint64_t v = 0;
+        memcpy(&v, s.data, std::min<size_t>(s.size, sizeof(v)));
+        (*prefixes)[i] = BigEndian::FromHost64(v);
+    }
+}
 
-class HeapMergeIterator final : public ChunkIterator {
+// Merge the sorted children by a loser tree: every internal node keeps the child that lost the match there,
+// and the winner, i.e. the child with the smallest row, is at the top. Taking a row from the winner replays
+// only the matches on the path from its leaf, log(k) comparisons instead of the pop and push of a heap.
+//
+// Two more things keep the comparisons down:
+//  - the rows of the winner less than the current row of the runner-up, which is the best of the losers on
+//    the path of the winner, are taken at once, found by a binary search in the chunk of the winner. So
+//    the runs of the rows from one child, common when the children hardly overlap, cost no tree operation
+//    per row, and are appended to the output chunk in one copy.
+//  - the rows are first compared by a normalized prefix of the first key column, an unsigned integer
+//    computed once per chunk, before calling `Column::compare_at` of every key column.
+class LoserTreeMergeIterator final : public ChunkIterator {
 public:
-    explicit HeapMergeIterator(std::vector<ChunkIteratorPtr> children)
+    explicit LoserTreeMergeIterator(std::vector<ChunkIteratorPtr> children)
             : ChunkIterator(children[0]->schema(), children[0]->chunk_size()),
               _children(std::move(children)),
-              _chunk_pool(_children.size()) {
+              _chunk_pool(_children.size()),
+              _cursors(_children.size()) {
 #ifndef NDEBUG
         // ensure that the children's schemas are all the same.
         for (size_t i = 1; i < _children.size(); i++) {
@@ -89,7 +130,7 @@ public:
 #endif
     }
 
-    ~HeapMergeIterator() override { close(); }
+    ~LoserTreeMergeIterator() override { close(); }
 
     void close() override;
 
@@ -107,34 +148,164 @@ protected:
     Status do_get_next(Chunk* chunk) override;
 
 private:
-    template <typename T, typename Container = std::vector<T>>
-    using MinPriorityQueue = std::priority_queue<T, Container, std::greater<T>>;
-    using ChunkHeap = MinPriorityQueue<ComparableChunk>;
+    // The current chunk of a child and the next row of it to merge.
+    struct Cursor {
+        // null once the child is exhausted.
+        Chunk* chunk = nullptr;
+        size_t row = 0;
+        // the prefixes of the first key column of the rows of |chunk|, empty if not computed.
+        std::vector<uint64_t> prefixes;
+
+        size_t remaining_rows() const { return chunk->num_rows() - row; }
+    };
 
     Status _init();
-    Status _fill_heap(size_t child);
+    Status _fill_cursor(size_t child);
+    void _compute_prefixes(Cursor* cursor) const;
     void _close_child(size_t child);
 
+    // Compare the row |m| of |lhs| with the row |n| of |rhs| by the key columns.
+    int _compare(const Cursor& lhs, size_t m, const Cursor& rhs, size_t n) const;
+
+    // Whether the current row of the child |a| comes before the one of the child |b|. The exhausted children
+    // come last, and the equal rows come in the order of the children.
+    bool _less(size_t a, size_t b) const;
+
+    // Whether the row |m| of the child |a| comes before the current row of the child |b|.
+    bool _less_at(size_t a, size_t m, size_t b) const;
+
+    // Replay the matches from the leaf of |child| up to the root, after its current row changed.
+    void _replay(size_t child);
+
+    // The number of the rows of the winner, from its current row, coming before all the other children.
+    size_t _winner_run_length(size_t winner) const;
+
     std::vector<ChunkIteratorPtr> _children;
     std::vector<ChunkPtr> _chunk_pool;
-    ChunkHeap _heap;
+    std::vector<Cursor> _cursors;
+    // |_tree[0]| is the winner, |_tree[1..k)| are the losers of the internal nodes, the leaf of the child i is
+    // the node k + i, and the parent of the node n is n / 2.
+    std::vector<size_t> _tree;
+    KeyPrefix _key_prefix = KeyPrefix::kNone;
+    size_t _prefix_type_size = 0;
+    // whether the equal prefixes mean the equal first key columns.
+    bool _exact_prefix = false;
     size_t _merged_rows = 0;
     bool _inited = false;
 };
 
-inline Status HeapMergeIterator::_init() {
+inline Status LoserTreeMergeIterator::_init() {
     DCHECK(_chunk_size > 0);
     DCHECK_EQ(_children.size(), _chunk_pool.size());
+    if (_schema.num_key_fields() > 0) {
+        _key_prefix = key_prefix_of(_schema.field(0)->type()->type());
+        _exact_prefix = _key_prefix != KeyPrefix::kNone && _key_prefix != KeyPrefix::kBinary;
+        _prefix_type_size = key_prefix_type_size(_key_prefix);
+    }
     for (size_t i = 0; i < _children.size(); i++) {
         _chunk_pool[i] = ChunkHelper::new_chunk(_schema, _chunk_size);
         CurrentMemTracker::consume(_chunk_pool[i]->memory_usage());
-        RETURN_IF_ERROR(_fill_heap(i));
+        RETURN_IF_ERROR(_fill_cursor(i));
     }
+
+    // build the tree bottom-up by the winners of the subtrees.
+    const size_t k = _children.size();
+    _tree.assign(k, 0);
+    std::vector<size_t> winners(2 * k);
+    for (size_t i = 0; i < k; i++) {
+        winners[k + i] = i;
+    }
+    for (size_t n = k - 1; n >= 1; n--) {
+        size_t a = winners[2 * n];
+        size_t b = winners[2 * n + 1];
+        if (_less(b, a)) {
+            std::swap(a, b);
+        }
+        winners[n] = a;
+        _tree[n] = b;
+    }
+    _tree[0] = winners[1];
     _inited = true;
     return Status::OK();
 }
 
-inline Status HeapMergeIterator::do_get_next(Chunk* chunk) {
+inline int LoserTreeMergeIterator::_compare(const Cursor& lhs, size_t m, const Cursor& rhs, size_t n) const {
+    size_t first = 0;
+    if (!lhs.prefixes.empty() && !rhs.prefixes.empty()) {
+        const uint64_t x = lhs.prefixes[m];
+        const uint64_t y = rhs.prefixes[n];
+        if (x != y) {
+            return x < y ? -1 : 1;
+        }
+        first = _exact_prefix ? 1 : 0;
+    }
+    const size_t key_columns = _schema.num_key_fields();
+    for (size_t i = first; i < key_columns; i++) {
+        const ColumnPtr& lc = lhs.chunk->get_column_by_index(i);
+        const ColumnPtr& rc = rhs.chunk->get_column_by_index(i);
+        if (int r = lc->compare_at(m, n, *rc, -1); r != 0) {
+            return r;
+        }
+    }
+    return 0;
+}
+
+inline bool LoserTreeMergeIterator::_less_at(size_t a, size_t m, size_t b) const {
+    const Cursor& rhs = _cursors[b];
+    if (rhs.chunk == nullptr) {
+        return true;
+    }
+    int r = _compare(_cursors[a], m, rhs, rhs.row);
+    return (r < 0) | ((r == 0) & (a < b));
+}
+
+inline bool LoserTreeMergeIterator::_less(size_t a, size_t b) const {
+    if (_cursors[a].chunk == nullptr) {
+        return false;
+    }
+    return _less_at(a, _cursors[a].row, b);
+}
+
+inline void LoserTreeMergeIterator::_replay(size_t child) {
+    const size_t k = _children.size();
+    size_t winner = child;
+    for (size_t n = (k + child) / 2; n >= 1; n /= 2) {
+        if (_less(_tree[n], winner)) {
+            std::swap(_tree[n], winner);
+        }
+    }
+    _tree[0] = winner;
+}
+
+inline size_t LoserTreeMergeIterator::_winner_run_length(size_t winner) const {
+    const Cursor& cursor = _cursors[winner];
+    const size_t k = _children.size();
+    // the runner-up is the best of the children that lost to the winner.
+    size_t runner_up = winner;
+    for (size_t n = (k + winner) / 2; n >= 1; n /= 2) {
+        if (runner_up == winner || _less(_tree[n], runner_up)) {
+            runner_up = _tree[n];
+        }
+    }
+    const size_t last = cursor.chunk->num_rows() - 1;
+    if (runner_up == winner || _less_at(winner, last, runner_up)) {
+        return cursor.remaining_rows();
+    }
+    // the current row comes first as the winner, find the first row not before the runner-up.
+    size_t lo = cursor.row + 1;
+    size_t hi = last;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (_less_at(winner, mid, runner_up)) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo - cursor.row;
+}
+
+inline Status LoserTreeMergeIterator::do_get_next(Chunk* chunk) {
     if (!_inited) {
         RETURN_IF_ERROR(_init());
     }
@@ -142,34 +313,38 @@ inline Status HeapMergeIterator::do_get_next(Chunk* chunk) {
     size_t prev_mem_usage = chunk->memory_usage();
     Status st;
 
-    while (!_heap.empty() && rows < _chunk_size) {
-        ComparableChunk min_chunk = _heap.top();
-        _heap.pop();
-        DCHECK_GT(min_chunk.remaining_rows(), 0);
+    while (rows < _chunk_size) {
+        const size_t winner = _tree[0];
+        Cursor& cursor = _cursors[winner];
+        if (cursor.chunk == nullptr) {
+            // all the children are exhausted.
+            break;
+        }
+        DCHECK_GT(cursor.remaining_rows(), 0);
 
-        size_t offset = min_chunk.compared_row();
-        // check whether |min_chunk| has overlapping with others.
-        if (offset == 0 && (_heap.empty() || min_chunk.less_than_all(_heap.top()))) {
+        const size_t run = _winner_run_length(winner);
+        if (cursor.row == 0 && run == cursor.chunk->num_rows()) {
+            // the whole chunk comes before the others.
             if (rows == 0) {
-                chunk->swap_chunk(*min_chunk._chunk);
-                return _fill_heap(min_chunk._order);
-            } else {
-                // retrieve |min_chunk| next time to avoid memory copy.
-                _heap.push(min_chunk);
-                break;
+                chunk->swap_chunk(*cursor.chunk);
+                st = _fill_cursor(winner);
+                _replay(winner);
+                return st;
             }
+            // retrieve the chunk next time to avoid memory copy.
+            break;
         }
 
-        chunk->append(*min_chunk._chunk, offset, 1);
-        min_chunk.advance(1);
-        rows += 1;
-        if (min_chunk.remaining_rows() > 0) {
-            _heap.push(min_chunk);
-        } else {
-            st = _fill_heap(min_chunk._order);
-            if (!st.ok()) {
-                break;
-            }
+        const size_t n = std::min(run, _chunk_size - rows);
+        chunk->append(*cursor.chunk, cursor.row, n);
+        cursor.row += n;
+        rows += n;
+        if (cursor.remaining_rows() == 0) {
+            st = _fill_cursor(winner);
+        }
+        _replay(winner);
+        if (!st.ok()) {
+            break;
         }
     }
     CurrentMemTracker::consume(static_cast<int64_t>(chunk->memory_usage()) - static_cast<int64_t>(prev_mem_usage));
@@ -182,8 +357,60 @@ inline Status HeapMergeIterator::do_get_next(Chunk* chunk) {
     }
 }
 
-inline Status HeapMergeIterator::_fill_heap(size_t child) {
+inline void LoserTreeMergeIterator::_compute_prefixes(Cursor* cursor) const {
+    cursor->prefixes.clear();
+    if (_key_prefix == KeyPrefix::kNone) {
+        return;
+    }
+    const Column* column = cursor->chunk->get_column_by_index(0).get();
+    if (column->is_nullable()) {
+        const auto* nullable = down_cast<const NullableColumn*>(column);
+        // the NULLs are compared by `compare_at`.
+        if (nullable->has_null()) {
+            return;
+        }
+        column = nullable->data_column().get();
+    }
+    if (_key_prefix == KeyPrefix::kBinary) {
+        if (column->is_binary()) {
+            binary_prefixes(*down_cast<const BinaryColumn*>(column), &cursor->prefixes);
+        }
+        return;
+    }
+    // e.g. the dict codes of the strings are not compared by prefixes.
+    if (column->is_binary() || column->is_constant() || column->type_size() != _prefix_type_size) {
+        return;
+    }
+    switch (_key_prefix) {
+    case KeyPrefix::kInt8:
+        signed_prefixes<int8_t>(*column, &cursor->prefixes);
+        break;
+    case KeyPrefix::kInt16:
+        signed_prefixes<int16_t>(*column, &cursor->prefixes);
+        break;
+    case KeyPrefix::kInt32:
+        signed_prefixes<int32_t>(*column, &cursor->prefixes);
+        break;
+    case KeyPrefix::kInt64:
+        signed_prefixes<int64_t>(*column, &cursor->prefixes);
+        break;
+    case KeyPrefix::kBool:
+        signed_prefixes<uint8_t>(*column, &cursor->prefixes);
+        break;
+    default:
+        break;
+    }
+}
+
+inline Status LoserTreeMergeIterator::_fill_cursor(size_t child) {
+    Cursor& cursor = _cursors[child];
+    cursor.chunk = nullptr;
+    cursor.row = 0;
+    cursor.prefixes.clear();
     Chunk* chunk = _chunk_pool[child].get();
+    if (chunk == nullptr) {
+        return Status::OK();
+    }
 
     CurrentMemTracker::release(chunk->memory_usage());
     chunk->reset();
@@ -192,7 +419,8 @@ inline Status HeapMergeIterator::_fill_heap(size_t child) {
     Status st = _children[child]->get_next(chunk);
     if (st.ok()) {
         DCHECK_GT(chunk->num_rows(), 0u);
-        _heap.push(ComparableChunk{chunk, child, _schema.num_key_fields()});
+        cursor.chunk = chunk;
+        _compute_prefixes(&cursor);
     } else if (st.is_end_of_file()) {
         // ignore Status::EndOfFile.
         _close_child(child);
@@ -203,7 +431,7 @@ inline Status HeapMergeIterator::_fill_heap(size_t child) {
     return Status::OK();
 }
 
-inline void HeapMergeIterator::_close_child(size_t child) {
+inline void LoserTreeMergeIterator::_close_child(size_t child) {
     if (_chunk_pool[child] == nullptr) {
         return;
     }
@@ -214,13 +442,14 @@ inline void HeapMergeIterator::_close_child(size_t child) {
     _children[child].reset();
 }
 
-inline void HeapMergeIterator::close() {
+inline void LoserTreeMergeIterator::close() {
     DCHECK_EQ(_children.size(), _chunk_pool.size());
     for (size_t i = 0; i < _children.size(); i++) {
         _close_child(i);
     }
     _children.clear();
     _chunk_pool.clear();
+    _cursors.clear();
 }
 
 ChunkIteratorPtr new_merge_iterator(const std::vector<ChunkIteratorPtr>& children) {
@@ -228,22 +457,7 @@ ChunkIteratorPtr new_merge_iterator(const std::vector<ChunkIteratorPtr>& childre
     if (children.size() == 1) {
         return children[0];
     }
-
-    // The `ComparableChunk` is using `uint16_t` to save the chunk order, if the size of
-    // children is greater than UINT16_MAX, the value of order will overflow.
-    const static size_t kMaxChildrenSize = std::numeric_limits<uint16_t>::max();
-
-    if (children.size() <= kMaxChildrenSize) {
-        return std::make_shared<HeapMergeIterator>(children);
-    }
-    std::vector<ChunkIteratorPtr> sub_merge_iterators;
-    sub_merge_iterators.reserve((children.size() + kMaxChildrenSize - 1) / kMaxChildrenSize);
-    for (size_t i = 0; i < children.size(); i += kMaxChildrenSize) {
-        size_t j = std::min(i + kMaxChildrenSize, children.size());
-        std::vector<ChunkIteratorPtr> v(children.begin() + i, children.begin() + j);
-        sub_merge_iterators.emplace_back(new_merge_iterator(v));
-    }
-    return new_merge_iterator(sub_merge_iterators);
+    return std::make_shared<LoserTreeMergeIterator>(children);
 }
 
 } // namespace starrocks::vectorized
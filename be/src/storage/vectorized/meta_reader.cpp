@@ -7,12 +7,34 @@
 #include "column/datum_convert.h"
 #include "storage/rowset/beta_rowset.h"
 #include "storage/rowset/segment_v2/column_reader.h"
+#include "storage/rowset/segment_v2/zone_map_index.h"
+#include "storage/del_vector.h"
+#include "storage/storage_engine.h"
 #include "storage/tablet.h"
+#include "storage/update_manager.h"
 #include "storage/vectorized/chunk_helper.h"
 
 namespace starrocks::vectorized {
 
-std::vector<std::string> SegmentMetaCollecter::support_collect_fields = {"dict_merge", "max", "min"};
+std::vector<std::string> SegmentMetaCollecter::support_collect_fields = {"dict_merge", "max", "min", "sum", "count"};
+
+// The meta of a segment is about the rows in it, which are merged with the rows of the other segments when read
+// from the tables of the other models than the duplicate key model, so the aggregate of the meta is exact only if
+// the rows are aggregated in the same way when merged. The rows of a primary key table are never merged, but some
+// of them may be deleted by the delete vectors, which is checked per segment by SegmentMetaCollecter.
+static bool is_meta_exact(KeysType keys_type, const TabletColumn& column, const std::string& field) {
+    if (field == "dict_merge" || keys_type == KeysType::DUP_KEYS || keys_type == KeysType::PRIMARY_KEYS) {
+        return true;
+    }
+    if (field == "max" || field == "min") {
+        return column.is_key();
+    }
+    if (field == "sum") {
+        return keys_type == KeysType::AGG_KEYS && !column.is_key() &&
+               column.aggregation() == OLAP_FIELD_AGGREGATION_SUM;
+    }
+    return false;
+}
 
 Status SegmentMetaCollecter::parse_field_and_colname(const std::string& item, std::string* field,
                                                      std::string* col_name) {
@@ -76,8 +98,16 @@ Status MetaReader::_build_collect_context(const MetaReaderParams& read_params) {
             return Status::InternalError(ss.str());
         }
 
+        const TabletColumn& column = _tablet->tablet_schema().column(index);
+        if (!is_meta_exact(_tablet->keys_type(), column, collect_field)) {
+            return Status::NotSupported("Not Support Collect Meta: " + it.second);
+        }
+        if (collect_field == "sum" || collect_field == "count") {
+            _collect_context.need_no_deletes = true;
+        }
+
         // get column type
-        FieldType type = _tablet->tablet_schema().column(index).type();
+        FieldType type = column.type();
         _collect_context.seg_collecter_params.field_type.emplace_back(type);
 
         // get collect field
@@ -105,8 +135,8 @@ Status MetaReader::_init_seg_meta_collecters(const MetaReaderParams& params) {
     std::vector<segment_v2::SegmentSharedPtr> segments;
     RETURN_IF_ERROR(_get_segments(params.tablet, params.version, &segments));
 
-    for (auto& segment : segments) {
-        SegmentMetaCollecter* seg_collecter = new SegmentMetaCollecter(segment);
+    for (size_t i = 0; i < segments.size(); i++) {
+        SegmentMetaCollecter* seg_collecter = new SegmentMetaCollecter(segments[i], _num_deleted_rows[i]);
         _obj_pool.add(seg_collecter);
 
         RETURN_IF_ERROR(seg_collecter->init(&_collect_context.seg_collecter_params));
@@ -118,11 +148,6 @@ Status MetaReader::_init_seg_meta_collecters(const MetaReaderParams& params) {
 
 Status MetaReader::_get_segments(const TabletSharedPtr& tablet, const Version& version,
                                  std::vector<segment_v2::SegmentSharedPtr>* segments) {
-    if (tablet->updates() != nullptr) {
-        LOG(INFO) << "Skipped Update tablet";
-        return Status::OK();
-    }
-
     std::vector<RowsetSharedPtr> rowsets;
     tablet->obtain_header_rdlock();
     Status acquire_rowset_st = tablet->capture_consistent_rowsets(_version, &rowsets);
@@ -136,10 +161,29 @@ Status MetaReader::_get_segments(const TabletSharedPtr& tablet, const Version& v
     }
 
     for (auto& rs : rowsets) {
+        // the deleted rows are still counted in the meta.
+        if (_collect_context.need_no_deletes && rs->rowset_meta()->has_delete_predicate()) {
+            return Status::NotSupported("Not Support Collect Meta of the tablet with delete predicates");
+        }
         RETURN_IF_ERROR(rs->load());
         auto beta_rowset = down_cast<BetaRowset*>(rs.get());
         for (auto seg : beta_rowset->segments()) {
+            size_t num_deleted_rows = 0;
+            if (tablet->updates() != nullptr) {
+                TabletSegmentId tsid;
+                tsid.tablet_id = tablet->tablet_id();
+                tsid.segment_id = rs->rowset_meta()->get_rowset_seg_id() + seg->id();
+                DelVectorPtr del_vec;
+                RETURN_IF_ERROR(StorageEngine::instance()->update_manager()->get_del_vec(
+                        tablet->data_dir()->get_meta(), tsid, version.second, &del_vec));
+                num_deleted_rows = del_vec->empty() ? 0 : del_vec->cardinality();
+            }
+            // the segments whose rows are all deleted don't count.
+            if (num_deleted_rows == seg->num_rows()) {
+                continue;
+            }
             segments->emplace_back(seg);
+            _num_deleted_rows.emplace_back(num_deleted_rows);
         }
     }
 
@@ -212,7 +256,8 @@ bool MetaReader::has_more() {
     return _has_more;
 }
 
-SegmentMetaCollecter::SegmentMetaCollecter(segment_v2::SegmentSharedPtr segment) : _segment(segment) {}
+SegmentMetaCollecter::SegmentMetaCollecter(segment_v2::SegmentSharedPtr segment, size_t num_deleted_rows)
+        : _segment(std::move(segment)), _num_deleted_rows(num_deleted_rows) {}
 
 SegmentMetaCollecter::~SegmentMetaCollecter() {}
 
@@ -227,8 +272,7 @@ Status SegmentMetaCollecter::_init_return_column_iterators() {
     DCHECK_EQ(_params->fields.size(), _params->cids.size());
     DCHECK_EQ(_params->fields.size(), _params->read_page.size());
 
-    fs::BlockManager* block_mgr = fs::fs_util::block_manager();
-    RETURN_IF_ERROR(block_mgr->open_block(_segment->file_name(), &_rblock));
+    RETURN_IF_ERROR(_segment->block_manager()->open_block(_segment->file_name(), &_rblock));
 
     _column_iterators.resize(_params->max_cid + 1, nullptr);
     for (int i = 0; i < _params->fields.size(); i++) {
@@ -266,6 +310,10 @@ Status SegmentMetaCollecter::_collect(const std::string& name, ColumnId cid, vec
         return _collect_max(cid, column, type);
     } else if (name == "min") {
         return _collect_min(cid, column, type);
+    } else if (name == "sum") {
+        return _collect_sum(cid, column, type);
+    } else if (name == "count") {
+        return _collect_count(cid, column, type);
     }
     return Status::NotSupported("Not Support Collect Meta: " + name);
 }
@@ -319,6 +367,10 @@ Status SegmentMetaCollecter::__collect_max_or_min(ColumnId cid, vectorized::Colu
     if (col_reader->column_type() != type) {
         return Status::InternalError("column type mismatch");
     }
+    if (_num_deleted_rows > 0) {
+        // the deleted rows are still in the zone map.
+        return Status::NotSupported("Not Support Collect Meta of the segment with deleted rows");
+    }
     const ZoneMapPB* segment_zone_map_pb = col_reader->segment_zone_map();
     TypeInfoPtr type_info = get_type_info(delegate_type(type));
     if constexpr (!is_max) {
@@ -337,4 +389,67 @@ Status SegmentMetaCollecter::__collect_max_or_min(ColumnId cid, vectorized::Colu
     return Status::OK();
 }
 
+// the sum of the segment zone map is in the type of the sum aggregation, i.e. BIGINT for the integers
+// except LARGEINT and DOUBLE for the floating point numbers.
+Status SegmentMetaCollecter::_collect_sum(ColumnId cid, vectorized::Column* column, FieldType type) {
+    if (cid >= _segment->num_columns()) {
+        return Status::NotFound("");
+    }
+    const ColumnReader* col_reader = _segment->column(cid);
+    if (col_reader == nullptr || col_reader->segment_zone_map() == nullptr) {
+        return Status::NotFound("");
+    }
+    if (col_reader->column_type() != type) {
+        return Status::InternalError("column type mismatch");
+    }
+    if (_num_deleted_rows > 0) {
+        return Status::NotSupported("Not Support Collect Meta of the segment with deleted rows");
+    }
+    const ZoneMapPB* segment_zone_map_pb = col_reader->segment_zone_map();
+    if (!segment_zone_map_pb->has_not_null()) {
+        return Status::OK();
+    }
+    if (type == OLAP_FIELD_TYPE_FLOAT || type == OLAP_FIELD_TYPE_DOUBLE) {
+        double sum = 0;
+        if (!segment_zone_map_pb->has_sum() || !zone_map_double_sum(*segment_zone_map_pb, &sum)) {
+            return Status::NotSupported("No pre-aggregated sum in the zone map");
+        }
+        column->append_datum(vectorized::Datum(sum));
+        return Status::OK();
+    }
+    int128_t sum = 0;
+    if (!segment_zone_map_pb->has_sum() || !zone_map_int_sum(*segment_zone_map_pb, &sum)) {
+        return Status::NotSupported("No pre-aggregated sum in the zone map");
+    }
+    if (type == OLAP_FIELD_TYPE_LARGEINT) {
+        column->append_datum(vectorized::Datum(sum));
+    } else {
+        column->append_datum(vectorized::Datum(static_cast<int64_t>(sum)));
+    }
+    return Status::OK();
+}
+
+// count of the not-null values, the number of the rows minus the number of the nulls in the segment zone map and
+// the number of the deleted rows, which are known to be not null only if the segment has no null.
+Status SegmentMetaCollecter::_collect_count(ColumnId cid, vectorized::Column* column, FieldType type) {
+    if (cid >= _segment->num_columns()) {
+        return Status::NotFound("");
+    }
+    const ColumnReader* col_reader = _segment->column(cid);
+    if (col_reader == nullptr || col_reader->segment_zone_map() == nullptr) {
+        return Status::NotFound("");
+    }
+    const ZoneMapPB* segment_zone_map_pb = col_reader->segment_zone_map();
+    if (segment_zone_map_pb->has_null() && !segment_zone_map_pb->has_null_count()) {
+        return Status::NotSupported("No null count in the zone map");
+    }
+    if (segment_zone_map_pb->has_null() && _num_deleted_rows > 0) {
+        return Status::NotSupported("Not Support Collect Meta of the segment with deleted rows and nulls");
+    }
+    int64_t null_count = segment_zone_map_pb->has_null() ? segment_zone_map_pb->null_count() : 0;
+    int64_t count = static_cast<int64_t>(_segment->num_rows()) - null_count - static_cast<int64_t>(_num_deleted_rows);
+    column->append_datum(vectorized::Datum(count));
+    return Status::OK();
+}
+
 } // namespace starrocks::vectorized
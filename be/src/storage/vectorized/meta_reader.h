@@ -71,6 +71,8 @@ public:
         size_t cursor_idx = 0;
 
         std::vector<int32_t> result_slot_ids;
+        // the sums and counts are not exact if any rows are deleted by the delete predicates.
+        bool need_no_deletes = false;
     };
 
 private:
@@ -84,6 +86,8 @@ private:
     MetaReaderParams _params;
 
     CollectContext _collect_context;
+    // the number of the rows deleted by the delete vector of each segment, of the primary key tablets.
+    std::vector<size_t> _num_deleted_rows;
 
     Status _init_params(const MetaReaderParams& read_params);
 
@@ -101,7 +105,7 @@ private:
 
 class SegmentMetaCollecter {
 public:
-    SegmentMetaCollecter(segment_v2::SegmentSharedPtr segment);
+    SegmentMetaCollecter(segment_v2::SegmentSharedPtr segment, size_t num_deleted_rows = 0);
     ~SegmentMetaCollecter();
     Status init(const SegmentMetaCollecterParams* params);
     Status collect(std::vector<vectorized::Column*>* dsts);
@@ -119,9 +123,12 @@ private:
     Status _collect_dict(ColumnId cid, vectorized::Column* column, FieldType type);
     Status _collect_max(ColumnId cid, vectorized::Column* column, FieldType type);
     Status _collect_min(ColumnId cid, vectorized::Column* column, FieldType type);
+    Status _collect_sum(ColumnId cid, vectorized::Column* column, FieldType type);
+    Status _collect_count(ColumnId cid, vectorized::Column* column, FieldType type);
     template <bool is_max>
     Status __collect_max_or_min(ColumnId cid, vectorized::Column* column, FieldType type);
     segment_v2::SegmentSharedPtr _segment;
+    size_t _num_deleted_rows;
     std::vector<ColumnIterator*> _column_iterators;
     const SegmentMetaCollecterParams* _params = nullptr;
     std::unique_ptr<fs::ReadableBlock> _rblock;
@@ -5,7 +5,9 @@
 #include "column/column_builder.h"
 #include "column/column_helper.h"
 #include "column/column_viewer.h"
+#include "env/env_broker.h"
 #include "exec/vectorized/parquet_scanner.h"
+#include "gutil/strings/substitute.h"
 #include "runtime/exec_env.h"
 #include "storage/rowset/rowset_factory.h"
 #include "storage/rowset/rowset_id_generator.h"
@@ -14,6 +16,7 @@
 #include "storage/storage_engine.h"
 #include "storage/vectorized/chunk_helper.h"
 #include "util/defer_op.h"
+#include "util/raw_container.h"
 
 namespace starrocks::vectorized {
 
@@ -452,7 +455,14 @@ Status PushHandler::_convert(const TabletSharedPtr& cur_tablet, const TabletShar
     LOG(INFO) << "tablet=" << cur_tablet->full_name() << ", file path=" << path
               << ", file size=" << _request.broker_scan_range.ranges[0].file_size;
 
-    if (!path.empty()) {
+    if (!path.empty() && _request.broker_scan_range.ranges[0].format_type == TFileFormatType::FORMAT_SEGMENT_V2) {
+        st = _ingest_segment_files(cur_tablet, rowset_writer.get());
+        if (!st.ok()) {
+            LOG(WARNING) << "fail to ingest segment files. res=" << st.to_string()
+                         << ", tablet=" << cur_tablet->full_name();
+            return st;
+        }
+    } else if (!path.empty()) {
         std::unique_ptr<PushBrokerReader> reader = std::make_unique<PushBrokerReader>();
         if (reader == nullptr) {
             LOG(WARNING) << "fail to create reader. tablet=" << cur_tablet->full_name();
@@ -514,4 +524,51 @@ Status PushHandler::_convert(const TabletSharedPtr& cur_tablet, const TabletShar
              << ", processed_rows" << num_rows;
     return st;
 }
+
+Status PushHandler::_ingest_segment_files(const TabletSharedPtr& tablet, RowsetWriter* rowset_writer) {
+    // the segment files are built for the schema of the tablet as of the load.
+    if (_request.schema_hash != tablet->schema_hash()) {
+        return Status::InvalidArgument(strings::Substitute("Schema hash $0 of the segment files mismatch tablet $1",
+                                                           _request.schema_hash, tablet->full_name()));
+    }
+    const auto& scan_range = _request.broker_scan_range;
+    for (size_t i = 0; i < scan_range.ranges.size(); ++i) {
+        const auto& range = scan_range.ranges[i];
+        if (range.file_type == TFileType::FILE_LOCAL) {
+            RETURN_IF_ERROR(rowset_writer->add_segment_file(range.path));
+            continue;
+        }
+        if (range.file_type != TFileType::FILE_BROKER || scan_range.broker_addresses.empty()) {
+            return Status::NotSupported(strings::Substitute("Unsupported file type of segment file $0", range.path));
+        }
+
+        // Copy the segment file to the tablet path, to be linked into the rowset.
+        EnvBroker env_broker(scan_range.broker_addresses[0], scan_range.params.properties);
+        std::unique_ptr<SequentialFile> src;
+        RETURN_IF_ERROR(env_broker.new_sequential_file(range.path, &src));
+        std::string local_path = strings::Substitute("$0/$1_$2.ingest", tablet->tablet_path(),
+                                                     rowset_writer->rowset_id().to_string(), i);
+        std::unique_ptr<WritableFile> dst;
+        RETURN_IF_ERROR(Env::Default()->new_writable_file(local_path, &dst));
+        DeferOp remove_local([&local_path] {
+            WARN_IF_ERROR(Env::Default()->delete_file(local_path), "Fail to delete " + local_path);
+        });
+        std::string buf;
+        raw::stl_string_resize_uninitialized(&buf, 8 * 1024 * 1024);
+        while (true) {
+            Slice slice(buf);
+            RETURN_IF_ERROR(src->read(&slice));
+            if (slice.size == 0) {
+                break;
+            }
+            RETURN_IF_ERROR(dst->append(slice));
+        }
+        RETURN_IF_ERROR(dst->sync());
+        RETURN_IF_ERROR(dst->close());
+        RETURN_IF_ERROR(rowset_writer->add_segment_file(local_path));
+    }
+    LOG(INFO) << "ingested " << scan_range.ranges.size() << " segment files into tablet " << tablet->full_name()
+              << ", rows=" << rowset_writer->num_rows();
+    return Status::OK();
+}
 } // namespace starrocks::vectorized
@@ -10,6 +10,7 @@
 #include "runtime/descriptors.h"
 #include "storage/olap_common.h"
 #include "storage/rowset/rowset.h"
+#include "storage/rowset/rowset_writer.h"
 #include "storage/tablet.h"
 
 namespace starrocks::vectorized {
@@ -63,6 +64,8 @@ private:
 // Vectorized push handler for spark load.
 // The parquet files generated by spark dpp are divided by tablet and the data is sorted,
 // so the push handler reads the parquet file through the broker and directly writes the rowset.
+// The segment files of FORMAT_SEGMENT_V2 built by spark for the tablet are not rewritten but linked into the
+// rowset, after being copied to the tablet path if they are read through the broker.
 class PushHandler {
 public:
     PushHandler() = default;
@@ -84,6 +87,8 @@ private:
     Status _convert(const TabletSharedPtr& cur_tablet, const TabletSharedPtr& new_tablet_vec,
                     RowsetSharedPtr* cur_rowset, RowsetSharedPtr* new_rowset);
 
+    Status _ingest_segment_files(const TabletSharedPtr& tablet, RowsetWriter* rowset_writer);
+
 private:
     // mainly tablet_id, version and delta file path
     TPushReq _request;
@@ -0,0 +1,24 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <functional>
+#include <vector>
+
+namespace starrocks {
+class ObjectPool;
+}
+
+namespace starrocks::vectorized {
+
+class ColumnPredicate;
+
+// Builds the predicates of the join runtime filters which have arrived so far, allocated from |pool|.
+// A segment iterator calls it right before filtering its segment by indexes, so that the runtime filters
+// arriving after the tablet reader is opened still prune the segments and pages not read yet.
+// The built predicates are only used to filter by indexes, the rows are still filtered by the runtime
+// filters in the scan operator.
+using RuntimeFilterPredicatesBuilder =
+        std::function<void(ObjectPool* pool, std::vector<const ColumnPredicate*>* preds)>;
+
+} // namespace starrocks::vectorized
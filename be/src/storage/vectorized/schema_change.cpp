@@ -26,12 +26,14 @@
 
 #include <algorithm>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include "runtime/exec_env.h"
 #include "runtime/heartbeat_flags.h"
 #include "runtime/mem_pool.h"
 #include "runtime/mem_tracker.h"
+#include "storage/data_dir.h"
 #include "storage/merger.h"
 #include "storage/row.h"
 #include "storage/row_block.h"
@@ -44,6 +46,7 @@
 #include "storage/vectorized/chunk_aggregator.h"
 #include "storage/vectorized/convert_helper.h"
 #include "storage/wrapper_field.h"
+#include "util/parallel_for.h"
 #include "util/unaligned_access.h"
 
 using std::deque;
@@ -1009,24 +1012,20 @@ Status SchemaChangeHandler::_do_process_alter_tablet_v2_normal(const TAlterTable
 
     Schema base_schema = ChunkHelper::convert_schema_to_format_v2(base_tablet->tablet_schema(), return_columns);
     Version delete_predicates_version(0, max_rowset->version().second);
-    TabletReaderParams read_params;
-    read_params.reader_type = ReaderType::READER_ALTER_TABLE;
-    read_params.skip_aggregation = false;
-    read_params.chunk_size = config::vector_chunk_size;
-
-    std::vector<vectorized::TabletReader*> readers;
-    for (auto rowset : rowsets_to_change) {
-        vectorized::TabletReader* tablet_rowset_reader = new TabletReader(base_tablet, rowset->version(), base_schema);
+
+    SchemaChangeParams sc_params;
+    // the rowsets are captured by the readers, so that they are kept even if the base tablet is compacted
+    // before they are converted.
+    for (auto& rowset : rowsets_to_change) {
+        auto tablet_rowset_reader = std::make_unique<TabletReader>(base_tablet, rowset->version(), base_schema,
+                                                                   std::vector<RowsetSharedPtr>{rowset});
         tablet_rowset_reader->set_delete_predicates_version(delete_predicates_version);
         RETURN_IF_ERROR(tablet_rowset_reader->prepare());
-        RETURN_IF_ERROR(tablet_rowset_reader->open(read_params));
-        readers.emplace_back(tablet_rowset_reader);
+        sc_params.rowset_readers.emplace_back(std::move(tablet_rowset_reader));
     }
 
-    SchemaChangeParams sc_params;
     sc_params.base_tablet = base_tablet;
     sc_params.new_tablet = new_tablet;
-    sc_params.rowset_readers = readers;
     sc_params.version = Version(0, end_version);
     sc_params.rowsets_to_change = rowsets_to_change;
     if (request.__isset.materialized_view_params) {
@@ -1124,7 +1123,6 @@ Status SchemaChangeHandler::_convert_historical_rowsets(SchemaChangeParams& sc_p
 
     bool sc_sorting = false;
     bool sc_directly = false;
-    std::unique_ptr<SchemaChange> sc_procedure;
     MemTracker* mem_tracker = ExecEnv::GetInstance()->schema_change_mem_tracker();
 
     // a. parse Alter request
@@ -1140,100 +1138,41 @@ Status SchemaChangeHandler::_convert_historical_rowsets(SchemaChangeParams& sc_p
         return status;
     }
 
+    const bool sc_linked = !sc_sorting && !sc_directly;
     if (sc_sorting) {
-        size_t memory_limitation = config::memory_limitation_per_thread_for_schema_change;
         LOG(INFO) << "doing schema change with sorting for base_tablet " << sc_params.base_tablet->full_name();
-        sc_procedure = std::make_unique<SchemaChangeWithSorting>(mem_tracker, chunk_changer,
-                                                                 memory_limitation * 1024 * 1024 * 1024);
-    } else if (sc_directly) {
-        sc_procedure = std::make_unique<SchemaChangeDirectly>(mem_tracker, chunk_changer);
-    } else {
+    } else if (sc_linked) {
         LOG(INFO) << "doing linked schema change for base_tablet " << sc_params.base_tablet->full_name();
-        sc_procedure = std::make_unique<LinkedSchemaChange>(mem_tracker, chunk_changer);
     }
 
-    if (sc_procedure.get() == nullptr) {
-        LOG(WARNING) << "failed to malloc SchemaChange. "
-                     << "malloc_size=" << sizeof(SchemaChangeWithSorting);
-        status = Status::InternalError("failed to malloc SchemaChange");
-        return status;
+    // the linked schema change only links the files, the others convert the rowsets in parallel.
+    // each worker has a procedure of its own, which is taken from |sc_procedures| for a rowset.
+    size_t num_rowsets = sc_params.rowsets_to_change.size();
+    size_t num_workers = sc_linked ? 1 : std::max(config::schema_change_max_parallel_rowsets, 1);
+    num_workers = std::min(num_workers, num_rowsets);
+    std::vector<std::unique_ptr<SchemaChange>> sc_procedures;
+    for (size_t i = 0; i < num_workers; ++i) {
+        sc_procedures.emplace_back(
+                _create_sc_procedure(mem_tracker, chunk_changer, sc_sorting, sc_directly, num_workers));
     }
-
-    for (int i = 0; i < sc_params.rowset_readers.size(); ++i) {
-        LOG(INFO) << "begin to convert a history rowset. version=" << sc_params.rowsets_to_change[i]->version().first
-                  << "-" << sc_params.rowsets_to_change[i]->version().second;
-        // set status for monitor
-        // If only one new_table is running, ref table will be set to running
-        // NOTE if the first sub_table is fail, it will continue as normal
-        TabletSharedPtr new_tablet = sc_params.new_tablet;
-        TabletSharedPtr base_tablet = sc_params.base_tablet;
-        RowsetWriterContext writer_context(kDataFormatUnknown, config::storage_format_version);
-        writer_context.mem_tracker = ExecEnv::GetInstance()->schema_change_mem_tracker();
-        writer_context.rowset_id = StorageEngine::instance()->next_rowset_id();
-        writer_context.tablet_uid = new_tablet->tablet_uid();
-        writer_context.tablet_id = new_tablet->tablet_id();
-        writer_context.partition_id = new_tablet->partition_id();
-        writer_context.tablet_schema_hash = new_tablet->schema_hash();
-        writer_context.rowset_type = sc_params.new_tablet->tablet_meta()->preferred_rowset_type();
-        writer_context.rowset_path_prefix = new_tablet->tablet_path();
-        writer_context.tablet_schema = &(new_tablet->tablet_schema());
-        writer_context.rowset_state = VISIBLE;
-        writer_context.version = sc_params.rowsets_to_change[i]->version();
-        writer_context.version_hash = sc_params.rowsets_to_change[i]->version_hash();
-        writer_context.segments_overlap = sc_params.rowsets_to_change[i]->rowset_meta()->segments_overlap();
-
-        if (sc_sorting) {
-            writer_context.write_tmp = true;
-        }
-
-        std::unique_ptr<RowsetWriter> rowset_writer;
-        status = RowsetFactory::create_rowset_writer(writer_context, &rowset_writer);
-        if (!status.ok()) {
-            status = Status::InternalError("build rowset writer failed");
-            LOG(INFO) << "build rowset writer failed";
-            return status;
-        }
-
-        if (!sc_procedure->process(sc_params.rowset_readers[i], rowset_writer.get(), new_tablet, base_tablet,
-                                   sc_params.rowsets_to_change[i])) {
-            LOG(WARNING) << "failed to process the version."
-                         << " version=" << sc_params.version.first << "-" << sc_params.version.second;
-            status = Status::InternalError("process failed");
-            return status;
-        }
-        // Add the new version of the data to the header,
-        // To prevent deadlocks, be sure to lock the old table first and then the new one
-        sc_params.new_tablet->obtain_push_lock();
-        RowsetSharedPtr new_rowset = rowset_writer->build();
-        if (new_rowset == nullptr) {
-            LOG(WARNING) << "failed to build rowset, exit alter process";
-            sc_params.new_tablet->release_push_lock();
-            break;
-        }
-        LOG(INFO) << "new rowset has " << new_rowset->num_segments() << " segments";
-        status = sc_params.new_tablet->add_rowset(new_rowset, false);
-        if (status.is_already_exist()) {
-            LOG(WARNING) << "version already exist, version revert occured. "
-                         << "tablet=" << sc_params.new_tablet->full_name() << ", version='" << sc_params.version.first
-                         << "-" << sc_params.version.second;
-            StorageEngine::instance()->add_unused_rowset(new_rowset);
-            status = Status::OK();
-        } else if (!status.ok()) {
-            LOG(WARNING) << "failed to register new version. "
-                         << " tablet=" << sc_params.new_tablet->full_name() << ", version=" << sc_params.version.first
-                         << "-" << sc_params.version.second;
-            StorageEngine::instance()->add_unused_rowset(new_rowset);
-            sc_params.new_tablet->release_push_lock();
-            break;
-        } else {
-            VLOG(3) << "register new version. tablet=" << sc_params.new_tablet->full_name()
-                    << ", version=" << sc_params.version.first << "-" << sc_params.version.second;
-        }
-        sc_params.new_tablet->release_push_lock();
-
-        VLOG(10) << "succeed to convert a history version."
-                 << " version=" << sc_params.version.first << "-" << sc_params.version.second;
+    if (num_workers > 1) {
+        LOG(INFO) << "converting " << num_rowsets << " rowsets with " << num_workers
+                  << " workers for base_tablet " << sc_params.base_tablet->full_name();
     }
+    std::mutex sc_procedures_mutex;
+    auto convert_rowset = [&](size_t i) {
+        std::unique_ptr<SchemaChange> sc_procedure;
+        {
+            std::lock_guard l(sc_procedures_mutex);
+            sc_procedure = std::move(sc_procedures.back());
+            sc_procedures.pop_back();
+        }
+        Status st = _convert_historical_rowset(sc_params, i, sc_procedure.get(), sc_sorting, sc_linked);
+        std::lock_guard l(sc_procedures_mutex);
+        sc_procedures.emplace_back(std::move(sc_procedure));
+        return st;
+    };
+    status = parallel_for(StorageEngine::instance()->parallel_task_pool(), num_rowsets, num_workers, convert_rowset);
 
     if (status.ok()) {
         status = sc_params.new_tablet->check_version_integrity(sc_params.version);
@@ -1246,6 +1185,109 @@ Status SchemaChangeHandler::_convert_historical_rowsets(SchemaChangeParams& sc_p
     return status;
 }
 
+std::unique_ptr<SchemaChange> SchemaChangeHandler::_create_sc_procedure(MemTracker* mem_tracker,
+                                                                       ChunkChanger& chunk_changer, bool sc_sorting,
+                                                                       bool sc_directly, size_t num_workers) {
+    if (sc_sorting) {
+        // the workers of one schema change share memory_limitation_per_thread_for_schema_change.
+        size_t memory_limitation = config::memory_limitation_per_thread_for_schema_change * 1024L * 1024 * 1024;
+        return std::make_unique<SchemaChangeWithSorting>(mem_tracker, chunk_changer,
+                                                         memory_limitation / std::max<size_t>(num_workers, 1));
+    } else if (sc_directly) {
+        return std::make_unique<SchemaChangeDirectly>(mem_tracker, chunk_changer);
+    } else {
+        return std::make_unique<LinkedSchemaChange>(mem_tracker, chunk_changer);
+    }
+}
+
+Status SchemaChangeHandler::_convert_historical_rowset(SchemaChangeParams& sc_params, size_t index,
+                                                       SchemaChange* sc_procedure, bool sc_sorting, bool sc_linked) {
+    const RowsetSharedPtr& rowset = sc_params.rowsets_to_change[index];
+    LOG(INFO) << "begin to convert a history rowset. version=" << rowset->version().first << "-"
+              << rowset->version().second;
+    // set status for monitor
+    // If only one new_table is running, ref table will be set to running
+    // NOTE if the first sub_table is fail, it will continue as normal
+    TabletSharedPtr new_tablet = sc_params.new_tablet;
+    TabletSharedPtr base_tablet = sc_params.base_tablet;
+    RowsetWriterContext writer_context(kDataFormatUnknown, config::storage_format_version);
+    writer_context.mem_tracker = ExecEnv::GetInstance()->schema_change_mem_tracker();
+    writer_context.rowset_id = StorageEngine::instance()->next_rowset_id();
+    writer_context.tablet_uid = new_tablet->tablet_uid();
+    writer_context.tablet_id = new_tablet->tablet_id();
+    writer_context.partition_id = new_tablet->partition_id();
+    writer_context.tablet_schema_hash = new_tablet->schema_hash();
+    writer_context.rowset_type = sc_params.new_tablet->tablet_meta()->preferred_rowset_type();
+    writer_context.rowset_path_prefix = new_tablet->tablet_path();
+    writer_context.tablet_schema = &(new_tablet->tablet_schema());
+    writer_context.rowset_state = VISIBLE;
+    writer_context.version = rowset->version();
+    writer_context.version_hash = rowset->version_hash();
+    writer_context.segments_overlap = rowset->rowset_meta()->segments_overlap();
+    writer_context.io_limiter = new_tablet->data_dir()->background_io_limiter();
+
+    if (sc_sorting) {
+        writer_context.write_tmp = true;
+    }
+
+    std::unique_ptr<RowsetWriter> rowset_writer;
+    Status status = RowsetFactory::create_rowset_writer(writer_context, &rowset_writer);
+    if (!status.ok()) {
+        LOG(INFO) << "build rowset writer failed";
+        return Status::InternalError("build rowset writer failed");
+    }
+
+    // the linked schema change does not read the rowset, the segments are linked to the new tablet and
+    // the columns added are read as default values.
+    std::unique_ptr<TabletReader>& reader = sc_params.rowset_readers[index];
+    if (!sc_linked) {
+        TabletReaderParams read_params;
+        read_params.reader_type = ReaderType::READER_ALTER_TABLE;
+        read_params.skip_aggregation = false;
+        read_params.chunk_size = config::vector_chunk_size;
+        RETURN_IF_ERROR(reader->open(read_params));
+    }
+    bool processed = sc_procedure->process(reader.get(), rowset_writer.get(), new_tablet, base_tablet, rowset);
+    // release the segments read as soon as the rowset is converted.
+    reader.reset();
+    if (!processed) {
+        LOG(WARNING) << "failed to process the version."
+                     << " version=" << rowset->version().first << "-" << rowset->version().second;
+        return Status::InternalError("process failed");
+    }
+    // Add the new version of the data to the header,
+    // To prevent deadlocks, be sure to lock the old table first and then the new one
+    sc_params.new_tablet->obtain_push_lock();
+    DeferOp release_push_lock([&sc_params] { sc_params.new_tablet->release_push_lock(); });
+    RowsetSharedPtr new_rowset = rowset_writer->build();
+    if (new_rowset == nullptr) {
+        LOG(WARNING) << "failed to build rowset, exit alter process";
+        return Status::InternalError("failed to build rowset");
+    }
+    LOG(INFO) << "new rowset has " << new_rowset->num_segments() << " segments";
+    status = sc_params.new_tablet->add_rowset(new_rowset, false);
+    if (status.is_already_exist()) {
+        LOG(WARNING) << "version already exist, version revert occured. "
+                     << "tablet=" << sc_params.new_tablet->full_name() << ", version='" << rowset->version().first
+                     << "-" << rowset->version().second;
+        StorageEngine::instance()->add_unused_rowset(new_rowset);
+        status = Status::OK();
+    } else if (!status.ok()) {
+        LOG(WARNING) << "failed to register new version. "
+                     << " tablet=" << sc_params.new_tablet->full_name() << ", version=" << rowset->version().first
+                     << "-" << rowset->version().second;
+        StorageEngine::instance()->add_unused_rowset(new_rowset);
+        return status;
+    } else {
+        VLOG(3) << "register new version. tablet=" << sc_params.new_tablet->full_name()
+                << ", version=" << rowset->version().first << "-" << rowset->version().second;
+    }
+
+    VLOG(10) << "succeed to convert a history version."
+             << " version=" << rowset->version().first << "-" << rowset->version().second;
+    return Status::OK();
+}
+
 // @static
 Status SchemaChangeHandler::_parse_request(
         TabletSharedPtr base_tablet, TabletSharedPtr new_tablet, ChunkChanger* chunk_changer, bool* sc_sorting,
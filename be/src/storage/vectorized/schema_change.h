@@ -168,7 +168,8 @@ public:
         AlterTabletType alter_tablet_type;
         TabletSharedPtr base_tablet;
         TabletSharedPtr new_tablet;
-        std::vector<vectorized::TabletReader*> rowset_readers;
+        // the readers of |rowsets_to_change|, opened only when the rowsets have to be rewritten.
+        std::vector<std::unique_ptr<vectorized::TabletReader>> rowset_readers;
         Version version;
         std::unordered_map<std::string, AlterMaterializedViewParam> materialized_params_map;
         std::vector<RowsetSharedPtr> rowsets_to_change;
@@ -186,6 +187,14 @@ private:
 
     static Status _convert_historical_rowsets(SchemaChangeParams& sc_params);
 
+    // create the procedure converting the rowsets for one of the |num_workers| workers of a schema change.
+    static std::unique_ptr<SchemaChange> _create_sc_procedure(MemTracker* mem_tracker, ChunkChanger& chunk_changer,
+                                                              bool sc_sorting, bool sc_directly, size_t num_workers);
+
+    // convert the |index|-th rowset of |sc_params.rowsets_to_change| and add it to the new tablet.
+    static Status _convert_historical_rowset(SchemaChangeParams& sc_params, size_t index, SchemaChange* sc_procedure,
+                                             bool sc_sorting, bool sc_linked);
+
     static Status _parse_request(
             TabletSharedPtr base_tablet, TabletSharedPtr new_tablet, ChunkChanger* chunk_changer, bool* sc_sorting,
             bool* sc_directly,
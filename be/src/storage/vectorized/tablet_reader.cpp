@@ -26,6 +26,16 @@ TabletReader::TabletReader(TabletSharedPtr tablet, const Version& version, Schem
     _delete_predicates_version = version;
 }
 
+TabletReader::TabletReader(TabletSharedPtr tablet, const Version& version, Schema schema,
+                           std::vector<RowsetSharedPtr> captured_rowsets)
+        : ChunkIterator(std::move(schema)),
+          _tablet(tablet),
+          _version(version),
+          _rowsets(std::move(captured_rowsets)),
+          _is_rowsets_captured(true) {
+    _delete_predicates_version = version;
+}
+
 void TabletReader::close() {
     if (_collect_iter != nullptr) {
         _collect_iter->close();
@@ -35,6 +45,9 @@ void TabletReader::close() {
 }
 
 Status TabletReader::prepare() {
+    if (_is_rowsets_captured) {
+        return Status::OK();
+    }
     _tablet->obtain_header_rdlock();
     auto st = _tablet->capture_consistent_rowsets(_version, &_rowsets);
     _tablet->release_header_lock();
@@ -55,10 +68,30 @@ Status TabletReader::do_get_next(Chunk* chunk) {
     return _collect_iter->get_next(chunk);
 }
 
-Status TabletReader::_get_segment_iterators(const RowsetReadOptions& options, std::vector<ChunkIteratorPtr>* iters) {
+Status TabletReader::_get_segment_iterators(const RowsetReadOptions& options, int64_t segment_begin,
+                                            int64_t segment_end, std::vector<ChunkIteratorPtr>* iters) {
     SCOPED_RAW_TIMER(&_stats.create_segment_iter_ns);
+    if (segment_end < 0) {
+        for (auto& rowset : _rowsets) {
+            RETURN_IF_ERROR(rowset->get_segment_iterators(schema(), options, iters));
+        }
+        return Status::OK();
+    }
+
+    // only read the segments in [segment_begin, segment_end) of all the rowsets.
+    int64_t rowset_segment_base = 0;
     for (auto& rowset : _rowsets) {
-        RETURN_IF_ERROR(rowset->get_segment_iterators(schema(), options, iters));
+        int64_t num_segments = rowset->num_segments();
+        int64_t begin = std::max<int64_t>(segment_begin - rowset_segment_base, 0);
+        int64_t end = std::min<int64_t>(segment_end - rowset_segment_base, num_segments);
+        rowset_segment_base += num_segments;
+        if (begin >= end) {
+            continue;
+        }
+        RowsetReadOptions rs_opts = options;
+        rs_opts.segment_begin = begin;
+        rs_opts.segment_end = end;
+        RETURN_IF_ERROR(rowset->get_segment_iterators(schema(), rs_opts, iters));
     }
     return Status::OK();
 }
@@ -78,8 +111,10 @@ Status TabletReader::_init_collector(const TabletReaderParams& params) {
     rs_opts.runtime_state = params.runtime_state;
     rs_opts.profile = params.profile;
     rs_opts.use_page_cache = params.use_page_cache;
+    rs_opts.fill_page_cache = params.fill_page_cache;
     rs_opts.tablet_schema = &(_tablet->tablet_schema());
     rs_opts.global_dictmaps = params.global_dictmaps;
+    rs_opts.runtime_filter_preds_builder = params.runtime_filter_preds_builder;
     if (keys_type == KeysType::PRIMARY_KEYS) {
         rs_opts.is_primary_keys = true;
         rs_opts.version = _version.second;
@@ -87,7 +122,7 @@ Status TabletReader::_init_collector(const TabletReaderParams& params) {
     }
 
     std::vector<ChunkIteratorPtr> seg_iters;
-    RETURN_IF_ERROR(_get_segment_iterators(rs_opts, &seg_iters));
+    RETURN_IF_ERROR(_get_segment_iterators(rs_opts, params.segment_begin, params.segment_end, &seg_iters));
 
     // Put each SegmentIterator into a TimedChunkIterator, if a profile is provided.
     if (params.profile != nullptr) {
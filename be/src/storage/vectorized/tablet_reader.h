@@ -21,6 +21,9 @@ class RowsetReadOptions;
 class TabletReader final : public ChunkIterator {
 public:
     TabletReader(TabletSharedPtr tablet, const Version& version, Schema schema);
+    // read the rowsets already captured at |version|, prepare() won't capture rowsets again.
+    TabletReader(TabletSharedPtr tablet, const Version& version, Schema schema,
+                 std::vector<RowsetSharedPtr> captured_rowsets);
     ~TabletReader() override { close(); }
 
     Status prepare();
@@ -49,7 +52,8 @@ private:
     Status _init_delete_predicates(const TabletReaderParams& read_params, DeletePredicates* dels);
     Status _init_collector(const TabletReaderParams& read_params);
     Status _to_seek_tuple(const TabletSchema& tablet_schema, const OlapTuple& input, SeekTuple* tuple);
-    Status _get_segment_iterators(const RowsetReadOptions& options, std::vector<ChunkIteratorPtr>* iters);
+    Status _get_segment_iterators(const RowsetReadOptions& options, int64_t segment_begin, int64_t segment_end,
+                                  std::vector<ChunkIteratorPtr>* iters);
 
     TabletSharedPtr _tablet;
     Version _version;
@@ -64,6 +68,7 @@ private:
     PredicateList _predicate_free_list;
 
     std::vector<RowsetSharedPtr> _rowsets;
+    bool _is_rowsets_captured = false;
     std::shared_ptr<ChunkIterator> _collect_iter;
 
     OlapReaderStatistics _stats;
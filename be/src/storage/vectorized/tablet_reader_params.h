@@ -10,6 +10,7 @@
 #include "storage/olap_common.h"
 #include "storage/tuple.h"
 #include "storage/vectorized/chunk_iterator.h"
+#include "storage/vectorized/runtime_filter_predicates.h"
 
 namespace starrocks {
 
@@ -34,6 +35,8 @@ struct TabletReaderParams {
     // 2. when read column index page
     //     if config::disable_storage_page_cache is false, we use page cache
     bool use_page_cache = false;
+    // whether to insert the data pages missed into page cache, false for the full scans.
+    bool fill_page_cache = true;
 
     // possible values are "gt", "ge", "eq"
     std::string range;
@@ -51,6 +54,15 @@ struct TabletReaderParams {
     int chunk_size = 1024;
 
     ColumnIdToGlobalDictMap* global_dictmaps = &EMPTY_GLOBAL_DICTMAPS;
+
+    // only read the segments whose ordinals are in [segment_begin, segment_end), the ordinals
+    // are counted over the segments of all the captured rowsets in order. -1 means read all.
+    // it's only valid when the rows needn't be merged across segments.
+    int64_t segment_begin = 0;
+    int64_t segment_end = -1;
+
+    // builds the index only predicates of the join runtime filters arriving after the reader is opened.
+    RuntimeFilterPredicatesBuilder runtime_filter_preds_builder;
 };
 
 } // namespace vectorized
@@ -0,0 +1,435 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include <gflags/gflags.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "column/chunk.h"
+#include "column/column_helper.h"
+#include "column/datum.h"
+#include "common/config.h"
+#include "common/object_pool.h"
+#include "common/status.h"
+#include "common/statusor.h"
+#include "env/env.h"
+#include "gen_cpp/olap_file.pb.h"
+#include "gen_cpp/segment_v2.pb.h"
+#include "gutil/strings/numbers.h"
+#include "gutil/strings/split.h"
+#include "gutil/strings/substitute.h"
+#include "runtime/mem_tracker.h"
+#include "runtime/memory/chunk_allocator.h"
+#include "storage/fs/file_block_manager.h"
+#include "storage/olap_common.h"
+#include "storage/page_cache.h"
+#include "storage/rowset/segment_v2/segment.h"
+#include "storage/rowset/segment_v2/segment_writer.h"
+#include "storage/rowset/vectorized/segment_options.h"
+#include "storage/tablet_schema.h"
+#include "storage/types.h"
+#include "storage/vectorized/chunk_helper.h"
+#include "storage/vectorized/column_predicate.h"
+#include "util/cpu_info.h"
+#include "util/file_utils.h"
+#include "util/mem_info.h"
+#include "util/stopwatch.hpp"
+
+DEFINE_string(column_types, "bigint,int,varchar",
+              "comma separated types of the columns, the first column is the sort key, "
+              "supported types are tinyint, smallint, int, bigint, float, double and varchar");
+DEFINE_string(column_encodings, "",
+              "comma separated encodings of the columns, e.g. BIT_SHUFFLE,PLAIN_ENCODING,DICT_ENCODING, "
+              "empty or DEFAULT_ENCODING for the default encoding of the type");
+DEFINE_string(column_compressions, "",
+              "comma separated compressions of the columns of form <type>[:<level>[:<dict size>]], "
+              "e.g. LZ4_FRAME,ZSTD:3,ZSTD:3:16384, empty for LZ4_FRAME");
+DEFINE_string(column_cardinalities, "",
+              "comma separated numbers of distinct values of the columns, 0 or absent for all distinct");
+DEFINE_int64(num_rows, 10000000, "number of rows of the segment");
+DEFINE_string(segment_dir, "/tmp/segment_scan_bench", "directory to write the segment into");
+DEFINE_bool(keep_segment, false, "do not remove the segment file after the benchmark");
+DEFINE_string(read_columns, "", "comma separated indexes of the columns to read, empty for all columns");
+DEFINE_string(predicates, "",
+              "comma separated predicates of form <column index>:<eq|ne|lt|le|gt|ge>:<value>, e.g. 0:lt:1000");
+DEFINE_bool(use_page_cache, false, "read pages through the storage page cache");
+DEFINE_int64(page_cache_mb, 4096, "capacity of the storage page cache in MB");
+DEFINE_int32(scan_chunk_size, 4096, "number of rows of the chunks returned by the segment iterator");
+DEFINE_int32(iterations, 5, "number of times the segment is scanned");
+
+namespace starrocks {
+
+static constexpr size_t kVarcharLength = 16;
+
+static std::string get_usage(const std::string& progname) {
+    std::stringstream ss;
+    ss << progname << " writes a synthetic segment and scans it with the vectorized segment iterator.\n";
+    ss << "Usage:\n";
+    ss << progname << " --column_types=bigint,int,varchar --column_encodings=,,DICT_ENCODING "
+       << "--column_cardinalities=0,1000,100 --num_rows=10000000\n";
+    ss << "    --column_compressions=,ZSTD:3,ZSTD:3:16384\n";
+    ss << "    --read_columns=0,2 --predicates=1:lt:100 --use_page_cache=true --iterations=5\n";
+    return ss.str();
+}
+
+static std::vector<std::string> split_flag(const std::string& flag) {
+    return strings::Split(flag, ",", strings::AllowEmpty());
+}
+
+static StatusOr<TabletSchemaPB> parse_schema() {
+    TabletSchemaPB schema_pb;
+    schema_pb.set_keys_type(DUP_KEYS);
+    schema_pb.set_num_short_key_columns(1);
+    int32_t unique_id = 0;
+    for (std::string type : split_flag(FLAGS_column_types)) {
+        std::transform(type.begin(), type.end(), type.begin(), ::toupper);
+        FieldType field_type = TabletColumn::get_field_type_by_string(type);
+        switch (field_type) {
+        case OLAP_FIELD_TYPE_TINYINT:
+        case OLAP_FIELD_TYPE_SMALLINT:
+        case OLAP_FIELD_TYPE_INT:
+        case OLAP_FIELD_TYPE_BIGINT:
+        case OLAP_FIELD_TYPE_FLOAT:
+        case OLAP_FIELD_TYPE_DOUBLE:
+        case OLAP_FIELD_TYPE_VARCHAR:
+            break;
+        default:
+            return Status::InvalidArgument("unsupported column type: " + type);
+        }
+        ColumnPB* column = schema_pb.add_column();
+        column->set_unique_id(unique_id);
+        column->set_name(strings::Substitute("c$0", unique_id));
+        column->set_type(type);
+        column->set_is_key(unique_id == 0);
+        column->set_aggregation("NONE");
+        column->set_is_nullable(false);
+        int32_t length = field_type == OLAP_FIELD_TYPE_VARCHAR ? kVarcharLength : get_type_info(field_type)->size();
+        column->set_length(length);
+        column->set_index_length(length);
+        unique_id++;
+    }
+    if (unique_id == 0) {
+        return Status::InvalidArgument("no column");
+    }
+    schema_pb.set_next_column_unique_id(unique_id);
+    return schema_pb;
+}
+
+static StatusOr<std::vector<int64_t>> parse_cardinalities(size_t num_columns) {
+    std::vector<int64_t> cardinalities(num_columns, FLAGS_num_rows);
+    auto values = split_flag(FLAGS_column_cardinalities);
+    for (size_t i = 0; i < std::min(num_columns, values.size()); ++i) {
+        int64_t cardinality = 0;
+        if (!values[i].empty() && !safe_strto64(values[i], &cardinality)) {
+            return Status::InvalidArgument("invalid cardinality: " + values[i]);
+        }
+        if (cardinality > 0) {
+            cardinalities[i] = std::min(cardinality, FLAGS_num_rows);
+        }
+    }
+    return cardinalities;
+}
+
+static Status parse_encodings(size_t num_columns, segment_v2::SegmentWriterOptions* opts) {
+    auto values = split_flag(FLAGS_column_encodings);
+    if (values.size() > num_columns) {
+        return Status::InvalidArgument("more encodings than columns");
+    }
+    for (uint32_t i = 0; i < values.size(); ++i) {
+        segment_v2::EncodingTypePB encoding;
+        if (values[i].empty()) {
+            continue;
+        }
+        if (!segment_v2::EncodingTypePB_Parse(values[i], &encoding)) {
+            return Status::InvalidArgument("invalid encoding: " + values[i]);
+        }
+        opts->column_encodings[i] = encoding;
+    }
+    return Status::OK();
+}
+
+static Status parse_compressions(size_t num_columns, segment_v2::SegmentWriterOptions* opts) {
+    auto values = split_flag(FLAGS_column_compressions);
+    if (values.size() > num_columns) {
+        return Status::InvalidArgument("more compressions than columns");
+    }
+    for (uint32_t i = 0; i < values.size(); ++i) {
+        if (values[i].empty()) {
+            continue;
+        }
+        auto parts = strings::Split(values[i], ":");
+        segment_v2::ColumnCompressionOptions compression;
+        int64_t dict_size = 0;
+        if (parts.size() > 3 || !CompressionTypePB_Parse(parts[0], &compression.compression) ||
+            (parts.size() > 1 && !safe_strto32(parts[1], &compression.level)) ||
+            (parts.size() > 2 && (!safe_strto64(parts[2], &dict_size) || dict_size < 0))) {
+            return Status::InvalidArgument("invalid compression: " + values[i]);
+        }
+        compression.dict_size = dict_size;
+        opts->column_compressions[i] = compression;
+    }
+    return Status::OK();
+}
+
+static Datum make_datum(FieldType type, int64_t value, std::string* buffer) {
+    Datum datum;
+    switch (type) {
+    case OLAP_FIELD_TYPE_TINYINT:
+        datum.set_int8(static_cast<int8_t>(value));
+        break;
+    case OLAP_FIELD_TYPE_SMALLINT:
+        datum.set_int16(static_cast<int16_t>(value));
+        break;
+    case OLAP_FIELD_TYPE_INT:
+        datum.set_int32(static_cast<int32_t>(value));
+        break;
+    case OLAP_FIELD_TYPE_BIGINT:
+        datum.set_int64(value);
+        break;
+    case OLAP_FIELD_TYPE_FLOAT:
+        datum.set_float(static_cast<float>(value));
+        break;
+    case OLAP_FIELD_TYPE_DOUBLE:
+        datum.set_double(static_cast<double>(value));
+        break;
+    default: {
+        // Zero padded, so that the strings are in the order of the values.
+        std::string digits = std::to_string(value);
+        buffer->assign(kVarcharLength - std::min(kVarcharLength, digits.size()), '0');
+        buffer->append(digits);
+        datum.set_slice(Slice(*buffer));
+    }
+    }
+    return datum;
+}
+
+// The first column is sorted and every column has values in [0, cardinality), the values of the sort
+// key are evenly distributed, and the values of the other columns are random.
+static Status write_segment(fs::BlockManager* block_mgr, const std::string& path, const TabletSchema& tablet_schema,
+                            const std::vector<int64_t>& cardinalities, segment_v2::SegmentWriterOptions opts,
+                            uint64_t* file_size) {
+    std::unique_ptr<fs::WritableBlock> wblock;
+    fs::CreateBlockOptions block_opts({path});
+    RETURN_IF_ERROR(block_mgr->create_block(block_opts, &wblock));
+    segment_v2::SegmentWriter writer(std::move(wblock), 0, &tablet_schema, opts);
+    RETURN_IF_ERROR(writer.init(0));
+
+    auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema);
+    std::mt19937_64 rand(0);
+    std::string buffer;
+    const size_t chunk_size = config::vector_chunk_size;
+    for (int64_t offset = 0; offset < FLAGS_num_rows; offset += chunk_size) {
+        const int64_t n = std::min<int64_t>(chunk_size, FLAGS_num_rows - offset);
+        auto chunk = vectorized::ChunkHelper::new_chunk(schema, n);
+        for (size_t i = 0; i < schema.num_fields(); ++i) {
+            auto& column = chunk->get_column_by_index(i);
+            const FieldType type = schema.field(i)->type()->type();
+            for (int64_t row = offset; row < offset + n; ++row) {
+                int64_t value = i == 0 ? static_cast<int64_t>(static_cast<__int128>(row) * cardinalities[i] /
+                                                              FLAGS_num_rows)
+                                       : static_cast<int64_t>(rand() % cardinalities[i]);
+                column->append_datum(make_datum(type, value, &buffer));
+            }
+        }
+        RETURN_IF_ERROR(writer.append_chunk(*chunk));
+    }
+    uint64_t index_size = 0;
+    return writer.finalize(file_size, &index_size);
+}
+
+static StatusOr<std::vector<ColumnId>> parse_read_columns(size_t num_columns) {
+    std::vector<ColumnId> cids;
+    for (const auto& value : strings::Split(FLAGS_read_columns, ",", strings::SkipWhitespace())) {
+        uint32_t cid = 0;
+        if (!safe_strtou32(value, &cid) || cid >= num_columns) {
+            return Status::InvalidArgument("invalid read column: " + value);
+        }
+        cids.push_back(cid);
+    }
+    if (cids.empty()) {
+        for (ColumnId cid = 0; cid < num_columns; ++cid) {
+            cids.push_back(cid);
+        }
+    }
+    return cids;
+}
+
+// The columns of the predicates are added into `cids` if they're not read, as the segment iterator
+// evaluates the predicates on the columns of the read schema.
+static Status parse_predicates(const TabletSchema& tablet_schema, ObjectPool* pool, std::vector<ColumnId>* cids,
+                               vectorized::SegmentReadOptions* read_opts) {
+    for (const auto& predicate : strings::Split(FLAGS_predicates, ",", strings::SkipWhitespace())) {
+        std::vector<std::string> parts = strings::Split(predicate, strings::delimiter::Limit(":", 2));
+        uint32_t cid = 0;
+        if (parts.size() != 3 || !safe_strtou32(parts[0], &cid) || cid >= tablet_schema.num_columns()) {
+            return Status::InvalidArgument("invalid predicate: " + predicate);
+        }
+        auto type_info = get_type_info(tablet_schema.column(cid).type());
+        Slice operand(parts[2]);
+        vectorized::ColumnPredicate* pred = nullptr;
+        if (parts[1] == "eq") {
+            pred = vectorized::new_column_eq_predicate(type_info, cid, operand);
+        } else if (parts[1] == "ne") {
+            pred = vectorized::new_column_ne_predicate(type_info, cid, operand);
+        } else if (parts[1] == "lt") {
+            pred = vectorized::new_column_lt_predicate(type_info, cid, operand);
+        } else if (parts[1] == "le") {
+            pred = vectorized::new_column_le_predicate(type_info, cid, operand);
+        } else if (parts[1] == "gt") {
+            pred = vectorized::new_column_gt_predicate(type_info, cid, operand);
+        } else if (parts[1] == "ge") {
+            pred = vectorized::new_column_ge_predicate(type_info, cid, operand);
+        } else {
+            return Status::InvalidArgument("invalid predicate operator: " + parts[1]);
+        }
+        pool->add(pred);
+        read_opts->predicates[cid].push_back(pred);
+        if (std::find(cids->begin(), cids->end(), cid) == cids->end()) {
+            cids->push_back(cid);
+        }
+    }
+    std::sort(cids->begin(), cids->end());
+    return Status::OK();
+}
+
+struct ScanResult {
+    int64_t rows_returned = 0;
+    int64_t elapsed_ns = 0;
+    OlapReaderStatistics stats;
+};
+
+static Status scan_segment(const std::shared_ptr<segment_v2::Segment>& segment, const vectorized::Schema& schema,
+                           vectorized::SegmentReadOptions read_opts, ScanResult* result) {
+    read_opts.stats = &result->stats;
+    MonotonicStopWatch watch;
+    watch.start();
+    auto iter = segment->new_iterator(schema, read_opts);
+    if (iter.status().is_end_of_file()) {
+        // All the rows are filtered by the zone maps.
+        result->elapsed_ns = watch.elapsed_time();
+        return Status::OK();
+    }
+    RETURN_IF_ERROR(iter.status());
+    auto chunk = vectorized::ChunkHelper::new_chunk((*iter)->schema(), read_opts.chunk_size);
+    while (true) {
+        chunk->reset();
+        Status st = (*iter)->get_next(chunk.get());
+        if (st.is_end_of_file()) {
+            break;
+        }
+        RETURN_IF_ERROR(st);
+        result->rows_returned += chunk->num_rows();
+    }
+    (*iter)->close();
+    result->elapsed_ns = watch.elapsed_time();
+    return Status::OK();
+}
+
+static void print_result(const std::string& name, const ScanResult& result) {
+    const double seconds = std::max<int64_t>(result.elapsed_ns, 1) / 1e9;
+    const auto& stats = result.stats;
+    const int64_t decode_ns = std::max<int64_t>(0, result.elapsed_ns - stats.io_ns - stats.decompress_ns);
+    printf("%-10s rows_read=%ld rows_returned=%ld time=%.3fms rows/s=%.0f io_bytes/s=%.0f decoded_bytes/s=%.0f "
+           "io=%.3fms decompress=%.3fms decode_and_filter=%.3fms pages=%ld cached_pages=%ld\n",
+           name.c_str(), stats.raw_rows_read, result.rows_returned, result.elapsed_ns / 1e6,
+           stats.raw_rows_read / seconds, stats.compressed_bytes_read / seconds, stats.bytes_read / seconds,
+           stats.io_ns / 1e6, stats.decompress_ns / 1e6, decode_ns / 1e6, stats.total_pages_num,
+           stats.cached_pages_num);
+}
+
+static Status run_segment_scan_bench() {
+    ASSIGN_OR_RETURN(auto schema_pb, parse_schema());
+    TabletSchema tablet_schema(schema_pb);
+    const size_t num_columns = tablet_schema.num_columns();
+    ASSIGN_OR_RETURN(auto cardinalities, parse_cardinalities(num_columns));
+
+    MemTracker mem_tracker;
+    segment_v2::SegmentWriterOptions writer_opts;
+    writer_opts.storage_format_version = 2;
+    writer_opts.mem_tracker = &mem_tracker;
+    RETURN_IF_ERROR(parse_encodings(num_columns, &writer_opts));
+    RETURN_IF_ERROR(parse_compressions(num_columns, &writer_opts));
+
+    fs::BlockManagerOptions block_mgr_opts;
+    block_mgr_opts.read_only = false;
+    fs::FileBlockManager block_mgr(Env::Default(), std::move(block_mgr_opts));
+    RETURN_IF_ERROR(FileUtils::create_dir(FLAGS_segment_dir));
+    const std::string path = FLAGS_segment_dir + "/segment_scan_bench.dat";
+
+    MonotonicStopWatch watch;
+    watch.start();
+    uint64_t file_size = 0;
+    RETURN_IF_ERROR(write_segment(&block_mgr, path, tablet_schema, cardinalities, writer_opts, &file_size));
+    printf("write      rows=%ld file_size=%lu time=%.3fms\n", FLAGS_num_rows, file_size, watch.elapsed_time() / 1e6);
+
+    ASSIGN_OR_RETURN(auto segment, segment_v2::Segment::open(&mem_tracker, &block_mgr, path, 0, &tablet_schema));
+    ASSIGN_OR_RETURN(auto cids, parse_read_columns(num_columns));
+    ObjectPool pool;
+    vectorized::SegmentReadOptions read_opts;
+    read_opts.block_mgr = &block_mgr;
+    read_opts.use_page_cache = FLAGS_use_page_cache;
+    read_opts.chunk_size = FLAGS_scan_chunk_size;
+    RETURN_IF_ERROR(parse_predicates(tablet_schema, &pool, &cids, &read_opts));
+    auto read_schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema, cids);
+
+    ScanResult total;
+    for (int i = 0; i < FLAGS_iterations; ++i) {
+        ScanResult result;
+        RETURN_IF_ERROR(scan_segment(segment, read_schema, read_opts, &result));
+        print_result(strings::Substitute("scan[$0]", i), result);
+        total.rows_returned += result.rows_returned;
+        total.elapsed_ns += result.elapsed_ns;
+        total.stats.raw_rows_read += result.stats.raw_rows_read;
+        total.stats.compressed_bytes_read += result.stats.compressed_bytes_read;
+        total.stats.bytes_read += result.stats.bytes_read;
+        total.stats.io_ns += result.stats.io_ns;
+        total.stats.decompress_ns += result.stats.decompress_ns;
+        total.stats.total_pages_num += result.stats.total_pages_num;
+        total.stats.cached_pages_num += result.stats.cached_pages_num;
+    }
+    print_result("total", total);
+
+    segment.reset();
+    if (!FLAGS_keep_segment) {
+        RETURN_IF_ERROR(FileUtils::remove(path));
+    }
+    mem_tracker.release(mem_tracker.consumption());
+    return Status::OK();
+}
+
+} // namespace starrocks
+
+int segment_scan_bench_main(int argc, char** argv) {
+    std::string usage = starrocks::get_usage(argv[0]);
+    gflags::SetUsageMessage(usage);
+    google::ParseCommandLineFlags(&argc, &argv, true);
+
+    // Use the default configs unless STARROCKS_HOME is set.
+    std::string conffile;
+    if (getenv("STARROCKS_HOME") != nullptr) {
+        conffile = std::string(getenv("STARROCKS_HOME")) + "/conf/be.conf";
+    }
+    if (!starrocks::config::init(conffile.empty() ? nullptr : conffile.c_str(), false)) {
+        std::cout << "error read config file" << std::endl;
+        return -1;
+    }
+    starrocks::CpuInfo::init();
+    starrocks::MemInfo::init();
+    starrocks::vectorized::ColumnHelper::init_static_variable();
+    starrocks::ChunkAllocator::init_instance(starrocks::config::chunk_reserved_bytes_limit);
+    starrocks::MemTracker page_cache_mem_tracker;
+    starrocks::StoragePageCache::create_global_cache(&page_cache_mem_tracker, FLAGS_page_cache_mb * 1024 * 1024);
+
+    starrocks::Status st = starrocks::run_segment_scan_bench();
+    starrocks::StoragePageCache::release_global_cache();
+    if (!st.ok()) {
+        std::cout << "segment scan bench failed: " << st.to_string() << std::endl;
+        return -1;
+    }
+    return 0;
+}
@@ -325,6 +325,48 @@ typedef void (*UdfPrepare)(FunctionContext* context, FunctionContext::FunctionSt
 /// execution thread with 'scope' set to THREAD_LOCAL.
 typedef void (*UdfClose)(FunctionContext* context, FunctionContext::FunctionStateScope scope);
 
+//----------------------------------------------------------------------------
+//---------------------------- Batch UDFs ------------------------------------
+//----------------------------------------------------------------------------
+// The vectorized engine evaluates a native UDF one chunk of rows per call, the symbol
+// of the UDF must implement UdfBatchEvaluate:
+//    void Example(FunctionContext* context, int num_args, const UdfColumn* args,
+//                 UdfResultColumn* result);
+//
+// Every argument is a column of num_rows rows, constant arguments are expanded:
+//  - null_data: one byte per row, 1 for NULL, or nullptr if there is no NULL.
+//  - data: the values of fixed length types, i.e. uint8_t for BOOLEAN, int8_t/int16_t/
+//    int32_t/int64_t/__int128 for TINYINT/SMALLINT/INT/BIGINT/LARGEINT, float and double
+//    for FLOAT and DOUBLE; the concatenated bytes of all the rows for CHAR and VARCHAR.
+//  - offsets: for CHAR and VARCHAR only, num_rows + 1 offsets, the i-th value is
+//    [data + offsets[i], data + offsets[i + 1]).
+//
+// The result is a column of num_rows rows:
+//  - null_data: one byte per row initialized to 0, set it to 1 for NULL.
+//  - data: for fixed length types, the num_rows values to fill in; nullptr for CHAR and
+//    VARCHAR, whose values must be appended in order by calling append_string() exactly
+//    once per row, an empty value for NULL.
+// The memory of the arguments and the result is owned by StarRocks and is valid only
+// during the call. Errors are reported by FunctionContext::set_error().
+struct UdfColumn {
+    int64_t num_rows;
+    const uint8_t* null_data;
+    const void* data;
+    const uint32_t* offsets;
+};
+
+struct UdfResultColumn {
+    int64_t num_rows;
+    uint8_t* null_data;
+    void* data;
+    void (*append_string)(UdfResultColumn* result, const uint8_t* ptr, int64_t len);
+    // Used by StarRocks to build the result, the UDF should not touch it.
+    void* builder;
+};
+
+typedef void (*UdfBatchEvaluate)(FunctionContext* context, int num_args, const UdfColumn* args,
+                                 UdfResultColumn* result);
+
 //----------------------------------------------------------------------------
 //------------------------------- UDAs ---------------------------------------
 //----------------------------------------------------------------------------
@@ -33,6 +33,7 @@
 #include <stdexcept>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "common/config.h"
 #include "common/logging.h"
@@ -786,10 +787,20 @@ public:
      * pointer).
      */
     static Roaring64Map fastunion(size_t n, const Roaring64Map** inputs) {
-        Roaring64Map ans;
-        // not particularly fast
+        // union the 32-bit bitmaps of the same high bytes at once, by roaring_bitmap_or_many.
+        std::map<uint32_t, std::vector<const Roaring*>> groups;
         for (size_t lcv = 0; lcv < n; ++lcv) {
-            ans |= *(inputs[lcv]);
+            for (const auto& map_entry : inputs[lcv]->roarings) {
+                groups[map_entry.first].push_back(&map_entry.second);
+            }
+        }
+        Roaring64Map ans;
+        for (auto& [key, group] : groups) {
+            if (group.size() == 1) {
+                ans.emplace(key, *group[0]);
+            } else {
+                ans.emplace(key, Roaring::fastunion(group.size(), group.data()));
+            }
         }
         return ans;
     }
@@ -1113,6 +1124,53 @@ public:
         return *this;
     }
 
+    // Compute the union between the current bitmap and all the provided bitmaps, which unions the containers of
+    // the same keys of all the bitmaps in one pass instead of one bitmap after another.
+    void fastunion(const std::vector<const BitmapValue*>& values) {
+        std::vector<const detail::Roaring64Map*> bitmaps;
+        std::vector<uint64_t> small_values;
+        for (const auto* value : values) {
+            switch (value->_type) {
+            case EMPTY:
+                break;
+            case SINGLE:
+                small_values.push_back(value->_sv);
+                break;
+            case SET:
+                small_values.insert(small_values.end(), value->_set.begin(), value->_set.end());
+                break;
+            case BITMAP:
+                bitmaps.push_back(value->_bitmap.get());
+                break;
+            }
+        }
+        if (bitmaps.empty()) {
+            for (uint64_t value : small_values) {
+                add(value);
+            }
+            return;
+        }
+
+        if (_type == BITMAP) {
+            bitmaps.push_back(_bitmap.get());
+        }
+        auto result =
+                std::make_shared<detail::Roaring64Map>(detail::Roaring64Map::fastunion(bitmaps.size(), bitmaps.data()));
+        if (_type == SINGLE) {
+            result->add(_sv);
+        } else if (_type == SET) {
+            for (const auto& x : _set) {
+                result->add(x);
+            }
+            _set.clear();
+        }
+        if (!small_values.empty()) {
+            result->addMany(small_values.size(), small_values.data());
+        }
+        _bitmap = std::move(result);
+        _type = BITMAP;
+    }
+
     // Note: rhs BitmapValue is only readable after this method
     // Compute the intersection between the current bitmap and the provided bitmap.
     // Possible type transitions are:
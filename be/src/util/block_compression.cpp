@@ -26,9 +26,14 @@
 #include <snappy/snappy-sinksource.h>
 #include <snappy/snappy.h>
 #include <zlib.h>
+#include <zstd/zdict.h>
 #include <zstd/zstd.h>
 #include <zstd/zstd_errors.h>
 
+#include <algorithm>
+#include <memory>
+#include <mutex>
+
 #include "gutil/strings/substitute.h"
 #include "util/faststring.h"
 
@@ -364,15 +369,26 @@ public:
 
 class ZstdBlockCompression final : public BlockCompressionCodec {
 public:
-    static const ZstdBlockCompression* instance() {
-        static ZstdBlockCompression s_instance;
-        return &s_instance;
+    static const ZstdBlockCompression* instance() { return instance(ZSTD_CLEVEL_DEFAULT); }
+
+    static const ZstdBlockCompression* instance(int level) {
+        static const std::vector<std::unique_ptr<ZstdBlockCompression>> s_instances = []() {
+            std::vector<std::unique_ptr<ZstdBlockCompression>> instances;
+            for (int i = 0; i <= ZSTD_maxCLevel(); ++i) {
+                instances.emplace_back(new ZstdBlockCompression(i));
+            }
+            return instances;
+        }();
+        if (level <= 0) {
+            level = ZSTD_CLEVEL_DEFAULT;
+        }
+        return s_instances[std::min(level, ZSTD_maxCLevel())].get();
     }
 
     ~ZstdBlockCompression() override = default;
 
     Status compress(const Slice& input, Slice* output) const override {
-        size_t ret = ZSTD_compress(output->data, output->size, input.data, input.size, ZSTD_CLEVEL_DEFAULT);
+        size_t ret = ZSTD_compress(output->data, output->size, input.data, input.size, _level);
         if (ZSTD_isError(ret)) {
             return Status::InvalidArgument(
                     strings::Substitute("ZSTD compress failed: $0", ZSTD_getErrorString(ZSTD_getErrorCode(ret))));
@@ -386,7 +402,7 @@ public:
             if (s != nullptr) ZSTD_freeCStream(s);
         };
         std::unique_ptr<ZSTD_CStream, decltype(deleter)> stream{ZSTD_createCStream(), deleter};
-        auto ret = ZSTD_initCStream(stream.get(), ZSTD_CLEVEL_DEFAULT);
+        auto ret = ZSTD_initCStream(stream.get(), _level);
         if (ZSTD_isError(ret)) {
             return Status::InvalidArgument(strings::Substitute("ZSTD ceate compress stream failed: $0", ret));
         }
@@ -440,6 +456,77 @@ public:
     }
 
     size_t max_compressed_len(size_t len) const override { return ZSTD_compressBound(len); }
+
+private:
+    explicit ZstdBlockCompression(int level) : _level(level) {}
+
+    const int _level;
+};
+
+// The dictionary is digested once for all the blocks. The contexts are cached per thread, since
+// the compression and decompression with a digested dictionary require one.
+class ZstdDictBlockCompression final : public BlockCompressionCodec {
+public:
+    ZstdDictBlockCompression(const Slice& dict, int level)
+            : _dict(dict.data, dict.size), _level(level <= 0 ? ZSTD_CLEVEL_DEFAULT : level) {}
+
+    ~ZstdDictBlockCompression() override {
+        ZSTD_freeCDict(_cdict);
+        ZSTD_freeDDict(_ddict);
+    }
+
+    Status init() {
+        // Only the writers compress, so the compression dictionary is digested lazily.
+        _ddict = ZSTD_createDDict(_dict.data(), _dict.size());
+        if (_ddict == nullptr) {
+            return Status::Corruption("invalid ZSTD dictionary");
+        }
+        return Status::OK();
+    }
+
+    Status compress(const Slice& input, Slice* output) const override {
+        std::call_once(_cdict_once, [this]() { _cdict = ZSTD_createCDict(_dict.data(), _dict.size(), _level); });
+        if (_cdict == nullptr) {
+            return Status::InternalError("ZSTD create compression dictionary failed");
+        }
+        static thread_local std::unique_ptr<ZSTD_CCtx, size_t (*)(ZSTD_CCtx*)> cctx(ZSTD_createCCtx(),
+                                                                                     ZSTD_freeCCtx);
+        size_t ret = ZSTD_compress_usingCDict(cctx.get(), output->data, output->size, input.data, input.size,
+                                              _cdict);
+        if (ZSTD_isError(ret)) {
+            return Status::InvalidArgument(
+                    strings::Substitute("ZSTD compress failed: $0", ZSTD_getErrorString(ZSTD_getErrorCode(ret))));
+        }
+        output->size = ret;
+        return Status::OK();
+    }
+
+    Status decompress(const Slice& input, Slice* output) const override {
+        if (output->data == nullptr) {
+            static uint8_t empty_buffer;
+            output->data = (char*)&empty_buffer;
+            output->size = 0;
+        }
+        static thread_local std::unique_ptr<ZSTD_DCtx, size_t (*)(ZSTD_DCtx*)> dctx(ZSTD_createDCtx(),
+                                                                                     ZSTD_freeDCtx);
+        size_t ret = ZSTD_decompress_usingDDict(dctx.get(), output->data, output->size, input.data, input.size,
+                                                _ddict);
+        if (ZSTD_isError(ret)) {
+            return Status::InvalidArgument(
+                    strings::Substitute("ZSTD decompress failed: $0", ZSTD_getErrorString(ZSTD_getErrorCode(ret))));
+        }
+        output->size = ret;
+        return Status::OK();
+    }
+
+    size_t max_compressed_len(size_t len) const override { return ZSTD_compressBound(len); }
+
+private:
+    const std::string _dict;
+    const int _level;
+    mutable std::once_flag _cdict_once;
+    mutable ZSTD_CDict* _cdict = nullptr;
+    ZSTD_DDict* _ddict = nullptr;
 };
 
 Status get_block_compression_codec(CompressionTypePB type, const BlockCompressionCodec** codec) {
@@ -468,4 +555,39 @@ Status get_block_compression_codec(CompressionTypePB type, const BlockCompressio
     return Status::OK();
 }
 
+Status get_block_compression_codec(CompressionTypePB type, int level, const BlockCompressionCodec** codec) {
+    if (type == CompressionTypePB::ZSTD) {
+        *codec = ZstdBlockCompression::instance(level);
+        return Status::OK();
+    }
+    return get_block_compression_codec(type, codec);
+}
+
+Status train_zstd_dictionary(const std::vector<Slice>& samples, size_t max_size, std::string* dict) {
+    faststring buffer;
+    std::vector<size_t> sample_sizes;
+    sample_sizes.reserve(samples.size());
+    for (const auto& sample : samples) {
+        buffer.append(sample.data, sample.size);
+        sample_sizes.push_back(sample.size);
+    }
+    dict->resize(max_size);
+    size_t ret = ZDICT_trainFromBuffer(dict->data(), max_size, buffer.data(), sample_sizes.data(),
+                                       static_cast<unsigned>(sample_sizes.size()));
+    if (ZDICT_isError(ret)) {
+        dict->clear();
+        return Status::InvalidArgument(
+                strings::Substitute("ZSTD train dictionary failed: $0", ZDICT_getErrorName(ret)));
+    }
+    dict->resize(ret);
+    return Status::OK();
+}
+
+Status create_zstd_dict_codec(const Slice& dict, int level, std::unique_ptr<BlockCompressionCodec>* codec) {
+    auto dict_codec = std::make_unique<ZstdDictBlockCompression>(dict, level);
+    RETURN_IF_ERROR(dict_codec->init());
+    *codec = std::move(dict_codec);
+    return Status::OK();
+}
+
 } // namespace starrocks
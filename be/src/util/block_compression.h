@@ -22,6 +22,8 @@
 #pragma once
 
 #include <cstddef>
+#include <memory>
+#include <string>
 #include <vector>
 
 #include "common/status.h"
@@ -73,4 +75,17 @@ public:
 // Return not OK, if error happens.
 Status get_block_compression_codec(CompressionTypePB type, const BlockCompressionCodec** codec);
 
+// The same as above, but compress with the compression |level| if the type is ZSTD, 0 for the default level.
+// The other types ignore |level|.
+Status get_block_compression_codec(CompressionTypePB type, int level, const BlockCompressionCodec** codec);
+
+// Train a ZSTD dictionary of at most |max_size| bytes from |samples|, which are the blocks to be compressed.
+// The small blocks of similar content are compressed much better with the dictionary.
+// Return not OK if there are not enough samples to train a dictionary.
+Status train_zstd_dictionary(const std::vector<Slice>& samples, size_t max_size, std::string* dict);
+
+// Create a ZSTD codec compressing with |dict| at the compression |level|, 0 for the default level.
+// The blocks compressed by it can only be decompressed by the codec of the same dictionary.
+Status create_zstd_dict_codec(const Slice& dict, int level, std::unique_ptr<BlockCompressionCodec>* codec);
+
 } // namespace starrocks
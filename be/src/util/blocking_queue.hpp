@@ -172,6 +172,22 @@ public:
         return false;
     }
 
+    // Return 1 on success;
+    // Return 0 on queue full;
+    // Return -1 on shutdown;
+    int try_put(const T& val) {
+        std::unique_lock<Lock> l(_lock);
+        if (_shutdown) {
+            return -1;
+        }
+        if (_items.size() >= _capacity) {
+            return 0;
+        }
+        _items.emplace_back(val);
+        _not_empty.notify_one();
+        return 1;
+    }
+
     // Shutdown the queue, this will wake up all waiting threads.
     void shutdown() {
         std::lock_guard<Lock> guard(_lock);
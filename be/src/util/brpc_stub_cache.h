@@ -21,48 +21,64 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <vector>
 
+#include "common/config.h"
 #include "gen_cpp/Types_types.h" // TNetworkAddress
 #include "gen_cpp/doris_internal_service.pb.h"
 #include "gen_cpp/internal_service.pb.h"
 #include "service/brpc.h"
-#include "util/spinlock.h"
 #include "util/starrocks_metrics.h"
 
 namespace starrocks {
 
-// map used
+// Caches the stubs of brpc channels by endpoint.
+//
+// The stubs are looked up for every rpc, e.g. of the exchange sinks, so the lookups only take a read lock,
+// and the write lock is taken once per endpoint to create its stubs.
+//
+// With config::brpc_connections_per_endpoint > 1, there are that many stubs per endpoint, each of which has
+// its own connection, and get_stub() returns them in round robin. Otherwise all the rpcs to an endpoint share
+// a single connection, which limits the throughput of the shuffle to it.
 class BrpcStubCache {
 public:
     BrpcStubCache() {
         _stub_map.init(239);
         REGISTER_GAUGE_STARROCKS_METRIC(brpc_endpoint_stub_count, [this]() {
-            std::lock_guard<SpinLock> l(_lock);
+            std::shared_lock l(_lock);
             return _stub_map.size();
         });
     }
     ~BrpcStubCache() {
-        for (auto& stub : _stub_map) {
-            delete stub.second;
+        for (auto& pool : _stub_map) {
+            delete pool.second;
         }
     }
 
     doris::PBackendService_Stub* get_stub(const butil::EndPoint& endpoint) {
-        std::lock_guard<SpinLock> l(_lock);
-        auto stub_ptr = _stub_map.seek(endpoint);
-        if (stub_ptr != nullptr) {
-            return *stub_ptr;
+        {
+            std::shared_lock l(_lock);
+            auto pool_ptr = _stub_map.seek(endpoint);
+            if (pool_ptr != nullptr) {
+                return (*pool_ptr)->next();
+            }
         }
-        // new one stub and insert into map
-        brpc::ChannelOptions options;
-        std::unique_ptr<brpc::Channel> channel(new brpc::Channel());
-        if (channel->Init(endpoint, &options)) {
+        std::unique_lock l(_lock);
+        auto pool_ptr = _stub_map.seek(endpoint);
+        if (pool_ptr != nullptr) {
+            return (*pool_ptr)->next();
+        }
+        auto pool = std::make_unique<StubPool>();
+        if (!pool->init(endpoint, std::max(config::brpc_connections_per_endpoint, 1))) {
             return nullptr;
         }
-        auto stub = new doris::PBackendService_Stub(channel.release(), google::protobuf::Service::STUB_OWNS_CHANNEL);
-        _stub_map.insert(endpoint, stub);
+        auto* stub = pool->next();
+        _stub_map.insert(endpoint, pool.release());
         return stub;
     }
 
@@ -85,8 +101,41 @@ public:
     }
 
 private:
-    SpinLock _lock;
-    butil::FlatMap<butil::EndPoint, doris::PBackendService_Stub*> _stub_map;
+    // The stubs of an endpoint, which are never removed once created, since the callers keep the pointers.
+    class StubPool {
+    public:
+        bool init(const butil::EndPoint& endpoint, int num_connections) {
+            for (int i = 0; i < num_connections; ++i) {
+                brpc::ChannelOptions options;
+                if (num_connections > 1) {
+                    // The single connections of channels in different groups are not shared.
+                    options.connection_type = brpc::CONNECTION_TYPE_SINGLE;
+                    options.connection_group = std::to_string(i);
+                }
+                std::unique_ptr<brpc::Channel> channel(new brpc::Channel());
+                if (channel->Init(endpoint, &options)) {
+                    return false;
+                }
+                _stubs.emplace_back(std::make_unique<doris::PBackendService_Stub>(
+                        channel.release(), google::protobuf::Service::STUB_OWNS_CHANNEL));
+            }
+            return true;
+        }
+
+        doris::PBackendService_Stub* next() {
+            if (_stubs.size() == 1) {
+                return _stubs[0].get();
+            }
+            return _stubs[_next_index.fetch_add(1, std::memory_order_relaxed) % _stubs.size()].get();
+        }
+
+    private:
+        std::vector<std::unique_ptr<doris::PBackendService_Stub>> _stubs;
+        std::atomic<size_t> _next_index{0};
+    };
+
+    std::shared_mutex _lock;
+    butil::FlatMap<butil::EndPoint, StubPool*> _stub_map;
 };
 
 } // namespace starrocks
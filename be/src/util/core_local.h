@@ -129,12 +129,14 @@ public:
     }
 
     inline size_t size() const { return _size; }
-    inline T* access() const {
+    inline T* access() const { return access_at_core(core_index()); }
+    // The index of the value of the current core, to access several values of the same core with one lookup.
+    inline size_t core_index() const {
         size_t cpu_id = sched_getcpu();
         if (cpu_id >= _size) {
             cpu_id &= _size - 1;
         }
-        return access_at_core(cpu_id);
+        return cpu_id;
     }
     inline T* access_at_core(size_t core_idx) const { return _values[core_idx]; }
 
@@ -0,0 +1,300 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "common/logging.h"
+
+namespace starrocks {
+
+// DDSketch is a quantile sketch with relative error guarantees, see "DDSketch: A Fast and Fully-Mergeable Quantile
+// Sketch with Relative-Error Guarantees" (VLDB 2019).
+//
+// A value v > 0 is counted in the bucket ceil(log_gamma(v)), gamma = (1 + accuracy) / (1 - accuracy), so that any
+// quantile is answered with a relative error of at most |accuracy|. The negative values are counted by their
+// absolute values in a separate store. A store keeps at most |max_num_buckets| buckets, and collapses its lowest
+// buckets when there are more, which keeps the higher quantiles exact to the accuracy, e.g. P99 of the latencies.
+//
+// Unlike TDigest, adding a value is a log and an increment, and merging two sketches adds up their bucket counts.
+class DDSketch {
+public:
+    // |relative_accuracy| is in [k_min_relative_accuracy, 1), or the default accuracy is used.
+    explicit DDSketch(double relative_accuracy = k_default_relative_accuracy, uint32_t max_num_buckets = 2048)
+            : _relative_accuracy(relative_accuracy), _max_num_buckets(std::max<uint32_t>(max_num_buckets, 1)) {
+        if (!(_relative_accuracy >= k_min_relative_accuracy && _relative_accuracy < 1)) {
+            _relative_accuracy = k_default_relative_accuracy;
+        }
+        _init_mapping();
+    }
+
+    static constexpr double k_default_relative_accuracy = 0.01;
+    // so that the bucket keys of the doubles fit in int32.
+    static constexpr double k_min_relative_accuracy = 1e-4;
+
+    double relative_accuracy() const { return _relative_accuracy; }
+
+    uint64_t count() const { return _zero_count + _positive.total + _negative.total; }
+
+    bool empty() const { return count() == 0; }
+
+    void add(double value, uint64_t count = 1) {
+        if (std::isnan(value) || count == 0) {
+            return;
+        }
+        _min = std::min(_min, value);
+        _max = std::max(_max, value);
+        if (value > k_min_indexable_value) {
+            _add_to_store(&_positive, _key(value), count);
+        } else if (value < -k_min_indexable_value) {
+            _add_to_store(&_negative, _key(-value), count);
+        } else {
+            _zero_count += count;
+        }
+    }
+
+    // Merge |other| into this sketch. The buckets are added up if both sketches have the same accuracy, otherwise
+    // the values of the buckets of |other| are added one bucket after another.
+    void merge(const DDSketch& other) {
+        if (other.empty()) {
+            return;
+        }
+        if (other._relative_accuracy != _relative_accuracy) {
+            other.for_each_bucket([this](double value, uint64_t count) { add(value, count); });
+            _min = std::min(_min, other._min);
+            _max = std::max(_max, other._max);
+            return;
+        }
+        _min = std::min(_min, other._min);
+        _max = std::max(_max, other._max);
+        _zero_count += other._zero_count;
+        _merge_store(&_positive, other._positive);
+        _merge_store(&_negative, other._negative);
+    }
+
+    // Return the value at the quantile |q| in [0, 1], or NaN if the sketch is empty.
+    double quantile(double q) const {
+        if (empty() || q < 0 || q > 1) {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+        const double rank = q * static_cast<double>(count() - 1);
+        double result = 0;
+        uint64_t seen = 0;
+        bool found = false;
+        // the negative values, from the largest absolute value down.
+        for (int64_t i = static_cast<int64_t>(_negative.counts.size()) - 1; i >= 0 && !found; --i) {
+            seen += _negative.counts[i];
+            if (static_cast<double>(seen) > rank) {
+                result = -_value(_negative.offset + static_cast<int32_t>(i));
+                found = true;
+            }
+        }
+        if (!found) {
+            seen += _zero_count;
+            if (static_cast<double>(seen) > rank) {
+                result = 0;
+                found = true;
+            }
+        }
+        for (size_t i = 0; i < _positive.counts.size() && !found; ++i) {
+            seen += _positive.counts[i];
+            if (static_cast<double>(seen) > rank) {
+                result = _value(_positive.offset + static_cast<int32_t>(i));
+                found = true;
+            }
+        }
+        if (!found) {
+            result = _max;
+        }
+        return std::clamp(result, _min, _max);
+    }
+
+    // Call |func| with the value and the count of every non-empty bucket.
+    template <typename Func>
+    void for_each_bucket(Func&& func) const {
+        if (_zero_count > 0) {
+            func(0.0, _zero_count);
+        }
+        for (size_t i = 0; i < _positive.counts.size(); ++i) {
+            if (_positive.counts[i] != 0) {
+                func(_value(_positive.offset + static_cast<int32_t>(i)), _positive.counts[i]);
+            }
+        }
+        for (size_t i = 0; i < _negative.counts.size(); ++i) {
+            if (_negative.counts[i] != 0) {
+                func(-_value(_negative.offset + static_cast<int32_t>(i)), _negative.counts[i]);
+            }
+        }
+    }
+
+    size_t serialize_size() const {
+        return sizeof(double) * 3 + sizeof(uint32_t) + sizeof(uint64_t) + _store_serialize_size(_positive) +
+               _store_serialize_size(_negative);
+    }
+
+    size_t serialize(uint8_t* writer) const {
+        uint8_t* start = writer;
+        writer = _write(writer, _relative_accuracy);
+        writer = _write(writer, _max_num_buckets);
+        writer = _write(writer, _min);
+        writer = _write(writer, _max);
+        writer = _write(writer, _zero_count);
+        writer = _serialize_store(writer, _positive);
+        writer = _serialize_store(writer, _negative);
+        return writer - start;
+    }
+
+    // Return the pointer to the data after the sketch.
+    const char* deserialize(const char* reader) {
+        reader = _read(reader, &_relative_accuracy);
+        reader = _read(reader, &_max_num_buckets);
+        reader = _read(reader, &_min);
+        reader = _read(reader, &_max);
+        reader = _read(reader, &_zero_count);
+        reader = _deserialize_store(reader, &_positive);
+        reader = _deserialize_store(reader, &_negative);
+        _init_mapping();
+        return reader;
+    }
+
+private:
+    // the counts of the consecutive buckets from |offset|.
+    struct Store {
+        int32_t offset = 0;
+        std::vector<uint64_t> counts;
+        uint64_t total = 0;
+    };
+
+    // the values too close to 0 to be indexed are counted as 0.
+    static constexpr double k_min_indexable_value = 1e-300;
+
+    void _init_mapping() {
+        DCHECK(_relative_accuracy > 0 && _relative_accuracy < 1) << _relative_accuracy;
+        const double gamma = (1 + _relative_accuracy) / (1 - _relative_accuracy);
+        _log_gamma = std::log(gamma);
+        _multiplier = 1 / _log_gamma;
+        // the middle of a bucket in the relative sense, 2 * gamma^k / (gamma + 1).
+        _value_factor = 2 / (1 + gamma);
+    }
+
+    int32_t _key(double value) const { return static_cast<int32_t>(std::ceil(std::log(value) * _multiplier)); }
+
+    double _value(int32_t key) const { return std::exp(key * _log_gamma) * _value_factor; }
+
+    void _add_to_store(Store* store, int32_t key, uint64_t count) const {
+        store->total += count;
+        if (store->counts.empty()) {
+            store->offset = key;
+            store->counts.push_back(count);
+            return;
+        }
+        const int32_t last = store->offset + static_cast<int32_t>(store->counts.size()) - 1;
+        if (key < store->offset) {
+            const int64_t span = static_cast<int64_t>(last) - key + 1;
+            if (span > _max_num_buckets) {
+                // collapsed into the lowest bucket kept.
+                const int32_t lowest = last - static_cast<int32_t>(_max_num_buckets) + 1;
+                if (lowest > store->offset) {
+                    _collapse(store, lowest);
+                } else if (lowest < store->offset) {
+                    store->counts.insert(store->counts.begin(), store->offset - lowest, 0);
+                    store->offset = lowest;
+                }
+                store->counts[0] += count;
+                return;
+            }
+            store->counts.insert(store->counts.begin(), store->offset - key, 0);
+            store->offset = key;
+        } else if (key > last) {
+            store->counts.resize(store->counts.size() + (key - last), 0);
+            const int64_t span = static_cast<int64_t>(key) - store->offset + 1;
+            if (span > _max_num_buckets) {
+                _collapse(store, key - static_cast<int32_t>(_max_num_buckets) + 1);
+            }
+        }
+        store->counts[key - store->offset] += count;
+    }
+
+    // Fold the buckets below |lowest| into the bucket |lowest|.
+    static void _collapse(Store* store, int32_t lowest) {
+        DCHECK_GT(lowest, store->offset);
+        const size_t n = lowest - store->offset;
+        uint64_t folded = 0;
+        for (size_t i = 0; i < n && i < store->counts.size(); ++i) {
+            folded += store->counts[i];
+        }
+        store->counts.erase(store->counts.begin(), store->counts.begin() + std::min(n, store->counts.size()));
+        if (store->counts.empty()) {
+            store->counts.push_back(0);
+        }
+        store->counts[0] += folded;
+        store->offset = lowest;
+    }
+
+    void _merge_store(Store* store, const Store& other) const {
+        for (size_t i = 0; i < other.counts.size(); ++i) {
+            if (other.counts[i] != 0) {
+                _add_to_store(store, other.offset + static_cast<int32_t>(i), other.counts[i]);
+            }
+        }
+    }
+
+    template <typename T>
+    static uint8_t* _write(uint8_t* writer, const T& value) {
+        memcpy(writer, &value, sizeof(T));
+        return writer + sizeof(T);
+    }
+
+    template <typename T>
+    static const char* _read(const char* reader, T* value) {
+        memcpy(value, reader, sizeof(T));
+        return reader + sizeof(T);
+    }
+
+    static size_t _store_serialize_size(const Store& store) {
+        return sizeof(int32_t) + sizeof(uint32_t) + store.counts.size() * sizeof(uint64_t);
+    }
+
+    static uint8_t* _serialize_store(uint8_t* writer, const Store& store) {
+        writer = _write(writer, store.offset);
+        writer = _write(writer, static_cast<uint32_t>(store.counts.size()));
+        if (!store.counts.empty()) {
+            memcpy(writer, store.counts.data(), store.counts.size() * sizeof(uint64_t));
+        }
+        return writer + store.counts.size() * sizeof(uint64_t);
+    }
+
+    static const char* _deserialize_store(const char* reader, Store* store) {
+        uint32_t size = 0;
+        reader = _read(reader, &store->offset);
+        reader = _read(reader, &size);
+        store->counts.resize(size);
+        if (size > 0) {
+            memcpy(store->counts.data(), reader, size * sizeof(uint64_t));
+        }
+        store->total = 0;
+        for (uint64_t count : store->counts) {
+            store->total += count;
+        }
+        return reader + size * sizeof(uint64_t);
+    }
+
+    double _relative_accuracy;
+    uint32_t _max_num_buckets;
+    double _log_gamma = 0;
+    double _multiplier = 0;
+    double _value_factor = 0;
+
+    double _min = std::numeric_limits<double>::max();
+    double _max = std::numeric_limits<double>::lowest();
+    uint64_t _zero_count = 0;
+    Store _positive;
+    Store _negative;
+};
+
+} // namespace starrocks
@@ -30,12 +30,14 @@
 #include <algorithm>
 #include <filesystem>
 #include <iomanip>
+#include <memory>
 #include <sstream>
 
 #include "env/env.h"
 #include "gutil/strings/split.h"
 #include "gutil/strings/strip.h"
 #include "gutil/strings/substitute.h"
+#include "util/crc32c.h"
 #include "util/defer_op.h"
 
 namespace starrocks {
@@ -285,6 +287,29 @@ Status FileUtils::md5sum(const std::string& file, std::string* md5sum) {
     return Status::OK();
 }
 
+Status FileUtils::crc32c(const std::string& file, uint32_t* checksum) {
+    int fd = open(file.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return Status::InternalError("failed to open file");
+    }
+    DeferOp close_fd([fd] { close(fd); });
+
+    std::unique_ptr<char[]> buf(new char[1024 * 1024]);
+    uint32_t crc = 0;
+    while (true) {
+        ssize_t rd_size = read(fd, buf.get(), 1024 * 1024);
+        if (rd_size < 0) {
+            PLOG(WARNING) << "failed to read " << file;
+            return Status::IOError("failed to read file");
+        } else if (rd_size == 0) {
+            break;
+        }
+        crc = crc32c::Extend(crc, buf.get(), rd_size);
+    }
+    *checksum = crc;
+    return Status::OK();
+}
+
 bool FileUtils::check_exist(const std::string& path) {
     return Env::Default()->path_exists(path).ok();
 }
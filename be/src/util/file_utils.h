@@ -108,6 +108,9 @@ public:
     // calc md5sum of a local file
     static Status md5sum(const std::string& file, std::string* md5sum);
 
+    // calc crc32c of a local file
+    static Status crc32c(const std::string& file, uint32_t* checksum);
+
     // check path(file or directory) exist with default env
     static bool check_exist(const std::string& path);
 
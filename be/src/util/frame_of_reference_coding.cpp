@@ -23,7 +23,10 @@
 
 #include <algorithm>
 #include <cstring>
+#include <limits>
+#include <type_traits>
 
+#include "gutil/endian.h"
 #include "util/bit_util.h"
 #include "util/coding.h"
 
@@ -277,8 +280,32 @@ bool ForDecoder<T>::init() {
 // param[out] output: the original integer data list
 template <typename T>
 void ForDecoder<T>::bit_unpack(const uint8_t* input, uint8_t in_num, int bit_width, T* output) {
+    uint32_t i = 0;
+    if constexpr (std::is_integral_v<T> && sizeof(T) <= 8) {
+        if (bit_width <= 56) {
+            // The values are packed from the most significant bit. Load the 8 bytes covering a value as a big
+            // endian word and shift the value out, instead of one bit a time, as long as the 8 bytes are inside
+            // the packed bytes of the frame.
+            const uint32_t num_bytes = (in_num * bit_width + 7) / 8;
+            const int shift = 64 - bit_width;
+            for (; i < in_num; i++) {
+                const uint32_t bit_offset = i * bit_width;
+                if ((bit_offset >> 3) + 8 > num_bytes) {
+                    break;
+                }
+                uint64_t word = BigEndian::Load64(input + (bit_offset >> 3));
+                output[i] = bit_width == 0 ? 0 : static_cast<T>((word << (bit_offset & 7)) >> shift);
+            }
+        }
+    }
+    if (i == in_num) {
+        return;
+    }
+    input += (i * bit_width) >> 3;
+    output += i;
+    in_num -= i;
     unsigned char in_mask = 0x80;
-    int bit_index = 0;
+    int bit_index = (i * bit_width) & 7;
     while (in_num > 0) {
         *output = 0;
         for (int i = 0; i < bit_width; i++) {
@@ -324,18 +351,18 @@ void ForDecoder<T>::decode_current_frame(T* output) {
         bit_unpack(_buffer + delta_offset, current_frame_size, bit_width, output);
     } else {
         bool is_ascending = _storage_formats[_current_decoded_frame] == 1;
-        std::vector<T> delta_values(current_frame_size);
-        bit_unpack(_buffer + delta_offset, current_frame_size, bit_width, delta_values.data());
+        // unpack the deltas into the output and add the base in place.
+        bit_unpack(_buffer + delta_offset, current_frame_size, bit_width, output);
         if (is_ascending) {
             T pre_value = min;
             for (uint8_t i = 0; i < current_frame_size; i++) {
-                T value = delta_values[i] + pre_value;
+                T value = output[i] + pre_value;
                 output[i] = value;
                 pre_value = value;
             }
         } else {
             for (uint8_t i = 0; i < current_frame_size; i++) {
-                output[i] = delta_values[i] + min;
+                output[i] = output[i] + min;
             }
         }
     }
@@ -399,9 +426,35 @@ bool ForDecoder<T>::get_batch(T* val, size_t count) {
     return true;
 }
 
+template <typename T>
+bool ForDecoder<T>::current_frame_bounds(T* min, T* max) {
+    if constexpr (!std::is_integral_v<T> || sizeof(T) > 8) {
+        return false;
+    } else {
+        DCHECK_LT(_current_index, _values_num);
+        uint32_t frame_index = _current_index / _max_frame_size;
+        if (_storage_formats[frame_index] == 2) {
+            return false;
+        }
+        // the values are the frame min plus the unsigned deltas of |bit_width| bits, the ascending frame
+        // accumulates the deltas.
+        T frame_min = decode_frame_min_value(frame_index);
+        uint8_t bit_width = _bit_widths[frame_index];
+        __int128 max_delta = bit_width >= 64 ? std::numeric_limits<uint64_t>::max() : (uint64_t(1) << bit_width) - 1;
+        if (_storage_formats[frame_index] == 1) {
+            max_delta *= frame_size(frame_index);
+        }
+        __int128 upper = static_cast<__int128>(frame_min) + max_delta;
+        *min = frame_min;
+        *max = upper > std::numeric_limits<T>::max() ? std::numeric_limits<T>::max() : static_cast<T>(upper);
+        return true;
+    }
+}
+
 template <typename T>
 bool ForDecoder<T>::skip(int32_t skip_num) {
-    if (_current_index + skip_num >= _values_num || _current_index + skip_num < 0) {
+    // skipping to the end is allowed.
+    if (_current_index + skip_num > _values_num || _current_index + skip_num < 0) {
         return false;
     }
     _current_index = _current_index + skip_num;
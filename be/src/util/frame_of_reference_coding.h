@@ -22,6 +22,7 @@
 #ifndef STARROCKS_FRAME_OF_REFERENCE_CODING_H
 #define STARROCKS_FRAME_OF_REFERENCE_CODING_H
 
+#include <algorithm>
 #include <cstdlib>
 #include <iostream>
 #include <limits>
@@ -107,6 +108,8 @@ public:
         _values_num = 0;
         _buffered_values_num = 0;
         _buffer->clear();
+        _storage_formats.clear();
+        _bit_widths.clear();
     }
 
 private:
@@ -151,6 +154,16 @@ public:
 
     uint32_t count() const { return _values_num; }
 
+    // The number of the values from the current one to the end of its frame.
+    uint32_t current_frame_remaining() const {
+        uint32_t frame_end = std::min(_values_num, (_current_index / _max_frame_size + 1) * _max_frame_size);
+        return frame_end - _current_index;
+    }
+
+    // Gets the bounds of the values of the frame containing the current value, without decoding the frame.
+    // Returns false if the bounds are unknown, i.e. the frame keeps the original values.
+    bool current_frame_bounds(T* min, T* max);
+
 private:
     void bit_unpack(const uint8_t* input, uint8_t in_num, int bit_width, T* output);
 
@@ -21,6 +21,9 @@
 
 #include "util/metrics.h"
 
+#include <cmath>
+#include <numeric>
+
 namespace starrocks {
 
 MetricLabels MetricLabels::EmptyLabels;
@@ -88,6 +91,91 @@ void Metric::hide() {
     _registry = nullptr;
 }
 
+int CoreLocalHistogram::bucket_index(int64_t value) {
+    // Shift the values by one, so that the powers of two are the upper bounds of the buckets.
+    uint64_t v = value > 0 ? value - 1 : 0;
+    v = std::min<uint64_t>(v, (1ULL << kMaxExponent) - 1);
+    if (v < kSubBuckets) {
+        return static_cast<int>(v);
+    }
+    const int exponent = 63 - __builtin_clzll(v);
+    const int sub_bucket = static_cast<int>(v >> (exponent - kSubBucketBits)) & (kSubBuckets - 1);
+    return (exponent - kSubBucketBits + 1) * kSubBuckets + sub_bucket;
+}
+
+int64_t CoreLocalHistogram::bucket_upper_bound(int index) {
+    if (index < kSubBuckets) {
+        return index + 1;
+    }
+    const int exponent = index / kSubBuckets + kSubBucketBits - 1;
+    const int sub_bucket = index % kSubBuckets;
+    return static_cast<int64_t>(kSubBuckets + sub_bucket + 1) << (exponent - kSubBucketBits);
+}
+
+std::vector<int64_t> CoreLocalHistogram::bucket_counts() const {
+    std::vector<int64_t> counts(kNumBuckets, 0);
+    for (int i = 0; i < kNumBuckets; ++i) {
+        for (size_t core = 0; core < _buckets[i].size(); ++core) {
+            counts[i] += *_buckets[i].access_at_core(core);
+        }
+    }
+    return counts;
+}
+
+int64_t CoreLocalHistogram::count() const {
+    auto counts = bucket_counts();
+    return std::accumulate(counts.begin(), counts.end(), static_cast<int64_t>(0));
+}
+
+int64_t CoreLocalHistogram::sum() const {
+    int64_t sum = 0;
+    for (size_t core = 0; core < _sum.size(); ++core) {
+        sum += *_sum.access_at_core(core);
+    }
+    return sum;
+}
+
+int64_t CoreLocalHistogram::value_at(double percentile) const {
+    auto counts = bucket_counts();
+    return _value_at(counts, std::accumulate(counts.begin(), counts.end(), static_cast<int64_t>(0)), percentile);
+}
+
+int64_t CoreLocalHistogram::_value_at(const std::vector<int64_t>& counts, int64_t count, double percentile) {
+    if (count == 0) {
+        return 0;
+    }
+    const auto rank = std::max<int64_t>(static_cast<int64_t>(std::ceil(percentile * count)), 1);
+    int64_t seen = 0;
+    for (int i = 0; i < kNumBuckets; ++i) {
+        seen += counts[i];
+        if (seen >= rank) {
+            return bucket_upper_bound(i);
+        }
+    }
+    return bucket_upper_bound(kNumBuckets - 1);
+}
+
+std::string CoreLocalHistogram::to_string() const {
+    auto counts = bucket_counts();
+    auto count = std::accumulate(counts.begin(), counts.end(), static_cast<int64_t>(0));
+    std::stringstream ss;
+    ss << "count=" << count << " sum=" << sum() << " p50=" << _value_at(counts, count, 0.5)
+       << " p90=" << _value_at(counts, count, 0.9) << " p99=" << _value_at(counts, count, 0.99)
+       << " p999=" << _value_at(counts, count, 0.999);
+    return ss.str();
+}
+
+void CoreLocalHistogram::write_value(rj::Value& metric_obj, rj::Document::AllocatorType& allocator) {
+    auto counts = bucket_counts();
+    auto count = std::accumulate(counts.begin(), counts.end(), static_cast<int64_t>(0));
+    metric_obj.AddMember("count", rj::Value(count), allocator);
+    metric_obj.AddMember("sum", rj::Value(sum()), allocator);
+    metric_obj.AddMember("p50", rj::Value(_value_at(counts, count, 0.5)), allocator);
+    metric_obj.AddMember("p90", rj::Value(_value_at(counts, count, 0.9)), allocator);
+    metric_obj.AddMember("p99", rj::Value(_value_at(counts, count, 0.99)), allocator);
+    metric_obj.AddMember("p999", rj::Value(_value_at(counts, count, 0.999)), allocator);
+}
+
 bool MetricCollector::add_metric(const MetricLabels& labels, Metric* metric) {
     if (empty()) {
         _type = metric->type();
@@ -30,15 +30,18 @@ DIAGNOSTIC_IGNORE("-Wclass-memaccess")
 DIAGNOSTIC_POP
 #include <rapidjson/rapidjson.h>
 
+#include <algorithm>
 #include <atomic>
 #include <functional>
 #include <iomanip>
+#include <memory>
 #include <mutex>
 #include <ostream>
 #include <set>
 #include <sstream>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "common/config.h"
 #include "util/core_local.h"
@@ -211,6 +214,50 @@ public:
     virtual ~LockGauge() = default;
 };
 
+// A histogram of non-negative values such as latencies, whose buckets are log-linear like HdrHistogram:
+// every power of two is split into kSubBuckets buckets, so a percentile is estimated within 1/kSubBuckets
+// of its value. The bucket i holds the values in (bucket_upper_bound(i - 1), bucket_upper_bound(i)], and
+// the values beyond 2^kMaxExponent are counted in the last bucket.
+//
+// The buckets are core local like IntCounter, so recording a value from many threads is as cheap as
+// incrementing a counter, and only reading the histogram merges the buckets of all the cores.
+class CoreLocalHistogram : public Metric {
+public:
+    static constexpr int kSubBucketBits = 2;
+    static constexpr int kSubBuckets = 1 << kSubBucketBits;
+    static constexpr int kMaxExponent = 40;
+    static constexpr int kNumBuckets = (kMaxExponent - kSubBucketBits + 1) * kSubBuckets;
+
+    explicit CoreLocalHistogram(MetricUnit unit) : Metric(MetricType::HISTOGRAM, unit) {}
+    ~CoreLocalHistogram() override = default;
+
+    void record(int64_t value) {
+        const size_t core = _sum.core_index();
+        __sync_fetch_and_add(_buckets[bucket_index(value)].access_at_core(core), 1);
+        __sync_fetch_and_add(_sum.access_at_core(core), std::max<int64_t>(value, 0));
+    }
+
+    static int bucket_index(int64_t value);
+    static int64_t bucket_upper_bound(int index);
+
+    // The number of values recorded into every bucket.
+    std::vector<int64_t> bucket_counts() const;
+    int64_t count() const;
+    int64_t sum() const;
+    // The upper bound of the bucket of the value at the percentile, `percentile` is in [0, 1].
+    int64_t value_at(double percentile) const;
+
+    // e.g. "count=10 sum=1234 p50=64 p90=160 p99=320 p999=320"
+    std::string to_string() const override;
+    void write_value(rj::Value& metric_obj, rj::Document::AllocatorType& allocator) override;
+
+private:
+    static int64_t _value_at(const std::vector<int64_t>& counts, int64_t count, double percentile);
+
+    std::unique_ptr<CoreLocalValue<int64_t>[]> _buckets{new CoreLocalValue<int64_t>[kNumBuckets]};
+    CoreLocalValue<int64_t> _sum;
+};
+
 // one key-value pair used to
 struct MetricLabel {
     std::string name;
@@ -392,6 +439,7 @@ using DoubleCounter = LockCounter<double>;
 using IntGauge = AtomicGauge<int64_t>;
 using UIntGauge = AtomicGauge<uint64_t>;
 using DoubleGauge = LockGauge<double>;
+using IntHistogram = CoreLocalHistogram;
 
 class TcmallocMetric final : public UIntGauge {
 public:
@@ -433,5 +481,8 @@ private:
 #define METRIC_DEFINE_DOUBLE_GAUGE(metric_name, unit) \
     starrocks::DoubleGauge metric_name { unit }
 
+#define METRIC_DEFINE_INT_HISTOGRAM(metric_name, unit) \
+    starrocks::IntHistogram metric_name { unit }
+
 #define METRIC_DEFINE_TCMALLOC_GAUGE(metric_name, tcmalloc_var) \
     starrocks::TcmallocMetric metric_name { tcmalloc_var }
@@ -0,0 +1,74 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/parallel_for.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+#include "util/threadpool.h"
+
+namespace starrocks {
+
+namespace {
+
+// The state shared by the caller and the workers, which may outlive the call in the workers started late.
+struct ParallelForState {
+    ParallelForState(size_t num, const std::function<Status(size_t)>* func) : num(num), func(func) {}
+
+    // Run |func| on the indexes not taken yet until all of them are taken or an error happens.
+    void run() {
+        std::unique_lock l(mutex);
+        if (next >= num) {
+            return;
+        }
+        num_running++;
+        while (next < num) {
+            size_t i = next++;
+            l.unlock();
+            Status st = (*func)(i);
+            l.lock();
+            if (!st.ok()) {
+                if (status.ok()) {
+                    status = st;
+                }
+                next = num;
+            }
+        }
+        if (--num_running == 0) {
+            cv.notify_all();
+        }
+    }
+
+    const size_t num;
+    // only used while |next| < |num|, i.e. before the call returns.
+    const std::function<Status(size_t)>* func;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    size_t next = 0;
+    size_t num_running = 0;
+    Status status;
+};
+
+} // namespace
+
+Status parallel_for(ThreadPool* pool, size_t num, size_t parallelism, const std::function<Status(size_t)>& func) {
+    auto state = std::make_shared<ParallelForState>(num, &func);
+    size_t num_workers = std::min(std::max<size_t>(parallelism, 1), num);
+    if (pool != nullptr) {
+        for (size_t i = 1; i < num_workers; ++i) {
+            if (!pool->submit_func([state]() { state->run(); }).ok()) {
+                break;
+            }
+        }
+    }
+    state->run();
+
+    std::unique_lock l(state->mutex);
+    state->cv.wait(l, [&]() { return state->num_running == 0; });
+    return state->status;
+}
+
+} // namespace starrocks
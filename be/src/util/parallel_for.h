@@ -0,0 +1,21 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+#include "common/status.h"
+
+namespace starrocks {
+
+class ThreadPool;
+
+// Run |func| on 0, 1, ..., |num| - 1 by at most |parallelism| workers, and stop taking more at the first
+// error, which is returned. The caller is one of the workers and the others are submitted to |pool|, so
+// the call always makes progress even if |pool| is busy, nullptr or full, in which case the caller runs
+// the rest alone. The workers which start after all the indexes are taken return at once, the call only
+// waits for the workers running |func|.
+Status parallel_for(ThreadPool* pool, size_t num, size_t parallelism, const std::function<Status(size_t)>& func);
+
+} // namespace starrocks
@@ -3,54 +3,96 @@
 #ifndef STARROCKS_PERCENTILE_VALUE_H
 #define STARROCKS_PERCENTILE_VALUE_H
 
+#include "ddsketch.h"
 #include "tdigest.h"
 
 namespace starrocks {
 class PercentileValue {
 public:
+    enum PercentileDataType { TDIGEST = 0, DDSKETCH = 1 };
+
     PercentileValue() { _type = TDIGEST; }
 
-    explicit PercentileValue(const Slice& src) {
-        switch (*src.data) {
-        case PercentileDataType::TDIGEST:
-            _type = TDIGEST;
-            break;
-        default:
-            DCHECK(false);
+    // A DDSketch percentile of the relative accuracy |relative_accuracy|.
+    explicit PercentileValue(double relative_accuracy) : _type(DDSKETCH), _ddsketch(relative_accuracy) {}
+
+    explicit PercentileValue(const Slice& src) { deserialize(src.data); }
+
+    PercentileDataType type() const { return _type; }
+
+    void add(float value) {
+        if (_type == DDSKETCH) {
+            _ddsketch.add(value);
+        } else {
+            _tdigest.add(value);
         }
-        _tdigest.deserialize(src.data + 1);
     }
 
-    void add(float value) { _tdigest.add(value); }
-
-    void merge(const PercentileValue* other) { _tdigest.merge(&other->_tdigest); }
+    // The percentiles of different types are merged by adding the centroids or the buckets of |other| as values
+    // with weights. An empty TDIGEST percentile, e.g. a new state, takes the type of |other|.
+    void merge(const PercentileValue* other) {
+        if (_type == other->_type) {
+            if (_type == DDSKETCH) {
+                _ddsketch.merge(other->_ddsketch);
+            } else {
+                _tdigest.merge(&other->_tdigest);
+            }
+        } else if (other->_type == DDSKETCH) {
+            if (_tdigest.processedWeight() + _tdigest.unprocessedWeight() == 0) {
+                _type = DDSKETCH;
+                _ddsketch = other->_ddsketch;
+                return;
+            }
+            other->_ddsketch.for_each_bucket([this](double value, uint64_t count) {
+                _tdigest.add(static_cast<Value>(value), static_cast<Weight>(count));
+            });
+        } else {
+            for (const auto* centroids : {&other->_tdigest.processed(), &other->_tdigest.unprocessed()}) {
+                for (const auto& centroid : *centroids) {
+                    _ddsketch.add(centroid.mean(), static_cast<uint64_t>(centroid.weight()));
+                }
+            }
+        }
+    }
 
     uint64_t serialize_size() const {
         //_type 1 bytes
-        return 1 + _tdigest.serialize_size();
+        return 1 + (_type == DDSKETCH ? _ddsketch.serialize_size() : _tdigest.serialize_size());
     }
 
     size_t serialize(uint8_t* writer) const {
         *(writer) = _type;
+        if (_type == DDSKETCH) {
+            return _ddsketch.serialize(writer + 1);
+        }
         return _tdigest.serialize(writer + 1);
     }
     void deserialize(const char* type_reader) {
         switch (*type_reader) {
         case PercentileDataType::TDIGEST:
             _type = TDIGEST;
+            _tdigest.deserialize(type_reader + 1);
+            break;
+        case PercentileDataType::DDSKETCH:
+            _type = DDSKETCH;
+            _ddsketch.deserialize(type_reader + 1);
             break;
         default:
             DCHECK(false);
         }
-        _tdigest.deserialize(type_reader + 1);
     }
 
-    Value quantile(Value q) { return _tdigest.quantile(q); }
+    Value quantile(Value q) {
+        if (_type == DDSKETCH) {
+            return static_cast<Value>(_ddsketch.quantile(q));
+        }
+        return _tdigest.quantile(q);
+    }
 
 private:
-    enum PercentileDataType { TDIGEST = 0 };
-    TDigest _tdigest;
     PercentileDataType _type;
+    TDigest _tdigest;
+    DDSketch _ddsketch;
 };
 } // namespace starrocks
 #endif //STARROCKS_PERCENTILE_VALUE_H
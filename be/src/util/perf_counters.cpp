@@ -26,6 +26,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <sys/syscall.h>
+#include <unistd.h>
 
 #include <fstream>
 #include <iomanip>
@@ -514,4 +515,64 @@ void PerfCounters::pretty_print(ostream* s) const {
     stream << std::endl;
 }
 
+ThreadHardwareCounters* ThreadHardwareCounters::current() {
+    thread_local bool opened = false;
+    thread_local std::unique_ptr<ThreadHardwareCounters> counters;
+    if (!opened) {
+        opened = true;
+        counters.reset(new ThreadHardwareCounters());
+        if (!counters->open()) {
+            counters.reset();
+        }
+    }
+    return counters.get();
+}
+
+ThreadHardwareCounters::ThreadHardwareCounters() {
+    _fds.fill(-1);
+}
+
+ThreadHardwareCounters::~ThreadHardwareCounters() {
+    for (int fd : _fds) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+}
+
+bool ThreadHardwareCounters::open() {
+    static const PerfCounters::Counter kCounters[NUM_EVENTS] = {
+            PerfCounters::PERF_COUNTER_HW_CPU_CYCLES, PerfCounters::PERF_COUNTER_HW_INSTRUCTIONS,
+            PerfCounters::PERF_COUNTER_HW_CACHE_MISSES, PerfCounters::PERF_COUNTER_HW_BRANCH_MISSES};
+    for (int i = 0; i < NUM_EVENTS; ++i) {
+        perf_event_attr attr;
+        init_event_attr(&attr, kCounters[i]);
+        // Only count the user space of this thread, which is allowed with perf_event_paranoid <= 2.
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP;
+        int fd = sys_perf_event_open(&attr, 0, -1, _group_fd, 0);
+        if (fd < 0) {
+            return false;
+        }
+        _fds[i] = fd;
+        if (_group_fd == -1) {
+            _group_fd = fd;
+        }
+    }
+    return true;
+}
+
+bool ThreadHardwareCounters::read(Values* values) const {
+    // The layout of PERF_FORMAT_GROUP: the number of events followed by their values.
+    uint64_t buffer[NUM_EVENTS + 1];
+    if (::read(_group_fd, buffer, sizeof(buffer)) != sizeof(buffer) || buffer[0] != NUM_EVENTS) {
+        return false;
+    }
+    for (int i = 0; i < NUM_EVENTS; ++i) {
+        (*values)[i] = buffer[i + 1];
+    }
+    return true;
+}
+
 } // namespace starrocks
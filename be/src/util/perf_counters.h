@@ -22,7 +22,9 @@
 #ifndef STARROCKS_BE_SRC_COMMON_UTIL_PERF_COUNTERS_H
 #define STARROCKS_BE_SRC_COMMON_UTIL_PERF_COUNTERS_H
 
+#include <array>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -141,6 +143,38 @@ private:
     int _group_fd;
 };
 
+// The hardware counters of the calling thread in one perf event group, which are read together,
+// so the events between two reads can be attributed to the code running in between.
+class ThreadHardwareCounters {
+public:
+    enum Event {
+        CPU_CYCLES,
+        INSTRUCTIONS,
+        LLC_MISSES,
+        BRANCH_MISSES,
+        NUM_EVENTS,
+    };
+    using Values = std::array<int64_t, NUM_EVENTS>;
+
+    // Returns the counters of the calling thread, which are opened at the first call in the thread
+    // and closed when the thread exits. Returns nullptr if the counters are not available, e.g. in
+    // a VM without PMU or not permitted by perf_event_paranoid.
+    static ThreadHardwareCounters* current();
+
+    ~ThreadHardwareCounters();
+
+    // Read the current values of all the events, returns false on failure.
+    bool read(Values* values) const;
+
+private:
+    ThreadHardwareCounters();
+
+    bool open();
+
+    int _group_fd = -1;
+    std::array<int, NUM_EVENTS> _fds;
+};
+
 } // namespace starrocks
 
 #endif
@@ -26,6 +26,8 @@
 #include <atomic>
 #include <boost/thread.hpp>
 #include <functional>
+#include <memory>
+#include <vector>
 
 #include "util/blocking_priority_queue.hpp"
 
@@ -33,6 +35,11 @@ namespace starrocks {
 
 // Simple threadpool which processes items (of type T) in parallel which were placed on a
 // blocking queue by Offer(). Each item is processed by a single user-supplied method.
+//
+// With more than one lane, the work is spread over the priority queues of the lanes instead of a single queue,
+// so that the many threads of the pool don't contend for the lock of a single queue. A thread takes the work of
+// its own lane first and steals the work of the other lanes when its lane is empty. The priority of the work is
+// kept within a lane only.
 class PriorityThreadPool {
 public:
     // Signature of a work-processing function. Takes the integer id of the thread which is
@@ -57,8 +64,13 @@ public:
     //  -- queue_size: the maximum size of the queue on which work items are offered. If the
     //     queue exceeds this size, subsequent calls to Offer will block until there is
     //     capacity available.
-    //  -- work_function: the function to run every time an item is consumed from the queue
-    PriorityThreadPool(uint32_t num_threads, uint32_t queue_size) : _work_queue(queue_size), _shutdown(false) {
+    //  -- num_lanes: the number of the queues the work items are spread over.
+    PriorityThreadPool(uint32_t num_threads, uint32_t queue_size, uint32_t num_lanes = 1) : _shutdown(false) {
+        num_lanes = std::max<uint32_t>(1, std::min(num_lanes, std::max<uint32_t>(1, num_threads)));
+        const uint32_t lane_size = std::max<uint32_t>(1, queue_size / num_lanes);
+        for (uint32_t i = 0; i < num_lanes; ++i) {
+            _work_queues.emplace_back(std::make_unique<BlockingPriorityQueue<Task>>(lane_size));
+        }
         for (int i = 0; i < num_threads; ++i) {
             new_thread(++_current_thread_id);
         }
@@ -82,13 +94,33 @@ public:
     //
     // Returns true if the work item was successfully added to the queue, false otherwise
     // (which typically means that the thread pool has already been shut down).
-    bool offer(const Task& task) { return _work_queue.blocking_put(task); }
+    bool offer(const Task& task) {
+        if (_work_queues.size() == 1) {
+            return _work_queues[0]->blocking_put(task);
+        }
+        const size_t lane = _next_lane++ % _work_queues.size();
+        if (_try_put(lane, task)) {
+            return true;
+        }
+        _num_pending++;
+        if (!_work_queues[lane]->blocking_put(task)) {
+            _num_pending--;
+            return false;
+        }
+        _wake_idle_thread();
+        return true;
+    }
 
-    bool try_offer(const Task& task) { return _work_queue.try_put(task); }
+    bool try_offer(const Task& task) {
+        if (_work_queues.size() == 1) {
+            return _work_queues[0]->try_put(task);
+        }
+        return _try_put(_next_lane++ % _work_queues.size(), task);
+    }
 
     bool offer(WorkFunction func) {
         PriorityThreadPool::Task task = {0, std::move(func)};
-        return _work_queue.blocking_put(std::move(task));
+        return offer(task);
     }
 
     // Shuts the thread pool down, causing the work queue to cease accepting offered work
@@ -100,16 +132,28 @@ public:
             std::lock_guard<std::mutex> l(_lock);
             _shutdown = true;
         }
-        _work_queue.shutdown();
+        for (auto& queue : _work_queues) {
+            queue->shutdown();
+        }
+        {
+            std::lock_guard<std::mutex> l(_idle_lock);
+        }
+        _idle_cv.notify_all();
     }
 
     // Blocks until all threads are finished. shutdown does not need to have been called,
     // since it may be called on a separate thread.
     void join() { _threads.join_all(); }
 
-    size_t get_queue_capacity() const { return _work_queue.get_capacity(); }
+    size_t get_queue_capacity() const { return _work_queues[0]->get_capacity() * _work_queues.size(); }
 
-    uint32_t get_queue_size() const { return _work_queue.get_size(); }
+    uint32_t get_queue_size() const {
+        uint32_t size = 0;
+        for (const auto& queue : _work_queues) {
+            size += queue->get_size();
+        }
+        return size;
+    }
 
     // Blocks until the work queue is empty, and then calls shutdown to stop the worker
     // threads and Join to wait until they are finished.
@@ -117,7 +161,7 @@ public:
     void drain_and_shutdown() {
         {
             std::unique_lock<std::mutex> l(_lock);
-            while (_work_queue.get_size() != 0) {
+            while (get_queue_size() != 0) {
                 _empty_cv.wait(l);
             }
         }
@@ -147,7 +191,7 @@ private:
 
         for (int i = 0; i < num_thread; ++i) {
             PriorityThreadPool::Task empty_task = {0, []() {}};
-            _work_queue.try_put(empty_task);
+            try_offer(empty_task);
         }
     }
 
@@ -168,15 +212,58 @@ private:
         }
     }
 
+    // Put |task| to the lane |lane|, or the first of the next lanes not full.
+    bool _try_put(size_t lane, const Task& task) {
+        _num_pending++;
+        for (size_t i = 0; i < _work_queues.size(); ++i) {
+            if (_work_queues[(lane + i) % _work_queues.size()]->try_put(task)) {
+                _wake_idle_thread();
+                return true;
+            }
+        }
+        _num_pending--;
+        return false;
+    }
+
+    void _wake_idle_thread() {
+        if (_num_idle > 0) {
+            {
+                std::lock_guard<std::mutex> l(_idle_lock);
+            }
+            _idle_cv.notify_one();
+        }
+    }
+
+    // Take a task from the lane of the thread |thread_id| first, or steal one from the other lanes, waiting for
+    // a task to be offered if all the lanes are empty. Returns false iff the pool has been shutdown.
+    bool _get_task(int thread_id, Task* task) {
+        if (_work_queues.size() == 1) {
+            return _work_queues[0]->blocking_get(task);
+        }
+        while (!_shutdown) {
+            for (size_t i = 0; i < _work_queues.size(); ++i) {
+                if (_work_queues[(thread_id + i) % _work_queues.size()]->non_blocking_get(task)) {
+                    _num_pending--;
+                    return true;
+                }
+            }
+            std::unique_lock<std::mutex> l(_idle_lock);
+            _num_idle++;
+            _idle_cv.wait(l, [this] { return _num_pending > 0 || _shutdown; });
+            _num_idle--;
+        }
+        return false;
+    }
+
     // Driver method for each thread in the pool. Continues to read work from the queue
     // until the pool is shutdown.
     void work_thread(int thread_id) {
         while (!is_shutdown()) {
             Task task;
-            if (_work_queue.blocking_get(&task)) {
+            if (_get_task(thread_id, &task)) {
                 task.work_function();
             }
-            if (_work_queue.get_size() == 0) {
+            if (get_queue_size() == 0) {
                 _empty_cv.notify_all();
             }
             if (_should_decrease) {
@@ -199,18 +286,15 @@ private:
         }
     }
 
-    // Returns value of _shutdown under a lock, forcing visibility to threads in the pool.
-    bool is_shutdown() {
-        std::lock_guard<std::mutex> l(_lock);
-        return _shutdown;
-    }
+    // Returns value of _shutdown, which is set under a lock.
+    bool is_shutdown() { return _shutdown; }
     // thread pointer
     // tid
     std::vector<std::pair<boost::thread*, int>> _threads_holder;
 
-    // Queue on which work items are held until a thread is available to process them in
-    // FIFO order.
-    BlockingPriorityQueue<Task> _work_queue;
+    // Queues on which work items are held until a thread is available to process them in
+    // priority order, one for each lane.
+    std::vector<std::unique_ptr<BlockingPriorityQueue<Task>>> _work_queues;
 
     // Collection of worker threads that process work from the queue.
     boost::thread_group _threads;
@@ -219,7 +303,7 @@ private:
     std::mutex _lock;
 
     // Set to true when threads should stop doing work and terminate.
-    bool _shutdown;
+    std::atomic<bool> _shutdown;
 
     // Signalled when the queue becomes empty
     std::condition_variable _empty_cv;
@@ -227,6 +311,14 @@ private:
     std::atomic<int32_t> _should_decrease = 0;
 
     std::atomic<int32_t> _current_thread_id = 0;
+
+    // The lane of the next task offered, the tasks in the lanes and the threads waiting for them, if there are
+    // more than one lane.
+    std::atomic<size_t> _next_lane = 0;
+    std::atomic<int64_t> _num_pending = 0;
+    std::atomic<int32_t> _num_idle = 0;
+    std::mutex _idle_lock;
+    std::condition_variable _idle_cv;
 };
 
 } // namespace starrocks
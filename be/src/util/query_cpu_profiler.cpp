@@ -0,0 +1,194 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/query_cpu_profiler.h"
+
+#include <gperftools/stacktrace.h>
+#include <sys/time.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <tuple>
+
+#include "common/config.h"
+#include "common/logging.h"
+#include "gutil/strings/substitute.h"
+#include "runtime/current_thread.h"
+
+namespace starrocks {
+
+QueryCpuProfiler* QueryCpuProfiler::instance() {
+    static QueryCpuProfiler profiler;
+    return &profiler;
+}
+
+QueryCpuProfiler::~QueryCpuProfiler() {
+    stop();
+}
+
+Status QueryCpuProfiler::start(int frequency) {
+    std::lock_guard<std::mutex> l(_state_lock);
+    if (_running) {
+        return Status::OK();
+    }
+    if (frequency <= 0 || frequency > 1000) {
+        return Status::InvalidArgument(strings::Substitute("invalid cpu profiler frequency $0", frequency));
+    }
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_sigaction = _signal_handler;
+    action.sa_flags = SA_RESTART | SA_SIGINFO;
+    sigemptyset(&action.sa_mask);
+    if (sigaction(SIGPROF, &action, &_old_action) != 0) {
+        return Status::InternalError(strings::Substitute("failed to install SIGPROF handler: $0", strerror(errno)));
+    }
+
+    _stopped = false;
+    _aggregate_thread = std::make_unique<std::thread>([this]() {
+        while (!_stopped) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(500));
+            aggregate();
+        }
+    });
+
+    struct itimerval timer;
+    timer.it_interval.tv_sec = 0;
+    timer.it_interval.tv_usec = 1000000 / frequency;
+    timer.it_value = timer.it_interval;
+    if (setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+        auto st = Status::InternalError(strings::Substitute("failed to set profiling timer: $0", strerror(errno)));
+        _stopped = true;
+        _aggregate_thread->join();
+        _aggregate_thread.reset();
+        sigaction(SIGPROF, &_old_action, nullptr);
+        return st;
+    }
+    _running = true;
+    LOG(INFO) << "query cpu profiler started, frequency=" << frequency;
+    return Status::OK();
+}
+
+bool QueryCpuProfiler::stop() {
+    std::lock_guard<std::mutex> l(_state_lock);
+    if (!_running) {
+        return false;
+    }
+    struct itimerval timer;
+    memset(&timer, 0, sizeof(timer));
+    setitimer(ITIMER_PROF, &timer, nullptr);
+    // A signal already raised may still be pending, ignore it instead of restoring the default action,
+    // which terminates the process.
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = SIG_IGN;
+    sigaction(SIGPROF, &action, nullptr);
+
+    _stopped = true;
+    _aggregate_thread->join();
+    _aggregate_thread.reset();
+    aggregate();
+    _running = false;
+    LOG(INFO) << "query cpu profiler stopped";
+    return true;
+}
+
+void QueryCpuProfiler::_signal_handler(int signo, siginfo_t* info, void* context) {
+    int saved_errno = errno;
+    instance()->_record(context);
+    errno = saved_errno;
+}
+
+void QueryCpuProfiler::_record(void* context) {
+    const uint64_t pos = _next.fetch_add(1, std::memory_order_relaxed);
+    Sample& sample = _samples[pos % kBufferSize];
+    sample.seq.store(pos * 2 + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    CurrentThread::query_id_signal_safe(&sample.query_id_hi, &sample.query_id_lo);
+    // Skip the frames of the signal handler and this function.
+    sample.depth = GetStackTraceWithContext(sample.pcs, kMaxDepth, 2, context);
+    sample.seq.store(pos * 2 + 2, std::memory_order_release);
+}
+
+void QueryCpuProfiler::aggregate() {
+    std::lock_guard<std::mutex> l(_lock);
+    const uint64_t end = _next.load(std::memory_order_acquire);
+    if (end - _aggregated > kBufferSize) {
+        _num_dropped += end - _aggregated - kBufferSize;
+        _aggregated = end - kBufferSize;
+    }
+    ++_round;
+    for (; _aggregated < end; ++_aggregated) {
+        const Sample& sample = _samples[_aggregated % kBufferSize];
+        const uint64_t seq = sample.seq.load(std::memory_order_acquire);
+        if (seq < _aggregated * 2 + 2) {
+            // Still being written, aggregate it next time.
+            break;
+        }
+        if (seq > _aggregated * 2 + 2) {
+            // Already overwritten by a later sample.
+            ++_num_dropped;
+            continue;
+        }
+        QueryKey key(sample.query_id_hi, sample.query_id_lo);
+        Stack stack(sample.pcs, sample.pcs + std::max(sample.depth, 0));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sample.seq.load(std::memory_order_relaxed) != _aggregated * 2 + 2) {
+            ++_num_dropped;
+            continue;
+        }
+        auto& query = _queries[key];
+        ++query.num_samples;
+        query.last_round = _round;
+        ++query.stacks[std::move(stack)];
+    }
+    _evict();
+}
+
+void QueryCpuProfiler::_evict() {
+    const size_t max_queries = std::max(config::query_cpu_profiler_max_queries, 1);
+    while (_queries.size() > max_queries) {
+        auto victim = _queries.begin();
+        for (auto it = _queries.begin(); it != _queries.end(); ++it) {
+            if (it->second.last_round < victim->second.last_round) {
+                victim = it;
+            }
+        }
+        _queries.erase(victim);
+    }
+}
+
+std::vector<std::pair<TUniqueId, int64_t>> QueryCpuProfiler::queries() {
+    aggregate();
+    std::vector<std::tuple<int64_t, TUniqueId, int64_t>> rounds;
+    {
+        std::lock_guard<std::mutex> l(_lock);
+        for (const auto& [key, query] : _queries) {
+            TUniqueId query_id;
+            query_id.__set_hi(key.first);
+            query_id.__set_lo(key.second);
+            rounds.emplace_back(query.last_round, query_id, query.num_samples);
+        }
+    }
+    std::stable_sort(rounds.begin(), rounds.end(),
+                     [](const auto& lhs, const auto& rhs) { return std::get<0>(lhs) > std::get<0>(rhs); });
+    std::vector<std::pair<TUniqueId, int64_t>> result;
+    result.reserve(rounds.size());
+    for (const auto& [round, query_id, num_samples] : rounds) {
+        result.emplace_back(query_id, num_samples);
+    }
+    return result;
+}
+
+bool QueryCpuProfiler::get_stacks(const TUniqueId& query_id, Stacks* stacks) {
+    aggregate();
+    std::lock_guard<std::mutex> l(_lock);
+    auto it = _queries.find(QueryKey(query_id.hi, query_id.lo));
+    if (it == _queries.end()) {
+        return false;
+    }
+    *stacks = it->second.stacks;
+    return true;
+}
+
+} // namespace starrocks
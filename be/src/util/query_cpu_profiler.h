@@ -0,0 +1,105 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <atomic>
+#include <csignal>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "common/status.h"
+#include "gen_cpp/Types_types.h"
+
+namespace starrocks {
+
+// A sampling CPU profiler cheap enough to run continuously, which attributes every sample to the query
+// the sampled thread is working for, as set by CurrentThread::set_query_id().
+//
+// SIGPROF is raised `frequency` times per second of the CPU time of the process, and delivered to the
+// thread consuming the CPU. The signal handler records the query id and the stack of the interrupted
+// thread into a lock-free ring buffer, and a background thread aggregates the stacks per query. The
+// samples of the threads not working for any query are attributed to the query id 0-0.
+//
+// It conflicts with the CPU profiler of gperftools, which also uses SIGPROF, so it must be stopped
+// while /pprof/profile is running.
+class QueryCpuProfiler {
+public:
+    using Stack = std::vector<void*>;
+    // The number of samples of every stack.
+    using Stacks = std::map<Stack, int64_t>;
+
+    static constexpr int kMaxDepth = 48;
+
+    static QueryCpuProfiler* instance();
+
+    ~QueryCpuProfiler();
+
+    Status start(int frequency);
+
+    // Return true if it was running.
+    bool stop();
+
+    bool is_running() const { return _running; }
+
+    // The queries sampled and their number of samples, the most recently sampled first.
+    std::vector<std::pair<TUniqueId, int64_t>> queries();
+
+    // Return false if the query isn't sampled or its stacks have been evicted.
+    bool get_stacks(const TUniqueId& query_id, Stacks* stacks);
+
+    // The samples lost because the ring buffer was overwritten before being aggregated.
+    int64_t num_dropped_samples() const { return _num_dropped; }
+
+    // Aggregate the samples in the ring buffer, called by the background thread periodically.
+    void aggregate();
+
+private:
+    using QueryKey = std::pair<int64_t, int64_t>;
+
+    struct Sample {
+        // A seqlock: `seq` is odd while the sample is being written.
+        std::atomic<uint64_t> seq{0};
+        int64_t query_id_hi;
+        int64_t query_id_lo;
+        int depth;
+        void* pcs[kMaxDepth];
+    };
+
+    struct QueryStacks {
+        int64_t num_samples = 0;
+        // The aggregation round the query was sampled last time, used to evict the least recent ones.
+        int64_t last_round = 0;
+        Stacks stacks;
+    };
+
+    static constexpr size_t kBufferSize = 8192;
+
+    QueryCpuProfiler() = default;
+
+    static void _signal_handler(int signo, siginfo_t* info, void* context);
+    void _record(void* context);
+    void _evict();
+
+    std::unique_ptr<Sample[]> _samples{new Sample[kBufferSize]};
+    std::atomic<uint64_t> _next{0};
+    uint64_t _aggregated = 0;
+    std::atomic<int64_t> _num_dropped{0};
+
+    // Serialize start() and stop().
+    std::mutex _state_lock;
+    std::atomic<bool> _running{false};
+    std::atomic<bool> _stopped{false};
+    std::unique_ptr<std::thread> _aggregate_thread;
+    struct sigaction _old_action;
+
+    // Protect `_queries` and `_round`, and serialize the aggregations.
+    std::mutex _lock;
+    std::map<QueryKey, QueryStacks> _queries;
+    int64_t _round = 0;
+};
+
+} // namespace starrocks
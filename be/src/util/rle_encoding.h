@@ -20,6 +20,7 @@
 // under the License.
 #pragma once
 
+#include <algorithm>
 #include <glog/logging.h>
 
 #include "gutil/port.h"
@@ -678,6 +679,13 @@ public:
     // Returns the number of consumed values or 0 if an error occurred.
     int32_t GetBatch(T* values, int32_t batch_num);
 
+    // Consume 'batch_num' values, which are indexes of the 'dict_len' entries of 'dict', and
+    // copy the dict entries they refer to to 'values'. A repeated run is filled with a single
+    // entry without materializing its indexes. Returns the number of consumed values, which is
+    // less than 'batch_num' if an error occurred or an index is out of the dict.
+    template <typename V>
+    int32_t GetBatchWithDict(const V* dict, int32_t dict_len, V* values, int32_t batch_num);
+
 private:
     // Called when both 'literal_count_' and 'repeat_count_' have been exhausted.
     // Sets either 'literal_count_' or 'repeat_count_' to the size of the next literal
@@ -863,4 +871,51 @@ inline int32_t RleBatchDecoder<T>::GetBatch(T* values, int32_t batch_num) {
     return num_consumed;
 }
 
+template <typename T>
+template <typename V>
+inline int32_t RleBatchDecoder<T>::GetBatchWithDict(const V* dict, int32_t dict_len, V* values, int32_t batch_num) {
+    // indexes of the literal runs are unpacked in batches into this buffer, whose size is
+    // a multiple of 32 so that the bit-packed values are unpacked without 'literal_buffer_'.
+    constexpr int32_t kIndexBatchSize = 1024;
+    T indexes[kIndexBatchSize];
+    int32_t num_consumed = 0;
+    while (num_consumed < batch_num) {
+        int32_t num_repeats = NextNumRepeats();
+        if (num_repeats > 0) {
+            int32_t num_repeats_to_set = std::min(num_repeats, batch_num - num_consumed);
+            T index = GetRepeatedValue(num_repeats_to_set);
+            if (UNLIKELY(index >= static_cast<T>(dict_len))) {
+                return num_consumed;
+            }
+            std::fill(values + num_consumed, values + num_consumed + num_repeats_to_set, dict[index]);
+            num_consumed += num_repeats_to_set;
+            continue;
+        }
+
+        int32_t num_literals = NextNumLiterals();
+        if (num_literals == 0) {
+            break;
+        }
+        int32_t num_literals_to_set = std::min({num_literals, batch_num - num_consumed, kIndexBatchSize});
+        if (!GetLiteralValues(num_literals_to_set, indexes)) {
+            return num_consumed;
+        }
+        // check the bound of all the indexes first to keep the look up loop branch free,
+        // so that it could be vectorized to gather instructions.
+        T max_index = 0;
+        for (int32_t i = 0; i < num_literals_to_set; ++i) {
+            max_index = std::max(max_index, indexes[i]);
+        }
+        if (UNLIKELY(max_index >= static_cast<T>(dict_len))) {
+            return num_consumed;
+        }
+        V* dst = values + num_consumed;
+        for (int32_t i = 0; i < num_literals_to_set; ++i) {
+            dst[i] = dict[indexes[i]];
+        }
+        num_consumed += num_literals_to_set;
+    }
+    return num_consumed;
+}
+
 } // namespace starrocks
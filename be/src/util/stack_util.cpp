@@ -21,6 +21,12 @@
 
 #include "util/stack_util.h"
 
+#include <cstdio>
+
+namespace google {
+bool Symbolize(void* pc, char* out, int out_size);
+} // namespace google
+
 namespace google::glog_internal_namespace_ {
 void DumpStackTraceToString(std::string* stacktrace);
 } // namespace google::glog_internal_namespace_
@@ -33,4 +39,13 @@ std::string get_stack_trace() {
     return s;
 }
 
+std::string symbolize(void* pc) {
+    char buf[1024];
+    if (google::Symbolize(pc, buf, sizeof(buf))) {
+        return buf;
+    }
+    snprintf(buf, sizeof(buf), "%p", pc);
+    return buf;
+}
+
 } // namespace starrocks
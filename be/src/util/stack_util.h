@@ -30,4 +30,7 @@ namespace starrocks {
 // for recursive calls.
 std::string get_stack_trace();
 
+// The demangled name of the function containing `pc`, or `pc` in hex if it can't be resolved.
+std::string symbolize(void* pc);
+
 } // namespace starrocks
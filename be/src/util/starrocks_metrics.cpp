@@ -43,10 +43,18 @@ StarRocksMetrics::StarRocksMetrics() : _metrics(_s_registry_name) {
     REGISTER_STARROCKS_METRIC(http_request_send_bytes);
     REGISTER_STARROCKS_METRIC(query_scan_bytes);
     REGISTER_STARROCKS_METRIC(query_scan_rows);
+    REGISTER_STARROCKS_METRIC(query_scan_pages);
+    REGISTER_STARROCKS_METRIC(query_scan_cached_pages);
+    REGISTER_STARROCKS_METRIC(query_scan_io_time_us);
+    REGISTER_STARROCKS_METRIC(query_scan_decompress_time_us);
 
     REGISTER_STARROCKS_METRIC(memtable_flush_total);
     REGISTER_STARROCKS_METRIC(memtable_flush_duration_us);
 
+    REGISTER_STARROCKS_METRIC(fragment_request_latency_us);
+    REGISTER_STARROCKS_METRIC(transmit_chunk_latency_us);
+    REGISTER_STARROCKS_METRIC(memtable_flush_latency_us);
+
     REGISTER_STARROCKS_METRIC(update_rowset_commit_request_total);
     REGISTER_STARROCKS_METRIC(update_rowset_commit_request_failed);
     REGISTER_STARROCKS_METRIC(update_rowset_commit_apply_total);
@@ -59,6 +67,13 @@ StarRocksMetrics::StarRocksMetrics() : _metrics(_s_registry_name) {
     REGISTER_STARROCKS_METRIC(update_del_vector_deletes_total);
     REGISTER_STARROCKS_METRIC(update_del_vector_deletes_new);
 
+    REGISTER_STARROCKS_METRIC(hdfs_block_cache_hit_total);
+    REGISTER_STARROCKS_METRIC(hdfs_block_cache_miss_total);
+    REGISTER_STARROCKS_METRIC(hdfs_block_cache_hit_bytes);
+    REGISTER_STARROCKS_METRIC(hdfs_block_cache_write_total);
+    REGISTER_STARROCKS_METRIC(hdfs_block_cache_checksum_failed_total);
+    REGISTER_STARROCKS_METRIC(hdfs_block_cache_usage_bytes);
+
     // push request
     _metrics.register_metric("push_requests_total", MetricLabels().add("status", "SUCCESS"),
                              &push_requests_success_total);
@@ -64,6 +64,11 @@ public:
     METRIC_DEFINE_INT_COUNTER(http_request_send_bytes, MetricUnit::BYTES);
     METRIC_DEFINE_INT_COUNTER(query_scan_bytes, MetricUnit::BYTES);
     METRIC_DEFINE_INT_COUNTER(query_scan_rows, MetricUnit::ROWS);
+    METRIC_DEFINE_INT_COUNTER(query_scan_pages, MetricUnit::NOUNIT);
+    // the pages of query scans hit in page cache.
+    METRIC_DEFINE_INT_COUNTER(query_scan_cached_pages, MetricUnit::NOUNIT);
+    METRIC_DEFINE_INT_COUNTER(query_scan_io_time_us, MetricUnit::MICROSECONDS);
+    METRIC_DEFINE_INT_COUNTER(query_scan_decompress_time_us, MetricUnit::MICROSECONDS);
     METRIC_DEFINE_INT_COUNTER(push_requests_success_total, MetricUnit::REQUESTS);
     METRIC_DEFINE_INT_COUNTER(push_requests_fail_total, MetricUnit::REQUESTS);
     METRIC_DEFINE_INT_COUNTER(push_request_duration_us, MetricUnit::MICROSECONDS);
@@ -155,6 +160,14 @@ public:
     METRIC_DEFINE_UINT_COUNTER(update_del_vector_deletes_total, MetricUnit::NOUNIT);
     METRIC_DEFINE_UINT_COUNTER(update_del_vector_deletes_new, MetricUnit::NOUNIT);
 
+    // Metrics of the block cache of the remote files
+    METRIC_DEFINE_INT_COUNTER(hdfs_block_cache_hit_total, MetricUnit::OPERATIONS);
+    METRIC_DEFINE_INT_COUNTER(hdfs_block_cache_miss_total, MetricUnit::OPERATIONS);
+    METRIC_DEFINE_INT_COUNTER(hdfs_block_cache_hit_bytes, MetricUnit::BYTES);
+    METRIC_DEFINE_INT_COUNTER(hdfs_block_cache_write_total, MetricUnit::OPERATIONS);
+    METRIC_DEFINE_INT_COUNTER(hdfs_block_cache_checksum_failed_total, MetricUnit::OPERATIONS);
+    METRIC_DEFINE_UINT_GAUGE(hdfs_block_cache_usage_bytes, MetricUnit::BYTES);
+
     // Gauges
     METRIC_DEFINE_INT_GAUGE(memory_pool_bytes_total, MetricUnit::BYTES);
     METRIC_DEFINE_INT_GAUGE(process_thread_num, MetricUnit::NOUNIT);
@@ -185,6 +198,12 @@ public:
     METRIC_DEFINE_TCMALLOC_GAUGE(tcmalloc_pageheap_unmapped_bytes, "tcmalloc.pageheap_unmapped_bytes");
     METRIC_DEFINE_TCMALLOC_GAUGE(tcmalloc_bytes_in_use, "generic.current_allocated_bytes");
 
+    // Histograms of the latencies, whose tails are hidden by the total durations above.
+    METRIC_DEFINE_INT_HISTOGRAM(fragment_request_latency_us, MetricUnit::MICROSECONDS);
+    // the time the receiver takes to handle a transmit_chunk rpc.
+    METRIC_DEFINE_INT_HISTOGRAM(transmit_chunk_latency_us, MetricUnit::MICROSECONDS);
+    METRIC_DEFINE_INT_HISTOGRAM(memtable_flush_latency_us, MetricUnit::MICROSECONDS);
+
     // Metrics related with BlockManager
     METRIC_DEFINE_INT_COUNTER(readable_blocks_total, MetricUnit::BLOCKS);
     METRIC_DEFINE_INT_COUNTER(writable_blocks_total, MetricUnit::BLOCKS);
@@ -189,6 +189,24 @@ private:
     template <typename T>
     static inline T string_to_int_no_overflow(const char* s, int len, ParseResult* result);
 
+    // Return true if all the 8 bytes of the little endian |eight| are '0'~'9'.
+    static inline bool is_eight_digits(uint64_t eight) {
+        return ((eight & 0xF0F0F0F0F0F0F0F0) | (((eight + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) ==
+               0x3333333333333333;
+    }
+
+    // Convert the 8 digits in the little endian |eight| to an integer, by multiplying and adding the
+    // adjacent 1, 2 and 4 digits in parallel.
+    static inline uint32_t parse_eight_digits(uint64_t eight) {
+        const uint64_t mask = 0x000000FF000000FF;
+        const uint64_t mul1 = 0x000F424000000064; // 100 + (1000000ULL << 32)
+        const uint64_t mul2 = 0x0000271000000001; // 1 + (10000ULL << 32)
+        eight -= 0x3030303030303030;
+        eight = (eight * 10) + (eight >> 8);
+        eight = (((eight & mask) * mul1) + (((eight >> 16) & mask) * mul2)) >> 32;
+        return static_cast<uint32_t>(eight);
+    }
+
     // This is considerably faster than glibc's implementation (>100x why???)
     // No special case handling needs to be done for overflows, the floating point spec
     // already does it and will cap the values to -inf/inf
@@ -399,14 +417,33 @@ inline T StringParser::string_to_int_no_overflow(const char* s, int len, ParseRe
         *result = PARSE_SUCCESS;
         return val;
     }
+    int i = 0;
+    if constexpr (sizeof(T) >= sizeof(uint32_t)) {
+        // Parse 8 digits at a time while they are all digits.
+        for (; i + 8 <= len; i += 8) {
+            uint64_t eight;
+            memcpy(&eight, s + i, sizeof(eight));
+            if (!is_eight_digits(eight)) {
+                break;
+            }
+            val = val * 100000000 + parse_eight_digits(eight);
+        }
+        if (i == len) {
+            *result = PARSE_SUCCESS;
+            return val;
+        }
+    }
     // Factor out the first char for error handling speeds up the loop.
-    if (LIKELY(s[0] >= '0' && s[0] <= '9')) {
-        val = s[0] - '0';
-    } else {
-        *result = PARSE_FAILURE;
-        return 0;
+    if (i == 0) {
+        if (LIKELY(s[0] >= '0' && s[0] <= '9')) {
+            val = s[0] - '0';
+        } else {
+            *result = PARSE_FAILURE;
+            return 0;
+        }
+        i = 1;
     }
-    for (int i = 1; i < len; ++i) {
+    for (; i < len; ++i) {
         if (LIKELY(s[i] >= '0' && s[i] <= '9')) {
             T digit = s[i] - '0';
             val = val * 10 + digit;
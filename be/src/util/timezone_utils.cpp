@@ -22,6 +22,9 @@
 
 #include "util/timezone_utils.h"
 
+#include <algorithm>
+#include <limits>
+
 namespace starrocks {
 
 RE2 TimezoneUtils::time_zone_offset_format_reg(R"(^[+-]{1}\d{2}\:\d{2}$)");
@@ -64,4 +67,85 @@ int64_t TimezoneUtils::to_utc_offset(const cctz::time_zone& ctz) {
     return a.cs - b.cs;
 }
 
+static const cctz::civil_second kCivilEpoch(1970, 1, 1, 0, 0, 0);
+static const cctz::time_point<cctz::sys_seconds> kUtcEpoch =
+        std::chrono::time_point_cast<cctz::sys_seconds>(std::chrono::system_clock::from_time_t(0));
+
+static inline cctz::time_point<cctz::sys_seconds> to_time_point(int64_t utc_second) {
+    return kUtcEpoch + cctz::seconds(utc_second);
+}
+
+static inline int64_t to_utc_second(const cctz::time_point<cctz::sys_seconds>& tp) {
+    return (tp - kUtcEpoch).count();
+}
+
+void TimezoneOffsetCache::_find_utc_interval(int64_t utc_second, int64_t* begin, int64_t* end,
+                                             int64_t* offset) const {
+    const auto tp = to_time_point(utc_second);
+    *offset = _ctz.lookup(tp).offset;
+    *begin = std::numeric_limits<int64_t>::min();
+    *end = std::numeric_limits<int64_t>::max();
+
+    // the transition happens when the civil time in current offset reaches |from|, and the civil time
+    // since the previous transition starts from |to|.
+    cctz::time_zone::civil_transition trans;
+    if (_ctz.next_transition(tp, &trans)) {
+        *end = (trans.from - kCivilEpoch) - *offset;
+    }
+    // the transition exactly at |tp| starts the interval.
+    if (_ctz.prev_transition(tp + cctz::seconds(1), &trans)) {
+        *begin = (trans.to - kCivilEpoch) - *offset;
+    }
+
+    // the transitions reported by cctz should bound |utc_second|, fall back to a single second otherwise.
+    if (utc_second < *begin || utc_second >= *end ||
+        (*begin != std::numeric_limits<int64_t>::min() && _ctz.lookup(to_time_point(*begin)).offset != *offset) ||
+        (*end != std::numeric_limits<int64_t>::max() && _ctz.lookup(to_time_point(*end - 1)).offset != *offset)) {
+        *begin = utc_second;
+        *end = utc_second + 1;
+    }
+}
+
+void TimezoneOffsetCache::_update_utc_interval(int64_t utc_second) {
+    _find_utc_interval(utc_second, &_utc_begin, &_utc_end, &_utc_offset);
+}
+
+bool TimezoneOffsetCache::_update_local_interval(int64_t local_second) {
+    const auto lookup = _ctz.lookup(kCivilEpoch + local_second);
+    if (lookup.kind != cctz::time_zone::civil_lookup::UNIQUE) {
+        return false;
+    }
+
+    int64_t begin;
+    int64_t end;
+    int64_t offset;
+    _find_utc_interval(to_utc_second(lookup.pre), &begin, &end, &offset);
+    if (begin == std::numeric_limits<int64_t>::min() && end == std::numeric_limits<int64_t>::max()) {
+        _local_begin = begin;
+        _local_end = end;
+        _local_offset = offset;
+        return true;
+    }
+
+    // the local seconds right after a transition may be repeated by the larger offset before it,
+    // so the cached interval starts from the larger one of the two offsets.
+    int64_t local_begin = std::numeric_limits<int64_t>::min();
+    if (begin != std::numeric_limits<int64_t>::min()) {
+        int64_t prev_offset = _ctz.lookup(to_time_point(begin - 1)).offset;
+        local_begin = begin + std::max(offset, prev_offset);
+    }
+    int64_t local_end = end == std::numeric_limits<int64_t>::max() ? end : end + offset;
+    if (local_second < local_begin || local_second >= local_end) {
+        return false;
+    }
+    _local_begin = local_begin;
+    _local_end = local_end;
+    _local_offset = offset;
+    return true;
+}
+
+int64_t TimezoneOffsetCache::_convert_local(int64_t local_second) const {
+    return to_utc_second(cctz::convert(kCivilEpoch + local_second, _ctz));
+}
+
 } // namespace starrocks
@@ -40,4 +40,50 @@ private:
     // RE2 obj is thread safe
     static RE2 time_zone_offset_format_reg;
 };
+
+// Convert the seconds between utc and the local time of a time zone, the offset of the interval between two
+// transitions is memoized, so converting the sorted or near sorted seconds is mostly a single addition.
+// The seconds of local time are counted from 1970-01-01 00:00:00 as if it were utc, like
+// TimestampValue::to_unix_second.
+//
+// Not thread safe, one instance per thread.
+class TimezoneOffsetCache {
+public:
+    explicit TimezoneOffsetCache(const cctz::time_zone& ctz) : _ctz(ctz) {}
+
+    int64_t utc_to_local(int64_t utc_second) {
+        if (utc_second < _utc_begin || utc_second >= _utc_end) {
+            _update_utc_interval(utc_second);
+        }
+        return utc_second + _utc_offset;
+    }
+
+    // same as cctz::convert, a skipped or repeated local time is converted by the offset before the transition.
+    int64_t local_to_utc(int64_t local_second) {
+        if (local_second < _local_begin || local_second >= _local_end) {
+            if (!_update_local_interval(local_second)) {
+                return _convert_local(local_second);
+            }
+        }
+        return local_second - _local_offset;
+    }
+
+private:
+    // find the interval [begin, end) of utc seconds around |utc_second| in which the offset doesn't change.
+    void _find_utc_interval(int64_t utc_second, int64_t* begin, int64_t* end, int64_t* offset) const;
+    void _update_utc_interval(int64_t utc_second);
+    bool _update_local_interval(int64_t local_second);
+    int64_t _convert_local(int64_t local_second) const;
+
+    cctz::time_zone _ctz;
+
+    int64_t _utc_begin = 0;
+    int64_t _utc_end = 0;
+    int64_t _utc_offset = 0;
+
+    // only the local seconds which are neither skipped nor repeated are cached.
+    int64_t _local_begin = 0;
+    int64_t _local_end = 0;
+    int64_t _local_offset = 0;
+};
 } // namespace starrocks
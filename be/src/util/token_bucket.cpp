@@ -0,0 +1,63 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/token_bucket.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#include "util/time.h"
+
+namespace starrocks {
+
+TokenBucket::TokenBucket(int64_t rate) : _rate(rate), _tokens(std::max<int64_t>(0, rate)) {
+    _last_refill_us = MonotonicMicros();
+}
+
+void TokenBucket::set_rate(int64_t rate) {
+    std::lock_guard l(_mutex);
+    if (rate == _rate) {
+        return;
+    }
+    _refill_unlocked(MonotonicMicros());
+    _rate = rate;
+    // the debt taken under the old rate is paid back at the new rate
+    _tokens = std::min<double>(_tokens, std::max<int64_t>(0, rate));
+}
+
+int64_t TokenBucket::rate() const {
+    std::lock_guard l(_mutex);
+    return _rate;
+}
+
+void TokenBucket::acquire(int64_t tokens) {
+    int64_t wait_us = take(tokens);
+    if (wait_us > 0) {
+        std::this_thread::sleep_for(std::chrono::microseconds(wait_us));
+    }
+}
+
+int64_t TokenBucket::take(int64_t tokens) {
+    if (tokens <= 0) {
+        return 0;
+    }
+    std::lock_guard l(_mutex);
+    if (_rate <= 0) {
+        return 0;
+    }
+    _refill_unlocked(MonotonicMicros());
+    _tokens -= tokens;
+    if (_tokens >= 0) {
+        return 0;
+    }
+    return static_cast<int64_t>(-_tokens * 1000000 / _rate);
+}
+
+void TokenBucket::_refill_unlocked(int64_t now_us) {
+    if (_rate > 0 && now_us > _last_refill_us) {
+        _tokens = std::min<double>(_rate, _tokens + static_cast<double>(now_us - _last_refill_us) * _rate / 1000000);
+    }
+    _last_refill_us = now_us;
+}
+
+} // namespace starrocks
@@ -0,0 +1,38 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+
+namespace starrocks {
+
+// TokenBucket limits the consumption of a resource, e.g. the bytes of disk I/O, to |rate| tokens per
+// second, with bursts of at most one second of tokens. acquire() takes the tokens at once and puts the
+// caller to sleep until the bucket is refilled, so a caller taking more than the burst still goes through
+// after a wait proportional to the tokens taken, and the concurrent callers share the rate.
+// The rate can be changed at any time, a rate <= 0 means no limit.
+class TokenBucket {
+public:
+    explicit TokenBucket(int64_t rate);
+
+    void set_rate(int64_t rate);
+    int64_t rate() const;
+
+    // Take |tokens| tokens, blocking until they are available.
+    void acquire(int64_t tokens);
+
+    // Take |tokens| tokens and return the microseconds the caller should wait before using them.
+    int64_t take(int64_t tokens);
+
+private:
+    void _refill_unlocked(int64_t now_us);
+
+    mutable std::mutex _mutex;
+    int64_t _rate;
+    // available tokens, negative if the callers are in debt
+    double _tokens;
+    int64_t _last_refill_us;
+};
+
+} // namespace starrocks
@@ -38,6 +38,7 @@ class MockMasterServerClient : public MasterServerClient {
 public:
     MockMasterServerClient(const TMasterInfo& master_info, FrontendServiceClientCache* client_cache);
     MOCK_METHOD2(finish_task, AgentStatus(const TFinishTaskRequest request, TMasterResult* result));
+    MOCK_METHOD2(finish_tasks, AgentStatus(const TFinishTasksRequest request, TFinishTasksResult* result));
     MOCK_METHOD2(report, AgentStatus(const TReportRequest request, TMasterResult* result));
 }; // class AgentServerClient
 
@@ -23,8 +23,11 @@
 
 #include <gtest/gtest.h>
 
+#include "column/binary_column.h"
+#include "column/const_column.h"
 #include "column/field.h"
 #include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
 
 namespace starrocks::vectorized {
 
@@ -173,6 +176,59 @@ TEST_F(ChunkTest, test_serde) {
     }
 }
 
+// NOLINTNEXTLINE
+TEST_F(ChunkTest, test_serde_encoded) {
+    auto ints = Int32Column::create();
+    auto strings = BinaryColumn::create();
+    auto nulls = NullColumn::create();
+    auto doubles = DoubleColumn::create();
+    auto distinct_strings = BinaryColumn::create();
+    for (int i = 0; i < 100; i++) {
+        ints->append(1000 + i);
+        strings->append(Slice(make_string(i % 3)));
+        nulls->append(i % 5 == 0);
+        doubles->append(i * 0.5);
+        distinct_strings->append(Slice(make_string(i)));
+    }
+    auto bigints = Int64Column::create();
+    bigints->append(7);
+    Columns columns{ints, NullableColumn::create(strings, nulls), ConstColumn::create(bigints, 100), doubles,
+                    distinct_strings};
+    auto chunk = std::make_unique<Chunk>(columns, make_schema(columns.size()));
+
+    std::string buffer;
+    buffer.resize(chunk->max_encoded_size());
+    buffer.resize(chunk->serialize_encoded((uint8_t*)buffer.data()));
+    ASSERT_LT(buffer.size(), chunk->serialize_size());
+
+    RuntimeChunkMeta meta;
+    meta.slot_id_to_index.init(columns.size());
+    for (size_t i = 0; i < columns.size(); i++) {
+        meta.slot_id_to_index.insert(i, i);
+    }
+    meta.is_nulls = {false, true, false, false, false};
+    meta.is_consts = {false, false, true, false, false};
+    meta.types = {TypeDescriptor(TYPE_INT), TypeDescriptor::create_varchar_type(10), TypeDescriptor(TYPE_BIGINT),
+                  TypeDescriptor(TYPE_DOUBLE), TypeDescriptor::create_varchar_type(10)};
+
+    Chunk new_chunk;
+    ASSERT_TRUE(new_chunk.deserialize((uint8_t*)buffer.data(), buffer.size(), meta).ok());
+    ASSERT_EQ(chunk->num_rows(), new_chunk.num_rows());
+    for (size_t i = 0; i < columns.size(); ++i) {
+        ASSERT_EQ(columns[i]->size(), new_chunk.columns()[i]->size());
+        for (size_t j = 0; j < columns[i]->size(); ++j) {
+            ASSERT_EQ(columns[i]->debug_item(j), new_chunk.columns()[i]->debug_item(j));
+        }
+    }
+    ASSERT_TRUE(new_chunk.columns()[1]->is_null(0));
+    ASSERT_FALSE(new_chunk.columns()[1]->is_null(1));
+    ASSERT_TRUE(new_chunk.columns()[2]->is_constant());
+
+    // corrupted data is rejected, the encoding of the first column follows the version and the number of rows.
+    buffer[2 * sizeof(uint32_t)] = 0xff;
+    ASSERT_FALSE(new_chunk.deserialize((uint8_t*)buffer.data(), buffer.size(), meta).ok());
+}
+
 // NOLINTNEXTLINE
 TEST_F(ChunkTest, test_copy_one_row) {
     auto chunk = std::make_unique<Chunk>(make_columns(2), make_schema(2));
@@ -78,4 +78,30 @@ TEST_F(ColumnPoolTest, single_thread) {
     delete c4;
 }
 
+// NOLINTNEXTLINE
+TEST_F(ColumnPoolTest, release_large_free_columns) {
+    constexpr size_t kNumColumns = ColumnPoolBlockSize<BinaryColumn>::value + 1;
+    std::vector<BinaryColumn*> columns;
+    for (size_t i = 0; i < kNumColumns; i++) {
+        auto c = get_column<BinaryColumn>();
+        c->get_bytes().reserve(i % 2 == 0 ? 8192 : 16);
+        columns.push_back(c);
+    }
+    // The first full block is pushed to the central free list by the last return.
+    for (auto c : columns) {
+        return_column<BinaryColumn>(c);
+    }
+    auto before = describe_column_pool<BinaryColumn>();
+    ASSERT_EQ(ColumnPoolBlockSize<BinaryColumn>::value, before.central_free_items);
+
+    size_t freed = release_large_free_columns<BinaryColumn>(8192);
+    ASSERT_GE(freed, ColumnPoolBlockSize<BinaryColumn>::value / 2 * 8192);
+
+    auto after = describe_column_pool<BinaryColumn>();
+    ASSERT_EQ(before.central_free_items, after.central_free_items);
+    ASSERT_EQ(before.central_free_bytes - freed, after.central_free_bytes);
+
+    ASSERT_EQ(0u, release_large_free_columns<BinaryColumn>(8192));
+}
+
 } // namespace starrocks::vectorized
@@ -40,6 +40,31 @@ protected:
         return std::shared_ptr<SequentialFile>(new StringSequentialFile(std::move(compressed_data)));
     }
 
+    static std::string compress(CompressionTypePB type, const Slice& content) {
+        const BlockCompressionCodec* codec = nullptr;
+        CHECK(get_block_compression_codec(type, &codec).ok());
+        std::string compressed_data(codec->max_compressed_len(content.size), '\0');
+        Slice buff(compressed_data);
+        CHECK(codec->compress(content, &buff).ok());
+        compressed_data.resize(buff.size);
+        return compressed_data;
+    }
+
+    static std::string read_all(SequentialFile* f, size_t read_buff_len) {
+        std::string data;
+        std::string own_buff(read_buff_len, '\0');
+        while (true) {
+            Slice buff(own_buff);
+            Status st = f->read(&buff);
+            CHECK(st.ok()) << st.to_string();
+            if (buff.size == 0) {
+                break;
+            }
+            data.append(buff.data, buff.size);
+        }
+        return data;
+    }
+
     std::shared_ptr<Decompressor> LZ4F_decompressor() {
         Decompressor* dec = nullptr;
         CHECK(Decompressor::create_decompressor(CompressionTypePB::LZ4_FRAME, &dec).ok());
@@ -88,4 +113,28 @@ TEST_F(CompressedSequentialFileTest, test_LZ4F) {
     }
 }
 
+// NOLINTNEXTLINE
+TEST_F(CompressedSequentialFileTest, test_parallel) {
+    const size_t K1 = 1024;
+    const std::string data = random_string(3 * K1 * K1 + 17);
+
+    for (auto type : {CompressionTypePB::LZ4_FRAME, CompressionTypePB::ZSTD}) {
+        // every 100KB in a frame of its own.
+        std::string compressed;
+        for (size_t offset = 0; offset < data.size(); offset += 100 * K1) {
+            compressed += compress(type, Slice(data.data() + offset, std::min(100 * K1, data.size() - offset)));
+        }
+        for (int parallelism : {1, 4}) {
+            ParallelCompressedSequentialFile f(std::make_shared<StringSequentialFile>(compressed), type, parallelism,
+                                               64 * K1);
+            ASSERT_EQ(data, read_all(&f, 10000));
+        }
+
+        // the frame too large to be buffered is decompressed sequentially.
+        ParallelCompressedSequentialFile f(std::make_shared<StringSequentialFile>(compress(type, data)), type, 4,
+                                           64 * K1);
+        ASSERT_EQ(data, read_all(&f, 10000));
+    }
+}
+
 } // namespace starrocks
@@ -8,6 +8,7 @@
 #include <map>
 #include <memory>
 
+#include "common/config.h"
 #include "env/env_memory.h"
 #include "gen_cpp/FileBrokerService_types.h"
 #include "gen_cpp/TFileBrokerService.h"
@@ -371,6 +372,38 @@ TEST_F(EnvBrokerTest, test_sequential_read) {
     ASSERT_EQ("", read(f, 1));
 }
 
+// NOLINTNEXTLINE
+TEST_F(EnvBrokerTest, test_sequential_read_ahead) {
+    const std::string path = "/tmp/1.txt";
+    const std::string content = "abcdefghijklmnopqrstuvwxyz0123456789";
+    ASSERT_OK(_env_mem->create_file(path));
+    ASSERT_OK(_env_mem->append_file(path, content));
+
+    const int32_t old_blocks = config::broker_read_ahead_blocks;
+    const int64_t old_block_bytes = config::broker_read_ahead_block_bytes;
+    config::broker_read_ahead_blocks = 3;
+    config::broker_read_ahead_block_bytes = 4;
+
+    std::unique_ptr<SequentialFile> f;
+    ASSERT_OK(_env.new_sequential_file(path, &f));
+    ASSERT_EQ("", read(f, 0));
+    ASSERT_EQ("a", read(f, 1));
+    // a read returns the bytes of one block at most.
+    ASSERT_EQ("bcd", read(f, 9));
+    ASSERT_EQ("efgh", read(f, 9));
+    ASSERT_OK(f->skip(10));
+    ASSERT_EQ("stuv", read(f, 100));
+    std::string rest;
+    for (std::string s = read(f, 3); !s.empty(); s = read(f, 3)) {
+        rest += s;
+    }
+    ASSERT_EQ("wxyz0123456789", rest);
+    ASSERT_EQ("", read(f, 1));
+
+    config::broker_read_ahead_blocks = old_blocks;
+    config::broker_read_ahead_block_bytes = old_block_bytes;
+}
+
 // NOLINTNEXTLINE
 TEST_F(EnvBrokerTest, test_random_read) {
     const std::string path = "/tmp/1.txt";
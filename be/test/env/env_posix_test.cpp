@@ -23,6 +23,7 @@
 
 #include <algorithm>
 
+#include "common/config.h"
 #include "common/logging.h"
 #include "env/env.h"
 #include "util/file_utils.h"
@@ -268,4 +269,40 @@ TEST_F(EnvPosixTest, iterate_dir) {
     FileUtils::remove_all(dir_path);
 }
 
+TEST_F(EnvPosixTest, read_at_batch) {
+    std::string fname = "./ut_dir/env_posix/read_at_batch";
+    std::string data;
+    for (int i = 0; i < 100000; ++i) {
+        data.push_back(static_cast<char>(i % 251));
+    }
+    std::unique_ptr<WritableFile> wfile;
+    ASSERT_TRUE(Env::Default()->new_writable_file(fname, &wfile).ok());
+    ASSERT_TRUE(wfile->append(data).ok());
+    ASSERT_TRUE(wfile->close().ok());
+
+    std::unique_ptr<RandomAccessFile> rfile;
+    ASSERT_TRUE(Env::Default()->new_random_access_file(fname, &rfile).ok());
+    // falls back to pread if io_uring is not supported.
+    for (bool enable_io_uring : {false, true}) {
+        config::enable_io_uring = enable_io_uring;
+        // more than the queue depth
+        std::vector<uint64_t> offsets;
+        std::vector<std::string> bufs(100, std::string(900, 0));
+        std::vector<Slice> slices;
+        for (int i = 0; i < 100; ++i) {
+            offsets.push_back(i * 997);
+            slices.emplace_back(bufs[i]);
+        }
+        ASSERT_TRUE(rfile->read_at_batch(offsets.data(), slices.data(), slices.size()).ok());
+        for (int i = 0; i < 100; ++i) {
+            ASSERT_EQ(data.substr(offsets[i], 900), bufs[i]);
+        }
+
+        // end of file
+        offsets = {0, 99950};
+        ASSERT_EQ(TStatusCode::END_OF_FILE, rfile->read_at_batch(offsets.data(), slices.data(), 2).code());
+    }
+    config::enable_io_uring = false;
+}
+
 } // namespace starrocks
@@ -71,6 +71,29 @@ struct DecoderChecker {
                 ASSERT_FALSE(st.ok());
             }
         }
+        {
+            auto column = starrocks::vectorized::FixedLengthColumn<T>::create();
+
+            // skip the first values
+            size_t num_skipped = values.size() / 4;
+            decoder->set_data(encoded_data);
+            auto st = decoder->skip(num_skipped);
+            ASSERT_TRUE(st.ok());
+            st = decoder->next_batch(values.size() - num_skipped, ColumnContentType::VALUE, column.get());
+            ASSERT_TRUE(st.ok());
+
+            const T* check = (const T*)column->raw_data();
+            for (size_t i = num_skipped; i < values.size(); ++i) {
+                ASSERT_EQ(values[i], *check);
+                check++;
+            }
+
+            if (!is_dictionary) {
+                // out-of-bounds access
+                st = decoder->skip(1);
+                ASSERT_FALSE(st.ok());
+            }
+        }
     }
 };
 
@@ -129,6 +152,29 @@ struct DecoderChecker<Slice, is_dictionary> {
                 ASSERT_FALSE(st.ok());
             }
         }
+        {
+            auto column = starrocks::vectorized::BinaryColumn::create();
+
+            // skip the first values
+            size_t num_skipped = values.size() / 4;
+            decoder->set_data(encoded_data);
+            auto st = decoder->skip(num_skipped);
+            ASSERT_TRUE(st.ok());
+            st = decoder->next_batch(values.size() - num_skipped, ColumnContentType::VALUE, column.get());
+            ASSERT_TRUE(st.ok());
+
+            const auto* check = (const Slice*)column->raw_data();
+            for (size_t i = num_skipped; i < values.size(); ++i) {
+                ASSERT_EQ(values[i], *check);
+                check++;
+            }
+
+            if (!is_dictionary) {
+                // out-of-bounds access
+                st = decoder->skip(1);
+                ASSERT_FALSE(st.ok());
+            }
+        }
     }
 };
 
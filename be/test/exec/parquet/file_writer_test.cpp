@@ -0,0 +1,140 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/parquet/file_writer.h"
+
+#include <arrow/api.h>
+#include <arrow/io/memory.h>
+#include <gtest/gtest.h>
+#include <parquet/arrow/reader.h>
+
+#include "column/binary_column.h"
+#include "column/column_helper.h"
+#include "column/const_column.h"
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "exec/file_writer.h"
+#include "runtime/date_value.h"
+
+namespace starrocks::parquet {
+
+// Keep the bytes written in memory.
+class MemoryFileWriter final : public starrocks::FileWriter {
+public:
+    Status open() override { return Status::OK(); }
+
+    Status write(const uint8_t* buf, size_t buf_len, size_t* written_len) override {
+        _data.append(reinterpret_cast<const char*>(buf), buf_len);
+        *written_len = buf_len;
+        return Status::OK();
+    }
+
+    Status close() override { return Status::OK(); }
+
+    const std::string& data() const { return _data; }
+
+private:
+    std::string _data;
+};
+
+static std::shared_ptr<arrow::Table> read_table(const std::string& data, int* num_row_groups) {
+    auto buffer = std::make_shared<arrow::Buffer>(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+    std::unique_ptr<::parquet::arrow::FileReader> reader;
+    auto st = ::parquet::arrow::OpenFile(std::make_shared<arrow::io::BufferReader>(buffer),
+                                         arrow::default_memory_pool(), &reader);
+    EXPECT_TRUE(st.ok()) << st.ToString();
+    *num_row_groups = reader->num_row_groups();
+    std::shared_ptr<arrow::Table> table;
+    st = reader->ReadTable(&table);
+    EXPECT_TRUE(st.ok()) << st.ToString();
+    st = table->CombineChunks(arrow::default_memory_pool()).Value(&table);
+    EXPECT_TRUE(st.ok()) << st.ToString();
+    return table;
+}
+
+// NOLINTNEXTLINE
+TEST(ParquetFileWriterTest, test_write_row_groups) {
+    std::vector<TypeDescriptor> types{TypeDescriptor(TYPE_INT), TypeDescriptor::create_varchar_type(32),
+                                      TypeDescriptor(TYPE_DATE)};
+    MemoryFileWriter file;
+    FileWriterOptions options;
+    // a few chunks in a row group.
+    options.row_group_max_bytes = 8 * 1024;
+    options.page_max_bytes = 1024;
+    FileWriter writer(&file, {"c0", "c1", "c2"}, types, options);
+    ASSERT_TRUE(writer.init().ok());
+
+    const int num_chunks = 20;
+    const int chunk_size = 100;
+    const vectorized::DateValue base = vectorized::DateValue::create(2021, 1, 1);
+    for (int c = 0; c < num_chunks; ++c) {
+        auto ints = vectorized::Int32Column::create();
+        auto strings = vectorized::NullableColumn::create(vectorized::BinaryColumn::create(),
+                                                          vectorized::NullColumn::create());
+        auto dates = vectorized::DateColumn::create();
+        for (int i = 0; i < chunk_size; ++i) {
+            int v = c * chunk_size + i;
+            ints->append(v);
+            if (v % 7 == 0) {
+                strings->append_nulls(1);
+            } else {
+                strings->append_datum(vectorized::Datum(Slice(std::to_string(v))));
+            }
+            dates->append(vectorized::DateValue{base.julian() + v});
+        }
+        ASSERT_TRUE(writer.write({ints, strings, dates}, chunk_size).ok());
+    }
+    ASSERT_TRUE(writer.close().ok());
+    // closed only once.
+    ASSERT_TRUE(writer.close().ok());
+    ASSERT_EQ(file.data().size(), writer.written_bytes());
+
+    int num_row_groups = 0;
+    auto table = read_table(file.data(), &num_row_groups);
+    ASSERT_GT(num_row_groups, 1);
+    ASSERT_EQ(num_chunks * chunk_size, table->num_rows());
+    ASSERT_EQ(3, table->num_columns());
+
+    auto c0 = std::static_pointer_cast<arrow::Int32Array>(table->column(0)->chunk(0));
+    auto c1 = std::static_pointer_cast<arrow::StringArray>(table->column(1)->chunk(0));
+    auto c2 = std::static_pointer_cast<arrow::Date32Array>(table->column(2)->chunk(0));
+    const int32_t base_days = base.julian() - vectorized::date::UNIX_EPOCH_JULIAN;
+    for (int v = 0; v < num_chunks * chunk_size; ++v) {
+        ASSERT_EQ(v, c0->Value(v));
+        if (v % 7 == 0) {
+            ASSERT_TRUE(c1->IsNull(v));
+        } else {
+            ASSERT_EQ(std::to_string(v), c1->GetString(v));
+        }
+        ASSERT_EQ(base_days + v, c2->Value(v));
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(ParquetFileWriterTest, test_const_column) {
+    std::vector<TypeDescriptor> types{TypeDescriptor(TYPE_BIGINT)};
+    MemoryFileWriter file;
+    FileWriter writer(&file, {"c0"}, types);
+    ASSERT_TRUE(writer.init().ok());
+    auto data = vectorized::Int64Column::create();
+    data->append(42);
+    ASSERT_TRUE(writer.write({vectorized::ConstColumn::create(data, 10)}, 10).ok());
+    ASSERT_TRUE(writer.close().ok());
+
+    int num_row_groups = 0;
+    auto table = read_table(file.data(), &num_row_groups);
+    ASSERT_EQ(1, num_row_groups);
+    ASSERT_EQ(10, table->num_rows());
+    auto c0 = std::static_pointer_cast<arrow::Int64Array>(table->column(0)->chunk(0));
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_EQ(42, c0->Value(i));
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(ParquetFileWriterTest, test_unsupported_type) {
+    MemoryFileWriter file;
+    FileWriter writer(&file, {"c0"}, {TypeDescriptor(TYPE_HLL)});
+    ASSERT_TRUE(writer.init().is_not_supported());
+}
+
+} // namespace starrocks::parquet
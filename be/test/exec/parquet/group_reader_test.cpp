@@ -116,6 +116,36 @@ private:
     tparquet::Type::type _type = tparquet::Type::type::INT32;
 };
 
+// Produce int32 values equal to the row numbers, and support skipping rows.
+class MockRangeColumnReader : public ColumnReader {
+public:
+    explicit MockRangeColumnReader(size_t num_rows) : _num_rows(num_rows) {}
+    ~MockRangeColumnReader() override = default;
+
+    Status prepare_batch(size_t* num_records, ColumnContentType content_type, vectorized::Column* column) override {
+        size_t num_rows = std::min(*num_records, _num_rows - _next_row);
+        for (size_t i = 0; i < num_rows; i++) {
+            column->append_datum(static_cast<int32_t>(_next_row + i));
+        }
+        _next_row += num_rows;
+        *num_records = num_rows;
+        return _next_row == _num_rows ? Status::EndOfFile("") : Status::OK();
+    }
+
+    Status finish_batch() override { return Status::OK(); }
+
+    Status skip_rows(size_t num_rows) override {
+        _next_row += num_rows;
+        return Status::OK();
+    }
+
+    void get_levels(int16_t** def_levels, int16_t** rep_levels, size_t* num_levels) override {}
+
+private:
+    size_t _num_rows = 0;
+    size_t _next_row = 0;
+};
+
 class GroupReaderTest : public ::testing::Test {
 protected:
     void SetUp() override {}
@@ -411,4 +441,56 @@ TEST_F(GroupReaderTest, TestGetNext) {
     _check_chunk(param, chunk, 8, 4);
 }
 
+TEST_F(GroupReaderTest, TestGetNextWithRowRanges) {
+    // create file
+    auto* file = _create_file();
+    auto* param = _pool.add(new GroupReaderParam());
+    param->read_cols.emplace_back(
+            _create_group_reader_param_of_column(0, tparquet::Type::type::INT32, PrimitiveType::TYPE_INT));
+    param->stats = &g_hdfs_scan_stats;
+    param->row_ranges.add(vectorized::Range(2, 5));
+    param->row_ranges.add(vectorized::Range(8, 12));
+
+    // create file meta
+    FileMetaData* file_meta;
+    Status status = _create_filemeta(&file_meta, param);
+    ASSERT_TRUE(status.ok());
+
+    // create row group reader
+    auto* group_reader = _pool.add(new GroupReader(file, file_meta, 0));
+
+    // init row group reader
+    status = group_reader->init(*param);
+    ASSERT_TRUE(status.is_end_of_file());
+
+    // replace column readers
+    group_reader->_column_readers.clear();
+    group_reader->_column_readers[0] = std::make_unique<MockRangeColumnReader>(12);
+    group_reader->_direct_read_columns = param->read_cols;
+    // create chunk
+    group_reader->_read_chunk = _create_chunk(param);
+
+    // rows before the first range are skipped
+    auto chunk = _create_chunk(param);
+    size_t row_count = 8;
+    status = group_reader->get_next(&chunk, &row_count);
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(row_count, 3);
+    _check_chunk(param, chunk, 2, 3);
+
+    // the last range
+    chunk = _create_chunk(param);
+    row_count = 8;
+    status = group_reader->get_next(&chunk, &row_count);
+    ASSERT_TRUE(status.is_end_of_file());
+    ASSERT_EQ(row_count, 4);
+    _check_chunk(param, chunk, 8, 4);
+
+    chunk = _create_chunk(param);
+    row_count = 8;
+    status = group_reader->get_next(&chunk, &row_count);
+    ASSERT_TRUE(status.is_end_of_file());
+    ASSERT_EQ(row_count, 0);
+}
+
 } // namespace starrocks::parquet
@@ -448,6 +448,71 @@ TEST_F(ParquetSchemaTest, SimpleArray) {
     }
 }
 
+TEST_F(ParquetSchemaTest, ColumnIndexAfterNestedType) {
+    std::vector<tparquet::SchemaElement> t_schemas;
+
+    t_schemas.resize(5);
+    // Root
+    {
+        auto& t_schema = t_schemas[0];
+        t_schema.name = "hive-schema";
+        t_schema.__set_num_children(2);
+    }
+    // Col1: Struct with two leaves
+    {
+        auto& t_schema = t_schemas[1];
+        t_schema.name = "col1";
+        t_schema.__set_num_children(2);
+        t_schema.__set_repetition_type(tparquet::FieldRepetitionType::OPTIONAL);
+    }
+    {
+        auto& t_schema = t_schemas[2];
+        t_schema.name = "a";
+        t_schema.__set_type(tparquet::Type::INT32);
+        t_schema.__set_num_children(0);
+        t_schema.__set_repetition_type(tparquet::FieldRepetitionType::OPTIONAL);
+    }
+    {
+        auto& t_schema = t_schemas[3];
+        t_schema.name = "b";
+        t_schema.__set_type(tparquet::Type::INT32);
+        t_schema.__set_num_children(0);
+        t_schema.__set_repetition_type(tparquet::FieldRepetitionType::REPEATED);
+    }
+    // Col2: INT64
+    {
+        auto& t_schema = t_schemas[4];
+        t_schema.name = "col2";
+        t_schema.__set_type(tparquet::Type::INT64);
+        t_schema.__set_num_children(0);
+        t_schema.__set_repetition_type(tparquet::FieldRepetitionType::OPTIONAL);
+    }
+
+    SchemaDescriptor desc;
+    auto st = desc.from_thrift(t_schemas);
+    ASSERT_TRUE(st.ok());
+    {
+        // the index of the top level field, not the index of the leaf column
+        auto idx = desc.get_column_index("col2");
+        ASSERT_EQ(1, idx);
+        auto field = desc.get_field_by_idx(idx);
+        ASSERT_STREQ("col2", field->name.c_str());
+        ASSERT_TRUE(field->is_leaf());
+        ASSERT_EQ(2, field->physical_column_index);
+        ASSERT_EQ(field, desc.get_stored_column_by_idx(2));
+    }
+    {
+        auto idx = desc.get_column_index("col1");
+        ASSERT_EQ(0, idx);
+        auto field = desc.get_field_by_idx(idx);
+        ASSERT_EQ(TYPE_STRUCT, field->type.type);
+        ASSERT_FALSE(field->is_leaf());
+        ASSERT_EQ(TYPE_ARRAY, field->children[1].type.type);
+        ASSERT_EQ(1, field->children[1].children[0].physical_column_index);
+    }
+    ASSERT_EQ(-1, desc.get_column_index("a"));
+}
+
 TEST_F(ParquetSchemaTest, TwoLevelArray) {
     std::vector<tparquet::SchemaElement> t_schemas;
 
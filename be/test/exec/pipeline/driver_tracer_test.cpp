@@ -0,0 +1,87 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/driver_tracer.h"
+
+#include <gtest/gtest.h>
+
+#include "common/config.h"
+#include "exec/pipeline/pipeline_driver.h"
+#include "util/uid_util.h"
+
+namespace starrocks::pipeline {
+
+static DriverTraceEvent make_event(int64_t timestamp_ns, uint64_t driver, DriverTraceEventType type,
+                                   DriverState state) {
+    DriverTraceEvent event;
+    event.timestamp_ns = timestamp_ns;
+    event.driver = driver;
+    event.fragment_instance_lo = 1;
+    event.driver_id = static_cast<int32_t>(driver);
+    event.source_node_id = 0;
+    event.type = type;
+    event.state = state;
+    return event;
+}
+
+// NOLINTNEXTLINE
+TEST(DriverTracerTest, buffer_overwrites_oldest_events) {
+    DriverTraceBuffer buffer(TUniqueId(), 3);
+    for (int i = 0; i < 10; ++i) {
+        buffer.add(make_event(i, 1, DriverTraceEventType::READY, DriverState::READY));
+    }
+    // The capacity is rounded up to 4.
+    auto events = buffer.events();
+    ASSERT_EQ(4, events.size());
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_EQ(6 + i, events[i].timestamp_ns);
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(DriverTracerTest, chrome_trace) {
+    DriverTraceBuffer buffer(TUniqueId(), 16);
+    buffer.add(make_event(1000, 1, DriverTraceEventType::READY, DriverState::READY));
+    buffer.add(make_event(2000, 1, DriverTraceEventType::RUNNING, DriverState::READY));
+    buffer.add(make_event(5000, 1, DriverTraceEventType::BLOCKED, DriverState::INPUT_EMPTY));
+    buffer.add(make_event(3000, 2, DriverTraceEventType::READY, DriverState::READY));
+    buffer.add(make_event(9000, 1, DriverTraceEventType::FINISHED, DriverState::FINISH));
+
+    std::string trace = buffer.to_chrome_trace();
+    ASSERT_NE(std::string::npos, trace.find(R"({"name":"Running","ph":"X","ts":2.000,"dur":3.000,"pid":1,"tid":1)"));
+    ASSERT_NE(std::string::npos, trace.find(R"({"name":"Blocked","ph":"X","ts":5.000,"dur":4.000,"pid":1,"tid":1,)"
+                                            R"("args":{"state":"INPUT_EMPTY"}})"));
+    ASSERT_NE(std::string::npos, trace.find(R"({"name":"Finished","ph":"i")"));
+    // The driver 2 is still ready at the latest event.
+    ASSERT_NE(std::string::npos, trace.find(R"({"name":"Ready","ph":"X","ts":3.000,"dur":6.000,"pid":1,"tid":2)"));
+}
+
+// NOLINTNEXTLINE
+TEST(DriverTracerTest, sample_queries) {
+    auto* tracer = DriverTracer::instance();
+    int64_t old_sample_rate = config::pipeline_driver_trace_sample_rate;
+    int64_t old_max_queries = config::pipeline_driver_trace_max_queries;
+    config::pipeline_driver_trace_sample_rate = 0;
+    TUniqueId query_id;
+    query_id.__set_hi(100);
+    query_id.__set_lo(0);
+    ASSERT_EQ(nullptr, tracer->start_query(query_id));
+
+    config::pipeline_driver_trace_sample_rate = 1;
+    config::pipeline_driver_trace_max_queries = 2;
+    for (int i = 1; i <= 3; ++i) {
+        query_id.__set_lo(i);
+        ASSERT_NE(nullptr, tracer->start_query(query_id));
+    }
+    auto ids = tracer->query_ids();
+    ASSERT_EQ(2, ids.size());
+    query_id.__set_lo(3);
+    ASSERT_EQ(print_id(query_id), ids[0]);
+    ASSERT_NE(nullptr, tracer->get(print_id(query_id)));
+    query_id.__set_lo(1);
+    ASSERT_EQ(nullptr, tracer->get(print_id(query_id)));
+
+    config::pipeline_driver_trace_sample_rate = old_sample_rate;
+    config::pipeline_driver_trace_max_queries = old_max_queries;
+}
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,178 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "column/chunk.h"
+#include "column/fixed_length_column.h"
+#include "exec/pipeline/pipeline_observer.h"
+#include "gutil/casts.h"
+#include "runtime/data_stream_mgr.h"
+#include "runtime/data_stream_recvr.h"
+#include "runtime/runtime_state.h"
+#include "util/runtime_profile.h"
+
+namespace starrocks::pipeline {
+
+// Count the runs of the closure, which is never deleted since the test owns it.
+class CountingClosure : public google::protobuf::Closure {
+public:
+    void Run() override { ++num_runs; }
+
+    int num_runs = 0;
+};
+
+// The chunks of the senders in this process are passed through DataStreamMgr::transmit_local_chunks to a
+// receiver of the pipeline engine, as the exchange sink does when enable_exchange_pass_through is on.
+class ExchangePassThroughTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        _fragment_instance_id.__set_hi(1);
+        _fragment_instance_id.__set_lo(2);
+        _state = std::make_unique<RuntimeState>(_fragment_instance_id, TQueryOptions(), TQueryGlobals(), nullptr);
+        ASSERT_TRUE(_state->init_instance_mem_tracker().ok());
+    }
+
+    void TearDown() override {
+        if (_recvr != nullptr) {
+            _recvr->remove_observer(&_observer);
+            _recvr->close();
+            _recvr.reset();
+        }
+    }
+
+protected:
+    static constexpr PlanNodeId kNodeId = 1;
+    static constexpr int kNumSenders = 2;
+
+    void _create_recvr(int buffer_size) {
+        _recvr = _mgr.create_recvr(_state.get(), _row_desc, _fragment_instance_id, kNodeId, kNumSenders, buffer_size,
+                                   std::make_shared<RuntimeProfile>("test"), false, nullptr, true);
+        _recvr->add_observer(&_observer);
+        // the observer is created notified.
+        ASSERT_TRUE(_observer.check_and_reset());
+    }
+
+    // a chunk of one column, whose rows are |values|.
+    static vectorized::ChunkUniquePtr _create_chunk(const std::vector<int32_t>& values) {
+        auto column = vectorized::Int32Column::create();
+        column->append_numbers(values.data(), values.size() * sizeof(int32_t));
+        auto chunk = std::make_unique<vectorized::Chunk>();
+        chunk->append_column(column, 0);
+        return chunk;
+    }
+
+    // pass |values| from |sender|, one chunk each, the sender runs *done unless the receiver holds it.
+    Status _transmit(int sender, const std::vector<int32_t>& values, bool eos, CountingClosure* closure = nullptr) {
+        std::vector<vectorized::ChunkUniquePtr> chunks;
+        for (int32_t value : values) {
+            chunks.emplace_back(_create_chunk({value}));
+        }
+        google::protobuf::Closure* done = closure;
+        RETURN_IF_ERROR(_mgr.transmit_local_chunks(_fragment_instance_id, kNodeId, sender, sender, std::move(chunks),
+                                                   eos, nullptr, closure != nullptr ? &done : nullptr));
+        if (done != nullptr) {
+            done->Run();
+        }
+        return Status::OK();
+    }
+
+    // take all the buffered chunks as the exchange source operator does.
+    std::vector<int32_t> _drain() {
+        std::vector<int32_t> values;
+        while (_recvr->has_output()) {
+            std::unique_ptr<vectorized::Chunk> chunk;
+            EXPECT_TRUE(_recvr->get_chunk(&chunk).ok());
+            EXPECT_TRUE(chunk != nullptr);
+            auto* column = down_cast<vectorized::Int32Column*>(chunk->get_column_by_index(0).get());
+            values.insert(values.end(), column->get_data().begin(), column->get_data().end());
+        }
+        return values;
+    }
+
+    TUniqueId _fragment_instance_id;
+    std::unique_ptr<RuntimeState> _state;
+    DataStreamMgr _mgr;
+    RowDescriptor _row_desc;
+    std::shared_ptr<DataStreamRecvr> _recvr;
+    PipelineObserver _observer;
+};
+
+// NOLINTNEXTLINE
+TEST_F(ExchangePassThroughTest, test_deliver_chunks_once) {
+    _create_recvr(1024 * 1024);
+    ASSERT_FALSE(_recvr->has_output());
+    ASSERT_FALSE(_recvr->is_finished());
+
+    ASSERT_TRUE(_transmit(0, {0, 1, 2}, false).ok());
+    ASSERT_TRUE(_transmit(1, {100, 101}, false).ok());
+    ASSERT_TRUE(_observer.check_and_reset());
+    ASSERT_TRUE(_recvr->has_output());
+    std::vector<int32_t> values = _drain();
+    // the chunks of a sender are in its order, and each chunk is taken exactly once.
+    std::vector<int32_t> expected{0, 1, 2, 100, 101};
+    ASSERT_EQ(expected, values);
+    ASSERT_FALSE(_recvr->has_output());
+    ASSERT_FALSE(_recvr->is_finished());
+
+    // the chunks sent with the eos are delivered before the sender is removed.
+    ASSERT_TRUE(_transmit(0, {3}, true).ok());
+    ASSERT_TRUE(_observer.check_and_reset());
+    ASSERT_FALSE(_recvr->is_finished());
+    ASSERT_EQ(std::vector<int32_t>{3}, _drain());
+    // the stream is not finished until all the senders send their eos.
+    ASSERT_FALSE(_recvr->is_finished());
+
+    ASSERT_TRUE(_transmit(1, {}, true).ok());
+    ASSERT_TRUE(_observer.check_and_reset());
+    ASSERT_FALSE(_recvr->has_output());
+    ASSERT_TRUE(_recvr->is_finished());
+
+    // a repeated eos does not count twice, and the chunks after the eos of all the senders are dropped.
+    ASSERT_TRUE(_transmit(1, {}, true).ok());
+    ASSERT_TRUE(_transmit(0, {4}, false).ok());
+    ASSERT_FALSE(_recvr->has_output());
+    ASSERT_TRUE(_recvr->is_finished());
+}
+
+// NOLINTNEXTLINE
+TEST_F(ExchangePassThroughTest, test_finish_with_buffered_chunks) {
+    _create_recvr(1024 * 1024);
+    ASSERT_TRUE(_transmit(0, {0, 1}, true).ok());
+    ASSERT_TRUE(_transmit(1, {2}, true).ok());
+    // the eos of all the senders does not finish the stream until the buffered chunks are taken.
+    ASSERT_TRUE(_recvr->has_output());
+    ASSERT_FALSE(_recvr->is_finished());
+    std::vector<int32_t> values = _drain();
+    std::sort(values.begin(), values.end());
+    ASSERT_EQ((std::vector<int32_t>{0, 1, 2}), values);
+    ASSERT_TRUE(_recvr->is_finished());
+}
+
+// NOLINTNEXTLINE
+TEST_F(ExchangePassThroughTest, test_hold_sender_when_buffer_full) {
+    _create_recvr(1);
+    CountingClosure closure;
+    ASSERT_TRUE(_transmit(0, {0, 1}, false, &closure).ok());
+    // the buffer is full, the sender waits until the consumer takes a chunk.
+    ASSERT_EQ(0, closure.num_runs);
+    ASSERT_TRUE(_recvr->has_output());
+
+    std::unique_ptr<vectorized::Chunk> chunk;
+    ASSERT_TRUE(_recvr->get_chunk(&chunk).ok());
+    ASSERT_EQ(1, closure.num_runs);
+    ASSERT_EQ(std::vector<int32_t>{1}, _drain());
+    ASSERT_EQ(1, closure.num_runs);
+
+    // the eos is never held, so the sender can finish at once.
+    CountingClosure eos_closure;
+    ASSERT_TRUE(_transmit(0, {2}, true, &eos_closure).ok());
+    ASSERT_EQ(1, eos_closure.num_runs);
+    ASSERT_TRUE(_transmit(1, {}, true).ok());
+    ASSERT_EQ(std::vector<int32_t>{2}, _drain());
+    ASSERT_TRUE(_recvr->is_finished());
+}
+
+} // namespace starrocks::pipeline
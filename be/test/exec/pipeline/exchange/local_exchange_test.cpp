@@ -0,0 +1,140 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/exchange/local_exchange.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+
+#include "column/chunk.h"
+#include "column/fixed_length_column.h"
+#include "exprs/expr_context.h"
+#include "exprs/slot_ref.h"
+
+namespace starrocks::pipeline {
+
+class PartitionExchangerTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        _memory_manager = std::make_shared<LocalExchangeMemoryManager>(1 << 30, _num_partitions);
+        _source = std::make_unique<LocalExchangeSourceOperatorFactory>(1, _memory_manager);
+        for (int i = 0; i < _num_partitions; ++i) {
+            _operators.emplace_back(_source->create(_num_partitions, i));
+        }
+        _partition_expr_ctxs.push_back(_pool.add(new ExprContext(&_slot_ref)));
+    }
+
+protected:
+    // a chunk of |num_rows| rows whose partition key is always |key|.
+    static vectorized::ChunkPtr _create_chunk(int32_t key, size_t num_rows) {
+        auto column = vectorized::Int32Column::create();
+        column->append_value_multiple_times(&key, num_rows);
+        auto chunk = std::make_shared<vectorized::Chunk>();
+        chunk->append_column(column, 0);
+        return chunk;
+    }
+
+    std::vector<int32_t> _partition_row_counts() const {
+        std::vector<int32_t> row_counts;
+        for (int i = 0; i < _num_partitions; ++i) {
+            row_counts.push_back(_memory_manager->partition_row_count(i));
+        }
+        return row_counts;
+    }
+
+    // the only partition which has queued rows.
+    int _hash_partition() const {
+        auto row_counts = _partition_row_counts();
+        for (int i = 0; i < _num_partitions; ++i) {
+            if (row_counts[i] > 0) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    // drain the queued rows of |partition| as the local exchange source does.
+    size_t _drain(int partition) {
+        auto* source = _source->get_sources()[partition];
+        source->finish(nullptr);
+        size_t num_rows = 0;
+        while (source->has_output()) {
+            auto chunk = source->pull_chunk(nullptr);
+            num_rows += chunk.value()->num_rows();
+        }
+        return num_rows;
+    }
+
+    const int _num_partitions = 4;
+    ObjectPool _pool;
+    SlotRef _slot_ref{TypeDescriptor(TYPE_INT), 0, 0};
+    std::vector<ExprContext*> _partition_expr_ctxs;
+    std::shared_ptr<LocalExchangeMemoryManager> _memory_manager;
+    std::unique_ptr<LocalExchangeSourceOperatorFactory> _source;
+    std::vector<OperatorPtr> _operators;
+};
+
+// NOLINTNEXTLINE
+TEST_F(PartitionExchangerTest, test_hash_partition_without_rebalance) {
+    PartitionExchanger exchanger(_memory_manager, _source.get(), true, _partition_expr_ctxs, false);
+    ASSERT_TRUE(exchanger.accept(_create_chunk(7, 1000)).ok());
+    int partition = _hash_partition();
+    ASSERT_NE(-1, partition);
+
+    // the hot partition keeps all the rows of its key.
+    ASSERT_TRUE(exchanger.accept(_create_chunk(7, 1000)).ok());
+    auto row_counts = _partition_row_counts();
+    ASSERT_EQ(2000, row_counts[partition]);
+    ASSERT_EQ(2000, std::accumulate(row_counts.begin(), row_counts.end(), 0));
+    ASSERT_EQ(2000, _drain(partition));
+    ASSERT_EQ(0, _memory_manager->partition_row_count(partition));
+}
+
+// NOLINTNEXTLINE
+TEST_F(PartitionExchangerTest, test_rebalance_hot_partition) {
+    PartitionExchanger exchanger(_memory_manager, _source.get(), true, _partition_expr_ctxs, true);
+    // nothing is queued yet, so the rows are hash partitioned.
+    ASSERT_TRUE(exchanger.accept(_create_chunk(7, 1000)).ok());
+    int partition = _hash_partition();
+    ASSERT_NE(-1, partition);
+    ASSERT_EQ(1000, _memory_manager->partition_row_count(partition));
+
+    // the partition is hot, so the rows are sent to the other partitions in round-robin manner.
+    ASSERT_TRUE(exchanger.accept(_create_chunk(7, 999)).ok());
+    auto row_counts = _partition_row_counts();
+    for (int i = 0; i < _num_partitions; ++i) {
+        ASSERT_EQ(i == partition ? 1000 : 333, row_counts[i]);
+    }
+
+    // once the hot partition has been drained, it is no longer hot and gets the rows of its key again.
+    ASSERT_EQ(1000, _drain(partition));
+    ASSERT_TRUE(exchanger.accept(_create_chunk(7, 100)).ok());
+    row_counts = _partition_row_counts();
+    for (int i = 0; i < _num_partitions; ++i) {
+        ASSERT_EQ(i == partition ? 100 : 333, row_counts[i]);
+    }
+
+    // no row is lost.
+    size_t num_rows = 0;
+    for (int i = 0; i < _num_partitions; ++i) {
+        num_rows += _drain(i);
+    }
+    ASSERT_EQ(100 + 999, num_rows);
+    ASSERT_EQ((std::vector<int32_t>(_num_partitions, 0)), _partition_row_counts());
+}
+
+// NOLINTNEXTLINE
+TEST_F(PartitionExchangerTest, test_no_rebalance_without_cold_partition) {
+    PartitionExchanger exchanger(_memory_manager, _source.get(), true, _partition_expr_ctxs, true);
+    // every partition has the same queued rows, so none of them is hot.
+    for (int i = 0; i < _num_partitions; ++i) {
+        _memory_manager->update_partition_row_count(i, 1000);
+    }
+    ASSERT_TRUE(exchanger.accept(_create_chunk(7, 1000)).ok());
+    auto row_counts = _partition_row_counts();
+    ASSERT_EQ(_num_partitions - 1, std::count(row_counts.begin(), row_counts.end(), 1000));
+    ASSERT_EQ(1, std::count(row_counts.begin(), row_counts.end(), 2000));
+}
+
+} // namespace starrocks::pipeline
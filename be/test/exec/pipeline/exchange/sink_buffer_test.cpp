@@ -0,0 +1,373 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/exchange/sink_buffer.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <deque>
+
+#include "common/config.h"
+#include "runtime/data_stream_recvr.h"
+#include "util/runtime_profile.h"
+
+namespace starrocks::pipeline {
+
+// Record the transmit_chunk rpcs instead of sending them, the test decides when and how each rpc is done.
+class FakeRpcChannel : public google::protobuf::RpcChannel {
+public:
+    struct Call {
+        PTransmitChunkParams request;
+        PTransmitChunkResult* response;
+        brpc::Controller* cntl;
+        google::protobuf::Closure* done;
+    };
+
+    void CallMethod(const google::protobuf::MethodDescriptor* method, google::protobuf::RpcController* controller,
+                    const google::protobuf::Message* request, google::protobuf::Message* response,
+                    google::protobuf::Closure* done) override {
+        Call call;
+        call.request.CopyFrom(*request);
+        call.response = static_cast<PTransmitChunkResult*>(response);
+        call.cntl = static_cast<brpc::Controller*>(controller);
+        call.done = done;
+        calls.emplace_back(std::move(call));
+    }
+
+    // finish the oldest rpc in flight, the callback may issue the next rpc of the same destination.
+    PTransmitChunkParams respond(bool failed = false) {
+        Call call = std::move(calls.front());
+        calls.pop_front();
+        if (failed) {
+            call.cntl->SetFailed("fake rpc failure");
+        } else {
+            call.response->mutable_status()->set_status_code(0);
+        }
+        call.done->Run();
+        return call.request;
+    }
+
+    std::deque<Call> calls;
+};
+
+class SinkBufferTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        for (size_t i = 0; i < kNumChannels; ++i) {
+            _stubs.emplace_back(std::make_unique<doris::PBackendService_Stub>(&_channels[i]));
+        }
+    }
+
+protected:
+    static constexpr size_t kNumChannels = 2;
+
+    TransmitChunkInfo _request(size_t channel_id, const std::vector<std::string>& chunks, bool eos = false) {
+        TransmitChunkInfo info;
+        info.channel_id = channel_id;
+        info.brpc_stub = _stubs[channel_id].get();
+        info.params.set_node_id(1);
+        info.params.set_sender_id(0);
+        info.params.set_be_number(0);
+        info.params.set_eos(eos);
+        for (const auto& data : chunks) {
+            info.params.add_chunks()->set_data(data);
+        }
+        return info;
+    }
+
+    static std::vector<std::string> _chunks(const PTransmitChunkParams& params) {
+        std::vector<std::string> chunks;
+        for (const auto& chunk : params.chunks()) {
+            chunks.push_back(chunk.data());
+        }
+        return chunks;
+    }
+
+    FakeRpcChannel _channels[kNumChannels];
+    std::vector<std::unique_ptr<doris::PBackendService_Stub>> _stubs;
+};
+
+// NOLINTNEXTLINE
+TEST_F(SinkBufferTest, test_send_in_order_per_destination) {
+    auto buffer = std::make_shared<SinkBuffer>(kNumChannels, 1);
+    buffer->add_request(_request(0, {"a1"}));
+    buffer->add_request(_request(0, {"a2"}));
+    buffer->add_request(_request(0, {"a3", "a4"}));
+    buffer->add_request(_request(1, {"b1"}));
+
+    // one rpc in flight per destination, the requests of the other destination are not blocked.
+    ASSERT_EQ(1, _channels[0].calls.size());
+    ASSERT_EQ(1, _channels[1].calls.size());
+    ASSERT_FALSE(buffer->is_finished());
+
+    // the queued requests are coalesced into the next rpc, in the order they were added.
+    auto first = _channels[0].respond();
+    ASSERT_EQ((std::vector<std::string>{"a1"}), _chunks(first));
+    ASSERT_EQ(1, _channels[0].calls.size());
+    auto second = _channels[0].respond();
+    ASSERT_EQ((std::vector<std::string>{"a2", "a3", "a4"}), _chunks(second));
+    ASSERT_LT(first.sequence(), second.sequence());
+    ASSERT_TRUE(_channels[0].calls.empty());
+    ASSERT_FALSE(buffer->is_finished());
+
+    ASSERT_EQ((std::vector<std::string>{"b1"}), _chunks(_channels[1].respond()));
+    ASSERT_TRUE(buffer->is_finished());
+    ASSERT_FALSE(buffer->is_cancelled());
+}
+
+// NOLINTNEXTLINE
+TEST_F(SinkBufferTest, test_split_rpcs_by_coalesced_bytes) {
+    int64_t old_coalesced_bytes = config::pipeline_sink_max_coalesced_bytes;
+    config::pipeline_sink_max_coalesced_bytes = 4;
+    auto buffer = std::make_shared<SinkBuffer>(kNumChannels, 1);
+    buffer->add_request(_request(0, {"a1"}));
+    buffer->add_request(_request(0, {"a2"}));
+    buffer->add_request(_request(0, {"a3"}));
+    buffer->add_request(_request(0, {"a4"}));
+    buffer->add_request(_request(0, {"a5"}));
+
+    std::vector<std::vector<std::string>> rpcs;
+    int64_t last_sequence = -1;
+    while (!_channels[0].calls.empty()) {
+        auto params = _channels[0].respond();
+        ASSERT_LT(last_sequence, params.sequence());
+        last_sequence = params.sequence();
+        rpcs.push_back(_chunks(params));
+    }
+    config::pipeline_sink_max_coalesced_bytes = old_coalesced_bytes;
+    ASSERT_EQ((std::vector<std::vector<std::string>>{{"a1"}, {"a2", "a3"}, {"a4", "a5"}}), rpcs);
+    ASSERT_TRUE(buffer->is_finished());
+}
+
+// NOLINTNEXTLINE
+TEST_F(SinkBufferTest, test_send_eos_once_after_all_sinkers) {
+    auto buffer = std::make_shared<SinkBuffer>(kNumChannels, 3);
+    for (size_t channel_id = 0; channel_id < kNumChannels; ++channel_id) {
+        buffer->add_request(_request(channel_id, {"c"}));
+        // the eos of a sinker which is not the last one is dropped, or sent as a normal request with its chunks.
+        buffer->add_request(_request(channel_id, {}, true));
+        buffer->add_request(_request(channel_id, {"d"}, true));
+        buffer->add_request(_request(channel_id, {}, true));
+    }
+
+    for (size_t channel_id = 0; channel_id < kNumChannels; ++channel_id) {
+        auto& channel = _channels[channel_id];
+        std::vector<std::string> chunks;
+        size_t num_eos = 0;
+        while (!channel.calls.empty()) {
+            // eos is the last request of the destination.
+            ASSERT_EQ(0, num_eos);
+            auto params = channel.respond();
+            auto rpc_chunks = _chunks(params);
+            chunks.insert(chunks.end(), rpc_chunks.begin(), rpc_chunks.end());
+            num_eos += params.eos();
+        }
+        ASSERT_EQ(1, num_eos);
+        ASSERT_EQ((std::vector<std::string>{"c", "d"}), chunks);
+    }
+    ASSERT_TRUE(buffer->is_finished());
+}
+
+// NOLINTNEXTLINE
+TEST_F(SinkBufferTest, test_cancel_with_rpc_in_flight) {
+    auto buffer = std::make_shared<SinkBuffer>(kNumChannels, 1);
+    buffer->add_request(_request(0, {"a1"}));
+    buffer->add_request(_request(0, {"a2"}));
+    buffer->add_request(_request(1, {"b1"}));
+    buffer->add_request(_request(1, {"b2"}));
+    ASSERT_EQ(1, _channels[0].calls.size());
+    ASSERT_EQ(1, _channels[1].calls.size());
+
+    // the failure of one rpc cancels the buffer and drops the queued requests of all the destinations.
+    _channels[0].respond(true);
+    ASSERT_TRUE(buffer->is_cancelled());
+    ASSERT_TRUE(buffer->is_finished());
+    ASSERT_FALSE(buffer->is_full());
+    ASSERT_TRUE(_channels[0].calls.empty());
+
+    // the requests added after the cancellation are dropped too.
+    buffer->add_request(_request(0, {"a3"}, true));
+    ASSERT_TRUE(_channels[0].calls.empty());
+
+    // the rpc in flight holds the buffer, which may be released by the fragment before the rpc is done.
+    std::weak_ptr<SinkBuffer> weak_buffer = buffer;
+    buffer.reset();
+    ASSERT_FALSE(weak_buffer.expired());
+    _channels[1].respond();
+    ASSERT_TRUE(_channels[1].calls.empty());
+    ASSERT_TRUE(weak_buffer.expired());
+}
+
+// Two senders with credit, each SinkBuffer of one destination, and a receiver whose consumer is driven by the test.
+class SinkBufferCreditTest : public SinkBufferTest {
+public:
+    void SetUp() override {
+        SinkBufferTest::SetUp();
+        _old_use_credit = config::pipeline_enable_exchange_credit_flow_control;
+        config::pipeline_enable_exchange_credit_flow_control = true;
+        _recvr = std::make_unique<DataStreamRecvr>(nullptr, nullptr, _row_desc, TUniqueId(), 1, kNumSenders, false,
+                                                   kBufferLimit, std::make_shared<RuntimeProfile>("test"), nullptr,
+                                                   true);
+    }
+
+    void TearDown() override {
+        _recvr->_release_pending_credits();
+        config::pipeline_enable_exchange_credit_flow_control = _old_use_credit;
+    }
+
+protected:
+    static constexpr int kNumSenders = kNumChannels;
+    static constexpr int kBufferLimit = 8;
+
+    TransmitChunkInfo _sender_request(int sender, const std::vector<std::string>& chunks, bool eos = false) {
+        TransmitChunkInfo info = _request(sender, chunks, eos);
+        info.channel_id = 0;
+        info.params.set_be_number(sender);
+        return info;
+    }
+
+    // Deliver the oldest rpc of |sender| to the receiver like DataStreamMgr::transmit_chunk.
+    void _deliver(int sender) {
+        auto call = std::move(_channels[sender].calls.front());
+        _channels[sender].calls.pop_front();
+        const auto& request = call.request;
+        ASSERT_TRUE(request.use_credit());
+        for (const auto& chunk : request.chunks()) {
+            _recvr->_num_buffered_bytes += chunk.data().size();
+            _buffered_chunks.push_back(chunk.data());
+        }
+        _max_buffered_bytes = std::max<int64_t>(_max_buffered_bytes, _recvr->_num_buffered_bytes.load());
+        call.response->mutable_status()->set_status_code(0);
+        if (request.eos()) {
+            _recvr->revoke_credit(request.be_number());
+        } else {
+            _recvr->grant_credit(request, call.response, &call.done);
+        }
+        if (call.done != nullptr) {
+            call.done->Run();
+        }
+    }
+
+    // Deliver the rpcs until all of them are either done or held by the receiver.
+    void _deliver_all() {
+        bool delivered = true;
+        while (delivered) {
+            delivered = false;
+            for (int sender = 0; sender < kNumSenders; ++sender) {
+                if (!_channels[sender].calls.empty()) {
+                    _deliver(sender);
+                    delivered = true;
+                }
+            }
+        }
+    }
+
+    // The consumer takes all the buffered chunks.
+    void _consume_all() {
+        for (const auto& chunk : _buffered_chunks) {
+            _consumed_chunks.push_back(chunk);
+        }
+        _buffered_chunks.clear();
+        _recvr->_num_buffered_bytes = 0;
+        _recvr->_grant_pending_credits();
+    }
+
+    RowDescriptor _row_desc;
+    std::unique_ptr<DataStreamRecvr> _recvr;
+    std::vector<std::string> _buffered_chunks;
+    std::vector<std::string> _consumed_chunks;
+    int64_t _max_buffered_bytes = 0;
+    bool _old_use_credit = false;
+};
+
+// NOLINTNEXTLINE
+TEST_F(SinkBufferCreditTest, test_buffered_bytes_within_limit) {
+    std::vector<std::shared_ptr<SinkBuffer>> buffers;
+    std::vector<std::string> sent_chunks;
+    for (int sender = 0; sender < kNumSenders; ++sender) {
+        buffers.emplace_back(std::make_shared<SinkBuffer>(1, 1));
+        for (int i = 0; i < 6; ++i) {
+            std::string chunk = std::string(1, 'a' + sender) + std::to_string(i);
+            sent_chunks.push_back(chunk);
+            buffers[sender]->add_request(_sender_request(sender, {chunk}));
+        }
+        buffers[sender]->add_request(_sender_request(sender, {}, true));
+    }
+
+    int num_rounds = 0;
+    while (!buffers[0]->is_finished() || !buffers[1]->is_finished()) {
+        ASSERT_LT(num_rounds++, 100);
+        _deliver_all();
+        ASSERT_LE(_recvr->_num_buffered_bytes.load(), kBufferLimit);
+        if (!buffers[0]->is_finished() || !buffers[1]->is_finished()) {
+            // the senders wait for credit until the consumer frees the buffer.
+            ASSERT_GT(_recvr->_num_pending_credit_requests.load(), 0);
+        }
+        _consume_all();
+    }
+    ASSERT_LE(_max_buffered_bytes, kBufferLimit);
+    ASSERT_EQ(kBufferLimit, _max_buffered_bytes);
+    ASSERT_GT(num_rounds, 1);
+    ASSERT_TRUE(_recvr->_granted_credits.empty());
+    ASSERT_EQ(0, _recvr->_num_granted_bytes);
+    ASSERT_FALSE(buffers[0]->is_cancelled());
+
+    std::sort(sent_chunks.begin(), sent_chunks.end());
+    std::sort(_consumed_chunks.begin(), _consumed_chunks.end());
+    ASSERT_EQ(sent_chunks, _consumed_chunks);
+}
+
+// NOLINTNEXTLINE
+TEST_F(SinkBufferCreditTest, test_grant_pending_credit_on_drain) {
+    auto buffer0 = std::make_shared<SinkBuffer>(1, 1);
+    auto buffer1 = std::make_shared<SinkBuffer>(1, 1);
+    // sender 0 fills the buffer.
+    buffer0->add_request(_sender_request(0, {"aaaa"}));
+    buffer0->add_request(_sender_request(0, {"bbbb"}));
+    _deliver(0);
+    _deliver(0);
+    _deliver(0);
+    _deliver(0);
+    ASSERT_EQ(kBufferLimit, _recvr->_num_buffered_bytes.load());
+
+    // the credit request of sender 1 is held until the buffer is drained.
+    buffer1->add_request(_sender_request(1, {"cc"}));
+    _deliver(1);
+    ASSERT_TRUE(_channels[1].calls.empty());
+    ASSERT_EQ(1, _recvr->_num_pending_credit_requests.load());
+    ASSERT_EQ(2, _recvr->_pending_credit_requests[1].min_bytes);
+
+    // freeing less than the sender needs grants nothing.
+    _recvr->_num_buffered_bytes = kBufferLimit - 1;
+    _recvr->_grant_pending_credits();
+    ASSERT_TRUE(_channels[1].calls.empty());
+
+    _consume_all();
+    ASSERT_EQ(0, _recvr->_num_pending_credit_requests.load());
+    ASSERT_EQ(1, _channels[1].calls.size());
+    ASSERT_EQ((std::vector<std::string>{"cc"}), _chunks(_channels[1].calls.front().request));
+    _deliver(1);
+    ASSERT_EQ(2, _recvr->_num_buffered_bytes.load());
+}
+
+// NOLINTNEXTLINE
+TEST_F(SinkBufferCreditTest, test_request_larger_than_buffer) {
+    auto buffer0 = std::make_shared<SinkBuffer>(1, 1);
+    auto buffer1 = std::make_shared<SinkBuffer>(1, 1);
+    buffer1->add_request(_sender_request(1, {"cc"}));
+    _deliver(1);
+    _deliver(1);
+    ASSERT_EQ(2, _recvr->_num_buffered_bytes.load());
+
+    // the request can't fit into the buffer, it's sent once nothing is buffered.
+    buffer0->add_request(_sender_request(0, {std::string(kBufferLimit + 4, 'a')}));
+    _deliver(0);
+    ASSERT_TRUE(_channels[0].calls.empty());
+    _consume_all();
+    ASSERT_EQ(1, _channels[0].calls.size());
+    _deliver(0);
+    ASSERT_EQ(kBufferLimit + 4, _recvr->_num_buffered_bytes.load());
+    ASSERT_TRUE(buffer0->is_finished());
+}
+
+} // namespace starrocks::pipeline
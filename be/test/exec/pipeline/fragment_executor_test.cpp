@@ -0,0 +1,25 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/fragment_executor.h"
+
+#include <gtest/gtest.h>
+
+namespace starrocks::pipeline {
+
+// NOLINTNEXTLINE
+TEST(FragmentExecutorTest, test_compute_adaptive_dop) {
+    // Idle.
+    ASSERT_EQ(16, FragmentExecutor::compute_adaptive_dop(16, 100, true, 16, 0));
+    ASSERT_EQ(16, FragmentExecutor::compute_adaptive_dop(16, 100, true, 16, 16));
+    // Loaded.
+    ASSERT_EQ(8, FragmentExecutor::compute_adaptive_dop(16, 100, true, 16, 32));
+    ASSERT_EQ(1, FragmentExecutor::compute_adaptive_dop(16, 100, true, 16, 1000));
+    // Capped by morsels.
+    ASSERT_EQ(3, FragmentExecutor::compute_adaptive_dop(16, 3, true, 16, 0));
+    ASSERT_EQ(16, FragmentExecutor::compute_adaptive_dop(16, 3, false, 16, 0));
+    ASSERT_EQ(1, FragmentExecutor::compute_adaptive_dop(16, 0, true, 16, 0));
+    // Unknown number of threads.
+    ASSERT_EQ(16, FragmentExecutor::compute_adaptive_dop(16, 100, false, 0, 1000));
+}
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,134 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/morsel.h"
+
+#include <gtest/gtest.h>
+
+#include "gutil/casts.h"
+#include "storage/rowset/rowset_factory.h"
+#include "storage/rowset/rowset_writer.h"
+#include "storage/rowset/rowset_writer_context.h"
+#include "storage/storage_engine.h"
+#include "storage/tablet.h"
+#include "storage/tablet_manager.h"
+#include "storage/tablet_updates.h"
+#include "storage/vectorized/chunk_helper.h"
+
+namespace starrocks::pipeline {
+
+class SplittableMorselQueueTest : public testing::Test {
+public:
+    void SetUp() override { _tablet = _create_tablet(10086, 1111); }
+
+    void TearDown() override {
+        if (_tablet) {
+            StorageEngine::instance()->tablet_manager()->drop_tablet(_tablet->tablet_id(), _tablet->schema_hash(),
+                                                                     false);
+            _tablet.reset();
+        }
+    }
+
+protected:
+    static TabletSharedPtr _create_tablet(int64_t tablet_id, int32_t schema_hash) {
+        TCreateTabletReq request;
+        request.tablet_id = tablet_id;
+        request.__set_version(1);
+        request.__set_version_hash(0);
+        request.tablet_schema.schema_hash = schema_hash;
+        request.tablet_schema.short_key_column_count = 1;
+        request.tablet_schema.keys_type = TKeysType::PRIMARY_KEYS;
+        request.tablet_schema.storage_type = TStorageType::COLUMN;
+
+        TColumn k1;
+        k1.column_name = "pk";
+        k1.__set_is_key(true);
+        k1.column_type.type = TPrimitiveType::BIGINT;
+        request.tablet_schema.columns.push_back(k1);
+
+        TColumn v1;
+        v1.column_name = "v1";
+        v1.__set_is_key(false);
+        v1.column_type.type = TPrimitiveType::INT;
+        request.tablet_schema.columns.push_back(v1);
+        auto st = StorageEngine::instance()->create_tablet(request);
+        CHECK(st.ok()) << st.to_string();
+        return StorageEngine::instance()->tablet_manager()->get_tablet(tablet_id, schema_hash);
+    }
+
+    // a rowset of |num_segments| segments, each of them has 10 rows.
+    RowsetSharedPtr _create_rowset(int num_segments) {
+        RowsetWriterContext writer_context(kDataFormatV2, config::storage_format_version);
+        writer_context.rowset_id = StorageEngine::instance()->next_rowset_id();
+        writer_context.tablet_id = _tablet->tablet_id();
+        writer_context.tablet_schema_hash = _tablet->schema_hash();
+        writer_context.partition_id = 0;
+        writer_context.rowset_type = BETA_ROWSET;
+        writer_context.rowset_path_prefix = _tablet->tablet_path();
+        writer_context.rowset_state = COMMITTED;
+        writer_context.tablet_schema = &_tablet->tablet_schema();
+        writer_context.version.first = 0;
+        writer_context.version.second = 0;
+        writer_context.segments_overlap = NONOVERLAPPING;
+        std::unique_ptr<RowsetWriter> writer;
+        EXPECT_TRUE(RowsetFactory::create_rowset_writer(writer_context, &writer).ok());
+        auto schema = vectorized::ChunkHelper::convert_schema(_tablet->tablet_schema());
+        for (int i = 0; i < num_segments; ++i) {
+            auto chunk = vectorized::ChunkHelper::new_chunk(schema, 10);
+            for (int64_t key = i * 10; key < i * 10 + 10; ++key) {
+                chunk->get_column_by_index(0)->append_datum(vectorized::Datum(key));
+                chunk->get_column_by_index(1)->append_datum(vectorized::Datum(static_cast<int32_t>(key)));
+            }
+            EXPECT_EQ(OLAP_SUCCESS, writer->flush_chunk(*chunk));
+        }
+        return writer->build();
+    }
+
+    Morsels _create_morsels(int64_t tablet_id, int64_t version) {
+        TScanRangeParams scan_range;
+        scan_range.scan_range.internal_scan_range.tablet_id = tablet_id;
+        scan_range.scan_range.internal_scan_range.schema_hash = std::to_string(_tablet->schema_hash());
+        scan_range.scan_range.internal_scan_range.version = std::to_string(version);
+        Morsels morsels;
+        morsels.emplace_back(std::make_unique<OlapMorsel>(1, scan_range));
+        return morsels;
+    }
+
+    TabletSharedPtr _tablet;
+};
+
+// NOLINTNEXTLINE
+TEST_F(SplittableMorselQueueTest, test_split_at_segments) {
+    ASSERT_TRUE(_tablet->rowset_commit(2, _create_rowset(3)).ok());
+
+    SplittableMorselQueue queue(_create_morsels(_tablet->tablet_id(), 2), 2);
+    ASSERT_TRUE(queue.init().ok());
+    ASSERT_EQ(3, queue.num_morsels());
+
+    // a half of the remaining segments every time.
+    std::vector<std::pair<int64_t, int64_t>> ranges;
+    while (auto morsel = queue.try_get()) {
+        auto* olap_morsel = down_cast<OlapMorsel*>(morsel.value().get());
+        ASSERT_TRUE(olap_morsel->has_segment_range());
+        ASSERT_EQ(1, olap_morsel->rowsets().size());
+        ranges.emplace_back(olap_morsel->segment_begin(), olap_morsel->segment_end());
+    }
+    ASSERT_EQ((std::vector<std::pair<int64_t, int64_t>>{{0, 2}, {2, 3}}), ranges);
+}
+
+// NOLINTNEXTLINE
+TEST_F(SplittableMorselQueueTest, test_missing_tablet) {
+    SplittableMorselQueue queue(_create_morsels(_tablet->tablet_id() + 1, 1), 2);
+    ASSERT_FALSE(queue.init().ok());
+}
+
+// NOLINTNEXTLINE
+TEST_F(SplittableMorselQueueTest, test_missing_version) {
+    ASSERT_TRUE(_tablet->rowset_commit(2, _create_rowset(2)).ok());
+
+    // fail at once instead of waiting for a version which is never committed.
+    SplittableMorselQueue queue(_create_morsels(_tablet->tablet_id(), 3), 2);
+    auto st = queue.init();
+    ASSERT_TRUE(st.is_not_found()) << st.to_string();
+}
+
+} // namespace starrocks::pipeline
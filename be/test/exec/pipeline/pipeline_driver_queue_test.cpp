@@ -0,0 +1,218 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/pipeline_driver_queue.h"
+
+#include <gtest/gtest.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <set>
+#include <thread>
+
+#include "exec/pipeline/source_operator.h"
+#include "util/cpu_info.h"
+
+namespace starrocks::pipeline {
+
+class NoopSourceOperator final : public SourceOperator {
+public:
+    NoopSourceOperator() : SourceOperator(0, "noop_source", 0) {}
+
+    bool has_output() const override { return false; }
+    bool is_finished() const override { return true; }
+    void finish(RuntimeState* state) override {}
+    StatusOr<vectorized::ChunkPtr> pull_chunk(RuntimeState* state) override {
+        return Status::InternalError("unused");
+    }
+};
+
+static std::vector<DriverPtr> create_drivers(size_t num_drivers) {
+    Operators operators{std::make_shared<NoopSourceOperator>()};
+    std::vector<DriverPtr> drivers;
+    for (size_t i = 0; i < num_drivers; ++i) {
+        drivers.emplace_back(std::make_shared<PipelineDriver>(operators, nullptr, nullptr, i, true));
+    }
+    return drivers;
+}
+
+// NOLINTNEXTLINE
+TEST(WorkStealingDriverQueueTest, test_steal_from_other_local_queues) {
+    WorkStealingDriverQueue queue(4);
+    ASSERT_EQ(4, queue.num_local_queues());
+    auto drivers = create_drivers(8);
+    // put back by a thread which is not an executor thread, so the drivers are spread over the local queues.
+    std::thread producer([&]() {
+        for (auto& driver : drivers) {
+            queue.put_back(driver.get());
+        }
+    });
+    producer.join();
+
+    // one executor thread takes all the drivers, most of them are stolen from the other local queues.
+    std::set<DriverRawPtr> taken;
+    size_t queue_index = 0;
+    for (size_t i = 0; i < drivers.size(); ++i) {
+        auto driver = queue.take(&queue_index);
+        ASSERT_TRUE(driver.ok());
+        ASSERT_EQ(0, queue_index);
+        ASSERT_EQ(0, driver.value()->driver_acct().get_last_local_queue());
+        taken.insert(driver.value());
+    }
+    ASSERT_EQ(drivers.size(), taken.size());
+
+    queue.close();
+    ASSERT_TRUE(queue.take(&queue_index).status().is_cancelled());
+}
+
+// NOLINTNEXTLINE
+TEST(WorkStealingDriverQueueTest, test_put_back_to_last_local_queue) {
+    WorkStealingDriverQueue queue(4);
+    auto drivers = create_drivers(2);
+    auto* driver = drivers[0].get();
+    auto* new_driver = drivers[1].get();
+
+    std::thread producer([&]() { queue.put_back(driver); });
+    producer.join();
+    // the executor threads own the local queues in the order of their first take, so the driver is run by the
+    // thread of the local queue 2.
+    for (size_t i = 0; i < 2; ++i) {
+        std::thread([&]() { ASSERT_EQ(i, queue._local_queue_index()); }).join();
+    }
+    std::thread([&]() {
+        size_t queue_index = 0;
+        auto taken = queue.take(&queue_index);
+        ASSERT_TRUE(taken.ok());
+        ASSERT_EQ(driver, taken.value());
+    }).join();
+    ASSERT_EQ(2, driver->driver_acct().get_last_local_queue());
+
+    // the poller puts the driver back to the local queue of the thread that ran it instead of the next one
+    // in round-robin, which is left to the driver that has never run.
+    std::thread poller([&]() {
+        queue.put_back(driver);
+        queue.put_back(new_driver);
+    });
+    poller.join();
+    ASSERT_EQ(0, queue._local_queues[0]->num_drivers);
+    ASSERT_EQ(1, queue._local_queues[1]->num_drivers);
+    ASSERT_EQ(1, queue._local_queues[2]->num_drivers);
+    ASSERT_EQ(0, queue._local_queues[3]->num_drivers);
+    queue.close();
+}
+
+// NOLINTNEXTLINE
+TEST(WorkStealingDriverQueueTest, test_steal_order) {
+    {
+        // without pinning, the neighbours are stolen from in order.
+        WorkStealingDriverQueue queue(4);
+        ASSERT_EQ((std::vector<size_t>{2, 3, 0}), queue._local_queues[1]->steal_order);
+        ASSERT_EQ(-1, queue._local_queues[1]->core);
+        queue.close();
+    }
+
+    const size_t num_local_queues = 8;
+    WorkStealingDriverQueue queue(num_local_queues, true);
+    for (size_t i = 0; i < num_local_queues; ++i) {
+        auto* local_queue = queue._local_queues[i].get();
+        ASSERT_EQ(static_cast<int>(i % CpuInfo::num_cores()), local_queue->core);
+        const auto& steal_order = local_queue->steal_order;
+        ASSERT_EQ(num_local_queues - 1, steal_order.size());
+        ASSERT_EQ(num_local_queues - 1, std::set<size_t>(steal_order.begin(), steal_order.end()).size());
+        ASSERT_EQ(0, std::count(steal_order.begin(), steal_order.end(), i));
+        // the local queues on the same NUMA node go first.
+        const int node = CpuInfo::get_numa_node_of_core(local_queue->core);
+        auto is_local = [&](size_t j) { return CpuInfo::get_numa_node_of_core(queue._local_queues[j]->core) == node; };
+        ASSERT_TRUE(std::is_partitioned(steal_order.begin(), steal_order.end(), is_local));
+    }
+
+    // the executor thread is pinned to the core of its local queue, if the core is allowed for the process.
+    std::thread([&]() {
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        ASSERT_EQ(0, pthread_getaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set));
+        const int core = queue._local_queues[queue._local_queue_index()]->core;
+        if (!CPU_ISSET(core, &cpu_set)) {
+            return;
+        }
+        CPU_ZERO(&cpu_set);
+        ASSERT_EQ(0, pthread_getaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set));
+        ASSERT_EQ(1, CPU_COUNT(&cpu_set));
+        ASSERT_TRUE(CPU_ISSET(core, &cpu_set));
+    }).join();
+    queue.close();
+}
+
+// NOLINTNEXTLINE
+TEST(WorkStealingDriverQueueTest, test_choose_level_by_accumulated_time) {
+    WorkStealingDriverQueue queue(1);
+    auto drivers = create_drivers(2);
+    auto* level0 = drivers[0].get();
+    auto* level1 = drivers[1].get();
+    level1->driver_acct().increment_schedule_times();
+    ASSERT_EQ(0, level0->driver_acct().get_level());
+    ASSERT_EQ(1, level1->driver_acct().get_level());
+
+    // the level 0 has run for much longer than the level 1, so the driver of the level 1 goes first.
+    level0->driver_acct().update_last_time_spent(1000000000L);
+    queue.get_sub_queue(0)->update_accu_time(level0);
+    queue.put_back(level0);
+    queue.put_back(level1);
+
+    size_t queue_index = 0;
+    auto driver = queue.take(&queue_index);
+    ASSERT_TRUE(driver.ok());
+    ASSERT_EQ(level1, driver.value());
+    ASSERT_EQ(1, queue_index);
+    driver = queue.take(&queue_index);
+    ASSERT_TRUE(driver.ok());
+    ASSERT_EQ(level0, driver.value());
+    ASSERT_EQ(0, queue_index);
+    queue.close();
+}
+
+// NOLINTNEXTLINE
+TEST(WorkStealingDriverQueueTest, test_concurrent_take) {
+    const size_t num_workers = 4;
+    const size_t num_drivers = 1000;
+    WorkStealingDriverQueue queue(num_workers);
+    auto drivers = create_drivers(num_drivers);
+
+    std::mutex mutex;
+    std::vector<DriverRawPtr> taken;
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < num_workers; ++i) {
+        workers.emplace_back([&]() {
+            size_t queue_index = 0;
+            while (true) {
+                auto driver = queue.take(&queue_index);
+                if (!driver.ok()) {
+                    ASSERT_TRUE(driver.status().is_cancelled());
+                    return;
+                }
+                std::lock_guard<std::mutex> l(mutex);
+                taken.push_back(driver.value());
+            }
+        });
+    }
+    for (auto& driver : drivers) {
+        queue.put_back(driver.get());
+    }
+    while (true) {
+        {
+            std::lock_guard<std::mutex> l(mutex);
+            if (taken.size() == num_drivers) {
+                break;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    // the idle workers blocked in take are woken up by close.
+    queue.close();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    ASSERT_EQ(num_drivers, std::set<DriverRawPtr>(taken.begin(), taken.end()).size());
+}
+
+} // namespace starrocks::pipeline
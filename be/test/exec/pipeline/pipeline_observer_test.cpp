@@ -0,0 +1,83 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/pipeline_observer.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+namespace starrocks::pipeline {
+
+TEST(PipelineObserverTest, test_check_and_reset) {
+    PipelineObserver observer;
+    // a new observer is marked as notified, so its driver is evaluated at least once.
+    ASSERT_TRUE(observer.check_and_reset());
+    ASSERT_FALSE(observer.check_and_reset());
+
+    observer.notify();
+    ASSERT_TRUE(observer.check_and_reset());
+    ASSERT_FALSE(observer.check_and_reset());
+}
+
+TEST(PipelineObserverTest, test_notify_observers) {
+    PipelineObservable observable;
+    PipelineObserver observer1;
+    PipelineObserver observer2;
+    observer1.check_and_reset();
+    observer2.check_and_reset();
+
+    observable.add_observer(&observer1);
+    observable.add_observer(&observer2);
+    observable.notify_observers();
+    ASSERT_TRUE(observer1.check_and_reset());
+    ASSERT_TRUE(observer2.check_and_reset());
+
+    observable.clear_observers();
+    observable.notify_observers();
+    ASSERT_FALSE(observer1.check_and_reset());
+    ASSERT_FALSE(observer2.check_and_reset());
+}
+
+TEST(PipelineObserverTest, test_remove_observer) {
+    PipelineObservable observable;
+    PipelineObserver observer1;
+    PipelineObserver observer2;
+    observer1.check_and_reset();
+    observer2.check_and_reset();
+
+    observable.add_observer(&observer1);
+    observable.add_observer(&observer2);
+    // the other observers are still notified after one of them is removed.
+    observable.remove_observer(&observer1);
+    observable.notify_observers();
+    ASSERT_FALSE(observer1.check_and_reset());
+    ASSERT_TRUE(observer2.check_and_reset());
+
+    observable.remove_observer(&observer1);
+    observable.remove_observer(&observer2);
+    observable.notify_observers();
+    ASSERT_FALSE(observer2.check_and_reset());
+}
+
+TEST(PipelineObserverTest, test_concurrent_notify) {
+    PipelineObservable observable;
+    PipelineObserver observer;
+    observable.add_observer(&observer);
+    observer.check_and_reset();
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&observable]() {
+            for (int j = 0; j < 1000; ++j) {
+                observable.notify_observers();
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    ASSERT_TRUE(observer.check_and_reset());
+    ASSERT_FALSE(observer.check_and_reset());
+}
+
+} // namespace starrocks::pipeline
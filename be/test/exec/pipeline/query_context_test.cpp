@@ -0,0 +1,47 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/query_context.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "common/config.h"
+
+namespace starrocks::pipeline {
+
+// NOLINTNEXTLINE
+TEST(QueryContextTest, peak_mem_usage) {
+    QueryContext ctx;
+    ctx.update_mem_usage(100);
+    ctx.update_mem_usage(50);
+    ctx.update_mem_usage(-120);
+    ASSERT_EQ(30, ctx.mem_usage());
+    ASSERT_EQ(150, ctx.peak_mem_usage());
+    // The timeline is disabled by default.
+    ASSERT_TRUE(ctx.mem_usage_timeline().empty());
+}
+
+// NOLINTNEXTLINE
+TEST(QueryContextTest, mem_usage_timeline) {
+    auto old_interval = config::pipeline_query_mem_timeline_interval_ms;
+    config::pipeline_query_mem_timeline_interval_ms = 1;
+    QueryContext ctx;
+    for (int i = 0; i < 5; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        ctx.update_mem_usage(10);
+    }
+    config::pipeline_query_mem_timeline_interval_ms = old_interval;
+
+    auto timeline = ctx.mem_usage_timeline();
+    ASSERT_EQ(5, timeline.size());
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_EQ(10 * (i + 1), timeline[i].second);
+        if (i > 0) {
+            ASSERT_GT(timeline[i].first, timeline[i - 1].first);
+        }
+    }
+    ASSERT_NE(std::string::npos, ctx.mem_usage_timeline_string().find("ms:50"));
+}
+
+} // namespace starrocks::pipeline
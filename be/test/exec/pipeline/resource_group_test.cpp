@@ -0,0 +1,52 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/resource_group.h"
+
+#include <gtest/gtest.h>
+
+namespace starrocks::pipeline {
+
+TEST(ResourceGroupTest, test_parse_groups) {
+    std::vector<ResourceGroupPtr> groups;
+    ASSERT_TRUE(ResourceGroupManager::parse_groups("", &groups).ok());
+    ASSERT_EQ(1, groups.size());
+    ASSERT_EQ(ResourceGroupManager::DEFAULT_GROUP_NAME, groups[0]->name());
+    ASSERT_EQ(1, groups[0]->cpu_weight());
+    ASSERT_EQ(0, groups[0]->max_concurrency());
+
+    ASSERT_TRUE(ResourceGroupManager::parse_groups("interactive:8;etl:2:4;default:3", &groups).ok());
+    ASSERT_EQ(3, groups.size());
+    ASSERT_EQ(3, groups[0]->cpu_weight());
+    ASSERT_EQ("interactive", groups[1]->name());
+    ASSERT_EQ(1, groups[1]->index());
+    ASSERT_EQ(8, groups[1]->cpu_weight());
+    ASSERT_EQ(0, groups[1]->max_concurrency());
+    ASSERT_EQ("etl", groups[2]->name());
+    ASSERT_EQ(2, groups[2]->index());
+    ASSERT_EQ(2, groups[2]->cpu_weight());
+    ASSERT_EQ(4, groups[2]->max_concurrency());
+
+    ASSERT_FALSE(ResourceGroupManager::parse_groups("etl", &groups).ok());
+    ASSERT_FALSE(ResourceGroupManager::parse_groups("etl:0", &groups).ok());
+    ASSERT_FALSE(ResourceGroupManager::parse_groups("etl:x", &groups).ok());
+    ASSERT_FALSE(ResourceGroupManager::parse_groups("etl:1:-1", &groups).ok());
+    ASSERT_FALSE(ResourceGroupManager::parse_groups("etl:1;etl:2", &groups).ok());
+}
+
+TEST(ResourceGroupTest, test_max_concurrency) {
+    ResourceGroup group("etl", 1, 2, 2);
+    ASSERT_TRUE(group.try_acquire_query());
+    ASSERT_TRUE(group.try_acquire_query());
+    ASSERT_FALSE(group.try_acquire_query());
+    ASSERT_EQ(2, group.num_running_queries());
+
+    group.release_query();
+    ASSERT_TRUE(group.try_acquire_query());
+
+    ResourceGroup unlimited("default", 0, 1, 0);
+    for (int i = 0; i < 100; i++) {
+        ASSERT_TRUE(unlimited.try_acquire_query());
+    }
+}
+
+} // namespace starrocks::pipeline
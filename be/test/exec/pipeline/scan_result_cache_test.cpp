@@ -0,0 +1,124 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/scan_result_cache.h"
+
+#include <gtest/gtest.h>
+
+#include "column/chunk.h"
+#include "column/column_helper.h"
+#include "runtime/mem_tracker.h"
+
+namespace starrocks::pipeline {
+
+static vectorized::ChunkPtr create_chunk(size_t num_rows) {
+    auto column = vectorized::ColumnHelper::create_column(TypeDescriptor(TYPE_INT), false);
+    for (size_t i = 0; i < num_rows; ++i) {
+        column->append_datum(vectorized::Datum(static_cast<int32_t>(i)));
+    }
+    auto chunk = std::make_shared<vectorized::Chunk>();
+    chunk->append_column(column, 0);
+    return chunk;
+}
+
+// NOLINTNEXTLINE
+TEST(ScanResultCacheTest, test_make_key) {
+    ASSERT_EQ(ScanResultCache::make_key("scan", 1, 2), ScanResultCache::make_key("scan", 1, 2));
+    ASSERT_NE(ScanResultCache::make_key("scan", 1, 2), ScanResultCache::make_key("scan", 1, 3));
+    ASSERT_NE(ScanResultCache::make_key("scan", 1, 2), ScanResultCache::make_key("scan", 2, 2));
+    ASSERT_NE(ScanResultCache::make_key("scan", 1, 2), ScanResultCache::make_key("other", 1, 2));
+}
+
+// NOLINTNEXTLINE
+TEST(ScanResultCacheTest, test_insert_and_lookup) {
+    const std::string key = ScanResultCache::make_key("scan", 1, 2);
+    const size_t entry_bytes = key.size() + create_chunk(1000)->memory_usage();
+    ScanResultCache cache(entry_bytes * 2);
+
+    ASSERT_EQ(nullptr, cache.lookup(key));
+    cache.insert(key, {create_chunk(1000)});
+    auto chunks = cache.lookup(key);
+    ASSERT_NE(nullptr, chunks);
+    ASSERT_EQ(1, chunks->size());
+    ASSERT_EQ(1000, (*chunks)[0]->num_rows());
+    ASSERT_EQ(entry_bytes, cache.memory_usage());
+
+    // Replace the existing entry.
+    cache.insert(key, {create_chunk(10), create_chunk(20)});
+    chunks = cache.lookup(key);
+    ASSERT_EQ(2, chunks->size());
+    ASSERT_EQ(1, cache.num_entries());
+
+    // Larger than the capacity.
+    const std::string large_key = ScanResultCache::make_key("scan", 2, 2);
+    cache.insert(large_key, {create_chunk(1000), create_chunk(1000), create_chunk(1000)});
+    ASSERT_EQ(nullptr, cache.lookup(large_key));
+    ASSERT_EQ(1, cache.num_entries());
+}
+
+// NOLINTNEXTLINE
+TEST(ScanResultCacheTest, test_evict) {
+    const size_t entry_bytes = ScanResultCache::make_key("scan", 0, 1).size() + create_chunk(1000)->memory_usage();
+    ScanResultCache cache(entry_bytes * 2);
+
+    cache.insert(ScanResultCache::make_key("scan", 0, 1), {create_chunk(1000)});
+    cache.insert(ScanResultCache::make_key("scan", 1, 1), {create_chunk(1000)});
+    // Touch tablet 0, so that tablet 1 is the least recently used.
+    ASSERT_NE(nullptr, cache.lookup(ScanResultCache::make_key("scan", 0, 1)));
+    cache.insert(ScanResultCache::make_key("scan", 2, 1), {create_chunk(1000)});
+    ASSERT_EQ(2, cache.num_entries());
+    ASSERT_NE(nullptr, cache.lookup(ScanResultCache::make_key("scan", 0, 1)));
+    ASSERT_EQ(nullptr, cache.lookup(ScanResultCache::make_key("scan", 1, 1)));
+    ASSERT_NE(nullptr, cache.lookup(ScanResultCache::make_key("scan", 2, 1)));
+
+    cache.set_capacity(entry_bytes);
+    ASSERT_EQ(1, cache.num_entries());
+    ASSERT_NE(nullptr, cache.lookup(ScanResultCache::make_key("scan", 2, 1)));
+
+    cache.set_capacity(0);
+    ASSERT_EQ(0, cache.num_entries());
+    ASSERT_EQ(0, cache.memory_usage());
+}
+
+// NOLINTNEXTLINE
+TEST(ScanResultCacheTest, test_mem_tracker) {
+    MemTracker process_tracker(-1, "process");
+    MemTracker cache_tracker(-1, "scan_result_cache", &process_tracker);
+    const size_t entry_bytes = ScanResultCache::make_key("scan", 0, 1).size() + create_chunk(1000)->memory_usage();
+    ScanResultCache cache(entry_bytes * 2, &cache_tracker);
+
+    cache.insert(ScanResultCache::make_key("scan", 0, 1), {create_chunk(1000)});
+    cache.insert(ScanResultCache::make_key("scan", 1, 1), {create_chunk(1000)});
+    ASSERT_EQ(static_cast<int64_t>(entry_bytes * 2), cache_tracker.consumption());
+    ASSERT_EQ(static_cast<int64_t>(entry_bytes * 2), process_tracker.consumption());
+
+    // The evicted and replaced entries are released.
+    cache.insert(ScanResultCache::make_key("scan", 2, 1), {create_chunk(1000)});
+    cache.insert(ScanResultCache::make_key("scan", 2, 1), {create_chunk(1000)});
+    ASSERT_EQ(2, cache.num_entries());
+    ASSERT_EQ(static_cast<int64_t>(entry_bytes * 2), cache_tracker.consumption());
+
+    cache.set_capacity(0);
+    ASSERT_EQ(0, cache_tracker.consumption());
+    ASSERT_EQ(0, process_tracker.consumption());
+}
+
+// NOLINTNEXTLINE
+TEST(ScanResultCacheTest, test_skip_insert_over_mem_limit) {
+    MemTracker process_tracker(100, "process");
+    MemTracker cache_tracker(-1, "scan_result_cache", &process_tracker);
+    ScanResultCache cache(1L << 30, &cache_tracker);
+
+    // The process is out of memory, so the chunks are not cached.
+    process_tracker.consume(200);
+    cache.insert(ScanResultCache::make_key("scan", 0, 1), {create_chunk(1000)});
+    ASSERT_EQ(0, cache.num_entries());
+    ASSERT_EQ(0, cache_tracker.consumption());
+    process_tracker.release(200);
+
+    cache.insert(ScanResultCache::make_key("scan", 0, 1), {create_chunk(10)});
+    ASSERT_EQ(1, cache.num_entries());
+    ASSERT_EQ(static_cast<int64_t>(cache.memory_usage()), cache_tracker.consumption());
+    cache.set_capacity(0);
+}
+
+} // namespace starrocks::pipeline
@@ -0,0 +1,275 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <set>
+
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "exec/pipeline/set/intersect_build_sink_operator.h"
+#include "exec/pipeline/set/intersect_output_source_operator.h"
+#include "exec/pipeline/set/intersect_probe_sink_operator.h"
+#include "exprs/slot_ref.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/runtime_state.h"
+#include "util/defer_op.h"
+
+namespace starrocks::pipeline {
+
+// (k, v) of a row, k is NULL if it has no value.
+using Row = std::pair<std::optional<int32_t>, int64_t>;
+
+// select k, v from t0 intersect select k, v from t1 intersect select k, v from t2,
+// where k is INT NULL and v is BIGINT NOT NULL, with the slots 0 and 1 in every child and the dest tuple.
+class IntersectOperatorsTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        TDescriptorTableBuilder table_builder;
+        TTupleDescriptorBuilder tuple_builder;
+        tuple_builder.add_slot(TSlotDescriptorBuilder().type(TYPE_INT).column_name("k").nullable(true).build());
+        tuple_builder.add_slot(TSlotDescriptorBuilder().type(TYPE_BIGINT).column_name("v").nullable(false).build());
+        tuple_builder.build(&table_builder);
+        ASSERT_TRUE(DescriptorTbl::create(&_pool, table_builder.desc_tbl(), &_desc_tbl).ok());
+
+        _state = std::make_shared<RuntimeState>(TUniqueId(), TQueryOptions(), TQueryGlobals(), nullptr);
+        _state->init_instance_mem_tracker();
+        _state->set_desc_tbl(_desc_tbl);
+
+        for (auto& exprs : _child_exprs) {
+            exprs.push_back(_pool.add(new ExprContext(_slot_ref(TYPE_INT, 0, true))));
+            exprs.push_back(_pool.add(new ExprContext(_slot_ref(TYPE_BIGINT, 1, false))));
+        }
+        _ctx_factory = std::make_shared<IntersectPartitionContextFactory>(0, 2);
+    }
+
+protected:
+    SlotRef* _slot_ref(PrimitiveType type, SlotId slot_id, bool is_nullable) {
+        TExprNode node;
+        node.node_type = TExprNodeType::SLOT_REF;
+        node.type = TypeDescriptor(type).to_thrift();
+        node.num_children = 0;
+        node.slot_ref.slot_id = slot_id;
+        node.slot_ref.tuple_id = 0;
+        node.__isset.slot_ref = true;
+        node.is_nullable = is_nullable;
+        return _pool.add(new SlotRef(node));
+    }
+
+    static vectorized::ChunkPtr _create_chunk(const std::vector<Row>& rows) {
+        auto keys = vectorized::NullableColumn::create(vectorized::Int32Column::create(),
+                                                       vectorized::NullColumn::create());
+        auto values = vectorized::Int64Column::create();
+        for (const auto& [key, value] : rows) {
+            if (key.has_value()) {
+                keys->append_datum(vectorized::Datum(key.value()));
+            } else {
+                keys->append_nulls(1);
+            }
+            values->append(value);
+        }
+        auto chunk = std::make_shared<vectorized::Chunk>();
+        chunk->append_column(keys, 0);
+        chunk->append_column(values, 1);
+        return chunk;
+    }
+
+    std::shared_ptr<IntersectBuildSinkOperator> _create_build(int32_t partition) {
+        auto op = std::make_shared<IntersectBuildSinkOperator>(1, 1, _ctx_factory->get_or_create(partition),
+                                                               _child_exprs[0]);
+        EXPECT_TRUE(op->prepare(_state.get()).ok());
+        return op;
+    }
+
+    std::shared_ptr<IntersectProbeSinkOperator> _create_probe(int32_t partition, size_t child_idx) {
+        auto op = std::make_shared<IntersectProbeSinkOperator>(1 + child_idx, 1, _ctx_factory->get_or_create(partition),
+                                                               _child_exprs[child_idx], child_idx);
+        EXPECT_TRUE(op->prepare(_state.get()).ok());
+        return op;
+    }
+
+    std::shared_ptr<IntersectOutputSourceOperator> _create_output(int32_t partition) {
+        auto op = std::make_shared<IntersectOutputSourceOperator>(4, 1, _ctx_factory->get_or_create(partition));
+        EXPECT_TRUE(op->prepare(_state.get()).ok());
+        return op;
+    }
+
+    std::set<Row> _pull_rows(IntersectOutputSourceOperator* output) {
+        std::set<Row> rows;
+        while (!output->is_finished()) {
+            EXPECT_TRUE(output->has_output());
+            auto chunk = output->pull_chunk(_state.get());
+            EXPECT_TRUE(chunk.ok());
+            EXPECT_LE(chunk.value()->num_rows(), static_cast<size_t>(config::vector_chunk_size));
+            const auto& keys = chunk.value()->get_column_by_slot_id(0);
+            const auto& values = chunk.value()->get_column_by_slot_id(1);
+            // the nullability of the dest columns follows the exprs of the first child.
+            EXPECT_TRUE(keys->is_nullable());
+            EXPECT_FALSE(values->is_nullable());
+            for (size_t i = 0; i < chunk.value()->num_rows(); ++i) {
+                auto key = keys->get(i);
+                Row row(key.is_null() ? std::nullopt : std::optional<int32_t>(key.get_int32()),
+                        values->get(i).get_int64());
+                EXPECT_TRUE(rows.insert(row).second);
+            }
+        }
+        return rows;
+    }
+
+    ObjectPool _pool;
+    DescriptorTbl* _desc_tbl = nullptr;
+    std::shared_ptr<RuntimeState> _state;
+    std::vector<ExprContext*> _child_exprs[3];
+    IntersectPartitionContextFactoryPtr _ctx_factory;
+};
+
+// NOLINTNEXTLINE
+TEST_F(IntersectOperatorsTest, test_multiple_children) {
+    auto build = _create_build(0);
+    auto probe1 = _create_probe(0, 1);
+    auto probe2 = _create_probe(0, 2);
+    auto output = _create_output(0);
+
+    // every PROBE and OUTPUT wait for the previous ones.
+    ASSERT_TRUE(build->need_input());
+    ASSERT_FALSE(probe1->need_input());
+    ASSERT_FALSE(probe1->is_finished());
+    ASSERT_FALSE(probe2->need_input());
+    ASSERT_FALSE(output->has_output());
+    ASSERT_FALSE(output->is_finished());
+
+    ASSERT_TRUE(build->push_chunk(_state.get(), _create_chunk({{1, 10}, {2, 20}, {std::nullopt, 30}})).ok());
+    ASSERT_TRUE(build->push_chunk(_state.get(), _create_chunk({{3, 30}, {1, 10}, {std::nullopt, 40}})).ok());
+    build->finish(_state.get());
+    ASSERT_TRUE(build->is_finished());
+    ASSERT_TRUE(probe1->need_input());
+    ASSERT_FALSE(probe2->need_input());
+
+    // the NULL keys are equal to each other, the same as DISTINCT.
+    ASSERT_TRUE(probe1->push_chunk(_state.get(), _create_chunk({{1, 10}, {std::nullopt, 30}, {3, 30}})).ok());
+    ASSERT_TRUE(probe1->push_chunk(_state.get(), _create_chunk({{4, 40}, {1, 10}, {1, 11}})).ok());
+    probe1->finish(_state.get());
+    ASSERT_TRUE(probe2->need_input());
+    ASSERT_FALSE(output->has_output());
+
+    // (2, 20) is hit by the last child only, and (3, 30) by the first two ones only.
+    ASSERT_TRUE(probe2->push_chunk(_state.get(), _create_chunk({{std::nullopt, 30}, {2, 20}, {3, 31}})).ok());
+    ASSERT_TRUE(probe2->push_chunk(_state.get(), _create_chunk({{1, 10}, {std::nullopt, 40}})).ok());
+    probe2->finish(_state.get());
+    ASSERT_TRUE(output->has_output());
+
+    std::set<Row> expected{{1, 10}, {std::nullopt, 30}};
+    ASSERT_EQ(expected, _pull_rows(output.get()));
+    ASSERT_TRUE(output->close(_state.get()).ok());
+}
+
+// NOLINTNEXTLINE
+TEST_F(IntersectOperatorsTest, test_small_output_chunks) {
+    int32_t old_chunk_size = config::vector_chunk_size;
+    config::vector_chunk_size = 4;
+    DeferOp defer([&]() { config::vector_chunk_size = old_chunk_size; });
+
+    auto build = _create_build(0);
+    auto probe1 = _create_probe(0, 1);
+    auto probe2 = _create_probe(0, 2);
+    auto output = _create_output(0);
+
+    // chunk i has the rows (i * 4 + j, j) for j in [0, 4), and only the odd chunks are hit by the last child.
+    std::vector<std::vector<Row>> chunks(5);
+    std::set<Row> expected;
+    for (int32_t i = 0; i < 5; ++i) {
+        for (int32_t j = 0; j < 4; ++j) {
+            chunks[i].emplace_back(i * 4 + j, j);
+        }
+        if (i % 2 == 1) {
+            expected.insert(chunks[i].begin(), chunks[i].end());
+        }
+    }
+    for (const auto& rows : chunks) {
+        ASSERT_TRUE(build->push_chunk(_state.get(), _create_chunk(rows)).ok());
+    }
+    build->finish(_state.get());
+    for (const auto& rows : chunks) {
+        ASSERT_TRUE(probe1->push_chunk(_state.get(), _create_chunk(rows)).ok());
+    }
+    probe1->finish(_state.get());
+    for (size_t i = 1; i < chunks.size(); i += 2) {
+        ASSERT_TRUE(probe2->push_chunk(_state.get(), _create_chunk(chunks[i])).ok());
+    }
+    probe2->finish(_state.get());
+
+    // the 8 rows are output by more than one chunk.
+    ASSERT_EQ(expected, _pull_rows(output.get()));
+}
+
+// NOLINTNEXTLINE
+TEST_F(IntersectOperatorsTest, test_child_without_rows) {
+    auto build = _create_build(0);
+    auto probe1 = _create_probe(0, 1);
+    auto probe2 = _create_probe(0, 2);
+    auto output = _create_output(0);
+
+    ASSERT_TRUE(build->push_chunk(_state.get(), _create_chunk({{1, 10}, {2, 20}})).ok());
+    build->finish(_state.get());
+    // the second child has no rows, so nothing is hit by all the children.
+    probe1->finish(_state.get());
+    ASSERT_TRUE(probe2->push_chunk(_state.get(), _create_chunk({{1, 10}, {2, 20}})).ok());
+    probe2->finish(_state.get());
+
+    ASSERT_TRUE(_pull_rows(output.get()).empty());
+}
+
+// NOLINTNEXTLINE
+TEST_F(IntersectOperatorsTest, test_finish_probes_early_for_empty_build) {
+    auto build = _create_build(0);
+    auto probe1 = _create_probe(0, 1);
+    auto probe2 = _create_probe(0, 2);
+    auto output = _create_output(0);
+
+    build->finish(_state.get());
+    // the PROBE of the next child is finished without any input once the hash set is known to be empty,
+    // and the driver finishes it then.
+    ASSERT_FALSE(probe1->need_input());
+    ASSERT_TRUE(probe1->is_finished());
+    ASSERT_FALSE(probe2->is_finished());
+    probe1->finish(_state.get());
+    ASSERT_FALSE(probe2->need_input());
+    ASSERT_TRUE(probe2->is_finished());
+    ASSERT_FALSE(output->is_finished());
+    probe2->finish(_state.get());
+
+    ASSERT_FALSE(output->has_output());
+    ASSERT_TRUE(output->is_finished());
+}
+
+// NOLINTNEXTLINE
+TEST_F(IntersectOperatorsTest, test_partitions) {
+    // each partition has its own hash set, shared by the BUILD, PROBEs and OUTPUT of the partition.
+    ASSERT_EQ(_ctx_factory->get_or_create(0), _ctx_factory->get_or_create(0));
+    ASSERT_NE(_ctx_factory->get_or_create(0), _ctx_factory->get_or_create(1));
+
+    std::vector<std::shared_ptr<IntersectBuildSinkOperator>> builds{_create_build(0), _create_build(1)};
+    std::vector<std::shared_ptr<IntersectProbeSinkOperator>> probe1s{_create_probe(0, 1), _create_probe(1, 1)};
+    std::vector<std::shared_ptr<IntersectProbeSinkOperator>> probe2s{_create_probe(0, 2), _create_probe(1, 2)};
+    std::vector<std::shared_ptr<IntersectOutputSourceOperator>> outputs{_create_output(0), _create_output(1)};
+
+    ASSERT_TRUE(builds[0]->push_chunk(_state.get(), _create_chunk({{1, 10}})).ok());
+    ASSERT_TRUE(builds[1]->push_chunk(_state.get(), _create_chunk({{2, 20}})).ok());
+    builds[0]->finish(_state.get());
+    builds[1]->finish(_state.get());
+    // the partition 1 is still waiting for its second child, it does not block the partition 0.
+    ASSERT_TRUE(probe1s[0]->push_chunk(_state.get(), _create_chunk({{1, 10}, {2, 20}})).ok());
+    probe1s[0]->finish(_state.get());
+    ASSERT_TRUE(probe2s[0]->push_chunk(_state.get(), _create_chunk({{1, 10}})).ok());
+    probe2s[0]->finish(_state.get());
+    ASSERT_FALSE(outputs[1]->has_output());
+    ASSERT_EQ((std::set<Row>{{1, 10}}), _pull_rows(outputs[0].get()));
+
+    ASSERT_TRUE(probe1s[1]->push_chunk(_state.get(), _create_chunk({{2, 20}})).ok());
+    probe1s[1]->finish(_state.get());
+    ASSERT_TRUE(probe2s[1]->push_chunk(_state.get(), _create_chunk({{2, 20}})).ok());
+    probe2s[1]->finish(_state.get());
+    ASSERT_EQ((std::set<Row>{{2, 20}}), _pull_rows(outputs[1].get()));
+}
+
+} // namespace starrocks::pipeline
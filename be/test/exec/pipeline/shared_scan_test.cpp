@@ -0,0 +1,146 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/pipeline/shared_scan.h"
+
+#include <gtest/gtest.h>
+
+#include "column/chunk.h"
+#include "column/datum.h"
+#include "column/field.h"
+#include "column/schema.h"
+#include "runtime/global_dicts.h"
+
+namespace starrocks::pipeline {
+
+// Output the chunks of one row 0, 1, ..., |num_chunks| - 1.
+class CountingIterator final : public vectorized::ChunkIterator {
+public:
+    CountingIterator(vectorized::Schema schema, int32_t num_chunks)
+            : ChunkIterator(std::move(schema)), _num_chunks(num_chunks) {}
+
+    void close() override {}
+
+protected:
+    Status do_get_next(vectorized::Chunk* chunk) override {
+        if (_next >= _num_chunks) {
+            return Status::EndOfFile("no more chunks");
+        }
+        chunk->get_column_by_index(0)->append_datum(vectorized::Datum(_next++));
+        return Status::OK();
+    }
+
+private:
+    const int32_t _num_chunks;
+    int32_t _next = 0;
+};
+
+static std::shared_ptr<SharedScan> create_shared_scan(int32_t num_chunks) {
+    auto field = std::make_shared<vectorized::Field>(0, "c0", OLAP_FIELD_TYPE_INT, false);
+    vectorized::Schema schema(vectorized::Fields{field});
+    auto open = [schema, num_chunks]() -> StatusOr<vectorized::ChunkIteratorPtr> {
+        vectorized::ChunkIteratorPtr iter = std::make_shared<CountingIterator>(schema, num_chunks);
+        RETURN_IF_ERROR(iter->init_encoded_schema(EMPTY_GLOBAL_DICTMAPS));
+        return iter;
+    };
+    return std::make_shared<SharedScan>(schema, 1, open);
+}
+
+static StatusOr<int32_t> read_value(SharedScan* scan, int64_t reader_id) {
+    vectorized::ChunkPtr chunk;
+    RETURN_IF_ERROR(scan->get_next(reader_id, &chunk));
+    return chunk->get_column_by_index(0)->get(0).get_int32();
+}
+
+// NOLINTNEXTLINE
+TEST(SharedScanTest, test_one_reader) {
+    auto scan = create_shared_scan(5);
+    int64_t reader = scan->attach();
+    for (int32_t i = 0; i < 5; ++i) {
+        auto value = read_value(scan.get(), reader);
+        ASSERT_TRUE(value.ok());
+        ASSERT_EQ(i, value.value());
+    }
+    ASSERT_TRUE(read_value(scan.get(), reader).status().is_end_of_file());
+    ASSERT_EQ(1, scan->num_passes());
+    scan->detach(reader);
+}
+
+// NOLINTNEXTLINE
+TEST(SharedScanTest, test_join_in_the_middle) {
+    auto scan = create_shared_scan(10);
+    int64_t first = scan->attach();
+    std::vector<int32_t> first_values;
+    for (int i = 0; i < 3; ++i) {
+        first_values.push_back(read_value(scan.get(), first).value());
+    }
+
+    // reads 3, 4, ..., 9 with the first reader, and then 0, 1, 2 in the next pass.
+    int64_t second = scan->attach();
+    std::vector<int32_t> second_values;
+    while (true) {
+        auto value = read_value(scan.get(), second);
+        if (!value.ok()) {
+            ASSERT_TRUE(value.status().is_end_of_file());
+            break;
+        }
+        second_values.push_back(value.value());
+    }
+    ASSERT_EQ((std::vector<int32_t>{3, 4, 5, 6, 7, 8, 9, 0, 1, 2}), second_values);
+    ASSERT_EQ(2, scan->num_passes());
+
+    // the chunks read by the second reader are kept for the first one.
+    while (true) {
+        auto value = read_value(scan.get(), first);
+        if (!value.ok()) {
+            ASSERT_TRUE(value.status().is_end_of_file());
+            break;
+        }
+        first_values.push_back(value.value());
+    }
+    ASSERT_EQ((std::vector<int32_t>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}), first_values);
+    ASSERT_EQ(2, scan->num_passes());
+
+    scan->detach(first);
+    scan->detach(second);
+}
+
+// NOLINTNEXTLINE
+TEST(SharedScanTest, test_attach_between_passes) {
+    auto scan = create_shared_scan(3);
+    int64_t first = scan->attach();
+    for (int32_t i = 0; i < 3; ++i) {
+        ASSERT_EQ(i, read_value(scan.get(), first).value());
+    }
+    ASSERT_TRUE(read_value(scan.get(), first).status().is_end_of_file());
+    scan->detach(first);
+
+    int64_t second = scan->attach();
+    for (int32_t i = 0; i < 3; ++i) {
+        ASSERT_EQ(i, read_value(scan.get(), second).value());
+    }
+    ASSERT_TRUE(read_value(scan.get(), second).status().is_end_of_file());
+    ASSERT_EQ(2, scan->num_passes());
+    scan->detach(second);
+}
+
+// NOLINTNEXTLINE
+TEST(SharedScanTest, test_mgr) {
+    auto* mgr = SharedScanMgr::instance();
+    const std::string key = SharedScanMgr::make_key(1, 2, {0, 1}, true);
+    ASSERT_NE(key, SharedScanMgr::make_key(1, 3, {0, 1}, true));
+    ASSERT_NE(key, SharedScanMgr::make_key(1, 2, {0}, true));
+    ASSERT_NE(key, SharedScanMgr::make_key(1, 2, {0, 1}, false));
+
+    auto scan = create_shared_scan(1);
+    auto open = []() -> StatusOr<vectorized::ChunkIteratorPtr> { return Status::InternalError("unused"); };
+    auto first = mgr->get_or_create(key, scan->schema(), 1, open);
+    auto second = mgr->get_or_create(key, scan->schema(), 1, open);
+    ASSERT_EQ(first.get(), second.get());
+    first.reset();
+    second.reset();
+    // a new scan once the previous one is released by all its readers, which fails to open.
+    auto third = mgr->get_or_create(key, scan->schema(), 1, open);
+    ASSERT_FALSE(read_value(third.get(), third->attach()).ok());
+}
+
+} // namespace starrocks::pipeline
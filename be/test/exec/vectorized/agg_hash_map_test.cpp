@@ -8,6 +8,7 @@
 #include <variant>
 
 #include "exec/vectorized/aggregate/agg_hash_set.h"
+#include "exec/vectorized/aggregate/agg_hash_variant.h"
 
 namespace starrocks {
 namespace vectorized {
@@ -203,5 +204,42 @@ TEST(HashMapTest, TwoLevelConvert) {
     }
 }
 
+TEST(HashMapTest, TwoLevelNumberKey) {
+    auto column = Int64Column::create();
+    for (int i = 0; i < 4096; i++) {
+        column->append(i % 1000);
+    }
+    Columns key_columns{column};
+
+    std::vector<int64_t> states(2000, 0);
+    size_t num_states = 0;
+    auto allocate_func = [&]() { return (AggDataPtr)&states[num_states++]; };
+
+    Int64AggHashMapWithOneNumberKey<PhmapSeed1> hash_map;
+    Int64TwoLevelAggHashMapWithOneNumberKey<PhmapSeed1> two_level_hash_map;
+    Buffer<AggDataPtr> agg_states(column->size());
+    Buffer<AggDataPtr> two_level_agg_states(column->size());
+    hash_map.compute_agg_states(column->size(), key_columns, nullptr, allocate_func, &agg_states);
+    two_level_hash_map.compute_agg_states(column->size(), key_columns, nullptr, allocate_func, &two_level_agg_states);
+
+    ASSERT_EQ(1000, hash_map.hash_map.size());
+    ASSERT_EQ(1000, two_level_hash_map.hash_map.size());
+    ASSERT_EQ(2000, num_states);
+    for (size_t i = 0; i < column->size(); i++) {
+        // The same key always gets the same state.
+        ASSERT_EQ(agg_states[i % 1000], agg_states[i]);
+        ASSERT_EQ(two_level_agg_states[i % 1000], two_level_agg_states[i]);
+        ASSERT_EQ(agg_states[i], hash_map.hash_map[i % 1000]);
+        ASSERT_EQ(two_level_agg_states[i], two_level_hash_map.hash_map[i % 1000]);
+    }
+
+    // Converting keeps all the states.
+    Int64TwoLevelAggHashMapWithOneNumberKey<PhmapSeed1> converted;
+    converted.hash_map.insert(hash_map.hash_map.begin(), hash_map.hash_map.end());
+    for (int64_t key = 0; key < 1000; key++) {
+        ASSERT_EQ(hash_map.hash_map[key], converted.hash_map[key]);
+    }
+}
+
 } // namespace vectorized
 } // namespace starrocks
@@ -0,0 +1,182 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/aggregator.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+
+#include "column/chunk.h"
+#include "column/fixed_length_column.h"
+#include "exec/pipeline/aggregate/aggregate_blocking_sink_operator.h"
+#include "exec/pipeline/aggregate/aggregate_blocking_source_operator.h"
+#include "runtime/descriptor_helper.h"
+
+namespace starrocks::vectorized {
+
+// select k, sum(v) from t group by k, where k is INT and v is BIGINT.
+class AggregatorSpillTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        _old_partition_num = config::agg_spill_partition_num;
+        _old_mem_limit_bytes = config::agg_spill_mem_limit_bytes;
+        config::agg_spill_partition_num = 4;
+        // spill after every chunk.
+        config::agg_spill_mem_limit_bytes = 0;
+
+        TDescriptorTableBuilder table_builder;
+        for (int i = 0; i < 2; ++i) {
+            TTupleDescriptorBuilder tuple_builder;
+            tuple_builder.add_slot(TSlotDescriptorBuilder().type(TYPE_INT).column_name("k").nullable(false).build());
+            tuple_builder.add_slot(TSlotDescriptorBuilder().type(TYPE_BIGINT).column_name("v").nullable(false).build());
+            tuple_builder.build(&table_builder);
+        }
+        ASSERT_TRUE(DescriptorTbl::create(&_pool, table_builder.desc_tbl(), &_desc_tbl).ok());
+        _state = _create_state(true);
+
+        _tnode.node_id = 1;
+        _tnode.node_type = TPlanNodeType::AGGREGATION_NODE;
+        _tnode.limit = -1;
+        _tnode.agg_node.need_finalize = true;
+        _tnode.agg_node.intermediate_tuple_id = 1;
+        _tnode.agg_node.output_tuple_id = 1;
+        _tnode.agg_node.grouping_exprs.push_back(_slot_ref(TYPE_INT, 0));
+
+        TExprNode sum;
+        sum.node_type = TExprNodeType::AGG_EXPR;
+        sum.type = TypeDescriptor(TYPE_BIGINT).to_thrift();
+        sum.num_children = 1;
+        sum.fn.name.function_name = "sum";
+        sum.fn.arg_types.push_back(TypeDescriptor(TYPE_BIGINT).to_thrift());
+        sum.fn.ret_type = TypeDescriptor(TYPE_BIGINT).to_thrift();
+        sum.fn.aggregate_fn.intermediate_type = TypeDescriptor(TYPE_BIGINT).to_thrift();
+        sum.agg_expr.is_merge_agg = false;
+        sum.has_nullable_child = false;
+        sum.is_nullable = true;
+        TExpr sum_expr;
+        sum_expr.nodes.push_back(sum);
+        sum_expr.nodes.push_back(_slot_ref(TYPE_BIGINT, 1).nodes[0]);
+        _tnode.agg_node.aggregate_functions.push_back(sum_expr);
+    }
+
+    void TearDown() override {
+        config::agg_spill_partition_num = _old_partition_num;
+        config::agg_spill_mem_limit_bytes = _old_mem_limit_bytes;
+    }
+
+protected:
+    std::shared_ptr<RuntimeState> _create_state(bool enable_spilling) {
+        TQueryOptions query_options;
+        query_options.__set_enable_spilling(enable_spilling);
+        auto state = std::make_shared<RuntimeState>(TUniqueId(), query_options, TQueryGlobals(), nullptr);
+        state->init_instance_mem_tracker();
+        state->set_desc_tbl(_desc_tbl);
+        return state;
+    }
+
+    static TExpr _slot_ref(PrimitiveType type, SlotId slot_id) {
+        TExprNode node;
+        node.node_type = TExprNodeType::SLOT_REF;
+        node.type = TypeDescriptor(type).to_thrift();
+        node.num_children = 0;
+        node.slot_ref.slot_id = slot_id;
+        node.slot_ref.tuple_id = 0;
+        node.__isset.slot_ref = true;
+        node.is_nullable = false;
+        TExpr expr;
+        expr.nodes.push_back(node);
+        return expr;
+    }
+
+    // the rows [begin, end) with k = row % num_keys and v = row.
+    static ChunkPtr _create_chunk(int64_t begin, int64_t end, int32_t num_keys) {
+        auto keys = Int32Column::create();
+        auto values = Int64Column::create();
+        for (int64_t row = begin; row < end; ++row) {
+            keys->append(static_cast<int32_t>(row % num_keys));
+            values->append(row);
+        }
+        auto chunk = std::make_shared<Chunk>();
+        chunk->append_column(keys, 0);
+        chunk->append_column(values, 1);
+        return chunk;
+    }
+
+    ObjectPool _pool;
+    DescriptorTbl* _desc_tbl = nullptr;
+    std::shared_ptr<RuntimeState> _state;
+    TPlanNode _tnode;
+    int32_t _old_partition_num = 0;
+    int64_t _old_mem_limit_bytes = 0;
+};
+
+// NOLINTNEXTLINE
+TEST_F(AggregatorSpillTest, test_spill_and_restore) {
+    const int32_t num_keys = 100;
+    const int64_t num_chunks = 10;
+    const int64_t chunk_size = 1000;
+
+    auto aggregator = std::make_shared<Aggregator>(_tnode);
+    pipeline::AggregateBlockingSinkOperator sink(0, 1, aggregator);
+    pipeline::AggregateBlockingSourceOperator source(1, 1, aggregator);
+    ASSERT_TRUE(sink.prepare(_state.get()).ok());
+    ASSERT_TRUE(source.prepare(_state.get()).ok());
+
+    std::map<int32_t, int64_t> expected;
+    for (int64_t i = 0; i < num_chunks; ++i) {
+        auto st = sink.push_chunk(_state.get(), _create_chunk(i * chunk_size, (i + 1) * chunk_size, num_keys));
+        ASSERT_TRUE(st.ok()) << st.to_string();
+    }
+    for (int64_t row = 0; row < num_chunks * chunk_size; ++row) {
+        expected[static_cast<int32_t>(row % num_keys)] += row;
+    }
+    // every chunk has been spilled and the hash map is empty.
+    ASSERT_TRUE(aggregator->has_spilled());
+    ASSERT_EQ(0, aggregator->hash_map_variant().size());
+    sink.finish(_state.get());
+
+    // every key is restored from the spilled partitions exactly once, with the states of all the chunks merged.
+    std::map<int32_t, int64_t> actual;
+    while (!source.is_finished()) {
+        ASSERT_TRUE(source.has_output());
+        auto chunk = source.pull_chunk(_state.get());
+        ASSERT_TRUE(chunk.ok()) << chunk.status().to_string();
+        for (size_t i = 0; i < chunk.value()->num_rows(); ++i) {
+            int32_t key = chunk.value()->get_column_by_index(0)->get(i).get_int32();
+            int64_t sum = chunk.value()->get_column_by_index(1)->get(i).get_int64();
+            ASSERT_TRUE(actual.emplace(key, sum).second) << "duplicate key " << key;
+        }
+    }
+    ASSERT_EQ(expected, actual);
+    ASSERT_FALSE(aggregator->has_pending_spill_partitions());
+
+    ASSERT_TRUE(source.close(_state.get()).ok());
+    ASSERT_TRUE(sink.close(_state.get()).ok());
+}
+
+// NOLINTNEXTLINE
+TEST_F(AggregatorSpillTest, test_no_spill_without_query_option) {
+    _state = _create_state(false);
+    auto aggregator = std::make_shared<Aggregator>(_tnode);
+    pipeline::AggregateBlockingSinkOperator sink(0, 1, aggregator);
+    pipeline::AggregateBlockingSourceOperator source(1, 1, aggregator);
+    ASSERT_TRUE(sink.prepare(_state.get()).ok());
+    ASSERT_TRUE(source.prepare(_state.get()).ok());
+
+    ASSERT_TRUE(sink.push_chunk(_state.get(), _create_chunk(0, 1000, 10)).ok());
+    ASSERT_FALSE(aggregator->has_spilled());
+    ASSERT_EQ(10, aggregator->hash_map_variant().size());
+    sink.finish(_state.get());
+
+    size_t num_rows = 0;
+    while (!source.is_finished()) {
+        auto chunk = source.pull_chunk(_state.get());
+        ASSERT_TRUE(chunk.ok());
+        num_rows += chunk.value()->num_rows();
+    }
+    ASSERT_EQ(10, num_rows);
+    ASSERT_TRUE(source.close(_state.get()).ok());
+    ASSERT_TRUE(sink.close(_state.get()).ok());
+}
+
+} // namespace starrocks::vectorized
@@ -4,9 +4,14 @@
 
 #include "column/column_helper.h"
 #include "column/datum_tuple.h"
+#include "exec/pipeline/sort/sort_context.h"
 #include "exec/vectorized/chunks_sorter_full_sort.h"
+#include "exec/vectorized/chunks_sorter_heap_sort.h"
 #include "exec/vectorized/chunks_sorter_topn.h"
 #include "exprs/slot_ref.h"
+#include "exprs/vectorized/topn_runtime_filter.h"
+#include "runtime/mem_tracker.h"
+#include "runtime/runtime_state.h"
 
 namespace starrocks::vectorized {
 
@@ -441,4 +446,298 @@ TEST_F(ChunksSorterTest, order_by_with_unequal_sized_chunks) {
     clear_sort_exprs(sort_exprs);
 }
 
+// NOLINTNEXTLINE
+TEST_F(ChunksSorterTest, heap_sort_small_limit) {
+    std::vector<bool> is_asc{false, false};
+    std::vector<bool> is_null_first{false, false};
+    std::vector<ExprContext*> sort_exprs;
+    sort_exprs.push_back(new ExprContext(_expr_nation.get()));
+    sort_exprs.push_back(new ExprContext(_expr_cust_key.get()));
+
+    // nation desc: SAUDI ARABIA, JORDAN, IRAQ, IRAN, EGYPT, NULL.
+    ChunksSorterHeapSort sorter(&sort_exprs, &is_asc, &is_null_first, 1, 6);
+    sorter.update(nullptr, _chunk_1);
+    sorter.update(nullptr, _chunk_2);
+    sorter.update(nullptr, _chunk_3);
+    sorter.done(nullptr);
+
+    bool eos = false;
+    ChunkPtr page;
+    sorter.get_next(&page, &eos);
+    ASSERT_FALSE(eos);
+    ASSERT_EQ(6, page->num_rows());
+    const std::vector<int32_t> expected = {58, 24, 12, 2, 52, 56};
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(expected[i], page->get(i).get(0).get_int32());
+    }
+    sorter.get_next(&page, &eos);
+    ASSERT_TRUE(eos);
+    clear_sort_exprs(sort_exprs);
+
+    // the integer column is filtered by the boundary in the fast path.
+    sort_exprs.push_back(new ExprContext(_expr_cust_key.get()));
+    is_asc = {true};
+    is_null_first = {false};
+    ChunksSorterHeapSort sorter2(&sort_exprs, &is_asc, &is_null_first, 2, 3);
+    TopNRuntimeFilter filter(0, TYPE_INT, true);
+    sorter2.set_runtime_filter(&filter);
+    sorter2.update(nullptr, _chunk_3);
+    sorter2.update(nullptr, _chunk_1);
+    sorter2.update(nullptr, _chunk_2);
+    TCondition cond;
+    ASSERT_TRUE(filter.get_condition("cust_key", &cond));
+    ASSERT_EQ("<=", cond.condition_op);
+    ASSERT_EQ(std::vector<std::string>{"16"}, cond.condition_values);
+    sorter2.done(nullptr);
+
+    ASSERT_TRUE(sorter2.pull_chunk(&page));
+    ASSERT_EQ(3, page->num_rows());
+    ASSERT_EQ(6, page->get(0).get(0).get_int32());
+    ASSERT_EQ(12, page->get(1).get(0).get_int32());
+    ASSERT_EQ(16, page->get(2).get(0).get_int32());
+    clear_sort_exprs(sort_exprs);
+}
+
+// NOLINTNEXTLINE
+TEST_F(ChunksSorterTest, topn_publish_runtime_filter) {
+    std::vector<bool> is_asc{false};
+    std::vector<bool> is_null_first{false};
+    std::vector<ExprContext*> sort_exprs;
+    sort_exprs.push_back(new ExprContext(_expr_cust_key.get()));
+
+    TopNRuntimeFilter filter(0, TYPE_INT, false);
+    TCondition cond;
+    ASSERT_FALSE(filter.get_condition("cust_key", &cond));
+
+    // sort every chunk, and keep the top 1 + 3 rows.
+    ChunksSorterTopn sorter(&sort_exprs, &is_asc, &is_null_first, 1, 3, 1);
+    sorter.set_runtime_filter(&filter);
+    sorter.update(nullptr, _chunk_1);
+    ASSERT_TRUE(filter.get_condition("cust_key", &cond));
+    ASSERT_EQ("cust_key", cond.column_name);
+    ASSERT_EQ(">=", cond.condition_op);
+    ASSERT_EQ(std::vector<std::string>{"41"}, cond.condition_values);
+    ASSERT_TRUE(cond.is_index_filter_only);
+
+    sorter.update(nullptr, _chunk_2);
+    sorter.update(nullptr, _chunk_3);
+    sorter.done(nullptr);
+    ASSERT_TRUE(filter.get_condition("cust_key", &cond));
+    ASSERT_EQ(std::vector<std::string>{"58"}, cond.condition_values);
+
+    clear_sort_exprs(sort_exprs);
+}
+
+// NOLINTNEXTLINE
+TEST_F(ChunksSorterTest, merge_sorted_runs_of_drivers) {
+    std::vector<bool> is_asc, is_null_first;
+    is_asc.push_back(false); // region
+    is_asc.push_back(true);  // cust_key
+    is_null_first.push_back(true);
+    is_null_first.push_back(true);
+    std::vector<ExprContext*> sort_exprs;
+    sort_exprs.push_back(new ExprContext(_expr_region.get()));
+    sort_exprs.push_back(new ExprContext(_expr_cust_key.get()));
+
+    // One sorter per driver, and the last driver gets no input.
+    std::vector<ChunkPtr> inputs = {_chunk_1, _chunk_2, _chunk_3, nullptr};
+    std::vector<std::shared_ptr<ChunksSorter>> sorters;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        sorters.emplace_back(std::make_shared<ChunksSorterFullSort>(&sort_exprs, &is_asc, &is_null_first, 2));
+    }
+    pipeline::SortContext sort_context(std::move(sorters), &sort_exprs, &is_asc, &is_null_first);
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        ASSERT_FALSE(sort_context.is_sink_complete(0));
+        const auto& sorter = sort_context.chunks_sorter(i);
+        if (inputs[i] != nullptr) {
+            ASSERT_TRUE(sorter->update(nullptr, inputs[i]).ok());
+        }
+        ASSERT_TRUE(sorter->finish(nullptr).ok());
+        sort_context.finish_one_sink(i);
+    }
+    ASSERT_TRUE(sort_context.is_sink_complete(0));
+
+    std::vector<int32_t> cust_keys;
+    bool eos = false;
+    while (!eos) {
+        ChunkPtr chunk;
+        eos = sort_context.pull_chunk(0, &chunk);
+        ASSERT_TRUE(sort_context.status().ok());
+        for (size_t i = 0; chunk != nullptr && i < chunk->num_rows(); ++i) {
+            cust_keys.push_back(chunk->get(i).get(0).get_int32());
+        }
+    }
+    std::vector<int32_t> expected = {69, 70, 71, 2, 4, 6, 12, 16, 24, 41, 49, 52, 54, 55, 56, 58};
+    ASSERT_EQ(expected, cust_keys);
+
+    clear_sort_exprs(sort_exprs);
+}
+
+// NOLINTNEXTLINE
+TEST_F(ChunksSorterTest, output_sorted_runs_of_partitions) {
+    std::vector<bool> is_asc, is_null_first;
+    is_asc.push_back(false); // region
+    is_asc.push_back(true);  // cust_key
+    is_null_first.push_back(true);
+    is_null_first.push_back(true);
+    std::vector<ExprContext*> sort_exprs;
+    sort_exprs.push_back(new ExprContext(_expr_region.get()));
+    sort_exprs.push_back(new ExprContext(_expr_cust_key.get()));
+
+    std::vector<ChunkPtr> inputs = {_chunk_1, _chunk_2};
+    std::vector<std::shared_ptr<ChunksSorter>> sorters;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        sorters.emplace_back(std::make_shared<ChunksSorterFullSort>(&sort_exprs, &is_asc, &is_null_first, 2));
+    }
+    pipeline::SortContext sort_context(std::move(sorters), &sort_exprs, &is_asc, &is_null_first, true);
+
+    auto pull_cust_keys = [&sort_context](int32_t driver_sequence) {
+        std::vector<int32_t> cust_keys;
+        bool eos = false;
+        while (!eos) {
+            ChunkPtr chunk;
+            eos = sort_context.pull_chunk(driver_sequence, &chunk);
+            for (size_t i = 0; chunk != nullptr && i < chunk->num_rows(); ++i) {
+                cust_keys.push_back(chunk->get(i).get(0).get_int32());
+            }
+        }
+        return cust_keys;
+    };
+
+    // Every driver outputs its own partition once its sink has finished, regardless of the others.
+    for (int32_t driver_sequence : {1, 0}) {
+        ASSERT_FALSE(sort_context.is_sink_complete(driver_sequence));
+        const auto& sorter = sort_context.chunks_sorter(driver_sequence);
+        ASSERT_TRUE(sorter->update(nullptr, inputs[driver_sequence]).ok());
+        ASSERT_TRUE(sorter->finish(nullptr).ok());
+        sort_context.finish_one_sink(driver_sequence);
+        ASSERT_TRUE(sort_context.is_sink_complete(driver_sequence));
+        if (driver_sequence == 1) {
+            ASSERT_FALSE(sort_context.is_sink_complete(0));
+            ASSERT_EQ((std::vector<int32_t>{69, 4, 16, 49, 55}), pull_cust_keys(1));
+        } else {
+            ASSERT_EQ((std::vector<int32_t>{71, 2, 12, 41, 54, 58}), pull_cust_keys(0));
+        }
+    }
+    ASSERT_TRUE(sort_context.status().ok());
+
+    clear_sort_exprs(sort_exprs);
+}
+
+// NOLINTNEXTLINE
+TEST_F(ChunksSorterTest, full_sort_spill_sorted_runs) {
+    std::vector<bool> is_asc, is_null_first;
+    is_asc.push_back(false); // region
+    is_asc.push_back(true);  // cust_key
+    is_null_first.push_back(true);
+    is_null_first.push_back(true);
+    std::vector<ExprContext*> sort_exprs;
+    sort_exprs.push_back(new ExprContext(_expr_region.get()));
+    sort_exprs.push_back(new ExprContext(_expr_cust_key.get()));
+
+    TQueryOptions query_options;
+    query_options.__set_enable_spilling(true);
+    RuntimeState state(TUniqueId(), query_options, TQueryGlobals(), nullptr);
+    state.init_instance_mem_tracker();
+    MemTracker mem_tracker;
+    RuntimeProfile profile("ChunksSorterFullSort");
+    ADD_TIMER(&profile, "ChunksSorter");
+
+    // every chunk is spilled as a sorted run, and the runs are merged in done().
+    int64_t old_mem_limit_bytes = config::sort_spill_mem_limit_bytes;
+    config::sort_spill_mem_limit_bytes = 0;
+    ChunksSorterFullSort sorter(&sort_exprs, &is_asc, &is_null_first, 2);
+    sorter.setup_runtime(&mem_tracker, &profile, "ChunksSorter");
+    ASSERT_TRUE(sorter.update(&state, _chunk_1).ok());
+    ASSERT_TRUE(sorter.update(&state, _chunk_2).ok());
+    ASSERT_TRUE(sorter.update(&state, _chunk_3).ok());
+    ASSERT_TRUE(sorter.done(&state).ok());
+    config::sort_spill_mem_limit_bytes = old_mem_limit_bytes;
+    ASSERT_EQ(3, profile.get_counter("SpillRuns")->value());
+    ASSERT_EQ(16, profile.get_counter("SpillRows")->value());
+
+    std::vector<int32_t> cust_keys;
+    bool eos = false;
+    while (!eos) {
+        ChunkPtr chunk;
+        sorter.get_next(&chunk, &eos);
+        for (size_t i = 0; chunk != nullptr && i < chunk->num_rows(); ++i) {
+            cust_keys.push_back(chunk->get(i).get(0).get_int32());
+        }
+    }
+    ASSERT_TRUE(sorter.status().ok());
+    std::vector<int32_t> expected = {69, 70, 71, 2, 4, 6, 12, 16, 24, 41, 49, 52, 54, 55, 56, 58};
+    ASSERT_EQ(expected, cust_keys);
+
+    clear_sort_exprs(sort_exprs);
+}
+
+static std::vector<std::pair<Datum, Datum>> full_sort_rows(const ChunkPtr& chunk, std::vector<ExprContext*>* sort_exprs,
+                                                          std::vector<bool>* is_asc,
+                                                          std::vector<bool>* is_null_first) {
+    ChunksSorterFullSort sorter(sort_exprs, is_asc, is_null_first, 2);
+    sorter.update(nullptr, chunk);
+    sorter.done(nullptr);
+    std::vector<std::pair<Datum, Datum>> rows;
+    bool eos = false;
+    while (!eos) {
+        ChunkPtr page;
+        sorter.get_next(&page, &eos);
+        for (size_t i = 0; page != nullptr && i < page->num_rows(); ++i) {
+            rows.emplace_back(page->get(i).get(0), page->get(i).get(1));
+        }
+    }
+    return rows;
+}
+
+// NOLINTNEXTLINE
+TEST_F(ChunksSorterTest, full_sort_by_normalized_keys) {
+    auto col_a = ColumnHelper::create_column(TypeDescriptor(TYPE_INT), true);
+    auto col_b = ColumnHelper::create_column(TypeDescriptor(TYPE_BIGINT), false);
+    for (int32_t i = 0; i < 1000; ++i) {
+        if (i % 7 == 0) {
+            col_a->append_nulls(1);
+        } else {
+            col_a->append_datum(Datum(int32_t((i * 37) % 19 - 9)));
+        }
+        col_b->append_datum(Datum(int64_t((i * 101) % 53) - 26));
+    }
+    butil::FlatMap<SlotId, size_t> map;
+    map.init(4);
+    map[0] = 0;
+    map[1] = 1;
+    auto chunk = std::make_shared<Chunk>(Columns{col_a, col_b}, map);
+
+    SlotRef expr_a(TypeDescriptor(TYPE_INT), 0, 0);
+    SlotRef expr_b(TypeDescriptor(TYPE_BIGINT), 0, 1);
+    std::vector<ExprContext*> sort_exprs;
+    sort_exprs.push_back(new ExprContext(&expr_a));
+    sort_exprs.push_back(new ExprContext(&expr_b));
+
+    for (bool asc_a : {true, false}) {
+        for (bool asc_b : {true, false}) {
+            for (bool null_first : {true, false}) {
+                std::vector<bool> is_asc{asc_a, asc_b};
+                std::vector<bool> is_null_first{null_first, null_first};
+
+                config::enable_sort_normalized_keys = false;
+                auto expected = full_sort_rows(chunk, &sort_exprs, &is_asc, &is_null_first);
+                config::enable_sort_normalized_keys = true;
+                auto actual = full_sort_rows(chunk, &sort_exprs, &is_asc, &is_null_first);
+
+                ASSERT_EQ(1000, actual.size());
+                for (size_t i = 0; i < expected.size(); ++i) {
+                    ASSERT_EQ(expected[i].first.is_null(), actual[i].first.is_null());
+                    if (!expected[i].first.is_null()) {
+                        ASSERT_EQ(expected[i].first.get_int32(), actual[i].first.get_int32());
+                    }
+                    ASSERT_EQ(expected[i].second.get_int64(), actual[i].second.get_int64());
+                }
+            }
+        }
+    }
+
+    clear_sort_exprs(sort_exprs);
+}
+
 } // namespace starrocks::vectorized
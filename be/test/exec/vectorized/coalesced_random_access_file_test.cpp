@@ -0,0 +1,126 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/coalesced_random_access_file.h"
+
+#include <gtest/gtest.h>
+
+#include "env/env_memory.h"
+#include "exec/vectorized/hdfs_file_meta_cache.h"
+#include "exec/vectorized/hdfs_scanner.h"
+
+namespace starrocks::vectorized {
+
+class CountingFile final : public RandomAccessFile {
+public:
+    explicit CountingFile(std::string str) : _file(std::move(str)) {}
+
+    Status read(uint64_t offset, Slice* res) const override {
+        num_reads++;
+        return _file.read(offset, res);
+    }
+    Status read_at(uint64_t offset, const Slice& res) const override {
+        num_reads++;
+        return _file.read_at(offset, res);
+    }
+    Status readv_at(uint64_t offset, const Slice* res, size_t res_cnt) const override {
+        num_reads++;
+        return _file.readv_at(offset, res, res_cnt);
+    }
+    Status size(uint64_t* size) const override { return _file.size(size); }
+    const std::string& file_name() const override { return _file.file_name(); }
+
+    mutable int num_reads = 0;
+
+private:
+    StringRandomAccessFile _file;
+};
+
+class CoalescedRandomAccessFileTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        for (int i = 0; i < 256; i++) {
+            _data.push_back(static_cast<char>(i));
+        }
+    }
+
+protected:
+    void _check_read(const CoalescedRandomAccessFile& file, uint64_t offset, size_t size) {
+        std::string buf(size, '\0');
+        ASSERT_TRUE(file.read_at(offset, Slice(buf.data(), size)).ok());
+        ASSERT_EQ(_data.substr(offset, size), buf);
+    }
+
+    std::string _data;
+    HdfsScanStats _stats;
+};
+
+TEST_F(CoalescedRandomAccessFileTest, TestMergeRanges) {
+    CountingFile underlying(_data);
+    CoalescedRandomAccessFile file(&underlying, &_stats);
+    std::vector<CoalescedRandomAccessFile::IORange> ranges;
+    ranges.emplace_back(15, 10);
+    ranges.emplace_back(0, 10);
+    ranges.emplace_back(100, 10);
+    file.set_io_ranges(std::move(ranges), 10, 1024);
+    // [0, 10) and [15, 25) are merged, [100, 110) is left alone
+    ASSERT_EQ(1, file.num_buffers());
+
+    _check_read(file, 0, 10);
+    ASSERT_EQ(1, underlying.num_reads);
+    ASSERT_EQ(1, _stats.coalesced_io_count);
+    ASSERT_EQ(25, _stats.coalesced_io_bytes);
+
+    _check_read(file, 15, 10);
+    ASSERT_EQ(1, underlying.num_reads);
+    // all of the ranges are read, the buffer is freed
+    ASSERT_EQ(0, file.num_buffers());
+
+    _check_read(file, 100, 10);
+    ASSERT_EQ(2, underlying.num_reads);
+}
+
+TEST_F(CoalescedRandomAccessFileTest, TestMaxBufferSize) {
+    CountingFile underlying(_data);
+    CoalescedRandomAccessFile file(&underlying, &_stats);
+    std::vector<CoalescedRandomAccessFile::IORange> ranges;
+    ranges.emplace_back(0, 20);
+    ranges.emplace_back(20, 20);
+    ranges.emplace_back(40, 20);
+    ranges.emplace_back(60, 20);
+    file.set_io_ranges(std::move(ranges), 0, 40);
+    ASSERT_EQ(2, file.num_buffers());
+
+    // the reads out of the ranges go to the underlying file
+    _check_read(file, 30, 20);
+    ASSERT_EQ(1, underlying.num_reads);
+    ASSERT_EQ(0, _stats.coalesced_io_count);
+
+    _check_read(file, 40, 20);
+    _check_read(file, 60, 20);
+    ASSERT_EQ(2, underlying.num_reads);
+    ASSERT_EQ(1, file.num_buffers());
+
+    // the buffers are released by the new ranges
+    file.set_io_ranges({}, 0, 40);
+    ASSERT_EQ(0, file.num_buffers());
+    _check_read(file, 0, 20);
+    ASSERT_EQ(3, underlying.num_reads);
+}
+
+TEST(HdfsFileMetaCacheTest, TestLookup) {
+    HdfsFileMetaCache cache(1024);
+    std::string key = HdfsFileMetaCache::make_key("orc", "/path/file", 100, 1);
+    ASSERT_EQ(nullptr, cache.lookup<std::string>(key));
+
+    cache.insert(key, std::make_shared<std::string>("tail"), 4);
+    auto value = cache.lookup<std::string>(key);
+    ASSERT_NE(nullptr, value);
+    ASSERT_EQ("tail", *value);
+
+    // the rewritten file
+    ASSERT_EQ(nullptr, cache.lookup<std::string>(HdfsFileMetaCache::make_key("orc", "/path/file", 100, 2)));
+    ASSERT_EQ(nullptr, cache.lookup<std::string>(HdfsFileMetaCache::make_key("orc", "/path/file", 200, 1)));
+    ASSERT_EQ(nullptr, cache.lookup<std::string>(HdfsFileMetaCache::make_key("parquet", "/path/file", 100, 1)));
+}
+
+} // namespace starrocks::vectorized
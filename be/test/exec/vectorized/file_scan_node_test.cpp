@@ -0,0 +1,202 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/file_scan_node.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "column/chunk.h"
+#include "common/config.h"
+#include "common/object_pool.h"
+#include "gen_cpp/Descriptors_types.h"
+#include "gen_cpp/PlanNodes_types.h"
+#include "runtime/descriptor_helper.h"
+#include "runtime/descriptors.h"
+#include "runtime/exec_env.h"
+#include "runtime/runtime_state.h"
+#include "runtime/stream_load/load_stream_mgr.h"
+#include "runtime/stream_load/stream_load_pipe.h"
+
+namespace starrocks::vectorized {
+
+class FileScanNodeTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        _old_parse_threads = config::streaming_load_parse_threads;
+        _old_parse_block_bytes = config::streaming_load_parse_block_bytes;
+        config::streaming_load_parse_threads = 4;
+        // the blocks are cut at the record delimiters of the small pipe buffers, so many records cross them.
+        config::streaming_load_parse_block_bytes = 64;
+        _env._load_stream_mgr = new LoadStreamMgr();
+    }
+
+    void TearDown() override {
+        config::streaming_load_parse_threads = _old_parse_threads;
+        config::streaming_load_parse_block_bytes = _old_parse_block_bytes;
+        delete _env._load_stream_mgr;
+        _env._load_stream_mgr = nullptr;
+    }
+
+protected:
+    // create a file scan node reading the stream load body of "<int>,<varchar>" records from |pipe|.
+    FileScanNode* _create_scan_node(const std::shared_ptr<StreamLoadPipe>& pipe) {
+        TDescriptorTableBuilder desc_tbl_builder;
+        TTupleDescriptorBuilder tuple_desc_builder;
+        std::vector<TypeDescriptor> types{TypeDescriptor(TYPE_INT), TypeDescriptor::create_varchar_type(32)};
+        for (auto& t : types) {
+            TSlotDescriptorBuilder slot_desc_builder;
+            slot_desc_builder.type(t).length(t.len).nullable(true);
+            tuple_desc_builder.add_slot(slot_desc_builder.build());
+        }
+        tuple_desc_builder.build(&desc_tbl_builder);
+        DescriptorTbl* desc_tbl = nullptr;
+        CHECK(DescriptorTbl::create(&_pool, desc_tbl_builder.desc_tbl(), &desc_tbl).ok());
+
+        _state = _pool.add(new RuntimeState(TUniqueId(), TQueryOptions(), TQueryGlobals(), &_env));
+        _state->set_desc_tbl(desc_tbl);
+        _state->init_instance_mem_tracker();
+
+        TPlanNode tnode;
+        tnode.__set_node_id(0);
+        tnode.__set_node_type(TPlanNodeType::FILE_SCAN_NODE);
+        tnode.__set_num_children(0);
+        tnode.__set_limit(-1);
+        tnode.__set_row_tuples({0});
+        tnode.__set_nullable_tuples({false});
+        tnode.__set_use_vectorized(true);
+        tnode.file_scan_node.__set_tuple_id(0);
+        auto* node = _pool.add(new FileScanNode(&_pool, tnode, *desc_tbl));
+        CHECK(node->init(tnode, _state).ok());
+
+        TBrokerScanRangeParams params;
+        params.column_separator = ',';
+        params.row_delimiter = '\n';
+        params.src_tuple_id = 0;
+        params.dest_tuple_id = 0;
+        for (int i = 0; i < types.size(); i++) {
+            TExprNode slot_ref;
+            slot_ref.__set_type(types[i].to_thrift());
+            slot_ref.__set_node_type(TExprNodeType::SLOT_REF);
+            slot_ref.__set_is_nullable(true);
+            slot_ref.__set_slot_ref(TSlotRef());
+            slot_ref.slot_ref.__set_slot_id(i);
+            params.expr_of_dest_slot[i].nodes.emplace_back(slot_ref);
+            params.src_slot_ids.emplace_back(i);
+        }
+        TUniqueId load_id;
+        load_id.__set_hi(1);
+        load_id.__set_lo(++_num_loads);
+        CHECK(_env.load_stream_mgr()->put(UniqueId(load_id), pipe).ok());
+        TBrokerRangeDesc range;
+        range.__set_file_type(TFileType::FILE_STREAM);
+        range.__set_format_type(TFileFormatType::FORMAT_CSV_PLAIN);
+        range.__set_splittable(false);
+        range.__set_path("");
+        range.__set_load_id(load_id);
+        range.__set_num_of_columns_from_file(types.size());
+        TScanRangeParams scan_range;
+        scan_range.scan_range.broker_scan_range.__set_params(params);
+        scan_range.scan_range.broker_scan_range.ranges.emplace_back(range);
+        CHECK(node->set_scan_ranges({scan_range}).ok());
+        return node;
+    }
+
+    // append |data| to |pipe| in the buffers of |piece| bytes.
+    static void _append(StreamLoadPipe* pipe, const std::string& data, size_t piece) {
+        for (size_t pos = 0; pos < data.size(); pos += piece) {
+            ASSERT_TRUE(pipe->append_and_flush(data.data() + pos, std::min(piece, data.size() - pos)).ok());
+        }
+    }
+
+    // read all the chunks of |node| into |chunks| until the end or an error.
+    Status _read_all(FileScanNode* node, std::vector<ChunkPtr>* chunks) {
+        RETURN_IF_ERROR(node->prepare(_state));
+        RETURN_IF_ERROR(node->open(_state));
+        bool eos = false;
+        while (!eos) {
+            ChunkPtr chunk;
+            RETURN_IF_ERROR(node->get_next(_state, &chunk, &eos));
+            if (!eos) {
+                chunks->emplace_back(std::move(chunk));
+            }
+        }
+        return Status::OK();
+    }
+
+    ExecEnv _env;
+    ObjectPool _pool;
+    RuntimeState* _state = nullptr;
+    int64_t _num_loads = 0;
+    int32_t _old_parse_threads = 0;
+    int64_t _old_parse_block_bytes = 0;
+};
+
+// NOLINTNEXTLINE
+TEST_F(FileScanNodeTest, test_parse_stream_in_parallel) {
+    const int kNumRows = 1000;
+    std::string body;
+    for (int i = 0; i < kNumRows; i++) {
+        body += std::to_string(i) + ",v" + std::to_string(i) + "\n";
+    }
+    // the last record has no record delimiter.
+    body.pop_back();
+    auto pipe = std::make_shared<StreamLoadPipe>(16 * 1024 * 1024);
+    // 7 bytes do not divide any record, so the records cross the pipe buffers and the blocks.
+    _append(pipe.get(), body, 7);
+    ASSERT_TRUE(pipe->finish().ok());
+
+    auto* node = _create_scan_node(pipe);
+    std::vector<ChunkPtr> chunks;
+    Status st = _read_all(node, &chunks);
+    ASSERT_TRUE(st.ok()) << st.to_string();
+    ASSERT_GT(chunks.size(), 1);
+    // the rows are in the order of the body.
+    int num_rows = 0;
+    for (auto& chunk : chunks) {
+        for (size_t i = 0; i < chunk->num_rows(); i++, num_rows++) {
+            auto row = chunk->get(i);
+            ASSERT_EQ(num_rows, row[0].get_int32());
+            ASSERT_EQ("v" + std::to_string(num_rows), row[1].get_slice().to_string());
+        }
+    }
+    ASSERT_EQ(kNumRows, num_rows);
+    ASSERT_EQ(0, _state->num_rows_load_filtered());
+    ASSERT_TRUE(node->close(_state).ok());
+}
+
+// NOLINTNEXTLINE
+TEST_F(FileScanNodeTest, test_parse_error) {
+    std::string body = "1,a\n2,b\n";
+    // a record longer than the CSV reader accepts fails the parser of its block.
+    body += "3," + std::string(1024 * 1024, 'x') + "\n";
+    body += "4,d\n";
+    auto pipe = std::make_shared<StreamLoadPipe>(16 * 1024 * 1024);
+    _append(pipe.get(), body, 4096);
+    ASSERT_TRUE(pipe->finish().ok());
+
+    auto* node = _create_scan_node(pipe);
+    std::vector<ChunkPtr> chunks;
+    Status st = _read_all(node, &chunks);
+    ASSERT_FALSE(st.ok());
+    ASSERT_NE(std::string::npos, st.get_error_msg().find("CSV line length exceed limit")) << st.to_string();
+    ASSERT_TRUE(node->close(_state).ok());
+}
+
+// NOLINTNEXTLINE
+TEST_F(FileScanNodeTest, test_cancelled_body) {
+    auto pipe = std::make_shared<StreamLoadPipe>(16 * 1024 * 1024);
+    _append(pipe.get(), "1,a\n2,b\n3,c\n", 5);
+    // the failure of the body fails the splitter, and the load.
+    pipe->cancel();
+
+    auto* node = _create_scan_node(pipe);
+    std::vector<ChunkPtr> chunks;
+    Status st = _read_all(node, &chunks);
+    ASSERT_FALSE(st.ok());
+    ASSERT_EQ("cancelled", st.get_error_msg());
+    ASSERT_TRUE(node->close(_state).ok());
+}
+
+} // namespace starrocks::vectorized
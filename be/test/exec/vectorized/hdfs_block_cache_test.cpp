@@ -0,0 +1,117 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/hdfs_block_cache.h"
+
+#include <gtest/gtest.h>
+
+#include "env/env_memory.h"
+#include "util/file_utils.h"
+
+namespace starrocks::vectorized {
+
+class HdfsBlockCacheTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        ASSERT_TRUE(FileUtils::remove_all(_dir).ok() || !FileUtils::check_exist(_dir));
+        for (int i = 0; i < 10000; i++) {
+            _data.push_back(static_cast<char>(i % 251));
+        }
+        _cache = std::make_unique<HdfsBlockCache>(std::vector<std::string>{_dir}, 4096, 1024);
+        ASSERT_TRUE(_cache->init().ok());
+        _file_key = HdfsBlockCache::make_file_key("/path/file", _data.size(), -1);
+        _file = std::make_unique<CachedRandomAccessFile>(std::make_shared<StringRandomAccessFile>(_data), _cache.get(),
+                                                         _file_key, _data.size());
+    }
+
+    void TearDown() override {
+        _file.reset();
+        _cache.reset();
+        ASSERT_TRUE(FileUtils::remove_all(_dir).ok());
+    }
+
+protected:
+    void _check_read(uint64_t offset, size_t size) {
+        std::string buf(size, '\0');
+        ASSERT_TRUE(_file->read_at(offset, Slice(buf.data(), size)).ok());
+        ASSERT_EQ(_data.substr(offset, size), buf);
+    }
+
+    bool _is_cached(int64_t block_index) {
+        char c;
+        return _cache->read(_file_key, block_index, 0, Slice(&c, 1)).ok();
+    }
+
+    const std::string _dir = "./hdfs_block_cache_test";
+    std::string _data;
+    std::unique_ptr<HdfsBlockCache> _cache;
+    std::string _file_key;
+    std::unique_ptr<CachedRandomAccessFile> _file;
+};
+
+TEST_F(HdfsBlockCacheTest, TestAdmitOnSecondMiss) {
+    // block 0, 1 and 2
+    _check_read(1000, 1500);
+    _cache->wait();
+    ASSERT_FALSE(_is_cached(0));
+    ASSERT_FALSE(_is_cached(1));
+    ASSERT_FALSE(_is_cached(2));
+
+    _check_read(1000, 1500);
+    _cache->wait();
+    ASSERT_TRUE(_is_cached(0));
+    ASSERT_TRUE(_is_cached(1));
+    ASSERT_TRUE(_is_cached(2));
+    ASSERT_FALSE(_is_cached(3));
+    ASSERT_EQ(3072, _cache->usage());
+
+    // read from the cache and the remote file
+    _check_read(10, 3000);
+    // the last block is shorter
+    _check_read(9000, 1000);
+    _check_read(9000, 1000);
+    _cache->wait();
+    ASSERT_TRUE(_is_cached(9));
+    _check_read(9500, 500);
+}
+
+TEST_F(HdfsBlockCacheTest, TestEvict) {
+    for (int i = 0; i < 2; i++) {
+        _check_read(0, 6000);
+        _cache->wait();
+    }
+    // the least recently used are removed
+    ASSERT_EQ(4096, _cache->usage());
+    int num_cached = 0;
+    for (int i = 0; i < 6; i++) {
+        num_cached += _is_cached(i);
+    }
+    ASSERT_EQ(4, num_cached);
+    _check_read(0, 6000);
+}
+
+TEST_F(HdfsBlockCacheTest, TestChecksum) {
+    for (int i = 0; i < 2; i++) {
+        _check_read(0, 100);
+        _cache->wait();
+    }
+    ASSERT_TRUE(_is_cached(0));
+
+    // overwrite the cached block
+    std::vector<std::string> children;
+    ASSERT_TRUE(Env::Default()->get_children(_dir, &children).ok());
+    for (const auto& child : children) {
+        if (child == "." || child == "..") {
+            continue;
+        }
+        std::unique_ptr<WritableFile> file;
+        ASSERT_TRUE(Env::Default()->new_writable_file(_dir + "/" + child, &file).ok());
+        ASSERT_TRUE(file->append(Slice(std::string(1024, 'x'))).ok());
+        ASSERT_TRUE(file->close().ok());
+    }
+
+    // the corrupted block is removed and read from the remote file
+    _check_read(0, 100);
+    ASSERT_EQ(0, _cache->usage());
+}
+
+} // namespace starrocks::vectorized
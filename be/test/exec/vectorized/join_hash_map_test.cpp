@@ -4,6 +4,8 @@
 
 #include <gtest/gtest.h>
 
+#include <set>
+
 #include "runtime/descriptor_helper.h"
 #include "runtime/exec_env.h"
 
@@ -495,7 +497,6 @@ void JoinHashMapTest::prepare_table_items(JoinHashTableItems* table_items, uint3
     table_items->row_count = row_count;
     table_items->next.resize(row_count + 1);
     table_items->build_pool = std::make_unique<MemPool>();
-    table_items->probe_pool = std::make_unique<MemPool>();
     table_items->mem_tracker = _mem_tracker.get();
     table_items->search_ht_timer = ADD_TIMER(_runtime_profile, "SearchHashTableTimer");
     table_items->output_build_column_timer = ADD_TIMER(_runtime_profile, "OutputBuildColumnTimer");
@@ -962,6 +963,91 @@ TEST_F(JoinHashMapTest, JoinBuildProbeFuncNullable) {
     table_items.mem_tracker->release(table_items.mem_tracker->consumption());
 }
 
+// NOLINTNEXTLINE
+TEST_F(JoinHashMapTest, DirectMappingJoinBuildProbeFunc) {
+    JoinHashTableItems table_items;
+    HashTableProbeState probe_state;
+    auto runtime_state = create_runtime_state();
+    runtime_state->init_instance_mem_tracker();
+
+    // build keys are [100, 110), probe keys are [95, 115)
+    auto type = TypeDescriptor::from_primtive_type(PrimitiveType::TYPE_INT);
+    auto build_column = ColumnHelper::create_column(type, false);
+    build_column->append_default();
+    build_column->append(*JoinHashMapTest::create_int32_column(10, 100), 0, 10);
+    auto probe_column = JoinHashMapTest::create_int32_column(20, 95);
+    table_items.direct_mapping_min_key = 100;
+    table_items.bucket_size = 11;
+    table_items.first.resize(table_items.bucket_size, 0);
+    table_items.key_columns.emplace_back(build_column);
+    table_items.row_count = 10;
+    table_items.next.resize(11);
+    table_items.mem_tracker = runtime_state->instance_mem_tracker();
+    probe_state.probe_row_count = 20;
+    probe_state.buckets.resize(config::vector_chunk_size);
+    probe_state.next.resize(config::vector_chunk_size, 0);
+    Columns probe_columns{probe_column};
+    probe_state.key_columns = &probe_columns;
+
+    auto status = DirectMappingJoinBuildFunc<TYPE_INT>::prepare(runtime_state.get(), &table_items, &probe_state);
+    ASSERT_TRUE(status.ok());
+    DirectMappingJoinBuildFunc<TYPE_INT>::construct_hash_table(&table_items, &probe_state);
+    // bucket 0 is reserved for the keys out of range
+    ASSERT_EQ(table_items.first[0], 0);
+    for (size_t i = 1; i < table_items.bucket_size; i++) {
+        ASSERT_EQ(table_items.first[i], i);
+    }
+
+    status = DirectMappingJoinProbeFunc<TYPE_INT>::prepare(&table_items, &probe_state);
+    ASSERT_TRUE(status.ok());
+    DirectMappingJoinProbeFunc<TYPE_INT>::lookup_init(table_items, &probe_state);
+    for (size_t i = 0; i < 20; i++) {
+        int32_t probe_key = 95 + i;
+        size_t found_count = 0;
+        size_t probe_index = probe_state.next[i];
+        auto data = ColumnHelper::as_raw_column<Int32Column>(table_items.key_columns[0])->get_data();
+        while (probe_index != 0) {
+            if (JoinKeyEqual<int32_t>()(probe_key, data[probe_index])) {
+                found_count++;
+            }
+            probe_index = table_items.next[probe_index];
+        }
+        ASSERT_EQ(found_count, (probe_key >= 100 && probe_key < 110) ? 1 : 0);
+    }
+    table_items.mem_tracker->release(table_items.mem_tracker->consumption());
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashMapTest, LookupBucketHeadsWithPrefetch) {
+    JoinHashTableItems table_items;
+    HashTableProbeState probe_state;
+    table_items.bucket_size = 64;
+    table_items.first.resize(table_items.bucket_size, 0);
+    for (uint32_t i = 0; i < table_items.bucket_size; i += 2) {
+        table_items.first[i] = i + 1;
+    }
+    probe_state.probe_row_count = 100;
+    probe_state.buckets.resize(probe_state.probe_row_count);
+    probe_state.next.resize(probe_state.probe_row_count);
+    Buffer<uint8_t> is_nulls(probe_state.probe_row_count, 0);
+    for (uint32_t i = 0; i < probe_state.probe_row_count; i++) {
+        probe_state.buckets[i] = (i * 7) % table_items.bucket_size;
+        is_nulls[i] = i % 3 == 0;
+    }
+
+    for (bool prefetch : {false, true}) {
+        table_items.enable_probe_prefetch = prefetch;
+        JoinHashMapHelper::lookup_bucket_heads(table_items, &probe_state, nullptr);
+        for (uint32_t i = 0; i < probe_state.probe_row_count; i++) {
+            ASSERT_EQ(probe_state.next[i], table_items.first[probe_state.buckets[i]]);
+        }
+        JoinHashMapHelper::lookup_bucket_heads(table_items, &probe_state, is_nulls.data());
+        for (uint32_t i = 0; i < probe_state.probe_row_count; i++) {
+            ASSERT_EQ(probe_state.next[i], is_nulls[i] ? 0 : table_items.first[probe_state.buckets[i]]);
+        }
+    }
+}
+
 // NOLINTNEXTLINE
 TEST_F(JoinHashMapTest, FixedSizeJoinBuildProbeFunc) {
     JoinHashTableItems table_items;
@@ -1114,7 +1200,6 @@ TEST_F(JoinHashMapTest, SerializedJoinBuildProbeFunc) {
     table_items.join_keys.emplace_back(JoinKeyDesc{TYPE_INT, false});
     table_items.mem_tracker = runtime_state->instance_mem_tracker();
     table_items.build_pool = std::make_unique<MemPool>();
-    table_items.probe_pool = std::make_unique<MemPool>();
     probe_state.probe_row_count = 10;
     probe_state.buckets.resize(config::vector_chunk_size);
     probe_state.next.resize(config::vector_chunk_size, 0);
@@ -1143,7 +1228,6 @@ TEST_F(JoinHashMapTest, SerializedJoinBuildProbeFunc) {
         ASSERT_EQ(found_count, 1);
     }
     table_items.build_pool.reset();
-    table_items.probe_pool.reset();
     table_items.mem_tracker->release(table_items.mem_tracker->consumption());
 }
 
@@ -1177,7 +1261,6 @@ TEST_F(JoinHashMapTest, SerializedJoinBuildProbeFuncNullable) {
     table_items.next.resize(11);
     table_items.mem_tracker = runtime_state->instance_mem_tracker();
     table_items.build_pool = std::make_unique<MemPool>();
-    table_items.probe_pool = std::make_unique<MemPool>();
     probe_state.probe_row_count = 10;
     probe_state.buckets.resize(config::vector_chunk_size);
     probe_state.next.resize(config::vector_chunk_size, 0);
@@ -1216,7 +1299,6 @@ TEST_F(JoinHashMapTest, SerializedJoinBuildProbeFuncNullable) {
         }
     }
     table_items.build_pool.reset();
-    table_items.probe_pool.reset();
     table_items.mem_tracker->release(table_items.mem_tracker->consumption());
 }
 
@@ -1619,6 +1701,288 @@ TEST_F(JoinHashMapTest, OneKeyJoinHashTable) {
     hash_table.close();
 }
 
+// NOLINTNEXTLINE
+TEST_F(JoinHashMapTest, RadixPartitionJoinHashTable) {
+    auto runtime_profile = create_runtime_profile();
+    auto runtime_state = create_runtime_state();
+    auto mem_tracker = create_mem_tracker(runtime_profile);
+    std::shared_ptr<ObjectPool> object_pool = std::make_shared<ObjectPool>();
+    config::vector_chunk_size = 4096;
+    bool old_enable_direct_mapping = config::enable_join_direct_mapping;
+    int64_t old_partition_bytes = config::join_radix_partition_bytes;
+    config::enable_join_direct_mapping = false;
+    config::join_radix_partition_bytes = 1024;
+
+    TDescriptorTableBuilder row_desc_builder;
+    add_tuple_descriptor(&row_desc_builder, PrimitiveType::TYPE_INT, false);
+    add_tuple_descriptor(&row_desc_builder, PrimitiveType::TYPE_INT, false);
+
+    std::shared_ptr<RowDescriptor> row_desc = create_row_desc(object_pool, &row_desc_builder, false);
+    std::shared_ptr<RowDescriptor> probe_row_desc = create_probe_desc(object_pool, &row_desc_builder, false);
+    std::shared_ptr<RowDescriptor> build_row_desc = create_build_desc(object_pool, &row_desc_builder, false);
+
+    HashTableParam param;
+    param.with_other_conjunct = false;
+    param.join_type = TJoinOp::INNER_JOIN;
+    param.row_desc = row_desc.get();
+    param.mem_tracker = mem_tracker.get();
+    param.join_keys.emplace_back(JoinKeyDesc{TYPE_INT, false});
+    param.probe_row_desc = probe_row_desc.get();
+    param.build_row_desc = build_row_desc.get();
+    param.search_ht_timer = ADD_TIMER(runtime_profile, "SearchHashTableTimer");
+    param.output_build_column_timer = ADD_TIMER(runtime_profile, "OutputBuildColumnTimer");
+    param.output_probe_column_timer = ADD_TIMER(runtime_profile, "OutputProbeColumnTimer");
+    param.output_tuple_column_timer = ADD_TIMER(runtime_profile, "OutputTupleColumnTimer");
+
+    JoinHashTable hash_table;
+    hash_table.create(param);
+    hash_table.set_radix_partition(true);
+
+    // build keys are [0, 1000), probe keys are [700, 1200)
+    auto build_chunk = create_int32_build_chunk(1000, false);
+    auto probe_chunk = create_int32_probe_chunk(500, 700, false);
+    Columns probe_key_columns;
+    probe_key_columns.emplace_back(probe_chunk->columns()[0]);
+
+    ASSERT_TRUE(hash_table.append_chunk(runtime_state.get(), build_chunk).ok());
+    hash_table.get_key_columns().emplace_back(hash_table.get_build_chunk()->columns()[0]);
+    ASSERT_TRUE(hash_table.build(runtime_state.get()).ok());
+    // the key column is still the column of build chunk after the build rows are reordered.
+    ASSERT_EQ(hash_table.get_key_columns()[0].get(), hash_table.get_build_chunk()->columns()[0].get());
+
+    ChunkPtr result_chunk = std::make_shared<Chunk>();
+    bool eos = false;
+    ASSERT_TRUE(hash_table.probe(probe_key_columns, &probe_chunk, &result_chunk, &eos).ok());
+    ASSERT_FALSE(eos);
+    ASSERT_EQ(result_chunk->num_rows(), 300);
+
+    // the rows are reordered, but the probe and build values of each row must still match.
+    std::set<int32_t> keys;
+    for (size_t i = 0; i < result_chunk->num_rows(); i++) {
+        int32_t key = result_chunk->get_column_by_slot_id(0)->get(i).get_int32();
+        keys.insert(key);
+        ASSERT_EQ(result_chunk->get_column_by_slot_id(1)->get(i).get_int32(), key + 10);
+        ASSERT_EQ(result_chunk->get_column_by_slot_id(2)->get(i).get_int32(), key + 20);
+        ASSERT_EQ(result_chunk->get_column_by_slot_id(3)->get(i).get_int32(), key);
+        ASSERT_EQ(result_chunk->get_column_by_slot_id(4)->get(i).get_int32(), key + 10);
+        ASSERT_EQ(result_chunk->get_column_by_slot_id(5)->get(i).get_int32(), key + 20);
+    }
+    ASSERT_EQ(keys.size(), 300);
+    ASSERT_EQ(*keys.begin(), 700);
+    ASSERT_EQ(*keys.rbegin(), 999);
+
+    hash_table.close();
+    config::enable_join_direct_mapping = old_enable_direct_mapping;
+    config::join_radix_partition_bytes = old_partition_bytes;
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashMapTest, RadixPartitionNullableJoinHashTable) {
+    auto runtime_profile = create_runtime_profile();
+    auto runtime_state = create_runtime_state();
+    auto mem_tracker = create_mem_tracker(runtime_profile);
+    std::shared_ptr<ObjectPool> object_pool = std::make_shared<ObjectPool>();
+    config::vector_chunk_size = 4096;
+    bool old_enable_direct_mapping = config::enable_join_direct_mapping;
+    int64_t old_partition_bytes = config::join_radix_partition_bytes;
+    config::enable_join_direct_mapping = false;
+    config::join_radix_partition_bytes = 1024;
+
+    TDescriptorTableBuilder row_desc_builder;
+    add_tuple_descriptor(&row_desc_builder, PrimitiveType::TYPE_INT, true);
+    add_tuple_descriptor(&row_desc_builder, PrimitiveType::TYPE_INT, true);
+
+    std::shared_ptr<RowDescriptor> row_desc = create_row_desc(object_pool, &row_desc_builder, true);
+    std::shared_ptr<RowDescriptor> probe_row_desc = create_probe_desc(object_pool, &row_desc_builder, true);
+    std::shared_ptr<RowDescriptor> build_row_desc = create_build_desc(object_pool, &row_desc_builder, true);
+
+    // one key for the hash map of the key itself, two keys for the hash map of the fixed size keys.
+    for (size_t num_keys : {1, 2}) {
+        HashTableParam param;
+        param.with_other_conjunct = false;
+        param.join_type = TJoinOp::INNER_JOIN;
+        param.row_desc = row_desc.get();
+        param.mem_tracker = mem_tracker.get();
+        param.probe_row_desc = probe_row_desc.get();
+        param.build_row_desc = build_row_desc.get();
+        param.search_ht_timer = ADD_TIMER(runtime_profile, "SearchHashTableTimer");
+        param.output_build_column_timer = ADD_TIMER(runtime_profile, "OutputBuildColumnTimer");
+        param.output_probe_column_timer = ADD_TIMER(runtime_profile, "OutputProbeColumnTimer");
+        param.output_tuple_column_timer = ADD_TIMER(runtime_profile, "OutputTupleColumnTimer");
+        for (size_t i = 0; i < num_keys; i++) {
+            param.join_keys.emplace_back(JoinKeyDesc{TYPE_INT, false});
+        }
+
+        JoinHashTable hash_table;
+        hash_table.create(param);
+        hash_table.set_radix_partition(true);
+
+        // the odd keys are null, the build keys are [0, 1000) and the probe keys are [700, 1200).
+        auto build_chunk = create_int32_build_chunk(1000, true);
+        auto probe_chunk = create_int32_probe_chunk(500, 700, true);
+        Columns probe_key_columns;
+        ASSERT_TRUE(hash_table.append_chunk(runtime_state.get(), build_chunk).ok());
+        for (size_t i = 0; i < num_keys; i++) {
+            probe_key_columns.emplace_back(probe_chunk->columns()[i]);
+            hash_table.get_key_columns().emplace_back(hash_table.get_build_chunk()->columns()[i]);
+        }
+        ASSERT_TRUE(hash_table.build(runtime_state.get()).ok());
+
+        ChunkPtr result_chunk = std::make_shared<Chunk>();
+        bool eos = false;
+        ASSERT_TRUE(hash_table.probe(probe_key_columns, &probe_chunk, &result_chunk, &eos).ok());
+        ASSERT_FALSE(eos);
+        ASSERT_EQ(result_chunk->num_rows(), 150);
+
+        // the null keys never match, and the probe and build values of each row must still match.
+        std::set<int32_t> keys;
+        for (size_t i = 0; i < result_chunk->num_rows(); i++) {
+            int32_t key = result_chunk->get_column_by_slot_id(0)->get(i).get_int32();
+            keys.insert(key);
+            ASSERT_EQ(key % 2, 0);
+            ASSERT_EQ(result_chunk->get_column_by_slot_id(1)->get(i).get_int32(), key + 10);
+            ASSERT_EQ(result_chunk->get_column_by_slot_id(3)->get(i).get_int32(), key);
+            ASSERT_EQ(result_chunk->get_column_by_slot_id(4)->get(i).get_int32(), key + 10);
+        }
+        ASSERT_EQ(keys.size(), 150);
+        ASSERT_EQ(*keys.begin(), 700);
+        ASSERT_EQ(*keys.rbegin(), 998);
+
+        hash_table.close();
+    }
+    config::enable_join_direct_mapping = old_enable_direct_mapping;
+    config::join_radix_partition_bytes = old_partition_bytes;
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashMapTest, ResetBuildJoinHashTable) {
+    auto runtime_profile = create_runtime_profile();
+    auto runtime_state = create_runtime_state();
+    auto mem_tracker = create_mem_tracker(runtime_profile);
+    std::shared_ptr<ObjectPool> object_pool = std::make_shared<ObjectPool>();
+    config::vector_chunk_size = 4096;
+
+    TDescriptorTableBuilder row_desc_builder;
+    add_tuple_descriptor(&row_desc_builder, PrimitiveType::TYPE_INT, false);
+    add_tuple_descriptor(&row_desc_builder, PrimitiveType::TYPE_INT, false);
+
+    std::shared_ptr<RowDescriptor> row_desc = create_row_desc(object_pool, &row_desc_builder, false);
+    std::shared_ptr<RowDescriptor> probe_row_desc = create_probe_desc(object_pool, &row_desc_builder, false);
+    std::shared_ptr<RowDescriptor> build_row_desc = create_build_desc(object_pool, &row_desc_builder, false);
+
+    HashTableParam param;
+    param.with_other_conjunct = false;
+    param.join_type = TJoinOp::INNER_JOIN;
+    param.row_desc = row_desc.get();
+    param.mem_tracker = mem_tracker.get();
+    param.join_keys.emplace_back(JoinKeyDesc{TYPE_INT, false});
+    param.probe_row_desc = probe_row_desc.get();
+    param.build_row_desc = build_row_desc.get();
+    param.search_ht_timer = ADD_TIMER(runtime_profile, "SearchHashTableTimer");
+    param.output_build_column_timer = ADD_TIMER(runtime_profile, "OutputBuildColumnTimer");
+    param.output_probe_column_timer = ADD_TIMER(runtime_profile, "OutputProbeColumnTimer");
+    param.output_tuple_column_timer = ADD_TIMER(runtime_profile, "OutputTupleColumnTimer");
+
+    JoinHashTable hash_table;
+    hash_table.create(param);
+
+    ASSERT_TRUE(hash_table.append_chunk(runtime_state.get(), create_int32_build_chunk(100, false)).ok());
+    hash_table.get_key_columns().emplace_back(hash_table.get_build_chunk()->columns()[0]);
+    ASSERT_TRUE(hash_table.build(runtime_state.get()).ok());
+    ASSERT_EQ(100, hash_table.get_row_count());
+
+    hash_table.reset_build();
+    ASSERT_EQ(0, hash_table.get_row_count());
+    ASSERT_EQ(1, hash_table.get_build_chunk()->num_rows());
+    ASSERT_TRUE(hash_table.get_key_columns().empty());
+
+    // build and probe again after reset
+    ASSERT_TRUE(hash_table.append_chunk(runtime_state.get(), create_int32_build_chunk(10, false)).ok());
+    hash_table.get_key_columns().emplace_back(hash_table.get_build_chunk()->columns()[0]);
+    ASSERT_TRUE(hash_table.build(runtime_state.get()).ok());
+    ASSERT_EQ(10, hash_table.get_row_count());
+
+    auto probe_chunk = create_int32_probe_chunk(5, 1, false);
+    Columns probe_key_columns;
+    probe_key_columns.emplace_back(probe_chunk->columns()[0]);
+    ChunkPtr result_chunk = std::make_shared<Chunk>();
+    bool eos = false;
+    ASSERT_TRUE(hash_table.probe(probe_key_columns, &probe_chunk, &result_chunk, &eos).ok());
+
+    ASSERT_EQ(result_chunk->num_columns(), 6);
+    check_int32_column(result_chunk->get_column_by_slot_id(0), 5, 1);
+    check_int32_column(result_chunk->get_column_by_slot_id(3), 5, 1);
+
+    hash_table.close();
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashMapTest, ShareBuildJoinHashTable) {
+    auto runtime_profile = create_runtime_profile();
+    auto runtime_state = create_runtime_state();
+    auto mem_tracker = create_mem_tracker(runtime_profile);
+    std::shared_ptr<ObjectPool> object_pool = std::make_shared<ObjectPool>();
+    config::vector_chunk_size = 4096;
+
+    TDescriptorTableBuilder row_desc_builder;
+    add_tuple_descriptor(&row_desc_builder, PrimitiveType::TYPE_INT, false);
+    add_tuple_descriptor(&row_desc_builder, PrimitiveType::TYPE_INT, false);
+
+    std::shared_ptr<RowDescriptor> row_desc = create_row_desc(object_pool, &row_desc_builder, false);
+    std::shared_ptr<RowDescriptor> probe_row_desc = create_probe_desc(object_pool, &row_desc_builder, false);
+    std::shared_ptr<RowDescriptor> build_row_desc = create_build_desc(object_pool, &row_desc_builder, false);
+
+    HashTableParam param;
+    param.with_other_conjunct = false;
+    param.join_type = TJoinOp::INNER_JOIN;
+    param.row_desc = row_desc.get();
+    param.mem_tracker = mem_tracker.get();
+    param.join_keys.emplace_back(JoinKeyDesc{TYPE_INT, false});
+    param.probe_row_desc = probe_row_desc.get();
+    param.build_row_desc = build_row_desc.get();
+    param.search_ht_timer = ADD_TIMER(runtime_profile, "SearchHashTableTimer");
+    param.output_build_column_timer = ADD_TIMER(runtime_profile, "OutputBuildColumnTimer");
+    param.output_probe_column_timer = ADD_TIMER(runtime_profile, "OutputProbeColumnTimer");
+    param.output_tuple_column_timer = ADD_TIMER(runtime_profile, "OutputTupleColumnTimer");
+
+    ASSERT_TRUE(JoinHashTable::can_share_build(TJoinOp::INNER_JOIN));
+    ASSERT_FALSE(JoinHashTable::can_share_build(TJoinOp::RIGHT_OUTER_JOIN));
+
+    JoinHashTable hash_table;
+    hash_table.create(param);
+    ASSERT_TRUE(hash_table.append_chunk(runtime_state.get(), create_int32_build_chunk(10, false)).ok());
+    hash_table.get_key_columns().emplace_back(hash_table.get_build_chunk()->columns()[0]);
+    ASSERT_TRUE(hash_table.build(runtime_state.get()).ok());
+    int64_t consumption = mem_tracker->consumption();
+
+    JoinHashTable reader_table;
+    reader_table.create(param);
+    reader_table.share_build(hash_table);
+    ASSERT_EQ(10, reader_table.get_row_count());
+    ASSERT_EQ(hash_table.get_build_chunk(), reader_table.get_build_chunk());
+    // the memory of the hash table is only accounted by the table which builds it.
+    ASSERT_EQ(consumption, mem_tracker->consumption());
+
+    // both tables probe with their own probe states.
+    auto probe_chunk1 = create_int32_probe_chunk(5, 1, false);
+    auto probe_chunk2 = create_int32_probe_chunk(3, 2, false);
+    Columns probe_key_columns1{probe_chunk1->columns()[0]};
+    Columns probe_key_columns2{probe_chunk2->columns()[0]};
+    ChunkPtr result_chunk1 = std::make_shared<Chunk>();
+    ChunkPtr result_chunk2 = std::make_shared<Chunk>();
+    bool eos = false;
+    ASSERT_TRUE(hash_table.probe(probe_key_columns1, &probe_chunk1, &result_chunk1, &eos).ok());
+    ASSERT_TRUE(reader_table.probe(probe_key_columns2, &probe_chunk2, &result_chunk2, &eos).ok());
+
+    check_int32_column(result_chunk1->get_column_by_slot_id(0), 5, 1);
+    check_int32_column(result_chunk1->get_column_by_slot_id(3), 5, 1);
+    check_int32_column(result_chunk2->get_column_by_slot_id(0), 3, 2);
+    check_int32_column(result_chunk2->get_column_by_slot_id(3), 3, 2);
+
+    reader_table.close();
+    hash_table.close();
+}
+
 // NOLINTNEXTLINE
 TEST_F(JoinHashMapTest, OneNullableKeyJoinHashTable) {
     auto runtime_profile = create_runtime_profile();
@@ -0,0 +1,260 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/merge_joiner.h"
+
+#include <gtest/gtest.h>
+
+#include <optional>
+
+#include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "exec/vectorized/merge_join_node.h"
+#include "exprs/slot_ref.h"
+#include "runtime/descriptor_helper.h"
+
+namespace starrocks::vectorized {
+
+using Keys = std::vector<std::optional<int32_t>>;
+// the values of the left and the right rows joined.
+using JoinedRows = std::vector<std::pair<int32_t, int32_t>>;
+
+// select l.v, r.v from l join r on l.k = r.k, where l is (k INT NULL, v INT) with the slots 0 and 1
+// and r is (k INT NULL, v INT) with the slots 2 and 3, both sorted by k with the NULLs first.
+class MergeJoinerTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        _old_chunk_size = config::vector_chunk_size;
+
+        TDescriptorTableBuilder table_builder;
+        for (int i = 0; i < 2; ++i) {
+            TTupleDescriptorBuilder tuple_builder;
+            tuple_builder.add_slot(TSlotDescriptorBuilder().type(TYPE_INT).column_name("k").nullable(true).build());
+            tuple_builder.add_slot(TSlotDescriptorBuilder().type(TYPE_INT).column_name("v").nullable(false).build());
+            tuple_builder.build(&table_builder);
+        }
+        ASSERT_TRUE(DescriptorTbl::create(&_pool, table_builder.desc_tbl(), &_desc_tbl).ok());
+        _left_row_desc =
+                std::make_unique<RowDescriptor>(*_desc_tbl, std::vector<TTupleId>{0}, std::vector<bool>{false});
+        _right_row_desc =
+                std::make_unique<RowDescriptor>(*_desc_tbl, std::vector<TTupleId>{1}, std::vector<bool>{false});
+        _row_desc = std::make_unique<RowDescriptor>(*_desc_tbl, std::vector<TTupleId>{0, 1},
+                                                    std::vector<bool>{false, false});
+    }
+
+    void TearDown() override { config::vector_chunk_size = _old_chunk_size; }
+
+protected:
+    MergeJoinerPtr _create_joiner() {
+        auto* left_key = _pool.add(new SlotRef(TypeDescriptor(TYPE_INT), 0, 0));
+        auto* right_key = _pool.add(new SlotRef(TypeDescriptor(TYPE_INT), 0, 2));
+        std::vector<ExprContext*> left_key_ctxs{_pool.add(new ExprContext(left_key))};
+        std::vector<ExprContext*> right_key_ctxs{_pool.add(new ExprContext(right_key))};
+        return std::make_shared<MergeJoiner>(std::move(left_key_ctxs), std::move(right_key_ctxs),
+                                             std::vector<ExprContext*>(), *_left_row_desc, *_right_row_desc,
+                                             *_row_desc);
+    }
+
+    // the rows with the |keys| and v = first_value, first_value + 1, ...
+    static ChunkPtr _create_chunk(const Keys& keys, int32_t first_value, SlotId key_slot, SlotId value_slot) {
+        auto key_column = NullableColumn::create(Int32Column::create(), NullColumn::create());
+        auto value_column = Int32Column::create();
+        for (size_t i = 0; i < keys.size(); ++i) {
+            if (keys[i].has_value()) {
+                key_column->append_datum(Datum(keys[i].value()));
+            } else {
+                key_column->append_nulls(1);
+            }
+            value_column->append(first_value + static_cast<int32_t>(i));
+        }
+        auto chunk = std::make_shared<Chunk>();
+        chunk->append_column(key_column, key_slot);
+        chunk->append_column(value_column, value_slot);
+        return chunk;
+    }
+
+    // split the sorted |keys| into the chunks of the |chunk_rows|, the values are the indexes of the rows.
+    static std::vector<ChunkPtr> _create_chunks(const Keys& keys, const std::vector<size_t>& chunk_rows,
+                                                SlotId key_slot, SlotId value_slot) {
+        std::vector<ChunkPtr> chunks;
+        size_t begin = 0;
+        for (size_t num_rows : chunk_rows) {
+            Keys chunk_keys(keys.begin() + begin, keys.begin() + begin + num_rows);
+            chunks.emplace_back(_create_chunk(chunk_keys, static_cast<int32_t>(begin), key_slot, value_slot));
+            begin += num_rows;
+        }
+        EXPECT_EQ(keys.size(), begin);
+        return chunks;
+    }
+
+    // the rows of a nested loop join, in the order of the left rows then the right rows.
+    static JoinedRows _nested_loop_join(const Keys& left_keys, const Keys& right_keys) {
+        JoinedRows rows;
+        for (size_t i = 0; i < left_keys.size(); ++i) {
+            for (size_t j = 0; j < right_keys.size(); ++j) {
+                if (left_keys[i].has_value() && right_keys[j].has_value() && left_keys[i] == right_keys[j]) {
+                    rows.emplace_back(i, j);
+                }
+            }
+        }
+        return rows;
+    }
+
+    // Feed the chunks the joiner asks for and collect the joined rows, the way the left operator drives it.
+    static JoinedRows _join(MergeJoiner* joiner, const std::vector<ChunkPtr>& lefts,
+                            const std::vector<ChunkPtr>& rights) {
+        JoinedRows rows;
+        size_t left_index = 0;
+        size_t right_index = 0;
+        while (!joiner->is_finished()) {
+            if (joiner->need_left()) {
+                if (left_index < lefts.size()) {
+                    EXPECT_TRUE(joiner->push_left(lefts[left_index++]).ok());
+                } else {
+                    joiner->set_left_eos();
+                }
+                continue;
+            }
+            if (joiner->need_right()) {
+                if (right_index < rights.size()) {
+                    EXPECT_TRUE(joiner->push_right(rights[right_index++]).ok());
+                } else {
+                    joiner->set_right_eos();
+                }
+                continue;
+            }
+            ChunkPtr chunk;
+            EXPECT_TRUE(joiner->pull_chunk(&chunk).ok());
+            EXPECT_LE(chunk->num_rows(), static_cast<size_t>(config::vector_chunk_size));
+            for (size_t i = 0; i < chunk->num_rows(); ++i) {
+                rows.emplace_back(chunk->get_column_by_slot_id(1)->get(i).get_int32(),
+                                  chunk->get_column_by_slot_id(3)->get(i).get_int32());
+            }
+        }
+        return rows;
+    }
+
+    JoinedRows _join(const Keys& left_keys, const std::vector<size_t>& left_chunk_rows, const Keys& right_keys,
+                     const std::vector<size_t>& right_chunk_rows) {
+        auto joiner = _create_joiner();
+        return _join(joiner.get(), _create_chunks(left_keys, left_chunk_rows, 0, 1),
+                     _create_chunks(right_keys, right_chunk_rows, 2, 3));
+    }
+
+    ObjectPool _pool;
+    DescriptorTbl* _desc_tbl = nullptr;
+    std::unique_ptr<RowDescriptor> _left_row_desc;
+    std::unique_ptr<RowDescriptor> _right_row_desc;
+    std::unique_ptr<RowDescriptor> _row_desc;
+    int32_t _old_chunk_size = 0;
+};
+
+// NOLINTNEXTLINE
+TEST_F(MergeJoinerTest, test_unique_keys) {
+    Keys left_keys{1, 2, 3, 5, 7};
+    Keys right_keys{2, 3, 4, 5, 8};
+    ASSERT_EQ((JoinedRows{{1, 0}, {2, 1}, {3, 3}}), _join(left_keys, {5}, right_keys, {5}));
+}
+
+// NOLINTNEXTLINE
+TEST_F(MergeJoinerTest, test_duplicate_keys) {
+    // the groups of equal keys span the chunks of both sides.
+    Keys left_keys{1, 2, 2, 2, 3, 5, 5, 6};
+    Keys right_keys{0, 2, 2, 3, 3, 3, 4, 5, 5, 5, 6};
+    JoinedRows expected = _nested_loop_join(left_keys, right_keys);
+    ASSERT_EQ(16, expected.size());
+    ASSERT_EQ(expected, _join(left_keys, {2, 1, 3, 2}, right_keys, {2, 1, 3, 1, 2, 2}));
+    ASSERT_EQ(expected, _join(left_keys, {1, 1, 1, 1, 1, 1, 1, 1}, right_keys, {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1}));
+    ASSERT_EQ(expected, _join(left_keys, {8}, right_keys, {11}));
+}
+
+// NOLINTNEXTLINE
+TEST_F(MergeJoinerTest, test_duplicate_keys_with_small_output_chunks) {
+    // every left row matches all the right rows, which is more than an output chunk.
+    config::vector_chunk_size = 4;
+    Keys left_keys(10, 1);
+    Keys right_keys(10, 1);
+    JoinedRows expected = _nested_loop_join(left_keys, right_keys);
+    ASSERT_EQ(100, expected.size());
+    ASSERT_EQ(expected, _join(left_keys, {3, 3, 4}, right_keys, {4, 4, 2}));
+}
+
+// NOLINTNEXTLINE
+TEST_F(MergeJoinerTest, test_null_keys) {
+    // the NULL keys never match, not even each other.
+    Keys left_keys{std::nullopt, std::nullopt, 1, 2, 2};
+    Keys right_keys{std::nullopt, 1, 2, 3};
+    ASSERT_EQ((JoinedRows{{2, 1}, {3, 2}, {4, 2}}), _join(left_keys, {2, 3}, right_keys, {1, 3}));
+
+    Keys all_null_keys{std::nullopt, std::nullopt};
+    ASSERT_TRUE(_join(all_null_keys, {2}, all_null_keys, {1, 1}).empty());
+    ASSERT_TRUE(_join(all_null_keys, {1, 1}, right_keys, {4}).empty());
+}
+
+// NOLINTNEXTLINE
+TEST_F(MergeJoinerTest, test_no_matched_keys) {
+    ASSERT_TRUE(_join({1, 3, 5}, {3}, {2, 4, 6}, {1, 2}).empty());
+    // all the right rows are less than the left ones and the other way round.
+    ASSERT_TRUE(_join({7, 8}, {2}, {1, 2, 3}, {3}).empty());
+    ASSERT_TRUE(_join({1, 2, 3}, {1, 2}, {7, 8}, {2}).empty());
+}
+
+// NOLINTNEXTLINE
+TEST_F(MergeJoinerTest, test_empty_left) {
+    auto joiner = _create_joiner();
+    auto rights = _create_chunks({1, 2, 3}, {3}, 2, 3);
+    ASSERT_TRUE(_join(joiner.get(), {}, rights).empty());
+
+    // the empty chunks are skipped.
+    joiner = _create_joiner();
+    auto empty_chunk = _create_chunk({}, 0, 0, 1);
+    ASSERT_TRUE(_join(joiner.get(), {empty_chunk, empty_chunk}, rights).empty());
+}
+
+// NOLINTNEXTLINE
+TEST_F(MergeJoinerTest, test_empty_right) {
+    auto joiner = _create_joiner();
+    auto lefts = _create_chunks({1, 2, 3}, {3}, 0, 1);
+    ASSERT_TRUE(_join(joiner.get(), lefts, {}).empty());
+
+    // the joiner finishes as soon as the right side is drained, the left rows are no longer needed.
+    joiner = _create_joiner();
+    ASSERT_TRUE(joiner->push_left(lefts[0]).ok());
+    ASSERT_TRUE(joiner->need_right());
+    joiner->set_right_eos();
+    ASSERT_TRUE(joiner->is_finished());
+    ASSERT_TRUE(joiner->is_right_complete());
+}
+
+// NOLINTNEXTLINE
+TEST_F(MergeJoinerTest, test_left_eos_before_right) {
+    // the remaining right rows are not needed once the left side is drained.
+    auto joiner = _create_joiner();
+    auto lefts = _create_chunks({1, 2}, {2}, 0, 1);
+    auto rights = _create_chunks({1, 2, 3, 4, 5, 6}, {2, 2, 2}, 2, 3);
+    ASSERT_EQ((JoinedRows{{0, 0}, {1, 1}}), _join(joiner.get(), lefts, rights));
+    ASSERT_FALSE(joiner->is_right_complete());
+}
+
+// NOLINTNEXTLINE
+TEST_F(MergeJoinerTest, test_reject_null_safe_equal) {
+    // the merge join has no join op, so only the inner join can be planned, and it has no null-safe equal.
+    TPlanNode tnode;
+    tnode.node_id = 1;
+    tnode.node_type = TPlanNodeType::MERGE_JOIN_NODE;
+    tnode.limit = -1;
+    tnode.row_tuples = {0, 1};
+    tnode.nullable_tuples = {false, false};
+    TEqJoinCondition cmp_conjunct;
+    cmp_conjunct.__set_opcode(TExprOpcode::EQ_FOR_NULL);
+    tnode.merge_join_node.cmp_conjuncts.push_back(cmp_conjunct);
+
+    MergeJoinNode node(&_pool, tnode, *_desc_tbl);
+    ASSERT_TRUE(node.init(tnode, nullptr).is_not_supported());
+
+    // no equal join condition at all.
+    tnode.merge_join_node.cmp_conjuncts.clear();
+    MergeJoinNode cross_node(&_pool, tnode, *_desc_tbl);
+    ASSERT_FALSE(cross_node.init(tnode, nullptr).ok());
+}
+
+} // namespace starrocks::vectorized
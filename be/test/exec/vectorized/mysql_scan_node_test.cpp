@@ -0,0 +1,54 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/mysql_scan_node.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+namespace starrocks::vectorized {
+
+using Filters = std::vector<std::string>;
+
+// NOLINTNEXTLINE
+TEST(MysqlScanNodeTest, test_split_empty_range) {
+    // the MIN and MAX of an empty table are not read.
+    ASSERT_EQ(Filters(), MysqlScanNode::split_int_key_range("`k`", "", "", 4));
+    // a key which is not an integer is not split.
+    ASSERT_EQ(Filters(), MysqlScanNode::split_int_key_range("`k`", "a", "z", 4));
+    ASSERT_EQ(Filters(), MysqlScanNode::split_int_key_range("`k`", "1.5", "8.5", 4));
+    // nor is the table with the parallelism 1.
+    ASSERT_EQ(Filters(), MysqlScanNode::split_int_key_range("`k`", "0", "99", 1));
+}
+
+// NOLINTNEXTLINE
+TEST(MysqlScanNodeTest, test_split_single_value) {
+    // a single range is queried by a single scanner.
+    ASSERT_EQ(Filters{"1 = 1"}, MysqlScanNode::split_int_key_range("`k`", "5", "5", 4));
+}
+
+// NOLINTNEXTLINE
+TEST(MysqlScanNodeTest, test_split_even_range) {
+    // the first and the last ranges are unbounded.
+    Filters expected{"`k` < 25", "`k` >= 25 AND `k` < 50", "`k` >= 50 AND `k` < 75", "`k` >= 75"};
+    ASSERT_EQ(expected, MysqlScanNode::split_int_key_range("`k`", "0", "99", 4));
+    expected = {"`k` < -3", "`k` >= -3 AND `k` < 4", "`k` >= 4"};
+    ASSERT_EQ(expected, MysqlScanNode::split_int_key_range("`k`", "-10", "10", 3));
+}
+
+// NOLINTNEXTLINE
+TEST(MysqlScanNodeTest, test_split_skewed_range) {
+    // fewer values than ranges, every range has one value at least.
+    Filters expected{"`k` < 1", "`k` >= 1 AND `k` < 2", "`k` >= 2"};
+    ASSERT_EQ(expected, MysqlScanNode::split_int_key_range("`k`", "0", "2", 8));
+    // the whole range of BIGINT does not overflow.
+    expected = {"`k` < 0", "`k` >= 0"};
+    ASSERT_EQ(expected, MysqlScanNode::split_int_key_range("`k`", "-9223372036854775808", "9223372036854775807", 2));
+    // the ranges are split by the values of the keys, not by the number of rows.
+    expected = {"`k` < 250000001", "`k` >= 250000001 AND `k` < 500000001", "`k` >= 500000001 AND `k` < 750000001",
+                "`k` >= 750000001"};
+    ASSERT_EQ(expected, MysqlScanNode::split_int_key_range("`k`", "1", "1000000000", 4));
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,103 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/olap_scan_node.h"
+
+#include <gtest/gtest.h>
+
+#include "util/runtime_profile.h"
+
+namespace starrocks::vectorized {
+
+class OlapScanNodeTest : public ::testing::Test {
+protected:
+    static constexpr int32_t kMinChunks = 10;
+    static constexpr int32_t kMaxChunks = 30;
+
+    // take a chunk from |*num_result_chunks| and put the refilled chunks into |*num_pool_chunks| like get_next,
+    // the chunks owned by the node always match the adjusted number.
+    void _take(bool starved, int32_t* num_result_chunks, int32_t* num_pool_chunks) {
+        if (starved) {
+            ASSERT_EQ(0, *num_result_chunks);
+            // a scanner fills a chunk while the consumer waits.
+            --*num_pool_chunks;
+            ++*num_result_chunks;
+        }
+        --*num_result_chunks;
+        int refill = OlapScanNode::_num_chunks_to_refill(starved, *num_result_chunks, kMinChunks, kMaxChunks,
+                                                         &_num_chunks);
+        _peak_chunks.set(_num_chunks);
+        *num_pool_chunks += refill;
+        ASSERT_EQ(_num_chunks, *num_result_chunks + *num_pool_chunks);
+        ASSERT_GE(_num_chunks, kMinChunks);
+        ASSERT_LE(_num_chunks, kMaxChunks);
+    }
+
+    int32_t _num_chunks = kMinChunks;
+    RuntimeProfile::HighWaterMarkCounter _peak_chunks{TUnit::UNIT};
+};
+
+// NOLINTNEXTLINE
+TEST_F(OlapScanNodeTest, test_grow_while_starved) {
+    // a waiting consumer gets one more chunk each time.
+    int32_t num_chunks = kMinChunks;
+    ASSERT_EQ(2, OlapScanNode::_num_chunks_to_refill(true, 0, kMinChunks, kMaxChunks, &num_chunks));
+    ASSERT_EQ(kMinChunks + 1, num_chunks);
+
+    // never beyond the chunks of kMaxConcurrency scanners.
+    num_chunks = kMaxChunks;
+    ASSERT_EQ(1, OlapScanNode::_num_chunks_to_refill(true, 0, kMinChunks, kMaxChunks, &num_chunks));
+    ASSERT_EQ(kMaxChunks, num_chunks);
+}
+
+// NOLINTNEXTLINE
+TEST_F(OlapScanNodeTest, test_shrink_while_chunks_pile_up) {
+    // half of the chunks are waiting for the consumer, one chunk is dropped.
+    int32_t num_chunks = 20;
+    ASSERT_EQ(0, OlapScanNode::_num_chunks_to_refill(false, 10, kMinChunks, kMaxChunks, &num_chunks));
+    ASSERT_EQ(19, num_chunks);
+
+    // fewer chunks are waiting, the chunk is returned as it is.
+    num_chunks = 20;
+    ASSERT_EQ(1, OlapScanNode::_num_chunks_to_refill(false, 9, kMinChunks, kMaxChunks, &num_chunks));
+    ASSERT_EQ(20, num_chunks);
+
+    // never below the chunks of one scanner, so that a pending scanner can always be resubmitted.
+    num_chunks = kMinChunks;
+    ASSERT_EQ(1, OlapScanNode::_num_chunks_to_refill(false, kMinChunks, kMinChunks, kMaxChunks, &num_chunks));
+    ASSERT_EQ(kMinChunks, num_chunks);
+}
+
+// NOLINTNEXTLINE
+TEST_F(OlapScanNodeTest, test_follow_the_consumer) {
+    int32_t num_result_chunks = 0;
+    int32_t num_pool_chunks = kMinChunks;
+    _peak_chunks.set(_num_chunks);
+
+    // a fast consumer waits for the scanners, the chunks grow up to the max.
+    for (int i = 0; i < 2 * kMaxChunks; i++) {
+        _take(true, &num_result_chunks, &num_pool_chunks);
+    }
+    ASSERT_EQ(kMaxChunks, _num_chunks);
+
+    // a slow consumer, the scanners fill all the chunks in the pool before each take.
+    for (int i = 0; i < 2 * kMaxChunks; i++) {
+        num_result_chunks += num_pool_chunks;
+        num_pool_chunks = 0;
+        _take(false, &num_result_chunks, &num_pool_chunks);
+    }
+    // all the chunks are waiting, so they shrink to the min.
+    ASSERT_EQ(kMinChunks, _num_chunks);
+
+    // the consumer catches up without changing the chunks, and it grows again once it waits.
+    while (num_result_chunks > 0) {
+        _take(false, &num_result_chunks, &num_pool_chunks);
+    }
+    _take(true, &num_result_chunks, &num_pool_chunks);
+    ASSERT_EQ(kMinChunks + 1, _num_chunks);
+
+    // the peak is kept while the number of chunks shrinks.
+    ASSERT_EQ(kMaxChunks, _peak_chunks.value());
+    ASSERT_EQ(_num_chunks, _peak_chunks.current_value());
+}
+
+} // namespace starrocks::vectorized
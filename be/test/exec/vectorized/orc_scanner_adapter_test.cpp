@@ -373,6 +373,112 @@ TEST_F(OrcScannerAdapterTest, SkipStripeByConjunctsInPred) {
     EXPECT_LE(records, 0);
 }
 
+static void push_is_null_pred_texpr_node(std::vector<TExprNode>& nodes, const std::string& function_name,
+                                        SlotDescriptor* slot_desc, TPrimitiveType::type value_type) {
+    TExprNode is_null_node;
+    is_null_node.__set_node_type(TExprNodeType::type::FUNCTION_CALL);
+    is_null_node.__set_type(create_primitive_type_desc(TPrimitiveType::BOOLEAN));
+    is_null_node.__set_num_children(1);
+    is_null_node.__set_use_vectorized(true);
+    TFunction fn;
+    fn.name.__set_function_name(function_name);
+    is_null_node.__set_fn(fn);
+
+    TExprNode slot_node;
+    slot_node.__set_node_type(TExprNodeType::SLOT_REF);
+    slot_node.__set_num_children(0);
+    slot_node.__set_type(create_primitive_type_desc(value_type));
+    TSlotRef slot_ref;
+    slot_ref.__set_slot_id(slot_desc->id());
+    slot_ref.__set_tuple_id(slot_desc->parent());
+    slot_node.__set_slot_ref(slot_ref);
+    slot_node.__set_use_vectorized(true);
+
+    nodes.emplace_back(is_null_node);
+    nodes.emplace_back(slot_node);
+}
+
+TEST_F(OrcScannerAdapterTest, SkipStripeByConjunctsInPredOfAllLiterals) {
+    OrcScannerAdapter adapter(_src_slot_descs);
+
+    // lo_orderdate in (0, 200000), only the second literal is in the file.
+    std::vector<TExprNode> nodes;
+    int slot_index = 1;
+    std::vector<TExprNode> lit_nodes = {create_int_literal_node(TPrimitiveType::INT, 0),
+                                        create_int_literal_node(TPrimitiveType::INT, 200000)};
+    push_inpred_texpr_node(nodes, TExprOpcode::type::FILTER_IN, _src_slot_descs[slot_index], TPrimitiveType::INT,
+                           lit_nodes);
+    ExprContext* ctx = create_expr_context(&_pool, nodes);
+    std::vector<Expr*> conjuncts = {ctx->root()};
+    adapter.set_conjuncts(conjuncts);
+
+    auto input_stream = orc::readLocalFile(input_orc_file);
+    adapter.init(std::move(input_stream));
+    uint64_t records = get_hit_rows(&adapter);
+    // the row group of the only item whose value is 200000.
+    EXPECT_EQ(records, default_row_group_size);
+}
+
+TEST_F(OrcScannerAdapterTest, SkipRowGroupsByConjunctsIsNull) {
+    // there is no null in lo_custkey.
+    {
+        OrcScannerAdapter adapter(_src_slot_descs);
+        std::vector<TExprNode> nodes;
+        push_is_null_pred_texpr_node(nodes, "is_null_pred", _src_slot_descs[0], TPrimitiveType::TINYINT);
+        ExprContext* ctx = create_expr_context(&_pool, nodes);
+        std::vector<Expr*> conjuncts = {ctx->root()};
+        adapter.set_conjuncts(conjuncts);
+
+        auto input_stream = orc::readLocalFile(input_orc_file);
+        adapter.init(std::move(input_stream));
+        EXPECT_EQ(get_hit_rows(&adapter), 0);
+    }
+    {
+        OrcScannerAdapter adapter(_src_slot_descs);
+        std::vector<TExprNode> nodes;
+        push_is_null_pred_texpr_node(nodes, "is_not_null_pred", _src_slot_descs[0], TPrimitiveType::TINYINT);
+        ExprContext* ctx = create_expr_context(&_pool, nodes);
+        std::vector<Expr*> conjuncts = {ctx->root()};
+        adapter.set_conjuncts(conjuncts);
+
+        auto input_stream = orc::readLocalFile(input_orc_file);
+        adapter.init(std::move(input_stream));
+        EXPECT_EQ(get_hit_rows(&adapter), total_record_num);
+    }
+}
+
+// Count the stripes whose row groups are picked.
+class CountPickedStripesRowFilter : public orc::RowReaderFilter {
+public:
+    void onStartingPickRowGroups() override { num_picked_stripes++; }
+
+    int num_picked_stripes = 0;
+};
+
+TEST_F(OrcScannerAdapterTest, SkipStripeByStripeStatistics) {
+    OrcScannerAdapter adapter(_src_slot_descs);
+    auto filter = std::make_shared<CountPickedStripesRowFilter>();
+    adapter.set_row_reader_filter(filter);
+
+    // lo_orderdate == 200000
+    // stripe0 min/max = 9/199927 [5120]
+    // stripe1 min/max= 19/200000 [4880]
+    std::vector<TExprNode> nodes;
+    int slot_index = 1;
+    TExprNode lit_node = create_int_literal_node(TPrimitiveType::INT, 200000);
+    push_binary_pred_texpr_node(nodes, TExprOpcode::type::EQ, _src_slot_descs[slot_index], TPrimitiveType::INT,
+                                lit_node);
+    ExprContext* ctx = create_expr_context(&_pool, nodes);
+    std::vector<Expr*> conjuncts = {ctx->root()};
+    adapter.set_conjuncts(conjuncts);
+
+    auto input_stream = orc::readLocalFile(input_orc_file);
+    adapter.init(std::move(input_stream));
+    EXPECT_EQ(get_hit_rows(&adapter), default_row_group_size);
+    // stripe0 is skipped by its statistics without reading its row indexes.
+    EXPECT_EQ(filter->num_picked_stripes, 1);
+}
+
 class SkipRowGroupRowFilter : public orc::RowReaderFilter {
 public:
     bool filterOnOpeningStripe(uint64_t stripeIndex, const orc::proto::StripeInformation* stripeInformation) override {
@@ -0,0 +1,85 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/range_join_predicate.h"
+
+#include <gtest/gtest.h>
+
+#include "column/chunk.h"
+#include "column/column_helper.h"
+
+namespace starrocks::vectorized {
+
+static ChunkPtr create_chunk(SlotId slot_id, const std::vector<int32_t>& values, int32_t null_value) {
+    auto column = ColumnHelper::create_column(TypeDescriptor(TYPE_INT), true);
+    for (int32_t value : values) {
+        if (value == null_value) {
+            column->append_nulls(1);
+        } else {
+            column->append_datum(Datum(value));
+        }
+    }
+    butil::FlatMap<SlotId, size_t> map;
+    map.init(4);
+    map[slot_id] = 0;
+    return std::make_shared<Chunk>(Columns{column}, map);
+}
+
+static bool satisfy(TExprOpcode::type op, int32_t probe, int32_t build) {
+    switch (op) {
+    case TExprOpcode::LT:
+        return probe < build;
+    case TExprOpcode::LE:
+        return probe <= build;
+    case TExprOpcode::GT:
+        return probe > build;
+    default:
+        return probe >= build;
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(RangeJoinPredicateTest, sort_build_chunk) {
+    auto build_chunk = create_chunk(1, {5, -1, 1, 3, 3, 9}, -1);
+    RangeJoinPredicate predicate(0, 1, TExprOpcode::GE);
+
+    auto sorted_chunk = predicate.sort_build_chunk(build_chunk);
+    ASSERT_EQ(5, sorted_chunk->num_rows());
+    std::vector<int32_t> expected{1, 3, 3, 5, 9};
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(expected[i], sorted_chunk->get_column_by_slot_id(1)->get(i).get_int32());
+    }
+}
+
+// NOLINTNEXTLINE
+TEST(RangeJoinPredicateTest, compute_ranges) {
+    std::vector<int32_t> build_values;
+    for (int32_t i = 0; i < 200; ++i) {
+        build_values.push_back((i * 37) % 61);
+    }
+    auto build_chunk = create_chunk(1, build_values, 0);
+    auto probe_chunk = create_chunk(0, {-5, 0, 1, 17, 30, 30, 60, 100}, 0);
+
+    for (auto op : {TExprOpcode::LT, TExprOpcode::LE, TExprOpcode::GT, TExprOpcode::GE}) {
+        RangeJoinPredicate predicate(0, 1, op);
+        auto sorted_chunk = predicate.sort_build_chunk(build_chunk);
+        const auto& sorted_column = sorted_chunk->get_column_by_slot_id(1);
+
+        std::vector<uint32_t> starts;
+        std::vector<uint32_t> ends;
+        predicate.compute_ranges(*probe_chunk, *sorted_chunk, &starts, &ends);
+        ASSERT_EQ(probe_chunk->num_rows(), starts.size());
+        ASSERT_EQ(probe_chunk->num_rows(), ends.size());
+
+        // The range must contain exactly the build rows satisfying the predicate.
+        const auto& probe_column = probe_chunk->get_column_by_slot_id(0);
+        for (size_t i = 0; i < probe_chunk->num_rows(); ++i) {
+            for (size_t j = 0; j < sorted_chunk->num_rows(); ++j) {
+                bool matched = !probe_column->is_null(i) &&
+                               satisfy(op, probe_column->get(i).get_int32(), sorted_column->get(j).get_int32());
+                ASSERT_EQ(matched, starts[i] <= j && j < ends[i]) << "op=" << op << " probe=" << i << " build=" << j;
+            }
+        }
+    }
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,91 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exec/vectorized/spill_file.h"
+
+#include <gtest/gtest.h>
+
+#include <deque>
+
+#include "column/chunk.h"
+#include "column/column_helper.h"
+#include "column/datum_tuple.h"
+#include "env/env.h"
+#include "util/file_utils.h"
+
+namespace starrocks::vectorized {
+
+class SpillFileTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        ASSERT_TRUE(FileUtils::create_dir(_dir).ok());
+        _template_chunk = std::make_unique<Chunk>();
+        _template_chunk->append_column(ColumnHelper::create_column(TypeDescriptor(TYPE_INT), false), 1);
+        _template_chunk->append_column(
+                ColumnHelper::create_column(TypeDescriptor::create_varchar_type(TypeDescriptor::MAX_VARCHAR_LENGTH),
+                                            true),
+                2);
+    }
+
+    void TearDown() override { ASSERT_TRUE(FileUtils::remove_all(_dir).ok()); }
+
+protected:
+    ChunkUniquePtr _create_chunk(int32_t begin, int32_t end) {
+        ChunkUniquePtr chunk = _template_chunk->clone_empty(end - begin);
+        for (int32_t i = begin; i < end; i++) {
+            chunk->get_column_by_index(0)->append_datum(Datum(i));
+            if (i % 3 == 0) {
+                chunk->get_column_by_index(1)->append_datum(Datum());
+            } else {
+                _values.emplace_back(std::to_string(i));
+                chunk->get_column_by_index(1)->append_datum(Datum(Slice(_values.back())));
+            }
+        }
+        return chunk;
+    }
+
+    const std::string _dir = "./ut_dir/spill_file_test";
+    ChunkUniquePtr _template_chunk;
+    std::deque<std::string> _values;
+};
+
+TEST_F(SpillFileTest, test_write_and_read) {
+    std::string path = _dir + "/spill_0";
+    auto res = SpillFile::create_at(path);
+    ASSERT_TRUE(res.ok()) << res.status().to_string();
+    SpillFilePtr file = std::move(res).value();
+
+    std::vector<ChunkUniquePtr> chunks;
+    chunks.emplace_back(_create_chunk(0, 100));
+    chunks.emplace_back(_create_chunk(100, 101));
+    chunks.emplace_back(_create_chunk(101, 4197));
+    for (const auto& chunk : chunks) {
+        ASSERT_TRUE(file->append(*chunk).ok());
+    }
+    ASSERT_EQ(3, file->num_chunks());
+    ASSERT_EQ(4197, file->num_rows());
+
+    ASSERT_TRUE(file->flip_to_read().ok());
+    ASSERT_FALSE(file->append(*chunks[0]).ok());
+    for (const auto& expected : chunks) {
+        auto chunk_or = file->read(*_template_chunk);
+        ASSERT_TRUE(chunk_or.ok()) << chunk_or.status().to_string();
+        ChunkUniquePtr chunk = std::move(chunk_or).value();
+        ASSERT_NE(nullptr, chunk);
+        ASSERT_EQ(expected->num_rows(), chunk->num_rows());
+        ASSERT_TRUE(chunk->is_slot_exist(1));
+        ASSERT_TRUE(chunk->is_slot_exist(2));
+        for (size_t i = 0; i < chunk->num_rows(); i++) {
+            ASSERT_EQ(expected->debug_row(i), chunk->debug_row(i));
+        }
+    }
+    auto eof = file->read(*_template_chunk);
+    ASSERT_TRUE(eof.ok());
+    ASSERT_EQ(nullptr, eof.value());
+
+    // The file is removed with the object
+    ASSERT_TRUE(FileUtils::check_exist(path));
+    file.reset();
+    ASSERT_FALSE(FileUtils::check_exist(path));
+}
+
+} // namespace starrocks::vectorized
@@ -10,6 +10,7 @@
 #include "column/fixed_length_column.h"
 #include "column/nullable_column.h"
 #include "column/vectorized_fwd.h"
+#include "common/config.h"
 #include "exprs/agg/aggregate_factory.h"
 #include "exprs/agg/maxmin.h"
 #include "exprs/agg/nullable_aggregate.h"
@@ -629,6 +630,42 @@ TEST_F(AggregateTest, test_sum_distinct) {
                                                       DecimalV2Value(21));
 }
 
+TEST_F(AggregateTest, test_distinct_bitmap) {
+    int64_t old_threshold = config::distinct_agg_bitmap_threshold;
+    // both of the states use bitmap
+    config::distinct_agg_bitmap_threshold = 100;
+    const AggregateFunction* func = get_aggregate_function("multi_distinct_count2", TYPE_INT, TYPE_BIGINT, false);
+    test_agg_function<int32_t, int64_t>(ctx, func, 1024, 1000, 2024);
+    func = get_aggregate_function("multi_distinct_sum2", TYPE_BIGINT, TYPE_BIGINT, false);
+    test_agg_function<int64_t, int64_t>(ctx, func, 523776, 2499500, 3023276);
+
+    // the bitmap of column 1 is merged into the hash set of column 2
+    config::distinct_agg_bitmap_threshold = 1010;
+    func = get_aggregate_function("multi_distinct_count2", TYPE_SMALLINT, TYPE_BIGINT, false);
+    test_agg_function<int16_t, int64_t>(ctx, func, 1024, 1000, 2024);
+    func = get_aggregate_function("multi_distinct_sum2", TYPE_INT, TYPE_BIGINT, false);
+    test_agg_function<int32_t, int64_t>(ctx, func, 523776, 2499500, 3023276);
+
+    // negative keys
+    config::distinct_agg_bitmap_threshold = 10;
+    func = get_aggregate_function("multi_distinct_sum2", TYPE_BIGINT, TYPE_BIGINT, false);
+    auto column = Int64Column::create();
+    for (int i = -100; i < 100; i++) {
+        column->append(i);
+        column->append(i);
+    }
+    column->append(std::numeric_limits<int64_t>::min() + 1);
+    column->append(std::numeric_limits<int64_t>::max());
+    std::unique_ptr<ManagedAggregateState> state = ManagedAggregateState::Make(func);
+    const Column* row_column = column.get();
+    func->update_batch_single_state(ctx, row_column->size(), &row_column, state->mutable_data());
+    auto result_column = Int64Column::create();
+    func->finalize_to_column(ctx, state->data(), result_column.get());
+    ASSERT_EQ(-100, result_column->get_data()[0]);
+
+    config::distinct_agg_bitmap_threshold = old_threshold;
+}
+
 TEST_F(AggregateTest, test_dict_merge) {
     const AggregateFunction* func = get_aggregate_function("dict_merge", TYPE_ARRAY, TYPE_VARCHAR, false);
     ColumnBuilder<TYPE_VARCHAR> builder;
@@ -730,6 +767,47 @@ TEST_F(AggregateTest, test_sum_nullable) {
     ASSERT_EQ(4950, result_data.get_data()[0]);
 }
 
+TEST_F(AggregateTest, test_remove_window_rows) {
+    using NullableSumInt64 = NullableAggregateFunctionState<SumAggregateState<int64_t>>;
+    const AggregateFunction* sum_null = get_aggregate_function("sum", TYPE_INT, TYPE_BIGINT, true);
+    const AggregateFunction* count_null = get_aggregate_function("count", TYPE_BIGINT, TYPE_BIGINT, true);
+    ASSERT_TRUE(sum_null->is_removable());
+    ASSERT_TRUE(count_null->is_removable());
+    ASSERT_FALSE(get_aggregate_function("sum", TYPE_DOUBLE, TYPE_DOUBLE, true)->is_removable());
+    ASSERT_FALSE(get_aggregate_function("avg", TYPE_INT, TYPE_DOUBLE, true)->is_removable());
+
+    auto data_column = Int32Column::create();
+    auto null_column = NullColumn::create();
+    for (int i = 0; i < 100; i++) {
+        data_column->append(i);
+        null_column->append(i % 2 ? 1 : 0);
+    }
+    auto column = NullableColumn::create(std::move(data_column), std::move(null_column));
+    const Column* row_column = column.get();
+
+    // slide the frame of 10 rows by 3 rows each time.
+    std::unique_ptr<ManagedAggregateState> sum_state = ManagedAggregateState::Make(sum_null);
+    std::unique_ptr<ManagedAggregateState> count_state = ManagedAggregateState::Make(count_null);
+    sum_null->update_batch_single_state(ctx, sum_state->mutable_data(), &row_column, 0, 100, 0, 10);
+    count_null->update_batch_single_state(ctx, count_state->mutable_data(), &row_column, 0, 100, 0, 10);
+    for (int start = 3; start + 10 <= 100; start += 3) {
+        sum_null->update_batch_single_state(ctx, sum_state->mutable_data(), &row_column, 0, 100, start + 7,
+                                            start + 10);
+        sum_null->remove_batch_single_state(ctx, sum_state->mutable_data(), &row_column, start - 3, start);
+        count_null->update_batch_single_state(ctx, count_state->mutable_data(), &row_column, 0, 100, start + 7,
+                                              start + 10);
+        count_null->remove_batch_single_state(ctx, count_state->mutable_data(), &row_column, start - 3, start);
+
+        int64_t expected_sum = 0;
+        for (int i = start; i < start + 10; ++i) {
+            expected_sum += (i % 2 ? 0 : i);
+        }
+        auto* null_state = (NullableSumInt64*)sum_state->mutable_data();
+        ASSERT_EQ(expected_sum, *reinterpret_cast<const int64_t*>(null_state->nested_state()));
+        ASSERT_EQ(5, *reinterpret_cast<const int64_t*>(count_state->data()));
+    }
+}
+
 TEST_F(AggregateTest, test_count_nullable) {
     const AggregateFunction* func = get_aggregate_function("count", TYPE_BIGINT, TYPE_BIGINT, true);
     std::unique_ptr<ManagedAggregateState> state = ManagedAggregateState::Make(func);
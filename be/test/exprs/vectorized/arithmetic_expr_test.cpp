@@ -187,6 +187,47 @@ TEST_F(VectorizedArithmeticExprTest, nullMulExpr) {
     }
 }
 
+// return the same column for every evaluation, like a slot ref returns the column of the chunk.
+class SharedColumnExpr final : public MockCostExpr {
+public:
+    SharedColumnExpr(const TExprNode& t, ColumnPtr column) : MockCostExpr(t), column(std::move(column)) {}
+
+    ColumnPtr evaluate(ExprContext* context, vectorized::Chunk* ptr) override { return column; }
+
+    ColumnPtr column;
+};
+
+TEST_F(VectorizedArithmeticExprTest, reuseIntermediateResult) {
+    auto shared = Int32Column::create();
+    for (int j = 0; j < 10; ++j) {
+        shared->append(j);
+    }
+    SharedColumnExpr col1(expr_node, shared);
+    MockVectorizedExpr<TYPE_INT> col2(expr_node, 10, 2);
+
+    // (col1 - 2) * col1
+    expr_node.opcode = TExprOpcode::SUBTRACT;
+    std::unique_ptr<Expr> sub(VectorizedArithmeticExprFactory::from_thrift(expr_node));
+    sub->_children.push_back(&col1);
+    sub->_children.push_back(&col2);
+    expr_node.opcode = TExprOpcode::MULTIPLY;
+    std::unique_ptr<Expr> mul(VectorizedArithmeticExprFactory::from_thrift(expr_node));
+    mul->_children.push_back(sub.get());
+    mul->_children.push_back(&col1);
+
+    for (int i = 0; i < 2; ++i) {
+        ColumnPtr ptr = mul->evaluate(nullptr, nullptr);
+        auto v = std::static_pointer_cast<Int32Column>(ptr);
+        ASSERT_EQ(10, v->size());
+        ASSERT_NE(shared.get(), v.get());
+        for (int j = 0; j < v->size(); ++j) {
+            ASSERT_EQ((j - 2) * j, v->get_data()[j]);
+            // the shared column is never overwritten.
+            ASSERT_EQ(j, shared->get_data()[j]);
+        }
+    }
+}
+
 TEST_F(VectorizedArithmeticExprTest, divExpr) {
     expr_node.opcode = TExprOpcode::DIVIDE;
     std::unique_ptr<Expr> expr(VectorizedArithmeticExprFactory::from_thrift(expr_node));
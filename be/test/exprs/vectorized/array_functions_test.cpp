@@ -580,6 +580,65 @@ TEST_F(ArrayFunctionsTest, array_contains_nullable_array) {
     }
 }
 
+// NOLINTNEXTLINE
+TEST_F(ArrayFunctionsTest, array_contains_const) {
+    // array_contains([1, NULL, 3], 3)
+    // array_contains([NULL], 3)
+    // array_contains([], 3)
+    // array_contains([2, 3], 3)
+    {
+        auto array = ColumnHelper::create_column(TYPE_ARRAY_INT, false);
+        array->append_datum(DatumArray{(int32_t)1, Datum(), (int32_t)3});
+        array->append_datum(DatumArray{Datum()});
+        array->append_datum(DatumArray{});
+        array->append_datum(DatumArray{(int32_t)2, (int32_t)3});
+
+        auto target = ColumnHelper::create_const_column<TYPE_INT>(3, 4);
+
+        auto result = ArrayFunctions::array_contains(nullptr, {array, target});
+        EXPECT_EQ(4, result->size());
+        EXPECT_EQ(1, result->get(0).get_int8());
+        EXPECT_EQ(0, result->get(1).get_int8());
+        EXPECT_EQ(0, result->get(2).get_int8());
+        EXPECT_EQ(1, result->get(3).get_int8());
+    }
+    // array_contains(["abc", NULL, "def"], "abc")
+    // array_contains(["abc", NULL, "def"], "xyz")
+    // array_contains(["abc", NULL, "def"], NULL)
+    // array_contains(["abc", NULL, "def"], "def")
+    {
+        auto array_data = ColumnHelper::create_column(TYPE_ARRAY_VARCHAR, false);
+        array_data->append_datum(DatumArray{"abc", Datum(), "def"});
+        auto array = ConstColumn::create(array_data, 4);
+
+        auto target = ColumnHelper::create_column(TypeDescriptor(TYPE_VARCHAR), true);
+        target->append_datum(Datum("abc"));
+        target->append_datum(Datum("xyz"));
+        target->append_datum(Datum());
+        target->append_datum(Datum("def"));
+
+        auto result = ArrayFunctions::array_contains(nullptr, {array, target});
+        EXPECT_EQ(4, result->size());
+        EXPECT_EQ(1, result->get(0).get_int8());
+        EXPECT_EQ(0, result->get(1).get_int8());
+        EXPECT_EQ(1, result->get(2).get_int8());
+        EXPECT_EQ(1, result->get(3).get_int8());
+    }
+    // array_contains([1, 2, 3], 2) of 3 rows
+    {
+        auto array_data = ColumnHelper::create_column(TYPE_ARRAY_INT, false);
+        array_data->append_datum(DatumArray{(int32_t)1, (int32_t)2, (int32_t)3});
+        auto array = ConstColumn::create(array_data, 3);
+
+        auto target = ColumnHelper::create_const_column<TYPE_INT>(2, 3);
+
+        auto result = ArrayFunctions::array_contains(nullptr, {array, target});
+        EXPECT_EQ(3, result->size());
+        EXPECT_TRUE(result->is_constant());
+        EXPECT_EQ(1, result->get(2).get_int8());
+    }
+}
+
 // NOLINTNEXTLINE
 TEST_F(ArrayFunctionsTest, array_append) {
     // array_append([], NULL)
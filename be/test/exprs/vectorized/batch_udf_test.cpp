@@ -0,0 +1,118 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exprs/vectorized/batch_udf.h"
+
+#include <gtest/gtest.h>
+
+#include "column/binary_column.h"
+#include "column/column_helper.h"
+#include "column/nullable_column.h"
+#include "testutil/parallel_test.h"
+
+namespace starrocks::vectorized {
+
+using starrocks_udf::UdfColumn;
+using starrocks_udf::UdfResultColumn;
+
+// a + b, NULL if any of them is NULL.
+static void add_udf(FunctionContext* context, int num_args, const UdfColumn* args, UdfResultColumn* result) {
+    const auto* a = static_cast<const int32_t*>(args[0].data);
+    const auto* b = static_cast<const int32_t*>(args[1].data);
+    auto* r = static_cast<int64_t*>(result->data);
+    for (int64_t i = 0; i < result->num_rows; ++i) {
+        r[i] = static_cast<int64_t>(a[i]) + b[i];
+        result->null_data[i] = (args[0].null_data != nullptr && args[0].null_data[i]) ||
+                               (args[1].null_data != nullptr && args[1].null_data[i]);
+    }
+}
+
+// concat(a, b), NULL if a is empty.
+static void concat_udf(FunctionContext* context, int num_args, const UdfColumn* args, UdfResultColumn* result) {
+    std::string value;
+    for (int64_t i = 0; i < result->num_rows; ++i) {
+        value.clear();
+        for (int j = 0; j < num_args; ++j) {
+            const char* data = static_cast<const char*>(args[j].data);
+            value.append(data + args[j].offsets[i], data + args[j].offsets[i + 1]);
+        }
+        result->null_data[i] = args[0].offsets[i] == args[0].offsets[i + 1];
+        result->append_string(result, reinterpret_cast<const uint8_t*>(value.data()), value.size());
+    }
+}
+
+static void bad_string_udf(FunctionContext* context, int num_args, const UdfColumn* args, UdfResultColumn* result) {
+    result->append_string(result, reinterpret_cast<const uint8_t*>("a"), 1);
+}
+
+PARALLEL_TEST(BatchUdfTest, fixedLengthTypes) {
+    std::unique_ptr<FunctionContext> ctx(FunctionContext::create_test_context());
+    auto a = Int32Column::create();
+    auto a_nulls = NullColumn::create();
+    auto b = Int32Column::create();
+    for (int i = 0; i < 10; ++i) {
+        a->append(i);
+        a_nulls->append(i % 3 == 0);
+        b->append(std::numeric_limits<int32_t>::max());
+    }
+    Columns args{NullableColumn::create(a, a_nulls), b};
+    std::vector<TypeDescriptor> arg_types{TypeDescriptor(TYPE_INT), TypeDescriptor(TYPE_INT)};
+
+    auto result = call_batch_udf(add_udf, ctx.get(), TypeDescriptor(TYPE_BIGINT), arg_types, args, 10);
+    ASSERT_FALSE(ctx->has_error());
+    ASSERT_EQ(10, result->size());
+    ASSERT_TRUE(result->is_nullable());
+    auto* data = ColumnHelper::cast_to_raw<TYPE_BIGINT>(down_cast<NullableColumn*>(result.get())->data_column());
+    for (int i = 0; i < 10; ++i) {
+        if (i % 3 == 0) {
+            ASSERT_TRUE(result->is_null(i));
+        } else {
+            ASSERT_FALSE(result->is_null(i));
+            ASSERT_EQ(static_cast<int64_t>(i) + std::numeric_limits<int32_t>::max(), data->get_data()[i]);
+        }
+    }
+
+    Columns not_null_args{b, b};
+    result = call_batch_udf(add_udf, ctx.get(), TypeDescriptor(TYPE_BIGINT), arg_types, not_null_args, 10);
+    ASSERT_FALSE(result->is_nullable());
+    ASSERT_EQ(2L * std::numeric_limits<int32_t>::max(), ColumnHelper::cast_to_raw<TYPE_BIGINT>(result)->get_data()[9]);
+}
+
+PARALLEL_TEST(BatchUdfTest, stringTypes) {
+    std::unique_ptr<FunctionContext> ctx(FunctionContext::create_test_context());
+    auto a = BinaryColumn::create();
+    a->append(Slice("abc"));
+    a->append(Slice(""));
+    a->append(Slice("starrocks"));
+    Columns args{a, ColumnHelper::create_const_column<TYPE_VARCHAR>(Slice("-x"), 3)};
+    std::vector<TypeDescriptor> arg_types{TypeDescriptor::create_varchar_type(10),
+                                          TypeDescriptor::create_varchar_type(10)};
+
+    auto result = call_batch_udf(concat_udf, ctx.get(), TypeDescriptor::create_varchar_type(20), arg_types, args, 3);
+    ASSERT_FALSE(ctx->has_error());
+    ASSERT_EQ(3, result->size());
+    ASSERT_EQ("'abc-x'", result->debug_item(0));
+    ASSERT_TRUE(result->is_null(1));
+    ASSERT_EQ("'starrocks-x'", result->debug_item(2));
+}
+
+PARALLEL_TEST(BatchUdfTest, missingStringValues) {
+    std::unique_ptr<FunctionContext> ctx(FunctionContext::create_test_context());
+    auto a = BinaryColumn::create();
+    a->append(Slice("abc"));
+    a->append(Slice("def"));
+    Columns args{a};
+    std::vector<TypeDescriptor> arg_types{TypeDescriptor::create_varchar_type(10)};
+
+    auto result =
+            call_batch_udf(bad_string_udf, ctx.get(), TypeDescriptor::create_varchar_type(10), arg_types, args, 2);
+    ASSERT_TRUE(ctx->has_error());
+    ASSERT_EQ(2, result->size());
+}
+
+PARALLEL_TEST(BatchUdfTest, checkType) {
+    ASSERT_TRUE(check_batch_udf_type(TypeDescriptor(TYPE_DOUBLE)).ok());
+    ASSERT_TRUE(check_batch_udf_type(TypeDescriptor::create_varchar_type(10)).ok());
+    ASSERT_FALSE(check_batch_udf_type(TypeDescriptor(TYPE_DATETIME)).ok());
+}
+
+} // namespace starrocks::vectorized
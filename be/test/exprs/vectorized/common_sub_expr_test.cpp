@@ -0,0 +1,128 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "exprs/vectorized/common_sub_expr.h"
+
+#include <gtest/gtest.h>
+
+#include "runtime/primitive_type.h"
+
+namespace starrocks::vectorized {
+
+class CommonSubExprTest : public ::testing::Test {
+protected:
+    static TExprNode slot_ref_node(SlotId slot_id) {
+        TExprNode node;
+        node.__set_node_type(TExprNodeType::SLOT_REF);
+        node.__set_type(gen_type_desc(TPrimitiveType::VARCHAR));
+        node.__set_num_children(0);
+        TSlotRef slot_ref;
+        slot_ref.__set_slot_id(slot_id);
+        slot_ref.__set_tuple_id(0);
+        node.__set_slot_ref(slot_ref);
+        return node;
+    }
+
+    static TExprNode string_literal_node(const std::string& value) {
+        TExprNode node;
+        node.__set_node_type(TExprNodeType::STRING_LITERAL);
+        node.__set_type(gen_type_desc(TPrimitiveType::VARCHAR));
+        node.__set_num_children(0);
+        TStringLiteral literal;
+        literal.__set_value(value);
+        node.__set_string_literal(literal);
+        return node;
+    }
+
+    static TExprNode function_node(const std::string& name, int num_children) {
+        TExprNode node;
+        node.__set_node_type(TExprNodeType::FUNCTION_CALL);
+        node.__set_type(gen_type_desc(TPrimitiveType::VARCHAR));
+        node.__set_num_children(num_children);
+        TFunction fn;
+        fn.name.__set_function_name(name);
+        node.__set_fn(fn);
+        return node;
+    }
+
+    // get_json_string(slot_id, path)
+    static std::vector<TExprNode> get_json_string(SlotId slot_id, const std::string& path) {
+        return {function_node("get_json_string", 2), slot_ref_node(slot_id), string_literal_node(path)};
+    }
+
+    static TExpr make_expr(const std::string& fn_name, std::vector<std::vector<TExprNode>> children) {
+        TExpr expr;
+        expr.nodes.emplace_back(function_node(fn_name, children.size()));
+        for (auto& child : children) {
+            expr.nodes.insert(expr.nodes.end(), child.begin(), child.end());
+        }
+        return expr;
+    }
+};
+
+TEST_F(CommonSubExprTest, extract_shared_sub_expr) {
+    // upper(get_json_string(1, '$.a')), lower(get_json_string(1, '$.a')), lower(get_json_string(1, '$.b'))
+    std::vector<TExpr> exprs;
+    exprs.emplace_back(make_expr("upper", {get_json_string(1, "$.a")}));
+    exprs.emplace_back(make_expr("lower", {get_json_string(1, "$.a")}));
+    exprs.emplace_back(make_expr("lower", {get_json_string(1, "$.b")}));
+    std::vector<TExpr> origin_exprs = exprs;
+
+    SlotId next_slot_id = -2;
+    std::vector<SlotId> common_slot_ids;
+    std::vector<TExpr> common_exprs;
+    ASSERT_EQ(1, extract_common_sub_exprs(&exprs, 0, &next_slot_id, &common_slot_ids, &common_exprs));
+
+    ASSERT_EQ(1, common_slot_ids.size());
+    ASSERT_EQ(-2, common_slot_ids[0]);
+    ASSERT_EQ(-3, next_slot_id);
+    ASSERT_EQ(get_json_string(1, "$.a"), common_exprs[0].nodes);
+
+    for (int i = 0; i < 2; ++i) {
+        ASSERT_EQ(2, exprs[i].nodes.size());
+        ASSERT_EQ(origin_exprs[i].nodes[0], exprs[i].nodes[0]);
+        ASSERT_EQ(TExprNodeType::SLOT_REF, exprs[i].nodes[1].node_type);
+        ASSERT_EQ(-2, exprs[i].nodes[1].slot_ref.slot_id);
+    }
+    // the path differs.
+    ASSERT_EQ(origin_exprs[2], exprs[2]);
+}
+
+TEST_F(CommonSubExprTest, extract_outermost_sub_expr) {
+    // concat(upper(get_json_string(1, '$.a')), upper(get_json_string(1, '$.a')))
+    std::vector<TExpr> exprs;
+    auto upper = get_json_string(1, "$.a");
+    upper.insert(upper.begin(), function_node("upper", 1));
+    exprs.emplace_back(make_expr("concat", {upper, upper}));
+
+    SlotId next_slot_id = -2;
+    std::vector<SlotId> common_slot_ids;
+    std::vector<TExpr> common_exprs;
+    ASSERT_EQ(1, extract_common_sub_exprs(&exprs, 0, &next_slot_id, &common_slot_ids, &common_exprs));
+    ASSERT_EQ(upper, common_exprs[0].nodes);
+    ASSERT_EQ(3, exprs[0].nodes.size());
+    ASSERT_EQ(-2, exprs[0].nodes[1].slot_ref.slot_id);
+    ASSERT_EQ(-2, exprs[0].nodes[2].slot_ref.slot_id);
+}
+
+TEST_F(CommonSubExprTest, keep_roots_and_non_deterministic) {
+    std::vector<TExpr> exprs;
+    // the same roots are not extracted.
+    exprs.emplace_back(make_expr("upper", {{slot_ref_node(1)}}));
+    exprs.emplace_back(make_expr("upper", {{slot_ref_node(1)}}));
+    // neither are the expressions without slot or with non-deterministic functions.
+    exprs.emplace_back(make_expr("concat", {{function_node("rand", 0)}, {function_node("rand", 0)}}));
+    std::vector<TExprNode> rand_with_slot = {function_node("concat", 2), function_node("rand", 0), slot_ref_node(1)};
+    exprs.emplace_back(make_expr("upper", {rand_with_slot}));
+    exprs.emplace_back(make_expr("lower", {rand_with_slot}));
+    std::vector<TExpr> origin_exprs = exprs;
+
+    SlotId next_slot_id = -2;
+    std::vector<SlotId> common_slot_ids;
+    std::vector<TExpr> common_exprs;
+    ASSERT_EQ(0, extract_common_sub_exprs(&exprs, 0, &next_slot_id, &common_slot_ids, &common_exprs));
+    ASSERT_EQ(origin_exprs, exprs);
+    ASSERT_TRUE(common_exprs.empty());
+    ASSERT_EQ(-2, next_slot_id);
+}
+
+} // namespace starrocks::vectorized
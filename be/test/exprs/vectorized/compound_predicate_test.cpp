@@ -5,7 +5,10 @@
 #include <glog/logging.h>
 #include <gtest/gtest.h>
 
+#include "column/chunk.h"
 #include "column/fixed_length_column.h"
+#include "column/nullable_column.h"
+#include "exprs/vectorized/column_ref.h"
 #include "exprs/vectorized/mock_vectorized_expr.h"
 
 namespace starrocks {
@@ -387,5 +390,72 @@ TEST_F(VectorizedCompoundPredicateTest, testOnlyNullAndZeroRow) {
     }
 }
 
+TEST_F(VectorizedCompoundPredicateTest, evaluateUndecidedRows) {
+    TExprNode slot_node;
+    slot_node.node_type = TExprNodeType::SLOT_REF;
+    slot_node.type = gen_type_desc(TPrimitiveType::BOOLEAN);
+    slot_node.num_children = 0;
+    slot_node.__isset.slot_ref = true;
+    slot_node.slot_ref.slot_id = 1;
+    ColumnRef left(slot_node);
+    slot_node.slot_ref.slot_id = 2;
+    ColumnRef right(slot_node);
+
+    // left is true on the rows of multiple of 4, and null on the rows of multiple of 7.
+    const int num_rows = 100;
+    auto l = NullableColumn::create(BooleanColumn::create(), NullColumn::create());
+    auto r = NullableColumn::create(BooleanColumn::create(), NullColumn::create());
+    for (int i = 0; i < num_rows; ++i) {
+        if (i % 7 == 0) {
+            l->append_nulls(1);
+        } else {
+            l->append_datum(Datum(static_cast<uint8_t>(i % 4 == 0)));
+        }
+        if (i % 5 == 0) {
+            r->append_nulls(1);
+        } else {
+            r->append_datum(Datum(static_cast<uint8_t>(i % 3 == 0)));
+        }
+    }
+    Chunk chunk;
+    chunk.append_column(l, 1);
+    chunk.append_column(r, 2);
+
+    for (auto opcode : {TExprOpcode::COMPOUND_AND, TExprOpcode::COMPOUND_OR}) {
+        expr_node.opcode = opcode;
+        std::unique_ptr<Expr> expr(VectorizedCompoundPredicateFactory::from_thrift(expr_node));
+        expr->_children.push_back(&left);
+        expr->_children.push_back(&right);
+
+        ColumnPtr result = expr->evaluate(nullptr, &chunk);
+        ASSERT_EQ(num_rows, result->size());
+        for (int i = 0; i < num_rows; ++i) {
+            bool l_null = l->is_null(i);
+            bool r_null = r->is_null(i);
+            bool l_value = !l_null && i % 4 == 0;
+            bool r_value = !r_null && i % 3 == 0;
+            if (opcode == TExprOpcode::COMPOUND_AND) {
+                if ((!l_null && !l_value) || (!r_null && !r_value)) {
+                    ASSERT_FALSE(result->is_null(i));
+                    ASSERT_EQ(0, result->get(i).get_uint8());
+                } else if (l_null || r_null) {
+                    ASSERT_TRUE(result->is_null(i));
+                } else {
+                    ASSERT_EQ(1, result->get(i).get_uint8());
+                }
+            } else {
+                if (l_value || r_value) {
+                    ASSERT_FALSE(result->is_null(i));
+                    ASSERT_EQ(1, result->get(i).get_uint8());
+                } else if (l_null || r_null) {
+                    ASSERT_TRUE(result->is_null(i));
+                } else {
+                    ASSERT_EQ(0, result->get(i).get_uint8());
+                }
+            }
+        }
+    }
+}
+
 } // namespace vectorized
 } // namespace starrocks
@@ -2652,4 +2652,23 @@ TEST_F(DecimalBinaryFunctionTest, test_decimal128p38s14_div_decimal128p38s14_eq_
     test_vector_vector_assert_overflow<TYPE_DECIMAL128, DivOp, true>(test_case_array, 38, 14, 38, 14, 38, 14,
                                                                      overflows);
 }
-} // namespace starrocks::vectorized
\ No newline at end of file
+
+// the precision of the lhs scaled up is 18, so no row can overflow and the rows are not checked.
+TEST_F(DecimalBinaryFunctionTest, test_decimal64p10s2_div_decimal64p10s2_without_overflow_checks) {
+    DecimalTestCaseArray test_cases = {{"12345678.90", "3.00", "4115226.30000000"},
+                                       {"-10.00", "3.00", "-3.33333333"},
+                                       {"2.00", "3.00", "0.66666667"},
+                                       {"1.00", "8.00", "0.12500000"},
+                                       {"99999999.99", "0.01", "9999999999.00000000"},
+                                       {"-99999999.99", "-0.01", "9999999999.00000000"},
+                                       {"99999999.99", "0", "0"}};
+    auto columns = prepare_vector_vector<TYPE_DECIMAL64>(test_cases, 10, 2, 10, 2, 0, 0);
+    using Div = UnpackConstColumnDecimalBinaryFunction<DivOp, true>;
+    auto result = Div::evaluate<TYPE_DECIMAL64, TYPE_DECIMAL64, TYPE_DECIMAL64>(columns[0], columns[1]);
+    ASSERT_FALSE(result->is_nullable());
+    test_vector_vector<TYPE_DECIMAL64, DivOp, true>(test_cases, 10, 2, 10, 2, 38, 8);
+    test_vector_const<TYPE_DECIMAL64, DivOp, true>(test_cases, 10, 2, 10, 2, 38, 8);
+    test_const_vector<TYPE_DECIMAL64, DivOp, true>(test_cases, 10, 2, 10, 2, 38, 8);
+    test_const_const<TYPE_DECIMAL64, DivOp, true>(test_cases, 10, 2, 10, 2, 38, 8);
+}
+} // namespace starrocks::vectorized
@@ -106,4 +106,47 @@ TEST_F(FunctionHelperTest, testMergeNotNullableColumnMergeWithNullColumn) {
         }
     }
 }
+
+TEST_F(FunctionHelperTest, testUnionNullableColumn) {
+    // more rows than a SIMD register, to cover both the vectorized and the remaining rows.
+    const int num_rows = 100;
+    auto v1 = NullableColumn::create(Int32Column::create(), NullColumn::create());
+    auto v2 = NullableColumn::create(Int32Column::create(), NullColumn::create());
+    auto v3 = NullableColumn::create(Int32Column::create(), NullColumn::create());
+    for (int i = 0; i < num_rows; ++i) {
+        if (i % 3 == 0) {
+            v1->append_nulls(1);
+        } else {
+            v1->append_datum(Datum(i));
+        }
+        if (i % 5 == 0) {
+            v2->append_nulls(1);
+        } else {
+            v2->append_datum(Datum(i));
+        }
+        v3->append_datum(Datum(i));
+    }
+    ASSERT_FALSE(v3->has_null());
+
+    auto nulls = FunctionHelper::union_nullable_column(v1, v2);
+    ASSERT_EQ(num_rows, nulls->size());
+    for (int i = 0; i < num_rows; ++i) {
+        ASSERT_EQ(i % 3 == 0 || i % 5 == 0, nulls->get_data()[i]);
+    }
+
+    nulls = FunctionHelper::union_nullable_column(v1, v3);
+    ASSERT_EQ(num_rows, nulls->size());
+    for (int i = 0; i < num_rows; ++i) {
+        ASSERT_EQ(i % 3 == 0, nulls->get_data()[i]);
+    }
+
+    auto produce_nulls = NullColumn::create();
+    for (int i = 0; i < num_rows; ++i) {
+        produce_nulls->append(i % 7 == 0 ? DATUM_NULL : DATUM_NOT_NULL);
+    }
+    FunctionHelper::union_produce_nullable_column(v1, v2, &produce_nulls);
+    for (int i = 0; i < num_rows; ++i) {
+        ASSERT_EQ(i % 3 == 0 || i % 5 == 0 || i % 7 == 0, produce_nulls->get_data()[i]);
+    }
+}
 } // namespace starrocks::vectorized
\ No newline at end of file
@@ -327,5 +327,75 @@ TEST_F(RuntimeFilterTest, TestJoinRuntimeFilterMerge3) {
     EXPECT_EQ(pbf0->max_value(), Slice("dd", 2));
 }
 
+TEST_F(RuntimeFilterTest, TestJoinRuntimeFilterShuffleHashCache) {
+    const size_t num_partitions = 3;
+    ColumnPtr column = ColumnHelper::create_column(TypeDescriptor(TYPE_INT), false);
+    auto* col = ColumnHelper::as_raw_column<RunTimeTypeTraits<TYPE_INT>::ColumnType>(column);
+    for (int i = 0; i < 200; i++) {
+        col->append(i);
+    }
+
+    std::vector<uint32_t> hashes;
+    JoinRuntimeFilter::compute_shuffle_hashes(column.get(), TRuntimeFilterBuildJoinMode::PARTITIONED, &hashes);
+    ASSERT_EQ(hashes.size(), 200);
+
+    // build the partitions of a shuffle-aware runtime filter containing the even numbers.
+    RuntimeBloomFilter<TYPE_INT> partitions[num_partitions];
+    for (auto& partition : partitions) {
+        partition.init(100);
+        partition.set_join_mode(TRuntimeFilterBuildJoinMode::PARTITIONED);
+    }
+    for (int i = 0; i < 200; i += 2) {
+        partitions[hashes[i] % num_partitions].insert(&i);
+    }
+    RuntimeBloomFilter<TYPE_INT> bf;
+    bf.init_min_max();
+    for (auto& partition : partitions) {
+        bf.concat(&partition);
+    }
+
+    JoinRuntimeFilter::ShuffleHashCache cache;
+    const std::vector<uint32_t>& cached = cache.get_or_compute(column.get(), TRuntimeFilterBuildJoinMode::PARTITIONED);
+    EXPECT_EQ(cached, hashes);
+    EXPECT_EQ(&cached, &cache.get_or_compute(column.get(), TRuntimeFilterBuildJoinMode::PARTITIONED));
+    EXPECT_NE(&cached, &cache.get_or_compute(column.get(), TRuntimeFilterBuildJoinMode::BUCKET_SHUFFLE));
+
+    JoinRuntimeFilter::RunningContext ctx;
+    Column::Filter expected = bf.evaluate(column.get(), &ctx);
+    ctx.shuffle_hash_cache = &cache;
+    Column::Filter actual = bf.evaluate(column.get(), &ctx);
+    EXPECT_EQ(expected, actual);
+    for (int i = 0; i < 200; i += 2) {
+        EXPECT_TRUE(actual[i]);
+    }
+    cache.clear();
+    EXPECT_EQ(expected, bf.evaluate(column.get(), &ctx));
+}
+
+TEST_F(RuntimeFilterTest, TestSelectivityWindow) {
+    RuntimeFilterSelectivityWindow window;
+    EXPECT_TRUE(window.empty());
+    EXPECT_EQ(1.0, window.selectivity());
+
+    window.add(1000, 100, 2000);
+    EXPECT_FALSE(window.empty());
+    EXPECT_DOUBLE_EQ(0.1, window.selectivity());
+    EXPECT_DOUBLE_EQ(2.0, window.cost_per_row());
+    EXPECT_DOUBLE_EQ(2.0 / 0.9, window.rank());
+
+    // a cheaper filter filtering out as many rows is ranked first.
+    RuntimeFilterSelectivityWindow cheaper;
+    cheaper.add(1000, 100, 1000);
+    EXPECT_LT(cheaper.rank(), window.rank());
+
+    // only the last samples are kept, so the filter turning ineffective is measured so.
+    for (size_t i = 0; i < RuntimeFilterSelectivityWindow::k_num_samples; i++) {
+        window.add(1000, 1000, 2000);
+    }
+    EXPECT_DOUBLE_EQ(1.0, window.selectivity());
+    window.add(1000, 0, 2000);
+    EXPECT_DOUBLE_EQ(0.75, window.selectivity());
+}
+
 } // namespace vectorized
 } // namespace starrocks
@@ -1743,6 +1743,45 @@ PARALLEL_TEST(VecStringFunctionsTest, regexpReplaceConstPattern) {
                     .ok());
 }
 
+PARALLEL_TEST(VecStringFunctionsTest, regexpConstPatternPrefilter) {
+    std::unique_ptr<FunctionContext> ctx(FunctionContext::create_test_context());
+    auto context = ctx.get();
+
+    auto str = BinaryColumn::create();
+    auto ptn = ColumnHelper::create_const_column<TYPE_VARCHAR>("b+(c)", 1);
+    auto replace = ColumnHelper::create_const_column<TYPE_VARCHAR>("<\\1>", 1);
+    auto field = ColumnHelper::create_const_column<TYPE_BIGINT>(1, 1);
+
+    std::string strs[] = {"abbcd", "xyz", "", "bc bbc"};
+    std::string replaced[] = {"a<c>d", "xyz", "", "<c> <c>"};
+    std::string extracted[] = {"c", "", "", "c"};
+    for (const auto& s : strs) {
+        str->append(s);
+    }
+
+    Columns columns{str, ptn, replace};
+    context->impl()->set_constant_columns(columns);
+    ASSERT_TRUE(StringFunctions::regexp_prepare(context, FunctionContext::FunctionStateScope::FRAGMENT_LOCAL).ok());
+    ASSERT_TRUE(StringFunctions::regexp_prepare(context, FunctionContext::FunctionStateScope::THREAD_LOCAL).ok());
+    ASSERT_NE(nullptr, context->get_function_state(FunctionContext::FunctionStateScope::THREAD_LOCAL));
+
+    auto result = StringFunctions::regexp_replace(context, columns);
+    auto v = ColumnHelper::as_column<BinaryColumn>(result);
+    for (int i = 0; i < sizeof(strs) / sizeof(strs[0]); ++i) {
+        ASSERT_EQ(replaced[i], v->get_data()[i].to_string());
+    }
+
+    columns[2] = field;
+    result = StringFunctions::regexp_extract(context, columns);
+    v = ColumnHelper::as_column<BinaryColumn>(result);
+    for (int i = 0; i < sizeof(strs) / sizeof(strs[0]); ++i) {
+        ASSERT_EQ(extracted[i], v->get_data()[i].to_string());
+    }
+
+    ASSERT_TRUE(StringFunctions::regexp_close(context, FunctionContext::FunctionStateScope::THREAD_LOCAL).ok());
+    ASSERT_TRUE(StringFunctions::regexp_close(context, FunctionContext::FunctionStateScope::FRAGMENT_LOCAL).ok());
+}
+
 PARALLEL_TEST(VecStringFunctionsTest, regexpReplace) {
     std::unique_ptr<FunctionContext> ctx(FunctionContext::create_test_context());
     auto context = ctx.get();
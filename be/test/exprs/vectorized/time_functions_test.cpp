@@ -857,6 +857,40 @@ TEST_F(TimeFunctionsTest, fromUnixToDatetimeWithConstFormat) {
     }
 }
 
+TEST_F(TimeFunctionsTest, fromUnixToDatetimeWithFixedConstFormat) {
+    std::string formats[] = {"yyyy-MM-dd HH:mm:ss", "%Y-%m-%d %H:%i:%s", "%Y-%m-%d", "yyyyMMdd"};
+    std::string res[][2] = {{"1970-01-01 16:00:00", "1970-01-01 17:03:09"},
+                            {"1970-01-01 16:00:00", "1970-01-01 17:03:09"},
+                            {"1970-01-01", "1970-01-01"},
+                            {"19700101", "19700101"}};
+    for (int i = 0; i < sizeof(formats) / sizeof(formats[0]); ++i) {
+        Columns columns;
+        auto tc1 = Int32Column::create();
+        tc1->append(24 * 60 * 60);
+        tc1->append(3789 + 24 * 60 * 60);
+        auto tc2 = ColumnHelper::create_const_column<TYPE_VARCHAR>(formats[i], 1);
+
+        columns.emplace_back(tc1);
+        columns.emplace_back(tc2);
+
+        _utils->get_fn_ctx()->impl()->set_constant_columns(columns);
+
+        ASSERT_TRUE(TimeFunctions::from_unix_prepare(_utils->get_fn_ctx(),
+                                                     FunctionContext::FunctionStateScope::FRAGMENT_LOCAL)
+                            .ok());
+
+        ColumnPtr result = TimeFunctions::from_unix_to_datetime_with_format(_utils->get_fn_ctx(), columns);
+
+        auto v = ColumnHelper::cast_to<TYPE_VARCHAR>(result);
+        ASSERT_EQ(res[i][0], v->get_data()[0]);
+        ASSERT_EQ(res[i][1], v->get_data()[1]);
+
+        ASSERT_TRUE(TimeFunctions::from_unix_close(_utils->get_fn_ctx(),
+                                                   FunctionContext::FunctionContext::FunctionStateScope::FRAGMENT_LOCAL)
+                            .ok());
+    }
+}
+
 TEST_F(TimeFunctionsTest, from_days) {
     FunctionContext* ctx = FunctionContext::create_test_context();
     std::unique_ptr<FunctionContext> x(ctx);
@@ -1459,6 +1493,56 @@ TEST_F(TimeFunctionsTest, convertTzConstTest) {
                     .ok());
 }
 
+TEST_F(TimeFunctionsTest, convertTzAcrossTransitions) {
+    std::string zones[][2] = {{"America/Los_Angeles", "Asia/Shanghai"},
+                              {"Asia/Shanghai", "America/Los_Angeles"},
+                              {"Europe/London", "America/Los_Angeles"},
+                              {"+08:00", "Europe/London"}};
+    auto tc = TimestampColumn::create();
+    // every 10 minutes around the transitions of 2021, in both directions.
+    for (int month : {3, 11}) {
+        for (int day = 6; day <= 28; day += 7) {
+            for (int minute = 0; minute < 24 * 60; minute += 10) {
+                tc->append(TimestampValue::create(2021, month, day, minute / 60, minute % 60, 7));
+            }
+            for (int minute = 24 * 60 - 1; minute >= 0; minute -= 10) {
+                tc->append(TimestampValue::create(2021, month, day, minute / 60, minute % 60, 7));
+            }
+        }
+    }
+
+    for (const auto& zone : zones) {
+        Columns columns;
+        columns.emplace_back(tc);
+        columns.emplace_back(ColumnHelper::create_const_column<TYPE_VARCHAR>(zone[0], 1));
+        columns.emplace_back(ColumnHelper::create_const_column<TYPE_VARCHAR>(zone[1], 1));
+        _utils->get_fn_ctx()->impl()->set_constant_columns(columns);
+        ASSERT_TRUE(TimeFunctions::convert_tz_prepare(_utils->get_fn_ctx(),
+                                                      FunctionContext::FunctionStateScope::FRAGMENT_LOCAL)
+                            .ok());
+        ColumnPtr result = TimeFunctions::convert_tz(_utils->get_fn_ctx(), columns);
+        ASSERT_TRUE(TimeFunctions::convert_tz_close(_utils->get_fn_ctx(),
+                                                    FunctionContext::FunctionStateScope::FRAGMENT_LOCAL)
+                            .ok());
+
+        auto v = ColumnHelper::cast_to<TYPE_DATETIME>(result);
+        ASSERT_EQ(tc->size(), v->size());
+        for (size_t i = 0; i < tc->size(); ++i) {
+            int year, month, day, hour, minute, second, usec;
+            tc->get_data()[i].to_timestamp(&year, &month, &day, &hour, &minute, &second, &usec);
+            DateTimeValue origin(TIME_DATETIME, year, month, day, hour, minute, second, usec);
+            int64_t timestamp;
+            ASSERT_TRUE(origin.unix_timestamp(&timestamp, zone[0]));
+            DateTimeValue expected;
+            ASSERT_TRUE(expected.from_unixtime(timestamp, zone[1]));
+            ASSERT_EQ(TimestampValue::create(expected.year(), expected.month(), expected.day(), expected.hour(),
+                                             expected.minute(), expected.second()),
+                      v->get_data()[i])
+                    << zone[0] << " -> " << zone[1] << ": " << tc->get_data()[i].to_string();
+        }
+    }
+}
+
 TEST_F(TimeFunctionsTest, utctimestampTest) {
     {
         ColumnPtr ptr = TimeFunctions::utc_timestamp(_utils->get_fn_ctx(), Columns());
@@ -184,6 +184,43 @@ TEST_F(GeoTypesTest, polygon_hole_contains) {
     }
 }
 
+TEST_F(GeoTypesTest, polygon_covering_contains) {
+    const char* wkt = "POLYGON ((10 10, 50 10, 50 50, 10 50, 10 10), (20 20, 40 20, 40 40, 20 40, 20 20))";
+    GeoParseStatus status;
+    std::unique_ptr<GeoShape> polygon(GeoShape::from_wkt(wkt, strlen(wkt), &status));
+    ASSERT_EQ(GEO_PARSE_OK, status);
+    std::unique_ptr<GeoShape> covered(GeoShape::from_wkt(wkt, strlen(wkt), &status));
+    ASSERT_EQ(GEO_PARSE_OK, status);
+    static_cast<GeoPolygon*>(covered.get())->build_covering();
+
+    for (double x = 0; x <= 60; x += 0.5) {
+        for (double y = 0; y <= 60; y += 0.5) {
+            GeoPoint point;
+            point.from_coord(x, y);
+            ASSERT_EQ(polygon->contains(&point), covered->contains(&point)) << x << " " << y;
+        }
+    }
+}
+
+TEST_F(GeoTypesTest, distance_sphere_batch) {
+    std::vector<double> x_lng{0, 116.35, -73.98, 180, 10, 200};
+    std::vector<double> x_lat{0, 39.93, 40.75, 90, -90, 10};
+    std::vector<double> y_lng{0, 121.47, 2.35, -180, 10, 10};
+    std::vector<double> y_lat{0, 31.23, 48.86, -90, 95, 10};
+    std::vector<double> result(x_lng.size());
+    std::vector<uint8_t> invalid(x_lng.size());
+    GeoPoint::st_distance_sphere(x_lng.data(), x_lat.data(), y_lng.data(), y_lat.data(), x_lng.size(),
+                                 result.data(), invalid.data());
+    for (size_t i = 0; i < x_lng.size(); ++i) {
+        double expected = 0;
+        bool valid = GeoPoint::st_distance_sphere(x_lng[i], x_lat[i], y_lng[i], y_lat[i], &expected);
+        ASSERT_EQ(!valid, invalid[i]) << i;
+        if (valid) {
+            ASSERT_DOUBLE_EQ(expected, result[i]) << i;
+        }
+    }
+}
+
 TEST_F(GeoTypesTest, circle) {
     GeoCircle circle;
     auto res = circle.init(110.123, 64, 1000);
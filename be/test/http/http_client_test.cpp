@@ -29,6 +29,7 @@
 #include "http/http_channel.h"
 #include "http/http_handler.h"
 #include "http/http_request.h"
+#include "util/crc32c.h"
 
 namespace starrocks {
 
@@ -134,6 +135,29 @@ TEST_F(HttpClientTest, download) {
     unlink(local_file.c_str());
 }
 
+TEST_F(HttpClientTest, download_resume_without_range_support) {
+    HttpClient client;
+    auto st = client.init(hostname + "/simple_get");
+    ASSERT_TRUE(st.ok());
+    client.set_basic_auth("test1", "");
+    std::string local_file = ".http_client_test_resume.dat";
+    auto fp = fopen(local_file.c_str(), "w");
+    fwrite("xx", 1, 2, fp);
+    fclose(fp);
+    // the handler ignores the range and returns the whole body, so the download restarts from the beginning
+    uint32_t checksum = 0;
+    st = client.download(local_file, 2, &checksum, nullptr);
+    ASSERT_TRUE(st.ok());
+    char buf[50];
+    fp = fopen(local_file.c_str(), "r");
+    auto size = fread(buf, 1, 50, fp);
+    fclose(fp);
+    buf[size] = 0;
+    ASSERT_STREQ("test1", buf);
+    ASSERT_EQ(crc32c::Value("test1", 5), checksum);
+    unlink(local_file.c_str());
+}
+
 TEST_F(HttpClientTest, get_failed) {
     HttpClient client;
     auto st = client.init(hostname + "/simple_get");
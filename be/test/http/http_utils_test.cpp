@@ -93,4 +93,27 @@ TEST_F(HttpUtilsTest, parse_basic_auth) {
     }
 }
 
+TEST_F(HttpUtilsTest, parse_byte_range) {
+    int64_t first = 0;
+    int64_t last = 0;
+    ASSERT_TRUE(parse_byte_range("bytes=10-", &first, &last));
+    ASSERT_EQ(10, first);
+    ASSERT_EQ(-1, last);
+    ASSERT_TRUE(parse_byte_range("bytes=0-99", &first, &last));
+    ASSERT_EQ(0, first);
+    ASSERT_EQ(99, last);
+    ASSERT_TRUE(parse_byte_range("bytes=5-5", &first, &last));
+    ASSERT_EQ(5, first);
+    ASSERT_EQ(5, last);
+
+    ASSERT_FALSE(parse_byte_range("", &first, &last));
+    ASSERT_FALSE(parse_byte_range("bytes=", &first, &last));
+    ASSERT_FALSE(parse_byte_range("bytes=-100", &first, &last));
+    ASSERT_FALSE(parse_byte_range("bytes=10", &first, &last));
+    ASSERT_FALSE(parse_byte_range("bytes=a-b", &first, &last));
+    ASSERT_FALSE(parse_byte_range("bytes=0-10,20-30", &first, &last));
+    ASSERT_FALSE(parse_byte_range("items=0-10", &first, &last));
+    ASSERT_FALSE(parse_byte_range("bytes=20-10", &first, &last));
+}
+
 } // namespace starrocks
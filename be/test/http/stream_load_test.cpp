@@ -28,6 +28,7 @@
 
 #include "gen_cpp/HeartbeatService_types.h"
 #include "http/http_channel.h"
+#include "http/http_common.h"
 #include "http/http_request.h"
 #include "runtime/exec_env.h"
 #include "runtime/stream_load/load_stream_mgr.h"
@@ -266,4 +267,29 @@ TEST_F(StreamLoadActionTest, plan_fail) {
     ASSERT_STREQ("Fail", doc["Status"].GetString());
 }
 
+TEST_F(StreamLoadActionTest, group_commit_with_label) {
+    const bool old_enable_group_commit = config::enable_group_commit;
+    config::enable_group_commit = true;
+    StreamLoadAction action(&_env);
+
+    HttpRequest request(_evhttp_req);
+    struct evhttp_request ev_req;
+    ev_req.remote_host = nullptr;
+    request._ev_req = &ev_req;
+    request._headers.emplace(HttpHeaders::AUTHORIZATION, "Basic cm9vdDo=");
+    request._headers.emplace(HttpHeaders::CONTENT_LENGTH, "16");
+    request._headers.emplace(HTTP_GROUP_COMMIT, "true");
+    request._headers.emplace(HTTP_LABEL_KEY, "label1");
+    request.set_handler(&action);
+    action.on_header(&request);
+    action.handle(&request);
+    config::enable_group_commit = old_enable_group_commit;
+
+    // the label of a load in a group would not be deduplicated.
+    rapidjson::Document doc;
+    doc.Parse(k_response_str.c_str());
+    ASSERT_STREQ("Fail", doc["Status"].GetString());
+    ASSERT_STREQ("label is not supported by group commit", doc["Message"].GetString());
+}
+
 } // namespace starrocks
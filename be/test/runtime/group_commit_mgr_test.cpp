@@ -0,0 +1,185 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "runtime/stream_load/group_commit_mgr.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "common/config.h"
+#include "gen_cpp/FrontendService_types.h"
+#include "gen_cpp/HeartbeatService_types.h"
+#include "runtime/exec_env.h"
+#include "runtime/stream_load/load_stream_mgr.h"
+#include "runtime/stream_load/stream_load_context.h"
+#include "runtime/stream_load/stream_load_executor.h"
+#include "runtime/stream_load/stream_load_pipe.h"
+#include "util/starrocks_metrics.h"
+
+namespace starrocks {
+
+extern TLoadTxnBeginResult k_stream_load_begin_result;
+extern TLoadTxnCommitResult k_stream_load_commit_result;
+extern TLoadTxnRollbackResult k_stream_load_rollback_result;
+extern TStreamLoadPutResult k_stream_load_put_result;
+extern Status k_stream_load_plan_status;
+
+class GroupCommitMgrTest : public testing::Test {
+public:
+    void SetUp() override {
+        k_stream_load_begin_result = TLoadTxnBeginResult();
+        k_stream_load_begin_result.__set_txnId(100);
+        k_stream_load_commit_result = TLoadTxnCommitResult();
+        k_stream_load_rollback_result = TLoadTxnRollbackResult();
+        k_stream_load_put_result = TStreamLoadPutResult();
+        k_stream_load_plan_status = Status::OK();
+        _old_interval_ms = config::group_commit_interval_ms;
+        _old_max_bytes = config::group_commit_max_bytes;
+        config::group_commit_interval_ms = 0;
+
+        _env._master_info = new TMasterInfo();
+        _env._load_stream_mgr = new LoadStreamMgr();
+        _env._stream_load_executor = new StreamLoadExecutor(&_env);
+
+        _request.db = "db";
+        _request.tbl = "tbl";
+        _request.formatType = TFileFormatType::FORMAT_CSV_PLAIN;
+    }
+
+    void TearDown() override {
+        config::group_commit_interval_ms = _old_interval_ms;
+        config::group_commit_max_bytes = _old_max_bytes;
+        delete _env._stream_load_executor;
+        _env._stream_load_executor = nullptr;
+        delete _env._load_stream_mgr;
+        _env._load_stream_mgr = nullptr;
+        delete _env._master_info;
+        _env._master_info = nullptr;
+    }
+
+protected:
+    // load |data| as a stream load with the group commit.
+    Status _load(GroupCommitMgr* mgr, const std::string& data, int64_t* txn_id) {
+        StreamLoadContext ctx(&_env);
+        ctx.db = "db";
+        ctx.table = "tbl";
+        ctx.label = "label_" + ctx.id.to_string();
+        StreamLoadPipe body(1024 * 1024, 64 * 1024);
+        RETURN_IF_ERROR(body.append(data.data(), data.size()));
+        RETURN_IF_ERROR(body.finish());
+        Status st = mgr->load(&ctx, _request, &body);
+        *txn_id = ctx.txn_id;
+        return st;
+    }
+
+    static int64_t _num_begin_txns() { return StarRocksMetrics::instance()->txn_begin_request_total.value(); }
+
+    static int64_t _num_commit_txns() { return StarRocksMetrics::instance()->txn_commit_request_total.value(); }
+
+    static int64_t _num_rollback_txns() { return StarRocksMetrics::instance()->txn_rollback_request_total.value(); }
+
+    ExecEnv _env;
+    TStreamLoadPutRequest _request;
+    int32_t _old_interval_ms = 0;
+    int64_t _old_max_bytes = 0;
+};
+
+// NOLINTNEXTLINE
+TEST_F(GroupCommitMgrTest, test_commit_loads_in_one_group) {
+    // the group is committed once both bodies are appended.
+    config::group_commit_interval_ms = 60 * 1000;
+    config::group_commit_max_bytes = 8;
+    GroupCommitMgr mgr(&_env);
+    const int64_t num_begin_txns = _num_begin_txns();
+    const int64_t num_commit_txns = _num_commit_txns();
+
+    Status st1;
+    Status st2;
+    int64_t txn_id1 = 0;
+    int64_t txn_id2 = 0;
+    std::thread t1([&]() { st1 = _load(&mgr, "1\n2\n", &txn_id1); });
+    std::thread t2([&]() { st2 = _load(&mgr, "3\n4\n", &txn_id2); });
+    t1.join();
+    t2.join();
+
+    ASSERT_TRUE(st1.ok()) << st1.to_string();
+    ASSERT_TRUE(st2.ok()) << st2.to_string();
+    ASSERT_EQ(100, txn_id1);
+    ASSERT_EQ(100, txn_id2);
+    ASSERT_EQ(num_begin_txns + 1, _num_begin_txns());
+    ASSERT_EQ(num_commit_txns + 1, _num_commit_txns());
+    ASSERT_TRUE(mgr._groups.empty());
+}
+
+// NOLINTNEXTLINE
+TEST_F(GroupCommitMgrTest, test_next_group_after_commit) {
+    GroupCommitMgr mgr(&_env);
+    const int64_t num_begin_txns = _num_begin_txns();
+
+    int64_t txn_id = 0;
+    ASSERT_TRUE(_load(&mgr, "1\n", &txn_id).ok());
+    ASSERT_TRUE(_load(&mgr, "2\n", &txn_id).ok());
+    ASSERT_EQ(num_begin_txns + 2, _num_begin_txns());
+    ASSERT_TRUE(mgr._groups.empty());
+}
+
+// NOLINTNEXTLINE
+TEST_F(GroupCommitMgrTest, test_begin_txn_failure) {
+    GroupCommitMgr mgr(&_env);
+    Status::InternalError("label already exists").to_thrift(&k_stream_load_begin_result.status);
+    const int64_t num_rollback_txns = _num_rollback_txns();
+
+    int64_t txn_id = 0;
+    ASSERT_FALSE(_load(&mgr, "1\n", &txn_id).ok());
+    ASSERT_EQ(num_rollback_txns, _num_rollback_txns());
+    ASSERT_TRUE(mgr._groups.empty());
+}
+
+// NOLINTNEXTLINE
+TEST_F(GroupCommitMgrTest, test_rollback_on_plan_failure) {
+    GroupCommitMgr mgr(&_env);
+    Status::InternalError("unknown table").to_thrift(&k_stream_load_put_result.status);
+    const int64_t num_rollback_txns = _num_rollback_txns();
+
+    int64_t txn_id = 0;
+    auto st = _load(&mgr, "1\n", &txn_id);
+    ASSERT_FALSE(st.ok());
+    ASSERT_EQ("unknown table", st.get_error_msg());
+    // the transaction is rolled back and the pipe is removed at once.
+    ASSERT_EQ(num_rollback_txns + 1, _num_rollback_txns());
+    ASSERT_TRUE(_env.load_stream_mgr()->_stream_map.empty());
+    ASSERT_TRUE(mgr._groups.empty());
+}
+
+// NOLINTNEXTLINE
+TEST_F(GroupCommitMgrTest, test_rollback_on_fragment_failure) {
+    GroupCommitMgr mgr(&_env);
+    k_stream_load_plan_status = Status::InternalError("fragment failed");
+    const int64_t num_commit_txns = _num_commit_txns();
+    const int64_t num_rollback_txns = _num_rollback_txns();
+
+    int64_t txn_id = 0;
+    auto st = _load(&mgr, "1\n", &txn_id);
+    ASSERT_FALSE(st.ok());
+    ASSERT_EQ("fragment failed", st.get_error_msg());
+    ASSERT_EQ(num_commit_txns, _num_commit_txns());
+    ASSERT_EQ(num_rollback_txns + 1, _num_rollback_txns());
+}
+
+// NOLINTNEXTLINE
+TEST_F(GroupCommitMgrTest, test_load_alone_on_filtered_rows) {
+    GroupCommitMgr mgr(&_env);
+    k_stream_load_plan_status = Status::InternalError("too many filtered rows");
+    const int64_t num_begin_txns = _num_begin_txns();
+    const int64_t num_rollback_txns = _num_rollback_txns();
+
+    // the group fails, and the load fails in the transaction of its own too.
+    int64_t txn_id = 0;
+    auto st = _load(&mgr, "1\n", &txn_id);
+    ASSERT_FALSE(st.ok());
+    ASSERT_EQ("too many filtered rows", st.get_error_msg());
+    ASSERT_EQ(num_begin_txns + 2, _num_begin_txns());
+    ASSERT_EQ(num_rollback_txns + 2, _num_rollback_txns());
+}
+
+} // namespace starrocks
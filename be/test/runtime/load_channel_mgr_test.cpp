@@ -23,6 +23,10 @@
 
 #include <gtest/gtest.h>
 
+#include <tuple>
+#include <vector>
+
+#include "common/config.h"
 #include "common/object_pool.h"
 #include "gen_cpp/Descriptors_types.h"
 #include "gen_cpp/InternalService_types.h"
@@ -30,6 +34,7 @@
 #include "runtime/descriptor_helper.h"
 #include "runtime/descriptors.h"
 #include "runtime/exec_env.h"
+#include "runtime/load_channel.h"
 #include "runtime/mem_tracker.h"
 #include "runtime/primitive_type.h"
 #include "runtime/row_batch.h"
@@ -709,4 +714,82 @@ TEST_F(LoadChannelMgrTest, duplicate_packet) {
     ASSERT_EQ(_k_tablet_recorder[21], 1);
 }
 
+// NOLINTNEXTLINE
+TEST_F(LoadChannelMgrTest, rank_flush_candidates) {
+    const int64_t kMB = 1024 * 1024;
+    const int64_t old_min_flush_size = config::load_min_flush_memtable_size;
+    config::load_min_flush_memtable_size = 16 * kMB;
+    MemTracker parent;
+    LoadChannel load(UniqueId(1, 1), 1024 * kMB * kMB, 60, &parent);
+    LoadChannel exceeded_load(UniqueId(1, 2), 100, 60, &parent);
+    exceeded_load._mem_tracker->consume(200);
+    ASSERT_TRUE(exceeded_load.mem_limit_exceeded());
+
+    std::vector<FlushCandidate> candidates;
+    auto add = [&](LoadChannel* load_channel, int64_t tablet_id, int64_t mb, int64_t age_ms, bool flushing) {
+        MemTableStat stat{tablet_id, mb * kMB, age_ms, flushing};
+        candidates.push_back(FlushCandidate{load_channel, nullptr, stat});
+    };
+    add(&load, 1, 4, 0, false);
+    add(&load, 2, 64, 0, false);
+    add(&load, 3, 32, 0, false);
+    add(&exceeded_load, 4, 20, 0, false);
+    add(&load, 5, 8, 0, true);
+    add(&load, 6, 1, 0, false);
+    // not written for two minutes, it's ranked as a memtable of 120MB.
+    add(&load, 7, 40, 120 * 1000, false);
+    LoadChannelMgr::_rank_flush_candidates(&candidates);
+
+    std::vector<int64_t> tablet_ids;
+    for (auto& candidate : candidates) {
+        tablet_ids.push_back(candidate.stat.tablet_id);
+    }
+    // the flushing ones first, then the large ones of the loads over their own limit, the larger and older
+    // large ones, and the small ones at last.
+    ASSERT_EQ((std::vector<int64_t>{5, 4, 7, 2, 3, 1, 6}), tablet_ids);
+
+    exceeded_load._mem_tracker->release(200);
+    config::load_min_flush_memtable_size = old_min_flush_size;
+}
+
+// NOLINTNEXTLINE
+TEST_F(LoadChannelMgrTest, pick_flush_candidates) {
+    const int64_t kMB = 1024 * 1024;
+    std::vector<FlushCandidate> candidates;
+    for (auto [tablet_id, mb, flushing] : std::vector<std::tuple<int64_t, int64_t, bool>>{
+                 {5, 8, true}, {2, 64, false}, {3, 32, false}, {4, 16, false}, {1, 4, false}}) {
+        candidates.push_back(FlushCandidate{nullptr, nullptr, MemTableStat{tablet_id, mb * kMB, 0, flushing}});
+    }
+    std::vector<int64_t> flushed;
+    int64_t failed_tablet_id = -1;
+    auto flush = [&](const FlushCandidate& candidate) {
+        flushed.push_back(candidate.stat.tablet_id);
+        return candidate.stat.tablet_id == failed_tablet_id ? Status::InternalError("flush failed") : Status::OK();
+    };
+    auto picked_ids = [&](int64_t exceeded_mem) {
+        flushed.clear();
+        std::vector<int64_t> tablet_ids;
+        auto picked = LoadChannelMgr::_pick_flush_candidates(candidates, exceeded_mem, flush);
+        for (const FlushCandidate* candidate : picked) {
+            tablet_ids.push_back(candidate->stat.tablet_id);
+        }
+        return tablet_ids;
+    };
+
+    // the flushing memtable is waited without a flush, and the picking stops once the memory is below limit.
+    ASSERT_EQ((std::vector<int64_t>{5, 2, 3}), picked_ids(80 * kMB));
+    ASSERT_EQ((std::vector<int64_t>{2, 3}), flushed);
+    ASSERT_EQ((std::vector<int64_t>{5}), picked_ids(8 * kMB));
+    ASSERT_TRUE(flushed.empty());
+    ASSERT_TRUE(picked_ids(0).empty());
+    ASSERT_TRUE(flushed.empty());
+    // all of them are not enough.
+    ASSERT_EQ((std::vector<int64_t>{5, 2, 3, 4, 1}), picked_ids(1024 * kMB));
+
+    // the memtable failed to flush frees nothing, so the next one is picked instead.
+    failed_tablet_id = 2;
+    ASSERT_EQ((std::vector<int64_t>{5, 3, 4}), picked_ids(50 * kMB));
+    ASSERT_EQ((std::vector<int64_t>{2, 3, 4}), flushed);
+}
+
 } // namespace starrocks
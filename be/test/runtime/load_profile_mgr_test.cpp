@@ -0,0 +1,71 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "runtime/stream_load/load_profile_mgr.h"
+
+#include <gtest/gtest.h>
+
+#include "common/config.h"
+#include "runtime/exec_env.h"
+#include "runtime/stream_load/load_stream_mgr.h"
+#include "runtime/stream_load/stream_load_context.h"
+
+namespace starrocks {
+
+class LoadProfileMgrTest : public testing::Test {
+public:
+    void SetUp() override {
+        _old_enable = config::enable_load_profile;
+        _old_max_num = config::load_profile_max_num;
+        config::enable_load_profile = true;
+        config::load_profile_max_num = 2;
+        _env._load_stream_mgr = new LoadStreamMgr();
+    }
+
+    void TearDown() override {
+        config::enable_load_profile = _old_enable;
+        config::load_profile_max_num = _old_max_num;
+        delete _env._load_stream_mgr;
+        _env._load_stream_mgr = nullptr;
+    }
+
+protected:
+    ExecEnv _env;
+
+private:
+    bool _old_enable;
+    int32_t _old_max_num;
+};
+
+// NOLINTNEXTLINE
+TEST_F(LoadProfileMgrTest, add_and_evict) {
+    LoadProfileMgr mgr;
+    for (int i = 0; i < 3; ++i) {
+        StreamLoadContext ctx(&_env);
+        ctx.label = "label_" + std::to_string(i);
+        ctx.txn_id = i;
+        ctx.write_data_cost_nanos = 1000000;
+        ctx.number_loaded_rows = 10;
+        ctx.fragment_profile = "Fragment profile\n";
+        mgr.add(&ctx);
+    }
+    ASSERT_EQ((std::vector<std::string>{"label_2", "label_1"}), mgr.labels());
+
+    std::string profile;
+    ASSERT_FALSE(mgr.get("label_0", &profile));
+    ASSERT_TRUE(mgr.get("label_2", &profile));
+    ASSERT_NE(std::string::npos, profile.find("Label: label_2"));
+    ASSERT_NE(std::string::npos, profile.find("WriteDataTime"));
+    ASSERT_NE(std::string::npos, profile.find("Fragment profile"));
+}
+
+// NOLINTNEXTLINE
+TEST_F(LoadProfileMgrTest, disabled) {
+    config::enable_load_profile = false;
+    LoadProfileMgr mgr;
+    StreamLoadContext ctx(&_env);
+    ctx.label = "label";
+    mgr.add(&ctx);
+    ASSERT_TRUE(mgr.labels().empty());
+}
+
+} // namespace starrocks
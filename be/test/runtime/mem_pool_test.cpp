@@ -128,6 +128,34 @@ TEST(MemPoolTest, Keep) {
     }
 }
 
+TEST(MemPoolTest, ClearAndRetain) {
+    MemPool p;
+    p.allocate(4 * 1024);
+    p.allocate(8 * 1024);
+    p.allocate(16 * 1024);
+    p.allocate(32 * 1024);
+    EXPECT_EQ(p.total_reserved_bytes(), (4 + 8 + 16 + 32) * 1024);
+
+    // the largest chunks are retained
+    p.clear_and_retain((32 + 8) * 1024);
+    EXPECT_EQ(p.total_allocated_bytes(), 0);
+    EXPECT_EQ(p.total_reserved_bytes(), (32 + 8) * 1024);
+
+    // the retained chunks are reused
+    p.allocate(32 * 1024);
+    p.allocate(8 * 1024);
+    EXPECT_EQ(p.total_allocated_bytes(), (32 + 8) * 1024);
+    EXPECT_EQ(p.total_reserved_bytes(), (32 + 8) * 1024);
+
+    // the new chunk keeps growing
+    p.allocate(1024);
+    EXPECT_EQ(p.total_reserved_bytes(), (32 + 8 + 64) * 1024);
+
+    p.clear_and_retain(0);
+    EXPECT_EQ(p.total_allocated_bytes(), 0);
+    EXPECT_EQ(p.total_reserved_bytes(), 0);
+}
+
 // Maximum allocation size which exceeds 32-bit.
 #define LARGE_ALLOC_SIZE (1LL << 32)
 
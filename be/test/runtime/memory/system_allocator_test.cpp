@@ -23,6 +23,8 @@
 
 #include <gtest/gtest.h>
 
+#include <cstring>
+
 #include "common/config.h"
 
 namespace starrocks {
@@ -49,4 +51,29 @@ TEST(SystemAllocatorTest, TestNormal) {
     test_normal<false>();
 }
 
+template <bool use_mmap>
+void test_huge_pages() {
+    config::use_mmap_allocate_chunk = use_mmap;
+    config::madvise_huge_pages = true;
+    {
+        auto ptr = SystemAllocator::allocate(SystemAllocator::HUGE_PAGE_SIZE * 2, 0);
+        ASSERT_NE(nullptr, ptr);
+        ASSERT_EQ(0, (uint64_t)ptr % 4096);
+        memset(ptr, 1, SystemAllocator::HUGE_PAGE_SIZE * 2);
+        SystemAllocator::free(ptr, SystemAllocator::HUGE_PAGE_SIZE * 2);
+    }
+    {
+        // too small to use huge pages
+        auto ptr = SystemAllocator::allocate(4096, 0);
+        ASSERT_NE(nullptr, ptr);
+        SystemAllocator::free(ptr, 4096);
+    }
+    config::madvise_huge_pages = false;
+}
+
+TEST(SystemAllocatorTest, TestHugePages) {
+    test_huge_pages<true>();
+    test_huge_pages<false>();
+}
+
 } // namespace starrocks
@@ -22,9 +22,17 @@
 #include <gtest/gtest.h>
 
 #include <filesystem>
+#include <fstream>
+#include <sstream>
 
+#include "common/config.h"
+#include "env/env_broker.h"
+#include "gen_cpp/TFileBrokerService.h"
 #include "runtime/exec_env.h"
+#include "storage/data_dir.h"
 #include "util/cpu_info.h"
+#include "util/file_utils.h"
+#include "util/thrift_client.h"
 
 #define private public // hack complier
 #define protected public
@@ -98,12 +106,350 @@ TEST_F(SnapshotLoaderTest, NormalCase) {
     ASSERT_TRUE(st.ok());
     ASSERT_EQ("1234_2_5_12345_1.idx", new_name);
 
+    st = loader._replace_tablet_id("0200000000000004f94ff0a2e6b8a9a9e0f8d1b2c3d4e5f6_0.cold", 5678, &new_name);
+    ASSERT_TRUE(st.ok());
+    ASSERT_EQ("0200000000000004f94ff0a2e6b8a9a9e0f8d1b2c3d4e5f6_0.cold", new_name);
+
     st = loader._replace_tablet_id("1234_2_5_12345_1.xxx", 5678, &new_name);
     ASSERT_FALSE(st.ok());
 
+    ASSERT_TRUE(loader._is_rowset_segment_file("0200000000000004f94ff0a2e6b8a9a9e0f8d1b2c3d4e5f6_0.dat"));
+    ASSERT_FALSE(loader._is_rowset_segment_file("0200000000000004f94ff0a2e6b8a9a9e0f8d1b2c3d4e5f6_0.idx"));
+    ASSERT_FALSE(loader._is_rowset_segment_file("1234_2_5_12345_1.dat"));
+    ASSERT_FALSE(loader._is_rowset_segment_file("12345.hdr"));
+
     st = loader._get_tablet_id_from_remote_path("/__tbl_10004/__part_10003/__idx_10004/__10005", &tablet_id);
     ASSERT_TRUE(st.ok());
     ASSERT_EQ(10005, tablet_id);
 }
 
+// A broker on the local file system, the remote paths are local paths.
+class LocalBrokerServiceClient : public TFileBrokerServiceClient {
+public:
+    using TBinaryProtocol = apache::thrift::protocol::TBinaryProtocol;
+    using TBufferedTransport = apache::thrift::transport::TBufferedTransport;
+    using TSocket = apache::thrift::transport::TSocket;
+
+    LocalBrokerServiceClient()
+            : TFileBrokerServiceClient(std::make_shared<TBinaryProtocol>(
+                      std::make_shared<TBufferedTransport>(std::make_shared<TSocket>("127.0.0.1", 12345)))) {}
+
+    void listPath(TBrokerListResponse& response, const TBrokerListPathRequest& request) override {
+        _check_connection();
+        std::string path = request.path;
+        bool list_dir = path.size() >= 2 && path.compare(path.size() - 2, 2, "/*") == 0;
+        if (list_dir) {
+            path.resize(path.size() - 2);
+        }
+        if (!std::filesystem::exists(path)) {
+            response.opStatus.__set_statusCode(TBrokerOperationStatusCode::FILE_NOT_FOUND);
+            return;
+        }
+        std::vector<std::filesystem::path> paths;
+        if (list_dir) {
+            for (const auto& entry : std::filesystem::directory_iterator(path)) {
+                paths.push_back(entry.path());
+            }
+        } else {
+            paths.emplace_back(path);
+        }
+        for (const auto& p : paths) {
+            TBrokerFileStatus status;
+            status.__set_path(p.filename().string());
+            status.__set_isDir(std::filesystem::is_directory(p));
+            status.__set_size(status.isDir ? 0 : std::filesystem::file_size(p));
+            status.__set_isSplitable(false);
+            response.files.emplace_back(std::move(status));
+        }
+        response.opStatus.__set_statusCode(TBrokerOperationStatusCode::OK);
+    }
+
+    void deletePath(TBrokerOperationStatus& response, const TBrokerDeletePathRequest& request) override {
+        _check_connection();
+        bool removed = std::filesystem::remove(request.path);
+        response.__set_statusCode(removed ? TBrokerOperationStatusCode::OK
+                                          : TBrokerOperationStatusCode::FILE_NOT_FOUND);
+    }
+
+    void renamePath(TBrokerOperationStatus& response, const TBrokerRenamePathRequest& request) override {
+        _check_connection();
+        std::error_code ec;
+        std::filesystem::rename(request.srcPath, request.destPath, ec);
+        response.__set_statusCode(ec ? TBrokerOperationStatusCode::FILE_NOT_FOUND : TBrokerOperationStatusCode::OK);
+    }
+
+    void checkPathExist(TBrokerCheckPathExistResponse& response, const TBrokerCheckPathExistRequest& request) override {
+        _check_connection();
+        response.opStatus.__set_statusCode(TBrokerOperationStatusCode::OK);
+        response.isPathExist = std::filesystem::exists(request.path);
+    }
+
+    void openReader(TBrokerOpenReaderResponse& response, const TBrokerOpenReaderRequest& request) override {
+        _check_connection();
+        if (!std::filesystem::exists(request.path)) {
+            response.opStatus.__set_statusCode(TBrokerOperationStatusCode::FILE_NOT_FOUND);
+            return;
+        }
+        num_opened_readers++;
+        response.__set_fd(_open(request.path));
+        response.opStatus.__set_statusCode(TBrokerOperationStatusCode::OK);
+    }
+
+    void pread(TBrokerReadResponse& response, const TBrokerPReadRequest& request) override {
+        _check_connection();
+        std::ifstream in(_files.at(request.fd.low), std::ios::binary);
+        in.seekg(request.offset);
+        response.data.resize(request.length);
+        in.read(response.data.data(), request.length);
+        response.data.resize(in.gcount());
+        response.opStatus.__set_statusCode(response.data.empty() ? TBrokerOperationStatusCode::END_OF_FILE
+                                                                 : TBrokerOperationStatusCode::OK);
+    }
+
+    void closeReader(TBrokerOperationStatus& response, const TBrokerCloseReaderRequest& request) override {
+        _files.erase(request.fd.low);
+        response.__set_statusCode(TBrokerOperationStatusCode::OK);
+    }
+
+    void openWriter(TBrokerOpenWriterResponse& response, const TBrokerOpenWriterRequest& request) override {
+        _check_connection();
+        num_opened_writers++;
+        std::ofstream(request.path, std::ios::binary | std::ios::trunc);
+        response.__set_fd(_open(request.path));
+        response.opStatus.__set_statusCode(TBrokerOperationStatusCode::OK);
+    }
+
+    void pwrite(TBrokerOperationStatus& response, const TBrokerPWriteRequest& request) override {
+        _check_connection();
+        const std::string& path = _files.at(request.fd.low);
+        if (fail_writes || std::filesystem::file_size(path) != request.offset) {
+            response.__set_statusCode(TBrokerOperationStatusCode::TARGET_STORAGE_SERVICE_ERROR);
+            return;
+        }
+        std::ofstream(path, std::ios::binary | std::ios::app) << request.data;
+        response.__set_statusCode(TBrokerOperationStatusCode::OK);
+    }
+
+    void closeWriter(TBrokerOperationStatus& response, const TBrokerCloseWriterRequest& request) override {
+        _files.erase(request.fd.low);
+        response.__set_statusCode(TBrokerOperationStatusCode::OK);
+    }
+
+    bool disconnected = false;
+    bool fail_writes = false;
+    int num_opened_readers = 0;
+    int num_opened_writers = 0;
+
+private:
+    void _check_connection() {
+        if (disconnected) throw apache::thrift::transport::TTransportException();
+    }
+
+    TBrokerFD _open(const std::string& path) {
+        TBrokerFD fd;
+        fd.__set_high(0);
+        fd.__set_low(++_next_fd);
+        _files[fd.low] = path;
+        return fd;
+    }
+
+    int64_t _next_fd = 0;
+    std::map<int64_t, std::string> _files;
+};
+
+class SnapshotLoaderTransferTest : public testing::Test {
+public:
+    void SetUp() override {
+        _old_trust_remote_segments = config::snapshot_upload_trust_remote_segments;
+        std::filesystem::remove_all(kRootPath);
+        std::filesystem::create_directories(kLocalPath);
+        std::filesystem::create_directories(kRemotePath);
+        EnvBroker::TEST_set_broker_client(&_client);
+        SnapshotLoader::TEST_set_broker_client(&_client);
+    }
+
+    void TearDown() override {
+        EnvBroker::TEST_set_broker_client(nullptr);
+        SnapshotLoader::TEST_set_broker_client(nullptr);
+        std::filesystem::remove_all(kRootPath);
+        config::snapshot_upload_trust_remote_segments = _old_trust_remote_segments;
+    }
+
+protected:
+    static constexpr const char* kRootPath = "./snapshot_loader_transfer_test";
+    static constexpr const char* kLocalPath = "./snapshot_loader_transfer_test/local/10005/1234";
+    static constexpr const char* kRemotePath = "./snapshot_loader_transfer_test/remote/__tbl_1/__10006";
+    static constexpr const char* kSegmentFile = "0200000000000004f94ff0a2e6b8a9a9e0f8d1b2c3d4e5f6_0.dat";
+
+    static void _write_file(const std::string& path, const std::string& content) {
+        std::ofstream(path, std::ios::binary | std::ios::trunc) << content;
+    }
+
+    static std::string _read_file(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        std::stringstream ss;
+        ss << in.rdbuf();
+        return ss.str();
+    }
+
+    static std::string _md5(const std::string& path) {
+        std::string md5;
+        CHECK(FileUtils::md5sum(path, &md5).ok());
+        return md5;
+    }
+
+    std::map<std::string, FileStat> _list_remote() {
+        std::map<std::string, FileStat> files;
+        Status st = _loader._get_existing_files_from_remote(_broker_addr, kRemotePath, {}, &files);
+        CHECK(st.ok()) << st.to_string();
+        return files;
+    }
+
+    Status _upload(const std::string& file, const std::map<std::string, FileStat>& remote_files, std::string* md5) {
+        return _loader._upload_file(_broker_addr, {}, kLocalPath, kRemotePath, file, remote_files, md5);
+    }
+
+    Status _download(const FileStat& file_stat, DataDir* data_dir) {
+        std::vector<std::string> local_files;
+        CHECK(_loader._get_existing_files_from_local(kLocalPath, &local_files).ok());
+        return _loader._download_file(_broker_addr, {}, kRemotePath, kLocalPath, 10005, file_stat, local_files,
+                                      data_dir);
+    }
+
+    LocalBrokerServiceClient _client;
+    SnapshotLoader _loader{nullptr, 1L, 2L};
+    TNetworkAddress _broker_addr;
+    bool _old_trust_remote_segments = false;
+};
+
+// NOLINTNEXTLINE
+TEST_F(SnapshotLoaderTransferTest, test_upload_and_skip_uploaded) {
+    std::string local_file = std::string(kLocalPath) + "/" + kSegmentFile;
+    _write_file(local_file, "segment data");
+    std::string md5;
+    ASSERT_TRUE(_upload(kSegmentFile, _list_remote(), &md5).ok());
+    ASSERT_EQ(_md5(local_file), md5);
+    ASSERT_EQ(1, _client.num_opened_writers);
+
+    auto remote_files = _list_remote();
+    ASSERT_EQ(1, remote_files.size());
+    ASSERT_EQ(md5, remote_files[kSegmentFile].md5);
+    ASSERT_EQ("segment data", _read_file(std::string(kRemotePath) + "/" + kSegmentFile + "." + md5));
+
+    // the file uploaded with the same checksum is skipped.
+    std::string md5_again;
+    ASSERT_TRUE(_upload(kSegmentFile, remote_files, &md5_again).ok());
+    ASSERT_EQ(md5, md5_again);
+    ASSERT_EQ(1, _client.num_opened_writers);
+
+    // the file changed is uploaded again.
+    _write_file(local_file, "new segment data");
+    ASSERT_TRUE(_upload(kSegmentFile, remote_files, &md5_again).ok());
+    ASSERT_EQ(_md5(local_file), md5_again);
+    ASSERT_EQ(2, _client.num_opened_writers);
+}
+
+// NOLINTNEXTLINE
+TEST_F(SnapshotLoaderTransferTest, test_trust_remote_segments) {
+    std::string local_file = std::string(kLocalPath) + "/" + kSegmentFile;
+    _write_file(local_file, "segment data");
+    std::map<std::string, FileStat> remote_files;
+    remote_files[kSegmentFile] = FileStat{kSegmentFile, "remote_md5", 12};
+
+    // off by default, the local file is checksummed and uploaded as the checksum differs.
+    ASSERT_FALSE(config::snapshot_upload_trust_remote_segments);
+    std::string md5;
+    ASSERT_TRUE(_upload(kSegmentFile, remote_files, &md5).ok());
+    ASSERT_EQ(_md5(local_file), md5);
+    ASSERT_EQ(1, _client.num_opened_writers);
+
+    // the segment with the same name and size is reused without reading the local file.
+    config::snapshot_upload_trust_remote_segments = true;
+    ASSERT_TRUE(_upload(kSegmentFile, remote_files, &md5).ok());
+    ASSERT_EQ("remote_md5", md5);
+    ASSERT_EQ(1, _client.num_opened_writers);
+
+    // but not with a different size.
+    remote_files[kSegmentFile].size = 13;
+    ASSERT_TRUE(_upload(kSegmentFile, remote_files, &md5).ok());
+    ASSERT_EQ(_md5(local_file), md5);
+    ASSERT_EQ(2, _client.num_opened_writers);
+}
+
+// NOLINTNEXTLINE
+TEST_F(SnapshotLoaderTransferTest, test_resume_upload_after_failure) {
+    std::string local_file = std::string(kLocalPath) + "/" + kSegmentFile;
+    _write_file(local_file, "segment data");
+    std::string part_file = std::string(kRemotePath) + "/" + kSegmentFile + ".part";
+
+    // the failed upload leaves the part file, which is not listed as an uploaded file.
+    _client.fail_writes = true;
+    std::string md5;
+    ASSERT_FALSE(_upload(kSegmentFile, _list_remote(), &md5).ok());
+    ASSERT_TRUE(std::filesystem::exists(part_file));
+    auto remote_files = _list_remote();
+    ASSERT_EQ(0, remote_files.count(kSegmentFile));
+
+    // the retry replaces the part file.
+    _client.fail_writes = false;
+    ASSERT_TRUE(_upload(kSegmentFile, remote_files, &md5).ok());
+    ASSERT_FALSE(std::filesystem::exists(part_file));
+    ASSERT_EQ(md5, _list_remote()[kSegmentFile].md5);
+
+    // the broker is unreachable.
+    _client.disconnected = true;
+    std::map<std::string, FileStat> files;
+    ASSERT_FALSE(_loader._get_existing_files_from_remote(_broker_addr, kRemotePath, {}, &files).ok());
+    _write_file(local_file, "new segment data");
+    ASSERT_FALSE(_upload(kSegmentFile, remote_files, &md5).ok());
+}
+
+// NOLINTNEXTLINE
+TEST_F(SnapshotLoaderTransferTest, test_download_skip_resume_and_failure) {
+    DataDir data_dir(kRootPath);
+    data_dir._disk_capacity_bytes = 1L << 30;
+    data_dir._available_bytes = 1L << 30;
+    std::string local_file = std::string(kLocalPath) + "/" + kSegmentFile;
+    _write_file(local_file, "segment data");
+    std::string md5 = _md5(local_file);
+    std::filesystem::remove(local_file);
+    _write_file(std::string(kRemotePath) + "/" + kSegmentFile + "." + md5, "segment data");
+    FileStat file_stat = _list_remote()[kSegmentFile];
+    ASSERT_EQ(md5, file_stat.md5);
+
+    ASSERT_TRUE(_download(file_stat, &data_dir).ok());
+    ASSERT_EQ("segment data", _read_file(local_file));
+    ASSERT_EQ(1, _client.num_opened_readers);
+
+    // the file downloaded with the same checksum is skipped.
+    ASSERT_TRUE(_download(file_stat, &data_dir).ok());
+    ASSERT_EQ(1, _client.num_opened_readers);
+
+    // the file partially downloaded by a failed download is downloaded again.
+    _write_file(local_file, "segm");
+    ASSERT_TRUE(_download(file_stat, &data_dir).ok());
+    ASSERT_EQ("segment data", _read_file(local_file));
+    ASSERT_EQ(2, _client.num_opened_readers);
+
+    // the downloaded file doesn't match the checksum.
+    std::filesystem::remove(local_file);
+    file_stat.md5 = "bad_md5";
+    std::filesystem::rename(std::string(kRemotePath) + "/" + kSegmentFile + "." + md5,
+                            std::string(kRemotePath) + "/" + kSegmentFile + ".bad_md5");
+    Status st = _download(file_stat, &data_dir);
+    ASSERT_FALSE(st.ok());
+    ASSERT_NE(std::string::npos, st.get_error_msg().find("invalid md5")) << st.to_string();
+
+    // the broker is unreachable.
+    std::filesystem::remove(local_file);
+    _client.disconnected = true;
+    ASSERT_FALSE(_download(file_stat, &data_dir).ok());
+    ASSERT_FALSE(std::filesystem::exists(local_file));
+
+    // no capacity left.
+    _client.disconnected = false;
+    data_dir._available_bytes = 0;
+    ASSERT_FALSE(_download(file_stat, &data_dir).ok());
+}
+
 } // namespace starrocks
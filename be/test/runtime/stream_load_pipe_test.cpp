@@ -73,6 +73,43 @@ TEST_F(StreamLoadPipeTest, append_buffer) {
     t1.join();
 }
 
+TEST_F(StreamLoadPipeTest, read_buffer) {
+    StreamLoadPipe pipe(66, 64);
+
+    auto appender = [&pipe] {
+        int k = 0;
+        for (int i = 0; i < 2; ++i) {
+            auto byte_buf = ByteBuffer::allocate(64);
+            char buf[64];
+            for (int j = 0; j < 64; ++j) {
+                buf[j] = '0' + (k++ % 10);
+            }
+            byte_buf->put_bytes(buf, 64);
+            byte_buf->flip();
+            pipe.append(byte_buf);
+        }
+        pipe.finish();
+    };
+    std::thread t1(appender);
+
+    int k = 0;
+    ByteBufferPtr buf;
+    for (int i = 0; i < 2; ++i) {
+        auto st = pipe.read_buffer(&buf);
+        ASSERT_TRUE(st.ok());
+        ASSERT_NE(nullptr, buf);
+        ASSERT_EQ(64, buf->remaining());
+        for (int j = 0; j < 64; ++j) {
+            ASSERT_EQ('0' + (k++ % 10), buf->ptr[buf->pos + j]);
+        }
+    }
+    auto st = pipe.read_buffer(&buf);
+    ASSERT_TRUE(st.ok());
+    ASSERT_EQ(nullptr, buf);
+
+    t1.join();
+}
+
 TEST_F(StreamLoadPipeTest, append_bytes) {
     StreamLoadPipe pipe(66, 64);
 
@@ -0,0 +1,171 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "service/internal_service.h"
+
+#include <gtest/gtest.h>
+
+#include "column/fixed_length_column.h"
+#include "runtime/exec_env.h"
+#include "service/brpc.h"
+#include "storage/rowset/rowset_factory.h"
+#include "storage/rowset/rowset_writer.h"
+#include "storage/rowset/rowset_writer_context.h"
+#include "storage/storage_engine.h"
+#include "storage/tablet.h"
+#include "storage/tablet_manager.h"
+#include "storage/tablet_updates.h"
+#include "storage/vectorized/chunk_helper.h"
+#include "util/coding.h"
+#include "util/countdown_latch.h"
+
+namespace starrocks {
+
+class LookupRowsTest : public testing::Test {
+public:
+    void SetUp() override {
+        TCreateTabletReq request;
+        request.tablet_id = 10087;
+        request.__set_version(1);
+        request.__set_version_hash(0);
+        request.tablet_schema.schema_hash = 1112;
+        request.tablet_schema.short_key_column_count = 1;
+        request.tablet_schema.keys_type = TKeysType::PRIMARY_KEYS;
+        request.tablet_schema.storage_type = TStorageType::COLUMN;
+
+        TColumn k1;
+        k1.column_name = "pk";
+        k1.__set_is_key(true);
+        k1.column_type.type = TPrimitiveType::BIGINT;
+        request.tablet_schema.columns.push_back(k1);
+
+        TColumn v1;
+        v1.column_name = "v1";
+        v1.__set_is_key(false);
+        v1.column_type.type = TPrimitiveType::INT;
+        request.tablet_schema.columns.push_back(v1);
+        auto st = StorageEngine::instance()->create_tablet(request);
+        ASSERT_TRUE(st.ok()) << st.to_string();
+        _tablet = StorageEngine::instance()->tablet_manager()->get_tablet(request.tablet_id, 1112);
+        ASSERT_TRUE(_tablet->rowset_commit(2, _create_rowset(10)).ok());
+    }
+
+    void TearDown() override {
+        if (_tablet) {
+            StorageEngine::instance()->tablet_manager()->drop_tablet(_tablet->tablet_id(), _tablet->schema_hash(),
+                                                                     false);
+            _tablet.reset();
+        }
+    }
+
+protected:
+    class LatchClosure : public google::protobuf::Closure {
+    public:
+        void Run() override { latch.count_down(); }
+        CountDownLatch latch{1};
+    };
+
+    // the rows of the keys [0, num_rows), whose v1 is the key plus 100.
+    RowsetSharedPtr _create_rowset(int64_t num_rows) {
+        RowsetWriterContext writer_context(kDataFormatV2, config::storage_format_version);
+        writer_context.rowset_id = StorageEngine::instance()->next_rowset_id();
+        writer_context.tablet_id = _tablet->tablet_id();
+        writer_context.tablet_schema_hash = _tablet->schema_hash();
+        writer_context.partition_id = 0;
+        writer_context.rowset_type = BETA_ROWSET;
+        writer_context.rowset_path_prefix = _tablet->tablet_path();
+        writer_context.rowset_state = COMMITTED;
+        writer_context.tablet_schema = &_tablet->tablet_schema();
+        writer_context.version.first = 0;
+        writer_context.version.second = 0;
+        writer_context.segments_overlap = NONOVERLAPPING;
+        std::unique_ptr<RowsetWriter> writer;
+        EXPECT_TRUE(RowsetFactory::create_rowset_writer(writer_context, &writer).ok());
+        auto schema = vectorized::ChunkHelper::convert_schema(_tablet->tablet_schema());
+        auto chunk = vectorized::ChunkHelper::new_chunk(schema, num_rows);
+        for (int64_t key = 0; key < num_rows; ++key) {
+            chunk->get_column_by_index(0)->append_datum(vectorized::Datum(key));
+            chunk->get_column_by_index(1)->append_datum(vectorized::Datum(static_cast<int32_t>(key + 100)));
+        }
+        EXPECT_EQ(OLAP_SUCCESS, writer->flush_chunk(*chunk));
+        return writer->build();
+    }
+
+    PLookupRowsRequest _request(const std::vector<int64_t>& keys) {
+        auto key_column = vectorized::Int64Column::create();
+        for (int64_t key : keys) {
+            key_column->append(key);
+        }
+        PLookupRowsRequest request;
+        request.set_tablet_id(_tablet->tablet_id());
+        request.set_schema_hash(_tablet->schema_hash());
+        std::string* data = request.add_keys();
+        data->resize(key_column->serialize_size());
+        key_column->serialize_column(reinterpret_cast<uint8_t*>(data->data()));
+        request.add_column_ids(1);
+        request.set_version(2);
+        return request;
+    }
+
+    static Status _lookup_rows(const PLookupRowsRequest& request, PLookupRowsResult* response) {
+        PInternalServiceImpl<PInternalService> service(ExecEnv::GetInstance());
+        brpc::Controller cntl;
+        LatchClosure closure;
+        service.lookup_rows(&cntl, &request, response, &closure);
+        closure.latch.wait();
+        return Status(response->status());
+    }
+
+    TabletSharedPtr _tablet;
+};
+
+// NOLINTNEXTLINE
+TEST_F(LookupRowsTest, test_lookup_rows) {
+    PLookupRowsResult response;
+    auto st = _lookup_rows(_request({3, 42, 7}), &response);
+    ASSERT_TRUE(st.ok()) << st.to_string();
+    ASSERT_EQ(2, response.version());
+    ASSERT_EQ(3, response.found_size());
+    ASSERT_TRUE(response.found(0));
+    ASSERT_FALSE(response.found(1));
+    ASSERT_TRUE(response.found(2));
+
+    ASSERT_EQ(1, response.columns_size());
+    auto column = vectorized::Int32Column::create();
+    column->deserialize_column(reinterpret_cast<const uint8_t*>(response.columns(0).data()));
+    ASSERT_EQ((std::vector<int32_t>{103, 107}), std::vector<int32_t>(column->get_data().begin(),
+                                                                     column->get_data().end()));
+}
+
+// NOLINTNEXTLINE
+TEST_F(LookupRowsTest, test_malformed_keys) {
+    // truncated
+    auto request = _request({3, 7});
+    request.mutable_keys(0)->resize(request.keys(0).size() - 3);
+    PLookupRowsResult response;
+    ASSERT_TRUE(_lookup_rows(request, &response).is_invalid_argument());
+
+    // the length is much longer than the bytes
+    request = _request({3});
+    std::string* data = request.mutable_keys(0);
+    encode_fixed32_le(reinterpret_cast<uint8_t*>(data->data()), 1U << 30);
+    response.Clear();
+    ASSERT_TRUE(_lookup_rows(request, &response).is_invalid_argument());
+
+    // not a multiple of the key size
+    request = _request({3});
+    data = request.mutable_keys(0);
+    data->append(1, '\0');
+    encode_fixed32_le(reinterpret_cast<uint8_t*>(data->data()), sizeof(int64_t) + 1);
+    response.Clear();
+    ASSERT_TRUE(_lookup_rows(request, &response).is_invalid_argument());
+}
+
+// NOLINTNEXTLINE
+TEST_F(LookupRowsTest, test_missing_tablet) {
+    auto request = _request({3});
+    request.set_tablet_id(_tablet->tablet_id() + 1);
+    PLookupRowsResult response;
+    ASSERT_TRUE(_lookup_rows(request, &response).is_not_found());
+}
+
+} // namespace starrocks
@@ -0,0 +1,52 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "simd/prefix_sum.h"
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace starrocks::vectorized {
+
+template <typename T>
+static void check_prefix_sum(const std::vector<T>& nums, T init) {
+    using U = std::make_unsigned_t<T>;
+    // cover all the tail lengths of the vectorized loops
+    for (size_t size = 0; size <= nums.size(); ++size) {
+        std::vector<T> result(nums.begin(), nums.begin() + size);
+        SIMD::prefix_sum(result.data(), size, init);
+        U expected = static_cast<U>(init);
+        for (size_t i = 0; i < size; ++i) {
+            expected += static_cast<U>(nums[i]);
+            ASSERT_EQ(static_cast<T>(expected), result[i]) << "size " << size << ", index " << i;
+        }
+    }
+}
+
+TEST(SIMDPrefixSumTest, PrefixSum) {
+    std::vector<int32_t> int32_nums(37);
+    std::vector<int64_t> int64_nums(37);
+    std::vector<int16_t> int16_nums(37);
+    for (int i = 0; i < 37; ++i) {
+        int32_nums[i] = (i % 3 == 0 ? -1 : 1) * i * 1000;
+        int64_nums[i] = (i % 2 == 0 ? -1 : 1) * (int64_t(1) << 40) * i;
+        int16_nums[i] = static_cast<int16_t>(i * 100);
+    }
+    check_prefix_sum<int32_t>(int32_nums, 0);
+    check_prefix_sum<int32_t>(int32_nums, -7);
+    check_prefix_sum<int64_t>(int64_nums, 0);
+    check_prefix_sum<int64_t>(int64_nums, int64_t(1) << 50);
+    check_prefix_sum<int16_t>(int16_nums, 3);
+}
+
+// the sums wrap around on overflow
+TEST(SIMDPrefixSumTest, Overflow) {
+    std::vector<int32_t> int32_nums(19, std::numeric_limits<int32_t>::max());
+    std::vector<int64_t> int64_nums(19, std::numeric_limits<int64_t>::min());
+    check_prefix_sum<int32_t>(int32_nums, std::numeric_limits<int32_t>::max());
+    check_prefix_sum<int64_t>(int64_nums, -1);
+}
+
+} // namespace starrocks::vectorized
@@ -0,0 +1,76 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "simd/reduce.h"
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace starrocks::vectorized {
+
+template <typename ResultType, typename T>
+static void check_sum(const std::vector<T>& nums) {
+    ResultType expected = 0;
+    for (T v : nums) {
+        expected += v;
+    }
+    // cover all the tail lengths of the unrolled loops
+    for (size_t size = 0; size <= nums.size(); ++size) {
+        ResultType result = 0;
+        for (size_t i = 0; i < size; ++i) {
+            result += nums[i];
+        }
+        ASSERT_TRUE(result == SIMD::sum<ResultType>(nums.data(), size)) << "size " << size;
+    }
+    ASSERT_TRUE(expected == SIMD::sum<ResultType>(nums.data(), nums.size()));
+}
+
+TEST(SIMDReduceTest, Sum) {
+    std::vector<int32_t> int32_nums(67);
+    std::vector<int64_t> int64_nums(67);
+    std::vector<int16_t> int16_nums(67);
+    for (int i = 0; i < 67; ++i) {
+        int32_nums[i] = (i % 3 == 0 ? -1 : 1) * (std::numeric_limits<int32_t>::max() - i);
+        int64_nums[i] = (i % 2 == 0 ? -1 : 1) * (int64_t(1) << 40) * i;
+        int16_nums[i] = static_cast<int16_t>(i * 1000);
+    }
+    check_sum<int64_t>(int32_nums);
+    check_sum<int64_t>(int64_nums);
+    check_sum<int64_t>(int16_nums);
+    check_sum<__int128>(int64_nums);
+
+    std::vector<uint32_t> uint32_nums(67, std::numeric_limits<uint32_t>::max());
+    check_sum<int64_t>(uint32_nums);
+
+    std::vector<double> double_nums(67);
+    std::iota(double_nums.begin(), double_nums.end(), 0.25);
+    check_sum<double>(double_nums);
+}
+
+TEST(SIMDReduceTest, MaxMin) {
+    std::vector<int32_t> nums(45);
+    for (int i = 0; i < 45; ++i) {
+        nums[i] = (i * 7919) % 101 - 50;
+    }
+    for (size_t size = 0; size <= nums.size(); ++size) {
+        int32_t expected_max = std::numeric_limits<int32_t>::lowest();
+        int32_t expected_min = std::numeric_limits<int32_t>::max();
+        for (size_t i = 0; i < size; ++i) {
+            expected_max = std::max(expected_max, nums[i]);
+            expected_min = std::min(expected_min, nums[i]);
+        }
+        ASSERT_EQ(expected_max, SIMD::max(nums.data(), size, std::numeric_limits<int32_t>::lowest()));
+        ASSERT_EQ(expected_min, SIMD::min(nums.data(), size, std::numeric_limits<int32_t>::max()));
+    }
+    // the initial value takes part in the reduction
+    ASSERT_EQ(100, SIMD::max(nums.data(), nums.size(), 100));
+    ASSERT_EQ(-100, SIMD::min(nums.data(), nums.size(), -100));
+
+    std::vector<double> double_nums{1.5, -2.5, 3.5, 0.5, 9.25, -7.0, 4.0, 2.0, 8.0};
+    ASSERT_EQ(9.25, SIMD::max(double_nums.data(), double_nums.size(), std::numeric_limits<double>::lowest()));
+    ASSERT_EQ(-7.0, SIMD::min(double_nums.data(), double_nums.size(), std::numeric_limits<double>::max()));
+}
+
+} // namespace starrocks::vectorized
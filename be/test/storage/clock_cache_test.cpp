@@ -0,0 +1,159 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/clock_cache.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+namespace starrocks {
+
+class ClockCacheTest : public testing::Test {
+public:
+    static ClockCacheTest* _s_current;
+
+    static void Deleter(const CacheKey& key, void* v) {
+        _s_current->_deleted_keys.push_back(DecodeKey(key));
+        _s_current->_deleted_values.push_back(reinterpret_cast<uintptr_t>(v));
+    }
+
+    static std::string EncodeKey(int k) {
+        std::string result(sizeof(k), 0);
+        memcpy(result.data(), &k, sizeof(k));
+        return result;
+    }
+
+    static int DecodeKey(const CacheKey& k) {
+        int result;
+        memcpy(&result, k.data(), sizeof(result));
+        return result;
+    }
+
+    static void* EncodeValue(uintptr_t v) { return reinterpret_cast<void*>(v); }
+
+    ClockCacheTest() { _s_current = this; }
+
+    void SetUp() override { _cache = std::make_unique<ShardedClockCache>(kNumShards * 16); }
+
+    void TearDown() override { _cache.reset(); }
+
+    int Lookup(int key) {
+        Cache::Handle* handle = _cache->lookup(EncodeKey(key));
+        const int r = (handle == nullptr) ? -1 : reinterpret_cast<uintptr_t>(_cache->value(handle));
+        if (handle != nullptr) {
+            _cache->release(handle);
+        }
+        return r;
+    }
+
+    void Insert(int key, int value, int charge, CachePriority priority = CachePriority::NORMAL) {
+        _cache->release(_cache->insert(EncodeKey(key), EncodeValue(value), charge, &ClockCacheTest::Deleter,
+                                       priority));
+    }
+
+    std::vector<int> _deleted_keys;
+    std::vector<int> _deleted_values;
+    std::unique_ptr<ShardedClockCache> _cache;
+};
+ClockCacheTest* ClockCacheTest::_s_current;
+
+TEST_F(ClockCacheTest, HitAndMiss) {
+    ASSERT_EQ(-1, Lookup(100));
+
+    Insert(100, 101, 1);
+    ASSERT_EQ(101, Lookup(100));
+    ASSERT_EQ(-1, Lookup(200));
+
+    Insert(200, 201, 1);
+    ASSERT_EQ(101, Lookup(100));
+    ASSERT_EQ(201, Lookup(200));
+
+    // replace the value of 100.
+    Insert(100, 102, 1);
+    ASSERT_EQ(102, Lookup(100));
+    ASSERT_EQ(1, _deleted_keys.size());
+    ASSERT_EQ(100, _deleted_keys[0]);
+    ASSERT_EQ(101, _deleted_values[0]);
+    ASSERT_EQ(2, _cache->get_memory_usage());
+}
+
+TEST_F(ClockCacheTest, EraseAndPinned) {
+    Insert(100, 101, 1);
+    Cache::Handle* h = _cache->lookup(EncodeKey(100));
+    ASSERT_NE(nullptr, h);
+    _cache->erase(EncodeKey(100));
+    ASSERT_EQ(-1, Lookup(100));
+    // still referenced by the handle.
+    ASSERT_EQ(0, _deleted_keys.size());
+    ASSERT_EQ(101, static_cast<int>(reinterpret_cast<uintptr_t>(_cache->value(h))));
+    _cache->release(h);
+    ASSERT_EQ(1, _deleted_keys.size());
+    ASSERT_EQ(0, _cache->get_memory_usage());
+}
+
+TEST_F(ClockCacheTest, SecondChance) {
+    // one shard of 16 bytes.
+    _cache = std::make_unique<ShardedClockCache>(16);
+    ASSERT_EQ(1, _cache->num_shards());
+    for (int i = 0; i < 16; i++) {
+        Insert(i, i, 1);
+    }
+    // the visited entries survive a sweep.
+    for (int i = 0; i < 4; i++) {
+        ASSERT_EQ(i, Lookup(i));
+    }
+    for (int i = 16; i < 28; i++) {
+        Insert(i, i, 1);
+    }
+    for (int i = 0; i < 4; i++) {
+        ASSERT_EQ(i, Lookup(i));
+    }
+    for (int i = 4; i < 16; i++) {
+        ASSERT_EQ(-1, Lookup(i));
+    }
+    ASSERT_EQ(16, _cache->get_memory_usage());
+}
+
+TEST_F(ClockCacheTest, DurableEvictedLast) {
+    _cache = std::make_unique<ShardedClockCache>(16);
+    for (int i = 0; i < 8; i++) {
+        Insert(i, i, 1, CachePriority::DURABLE);
+    }
+    for (int i = 8; i < 40; i++) {
+        Insert(i, i, 1);
+    }
+    for (int i = 0; i < 8; i++) {
+        ASSERT_EQ(i, Lookup(i));
+    }
+    // evicted when the normal entries are not enough.
+    Insert(100, 100, 16);
+    ASSERT_EQ(100, Lookup(100));
+    for (int i = 0; i < 8; i++) {
+        ASSERT_EQ(-1, Lookup(i));
+    }
+}
+
+TEST_F(ClockCacheTest, Concurrent) {
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; t++) {
+        threads.emplace_back([this, t]() {
+            for (int i = 0; i < 10000; i++) {
+                int key = (i * 7 + t) % 1000;
+                Cache::Handle* h = _cache->lookup(EncodeKey(key));
+                if (h == nullptr) {
+                    h = _cache->insert(EncodeKey(key), EncodeValue(key), 1, [](const CacheKey&, void*) {});
+                }
+                ASSERT_EQ(key, static_cast<int>(reinterpret_cast<uintptr_t>(_cache->value(h))));
+                _cache->release(h);
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    _cache->prune();
+    ASSERT_EQ(0, _cache->get_memory_usage());
+}
+
+} // namespace starrocks
@@ -0,0 +1,45 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/compaction_scheduler.h"
+
+#include <gtest/gtest.h>
+
+namespace starrocks {
+
+// NOLINTNEXTLINE
+TEST(CompactionSchedulerTest, test_calc_priority) {
+    // higher score first
+    ASSERT_GT(CompactionScheduler::calc_priority(10, 10, 0), CompactionScheduler::calc_priority(5, 10, 0));
+    // more versions first
+    ASSERT_GT(CompactionScheduler::calc_priority(10, 800, 0), CompactionScheduler::calc_priority(10, 10, 0));
+    // hotter tablets first
+    ASSERT_GT(CompactionScheduler::calc_priority(10, 10, 100), CompactionScheduler::calc_priority(10, 10, 0));
+    // the version ratio is capped
+    ASSERT_DOUBLE_EQ(CompactionScheduler::calc_priority(10, 100000, 0),
+                     CompactionScheduler::calc_priority(10, 200000, 0));
+}
+
+// NOLINTNEXTLINE
+TEST(CompactionSchedulerTest, test_pick_task) {
+    auto* disk1 = reinterpret_cast<DataDir*>(0x1);
+    auto* disk2 = reinterpret_cast<DataDir*>(0x2);
+    std::vector<CompactionTask> queue(3);
+    queue[0].data_dir = disk1;
+    queue[1].data_dir = disk1;
+    queue[2].data_dir = disk2;
+
+    std::unordered_map<DataDir*, int32_t> running;
+    ASSERT_EQ(0, CompactionScheduler::pick_task(queue, running, 2));
+
+    // disk1 is full, skip to the task of disk2
+    running[disk1] = 2;
+    ASSERT_EQ(2, CompactionScheduler::pick_task(queue, running, 2));
+    // no limit
+    ASSERT_EQ(0, CompactionScheduler::pick_task(queue, running, 0));
+
+    running[disk2] = 2;
+    ASSERT_EQ(-1, CompactionScheduler::pick_task(queue, running, 2));
+    ASSERT_EQ(-1, CompactionScheduler::pick_task({}, running, 2));
+}
+
+} // namespace starrocks
@@ -0,0 +1,182 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/data_dir.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <vector>
+
+#include "common/config.h"
+#include "runtime/mem_tracker.h"
+#include "storage/rowset/rowset_factory.h"
+#include "storage/rowset/rowset_writer.h"
+#include "storage/rowset/rowset_writer_context.h"
+#include "storage/storage_engine.h"
+#include "storage/task/engine_publish_version_task.h"
+#include "storage/tablet_manager.h"
+#include "storage/txn_manager.h"
+#include "storage/vectorized/chunk_helper.h"
+
+namespace starrocks {
+
+class DataDirTest : public testing::Test {
+public:
+    void SetUp() override {
+        _old_load_threads = config::tablet_meta_load_threads_per_data_dir;
+        _old_ignore_failure = config::ignore_load_tablet_failure;
+        // the data dir is shared with the tablets of the other tests.
+        config::ignore_load_tablet_failure = true;
+    }
+
+    void TearDown() override {
+        config::tablet_meta_load_threads_per_data_dir = _old_load_threads;
+        config::ignore_load_tablet_failure = _old_ignore_failure;
+        auto* txn_mgr = StorageEngine::instance()->txn_manager();
+        for (auto& [tablet, partition_id] : _tablets) {
+            (void)txn_mgr->rollback_txn(partition_id, tablet, kTxnId);
+            (void)StorageEngine::instance()->tablet_manager()->drop_tablet(tablet->tablet_id(), tablet->schema_hash(),
+                                                                           false);
+        }
+        _tablets.clear();
+    }
+
+protected:
+    static constexpr int64_t kPublishedPartitionId = 5001;
+    static constexpr int64_t kCommittedPartitionId = 5002;
+    static constexpr int64_t kTxnId = 6001;
+    static constexpr int32_t kSchemaHash = 1111;
+
+    TabletSharedPtr _create_tablet(int64_t tablet_id, int64_t partition_id) {
+        TCreateTabletReq request;
+        request.tablet_id = tablet_id;
+        request.__set_version(1);
+        request.__set_version_hash(0);
+        request.__set_partition_id(partition_id);
+        request.tablet_schema.schema_hash = kSchemaHash;
+        request.tablet_schema.short_key_column_count = 1;
+        request.tablet_schema.keys_type = TKeysType::DUP_KEYS;
+        request.tablet_schema.storage_type = TStorageType::COLUMN;
+
+        TColumn k1;
+        k1.column_name = "k1";
+        k1.__set_is_key(true);
+        k1.column_type.type = TPrimitiveType::INT;
+        request.tablet_schema.columns.push_back(k1);
+        auto st = StorageEngine::instance()->create_tablet(request);
+        CHECK(st.ok()) << st.to_string();
+        auto tablet = StorageEngine::instance()->tablet_manager()->get_tablet(tablet_id, kSchemaHash);
+        _tablets.emplace_back(tablet, partition_id);
+        return tablet;
+    }
+
+    // write a rowset of one row to |tablet| in the txn and commit it.
+    void _commit(const TabletSharedPtr& tablet, int64_t partition_id) {
+        PUniqueId load_id;
+        load_id.set_hi(tablet->tablet_id());
+        load_id.set_lo(kTxnId);
+        auto* txn_mgr = StorageEngine::instance()->txn_manager();
+        ASSERT_EQ(OLAP_SUCCESS, txn_mgr->prepare_txn(partition_id, tablet, kTxnId, load_id));
+
+        RowsetWriterContext writer_context(kDataFormatV2, config::storage_format_version);
+        writer_context.rowset_id = StorageEngine::instance()->next_rowset_id();
+        writer_context.tablet_uid = tablet->tablet_uid();
+        writer_context.tablet_id = tablet->tablet_id();
+        writer_context.tablet_schema_hash = tablet->schema_hash();
+        writer_context.partition_id = partition_id;
+        writer_context.txn_id = kTxnId;
+        writer_context.load_id = load_id;
+        writer_context.rowset_path_prefix = tablet->tablet_path();
+        writer_context.rowset_state = COMMITTED;
+        writer_context.tablet_schema = &tablet->tablet_schema();
+        writer_context.segments_overlap = NONOVERLAPPING;
+        std::unique_ptr<RowsetWriter> writer;
+        ASSERT_TRUE(RowsetFactory::create_rowset_writer(writer_context, &writer).ok());
+        auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet->tablet_schema());
+        auto chunk = vectorized::ChunkHelper::new_chunk(schema, 1);
+        chunk->get_column_by_index(0)->append_datum(vectorized::Datum((int32_t)1));
+        ASSERT_EQ(OLAP_SUCCESS, writer->add_chunk(*chunk));
+        ASSERT_EQ(OLAP_SUCCESS, writer->flush());
+        RowsetSharedPtr rowset = writer->build();
+        ASSERT_TRUE(rowset != nullptr);
+        ASSERT_EQ(OLAP_SUCCESS, txn_mgr->commit_txn(partition_id, tablet, kTxnId, load_id, rowset, false));
+    }
+
+    // load the metas of |data_dir| into a new tablet manager and a new txn manager by |num_threads| threads,
+    // and check the tablets and the txns of this test are all loaded.
+    void _load_and_check(DataDir* data_dir, int32_t num_threads) {
+        config::tablet_meta_load_threads_per_data_dir = num_threads;
+        MemTracker mem_tracker;
+        TabletManager tablet_mgr(&mem_tracker, 4);
+        TxnManager txn_mgr(4, 4);
+        TabletManager* old_tablet_mgr = data_dir->_tablet_manager;
+        TxnManager* old_txn_mgr = data_dir->_txn_manager;
+        data_dir->_tablet_manager = &tablet_mgr;
+        data_dir->_txn_manager = &txn_mgr;
+        OLAPStatus res = data_dir->load();
+        data_dir->_tablet_manager = old_tablet_mgr;
+        data_dir->_txn_manager = old_txn_mgr;
+        ASSERT_EQ(OLAP_SUCCESS, res);
+
+        std::map<TabletInfo, RowsetSharedPtr> committed_tablets;
+        txn_mgr.get_txn_related_tablets(kTxnId, kCommittedPartitionId, &committed_tablets);
+        std::map<TabletInfo, RowsetSharedPtr> published_tablets;
+        txn_mgr.get_txn_related_tablets(kTxnId, kPublishedPartitionId, &published_tablets);
+        ASSERT_TRUE(published_tablets.empty());
+        int num_committed = 0;
+        for (auto& [tablet, partition_id] : _tablets) {
+            auto loaded = tablet_mgr.get_tablet(tablet->tablet_id(), tablet->schema_hash());
+            ASSERT_TRUE(loaded != nullptr) << tablet->tablet_id();
+            ASSERT_EQ(tablet->tablet_uid(), loaded->tablet_uid());
+            if (partition_id == kPublishedPartitionId) {
+                ASSERT_TRUE(loaded->check_version_exist(Version(2, 2))) << tablet->tablet_id();
+            } else {
+                ASSERT_FALSE(loaded->check_version_exist(Version(2, 2))) << tablet->tablet_id();
+                // the committed rowset is added back to the txn.
+                TabletInfo tablet_info(tablet->tablet_id(), tablet->schema_hash(), tablet->tablet_uid());
+                auto iter = committed_tablets.find(tablet_info);
+                ASSERT_TRUE(iter != committed_tablets.end()) << tablet->tablet_id();
+                ASSERT_EQ(kTxnId, iter->second->txn_id());
+                num_committed++;
+            }
+        }
+        ASSERT_EQ(num_committed, committed_tablets.size());
+    }
+
+    int32_t _old_load_threads = 0;
+    bool _old_ignore_failure = false;
+    std::vector<std::pair<TabletSharedPtr, int64_t>> _tablets;
+};
+
+// NOLINTNEXTLINE
+TEST_F(DataDirTest, test_load_metas_in_parallel) {
+    const int kNumTablets = 40;
+    for (int i = 0; i < kNumTablets; ++i) {
+        int64_t partition_id = i % 2 == 0 ? kPublishedPartitionId : kCommittedPartitionId;
+        auto tablet = _create_tablet(14001 + i, partition_id);
+        ASSERT_TRUE(tablet != nullptr);
+        _commit(tablet, partition_id);
+    }
+
+    TPublishVersionRequest request;
+    request.transaction_id = kTxnId;
+    TPartitionVersionInfo version_info;
+    version_info.partition_id = kPublishedPartitionId;
+    version_info.version = 2;
+    version_info.version_hash = 0;
+    request.partition_version_infos.push_back(version_info);
+    std::vector<TTabletId> error_tablet_ids;
+    EnginePublishVersionTask task(request, &error_tablet_ids);
+    ASSERT_EQ(OLAP_SUCCESS, task.finish());
+
+    DataDir* data_dir = _tablets[0].first->data_dir();
+    for (auto& [tablet, partition_id] : _tablets) {
+        ASSERT_EQ(data_dir, tablet->data_dir());
+    }
+    // with 2 threads, the metas are more than the queue between the reading thread and the loading threads holds.
+    _load_and_check(data_dir, 1);
+    _load_and_check(data_dir, 2);
+    _load_and_check(data_dir, 8);
+}
+
+} // namespace starrocks
@@ -0,0 +1,80 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/fs/async_block.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "env/env_memory.h"
+#include "storage/fs/file_block_manager.h"
+#include "util/slice.h"
+
+namespace starrocks::fs {
+
+class AsyncWritableBlockTest : public testing::Test {
+protected:
+    void SetUp() override {
+        _env = std::make_unique<EnvMemory>();
+        _block_mgr = std::make_unique<FileBlockManager>(_env.get(), BlockManagerOptions());
+        ASSERT_TRUE(_env->create_dir(kTestDir).ok());
+    }
+
+    std::string read_file(const std::string& fname) {
+        std::unique_ptr<ReadableBlock> rblock;
+        CHECK(_block_mgr->open_block(fname, &rblock).ok());
+        uint64_t size = 0;
+        CHECK(rblock->size(&size).ok());
+        std::string data(size, '\0');
+        CHECK(rblock->read(0, Slice(data)).ok());
+        return data;
+    }
+
+    const std::string kTestDir = "/async_block_test";
+    std::unique_ptr<EnvMemory> _env;
+    std::unique_ptr<FileBlockManager> _block_mgr;
+};
+
+// NOLINTNEXTLINE
+TEST_F(AsyncWritableBlockTest, test_append) {
+    std::string fname = kTestDir + "/test_append";
+    std::unique_ptr<WritableBlock> wblock;
+    ASSERT_TRUE(_block_mgr->create_block(CreateBlockOptions({fname}), &wblock).ok());
+    AsyncWritableBlock block(std::move(wblock), 4096);
+    ASSERT_EQ(WritableBlock::CLEAN, block.state());
+
+    // the appends smaller and larger than the buffers.
+    std::string expected;
+    for (int i = 0; i < 1000; i++) {
+        std::string data(i * 7 % 10000, 'a' + i % 26);
+        if (i % 2 == 0) {
+            ASSERT_TRUE(block.append(data).ok());
+        } else {
+            Slice slices[2] = {Slice(data.data(), data.size() / 2),
+                               Slice(data.data() + data.size() / 2, data.size() - data.size() / 2)};
+            ASSERT_TRUE(block.appendv(slices, 2).ok());
+        }
+        expected.append(data);
+        ASSERT_EQ(expected.size(), block.bytes_appended());
+    }
+    ASSERT_EQ(WritableBlock::DIRTY, block.state());
+    ASSERT_TRUE(block.finalize().ok());
+    ASSERT_EQ(WritableBlock::FINALIZED, block.state());
+    ASSERT_TRUE(block.close().ok());
+    ASSERT_EQ(WritableBlock::CLOSED, block.state());
+    ASSERT_EQ(expected, read_file(fname));
+}
+
+// NOLINTNEXTLINE
+TEST_F(AsyncWritableBlockTest, test_close_without_finalize) {
+    std::string fname = kTestDir + "/test_close_without_finalize";
+    std::unique_ptr<WritableBlock> wblock;
+    ASSERT_TRUE(_block_mgr->create_block(CreateBlockOptions({fname}), &wblock).ok());
+    AsyncWritableBlock block(std::move(wblock), 4096);
+    std::string data(10000, 'x');
+    ASSERT_TRUE(block.append(data).ok());
+    ASSERT_TRUE(block.close().ok());
+    ASSERT_EQ(data, read_file(fname));
+}
+
+} // namespace starrocks::fs
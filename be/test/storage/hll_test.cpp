@@ -196,6 +196,43 @@ TEST_F(TestHll, Normal) {
     }
 }
 
+TEST_F(TestHll, MergeSerialized) {
+    HyperLogLog explicit_hll;
+    HyperLogLog sparse_hll;
+    HyperLogLog full_hll;
+    for (int i = 0; i < 100; ++i) {
+        explicit_hll.update(hash(i));
+    }
+    for (int i = 0; i < 1000; ++i) {
+        sparse_hll.update(hash(i + 10000));
+    }
+    for (int i = 0; i < 100000; ++i) {
+        full_hll.update(hash(i + 100000));
+    }
+
+    std::vector<uint8_t> buf(HLL_REGISTERS_COUNT + 1);
+    HyperLogLog expected;
+    HyperLogLog merged;
+    for (const HyperLogLog* hll : {&explicit_hll, &sparse_hll, &full_hll}) {
+        size_t len = hll->serialize(buf.data());
+        ASSERT_TRUE(merged.merge(Slice(buf.data(), len)));
+        expected.merge(*hll);
+        ASSERT_EQ(expected.estimate_cardinality(), merged.estimate_cardinality());
+    }
+
+    // merge into an explicit hll
+    HyperLogLog merged2;
+    merged2.update(hash(1));
+    size_t len = full_hll.serialize(buf.data());
+    ASSERT_TRUE(merged2.merge(Slice(buf.data(), len)));
+    HyperLogLog expected2;
+    expected2.update(hash(1));
+    expected2.merge(full_hll);
+    ASSERT_EQ(expected2.estimate_cardinality(), merged2.estimate_cardinality());
+
+    ASSERT_FALSE(merged2.merge(Slice((char*)nullptr, 0)));
+}
+
 TEST_F(TestHll, InvalidPtr) {
     {
         HyperLogLog hll(Slice((char*)nullptr, 0));
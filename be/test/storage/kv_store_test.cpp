@@ -26,6 +26,8 @@
 #include <filesystem>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "storage/olap_define.h"
 #include "util/file_utils.h"
@@ -114,4 +116,45 @@ TEST_F(KVStoreTest, TestIterate) {
     ASSERT_EQ(false, error_flag);
 }
 
+TEST_F(KVStoreTest, TestQueueBatch) {
+    // the batches are applied in the order they are queued
+    WriteBatch batch1;
+    ASSERT_TRUE(batch1.Put(_kv_store->handle(META_COLUMN_FAMILY_INDEX), "key", "value1").ok());
+    WriteBatch batch2;
+    ASSERT_TRUE(batch2.Put(_kv_store->handle(META_COLUMN_FAMILY_INDEX), "key", "value2").ok());
+    auto queued1 = _kv_store->queue_batch(std::move(batch1));
+    auto queued2 = _kv_store->queue_batch(std::move(batch2));
+    ASSERT_TRUE(_kv_store->wait_batch(queued2).ok());
+    ASSERT_TRUE(queued1->done);
+    ASSERT_TRUE(_kv_store->wait_batch(queued1).ok());
+    std::string value_get;
+    ASSERT_TRUE(_kv_store->get(META_COLUMN_FAMILY_INDEX, "key", &value_get).ok());
+    ASSERT_EQ("value2", value_get);
+
+    // concurrent writers
+    const int num_threads = 8;
+    const int num_keys = 100;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; t++) {
+        threads.emplace_back([this, t]() {
+            for (int i = 0; i < num_keys; i++) {
+                WriteBatch batch;
+                std::string key = "key_" + std::to_string(t) + "_" + std::to_string(i);
+                ASSERT_TRUE(batch.Put(_kv_store->handle(META_COLUMN_FAMILY_INDEX), key, key).ok());
+                ASSERT_TRUE(_kv_store->wait_batch(_kv_store->queue_batch(std::move(batch))).ok());
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    for (int t = 0; t < num_threads; t++) {
+        for (int i = 0; i < num_keys; i++) {
+            std::string key = "key_" + std::to_string(t) + "_" + std::to_string(i);
+            ASSERT_TRUE(_kv_store->get(META_COLUMN_FAMILY_INDEX, key, &value_get).ok());
+            ASSERT_EQ(key, value_get);
+        }
+    }
+}
+
 } // namespace starrocks
@@ -0,0 +1,124 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include <gtest/gtest.h>
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "common/config.h"
+#include "storage/rowset/rowset.h"
+#include "storage/rowset/rowset_meta.h"
+#include "storage/storage_engine.h"
+#include "storage/tablet.h"
+#include "storage/tablet_manager.h"
+
+namespace starrocks {
+
+class TieredStorageMigrationTest : public testing::Test {
+public:
+    void SetUp() override {
+        _old_cold_tablet_age = config::tiered_storage_cold_tablet_age_seconds;
+        config::tiered_storage_cold_tablet_age_seconds = 100;
+        _old_query_counts.swap(StorageEngine::instance()->_tiered_storage_query_counts);
+    }
+
+    void TearDown() override {
+        config::tiered_storage_cold_tablet_age_seconds = _old_cold_tablet_age;
+        StorageEngine::instance()->_tiered_storage_query_counts.swap(_old_query_counts);
+        for (auto& tablet : _tablets) {
+            (void)StorageEngine::instance()->tablet_manager()->drop_tablet(tablet->tablet_id(), tablet->schema_hash(),
+                                                                           false);
+        }
+        _tablets.clear();
+    }
+
+protected:
+    TabletSharedPtr _create_tablet(int64_t tablet_id, TKeysType::type keys_type) {
+        TCreateTabletReq request;
+        request.tablet_id = tablet_id;
+        request.__set_version(1);
+        request.__set_version_hash(0);
+        request.tablet_schema.schema_hash = 1111;
+        request.tablet_schema.short_key_column_count = 1;
+        request.tablet_schema.keys_type = keys_type;
+        request.tablet_schema.storage_type = TStorageType::COLUMN;
+
+        TColumn k1;
+        k1.column_name = "k1";
+        k1.__set_is_key(true);
+        k1.column_type.type = TPrimitiveType::BIGINT;
+        request.tablet_schema.columns.push_back(k1);
+        auto st = StorageEngine::instance()->create_tablet(request);
+        CHECK(st.ok()) << st.to_string();
+        auto tablet = StorageEngine::instance()->tablet_manager()->get_tablet(tablet_id, 1111);
+        CHECK(tablet != nullptr);
+        _tablets.push_back(tablet);
+        return tablet;
+    }
+
+    // a DUP tablet whose newest data is written at |write_time|.
+    TabletSharedPtr _create_tablet_written_at(int64_t tablet_id, int64_t write_time) {
+        auto tablet = _create_tablet(tablet_id, TKeysType::DUP_KEYS);
+        tablet->rowset_with_max_version()->rowset_meta()->set_creation_time(write_time);
+        return tablet;
+    }
+
+    static std::vector<int64_t> _collect(const std::vector<TabletSharedPtr>& tablets, int64_t now) {
+        std::vector<std::pair<int64_t, TabletSharedPtr>> cold_tablets;
+        StorageEngine::instance()->_collect_cold_tablets(tablets, now, &cold_tablets);
+        std::vector<int64_t> tablet_ids;
+        for (auto& [newest_write_time, tablet] : cold_tablets) {
+            tablet_ids.push_back(tablet->tablet_id());
+        }
+        return tablet_ids;
+    }
+
+    int64_t _old_cold_tablet_age = 0;
+    std::unordered_map<int64_t, int64_t> _old_query_counts;
+    std::vector<TabletSharedPtr> _tablets;
+};
+
+// NOLINTNEXTLINE
+TEST_F(TieredStorageMigrationTest, test_migration_window) {
+    ASSERT_TRUE(StorageEngine::_in_tiered_storage_migration_window(0, 0, 6));
+    ASSERT_TRUE(StorageEngine::_in_tiered_storage_migration_window(5, 0, 6));
+    ASSERT_FALSE(StorageEngine::_in_tiered_storage_migration_window(6, 0, 6));
+    ASSERT_FALSE(StorageEngine::_in_tiered_storage_migration_window(23, 0, 6));
+
+    // the window wraps around midnight.
+    ASSERT_TRUE(StorageEngine::_in_tiered_storage_migration_window(22, 22, 2));
+    ASSERT_TRUE(StorageEngine::_in_tiered_storage_migration_window(1, 22, 2));
+    ASSERT_FALSE(StorageEngine::_in_tiered_storage_migration_window(2, 22, 2));
+    ASSERT_FALSE(StorageEngine::_in_tiered_storage_migration_window(12, 22, 2));
+
+    // an empty window.
+    ASSERT_FALSE(StorageEngine::_in_tiered_storage_migration_window(3, 3, 3));
+}
+
+// NOLINTNEXTLINE
+TEST_F(TieredStorageMigrationTest, test_collect_cold_tablets) {
+    auto tablet1 = _create_tablet_written_at(15001, 1000);
+    auto tablet2 = _create_tablet_written_at(15002, 2000);
+    auto tablet3 = _create_tablet_written_at(15003, 3000);
+    // the migration task does not support the primary key tablets.
+    auto pk_tablet = _create_tablet(15004, TKeysType::PRIMARY_KEYS);
+    std::vector<TabletSharedPtr> tablets{tablet3, pk_tablet, tablet2, tablet1};
+
+    // the heat of the tablets is unknown in the first round.
+    ASSERT_TRUE(_collect(tablets, 5000).empty());
+
+    // a queried tablet is hot, the others are cold, the oldest first.
+    tablet2->increase_query_count();
+    ASSERT_EQ((std::vector<int64_t>{15001, 15003}), _collect(tablets, 5000));
+
+    // the tablet is cold if not queried in the next round, but the data of a tablet may be too new.
+    ASSERT_EQ((std::vector<int64_t>{15001, 15002}), _collect(tablets, 3050));
+
+    // a tablet not seen in a round loses its heat.
+    ASSERT_EQ((std::vector<int64_t>{15001}), _collect({tablet1}, 5000));
+    ASSERT_EQ((std::vector<int64_t>{15001}), _collect(tablets, 5000));
+    ASSERT_EQ((std::vector<int64_t>{15001, 15002, 15003}), _collect(tablets, 5000));
+}
+
+} // namespace starrocks
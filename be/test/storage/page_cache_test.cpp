@@ -94,4 +94,56 @@ TEST_F(StoragePageCacheTest, normal) {
     }
 }
 
+// NOLINTNEXTLINE
+TEST_F(StoragePageCacheTest, index_and_data_tiers) {
+    StoragePageCache cache(_mem_tracker.get(), kNumShards * 4096, kNumShards * 2048);
+
+    StoragePageCache::CacheKey index_key("index", 0);
+    StoragePageCache::CacheKey data_key("data", 0);
+
+    {
+        char* buf = new char[1024];
+        PageCacheHandle handle;
+        ASSERT_TRUE(cache.insert(index_key, Slice(buf, 1024), &handle, false));
+        ASSERT_EQ(buf, handle.data().data);
+        // the index page is not in the data tier.
+        PageCacheHandle data_handle;
+        ASSERT_FALSE(cache.lookup(index_key, &data_handle, true));
+    }
+
+    {
+        // the data page is not admitted on the first miss.
+        std::unique_ptr<char[]> buf(new char[1024]);
+        PageCacheHandle handle;
+        ASSERT_FALSE(cache.insert(data_key, Slice(buf.get(), 1024), &handle, false, true));
+        ASSERT_FALSE(cache.lookup(data_key, &handle, true));
+        // admitted on the second miss.
+        ASSERT_TRUE(cache.insert(data_key, Slice(buf.get(), 1024), &handle, false, true));
+        buf.release();
+        ASSERT_TRUE(cache.lookup(data_key, &handle, true));
+    }
+
+    {
+        // the data page of the in memory table is always admitted.
+        StoragePageCache::CacheKey memory_key("mem", 0);
+        char* buf = new char[1024];
+        PageCacheHandle handle;
+        ASSERT_TRUE(cache.insert(memory_key, Slice(buf, 1024), &handle, true, true));
+        ASSERT_TRUE(cache.lookup(memory_key, &handle, true));
+    }
+
+    // a large scan of the data pages evicts neither the index page nor the data page admitted.
+    for (int i = 0; i < 10 * kNumShards; ++i) {
+        StoragePageCache::CacheKey key("scan", i);
+        std::unique_ptr<char[]> buf(new char[1024]);
+        PageCacheHandle handle;
+        ASSERT_FALSE(cache.insert(key, Slice(buf.get(), 1024), &handle, false, true));
+    }
+    {
+        PageCacheHandle handle;
+        ASSERT_TRUE(cache.lookup(index_key, &handle));
+        ASSERT_TRUE(cache.lookup(data_key, &handle, true));
+    }
+}
+
 } // namespace starrocks
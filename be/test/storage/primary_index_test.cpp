@@ -4,8 +4,11 @@
 
 #include <gtest/gtest.h>
 
+#include <fstream>
+
 #include "column/fixed_length_column.h"
 #include "column/schema.h"
+#include "env/env.h"
 #include "gutil/strings/substitute.h"
 #include "storage/primary_key_encoder.h"
 #include "storage/vectorized/chunk_helper.h"
@@ -246,6 +249,65 @@ PARALLEL_TEST(PrimaryIndexTest, test_composite_key) {
     ASSERT_EQ(deletes[1].size(), kSegmentSize);
 }
 
+// writes the snapshot of an index of |pk_col| and checks the positions of the keys read back by upserting them.
+static void test_snapshot(const vectorized::Schema& schema, const vectorized::Column& pk_col, const std::string& path) {
+    auto pk_index = TEST_create_primary_index(schema);
+    ASSERT_TRUE(pk_index->insert(3, 10, pk_col).ok());
+    ASSERT_TRUE(pk_index->write_snapshot(path, 7, {3, 5}).ok());
+
+    auto loaded = TEST_create_primary_index(schema);
+    int64_t version = 0;
+    std::vector<uint32_t> rowset_ids;
+    ASSERT_TRUE(loaded->read_snapshot(path, &version, &rowset_ids).ok());
+    ASSERT_EQ(7, version);
+    ASSERT_EQ((std::vector<uint32_t>{3, 5}), rowset_ids);
+    ASSERT_EQ(pk_col.size(), loaded->size());
+
+    PrimaryIndex::DeletesMap deletes;
+    loaded->upsert(4, 0, pk_col, &deletes);
+    ASSERT_EQ(1, deletes.size());
+    ASSERT_EQ(pk_col.size(), deletes[3].size());
+    for (uint32_t i = 0; i < deletes[3].size(); i++) {
+        ASSERT_EQ(10 + i, deletes[3][i]);
+    }
+
+    // flip a byte of the last block
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekg(-13, std::ios::end);
+        char c = 0;
+        file.get(c);
+        file.seekp(-13, std::ios::end);
+        file.put(static_cast<char>(c ^ 0x1));
+    }
+    auto corrupted = TEST_create_primary_index(schema);
+    ASSERT_FALSE(corrupted->read_snapshot(path, &version, &rowset_ids).ok());
+    ASSERT_TRUE(Env::Default()->delete_file(path).ok());
+}
+
+PARALLEL_TEST(PrimaryIndexTest, test_snapshot_bigint) {
+    auto f = std::make_shared<vectorized::Field>(0, "c0", OLAP_FIELD_TYPE_BIGINT, false);
+    f->set_is_key(true);
+    vectorized::Schema schema(Fields{f});
+    // more than one block of entries
+    auto pk_col = Int64Column::create();
+    for (int64_t i = 0; i < 100000; i++) {
+        pk_col->append(i * 3);
+    }
+    test_snapshot(schema, *pk_col, "./primary_index_snapshot_bigint.pkidx");
+}
+
+PARALLEL_TEST(PrimaryIndexTest, test_snapshot_varchar) {
+    auto f = std::make_shared<vectorized::Field>(0, "c0", OLAP_FIELD_TYPE_VARCHAR, false);
+    f->set_is_key(true);
+    vectorized::Schema schema(Fields{f});
+    auto pk_col = BinaryColumn::create();
+    for (int i = 0; i < 1000; i++) {
+        pk_col->append(strings::Substitute("binary_pk_$0", i));
+    }
+    test_snapshot(schema, *pk_col, "./primary_index_snapshot_varchar.pkidx");
+}
+
 // TODO: test composite primary key
 
 } // namespace starrocks
@@ -42,6 +42,7 @@
 #include "storage/tablet_schema.h"
 #include "storage/vectorized/chunk_helper.h"
 #include "storage/vectorized/column_predicate.h"
+#include "storage/vectorized/delete_predicates.h"
 #include "util/defer_op.h"
 #include "util/file_utils.h"
 
@@ -731,4 +732,707 @@ TEST_F(BetaRowsetTest, FinalMergeTest) {
     }
 }
 
+TEST_F(BetaRowsetTest, RuntimeFilterPredicatesTest) {
+    TabletSchema tablet_schema;
+    create_tablet_schema(&tablet_schema);
+    RowsetSharedPtr rowset;
+    const int num_segments = 2;
+    const uint32_t rows_per_segment = 4096;
+    {
+        RowsetWriterContext writer_context(kDataFormatV2, kDataFormatV2);
+        create_rowset_writer_context(&tablet_schema, &writer_context);
+
+        std::unique_ptr<RowsetWriter> rowset_writer;
+        ASSERT_TRUE(RowsetFactory::create_rowset_writer(writer_context, &rowset_writer).ok());
+
+        auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema);
+        for (int seg = 0; seg < num_segments; seg++) {
+            auto chunk = vectorized::ChunkHelper::new_chunk(schema, rows_per_segment);
+            auto& cols = chunk->columns();
+            for (auto i = 0; i < rows_per_segment; i++) {
+                auto value = static_cast<int32_t>(seg * rows_per_segment + i);
+                cols[0]->append_datum(vectorized::Datum(value));
+                cols[1]->append_datum(vectorized::Datum(value));
+                cols[2]->append_datum(vectorized::Datum(value));
+            }
+            rowset_writer->add_chunk(*chunk.get());
+            EXPECT_EQ(OLAP_SUCCESS, rowset_writer->flush());
+        }
+
+        rowset = rowset_writer->build();
+        ASSERT_TRUE(rowset != nullptr);
+        ASSERT_EQ(num_segments, rowset->rowset_meta()->num_segments());
+    }
+
+    auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema);
+    OlapReaderStatistics stats;
+    vectorized::RowsetReadOptions rs_opts;
+    rs_opts.sorted = false;
+    rs_opts.stats = &stats;
+
+    // the runtime filter `k1 < rows_per_segment` arrives after the first segment iterator is initialized.
+    int num_calls = 0;
+    rs_opts.runtime_filter_preds_builder = [&](ObjectPool* pool,
+                                               std::vector<const vectorized::ColumnPredicate*>* preds) {
+        if (num_calls++ == 0) {
+            return;
+        }
+        auto* pred = pool->add(vectorized::new_column_lt_predicate(get_type_info(OLAP_FIELD_TYPE_INT), 0,
+                                                                   std::to_string(rows_per_segment)));
+        pred->set_index_filter_only(true);
+        preds->push_back(pred);
+    };
+
+    auto res = rowset->new_iterator(schema, rs_opts);
+    ASSERT_TRUE(res.ok()) << res.status().to_string();
+    auto iter = std::move(res).value();
+    auto chunk = vectorized::ChunkHelper::new_chunk(schema, config::vector_chunk_size);
+    size_t count = 0;
+    while (true) {
+        auto st = iter->get_next(chunk.get());
+        if (st.is_end_of_file()) {
+            break;
+        }
+        ASSERT_TRUE(st.ok()) << st.to_string();
+        count += chunk->num_rows();
+        chunk->reset();
+    }
+    EXPECT_EQ(num_segments, num_calls);
+    // the second segment is pruned by zone map, the rows of the first segment are not filtered.
+    EXPECT_EQ(rows_per_segment, count);
+    EXPECT_EQ(rows_per_segment, stats.rows_stats_filtered);
+}
+
+TEST_F(BetaRowsetTest, LazyPredicateColumnsTest) {
+    TabletSchema tablet_schema;
+    create_tablet_schema(&tablet_schema);
+    RowsetSharedPtr rowset;
+    const uint32_t rows_per_segment = 4096;
+    {
+        RowsetWriterContext writer_context(kDataFormatV2, kDataFormatV2);
+        create_rowset_writer_context(&tablet_schema, &writer_context);
+
+        std::unique_ptr<RowsetWriter> rowset_writer;
+        ASSERT_TRUE(RowsetFactory::create_rowset_writer(writer_context, &rowset_writer).ok());
+
+        auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema);
+        auto chunk = vectorized::ChunkHelper::new_chunk(schema, rows_per_segment);
+        auto& cols = chunk->columns();
+        for (auto i = 0; i < rows_per_segment; i++) {
+            auto value = static_cast<int32_t>(i);
+            cols[0]->append_datum(vectorized::Datum(value));
+            cols[1]->append_datum(vectorized::Datum(value));
+            cols[2]->append_datum(vectorized::Datum(value));
+        }
+        rowset_writer->add_chunk(*chunk.get());
+        EXPECT_EQ(OLAP_SUCCESS, rowset_writer->flush());
+
+        rowset = rowset_writer->build();
+        ASSERT_TRUE(rowset != nullptr);
+    }
+
+    auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema);
+    OlapReaderStatistics stats;
+    vectorized::RowsetReadOptions rs_opts;
+    rs_opts.sorted = false;
+    rs_opts.stats = &stats;
+
+    // select k1, k2, v1 where k1 < 40 and k2 != 7, k2 is read by rowid for the rows of k1 < 40.
+    std::unique_ptr<vectorized::ColumnPredicate> p0(
+            vectorized::new_column_lt_predicate(get_type_info(OLAP_FIELD_TYPE_INT), 0, "40"));
+    std::unique_ptr<vectorized::ColumnPredicate> p1(
+            vectorized::new_column_ne_predicate(get_type_info(OLAP_FIELD_TYPE_INT), 1, "7"));
+    rs_opts.predicates[p0->column_id()].emplace_back(p0.get());
+    rs_opts.predicates[p1->column_id()].emplace_back(p1.get());
+
+    auto res = rowset->new_iterator(schema, rs_opts);
+    ASSERT_TRUE(res.ok()) << res.status().to_string();
+    auto iter = std::move(res).value();
+    auto chunk = vectorized::ChunkHelper::new_chunk(schema, config::vector_chunk_size);
+    std::vector<int32_t> values;
+    while (true) {
+        auto st = iter->get_next(chunk.get());
+        if (st.is_end_of_file()) {
+            break;
+        }
+        ASSERT_TRUE(st.ok()) << st.to_string();
+        for (size_t i = 0; i < chunk->num_rows(); i++) {
+            auto row = chunk->get(i);
+            ASSERT_EQ(row[0].get_int32(), row[1].get_int32());
+            ASSERT_EQ(row[0].get_int32(), row[2].get_int32());
+            values.push_back(row[0].get_int32());
+        }
+        chunk->reset();
+    }
+    std::vector<int32_t> expected;
+    for (int32_t i = 0; i < 40; i++) {
+        if (i != 7) {
+            expected.push_back(i);
+        }
+    }
+    ASSERT_EQ(expected, values);
+}
+
+TEST_F(BetaRowsetTest, PredicateCacheTest) {
+    TabletSchema tablet_schema;
+    create_tablet_schema(&tablet_schema);
+    RowsetSharedPtr rowset;
+    const uint32_t rows_per_segment = 4096;
+    {
+        RowsetWriterContext writer_context(kDataFormatV2, kDataFormatV2);
+        create_rowset_writer_context(&tablet_schema, &writer_context);
+
+        std::unique_ptr<RowsetWriter> rowset_writer;
+        ASSERT_TRUE(RowsetFactory::create_rowset_writer(writer_context, &rowset_writer).ok());
+
+        auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema);
+        auto chunk = vectorized::ChunkHelper::new_chunk(schema, rows_per_segment);
+        auto& cols = chunk->columns();
+        for (auto i = 0; i < rows_per_segment; i++) {
+            auto value = static_cast<int32_t>(i);
+            cols[0]->append_datum(vectorized::Datum(value));
+            cols[1]->append_datum(vectorized::Datum(value));
+            cols[2]->append_datum(vectorized::Datum(value));
+        }
+        rowset_writer->add_chunk(*chunk.get());
+        EXPECT_EQ(OLAP_SUCCESS, rowset_writer->flush());
+
+        rowset = rowset_writer->build();
+        ASSERT_TRUE(rowset != nullptr);
+    }
+
+    const int64_t old_capacity = config::segment_predicate_cache_capacity;
+    config::segment_predicate_cache_capacity = 64 * 1024 * 1024;
+    DeferOp config_restorer([&] { config::segment_predicate_cache_capacity = old_capacity; });
+
+    auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema);
+    // select k1, k2, v1 where k1 < 40 and k2 != 7.
+    std::unique_ptr<vectorized::ColumnPredicate> p0(
+            vectorized::new_column_lt_predicate(get_type_info(OLAP_FIELD_TYPE_INT), 0, "40"));
+    std::unique_ptr<vectorized::ColumnPredicate> p1(
+            vectorized::new_column_ne_predicate(get_type_info(OLAP_FIELD_TYPE_INT), 1, "7"));
+    auto scan = [&](OlapReaderStatistics* stats, std::vector<int32_t>* values) {
+        vectorized::RowsetReadOptions rs_opts;
+        rs_opts.sorted = false;
+        rs_opts.stats = stats;
+        rs_opts.predicates[p0->column_id()].emplace_back(p0.get());
+        rs_opts.predicates[p1->column_id()].emplace_back(p1.get());
+
+        auto res = rowset->new_iterator(schema, rs_opts);
+        ASSERT_TRUE(res.ok()) << res.status().to_string();
+        auto iter = std::move(res).value();
+        auto chunk = vectorized::ChunkHelper::new_chunk(schema, config::vector_chunk_size);
+        while (true) {
+            auto st = iter->get_next(chunk.get());
+            if (st.is_end_of_file()) {
+                break;
+            }
+            ASSERT_TRUE(st.ok()) << st.to_string();
+            for (size_t i = 0; i < chunk->num_rows(); i++) {
+                values->push_back(chunk->get(i)[2].get_int32());
+            }
+            chunk->reset();
+        }
+    };
+
+    std::vector<int32_t> expected;
+    for (int32_t i = 0; i < 40; i++) {
+        if (i != 7) {
+            expected.push_back(i);
+        }
+    }
+
+    // the first scan evaluates the predicates and caches the rows selected.
+    OlapReaderStatistics stats1;
+    std::vector<int32_t> values1;
+    scan(&stats1, &values1);
+    ASSERT_EQ(expected, values1);
+    EXPECT_EQ(0, stats1.rows_pred_cache_filtered);
+
+    // the second scan reads only the cached rows without evaluating the predicates.
+    OlapReaderStatistics stats2;
+    std::vector<int32_t> values2;
+    scan(&stats2, &values2);
+    ASSERT_EQ(expected, values2);
+    EXPECT_EQ(rows_per_segment - expected.size(), stats2.rows_pred_cache_filtered);
+    EXPECT_EQ(0, stats2.rows_vec_cond_filtered);
+    EXPECT_EQ(expected.size(), stats2.raw_rows_read);
+}
+
+TEST_F(BetaRowsetTest, DeleteBitmapCacheTest) {
+    TabletSchema tablet_schema;
+    create_tablet_schema(&tablet_schema);
+    RowsetSharedPtr rowset;
+    const uint32_t rows_per_segment = 4096;
+    {
+        RowsetWriterContext writer_context(kDataFormatV2, kDataFormatV2);
+        create_rowset_writer_context(&tablet_schema, &writer_context);
+
+        std::unique_ptr<RowsetWriter> rowset_writer;
+        ASSERT_TRUE(RowsetFactory::create_rowset_writer(writer_context, &rowset_writer).ok());
+
+        auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema);
+        auto chunk = vectorized::ChunkHelper::new_chunk(schema, rows_per_segment);
+        auto& cols = chunk->columns();
+        for (auto i = 0; i < rows_per_segment; i++) {
+            auto value = static_cast<int32_t>(i);
+            cols[0]->append_datum(vectorized::Datum(value));
+            cols[1]->append_datum(vectorized::Datum(value));
+            cols[2]->append_datum(vectorized::Datum(value));
+        }
+        rowset_writer->add_chunk(*chunk.get());
+        EXPECT_EQ(OLAP_SUCCESS, rowset_writer->flush());
+
+        rowset = rowset_writer->build();
+        ASSERT_TRUE(rowset != nullptr);
+    }
+
+    const int64_t old_capacity = config::segment_delete_bitmap_cache_capacity;
+    config::segment_delete_bitmap_cache_capacity = 64 * 1024 * 1024;
+    DeferOp config_restorer([&] { config::segment_delete_bitmap_cache_capacity = old_capacity; });
+
+    // DELETE WHERE k1 < 100, and then DELETE WHERE k2 >= 4000 AND v1 != 4001.
+    std::unique_ptr<vectorized::ColumnPredicate> p0(
+            vectorized::new_column_lt_predicate(get_type_info(OLAP_FIELD_TYPE_INT), 0, "100"));
+    std::unique_ptr<vectorized::ColumnPredicate> p1(
+            vectorized::new_column_ge_predicate(get_type_info(OLAP_FIELD_TYPE_INT), 1, "4000"));
+    std::unique_ptr<vectorized::ColumnPredicate> p2(
+            vectorized::new_column_ne_predicate(get_type_info(OLAP_FIELD_TYPE_INT), 2, "4001"));
+    vectorized::DeletePredicates delete_predicates;
+    delete_predicates.add(1, vectorized::ConjunctivePredicates{p0.get()});
+    delete_predicates.add(2, vectorized::ConjunctivePredicates{p1.get(), p2.get()});
+
+    auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema);
+    auto scan = [&](OlapReaderStatistics* stats, std::vector<int32_t>* values) {
+        vectorized::RowsetReadOptions rs_opts;
+        rs_opts.sorted = false;
+        rs_opts.stats = stats;
+        rs_opts.delete_predicates = &delete_predicates;
+        rs_opts.tablet_schema = &tablet_schema;
+
+        auto res = rowset->new_iterator(schema, rs_opts);
+        ASSERT_TRUE(res.ok()) << res.status().to_string();
+        auto iter = std::move(res).value();
+        auto chunk = vectorized::ChunkHelper::new_chunk(schema, config::vector_chunk_size);
+        while (true) {
+            auto st = iter->get_next(chunk.get());
+            if (st.is_end_of_file()) {
+                break;
+            }
+            ASSERT_TRUE(st.ok()) << st.to_string();
+            for (size_t i = 0; i < chunk->num_rows(); i++) {
+                values->push_back(chunk->get(i)[2].get_int32());
+            }
+            chunk->reset();
+        }
+    };
+
+    std::vector<int32_t> expected;
+    for (int32_t i = 100; i < rows_per_segment; i++) {
+        if (i < 4000 || i == 4001) {
+            expected.push_back(i);
+        }
+    }
+
+    // the first scan evaluates the delete predicates on the segment and caches the rows deleted, and the second
+    // scan reuses them. Both skip reading the rows deleted.
+    for (int i = 0; i < 2; i++) {
+        OlapReaderStatistics stats;
+        std::vector<int32_t> values;
+        scan(&stats, &values);
+        ASSERT_EQ(expected, values);
+        EXPECT_EQ(rows_per_segment - expected.size(), stats.rows_del_filtered);
+        EXPECT_EQ(expected.size(), stats.raw_rows_read);
+    }
+}
+
+TEST_F(BetaRowsetTest, ParallelFlushChunkTest) {
+    TabletSchema tablet_schema;
+    create_tablet_schema(&tablet_schema);
+    RowsetSharedPtr rowset;
+    const uint32_t num_rows = 4096;
+    const int32_t old_max_parallel_segments = config::memtable_flush_max_parallel_segments;
+    const int64_t old_min_rows_per_segment = config::memtable_flush_min_rows_per_segment;
+    config::memtable_flush_max_parallel_segments = 4;
+    config::memtable_flush_min_rows_per_segment = 1000;
+    DeferOp config_restorer([&] {
+        config::memtable_flush_max_parallel_segments = old_max_parallel_segments;
+        config::memtable_flush_min_rows_per_segment = old_min_rows_per_segment;
+    });
+    {
+        RowsetWriterContext writer_context(kDataFormatV2, kDataFormatV2);
+        create_rowset_writer_context(&tablet_schema, &writer_context);
+
+        std::unique_ptr<RowsetWriter> rowset_writer;
+        ASSERT_TRUE(RowsetFactory::create_rowset_writer(writer_context, &rowset_writer).ok());
+
+        auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema);
+        auto chunk = vectorized::ChunkHelper::new_chunk(schema, num_rows);
+        auto& cols = chunk->columns();
+        for (auto i = 0; i < num_rows; i++) {
+            auto value = static_cast<int32_t>(i);
+            cols[0]->append_datum(vectorized::Datum(value));
+            cols[1]->append_datum(vectorized::Datum(value));
+            cols[2]->append_datum(vectorized::Datum(value));
+        }
+        // 4096 rows are cut into 4 segments of 1024 rows.
+        EXPECT_EQ(OLAP_SUCCESS, rowset_writer->flush_chunk(*chunk));
+
+        rowset = rowset_writer->build();
+        ASSERT_TRUE(rowset != nullptr);
+        ASSERT_EQ(4, rowset->rowset_meta()->num_segments());
+        ASSERT_EQ(num_rows, rowset->rowset_meta()->num_rows());
+    }
+
+    auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema);
+    OlapReaderStatistics stats;
+    vectorized::RowsetReadOptions rs_opts;
+    rs_opts.sorted = false;
+    rs_opts.stats = &stats;
+
+    auto res = rowset->new_iterator(schema, rs_opts);
+    ASSERT_TRUE(res.ok()) << res.status().to_string();
+    auto iter = std::move(res).value();
+    auto chunk = vectorized::ChunkHelper::new_chunk(schema, config::vector_chunk_size);
+    int32_t expected = 0;
+    while (true) {
+        auto st = iter->get_next(chunk.get());
+        if (st.is_end_of_file()) {
+            break;
+        }
+        ASSERT_TRUE(st.ok()) << st.to_string();
+        // the segments are read in the order of their ids, which keeps the rows of the memtable in order.
+        for (size_t i = 0; i < chunk->num_rows(); i++) {
+            ASSERT_EQ(expected++, chunk->get(i)[0].get_int32());
+        }
+        chunk->reset();
+    }
+    ASSERT_EQ(num_rows, expected);
+}
+
+
+TEST_F(BetaRowsetTest, ColdColumnTest) {
+    // (k1 int, v1 varchar(20)) duplicated key (k1), v1 is written to the cold file.
+    TabletSchemaPB tablet_schema_pb;
+    tablet_schema_pb.set_keys_type(DUP_KEYS);
+    tablet_schema_pb.set_num_short_key_columns(1);
+    tablet_schema_pb.set_num_rows_per_row_block(1024);
+    tablet_schema_pb.set_next_column_unique_id(3);
+    ColumnPB* column_1 = tablet_schema_pb.add_column();
+    column_1->set_unique_id(1);
+    column_1->set_name("k1");
+    column_1->set_type("INT");
+    column_1->set_is_key(true);
+    column_1->set_length(4);
+    column_1->set_index_length(4);
+    column_1->set_is_nullable(false);
+    ColumnPB* column_2 = tablet_schema_pb.add_column();
+    column_2->set_unique_id(2);
+    column_2->set_name("v1");
+    column_2->set_type("VARCHAR");
+    column_2->set_length(20);
+    column_2->set_is_key(false);
+    column_2->set_is_nullable(false);
+    column_2->set_aggregation("NONE");
+    TabletSchema tablet_schema;
+    tablet_schema.init_from_pb(tablet_schema_pb);
+
+    const std::string old_cold_column_storage_path = config::cold_column_storage_path;
+    config::cold_column_storage_path = config::storage_root_path + "/cold";
+    DeferOp config_restorer([&] { config::cold_column_storage_path = old_cold_column_storage_path; });
+    ASSERT_TRUE(FileUtils::create_dir(config::cold_column_storage_path).ok());
+
+    const uint32_t num_rows = 4096;
+    // the segment files of a tablet are in <data_dir>/data/<shard>/<tablet_id>/<schema_hash>.
+    const std::string rowset_path = config::storage_root_path + "/data/0/12345/1111";
+    ASSERT_TRUE(FileUtils::create_dir(rowset_path).ok());
+    RowsetSharedPtr rowset;
+    std::string segment_file;
+    {
+        RowsetWriterContext writer_context(kDataFormatV2, kDataFormatV2);
+        create_rowset_writer_context(&tablet_schema, &writer_context);
+        writer_context.rowset_path_prefix = rowset_path;
+        writer_context.write_cold_columns = true;
+        segment_file = BetaRowset::segment_file_path(writer_context.rowset_path_prefix, writer_context.rowset_id, 0);
+
+        std::unique_ptr<RowsetWriter> rowset_writer;
+        ASSERT_TRUE(RowsetFactory::create_rowset_writer(writer_context, &rowset_writer).ok());
+
+        auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema);
+        auto chunk = vectorized::ChunkHelper::new_chunk(schema, num_rows);
+        auto& cols = chunk->columns();
+        std::vector<std::string> values(num_rows);
+        for (auto i = 0; i < num_rows; i++) {
+            values[i] = "value_" + std::to_string(i);
+            cols[0]->append_datum(vectorized::Datum(static_cast<int32_t>(i)));
+            cols[1]->append_datum(vectorized::Datum(Slice(values[i])));
+        }
+        rowset_writer->add_chunk(*chunk);
+        EXPECT_EQ(OLAP_SUCCESS, rowset_writer->flush());
+
+        rowset = rowset_writer->build();
+        ASSERT_TRUE(rowset != nullptr);
+    }
+    const std::string rowset_id = rowset->rowset_id().to_string();
+    const std::string cold_file = segment_v2::Segment::cold_file_path(segment_file);
+    ASSERT_EQ(config::cold_column_storage_path + "/12345/1111/" + rowset_id + "_0.cold", cold_file);
+    ASSERT_TRUE(FileUtils::check_exist(cold_file));
+    ASSERT_FALSE(FileUtils::check_exist(segment_v2::Segment::local_cold_file_path(segment_file)));
+
+    auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema);
+    auto check_rowset = [&](const RowsetSharedPtr& rs) {
+        OlapReaderStatistics stats;
+        vectorized::RowsetReadOptions rs_opts;
+        rs_opts.sorted = false;
+        rs_opts.stats = &stats;
+        auto res = rs->new_iterator(schema, rs_opts);
+        ASSERT_TRUE(res.ok()) << res.status().to_string();
+        auto iter = std::move(res).value();
+        auto chunk = vectorized::ChunkHelper::new_chunk(schema, config::vector_chunk_size);
+        int32_t count = 0;
+        while (true) {
+            auto st = iter->get_next(chunk.get());
+            if (st.is_end_of_file()) {
+                break;
+            }
+            ASSERT_TRUE(st.ok()) << st.to_string();
+            for (size_t i = 0; i < chunk->num_rows(); i++) {
+                auto row = chunk->get(i);
+                ASSERT_EQ(count, row[0].get_int32());
+                ASSERT_EQ("value_" + std::to_string(count), row[1].get_slice().to_string());
+                count++;
+            }
+            chunk->reset();
+        }
+        ASSERT_EQ(num_rows, count);
+    };
+    check_rowset(rowset);
+
+    // a snapshot has the same tablet id, schema hash and rowset id, so the cold file is copied into it.
+    const std::string snapshot_path = config::storage_root_path + "/snapshot/20261015000000.0/12345/1111";
+    ASSERT_TRUE(FileUtils::create_dir(snapshot_path).ok());
+    ASSERT_TRUE(rowset->link_files_to(snapshot_path, rowset->rowset_id()).ok());
+    const std::string snapshot_cold_file = snapshot_path + "/" + rowset_id + "_0.cold";
+    ASSERT_TRUE(FileUtils::check_exist(snapshot_cold_file));
+    RowsetSharedPtr snapshot_rowset;
+    ASSERT_TRUE(RowsetFactory::create_rowset(_tablet_meta_mem_tracker.get(), &tablet_schema, snapshot_path,
+                                             rowset->rowset_meta(), &snapshot_rowset)
+                        .ok());
+
+    // a rowset linked into another tablet, e.g. by a schema change, links the cold file there.
+    RowsetId new_rowset_id;
+    new_rowset_id.init(10001);
+    const std::string new_rowset_path = config::storage_root_path + "/data/0/12346/1111";
+    ASSERT_TRUE(FileUtils::create_dir(new_rowset_path).ok());
+    ASSERT_TRUE(rowset->link_files_to(new_rowset_path, new_rowset_id).ok());
+    const std::string new_cold_file =
+            config::cold_column_storage_path + "/12346/1111/" + new_rowset_id.to_string() + "_0.cold";
+    ASSERT_TRUE(FileUtils::check_exist(new_cold_file));
+
+    ASSERT_EQ(OLAP_SUCCESS, rowset->remove());
+    ASSERT_FALSE(FileUtils::check_exist(cold_file));
+    ASSERT_TRUE(FileUtils::check_exist(new_cold_file));
+
+    {
+        // the snapshot is read by its own cold file, even without the cold column storage.
+        config::cold_column_storage_path = "";
+        check_rowset(snapshot_rowset);
+
+        // the cold file of a snapshot is linked next to the segment files, e.g. when a clone converts the rowset ids.
+        const std::string clone_path = config::storage_root_path + "/data/0/12347/1111";
+        ASSERT_TRUE(FileUtils::create_dir(clone_path).ok());
+        ASSERT_TRUE(snapshot_rowset->link_files_to(clone_path, new_rowset_id).ok());
+        ASSERT_TRUE(FileUtils::check_exist(clone_path + "/" + new_rowset_id.to_string() + "_0.cold"));
+
+        ASSERT_EQ(OLAP_SUCCESS, snapshot_rowset->remove());
+        ASSERT_FALSE(FileUtils::check_exist(snapshot_cold_file));
+    }
+}
+
+TEST_F(BetaRowsetTest, SweepOrphanColdFileTest) {
+    const std::string old_cold_column_storage_path = config::cold_column_storage_path;
+    config::cold_column_storage_path = config::storage_root_path + "/cold";
+    DeferOp config_restorer([&] { config::cold_column_storage_path = old_cold_column_storage_path; });
+
+    // the tablet 12345 doesn't exist.
+    const std::string cold_dir = config::cold_column_storage_path + "/12345/1111";
+    ASSERT_TRUE(FileUtils::create_dir(cold_dir).ok());
+    RowsetId rowset_id;
+    rowset_id.init(10000);
+    const std::string cold_file = cold_dir + "/" + rowset_id.to_string() + "_0.cold";
+    std::unique_ptr<WritableFile> file;
+    ASSERT_TRUE(Env::Default()->new_writable_file(cold_file, &file).ok());
+    ASSERT_TRUE(file->close().ok());
+
+    // too new to be removed.
+    k_engine->_sweep_orphan_cold_files(time(nullptr), 3600);
+    ASSERT_TRUE(FileUtils::check_exist(cold_file));
+
+    k_engine->_sweep_orphan_cold_files(time(nullptr), 0);
+    ASSERT_FALSE(FileUtils::check_exist(cold_file));
+    ASSERT_FALSE(FileUtils::check_exist(config::cold_column_storage_path + "/12345"));
+}
+
+TEST_F(BetaRowsetTest, SegmentPackTest) {
+    TabletSchema tablet_schema;
+    create_tablet_schema(&tablet_schema);
+    const int64_t old_segment_pack_max_bytes = config::segment_pack_max_bytes;
+    config::segment_pack_max_bytes = 1024 * 1024;
+    DeferOp config_restorer([&] { config::segment_pack_max_bytes = old_segment_pack_max_bytes; });
+
+    const uint32_t num_rows_per_flush = 100;
+    const uint32_t num_flushes = 3;
+    RowsetSharedPtr rowset;
+    std::string rowset_path;
+    {
+        RowsetWriterContext writer_context(kDataFormatV2, kDataFormatV2);
+        create_rowset_writer_context(&tablet_schema, &writer_context);
+        rowset_path = writer_context.rowset_path_prefix;
+
+        std::unique_ptr<RowsetWriter> rowset_writer;
+        ASSERT_TRUE(RowsetFactory::create_rowset_writer(writer_context, &rowset_writer).ok());
+
+        auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema);
+        for (uint32_t flush = 0; flush < num_flushes; flush++) {
+            auto chunk = vectorized::ChunkHelper::new_chunk(schema, num_rows_per_flush);
+            auto& cols = chunk->columns();
+            for (uint32_t i = 0; i < num_rows_per_flush; i++) {
+                auto value = static_cast<int32_t>(flush * num_rows_per_flush + i);
+                cols[0]->append_datum(vectorized::Datum(value));
+                cols[1]->append_datum(vectorized::Datum(value));
+                cols[2]->append_datum(vectorized::Datum(value));
+            }
+            EXPECT_EQ(OLAP_SUCCESS, rowset_writer->flush_chunk(*chunk));
+        }
+
+        rowset = rowset_writer->build();
+        ASSERT_TRUE(rowset != nullptr);
+        ASSERT_EQ(num_flushes, rowset->rowset_meta()->num_segments());
+        ASSERT_TRUE(rowset->rowset_meta()->has_segment_pack());
+    }
+    // all the segments are in the pack file.
+    const std::string pack_file = BetaRowset::segment_pack_file_path(rowset_path, rowset->rowset_id());
+    ASSERT_TRUE(FileUtils::check_exist(pack_file));
+    for (uint32_t i = 0; i < num_flushes; i++) {
+        ASSERT_FALSE(FileUtils::check_exist(BetaRowset::segment_file_path(rowset_path, rowset->rowset_id(), i)));
+    }
+
+    auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema);
+    OlapReaderStatistics stats;
+    vectorized::RowsetReadOptions rs_opts;
+    rs_opts.sorted = false;
+    rs_opts.stats = &stats;
+    {
+        auto res = rowset->new_iterator(schema, rs_opts);
+        ASSERT_TRUE(res.ok()) << res.status().to_string();
+        auto iter = std::move(res).value();
+        auto chunk = vectorized::ChunkHelper::new_chunk(schema, config::vector_chunk_size);
+        int32_t expected = 0;
+        while (true) {
+            auto st = iter->get_next(chunk.get());
+            if (st.is_end_of_file()) {
+                break;
+            }
+            ASSERT_TRUE(st.ok()) << st.to_string();
+            for (size_t i = 0; i < chunk->num_rows(); i++) {
+                auto row = chunk->get(i);
+                ASSERT_EQ(expected, row[0].get_int32());
+                ASSERT_EQ(expected, row[2].get_int32());
+                expected++;
+            }
+            chunk->reset();
+        }
+        ASSERT_EQ(num_rows_per_flush * num_flushes, expected);
+    }
+
+    ASSERT_EQ(OLAP_SUCCESS, rowset->remove());
+    ASSERT_FALSE(FileUtils::check_exist(pack_file));
+}
+
+TEST_F(BetaRowsetTest, AddSegmentFileTest) {
+    TabletSchema tablet_schema;
+    create_tablet_schema(&tablet_schema);
+
+    const uint32_t num_rows = 100;
+    RowsetSharedPtr src_rowset;
+    std::string rowset_path;
+    {
+        RowsetWriterContext writer_context(kDataFormatV2, kDataFormatV2);
+        create_rowset_writer_context(&tablet_schema, &writer_context);
+        rowset_path = writer_context.rowset_path_prefix;
+
+        std::unique_ptr<RowsetWriter> rowset_writer;
+        ASSERT_TRUE(RowsetFactory::create_rowset_writer(writer_context, &rowset_writer).ok());
+
+        auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema);
+        auto chunk = vectorized::ChunkHelper::new_chunk(schema, num_rows);
+        auto& cols = chunk->columns();
+        for (uint32_t i = 0; i < num_rows; i++) {
+            auto value = static_cast<int32_t>(i);
+            cols[0]->append_datum(vectorized::Datum(value));
+            cols[1]->append_datum(vectorized::Datum(value));
+            cols[2]->append_datum(vectorized::Datum(value));
+        }
+        ASSERT_EQ(OLAP_SUCCESS, rowset_writer->flush_chunk(*chunk));
+        src_rowset = rowset_writer->build();
+        ASSERT_TRUE(src_rowset != nullptr);
+    }
+    const std::string segment_file = BetaRowset::segment_file_path(rowset_path, src_rowset->rowset_id(), 0);
+    const std::string bad_file = rowset_path + "/bad_segment.dat";
+    {
+        std::unique_ptr<WritableFile> file;
+        ASSERT_TRUE(Env::Default()->new_writable_file(bad_file, &file).ok());
+        ASSERT_TRUE(file->append("not a segment file").ok());
+        ASSERT_TRUE(file->close().ok());
+    }
+
+    RowsetSharedPtr rowset;
+    {
+        RowsetWriterContext writer_context(kDataFormatV2, kDataFormatV2);
+        create_rowset_writer_context(&tablet_schema, &writer_context);
+        writer_context.rowset_id.init(10001);
+
+        std::unique_ptr<RowsetWriter> rowset_writer;
+        ASSERT_TRUE(RowsetFactory::create_rowset_writer(writer_context, &rowset_writer).ok());
+        ASSERT_FALSE(rowset_writer->add_segment_file(bad_file).ok());
+        ASSERT_FALSE(FileUtils::check_exist(BetaRowset::segment_file_path(rowset_path, writer_context.rowset_id, 0)));
+        ASSERT_TRUE(rowset_writer->add_segment_file(segment_file).ok());
+        ASSERT_TRUE(rowset_writer->add_segment_file(segment_file).ok());
+        rowset = rowset_writer->build();
+        ASSERT_TRUE(rowset != nullptr);
+        ASSERT_EQ(2, rowset->rowset_meta()->num_segments());
+        ASSERT_EQ(2 * num_rows, rowset->num_rows());
+    }
+
+    auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet_schema);
+    OlapReaderStatistics stats;
+    vectorized::RowsetReadOptions rs_opts;
+    rs_opts.sorted = false;
+    rs_opts.stats = &stats;
+    {
+        auto res = rowset->new_iterator(schema, rs_opts);
+        ASSERT_TRUE(res.ok()) << res.status().to_string();
+        auto iter = std::move(res).value();
+        auto chunk = vectorized::ChunkHelper::new_chunk(schema, config::vector_chunk_size);
+        uint32_t count = 0;
+        while (true) {
+            auto st = iter->get_next(chunk.get());
+            if (st.is_end_of_file()) {
+                break;
+            }
+            ASSERT_TRUE(st.ok()) << st.to_string();
+            for (size_t i = 0; i < chunk->num_rows(); i++) {
+                ASSERT_EQ(static_cast<int32_t>(count % num_rows), chunk->get(i)[0].get_int32());
+                count++;
+            }
+            chunk->reset();
+        }
+        ASSERT_EQ(2 * num_rows, count);
+    }
+
+    ASSERT_EQ(OLAP_SUCCESS, rowset->remove());
+    ASSERT_EQ(OLAP_SUCCESS, src_rowset->remove());
+    ASSERT_TRUE(Env::Default()->delete_file(bad_file).ok());
+}
+
 } // namespace starrocks
@@ -25,6 +25,7 @@
 
 #include <memory>
 
+#include "column/fixed_length_column.h"
 #include "runtime/mem_pool.h"
 #include "runtime/mem_tracker.h"
 #include "storage/rowset/segment_v2/options.h"
@@ -357,4 +358,44 @@ TEST_F(BitShufflePageTest, TestReserveHead) {
                                      segment_v2::BitShufflePageDecoder<OLAP_FIELD_TYPE_INT>, 4>(ints.get(), size);
 }
 
+// NOLINTNEXTLINE
+TEST_F(BitShufflePageTest, TestDecodeToColumn) {
+    const uint32_t size = 1001;
+    std::vector<int32_t> ints(size);
+    for (int i = 0; i < size; i++) {
+        ints[i] = random();
+    }
+    PageBuilderOptions options;
+    options.data_page_size = 256 * 1024;
+    segment_v2::BitshufflePageBuilder<OLAP_FIELD_TYPE_INT> page_builder(options);
+    ASSERT_EQ(size, page_builder.add(reinterpret_cast<const uint8_t*>(ints.data()), size));
+    OwnedSlice s = page_builder.finish()->build();
+
+    segment_v2::PageDecoderOptions decoder_options;
+    segment_v2::BitShufflePageDecoder<OLAP_FIELD_TYPE_INT> page_decoder(s.slice(), decoder_options);
+    ASSERT_TRUE(page_decoder.init().ok());
+
+    // the whole page is decoded into the column directly, after the existing values.
+    auto column = vectorized::Int32Column::create();
+    column->append(-1);
+    size_t count = size + 10;
+    ASSERT_TRUE(page_decoder.next_batch(&count, column.get()).ok());
+    ASSERT_EQ(size, count);
+    ASSERT_EQ(size + 1, column->size());
+    ASSERT_EQ(-1, column->get_data()[0]);
+    for (int i = 0; i < size; i++) {
+        ASSERT_EQ(ints[i], column->get_data()[i + 1]);
+    }
+
+    // read part of the page after seek.
+    ASSERT_TRUE(page_decoder.seek_to_position_in_page(100).ok());
+    column->reset_column();
+    count = 200;
+    ASSERT_TRUE(page_decoder.next_batch(&count, column.get()).ok());
+    ASSERT_EQ(200, count);
+    for (int i = 0; i < count; i++) {
+        ASSERT_EQ(ints[i + 100], column->get_data()[i]);
+    }
+}
+
 } // namespace starrocks
@@ -22,6 +22,7 @@
 #include <gtest/gtest.h>
 
 #include <memory>
+#include <vector>
 
 #include "storage/rowset/segment_v2/bloom_filter.h"
 
@@ -178,5 +179,30 @@ TEST_F(BlockBloomFilterTest, slice) {
     ASSERT_FALSE(bf->test_bytes(s.data, s.size));
 }
 
+// Test for testing many hashes at once
+TEST_F(BlockBloomFilterTest, TestAnyHash) {
+    std::unique_ptr<BloomFilter> bf;
+    ASSERT_TRUE(BloomFilter::create(BLOCK_BLOOM_FILTER, &bf).ok());
+    ASSERT_TRUE(bf->init(_expected_num, _fpp, HASH_MURMUR3_X64_64).ok());
+    std::vector<uint64_t> added;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        uint32_t v = i * 2;
+        bf->add_bytes((char*)&v, sizeof(v));
+        added.push_back(bf->hash((char*)&v, sizeof(v)));
+    }
+    // agree with testing the hashes one by one.
+    int num_false_positives = 0;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        uint32_t v = i * 2 + 1;
+        uint64_t hash = bf->hash((char*)&v, sizeof(v));
+        ASSERT_EQ(bf->test_hash(hash), bf->test_any_hash(&hash, 1));
+        num_false_positives += bf->test_any_hash(&hash, 1);
+        std::vector<uint64_t> hashes{hash, added[i]};
+        ASSERT_TRUE(bf->test_any_hash(hashes.data(), hashes.size()));
+    }
+    ASSERT_LT(num_false_positives, 100);
+    ASSERT_FALSE(bf->test_any_hash(nullptr, 0));
+}
+
 } // namespace segment_v2
 } // namespace starrocks
@@ -287,5 +287,54 @@ TEST_F(BloomFilterIndexReaderWriterTest, test_decimal) {
     delete[] val;
 }
 
+TEST_F(BloomFilterIndexReaderWriterTest, test_ngram) {
+    // two pages: the log messages with "error" and the others.
+    std::vector<std::string> page0{"connect error: timeout", "disk error", "ok"};
+    std::vector<std::string> page1{"request finished", "write 10 rows", "x"};
+    std::string fname = kTestDir + "/bloom_filter_ngram";
+    ColumnIndexMetaPB meta;
+    {
+        std::unique_ptr<fs::WritableBlock> wblock;
+        fs::CreateBlockOptions opts({fname});
+        ASSERT_TRUE(_block_mgr->create_block(opts, &wblock).ok());
+
+        std::unique_ptr<BloomFilterIndexWriter> writer;
+        TypeInfoPtr type_info = get_type_info(OLAP_FIELD_TYPE_VARCHAR);
+        ASSERT_TRUE(BloomFilterIndexWriter::create_ngram(BloomFilterOptions(), type_info, 3, &writer).ok());
+        for (const auto* page : {&page0, &page1}) {
+            std::vector<Slice> values(page->begin(), page->end());
+            writer->add_values(values.data(), values.size());
+            writer->add_nulls(1);
+            ASSERT_TRUE(writer->flush().ok());
+        }
+        ASSERT_TRUE(writer->finish(wblock.get(), &meta).ok());
+        ASSERT_TRUE(wblock->close().ok());
+    }
+    ASSERT_EQ(NGRAM_BLOOM_FILTER_INDEX, meta.type());
+    ASSERT_EQ(3, meta.ngram_bloom_filter_index().gram_size());
+
+    BloomFilterIndexReader reader;
+    ASSERT_TRUE(reader.load(_block_mgr, fname, &meta.ngram_bloom_filter_index(), true, false).ok());
+    std::unique_ptr<BloomFilterIndexIterator> iter;
+    ASSERT_TRUE(reader.new_iterator(&iter).ok());
+
+    std::unique_ptr<BloomFilter> bf;
+    ASSERT_TRUE(iter->read_bloom_filter(0, &bf).ok());
+    for (const char* gram : {"err", "rro", "ror", "tim", "dis"}) {
+        ASSERT_TRUE(bf->test_bytes(gram, 3)) << gram;
+    }
+    ASSERT_TRUE(iter->read_bloom_filter(1, &bf).ok());
+    for (const char* gram : {"req", "ows", "10 "}) {
+        ASSERT_TRUE(bf->test_bytes(gram, 3)) << gram;
+    }
+    ASSERT_FALSE(bf->test_bytes("err", 3) && bf->test_bytes("rro", 3) && bf->test_bytes("ror", 3));
+
+    // only CHAR and VARCHAR are supported.
+    std::unique_ptr<BloomFilterIndexWriter> writer;
+    ASSERT_FALSE(
+            BloomFilterIndexWriter::create_ngram(BloomFilterOptions(), get_type_info(OLAP_FIELD_TYPE_INT), 3, &writer)
+                    .ok());
+}
+
 } // namespace segment_v2
 } // namespace starrocks
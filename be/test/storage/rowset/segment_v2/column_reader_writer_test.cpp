@@ -64,6 +64,11 @@ protected:
 
     void TearDown() override { _tracker.release(_tracker.consumption()); }
 
+    // the compression of the columns written by test_nullable_data().
+    CompressionTypePB _compression = starrocks::LZ4_FRAME;
+    int _compression_level = 0;
+    size_t _compression_dict_size = 0;
+
     template <FieldType type, EncodingTypePB encoding, uint32_t version, bool adaptive = true>
     void test_nullable_data(const vectorized::Column& src, const std::string null_encoding = "0") {
         config::set_config("null_encoding", null_encoding);
@@ -99,9 +104,11 @@ protected:
                 writer_opts.meta->set_length(0);
             }
             writer_opts.meta->set_encoding(encoding);
-            writer_opts.meta->set_compression(starrocks::LZ4_FRAME);
+            writer_opts.meta->set_compression(_compression);
             writer_opts.meta->set_is_nullable(true);
             writer_opts.need_zone_map = true;
+            writer_opts.compression_level = _compression_level;
+            writer_opts.compression_dict_size = _compression_dict_size;
 
             TabletColumn column(OLAP_FIELD_AGGREGATION_NONE, type);
             if (type == OLAP_FIELD_TYPE_VARCHAR) {
@@ -145,7 +152,9 @@ protected:
             ASSERT_TRUE(st.ok());
             ColumnIteratorOptions iter_opts;
             OlapReaderStatistics stats;
+            ColumnReadStatistics column_stats;
             iter_opts.stats = &stats;
+            iter_opts.column_stats = &column_stats;
             iter_opts.rblock = rblock.get();
             st = iter->init(iter_opts);
             ASSERT_TRUE(st.ok());
@@ -165,6 +174,15 @@ protected:
                             << " row " << i << ": " << datum_to_string(type_info.get(), src.get(i)) << " vs "
                             << datum_to_string(type_info.get(), dst->get(i));
                 }
+
+                // the data pages are counted to the column, but not the index pages.
+                ASSERT_GT(column_stats.pages_read, 0);
+                ASSERT_LE(column_stats.pages_read, stats.total_pages_num);
+                ASSERT_EQ(0, column_stats.cached_pages);
+                ASSERT_GT(column_stats.compressed_bytes_read, 0);
+                ASSERT_LE(column_stats.compressed_bytes_read, stats.compressed_bytes_read);
+                ASSERT_GT(column_stats.uncompressed_bytes_read, 0);
+                ASSERT_EQ(stats.bytes_read, column_stats.bytes_read);
             }
 
             {
@@ -530,6 +548,44 @@ TEST_F(ColumnReaderWriterTest, test_datetime) {
     test_nullable_data<OLAP_FIELD_TYPE_TIMESTAMP, BIT_SHUFFLE, 2>(*col, "1");
 }
 
+// NOLINTNEXTLINE
+TEST_F(ColumnReaderWriterTest, test_delta_encoding) {
+    auto col = numeric_data<OLAP_FIELD_TYPE_BIGINT>(4);
+    test_nullable_data<OLAP_FIELD_TYPE_BIGINT, DELTA_ENCODING, 1>(*col);
+    test_nullable_data<OLAP_FIELD_TYPE_BIGINT, DELTA_ENCODING, 2>(*col);
+    col = numeric_data<OLAP_FIELD_TYPE_INT>(10000);
+    test_nullable_data<OLAP_FIELD_TYPE_INT, DELTA_ENCODING, 2>(*col);
+    col = datetime_values(100);
+    test_nullable_data<OLAP_FIELD_TYPE_TIMESTAMP, DELTA_ENCODING, 2>(*col);
+}
+
+// NOLINTNEXTLINE
+TEST_F(ColumnReaderWriterTest, test_adaptive_page_encoding) {
+    config::set_config("enable_adaptive_page_encoding", "true");
+    config::set_config("adaptive_page_encoding_sample_interval", "1");
+
+    // sequences are encoded by FOR
+    auto col = numeric_data<OLAP_FIELD_TYPE_BIGINT>(4);
+    test_nullable_data<OLAP_FIELD_TYPE_BIGINT, DEFAULT_ENCODING, 1>(*col);
+    test_nullable_data<OLAP_FIELD_TYPE_BIGINT, DEFAULT_ENCODING, 2>(*col);
+    col = datetime_values(100);
+    test_nullable_data<OLAP_FIELD_TYPE_TIMESTAMP, DEFAULT_ENCODING, 2>(*col);
+
+    // random values are encoded by PLAIN
+    col = vectorized::ChunkHelper::column_from_field_type(OLAP_FIELD_TYPE_INT, true);
+    for (int i = 0; i < 1024 * 1024; i++) {
+        int32_t value = random();
+        (void)col->append_numbers(&value, sizeof(value));
+    }
+    test_nullable_data<OLAP_FIELD_TYPE_INT, DEFAULT_ENCODING, 2>(*col);
+
+    col = numeric_data<OLAP_FIELD_TYPE_DOUBLE>(4);
+    test_nullable_data<OLAP_FIELD_TYPE_DOUBLE, DEFAULT_ENCODING, 2>(*col);
+
+    config::set_config("adaptive_page_encoding_sample_interval", "16");
+    config::set_config("enable_adaptive_page_encoding", "false");
+}
+
 // NOLINTNEXTLINE
 TEST_F(ColumnReaderWriterTest, test_binary) {
     auto c = low_cardinality_strings(10000);
@@ -551,6 +607,24 @@ TEST_F(ColumnReaderWriterTest, test_binary) {
     test_nullable_data<OLAP_FIELD_TYPE_CHAR, DICT_ENCODING, 2>(*c, "1");
 }
 
+// NOLINTNEXTLINE
+TEST_F(ColumnReaderWriterTest, test_zstd_compression) {
+    _compression = starrocks::ZSTD;
+    _compression_level = 3;
+    auto c = high_cardinality_strings(100);
+    test_nullable_data<OLAP_FIELD_TYPE_VARCHAR, PLAIN_ENCODING, 2>(*c);
+
+    // the dictionary is trained from the first pages, and the pages before and after it are all readable.
+    _compression_dict_size = 4096;
+    test_nullable_data<OLAP_FIELD_TYPE_VARCHAR, PLAIN_ENCODING, 2>(*c);
+    auto col = numeric_data<OLAP_FIELD_TYPE_BIGINT>(4);
+    test_nullable_data<OLAP_FIELD_TYPE_BIGINT, BIT_SHUFFLE, 2>(*col);
+
+    // too few samples to train a dictionary, falls back to ZSTD without dictionary.
+    col->resize(1000);
+    test_nullable_data<OLAP_FIELD_TYPE_BIGINT, BIT_SHUFFLE, 2>(*col);
+}
+
 // NOLINTNEXTLINE
 TEST_F(ColumnReaderWriterTest, test_default_value) {
     std::string v_int("1");
@@ -0,0 +1,152 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/rowset/segment_v2/delta_page.h"
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "runtime/mem_pool.h"
+#include "storage/column_block.h"
+#include "storage/rowset/segment_v2/options.h"
+#include "storage/types.h"
+#include "storage/vectorized/chunk_helper.h"
+
+namespace starrocks::segment_v2 {
+
+class DeltaPageTest : public testing::Test {
+public:
+    // Return the encoded size.
+    template <FieldType Type>
+    size_t test_encode_decode(const std::vector<typename TypeTraits<Type>::CppType>& src) {
+        using CppType = typename TypeTraits<Type>::CppType;
+        PageBuilderOptions builder_options;
+        builder_options.data_page_size = 256 * 1024;
+        DeltaPageBuilder<Type> page_builder(builder_options);
+        // the builder is reused after reset.
+        page_builder.add(reinterpret_cast<const uint8_t*>(src.data()), src.size());
+        page_builder.finish();
+        page_builder.reset();
+        size_t size = page_builder.add(reinterpret_cast<const uint8_t*>(src.data()), src.size());
+        EXPECT_EQ(src.size(), size);
+        OwnedSlice s = page_builder.finish()->build();
+        EXPECT_EQ(src.size(), page_builder.count());
+        if (!src.empty()) {
+            CppType first_value;
+            CppType last_value;
+            EXPECT_TRUE(page_builder.get_first_value(&first_value).ok());
+            EXPECT_TRUE(page_builder.get_last_value(&last_value).ok());
+            EXPECT_EQ(src.front(), first_value);
+            EXPECT_EQ(src.back(), last_value);
+        }
+
+        PageDecoderOptions decoder_options;
+        DeltaPageDecoder<Type> page_decoder(s.slice(), decoder_options);
+        EXPECT_TRUE(page_decoder.init().ok());
+        EXPECT_EQ(0, page_decoder.current_index());
+        EXPECT_EQ(src.size(), page_decoder.count());
+
+        auto column = vectorized::ChunkHelper::column_from_field_type(Type, false);
+        size_t n = src.size() + 1;
+        EXPECT_TRUE(page_decoder.next_batch(&n, column.get()).ok());
+        EXPECT_EQ(src.size(), n);
+        EXPECT_EQ(src.size(), column->size());
+        const auto* values = reinterpret_cast<const CppType*>(column->raw_data());
+        for (size_t i = 0; i < src.size(); i++) {
+            if (src[i] != values[i]) {
+                ADD_FAILURE() << "Fail at index " << i << " inserted=" << src[i] << " got=" << values[i];
+                break;
+            }
+        }
+
+        // seek and read by ColumnBlockView
+        MemPool pool;
+        std::unique_ptr<ColumnVectorBatch> cvb;
+        ColumnVectorBatch::create(1, true, get_type_info(Type), nullptr, &cvb);
+        ColumnBlock block(cvb.get(), &pool);
+        for (int i = 0; i < 100 && !src.empty(); i++) {
+            size_t pos = random() % src.size();
+            EXPECT_TRUE(page_decoder.seek_to_position_in_page(pos).ok());
+            EXPECT_EQ(pos, page_decoder.current_index());
+            ColumnBlockView column_block_view(&block);
+            size_t one = 1;
+            EXPECT_TRUE(page_decoder.next_batch(&one, &column_block_view).ok());
+            EXPECT_EQ(1, one);
+            EXPECT_EQ(src[pos], *reinterpret_cast<const CppType*>(block.cell_ptr(0)));
+        }
+        return s.slice().size;
+    }
+};
+
+// NOLINTNEXTLINE
+TEST_F(DeltaPageTest, TestSequence) {
+    std::vector<int32_t> ints;
+    std::vector<int64_t> bigints;
+    for (int i = 0; i < 10000; i++) {
+        ints.push_back(1000000 + i);
+        bigints.push_back(1600000000000000LL + i * 1000000LL);
+    }
+    // the steady steps are encoded as the delta-of-deltas of 0, which take no bits.
+    ASSERT_LT(test_encode_decode<OLAP_FIELD_TYPE_INT>(ints), 1000);
+    ASSERT_LT(test_encode_decode<OLAP_FIELD_TYPE_BIGINT>(bigints), 1000);
+    ASSERT_LT(test_encode_decode<OLAP_FIELD_TYPE_TIMESTAMP>(bigints), 1000);
+    ASSERT_LT(test_encode_decode<OLAP_FIELD_TYPE_DATETIME>(bigints), 1000);
+}
+
+// NOLINTNEXTLINE
+TEST_F(DeltaPageTest, TestNearlySorted) {
+    std::vector<int64_t> bigints;
+    int64_t value = 1600000000000000LL;
+    for (int i = 0; i < 10000; i++) {
+        value += random() % 1000;
+        bigints.push_back(value);
+    }
+    // 10 bits for every delta
+    ASSERT_LT(test_encode_decode<OLAP_FIELD_TYPE_BIGINT>(bigints), 10000 * 10 / 8 + 1000);
+}
+
+// NOLINTNEXTLINE
+TEST_F(DeltaPageTest, TestRandomAndOverflow) {
+    std::vector<int32_t> ints;
+    std::vector<int64_t> bigints;
+    for (int i = 0; i < 1000; i++) {
+        ints.push_back(i % 2 == 0 ? std::numeric_limits<int32_t>::min() : std::numeric_limits<int32_t>::max());
+        bigints.push_back(i % 3 == 0 ? std::numeric_limits<int64_t>::max() : static_cast<int64_t>(random()) << 31);
+    }
+    test_encode_decode<OLAP_FIELD_TYPE_INT>(ints);
+    test_encode_decode<OLAP_FIELD_TYPE_BIGINT>(bigints);
+}
+
+// NOLINTNEXTLINE
+TEST_F(DeltaPageTest, TestSmallPages) {
+    for (size_t size = 0; size < 5; size++) {
+        std::vector<int64_t> bigints;
+        for (size_t i = 0; i < size; i++) {
+            bigints.push_back(static_cast<int64_t>(i * i) - 3);
+        }
+        test_encode_decode<OLAP_FIELD_TYPE_BIGINT>(bigints);
+    }
+}
+
+// NOLINTNEXTLINE
+TEST_F(DeltaPageTest, TestPageFull) {
+    PageBuilderOptions builder_options;
+    builder_options.data_page_size = 1024;
+    DeltaPageBuilder<OLAP_FIELD_TYPE_INT> page_builder(builder_options);
+    std::vector<int32_t> ints(1000, 1);
+    ASSERT_EQ(256, page_builder.add(reinterpret_cast<const uint8_t*>(ints.data()), ints.size()));
+    ASSERT_TRUE(page_builder.is_page_full());
+    ASSERT_EQ(0, page_builder.add(reinterpret_cast<const uint8_t*>(ints.data()), ints.size()));
+}
+
+// NOLINTNEXTLINE
+TEST_F(DeltaPageTest, TestCorruption) {
+    PageDecoderOptions decoder_options;
+    uint8_t data[] = {3, 0, 0, 0, 0};
+    DeltaPageDecoder<OLAP_FIELD_TYPE_INT> page_decoder(Slice(data, sizeof(data)), decoder_options);
+    ASSERT_FALSE(page_decoder.init().ok());
+}
+
+} // namespace starrocks::segment_v2
@@ -30,7 +30,9 @@
 #include "storage/rowset/segment_v2/options.h"
 #include "storage/rowset/segment_v2/page_builder.h"
 #include "storage/rowset/segment_v2/page_decoder.h"
+#include "storage/types.h"
 #include "storage/vectorized/chunk_helper.h"
+#include "storage/vectorized/column_predicate.h"
 #include "util/logging.h"
 
 using starrocks::segment_v2::PageBuilderOptions;
@@ -286,6 +288,45 @@ TEST_F(FrameOfReferencePageTest, TestInt32NormalBlockEncoderSize) {
     ASSERT_EQ(123, s.slice().size);
 }
 
+TEST_F(FrameOfReferencePageTest, TestNextBatchAndEvaluate) {
+    const uint32_t size = 10000;
+    std::unique_ptr<int32_t[]> ints(new int32_t[size]);
+    for (int i = 0; i < size; i++) {
+        ints.get()[i] = i + random() % 8;
+    }
+    PageBuilderOptions builder_options;
+    builder_options.data_page_size = 256 * 1024;
+    segment_v2::FrameOfReferencePageBuilder<OLAP_FIELD_TYPE_INT> for_page_builder(builder_options);
+    ASSERT_EQ(size, for_page_builder.add(reinterpret_cast<const uint8_t*>(ints.get()), size));
+    OwnedSlice s = for_page_builder.finish()->build();
+
+    PageDecoderOptions decoder_options;
+    segment_v2::FrameOfReferencePageDecoder<OLAP_FIELD_TYPE_INT> for_page_decoder(s.slice(), decoder_options);
+    ASSERT_TRUE(for_page_decoder.init().ok());
+    ASSERT_TRUE(for_page_decoder.support_encoded_evaluation());
+
+    // most of the frames are out of the range of the predicate and skipped.
+    std::unique_ptr<vectorized::ColumnPredicate> pred(
+            vectorized::new_column_lt_predicate(get_type_info(OLAP_FIELD_TYPE_INT), 0, "1000"));
+    auto column = vectorized::ChunkHelper::column_from_field_type(OLAP_FIELD_TYPE_INT, false);
+    std::vector<uint8_t> selection(size);
+    size_t read = 0;
+    while (read < size) {
+        size_t n = 999;
+        ASSERT_TRUE(for_page_decoder.next_batch_and_evaluate(&n, column.get(), pred.get(), selection.data()).ok());
+        ASSERT_GT(n, 0);
+        read += n;
+    }
+    ASSERT_EQ(size, read);
+    ASSERT_EQ(size, column->size());
+    for (uint32_t i = 0; i < size; i++) {
+        ASSERT_EQ(ints.get()[i] < 1000, selection[i] != 0);
+        if (selection[i]) {
+            ASSERT_EQ(ints.get()[i], column->get(i).get<int32_t>());
+        }
+    }
+}
+
 TEST_F(FrameOfReferencePageTest, TestFindBitsOfInt) {
     int8_t bits_3 = 0x06;
     ASSERT_EQ(3, bits(bits_3));
@@ -32,6 +32,8 @@
 #include "storage/rowset/segment_v2/options.h"
 #include "storage/rowset/segment_v2/page_builder.h"
 #include "storage/rowset/segment_v2/page_decoder.h"
+#include "storage/types.h"
+#include "storage/vectorized/column_predicate.h"
 #include "util/logging.h"
 
 using starrocks::segment_v2::PageBuilderOptions;
@@ -232,4 +234,38 @@ TEST_F(RlePageTest, TestRleBoolBlockEncoderSize) {
     ASSERT_EQ(7, s.slice().size);
 }
 
+// Test for evaluating the predicate on the runs, for INT32
+TEST_F(RlePageTest, TestRleInt32NextBatchAndEvaluate) {
+    const uint32_t size = 10000;
+    std::unique_ptr<int32_t[]> ints(new int32_t[size]);
+    for (int i = 0; i < size; i++) {
+        // long runs mixed with the literals.
+        ints.get()[i] = (i / 1000) % 2 == 0 ? (i / 100) % 5 : random() % 5;
+    }
+    OwnedSlice s = rle_encode<OLAP_FIELD_TYPE_INT>(ints.get(), size);
+
+    PageDecoderOptions decoder_options;
+    segment_v2::RlePageDecoder<OLAP_FIELD_TYPE_INT> rle_page_decoder(s.slice(), decoder_options);
+    ASSERT_TRUE(rle_page_decoder.init().ok());
+    ASSERT_TRUE(rle_page_decoder.support_encoded_evaluation());
+
+    std::unique_ptr<vectorized::ColumnPredicate> pred(
+            vectorized::new_column_eq_predicate(get_type_info(OLAP_FIELD_TYPE_INT), 0, "2"));
+    auto column = vectorized::FixedLengthColumn<int32_t>::create();
+    std::vector<uint8_t> selection(size);
+    size_t read = 0;
+    while (read < size) {
+        size_t n = 777;
+        ASSERT_TRUE(rle_page_decoder.next_batch_and_evaluate(&n, column.get(), pred.get(), selection.data()).ok());
+        ASSERT_GT(n, 0);
+        read += n;
+    }
+    ASSERT_EQ(size, read);
+    ASSERT_EQ(size, column->size());
+    for (uint32_t i = 0; i < size; i++) {
+        ASSERT_EQ(ints.get()[i], column->get_data()[i]);
+        ASSERT_EQ(ints.get()[i] == 2, selection[i] != 0);
+    }
+}
+
 } // namespace starrocks
@@ -21,6 +21,10 @@
 
 #include "storage/rowset/segment_v2/segment.h"
 
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wclass-memaccess"
+#include <bvar/bvar.h>
+#pragma GCC diagnostic pop
 #include <gtest/gtest.h>
 
 #include <functional>
@@ -50,6 +54,8 @@
         ASSERT_TRUE(_status.ok()) << _status.to_string(); \
     } while (0)
 
+extern bvar::Adder<int> g_segment_footer_cache_hits;
+
 namespace starrocks {
 namespace segment_v2 {
 
@@ -654,6 +660,48 @@ TEST_F(SegmentReaderWriterTest, estimate_segment_size) {
     ASSERT_NE(segment_size, 0);
 }
 
+TEST_F(SegmentReaderWriterTest, ReopenWithFooterCache) {
+    TabletSchema tablet_schema = create_schema({create_int_key(1), create_int_value(2)});
+    SegmentWriterOptions opts;
+    opts.num_rows_per_block = 10;
+    opts.mem_tracker = _mem_tracker.get();
+    std::string filename = strings::Substitute("$0/seg_reopen.dat", kSegmentDir);
+
+    auto write_segment = [&](size_t nrows) {
+        std::unique_ptr<fs::WritableBlock> wblock;
+        fs::CreateBlockOptions block_opts({filename});
+        ASSERT_OK(_block_mgr->create_block(block_opts, &wblock));
+        SegmentWriter writer(std::move(wblock), 0, &tablet_schema, opts);
+        ASSERT_OK(writer.init(10));
+        RowCursor row;
+        ASSERT_EQ(OLAP_SUCCESS, row.init(tablet_schema));
+        for (size_t rid = 0; rid < nrows; ++rid) {
+            for (int cid = 0; cid < tablet_schema.num_columns(); ++cid) {
+                RowCursorCell cell = row.cell(cid);
+                DefaultIntGenerator(rid, cid, 0, cell);
+            }
+            ASSERT_OK(writer.append_row(row));
+        }
+        uint64_t file_size, index_size;
+        ASSERT_OK(writer.finalize(&file_size, &index_size));
+    };
+
+    write_segment(100);
+    int hits = g_segment_footer_cache_hits.get_value();
+    for (int i = 0; i < 2; i++) {
+        auto segment = *Segment::open(_mem_tracker.get(), _block_mgr, filename, 0, &tablet_schema);
+        ASSERT_EQ(100, segment->num_rows());
+    }
+    ASSERT_EQ(hits + 1, g_segment_footer_cache_hits.get_value());
+
+    // the footer cached is not used for the file written again.
+    ASSERT_OK(_env->delete_file(filename));
+    write_segment(200);
+    auto segment = *Segment::open(_mem_tracker.get(), _block_mgr, filename, 0, &tablet_schema);
+    ASSERT_EQ(200, segment->num_rows());
+    ASSERT_EQ(hits + 1, g_segment_footer_cache_hits.get_value());
+}
+
 TEST_F(SegmentReaderWriterTest, TestDefaultValueColumn) {
     std::vector<TabletColumn> columns = {create_int_key(1), create_int_key(2), create_int_value(3),
                                          create_int_value(4)};
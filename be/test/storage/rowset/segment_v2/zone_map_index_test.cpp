@@ -23,6 +23,7 @@
 
 #include <gtest/gtest.h>
 
+#include <limits>
 #include <memory>
 #include <string>
 
@@ -168,6 +169,118 @@ TEST_F(ColumnZoneMapTest, NormalTestIntPage) {
     delete field;
 }
 
+// Test for the sub-page zone maps of int
+TEST_F(ColumnZoneMapTest, SubPageTestIntPage) {
+    std::string filename = kTestDir + "/SubPageTestIntPage";
+
+    TabletColumn int_column = create_int_key(0);
+    Field* field = FieldFactory::create(int_column);
+
+    // 4 rows per sub-page.
+    std::unique_ptr<ZoneMapIndexWriter> builder = ZoneMapIndexWriter::create(field, 4);
+    // page 0: [1, 2, 3, 4], [5, 6, null, null], [9, 10]
+    std::vector<int> values1 = {1, 2, 3, 4, 5, 6};
+    builder->add_values((const uint8_t*)values1.data(), values1.size());
+    builder->add_nulls(2);
+    std::vector<int> values2 = {9, 10};
+    builder->add_values((const uint8_t*)values2.data(), values2.size());
+    builder->flush();
+    // page 1: [null, null, null, null], [null, 20, 30]
+    builder->add_nulls(5);
+    std::vector<int> values3 = {20, 30};
+    builder->add_values((const uint8_t*)values3.data(), values3.size());
+    builder->flush();
+    ColumnIndexMetaPB index_meta;
+    {
+        std::unique_ptr<fs::WritableBlock> wblock;
+        fs::CreateBlockOptions opts({filename});
+        ASSERT_TRUE(_block_mgr->create_block(opts, &wblock).ok());
+        ASSERT_TRUE(builder->finish(wblock.get(), &index_meta).ok());
+        ASSERT_TRUE(wblock->close().ok());
+    }
+    ASSERT_EQ(4, index_meta.zone_map_index().sub_page_rows());
+    ASSERT_EQ(7, index_meta.zone_map_index().segment_zone_map().null_count());
+
+    ZoneMapIndexReader column_zone_map;
+    ASSERT_OK(column_zone_map.load(_block_mgr, filename, &index_meta.zone_map_index(), true, false));
+    ASSERT_EQ(2, column_zone_map.num_pages());
+    ASSERT_EQ(4, column_zone_map.sub_page_rows());
+    ASSERT_EQ(2, column_zone_map.page_zone_maps()[0].null_count());
+    ASSERT_EQ(5, column_zone_map.page_zone_maps()[1].null_count());
+
+    const std::vector<ZoneMapPB>& zone_maps = column_zone_map.sub_page_zone_maps();
+    ASSERT_EQ(5, zone_maps.size());
+    ASSERT_EQ(std::to_string(1), zone_maps[0].min());
+    ASSERT_EQ(std::to_string(4), zone_maps[0].max());
+    ASSERT_EQ(0, zone_maps[0].null_count());
+
+    ASSERT_EQ(std::to_string(5), zone_maps[1].min());
+    ASSERT_EQ(std::to_string(6), zone_maps[1].max());
+    ASSERT_EQ(2, zone_maps[1].null_count());
+
+    ASSERT_EQ(std::to_string(9), zone_maps[2].min());
+    ASSERT_EQ(std::to_string(10), zone_maps[2].max());
+    ASSERT_EQ(false, zone_maps[2].has_null());
+
+    ASSERT_EQ(true, zone_maps[3].has_null());
+    ASSERT_EQ(false, zone_maps[3].has_not_null());
+    ASSERT_EQ(4, zone_maps[3].null_count());
+
+    ASSERT_EQ(std::to_string(20), zone_maps[4].min());
+    ASSERT_EQ(std::to_string(30), zone_maps[4].max());
+    ASSERT_EQ(1, zone_maps[4].null_count());
+    delete field;
+}
+
+// Test for the pre-aggregated sums of int
+TEST_F(ColumnZoneMapTest, SumTestIntPage) {
+    std::string filename = kTestDir + "/SumTestIntPage";
+
+    TabletColumn int_column = create_int_key(0);
+    Field* field = FieldFactory::create(int_column);
+
+    std::unique_ptr<ZoneMapIndexWriter> builder = ZoneMapIndexWriter::create(field, 4, true);
+    std::vector<int> values1 = {1, 2, 3, 4, 5, 6};
+    builder->add_values((const uint8_t*)values1.data(), values1.size());
+    builder->add_nulls(2);
+    builder->flush();
+    std::vector<int> values2 = {std::numeric_limits<int>::max(), std::numeric_limits<int>::max(), -7};
+    builder->add_values((const uint8_t*)values2.data(), values2.size());
+    builder->flush();
+    builder->add_nulls(3);
+    builder->flush();
+    ColumnIndexMetaPB index_meta;
+    {
+        std::unique_ptr<fs::WritableBlock> wblock;
+        fs::CreateBlockOptions opts({filename});
+        ASSERT_TRUE(_block_mgr->create_block(opts, &wblock).ok());
+        ASSERT_TRUE(builder->finish(wblock.get(), &index_meta).ok());
+        ASSERT_TRUE(wblock->close().ok());
+    }
+
+    // the sum doesn't overflow the type of the column.
+    const int128_t page_sum1 = 2 * static_cast<int128_t>(std::numeric_limits<int>::max()) - 7;
+    int128_t sum = 0;
+    ASSERT_TRUE(zone_map_int_sum(index_meta.zone_map_index().segment_zone_map(), &sum));
+    ASSERT_TRUE(sum == 21 + page_sum1);
+    double double_sum = 0;
+    ASSERT_FALSE(zone_map_double_sum(index_meta.zone_map_index().segment_zone_map(), &double_sum));
+
+    ZoneMapIndexReader column_zone_map;
+    ASSERT_OK(column_zone_map.load(_block_mgr, filename, &index_meta.zone_map_index(), true, false));
+    const std::vector<ZoneMapPB>& zone_maps = column_zone_map.page_zone_maps();
+    ASSERT_EQ(3, zone_maps.size());
+    ASSERT_TRUE(zone_map_int_sum(zone_maps[0], &sum));
+    ASSERT_TRUE(sum == 21);
+    ASSERT_TRUE(zone_map_int_sum(zone_maps[1], &sum));
+    ASSERT_TRUE(sum == page_sum1);
+    ASSERT_TRUE(zone_map_int_sum(zone_maps[2], &sum));
+    ASSERT_TRUE(sum == 0);
+    // the sub-page zone maps don't keep the sums.
+    ASSERT_FALSE(column_zone_map.sub_page_zone_maps()[0].has_sum());
+    delete field;
+}
+
 // Test for string
 TEST_F(ColumnZoneMapTest, NormalTestVarcharPage) {
     TabletColumn varchar_column = create_varchar_key(0);
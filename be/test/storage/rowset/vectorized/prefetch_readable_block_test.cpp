@@ -0,0 +1,133 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/rowset/vectorized/prefetch_readable_block.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+
+#include "storage/fs/block_id.h"
+#include "util/priority_thread_pool.hpp"
+#include "util/slice.h"
+
+namespace starrocks::vectorized {
+
+// A readable block of the bytes in memory, counting the reads.
+class MemoryReadableBlock final : public fs::ReadableBlock {
+public:
+    explicit MemoryReadableBlock(std::string data) : _data(std::move(data)) {}
+
+    const BlockId& id() const override { return _id; }
+    const std::string& path() const override { return _path; }
+    Status close() override { return Status::OK(); }
+    fs::BlockManager* block_manager() const override { return nullptr; }
+    Status size(uint64_t* sz) const override {
+        *sz = _data.size();
+        return Status::OK();
+    }
+    Status read(uint64_t offset, Slice result) const override {
+        if (offset + result.size > _data.size()) {
+            return Status::IOError("read out of range");
+        }
+        _num_reads++;
+        memcpy(result.data, _data.data() + offset, result.size);
+        return Status::OK();
+    }
+    Status readv(uint64_t offset, const Slice* res, size_t res_cnt) const override {
+        for (size_t i = 0; i < res_cnt; i++) {
+            RETURN_IF_ERROR(read(offset, res[i]));
+            offset += res[i].size;
+        }
+        return Status::OK();
+    }
+
+    int num_reads() const { return _num_reads; }
+
+private:
+    BlockId _id;
+    std::string _path = "memory";
+    std::string _data;
+    mutable std::atomic<int> _num_reads{0};
+};
+
+class PrefetchReadableBlockTest : public testing::Test {
+protected:
+    void SetUp() override {
+        for (int i = 0; i < 4096; i++) {
+            _data.push_back(static_cast<char>(i % 251));
+        }
+    }
+
+    std::unique_ptr<PrefetchReadableBlock> create_block(size_t max_gap, size_t max_io_bytes) {
+        auto block = std::make_unique<MemoryReadableBlock>(_data);
+        _mem_block = block.get();
+        return std::make_unique<PrefetchReadableBlock>(std::move(block), max_gap, max_io_bytes);
+    }
+
+    void check_read(PrefetchReadableBlock* block, uint64_t offset, size_t size) {
+        std::string buf(size, 0);
+        ASSERT_TRUE(block->read(offset, Slice(buf)).ok());
+        ASSERT_EQ(_data.substr(offset, size), buf);
+    }
+
+    std::string _data;
+    MemoryReadableBlock* _mem_block = nullptr;
+};
+
+TEST_F(PrefetchReadableBlockTest, coalesce) {
+    auto block = create_block(16, 256);
+    // coalesced into [0, 200) over the gap, and [300, 500), [500, 600) for the max io bytes.
+    block->add_stream({{0, 100}, {110, 90}, {300, 100}, {400, 100}, {500, 100}});
+    // another stream, [1000, 1100).
+    block->add_stream({{1000, 50}, {1050, 50}});
+    block->start(nullptr);
+    ASSERT_EQ(4, block->num_io_ranges());
+
+    check_read(block.get(), 0, 100);
+    check_read(block.get(), 110, 90);
+    ASSERT_EQ(1, _mem_block->num_reads());
+    check_read(block.get(), 1000, 50);
+    check_read(block.get(), 1050, 50);
+    ASSERT_EQ(2, _mem_block->num_reads());
+    check_read(block.get(), 300, 100);
+    check_read(block.get(), 400, 100);
+    check_read(block.get(), 500, 100);
+    ASSERT_EQ(4, _mem_block->num_reads());
+
+    // out of the planned ranges.
+    check_read(block.get(), 2000, 10);
+    ASSERT_EQ(5, _mem_block->num_reads());
+    // the released io range is read from the underlying block.
+    check_read(block.get(), 0, 100);
+    ASSERT_EQ(6, _mem_block->num_reads());
+}
+
+TEST_F(PrefetchReadableBlockTest, thread_pool) {
+    PriorityThreadPool pool(2, 16);
+    for (int round = 0; round < 10; round++) {
+        auto block = create_block(0, 512);
+        std::vector<std::pair<uint64_t, uint64_t>> ranges;
+        for (uint64_t offset = 0; offset < 2048; offset += 64) {
+            ranges.emplace_back(offset, 64);
+        }
+        block->add_stream(ranges);
+        ranges.clear();
+        for (uint64_t offset = 2048; offset < 4096; offset += 128) {
+            ranges.emplace_back(offset, 128);
+        }
+        block->add_stream(ranges);
+        block->start(&pool);
+        ASSERT_EQ(8, block->num_io_ranges());
+
+        for (uint64_t i = 0; i < 16; i++) {
+            check_read(block.get(), i * 128, 64);
+            check_read(block.get(), i * 128 + 64, 64);
+            check_read(block.get(), 2048 + i * 128, 128);
+        }
+        // the block is destroyed with the prefetch tasks in flight in some rounds.
+    }
+    pool.shutdown();
+    pool.join();
+}
+
+} // namespace starrocks::vectorized
@@ -23,6 +23,8 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+
 #include "storage/row_cursor.h"
 #include "storage/tablet_schema_helper.h"
 #include "util/debug_util.h"
@@ -97,6 +99,49 @@ TEST_F(ShortKeyIndexTest, buider) {
     }
 }
 
+// the keys share long common prefixes and some of them are shorter than the 8-byte prefixes.
+TEST_F(ShortKeyIndexTest, seek_by_prefix) {
+    std::vector<std::string> keys;
+    for (int i = 0; i < 20; i++) {
+        std::string head = std::string(1, '\x02') + std::string(i % 5, '\x00');
+        keys.push_back(head);
+        for (int j = 0; j < 20; j += 3) {
+            keys.push_back(head + "common_prefix_" + std::to_string(100 + i) + "_" + std::to_string(j));
+        }
+    }
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    ShortKeyIndexBuilder builder(0, 1024);
+    for (auto& key : keys) {
+        ASSERT_TRUE(builder.add_item(key).ok());
+    }
+    std::vector<Slice> slices;
+    segment_v2::PageFooterPB footer;
+    ASSERT_TRUE(builder.finalize(keys.size() * 1024, &slices, &footer).ok());
+    std::string buf;
+    for (auto& slice : slices) {
+        buf.append(slice.data, slice.size);
+    }
+    ShortKeyIndexDecoder decoder;
+    ASSERT_TRUE(decoder.parse(buf, footer.short_key_page_footer()).ok());
+
+    std::vector<std::string> targets = keys;
+    for (auto& key : keys) {
+        targets.push_back(key + "0");
+        targets.push_back(key.substr(0, key.size() - 1));
+        targets.push_back(key.substr(0, 8));
+    }
+    targets.emplace_back("");
+    targets.emplace_back("\xff");
+    for (auto& target : targets) {
+        auto expected_lower = std::lower_bound(keys.begin(), keys.end(), target) - keys.begin();
+        auto expected_upper = std::upper_bound(keys.begin(), keys.end(), target) - keys.begin();
+        ASSERT_EQ(expected_lower, decoder.lower_bound(target).ordinal());
+        ASSERT_EQ(expected_upper, decoder.upper_bound(target).ordinal());
+    }
+}
+
 TEST_F(ShortKeyIndexTest, enocde) {
     TabletSchema tablet_schema;
     tablet_schema._cols.push_back(create_int_key(0));
@@ -5,6 +5,7 @@
 #include <gtest/gtest.h>
 
 #include <chrono>
+#include <filesystem>
 #include <string>
 #include <thread>
 
@@ -12,7 +13,9 @@
 #include "column/vectorized_fwd.h"
 #include "gutil/strings/substitute.h"
 #include "storage/kv_store.h"
+#include "storage/primary_index.h"
 #include "storage/primary_key_encoder.h"
+#include "storage/rowset/beta_rowset.h"
 #include "storage/rowset/rowset_factory.h"
 #include "storage/rowset/rowset_writer.h"
 #include "storage/rowset/rowset_writer_context.h"
@@ -67,6 +70,35 @@ public:
         return writer->build();
     }
 
+    // a partial update of the column v2 of |keys|.
+    RowsetSharedPtr create_partial_rowset(const TabletSharedPtr& tablet, const vector<int64_t>& keys) {
+        auto partial_schema = tablet->tablet_schema().create_partial({0, 2});
+        RowsetWriterContext writer_context(kDataFormatV2, config::storage_format_version);
+        writer_context.rowset_id = StorageEngine::instance()->next_rowset_id();
+        writer_context.tablet_id = tablet->tablet_id();
+        writer_context.tablet_schema_hash = tablet->schema_hash();
+        writer_context.partition_id = 0;
+        writer_context.rowset_type = BETA_ROWSET;
+        writer_context.rowset_path_prefix = tablet->tablet_path();
+        writer_context.rowset_state = COMMITTED;
+        writer_context.tablet_schema = &tablet->tablet_schema();
+        writer_context.partial_update_tablet_schema = partial_schema.get();
+        writer_context.version.first = 0;
+        writer_context.version.second = 0;
+        writer_context.segments_overlap = NONOVERLAPPING;
+        std::unique_ptr<RowsetWriter> writer;
+        EXPECT_TRUE(RowsetFactory::create_rowset_writer(writer_context, &writer).ok());
+        auto schema = vectorized::ChunkHelper::convert_schema(*partial_schema);
+        auto chunk = vectorized::ChunkHelper::new_chunk(schema, keys.size());
+        auto& cols = chunk->columns();
+        for (int64_t key : keys) {
+            cols[0]->append_datum(vectorized::Datum(key));
+            cols[1]->append_datum(vectorized::Datum((int32_t)(key % 1000 + 3)));
+        }
+        EXPECT_EQ(OLAP_SUCCESS, writer->flush_chunk(*chunk));
+        return writer->build();
+    }
+
     TabletSharedPtr create_tablet(int64_t tablet_id, int32_t schema_hash) {
         TCreateTabletReq request;
         request.tablet_id = tablet_id;
@@ -1332,4 +1364,152 @@ TEST_F(TabletUpdatesTest, snapshot_with_empty_rowset) {
     EXPECT_EQ(keys0.size(), read_tablet(tablet1, tablet1->updates()->max_version()));
 }
 
+TEST_F(TabletUpdatesTest, partial_update) {
+    srand(GetCurrentTimeMicros());
+    _tablet = create_tablet(rand(), rand());
+    const int N = 1000;
+    std::vector<int64_t> keys;
+    for (int i = 0; i < N; i++) {
+        keys.push_back(i);
+    }
+    ASSERT_TRUE(_tablet->rowset_commit(2, create_rowset(_tablet, keys)).ok());
+    // update v2 of the odd keys.
+    std::vector<int64_t> partial_keys;
+    for (int i = 1; i < N; i += 2) {
+        partial_keys.push_back(i);
+    }
+    auto partial_rowset = create_partial_rowset(_tablet, partial_keys);
+    ASSERT_TRUE(partial_rowset->rowset_meta()->is_partial_update());
+    ASSERT_TRUE(_tablet->rowset_commit(3, partial_rowset).ok());
+    ASSERT_EQ(3, _tablet->updates()->max_version());
+
+    // the partial rowset is replaced by a full one when it's applied.
+    std::vector<RowsetSharedPtr> rowsets;
+    ASSERT_TRUE(_tablet->updates()->get_applied_rowsets(3, &rowsets).ok());
+    auto delta = _tablet->updates()->get_delta_rowset(3);
+    ASSERT_NE(nullptr, delta);
+    ASSERT_FALSE(delta->rowset_meta()->is_partial_update());
+    ASSERT_EQ(partial_keys.size(), static_cast<size_t>(delta->num_rows()));
+
+    auto iter = create_tablet_iterator(_tablet, 3);
+    ASSERT_NE(nullptr, iter);
+    auto chunk = vectorized::ChunkHelper::new_chunk(iter->schema(), 100);
+    size_t count = 0;
+    while (true) {
+        chunk->reset();
+        auto st = iter->get_next(chunk.get());
+        if (st.is_end_of_file()) {
+            break;
+        }
+        ASSERT_TRUE(st.ok()) << st.to_string();
+        for (size_t i = 0; i < chunk->num_rows(); i++) {
+            auto row = chunk->get(i);
+            int64_t key = row.get(0).get_int64();
+            EXPECT_EQ((int16_t)(key % 100 + 1), row.get(1).get_int16());
+            EXPECT_EQ((int32_t)(key % 1000 + (key % 2 == 1 ? 3 : 2)), row.get(2).get_int32());
+        }
+        count += chunk->num_rows();
+    }
+    ASSERT_EQ(N, count);
+
+    // the full rowset is loaded after reopening the tablet.
+    auto tablet1 = load_same_tablet_from_store(_tablet);
+    ASSERT_EQ(3, tablet1->updates()->max_version());
+    ASSERT_FALSE(tablet1->updates()->get_delta_rowset(3)->rowset_meta()->is_partial_update());
+    EXPECT_EQ(N, read_tablet(tablet1, 3));
+}
+
+TEST_F(TabletUpdatesTest, get_rows_by_keys) {
+    srand(GetCurrentTimeMicros());
+    _tablet = create_tablet(rand(), rand());
+    std::vector<int64_t> keys;
+    for (int i = 0; i < 100; i++) {
+        keys.push_back(i);
+    }
+    ASSERT_TRUE(_tablet->rowset_commit(2, create_rowset(_tablet, keys)).ok());
+    // upsert the keys 50~149, then delete the key 10.
+    std::vector<int64_t> keys2;
+    for (int i = 50; i < 150; i++) {
+        keys2.push_back(i);
+    }
+    auto deletes = vectorized::Int64Column::create();
+    deletes->append(10);
+    ASSERT_TRUE(_tablet->rowset_commit(3, create_rowset(_tablet, keys2, deletes.get())).ok());
+
+    auto key_column = vectorized::Int64Column::create();
+    for (int64_t k : {120, 10, 5, 300, 60, 5}) {
+        key_column->append(k);
+    }
+    std::vector<ColumnId> key_cids{0};
+    auto key_schema = std::make_shared<vectorized::Schema>(
+            vectorized::ChunkHelper::convert_schema_to_format_v2(_tablet->tablet_schema(), key_cids));
+    vectorized::Chunk key_chunk({key_column}, key_schema);
+    std::vector<std::unique_ptr<vectorized::Column>> columns;
+    columns.emplace_back(vectorized::Int32Column::create_mutable());
+    std::vector<bool> found;
+    int64_t read_version = 0;
+    ASSERT_TRUE(_tablet->updates()->get_rows_by_keys(key_chunk, 3, 60000, {2}, &found, &columns, &read_version).ok());
+    ASSERT_EQ(3, read_version);
+    ASSERT_EQ((std::vector<bool>{true, false, true, false, true, true}), found);
+    ASSERT_EQ(4, columns[0]->size());
+    for (size_t i = 0, j = 0; i < key_column->size(); i++) {
+        if (found[i]) {
+            EXPECT_EQ((int32_t)(key_column->get_data()[i] % 1000 + 2), columns[0]->get(j++).get_int32());
+        }
+    }
+}
+
+// NOLINTNEXTLINE
+TEST_F(TabletUpdatesTest, load_primary_index_in_parallel) {
+    srand(GetCurrentTimeMicros());
+    _tablet = create_tablet(rand(), rand());
+    // 5 rowsets of one segment each, with the keys 0~499, the second one deletes the key 5.
+    std::vector<RowsetSharedPtr> rowsets;
+    for (int i = 0; i < 5; i++) {
+        std::vector<int64_t> keys;
+        for (int k = i * 100; k < (i + 1) * 100; k++) {
+            keys.push_back(k);
+        }
+        auto deletes = vectorized::Int64Column::create();
+        deletes->append(5);
+        auto rowset = create_rowset(_tablet, keys, i == 1 ? deletes.get() : nullptr);
+        ASSERT_TRUE(_tablet->rowset_commit(i + 2, rowset).ok());
+        rowsets.push_back(rowset);
+    }
+    std::vector<RowsetSharedPtr> applied_rowsets;
+    ASSERT_TRUE(_tablet->updates()->get_applied_rowsets(6, &applied_rowsets).ok());
+
+    const int32_t old_load_threads = config::primary_index_load_threads;
+    const int64_t old_min_rows = config::primary_index_parallel_load_min_rows;
+    config::primary_index_load_threads = 3;
+    config::primary_index_parallel_load_min_rows = 0;
+    DeferOp reset_config([&]() {
+        config::primary_index_load_threads = old_load_threads;
+        config::primary_index_parallel_load_min_rows = old_min_rows;
+    });
+
+    PrimaryIndex index;
+    ASSERT_TRUE(index.load(_tablet.get()).ok());
+    ASSERT_EQ(499, index.size());
+    auto key_column = vectorized::Int64Column::create();
+    for (int64_t k : {5, 250, 499, 500}) {
+        key_column->append(k);
+    }
+    std::vector<uint64_t> rowids;
+    index.get(*key_column, &rowids);
+    ASSERT_EQ(4, rowids.size());
+    ASSERT_EQ(PrimaryIndex::NOT_FOUND, rowids[0]);
+    ASSERT_EQ(rowsets[2]->rowset_meta()->get_rowset_seg_id(), rowids[1] >> 32);
+    ASSERT_EQ(50, rowids[1] & 0xffffffff);
+    ASSERT_EQ(rowsets[4]->rowset_meta()->get_rowset_seg_id(), rowids[2] >> 32);
+    ASSERT_EQ(99, rowids[2] & 0xffffffff);
+    ASSERT_EQ(PrimaryIndex::NOT_FOUND, rowids[3]);
+
+    // a segment which can't be read fails the load.
+    auto rowset = rowsets[3];
+    std::filesystem::resize_file(BetaRowset::segment_file_path(rowset->rowset_path(), rowset->rowset_id(), 0), 0);
+    PrimaryIndex failed_index;
+    ASSERT_FALSE(failed_index.load(_tablet.get()).ok());
+}
+
 } // namespace starrocks
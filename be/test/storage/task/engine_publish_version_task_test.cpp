@@ -0,0 +1,168 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/task/engine_publish_version_task.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "common/config.h"
+#include "storage/rowset/rowset_factory.h"
+#include "storage/rowset/rowset_writer.h"
+#include "storage/rowset/rowset_writer_context.h"
+#include "storage/storage_engine.h"
+#include "storage/tablet_manager.h"
+#include "storage/txn_manager.h"
+#include "storage/vectorized/chunk_helper.h"
+
+namespace starrocks {
+
+class EnginePublishVersionTaskTest : public testing::Test {
+public:
+    void SetUp() override {
+        _old_parallelism = config::publish_version_tablet_parallelism;
+        config::publish_version_tablet_parallelism = 2;
+    }
+
+    void TearDown() override {
+        config::publish_version_tablet_parallelism = _old_parallelism;
+        auto* txn_mgr = StorageEngine::instance()->txn_manager();
+        for (auto& tablet : _tablets) {
+            (void)txn_mgr->rollback_txn(kPartitionId, tablet, kTxnId);
+            (void)StorageEngine::instance()->tablet_manager()->drop_tablet(tablet->tablet_id(), tablet->schema_hash(),
+                                                                           false);
+        }
+        _tablets.clear();
+    }
+
+protected:
+    static constexpr int64_t kPartitionId = 3001;
+    static constexpr int64_t kTxnId = 4001;
+    static constexpr int32_t kSchemaHash = 1111;
+
+    TabletSharedPtr _create_tablet(int64_t tablet_id) {
+        TCreateTabletReq request;
+        request.tablet_id = tablet_id;
+        request.__set_version(1);
+        request.__set_version_hash(0);
+        request.__set_partition_id(kPartitionId);
+        request.tablet_schema.schema_hash = kSchemaHash;
+        request.tablet_schema.short_key_column_count = 1;
+        request.tablet_schema.keys_type = TKeysType::DUP_KEYS;
+        request.tablet_schema.storage_type = TStorageType::COLUMN;
+
+        TColumn k1;
+        k1.column_name = "k1";
+        k1.__set_is_key(true);
+        k1.column_type.type = TPrimitiveType::INT;
+        request.tablet_schema.columns.push_back(k1);
+
+        TColumn v1;
+        v1.column_name = "v1";
+        v1.__set_is_key(false);
+        v1.column_type.type = TPrimitiveType::INT;
+        request.tablet_schema.columns.push_back(v1);
+        auto st = StorageEngine::instance()->create_tablet(request);
+        CHECK(st.ok()) << st.to_string();
+        auto tablet = StorageEngine::instance()->tablet_manager()->get_tablet(tablet_id, kSchemaHash);
+        _tablets.push_back(tablet);
+        return tablet;
+    }
+
+    // write a rowset of one row to |tablet| in the txn, and commit it if |commit| is true.
+    void _load(const TabletSharedPtr& tablet, bool commit) {
+        PUniqueId load_id;
+        load_id.set_hi(tablet->tablet_id());
+        load_id.set_lo(kTxnId);
+        auto* txn_mgr = StorageEngine::instance()->txn_manager();
+        ASSERT_EQ(OLAP_SUCCESS, txn_mgr->prepare_txn(kPartitionId, tablet, kTxnId, load_id));
+        if (!commit) {
+            return;
+        }
+
+        RowsetWriterContext writer_context(kDataFormatV2, config::storage_format_version);
+        writer_context.rowset_id = StorageEngine::instance()->next_rowset_id();
+        writer_context.tablet_uid = tablet->tablet_uid();
+        writer_context.tablet_id = tablet->tablet_id();
+        writer_context.tablet_schema_hash = tablet->schema_hash();
+        writer_context.partition_id = kPartitionId;
+        writer_context.txn_id = kTxnId;
+        writer_context.load_id = load_id;
+        writer_context.rowset_path_prefix = tablet->tablet_path();
+        writer_context.rowset_state = COMMITTED;
+        writer_context.tablet_schema = &tablet->tablet_schema();
+        writer_context.segments_overlap = NONOVERLAPPING;
+        std::unique_ptr<RowsetWriter> writer;
+        ASSERT_TRUE(RowsetFactory::create_rowset_writer(writer_context, &writer).ok());
+        auto schema = vectorized::ChunkHelper::convert_schema_to_format_v2(tablet->tablet_schema());
+        auto chunk = vectorized::ChunkHelper::new_chunk(schema, 1);
+        chunk->get_column_by_index(0)->append_datum(vectorized::Datum((int32_t)1));
+        chunk->get_column_by_index(1)->append_datum(vectorized::Datum((int32_t)2));
+        ASSERT_EQ(OLAP_SUCCESS, writer->add_chunk(*chunk));
+        ASSERT_EQ(OLAP_SUCCESS, writer->flush());
+        RowsetSharedPtr rowset = writer->build();
+        ASSERT_TRUE(rowset != nullptr);
+        ASSERT_EQ(OLAP_SUCCESS, txn_mgr->commit_txn(kPartitionId, tablet, kTxnId, load_id, rowset, false));
+    }
+
+    int32_t _old_parallelism = 0;
+    std::vector<TabletSharedPtr> _tablets;
+};
+
+// NOLINTNEXTLINE
+TEST_F(EnginePublishVersionTaskTest, test_publish_with_one_failed_tablet) {
+    const int kNumTablets = 5;
+    const int kFailedTablet = 2;
+    for (int i = 0; i < kNumTablets; ++i) {
+        auto tablet = _create_tablet(12001 + i);
+        ASSERT_TRUE(tablet != nullptr);
+        // the txn of the failed tablet is not committed, it has no rowset to publish.
+        _load(tablet, i != kFailedTablet);
+    }
+
+    TPublishVersionRequest request;
+    request.transaction_id = kTxnId;
+    TPartitionVersionInfo version_info;
+    version_info.partition_id = kPartitionId;
+    version_info.version = 2;
+    version_info.version_hash = 0;
+    request.partition_version_infos.push_back(version_info);
+    std::vector<TTabletId> error_tablet_ids;
+    EnginePublishVersionTask task(request, &error_tablet_ids);
+    OLAPStatus res = task.finish();
+
+    // the failure of one tablet does not stop the others from being published.
+    ASSERT_EQ(OLAP_ERR_PUSH_ROWSET_NOT_FOUND, res);
+    ASSERT_EQ(std::vector<TTabletId>{_tablets[kFailedTablet]->tablet_id()}, error_tablet_ids);
+    for (int i = 0; i < kNumTablets; ++i) {
+        ASSERT_EQ(i != kFailedTablet, _tablets[i]->check_version_exist(Version(2, 2))) << i;
+    }
+}
+
+// NOLINTNEXTLINE
+TEST_F(EnginePublishVersionTaskTest, test_publish_all_tablets) {
+    const int kNumTablets = 4;
+    for (int i = 0; i < kNumTablets; ++i) {
+        auto tablet = _create_tablet(12101 + i);
+        ASSERT_TRUE(tablet != nullptr);
+        _load(tablet, true);
+    }
+
+    TPublishVersionRequest request;
+    request.transaction_id = kTxnId;
+    TPartitionVersionInfo version_info;
+    version_info.partition_id = kPartitionId;
+    version_info.version = 2;
+    version_info.version_hash = 0;
+    request.partition_version_infos.push_back(version_info);
+    request.__set_strict_mode(true);
+    std::vector<TTabletId> error_tablet_ids;
+    EnginePublishVersionTask task(request, &error_tablet_ids);
+    ASSERT_EQ(OLAP_SUCCESS, task.finish());
+    ASSERT_TRUE(error_tablet_ids.empty());
+    for (auto& tablet : _tablets) {
+        ASSERT_TRUE(tablet->check_version_exist(Version(2, 2)));
+    }
+}
+
+} // namespace starrocks
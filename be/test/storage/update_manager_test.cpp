@@ -6,6 +6,7 @@
 
 #include "runtime/mem_tracker.h"
 #include "storage/del_vector.h"
+#include "storage/del_vector_cache.h"
 #include "storage/kv_store.h"
 #include "storage/olap_define.h"
 #include "storage/rowset/rowset_factory.h"
@@ -146,6 +147,45 @@ TEST_F(UpdateManagerTest, testDelVec) {
     ASSERT_EQ(5, tmp->version());
 }
 
+TEST_F(UpdateManagerTest, testDelVecCacheEvict) {
+    MemTracker tracker(-1, "del_vec_cache");
+    DelVectorCache cache(&tracker);
+    DelVector empty;
+    std::vector<DelVectorPtr> delvecs;
+    for (uint32_t i = 0; i < 64; i++) {
+        DelVectorPtr delvec;
+        empty.add_dels_as_new_version({i, i + 100, i + 10000}, 2, &delvec);
+        delvecs.push_back(delvec);
+    }
+    const size_t charge = delvecs[0]->memory_usage();
+    // two entries per shard.
+    cache.set_capacity(charge * 2 * DelVectorCache::kNumShards);
+    TabletSegmentId tsid;
+    tsid.tablet_id = 1;
+    for (uint32_t i = 0; i < delvecs.size(); i++) {
+        tsid.segment_id = i;
+        ASSERT_TRUE(cache.set(tsid, delvecs[i]).ok());
+    }
+    ASSERT_LE(cache.memory_usage(), charge * 2 * DelVectorCache::kNumShards);
+    ASSERT_LT(cache.size(), delvecs.size());
+    ASSERT_EQ(cache.memory_usage(), tracker.consumption());
+    // the evicted ones are still valid for the holders.
+    ASSERT_EQ(3, delvecs[0]->cardinality());
+
+    tsid.segment_id = 63;
+    ASSERT_EQ(delvecs[63], cache.get(tsid, 2));
+    ASSERT_EQ(nullptr, cache.get(tsid, 1));
+    ASSERT_FALSE(cache.set(tsid, delvecs[62]).ok());
+    DelVectorPtr delvec3;
+    delvecs[63]->add_dels_as_new_version({1}, 3, &delvec3);
+    ASSERT_EQ(delvec3, cache.set_if_newer(tsid, delvec3));
+    ASSERT_EQ(delvec3, cache.set_if_newer(tsid, delvecs[63]));
+
+    cache.clear();
+    ASSERT_EQ(0, cache.size());
+    ASSERT_EQ(0, tracker.consumption());
+}
+
 TEST_F(UpdateManagerTest, testExpireEntry) {
     srand(time(NULL));
     create_tablet(rand(), rand());
@@ -8,6 +8,7 @@
 #include "column/field.h"
 #include "column/nullable_column.h"
 #include "column/schema.h"
+#include "common/config.h"
 #include "gtest/gtest.h"
 #include "runtime/descriptor_helper.h"
 #include "storage/row_block2.h"
@@ -253,5 +254,33 @@ TEST_F(ChunkHelperTest, NewChunkWithTuple) {
     ASSERT_EQ(chunk->get_column_by_slot_id(8)->get_name(), "binary");
 }
 
+TEST_F(ChunkHelperTest, AdaptiveChunkSize) {
+    auto schema = gen_v_schema(false);
+    // 1 + 2 + 4 + 8 + 16 + 4 + 8 + 16 + 16 bytes per row.
+    const size_t row_bytes = 75;
+
+    auto old_chunk_size = config::vector_chunk_size;
+    auto old_target_bytes = config::vector_chunk_target_bytes;
+    auto old_min_size = config::vector_chunk_min_size;
+    config::vector_chunk_size = 4096;
+    config::vector_chunk_min_size = 256;
+
+    config::vector_chunk_target_bytes = 0;
+    ASSERT_EQ(4096, ChunkHelper::adaptive_chunk_size(*schema));
+
+    config::vector_chunk_target_bytes = row_bytes * 4096;
+    ASSERT_EQ(4096, ChunkHelper::adaptive_chunk_size(*schema));
+
+    config::vector_chunk_target_bytes = row_bytes * 1000;
+    ASSERT_EQ(512, ChunkHelper::adaptive_chunk_size(*schema));
+
+    config::vector_chunk_target_bytes = row_bytes * 10;
+    ASSERT_EQ(256, ChunkHelper::adaptive_chunk_size(*schema));
+
+    config::vector_chunk_size = old_chunk_size;
+    config::vector_chunk_target_bytes = old_target_bytes;
+    config::vector_chunk_min_size = old_min_size;
+}
+
 } // namespace vectorized
 } // namespace starrocks
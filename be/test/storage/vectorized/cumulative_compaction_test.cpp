@@ -36,13 +36,13 @@ public:
         rowset_writer_context->version_hash = 110;
     }
 
-    void create_tablet_schema(KeysType keys_type) {
+    void create_tablet_schema(KeysType keys_type, int num_value_columns = 1) {
         TabletSchemaPB tablet_schema_pb;
         tablet_schema_pb.set_keys_type(keys_type);
         tablet_schema_pb.set_num_short_key_columns(2);
         tablet_schema_pb.set_num_rows_per_row_block(1024);
         tablet_schema_pb.set_compress_kind(COMPRESS_NONE);
-        tablet_schema_pb.set_next_column_unique_id(4);
+        tablet_schema_pb.set_next_column_unique_id(3 + num_value_columns);
 
         ColumnPB* column_1 = tablet_schema_pb.add_column();
         column_1->set_unique_id(1);
@@ -64,15 +64,17 @@ public:
         column_2->set_is_nullable(false);
         column_2->set_is_bf_column(false);
 
-        ColumnPB* column_3 = tablet_schema_pb.add_column();
-        column_3->set_unique_id(3);
-        column_3->set_name("v1");
-        column_3->set_type("INT");
-        column_3->set_length(4);
-        column_3->set_is_key(false);
-        column_3->set_is_nullable(false);
-        column_3->set_is_bf_column(false);
-        column_3->set_aggregation("SUM");
+        for (int i = 0; i < num_value_columns; ++i) {
+            ColumnPB* column = tablet_schema_pb.add_column();
+            column->set_unique_id(3 + i);
+            column->set_name("v" + std::to_string(i + 1));
+            column->set_type("INT");
+            column->set_length(4);
+            column->set_is_key(false);
+            column->set_is_nullable(false);
+            column->set_is_bf_column(false);
+            column->set_aggregation("SUM");
+        }
 
         _tablet_schema.reset(new TabletSchema);
         _tablet_schema->init_from_pb(tablet_schema_pb);
@@ -108,8 +110,10 @@ public:
             row.set_field_content(0, reinterpret_cast<char*>(&field_0), _mem_pool.get());
             Slice field_1(test_data[i]);
             row.set_field_content(1, reinterpret_cast<char*>(&field_1), _mem_pool.get());
-            int32_t field_2 = 10000 + i;
-            row.set_field_content(2, reinterpret_cast<char*>(&field_2), _mem_pool.get());
+            for (size_t cid = 2; cid < _tablet_schema->num_columns(); ++cid) {
+                int32_t field_value = 10000 * (cid - 1) + i;
+                row.set_field_content(cid, reinterpret_cast<char*>(&field_value), _mem_pool.get());
+            }
             writer->add_row(row);
         }
     }
@@ -244,4 +248,123 @@ TEST_F(CumulativeCompactionTest, test_compact_succeed) {
     ASSERT_TRUE(cumulative_compaction.compact().ok());
 }
 
+TEST_F(CumulativeCompactionTest, test_compact_succeed_vertically) {
+    config::storage_format_version = 2;
+    config::enable_vertical_compaction = true;
+    config::vertical_compaction_max_columns_per_group = 2;
+    create_tablet_schema(AGG_KEYS, 5);
+
+    RowsetWriterContext rowset_writer_context(kDataFormatUnknown, config::storage_format_version);
+    create_rowset_writer_context(&rowset_writer_context);
+    std::unique_ptr<RowsetWriter> _rowset_writer;
+    ASSERT_TRUE(RowsetFactory::create_rowset_writer(rowset_writer_context, &_rowset_writer).ok());
+
+    rowset_writer_add_rows(_rowset_writer);
+
+    _rowset_writer->flush();
+    RowsetSharedPtr src_rowset = _rowset_writer->build();
+    ASSERT_TRUE(src_rowset != nullptr);
+    RowsetId src_rowset_id;
+    src_rowset_id.init(10000);
+    ASSERT_EQ(src_rowset_id, src_rowset->rowset_id());
+    ASSERT_EQ(1024, src_rowset->num_rows());
+
+    TabletMetaSharedPtr tablet_meta = std::make_shared<TabletMeta>(_tablet_meta_mem_tracker.get());
+    create_tablet_meta(tablet_meta.get());
+    tablet_meta->add_rs_meta(src_rowset->rowset_meta());
+
+    {
+        RowsetId src_rowset_id;
+        src_rowset_id.init(10001);
+        rowset_writer_context.rowset_id = src_rowset_id;
+        rowset_writer_context.version =
+                Version(rowset_writer_context.version.second + 1, rowset_writer_context.version.second + 1);
+
+        std::unique_ptr<RowsetWriter> _rowset_writer;
+        ASSERT_TRUE(RowsetFactory::create_rowset_writer(rowset_writer_context, &_rowset_writer).ok());
+
+        rowset_writer_add_rows(_rowset_writer);
+
+        _rowset_writer->flush();
+        RowsetSharedPtr src_rowset = _rowset_writer->build();
+        ASSERT_TRUE(src_rowset != nullptr);
+        ASSERT_EQ(src_rowset_id, src_rowset->rowset_id());
+        ASSERT_EQ(1024, src_rowset->num_rows());
+
+        tablet_meta->add_rs_meta(src_rowset->rowset_meta());
+    }
+
+    TabletSharedPtr tablet =
+            Tablet::create_tablet_from_meta(_tablet_meta_mem_tracker.get(), tablet_meta,
+                                            starrocks::ExecEnv::GetInstance()->storage_engine()->get_stores()[0]);
+    tablet->init();
+
+    config::cumulative_compaction_skip_window_seconds = -2;
+
+    CumulativeCompaction cumulative_compaction(_compaction_mem_tracker.get(), tablet);
+
+    ASSERT_TRUE(cumulative_compaction.compact().ok());
+    ASSERT_EQ(1024, tablet->num_rows());
+}
+
+TEST_F(CumulativeCompactionTest, test_compact_succeed_by_key_ranges) {
+    config::storage_format_version = 2;
+    config::compaction_key_range_split_min_bytes = 0;
+    config::compaction_max_key_ranges = 4;
+    create_tablet_schema(AGG_KEYS);
+
+    RowsetWriterContext rowset_writer_context(kDataFormatUnknown, config::storage_format_version);
+    create_rowset_writer_context(&rowset_writer_context);
+    std::unique_ptr<RowsetWriter> _rowset_writer;
+    ASSERT_TRUE(RowsetFactory::create_rowset_writer(rowset_writer_context, &_rowset_writer).ok());
+
+    rowset_writer_add_rows(_rowset_writer);
+
+    _rowset_writer->flush();
+    RowsetSharedPtr src_rowset = _rowset_writer->build();
+    ASSERT_TRUE(src_rowset != nullptr);
+    RowsetId src_rowset_id;
+    src_rowset_id.init(10000);
+    ASSERT_EQ(src_rowset_id, src_rowset->rowset_id());
+    ASSERT_EQ(1024, src_rowset->num_rows());
+
+    TabletMetaSharedPtr tablet_meta = std::make_shared<TabletMeta>(_tablet_meta_mem_tracker.get());
+    create_tablet_meta(tablet_meta.get());
+    tablet_meta->add_rs_meta(src_rowset->rowset_meta());
+
+    {
+        RowsetId src_rowset_id;
+        src_rowset_id.init(10001);
+        rowset_writer_context.rowset_id = src_rowset_id;
+        rowset_writer_context.version =
+                Version(rowset_writer_context.version.second + 1, rowset_writer_context.version.second + 1);
+
+        std::unique_ptr<RowsetWriter> _rowset_writer;
+        ASSERT_TRUE(RowsetFactory::create_rowset_writer(rowset_writer_context, &_rowset_writer).ok());
+
+        rowset_writer_add_rows(_rowset_writer);
+
+        _rowset_writer->flush();
+        RowsetSharedPtr src_rowset = _rowset_writer->build();
+        ASSERT_TRUE(src_rowset != nullptr);
+        ASSERT_EQ(src_rowset_id, src_rowset->rowset_id());
+        ASSERT_EQ(1024, src_rowset->num_rows());
+
+        tablet_meta->add_rs_meta(src_rowset->rowset_meta());
+    }
+
+    TabletSharedPtr tablet =
+            Tablet::create_tablet_from_meta(_tablet_meta_mem_tracker.get(), tablet_meta,
+                                            starrocks::ExecEnv::GetInstance()->storage_engine()->get_stores()[0]);
+    tablet->init();
+
+    config::cumulative_compaction_skip_window_seconds = -2;
+
+    CumulativeCompaction cumulative_compaction(_compaction_mem_tracker.get(), tablet);
+
+    ASSERT_TRUE(cumulative_compaction.compact().ok());
+    ASSERT_EQ(1024, tablet->num_rows());
+    config::compaction_key_range_split_min_bytes = 10737418240;
+}
+
 } // namespace starrocks::vectorized
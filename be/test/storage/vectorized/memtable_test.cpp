@@ -309,6 +309,131 @@ TEST_F(MemTableTest, testUniqKeysInsertFlushRead) {
     ASSERT_EQ(n, pkey_read);
 }
 
+TEST_F(MemTableTest, testUniqKeysMergeSortedRuns) {
+    const string path = "./ut_dir/MemTableTest_testUniqKeysMergeSortedRuns";
+    MySetUp("pk int,name varchar,pv int", "pk int,name varchar,pv int", 1, KeysType::UNIQUE_KEYS, path);
+    const size_t n = 1000;
+    auto pchunk = gen_chunk(*_slots, n);
+    // every insert is merged into a sorted run, the keys of the runs overlap.
+    auto old_write_buffer_size = config::write_buffer_size;
+    config::write_buffer_size = 1;
+    for (int run = 0; run < 4; run++) {
+        vector<uint32_t> indexes;
+        for (int i = run * 100; i < n; i++) {
+            indexes.emplace_back(i);
+        }
+        std::random_shuffle(indexes.begin(), indexes.end());
+        _mem_table->insert(pchunk.get(), indexes.data(), 0, indexes.size());
+    }
+    config::write_buffer_size = old_write_buffer_size;
+    ASSERT_TRUE(_mem_table->finalize().ok());
+    ASSERT_EQ(OLAP_SUCCESS, _mem_table->flush());
+    RowsetSharedPtr rowset = _writer->build();
+    unique_ptr<Schema> read_schema = create_schema("pk int", 1);
+    OlapReaderStatistics stats;
+    vectorized::RowsetReadOptions rs_opts;
+    rs_opts.sorted = false;
+    rs_opts.use_page_cache = false;
+    rs_opts.stats = &stats;
+    auto itr = rowset->new_iterator(*read_schema, rs_opts);
+    ASSERT_TRUE(itr.ok()) << itr.status().to_string();
+    std::shared_ptr<vectorized::Chunk> chunk = vectorized::ChunkHelper::new_chunk(*read_schema, 4096);
+    size_t pkey_read = 0;
+    int last_value = 0;
+    while (true) {
+        Status st = (*itr)->get_next(chunk.get());
+        if (st.is_end_of_file()) {
+            break;
+        }
+        auto column = chunk->get_column_by_name("pk");
+        for (size_t i = 0; i < column->size(); i++) {
+            int new_value = column->get(i).get_int32();
+            ASSERT_LT(last_value, new_value);
+            last_value = new_value;
+        }
+        pkey_read += chunk->num_rows();
+        chunk->reset();
+    }
+    ASSERT_EQ(n, pkey_read);
+}
+
+// Returns the number of the keys of |rowset|, which are checked in strictly ascending order.
+static size_t read_unique_sorted_keys(const RowsetSharedPtr& rowset) {
+    unique_ptr<Schema> read_schema = create_schema("pk int", 1);
+    OlapReaderStatistics stats;
+    vectorized::RowsetReadOptions rs_opts;
+    rs_opts.sorted = false;
+    rs_opts.use_page_cache = false;
+    rs_opts.stats = &stats;
+    auto itr = rowset->new_iterator(*read_schema, rs_opts);
+    CHECK(itr.ok()) << itr.status().to_string();
+    std::shared_ptr<vectorized::Chunk> chunk = vectorized::ChunkHelper::new_chunk(*read_schema, 4096);
+    size_t pkey_read = 0;
+    int last_value = 0;
+    while (true) {
+        Status st = (*itr)->get_next(chunk.get());
+        if (st.is_end_of_file()) {
+            break;
+        }
+        auto column = chunk->get_column_by_name("pk");
+        for (size_t i = 0; i < column->size(); i++) {
+            int new_value = column->get(i).get_int32();
+            CHECK_LT(last_value, new_value);
+            last_value = new_value;
+        }
+        pkey_read += chunk->num_rows();
+        chunk->reset();
+    }
+    return pkey_read;
+}
+
+TEST_F(MemTableTest, testUniqKeysInputSorted) {
+    const string path = "./ut_dir/MemTableTest_testUniqKeysInputSorted";
+    MySetUp("pk int,name varchar,pv int", "pk int,name varchar,pv int", 1, KeysType::UNIQUE_KEYS, path);
+    _mem_table->set_input_sorted(true);
+    const size_t n = 1000;
+    auto pchunk = gen_chunk(*_slots, n);
+    // every insert is merged into a run, the last key of a run is the first key of the next one.
+    auto old_write_buffer_size = config::write_buffer_size;
+    config::write_buffer_size = 1;
+    for (int run = 0; run < 4; run++) {
+        vector<uint32_t> indexes;
+        for (int i = run * 250; i <= std::min<int>((run + 1) * 250, n - 1); i++) {
+            indexes.emplace_back(i);
+        }
+        _mem_table->insert(pchunk.get(), indexes.data(), 0, indexes.size());
+    }
+    config::write_buffer_size = old_write_buffer_size;
+    ASSERT_TRUE(_mem_table->finalize().ok());
+    ASSERT_EQ(OLAP_SUCCESS, _mem_table->flush());
+    ASSERT_EQ(n, read_unique_sorted_keys(_writer->build()));
+}
+
+TEST_F(MemTableTest, testUniqKeysInputNotSorted) {
+    const string path = "./ut_dir/MemTableTest_testUniqKeysInputNotSorted";
+    MySetUp("pk int,name varchar,pv int", "pk int,name varchar,pv int", 1, KeysType::UNIQUE_KEYS, path);
+    // the rows out of order are sorted as usual.
+    _mem_table->set_input_sorted(true);
+    const size_t n = 1000;
+    auto pchunk = gen_chunk(*_slots, n);
+    auto old_write_buffer_size = config::write_buffer_size;
+    config::write_buffer_size = 1;
+    for (int run = 0; run < 4; run++) {
+        vector<uint32_t> indexes;
+        for (int i = run * 100; i < n; i++) {
+            indexes.emplace_back(i);
+        }
+        if (run == 2) {
+            std::random_shuffle(indexes.begin(), indexes.end());
+        }
+        _mem_table->insert(pchunk.get(), indexes.data(), 0, indexes.size());
+    }
+    config::write_buffer_size = old_write_buffer_size;
+    ASSERT_TRUE(_mem_table->finalize().ok());
+    ASSERT_EQ(OLAP_SUCCESS, _mem_table->flush());
+    ASSERT_EQ(n, read_unique_sorted_keys(_writer->build()));
+}
+
 TEST_F(MemTableTest, testPrimaryKeysWithDeletes) {
     const string path = "./ut_dir/MemTableTest_testPrimaryKeysWithDeletes";
     MySetUp("pk bigint,v1 int", "pk bigint,v1 int,__op tinyint", 1, KeysType::PRIMARY_KEYS, path);
@@ -4,6 +4,8 @@
 
 #include <algorithm>
 #include <memory>
+#include <random>
+#include <tuple>
 #include <vector>
 
 #include "column/column_pool.h"
@@ -138,4 +140,56 @@ TEST_F(MergeIteratorTest, test_issue_DSDB_2715) {
     iter->close();
 }
 
+// NOLINTNEXTLINE
+TEST_F(MergeIteratorTest, merge_many_by_string_prefix) {
+    auto k1 = std::make_shared<Field>(0, "k1", get_type_info(OLAP_FIELD_TYPE_VARCHAR), false);
+    auto k2 = std::make_shared<Field>(1, "k2", get_type_info(OLAP_FIELD_TYPE_INT), false);
+    auto v = std::make_shared<Field>(2, "v", get_type_info(OLAP_FIELD_TYPE_INT), false);
+    k1->set_is_key(true);
+    k2->set_is_key(true);
+    Schema schema(std::vector<FieldPtr>{k1, k2, v});
+
+    // the strings share the first 8 bytes or differ in them, some are the prefixes of the others.
+    std::vector<std::string> strings{"",          "a",         std::string("a\0", 2), "abcdefgh",
+                                     "abcdefgh1", "abcdefgh2", "abcdefgi",             "b"};
+    const int num_children = 7;
+    std::vector<std::tuple<std::string, int32_t, int32_t>> expected;
+    std::vector<ChunkIteratorPtr> children;
+    std::mt19937 rand(2021);
+    for (int32_t child = 0; child < num_children; child++) {
+        std::vector<std::pair<std::string, int32_t>> keys;
+        const int num_rows = child == 3 ? 0 : 50;
+        for (int i = 0; i < num_rows; i++) {
+            keys.emplace_back(strings[rand() % strings.size()], static_cast<int32_t>(rand() % 4));
+        }
+        std::sort(keys.begin(), keys.end());
+        Datums c1;
+        Datums c2;
+        Datums c3;
+        for (const auto& [s, n] : keys) {
+            c1.emplace_back(Slice(*std::find(strings.begin(), strings.end(), s)));
+            c2.emplace_back(n);
+            c3.emplace_back(child);
+            expected.emplace_back(s, n, child);
+        }
+        auto iter = std::make_shared<VectorChunkIterator>(schema, c1, c2, c3);
+        iter->chunk_size(1 + child % 4);
+        children.emplace_back(iter);
+    }
+    // the equal keys come in the order of the children.
+    std::sort(expected.begin(), expected.end());
+
+    auto iter = new_merge_iterator(children);
+    std::vector<std::tuple<std::string, int32_t, int32_t>> real;
+    ChunkPtr chunk = ChunkHelper::new_chunk(iter->schema(), 5);
+    while (iter->get_next(chunk.get()).ok()) {
+        for (size_t i = 0; i < chunk->num_rows(); i++) {
+            auto row = chunk->get(i);
+            real.emplace_back(row[0].get_slice().to_string(), row[1].get_int32(), row[2].get_int32());
+        }
+        chunk->reset();
+    }
+    ASSERT_EQ(expected, real);
+}
+
 } // namespace starrocks::vectorized
@@ -0,0 +1,218 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "storage/vectorized/meta_reader.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "column/fixed_length_column.h"
+#include "common/config.h"
+#include "storage/rowset/rowset_factory.h"
+#include "storage/rowset/rowset_writer.h"
+#include "storage/rowset/rowset_writer_context.h"
+#include "storage/storage_engine.h"
+#include "storage/tablet_manager.h"
+#include "storage/tablet_updates.h"
+#include "storage/vectorized/chunk_helper.h"
+
+namespace starrocks::vectorized {
+
+class MetaReaderTest : public testing::Test {
+public:
+    void SetUp() override {
+        TCreateTabletReq request;
+        request.tablet_id = 13001;
+        request.__set_version(1);
+        request.__set_version_hash(0);
+        request.tablet_schema.schema_hash = 1111;
+        request.tablet_schema.short_key_column_count = 1;
+        request.tablet_schema.keys_type = TKeysType::PRIMARY_KEYS;
+        request.tablet_schema.storage_type = TStorageType::COLUMN;
+
+        TColumn pk;
+        pk.column_name = "pk";
+        pk.__set_is_key(true);
+        pk.column_type.type = TPrimitiveType::BIGINT;
+        request.tablet_schema.columns.push_back(pk);
+
+        TColumn v1;
+        v1.column_name = "v1";
+        v1.__set_is_key(false);
+        v1.__set_is_allow_null(true);
+        v1.column_type.type = TPrimitiveType::INT;
+        request.tablet_schema.columns.push_back(v1);
+        auto st = StorageEngine::instance()->create_tablet(request);
+        ASSERT_TRUE(st.ok()) << st.to_string();
+        _tablet = StorageEngine::instance()->tablet_manager()->get_tablet(request.tablet_id,
+                                                                          request.tablet_schema.schema_hash);
+        ASSERT_TRUE(_tablet != nullptr);
+    }
+
+    void TearDown() override {
+        if (_tablet != nullptr) {
+            StorageEngine::instance()->tablet_manager()->drop_tablet(_tablet->tablet_id(), _tablet->schema_hash(),
+                                                                     false);
+            _tablet.reset();
+        }
+    }
+
+protected:
+    // commit a rowset of the rows of |keys|, whose v1 is the key or null if |null_even_keys| and the key is even,
+    // which deletes |deletes|.
+    void _commit(int64_t version, const std::vector<int64_t>& keys, bool null_even_keys,
+                 const std::vector<int64_t>& deletes = {}) {
+        RowsetWriterContext writer_context(kDataFormatV2, config::storage_format_version);
+        writer_context.rowset_id = StorageEngine::instance()->next_rowset_id();
+        writer_context.tablet_id = _tablet->tablet_id();
+        writer_context.tablet_schema_hash = _tablet->schema_hash();
+        writer_context.partition_id = 0;
+        writer_context.rowset_type = BETA_ROWSET;
+        writer_context.rowset_path_prefix = _tablet->tablet_path();
+        writer_context.rowset_state = COMMITTED;
+        writer_context.tablet_schema = &_tablet->tablet_schema();
+        writer_context.version.first = 0;
+        writer_context.version.second = 0;
+        writer_context.segments_overlap = NONOVERLAPPING;
+        std::unique_ptr<RowsetWriter> writer;
+        ASSERT_TRUE(RowsetFactory::create_rowset_writer(writer_context, &writer).ok());
+        auto schema = ChunkHelper::convert_schema(_tablet->tablet_schema());
+        auto chunk = ChunkHelper::new_chunk(schema, keys.size());
+        for (int64_t key : keys) {
+            chunk->get_column_by_index(0)->append_datum(Datum(key));
+            if (null_even_keys && key % 2 == 0) {
+                chunk->get_column_by_index(1)->append_nulls(1);
+            } else {
+                chunk->get_column_by_index(1)->append_datum(Datum(static_cast<int32_t>(key)));
+            }
+        }
+        if (deletes.empty()) {
+            ASSERT_EQ(OLAP_SUCCESS, writer->flush_chunk(*chunk));
+        } else {
+            Int64Column delete_keys;
+            delete_keys.append_numbers(deletes.data(), deletes.size() * sizeof(int64_t));
+            ASSERT_EQ(OLAP_SUCCESS, writer->flush_chunk_with_deletes(*chunk, delete_keys));
+        }
+        auto rowset = writer->build();
+        ASSERT_TRUE(rowset != nullptr);
+        ASSERT_TRUE(_tablet->rowset_commit(version, rowset).ok());
+    }
+
+    // the segments of the meta scan at |version|, and the rows deleted from each of them.
+    void _get_segments(int64_t version, MetaReader* reader, std::vector<segment_v2::SegmentSharedPtr>* segments) {
+        reader->_version = Version(0, version);
+        ASSERT_TRUE(reader->_get_segments(_tablet, reader->_version, segments).ok());
+        ASSERT_EQ(segments->size(), reader->_num_deleted_rows.size());
+    }
+
+    // collect |field| of v1 from |segment|, into |column| of the type of the result.
+    static Status _collect(const segment_v2::SegmentSharedPtr& segment, size_t num_deleted_rows,
+                           const std::string& field, Column* column) {
+        SegmentMetaCollecterParams params;
+        params.fields.emplace_back(field);
+        params.cids.emplace_back(1);
+        params.read_page.emplace_back(false);
+        params.field_type.emplace_back(OLAP_FIELD_TYPE_INT);
+        params.max_cid = 1;
+        SegmentMetaCollecter collecter(segment, num_deleted_rows);
+        RETURN_IF_ERROR(collecter.init(&params));
+        std::vector<Column*> dsts{column};
+        return collecter.collect(&dsts);
+    }
+
+    static bool _has_null(const segment_v2::SegmentSharedPtr& segment) {
+        return segment->column(1)->segment_zone_map()->has_null();
+    }
+
+    static std::vector<int64_t> _range(int64_t begin, int64_t end) {
+        std::vector<int64_t> keys;
+        for (int64_t key = begin; key < end; key++) {
+            keys.push_back(key);
+        }
+        return keys;
+    }
+
+    TabletSharedPtr _tablet;
+};
+
+// NOLINTNEXTLINE
+TEST_F(MetaReaderTest, test_primary_key_tablet_with_deletes) {
+    // version 2: the rows 0..9, version 3: the rows 10..19 of which the even ones are null, version 4: the rows
+    // 20..29, version 5: delete the rows 0..9 and 25, version 6: delete the row 11.
+    _commit(2, _range(0, 10), false);
+    _commit(3, _range(10, 20), true);
+    _commit(4, _range(20, 30), false);
+    std::vector<int64_t> deletes = _range(0, 10);
+    deletes.push_back(25);
+    _commit(5, {}, false, deletes);
+    _commit(6, {}, false, {11});
+
+    {
+        MetaReader reader;
+        std::vector<segment_v2::SegmentSharedPtr> segments;
+        _get_segments(4, &reader, &segments);
+        ASSERT_EQ(3, segments.size());
+        std::vector<int64_t> counts;
+        for (size_t i = 0; i < segments.size(); i++) {
+            ASSERT_EQ(0, reader._num_deleted_rows[i]);
+            Int64Column count;
+            ASSERT_TRUE(_collect(segments[i], reader._num_deleted_rows[i], "count", &count).ok());
+            counts.push_back(count.get_data()[0]);
+        }
+        std::sort(counts.begin(), counts.end());
+        // the nulls are not counted.
+        ASSERT_EQ((std::vector<int64_t>{5, 10, 10}), counts);
+    }
+
+    {
+        MetaReader reader;
+        std::vector<segment_v2::SegmentSharedPtr> segments;
+        _get_segments(5, &reader, &segments);
+        // the segment of version 2 is all deleted, and the rowset of the deletes has no rows.
+        ASSERT_EQ(2, segments.size());
+        for (size_t i = 0; i < segments.size(); i++) {
+            size_t num_deleted_rows = reader._num_deleted_rows[i];
+            Int64Column count;
+            Int32Column max;
+            Int32Column min;
+            ASSERT_TRUE(_collect(segments[i], num_deleted_rows, "count", &count).ok());
+            if (_has_null(segments[i])) {
+                ASSERT_EQ(0, num_deleted_rows);
+                ASSERT_EQ(5, count.get_data()[0]);
+                ASSERT_TRUE(_collect(segments[i], num_deleted_rows, "max", &max).ok());
+                ASSERT_EQ(19, max.get_data()[0]);
+            } else {
+                // the row 25 is deleted.
+                ASSERT_EQ(1, num_deleted_rows);
+                ASSERT_EQ(9, count.get_data()[0]);
+                // the zone map still covers the deleted row.
+                ASSERT_TRUE(_collect(segments[i], num_deleted_rows, "max", &max).is_not_supported());
+                ASSERT_TRUE(_collect(segments[i], num_deleted_rows, "min", &min).is_not_supported());
+                ASSERT_TRUE(max.empty());
+                ASSERT_TRUE(min.empty());
+            }
+        }
+    }
+
+    {
+        MetaReader reader;
+        std::vector<segment_v2::SegmentSharedPtr> segments;
+        _get_segments(6, &reader, &segments);
+        ASSERT_EQ(2, segments.size());
+        for (size_t i = 0; i < segments.size(); i++) {
+            Int64Column count;
+            Status st = _collect(segments[i], reader._num_deleted_rows[i], "count", &count);
+            ASSERT_EQ(1, reader._num_deleted_rows[i]);
+            if (_has_null(segments[i])) {
+                // the deleted rows may be the nulls.
+                ASSERT_TRUE(st.is_not_supported()) << st.to_string();
+            } else {
+                ASSERT_TRUE(st.ok()) << st.to_string();
+                ASSERT_EQ(9, count.get_data()[0]);
+            }
+        }
+    }
+}
+
+} // namespace starrocks::vectorized
@@ -89,6 +89,34 @@ class SchemaChangeTest : public testing::Test {
         ASSERT_TRUE(tablet->add_rowset(new_rowset, false).ok());
     }
 
+    // add a rowset of 4 rows of (k1, k2, v1) in the descending order of k2 to |tablet| at |version|.
+    void AddRowset(const TabletSharedPtr& tablet, int64_t version) {
+        vectorized::Schema schema = ChunkHelper::convert_schema_to_format_v2(tablet->tablet_schema());
+        ChunkPtr chunk = ChunkHelper::new_chunk(schema, config::vector_chunk_size);
+        for (int32_t j = 0; j < 4; ++j) {
+            chunk->get_column_by_index(0)->append_datum(Datum((int32_t)version));
+            chunk->get_column_by_index(1)->append_datum(Datum(4 - j));
+            chunk->get_column_by_index(2)->append_datum(Datum(j));
+        }
+        RowsetWriterContext writer_context(kDataFormatUnknown, kDataFormatV2);
+        writer_context.rowset_id = StorageEngine::instance()->next_rowset_id();
+        writer_context.tablet_uid = tablet->tablet_uid();
+        writer_context.tablet_id = tablet->tablet_id();
+        writer_context.tablet_schema_hash = tablet->schema_hash();
+        writer_context.rowset_path_prefix = tablet->tablet_path();
+        writer_context.tablet_schema = &(tablet->tablet_schema());
+        writer_context.rowset_state = VISIBLE;
+        writer_context.version = Version(version, version);
+        writer_context.version_hash = 0;
+        std::unique_ptr<RowsetWriter> rowset_writer;
+        ASSERT_TRUE(RowsetFactory::create_rowset_writer(writer_context, &rowset_writer).ok());
+        ASSERT_EQ(OLAP_SUCCESS, rowset_writer->add_chunk(*chunk));
+        ASSERT_EQ(OLAP_SUCCESS, rowset_writer->flush());
+        RowsetSharedPtr rowset = rowset_writer->build();
+        ASSERT_TRUE(rowset != nullptr);
+        ASSERT_TRUE(tablet->add_rowset(rowset, false).ok());
+    }
+
     void SetTabletSchema(const std::string& name, const std::string& type, const std::string& aggregation,
                          uint32_t length, bool is_allow_null, bool is_key, TabletSchema* tablet_schema) {
         TabletSchemaPB tablet_schema_pb;
@@ -538,4 +566,75 @@ TEST_F(SchemaChangeTest, schema_change_with_sorting) {
     (void)StorageEngine::instance()->tablet_manager()->drop_tablet(1002, 270068375);
 }
 
+TEST_F(SchemaChangeTest, convert_historical_rowsets_in_parallel) {
+    StorageEngine* engine = StorageEngine::instance();
+    TCreateTabletReq base_tablet_req;
+    SetCreateTabletReq(&base_tablet_req, 1101);
+    AddColumn(&base_tablet_req, "k1", TPrimitiveType::INT, true);
+    AddColumn(&base_tablet_req, "k2", TPrimitiveType::INT, true);
+    AddColumn(&base_tablet_req, "v1", TPrimitiveType::INT, false);
+    ASSERT_TRUE(engine->create_tablet(base_tablet_req).ok());
+    TabletSharedPtr base_tablet = engine->tablet_manager()->get_tablet(1101, 270068375);
+    for (int64_t version = 2; version <= 5; ++version) {
+        AddRowset(base_tablet, version);
+    }
+    // the order of the keys is changed, so the rowsets are converted with sorting.
+    TCreateTabletReq new_tablet_req;
+    SetCreateTabletReq(&new_tablet_req, 1102);
+    AddColumn(&new_tablet_req, "k2", TPrimitiveType::INT, true);
+    AddColumn(&new_tablet_req, "k1", TPrimitiveType::INT, true);
+    AddColumn(&new_tablet_req, "v1", TPrimitiveType::INT, false);
+    ASSERT_TRUE(engine->create_tablet(new_tablet_req).ok());
+    TabletSharedPtr new_tablet = engine->tablet_manager()->get_tablet(1102, 270068375);
+
+    SchemaChangeHandler::SchemaChangeParams sc_params;
+    sc_params.base_tablet = base_tablet;
+    sc_params.new_tablet = new_tablet;
+    sc_params.version = Version(0, 5);
+    vectorized::Schema base_schema = ChunkHelper::convert_schema_to_format_v2(base_tablet->tablet_schema());
+    for (int64_t version = 2; version <= 5; ++version) {
+        RowsetSharedPtr rowset = base_tablet->get_rowset_by_version(Version(version, version));
+        ASSERT_TRUE(rowset != nullptr);
+        auto reader = std::make_unique<TabletReader>(base_tablet, rowset->version(), base_schema,
+                                                     std::vector<RowsetSharedPtr>{rowset});
+        ASSERT_TRUE(reader->prepare().ok());
+        sc_params.rowsets_to_change.push_back(rowset);
+        sc_params.rowset_readers.emplace_back(std::move(reader));
+    }
+
+    int32_t old_parallel_rowsets = config::schema_change_max_parallel_rowsets;
+    config::schema_change_max_parallel_rowsets = 3;
+    Status st = SchemaChangeHandler::_convert_historical_rowsets(sc_params);
+    config::schema_change_max_parallel_rowsets = old_parallel_rowsets;
+    ASSERT_TRUE(st.ok()) << st.to_string();
+    for (int64_t version = 2; version <= 5; ++version) {
+        RowsetSharedPtr rowset = new_tablet->get_rowset_by_version(Version(version, version));
+        ASSERT_TRUE(rowset != nullptr) << version;
+        ASSERT_EQ(4, rowset->num_rows()) << version;
+    }
+    (void)engine->tablet_manager()->drop_tablet(1101, 270068375);
+    (void)engine->tablet_manager()->drop_tablet(1102, 270068375);
+}
+
+TEST_F(SchemaChangeTest, split_sorting_memory_across_workers) {
+    TabletSchema tablet_schema;
+    SetTabletSchema("k1", "INT", "NONE", 4, false, true, &tablet_schema);
+    ChunkChanger chunk_changer(tablet_schema);
+    size_t memory_limitation = config::memory_limitation_per_thread_for_schema_change * 1024L * 1024 * 1024;
+
+    auto sc_procedure = SchemaChangeHandler::_create_sc_procedure(_mem_tracker, chunk_changer, true, false, 1);
+    auto* sorting = dynamic_cast<SchemaChangeWithSorting*>(sc_procedure.get());
+    ASSERT_TRUE(sorting != nullptr);
+    ASSERT_EQ(memory_limitation, sorting->_memory_limitation);
+
+    // each of the 4 workers sorts with a quarter of the memory.
+    sc_procedure = SchemaChangeHandler::_create_sc_procedure(_mem_tracker, chunk_changer, true, false, 4);
+    sorting = dynamic_cast<SchemaChangeWithSorting*>(sc_procedure.get());
+    ASSERT_TRUE(sorting != nullptr);
+    ASSERT_EQ(memory_limitation / 4, sorting->_memory_limitation);
+
+    sc_procedure = SchemaChangeHandler::_create_sc_procedure(_mem_tracker, chunk_changer, false, true, 4);
+    ASSERT_TRUE(dynamic_cast<SchemaChangeDirectly*>(sc_procedure.get()) != nullptr);
+}
+
 } // namespace starrocks::vectorized
\ No newline at end of file
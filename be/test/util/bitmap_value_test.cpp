@@ -66,6 +66,35 @@ TEST(BitmapValueTest, bitmap_union) {
     ASSERT_EQ(5, bitmap2.cardinality());
 }
 
+TEST(BitmapValueTest, bitmap_fastunion) {
+    BitmapValue empty;
+    BitmapValue single(1024);
+    BitmapValue set;
+    set.add(1);
+    set.add(2);
+    BitmapValue bitmap({1024, 1025, 1026, (1ull << 40) + 1});
+    BitmapValue bitmap2({3, (1ull << 40) + 1, (1ull << 40) + 2});
+
+    // only small values
+    BitmapValue small;
+    small.fastunion({&empty, &single, &set});
+    ASSERT_EQ(3, small.cardinality());
+
+    BitmapValue result(7);
+    result.fastunion({&empty, &single, &set, &bitmap, &bitmap2});
+    ASSERT_EQ(BitmapValue::BITMAP, result._type);
+    ASSERT_EQ(9, result.cardinality());
+    for (uint64_t v : {1ull, 2ull, 3ull, 7ull, 1024ull, 1025ull, 1026ull, (1ull << 40) + 1, (1ull << 40) + 2}) {
+        ASSERT_TRUE(result.contains(v));
+    }
+
+    // union into a bitmap
+    result.fastunion({&single, &bitmap2, &set});
+    ASSERT_EQ(9, result.cardinality());
+    result.fastunion({});
+    ASSERT_EQ(9, result.cardinality());
+}
+
 TEST(BitmapValueTest, bitmap_intersect) {
     BitmapValue empty;
     BitmapValue single(1024);
@@ -165,4 +165,77 @@ TEST_F(BlockCompressionTest, multi) {
     test_multi_slices(starrocks::CompressionTypePB::ZSTD);
 }
 
+TEST_F(BlockCompressionTest, zstd_level) {
+    std::string orig;
+    for (int i = 0; i < 10000; i++) {
+        orig.append("value_" + std::to_string(i % 1000) + ",");
+    }
+    size_t sizes[2];
+    int levels[2] = {1, 19};
+    for (int i = 0; i < 2; i++) {
+        const BlockCompressionCodec* codec = nullptr;
+        ASSERT_TRUE(get_block_compression_codec(starrocks::CompressionTypePB::ZSTD, levels[i], &codec).ok());
+        std::string compressed(codec->max_compressed_len(orig.size()), '\0');
+        Slice compressed_slice(compressed);
+        ASSERT_TRUE(codec->compress(orig, &compressed_slice).ok());
+        sizes[i] = compressed_slice.size;
+
+        // the blocks of any level are decompressed by the default codec
+        const BlockCompressionCodec* default_codec = nullptr;
+        ASSERT_TRUE(get_block_compression_codec(starrocks::CompressionTypePB::ZSTD, &default_codec).ok());
+        std::string uncompressed(orig.size(), '\0');
+        Slice uncompressed_slice(uncompressed);
+        ASSERT_TRUE(default_codec->decompress(compressed_slice, &uncompressed_slice).ok());
+        ASSERT_EQ(orig, uncompressed);
+    }
+    ASSERT_LE(sizes[1], sizes[0]);
+}
+
+TEST_F(BlockCompressionTest, zstd_dictionary) {
+    // small blocks sharing the same vocabulary
+    std::vector<std::string> blocks;
+    for (int i = 0; i < 1000; i++) {
+        std::string block;
+        for (int j = 0; j < 8; j++) {
+            block.append("{\"user\":\"user_" + std::to_string((i * 7 + j) % 50) + "\",\"event\":\"click\",\"page\":");
+            block.append(std::to_string(i * j) + "}");
+        }
+        blocks.emplace_back(std::move(block));
+    }
+    std::vector<Slice> samples(blocks.begin(), blocks.end());
+    std::string dict;
+    ASSERT_TRUE(train_zstd_dictionary(samples, 4096, &dict).ok());
+    ASSERT_GT(dict.size(), 0);
+    ASSERT_LE(dict.size(), 4096);
+
+    std::unique_ptr<BlockCompressionCodec> dict_codec;
+    ASSERT_TRUE(create_zstd_dict_codec(dict, 3, &dict_codec).ok());
+    const BlockCompressionCodec* codec = nullptr;
+    ASSERT_TRUE(get_block_compression_codec(starrocks::CompressionTypePB::ZSTD, &codec).ok());
+    size_t dict_size = 0;
+    size_t plain_size = 0;
+    for (const auto& block : blocks) {
+        std::string compressed(dict_codec->max_compressed_len(block.size()), '\0');
+        Slice compressed_slice(compressed);
+        ASSERT_TRUE(dict_codec->compress(block, &compressed_slice).ok());
+        dict_size += compressed_slice.size;
+
+        // decompressed by another codec of the same dictionary
+        std::unique_ptr<BlockCompressionCodec> reader_codec;
+        ASSERT_TRUE(create_zstd_dict_codec(dict, 0, &reader_codec).ok());
+        std::string uncompressed(block.size(), '\0');
+        Slice uncompressed_slice(uncompressed);
+        ASSERT_TRUE(reader_codec->decompress(compressed_slice, &uncompressed_slice).ok());
+        ASSERT_EQ(block, uncompressed);
+
+        compressed_slice = Slice(compressed);
+        ASSERT_TRUE(codec->compress(block, &compressed_slice).ok());
+        plain_size += compressed_slice.size;
+    }
+    ASSERT_LT(dict_size, plain_size);
+
+    // too few samples
+    ASSERT_FALSE(train_zstd_dictionary(std::vector<Slice>(samples.begin(), samples.begin() + 1), 4096, &dict).ok());
+}
+
 } // namespace starrocks
@@ -23,6 +23,8 @@
 
 #include <gtest/gtest.h>
 
+#include <set>
+
 namespace starrocks {
 
 class BrpcStubCacheTest : public testing::Test {
@@ -47,6 +49,26 @@ TEST_F(BrpcStubCacheTest, normal) {
     ASSERT_EQ(stub1, stub3);
 }
 
+TEST_F(BrpcStubCacheTest, multiple_connections) {
+    int32_t old_connections = config::brpc_connections_per_endpoint;
+    config::brpc_connections_per_endpoint = 3;
+    BrpcStubCache cache;
+    TNetworkAddress address;
+    address.hostname = "127.0.0.1";
+    address.port = 123;
+    std::set<doris::PBackendService_Stub*> stubs;
+    for (int i = 0; i < 6; ++i) {
+        auto stub = cache.get_stub(address);
+        ASSERT_NE(nullptr, stub);
+        stubs.insert(stub);
+    }
+    // The stubs of the endpoint are returned in round robin.
+    ASSERT_EQ(3, stubs.size());
+    address.port = 124;
+    ASSERT_EQ(0, stubs.count(cache.get_stub(address)));
+    config::brpc_connections_per_endpoint = old_connections;
+}
+
 TEST_F(BrpcStubCacheTest, invalid) {
     BrpcStubCache cache;
     TNetworkAddress address;
@@ -0,0 +1,108 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/ddsketch.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "util/percentile_value.h"
+
+namespace starrocks {
+
+// the value of the quantile q of the sorted values, by the same rank as DDSketch.
+static double exact_quantile(const std::vector<double>& sorted, double q) {
+    return sorted[static_cast<size_t>(q * (sorted.size() - 1))];
+}
+
+TEST(DDSketchTest, empty) {
+    DDSketch sketch;
+    ASSERT_TRUE(sketch.empty());
+    ASSERT_TRUE(std::isnan(sketch.quantile(0.5)));
+}
+
+TEST(DDSketchTest, relative_accuracy) {
+    std::mt19937 gen(0);
+    std::lognormal_distribution<double> dist(0, 2);
+    DDSketch sketch(0.01);
+    std::vector<double> values;
+    for (int i = 0; i < 100000; ++i) {
+        double v = dist(gen);
+        // some negative values and zeros.
+        if (i % 10 == 0) {
+            v = -v;
+        } else if (i % 97 == 0) {
+            v = 0;
+        }
+        values.push_back(v);
+        sketch.add(v);
+    }
+    std::sort(values.begin(), values.end());
+    ASSERT_EQ(values.size(), sketch.count());
+    for (double q : {0.0, 0.01, 0.1, 0.25, 0.5, 0.75, 0.9, 0.99, 0.999, 1.0}) {
+        double expected = exact_quantile(values, q);
+        ASSERT_NEAR(expected, sketch.quantile(q), std::abs(expected) * 0.01 + 1e-9) << q;
+    }
+}
+
+TEST(DDSketchTest, merge_and_serialize) {
+    std::mt19937 gen(1);
+    std::exponential_distribution<double> dist(0.01);
+    std::vector<double> values;
+    DDSketch merged(0.02);
+    for (int s = 0; s < 10; ++s) {
+        DDSketch sketch(0.02);
+        for (int i = 0; i < 1000; ++i) {
+            double v = dist(gen);
+            values.push_back(v);
+            sketch.add(v);
+        }
+        std::vector<uint8_t> buf(sketch.serialize_size());
+        ASSERT_EQ(buf.size(), sketch.serialize(buf.data()));
+        DDSketch copy;
+        ASSERT_EQ((const char*)buf.data() + buf.size(), copy.deserialize((const char*)buf.data()));
+        merged.merge(copy);
+    }
+    std::sort(values.begin(), values.end());
+    ASSERT_EQ(values.size(), merged.count());
+    for (double q : {0.5, 0.9, 0.99}) {
+        double expected = exact_quantile(values, q);
+        ASSERT_NEAR(expected, merged.quantile(q), expected * 0.02);
+    }
+}
+
+TEST(DDSketchTest, bounded_buckets) {
+    DDSketch sketch(0.01, 128);
+    for (int i = 1; i <= 100000; ++i) {
+        sketch.add(i * 0.001);
+    }
+    // the lowest buckets are collapsed, the high quantiles keep the accuracy.
+    ASSERT_LE(sketch.serialize_size(), 200 * sizeof(uint64_t));
+    ASSERT_NEAR(99.0, sketch.quantile(0.99), 99.0 * 0.01);
+    ASSERT_DOUBLE_EQ(100.0, sketch.quantile(1.0));
+}
+
+TEST(DDSketchTest, percentile_value) {
+    PercentileValue ddsketch(0.01);
+    PercentileValue tdigest;
+    for (int i = 1; i <= 1000; ++i) {
+        ddsketch.add(i);
+        tdigest.add(i + 1000);
+    }
+    std::vector<uint8_t> buf(ddsketch.serialize_size());
+    ddsketch.serialize(buf.data());
+    PercentileValue copy(Slice(buf.data(), buf.size()));
+    ASSERT_EQ(PercentileValue::DDSKETCH, copy.type());
+    ASSERT_NEAR(500, copy.quantile(0.5), 5);
+
+    // a new percentile takes the type of the merged one.
+    PercentileValue state;
+    state.merge(&copy);
+    ASSERT_EQ(PercentileValue::DDSKETCH, state.type());
+    state.merge(&tdigest);
+    ASSERT_NEAR(1000, state.quantile(0.5), 20);
+}
+
+} // namespace starrocks
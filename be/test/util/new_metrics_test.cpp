@@ -185,6 +185,48 @@ TEST_F(MetricsTest, Gauge) {
     }
 }
 
+TEST_F(MetricsTest, Histogram) {
+    // The buckets are (0, 1], (1, 2], (2, 3], (3, 4], (4, 5], (5, 6], (6, 7], (7, 8], (8, 10], ...
+    ASSERT_EQ(0, IntHistogram::bucket_index(0));
+    ASSERT_EQ(0, IntHistogram::bucket_index(1));
+    ASSERT_EQ(3, IntHistogram::bucket_index(4));
+    ASSERT_EQ(4, IntHistogram::bucket_index(5));
+    ASSERT_EQ(7, IntHistogram::bucket_index(8));
+    ASSERT_EQ(8, IntHistogram::bucket_index(9));
+    ASSERT_EQ(8, IntHistogram::bucket_index(10));
+    ASSERT_EQ(IntHistogram::kNumBuckets - 1, IntHistogram::bucket_index(INT64_MAX));
+    for (int i = 0; i < IntHistogram::kNumBuckets; ++i) {
+        int64_t upper_bound = IntHistogram::bucket_upper_bound(i);
+        ASSERT_EQ(i, IntHistogram::bucket_index(upper_bound));
+        if (i + 1 < IntHistogram::kNumBuckets) {
+            ASSERT_EQ(i + 1, IntHistogram::bucket_index(upper_bound + 1));
+        }
+    }
+    ASSERT_EQ(1LL << IntHistogram::kMaxExponent, IntHistogram::bucket_upper_bound(IntHistogram::kNumBuckets - 1));
+
+    IntHistogram histogram(MetricUnit::MICROSECONDS);
+    ASSERT_EQ(0, histogram.count());
+    ASSERT_EQ(0, histogram.value_at(0.99));
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&histogram]() {
+            for (int i = 1; i <= 1000; ++i) {
+                histogram.record(i);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(4000, histogram.count());
+    ASSERT_EQ(4 * 500500, histogram.sum());
+    // The estimation is the upper bound of the bucket, within 25% of the exact value.
+    ASSERT_EQ(512, histogram.value_at(0.5));
+    ASSERT_EQ(1024, histogram.value_at(0.99));
+    ASSERT_EQ(1, histogram.value_at(0));
+    ASSERT_STREQ("count=4000 sum=2002000 p50=512 p90=1024 p99=1024 p999=1024", histogram.to_string().c_str());
+}
+
 TEST_F(MetricsTest, MetricLabel) {
     std::string put("put");
     MetricLabel label("type", put);
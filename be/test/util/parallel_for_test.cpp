@@ -0,0 +1,113 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/parallel_for.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "util/countdown_latch.h"
+#include "util/threadpool.h"
+
+namespace starrocks {
+
+class ParallelForTest : public testing::Test {
+public:
+    void SetUp() override {
+        ASSERT_TRUE(ThreadPoolBuilder("parallel_for_test").set_min_threads(0).set_max_threads(4).build(&_pool).ok());
+    }
+
+    void TearDown() override { _pool->shutdown(); }
+
+protected:
+    std::unique_ptr<ThreadPool> _pool;
+};
+
+// NOLINTNEXTLINE
+TEST_F(ParallelForTest, test_run_every_index_once) {
+    for (ThreadPool* pool : {_pool.get(), static_cast<ThreadPool*>(nullptr)}) {
+        std::mutex mutex;
+        std::multiset<size_t> indexes;
+        std::set<std::thread::id> threads;
+        auto st = parallel_for(pool, 100, 4, [&](size_t i) {
+            std::lock_guard l(mutex);
+            indexes.insert(i);
+            threads.insert(std::this_thread::get_id());
+            return Status::OK();
+        });
+        ASSERT_TRUE(st.ok()) << st.to_string();
+        ASSERT_EQ(100, indexes.size());
+        for (size_t i = 0; i < 100; ++i) {
+            ASSERT_EQ(1, indexes.count(i));
+        }
+        ASSERT_LE(threads.size(), 4);
+        if (pool == nullptr) {
+            // the caller runs all of them without a pool.
+            ASSERT_EQ(1, threads.size());
+            ASSERT_EQ(1, threads.count(std::this_thread::get_id()));
+        }
+    }
+    ASSERT_TRUE(parallel_for(_pool.get(), 0, 4, [](size_t) { return Status::InternalError("never run"); }).ok());
+}
+
+// NOLINTNEXTLINE
+TEST_F(ParallelForTest, test_run_in_parallel) {
+    // every index waits for the others, so they must be run by 4 workers at the same time.
+    CountDownLatch latch(4);
+    auto st = parallel_for(_pool.get(), 4, 4, [&](size_t i) {
+        latch.count_down();
+        latch.wait();
+        return Status::OK();
+    });
+    ASSERT_TRUE(st.ok()) << st.to_string();
+}
+
+// NOLINTNEXTLINE
+TEST_F(ParallelForTest, test_stop_at_first_error) {
+    std::atomic<size_t> num_runs{0};
+    auto st = parallel_for(_pool.get(), 1000, 4, [&](size_t i) {
+        num_runs++;
+        if (i == 10) {
+            return Status::InternalError("failed at 10");
+        }
+        return Status::OK();
+    });
+    ASSERT_FALSE(st.ok());
+    ASSERT_EQ("failed at 10", st.get_error_msg());
+    // the workers stop taking more indexes after the error.
+    ASSERT_LT(num_runs, 1000);
+}
+
+// NOLINTNEXTLINE
+TEST_F(ParallelForTest, test_busy_pool) {
+    // all the threads of the pool are blocked, the caller runs all the indexes alone.
+    CountDownLatch blocked(4);
+    CountDownLatch release(1);
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(_pool->submit_func([&]() {
+                             blocked.count_down();
+                             release.wait();
+                         })
+                            .ok());
+    }
+    blocked.wait();
+
+    std::set<std::thread::id> threads;
+    auto st = parallel_for(_pool.get(), 10, 4, [&](size_t i) {
+        threads.insert(std::this_thread::get_id());
+        return Status::OK();
+    });
+    ASSERT_TRUE(st.ok()) << st.to_string();
+    ASSERT_EQ(1, threads.size());
+    ASSERT_EQ(1, threads.count(std::this_thread::get_id()));
+
+    // the workers queued meanwhile return at once without running anything.
+    release.count_down();
+    _pool->wait();
+}
+
+} // namespace starrocks
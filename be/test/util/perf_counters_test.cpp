@@ -0,0 +1,38 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/perf_counters.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+namespace starrocks {
+
+TEST(ThreadHardwareCountersTest, read) {
+    ThreadHardwareCounters* counters = ThreadHardwareCounters::current();
+    if (counters == nullptr) {
+        // The hardware counters are not available on this machine.
+        return;
+    }
+    ASSERT_EQ(counters, ThreadHardwareCounters::current());
+
+    ThreadHardwareCounters::Values begin;
+    ASSERT_TRUE(counters->read(&begin));
+    volatile int64_t sum = 0;
+    for (int i = 0; i < 1000000; ++i) {
+        sum += i;
+    }
+    ThreadHardwareCounters::Values end;
+    ASSERT_TRUE(counters->read(&end));
+    ASSERT_GT(end[ThreadHardwareCounters::INSTRUCTIONS], begin[ThreadHardwareCounters::INSTRUCTIONS]);
+    for (int i = 0; i < ThreadHardwareCounters::NUM_EVENTS; ++i) {
+        ASSERT_GE(end[i], begin[i]);
+    }
+
+    // Every thread has its own counters.
+    ThreadHardwareCounters* other = nullptr;
+    std::thread([&other] { other = ThreadHardwareCounters::current(); }).join();
+    ASSERT_NE(counters, other);
+}
+
+} // namespace starrocks
@@ -0,0 +1,69 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/priority_thread_pool.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "util/countdown_latch.h"
+
+namespace starrocks {
+
+// NOLINTNEXTLINE
+TEST(PriorityThreadPoolTest, run_tasks_in_lanes) {
+    const int num_tasks = 10000;
+    PriorityThreadPool pool(8, 1024, 4);
+    std::atomic<int> num_done{0};
+    CountDownLatch latch(num_tasks);
+    for (int i = 0; i < num_tasks; ++i) {
+        PriorityThreadPool::Task task;
+        task.priority = i % 10;
+        task.work_function = [&] {
+            num_done++;
+            latch.count_down();
+        };
+        ASSERT_TRUE(pool.offer(task));
+    }
+    latch.wait();
+    ASSERT_EQ(num_tasks, num_done);
+    ASSERT_EQ(0, pool.get_queue_size());
+}
+
+// NOLINTNEXTLINE
+TEST(PriorityThreadPoolTest, steal_from_other_lanes) {
+    // the thread blocked keeps the tasks of its lane from being run, but the other thread steals them.
+    PriorityThreadPool pool(2, 16, 2);
+    CountDownLatch blocker(1);
+    CountDownLatch latch(8);
+    ASSERT_TRUE(pool.offer([&] { blocker.wait(); }));
+    for (int i = 0; i < 8; ++i) {
+        ASSERT_TRUE(pool.offer([&] { latch.count_down(); }));
+    }
+    ASSERT_TRUE(latch.wait_for(MonoDelta::FromSeconds(10)));
+    blocker.count_down();
+}
+
+// NOLINTNEXTLINE
+TEST(PriorityThreadPoolTest, try_offer_full) {
+    PriorityThreadPool pool(1, 2, 2);
+    CountDownLatch blocker(1);
+    CountDownLatch started(1);
+    ASSERT_TRUE(pool.offer([&] {
+        started.count_down();
+        blocker.wait();
+    }));
+    started.wait();
+    // one lane of one task only, as the lanes are no more than the threads.
+    ASSERT_EQ(2, pool.get_queue_capacity());
+    ASSERT_TRUE(pool.try_offer({0, [] {}}));
+    ASSERT_TRUE(pool.try_offer({0, [] {}}));
+    ASSERT_FALSE(pool.try_offer({0, [] {}}));
+    blocker.count_down();
+    pool.drain_and_shutdown();
+    ASSERT_EQ(0, pool.get_queue_size());
+}
+
+} // namespace starrocks
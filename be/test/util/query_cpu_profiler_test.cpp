@@ -0,0 +1,59 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/query_cpu_profiler.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include "runtime/current_thread.h"
+
+namespace starrocks {
+
+// NOLINTNEXTLINE
+TEST(QueryCpuProfilerTest, attribute_samples_to_query) {
+    auto* profiler = QueryCpuProfiler::instance();
+    ASSERT_FALSE(profiler->start(0).ok());
+    ASSERT_TRUE(profiler->start(1000).ok());
+    ASSERT_TRUE(profiler->is_running());
+
+    TUniqueId query_id;
+    query_id.__set_hi(100);
+    query_id.__set_lo(200);
+    CurrentThread::set_query_id(query_id);
+    volatile int64_t sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds(300)) {
+        for (int i = 0; i < 10000; ++i) {
+            sum += i;
+        }
+    }
+    CurrentThread::set_query_id(TUniqueId());
+
+    ASSERT_TRUE(profiler->stop());
+    ASSERT_FALSE(profiler->is_running());
+    ASSERT_FALSE(profiler->stop());
+
+    int64_t num_samples = 0;
+    for (const auto& [id, n] : profiler->queries()) {
+        if (id == query_id) {
+            num_samples = n;
+        }
+    }
+    ASSERT_GT(num_samples, 0);
+    QueryCpuProfiler::Stacks stacks;
+    ASSERT_TRUE(profiler->get_stacks(query_id, &stacks));
+    int64_t total = 0;
+    for (const auto& [stack, n] : stacks) {
+        ASSERT_FALSE(stack.empty());
+        total += n;
+    }
+    ASSERT_EQ(num_samples, total);
+
+    TUniqueId unknown_id;
+    unknown_id.__set_hi(1);
+    unknown_id.__set_lo(1);
+    ASSERT_FALSE(profiler->get_stacks(unknown_id, &stacks));
+}
+
+} // namespace starrocks
@@ -465,4 +465,40 @@ TEST_F(TestRle, TestBatch) {
     ASSERT_EQ(1024, n);
 }
 
+TEST_F(TestRle, TestGetBatchWithDict) {
+    const int bit_width = 4;
+    const std::vector<int64_t> dict = {100, 101, 102, 103, 104, 105, 106, 107, 108, 109};
+    std::vector<uint32_t> indexes;
+    // a repeated run followed by literal runs longer than a batch of literals
+    indexes.insert(indexes.end(), 300, 3);
+    for (int i = 0; i < 3000; ++i) {
+        indexes.push_back(i % dict.size());
+    }
+    indexes.insert(indexes.end(), 17, 9);
+
+    faststring buffer;
+    RleEncoder<uint32_t> encoder(&buffer, bit_width);
+    for (auto index : indexes) {
+        encoder.Put(index);
+    }
+    encoder.Flush();
+
+    RleBatchDecoder<uint32_t> decoder(buffer.data(), buffer.size(), bit_width);
+    std::vector<int64_t> values(indexes.size());
+    // read in batches not aligned to the runs
+    int32_t num_read = 0;
+    while (num_read < static_cast<int32_t>(indexes.size())) {
+        int32_t n = std::min<int32_t>(77, indexes.size() - num_read);
+        ASSERT_EQ(n, decoder.GetBatchWithDict(dict.data(), dict.size(), &values[num_read], n));
+        num_read += n;
+    }
+    for (size_t i = 0; i < indexes.size(); ++i) {
+        ASSERT_EQ(dict[indexes[i]], values[i]);
+    }
+
+    // the index out of the dict is not looked up
+    RleBatchDecoder<uint32_t> decoder2(buffer.data(), buffer.size(), bit_width);
+    ASSERT_EQ(300, decoder2.GetBatchWithDict(dict.data(), 4, &values[0], indexes.size()));
+}
+
 } // namespace starrocks
@@ -0,0 +1,44 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+#include "util/token_bucket.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+namespace starrocks {
+
+// NOLINTNEXTLINE
+TEST(TokenBucketTest, test_no_limit) {
+    TokenBucket bucket(0);
+    ASSERT_EQ(0, bucket.take(1L << 40));
+    ASSERT_EQ(0, bucket.take(1L << 40));
+}
+
+// NOLINTNEXTLINE
+TEST(TokenBucketTest, test_take) {
+    TokenBucket bucket(1000);
+    // the burst is one second of tokens
+    ASSERT_EQ(0, bucket.take(1000));
+    // in debt for about half a second
+    int64_t wait_us = bucket.take(500);
+    ASSERT_GT(wait_us, 400000);
+    ASSERT_LE(wait_us, 500000);
+    // the next caller waits after the previous one
+    ASSERT_GT(bucket.take(500), wait_us);
+
+    bucket.set_rate(0);
+    ASSERT_EQ(0, bucket.take(1000));
+}
+
+// NOLINTNEXTLINE
+TEST(TokenBucketTest, test_acquire) {
+    TokenBucket bucket(10000);
+    bucket.acquire(10000);
+    auto start = std::chrono::steady_clock::now();
+    bucket.acquire(2000);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    ASSERT_GE(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count(), 150);
+}
+
+} // namespace starrocks
@@ -62,6 +62,7 @@ Usage: $0 <options>
      --without-gcov     build Backend without gcov(default)
      --with-hdfs        enable hdfs support
      --without-hdfs     disable hdfs support
+     --with-benchmark   build the microbenchmarks of Backend
 
   Eg.
     $0                                      build all
@@ -85,6 +86,7 @@ OPTS=$(getopt \
   -l 'without-gcov' \
   -l 'with-hdfs' \
   -l 'without-hdfs' \
+  -l 'with-benchmark' \
   -l 'help' \
   -- "$@")
 
@@ -101,6 +103,7 @@ CLEAN=
 RUN_UT=
 WITH_GCOV=OFF
 WITH_HDFS=ON
+WITH_BENCHMARK=OFF
 if [[ -z ${USE_AVX2} ]]; then
     USE_AVX2=ON
 fi
@@ -131,6 +134,7 @@ else
             --without-gcov) WITH_GCOV=OFF; shift ;;
             --with-hdfs) WITH_HDFS=ON; shift ;;
             --without-hdfs) WITH_HDFS=OFF; shift ;;
+            --with-benchmark) WITH_BENCHMARK=ON; shift ;;
             -h) HELP=1; shift ;;
             --help) HELP=1; shift ;;
             --) shift ;  break ;;
@@ -157,6 +161,7 @@ echo "Get params:
     RUN_UT              -- $RUN_UT
     WITH_GCOV           -- $WITH_GCOV
     WITH_HDFS           -- $WITH_HDFS
+    WITH_BENCHMARK      -- $WITH_BENCHMARK
     USE_AVX2            -- $USE_AVX2
 "
 
@@ -194,7 +199,8 @@ if [ ${BUILD_BE} -eq 1 ] ; then
     mkdir -p ${CMAKE_BUILD_DIR}
     cd ${CMAKE_BUILD_DIR}
     ${CMAKE_CMD} .. -DSTARROCKS_THIRDPARTY=${STARROCKS_THIRDPARTY} -DSTARROCKS_HOME=${STARROCKS_HOME} -DCMAKE_CXX_COMPILER_LAUNCHER=ccache -DCMAKE_BUILD_TYPE=${CMAKE_BUILD_TYPE} \
-                    -DMAKE_TEST=OFF -DWITH_HDFS=${WITH_HDFS} -DWITH_GCOV=${WITH_GCOV} -DUSE_AVX2=$USE_AVX2
+                    -DMAKE_TEST=OFF -DWITH_HDFS=${WITH_HDFS} -DWITH_GCOV=${WITH_GCOV} -DUSE_AVX2=$USE_AVX2 \
+                    -DMAKE_BENCHMARK=${WITH_BENCHMARK}
     time make -j${PARALLEL}
     make install
     cd ${STARROCKS_HOME}
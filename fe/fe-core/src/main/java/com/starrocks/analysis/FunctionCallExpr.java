@@ -86,6 +86,10 @@ public class FunctionCallExpr extends Expr {
                     .add("stddev").add("stddev_val").add("stddev_samp")
                     .add("variance").add("variance_pop").add("variance_pop").add("var_samp").add("var_pop").build();
 
+    // the sketches of percentile_approx(expr, p, B, method), B is the compression of tdigest or the relative accuracy
+    // of ddsketch.
+    public static final ImmutableSet<String> PERCENTILE_APPROX_METHODS = ImmutableSet.of("tdigest", "ddsketch");
+
     // TODO(yan): add more known functions which are monotonic.
     private static final ImmutableSet<String> MONOTONIC_FUNCTION_SET =
             new ImmutableSet.Builder().add("year").build();
@@ -514,19 +518,27 @@ public class FunctionCallExpr extends Expr {
         }
 
         if (fnName.getFunction().equalsIgnoreCase("percentile_approx")) {
-            if (children.size() != 2 && children.size() != 3) {
-                throw new AnalysisException("percentile_approx(expr, DOUBLE [, B]) requires two or three parameters");
+            if (children.size() < 2 || children.size() > 4) {
+                throw new AnalysisException(
+                        "percentile_approx(expr, DOUBLE [, B [, method]]) requires two to four parameters");
             }
             if (!getChild(1).isConstant()) {
                 throw new AnalysisException("percentile_approx requires second parameter must be a constant : "
                         + this.toSql());
             }
-            if (children.size() == 3) {
+            if (children.size() >= 3) {
                 if (!getChild(2).isConstant()) {
                     throw new AnalysisException("percentile_approx requires the third parameter must be a constant : "
                             + this.toSql());
                 }
             }
+            if (children.size() == 4) {
+                if (!(getChild(3) instanceof StringLiteral) ||
+                        !PERCENTILE_APPROX_METHODS.contains(((StringLiteral) getChild(3)).getValue().toLowerCase())) {
+                    throw new AnalysisException("percentile_approx requires the fourth parameter must be one of "
+                            + PERCENTILE_APPROX_METHODS + " : " + this.toSql());
+                }
+            }
         }
     }
 
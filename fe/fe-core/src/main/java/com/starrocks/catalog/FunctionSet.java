@@ -520,6 +520,9 @@ public class FunctionSet {
         addBuiltin(AggregateFunction.createBuiltin("percentile_approx",
                 Lists.newArrayList(Type.DOUBLE, Type.DOUBLE, Type.DOUBLE), Type.DOUBLE, Type.VARCHAR,
                 false, false, false));
+        addBuiltin(AggregateFunction.createBuiltin("percentile_approx",
+                Lists.newArrayList(Type.DOUBLE, Type.DOUBLE, Type.DOUBLE, Type.VARCHAR), Type.DOUBLE, Type.VARCHAR,
+                false, false, false));
 
         addBuiltin(AggregateFunction.createBuiltin("percentile_union",
                 Lists.newArrayList(Type.PERCENTILE), Type.PERCENTILE, Type.PERCENTILE,
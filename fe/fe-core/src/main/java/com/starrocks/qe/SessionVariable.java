@@ -117,6 +117,12 @@ public class SessionVariable implements Serializable, Writable, Cloneable {
 
     public static final String PIPELINE_QUERY_EXPIRE_SECONDS = "pipeline_query_expire_seconds";
 
+    public static final String PIPELINE_RESOURCE_GROUP = "pipeline_resource_group";
+
+    public static final String ENABLE_PIPELINE_HARDWARE_COUNTERS = "enable_pipeline_hardware_counters";
+
+    public static final String ENABLE_SCAN_COLUMN_IO_STATS = "enable_scan_column_io_stats";
+
     // hash join right table push down
     public static final String HASH_JOIN_PUSH_DOWN_RIGHT_TABLE = "hash_join_push_down_right_table";
 
@@ -308,6 +314,21 @@ public class SessionVariable implements Serializable, Writable, Cloneable {
     @VariableMgr.VarAttr(name = PIPELINE_QUERY_EXPIRE_SECONDS)
     private int pipelineQueryExpireSeconds = 300;
 
+    // the resource group of pipeline engine which the queries run in, the resource groups are
+    // defined by the config pipeline_resource_groups of BE, empty means the default group.
+    @VariableMgr.VarAttr(name = PIPELINE_RESOURCE_GROUP)
+    private String pipelineResourceGroup = "";
+
+    // collect the cpu cycles, instructions, llc misses and branch misses of every pipeline operator
+    // into the profile, the hardware counters of linux perf events must be available on BE.
+    @VariableMgr.VarAttr(name = ENABLE_PIPELINE_HARDWARE_COUNTERS)
+    private boolean enablePipelineHardwareCounters = false;
+
+    // collect the pages read, pages hit in page cache, bytes read and the time of io, decompression and
+    // decoding of every column scanned into the profile of the olap scan.
+    @VariableMgr.VarAttr(name = ENABLE_SCAN_COLUMN_IO_STATS)
+    private boolean enableScanColumnIOStats = false;
+
     @VariableMgr.VarAttr(name = ENABLE_INSERT_STRICT)
     private boolean enableInsertStrict = true;
 
@@ -748,6 +769,11 @@ public class SessionVariable implements Serializable, Writable, Cloneable {
         tResult.setPipeline_dop(pipelineDop);
         tResult.setPipeline_scan_mode(pipelineScanMode);
         tResult.setPipeline_query_expire_seconds(pipelineQueryExpireSeconds);
+        if (!pipelineResourceGroup.isEmpty()) {
+            tResult.setPipeline_resource_group(pipelineResourceGroup);
+        }
+        tResult.setEnable_pipeline_hardware_counters(enablePipelineHardwareCounters);
+        tResult.setEnable_scan_column_io_stats(enableScanColumnIOStats);
         return tResult;
     }
 
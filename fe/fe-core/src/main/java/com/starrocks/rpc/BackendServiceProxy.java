@@ -31,6 +31,7 @@ import com.starrocks.common.Config;
 import com.starrocks.common.util.JdkUtils;
 import com.starrocks.proto.PCancelPlanFragmentRequest;
 import com.starrocks.proto.PCancelPlanFragmentResult;
+import com.starrocks.proto.PExecBatchPlanFragmentsResult;
 import com.starrocks.proto.PExecPlanFragmentResult;
 import com.starrocks.proto.PFetchDataResult;
 import com.starrocks.proto.PPlanFragmentCancelReason;
@@ -38,6 +39,7 @@ import com.starrocks.proto.PProxyRequest;
 import com.starrocks.proto.PProxyResult;
 import com.starrocks.proto.PTriggerProfileReportResult;
 import com.starrocks.proto.PUniqueId;
+import com.starrocks.thrift.TExecBatchPlanFragmentsParams;
 import com.starrocks.thrift.TExecPlanFragmentParams;
 import com.starrocks.thrift.TNetworkAddress;
 import com.starrocks.thrift.TUniqueId;
@@ -123,6 +125,36 @@ public class BackendServiceProxy {
         }
     }
 
+    public Future<PExecBatchPlanFragmentsResult> execBatchPlanFragmentsAsync(
+            TNetworkAddress address, TExecBatchPlanFragmentsParams tRequest)
+            throws TException, RpcException {
+        final PExecBatchPlanFragmentsRequest pRequest = new PExecBatchPlanFragmentsRequest();
+        pRequest.setRequest(tRequest);
+        try {
+            final PBackendService service = getProxy(address);
+            return service.execBatchPlanFragmentsAsync(pRequest);
+        } catch (NoSuchElementException e) {
+            try {
+                // retry
+                try {
+                    Thread.sleep(10);
+                } catch (InterruptedException interruptedException) {
+                    // do nothing
+                }
+                final PBackendService service = getProxy(address);
+                return service.execBatchPlanFragmentsAsync(pRequest);
+            } catch (NoSuchElementException noSuchElementException) {
+                LOG.warn("Execute batch plan fragments retry failed, address={}:{}",
+                        address.getHostname(), address.getPort(), noSuchElementException);
+                throw new RpcException(address.hostname, e.getMessage());
+            }
+        } catch (Throwable e) {
+            LOG.warn("Execute batch plan fragments catch a exception, address={}:{}",
+                    address.getHostname(), address.getPort(), e);
+            throw new RpcException(address.hostname, e.getMessage());
+        }
+    }
+
     public Future<PCancelPlanFragmentResult> cancelPlanFragmentAsync(
             TNetworkAddress address, TUniqueId queryId, TUniqueId finstId, PPlanFragmentCancelReason cancelReason,
             boolean isPipeline) throws RpcException {
@@ -0,0 +1,9 @@
+// This file is licensed under the Elastic License 2.0. Copyright 2021 StarRocks Limited.
+
+package com.starrocks.rpc;
+
+import com.baidu.bjf.remoting.protobuf.annotation.ProtobufClass;
+
+@ProtobufClass
+public class PExecBatchPlanFragmentsRequest extends AttachmentRequest {
+}
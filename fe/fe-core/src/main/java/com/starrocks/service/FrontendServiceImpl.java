@@ -88,6 +88,8 @@ import com.starrocks.thrift.TExecPlanFragmentParams;
 import com.starrocks.thrift.TFeResult;
 import com.starrocks.thrift.TFetchResourceResult;
 import com.starrocks.thrift.TFinishTaskRequest;
+import com.starrocks.thrift.TFinishTasksRequest;
+import com.starrocks.thrift.TFinishTasksResult;
 import com.starrocks.thrift.TGetDBPrivsParams;
 import com.starrocks.thrift.TGetDBPrivsResult;
 import com.starrocks.thrift.TGetDbsParams;
@@ -546,6 +548,15 @@ public class FrontendServiceImpl implements FrontendService.Iface {
         return masterImpl.finishTask(request);
     }
 
+    @Override
+    public TFinishTasksResult finishTasks(TFinishTasksRequest request) throws TException {
+        List<TMasterResult> results = new ArrayList<>(request.getRequestsSize());
+        for (TFinishTaskRequest finishTaskRequest : request.getRequests()) {
+            results.add(masterImpl.finishTask(finishTaskRequest));
+        }
+        return new TFinishTasksResult(results);
+    }
+
     @Override
     public TMasterResult report(TReportRequest request) throws TException {
         return masterImpl.report(request);
@@ -211,19 +211,28 @@ public class FunctionAnalyzer {
         }
 
         if (fnName.getFunction().equalsIgnoreCase("percentile_approx")) {
-            if (functionCallExpr.getChildren().size() != 2 && functionCallExpr.getChildren().size() != 3) {
-                throw new SemanticException("percentile_approx(expr, DOUBLE [, B]) requires two or three parameters");
+            if (functionCallExpr.getChildren().size() < 2 || functionCallExpr.getChildren().size() > 4) {
+                throw new SemanticException(
+                        "percentile_approx(expr, DOUBLE [, B [, method]]) requires two to four parameters");
             }
             if (!functionCallExpr.getChild(1).isConstant()) {
                 throw new SemanticException("percentile_approx requires second parameter must be a constant : "
                         + functionCallExpr.toSql());
             }
-            if (functionCallExpr.getChildren().size() == 3) {
+            if (functionCallExpr.getChildren().size() >= 3) {
                 if (!functionCallExpr.getChild(2).isConstant()) {
                     throw new SemanticException("percentile_approx requires the third parameter must be a constant : "
                             + functionCallExpr.toSql());
                 }
             }
+            if (functionCallExpr.getChildren().size() == 4) {
+                Expr method = functionCallExpr.getChild(3);
+                if (!(method instanceof StringLiteral) || !FunctionCallExpr.PERCENTILE_APPROX_METHODS.contains(
+                        ((StringLiteral) method).getValue().toLowerCase())) {
+                    throw new SemanticException("percentile_approx requires the fourth parameter must be one of "
+                            + FunctionCallExpr.PERCENTILE_APPROX_METHODS + " : " + functionCallExpr.toSql());
+                }
+            }
         }
     }
 }
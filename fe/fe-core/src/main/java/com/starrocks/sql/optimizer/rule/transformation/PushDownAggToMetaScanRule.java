@@ -27,9 +27,10 @@ import java.util.Collections;
 import java.util.List;
 import java.util.Map;
 
-// For meta scan query: select max(a), min(a), dict_merge(a) from test_all_type [_META_]
-// we need to push max, min, dict_merge aggregate function infos to meta scan node
-// we will generate new columns: max_a, min_a, dict_merge_a, make meta scan known what meta info to collect
+// For meta scan query: select max(a), min(a), dict_merge(a), sum(a), count(a) from test_all_type [_META_]
+// we need to push max, min, dict_merge, sum, count aggregate function infos to meta scan node
+// we will generate new columns: max_a, min_a, dict_merge_a, sum_a, count_a, make meta scan known what meta info
+// to collect
 public class PushDownAggToMetaScanRule extends TransformationRule {
     public PushDownAggToMetaScanRule() {
         super(RuleType.TF_PUSH_DOWN_AGG_TO_META_SCAN,
@@ -78,14 +79,21 @@ public class PushDownAggToMetaScanRule extends TransformationRule {
             newScanColumnRefs.put(metaColumn, metaScan.getColRefToColumnMetaMap().get(usedColumn));
 
             Function aggFunction = aggCall.getFunction();
+            String aggFnName = aggCall.getFnName();
             // DictMerge meta aggregate function is special, need change the are type from
             // VARCHAR to ARRAY_VARCHAR
             if (aggCall.getFnName().equals(FunctionSet.DICT_MERGE)) {
                 aggFunction = Expr.getBuiltinFunction(aggCall.getFnName(),
                         new Type[] {Type.ARRAY_VARCHAR}, Function.CompareMode.IS_IDENTICAL);
+            } else if (aggCall.getFnName().equals(FunctionSet.SUM) ||
+                    aggCall.getFnName().equals(FunctionSet.COUNT)) {
+                // the sums and counts of the segments are already in the result type, sum them up
+                aggFnName = FunctionSet.SUM;
+                aggFunction = Expr.getBuiltinFunction(FunctionSet.SUM,
+                        new Type[] {columnType}, Function.CompareMode.IS_IDENTICAL);
             }
 
-            CallOperator newAggCall = new CallOperator(aggCall.getFnName(), aggCall.getType(),
+            CallOperator newAggCall = new CallOperator(aggFnName, aggCall.getType(),
                     Collections.singletonList(metaColumn), aggFunction);
             newAggCalls.put(kv.getKey(), newAggCall);
         }
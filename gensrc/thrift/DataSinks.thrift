@@ -115,6 +115,8 @@ struct TOlapTableSink {
     12: required Descriptors.TOlapTableLocationParam location
     13: required Descriptors.TNodesInfo nodes_info
     14: optional i64 load_channel_timeout_s // the timeout of load channels in second
+    // whether the rows of every tablet are loaded in the order of the keys, e.g. the data prepared by spark
+    15: optional bool input_sorted
 }
 
 struct TDataSink {
@@ -341,6 +341,24 @@ enum FrontendServiceVersion {
   V1
 }
 
+// The actual cardinality of a plan node in a fragment instance, for the optimizer to compare with its estimation.
+struct TPlanNodeRuntimeStats {
+  1: optional i32 plan_node_id
+
+  // rows output by the node
+  2: optional i64 output_rows
+
+  // rows read from the storage by a scan node before and after the predicates pushed down,
+  // and the rows skipped by the indexes, where the runtime filters pushed down also take effect.
+  3: optional i64 raw_rows_read
+  4: optional i64 rows_read
+  5: optional i64 index_filtered_rows
+
+  // rows input and output by the runtime filters evaluated on the chunks of the node
+  6: optional i64 runtime_filter_input_rows
+  7: optional i64 runtime_filter_output_rows
+}
+
 // The results of an INSERT query, sent to the coordinator as part of 
 // TReportExecStatusParams
 struct TReportExecStatusParams {
@@ -386,6 +404,9 @@ struct TReportExecStatusParams {
   15: optional i64 loaded_rows
 
   16: optional i64 backend_id
+
+  // only set in the final report
+  17: optional list<TPlanNodeRuntimeStats> plan_node_runtime_stats
 }
 
 struct TFeResult {
@@ -919,6 +940,7 @@ service FrontendService {
     TReportExecStatusResult reportExecStatus(1:TReportExecStatusParams params)
 
     MasterService.TMasterResult finishTask(1:MasterService.TFinishTaskRequest request)
+    MasterService.TFinishTasksResult finishTasks(1:MasterService.TFinishTasksRequest request)
     MasterService.TMasterResult report(1:MasterService.TReportRequest request)
     MasterService.TFetchResourceResult fetchResource()
 
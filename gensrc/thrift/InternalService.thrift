@@ -154,6 +154,12 @@ struct TQueryOptions {
   55: optional i32 pipeline_scan_mode;
   // For query context expired period
   56: optional i32 pipeline_query_expire_seconds
+  // The resource group of pipeline engine the query runs in
+  57: optional string pipeline_resource_group
+  // Collect the hardware events of every pipeline operator into its profile
+  58: optional bool enable_pipeline_hardware_counters = false;
+  // Collect the pages, bytes and time of reading every column of the scans into their profiles
+  59: optional bool enable_scan_column_io_stats = false;
 }
 
 
@@ -301,6 +307,15 @@ struct TExecPlanFragmentParams {
   50: optional bool is_pipeline
 }
 
+// Deploy the instances of one plan fragment on one backend by one rpc, the parts shared by all the instances,
+// e.g. the plan fragment, the descriptor table and the query options, are sent only once in common_param,
+// and unique_param_per_instance only carries the parts specific to each instance, i.e. params and backend_num.
+struct TExecBatchPlanFragmentsParams {
+  1: optional TExecPlanFragmentParams common_param
+
+  2: optional list<TExecPlanFragmentParams> unique_param_per_instance
+}
+
 struct TExecPlanFragmentResult {
   // required in V1
   1: optional Status.TStatus status
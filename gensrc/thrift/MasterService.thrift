@@ -100,6 +100,16 @@ struct TMasterResult {
     1: required Status.TStatus status
 }
 
+// The finish reports of the tasks done at about the same time on a backend, sent in one rpc.
+struct TFinishTasksRequest {
+    1: required list<TFinishTaskRequest> requests
+}
+
+struct TFinishTasksResult {
+    // the results of the requests in order
+    1: required list<TMasterResult> results
+}
+
 // Now we only support CPU share.
 enum TResourceType {
     TRESOURCE_CPU_SHARE
@@ -116,6 +116,8 @@ enum TFileFormatType {
     FORMAT_ORC = 8,
     FORMAT_JSON = 9,
     FORMAT_CSV_ZSTD = 10,
+    // segment_v2 files built for the schema of the tablet, ingested by spark load as they are.
+    FORMAT_SEGMENT_V2 = 11,
 }
 
 // One broker range information.
@@ -214,6 +216,9 @@ struct THdfsScanRange {
 
     // file format of hdfs file
     6: optional Descriptors.THdfsFileFormat file_format
+
+    // last modification time of the hdfs file, identifies the cached footer of the file
+    7: optional i64 modification_time
 }
 
 // Specification of an individual data range which is held in its entirety